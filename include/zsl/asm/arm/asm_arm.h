@@ -6,9 +6,10 @@
 
 /**
  * @file
- * @brief Optimised functions for zscilib using ARM Thumb or ARM Thumb2.
+ * @brief Optimised functions for zscilib using ARM Thumb, Thumb2 or MVE.
  *
- * This file contains optimised functions for ARM Thumb or ARM Thumb2.
+ * This file contains optimised functions for ARM Thumb, ARM Thumb2 and
+ * ARM Helium (MVE).
  */
 
 #ifndef ZEPHYR_INCLUDE_ZSL_ASM_ARM_H_
@@ -19,10 +20,212 @@
 /** Write (output) constraint with Thumb general purpose registers (RO..R7). */
 #define OP_WR_T "=l"
 
-#if (CONFIG_ZSL_PLATFORM_OPT == 2)  /* ARM Thumb2 */
+#if (CONFIG_ZSL_PLATFORM_OPT == 2) || (CONFIG_ZSL_PLATFORM_OPT == 3)
+    /* ARM Thumb2 */
     #define RESUME_SYNTAX
 #else
     #define RESUME_SYNTAX ".syntax divided \n\t"
 #endif
 
+/*
+ * Single-precision kernels shared by the optimised vector and matrix
+ * functions. These are only available when zsl_real_t is a float, and
+ * either an FPv4 (or later) FPU is present (Cortex-M4F/M7, option 2), or
+ * the MVE floating-point extension is present (Cortex-M55, option 3).
+ * Otherwise the generic C implementations are used.
+ */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#if !defined(__ARM_FEATURE_MVE) || !(__ARM_FEATURE_MVE & 2)
+#error "CONFIG_ZSL_PLATFORM_OPT=3 requires MVE floating-point support"
+#endif
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_ASM_ARM_F32 1
+#include <arm_mve.h>
+#endif
+#elif (CONFIG_ZSL_PLATFORM_OPT == 2)
+#if CONFIG_ZSL_SINGLE_PRECISION && defined(__ARM_FP) && (__ARM_FP & 4) && \
+	defined(__ARM_FEATURE_FMA)
+#define ZSL_ASM_ARM_F32 1
+#endif
+#endif
+
+#if ZSL_ASM_ARM_F32
+#include <stddef.h>
+#include <zsl/zsl.h>
+
+/** Returns the dot product of the 'n' element arrays 'a' and 'b'. */
+static inline float asm_arm_f32_dot(const float *a, const float *b, size_t n)
+{
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	float32x4_t acc = vdupq_n_f32(0.0f);
+
+	/* Tail predication handles the final partial vector. */
+	for (int32_t cnt = (int32_t)n; cnt > 0; cnt -= 4) {
+		mve_pred16_t p = vctp32q((uint32_t)cnt);
+
+		acc = vfmaq_m_f32(acc, vld1q_z_f32(a, p), vld1q_z_f32(b, p), p);
+		a += 4;
+		b += 4;
+	}
+
+	return (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) +
+	       (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#else
+	float acc0 = 0.0f;
+	float acc1 = 0.0f;
+	size_t blocks = n >> 2;
+
+	/* Four elements per iteration, with two accumulators to hide the
+	 * latency of the fused multiply-accumulate. */
+	if (blocks) {
+		__asm__ volatile (
+			RESUME_SYNTAX
+			"1:\n\t"
+			"vldmia %[a]!, {s0-s3}\n\t"
+			"vldmia %[b]!, {s4-s7}\n\t"
+			"vfma.f32 %[acc0], s0, s4\n\t"
+			"vfma.f32 %[acc1], s1, s5\n\t"
+			"vfma.f32 %[acc0], s2, s6\n\t"
+			"vfma.f32 %[acc1], s3, s7\n\t"
+			"subs %[cnt], %[cnt], #1\n\t"
+			"bne 1b\n\t"
+			: [a] "+r" (a), [b] "+r" (b), [cnt] "+r" (blocks),
+			  [acc0] "+t" (acc0), [acc1] "+t" (acc1)
+			:
+			: "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+			  "cc", "memory");
+	}
+
+	for (size_t i = 0; i < (n & 3); i++) {
+		acc0 += a[i] * b[i];
+	}
+
+	return acc0 + acc1;
+#endif
+}
+
+/** Assigns x = a + b for the 'n' element arrays 'a', 'b' and 'x'. */
+static inline void asm_arm_f32_add(const float *a, const float *b, float *x,
+				   size_t n)
+{
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (int32_t cnt = (int32_t)n; cnt > 0; cnt -= 4) {
+		mve_pred16_t p = vctp32q((uint32_t)cnt);
+
+		vst1q_p_f32(x, vaddq_x_f32(vld1q_z_f32(a, p),
+					   vld1q_z_f32(b, p), p), p);
+		a += 4;
+		b += 4;
+		x += 4;
+	}
+#else
+	size_t blocks = n >> 2;
+
+	if (blocks) {
+		__asm__ volatile (
+			RESUME_SYNTAX
+			"1:\n\t"
+			"vldmia %[a]!, {s0-s3}\n\t"
+			"vldmia %[b]!, {s4-s7}\n\t"
+			"vadd.f32 s0, s0, s4\n\t"
+			"vadd.f32 s1, s1, s5\n\t"
+			"vadd.f32 s2, s2, s6\n\t"
+			"vadd.f32 s3, s3, s7\n\t"
+			"vstmia %[x]!, {s0-s3}\n\t"
+			"subs %[cnt], %[cnt], #1\n\t"
+			"bne 1b\n\t"
+			: [a] "+r" (a), [b] "+r" (b), [x] "+r" (x),
+			  [cnt] "+r" (blocks)
+			:
+			: "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+			  "cc", "memory");
+	}
+
+	for (size_t i = 0; i < (n & 3); i++) {
+		x[i] = a[i] + b[i];
+	}
+#endif
+}
+
+/** Scales the 'n' element array 'x' by 's' in place. */
+static inline void asm_arm_f32_scale(float *x, float s, size_t n)
+{
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (int32_t cnt = (int32_t)n; cnt > 0; cnt -= 4) {
+		mve_pred16_t p = vctp32q((uint32_t)cnt);
+
+		vst1q_p_f32(x, vmulq_x_n_f32(vld1q_z_f32(x, p), s, p), p);
+		x += 4;
+	}
+#else
+	float *y = x;
+	size_t blocks = n >> 2;
+
+	if (blocks) {
+		__asm__ volatile (
+			RESUME_SYNTAX
+			"1:\n\t"
+			"vldmia %[x]!, {s0-s3}\n\t"
+			"vmul.f32 s0, s0, %[s]\n\t"
+			"vmul.f32 s1, s1, %[s]\n\t"
+			"vmul.f32 s2, s2, %[s]\n\t"
+			"vmul.f32 s3, s3, %[s]\n\t"
+			"vstmia %[y]!, {s0-s3}\n\t"
+			"subs %[cnt], %[cnt], #1\n\t"
+			"bne 1b\n\t"
+			: [x] "+r" (x), [y] "+r" (y), [cnt] "+r" (blocks)
+			: [s] "t" (s)
+			: "s0", "s1", "s2", "s3", "cc", "memory");
+	}
+
+	for (size_t i = 0; i < (n & 3); i++) {
+		x[i] *= s;
+	}
+#endif
+}
+
+/** Accumulates y += s * x for the 'n' element arrays 'x' and 'y'. */
+static inline void asm_arm_f32_axpy(const float *x, float s, float *y,
+				    size_t n)
+{
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (int32_t cnt = (int32_t)n; cnt > 0; cnt -= 4) {
+		mve_pred16_t p = vctp32q((uint32_t)cnt);
+
+		vst1q_p_f32(y, vfmaq_m_n_f32(vld1q_z_f32(y, p),
+					     vld1q_z_f32(x, p), s, p), p);
+		x += 4;
+		y += 4;
+	}
+#else
+	float *z = y;
+	size_t blocks = n >> 2;
+
+	if (blocks) {
+		__asm__ volatile (
+			RESUME_SYNTAX
+			"1:\n\t"
+			"vldmia %[x]!, {s0-s3}\n\t"
+			"vldmia %[y]!, {s4-s7}\n\t"
+			"vfma.f32 s4, s0, %[s]\n\t"
+			"vfma.f32 s5, s1, %[s]\n\t"
+			"vfma.f32 s6, s2, %[s]\n\t"
+			"vfma.f32 s7, s3, %[s]\n\t"
+			"vstmia %[z]!, {s4-s7}\n\t"
+			"subs %[cnt], %[cnt], #1\n\t"
+			"bne 1b\n\t"
+			: [x] "+r" (x), [y] "+r" (y), [z] "+r" (z),
+			  [cnt] "+r" (blocks)
+			: [s] "t" (s)
+			: "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+			  "cc", "memory");
+	}
+
+	for (size_t i = 0; i < (n & 3); i++) {
+		y[i] += s * x[i];
+	}
+#endif
+}
+#endif /* ZSL_ASM_ARM_F32 */
+
 #endif /* ZEPHYR_INCLUDE_ZSL_ASM_ARM_H_ */
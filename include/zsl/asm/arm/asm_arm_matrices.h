@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised matrix functions for zscilib using ARM Thumb2 or MVE.
+ *
+ * This file contains optimised matrix functions for ARM Thumb2 or ARM
+ * Helium (MVE).
+ */
+
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/asm/arm/asm_arm.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_ARM_MATRICES_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_ARM_MATRICES_H_
+
+#if !asm_mtx_mult
+#if ZSL_ASM_ARM_F32
+/**
+ * Assigns mc = ma * mb, where the dimensions have already been validated.
+ *
+ * Each row of 'mc' is built up as a sum of the rows of 'mb' scaled by the
+ * matching row of 'ma', so 'mb' and 'mc' are only ever read sequentially.
+ * The small caches (if any) of Cortex-M parts make blocking unnecessary.
+ */
+static inline void zsl_asm_mtx_mult(const struct zsl_mtx *ma,
+				    const struct zsl_mtx *mb,
+				    struct zsl_mtx *mc)
+{
+	const size_t p = ma->sz_cols;
+	const size_t n = mb->sz_cols;
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		float *c = &mc->data[i * n];
+
+		memset(c, 0, n * sizeof(zsl_real_t));
+		for (size_t k = 0; k < p; k++) {
+			asm_arm_f32_axpy(&mb->data[k * n], ma->data[i * p + k],
+					 c, n);
+		}
+	}
+}
+#define asm_mtx_mult 1
+#endif /* ZSL_ASM_ARM_F32 */
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_ARM_MATRICES_H_ */
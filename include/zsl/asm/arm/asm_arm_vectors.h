@@ -6,9 +6,10 @@
 
 /**
  * @file
- * @brief Optimised vector functions for zscilib using ARM Thumb or ARM Thumb2.
+ * @brief Optimised vector functions for zscilib using ARM Thumb, Thumb2 or MVE.
  *
- * This file contains optimised vector functions for ARM Thumb or ARM Thumb2.
+ * This file contains optimised vector functions for ARM Thumb, ARM Thumb2 or
+ * ARM Helium (MVE).
  */
 
 #include <zsl/zsl.h>
@@ -18,8 +19,9 @@
 #define ZEPHYR_INCLUDE_ZSL_ASM_ARM_VECTORS_H_
 
 #if !asm_vec_add
-#if CONFIG_ZSL_PLATFORM_OPT == 2
-int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+#if ZSL_ASM_ARM_F32
+int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure v and w are equal length. */
@@ -28,9 +30,7 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 	}
 #endif
 
-	for (size_t i = 0; i < v->sz; i++) {
-		x->data[i] = v->data[i] + w->data[i];
-	}
+	asm_arm_f32_add(v->data, w->data, x->data, v->sz);
 
 	return 0;
 }
@@ -38,6 +38,55 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 #endif
 #endif
 
+#if ZSL_ASM_ARM_F32
+/*
+ * Returns the dot product of 'a' and 'b', reducing each block of up to
+ * ZSL_VEC_PAIRWISE_BLOCK elements with asm_arm_f32_dot and adding the
+ * partial sums pairwise, as zsl_vec_pairwise does.
+ */
+static float asm_arm_vec_dot(const float *a, const float *b, size_t n)
+{
+	size_t h;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		h = (n / 2) & ~(size_t)3;
+		return asm_arm_vec_dot(a, b, h) +
+		       asm_arm_vec_dot(a + h, b + h, n - h);
+	}
+
+	return asm_arm_f32_dot(a, b, n);
+}
+#endif
+
+#if !asm_vec_dot
+#if ZSL_ASM_ARM_F32
+int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w, zsl_real_t *d)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	*d = asm_arm_vec_dot(v->data, w->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_dot 1
+#endif
+#endif
+
+#if !asm_vec_norm
+#if ZSL_ASM_ARM_F32
+zsl_real_t zsl_vec_norm(const struct zsl_vec *v)
+{
+	return ZSL_SQRT(asm_arm_vec_dot(v->data, v->data, v->sz));
+}
+#define asm_vec_norm 1
+#endif
+#endif
+
 #if !asm_vec_scalar_add
 #if CONFIG_ZSL_PLATFORM_OPT == 2
 /* TODO: ARM Thumb2 GNU implementation. */
@@ -54,18 +103,15 @@ int zsl_vec_scalar_add(struct zsl_vec *v, zsl_real_t s)
 #endif
 
 #if !asm_vec_scalar_mult
-#if CONFIG_ZSL_PLATFORM_OPT == 2
-/* TODO: ARM Thumb2 GNU implementation. */
+#if ZSL_ASM_ARM_F32
 int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s)
 {
-	for (size_t i = 0; i < v->sz; i++) {
-		v->data[i] *= s;
-	}
+	asm_arm_f32_scale(v->data, s, v->sz);
 
 	return 0;
 }
 #define asm_vec_scalar_mult 1
-#endif /* CONFIG_ZSL_PLATFORM_OPT == 2 */
+#endif /* ZSL_ASM_ARM_F32 */
 #endif
 
 #if !asm_vec_scalar_div
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief FFT functions for zscilib using the CMSIS-DSP library.
+ *
+ * This file routes the real FFT through CMSIS-DSP when
+ * CONFIG_ZSL_BACKEND_CMSIS_DSP is enabled. Sizes CMSIS-DSP doesn't support
+ * fall back to the generic implementation. The complex FFT always uses the
+ * generic implementation, since CMSIS-DSP expects interleaved data.
+ */
+
+#include <errno.h>
+#include <arm_math.h>
+#include <zsl/zsl.h>
+#include <zsl/fft.h>
+#include <zsl/workspace.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_FFT_H_
+#define ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_FFT_H_
+
+#if !CONFIG_ZSL_SINGLE_PRECISION
+#error "CONFIG_ZSL_BACKEND_CMSIS_DSP requires CONFIG_ZSL_SINGLE_PRECISION"
+#endif
+
+/*
+ * arm_rfft_fast_f32 can't work in place, so its output is placed in
+ * scratch memory and copied back. Its packed output layout matches that of
+ * zsl_fft_real.
+ */
+static int cmsis_dsp_fft_real(struct zsl_vec *v, bool inverse)
+{
+	int rc = 0;
+	arm_rfft_fast_instance_f32 s;
+	float32_t *out;
+
+	if ((v->sz < 2) || (v->sz > ZSL_FFT_MAX_N) ||
+	    (v->sz & (v->sz - 1)) != 0) {
+		return -EINVAL;
+	}
+
+	if (arm_rfft_fast_init_f32(&s, (uint16_t)v->sz) != ARM_MATH_SUCCESS) {
+		zsl_fft_real_c(v, inverse);
+		return 0;
+	}
+
+	ZSL_SCRATCH_DEF(ws, v->sz);
+	size_t mark = zsl_ws_mark(ws);
+
+	out = zsl_ws_alloc(ws, v->sz);
+	if (out == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	arm_rfft_fast_f32(&s, v->data, out, inverse ? 1 : 0);
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = out[i];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+#if !asm_fft_real
+int zsl_fft_real(struct zsl_vec *v)
+{
+	return cmsis_dsp_fft_real(v, false);
+}
+
+int zsl_ifft_real(struct zsl_vec *v)
+{
+	return cmsis_dsp_fft_real(v, true);
+}
+#define asm_fft_real 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_FFT_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Matrix functions for zscilib using the CMSIS-DSP library.
+ *
+ * This file routes common matrix functions through CMSIS-DSP when
+ * CONFIG_ZSL_BACKEND_CMSIS_DSP is enabled. It takes precedence over the
+ * ARM Thumb2/MVE implementations in asm_arm_matrices.h.
+ *
+ * CMSIS-DSP matrices store their dimensions as 16-bit values, which is
+ * far beyond the sizes that fit in the memory of a typical target.
+ */
+
+#include <errno.h>
+#include <arm_math.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/workspace.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_MATRICES_H_
+#define ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_MATRICES_H_
+
+#if !CONFIG_ZSL_SINGLE_PRECISION
+#error "CONFIG_ZSL_BACKEND_CMSIS_DSP requires CONFIG_ZSL_SINGLE_PRECISION"
+#endif
+
+/** Wraps the data in 'm' in a CMSIS-DSP matrix instance without copying. */
+static inline void
+zsl_cmsis_mtx(const struct zsl_mtx *m, arm_matrix_instance_f32 *a)
+{
+	arm_mat_init_f32(a, (uint16_t)m->sz_rows, (uint16_t)m->sz_cols,
+			 m->data);
+}
+
+#if !asm_mtx_mult
+/**
+ * Assigns mc = ma * mb, where the dimensions have already been validated by
+ * zsl_mtx_mult.
+ */
+static inline void zsl_asm_mtx_mult(const struct zsl_mtx *ma,
+				    const struct zsl_mtx *mb,
+				    struct zsl_mtx *mc)
+{
+	arm_matrix_instance_f32 a, b, c;
+
+	zsl_cmsis_mtx(ma, &a);
+	zsl_cmsis_mtx(mb, &b);
+	zsl_cmsis_mtx(mc, &c);
+	arm_mat_mult_f32(&a, &b, &c);
+}
+#define asm_mtx_mult 1
+#endif
+
+#if !asm_mtx_trans
+int zsl_mtx_trans(const struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	arm_matrix_instance_f32 a, b;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma and mb have the same shape. */
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_cmsis_mtx(ma, &a);
+	zsl_cmsis_mtx(mb, &b);
+	arm_mat_trans_f32(&a, &b);
+
+	return 0;
+}
+#define asm_mtx_trans 1
+#endif
+
+#if !asm_mtx_inv
+int zsl_mtx_inv(const struct zsl_mtx *m, struct zsl_mtx *mi)
+{
+	int rc;
+	struct zsl_mtx tmp;
+	arm_matrix_instance_f32 a, b;
+
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_inv_3x3(m, mi);
+	}
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mi' have the same shape. */
+	if (m->sz_rows != mi->sz_rows) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Shortcut for 4x4 matrices. */
+	if (m->sz_rows == 4) {
+		return zsl_mtx_inv_4x4(m, mi);
+	}
+
+	/* arm_mat_inverse_f32 overwrites its input, so invert a copy. */
+	ZSL_SCRATCH_DEF(ws, m->sz_rows * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &tmp, m->sz_rows, m->sz_cols);
+	if (rc) {
+		goto err;
+	}
+	zsl_mtx_copy(&tmp, m);
+
+	zsl_cmsis_mtx(&tmp, &a);
+	zsl_cmsis_mtx(mi, &b);
+
+	/* Leave 'mi' as an identity matrix if 'm' is singular. */
+	if (arm_mat_inverse_f32(&a, &b) != ARM_MATH_SUCCESS) {
+		zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+#define asm_mtx_inv 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_MATRICES_H_ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Vector functions for zscilib using the CMSIS-DSP library.
+ *
+ * This file routes common vector functions through CMSIS-DSP when
+ * CONFIG_ZSL_BACKEND_CMSIS_DSP is enabled. It takes precedence over the
+ * ARM Thumb/Thumb2/MVE implementations in asm_arm_vectors.h.
+ */
+
+#include <errno.h>
+#include <arm_math.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_VECTORS_H_
+#define ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_VECTORS_H_
+
+#if !CONFIG_ZSL_SINGLE_PRECISION
+#error "CONFIG_ZSL_BACKEND_CMSIS_DSP requires CONFIG_ZSL_SINGLE_PRECISION"
+#endif
+
+#if !asm_vec_add
+int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	arm_add_f32(v->data, w->data, x->data, (uint32_t)v->sz);
+
+	return 0;
+}
+#define asm_vec_add 1
+#endif
+
+/*
+ * Returns the dot product of 'a' and 'b', reducing each block of up to
+ * ZSL_VEC_PAIRWISE_BLOCK elements with arm_dot_prod_f32 and adding the
+ * partial sums pairwise, as zsl_vec_pairwise does.
+ */
+static float32_t zsl_cmsis_vec_dot(const float32_t *a, const float32_t *b,
+				   size_t n)
+{
+	float32_t d;
+	size_t h;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		h = (n / 2) & ~(size_t)3;
+		return zsl_cmsis_vec_dot(a, b, h) +
+		       zsl_cmsis_vec_dot(a + h, b + h, n - h);
+	}
+
+	arm_dot_prod_f32(a, b, (uint32_t)n, &d);
+
+	return d;
+}
+
+#if !asm_vec_dot
+int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w, zsl_real_t *d)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	*d = zsl_cmsis_vec_dot(v->data, w->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_dot 1
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CMSIS_DSP_VECTORS_H_ */
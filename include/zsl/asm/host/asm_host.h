@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised functions for zscilib using host SIMD instruction sets.
+ *
+ * This file contains vector kernels for x86 SSE2/AVX2 and AArch64 NEON,
+ * intended for native_posix and desktop builds. The instruction set is
+ * chosen from the compiler's target flags (e.g. '-mavx2 -mfma'), so the
+ * kernels are only used when the build target supports them.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_HOST_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_HOST_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+
+/*
+ * Each instruction set is described by a vector type holding ZSL_SIMD_W
+ * zsl_real_t lanes, and a small set of operations on that type. Loads and
+ * stores are unaligned by default, since vector and matrix data has no
+ * alignment guarantees beyond that of zsl_real_t. The kernels check their
+ * operands, and switch to the aligned forms when every operand is aligned
+ * to the vector width, as with ZSL_VECTOR_DEF_ALIGNED.
+ */
+#if defined(__AVX__)
+#include <immintrin.h>
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_SIMD_W              8
+#define zsl_simd_t              __m256
+#define ZSL_SIMD_ZERO()         _mm256_setzero_ps()
+#define ZSL_SIMD_SET1(s)        _mm256_set1_ps(s)
+#define ZSL_SIMD_LOAD(p)        _mm256_loadu_ps(p)
+#define ZSL_SIMD_STORE(p, a)    _mm256_storeu_ps(p, a)
+#define ZSL_SIMD_LOADA(p)       _mm256_load_ps(p)
+#define ZSL_SIMD_STOREA(p, a)   _mm256_store_ps(p, a)
+#define ZSL_SIMD_ADD(a, b)      _mm256_add_ps(a, b)
+#define ZSL_SIMD_MUL(a, b)      _mm256_mul_ps(a, b)
+#if defined(__FMA__)
+#define ZSL_SIMD_FMA(c, a, b)   _mm256_fmadd_ps(a, b, c)
+#endif
+#else
+#define ZSL_SIMD_W              4
+#define zsl_simd_t              __m256d
+#define ZSL_SIMD_ZERO()         _mm256_setzero_pd()
+#define ZSL_SIMD_SET1(s)        _mm256_set1_pd(s)
+#define ZSL_SIMD_LOAD(p)        _mm256_loadu_pd(p)
+#define ZSL_SIMD_STORE(p, a)    _mm256_storeu_pd(p, a)
+#define ZSL_SIMD_LOADA(p)       _mm256_load_pd(p)
+#define ZSL_SIMD_STOREA(p, a)   _mm256_store_pd(p, a)
+#define ZSL_SIMD_ADD(a, b)      _mm256_add_pd(a, b)
+#define ZSL_SIMD_MUL(a, b)      _mm256_mul_pd(a, b)
+#if defined(__FMA__)
+#define ZSL_SIMD_FMA(c, a, b)   _mm256_fmadd_pd(a, b, c)
+#endif
+#endif
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_SIMD_W              4
+#define zsl_simd_t              __m128
+#define ZSL_SIMD_ZERO()         _mm_setzero_ps()
+#define ZSL_SIMD_SET1(s)        _mm_set1_ps(s)
+#define ZSL_SIMD_LOAD(p)        _mm_loadu_ps(p)
+#define ZSL_SIMD_STORE(p, a)    _mm_storeu_ps(p, a)
+#define ZSL_SIMD_LOADA(p)       _mm_load_ps(p)
+#define ZSL_SIMD_STOREA(p, a)   _mm_store_ps(p, a)
+#define ZSL_SIMD_ADD(a, b)      _mm_add_ps(a, b)
+#define ZSL_SIMD_MUL(a, b)      _mm_mul_ps(a, b)
+#else
+#define ZSL_SIMD_W              2
+#define zsl_simd_t              __m128d
+#define ZSL_SIMD_ZERO()         _mm_setzero_pd()
+#define ZSL_SIMD_SET1(s)        _mm_set1_pd(s)
+#define ZSL_SIMD_LOAD(p)        _mm_loadu_pd(p)
+#define ZSL_SIMD_STORE(p, a)    _mm_storeu_pd(p, a)
+#define ZSL_SIMD_LOADA(p)       _mm_load_pd(p)
+#define ZSL_SIMD_STOREA(p, a)   _mm_store_pd(p, a)
+#define ZSL_SIMD_ADD(a, b)      _mm_add_pd(a, b)
+#define ZSL_SIMD_MUL(a, b)      _mm_mul_pd(a, b)
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_SIMD_W              4
+#define zsl_simd_t              float32x4_t
+#define ZSL_SIMD_ZERO()         vdupq_n_f32(0.0f)
+#define ZSL_SIMD_SET1(s)        vdupq_n_f32(s)
+#define ZSL_SIMD_LOAD(p)        vld1q_f32(p)
+#define ZSL_SIMD_STORE(p, a)    vst1q_f32(p, a)
+#define ZSL_SIMD_LOADA(p)       vld1q_f32(p)
+#define ZSL_SIMD_STOREA(p, a)   vst1q_f32(p, a)
+#define ZSL_SIMD_ADD(a, b)      vaddq_f32(a, b)
+#define ZSL_SIMD_MUL(a, b)      vmulq_f32(a, b)
+#define ZSL_SIMD_FMA(c, a, b)   vfmaq_f32(c, a, b)
+#else
+#define ZSL_SIMD_W              2
+#define zsl_simd_t              float64x2_t
+#define ZSL_SIMD_ZERO()         vdupq_n_f64(0.0)
+#define ZSL_SIMD_SET1(s)        vdupq_n_f64(s)
+#define ZSL_SIMD_LOAD(p)        vld1q_f64(p)
+#define ZSL_SIMD_STORE(p, a)    vst1q_f64(p, a)
+#define ZSL_SIMD_LOADA(p)       vld1q_f64(p)
+#define ZSL_SIMD_STOREA(p, a)   vst1q_f64(p, a)
+#define ZSL_SIMD_ADD(a, b)      vaddq_f64(a, b)
+#define ZSL_SIMD_MUL(a, b)      vmulq_f64(a, b)
+#define ZSL_SIMD_FMA(c, a, b)   vfmaq_f64(c, a, b)
+#endif
+#endif
+
+#ifdef ZSL_SIMD_W
+#define ZSL_ASM_HOST_SIMD 1
+
+#ifndef ZSL_SIMD_FMA
+#define ZSL_SIMD_FMA(c, a, b)   ZSL_SIMD_ADD(c, ZSL_SIMD_MUL(a, b))
+#endif
+
+/** The alignment in bytes required by ZSL_SIMD_LOADA and ZSL_SIMD_STOREA. */
+#define ZSL_SIMD_ALIGN          (ZSL_SIMD_W * sizeof(zsl_real_t))
+
+/** True if 'p' can be used with ZSL_SIMD_LOADA and ZSL_SIMD_STOREA. */
+#define ZSL_SIMD_IS_ALIGNED(p)  ZSL_IS_ALIGNED(p, ZSL_SIMD_ALIGN)
+
+/*
+ * Loads and stores that are aligned if 'al' is true. The kernels below are
+ * always inlined with a constant 'al', so each call site compiles to a
+ * single form.
+ */
+#define ZSL_SIMD_LD(al, p)      ((al) ? ZSL_SIMD_LOADA(p) : ZSL_SIMD_LOAD(p))
+#define ZSL_SIMD_ST(al, p, a)						\
+	do {								\
+		if (al) {						\
+			ZSL_SIMD_STOREA(p, a);				\
+		} else {						\
+			ZSL_SIMD_STORE(p, a);				\
+		}							\
+	} while (0)
+
+#define ZSL_SIMD_INLINE         static inline __attribute__((always_inline))
+
+/** Returns the sum of the lanes in 'a'. */
+static inline zsl_real_t asm_host_hsum(zsl_simd_t a)
+{
+	zsl_real_t l[ZSL_SIMD_W];
+	zsl_real_t sum = 0.0;
+
+	ZSL_SIMD_STORE(l, a);
+	for (size_t i = 0; i < ZSL_SIMD_W; i++) {
+		sum += l[i];
+	}
+
+	return sum;
+}
+
+/** Returns the dot product of the 'n' element arrays 'a' and 'b'. */
+ZSL_SIMD_INLINE zsl_real_t asm_host_dot_k(const zsl_real_t *a,
+					  const zsl_real_t *b, size_t n,
+					  const bool al)
+{
+	zsl_simd_t acc0 = ZSL_SIMD_ZERO();
+	zsl_simd_t acc1 = ZSL_SIMD_ZERO();
+	zsl_real_t sum;
+	size_t i = 0;
+
+	/* Two independent accumulators hide the add/FMA latency. */
+	for (; i + 2 * ZSL_SIMD_W <= n; i += 2 * ZSL_SIMD_W) {
+		acc0 = ZSL_SIMD_FMA(acc0, ZSL_SIMD_LD(al, &a[i]),
+				    ZSL_SIMD_LD(al, &b[i]));
+		acc1 = ZSL_SIMD_FMA(acc1, ZSL_SIMD_LD(al, &a[i + ZSL_SIMD_W]),
+				    ZSL_SIMD_LD(al, &b[i + ZSL_SIMD_W]));
+	}
+	for (; i + ZSL_SIMD_W <= n; i += ZSL_SIMD_W) {
+		acc0 = ZSL_SIMD_FMA(acc0, ZSL_SIMD_LD(al, &a[i]),
+				    ZSL_SIMD_LD(al, &b[i]));
+	}
+
+	sum = asm_host_hsum(ZSL_SIMD_ADD(acc0, acc1));
+	for (; i < n; i++) {
+		sum += a[i] * b[i];
+	}
+
+	return sum;
+}
+
+static inline zsl_real_t asm_host_dot(const zsl_real_t *a, const zsl_real_t *b,
+				      size_t n)
+{
+	if (ZSL_SIMD_IS_ALIGNED(a) && ZSL_SIMD_IS_ALIGNED(b)) {
+		return asm_host_dot_k(a, b, n, true);
+	}
+
+	return asm_host_dot_k(a, b, n, false);
+}
+
+/** Assigns x = a + b for the 'n' element arrays 'a', 'b' and 'x'. */
+ZSL_SIMD_INLINE void asm_host_add_k(const zsl_real_t *a, const zsl_real_t *b,
+				    zsl_real_t *x, size_t n, const bool al)
+{
+	size_t i = 0;
+
+	for (; i + ZSL_SIMD_W <= n; i += ZSL_SIMD_W) {
+		ZSL_SIMD_ST(al, &x[i], ZSL_SIMD_ADD(ZSL_SIMD_LD(al, &a[i]),
+						    ZSL_SIMD_LD(al, &b[i])));
+	}
+	for (; i < n; i++) {
+		x[i] = a[i] + b[i];
+	}
+}
+
+static inline void asm_host_add(const zsl_real_t *a, const zsl_real_t *b,
+				zsl_real_t *x, size_t n)
+{
+	if (ZSL_SIMD_IS_ALIGNED(a) && ZSL_SIMD_IS_ALIGNED(b) &&
+	    ZSL_SIMD_IS_ALIGNED(x)) {
+		asm_host_add_k(a, b, x, n, true);
+	} else {
+		asm_host_add_k(a, b, x, n, false);
+	}
+}
+
+/** Scales the 'n' element array 'x' by 's' in place. */
+ZSL_SIMD_INLINE void asm_host_scale_k(zsl_real_t *x, zsl_real_t s, size_t n,
+				      const bool al)
+{
+	zsl_simd_t vs = ZSL_SIMD_SET1(s);
+	size_t i = 0;
+
+	for (; i + ZSL_SIMD_W <= n; i += ZSL_SIMD_W) {
+		zsl_simd_t vx = ZSL_SIMD_LD(al, &x[i]);
+
+		ZSL_SIMD_ST(al, &x[i], ZSL_SIMD_MUL(vx, vs));
+	}
+	for (; i < n; i++) {
+		x[i] *= s;
+	}
+}
+
+static inline void asm_host_scale(zsl_real_t *x, zsl_real_t s, size_t n)
+{
+	if (ZSL_SIMD_IS_ALIGNED(x)) {
+		asm_host_scale_k(x, s, n, true);
+	} else {
+		asm_host_scale_k(x, s, n, false);
+	}
+}
+
+/** Accumulates y += s * x for the 'n' element arrays 'x' and 'y'. */
+ZSL_SIMD_INLINE void asm_host_axpy_k(const zsl_real_t *x, zsl_real_t s,
+				     zsl_real_t *y, size_t n, const bool al)
+{
+	zsl_simd_t vs = ZSL_SIMD_SET1(s);
+	size_t i = 0;
+
+	for (; i + ZSL_SIMD_W <= n; i += ZSL_SIMD_W) {
+		zsl_simd_t vy = ZSL_SIMD_LD(al, &y[i]);
+
+		vy = ZSL_SIMD_FMA(vy, ZSL_SIMD_LD(al, &x[i]), vs);
+		ZSL_SIMD_ST(al, &y[i], vy);
+	}
+	for (; i < n; i++) {
+		y[i] += s * x[i];
+	}
+}
+
+static inline void asm_host_axpy(const zsl_real_t *x, zsl_real_t s,
+				 zsl_real_t *y, size_t n)
+{
+	if (ZSL_SIMD_IS_ALIGNED(x) && ZSL_SIMD_IS_ALIGNED(y)) {
+		asm_host_axpy_k(x, s, y, n, true);
+	} else {
+		asm_host_axpy_k(x, s, y, n, false);
+	}
+}
+#endif /* ZSL_SIMD_W */
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_HOST_H_ */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised matrix functions for zscilib using host SIMD.
+ *
+ * This file contains optimised matrix functions for x86 SSE2/AVX2 or
+ * AArch64 NEON.
+ */
+
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/asm/host/asm_host.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_HOST_MATRICES_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_HOST_MATRICES_H_
+
+/*
+ * Two-lane vectors (SSE2 in double precision) give the same 4x4 tile as the
+ * generic blocked C code, which the compiler already vectorises, so only
+ * wider vectors use the SIMD kernel.
+ */
+#if !asm_mtx_mult
+#if ZSL_ASM_HOST_SIMD && (ZSL_SIMD_W >= 4)
+/** Number of rows of 'mb' kept in cache while a strip of 'mc' is built. */
+#define ZSL_ASM_HOST_MULT_KC 128
+
+/**
+ * Accumulates the rows [i, i + 4) and columns [j, j + 2 * ZSL_SIMD_W) of
+ * 'mc' with the products of 'ma' and 'mb' over [k0, k1), keeping the output
+ * tile in eight SIMD registers. Rows of 'b' and 'c' are accessed with
+ * aligned loads and stores if 'al' is true.
+ */
+ZSL_SIMD_INLINE void
+asm_host_mtx_mult_tile(const zsl_real_t *a, size_t lda, const zsl_real_t *b,
+		       size_t ldb, zsl_real_t *c, size_t ldc,
+		       size_t k0, size_t k1, const bool al)
+{
+	zsl_simd_t c00 = ZSL_SIMD_LD(al, &c[0 * ldc]);
+	zsl_simd_t c01 = ZSL_SIMD_LD(al, &c[0 * ldc + ZSL_SIMD_W]);
+	zsl_simd_t c10 = ZSL_SIMD_LD(al, &c[1 * ldc]);
+	zsl_simd_t c11 = ZSL_SIMD_LD(al, &c[1 * ldc + ZSL_SIMD_W]);
+	zsl_simd_t c20 = ZSL_SIMD_LD(al, &c[2 * ldc]);
+	zsl_simd_t c21 = ZSL_SIMD_LD(al, &c[2 * ldc + ZSL_SIMD_W]);
+	zsl_simd_t c30 = ZSL_SIMD_LD(al, &c[3 * ldc]);
+	zsl_simd_t c31 = ZSL_SIMD_LD(al, &c[3 * ldc + ZSL_SIMD_W]);
+
+	for (size_t k = k0; k < k1; k++) {
+		zsl_simd_t b0 = ZSL_SIMD_LD(al, &b[k * ldb]);
+		zsl_simd_t b1 = ZSL_SIMD_LD(al, &b[k * ldb + ZSL_SIMD_W]);
+		zsl_simd_t s;
+
+		s = ZSL_SIMD_SET1(a[0 * lda + k]);
+		c00 = ZSL_SIMD_FMA(c00, s, b0);
+		c01 = ZSL_SIMD_FMA(c01, s, b1);
+		s = ZSL_SIMD_SET1(a[1 * lda + k]);
+		c10 = ZSL_SIMD_FMA(c10, s, b0);
+		c11 = ZSL_SIMD_FMA(c11, s, b1);
+		s = ZSL_SIMD_SET1(a[2 * lda + k]);
+		c20 = ZSL_SIMD_FMA(c20, s, b0);
+		c21 = ZSL_SIMD_FMA(c21, s, b1);
+		s = ZSL_SIMD_SET1(a[3 * lda + k]);
+		c30 = ZSL_SIMD_FMA(c30, s, b0);
+		c31 = ZSL_SIMD_FMA(c31, s, b1);
+	}
+
+	ZSL_SIMD_ST(al, &c[0 * ldc], c00);
+	ZSL_SIMD_ST(al, &c[0 * ldc + ZSL_SIMD_W], c01);
+	ZSL_SIMD_ST(al, &c[1 * ldc], c10);
+	ZSL_SIMD_ST(al, &c[1 * ldc + ZSL_SIMD_W], c11);
+	ZSL_SIMD_ST(al, &c[2 * ldc], c20);
+	ZSL_SIMD_ST(al, &c[2 * ldc + ZSL_SIMD_W], c21);
+	ZSL_SIMD_ST(al, &c[3 * ldc], c30);
+	ZSL_SIMD_ST(al, &c[3 * ldc + ZSL_SIMD_W], c31);
+}
+
+/**
+ * Assigns mc = ma * mb, where the dimensions have already been validated.
+ *
+ * The bulk of 'mc' is built from 4 x (2 * ZSL_SIMD_W) register tiles, with
+ * the shared dimension processed in panels of ZSL_ASM_HOST_MULT_KC rows so
+ * the active part of 'mb' stays in cache. Leftover rows and columns are
+ * accumulated from the scaled rows of 'mb'. If 'mb' and 'mc' are aligned,
+ * as with ZSL_MATRIX_DEF_ALIGNED, and 'n' is a multiple of the SIMD width,
+ * every tile row is aligned too.
+ */
+static inline void zsl_asm_mtx_mult(const struct zsl_mtx *ma,
+				    const struct zsl_mtx *mb,
+				    struct zsl_mtx *mc)
+{
+	const size_t m = ma->sz_rows;
+	const size_t p = ma->sz_cols;
+	const size_t n = mb->sz_cols;
+	const size_t tw = 2 * ZSL_SIMD_W;
+	const size_t m4 = m - (m % 4);
+	const size_t nt = n - (n % tw);
+	const bool al = ZSL_SIMD_IS_ALIGNED(mb->data) &&
+			ZSL_SIMD_IS_ALIGNED(mc->data) &&
+			(n % ZSL_SIMD_W == 0);
+
+	memset(mc->data, 0, m * n * sizeof(zsl_real_t));
+
+	for (size_t k0 = 0; k0 < p; k0 += ZSL_ASM_HOST_MULT_KC) {
+		size_t k1 = (k0 + ZSL_ASM_HOST_MULT_KC < p) ?
+			    k0 + ZSL_ASM_HOST_MULT_KC : p;
+
+		for (size_t i = 0; i < m4; i += 4) {
+			for (size_t j = 0; j < nt; j += tw) {
+				const zsl_real_t *a = &ma->data[i * p];
+				const zsl_real_t *b = &mb->data[j];
+				zsl_real_t *c = &mc->data[i * n + j];
+
+				if (al) {
+					asm_host_mtx_mult_tile(a, p, b, n, c, n,
+							       k0, k1, true);
+				} else {
+					asm_host_mtx_mult_tile(a, p, b, n, c, n,
+							       k0, k1, false);
+				}
+			}
+		}
+
+		/* Leftover columns of the tiled rows, and leftover rows. */
+		for (size_t i = 0; i < m; i++) {
+			size_t j0 = (i < m4) ? nt : 0;
+
+			if (j0 == n) {
+				continue;
+			}
+			for (size_t k = k0; k < k1; k++) {
+				asm_host_axpy(&mb->data[k * n + j0],
+					      ma->data[i * p + k],
+					      &mc->data[i * n + j0], n - j0);
+			}
+		}
+	}
+}
+#define asm_mtx_mult 1
+#endif /* ZSL_ASM_HOST_SIMD && (ZSL_SIMD_W >= 4) */
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_HOST_MATRICES_H_ */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised vector functions for zscilib using host SIMD.
+ *
+ * This file contains optimised vector functions for x86 SSE2/AVX2 or
+ * AArch64 NEON.
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/asm/host/asm_host.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_HOST_VECTORS_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_HOST_VECTORS_H_
+
+#if !asm_vec_add
+#if ZSL_ASM_HOST_SIMD
+int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	asm_host_add(v->data, w->data, x->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_add 1
+#endif
+#endif
+
+#if !asm_vec_scalar_mult
+#if ZSL_ASM_HOST_SIMD
+int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s)
+{
+	asm_host_scale(v->data, s, v->sz);
+
+	return 0;
+}
+#define asm_vec_scalar_mult 1
+#endif
+#endif
+
+#if ZSL_ASM_HOST_SIMD
+/*
+ * Returns the dot product of 'a' and 'b', reducing each block of up to
+ * ZSL_VEC_PAIRWISE_BLOCK elements with asm_host_dot and adding the partial
+ * sums pairwise, as zsl_vec_pairwise does. The halves are split on a
+ * multiple of the vector width, so aligned inputs stay aligned.
+ */
+static zsl_real_t asm_host_vec_dot(const zsl_real_t *a, const zsl_real_t *b,
+				   size_t n)
+{
+	size_t h;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		h = (n / 2) & ~(size_t)(ZSL_SIMD_W - 1);
+		return asm_host_vec_dot(a, b, h) +
+		       asm_host_vec_dot(a + h, b + h, n - h);
+	}
+
+	return asm_host_dot(a, b, n);
+}
+#endif
+
+#if !asm_vec_dot
+#if ZSL_ASM_HOST_SIMD
+int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w, zsl_real_t *d)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	*d = asm_host_vec_dot(v->data, w->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_dot 1
+#endif
+#endif
+
+#if !asm_vec_norm
+#if ZSL_ASM_HOST_SIMD
+zsl_real_t zsl_vec_norm(const struct zsl_vec *v)
+{
+	return ZSL_SQRT(asm_host_vec_dot(v->data, v->data, v->sz));
+}
+#define asm_vec_norm 1
+#endif
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_HOST_VECTORS_H_ */
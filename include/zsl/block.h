@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup BLOCK Block Processing
+ *
+ * @brief Double-buffered blocks of samples, passed through a fixed chain of
+ *        processing stages.
+ *
+ * For continuous acquisition, a DMA channel or ISR fills one block of
+ * samples while a worker thread processes the other. The stages, such as a
+ * filter, a statistics update and a measurement encoder, are registered
+ * once with @ref zsl_blk_add_stage, and each completed block is passed
+ * through them in order by @ref zsl_blk_process. Both blocks are allocated
+ * when the processor is declared, so nothing is allocated or copied per
+ * block: every stage works on the block in place.
+ *
+ * The producer and consumer synchronise through the free-running 'head'
+ * and 'tail' block counts, as in @ref FUSION_QUEUE, so neither side takes a
+ * lock or disables interrupts. On Zephyr, the consumer can also sleep until
+ * a block is ready.
+ */
+
+/**
+ * @file
+ * @brief API header file for block processing in zscilib.
+ *
+ * This file contains the zscilib block processing APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_BLOCK_H_
+#define ZEPHYR_INCLUDE_ZSL_BLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup BLK_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for block processing.
+ *
+ * @ingroup BLOCK
+ *  @{ */
+
+/**
+ * @brief The alignment of the block buffers and counters, which should be
+ *        the data cache line size of the target, or the alignment that the
+ *        DMA controller requires if that is larger.
+ */
+#ifndef ZSL_BLK_ALIGN
+#define ZSL_BLK_ALIGN           (32)
+#endif
+
+/**
+ * @brief A processing stage, which works on block 'v' in place.
+ *
+ * A stage may reduce v->sz, for example when decimating, in which case the
+ * later stages see the shorter block. It must not increase it.
+ *
+ * @param v     The block.
+ * @param arg   The argument given to @ref zsl_blk_add_stage.
+ *
+ * @return 0 to pass the block to the next stage, or a negative error code
+ *         to stop processing the block.
+ */
+typedef int (*zsl_blk_stage_fn_t)(struct zsl_vec *v, void *arg);
+
+/** @brief One registered processing stage. */
+struct zsl_blk_stage {
+	/** The stage function. */
+	zsl_blk_stage_fn_t fn;
+	/** The argument passed to 'fn'. */
+	void *arg;
+};
+
+/**
+ * @brief A double-buffered block processor. Declare with
+ *        @ref ZSL_BLK_DEF, and set up with @ref zsl_blk_init.
+ */
+struct zsl_blk {
+	/** The number of samples in each block. */
+	size_t sz;
+	/** The two blocks, of 'sz' samples each. */
+	zsl_real_t *buf[2];
+	/** The registered stages, in the order they run. */
+	struct zsl_blk_stage *stages;
+	/** The number of entries in 'stages'. */
+	size_t max_stages;
+	/** The number of stages registered. */
+	size_t nstages;
+	/** The number of blocks completed. Written by the producer. */
+	uint32_t head __attribute__((aligned(ZSL_BLK_ALIGN)));
+	/** The number of samples pushed into the current block. */
+	uint32_t pos;
+	/**
+	 * The number of samples or blocks dropped because both blocks were
+	 * waiting to be processed. Written by the producer.
+	 */
+	uint32_t overruns;
+	/** The number of blocks processed. Written by the consumer. */
+	uint32_t tail __attribute__((aligned(ZSL_BLK_ALIGN)));
+	/** The number of blocks stopped by a failing stage. */
+	uint32_t errors;
+#ifdef __ZEPHYR__
+	/** Given each time the producer completes a block. */
+	struct k_sem ready;
+#endif
+};
+
+/**
+ * Macro to declare a block processor with two blocks of 'n' samples and
+ * room for 'ns' stages. The blocks are static, so this should be used at
+ * file scope.
+ */
+#define ZSL_BLK_DEF(name, n, ns)					\
+	static zsl_real_t name ## _blk[2][n]				\
+	__attribute__((aligned(ZSL_BLK_ALIGN)));			\
+	static struct zsl_blk_stage name ## _stg[ns];			\
+	struct zsl_blk name = {						\
+		.sz = n,						\
+		.buf = { name ## _blk[0], name ## _blk[1] },		\
+		.stages = name ## _stg,					\
+		.max_stages = ns,					\
+	}
+
+/** @} */ /* End of BLK_STRUCTS group */
+
+/**
+ * @addtogroup BLK_FUNCS Functions
+ *
+ * @brief Block processing functions.
+ *
+ * Only one context may produce blocks, with @ref zsl_blk_push or with
+ * @ref zsl_blk_fill_buf and @ref zsl_blk_commit, and only one may consume
+ * them with @ref zsl_blk_process. The producer functions are safe to call
+ * from an ISR.
+ *
+ * @ingroup BLOCK
+ *  @{ */
+
+/**
+ * @brief Empties block processor 'b' and removes all of its stages.
+ *
+ * @param b     The block processor.
+ *
+ * @return 0 on success, or -EINVAL if 'b' has no buffers.
+ */
+int zsl_blk_init(struct zsl_blk *b);
+
+/**
+ * @brief Adds a stage to the end of the chain of 'b'. Stages should be
+ *        added before the first block is produced.
+ *
+ * @param b     The block processor.
+ * @param fn    The stage function.
+ * @param arg   The argument passed to 'fn'.
+ *
+ * @return 0 on success, -EINVAL if 'fn' is NULL, or -ENOMEM if 'b' already
+ *         has 'max_stages' stages.
+ */
+int zsl_blk_add_stage(struct zsl_blk *b, zsl_blk_stage_fn_t fn, void *arg);
+
+/**
+ * @brief Returns the block that the producer should fill next, such as the
+ *        destination of the next DMA transfer of 'sz' samples.
+ *
+ * @param b     The block processor.
+ *
+ * @return The block, or NULL if both blocks are waiting to be processed.
+ */
+static inline zsl_real_t *zsl_blk_fill_buf(struct zsl_blk *b)
+{
+	uint32_t head = b->head;
+
+	if (head - __atomic_load_n(&b->tail, __ATOMIC_ACQUIRE) >= 2) {
+		return NULL;
+	}
+
+	return b->buf[head & 1];
+}
+
+/**
+ * @brief Marks the block returned by @ref zsl_blk_fill_buf as complete and
+ *        passes it to the consumer, for example from a DMA completion ISR.
+ *
+ * @param b     The block processor.
+ *
+ * @return 0 on success, or -ENOBUFS if there was no block to fill, in which
+ *         case 'overruns' is incremented.
+ */
+int zsl_blk_commit(struct zsl_blk *b);
+
+/**
+ * @brief Adds one sample to the block being filled, and passes the block to
+ *        the consumer once it holds 'sz' samples.
+ *
+ * @param b     The block processor.
+ * @param x     The sample.
+ *
+ * @return 0 on success, or -ENOBUFS if both blocks are waiting to be
+ *         processed, in which case the sample is dropped and 'overruns'
+ *         is incremented.
+ */
+int zsl_blk_push(struct zsl_blk *b, zsl_real_t x);
+
+/**
+ * @brief Passes the oldest completed block through every stage of 'b' in
+ *        order, then returns it to the producer.
+ *
+ * If a stage fails, the later stages are skipped and 'errors' is
+ * incremented, but the block is still returned to the producer, so a bad
+ * block cannot stall acquisition.
+ *
+ * @param b     The block processor.
+ * @param wait  If true, sleep until a block is ready. This is only possible
+ *              on Zephyr, and is ignored elsewhere.
+ *
+ * @return 0 on success, -EAGAIN if no block was ready, or the error code of
+ *         the failing stage.
+ */
+int zsl_blk_process(struct zsl_blk *b, bool wait);
+
+/**
+ * @brief A stage that runs FIR filter 'arg' over the block with
+ *        @ref zsl_fir_process.
+ */
+int zsl_blk_stage_fir(struct zsl_vec *v, void *arg);
+
+/**
+ * @brief A stage that runs IIR filter 'arg' over the block with
+ *        @ref zsl_iir_process.
+ */
+int zsl_blk_stage_iir(struct zsl_vec *v, void *arg);
+
+/** @} */ /* End of BLK_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_BLOCK_H_ */
+
+/** @} */ /* End of BLOCK group */
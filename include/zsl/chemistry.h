@@ -20,7 +20,9 @@
 #ifndef ZEPHYR_INCLUDE_ZSL_CHEMISTRY_H_
 #define ZEPHYR_INCLUDE_ZSL_CHEMISTRY_H_
 
+#include <stdint.h>
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -174,6 +176,174 @@ enum zsl_chem_elements {
  */
 extern const zsl_real_t zsl_chem_atom_weight[119];
 
+/**
+ * @brief Static properties of a chemical element.
+ */
+struct zsl_chem_elem_props {
+	/** The element's symbol, such as "He", null-terminated. */
+	char sym[3];
+	/** The period (row) of the periodic table, from 1 to 7. */
+	uint8_t period;
+	/**
+	 * The IUPAC group (column) of the periodic table, from 1 to 18, or 0
+	 * for the lanthanides and actinides other than lutetium and
+	 * lawrencium, which sit outside the eighteen columns.
+	 */
+	uint8_t group;
+};
+
+/**
+ * @brief Properties of every element, indexed directly by
+ *        @ref zsl_chem_elements, with an empty entry at index 0.
+ *
+ * The table is const, so it stays in flash, and a lookup is a single
+ * indexed load.
+ */
+extern const struct zsl_chem_elem_props zsl_chem_elem_props[119];
+
+/**
+ * @brief One element of a chemical formula, and the number of its atoms.
+ */
+struct zsl_chem_term {
+	/** The element, as a @ref zsl_chem_elements value. */
+	uint8_t elem;
+	/** The number of atoms of the element in one formula unit. */
+	uint16_t count;
+};
+
+/**
+ * @brief A precompiled chemical formula.
+ *
+ * The formula is parsed or checked once, by @ref zsl_chem_formula_parse or
+ * @ref zsl_chem_formula_init, which also caches its molar mass, so later
+ * conversions don't need to look up any elements.
+ */
+struct zsl_chem_formula {
+	/** The number of terms, or the capacity of 'terms' when parsing. */
+	size_t sz;
+	/** The terms of the formula. The same element may appear twice. */
+	struct zsl_chem_term *terms;
+	/** The molar mass in g/mol, set by init or parse. */
+	zsl_real_t mm;
+};
+
+/** Macro to declare a formula with room for 'n' terms, to be filled by
+ * @ref zsl_chem_formula_parse.
+ */
+#define ZSL_CHEM_FORMULA_DEF(fname, n)				\
+	struct zsl_chem_term fname ## _terms[n];		\
+	struct zsl_chem_formula fname = {			\
+		.sz = n,					\
+		.terms = fname ## _terms,			\
+		.mm = 0.0					\
+	}
+
+/** @} */ /* End of CHEM_STRUCTS group */
+
+/**
+ * @addtogroup CHEM_FUNCS Functions
+ *
+ * @brief Chemistry functions.
+ *
+ * @ingroup CHEMISTRY
+ *  @{ */
+
+/**
+ * @brief Returns the standard atomic weight of element 'e' in g/mol, or 0.0
+ *        if 'e' isn't a valid element or has no standard atomic weight.
+ */
+static inline zsl_real_t zsl_chem_elem_weight(enum zsl_chem_elements e)
+{
+	if ((unsigned int)e > ZSL_CHEM_ELEM_OGANESSON) {
+		return 0.0;
+	}
+
+	return zsl_chem_atom_weight[e];
+}
+
+/**
+ * @brief Finds the element with symbol 'sym'.
+ *
+ * @param sym   The element's symbol, such as "Fe". Case sensitive.
+ * @param e     The element found.
+ *
+ * @return 0 on success, or -EINVAL if no element has this symbol.
+ */
+int zsl_chem_elem_find(const char *sym, enum zsl_chem_elements *e);
+
+/**
+ * @brief Checks the terms of formula 'f' and caches its molar mass.
+ *
+ * @param f     The formula, with 'sz' and 'terms' set.
+ *
+ * @return 0 on success, or -EINVAL if a term has an invalid element, or an
+ *         element without a standard atomic weight.
+ */
+int zsl_chem_formula_init(struct zsl_chem_formula *f);
+
+/**
+ * @brief Parses a simple formula such as "CO2" or "CH3CH2OH" into 'f', and
+ *        caches its molar mass.
+ *
+ * Each element symbol may be followed by a count, which defaults to 1.
+ * Parentheses, hydrates and charges aren't supported.
+ *
+ * @param s     The formula to parse, null-terminated.
+ * @param f     The formula, whose 'sz' gives the capacity of 'terms' on
+ *              entry, and the number of terms used on return.
+ *
+ * @return 0 on success, -EINVAL if 's' isn't a valid formula, or -ENOMEM if
+ *         it has more terms than 'f' can hold.
+ */
+int zsl_chem_formula_parse(const char *s, struct zsl_chem_formula *f);
+
+/**
+ * @brief Converts gas concentrations in parts per million by volume (umol
+ *        per mol) to mass concentrations in mg/m^3, for an ideal gas of
+ *        formula 'f' at temperature 't' and pressure 'p'.
+ *
+ * The molar density of the mixture, p / RT, is computed once with
+ * @ref zsl_phy_gas_press, so each sample costs one multiplication.
+ *
+ * @param f     The gas, initialised by init or parse.
+ * @param t     The temperature in kelvins.
+ * @param p     The pressure in pascals.
+ * @param ppm   The concentrations in ppm.
+ * @param mg    The output concentrations in mg/m^3. This may be 'ppm'.
+ *
+ * @return 0 on success, or -EINVAL if 't' or 'p' isn't positive, or the
+ *         vectors differ in size.
+ */
+int zsl_chem_ppm_to_mgm3(const struct zsl_chem_formula *f, zsl_real_t t,
+			 zsl_real_t p, const struct zsl_vec *ppm,
+			 struct zsl_vec *mg);
+
+/**
+ * @brief Converts mass concentrations in mg/m^3 to parts per million by
+ *        volume. This is the inverse of @ref zsl_chem_ppm_to_mgm3.
+ */
+int zsl_chem_mgm3_to_ppm(const struct zsl_chem_formula *f, zsl_real_t t,
+			 zsl_real_t p, const struct zsl_vec *mg,
+			 struct zsl_vec *ppm);
+
+/**
+ * @brief Converts gas concentrations in parts per million by volume to
+ *        molarity, in mol/L, for an ideal gas at temperature 't' and
+ *        pressure 'p'. This doesn't depend on the gas.
+ *
+ * @param t     The temperature in kelvins.
+ * @param p     The pressure in pascals.
+ * @param ppm   The concentrations in ppm.
+ * @param mol   The output concentrations in mol/L. This may be 'ppm'.
+ *
+ * @return 0 on success, or -EINVAL if 't' or 'p' isn't positive, or the
+ *         vectors differ in size.
+ */
+int zsl_chem_ppm_to_molar(zsl_real_t t, zsl_real_t p,
+			  const struct zsl_vec *ppm, struct zsl_vec *mol);
+
+/** @} */ /* End of CHEM_FUNCS group */
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,10 +21,13 @@
 #ifndef ZEPHYR_INCLUDE_ZSL_COLORIMETRY_H_
 #define ZEPHYR_INCLUDE_ZSL_COLORIMETRY_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/measurement/measurement.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -249,7 +252,33 @@ enum zsl_clr_uv_cct_method {
 	 * Highly accurate between 2,600 and 20,000 K, making it the ideal
 	 * choice for artifical lighting.
 	 */
-	ZSL_CLR_UV_CCT_METHOD_OHNO2014
+	ZSL_CLR_UV_CCT_METHOD_OHNO2014,
+
+	/**
+	 * @brief Yoshi Ohno 2014, with a cascade search of the Planckian
+	 * lookup table.
+	 *
+	 * Gives the same results as ZSL_CLR_UV_CCT_METHOD_OHNO2014 for (u,v)
+	 * values near the Planckian locus, but compares against 1/8th of the
+	 * table before refining the match, rather than the full table.
+	 */
+	ZSL_CLR_UV_CCT_METHOD_OHNO2014_CASCADE
+};
+
+/**
+ * @brief The cone response model to use in a chromatic adaptation
+ *        transform.
+ */
+enum zsl_clr_cat_method {
+	/**
+	 * @brief The Bradford transform, as used by ICC profiles.
+	 */
+	ZSL_CLR_CAT_METHOD_BRADFORD = 0,
+
+	/**
+	 * @brief The CIECAM02 CAT02 transform, with full adaptation.
+	 */
+	ZSL_CLR_CAT_METHOD_CAT02
 };
 
 /**
@@ -523,6 +552,256 @@ struct zsl_clr_spd {
 	} comps[];  /**< The spectral component data that makes up the spd. */
 };
 
+/**
+ * @brief Spectral power distribution held as separate wavelength and value
+ *        arrays.
+ *
+ * Holds the same data as @ref zsl_clr_spd, but with the values stored
+ * contiguously in a vector, so that large, high resolution SPDs can be
+ * scanned and scaled without stepping over the wavelengths. Declare the
+ * spd and its storage with @ref ZSL_CLR_SPD_SOA_DEF.
+ */
+struct zsl_clr_spd_soa {
+	/** The wavelength in nm of each sample. */
+	unsigned int *nm;
+	/** The relative value of each sample. */
+	struct zsl_vec values;
+};
+
+/**
+ * Macro to declare a structure-of-arrays spd with 'n' samples.
+ *
+ * Be sure to also fill in 'nm' and 'values' after this macro, since
+ * neither is initialised.
+ */
+#define ZSL_CLR_SPD_SOA_DEF(name, n)			 \
+	unsigned int name ## _nm[n];			 \
+	zsl_real_t name ## _v[n];			 \
+	struct zsl_clr_spd_soa name = {			 \
+		.nm = name ## _nm,			 \
+		.values = {				 \
+			.sz = n,			 \
+			.data = name ## _v		 \
+		}					 \
+	}
+
+/**
+ * @brief Precomputed luminous efficiency weights for integrating spectral
+ *        samples taken at fixed wavelengths.
+ *
+ * 'w' holds the luminous efficiency function resampled at each wavelength
+ * in 'nm', multiplied by the width in nm that the sample covers, so an
+ * integration is a single dot product. Declare the weights and their
+ * storage with @ref ZSL_CLR_LEF_WEIGHTS_DEF.
+ */
+struct zsl_clr_lef_weights {
+	/** The luminous efficiency function used for the weights. */
+	enum zsl_clr_lef lef;
+	/** Set once 'w' holds the weights for the values above and 'nm'. */
+	bool valid;
+	/** The wavelength in nm of each sample, as last compiled. */
+	unsigned int *nm;
+	/** The weight of each sample. */
+	struct zsl_vec w;
+};
+
+/**
+ * Macro to declare luminous efficiency weights for 'n' samples.
+ *
+ * Be sure to also call 'zsl_clr_lef_weights_compile' on the weights after
+ * this macro, since they are not initialised.
+ */
+#define ZSL_CLR_LEF_WEIGHTS_DEF(name, n)		 \
+	unsigned int name ## _nm[n];			 \
+	zsl_real_t name ## _w[n];			 \
+	struct zsl_clr_lef_weights name = {		 \
+		.valid = false,				 \
+		.nm = name ## _nm,			 \
+		.w = {					 \
+			.sz = n,			 \
+			.data = name ## _w		 \
+		}					 \
+	}
+
+/**
+ * @brief Precomputed weights for converting spectral samples taken at
+ *        fixed wavelengths into an XYZ tristimulus.
+ *
+ * Row 0, 1 and 2 of 'w' hold the X, Y and Z weight of each sample, so a
+ * conversion is three dot products. Declare the converter and its storage
+ * with @ref ZSL_CLR_SPD_XYZ_CONV_DEF.
+ */
+struct zsl_clr_spd_xyz_conv {
+	/** The CIE standard observer model used for the weights. */
+	enum zsl_clr_obs observer;
+	/** The 3 x n X, Y and Z weights of the n samples. */
+	struct zsl_mtx w;
+};
+
+/**
+ * Macro to declare a converter for spectral data of 'n' samples.
+ *
+ * Be sure to also call 'zsl_clr_conv_spd_xyz_compile' on the converter
+ * after this macro, since the weights are not initialised.
+ */
+#define ZSL_CLR_SPD_XYZ_CONV_DEF(name, n)		 \
+	zsl_real_t name ## _w[3 * (n)];			 \
+	struct zsl_clr_spd_xyz_conv name = {		 \
+		.w = {					 \
+			.sz_rows = 3,			 \
+			.sz_cols = n,			 \
+			.data = name ## _w		 \
+		}					 \
+	}
+
+/**
+ * @brief A precompiled pipeline from spectral sensor channel counts to a
+ *        CIE 1960 CCT and Duv pair.
+ *
+ * 'conv' holds the channel weights, including any per-channel calibration
+ * gain, so each sample is three dot products followed by the CCT search.
+ * 'hint' carries the last Planckian table match between samples when an
+ * Ohno 2014 method is used. Declare the pipeline and its storage with
+ * @ref ZSL_CLR_CCT_PIPE_DEF.
+ */
+struct zsl_clr_cct_pipe {
+	/** The compiled channel count to XYZ converter. */
+	struct zsl_clr_spd_xyz_conv conv;
+	/** The CCT and Duv algorithm to use. */
+	enum zsl_clr_uv_cct_method method;
+	/** The last Planckian table match, or zero. */
+	size_t hint;
+	/** The CCT and Duv payload of the last measurement. */
+	zsl_real_t out[2];
+};
+
+/**
+ * Macro to declare a CCT pipeline for a sensor with 'n' channels.
+ *
+ * Be sure to also call 'zsl_clr_cct_pipe_compile' on the pipeline after
+ * this macro, since the weights are not initialised.
+ */
+#define ZSL_CLR_CCT_PIPE_DEF(name, n)			 \
+	zsl_real_t name ## _w[3 * (n)];			 \
+	struct zsl_clr_cct_pipe name = {		 \
+		.conv = {				 \
+			.w = {				 \
+				.sz_rows = 3,		 \
+				.sz_cols = n,		 \
+				.data = name ## _w	 \
+			}				 \
+		}					 \
+	}
+
+/**
+ * @brief A chromatic adaptation transform between two standard illuminants.
+ *
+ * 'm' holds the combined 3x3 cone response, scaling and inverse cone
+ * response matrix, so an adaptation is a single 3x3 multiply. Declare the
+ * transform and its storage with @ref ZSL_CLR_CAT_DEF.
+ */
+struct zsl_clr_cat {
+	/** The cone response model used for 'm'. */
+	enum zsl_clr_cat_method method;
+	/** The CIE standard observer model of both illuminants. */
+	enum zsl_clr_obs observer;
+	/** The source illuminant. */
+	enum zsl_clr_illum src;
+	/** The destination illuminant. */
+	enum zsl_clr_illum dst;
+	/** Set once 'm' holds the transform for the values above. */
+	bool valid;
+	/** The 3x3 XYZ to XYZ adaptation matrix. */
+	struct zsl_mtx m;
+};
+
+/**
+ * Macro to declare a chromatic adaptation transform.
+ *
+ * Be sure to also call 'zsl_clr_conv_cat_compile' on the transform after
+ * this macro, since the matrix is not initialised.
+ */
+#define ZSL_CLR_CAT_DEF(name)				 \
+	zsl_real_t name ## _m[9];			 \
+	struct zsl_clr_cat name = {			 \
+		.valid = false,				 \
+		.m = {					 \
+			.sz_rows = 3,			 \
+			.sz_cols = 3,			 \
+			.data = name ## _m		 \
+		}					 \
+	}
+
+/** The lowest color temperature covered by a @ref zsl_clr_ct_lut, in K. */
+#define ZSL_CLR_CT_LUT_MIN 1000.0
+
+/** The highest color temperature covered by a @ref zsl_clr_ct_lut, in K. */
+#define ZSL_CLR_CT_LUT_MAX 25000.0
+
+/**
+ * @brief A color temperature to XYZ lookup table for one standard observer.
+ *
+ * Row 'i' of 'xz' holds the X and Z values (Y = 1.0) of the Planckian
+ * radiator at the i'th of 'xz.sz_rows' points spaced evenly in reciprocal
+ * temperature from ZSL_CLR_CT_LUT_MIN to ZSL_CLR_CT_LUT_MAX, which keeps
+ * the interpolation error roughly constant across the range. The number
+ * of points sets the precision. Declare the table and its storage with
+ * @ref ZSL_CLR_CT_LUT_DEF.
+ */
+struct zsl_clr_ct_lut {
+	/** The CIE standard observer model used for the table. */
+	enum zsl_clr_obs observer;
+	/** Set once 'xz' holds the table for 'observer'. */
+	bool valid;
+	/** The n x 2 X and Z values. */
+	struct zsl_mtx xz;
+};
+
+/**
+ * Macro to declare a color temperature lookup table of 'n' points, which
+ * must be at least two.
+ *
+ * Be sure to also call 'zsl_clr_ct_lut_compile' on the table after this
+ * macro, since the values are not initialised.
+ */
+#define ZSL_CLR_CT_LUT_DEF(name, n)			 \
+	zsl_real_t name ## _xz[2 * (n)];		 \
+	struct zsl_clr_ct_lut name = {			 \
+		.valid = false,				 \
+		.xz = {					 \
+			.sz_rows = n,			 \
+			.sz_cols = 2,			 \
+			.data = name ## _xz		 \
+		}					 \
+	}
+
+/**
+ * @brief The running normal equations of a least-squares fit of a 3x3
+ *        sensor RGB to XYZ color correction matrix to measured patches.
+ *
+ * Only the weighted sums of the products of the patch values are kept, so
+ * any number of patches can be added in constant memory, in any order.
+ * Start a fit with @ref zsl_clr_ccm_fit_init.
+ */
+struct zsl_clr_ccm_fit {
+	/** The weighted sum of rgb * rgb^T, row-major. */
+	zsl_real_t rr[9];
+	/** The weighted sum of rgb * xyz^T, row-major. */
+	zsl_real_t rx[9];
+	/** The weighted sum of xyz^T * xyz. */
+	zsl_real_t xx;
+	/** The sum of the weights. */
+	zsl_real_t w;
+	/** The number of patches added. */
+	size_t n;
+};
+
+/** The number of entries in the sRGB encoding lookup table. */
+#define ZSL_CLR_SRGB_ENC_LUT_SZ 4096
+
+/** The number of entries in the sRGB decoding lookup table. */
+#define ZSL_CLR_SRGB_DEC_LUT_SZ 256
+
 /** @} */ /* End of STRUCT group */
 
 /**
@@ -546,6 +825,161 @@ struct zsl_clr_spd {
 int zsl_clr_conv_spd_xyz(const struct zsl_clr_spd *spd, enum zsl_clr_obs obs,
 			 struct zsl_clr_xyz *xyz);
 
+/**
+ * @brief Converts the supplied structure-of-arrays spectral power
+ * distribution into it's equivalent XYZ tristimulus using the specified
+ * standard observer model.
+ *
+ * Gives the same result as @ref zsl_clr_conv_spd_xyz for an spd holding
+ * the same wavelengths and values.
+ *
+ * @param spd   Pointer to the spectral power distribution data to use.
+ * @param obs   The CIE standard observer model to use for the conversion.
+ * @param xyz   Pointer to the placeholder for the output XYZ tristimulus.
+ *
+ * @returns 0 on normal execution, otherwise an appropriate error code.
+ */
+int zsl_clr_conv_spd_soa_xyz(const struct zsl_clr_spd_soa *spd,
+			     enum zsl_clr_obs obs, struct zsl_clr_xyz *xyz);
+
+/**
+ * @brief Precomputes the weights of converter 'c' for spectral samples at
+ *        the fixed wavelengths 'nm', such as the channels of a spectral
+ *        sensor.
+ *
+ * The weights are the observer's colour matching functions at each
+ * wavelength, as used by @ref zsl_clr_conv_spd_xyz, optionally multiplied
+ * by a per-sample gain such as an illuminant's relative power or a sensor
+ * calibration factor. Wavelengths outside 360..830 nm get a weight of 0.
+ *
+ * @param c     The converter, whose 'w' has one column per sample.
+ * @param nm    The wavelength in nm of each sample.
+ * @param gain  The gain of each sample, or NULL for no gain.
+ * @param obs   The CIE standard observer model to use for the conversion.
+ *
+ * @returns 0 on success, or -EINVAL if 'w' doesn't have three rows, 'gain'
+ *          is the wrong size, or no wavelength is in range.
+ */
+int zsl_clr_conv_spd_xyz_compile(struct zsl_clr_spd_xyz_conv *c,
+				 const unsigned int *nm,
+				 const struct zsl_vec *gain,
+				 enum zsl_clr_obs obs);
+
+/**
+ * @brief Converts spectral samples into their XYZ tristimulus, scaled to
+ *        Y = 1.0, using converter 'c'.
+ *
+ * With no gain, this gives the same result as @ref zsl_clr_conv_spd_xyz
+ * for an spd holding the same wavelengths and values.
+ *
+ * @param c       The converter, from @ref zsl_clr_conv_spd_xyz_compile.
+ * @param values  The value of each sample, in the order of 'nm'.
+ * @param xyz     Pointer to the placeholder for the output XYZ tristimulus.
+ *
+ * @returns 0 on success, or -EINVAL if 'values' is the wrong size or the
+ *          resulting Y is zero.
+ */
+int zsl_clr_conv_spd_xyz_compiled(const struct zsl_clr_spd_xyz_conv *c,
+				  const struct zsl_vec *values,
+				  struct zsl_clr_xyz *xyz);
+
+/**
+ * @brief Compiles a channel count to CCT pipeline.
+ *
+ * @param p       Pointer to the pipeline, declared with ZSL_CLR_CCT_PIPE_DEF.
+ * @param nm      The wavelength of each sensor channel, in nm.
+ * @param gain    The calibration gain to apply to each channel's count, or
+ *                NULL to use the counts as is.
+ * @param obs     The CIE standard observer model to use.
+ * @param method  The CCT and Duv algorithm to use.
+ *
+ * @return 0 on success, error code on failure, as for
+ *         @ref zsl_clr_conv_spd_xyz_compile.
+ */
+int zsl_clr_cct_pipe_compile(struct zsl_clr_cct_pipe *p,
+			     const unsigned int *nm, const struct zsl_vec *gain,
+			     enum zsl_clr_obs obs,
+			     enum zsl_clr_uv_cct_method method);
+
+/**
+ * @brief Converts one sample of sensor channel counts to a CIE 1960 CCT
+ *        and Duv pair.
+ *
+ * Gives the same result as normalising the calibrated counts, and then
+ * calling @ref zsl_clr_conv_spd_xyz, @ref zsl_clr_conv_xyz_uv60 and
+ * @ref zsl_clr_conv_uv60_cct in turn.
+ *
+ * @param p       Pointer to the compiled pipeline.
+ * @param counts  The count of each sensor channel.
+ * @param cct     Pointer to the output CCT and Duv pair.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int zsl_clr_cct_pipe_run(struct zsl_clr_cct_pipe *p,
+			 const struct zsl_vec *counts, struct zsl_clr_cct *cct);
+
+/**
+ * @brief Converts one sample of sensor channel counts to a CCT and Duv
+ *        measurement.
+ *
+ * The measurement has a ZSL_MES_TYPE_COLOR base type, a
+ * ZSL_MES_EXT_TYPE_COLOR_CIE1960_CCT_DUV extended type and a
+ * ZSL_MES_UNIT_SI_KELVIN unit, and its payload points to the CCT and Duv
+ * values in 'p->out', which are overwritten by the next call.
+ *
+ * @param p       Pointer to the compiled pipeline.
+ * @param counts  The count of each sensor channel.
+ * @param mes     Pointer to the output measurement.
+ *
+ * @return 0 on success, error code on failure, in which case 'mes' is
+ *         left unchanged.
+ */
+int zsl_clr_cct_pipe_mes(struct zsl_clr_cct_pipe *p,
+			 const struct zsl_vec *counts,
+			 struct zsl_measurement *mes);
+
+/**
+ * @brief Computes the chromatic adaptation transform from illuminant 'src'
+ *        to illuminant 'dst', using the standard illuminant data for
+ *        observer 'obs'.
+ *
+ * If 'cat' already holds the transform for the same method, observer and
+ * illuminants, it is kept as is, so this can be called before each batch
+ * of adaptations at little cost.
+ *
+ * @param cat     Pointer to the transform, declared with ZSL_CLR_CAT_DEF.
+ * @param method  The cone response model to use.
+ * @param obs     The CIE standard observer model of the illuminant data.
+ * @param src     The illuminant the input values are relative to.
+ * @param dst     The illuminant the output values should be relative to.
+ *
+ * @return 0 on success, -EINVAL if either illuminant is not available for
+ *         'obs', or 'method' is unknown.
+ */
+int zsl_clr_conv_cat_compile(struct zsl_clr_cat *cat,
+			     enum zsl_clr_cat_method method,
+			     enum zsl_clr_obs obs, enum zsl_clr_illum src,
+			     enum zsl_clr_illum dst);
+
+/**
+ * @brief Adapts an array of CIE 1931 XYZ tristimulus values using a
+ *        transform computed by @ref zsl_clr_conv_cat_compile.
+ *
+ * The output observer and illuminant are set from 'cat', and the invalid
+ * flags are copied from the input. 'in' and 'out' may point to the same
+ * array.
+ *
+ * @param cat   Pointer to the compiled transform.
+ * @param in    Pointer to the 'n' input XYZ values, relative to 'cat->src'.
+ * @param out   Pointer to the 'n' output XYZ values.
+ * @param n     The number of values to adapt.
+ *
+ * @return 0 on success, -EINVAL if 'cat' has not been compiled.
+ */
+int zsl_clr_conv_xyz_cat(const struct zsl_clr_cat *cat,
+			 const struct zsl_clr_xyz *in, struct zsl_clr_xyz *out,
+			 size_t n);
+
 /**
  * @brief Converts a CIE 1931 xyY chromaticity to its XYZ tristimulus
  *        equivalent.
@@ -670,7 +1104,56 @@ int zsl_clr_conv_ct_xyz(zsl_real_t ct, enum zsl_clr_obs obs,
  * @return 0 on success, error code on failure.
  */
 int zsl_clr_conv_ct_rgb8(zsl_real_t ct, enum zsl_clr_obs obs,
-			 struct zsl_mtx *mtx, struct zsl_clr_rgb8 *rgb);
+			 const struct zsl_mtx *mtx, struct zsl_clr_rgb8 *rgb);
+
+/**
+ * @brief Fills in lookup table 'lut' for observer 'obs' using
+ *        @ref zsl_clr_conv_ct_xyz.
+ *
+ * The table is left untouched if it already holds the data for 'obs'.
+ *
+ * @param lut   The table, declared with ZSL_CLR_CT_LUT_DEF.
+ * @param obs   The CIE standard observer model to use for the conversion.
+ *
+ * @return 0 on success, or -EINVAL if the table has fewer than two points
+ *         or the observer data is not available.
+ */
+int zsl_clr_ct_lut_compile(struct zsl_clr_ct_lut *lut, enum zsl_clr_obs obs);
+
+/**
+ * @brief Converts an exact CIE 1960 CCT (Duv = 0.0) to a CIE 1931 XYZ
+ *        tristimulus, interpolating from lookup table 'lut'.
+ *
+ * Color temperatures outside ZSL_CLR_CT_LUT_MIN..ZSL_CLR_CT_LUT_MAX, or
+ * any color temperature when 'exact' is set, are evaluated directly with
+ * @ref zsl_clr_conv_ct_xyz.
+ *
+ * @param lut   The table, from @ref zsl_clr_ct_lut_compile.
+ * @param ct    The color temperature to use.
+ * @param exact Set to evaluate Planck's law rather than use the table.
+ * @param xyz   Pointer to the output CIE 1931 XYZ tristimulus.
+ *
+ * @return 0 on success, or -EINVAL if the table is not compiled.
+ */
+int zsl_clr_conv_ct_xyz_lut(const struct zsl_clr_ct_lut *lut, zsl_real_t ct,
+			    bool exact, struct zsl_clr_xyz *xyz);
+
+/**
+ * @brief Converts an exact CIE 1960 CCT (Duv = 0.0) to an 8-bit RGBA value
+ *        using lookup table 'lut' and the supplied XYZ to RGB color space
+ *        correlation matrix.
+ *
+ * @param lut   The table, from @ref zsl_clr_ct_lut_compile.
+ * @param ct    The color temperature to use.
+ * @param exact Set to evaluate Planck's law rather than use the table.
+ * @param mtx   Pointer to the 3x3 XYZ to RGB color space correlation matrix.
+ * @param rgb   Pointer to the output zsl_clr_rgb8 value.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int zsl_clr_conv_ct_rgb8_lut(const struct zsl_clr_ct_lut *lut, zsl_real_t ct,
+			     bool exact, const struct zsl_mtx *mtx,
+			     struct zsl_clr_rgb8 *rgb);
 
 /**
  * @brief Converts an exact CIE 1960 CCT (Duv = 0.0) to an floating point RGBA
@@ -684,7 +1167,7 @@ int zsl_clr_conv_ct_rgb8(zsl_real_t ct, enum zsl_clr_obs obs,
  * @return 0 on success, error code on failure.
  */
 int zsl_clr_conv_ct_rgbf(zsl_real_t ct, enum zsl_clr_obs obs,
-			 struct zsl_mtx *mtx, struct zsl_clr_rgbf *rgb);
+			 const struct zsl_mtx *mtx, struct zsl_clr_rgbf *rgb);
 
 /**
  * @brief Converts a CIE 1960 CCT and Duv pair to a CIE 1931 xyY chromaticity.
@@ -723,6 +1206,25 @@ int zsl_clr_conv_cct_xyz(struct zsl_clr_cct *cct, enum zsl_clr_obs obs,
 int zsl_clr_conv_uv60_cct(enum zsl_clr_uv_cct_method method,
 			  struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct);
 
+/**
+ * @brief Converts a CIE 1960 (u, v) pair to a CIE 1960 CCT and Duv
+ *        pair using Ohno 2014, starting the lookup table search from the
+ *        match of a previous call.
+ *
+ * For a stream of slowly changing readings, keep one hint per stream,
+ * initialised to zero. The search then walks a few table entries from the
+ * last match rather than searching the whole table.
+ *
+ * @param uv        Pointer to input CIE 1960 (u, v) pair.
+ * @param cct       Pointer to output zsl_clr_cct.
+ * @param hint      The table index of the last match, updated on return,
+ *                  or zero to search from scratch.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int zsl_clr_conv_uv60_cct_ohno2014_hint(struct zsl_clr_uv60 *uv,
+					struct zsl_clr_cct *cct, size_t *hint);
+
 /**
  * @brief Converts a CIE 1931 XYZ tristimulus to an 8-bit RGBA value
  *        using the supplied XYZ to RGB color space correlation matrix.
@@ -733,7 +1235,7 @@ int zsl_clr_conv_uv60_cct(enum zsl_clr_uv_cct_method method,
  *
  * @return 0 on success, error code on failure.
  */
-int zsl_clr_conv_xyz_rgb8(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
+int zsl_clr_conv_xyz_rgb8(struct zsl_clr_xyz *xyz, const struct zsl_mtx *mtx,
 			  struct zsl_clr_rgb8 *rgb);
 
 /**
@@ -750,9 +1252,178 @@ int zsl_clr_conv_xyz_rgb8(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
  *
  * @return 0 on success, error code on failure.
  */
-int zsl_clr_conv_xyz_rgbf(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
+int zsl_clr_conv_xyz_rgbf(struct zsl_clr_xyz *xyz, const struct zsl_mtx *mtx,
 			  struct zsl_clr_rgbf *rgb);
 
+/**
+ * @brief Converts an array of CIE 1931 XYZ tristimulus values to floating
+ *        point RGBA values using the supplied XYZ to RGB color space
+ *        correlation matrix.
+ *
+ * The results, including the out of gamut flags, are the same as calling
+ * @ref zsl_clr_conv_xyz_rgbf on each entry, but the correlation matrix is
+ * only checked and loaded once for the entire array.
+ *
+ * @param xyz   Pointer to the 'n' input CIE 1931 XYZ tristimulus values.
+ * @param mtx   Pointer to the 3x3 XYZ to RGB color space correlation matrix.
+ * @param rgb   Pointer to the 'n' output zsl_clr_rgbf values.
+ * @param n     The number of values to convert.
+ *
+ * @return 0 on success, -EINVAL if 'mtx' is not 3x3.
+ */
+int zsl_clr_conv_xyz_rgbf_arr(const struct zsl_clr_xyz *xyz,
+			      const struct zsl_mtx *mtx,
+			      struct zsl_clr_rgbf *rgb, size_t n);
+
+/**
+ * @brief Converts an array of CIE 1931 XYZ tristimulus values to 8-bit RGBA
+ *        values using the supplied XYZ to RGB color space correlation
+ *        matrix, and an optional 8-bit output lookup table.
+ *
+ * Each channel is limited to 0.0..1.0 and then, if 'lut' is NULL, scaled
+ * by 255 as in @ref zsl_clr_conv_xyz_rgb8. Otherwise, the channel value
+ * is rounded to the nearest of 'lut_sz' evenly spaced table entries, with
+ * entry 0 at 0.0 and entry 'lut_sz' - 1 at 1.0, which is returned as is.
+ * This allows a transfer function to be applied at no extra cost.
+ *
+ * @param xyz     Pointer to the 'n' input CIE 1931 XYZ tristimulus values.
+ * @param mtx     Pointer to the 3x3 XYZ to RGB color space correlation
+ *                matrix.
+ * @param rgb     Pointer to the 'n' output zsl_clr_rgb8 values.
+ * @param n       The number of values to convert.
+ * @param lut     Pointer to the output lookup table, or NULL.
+ * @param lut_sz  The number of entries in 'lut', at least 2 if used.
+ *
+ * @return 0 on success, -EINVAL if 'mtx' is not 3x3 or 'lut_sz' is too
+ *         small.
+ */
+int zsl_clr_conv_xyz_rgb8_arr(const struct zsl_clr_xyz *xyz,
+			      const struct zsl_mtx *mtx,
+			      struct zsl_clr_rgb8 *rgb, size_t n,
+			      const uint8_t *lut, size_t lut_sz);
+
+/**
+ * @brief Converts planar CIE 1931 XYZ tristimulus values to planar floating
+ *        point RGB values using the supplied XYZ to RGB color space
+ *        correlation matrix.
+ *
+ * Rows 0, 1 and 2 of 'xyz' hold the X, Y and Z planes, each with one
+ * column per pixel, and rows 0, 1 and 2 of 'rgb' receive the red, green
+ * and blue planes. If CONFIG_ZSL_CLR_RGBF_BOUND_CAP is enabled, the output
+ * values are limited to 0.0..1.0. No out of gamut flags are produced.
+ *
+ * @param mtx   Pointer to the 3x3 XYZ to RGB color space correlation matrix.
+ * @param xyz   Pointer to the 3xn input XYZ planes.
+ * @param rgb   Pointer to the 3xn output RGB planes.
+ *
+ * @return 0 on success, -EINVAL on a size mismatch.
+ */
+int zsl_clr_conv_xyz_rgbf_planar(const struct zsl_mtx *mtx,
+				 const struct zsl_mtx *xyz,
+				 struct zsl_mtx *rgb);
+
+/**
+ * @brief Converts planar CIE 1931 XYZ tristimulus values to interleaved
+ *        8-bit RGB pixels, three bytes per pixel, using the supplied XYZ
+ *        to RGB color space correlation matrix and an optional 8-bit
+ *        output lookup table.
+ *
+ * The 8-bit conversion and the use of 'lut' are as described for
+ * @ref zsl_clr_conv_xyz_rgb8_arr.
+ *
+ * @param mtx     Pointer to the 3x3 XYZ to RGB color space correlation
+ *                matrix.
+ * @param xyz     Pointer to the 3xn input XYZ planes.
+ * @param rgb     Pointer to the 3 * n byte output buffer.
+ * @param lut     Pointer to the output lookup table, or NULL.
+ * @param lut_sz  The number of entries in 'lut', at least 2 if used.
+ *
+ * @return 0 on success, -EINVAL if 'mtx' is not 3x3, 'xyz' does not have
+ *         three rows or 'lut_sz' is too small.
+ */
+int zsl_clr_conv_xyz_rgb888(const struct zsl_mtx *mtx,
+			    const struct zsl_mtx *xyz, uint8_t *rgb,
+			    const uint8_t *lut, size_t lut_sz);
+
+/**
+ * @brief Applies the sRGB transfer function to an array of linear floating
+ *        point RGBA values.
+ *
+ * The red, green and blue channels are limited to 0.0..1.0 and encoded,
+ * while the alpha channel and the out of gamut flags are copied as is.
+ * 'rgb' and 'srgb' may point to the same array.
+ *
+ * @param rgb   Pointer to the 'n' input linear zsl_clr_rgbf values.
+ * @param srgb  Pointer to the 'n' output sRGB encoded zsl_clr_rgbf values.
+ * @param n     The number of values to convert.
+ *
+ * @return 0 on success.
+ */
+int zsl_clr_conv_rgbf_srgbf(const struct zsl_clr_rgbf *rgb,
+			    struct zsl_clr_rgbf *srgb, size_t n);
+
+/**
+ * @brief Removes the sRGB transfer function from an array of sRGB encoded
+ *        floating point RGBA values.
+ *
+ * The red, green and blue channels are limited to 0.0..1.0 and decoded,
+ * while the alpha channel and the out of gamut flags are copied as is.
+ * 'srgb' and 'rgb' may point to the same array.
+ *
+ * @param srgb  Pointer to the 'n' input sRGB encoded zsl_clr_rgbf values.
+ * @param rgb   Pointer to the 'n' output linear zsl_clr_rgbf values.
+ * @param n     The number of values to convert.
+ *
+ * @return 0 on success.
+ */
+int zsl_clr_conv_srgbf_rgbf(const struct zsl_clr_rgbf *srgb,
+			    struct zsl_clr_rgbf *rgb, size_t n);
+
+/**
+ * @brief Converts an array of linear floating point RGBA values to sRGB
+ *        encoded 8-bit RGBA values.
+ *
+ * The red, green and blue channels are limited to 0.0..1.0, encoded and
+ * rounded to 8-bits, while the alpha channel is scaled and rounded without
+ * encoding. The out of gamut flags are copied as is.
+ *
+ * If 'fast' is true and CONFIG_ZSL_CLR_SRGB_LUT is enabled, the encoding
+ * is read from the table returned by @ref zsl_clr_srgb_lut_get, rounding
+ * the input to the nearest of ZSL_CLR_SRGB_ENC_LUT_SZ steps. The result
+ * may then differ from the exact encoding by one. Otherwise, the transfer
+ * function is evaluated for each channel.
+ *
+ * @param rgb   Pointer to the 'n' input linear zsl_clr_rgbf values.
+ * @param srgb  Pointer to the 'n' output sRGB encoded zsl_clr_rgb8 values.
+ * @param n     The number of values to convert.
+ * @param fast  Whether to use the encoding lookup table when available.
+ *
+ * @return 0 on success.
+ */
+int zsl_clr_conv_rgbf_srgb8(const struct zsl_clr_rgbf *rgb,
+			    struct zsl_clr_rgb8 *srgb, size_t n, bool fast);
+
+/**
+ * @brief Converts an array of sRGB encoded 8-bit RGBA values to linear
+ *        floating point RGBA values.
+ *
+ * The red, green and blue channels are decoded, while the alpha channel is
+ * scaled without decoding. The out of gamut flags are copied as is.
+ *
+ * If 'fast' is true and CONFIG_ZSL_CLR_SRGB_LUT is enabled, the decoding
+ * is read from the table returned by @ref zsl_clr_srgb_lut_get, which
+ * gives the same result as evaluating the transfer function.
+ *
+ * @param srgb  Pointer to the 'n' input sRGB encoded zsl_clr_rgb8 values.
+ * @param rgb   Pointer to the 'n' output linear zsl_clr_rgbf values.
+ * @param n     The number of values to convert.
+ * @param fast  Whether to use the decoding lookup table when available.
+ *
+ * @return 0 on success.
+ */
+int zsl_clr_conv_srgb8_rgbf(const struct zsl_clr_rgb8 *srgb,
+			    struct zsl_clr_rgbf *rgb, size_t n, bool fast);
+
 /** @} */ /* End of CONV group */
 
 /**
@@ -773,8 +1444,104 @@ int zsl_clr_conv_xyz_rgbf(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
  */
 int zsl_clr_norm_spd(struct zsl_clr_spd *spd);
 
+/**
+ * @brief Normalises the supplied structure-of-arrays spectral power
+ * distribution data to a 1.0 range. This function call is destructive to
+ * the input values.
+ *
+ * @param spd   Pointer to the spectral power distribution data to normalise.
+ *
+ * @returns 0 on normal execution, otherwise an appropriate error code.
+ */
+int zsl_clr_norm_spd_soa(struct zsl_clr_spd_soa *spd);
+
 /** @} */ /* End of NORM group */
 
+/**
+ * @addtogroup CCM_FIT Color Correction Matrix Fitting Functions
+ *
+ * Functions to fit a color correction matrix to a sensor from measured
+ * patches, such as the 24 patches of a color checker chart.
+ *
+ * Each patch pairs the linear RGB reading of the sensor with the reference
+ * XYZ tristimulus of the patch. The fitted 3x3 matrix 'M' minimizes the
+ * weighted sum of |M * rgb - xyz|^2 over the patches, and is found from the
+ * 3x3 normal equations with a Cholesky decomposition.
+ *
+ * @ingroup COLORIMETRY
+ *  @{ */
+
+/**
+ * @brief Starts a new fit, with no patches.
+ *
+ * @param fit   The fit to reset.
+ *
+ * @returns 0 on normal execution.
+ */
+int zsl_clr_ccm_fit_init(struct zsl_clr_ccm_fit *fit);
+
+/**
+ * @brief Adds one patch to the fit.
+ *
+ * @param fit   The fit.
+ * @param rgb   The linear sensor reading of the patch. The alpha channel
+ *              is ignored.
+ * @param xyz   The reference XYZ tristimulus of the patch.
+ * @param w     The weight of the patch, such as a larger weight for the
+ *              neutral patches to keep the white balance accurate.
+ *
+ * @returns 0 on normal execution, or -EINVAL if 'w' is negative or either
+ *          value is flagged as invalid.
+ */
+int zsl_clr_ccm_fit_feed(struct zsl_clr_ccm_fit *fit,
+			 const struct zsl_clr_rgbf *rgb,
+			 const struct zsl_clr_xyz *xyz, zsl_real_t w);
+
+/**
+ * @brief Adds 'n' patches with a weight of 1.0 to the fit.
+ *
+ * @param fit   The fit.
+ * @param rgb   The 'n' linear sensor readings.
+ * @param xyz   The 'n' reference XYZ tristimulus values.
+ * @param n     The number of patches.
+ *
+ * @returns 0 on normal execution, or -EINVAL if any value is flagged as
+ *          invalid, in which case no patches are added.
+ */
+int zsl_clr_ccm_fit_feed_arr(struct zsl_clr_ccm_fit *fit,
+			     const struct zsl_clr_rgbf *rgb,
+			     const struct zsl_clr_xyz *xyz, size_t n);
+
+/**
+ * @brief Solves the fit for the color correction matrix.
+ *
+ * Without 'rgbccm', 'ccm' maps sensor RGB to XYZ. With one of the XYZ to RGB
+ * matrices of @ref zsl_clr_rgbccm_get, 'ccm' is their product, which maps
+ * sensor RGB straight to that linear RGB space in a single 3x3 multiply.
+ * Either can be passed to @ref zsl_clr_conv_xyz_rgbf, or to
+ * @ref zsl_clr_conv_xyz_rgb8 and its array form, with the sensor reading
+ * in the xyz_x, xyz_y and xyz_z fields of the input.
+ *
+ * The fit isn't changed, so more patches can be added and the fit solved
+ * again.
+ *
+ * @param fit     The fit.
+ * @param rgbccm  Pointer to a 3x3 XYZ to RGB matrix to apply after the fit,
+ *                or NULL.
+ * @param ccm     Pointer to the 3x3 output matrix.
+ * @param rms     If not NULL, set to the weighted root-mean-square XYZ
+ *                error of the fitted matrix over the patches.
+ *
+ * @returns 0 on normal execution, -EINVAL if a matrix isn't 3x3 or the
+ *          fit has no weight, or -ENOTPOSDEF if the sensor readings don't
+ *          span all three channels, such as with fewer than three patches.
+ */
+int zsl_clr_ccm_fit_solve(const struct zsl_clr_ccm_fit *fit,
+			  const struct zsl_mtx *rgbccm, struct zsl_mtx *ccm,
+			  zsl_real_t *rms);
+
+/** @} */ /* End of CCM_FIT group */
+
 /**
  * @addtogroup COLOR_DATA Data Access Functions
  *
@@ -824,11 +1591,13 @@ int zsl_clr_illum_get(enum zsl_clr_obs obs, enum zsl_clr_illum illum,
  * @brief   Retrieves a pointer to the zsl_clr_obs_data for the specified
  *          CIE standard observer model.
  *
+ * The data is looked up directly by observer. The 10 degree observer is
+ * only available when CONFIG_ZSL_CLR_OBS_10_DEG is enabled, otherwise
+ * '*data' is set to NULL.
+ *
  * @param obs   The standard observer whose data should be retrieved.
  * @param data  Pointer to the pointer where the const zsl_clr_obs_data should
- *              be made accessible.
- *
- * @returns 0 on normal execution, otherwise an appropriate error code.
+ *              be made accessible, or NULL if it is not available.
  *
  * @b Example
  *
@@ -872,6 +1641,42 @@ void zsl_clr_lef_get(enum zsl_clr_lef lef, const struct zsl_clr_spd **data);
  */
 int zsl_clr_lef_lerp(enum zsl_clr_lef lef, unsigned int nm, zsl_real_t *val);
 
+/**
+ * @brief   Resamples the specified CIE luminous efficiency function onto
+ *          the sample wavelengths 'nm' in a single pass over the table.
+ *
+ * Each weight is the interpolated efficiency at that wavelength, as per
+ * @ref zsl_clr_lef_lerp, times half the distance between its neighbouring
+ * wavelengths, giving a trapezoidal integration. The weights are left
+ * untouched if they already hold the data for 'lef' and 'nm'.
+ *
+ * @param lw    The weights, declared with ZSL_CLR_LEF_WEIGHTS_DEF.
+ * @param lef   The luminous efficiency function to use.
+ * @param nm    The wavelength in nm of each sample, in ascending order.
+ *
+ * @returns 0 on normal execution, or -EINVAL if the wavelengths are not
+ *          in ascending order.
+ */
+int zsl_clr_lef_weights_compile(struct zsl_clr_lef_weights *lw,
+				enum zsl_clr_lef lef, const unsigned int *nm);
+
+/**
+ * @brief   Integrates the product of spectral samples and the luminous
+ *          efficiency function over wavelength using weights 'lw'.
+ *
+ * For spectral irradiance samples in W/m^2/nm, multiplying the result by
+ * 683 lm/W (photopic) or 1700 lm/W (scotopic) gives the illuminance in lux.
+ *
+ * @param lw     The weights, from @ref zsl_clr_lef_weights_compile.
+ * @param values The value of each sample, in the order of 'nm'.
+ * @param integ  Pointer to the integral's placeholder.
+ *
+ * @returns 0 on normal execution, or -EINVAL if the weights are not
+ *          compiled or 'values' is the wrong size.
+ */
+int zsl_clr_lef_integ(const struct zsl_clr_lef_weights *lw,
+		      const struct zsl_vec *values, zsl_real_t *integ);
+
 /**
  * @brief   Retrieves a pointer to a standard 3x3 XYZ to RGB color space
  *          correlation matrix.
@@ -882,7 +1687,27 @@ int zsl_clr_lef_lerp(enum zsl_clr_lef lef, unsigned int nm, zsl_real_t *val);
  *
  * @returns 0 on normal execution, otherwise an appropriate error code.
  */
-void zsl_clr_rgbccm_get(enum zsl_clr_rgb_ccm ccm, struct zsl_mtx **mtx);
+void zsl_clr_rgbccm_get(enum zsl_clr_rgb_ccm ccm,
+			const struct zsl_mtx **mtx);
+
+/**
+ * @brief   Retrieves pointers to the sRGB transfer function lookup tables.
+ *
+ * Entry 'i' of the ZSL_CLR_SRGB_ENC_LUT_SZ entry encoding table holds the
+ * rounded 8-bit sRGB encoding of the linear value i / 4095, so it can also
+ * be passed to @ref zsl_clr_conv_xyz_rgb8_arr and
+ * @ref zsl_clr_conv_xyz_rgb888. Entry 'i' of the ZSL_CLR_SRGB_DEC_LUT_SZ
+ * entry decoding table holds the linear value of the encoded value i / 255.
+ *
+ * @param enc   Pointer to the pointer where the encoding table should be
+ *              made accessible.
+ * @param dec   Pointer to the pointer where the decoding table should be
+ *              made accessible.
+ *
+ * @returns 0 on normal execution, or -ENOTSUP if CONFIG_ZSL_CLR_SRGB_LUT
+ *          is disabled, in which case both pointers are set to NULL.
+ */
+int zsl_clr_srgb_lut_get(const uint8_t **enc, const zsl_real_t **dec);
 
 /** @} */ /* End of COLOR_DATA group */
 
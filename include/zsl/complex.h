@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup COMPLEX Complex Numbers
+ *
+ * @brief Complex scalars, vectors and matrices.
+ *
+ * Complex values are made up of two zsl_real_t parts, so they follow the
+ * precision selected with CONFIG_ZSL_SINGLE_PRECISION. C99 'complex' isn't
+ * used, since its availability and precision vary between toolchains.
+ *
+ * Complex vectors and matrices store their real and imaginary parts in two
+ * separate arrays rather than interleaved, so each kernel works on plain
+ * arrays of zsl_real_t that the compiler can vectorise, and a real vector
+ * or matrix can be used as either part without being copied.
+ */
+
+/**
+ * @file
+ * @brief API header file for complex numbers in zscilib.
+ *
+ * This file contains the zscilib complex number APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_COMPLEX_H_
+#define ZEPHYR_INCLUDE_ZSL_COMPLEX_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CPLX_STRUCTS Structs and Macros
+ *
+ * @brief Various structs and macros related to complex numbers.
+ *
+ * @ingroup COMPLEX
+ *  @{ */
+
+/** @brief Represents a complex number, re + im * i. */
+struct zsl_cplx {
+	/** The real part. */
+	zsl_real_t re;
+	/** The imaginary part. */
+	zsl_real_t im;
+};
+
+/** @brief Represents a vector of complex numbers. */
+struct zsl_cvec {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The real parts of the elements. */
+	zsl_real_t *re;
+	/** The imaginary parts of the elements. */
+	zsl_real_t *im;
+};
+
+/** @brief Represents a row-major matrix of complex numbers. */
+struct zsl_cmtx {
+	/** The number of rows in the matrix (typically denoted as 'm'). */
+	size_t sz_rows;
+	/** The number of columns in the matrix (typically denoted as 'n'). */
+	size_t sz_cols;
+	/** The real parts of the elements, in row-major order. */
+	zsl_real_t *re;
+	/** The imaginary parts of the elements, in row-major order. */
+	zsl_real_t *im;
+};
+
+/** Macro to declare a complex vector of size `n`.
+ *
+ * Be sure to also call 'zsl_cvec_init' on the vector after this macro, since
+ * vectors declared on the stack may have non-zero values by default!
+ */
+#define ZSL_CVEC_DEF(vname, n)			\
+	zsl_real_t vname ## _re[n];		\
+	zsl_real_t vname ## _im[n];		\
+	struct zsl_cvec vname = {		\
+		.sz = n,			\
+		.re = vname ## _re,		\
+		.im = vname ## _im		\
+	}
+
+/** Macro to declare a complex matrix of size `m` rows by `n` columns.
+ *
+ * Be sure to also call 'zsl_cmtx_init' on the matrix after this macro,
+ * since matrices declared on the stack may have non-zero values by default!
+ */
+#define ZSL_CMTX_DEF(mname, m, n)		\
+	zsl_real_t mname ## _re[(m) * (n)];	\
+	zsl_real_t mname ## _im[(m) * (n)];	\
+	struct zsl_cmtx mname = {		\
+		.sz_rows = m,			\
+		.sz_cols = n,			\
+		.re = mname ## _re,		\
+		.im = mname ## _im		\
+	}
+
+/** @} */ /* End of CPLX_STRUCTS group */
+
+/**
+ * @addtogroup CPLX_SCALAR Scalar Functions
+ *
+ * @brief Arithmetic on single complex numbers.
+ *
+ * @ingroup COMPLEX
+ *  @{ */
+
+/** @brief Returns a + b. */
+static inline struct zsl_cplx zsl_cplx_add(struct zsl_cplx a,
+					   struct zsl_cplx b)
+{
+	return (struct zsl_cplx){ a.re + b.re, a.im + b.im };
+}
+
+/** @brief Returns a - b. */
+static inline struct zsl_cplx zsl_cplx_sub(struct zsl_cplx a,
+					   struct zsl_cplx b)
+{
+	return (struct zsl_cplx){ a.re - b.re, a.im - b.im };
+}
+
+/** @brief Returns a * b. */
+static inline struct zsl_cplx zsl_cplx_mul(struct zsl_cplx a,
+					   struct zsl_cplx b)
+{
+	return (struct zsl_cplx){ a.re * b.re - a.im * b.im,
+				  a.re * b.im + a.im * b.re };
+}
+
+/** @brief Returns the complex conjugate of a. */
+static inline struct zsl_cplx zsl_cplx_conj(struct zsl_cplx a)
+{
+	return (struct zsl_cplx){ a.re, -a.im };
+}
+
+/** @brief Returns s * a, where 's' is real. */
+static inline struct zsl_cplx zsl_cplx_scale(struct zsl_cplx a,
+					     zsl_real_t s)
+{
+	return (struct zsl_cplx){ s * a.re, s * a.im };
+}
+
+/** @brief Returns |a|^2, which is cheaper to compute than |a|. */
+static inline zsl_real_t zsl_cplx_abs2(struct zsl_cplx a)
+{
+	return a.re * a.re + a.im * a.im;
+}
+
+/**
+ * @brief Returns a / b. The operands are scaled first (Smith's method), so
+ *        the result doesn't overflow or underflow unless the quotient
+ *        itself does. Division by zero returns NAN in both parts.
+ */
+struct zsl_cplx zsl_cplx_div(struct zsl_cplx a, struct zsl_cplx b);
+
+/**
+ * @brief Returns the magnitude |a|, avoiding overflow or underflow when
+ *        squaring the parts.
+ */
+zsl_real_t zsl_cplx_abs(struct zsl_cplx a);
+
+/** @brief Returns the argument (phase angle) of a, in radians in [-pi, pi]. */
+zsl_real_t zsl_cplx_arg(struct zsl_cplx a);
+
+/** @brief Returns the complex number with magnitude 'r' and angle 'theta'. */
+struct zsl_cplx zsl_cplx_polar(zsl_real_t r, zsl_real_t theta);
+
+/** @brief Returns the principal square root of a, whose real part is >= 0. */
+struct zsl_cplx zsl_cplx_sqrt(struct zsl_cplx a);
+
+/** @brief Returns e^a. */
+struct zsl_cplx zsl_cplx_exp(struct zsl_cplx a);
+
+/** @} */ /* End of CPLX_SCALAR group */
+
+/**
+ * @addtogroup CPLX_VECTORS Vector Functions
+ *
+ * @brief Functions on complex vectors.
+ *
+ * @ingroup COMPLEX
+ *  @{ */
+
+/**
+ * @brief Sets every element of vector 'v' to zero.
+ *
+ * @param v The vector to initialise.
+ *
+ * @return 0 on success.
+ */
+int zsl_cvec_init(struct zsl_cvec *v);
+
+/**
+ * @brief Sets complex vector 'v' to 're' + 'im' * i.
+ *
+ * @param v     The output complex vector.
+ * @param re    The real parts, the same size as 'v'.
+ * @param im    The imaginary parts, the same size as 'v', or NULL if they
+ *              are all zero.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_from_vec(struct zsl_cvec *v, const struct zsl_vec *re,
+		      const struct zsl_vec *im);
+
+/**
+ * @brief Returns element 'i' of vector 'v' in 'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'i' is out of range.
+ */
+int zsl_cvec_get(const struct zsl_cvec *v, size_t i, struct zsl_cplx *x);
+
+/**
+ * @brief Sets element 'i' of vector 'v' to 'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'i' is out of range.
+ */
+int zsl_cvec_set(struct zsl_cvec *v, size_t i, struct zsl_cplx x);
+
+/**
+ * @brief Adds complex vectors 'v' and 'w', placing the result in 'x'.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_add(const struct zsl_cvec *v, const struct zsl_cvec *w,
+		 struct zsl_cvec *x);
+
+/**
+ * @brief Subtracts complex vector 'w' from 'v', placing the result in 'x'.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_sub(const struct zsl_cvec *v, const struct zsl_cvec *w,
+		 struct zsl_cvec *x);
+
+/**
+ * @brief Multiplies complex vectors 'v' and 'w' element by element, placing
+ *        the result in 'x', which may be 'v' or 'w'.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_mul(const struct zsl_cvec *v, const struct zsl_cvec *w,
+		 struct zsl_cvec *x);
+
+/**
+ * @brief Multiplies every element of complex vector 'v' by 's', in place.
+ *
+ * @return 0 on success.
+ */
+int zsl_cvec_scale(struct zsl_cvec *v, struct zsl_cplx s);
+
+/**
+ * @brief Replaces every element of complex vector 'v' with its conjugate.
+ *
+ * @return 0 on success.
+ */
+int zsl_cvec_conj(struct zsl_cvec *v);
+
+/**
+ * @brief Computes the inner product of complex vectors 'v' and 'w', the
+ *        sum of conj(v[i]) * w[i], so that the product of a vector with
+ *        itself is its squared norm.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_dot(const struct zsl_cvec *v, const struct zsl_cvec *w,
+		 struct zsl_cplx *d);
+
+/**
+ * @brief Returns the Euclidean norm of complex vector 'v'.
+ */
+zsl_real_t zsl_cvec_norm(const struct zsl_cvec *v);
+
+/**
+ * @brief Places the magnitude of each element of complex vector 'v' in real
+ *        vector 'w', for example to get an amplitude spectrum.
+ *
+ * @return 0 on success, or -EINVAL if the vectors aren't the same size.
+ */
+int zsl_cvec_abs(const struct zsl_cvec *v, struct zsl_vec *w);
+
+/** @} */ /* End of CPLX_VECTORS group */
+
+/**
+ * @addtogroup CPLX_MATRICES Matrix Functions
+ *
+ * @brief Functions on complex matrices.
+ *
+ * @ingroup COMPLEX
+ *  @{ */
+
+/**
+ * @brief Sets every element of matrix 'm' to zero.
+ *
+ * @param m The matrix to initialise.
+ *
+ * @return 0 on success.
+ */
+int zsl_cmtx_init(struct zsl_cmtx *m);
+
+/**
+ * @brief Sets complex matrix 'm' to 're' + 'im' * i.
+ *
+ * @param m     The output complex matrix.
+ * @param re    The real parts, the same shape as 'm'.
+ * @param im    The imaginary parts, the same shape as 'm', or NULL if they
+ *              are all zero.
+ *
+ * @return 0 on success, or -EINVAL if the matrices aren't the same shape.
+ */
+int zsl_cmtx_from_mtx(struct zsl_cmtx *m, const struct zsl_mtx *re,
+		      const struct zsl_mtx *im);
+
+/**
+ * @brief Returns the element at row 'i' and column 'j' of matrix 'm' in
+ *        'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'i' or 'j' is out of range.
+ */
+int zsl_cmtx_get(const struct zsl_cmtx *m, size_t i, size_t j,
+		 struct zsl_cplx *x);
+
+/**
+ * @brief Sets the element at row 'i' and column 'j' of matrix 'm' to 'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'i' or 'j' is out of range.
+ */
+int zsl_cmtx_set(struct zsl_cmtx *m, size_t i, size_t j, struct zsl_cplx x);
+
+/**
+ * @brief Adds complex matrices 'ma' and 'mb', placing the result in 'mc'.
+ *
+ * @return 0 on success, or -EINVAL if the matrices aren't the same shape.
+ */
+int zsl_cmtx_add(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+		 struct zsl_cmtx *mc);
+
+/**
+ * @brief Subtracts complex matrix 'mb' from 'ma', placing the result in
+ *        'mc'.
+ *
+ * @return 0 on success, or -EINVAL if the matrices aren't the same shape.
+ */
+int zsl_cmtx_sub(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+		 struct zsl_cmtx *mc);
+
+/**
+ * @brief Multiplies complex matrices 'ma' and 'mb', placing the result in
+ *        'mc', which must not be 'ma' or 'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the matrix shapes don't match.
+ */
+int zsl_cmtx_mult(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+		  struct zsl_cmtx *mc);
+
+/**
+ * @brief Multiplies complex matrix 'm' by complex vector 'v', placing the
+ *        result in 'w', which must not be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the sizes don't match.
+ */
+int zsl_cmtx_mult_cvec(const struct zsl_cmtx *m, const struct zsl_cvec *v,
+		       struct zsl_cvec *w);
+
+/**
+ * @brief Places the conjugate transpose of complex matrix 'ma' in 'mb',
+ *        which must not be 'ma'.
+ *
+ * @return 0 on success, or -EINVAL if 'mb' isn't the transposed shape of
+ *         'ma'.
+ */
+int zsl_cmtx_herm(const struct zsl_cmtx *ma, struct zsl_cmtx *mb);
+
+/**
+ * @brief Calculates all eigenvalues of real square matrix 'm', including
+ *        complex conjugate pairs, from its real Schur form.
+ *
+ * Each 1x1 diagonal block of the Schur form holds a real eigenvalue, and
+ * each 2x2 block a complex conjugate pair. The eigenvalues are returned in
+ * the order their blocks appear on the diagonal, with the pair members
+ * next to each other and the one with the positive imaginary part first.
+ *
+ * @param m     The input square matrix.
+ * @param v     The output complex vector, with one element per row of 'm'.
+ * @param iter  The maximum number of QR iterations, see @ref zsl_mtx_schur.
+ *
+ * @return 0 on success, -EINVAL if 'm' isn't square or 'v' is the wrong
+ *         size, or -ENOCONVERGE if the Schur form didn't converge within
+ *         'iter' iterations.
+ */
+int zsl_mtx_eigenvalues_cplx(const struct zsl_mtx *m, struct zsl_cvec *v,
+			     size_t iter);
+
+/** @} */ /* End of CPLX_MATRICES group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_COMPLEX_H_ */
+
+/** @} */ /* End of complex group */
@@ -44,6 +44,16 @@ extern "C" {
  */
 #define ZSL_PI                                          (3.14159265359)
 
+/**
+ * The number of degrees in one radian, 180 / Pi.
+ */
+#define ZSL_RAD_TO_DEG                                  (57.2957795131)
+
+/**
+ * The number of radians in one degree, Pi / 180.
+ */
+#define ZSL_DEG_TO_RAD                                  (0.0174532925199)
+
 /**
  * The gravitational acceleration at the surface of the Earth, in meters per
  * second squared.
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup CONVOLUTION Convolution and Correlation
+ *
+ * @brief Linear convolution and cross-correlation of real vectors.
+ *
+ * Each operation has a direct implementation, whose cost grows with the
+ * product of the input sizes, and one based on the FFT, whose cost grows
+ * with (n log n) of the output size but needs scratch memory for two
+ * zero-padded copies of the inputs. @ref zsl_conv and @ref zsl_xcorr pick
+ * the cheaper of the two for the sizes given.
+ *
+ * The inputs are read in place, so windows of longer signals can be passed
+ * without copying them by using @ref zsl_vec_view.
+ */
+
+/**
+ * @file
+ * @brief API header file for convolution and correlation in zscilib.
+ *
+ * This file contains the zscilib convolution and correlation APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CONVOLUTION_H_
+#define ZEPHYR_INCLUDE_ZSL_CONVOLUTION_H_
+
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Forward declaration, see zsl/workspace.h. */
+struct zsl_workspace;
+
+/**
+ * @addtogroup CONV_FUNCS Functions
+ *
+ * @brief Convolution and correlation functions.
+ *
+ * @ingroup CONVOLUTION
+ *  @{ */
+
+/**
+ * @brief Computes the full linear convolution of 'x' and 'h',
+ *        y[n] = sum(x[k] * h[n - k]), choosing the direct or FFT-based
+ *        method from the input sizes.
+ *
+ * The FFT is only used for outputs up to CONFIG_ZSL_CONV_FFT_MAX_N
+ * samples, after rounding up to a power of two, since its scratch memory
+ * grows with the output size.
+ *
+ * @param x     The first input vector.
+ * @param h     The second input vector, typically the shorter.
+ * @param y     The output vector, of size x->sz + h->sz - 1. This must not
+ *              be 'x' or 'h'.
+ *
+ * @return 0 on success, or -EINVAL if 'y' isn't the right size.
+ */
+int zsl_conv(const struct zsl_vec *x, const struct zsl_vec *h,
+	     struct zsl_vec *y);
+
+/**
+ * @brief Equivalent to @ref zsl_conv, always using the direct method. Each
+ *        input sample adds a scaled copy of 'h' to the output, so the inner
+ *        loop runs over contiguous memory.
+ */
+int zsl_conv_direct(const struct zsl_vec *x, const struct zsl_vec *h,
+		    struct zsl_vec *y);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_conv_fft_ws and @ref zsl_xcorr_fft_ws for inputs of
+ *        'nx' and 'nh' samples.
+ *
+ * @param nx    The size of the first input vector.
+ * @param nh    The size of the second input vector.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_conv_fft_ws_sz(size_t nx, size_t nh);
+
+/**
+ * @brief Equivalent to @ref zsl_conv, always using the FFT-based method,
+ *        with its temporary memory allocated from workspace 'ws'.
+ *
+ * @return 0 on success, -EINVAL if 'y' isn't the right size or the padded
+ *         output is larger than ZSL_FFT_MAX_N, or -ENOMEM if 'ws' is too
+ *         small.
+ */
+int zsl_conv_fft_ws(const struct zsl_vec *x, const struct zsl_vec *h,
+		    struct zsl_vec *y, struct zsl_workspace *ws);
+
+/**
+ * @brief Computes the cross-correlation of 'x' and 'y' at every lag where
+ *        they overlap, r[i] = sum(x[n + lag] * y[n]), with
+ *        lag = i - (y->sz - 1). The method is chosen as for @ref zsl_conv.
+ *
+ * The lag at which 'r' peaks is the delay of 'x' relative to 'y'.
+ *
+ * @param x     The first input vector.
+ * @param y     The second input vector.
+ * @param r     The output vector, of size x->sz + y->sz - 1. This must not
+ *              be 'x' or 'y'.
+ *
+ * @return 0 on success, or -EINVAL if 'r' isn't the right size.
+ */
+int zsl_xcorr(const struct zsl_vec *x, const struct zsl_vec *y,
+	      struct zsl_vec *r);
+
+/**
+ * @brief Equivalent to @ref zsl_xcorr, always using the direct method.
+ */
+int zsl_xcorr_direct(const struct zsl_vec *x, const struct zsl_vec *y,
+		     struct zsl_vec *r);
+
+/**
+ * @brief Equivalent to @ref zsl_xcorr, always using the FFT-based method,
+ *        with its temporary memory allocated from workspace 'ws', which
+ *        must have zsl_conv_fft_ws_sz(x->sz, y->sz) free entries.
+ *
+ * @return 0 on success, -EINVAL if 'r' isn't the right size or the padded
+ *         output is larger than ZSL_FFT_MAX_N, or -ENOMEM if 'ws' is too
+ *         small.
+ */
+int zsl_xcorr_fft_ws(const struct zsl_vec *x, const struct zsl_vec *y,
+		     struct zsl_vec *r, struct zsl_workspace *ws);
+
+/**
+ * @brief Computes the cross-correlation of 'x' and 'y' at a single lag,
+ *        sum(x[n + lag] * y[n]) over the samples where they overlap. This
+ *        is a dot product of the overlapping parts, read in place.
+ *
+ * @param x     The first input vector.
+ * @param y     The second input vector.
+ * @param lag   The delay of 'x' relative to 'y', in samples.
+ * @param r     The correlation at 'lag', or 0 if they don't overlap.
+ *
+ * @return 0 on success.
+ */
+int zsl_xcorr_lag(const struct zsl_vec *x, const struct zsl_vec *y,
+		  int lag, zsl_real_t *r);
+
+/** @} */ /* End of CONV_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CONVOLUTION_H_ */
+
+/** @} */ /* End of convolution group */
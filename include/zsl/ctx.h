@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup CTX Contexts
+ *
+ * @brief Per-thread state for running the heavy matrix functions
+ *        concurrently.
+ *
+ * Without a context, functions like zsl_mtx_eigenvalues take their
+ * temporaries from the stack, the shared scratch pool (which serialises
+ * callers on a mutex), or, for zsl_mtx_qrd_iter with
+ * CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH, a static buffer. zsl_mtx_entry_fn_random
+ * also shares a single generator between all callers.
+ *
+ * A @ref zsl_ctx instead bundles the scratch memory and random number
+ * generator that one thread uses, and the _ctx variants below take their
+ * state from it alone. Giving each thread its own context lets decompositions
+ * run in parallel on SMP targets without locking, and with their memory use
+ * fixed when the context is declared.
+ *
+ * Instrumentation needs no context, since the call being recorded is
+ * already tracked per thread when CONFIG_THREAD_LOCAL_STORAGE is enabled.
+ */
+
+/**
+ * @file
+ * @brief API header file for contexts in zscilib.
+ *
+ * This file contains the zscilib context APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CTX_H_
+#define ZEPHYR_INCLUDE_ZSL_CTX_H_
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/random.h>
+#include <zsl/workspace.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CTX_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with contexts.
+ *
+ * @ingroup CTX
+ *  @{ */
+
+/** @brief The state used by one thread calling the _ctx functions. */
+struct zsl_ctx {
+	/** The workspace that temporaries are allocated from. */
+	struct zsl_workspace *ws;
+	/** The random number generator, or NULL if none is needed. */
+	struct zsl_rand *rng;
+};
+
+/**
+ * Macro to declare a context with 'n' zsl_real_t entries of scratch memory
+ * and its own random number generator, which should be seeded with
+ * @ref zsl_ctx_seed before use.
+ *
+ * As with ZSL_WORKSPACE_DEF, this can be used at file scope, or inside a
+ * thread's entry function to place the context on that thread's stack.
+ */
+#define ZSL_CTX_DEF(name, n)						\
+	ZSL_WORKSPACE_DEF(name ## _ctx_ws, n);				\
+	struct zsl_rand name ## _ctx_rng;				\
+	struct zsl_ctx name = {						\
+		.ws = &name ## _ctx_ws,					\
+		.rng = &name ## _ctx_rng				\
+	}
+
+/** @} */ /* End of CTX_STRUCTS group */
+
+/**
+ * @addtogroup CTX_FUNCS Functions
+ *
+ * @brief Context functions, and context variants of the heavy matrix
+ *        functions.
+ *
+ * Each _ctx function is equivalent to the matching _ws function, with its
+ * temporaries allocated from the context's workspace. See the _ws_sz
+ * helpers in matrices.h to size the workspace. Two threads may call these
+ * at the same time as long as they use different contexts.
+ *
+ * @ingroup CTX
+ *  @{ */
+
+/**
+ * @brief Initialises context 'ctx' with workspace 'ws' and random number
+ *        generator 'rng'.
+ *
+ * @param ctx   The context to initialise.
+ * @param ws    The workspace to allocate temporaries from.
+ * @param rng   The random number generator, or NULL if none is needed.
+ *
+ * @return 0 on success, or -EINVAL if 'ws' is NULL.
+ */
+static inline int zsl_ctx_init(struct zsl_ctx *ctx, struct zsl_workspace *ws,
+			       struct zsl_rand *rng)
+{
+	if (ws == NULL) {
+		return -EINVAL;
+	}
+
+	ctx->ws = ws;
+	ctx->rng = rng;
+
+	return 0;
+}
+
+/**
+ * @brief Seeds the random number generator of 'ctx'. Contexts seeded with
+ *        different values give independent streams.
+ *
+ * @return 0 on success, or -EINVAL if 'ctx' has no generator.
+ */
+static inline int zsl_ctx_seed(struct zsl_ctx *ctx, uint64_t seed)
+{
+	if (ctx->rng == NULL) {
+		return -EINVAL;
+	}
+
+	return zsl_rand_seed(ctx->rng, seed);
+}
+
+/**
+ * @brief Fills 'm' with values uniformly distributed in [-1.0, 1.0) from
+ *        the generator of 'ctx'. This is the reentrant equivalent of
+ *        initialising 'm' with @ref zsl_mtx_entry_fn_random.
+ *
+ * @return 0 on success, or -EINVAL if 'ctx' has no generator.
+ */
+static inline int zsl_mtx_init_random_ctx(struct zsl_mtx *m,
+					  struct zsl_ctx *ctx)
+{
+	if (ctx->rng == NULL) {
+		return -EINVAL;
+	}
+
+	return zsl_rand_mtx_uniform(ctx->rng, m, -1.0, 1.0);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_solve_refine_ws. */
+static inline int zsl_mtx_solve_refine_ctx(const struct zsl_mtx *a,
+					   struct zsl_mtx *b,
+					   struct zsl_mtx *x, size_t iter,
+					   struct zsl_ctx *ctx)
+{
+	return zsl_mtx_solve_refine_ws(a, b, x, iter, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_inv_refine_ws. */
+static inline int zsl_mtx_inv_refine_ctx(const struct zsl_mtx *m,
+					 struct zsl_mtx *mi, size_t iter,
+					 struct zsl_ctx *ctx)
+{
+	return zsl_mtx_inv_refine_ws(m, mi, iter, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_expm_ws. */
+static inline int zsl_mtx_expm_ctx(const struct zsl_mtx *m, struct zsl_mtx *e,
+				   struct zsl_ctx *ctx)
+{
+	return zsl_mtx_expm_ws(m, e, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_c2d_ws. */
+static inline int zsl_mtx_c2d_ctx(const struct zsl_mtx *a,
+				  const struct zsl_mtx *b, zsl_real_t t,
+				  struct zsl_mtx *ad, struct zsl_mtx *bd,
+				  struct zsl_ctx *ctx)
+{
+	return zsl_mtx_c2d_ws(a, b, t, ad, bd, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_householder_ws. */
+static inline int zsl_mtx_householder_ctx(const struct zsl_mtx *m,
+					  struct zsl_mtx *h, bool hessenberg,
+					  struct zsl_ctx *ctx)
+{
+	return zsl_mtx_householder_ws(m, h, hessenberg, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_qrd_ws. */
+static inline int zsl_mtx_qrd_ctx(const struct zsl_mtx *m, struct zsl_mtx *q,
+				  struct zsl_mtx *r, bool hessenberg,
+				  struct zsl_ctx *ctx)
+{
+	return zsl_mtx_qrd_ws(m, q, r, hessenberg, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_schur_ws. */
+static inline int zsl_mtx_schur_ctx(const struct zsl_mtx *m,
+				    struct zsl_mtx *t, struct zsl_mtx *q,
+				    size_t iter, size_t *used,
+				    struct zsl_ctx *ctx)
+{
+	return zsl_mtx_schur_ws(m, t, q, iter, used, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_eigen_sym_ws. */
+static inline int zsl_mtx_eigen_sym_ctx(const struct zsl_mtx *m,
+					struct zsl_vec *v, struct zsl_mtx *mev,
+					struct zsl_ctx *ctx)
+{
+	return zsl_mtx_eigen_sym_ws(m, v, mev, ctx->ws);
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/** @brief Equivalent to @ref zsl_mtx_qrd_iter_ws. */
+static inline int zsl_mtx_qrd_iter_ctx(const struct zsl_mtx *m,
+				       struct zsl_mtx *mout, size_t iter,
+				       size_t *used, struct zsl_ctx *ctx)
+{
+	return zsl_mtx_qrd_iter_ws(m, mout, iter, used, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_eigenvalues_ws. */
+static inline int zsl_mtx_eigenvalues_ctx(const struct zsl_mtx *m,
+					  struct zsl_vec *v, size_t iter,
+					  size_t *used, struct zsl_ctx *ctx)
+{
+	return zsl_mtx_eigenvalues_ws(m, v, iter, used, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_eigenvectors_ws. */
+static inline int zsl_mtx_eigenvectors_ctx(const struct zsl_mtx *m,
+					   struct zsl_mtx *mev, size_t iter,
+					   bool orthonormal,
+					   struct zsl_ctx *ctx)
+{
+	return zsl_mtx_eigenvectors_ws(m, mev, iter, orthonormal, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_svd_ws. */
+static inline int zsl_mtx_svd_ctx(const struct zsl_mtx *m, struct zsl_mtx *u,
+				  struct zsl_mtx *e, struct zsl_mtx *v,
+				  size_t iter, struct zsl_ctx *ctx)
+{
+	return zsl_mtx_svd_ws(m, u, e, v, iter, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_svd_vals_ws. */
+static inline int zsl_mtx_svd_vals_ctx(const struct zsl_mtx *m,
+				       struct zsl_vec *s, size_t iter,
+				       struct zsl_ctx *ctx)
+{
+	return zsl_mtx_svd_vals_ws(m, s, iter, ctx->ws);
+}
+
+/** @brief Equivalent to @ref zsl_mtx_pinv_ws. */
+static inline int zsl_mtx_pinv_ctx(const struct zsl_mtx *m,
+				   struct zsl_mtx *pinv, size_t iter,
+				   struct zsl_ctx *ctx)
+{
+	return zsl_mtx_pinv_ws(m, pinv, iter, ctx->ws);
+}
+#endif
+
+/** @} */ /* End of CTX_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CTX_H_ */
+
+/** @} */ /* End of CTX group */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup DUAL Dual Numbers
+ *
+ * @brief Forward-mode automatic differentiation, and first-order uncertainty
+ *        propagation.
+ *
+ * A dual number carries a value and its partial derivatives with respect to
+ * up to ZSL_DUAL_N inputs. Every operation below updates both with the
+ * chain rule. A model written with these operations therefore gives its
+ * Jacobian alongside its result, from a single evaluation.
+ *
+ * @ref zsl_dual_propagate uses that Jacobian 'J' to propagate the
+ * covariance 'Cx' of the inputs to the covariance J * Cx * J^T of the
+ * outputs, as in the GUM law of propagation of uncertainty. This is exact
+ * for linear models, and a cheap approximation to @ref MONTECARLO for
+ * models that are close to linear over the input uncertainties.
+ */
+
+/**
+ * @file
+ * @brief API header file for dual numbers in zscilib.
+ *
+ * This file contains the zscilib dual number APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_DUAL_H_
+#define ZEPHYR_INCLUDE_ZSL_DUAL_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup DUAL_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for dual numbers.
+ *
+ * @ingroup DUAL
+ *  @{ */
+
+/**
+ * The number of partial derivatives in each dual number, and so the most
+ * inputs a model can be differentiated against.
+ */
+#ifndef ZSL_DUAL_N
+#define ZSL_DUAL_N              (6)
+#endif
+
+/** @brief A value and its partial derivatives. */
+struct zsl_dual {
+	/** The value. */
+	zsl_real_t v;
+	/** The partial derivatives of 'v' with respect to each input. */
+	zsl_real_t d[ZSL_DUAL_N];
+};
+
+/**
+ * @brief A model, evaluated with dual numbers.
+ *
+ * @param x     The inputs.
+ * @param y     The outputs.
+ * @param arg   The argument passed to @ref zsl_dual_jacobian.
+ *
+ * @return 0 on success, or a negative error code.
+ */
+typedef int (*zsl_dual_fn_t)(const struct zsl_dual *x, struct zsl_dual *y,
+			     void *arg);
+
+/** @} */ /* End of DUAL_STRUCTS group */
+
+/**
+ * @addtogroup DUAL_FUNCS Functions
+ *
+ * @brief Dual number functions.
+ *
+ * The output of every function may be the same as one of its inputs.
+ *
+ * @ingroup DUAL
+ *  @{ */
+
+/**
+ * @brief Sets 'a' to constant 'x', with no dependence on any input.
+ *
+ * @return 0 on success.
+ */
+int zsl_dual_const(struct zsl_dual *a, zsl_real_t x);
+
+/**
+ * @brief Sets 'a' to input 'i' of a model, with value 'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'i' is not below ZSL_DUAL_N.
+ */
+int zsl_dual_var(struct zsl_dual *a, zsl_real_t x, size_t i);
+
+/** @brief Computes c = a + b. */
+int zsl_dual_add(const struct zsl_dual *a, const struct zsl_dual *b,
+		 struct zsl_dual *c);
+
+/** @brief Computes c = a - b. */
+int zsl_dual_sub(const struct zsl_dual *a, const struct zsl_dual *b,
+		 struct zsl_dual *c);
+
+/** @brief Computes c = a * b. */
+int zsl_dual_mult(const struct zsl_dual *a, const struct zsl_dual *b,
+		  struct zsl_dual *c);
+
+/**
+ * @brief Computes c = a / b.
+ *
+ * @return 0 on success, or -EINVAL if 'b' is zero.
+ */
+int zsl_dual_div(const struct zsl_dual *a, const struct zsl_dual *b,
+		 struct zsl_dual *c);
+
+/** @brief Computes c = s * a for real 's'. */
+int zsl_dual_scalar_mult(const struct zsl_dual *a, zsl_real_t s,
+			 struct zsl_dual *c);
+
+/**
+ * @brief Computes c = sqrt(a).
+ *
+ * @return 0 on success, or -EINVAL if 'a' is not above zero, where the
+ *         derivative is undefined.
+ */
+int zsl_dual_sqrt(const struct zsl_dual *a, struct zsl_dual *c);
+
+/** @brief Computes c = e^a. */
+int zsl_dual_exp(const struct zsl_dual *a, struct zsl_dual *c);
+
+/**
+ * @brief Computes c = ln(a).
+ *
+ * @return 0 on success, or -EINVAL if 'a' is not above zero.
+ */
+int zsl_dual_log(const struct zsl_dual *a, struct zsl_dual *c);
+
+/**
+ * @brief Computes c = a^p for real 'p'.
+ *
+ * @return 0 on success, or -EINVAL if 'a' is not above zero.
+ */
+int zsl_dual_pow(const struct zsl_dual *a, zsl_real_t p, struct zsl_dual *c);
+
+/** @brief Computes c = sin(a), for 'a' in radians. */
+int zsl_dual_sin(const struct zsl_dual *a, struct zsl_dual *c);
+
+/** @brief Computes c = cos(a), for 'a' in radians. */
+int zsl_dual_cos(const struct zsl_dual *a, struct zsl_dual *c);
+
+/**
+ * @brief Computes c = atan2(y, x), in radians.
+ *
+ * @return 0 on success, or -EINVAL if 'x' and 'y' are both zero.
+ */
+int zsl_dual_atan2(const struct zsl_dual *y, const struct zsl_dual *x,
+		   struct zsl_dual *c);
+
+/** @brief Computes the dot product 'c' of the 'n' element vectors a and b. */
+int zsl_dual_vec_dot(const struct zsl_dual *a, const struct zsl_dual *b,
+		     size_t n, struct zsl_dual *c);
+
+/**
+ * @brief Computes the Euclidean norm 'c' of the 'n' element vector 'a'.
+ *
+ * @return 0 on success, or -EINVAL if 'a' is all zero.
+ */
+int zsl_dual_vec_norm(const struct zsl_dual *a, size_t n,
+		      struct zsl_dual *c);
+
+/** @brief Computes the cross product c = a x b of two 3-vectors. */
+int zsl_dual_vec_cross(const struct zsl_dual *a, const struct zsl_dual *b,
+		       struct zsl_dual *c);
+
+/**
+ * @brief Computes c = m * a, for real matrix 'm', such as a color space
+ *        correlation matrix, and vector 'a' of m->sz_cols elements.
+ *
+ * @param m     The matrix.
+ * @param a     The input vector.
+ * @param c     The output vector, of m->sz_rows elements. This must not
+ *              overlap 'a'.
+ *
+ * @return 0 on success.
+ */
+int zsl_dual_mtx_mult_vec(const struct zsl_mtx *m, const struct zsl_dual *a,
+			  struct zsl_dual *c);
+
+/**
+ * @brief Computes the quaternion product qm = qa * qb, as
+ *        @ref zsl_quat_mult. Each quaternion is stored r, i, j, k.
+ */
+int zsl_dual_quat_mult(const struct zsl_dual *qa, const struct zsl_dual *qb,
+		       struct zsl_dual *qm);
+
+/**
+ * @brief Rotates 3-vector 'v' by unit quaternion 'q' into 'vr', as
+ *        @ref zsl_quat_rot_vec. 'q' is stored r, i, j, k.
+ */
+int zsl_dual_quat_rot_vec(const struct zsl_dual *q, const struct zsl_dual *v,
+			  struct zsl_dual *vr);
+
+/**
+ * @brief Converts a CIE 1931 XYZ tristimulus to CIE 1931 xyY, as
+ *        @ref zsl_clr_conv_xyz_xyy.
+ *
+ * @return 0 on success, or -EINVAL if X + Y + Z is zero.
+ */
+int zsl_dual_clr_xyz_xyy(const struct zsl_dual *xyz, struct zsl_dual *xyy);
+
+/**
+ * @brief Applies the sRGB transfer function to linear channel value 'a'.
+ *
+ * As in @ref zsl_clr_conv_rgbf_srgbf, 'a' is limited to 0.0..1.0 first,
+ * so the derivative is zero outside that range.
+ *
+ * @return 0 on success.
+ */
+int zsl_dual_clr_srgb_enc(const struct zsl_dual *a, struct zsl_dual *c);
+
+/**
+ * @brief Evaluates model 'fn' at 'x', giving its outputs 'y' and its
+ *        Jacobian 'j', in a single evaluation.
+ *
+ * @param fn    The model.
+ * @param arg   The argument passed to 'fn'.
+ * @param x     The inputs, at most ZSL_DUAL_N.
+ * @param y     The outputs.
+ * @param j     The y->sz x x->sz Jacobian, where entry (i, k) is the
+ *              partial derivative of output 'i' with respect to input 'k'.
+ *
+ * @return 0 on success, -EINVAL if 'x' has more than ZSL_DUAL_N entries,
+ *         'y' is empty or the shapes don't match, or the error returned
+ *         by 'fn'.
+ */
+int zsl_dual_jacobian(zsl_dual_fn_t fn, void *arg, const struct zsl_vec *x,
+		      struct zsl_vec *y, struct zsl_mtx *j);
+
+/**
+ * @brief Propagates the covariance 'cx' of inputs 'x' through model 'fn',
+ *        giving the outputs 'y' and their covariance cy = J * cx * J^T.
+ *
+ * For uncorrelated inputs, 'cx' is diagonal with the squares of the
+ * standard uncertainties, and the square roots of the diagonal of 'cy'
+ * are the combined standard uncertainties of the outputs.
+ *
+ * @param fn    The model.
+ * @param arg   The argument passed to 'fn'.
+ * @param x     The inputs, at most ZSL_DUAL_N.
+ * @param cx    The x->sz x x->sz covariance of the inputs.
+ * @param y     The outputs.
+ * @param cy    The y->sz x y->sz covariance of the outputs.
+ *
+ * @return 0 on success, -EINVAL if 'x' has more than ZSL_DUAL_N entries,
+ *         'y' is empty or the shapes don't match, or the error returned
+ *         by 'fn'.
+ */
+int zsl_dual_propagate(zsl_dual_fn_t fn, void *arg, const struct zsl_vec *x,
+		       const struct zsl_mtx *cx, struct zsl_vec *y,
+		       struct zsl_mtx *cy);
+
+/** @} */ /* End of DUAL_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_DUAL_H_ */
+
+/** @} */ /* End of DUAL group */
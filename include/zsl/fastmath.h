@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Fast approximate trigonometric and logarithm functions for zscilib.
+ *
+ * This file contains static inline polynomial approximations of sin, cos,
+ * atan2, asin, acos and log10, for targets where the libm versions dominate the
+ * per-sample budget (Cortex-M0+, M4F, etc.). They use only multiplies,
+ * adds, a single divide (atan2) or square root (asin, acos), and no
+ * tables. The absolute error bounds below are those of the polynomials in
+ * double precision. In single precision, float rounding dominates, and
+ * the error is below 1E-5 for the typical ranges of orientation values.
+ *
+ * The functions can always be called directly. Each module that opts in
+ * to them when CONFIG_ZSL_FAST_MATH is set also has a set of macros below,
+ * which map to either these functions or the full precision libm ones
+ * depending on its own Kconfig option, so that modules like colorimetry
+ * can keep full precision.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FASTMATH_H_
+#define ZEPHYR_INCLUDE_ZSL_FASTMATH_H_
+
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Approximates sin(x) for |x| < 1E5, with an absolute error below
+ *        1E-7 plus the range reduction error of about |x| * 1E-16 (double)
+ *        or |x| * 1E-7 (float).
+ *
+ * The argument is reduced to [-pi/2, pi/2], where sin is evaluated with a
+ * degree 11 odd polynomial.
+ */
+static inline zsl_real_t zsl_fast_sin(zsl_real_t x)
+{
+	zsl_real_t x2;
+	int32_t n;
+
+	/* Reduce to [-pi, pi], then fold into [-pi/2, pi/2]. */
+	n = (int32_t)(x * (1.0 / (2.0 * ZSL_PI)) + (x < 0.0 ? -0.5 : 0.5));
+	x -= (zsl_real_t)n * (2.0 * ZSL_PI);
+	if (x > ZSL_PI / 2.0) {
+		x = ZSL_PI - x;
+	} else if (x < -ZSL_PI / 2.0) {
+		x = -ZSL_PI - x;
+	}
+
+	x2 = x * x;
+
+	return x * (1.0 + x2 * (-1.6666666666666666E-1 +
+			x2 * (8.3333333333333332E-3 +
+			x2 * (-1.9841269841269841E-4 +
+			x2 * (2.7557319223985893E-6 +
+			x2 * -2.5052108385441720E-8)))));
+}
+
+/**
+ * @brief Approximates cos(x) for |x| < 1E5, with the same error bounds as
+ *        @ref zsl_fast_sin.
+ */
+static inline zsl_real_t zsl_fast_cos(zsl_real_t x)
+{
+	return zsl_fast_sin(x + ZSL_PI / 2.0);
+}
+
+/**
+ * @brief Approximates atan2(y, x) in radians, with an absolute error below
+ *        2E-8. Returns 0.0 when both 'x' and 'y' are zero.
+ *
+ * The smaller of |x| and |y| is divided by the larger, and atan is then
+ * evaluated on [0, 1] with a degree 17 odd polynomial (Abramowitz and
+ * Stegun 4.4.49) before being mapped back to the correct octant.
+ */
+static inline zsl_real_t zsl_fast_atan2(zsl_real_t y, zsl_real_t x)
+{
+	zsl_real_t ax = x < 0.0 ? -x : x;
+	zsl_real_t ay = y < 0.0 ? -y : y;
+	zsl_real_t a, a2, r;
+
+	if (ax == 0.0 && ay == 0.0) {
+		return 0.0;
+	}
+
+	a = ax > ay ? ay / ax : ax / ay;
+	a2 = a * a;
+	r = a * (1.0 + a2 * (-0.3333314528 + a2 * (0.1999355085 +
+		a2 * (-0.1420889944 + a2 * (0.1065626393 +
+		a2 * (-0.0752896400 + a2 * (0.0429096138 +
+		a2 * (-0.0161657367 + a2 * 0.0028662257))))))));
+
+	if (ay > ax) {
+		r = ZSL_PI / 2.0 - r;
+	}
+	if (x < 0.0) {
+		r = ZSL_PI - r;
+	}
+
+	return y < 0.0 ? -r : r;
+}
+
+/**
+ * @brief Approximates acos(x) in radians, with an absolute error below
+ *        3E-8. 'x' is clamped to [-1.0, 1.0].
+ *
+ * Uses acos(x) = sqrt(1 - x) * P(x) on [0, 1] with a degree 7 polynomial
+ * (Abramowitz and Stegun 4.4.46), and acos(-x) = pi - acos(x).
+ */
+static inline zsl_real_t zsl_fast_acos(zsl_real_t x)
+{
+	zsl_real_t ax = x < 0.0 ? -x : x;
+	zsl_real_t r;
+
+	if (ax > 1.0) {
+		ax = 1.0;
+	}
+
+	r = ZSL_SQRT(1.0 - ax) * (1.5707963050 + ax * (-0.2145988016 +
+		ax * (0.0889789874 + ax * (-0.0501743046 +
+		ax * (0.0308918810 + ax * (-0.0170881256 +
+		ax * (0.0066700901 + ax * -0.0012624911)))))));
+
+	return x < 0.0 ? ZSL_PI - r : r;
+}
+
+/**
+ * @brief Approximates asin(x) in radians, with the same error bounds as
+ *        @ref zsl_fast_acos. 'x' is clamped to [-1.0, 1.0].
+ */
+static inline zsl_real_t zsl_fast_asin(zsl_real_t x)
+{
+	return ZSL_PI / 2.0 - zsl_fast_acos(x);
+}
+
+/**
+ * @brief Approximates log10(x) for positive, normal 'x', with an absolute
+ *        error below 1E-9 in double precision.
+ *
+ * The exponent is read from the bits of 'x', leaving a mantissa m in
+ * [sqrt(0.5), sqrt(2)), and ln(m) = 2 * atanh((m - 1) / (m + 1)) is
+ * evaluated with a degree 9 odd polynomial. It takes a single divide.
+ */
+static inline zsl_real_t zsl_fast_log10(zsl_real_t x)
+{
+	int32_t e;
+	zsl_real_t s, s2;
+
+#if CONFIG_ZSL_SINGLE_PRECISION
+	union { float f; uint32_t u; } c = { .f = x };
+
+	e = (int32_t)((c.u >> 23) & 0xffu) - 127;
+	c.u = (c.u & 0x007fffffu) | 0x3f800000u;
+#else
+	union { double f; uint64_t u; } c = { .f = x };
+
+	e = (int32_t)((c.u >> 52) & 0x7ffu) - 1023;
+	c.u = (c.u & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+#endif
+	if (c.f > 1.4142135623730951) {
+		c.f *= 0.5;
+		e++;
+	}
+
+	s = (c.f - 1.0) / (c.f + 1.0);
+	s2 = s * s;
+
+	return (2.0 * s * (1.0 + s2 * (3.3333333333333333E-1 +
+		s2 * (2.0E-1 + s2 * (1.4285714285714286E-1 +
+		s2 * 1.1111111111111111E-1)))) +
+		(zsl_real_t)e * 6.9314718055994531E-1) * 4.3429448190325182E-1;
+}
+
+/*
+ * Trig functions used by the orientation module, including the fusion
+ * drivers.
+ */
+#if CONFIG_ZSL_FAST_MATH_ORIENTATION
+#define ZSL_ORI_SIN     zsl_fast_sin
+#define ZSL_ORI_COS     zsl_fast_cos
+#define ZSL_ORI_ATAN2   zsl_fast_atan2
+#define ZSL_ORI_ASIN    zsl_fast_asin
+#define ZSL_ORI_ACOS    zsl_fast_acos
+#else
+#define ZSL_ORI_SIN     ZSL_SIN
+#define ZSL_ORI_COS     ZSL_COS
+#define ZSL_ORI_ATAN2   ZSL_ATAN2
+#define ZSL_ORI_ASIN    ZSL_ASIN
+#define ZSL_ORI_ACOS    ZSL_ACOS
+#endif
+
+/* Logarithms used by the sound module's block level functions. */
+#if CONFIG_ZSL_FAST_MATH_SOUND
+#define ZSL_SND_LOG10   zsl_fast_log10
+#else
+#define ZSL_SND_LOG10   ZSL_LOG10
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FASTMATH_H_ */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FFT Fast Fourier Transform
+ *
+ * @brief In-place FFT and inverse FFT of complex and real data.
+ *
+ * The transforms work directly on the data of the caller's vectors, and
+ * need no temporary memory. Complex data is held as a zsl_cvec, whose real
+ * and imaginary parts can be the data of two existing zsl_vec, and real
+ * data is held as a zsl_vec.
+ *
+ * Sizes must be a power of two, up to ZSL_FFT_MAX_N. Radix-4 butterflies
+ * are used throughout, with a single radix-2 stage when the size is an odd
+ * power of two. Twiddle factors are read from a quarter-wave sine table in
+ * flash, so nothing is computed or allocated at runtime.
+ *
+ * The forward transform is unscaled, X[k] = sum(x[j] * e^(-2 pi i jk / n)),
+ * and the inverse transform divides by 'n', so that an inverse transform
+ * of a forward transform returns the original data.
+ */
+
+/**
+ * @file
+ * @brief API header file for FFT functions in zscilib.
+ *
+ * This file contains the zscilib FFT APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FFT_H_
+#define ZEPHYR_INCLUDE_ZSL_FFT_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/complex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FFT_STRUCTS Structs and Macros
+ *
+ * @brief Various macros related to the FFT.
+ *
+ * @ingroup FFT
+ *  @{ */
+
+/** The largest transform size supported, set by the twiddle table size. */
+#define ZSL_FFT_MAX_N   (4096)
+
+/** @} */ /* End of FFT_STRUCTS group */
+
+/**
+ * @addtogroup FFT_FUNCS Functions
+ *
+ * @brief FFT functions.
+ *
+ * @ingroup FFT
+ *  @{ */
+
+/**
+ * @brief Computes the FFT of complex vector 'v' in place.
+ *
+ * @param v     The complex vector to transform, whose size must be a power
+ *              of two no larger than ZSL_FFT_MAX_N.
+ *
+ * @return 0 on success, or -EINVAL if the size of 'v' isn't supported.
+ */
+int zsl_fft_cplx(struct zsl_cvec *v);
+
+/**
+ * @brief Computes the inverse FFT of complex vector 'v' in place.
+ *
+ * @param v     The complex vector to transform, whose size must be a power
+ *              of two no larger than ZSL_FFT_MAX_N.
+ *
+ * @return 0 on success, or -EINVAL if the size of 'v' isn't supported.
+ */
+int zsl_ifft_cplx(struct zsl_cvec *v);
+
+/**
+ * @brief Computes the FFT of real vector 'v' in place, using a complex FFT
+ *        of half the size.
+ *
+ * Since the spectrum of real data is conjugate symmetric, only the first
+ * n / 2 + 1 bins are returned, packed into the 'n' elements of 'v' in the
+ * same layout as the CMSIS-DSP real FFT:
+ *
+ *   v[0]          Re(X[0])
+ *   v[1]          Re(X[n / 2])
+ *   v[2k]         Re(X[k]), for 0 < k < n / 2
+ *   v[2k + 1]     Im(X[k]), for 0 < k < n / 2
+ *
+ * X[0] and X[n / 2] are always real.
+ *
+ * When CONFIG_ZSL_BACKEND_CMSIS_DSP is enabled, this is computed by
+ * CMSIS-DSP, using scratch memory for its output.
+ *
+ * @param v     The real vector to transform, whose size must be a power
+ *              of two from 4 to ZSL_FFT_MAX_N.
+ *
+ * @return 0 on success, or -EINVAL if the size of 'v' isn't supported.
+ */
+int zsl_fft_real(struct zsl_vec *v);
+
+/**
+ * @brief Computes the inverse of @ref zsl_fft_real in place, turning the
+ *        packed spectrum in 'v' back into real samples.
+ *
+ * @param v     The packed spectrum to transform, whose size must be a power
+ *              of two from 4 to ZSL_FFT_MAX_N.
+ *
+ * @return 0 on success, or -EINVAL if the size of 'v' isn't supported.
+ */
+int zsl_ifft_real(struct zsl_vec *v);
+
+/** @} */ /* End of FFT_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FFT_H_ */
+
+/** @} */ /* End of FFT group */
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FILTER Digital Filters
+ *
+ * @brief FIR and IIR filters that process blocks of samples in place.
+ *
+ * Each filter keeps its history in a caller-provided state buffer, so a
+ * stream can be processed one block at a time, and several filters can
+ * share one set of coefficients.
+ *
+ * A filter can process several channels at once, such as the x, y and z
+ * axes of an IMU. Blocks are then interleaved, with the samples of every
+ * channel taken at the same time stored next to each other, as sensor
+ * drivers usually report them. Each channel has its own history, and the
+ * inner loops run across channels, which the compiler can vectorise. With
+ * a single channel, FIR filters use a vectorised dot product instead.
+ */
+
+/**
+ * @file
+ * @brief API header file for digital filters in zscilib.
+ *
+ * This file contains the zscilib digital filter APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FILTER_H_
+#define ZEPHYR_INCLUDE_ZSL_FILTER_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FILTER_STRUCTS Structs and Macros
+ *
+ * @brief Various structs and macros related to digital filters.
+ *
+ * @ingroup FILTER
+ *  @{ */
+
+/**
+ * @brief A finite impulse response filter,
+ *        y[n] = h[0] * x[n] + h[1] * x[n - 1] + ... + h[taps - 1] *
+ *        x[n - taps + 1].
+ */
+struct zsl_fir {
+	/** The number of coefficients. */
+	size_t taps;
+	/** The number of interleaved channels in each block. */
+	size_t channels;
+	/** The coefficients, h[0] to h[taps - 1]. */
+	const zsl_real_t *h;
+	/**
+	 * The delay line of 2 * taps * channels entries. Each sample is
+	 * stored twice, so the most recent 'taps' samples are always
+	 * contiguous.
+	 */
+	zsl_real_t *state;
+	/** The position of the newest sample in the delay line. */
+	size_t pos;
+};
+
+/**
+ * @brief The coefficients of one second-order IIR section, normalised so
+ *        that a0 is 1:
+ *        H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+ */
+struct zsl_biquad {
+	zsl_real_t b0;
+	zsl_real_t b1;
+	zsl_real_t b2;
+	zsl_real_t a1;
+	zsl_real_t a2;
+};
+
+/**
+ * @brief An infinite impulse response filter, made of a cascade of
+ *        second-order sections in transposed direct form II.
+ */
+struct zsl_iir {
+	/** The number of second-order sections. */
+	size_t stages;
+	/** The number of interleaved channels in each block. */
+	size_t channels;
+	/** The coefficients of each section, in the order applied. */
+	const struct zsl_biquad *coeffs;
+	/** The two state variables of each section and channel, 2 * stages *
+	 * channels entries. */
+	zsl_real_t *state;
+};
+
+/** Macro to declare an FIR filter with 'ntaps' coefficients at 'hc' and
+ * 'nch' channels, along with its delay line.
+ *
+ * Be sure to also call 'zsl_fir_init' on the filter after this macro, since
+ * a delay line declared on the stack may have non-zero values by default!
+ */
+#define ZSL_FIR_DEF(fname, ntaps, nch, hc)			\
+	zsl_real_t fname ## _state[2 * (ntaps) * (nch)];	\
+	struct zsl_fir fname = {				\
+		.taps = ntaps,					\
+		.channels = nch,				\
+		.h = hc,					\
+		.state = fname ## _state,			\
+		.pos = 0					\
+	}
+
+/** Macro to declare an IIR filter with the 'nstages' sections at 'bq' and
+ * 'nch' channels, along with its state.
+ *
+ * Be sure to also call 'zsl_iir_init' on the filter after this macro, since
+ * state declared on the stack may have non-zero values by default!
+ */
+#define ZSL_IIR_DEF(iname, nstages, nch, bq)			\
+	zsl_real_t iname ## _state[2 * (nstages) * (nch)];	\
+	struct zsl_iir iname = {				\
+		.stages = nstages,				\
+		.channels = nch,				\
+		.coeffs = bq,					\
+		.state = iname ## _state			\
+	}
+
+/** @} */ /* End of FILTER_STRUCTS group */
+
+/**
+ * @addtogroup FILTER_FUNCS Functions
+ *
+ * @brief Filter functions.
+ *
+ * @ingroup FILTER
+ *  @{ */
+
+/**
+ * @brief Clears the history of FIR filter 'f', as if every earlier input
+ *        had been zero.
+ *
+ * @param f     The filter to reset.
+ *
+ * @return 0 on success, or -EINVAL if 'f' has no taps or channels.
+ */
+int zsl_fir_init(struct zsl_fir *f);
+
+/**
+ * @brief Filters the block of samples in 'v' in place with FIR filter 'f'.
+ *
+ * @param f     The filter to apply.
+ * @param v     The interleaved block of samples, whose size must be a
+ *              multiple of the number of channels.
+ *
+ * @return 0 on success, or -EINVAL if the block size isn't valid.
+ */
+int zsl_fir_process(struct zsl_fir *f, struct zsl_vec *v);
+
+/**
+ * @brief Filters the block of samples in 'v' with FIR filter 'f', keeping
+ *        every 'm'th output in 'w'. Only the outputs kept are computed.
+ *
+ * @param f     The anti-aliasing filter to apply.
+ * @param m     The decimation factor.
+ * @param v     The interleaved input block, whose size must be a multiple
+ *              of 'm' times the number of channels.
+ * @param w     The output block, 1 / m the size of 'v'. This may be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the block sizes aren't valid.
+ */
+int zsl_fir_decim(struct zsl_fir *f, size_t m, const struct zsl_vec *v,
+		  struct zsl_vec *w);
+
+/**
+ * @brief Upsamples the block of samples in 'v' by a factor of 'l' into
+ *        'w', using FIR filter 'f' as the interpolation filter.
+ *
+ * This is equivalent to inserting l - 1 zeros after each input sample and
+ * filtering the result, but skips the products with those zeros. The
+ * coefficients should have a DC gain of 'l' to preserve the amplitude.
+ *
+ * Only the most recent ceil(taps / l) inputs are kept in the delay line,
+ * so a filter used for interpolation shouldn't be used with the other
+ * process functions without calling @ref zsl_fir_init first.
+ *
+ * @param f     The interpolation filter to apply.
+ * @param l     The interpolation factor.
+ * @param v     The interleaved input block, whose size must be a multiple
+ *              of the number of channels.
+ * @param w     The output block, 'l' times the size of 'v'. This must not
+ *              be 'v'.
+ *
+ * @return 0 on success, or -EINVAL if the block sizes aren't valid.
+ */
+int zsl_fir_interp(struct zsl_fir *f, size_t l, const struct zsl_vec *v,
+		   struct zsl_vec *w);
+
+/**
+ * @brief Clears the history of IIR filter 'f', as if every earlier input
+ *        had been zero.
+ *
+ * @param f     The filter to reset.
+ *
+ * @return 0 on success, or -EINVAL if 'f' has no channels.
+ */
+int zsl_iir_init(struct zsl_iir *f);
+
+/**
+ * @brief Filters the block of samples in 'v' in place with IIR filter 'f'.
+ *
+ * Each section is applied to the whole block before the next, which keeps
+ * its coefficients in registers.
+ *
+ * @param f     The filter to apply.
+ * @param v     The interleaved block of samples, whose size must be a
+ *              multiple of the number of channels.
+ *
+ * @return 0 on success, or -EINVAL if the block size isn't valid.
+ */
+int zsl_iir_process(struct zsl_iir *f, struct zsl_vec *v);
+
+/** @} */ /* End of FILTER_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FILTER_H_ */
+
+/** @} */ /* End of filter group */
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FIXED Fixed-Point
+ *
+ * @brief Q31 fixed-point vectors, matrices, quaternions and interpolation.
+ *
+ * These functions provide an integer-only alternative to the zsl_real_t
+ * APIs for devices without an FPU (Cortex-M0+, etc.), where every float or
+ * double operation is emulated in software.
+ *
+ * Values are stored in Q31 format, where an int32_t 'q' represents the real
+ * value q / 2^31, covering the range [-1.0, 1.0). Inputs must be scaled
+ * into this range by the caller. Intermediate products are accumulated in
+ * 64 bits with 16 guard bits, and results saturate rather than wrap.
+ */
+
+/**
+ * @file
+ * @brief API header file for fixed-point functions in zscilib.
+ *
+ * This file contains the zscilib fixed-point APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_FIXED_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/orientation/quaternions.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FIXED_STRUCTS Structs, Enums and Macros
+ *
+ * @brief Various structs and macros related to fixed-point values.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/** @brief A Q31 fixed-point value, representing q / 2^31. */
+typedef int32_t zsl_q31_t;
+
+/** @brief A Q15 fixed-point value, representing q / 2^15. */
+typedef int16_t zsl_q15_t;
+
+/** @brief The largest Q31 value, just below 1.0. */
+#define ZSL_Q31_MAX INT32_MAX
+
+/** @brief The smallest Q31 value, -1.0. */
+#define ZSL_Q31_MIN INT32_MIN
+
+/**
+ * @brief Converts the constant 'x', where -1.0 <= x < 1.0, to Q31 at
+ *        compile time.
+ */
+#define ZSL_Q31(x) ((zsl_q31_t)((x) * 2147483648.0))
+
+/** @brief Represents a vector of Q31 values. */
+struct zsl_vec_q31 {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The Q31 elements in the vector. */
+	zsl_q31_t *data;
+};
+
+/** @brief Represents a row-major matrix of Q31 values. */
+struct zsl_mtx_q31 {
+	/** The number of rows in the matrix (typically denoted as 'm'). */
+	size_t sz_rows;
+	/** The number of columns in the matrix (typically denoted as 'n'). */
+	size_t sz_cols;
+	/** The Q31 entries in the matrix, in row-major order. */
+	zsl_q31_t *data;
+};
+
+/** @brief Represents a quaternion with Q31 components. */
+struct zsl_quat_q31 {
+	zsl_q31_t r;    /**< @brief The real component. */
+	zsl_q31_t i;    /**< @brief The first imaginary component. */
+	zsl_q31_t j;    /**< @brief The second imaginary component */
+	zsl_q31_t k;    /**< @brief The third imaginary component. */
+};
+
+/** @brief XY struct for Q31 linear interpolation. */
+struct zsl_interp_xy_q31 {
+	zsl_q31_t x;
+	zsl_q31_t y;
+};
+
+/** Macro to declare a Q31 vector of size `n`. */
+#define ZSL_VEC_Q31_DEF(name, n)	      \
+	zsl_q31_t name ## _vec[n];	      \
+	struct zsl_vec_q31 name = {	      \
+		.sz = n,		      \
+		.data = name ## _vec	      \
+	}
+
+/** Macro to declare a Q31 matrix with `m` rows and `n` columns. */
+#define ZSL_MTX_Q31_DEF(name, m, n)	      \
+	zsl_q31_t name ## _mtx[m * n];	      \
+	struct zsl_mtx_q31 name = {	      \
+		.sz_rows = m,		      \
+		.sz_cols = n,		      \
+		.data = name ## _mtx	      \
+	}
+
+/** @} */ /* End of FIXED_STRUCTS group */
+
+/**
+ * @addtogroup FIXED_SCALAR Scalar Functions
+ *
+ * @brief Saturating arithmetic on single fixed-point values.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/** @brief Saturates the 64-bit value 'x' to the Q31 range. */
+static inline zsl_q31_t zsl_q31_sat(int64_t x)
+{
+	if (x > ZSL_Q31_MAX) {
+		return ZSL_Q31_MAX;
+	}
+	if (x < ZSL_Q31_MIN) {
+		return ZSL_Q31_MIN;
+	}
+
+	return (zsl_q31_t)x;
+}
+
+/** @brief Returns the saturated sum a + b. */
+static inline zsl_q31_t zsl_q31_add(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat((int64_t)a + b);
+}
+
+/** @brief Returns the saturated difference a - b. */
+static inline zsl_q31_t zsl_q31_sub(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat((int64_t)a - b);
+}
+
+/** @brief Returns the rounded, saturated product a * b. */
+static inline zsl_q31_t zsl_q31_mul(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat(((int64_t)a * b + (1LL << 30)) >> 31);
+}
+
+/** @brief Converts the Q15 value 'a' to Q31. */
+static inline zsl_q31_t zsl_q15_to_q31(zsl_q15_t a)
+{
+	return (zsl_q31_t)a * 65536;
+}
+
+/** @brief Converts the Q31 value 'a' to Q15, rounding to nearest. */
+static inline zsl_q15_t zsl_q31_to_q15(zsl_q31_t a)
+{
+	int64_t x = ((int64_t)a + (1 << 15)) >> 16;
+
+	return (zsl_q15_t)(x > INT16_MAX ? INT16_MAX : x);
+}
+
+/**
+ * @brief Converts 'x' to Q31, saturating values outside [-1.0, 1.0).
+ *
+ * This uses floating-point arithmetic, and is intended for converting data
+ * at the boundaries of an application rather than in inner loops.
+ */
+zsl_q31_t zsl_q31_from_real(zsl_real_t x);
+
+/** @brief Converts the Q31 value 'q' to a zsl_real_t. */
+zsl_real_t zsl_q31_to_real(zsl_q31_t q);
+
+/** @} */ /* End of FIXED_SCALAR group */
+
+/**
+ * @addtogroup FIXED_VEC Vector Functions
+ *
+ * @brief Q31 equivalents of common zsl_vec functions.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Converts the zsl_real_t vector 'v' to the Q31 vector 'q',
+ *        saturating any values outside [-1.0, 1.0).
+ *
+ * @param v     The input vector.
+ * @param q     The output Q31 vector, with the same size as 'v'.
+ *
+ * @return 0 on success, or -EINVAL if 'v' and 'q' differ in size.
+ */
+int zsl_vec_q31_from_vec(struct zsl_vec *v, struct zsl_vec_q31 *q);
+
+/**
+ * @brief Converts the Q31 vector 'q' to the zsl_real_t vector 'v'.
+ *
+ * @param q     The input Q31 vector.
+ * @param v     The output vector, with the same size as 'q'.
+ *
+ * @return 0 on success, or -EINVAL if 'q' and 'v' differ in size.
+ */
+int zsl_vec_q31_to_vec(struct zsl_vec_q31 *q, struct zsl_vec *v);
+
+/**
+ * @brief Adds corresponding elements of 'v' and 'w', saturating the results
+ *        in 'x'.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector, which may be 'v' or 'w'.
+ *
+ * @return 0 on success, or -EINVAL if the vectors differ in size.
+ */
+int zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Subtracts corresponding elements of 'w' from 'v', saturating the
+ *        results in 'x'.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param x     The output vector, which may be 'v' or 'w'.
+ *
+ * @return 0 on success, or -EINVAL if the vectors differ in size.
+ */
+int zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Negates the elements of 'v' in place, saturating -1.0 to the
+ *        largest Q31 value.
+ *
+ * @param v     The vector to negate.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_neg(struct zsl_vec_q31 *v);
+
+/**
+ * @brief Multiplies the elements of 'v' by the Q31 scalar 's' in place.
+ *
+ * @param v     The vector to scale.
+ * @param s     The Q31 scalar.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s);
+
+/**
+ * @brief Computes the dot product of 'v' and 'w', saturating the result.
+ *
+ * The products are accumulated in 64 bits, so only the final result is
+ * saturated, even if a partial sum leaves the Q31 range.
+ *
+ * @param v     The first input vector.
+ * @param w     The second input vector.
+ * @param d     Pointer to the output Q31 dot product.
+ *
+ * @return 0 on success, or -EINVAL if 'v' and 'w' differ in size.
+ */
+int zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    zsl_q31_t *d);
+
+/**
+ * @brief Returns the norm (magnitude) of 'v', saturating at the largest Q31
+ *        value when the norm is 1.0 or greater.
+ *
+ * @param v     The input vector.
+ *
+ * @return The Q31 norm of 'v'.
+ */
+zsl_q31_t zsl_vec_q31_norm(struct zsl_vec_q31 *v);
+
+/** @} */ /* End of FIXED_VEC group */
+
+/**
+ * @addtogroup FIXED_MTX Matrix Functions
+ *
+ * @brief Q31 equivalents of common zsl_mtx functions.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Converts the zsl_real_t matrix 'm' to the Q31 matrix 'q',
+ *        saturating any values outside [-1.0, 1.0).
+ *
+ * @param m     The input matrix.
+ * @param q     The output Q31 matrix, with the same shape as 'm'.
+ *
+ * @return 0 on success, or -EINVAL if 'm' and 'q' differ in shape.
+ */
+int zsl_mtx_q31_from_mtx(struct zsl_mtx *m, struct zsl_mtx_q31 *q);
+
+/**
+ * @brief Converts the Q31 matrix 'q' to the zsl_real_t matrix 'm'.
+ *
+ * @param q     The input Q31 matrix.
+ * @param m     The output matrix, with the same shape as 'q'.
+ *
+ * @return 0 on success, or -EINVAL if 'q' and 'm' differ in shape.
+ */
+int zsl_mtx_q31_to_mtx(struct zsl_mtx_q31 *q, struct zsl_mtx *m);
+
+/**
+ * @brief Adds corresponding entries of 'ma' and 'mb', saturating the
+ *        results in 'mc'.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix, which may be 'ma' or 'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the matrices differ in shape.
+ */
+int zsl_mtx_q31_add(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Subtracts corresponding entries of 'mb' from 'ma', saturating the
+ *        results in 'mc'.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix.
+ * @param mc    The output matrix, which may be 'ma' or 'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the matrices differ in shape.
+ */
+int zsl_mtx_q31_sub(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		    struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Multiplies matrices 'ma' and 'mb', assigning the saturated product
+ *        to 'mc'.
+ *
+ * Each entry is accumulated in 64 bits, as with @ref zsl_vec_q31_dot.
+ *
+ * @param ma    The first input matrix.
+ * @param mb    The second input matrix, with as many rows as 'ma' has
+ *              columns.
+ * @param mc    The output matrix, with the rows of 'ma' and the columns of
+ *              'mb'. This must not be 'ma' or 'mb'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_mult(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		     struct zsl_mtx_q31 *mc);
+
+/**
+ * @brief Multiplies the entries of 'm' by the Q31 scalar 's' in place.
+ *
+ * @param m     The matrix to scale.
+ * @param s     The Q31 scalar.
+ *
+ * @return 0 on success.
+ */
+int zsl_mtx_q31_scalar_mult(struct zsl_mtx_q31 *m, zsl_q31_t s);
+
+/**
+ * @brief Transposes 'ma' into 'mb'.
+ *
+ * @param ma    The input matrix.
+ * @param mb    The output matrix, with the columns and rows of 'ma'. This
+ *              must not be 'ma'.
+ *
+ * @return 0 on success, or -EINVAL if the shapes don't match.
+ */
+int zsl_mtx_q31_trans(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb);
+
+/** @} */ /* End of FIXED_MTX group */
+
+/**
+ * @addtogroup FIXED_QUAT Quaternion Functions
+ *
+ * @brief Q31 equivalents of common zsl_quat functions.
+ *
+ * Since a unit quaternion may have a component of exactly 1.0, which Q31
+ * can't represent, such components saturate to the largest Q31 value.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Converts the quaternion 'q' to the Q31 quaternion 'qq',
+ *        saturating any components outside [-1.0, 1.0).
+ *
+ * @param q     The input quaternion.
+ * @param qq    The output Q31 quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_from_quat(struct zsl_quat *q, struct zsl_quat_q31 *qq);
+
+/**
+ * @brief Converts the Q31 quaternion 'qq' to the quaternion 'q'.
+ *
+ * @param qq    The input Q31 quaternion.
+ * @param q     The output quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_to_quat(struct zsl_quat_q31 *qq, struct zsl_quat *q);
+
+/**
+ * @brief Returns the magnitude of 'q', saturating at the largest Q31 value
+ *        when the magnitude is 1.0 or greater.
+ *
+ * @param q     The input quaternion.
+ *
+ * @return The Q31 magnitude of 'q'.
+ */
+zsl_q31_t zsl_quat_q31_magn(struct zsl_quat_q31 *q);
+
+/**
+ * @brief Normalises 'q' to a unit quaternion in 'qn'. A zero quaternion
+ *        produces a zero output.
+ *
+ * @param q     The input quaternion.
+ * @param qn    The output unit quaternion, which may be 'q'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_to_unit(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qn);
+
+/**
+ * @brief Multiplies each component of 'q' by the Q31 scalar 's'.
+ *
+ * @param q     The input quaternion.
+ * @param s     The Q31 scalar.
+ * @param qs    The output quaternion, which may be 'q'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_scale(struct zsl_quat_q31 *q, zsl_q31_t s,
+		       struct zsl_quat_q31 *qs);
+
+/**
+ * @brief Computes the Hamilton product of 'qa' and 'qb', assigning the
+ *        saturated result to 'qm'.
+ *
+ * @param qa    The first input quaternion.
+ * @param qb    The second input quaternion.
+ * @param qm    The output quaternion, which may be 'qa' or 'qb'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_mult(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		      struct zsl_quat_q31 *qm);
+
+/**
+ * @brief Assigns the conjugate of 'q' to 'qc'. For a unit quaternion, this
+ *        is also the inverse.
+ *
+ * @param q     The input quaternion.
+ * @param qc    The output quaternion, which may be 'q'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_conj(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qc);
+
+/** @} */ /* End of FIXED_QUAT group */
+
+/**
+ * @addtogroup FIXED_INTERP Interpolation Functions
+ *
+ * @brief Q31 equivalents of the linear interpolation functions.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Linear (AKA 'piecewise linear') interpolation for Y between the
+ *        points in a Q31 XY array. This is the fixed-point equivalent of
+ *        zsl_interp_lin_y_arr.
+ *
+ * @param xy  The array of XY pairs, sorted on X in ascending or descending
+ *            order (min two!).
+ * @param n   The number of elements in the XY array.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the interpolated Y value, which
+ *            is set to 0 on error.
+ *
+ * @return 0 on success, or -EINVAL if 'n' is less than two, 'x' is outside
+ *         the range of the array, or the matching points share an X value.
+ */
+int zsl_interp_lin_y_arr_q31(struct zsl_interp_xy_q31 xy[], size_t n,
+			     zsl_q31_t x, zsl_q31_t *y);
+
+/** @} */ /* End of FIXED_INTERP group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FIXED_H_ */
+
+/** @} */ /* End of fixed group */
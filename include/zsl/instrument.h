@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup INSTRUMENT Instrumentation
+ *
+ * @brief Peak stack and scratch memory use of library functions.
+ *
+ * The temporaries used by functions like zsl_mtx_pinv are sized from their
+ * inputs at runtime, so their stack use can't be known from a static
+ * analysis of the image. When CONFIG_ZSL_INSTRUMENT is enabled, every
+ * function that declares temporaries with ZSL_SCRATCH_DEF, as well as the
+ * functions that place variable-length arrays on the stack, keeps a record
+ * of the number of times it was called and the largest amount of stack and
+ * scratch memory any one of those calls used, including that used by the
+ * library functions it called in turn.
+ *
+ * Stack use is measured from the frame of the instrumented function to the
+ * deepest point reached at any instrumented call or workspace allocation
+ * beneath it. Leaf functions with no temporaries aren't observed, so the
+ * figures are a close lower bound rather than exact, and a margin should be
+ * allowed when sizing thread stacks from them. Scratch memory is the peak
+ * number of bytes allocated from workspaces, including the shared scratch
+ * pool, during the call.
+ *
+ * When CONFIG_ZSL_TRACE is enabled, the most expensive functions also
+ * report the entry and exit of each call, and the number of cycles it took,
+ * to @ref zsl_trace_hook_enter and @ref zsl_trace_hook_exit, which an
+ * application can define to pass them on to its tracing backend. With
+ * CONFIG_ZSL_TRACE_HIST, a histogram of the cycle counts of each function is
+ * also kept, which can be read with @ref zsl_trace_stats.
+ *
+ * When these options are disabled, the instrumentation compiles to nothing.
+ */
+
+/**
+ * @file
+ * @brief API header file for instrumentation in zscilib.
+ *
+ * This file contains the zscilib instrumentation APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_INSTRUMENT_H_
+#define ZEPHYR_INCLUDE_ZSL_INSTRUMENT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup INSTR_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for instrumentation.
+ *
+ * @ingroup INSTRUMENT
+ *  @{ */
+
+/** @brief The usage recorded for one instrumented function. */
+struct zsl_instr_rec {
+	/** The name of the function. */
+	const char *name;
+	/** The number of calls made since startup or the last reset. */
+	uint32_t calls;
+	/** The most stack used by any one call, in bytes. */
+	size_t stack;
+	/** The most scratch memory used by any one call, in bytes. */
+	size_t scratch;
+	/** The next record, or NULL. Records are added on first use. */
+	struct zsl_instr_rec *next;
+	/** Whether this record has been added to the list. */
+	bool listed;
+};
+
+/** @brief The state of an instrumented call that is in progress. */
+struct zsl_instr_frame {
+	/** The record for the function. */
+	struct zsl_instr_rec *rec;
+	/** The frame address of the function. */
+	uintptr_t sp0;
+	/** The lowest stack address seen during the call. */
+	uintptr_t sp_min;
+	/** The scratch memory in use when the call started, in bytes. */
+	size_t scratch0;
+	/** The most scratch memory in use during the call, in bytes. */
+	size_t scratch_max;
+	/** The call this one was made from, or NULL. */
+	struct zsl_instr_frame *up;
+};
+
+/**
+ * Macro to start recording the usage of the enclosing function, where
+ * 'pfx' is a prefix for the variables it declares. The call ends when the
+ * enclosing block is left, however that happens.
+ *
+ * This is included in ZSL_SCRATCH_DEF, so it is only needed in functions
+ * that place temporaries on the stack in other ways.
+ */
+#if CONFIG_ZSL_INSTRUMENT
+#define ZSL_INSTR_ENTER(pfx)						\
+	static struct zsl_instr_rec pfx ## _rec = { .name = __func__ };	\
+	struct zsl_instr_frame pfx ## _frame				\
+	__attribute__((cleanup(zsl_instr_exit))) = {			\
+		.rec = &pfx ## _rec,					\
+		.sp0 = (uintptr_t)__builtin_frame_address(0)		\
+	};								\
+	zsl_instr_enter(&pfx ## _frame)
+#else
+#define ZSL_INSTR_ENTER(pfx) do { } while (0)
+#endif
+
+/** The number of bins in a cycle count histogram. */
+#define ZSL_TRACE_HIST_BINS     (32)
+
+/** @brief The functions that report their calls when tracing is enabled. */
+enum zsl_trace_id {
+	ZSL_TRACE_MTX_MULT,
+	ZSL_TRACE_MTX_SVD,
+	ZSL_TRACE_MTX_EIGENVALUES,
+	/** The per-sample update of the fusion drivers. */
+	ZSL_TRACE_FUS_FEED,
+	ZSL_TRACE_CLR_CONV_SPD_XYZ,
+	ZSL_TRACE_COUNT
+};
+
+/** @brief A traced call that is in progress. */
+struct zsl_trace_span {
+	/** The function that was called. */
+	enum zsl_trace_id id;
+	/** The cycle count when the call started. */
+	uint32_t t0;
+};
+
+/** @brief The cycle counts recorded for one traced function. */
+struct zsl_trace_stats {
+	/** The number of calls made since startup or the last reset. */
+	uint32_t calls;
+	/** The fewest cycles any call took. */
+	uint32_t min;
+	/** The most cycles any call took. */
+	uint32_t max;
+	/** The total number of cycles taken by all calls. */
+	uint64_t total;
+	/**
+	 * The number of calls in each bin, where bin 'i' counts the calls
+	 * that took from 2^i to 2^(i + 1) - 1 cycles. Bin 0 also counts the
+	 * calls that took 0 cycles.
+	 */
+	uint32_t hist[ZSL_TRACE_HIST_BINS];
+};
+
+/**
+ * Macro to trace the rest of the enclosing block as a call to function
+ * 'id', which is reported when the block is left, however that happens.
+ */
+#if CONFIG_ZSL_TRACE
+#define ZSL_TRACE(id)							\
+	struct zsl_trace_span zsl_trace_span_				\
+	__attribute__((cleanup(zsl_trace_end))) = zsl_trace_begin(id)
+#else
+#define ZSL_TRACE(id) do { } while (0)
+#endif
+
+/** @} */ /* End of INSTR_STRUCTS group */
+
+/**
+ * @addtogroup INSTR_FUNCS Functions
+ *
+ * @brief Functions used to read the recorded usage.
+ *
+ * @ingroup INSTRUMENT
+ *  @{ */
+
+#if CONFIG_ZSL_INSTRUMENT
+/**
+ * @brief Returns the first usage record, or NULL if no instrumented
+ *        function has been called. The rest follow through 'next'.
+ */
+const struct zsl_instr_rec *zsl_instr_first(void);
+
+/**
+ * @brief Returns the usage record for function 'name', or NULL if it
+ *        hasn't been called.
+ *
+ * @param name  The name of the function, for example "zsl_mtx_pinv".
+ */
+const struct zsl_instr_rec *zsl_instr_find(const char *name);
+
+/**
+ * @brief Clears the call counts and peaks of every record.
+ */
+void zsl_instr_reset(void);
+
+/**
+ * @brief Starts the call described by 'f'. Used by ZSL_INSTR_ENTER.
+ *
+ * @param f     The frame of the call, with 'rec' and 'sp0' set.
+ */
+void zsl_instr_enter(struct zsl_instr_frame *f);
+
+/**
+ * @brief Ends the call described by 'f', updating its record. Used by
+ *        ZSL_INSTR_ENTER.
+ *
+ * @param f     The frame of the call.
+ */
+void zsl_instr_exit(struct zsl_instr_frame *f);
+
+/**
+ * @brief Accounts for 'delta' bytes of scratch memory being allocated, or
+ *        freed if negative, and samples the stack depth. Called by the
+ *        workspace functions.
+ *
+ * @param delta The change in scratch memory use, in bytes.
+ */
+void zsl_instr_scratch(ptrdiff_t delta);
+#else
+static inline void zsl_instr_scratch(ptrdiff_t delta)
+{
+	(void)delta;
+}
+#endif
+
+#if CONFIG_ZSL_TRACE
+/**
+ * @brief Called on entry to traced function 'id'.
+ *
+ * The default does nothing. An application can define its own version to
+ * pass the event to a tracing backend, such as SEGGER SystemView or CTF.
+ *
+ * @param id    The function that was called.
+ */
+void zsl_trace_hook_enter(enum zsl_trace_id id);
+
+/**
+ * @brief Called on exit from traced function 'id'.
+ *
+ * The default does nothing, see @ref zsl_trace_hook_enter.
+ *
+ * @param id        The function that returned.
+ * @param cycles    The number of cycles the call took.
+ */
+void zsl_trace_hook_exit(enum zsl_trace_id id, uint32_t cycles);
+
+/**
+ * @brief Returns the name of traced function 'id', or NULL if 'id' isn't
+ *        valid.
+ *
+ * @param id    The function to return the name of.
+ */
+const char *zsl_trace_name(enum zsl_trace_id id);
+
+#if CONFIG_ZSL_TRACE_HIST
+/**
+ * @brief Copies the cycle counts recorded for traced function 'id' into
+ *        'st'.
+ *
+ * @param id    The function to return the counts of.
+ * @param st    Pointer to the output counts.
+ *
+ * @return 0 on success, or -EINVAL if 'id' isn't valid.
+ */
+int zsl_trace_stats(enum zsl_trace_id id, struct zsl_trace_stats *st);
+
+/**
+ * @brief Clears the cycle counts of every traced function.
+ */
+void zsl_trace_reset(void);
+#endif
+
+/**
+ * @brief Starts a traced call to 'id'. Used by ZSL_TRACE.
+ *
+ * @param id    The function that was called.
+ *
+ * @return The span to pass to @ref zsl_trace_end when the call returns.
+ */
+struct zsl_trace_span zsl_trace_begin(enum zsl_trace_id id);
+
+/**
+ * @brief Ends traced call 's'. Used by ZSL_TRACE.
+ *
+ * @param s     The span returned by @ref zsl_trace_begin.
+ */
+void zsl_trace_end(struct zsl_trace_span *s);
+#endif
+
+/** @} */ /* End of INSTR_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_INSTRUMENT_H_ */
+
+/** @} */ /* End of instrumentation group */
@@ -21,6 +21,7 @@
 #ifndef ZEPHYR_INCLUDE_ZSL_INTERP_H_
 #define ZEPHYR_INCLUDE_ZSL_INTERP_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <zsl/zsl.h>
 
@@ -28,6 +29,9 @@
 extern "C" {
 #endif
 
+/* Forward declaration, see zsl/workspace.h. */
+struct zsl_workspace;
+
 /**
  * @addtogroup INTERP_STRUCTS Structs and Enums
  *
@@ -49,6 +53,122 @@ struct zsl_interp_xyc {
         zsl_real_t y2; /**< @brief Second derivative from the spline. */
 };
 
+/**
+ * @brief Search state for repeated lookups in the same X,Y table.
+ *
+ * The interval found by the last lookup is kept, and the next lookup hunts
+ * outwards from it in steps of 1, 2, 4, ... before bisecting, so queries
+ * that change slowly cost O(1) rather than O(log n). Each context belongs
+ * to one table, and must be set up with @ref zsl_interp_cache_init or
+ * @ref zsl_interp_cache_init_xyc.
+ */
+struct zsl_interp_cache {
+        /** @brief The number of elements in the table. */
+        size_t n;
+        /** @brief The lower index of the last interval found. */
+        size_t idx;
+        /** @brief Whether x ascends (true) or descends (false). */
+        bool asc;
+};
+
+/**
+ * @brief A table of y values sampled on a uniform x grid, with y[i] at
+ *        x0 + i * dx.
+ *
+ * Since the x values are implied, the table takes half the memory of an
+ * array of @ref zsl_interp_xy, and a lookup is a direct index with no
+ * search. 'y2' holds the spline's second derivatives for cubic
+ * interpolation, and may be NULL if only linear or nearest neighbour
+ * interpolation is used.
+ */
+struct zsl_interp_grid {
+        /** @brief The x value of y[0]. */
+        zsl_real_t x0;
+        /** @brief The spacing between x values, which must be positive. */
+        zsl_real_t dx;
+        /** @brief The number of y values (min two!). */
+        size_t n;
+        /** @brief The y values. */
+        const zsl_real_t *y;
+        /** @brief 'n' second derivatives from the spline, or NULL. */
+        zsl_real_t *y2;
+};
+
+/**
+ * @brief One interval of a piecewise cubic, with y = a + t * (b + t * (c +
+ *        t * d)) for t = x - 'x' up to the next interval's 'x'.
+ */
+struct zsl_interp_spline_seg {
+        /** @brief The x value at the start of the interval. */
+        zsl_real_t x;
+        /** @brief The y value at the start of the interval. */
+        zsl_real_t a;
+        /** @brief The first derivative at the start of the interval. */
+        zsl_real_t b;
+        /** @brief Half the second derivative at the start of the interval. */
+        zsl_real_t c;
+        /** @brief A sixth of the third derivative over the interval. */
+        zsl_real_t d;
+};
+
+/**
+ * @brief A piecewise cubic through 'n' points, with its polynomial
+ *        coefficients precomputed so that evaluation is a single Horner
+ *        step.
+ *
+ * The last of the 'n' segments only holds the final x and y values.
+ * Lookups hunt from the previous interval using 'cache', so a spline
+ * should only be evaluated from one thread at a time. Declare the spline
+ * and its storage with @ref ZSL_INTERP_SPLINE_DEF.
+ */
+struct zsl_interp_spline {
+        /** @brief The number of points. */
+        size_t n;
+        /** @brief The 'n' segments. */
+        struct zsl_interp_spline_seg *seg;
+        /** @brief Search state for the last lookup. */
+        struct zsl_interp_cache cache;
+};
+
+/**
+ * Macro to declare a piecewise cubic through 'sz' points.
+ *
+ * Be sure to also build the spline with 'zsl_interp_spline_natural',
+ * 'zsl_interp_spline_pchip' or 'zsl_interp_spline_akima' after this macro,
+ * since the storage is not initialised.
+ */
+#define ZSL_INTERP_SPLINE_DEF(name, sz)              \
+        struct zsl_interp_spline_seg name ## _seg[sz]; \
+        struct zsl_interp_spline name = {              \
+                .n = sz,                               \
+                .seg = name ## _seg                    \
+        }
+
+/**
+ * @brief A 2D table of z values over ascending x and y axes, with
+ *        z[i * ny + j] at (x[i], y[j]).
+ *
+ * The axes can be unevenly spaced. The cell of the last lookup is kept in
+ * 'cx' and 'cy', so a table should only be used from one thread at a time.
+ * Set the axes and values, then call @ref zsl_interp_grid2_init.
+ */
+struct zsl_interp_grid2 {
+        /** @brief The 'nx' x values, strictly ascending. */
+        const zsl_real_t *x;
+        /** @brief The number of x values (min two!). */
+        size_t nx;
+        /** @brief The 'ny' y values, strictly ascending. */
+        const zsl_real_t *y;
+        /** @brief The number of y values (min two!). */
+        size_t ny;
+        /** @brief The 'nx' * 'ny' z values, in row-major order. */
+        const zsl_real_t *z;
+        /** @brief Search state for the x axis. */
+        struct zsl_interp_cache cx;
+        /** @brief Search state for the y axis. */
+        struct zsl_interp_cache cy;
+};
+
 /** @} */ /* End of INTERP_STRUCTS group */
 
 /**
@@ -205,6 +325,332 @@ int zsl_interp_cubic_calc (struct zsl_interp_xyc xyc[], size_t n,
 int zsl_interp_cubic_arr(struct zsl_interp_xyc xyc[], size_t n,
                          zsl_real_t x, zsl_real_t *y);
 
+/**
+ * @brief Sets up search context 'c' for lookups in table 'xy', detecting
+ *        its order once.
+ *
+ * @param c   The search context to initialise.
+ * @param xy  The monotonic array of X,Y values to be searched.
+ * @param n   The number of elements in the X,Y array (min two!).
+ *
+ * @return 0 on success, or -EINVAL if n < 2.
+ */
+int zsl_interp_cache_init(struct zsl_interp_cache *c,
+                          struct zsl_interp_xy xy[], size_t n);
+
+/**
+ * @brief Sets up search context 'c' for lookups in cubic spline table 'xyc',
+ *        whose x values must ascend.
+ *
+ * @param c    The search context to initialise.
+ * @param xyc  The ascending array of X,Y,Y2 values to be searched.
+ * @param n    The number of elements in the X,Y,Y2 array (min three!).
+ *
+ * @return 0 on success, or -EINVAL if n < 3 or x descends.
+ */
+int zsl_interp_cache_init_xyc(struct zsl_interp_cache *c,
+                              struct zsl_interp_xyc xyc[], size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_interp_find_x, but hunting from the interval
+ *        of the last lookup made with search context 'c'.
+ *
+ * @param c   The search context for 'xy'.
+ * @param xy  The array of X,Y values to search.
+ * @param x   The x value to search for.
+ * @param idx Pointer to the placeholder for the position of x in the X,Y array.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range, with 'idx' set to
+ *         -1 or n as per @ref zsl_interp_find_x.
+ */
+int zsl_interp_find_x_cached(struct zsl_interp_cache *c,
+                             struct zsl_interp_xy xy[], zsl_real_t x,
+                             int *idx);
+
+/**
+ * @brief Equivalent to @ref zsl_interp_nn_arr, using search context 'c'.
+ *
+ * @param c   The search context for 'xy'.
+ * @param xy  The array of XY pairs to use when interpolating.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int zsl_interp_nn_cached(struct zsl_interp_cache *c,
+                         struct zsl_interp_xy xy[], zsl_real_t x,
+                         zsl_real_t *y);
+
+/**
+ * @brief Equivalent to @ref zsl_interp_lin_y_arr, using search context 'c'.
+ *
+ * @param c   The search context for 'xy'.
+ * @param xy  The array of XY pairs to use when interpolating.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int zsl_interp_lin_y_cached(struct zsl_interp_cache *c,
+                            struct zsl_interp_xy xy[], zsl_real_t x,
+                            zsl_real_t *y);
+
+/**
+ * @brief Equivalent to @ref zsl_interp_cubic_arr, using search context 'c',
+ *        except that x must be within the table.
+ *
+ * @param c    The search context for 'xyc'.
+ * @param xyc  The array of X,Y,Y2 values to use when interpolating, with Y2
+ *             from @ref zsl_interp_cubic_calc.
+ * @param x    The X value to interpolate for (x >= xyc[0].x, <= xyc[n-1].x).
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range.
+ */
+int zsl_interp_cubic_cached(struct zsl_interp_cache *c,
+                            struct zsl_interp_xyc xyc[], zsl_real_t x,
+                            zsl_real_t *y);
+
+/**
+ * @brief Linear interpolation of every value of 'xs' in table 'xy'.
+ *
+ * Each lookup hunts from the interval of the previous one, so sorted or
+ * nearly sorted queries walk the table in a single pass, in O(n + count)
+ * steps rather than O(count * log n). Unsorted queries are still correct.
+ *
+ * @param xy    The array of XY pairs to use when interpolating (min two!).
+ * @param n     The number of elements in the XY array.
+ * @param xs    The 'count' X values to interpolate for.
+ * @param ys    The 'count' interpolated Y values. This may be 'xs'.
+ * @param count The number of values to interpolate.
+ *
+ * @return 0 on success, or -EINVAL if n < 2 or any X value is out of
+ *         range, in which case its Y value is set to NAN and the others are
+ *         still interpolated.
+ */
+int zsl_interp_lin_y_batch(struct zsl_interp_xy xy[], size_t n,
+                           const zsl_real_t *xs, zsl_real_t *ys,
+                           size_t count);
+
+/**
+ * @brief Cubic spline interpolation of every value of 'xs' in table 'xyc',
+ *        walking the table as per @ref zsl_interp_lin_y_batch.
+ *
+ * @param xyc   The ascending array of X,Y,Y2 values to use when
+ *              interpolating, with Y2 from @ref zsl_interp_cubic_calc.
+ * @param n     The number of elements in the X,Y,Y2 array (min three!).
+ * @param xs    The 'count' X values to interpolate for.
+ * @param ys    The 'count' interpolated Y values. This may be 'xs'.
+ * @param count The number of values to interpolate.
+ *
+ * @return 0 on success, or -EINVAL if 'xyc' is invalid or any X value is
+ *         out of range, in which case its Y value is set to NAN and the
+ *         others are still interpolated.
+ */
+int zsl_interp_cubic_batch(struct zsl_interp_xyc xyc[], size_t n,
+                           const zsl_real_t *xs, zsl_real_t *ys,
+                           size_t count);
+
+/**
+ * @brief Nearest neighbour interpolation in uniform grid 'g', rounding up
+ *        on 0.5.
+ *
+ * @param g   The grid to use when interpolating.
+ * @param x   The X value to interpolate for (x >= x0, <= x0 + (n-1) * dx).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range or 'g' is invalid.
+ */
+int zsl_interp_grid_nn(const struct zsl_interp_grid *g, zsl_real_t x,
+                       zsl_real_t *y);
+
+/**
+ * @brief Linear interpolation in uniform grid 'g'.
+ *
+ * @param g   The grid to use when interpolating.
+ * @param x   The X value to interpolate for (x >= x0, <= x0 + (n-1) * dx).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range or 'g' is invalid.
+ */
+int zsl_interp_grid_lin(const struct zsl_interp_grid *g, zsl_real_t x,
+                        zsl_real_t *y);
+
+/**
+ * @brief Returns the workspace size, in zsl_real_t elements, needed by
+ *        @ref zsl_interp_grid_cubic_calc_ws for a grid of 'n' points.
+ */
+size_t zsl_interp_grid_cubic_calc_ws_sz(size_t n);
+
+/**
+ * @brief Calculates g->y2 for cubic spline interpolation in uniform grid
+ *        'g', taking scratch memory from 'ws'.
+ *
+ * @param g   The grid, with 'y2' pointing to 'n' writable values.
+ * @param yp1 1st derivative at 1. Set to >= 1e30 for natural spline.
+ * @param ypn 1st derivative at n'th point. Set to >= 1e30 for natural spline.
+ * @param ws  The workspace to use.
+ *
+ * @return 0 on success, -EINVAL if 'g' is invalid or has fewer than three
+ *         points or no 'y2', or -ENOMEM if 'ws' is too small.
+ */
+int zsl_interp_grid_cubic_calc_ws(struct zsl_interp_grid *g, zsl_real_t yp1,
+                                  zsl_real_t ypn, struct zsl_workspace *ws);
+
+/**
+ * @brief Equivalent to @ref zsl_interp_grid_cubic_calc_ws, using scratch
+ *        memory on the stack or from the scratch pool.
+ *
+ * NOTE: This function must be called BEFORE using zsl_interp_grid_cubic.
+ */
+int zsl_interp_grid_cubic_calc(struct zsl_interp_grid *g, zsl_real_t yp1,
+                               zsl_real_t ypn);
+
+/**
+ * @brief Cubic spline interpolation in uniform grid 'g'.
+ *
+ * @param g   The grid to use, with 'y2' from @ref zsl_interp_grid_cubic_calc.
+ * @param x   The X value to interpolate for (x >= x0, <= x0 + (n-1) * dx).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range or 'g' is invalid.
+ */
+int zsl_interp_grid_cubic(const struct zsl_interp_grid *g, zsl_real_t x,
+                          zsl_real_t *y);
+
+/**
+ * @brief Builds cubic spline 'sp' through the 'sp->n' points of 'xy', with
+ *        the same curve as @ref zsl_interp_cubic_calc.
+ *
+ * The tridiagonal system is solved in the spline's own storage, so no
+ * temporary memory is needed.
+ *
+ * @param sp  The spline to build.
+ * @param xy  The 'sp->n' X,Y values, with strictly ascending x (min three!).
+ * @param yp1 1st derivative at 1. Set to >= 1e30 for natural spline.
+ * @param ypn 1st derivative at n'th point. Set to >= 1e30 for natural spline.
+ *
+ * @return 0 on success, or -EINVAL if there are fewer than three points or
+ *         x isn't strictly ascending.
+ */
+int zsl_interp_spline_natural(struct zsl_interp_spline *sp,
+                              const struct zsl_interp_xy xy[],
+                              zsl_real_t yp1, zsl_real_t ypn);
+
+/**
+ * @brief Builds monotone piecewise cubic Hermite (PCHIP) interpolant 'sp'
+ *        through the 'sp->n' points of 'xy'.
+ *
+ * The derivatives are weighted harmonic means of the neighbouring slopes
+ * (Fritsch and Carlson), so the curve never overshoots the data and is
+ * monotonic wherever the data is.
+ *
+ * @param sp  The spline to build.
+ * @param xy  The 'sp->n' X,Y values, with strictly ascending x (min two!).
+ *
+ * @return 0 on success, or -EINVAL if there are fewer than two points or x
+ *         isn't strictly ascending.
+ */
+int zsl_interp_spline_pchip(struct zsl_interp_spline *sp,
+                            const struct zsl_interp_xy xy[]);
+
+/**
+ * @brief Builds Akima piecewise cubic interpolant 'sp' through the 'sp->n'
+ *        points of 'xy'.
+ *
+ * Each derivative is taken from the four nearest slopes, weighted so that
+ * an outlier only disturbs its immediate neighbourhood, avoiding the
+ * ringing of a global spline.
+ *
+ * @param sp  The spline to build.
+ * @param xy  The 'sp->n' X,Y values, with strictly ascending x (min three!).
+ *
+ * @return 0 on success, or -EINVAL if there are fewer than three points or
+ *         x isn't strictly ascending.
+ */
+int zsl_interp_spline_akima(struct zsl_interp_spline *sp,
+                            const struct zsl_interp_xy xy[]);
+
+/**
+ * @brief Evaluates piecewise cubic 'sp' at x.
+ *
+ * @param sp  The spline to evaluate.
+ * @param x   The X value to interpolate for, within the spline's points.
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, or -EINVAL if x is out of range.
+ */
+int zsl_interp_spline_eval(struct zsl_interp_spline *sp, zsl_real_t x,
+                           zsl_real_t *y);
+
+/**
+ * @brief Checks the axes of 2D table 'g' and resets its search state.
+ *
+ * @param g  The table to initialise.
+ *
+ * @return 0 on success, or -EINVAL if an axis has fewer than two values or
+ *         isn't strictly ascending.
+ */
+int zsl_interp_grid2_init(struct zsl_interp_grid2 *g);
+
+/**
+ * @brief Bilinear interpolation in 2D table 'g'.
+ *
+ * @param g   The table to use when interpolating.
+ * @param x   The X value to interpolate for, within the x axis.
+ * @param y   The Y value to interpolate for, within the y axis.
+ * @param z   Pointer to the placeholder for the interpolated Z value.
+ *
+ * @return 0 on success, or -EINVAL if x or y is out of range.
+ */
+int zsl_interp_grid2_bilin(struct zsl_interp_grid2 *g, zsl_real_t x,
+                           zsl_real_t y, zsl_real_t *z);
+
+/**
+ * @brief Bicubic interpolation in 2D table 'g'.
+ *
+ * Each axis uses cubic Hermite interpolation, with the derivatives at each
+ * point taken from the parabola through it and its two neighbours, or
+ * from the nearest interval at the edges of the table. The result is
+ * continuously differentiable and exact for quadratics away from the
+ * edges.
+ *
+ * @param g   The table to use when interpolating.
+ * @param x   The X value to interpolate for, within the x axis.
+ * @param y   The Y value to interpolate for, within the y axis.
+ * @param z   Pointer to the placeholder for the interpolated Z value.
+ *
+ * @return 0 on success, or -EINVAL if x or y is out of range.
+ */
+int zsl_interp_grid2_bicubic(struct zsl_interp_grid2 *g, zsl_real_t x,
+                             zsl_real_t y, zsl_real_t *z);
+
+/**
+ * @brief Bilinear interpolation in 2D table 'g' at 'count' points
+ *        (xs[k], ys[k]).
+ *
+ * @param g     The table to use when interpolating.
+ * @param xs    The 'count' X values.
+ * @param ys    The 'count' Y values.
+ * @param zs    The 'count' interpolated Z values.
+ * @param count The number of points.
+ *
+ * @return 0 on success, or -EINVAL if any point is out of range, in which
+ *         case its Z value is set to NAN and the others are still
+ *         interpolated.
+ */
+int zsl_interp_grid2_bilin_batch(struct zsl_interp_grid2 *g,
+                                 const zsl_real_t *xs, const zsl_real_t *ys,
+                                 zsl_real_t *zs, size_t count);
+
+/**
+ * @brief Bicubic interpolation in 2D table 'g' at 'count' points
+ *        (xs[k], ys[k]), as per @ref zsl_interp_grid2_bilin_batch.
+ */
+int zsl_interp_grid2_bicubic_batch(struct zsl_interp_grid2 *g,
+                                   const zsl_real_t *xs, const zsl_real_t *ys,
+                                   zsl_real_t *zs, size_t count);
+
 /** @} */ /* End of INTERP_FUNCS group */
 
 #ifdef __cplusplus
@@ -41,6 +41,15 @@ extern "C" {
 #define EEIGENSIZE   (100)
 /** Error: Occurs when the input matrix has complex eigenvalues. */
 #define ECOMPLEXVAL  (101)
+/** Error: The input matrix is not positive-definite. */
+#define ENOTPOSDEF   (102)
+/** Error: The input matrix is singular. */
+#define ESINGULAR    (103)
+/** Error: An iterative solver failed to converge in the allowed steps. */
+#define ENOCONVERGE  (104)
+
+/* Forward declaration, see zsl/workspace.h. */
+struct zsl_workspace;
 
 /** @brief Represents a m x n matrix, with data stored in row-major order. */
 struct zsl_mtx {
@@ -66,6 +75,152 @@ struct zsl_mtx {
 		.data = name ## _mtx	\
 	}
 
+/**
+ * Macro to declare a matrix of shape m*n whose data is aligned to
+ * ZSL_DATA_ALIGN bytes, and padded to a whole number of ZSL_DATA_ALIGN
+ * blocks.
+ *
+ * The rows are still stored back to back, since every matrix function takes
+ * 'sz_cols' as the row stride. When 'n' is a multiple of the SIMD width,
+ * every row is aligned too, and the optimised kernels use aligned loads
+ * and stores on each row.
+ *
+ * Be sure to also call 'zsl_mtx_init' on the matrix after this macro.
+ */
+#define ZSL_MATRIX_DEF_ALIGNED(name, m, n)				\
+	zsl_real_t name ## _mtx[ZSL_ALIGN_PAD((m) * (n))]		\
+	__attribute__((aligned(ZSL_DATA_ALIGN)));			\
+	struct zsl_mtx name = {						\
+		.sz_rows = m,						\
+		.sz_cols = n,						\
+		.data = name ## _mtx					\
+	}
+
+/**
+ * Macro to declare a read-only matrix of shape m*n, initialised from the
+ * row-major values that follow, for example:
+ *
+ *   ZSL_MATRIX_CONST_DEF(ccm, 2, 2, 1.0, 0.5, 0.0, 2.0);
+ *
+ * Both the values and the struct are const, so they are placed in flash,
+ * and the matrix can be passed to any 'const struct zsl_mtx *' input
+ * parameter without copying it into RAM first. Passing it as an output is
+ * diagnosed by the compiler.
+ */
+#define ZSL_MATRIX_CONST_DEF(name, m, n, ...)				\
+	static const zsl_real_t name ## _mtx[m * n] = { __VA_ARGS__ };	\
+	static const struct zsl_mtx name = {				\
+		.sz_rows = m,						\
+		.sz_cols = n,						\
+		.data = (zsl_real_t *)name ## _mtx			\
+	}
+
+/**
+ * @brief Represents a m x n view onto the data of an existing matrix, such
+ *        as a block, row or column, without copying it.
+ *
+ * Consecutive rows of a view are 'ld' (the leading dimension) entries
+ * apart, which is the number of columns in the matrix being viewed. A view
+ * with 'ld' equal to 'sz_cols' is laid out exactly like a zsl_mtx.
+ */
+struct zsl_mtx_view {
+	/** The number of rows in the view. */
+	size_t sz_rows;
+	/** The number of columns in the view. */
+	size_t sz_cols;
+	/** The distance between the start of consecutive rows, in entries. */
+	size_t ld;
+	/** The first entry of the view, in the underlying matrix. */
+	zsl_real_t *data;
+};
+
+/**
+ * @brief Represents a batch of 'sz_batch' independent m x n matrices, stored
+ *        in structure-of-arrays form.
+ *
+ * Entry (i, j) of every matrix in the batch is stored contiguously, so entry
+ * (i, j) of matrix 'b' is at data[(i * sz_cols + j) * sz_batch + b]. This
+ * lets the batch functions run the same small kernel across the whole batch
+ * with unit-stride accesses, rather than once per matrix.
+ */
+struct zsl_mtx_batch {
+	/** The number of rows in each matrix. */
+	size_t sz_rows;
+	/** The number of columns in each matrix. */
+	size_t sz_cols;
+	/** The number of matrices in the batch. */
+	size_t sz_batch;
+	/** Data assigned to the batch, in the order described above. */
+	zsl_real_t *data;
+};
+
+/**
+ * Macro to declare a batch of 'count' matrices of shape m*n.
+ *
+ * Be sure to also call 'zsl_mtx_batch_init' on the batch after this macro,
+ * since batches declared on the stack may have non-zero values by default!
+ */
+#define ZSL_MATRIX_BATCH_DEF(name, m, n, count)	\
+	zsl_real_t name ## _mtxb[(m) * (n) * (count)];	\
+	struct zsl_mtx_batch name = {			\
+		.sz_rows = m,				\
+		.sz_cols = n,				\
+		.sz_batch = count,			\
+		.data = name ## _mtxb			\
+	}
+
+/** @brief The decompositions that a @ref zsl_mtx_plan can execute. */
+enum zsl_mtx_plan_type {
+	/** Full SVD, see @ref zsl_mtx_plan_svd. */
+	ZSL_MTX_PLAN_SVD                = 0,
+	/** Singular values only, see @ref zsl_mtx_plan_svd_vals. */
+	ZSL_MTX_PLAN_SVD_VALS           = 1,
+	/** Pseudo-inverse, see @ref zsl_mtx_plan_pinv. */
+	ZSL_MTX_PLAN_PINV               = 2,
+	/** Eigenvalues, see @ref zsl_mtx_plan_eigenvalues. */
+	ZSL_MTX_PLAN_EIGENVALUES        = 3,
+};
+
+/**
+ * @brief A decomposition prepared once for a fixed input shape, with its
+ *        temporaries allocated up front. Created with
+ *        @ref zsl_mtx_plan_init; the fields are private.
+ */
+struct zsl_mtx_plan {
+	/** The decomposition this plan executes. */
+	enum zsl_mtx_plan_type type;
+	/** The number of rows in the input matrix. */
+	size_t sz_rows;
+	/** The number of columns in the input matrix. */
+	size_t sz_cols;
+	/** The maximum number of sweeps or QR steps per call. */
+	size_t iter;
+	/** The working copy of the input. */
+	struct zsl_mtx w;
+	/** The accumulated rotations, for ZSL_MTX_PLAN_SVD and _PINV. */
+	struct zsl_mtx vq;
+	/** Per-column or per-row temporaries. */
+	zsl_real_t *t1;
+	/** A second per-column or per-row temporary. */
+	zsl_real_t *t2;
+	/** The sweeps or QR steps run since @ref zsl_mtx_plan_start. */
+	size_t done;
+	/** The QR steps since an eigenvalue last converged. */
+	size_t stall;
+	/** The first column of the next Jacobi pair to rotate. */
+	size_t pi;
+	/** The second column of the next Jacobi pair to rotate. */
+	size_t pj;
+	/** True once @ref zsl_mtx_plan_start has loaded an input. */
+	bool started;
+	/** True once the run started by @ref zsl_mtx_plan_start converged. */
+	bool converged;
+	/** True if the current Jacobi sweep has rotated any pair so far. */
+	bool rotated;
+	/** True if the input loaded by @ref zsl_mtx_plan_start is symmetric. */
+	bool sym;
+};
+
 /** @} */ /* End of MTX_STRUCTS group */
 
 /**
@@ -156,6 +311,35 @@ typedef int (*zsl_mtx_unary_fn_t)(struct zsl_mtx *m, size_t i, size_t j);
 typedef int (*zsl_mtx_binary_fn_t)(struct zsl_mtx *ma, struct zsl_mtx *mb,
 				   struct zsl_mtx *mc, size_t i, size_t j);
 
+/**
+ * @brief Function prototype called when applying a unary operation to a
+ * matrix a row at a time via `zsl_mtx_unary_func_rows`.
+ *
+ * @param row   Pointer to the first coefficient of the row, which may be
+ *              modified in place.
+ * @param n     The number of coefficients in the row.
+ * @param i     The row number (0-based).
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+typedef int (*zsl_mtx_unary_row_fn_t)(zsl_real_t *row, size_t n, size_t i);
+
+/**
+ * @brief Function prototype called when applying a binary operation to a
+ * pair of matrices a row at a time via `zsl_mtx_binary_func_rows`.
+ *
+ * @param a     Pointer to the row of the first input matrix.
+ * @param b     Pointer to the row of the second input matrix.
+ * @param c     Pointer to the row of the output matrix.
+ * @param n     The number of coefficients in each row.
+ * @param i     The row number (0-based).
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+typedef int (*zsl_mtx_binary_row_fn_t)(const zsl_real_t *a,
+				       const zsl_real_t *b, zsl_real_t *c,
+				       size_t n, size_t i);
+
 /**
  * @brief Function prototype called when populating a matrix via `zsl_mtx_init`.
  *
@@ -193,6 +377,11 @@ int zsl_mtx_entry_fn_identity(struct zsl_mtx *m, size_t i, size_t j);
 /**
  * @brief Sets the value to a random number between -1.0 and 1.0.
  *
+ * All calls share a single, fixed-seed generator, so the sequence is
+ * reproducible from boot but this function is not thread-safe. Prefer
+ * @ref zsl_rand_mtx_uniform with a caller-owned generator, or
+ * @ref zsl_mtx_init_random_ctx, where the seed or thread-safety matters.
+ *
  * @param m     Pointer to the zsl_mtx to use.
  * @param i     The row number to write (0-based).
  * @param j     The column number to write (0-based).
@@ -231,7 +420,7 @@ int zsl_mtx_init(struct zsl_mtx *m, zsl_mtx_init_entry_fn_t entry_fn);
  *
  * @return 0 on success, and non-zero error code on failure
  */
-int zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a);
+int zsl_mtx_from_arr(struct zsl_mtx *m, const zsl_real_t *a);
 
 /**
  * @brief Copies the contents of matrix 'msrc' into matrix 'mdest'.
@@ -241,7 +430,7 @@ int zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a);
  *
  * @return 0 on success, and non-zero error code on failure
  */
-int zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc);
+int zsl_mtx_copy(struct zsl_mtx *mdest, const struct zsl_mtx *msrc);
 
 /** @} */ /* End of MTX_INIT group */
 
@@ -265,7 +454,23 @@ int zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc);
  * @return  0 if everything executed correctly, or -EINVAL on an out of
  *          bounds error.
  */
-int zsl_mtx_get(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x);
+#if CONFIG_ZSL_MATRIX_INLINE
+static inline int zsl_mtx_get(const struct zsl_mtx *m, size_t i, size_t j,
+			      zsl_real_t *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	*x = m->data[(i * m->sz_cols) + j];
+
+	return 0;
+}
+#else
+int zsl_mtx_get(const struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x);
+#endif
 
 /**
  * @brief Sets a single value at the specified row (i) and column (j).
@@ -278,7 +483,23 @@ int zsl_mtx_get(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x);
  * @return  0 if everything executed correctly, or -EINVAL on an out of
  *          bounds error.
  */
+#if CONFIG_ZSL_MATRIX_INLINE
+static inline int zsl_mtx_set(struct zsl_mtx *m, size_t i, size_t j,
+			      zsl_real_t x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	m->data[(i * m->sz_cols) + j] = x;
+
+	return 0;
+}
+#else
 int zsl_mtx_set(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t x);
+#endif
 
 /**
  * @brief Gets the contents of row 'i' from matrix 'm', assigning the array
@@ -292,7 +513,7 @@ int zsl_mtx_set(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t x);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_get_row(struct zsl_mtx *m, size_t i, zsl_real_t *v);
+int zsl_mtx_get_row(const struct zsl_mtx *m, size_t i, zsl_real_t *v);
 
 /**
  * @brief Sets the contents of row 'i' in matrix 'm', assigning the values
@@ -306,7 +527,7 @@ int zsl_mtx_get_row(struct zsl_mtx *m, size_t i, zsl_real_t *v);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_set_row(struct zsl_mtx *m, size_t i, zsl_real_t *v);
+int zsl_mtx_set_row(struct zsl_mtx *m, size_t i, const zsl_real_t *v);
 
 /**
  * @brief Gets the contents of column 'j' from matrix 'm', assigning the array
@@ -320,7 +541,7 @@ int zsl_mtx_set_row(struct zsl_mtx *m, size_t i, zsl_real_t *v);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_get_col(struct zsl_mtx *m, size_t j, zsl_real_t *v);
+int zsl_mtx_get_col(const struct zsl_mtx *m, size_t j, zsl_real_t *v);
 
 /**
  * @brief Sets the contents of column 'j' in matrix 'm', assigning the values
@@ -334,10 +555,243 @@ int zsl_mtx_get_col(struct zsl_mtx *m, size_t j, zsl_real_t *v);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_set_col(struct zsl_mtx *m, size_t j, zsl_real_t *v);
+int zsl_mtx_set_col(struct zsl_mtx *m, size_t j, const zsl_real_t *v);
 
 /** @} */ /* End of MTX_DATAACCESS group */
 
+/**
+ * @addtogroup MTX_VIEWS Views
+ *
+ * @brief Functions used to create and operate on zero-copy views of blocks,
+ *        rows and columns of a matrix.
+ *
+ * Writes through a view modify the underlying matrix, and a view is only
+ * valid for as long as the matrix it refers to.
+ *
+ * @ingroup MATRICES
+ *  @{ */
+
+/**
+ * @brief Creates view 'v' onto the 'rows' x 'cols' block of matrix 'm'
+ *        whose top left entry is at row 'i' and column 'j'.
+ *
+ * @param m     Pointer to the zsl_mtx to view.
+ * @param i     The first row of the block (0-based).
+ * @param j     The first column of the block (0-based).
+ * @param rows  The number of rows in the block.
+ * @param cols  The number of columns in the block.
+ * @param v     Pointer to the output view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the block
+ *          doesn't fit within 'm'.
+ */
+int zsl_mtx_view(struct zsl_mtx *m, size_t i, size_t j, size_t rows,
+		 size_t cols, struct zsl_mtx_view *v);
+
+/**
+ * @brief Creates 1 x n view 'v' onto row 'i' of matrix 'm'.
+ *
+ * @param m     Pointer to the zsl_mtx to view.
+ * @param i     The row number to view (0-based).
+ * @param v     Pointer to the output view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'i' is out of
+ *          bounds.
+ */
+int zsl_mtx_view_row(struct zsl_mtx *m, size_t i, struct zsl_mtx_view *v);
+
+/**
+ * @brief Creates m x 1 view 'v' onto column 'j' of matrix 'm'.
+ *
+ * @param m     Pointer to the zsl_mtx to view.
+ * @param j     The column number to view (0-based).
+ * @param v     Pointer to the output view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'j' is out of
+ *          bounds.
+ */
+int zsl_mtx_view_col(struct zsl_mtx *m, size_t j, struct zsl_mtx_view *v);
+
+/**
+ * @brief Creates 'len' x 1 view 'v' onto every 'stride'th value of vector
+ *        'vec', starting at index 'offset'.
+ *
+ * This gives zero-copy access to one channel of an interleaved block, or to
+ * a decimated signal, which a zsl_vec can't describe since its values must
+ * be contiguous. With a stride of 1, @ref zsl_vec_view can be used instead.
+ *
+ * @param vec       Pointer to the vector to view.
+ * @param offset    The index of the first value to view (0-based).
+ * @param len       The number of values to view.
+ * @param stride    The distance between consecutive values, at least 1.
+ * @param v         Pointer to the output view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'stride' is
+ *          zero or the view extends beyond the end of 'vec'.
+ */
+int zsl_mtx_view_vec(struct zsl_vec *vec, size_t offset, size_t len,
+		     size_t stride, struct zsl_mtx_view *v);
+
+/**
+ * @brief Creates view 'vs' onto the 'rows' x 'cols' block of view 'v'
+ *        whose top left entry is at row 'i' and column 'j'.
+ *
+ * @param v     Pointer to the view to take the block from.
+ * @param i     The first row of the block (0-based).
+ * @param j     The first column of the block (0-based).
+ * @param rows  The number of rows in the block.
+ * @param cols  The number of columns in the block.
+ * @param vs    Pointer to the output view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the block
+ *          doesn't fit within 'v'.
+ */
+int zsl_mtx_view_sub(struct zsl_mtx_view *v, size_t i, size_t j, size_t rows,
+		     size_t cols, struct zsl_mtx_view *vs);
+
+/**
+ * @brief Gets a single value from the specified row (i) and column (j) of
+ *        view 'v'.
+ *
+ * @param v     Pointer to the view to use.
+ * @param i     The row number to read (0-based).
+ * @param j     The column number to read (0-based).
+ * @param x     Pointer to where the value should be stored.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL on an out of
+ *          bounds error.
+ */
+int zsl_mtx_view_get(const struct zsl_mtx_view *v, size_t i, size_t j,
+		     zsl_real_t *x);
+
+/**
+ * @brief Sets a single value at the specified row (i) and column (j) of
+ *        view 'v', updating the underlying matrix.
+ *
+ * @param v     Pointer to the view to use.
+ * @param i     The row number to update (0-based).
+ * @param j     The column number to update (0-based).
+ * @param x     The value to assign.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL on an out of
+ *          bounds error.
+ */
+int zsl_mtx_view_set(struct zsl_mtx_view *v, size_t i, size_t j,
+		     zsl_real_t x);
+
+/**
+ * @brief Copies the contents of view 'vsrc' into view 'vdest'.
+ *
+ * @param vdest Pointer to the destination view. This must not overlap
+ *              'vsrc'.
+ * @param vsrc  Pointer to the source view.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the views are
+ *          not identically shaped.
+ */
+int zsl_mtx_view_copy(struct zsl_mtx_view *vdest,
+		      const struct zsl_mtx_view *vsrc);
+
+/**
+ * @brief Multiplies view 'va' by 'vb', assigning the output to 'vc'. This
+ *        uses the same blocked kernel as @ref zsl_mtx_mult.
+ *
+ * @param va    Pointer to the first input view.
+ * @param vb    Pointer to the second input view.
+ * @param vc    Pointer to the output view. This must not overlap 'va' or
+ *              'vb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the views
+ *          are not compatibly shaped.
+ */
+int zsl_mtx_view_mult(const struct zsl_mtx_view *va,
+		      const struct zsl_mtx_view *vb, struct zsl_mtx_view *vc);
+
+/** @} */ /* End of MTX_VIEWS group */
+
+/**
+ * @addtogroup MTX_BATCH Batches
+ *
+ * @brief Functions that apply the same operation to many independent small
+ *        matrices at once, such as per-body rotation or inertia matrices.
+ *
+ * Shapes are checked once per call rather than once per matrix, and the
+ * inner loops run over the batch dimension with unit stride, so compilers
+ * can vectorise them across matrices.
+ *
+ * @ingroup MATRICES
+ *  @{ */
+
+/**
+ * @brief Sets every entry of every matrix in batch 'b' to 0.0.
+ *
+ * @param b     Pointer to the batch to initialise.
+ *
+ * @return 0 on success.
+ */
+int zsl_mtx_batch_init(struct zsl_mtx_batch *b);
+
+/**
+ * @brief Copies matrix 'idx' of batch 'b' into 'm'.
+ *
+ * @param b     Pointer to the batch.
+ * @param idx   The index of the matrix in the batch (0-based).
+ * @param m     Pointer to the output matrix, the same shape as those in 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'idx' is out
+ *          of range or 'm' is the wrong shape.
+ */
+int zsl_mtx_batch_get(const struct zsl_mtx_batch *b, size_t idx,
+		      struct zsl_mtx *m);
+
+/**
+ * @brief Copies matrix 'm' into position 'idx' of batch 'b'.
+ *
+ * @param b     Pointer to the batch.
+ * @param idx   The index of the matrix in the batch (0-based).
+ * @param m     Pointer to the input matrix, the same shape as those in 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'idx' is out
+ *          of range or 'm' is the wrong shape.
+ */
+int zsl_mtx_batch_set(struct zsl_mtx_batch *b, size_t idx,
+		      const struct zsl_mtx *m);
+
+/**
+ * @brief Multiplies each matrix in batch 'ba' by the matching matrix in
+ *        batch 'bb', assigning the outputs to batch 'bc'.
+ *
+ * @param ba    Pointer to the first input batch, of m x n matrices.
+ * @param bb    Pointer to the second input batch, of n x p matrices.
+ * @param bc    Pointer to the output batch, of m x p matrices. This must
+ *              not be 'ba' or 'bb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the batches
+ *          are not compatibly shaped or sized.
+ */
+int zsl_mtx_batch_mult(const struct zsl_mtx_batch *ba,
+		       const struct zsl_mtx_batch *bb,
+		       struct zsl_mtx_batch *bc);
+
+/**
+ * @brief Inverts each 3x3 matrix in batch 'ba', assigning the outputs to
+ *        batch 'bi'.
+ *
+ * As with @ref zsl_mtx_inv_3x3, matrices with a zero determinant are
+ * replaced by the identity matrix.
+ *
+ * @param ba    Pointer to the input batch of 3x3 matrices.
+ * @param bi    Pointer to the output batch. This may be 'ba', to invert
+ *              the batch in place.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          aren't 3x3 or the batches are different sizes.
+ */
+int zsl_mtx_batch_inv_3x3(const struct zsl_mtx_batch *ba,
+			  struct zsl_mtx_batch *bi);
+
+/** @} */ /* End of MTX_BATCH group */
+
 /**
  * @ingroup MTX_OPERANDS
  *  @{ */
@@ -363,6 +817,20 @@ int zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op);
  */
 int zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn);
 
+/**
+ * @brief Applies a unary function to matrix 'm' one row at a time, using the
+ * specified 'zsl_mtx_unary_row_fn_t' instance.
+ *
+ * This makes one call per row rather than one per coefficient, and gives
+ * the callback a contiguous array that it can process in a tight loop.
+ *
+ * @param m         Pointer to the zsl_mtx to use.
+ * @param fn        The zsl_mtx_unary_row_fn_t instance to call.
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+int zsl_mtx_unary_func_rows(struct zsl_mtx *m, zsl_mtx_unary_row_fn_t fn);
+
 /**
  * @brief Applies a component-wise binary operation on every coefficient in
  * symmetrical matrices 'ma' and 'mb', with the results being stored in the
@@ -375,7 +843,7 @@ int zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn);
  *
  * @return 0 on success, and non-zero error code on failure
  */
-int zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb,
+int zsl_mtx_binary_op(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
 		      struct zsl_mtx *mc, zsl_mtx_binary_op_t op);
 
 /**
@@ -394,6 +862,22 @@ int zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb,
 int zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
 			struct zsl_mtx *mc, zsl_mtx_binary_fn_t fn);
 
+/**
+ * @brief Applies a binary function to identically shaped matrices 'ma' and
+ * 'mb' one row at a time, storing the results in 'mc', using the specified
+ * 'zsl_mtx_binary_row_fn_t' instance.
+ *
+ * @param ma        Pointer to first zsl_mtx to use in the binary operation.
+ * @param mb        Pointer to second zsl_mtx to use in the binary operation.
+ * @param mc        Pointer to output zsl_mtx used to store results.
+ * @param fn        The zsl_mtx_binary_row_fn_t instance to call.
+ *
+ * @return 0 on success, -EINVAL if the matrices are not identically shaped,
+ *         or the first non-zero error code returned by 'fn'.
+ */
+int zsl_mtx_binary_func_rows(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+			     struct zsl_mtx *mc, zsl_mtx_binary_row_fn_t fn);
+
 /** @} */ /* End of MTX_OPERANDS group */
 
 /**
@@ -415,7 +899,14 @@ int zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
  * @return  0 if everything executed correctly, or -EINVAL if the three
  *          matrices are not all identically shaped.
  */
-int zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
+#if CONFIG_ZSL_MATRIX_INLINE
+/* Defined inline in zsl/matrices_fixed.h. */
+static inline int zsl_mtx_add(const struct zsl_mtx *ma,
+			      const struct zsl_mtx *mb, struct zsl_mtx *mc);
+#else
+int zsl_mtx_add(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		struct zsl_mtx *mc);
+#endif
 
 /**
  * @brief Adds matrices 'ma' and 'mb', assigning the output to 'ma'.
@@ -430,7 +921,7 @@ int zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
  * @return  0 if everything executed correctly, or -EINVAL if the two input
  *          matrices are not identically shaped.
  */
-int zsl_mtx_add_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
+int zsl_mtx_add_d(struct zsl_mtx *ma, const struct zsl_mtx *mb);
 
 /**
  * @brief Adds the values of row 'j' to row 'i' in matrix 'm'. This operation
@@ -475,7 +966,14 @@ int zsl_mtx_sum_rows_scaled_d(struct zsl_mtx *m, size_t i, size_t j,
  * @return  0 if everything executed correctly, or -EINVAL if the three
  *          matrices are not all identically shaped.
  */
-int zsl_mtx_sub(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
+#if CONFIG_ZSL_MATRIX_INLINE
+/* Defined inline in zsl/matrices_fixed.h. */
+static inline int zsl_mtx_sub(const struct zsl_mtx *ma,
+			      const struct zsl_mtx *mb, struct zsl_mtx *mc);
+#else
+int zsl_mtx_sub(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		struct zsl_mtx *mc);
+#endif
 
 /**
  * @brief Subtracts matrix 'mb' from 'ma', assigning the output to 'ma'.
@@ -490,7 +988,7 @@ int zsl_mtx_sub(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
  * @return  0 if everything executed correctly, or -EINVAL if the two input
  *          matrices are not identically shaped.
  */
-int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
+int zsl_mtx_sub_d(struct zsl_mtx *ma, const struct zsl_mtx *mb);
 
 /**
  * @brief Multiplies matrix 'ma' by 'mb', assigning the output to 'mc'.
@@ -505,7 +1003,85 @@ int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
  * @return  0 if everything executed correctly, or -EINVAL if the input
  *          matrices are not compatibly shaped.
  */
-int zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
+#if CONFIG_ZSL_MATRIX_INLINE
+/* Defined inline in zsl/matrices_fixed.h. */
+static inline int zsl_mtx_mult(const struct zsl_mtx *ma,
+			       const struct zsl_mtx *mb, struct zsl_mtx *mc);
+#else
+int zsl_mtx_mult(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		 struct zsl_mtx *mc);
+#endif
+
+/**
+ * @brief Computes mc = alpha * op(ma) * op(mb) + beta * mc, where op(x) is
+ *        either 'x' or its transpose.
+ *
+ * Transposed operands are read in transposed order directly, so no
+ * temporary transpose is needed. When 'beta' is zero the initial contents
+ * of 'mc' are ignored.
+ *
+ * @param ma        Pointer to the first input zsl_mtx.
+ * @param trans_a   Use the transpose of 'ma' if true.
+ * @param mb        Pointer to the second input zsl_mtx.
+ * @param trans_b   Use the transpose of 'mb' if true.
+ * @param alpha     The scale factor applied to the product.
+ * @param beta      The scale factor applied to the initial 'mc'.
+ * @param mc        Pointer to the output zsl_mtx. This must not be 'ma' or
+ *                  'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped.
+ */
+int zsl_mtx_mult_ex(const struct zsl_mtx *ma, bool trans_a,
+		    const struct zsl_mtx *mb, bool trans_b, zsl_real_t alpha,
+		    zsl_real_t beta, struct zsl_mtx *mc);
+
+/**
+ * @brief Computes mc = alpha * ma * mb + beta * mc in a single pass, with
+ *        no intermediate matrices.
+ *
+ * This is @ref zsl_mtx_mult_ex with neither operand transposed. With
+ * 'beta' set to 1.0 it accumulates the product into an existing 'mc'.
+ *
+ * @param ma    Pointer to the first input zsl_mtx.
+ * @param mb    Pointer to the second input zsl_mtx.
+ * @param alpha The scale factor applied to the product.
+ * @param beta  The scale factor applied to the initial 'mc'.
+ * @param mc    Pointer to the output zsl_mtx. This must not be 'ma' or 'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped.
+ */
+int zsl_mtx_gemm(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		 zsl_real_t alpha, zsl_real_t beta, struct zsl_mtx *mc);
+
+/**
+ * @brief Adds 'alpha' times matrix 'mx' to 'my' (my = alpha * mx + my).
+ *
+ * @param alpha The scale factor applied to 'mx'.
+ * @param mx    Pointer to the input zsl_mtx.
+ * @param my    Pointer to the zsl_mtx to accumulate into.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          are not identically shaped.
+ */
+int zsl_mtx_axpy(zsl_real_t alpha, const struct zsl_mtx *mx,
+		 struct zsl_mtx *my);
+
+/**
+ * @brief Adds the scaled outer product of vectors 'x' and 'y' to matrix 'm'
+ *        (m = alpha * x * y^T + m), without forming the outer product.
+ *
+ * @param alpha The scale factor applied to the outer product.
+ * @param x     Pointer to the column vector, with m->sz_rows entries.
+ * @param y     Pointer to the row vector, with m->sz_cols entries.
+ * @param m     Pointer to the zsl_mtx to accumulate into.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the sizes
+ *          don't match.
+ */
+int zsl_mtx_ger(zsl_real_t alpha, const struct zsl_vec *x,
+		const struct zsl_vec *y, struct zsl_mtx *m);
 
 /**
  * @brief Multiplies all elements in matrix 'm' by scalar value 's'.
@@ -551,19 +1127,42 @@ int zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s);
  * @return  0 if everything executed correctly, or -EINVAL if ma and mb are
  *          not compatibly shaped.
  */
-int zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb);
+#if CONFIG_ZSL_MATRIX_INLINE
+/* Defined inline in zsl/matrices_fixed.h. */
+static inline int zsl_mtx_trans(const struct zsl_mtx *ma,
+				struct zsl_mtx *mb);
+#else
+int zsl_mtx_trans(const struct zsl_mtx *ma, struct zsl_mtx *mb);
+#endif
+
+/**
+ * @brief Transposes matrix 'm' in place, swapping its row and column
+ *        counts.
+ *
+ * Square matrices are transposed by recursively splitting them into
+ * blocks, which keeps the swapped entries in cache at any matrix size.
+ * Rectangular matrices are permuted by following the cycles of the
+ * transpose, which needs no additional memory.
+ *
+ * @param m     Pointer to the matrix to transpose.
+ *
+ * @warning     This function is destructive to 'm'!
+ *
+ * @return  0 on success.
+ */
+int zsl_mtx_trans_d(struct zsl_mtx *m);
 
 /**
  * @brief Calculates the ajoint matrix, based on the input 3x3 matrix 'm'.
  *
  * @param m     The input 3x3 square matrix to use.
  * @param ma    The output 3x3 square matrix the adjoint values will be
- *              assigned to.
+ *              assigned to. This may be 'm'.
  *
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          3x3 square matrix.
  */
-int zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma);
+int zsl_mtx_adjoint_3x3(const struct zsl_mtx *m, struct zsl_mtx *ma);
 
 /**
  * @brief Calculates the ajoint matrix, based on the input square matrix 'm'.
@@ -574,7 +1173,7 @@ int zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma);
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          square matrix.
  */
-int zsl_mtx_adjoint(struct zsl_mtx *m, struct zsl_mtx *ma);
+int zsl_mtx_adjoint(const struct zsl_mtx *m, struct zsl_mtx *ma);
 
 /**
  * @brief Removes row 'i' and column 'j' from square matrix 'm', assigning the
@@ -588,7 +1187,8 @@ int zsl_mtx_adjoint(struct zsl_mtx *m, struct zsl_mtx *ma);
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          square matrix.
  */
-int zsl_mtx_reduce(struct zsl_mtx *m, struct zsl_mtx *mr, size_t i, size_t j);
+int zsl_mtx_reduce(const struct zsl_mtx *m, struct zsl_mtx *mr, size_t i,
+		   size_t j);
 
 /* NOTE: This is used for household method/QR. Should it be in the main lib? */
 /**
@@ -617,7 +1217,7 @@ int zsl_mtx_reduce_iter(struct zsl_mtx *m, struct zsl_mtx *mred);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_augm_diag(struct zsl_mtx *m, struct zsl_mtx *maug);
+int zsl_mtx_augm_diag(const struct zsl_mtx *m, struct zsl_mtx *maug);
 
 /**
  * @brief Calculates the determinant of the input 3x3 matrix 'm'.
@@ -627,18 +1227,41 @@ int zsl_mtx_augm_diag(struct zsl_mtx *m, struct zsl_mtx *maug);
  *
  * @return  0 on success, or -EINVAL if this isn't a 3x3 square matrix.
  */
-int zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d);
+int zsl_mtx_deter_3x3(const struct zsl_mtx *m, zsl_real_t *d);
+
+/**
+ * @brief Calculates the LU decomposition of square matrix 'm' using
+ *        Gaussian elimination with partial pivoting, such that P * m = L * U.
+ *
+ * At each step, the row with the largest absolute value in the current
+ * column is swapped onto the diagonal, which keeps every element of 'l'
+ * within -1.0..1.0. If 'm' is singular, the decomposition still completes,
+ * but one or more diagonal elements of 'u' will be zero.
+ *
+ * @param m     The input square matrix to decompose.
+ * @param l     The output unit lower triangular matrix.
+ * @param u     The output upper triangular matrix.
+ * @param p     The output permutation matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' isn't a
+ *          square matrix, or 'l', 'u' and 'p' aren't the same shape as 'm'.
+ */
+int zsl_mtx_lu(const struct zsl_mtx *m, struct zsl_mtx *l, struct zsl_mtx *u,
+	       struct zsl_mtx *p);
 
 /**
  * @brief Calculates the determinant of the input square matrix 'm'.
  *
+ * Matrices other than 3x3 are factored with partial-pivoting LU
+ * decomposition, requiring O(n^3) time and a single temporary nxn matrix.
+ *
  * @param m     The input square matrix to use.
  * @param d     The determinant of square matrix m.
  *
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          square matrix.
  */
-int zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d);
+int zsl_mtx_deter(const struct zsl_mtx *m, zsl_real_t *d);
 
 /**
  * @brief Given the element (i,j) in matrix 'm', this function performs
@@ -688,18 +1311,50 @@ int zsl_mtx_gauss_elim_d(struct zsl_mtx *m, struct zsl_mtx *mi,
 int zsl_mtx_gauss_reduc(struct zsl_mtx *m, struct zsl_mtx *mi,
 			struct zsl_mtx *mg);
 
+/**
+ * @brief Reduces the augmented matrix [A | B] in 'm' to [I | A^-1 * B] in
+ *        place, using Gauss-Jordan elimination with partial pivoting.
+ *
+ * 'A' is the leading n x n block of 'm', and 'B' is made up of the remaining
+ * sz_cols - n columns, so a system with several right-hand sides can be
+ * solved in a single pass. Rows of 'm' below row 'n' are left untouched.
+ * This function is destructive and will modify the contents of m.
+ *
+ * @param m     Pointer to the augmented input/output matrix.
+ * @param n     The number of rows and columns in the coefficient block 'A'.
+ *
+ * @return 0 on success, -EINVAL if the n x n block doesn't fit in 'm', or
+ *         -ESINGULAR if 'A' is found to be singular, in which case 'm' is
+ *         left partially reduced.
+ */
+int zsl_mtx_gauss_jordan_d(struct zsl_mtx *m, size_t n);
+
 /**
  * @brief Updates the values of every column vector in input matrix 'm' to have
  *        unitary values.
  *
  * @param m      Pointer to the input matrix.
  * @param mnorm  Pointer to the output matrix where the columns are unitary
- *               vectors.
+ *               vectors. This may be 'm'.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_cols_norm(struct zsl_mtx *m, struct zsl_mtx *mnorm);
+int zsl_mtx_cols_norm(const struct zsl_mtx *m, struct zsl_mtx *mnorm);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_cols_norm, normalising the columns of
+ *        'm' in place.
+ *
+ * The norms are accumulated a row at a time, so the matrix is read with
+ * unit stride rather than column by column.
+ *
+ * @param m      Pointer to the matrix to normalise.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if no scratch
+ *          memory was available.
+ */
+int zsl_mtx_cols_norm_d(struct zsl_mtx *m);
 
 /**
  * @brief Performs the Gram-Schmidt algorithm on the set of column vectors in
@@ -708,12 +1363,30 @@ int zsl_mtx_cols_norm(struct zsl_mtx *m, struct zsl_mtx *mnorm);
  *
  * @param m     Pointer to the input matrix containing the vector data.
  * @param mort  Pointer to the output matrix containing the orthogonal vector
- *              data.
+ *              data. This may be 'm'.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_gram_schmidt(struct zsl_mtx *m, struct zsl_mtx *mort);
+int zsl_mtx_gram_schmidt(const struct zsl_mtx *m, struct zsl_mtx *mort);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_gram_schmidt, orthogonalising the
+ *        columns of 'm' in place, without normalising them.
+ *
+ * The projections of each column onto the columns before it are removed in
+ * a single pass over the rows of 'm', so the matrix is read with unit stride
+ * and no column is copied out. When a pass cancels most of a column,
+ * rounding may have left it less than orthogonal, and the pass is repeated
+ * once. This is as stable as modified Gram-Schmidt, and only costs the extra
+ * pass for the columns that need it.
+ *
+ * @param m     Pointer to the matrix to orthogonalise.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if no scratch
+ *          memory was available.
+ */
+int zsl_mtx_gram_schmidt_d(struct zsl_mtx *m);
 
 /**
  * @brief Normalises elements in matrix m such that the element at position
@@ -749,28 +1422,507 @@ int zsl_mtx_norm_elem_d(struct zsl_mtx *m, struct zsl_mtx *mi,
  * @brief Calculates the inverse of 3x3 matrix 'm'. If the determinant of
  *        'm' is zero, an identity matrix will be returned via 'mi'.
  *
+ * The cofactors are computed once and scaled directly, using
+ * @ref zsl_mtx33_inv, which also returns the determinant if it's needed.
+ *
  * @param m     The input 3x3 matrix to use.
- * @param mi    The output inverse 3x3 matrix.
+ * @param mi    The output inverse 3x3 matrix. This may be 'm'.
  *
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          3x3 matrix.
  */
-int zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi);
+int zsl_mtx_inv_3x3(const struct zsl_mtx *m, struct zsl_mtx *mi);
+
+/**
+ * @brief Calculates the inverse of 4x4 matrix 'm' in closed form. If the
+ *        determinant of 'm' is zero, an identity matrix will be returned
+ *        via 'mi'.
+ *
+ * This uses @ref zsl_mtx44_inv, which also returns the determinant if
+ * it's needed.
+ *
+ * @param m     The input 4x4 matrix to use.
+ * @param mi    The output inverse 4x4 matrix. This may be 'm'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if this isn't a
+ *          4x4 matrix.
+ */
+int zsl_mtx_inv_4x4(const struct zsl_mtx *m, struct zsl_mtx *mi);
 
 /**
  * @brief Calculates the inverse of square matrix 'm'.
  *
+ * 3x3 and 4x4 matrices are inverted in closed form. Other sizes are
+ * inverted using partial-pivoting LU decomposition followed by forward and
+ * back substitution. If 'm' is singular, 'mi' is set to the identity
+ * matrix.
+ *
  * @param m     The input square matrix to use.
  * @param mi    The output inverse square matrix.
  *
  * @return  0 if everything executed correctly, or -EINVAL if this isn't a
  *          square matrix.
  */
-int zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi);
+int zsl_mtx_inv(const struct zsl_mtx *m, struct zsl_mtx *mi);
 
 /**
- * @brief Balances the square matrix 'm', a process in which the eigenvalues of
- *        the output matrix are the same as the eigenvalues of the input matrix.
+ * @brief Calculates the inverse of square matrix 'm' in place, using
+ *        Gauss-Jordan elimination with partial pivoting.
+ *
+ * Unlike @ref zsl_mtx_inv, no second n x n matrix is required: each pivot
+ * column is overwritten with the matching column of the inverse as it is
+ * reduced, and the row interchanges are undone as column interchanges at
+ * the end. This function is destructive and will modify the contents of m.
+ *
+ * @param m     The square matrix to invert, which holds its inverse on exit.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if this isn't a
+ *          square matrix, or -ESINGULAR if 'm' is found to be singular, in
+ *          which case its contents are undefined.
+ */
+int zsl_mtx_inv_d(struct zsl_mtx *m);
+
+/**
+ * @brief Calculates the Cholesky decomposition of the symmetric
+ *        positive-definite matrix 'm', such that m = L * L^T.
+ *
+ * Only the lower triangle of 'm' is read, and 'l' may point to the same
+ * matrix as 'm' to perform the decomposition in place. The elements above
+ * the diagonal of 'l' are set to zero.
+ *
+ * @param m     The input symmetric positive-definite matrix.
+ * @param l     The output lower triangular matrix.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'm' isn't square
+ *          or 'l' isn't the same shape as 'm', or -ENOTPOSDEF if 'm' isn't
+ *          positive-definite.
+ */
+int zsl_mtx_cholesky(const struct zsl_mtx *m, struct zsl_mtx *l);
+
+/**
+ * @brief Solves L * L^T * X = B for X, given the Cholesky factor 'l'
+ *        calculated by @ref zsl_mtx_cholesky.
+ *
+ * Each column of 'b' is treated as a separate right-hand side. This is
+ * cheaper and more accurate than forming an explicit inverse, and 'l' can
+ * be reused for any number of calls. 'x' may point to the same matrix as
+ * 'b' to solve in place.
+ *
+ * @param l     The nxn lower triangular Cholesky factor.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'l' isn't
+ *          square, or 'b' and 'x' aren't compatible with 'l'.
+ */
+int zsl_mtx_chol_solve(const struct zsl_mtx *l, struct zsl_mtx *b,
+		       struct zsl_mtx *x);
+
+/**
+ * @brief Updates the Cholesky factor 'l' in place, so that it becomes the
+ *        factor of L * L^T + v * v^T.
+ *
+ * This rank-1 update requires O(n^2) operations, compared to O(n^3) for a
+ * new call to @ref zsl_mtx_cholesky.
+ *
+ * @param l     The nxn lower triangular Cholesky factor to update.
+ * @param v     The update vector, with n elements.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'l' isn't
+ *          square or 'v' doesn't have n elements.
+ */
+int zsl_mtx_chol_update(struct zsl_mtx *l, struct zsl_vec *v);
+
+/**
+ * @brief Updates the inverse 'mi' of matrix A in place, so that it becomes
+ *        the inverse of A + u * v^T, using the Sherman-Morrison formula.
+ *
+ * This rank-1 update requires O(n^2) operations, compared to O(n^3) for a
+ * new call to @ref zsl_mtx_inv. Rounding errors accumulate over many
+ * updates, so long-running callers should re-invert periodically.
+ *
+ * @param mi    The nxn inverse to update.
+ * @param u     The first update vector, with n elements.
+ * @param v     The second update vector, with n elements.
+ * @param d     If not NULL, the determinant of A, which is updated to the
+ *              determinant of A + u * v^T by the matrix determinant lemma.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'mi' isn't
+ *          square or 'u' or 'v' don't have n elements, -ESINGULAR if
+ *          A + u * v^T is singular, in which case 'mi' and 'd' are left
+ *          unchanged, or -ENOMEM if no scratch memory was available.
+ */
+int zsl_mtx_inv_rank1(struct zsl_mtx *mi, const struct zsl_vec *u,
+		      const struct zsl_vec *v, zsl_real_t *d);
+
+/**
+ * @brief Replaces row 'i' of matrix 'm' with 'row', updating its inverse
+ *        'mi' and, optionally, its determinant 'd' to match in O(n^2)
+ *        operations.
+ *
+ * This is @ref zsl_mtx_inv_rank1 with u = e_i, for matrices where one row
+ * changes at a time, such as the design matrix of a sliding least-squares
+ * fit.
+ *
+ * @param m     The nxn matrix, whose row 'i' is replaced.
+ * @param mi    The nxn inverse of 'm' to update.
+ * @param i     The row to replace (zero-based).
+ * @param row   The new row, with n elements.
+ * @param d     If not NULL, the determinant of 'm' to update.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't nxn, 'row' doesn't have n elements or 'i' is out of
+ *          range, -ESINGULAR if the updated matrix is singular, in which
+ *          case nothing is changed, or -ENOMEM if no scratch memory was
+ *          available.
+ */
+int zsl_mtx_inv_update_row(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i,
+			   const struct zsl_vec *row, zsl_real_t *d);
+
+/**
+ * @brief Solves the linear system A * X = B for X, without forming an
+ *        explicit inverse of 'a'.
+ *
+ * 'a' is factored once using partial-pivoting LU decomposition, and each
+ * column of 'b' is then solved as a separate right-hand side by forward and
+ * back substitution. 'a' is not modified, and 'x' may point to the same
+ * matrix as 'b' to solve in place.
+ *
+ * @param a     The nxn coefficient matrix.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'a' isn't square
+ *          or 'b' and 'x' aren't compatible with 'a', or -ESINGULAR if 'a'
+ *          is singular.
+ */
+int zsl_mtx_solve(const struct zsl_mtx *a, struct zsl_mtx *b,
+		  struct zsl_mtx *x);
+
+/**
+ * @brief Factors square matrix 'm' in place with partial-pivoting LU
+ *        decomposition, so that it can be used to solve several systems
+ *        with @ref zsl_mtx_lu_solve.
+ *
+ * On return, the strictly lower triangle of 'm' holds the multipliers of
+ * the unit lower triangular factor L, and the upper triangle holds U, such
+ * that row i of L * U is row perm[i] of the original 'm'.
+ *
+ * @param m     The nxn matrix to factor in place.
+ * @param perm  The output row permutation, with n elements, holding the
+ *              original row index of each row of the factors.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'm' isn't square
+ *          or 'perm' doesn't have n elements, or -ESINGULAR if 'm' is
+ *          singular, in which case the factors are incomplete.
+ */
+int zsl_mtx_lu_fact_d(struct zsl_mtx *m, struct zsl_vec *perm);
+
+/**
+ * @brief Solves the linear system A * X = B for X, using the LU factors of
+ *        'a' from @ref zsl_mtx_lu_fact_d.
+ *
+ * This requires O(n^2) operations per column of 'b', compared to O(n^3)
+ * for @ref zsl_mtx_solve, so factoring once and solving many times is
+ * much faster when only the right-hand side changes.
+ *
+ * @param lu    The nxn LU factors of 'a'.
+ * @param perm  The row permutation, from @ref zsl_mtx_lu_fact_d.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'. This must not
+ *              be the same matrix as 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'lu' isn't
+ *          square or 'perm', 'b' and 'x' aren't compatible with 'lu'.
+ */
+int zsl_mtx_lu_solve(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		     struct zsl_mtx *b, struct zsl_mtx *x);
+
+/**
+ * @brief Calculates the 1-norm of matrix 'm', the largest sum of the
+ *        absolute values in any column.
+ *
+ * @param m     The input matrix.
+ * @param n     The output norm.
+ *
+ * @return 0 on success.
+ */
+int zsl_mtx_norm_1(const struct zsl_mtx *m, zsl_real_t *n);
+
+/**
+ * @brief Estimates the reciprocal condition number of matrix A in the
+ *        1-norm, 1 / (||A|| * ||A^-1||), from its LU factors.
+ *
+ * ||A^-1|| is estimated with Hager's method, as refined by Higham, which
+ * needs a few solves with the existing factors, so this costs O(n^2)
+ * rather than the O(n^3) of forming the inverse. The estimate is rarely
+ * more than a factor of three below the true value. Values close to the
+ * machine epsilon mean that solving with, or inverting, A will lose most
+ * of its precision, and a more robust method such as
+ * @ref zsl_mtx_solve_refine or @ref zsl_mtx_pinv should be used instead.
+ *
+ * @param lu     The nxn LU factors of A, from @ref zsl_mtx_lu_fact_d.
+ * @param perm   The row permutation, from @ref zsl_mtx_lu_fact_d.
+ * @param anorm  The 1-norm of A, from @ref zsl_mtx_norm_1.
+ * @param rcond  The estimated reciprocal condition number, which is 0.0 if
+ *               A is exactly singular.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'lu' isn't
+ *          square or 'perm' doesn't have n elements, or -ENOMEM if no
+ *          scratch memory was available.
+ */
+int zsl_mtx_rcond_lu(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		     zsl_real_t anorm, zsl_real_t *rcond);
+
+/**
+ * @brief Estimates the reciprocal condition number of matrix 'm' in the
+ *        1-norm, factoring it first. See @ref zsl_mtx_rcond_lu.
+ *
+ * @param m      The nxn input matrix.
+ * @param rcond  The estimated reciprocal condition number, which is 0.0 if
+ *               'm' is exactly singular.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'm' isn't
+ *          square, or -ENOMEM if no scratch memory was available.
+ */
+int zsl_mtx_rcond(const struct zsl_mtx *m, zsl_real_t *rcond);
+
+/**
+ * @brief Solves the linear system A * X = B for X using mixed-precision
+ *        iterative refinement.
+ *
+ * 'a' is factored once with partial-pivoting LU decomposition in
+ * zsl_real_t, as in @ref zsl_mtx_solve. Each column of the solution is then
+ * improved for up to 'iter' steps by solving for a correction from the
+ * residual B - A * X, which is accumulated in a wider type (double in
+ * single-precision builds, long double otherwise). Refinement stops early
+ * once the correction is negligible or no longer shrinking.
+ *
+ * This recovers a solution accurate to the working precision even for
+ * moderately ill-conditioned 'a', at the cost of one extra matrix-vector
+ * product and substitution per step, rather than switching the whole
+ * library to double precision. 'a' is not modified, and 'x' may point to
+ * the same matrix as 'b' to solve in place.
+ *
+ * @param a     The nxn coefficient matrix.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ * @param iter  The maximum number of refinement steps per column. Two or
+ *              three steps are usually sufficient.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'a' isn't square
+ *          or 'b' and 'x' aren't compatible with 'a', or -ESINGULAR if 'a'
+ *          is singular.
+ */
+int zsl_mtx_solve_refine(const struct zsl_mtx *a, struct zsl_mtx *b,
+			 struct zsl_mtx *x, size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_mtx_solve_refine_ws and @ref zsl_mtx_inv_refine_ws for an
+ *        nxn matrix.
+ *
+ * @param n     The number of rows and columns in the coefficient matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_solve_refine_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_solve_refine, taking its temporaries
+ *        from workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param a     The nxn coefficient matrix.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ * @param iter  The maximum number of refinement steps per column.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_mtx_solve_refine_ws_sz(n) free entries.
+ *
+ * @return  0 on success, -EINVAL or -ESINGULAR as for
+ *          @ref zsl_mtx_solve_refine, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_solve_refine_ws(const struct zsl_mtx *a, struct zsl_mtx *b,
+			    struct zsl_mtx *x, size_t iter,
+			    struct zsl_workspace *ws);
+
+/**
+ * @brief Calculates the inverse of square matrix 'm' using mixed-precision
+ *        iterative refinement, as described for @ref zsl_mtx_solve_refine.
+ *
+ * This is more accurate than @ref zsl_mtx_inv for ill-conditioned matrices
+ * in single-precision builds. Unlike @ref zsl_mtx_inv, a singular 'm' is
+ * reported as an error.
+ *
+ * @param m     The input square matrix.
+ * @param mi    The output inverse matrix, the same shape as 'm'. This must
+ *              not be 'm'.
+ * @param iter  The maximum number of refinement steps per column.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't square and of the same size, or -ESINGULAR if 'm' is
+ *          singular.
+ */
+int zsl_mtx_inv_refine(const struct zsl_mtx *m, struct zsl_mtx *mi,
+		       size_t iter);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_inv_refine, taking its temporaries from
+ *        workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param m     The input square matrix.
+ * @param mi    The output inverse matrix, the same shape as 'm'.
+ * @param iter  The maximum number of refinement steps per column.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_mtx_solve_refine_ws_sz(n) free entries.
+ *
+ * @return  0 on success, -EINVAL or -ESINGULAR as for
+ *          @ref zsl_mtx_inv_refine, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_inv_refine_ws(const struct zsl_mtx *m, struct zsl_mtx *mi,
+			  size_t iter, struct zsl_workspace *ws);
+
+/**
+ * @brief Calculates the matrix exponential e = exp(m) of square matrix 'm'.
+ *
+ * This uses scaling and squaring with a degree 6 diagonal Pade
+ * approximant: 'm' is halved until its infinity norm is at most 0.5, the
+ * approximant is solved with partial-pivoting LU decomposition, and the
+ * result is squared back up once per halving. This is accurate to roughly
+ * the working precision for well-scaled inputs, and costs a handful of
+ * nxn matrix multiplications plus one extra multiplication per halving.
+ *
+ * @param m     The input square matrix.
+ * @param e     The output matrix, the same shape as 'm'. This may point to
+ *              the same matrix as 'm'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't square and of the same size, or -ESINGULAR if the Pade
+ *          denominator couldn't be factored, which indicates non-finite
+ *          values in 'm'.
+ */
+int zsl_mtx_expm(const struct zsl_mtx *m, struct zsl_mtx *e);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_mtx_expm_ws for an nxn matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_expm_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_expm, taking its temporaries from
+ *        workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param m     The input square matrix.
+ * @param e     The output matrix, the same shape as 'm'.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_mtx_expm_ws_sz(n) free entries.
+ *
+ * @return  0 on success, -EINVAL or -ESINGULAR as for @ref zsl_mtx_expm,
+ *          or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_expm_ws(const struct zsl_mtx *m, struct zsl_mtx *e,
+		    struct zsl_workspace *ws);
+
+/**
+ * @brief Discretises the continuous-time system dx/dt = A * x + B * u with
+ *        a zero-order hold on 'u' and a sample period of 't'.
+ *
+ * The discrete system x[k + 1] = Ad * x[k] + Bd * u[k] is found by taking
+ * the matrix exponential of the (n + p)x(n + p) block matrix
+ * [A B; 0 0] * t, whose top row holds Ad = exp(A * t) and Bd. This is
+ * typically done once, when a Kalman filter or controller is configured.
+ *
+ * @param a     The nxn continuous-time state matrix.
+ * @param b     The nxp continuous-time input matrix, or NULL if the system
+ *              has no inputs.
+ * @param t     The sample period.
+ * @param ad    The nxn output discrete-time state matrix.
+ * @param bd    The nxp output discrete-time input matrix, or NULL if 'b'
+ *              is NULL.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't compatible, or -ESINGULAR as for @ref zsl_mtx_expm.
+ */
+int zsl_mtx_c2d(const struct zsl_mtx *a, const struct zsl_mtx *b, zsl_real_t t,
+		struct zsl_mtx *ad, struct zsl_mtx *bd);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_mtx_c2d_ws for an n-state, p-input system.
+ *
+ * @param n     The number of states.
+ * @param p     The number of inputs, which is zero if 'b' is NULL.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_c2d_ws_sz(size_t n, size_t p);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_c2d, taking its temporaries from
+ *        workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param a     The nxn continuous-time state matrix.
+ * @param b     The nxp continuous-time input matrix, or NULL.
+ * @param t     The sample period.
+ * @param ad    The nxn output discrete-time state matrix.
+ * @param bd    The nxp output discrete-time input matrix, or NULL.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_mtx_c2d_ws_sz(n, p) free entries.
+ *
+ * @return  0 on success, -EINVAL or -ESINGULAR as for @ref zsl_mtx_c2d,
+ *          or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_c2d_ws(const struct zsl_mtx *a, const struct zsl_mtx *b,
+		   zsl_real_t t, struct zsl_mtx *ad, struct zsl_mtx *bd,
+		   struct zsl_workspace *ws);
+
+/**
+ * @brief Solves T * X = B for X, where 't' is a triangular matrix.
+ *
+ * Only the lower (or upper) triangle of 't', including the diagonal, is
+ * read. Each column of 'b' is treated as a separate right-hand side, and 'x'
+ * may point to the same matrix as 'b' to solve in place.
+ *
+ * @param t     The nxn triangular matrix.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ * @param lower True if 't' is lower triangular, false if it's upper
+ *              triangular.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 't' isn't square
+ *          or 'b' and 'x' aren't compatible with 't', or -ESINGULAR if the
+ *          diagonal of 't' contains a zero.
+ */
+int zsl_mtx_trsm(const struct zsl_mtx *t, struct zsl_mtx *b, struct zsl_mtx *x,
+		 bool lower);
+
+/**
+ * @brief Solves T * x = b for vector x, where 't' is a triangular matrix.
+ *
+ * This is the single right-hand side form of @ref zsl_mtx_trsm, and 'x' may
+ * point to the same vector as 'b'.
+ *
+ * @param t     The nxn triangular matrix.
+ * @param b     The right-hand side vector, with n elements.
+ * @param x     The output solution vector, with n elements.
+ * @param lower True if 't' is lower triangular, false if it's upper
+ *              triangular.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 't' isn't square
+ *          or 'b' and 'x' don't have n elements, or -ESINGULAR if the
+ *          diagonal of 't' contains a zero.
+ */
+int zsl_mtx_trsv(const struct zsl_mtx *t, struct zsl_vec *b, struct zsl_vec *x,
+		 bool lower);
+
+/**
+ * @brief Balances the square matrix 'm', a process in which the eigenvalues of
+ *        the output matrix are the same as the eigenvalues of the input matrix.
  *
  * @param m     The input square matrix to use.
  * @param mout  The output balanced matrix.
@@ -778,7 +1930,7 @@ int zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout);
+int zsl_mtx_balance(const struct zsl_mtx *m, struct zsl_mtx *mout);
 
 /**
  * @brief Calculates the householder reflection of 'm'. Used as part of QR
@@ -793,7 +1945,36 @@ int zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
+int zsl_mtx_householder(const struct zsl_mtx *m, struct zsl_mtx *h,
+			bool hessenberg);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_householder_ws for an input matrix with 'rows' rows.
+ *
+ * @param rows  The number of rows in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_householder_ws_sz(size_t rows);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_householder, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * 'h' may be larger than the reflection, in which case the reflection is
+ * placed in the lower right corner of an identity matrix.
+ *
+ * @param m            Pointer to the input matrix to use.
+ * @param h            Pointer to the output square matrix.
+ * @param hessenberg   If set to true, the first line in 'm' is ignored.
+ * @param ws           Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_householder_ws(const struct zsl_mtx *m, struct zsl_mtx *h,
+			   bool hessenberg, struct zsl_workspace *ws);
 
 /**
  * @brief If 'hessenberg' is set to false, this function performs the QR
@@ -808,6 +1989,10 @@ int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
  * but they tend to be less stable than the householder method for a similar
  * computational cost.
  *
+ * The reflections are applied implicitly rather than as dense matrices, so
+ * only 'q' itself is formed. Use @ref zsl_mtx_qr if 'q' is not required
+ * explicitly.
+ *
  * @param m     Pointer to the input square matrix.
  * @param q     Pointer to the output orthoogonal square matrix.
  * @param r     Pointer to the output upper triangular square matrix or
@@ -817,26 +2002,199 @@ int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+int zsl_mtx_qrd(const struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
 		bool hessenberg);
 
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_qrd_ws for a rows x cols input matrix.
+ *
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_qrd_ws_sz(size_t rows, size_t cols);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_qrd, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     Pointer to the input square matrix.
+ * @param q     Pointer to the output orthoogonal square matrix.
+ * @param r     Pointer to the output upper triangular square matrix or
+ *              hessenberg matrix if set to true.
+ * @param hessenberg Sets the matrix to hessenberg format if 'true'.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_qrd_ws(const struct zsl_mtx *m, struct zsl_mtx *q,
+		   struct zsl_mtx *r, bool hessenberg,
+		   struct zsl_workspace *ws);
+
+/**
+ * @brief Performs the QR decomposition of matrix 'm' using Householder
+ *        reflections, storing the result in compact form: R in the upper
+ *        triangle of 'qr', and the Householder vectors below its diagonal.
+ *
+ * Q is never formed explicitly. It is the product H_0 * H_1 * ... of the
+ * reflectors H_k = I - tau_k * v_k * v_k^T, where v_k has an implicit 1 in
+ * row k, and can be applied to other matrices with
+ * @ref zsl_mtx_qr_apply_q. This requires no temporary memory, and avoids
+ * the cost of multiplying dense reflection matrices.
+ *
+ * @param m     Pointer to the input matrix.
+ * @param qr    Pointer to the output matrix, the same size as 'm'. This
+ *              may be 'm' to factorise in place.
+ * @param tau   Pointer to the output vector of reflector scale factors,
+ *              with MIN(rows, cols) elements.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'qr' or 'tau'
+ *          are sized incorrectly.
+ */
+int zsl_mtx_qr(const struct zsl_mtx *m, struct zsl_mtx *qr,
+	       struct zsl_vec *tau);
+
+/**
+ * @brief Multiplies matrix 'b' in place by the Q (or Q^T) factor of a
+ *        compact QR decomposition produced by @ref zsl_mtx_qr.
+ *
+ * Applying Q^T to the right-hand side of a linear system, followed by
+ * @ref zsl_mtx_trsm with the upper triangle of 'qr', solves the system in
+ * the least-squares sense.
+ *
+ * @param qr    Pointer to the compact QR decomposition.
+ * @param tau   Pointer to the reflector scale factors.
+ * @param b     Pointer to the matrix to multiply, which must have as many
+ *              rows as 'qr' and must not be 'qr'.
+ * @param trans If true, 'b' is multiplied by Q^T rather than Q.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'b' or 'tau'
+ *          are sized incorrectly.
+ */
+int zsl_mtx_qr_apply_q(const struct zsl_mtx *qr, const struct zsl_vec *tau,
+		       struct zsl_mtx *b, bool trans);
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Computes recursively the QR decompisition method to put the input
  *        square matrix into upper triangular form.
  *
+ * Each iteration uses a Wilkinson shift taken from the trailing 2x2
+ * submatrix of the unconverged block, and converged rows are deflated from
+ * the bottom of that block. Iteration stops early once every row has
+ * converged, leaving 2x2 blocks on the diagonal for complex conjugate
+ * eigenvalue pairs.
+ *
  * @param m     The input square matrix to use when performing the QR
  *              decomposition.
  * @param mout  The output upper triangular square matrix where the results
  *              should be stored.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
+ * @param iter  The maximum number of times that 'zsl_mtx_qrd' should be
+ *              called.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter);
+int zsl_mtx_qrd_iter(const struct zsl_mtx *m, struct zsl_mtx *mout,
+		     size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_qrd_iter_ws for an nxn input matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_qrd_iter_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_qrd_iter, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack or the QRD
+ *        scratch memory.
+ *
+ * @param m     The input square matrix to use when performing the QR
+ *              decomposition.
+ * @param mout  The output upper triangular square matrix where the results
+ *              should be stored.
+ * @param iter  The maximum number of times that 'zsl_mtx_qrd' should be
+ *              called.
+ * @param used  If not NULL, set to the number of iterations actually
+ *              performed, which is at most 'iter'.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_qrd_iter_ws(const struct zsl_mtx *m, struct zsl_mtx *mout,
+			size_t iter, size_t *used, struct zsl_workspace *ws);
 #endif
 
+/**
+ * @brief Computes the real Schur decomposition M = Q * T * Q^T of square
+ *        matrix 'm'.
+ *
+ * 'm' is reduced to upper Hessenberg form once with Householder
+ * reflections, as in @ref zsl_mtx_qrd with 'hessenberg' set, and shifted QR
+ * iterations are then run on the Hessenberg matrix. Each iteration is an
+ * implicit Francis double-shift step on the unreduced block, chasing a
+ * 3x3 Householder bulge down the subdiagonal, so it costs O(n^2) rather
+ * than the O(n^3) of @ref zsl_mtx_qrd_iter on a dense matrix, and complex
+ * conjugate shifts are handled in real arithmetic. Converged rows are
+ * deflated from the bottom of the active block, and an exceptional shift
+ * is used every 10 iterations without a deflation to break cycles.
+ *
+ * 'T' is quasi upper triangular: real eigenvalues are on its diagonal, and
+ * each complex conjugate pair is held in a 2x2 block on the diagonal whose
+ * subdiagonal element is non-zero.
+ *
+ * @param m     The input square matrix.
+ * @param t     The output quasi upper triangular matrix, the same shape as
+ *              'm'. This must not be 'm'.
+ * @param q     The output orthogonal matrix, the same shape as 'm', or NULL
+ *              if only 'T' is needed.
+ * @param iter  The maximum number of QR iterations.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't square and of the same size, or -ENOCONVERGE if 'T'
+ *          didn't converge within 'iter' iterations, in which case 't' and
+ *          'q' hold the partly converged decomposition.
+ */
+int zsl_mtx_schur(const struct zsl_mtx *m, struct zsl_mtx *t, struct zsl_mtx *q,
+		  size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_schur_ws for an nxn input matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_schur_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_schur, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input square matrix.
+ * @param t     The output quasi upper triangular matrix.
+ * @param q     The output orthogonal matrix, or NULL.
+ * @param iter  The maximum number of QR iterations.
+ * @param used  If not NULL, set to the number of iterations actually
+ *              performed, which is at most 'iter'.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 on success, -EINVAL or -ENOCONVERGE as for
+ *          @ref zsl_mtx_schur, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_schur_ws(const struct zsl_mtx *m, struct zsl_mtx *t,
+		     struct zsl_mtx *q, size_t iter, size_t *used,
+		     struct zsl_workspace *ws);
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief   Calculates the eigenvalues for input matrix 'm' using QR
@@ -846,18 +2204,51 @@ int zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter);
  * @param m     The input square matrix to use.
  * @param v     The placeholder for the output vector where the real eigenvalues
  *              should be stored.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called
- *              during the QR decomposition phase.
+ * @param iter  The maximum number of times that 'zsl_mtx_qrd' should be
+ *              called during the QR decomposition phase. Iteration stops
+ *              early once the eigenvalues have converged to working
+ *              precision, so this only bounds the worst case.
  *
- * NOTE: Large values required more iterations to get precise results, and
- * some trial and error may be required to find the right balance of
- * iterations versus processing time.
+ * The eigenvalues are returned in order of decreasing absolute value.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code. If -ECOMPLEXVAL is returned, it means that complex
- *          numbers were detected in the output eigenvalues.
+ *          numbers were detected in the output eigenvalues, and if
+ *          -ENOCONVERGE is returned, 'iter' iterations weren't enough and
+ *          'v' holds the partly converged estimates.
  */
-int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
+int zsl_mtx_eigenvalues(const struct zsl_mtx *m, struct zsl_vec *v,
+			size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_eigenvalues_ws for an nxn input matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_eigenvalues_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_eigenvalues, but all temporary memory
+ *        is allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param v     The placeholder for the output vector where the real eigenvalues
+ *              should be stored.
+ * @param iter  The maximum number of times that 'zsl_mtx_qrd' should be
+ *              called during the QR decomposition phase.
+ * @param used  If not NULL, set to the number of QR iterations actually
+ *              performed, which is at most 'iter'.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          -ECOMPLEXVAL if complex eigenvalues were detected, or
+ *          -ENOCONVERGE if 'iter' iterations weren't enough.
+ */
+int zsl_mtx_eigenvalues_ws(const struct zsl_mtx *m, struct zsl_vec *v,
+			   size_t iter, size_t *used, struct zsl_workspace *ws);
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
@@ -883,27 +2274,179 @@ int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
  *          error code. If the number of calcualted eigenvectors is less
  *          than the columns in 'm', EEIGENSIZE will be returned.
  */
-int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
-                         bool orthonormal);
+int zsl_mtx_eigenvectors(const struct zsl_mtx *m, struct zsl_mtx *mev,
+			 size_t iter, bool orthonormal);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_eigenvectors_ws for an nxn input matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_eigenvectors_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_eigenvectors, but all temporary memory
+ *        is allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m             The input square matrix to use.
+ * @param mev           The placeholder for the output square matrix where the
+ *                      eigenvectors should be stored as column vectors.
+ * @param iter          The number of times that 'zsl_mtx_qrd' should be called.
+ *                      during the QR decomposition phase.
+ * @param orthonormal   If set to true, the output matrix 'mev' will be
+ *                      orthonormalised.
+ * @param ws            Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          or -EEIGENSIZE if fewer eigenvectors than columns were found.
+ */
+int zsl_mtx_eigenvectors_ws(const struct zsl_mtx *m, struct zsl_mtx *mev,
+			    size_t iter, bool orthonormal,
+			    struct zsl_workspace *ws);
 #endif
 
+/**
+ * @brief Calculates the eigenvalues and eigenvectors of the symmetric input
+ *        matrix 'm', such as a covariance matrix or an inertia tensor.
+ *
+ * 3x3 matrices are solved in closed form, and other sizes use the cyclic
+ * Jacobi method. Only the upper triangle of 'm' is referenced.
+ *
+ * @param m     The input symmetric square matrix to use.
+ * @param v     The placeholder for the output vector where the eigenvalues
+ *              should be stored, in order of decreasing value.
+ * @param mev   The placeholder for the output square matrix where the
+ *              orthonormal eigenvectors should be stored as column vectors,
+ *              in the same order as 'v'. May be NULL if only the
+ *              eigenvalues are required.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' isn't
+ *          square or the outputs aren't sized to match.
+ */
+int zsl_mtx_eigen_sym(const struct zsl_mtx *m, struct zsl_vec *v,
+		      struct zsl_mtx *mev);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_eigen_sym_ws for an nxn input matrix.
+ *
+ * @param n     The number of rows and columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_eigen_sym_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_eigen_sym, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input symmetric square matrix to use.
+ * @param v     The placeholder for the output vector where the eigenvalues
+ *              should be stored, in order of decreasing value.
+ * @param mev   The placeholder for the output eigenvector matrix, or NULL.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          or -EINVAL if 'm' isn't square or the outputs aren't sized to
+ *          match.
+ */
+int zsl_mtx_eigen_sym_ws(const struct zsl_mtx *m, struct zsl_vec *v,
+			 struct zsl_mtx *mev, struct zsl_workspace *ws);
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Performs singular value decomposition, converting input matrix 'm'
- *        into matrices 'u', 'e', and 'v'.
+ *        into matrices 'u', 'e', and 'v', such that m = u * e * v^T.
+ *
+ * This uses one-sided Jacobi rotations on the columns of 'm' (or of its
+ * transpose, if 'm' has more columns than rows), which avoids forming
+ * m * m^T and squaring the condition number. Sweeps stop as soon as every
+ * pair of columns is orthogonal to working precision. The singular values
+ * are placed on the diagonal of 'e' in decreasing order.
  *
  * @param m     The input mxn matrix to use.
  * @param u     The placeholder for the output mxm matrix u.
  * @param e     The placeholder for the output mxn matrix sigma.
  * @param v     The placeholder for the output nxn matrix v.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
- *              during the QR decomposition phase.
+ * @param iter  The maximum number of Jacobi sweeps to perform.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+int zsl_mtx_svd(const struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 		struct zsl_mtx *v, size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_svd_ws for a rows x cols input matrix.
+ *
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_svd_ws_sz(size_t rows, size_t cols);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_svd, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param u     The placeholder for the output mxm matrix u.
+ * @param e     The placeholder for the output mxn matrix sigma.
+ * @param v     The placeholder for the output nxn matrix v.
+ * @param iter  The maximum number of Jacobi sweeps to perform.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_svd_ws(const struct zsl_mtx *m, struct zsl_mtx *u,
+		   struct zsl_mtx *e, struct zsl_mtx *v, size_t iter,
+		   struct zsl_workspace *ws);
+
+/**
+ * @brief Calculates only the singular values of matrix 'm', skipping the
+ *        accumulation of 'u' and 'v'.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param s     The output vector of min(m, n) singular values, in
+ *              decreasing order.
+ * @param iter  The maximum number of Jacobi sweeps to perform.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 's' doesn't
+ *          have min(m, n) elements.
+ */
+int zsl_mtx_svd_vals(const struct zsl_mtx *m, struct zsl_vec *s, size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_svd_vals_ws for a rows x cols input matrix.
+ *
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_svd_vals_ws_sz(size_t rows, size_t cols);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_svd_vals, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param s     The output vector of min(m, n) singular values.
+ * @param iter  The maximum number of Jacobi sweeps to perform.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          or -EINVAL if 's' doesn't have min(m, n) elements.
+ */
+int zsl_mtx_svd_vals_ws(const struct zsl_mtx *m, struct zsl_vec *s, size_t iter,
+			struct zsl_workspace *ws);
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
@@ -919,11 +2462,237 @@ int zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter);
+int zsl_mtx_pinv(const struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_mtx_pinv_ws for a rows x cols input matrix.
+ *
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_pinv_ws_sz(size_t rows, size_t cols);
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_pinv, but all temporary memory is
+ *        allocated from workspace 'ws' rather than the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
+ *              during the QR decomposition phase.
+ * @param ws    Pointer to the workspace to allocate temporaries from.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too small,
+ *          otherwise an appropriate error code.
+ */
+int zsl_mtx_pinv_ws(const struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		    struct zsl_workspace *ws);
 #endif
 
 /** @} */ /* End of MTX_TRANSFORMATIONS group */
 
+/**
+ * @addtogroup MTX_PLANS Plans
+ *
+ * @brief Decompositions prepared once per input shape and run many times.
+ *
+ * A control loop that calls zsl_mtx_svd or zsl_mtx_pinv on same-sized
+ * matrices on every cycle pays each time to size and allocate temporaries
+ * from scratch memory. A plan does that work once: @ref zsl_mtx_plan_init
+ * checks the shape and carves every temporary out of a caller-provided
+ * workspace, and the plan is then executed any number of times with no
+ * further allocation, as in FFTW.
+ *
+ * The workspace memory belongs to the plan for as long as it is used, so
+ * it must not be released or reused for anything else in the meantime.
+ * A plan holds intermediate results, so it must not be executed from two
+ * threads at once.
+ *
+ * The number of sweeps or QR steps these decompositions need depends on
+ * the input, but the cost of each one does not: a Jacobi sweep of the SVD
+ * rotates every pair of columns once, and a QR step of the eigenvalue
+ * iteration costs O(n^2). For a bounded latency, a plan can therefore also
+ * be run in time slices. @ref zsl_mtx_plan_start loads an input, each call
+ * to @ref zsl_mtx_plan_step runs at most a given number of steps, and the
+ * execute functions, called with a NULL input, form the best result so far
+ * from the state left in the plan, whether it has converged or not.
+ *
+ * @ingroup MATRICES
+ *  @{ */
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Returns the number of zsl_real_t workspace entries that
+ *        @ref zsl_mtx_plan_init allocates for a plan of type 'type' and a
+ *        rows x cols input matrix.
+ *
+ * @param type  The decomposition to plan.
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_mtx_plan_ws_sz(enum zsl_mtx_plan_type type, size_t rows,
+			  size_t cols);
+
+/**
+ * @brief Creates a plan for running decomposition 'type' on rows x cols
+ *        input matrices, allocating its temporaries from 'ws'.
+ *
+ * @param plan  The plan to initialise.
+ * @param type  The decomposition to plan.
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ * @param iter  The maximum number of Jacobi sweeps or QR steps per call.
+ * @param ws    The workspace to allocate temporaries from, with
+ *              zsl_mtx_plan_ws_sz(type, rows, cols) free entries.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'type' is
+ *          unknown, the shape is empty, or it isn't square for
+ *          ZSL_MTX_PLAN_EIGENVALUES, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_mtx_plan_init(struct zsl_mtx_plan *plan, enum zsl_mtx_plan_type type,
+		      size_t rows, size_t cols, size_t iter,
+		      struct zsl_workspace *ws);
+
+/**
+ * @brief Loads input 'm' into 'plan' for a time-sliced run with
+ *        @ref zsl_mtx_plan_step. No sweeps or QR steps are run yet.
+ *
+ * For ZSL_MTX_PLAN_EIGENVALUES, this also balances 'm' and reduces it to
+ * Hessenberg form, which takes O(n^3) operations regardless of the data.
+ *
+ * @param plan  The plan.
+ * @param m     The input matrix, of the shape 'plan' was created for. It
+ *              isn't read again afterwards.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' has the
+ *          wrong shape.
+ */
+int zsl_mtx_plan_start(struct zsl_mtx_plan *plan, const struct zsl_mtx *m);
+
+/**
+ * @brief Continues the run started by @ref zsl_mtx_plan_start for at most
+ *        'budget' Jacobi sweeps or QR steps, stopping early once it has
+ *        converged.
+ *
+ * The run can be continued by further calls, in the same or later ticks,
+ * until it has converged or run the 'iter' steps given to
+ * @ref zsl_mtx_plan_init in total. Calling the matching execute function
+ * with a NULL input forms the result at any point in between.
+ *
+ * @param plan  The plan.
+ * @param budget The largest number of sweeps or QR steps to run.
+ * @param used  If not NULL, set to the number of sweeps or QR steps run.
+ *
+ * @return  0 if the run has converged, -EAGAIN if 'budget' was used up
+ *          first, -ENOCONVERGE if the run reached 'iter' steps without
+ *          converging, or -EINVAL if no run was started.
+ */
+int zsl_mtx_plan_step(struct zsl_mtx_plan *plan, size_t budget, size_t *used);
+
+/**
+ * @brief Continues the Jacobi run of a ZSL_MTX_PLAN_SVD, _SVD_VALS or
+ *        _PINV plan started by @ref zsl_mtx_plan_start for at most 'budget'
+ *        column-pair rotations.
+ *
+ * A sweep of a p x q input visits q * (q - 1) / 2 pairs of columns, so a
+ * single sweep of a large matrix may take too long for one tick. Each pair
+ * costs O(p + q), whatever the data, so this bounds the work per call much
+ * more finely than @ref zsl_mtx_plan_step. The position within the sweep is
+ * kept in the plan, and the two functions may be mixed freely; only whole
+ * sweeps count towards 'iter'.
+ *
+ * @param plan  The plan.
+ * @param budget The largest number of column pairs to visit.
+ * @param used  If not NULL, set to the number of column pairs visited.
+ *
+ * @return  0 if the run has converged, -EAGAIN if 'budget' was used up
+ *          first, -ENOCONVERGE if the run reached 'iter' sweeps without
+ *          converging, or -EINVAL if no run was started or 'plan' is a
+ *          ZSL_MTX_PLAN_EIGENVALUES plan, whose QR steps already cost only
+ *          O(n^2) each.
+ */
+int zsl_mtx_plan_rotate(struct zsl_mtx_plan *plan, size_t budget,
+			size_t *used);
+
+/**
+ * @brief Executes a ZSL_MTX_PLAN_SVD plan, equivalent to @ref zsl_mtx_svd.
+ *
+ * @param plan  The plan to execute.
+ * @param m     The input matrix, of the shape 'plan' was created for, or
+ *              NULL to form the result of the run started with
+ *              @ref zsl_mtx_plan_start.
+ * @param u     The placeholder for the output mxm matrix u.
+ * @param e     The placeholder for the output mxn matrix sigma.
+ * @param v     The placeholder for the output nxn matrix v.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'plan' has a
+ *          different type, any matrix has the wrong shape, or 'm' is
+ *          NULL and no run was started.
+ */
+int zsl_mtx_plan_svd(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+		     struct zsl_mtx *u, struct zsl_mtx *e, struct zsl_mtx *v);
+
+/**
+ * @brief Executes a ZSL_MTX_PLAN_SVD_VALS plan, equivalent to
+ *        @ref zsl_mtx_svd_vals.
+ *
+ * @param plan  The plan to execute.
+ * @param m     The input matrix, of the shape 'plan' was created for, or
+ *              NULL to form the result of the run started with
+ *              @ref zsl_mtx_plan_start.
+ * @param s     The output vector of min(m, n) singular values.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'plan' has a
+ *          different type, 'm' or 's' have the wrong shape, or 'm' is
+ *          NULL and no run was started.
+ */
+int zsl_mtx_plan_svd_vals(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+			  struct zsl_vec *s);
+
+/**
+ * @brief Executes a ZSL_MTX_PLAN_PINV plan, equivalent to
+ *        @ref zsl_mtx_pinv.
+ *
+ * @param plan  The plan to execute.
+ * @param m     The input mxn matrix, of the shape 'plan' was created for,
+ *              or NULL to form the result of the run started with
+ *              @ref zsl_mtx_plan_start.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'plan' has a
+ *          different type, 'm' or 'pinv' have the wrong shape, or 'm' is
+ *          NULL and no run was started.
+ */
+int zsl_mtx_plan_pinv(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+		      struct zsl_mtx *pinv);
+
+/**
+ * @brief Executes a ZSL_MTX_PLAN_EIGENVALUES plan, equivalent to
+ *        @ref zsl_mtx_eigenvalues.
+ *
+ * @param plan  The plan to execute.
+ * @param m     The input nxn matrix, of the shape 'plan' was created for,
+ *              or NULL to form the result of the run started with
+ *              @ref zsl_mtx_plan_start.
+ * @param v     The output vector of real eigenvalues.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'plan' has a
+ *          different type, 'm' has the wrong shape, or 'm' is NULL and no
+ *          run was started, -ECOMPLEXVAL if the input has complex
+ *          eigenvalues, or -ENOCONVERGE if the run ended without
+ *          converging.
+ */
+int zsl_mtx_plan_eigenvalues(struct zsl_mtx_plan *plan,
+			     const struct zsl_mtx *m, struct zsl_vec *v);
+#endif
+
+/** @} */ /* End of MTX_PLANS group */
+
 /**
  * @addtogroup MTX_LIMITS Limits
  *
@@ -941,7 +2710,7 @@ int zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x);
+int zsl_mtx_min(const struct zsl_mtx *m, zsl_real_t *x);
 
 /**
  * @brief Traverses the matrix elements to find the maximum element value.
@@ -952,7 +2721,7 @@ int zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_max(struct zsl_mtx *m, zsl_real_t *x);
+int zsl_mtx_max(const struct zsl_mtx *m, zsl_real_t *x);
 
 /**
  * @brief Traverses the matrix elements to find the (i,j) index of the minimum
@@ -968,7 +2737,7 @@ int zsl_mtx_max(struct zsl_mtx *m, zsl_real_t *x);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_min_idx(struct zsl_mtx *m, size_t *i, size_t *j);
+int zsl_mtx_min_idx(const struct zsl_mtx *m, size_t *i, size_t *j);
 
 /**
  * @brief Traverses the matrix elements to find the (i,j) index of the maximum
@@ -984,7 +2753,7 @@ int zsl_mtx_min_idx(struct zsl_mtx *m, size_t *i, size_t *j);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_max_idx(struct zsl_mtx *m, size_t *i, size_t *j);
+int zsl_mtx_max_idx(const struct zsl_mtx *m, size_t *i, size_t *j);
 
 /** @} */ /* End of MTX_LIMITS group */
 
@@ -997,7 +2766,8 @@ int zsl_mtx_max_idx(struct zsl_mtx *m, size_t *i, size_t *j);
  *  @{ */
 
 /**
- * @brief Checks if two matrices are identical in shape and content.
+ * @brief Checks if two matrices are identical in shape and content. Values
+ *        are compared exactly, with 0.0 and -0.0 taken as equal.
  *
  * @param ma The first matrix.
  * @param mb The second matrix.
@@ -1005,7 +2775,7 @@ int zsl_mtx_max_idx(struct zsl_mtx *m, size_t *i, size_t *j);
  * @return true if the two matrices have the same shape and values,
  *         otherwise false.
  */
-bool zsl_mtx_is_equal(struct zsl_mtx *ma, struct zsl_mtx *mb);
+bool zsl_mtx_is_equal(const struct zsl_mtx *ma, const struct zsl_mtx *mb);
 
 /**
  * @brief Checks if all elements in matrix m are >= zero.
@@ -1015,19 +2785,152 @@ bool zsl_mtx_is_equal(struct zsl_mtx *ma, struct zsl_mtx *mb);
  * @return true if the all matrix elements are zero or positive,
  *         otherwise false.
  */
-bool zsl_mtx_is_notneg(struct zsl_mtx *m);
+bool zsl_mtx_is_notneg(const struct zsl_mtx *m);
 
 /**
- * @brief Checks if the square input matrix is symmetric.
+ * @brief Checks if the input matrix is square and symmetric, to within
+ *        1E-6.
+ *
+ * The matrix is compared in square tiles, each against its transposed
+ * mirror, and the check stops at the first tile that differs.
  *
  * @param m The matrix to check.
  *
  * @return true if the matrix is symmetric, otherwise false.
  */
-bool zsl_mtx_is_sym(struct zsl_mtx *m);
+bool zsl_mtx_is_sym(const struct zsl_mtx *m);
 
 /** @} */ /* End of MTX_COMPARISON group */
 
+/**
+ * @addtogroup MTX_STRUCTURE Structure
+ *
+ * @brief Functions that take advantage of known structure in a matrix, such
+ *        as symmetry or triangularity, to pick a cheaper algorithm.
+ *
+ * The structure of a matrix is described by a set of ZSL_MTX_PROP_* flags,
+ * which are either known from how the matrix was produced, or found once
+ * with @ref zsl_mtx_props. The flags are kept by the caller alongside the
+ * matrix, rather than in the zsl_mtx itself, since matrix data is often
+ * written directly, which would leave stored flags out of date.
+ *
+ * Some routines produce matrices with known structure:
+ *
+ * - @ref zsl_mtx_qrd: 'q' is ZSL_MTX_PROP_ORTHO, and 'r' is
+ *   ZSL_MTX_PROP_UPPER unless 'hessenberg' is set.
+ * - @ref zsl_mtx_cholesky: 'l' is ZSL_MTX_PROP_LOWER.
+ * - @ref zsl_mtx_eigen_sym: 'mev' is ZSL_MTX_PROP_ORTHO.
+ *
+ * The flags are trusted as given, so passing flags that don't apply gives
+ * wrong results.
+ *
+ * @ingroup MATRICES
+ *  @{ */
+
+/** Matrix property: square and symmetric, see @ref zsl_mtx_is_sym. */
+#define ZSL_MTX_PROP_SYM        (1u << 0)
+/** Matrix property: symmetric and positive-definite. */
+#define ZSL_MTX_PROP_POSDEF     (1u << 1)
+/** Matrix property: square, with only zeros below the diagonal. */
+#define ZSL_MTX_PROP_UPPER      (1u << 2)
+/** Matrix property: square, with only zeros above the diagonal. */
+#define ZSL_MTX_PROP_LOWER      (1u << 3)
+/** Matrix property: diagonal, which is both upper and lower triangular. */
+#define ZSL_MTX_PROP_DIAG       (ZSL_MTX_PROP_UPPER | ZSL_MTX_PROP_LOWER)
+/** Matrix property: square and orthogonal, so its inverse is its
+ * transpose. */
+#define ZSL_MTX_PROP_ORTHO      (1u << 4)
+
+/**
+ * @brief Determines the structural properties of 'm' that algorithms can
+ *        take advantage of, as a set of ZSL_MTX_PROP_* flags.
+ *
+ * This is meant to be called once for a matrix whose contents don't change,
+ * such as a covariance or system matrix, so that code in a hot loop can
+ * pass the flags to the *_props functions without checking 'm' again.
+ *
+ * Triangularity requires exact zeros. Orthogonality is tested by forming
+ * m^T * m, and positive-definiteness by a Cholesky decomposition, each
+ * using scratch memory for one copy of 'm'. Non-square matrices have no
+ * properties.
+ *
+ * @param m     The matrix to check.
+ * @param props The ZSL_MTX_PROP_* flags that apply to 'm'.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if no scratch
+ *          memory was available, in which case only ZSL_MTX_PROP_SYM,
+ *          ZSL_MTX_PROP_UPPER and ZSL_MTX_PROP_LOWER are reliable.
+ */
+int zsl_mtx_props(const struct zsl_mtx *m, uint32_t *props);
+
+/**
+ * @brief Multiplies matrix 'ma' by 'mb', assigning the output to 'mc', and
+ *        skipping the products with the known zeros of either input.
+ *
+ * A triangular operand halves the work, and a diagonal 'ma' reduces the
+ * product to scaling the rows of 'mb'. Without triangular flags this is
+ * @ref zsl_mtx_mult.
+ *
+ * @param ma    Pointer to the first input zsl_mtx.
+ * @param pa    The ZSL_MTX_PROP_* flags of 'ma'.
+ * @param mb    Pointer to the second input zsl_mtx.
+ * @param pb    The ZSL_MTX_PROP_* flags of 'mb'.
+ * @param mc    Pointer to the output zsl_mtx. This must not be 'ma' or
+ *              'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped, or a triangular flag is
+ *          given for a matrix that isn't square.
+ */
+int zsl_mtx_mult_props(const struct zsl_mtx *ma, uint32_t pa,
+		       const struct zsl_mtx *mb, uint32_t pb,
+		       struct zsl_mtx *mc);
+
+/**
+ * @brief Calculates the inverse of square matrix 'm', choosing the method
+ *        from its ZSL_MTX_PROP_* flags.
+ *
+ * Diagonal matrices are inverted in O(n), orthogonal matrices are
+ * transposed, triangular matrices use substitution, and positive-definite
+ * matrices use a Cholesky decomposition. Anything else uses
+ * @ref zsl_mtx_inv.
+ *
+ * @param m     The input square matrix to use.
+ * @param props The ZSL_MTX_PROP_* flags of 'm'.
+ * @param mi    The output inverse square matrix. This must not be 'm'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'm' and 'mi'
+ *          aren't square and the same shape, -ESINGULAR if a triangular
+ *          'm' has a zero on its diagonal, -ENOTPOSDEF if 'm' isn't
+ *          positive-definite after all, or -ENOMEM if no scratch memory
+ *          was available.
+ */
+int zsl_mtx_inv_props(const struct zsl_mtx *m, uint32_t props,
+		      struct zsl_mtx *mi);
+
+/**
+ * @brief Solves the linear system A * X = B for X, choosing the method from
+ *        the ZSL_MTX_PROP_* flags of 'a'.
+ *
+ * The methods are chosen as for @ref zsl_mtx_inv_props, without forming
+ * an inverse, and @ref zsl_mtx_solve is used for general matrices. 'x' may
+ * point to the same matrix as 'b' to solve in place.
+ *
+ * @param a     The nxn coefficient matrix.
+ * @param props The ZSL_MTX_PROP_* flags of 'a'.
+ * @param b     The n-row right-hand side matrix.
+ * @param x     The output solution, the same shape as 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'a' isn't square
+ *          or 'b' and 'x' aren't compatible with 'a', -ESINGULAR if 'a'
+ *          is singular, -ENOTPOSDEF if 'a' isn't positive-definite after
+ *          all, or -ENOMEM if no scratch memory was available.
+ */
+int zsl_mtx_solve_props(const struct zsl_mtx *a, uint32_t props,
+			struct zsl_mtx *b, struct zsl_mtx *x);
+
+/** @} */ /* End of MTX_STRUCTURE group */
+
 /**
  * @addtogroup MTX_DISPLAY Display
  *
@@ -1044,7 +2947,7 @@ bool zsl_mtx_is_sym(struct zsl_mtx *m);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_mtx_print(struct zsl_mtx *m);
+int zsl_mtx_print(const struct zsl_mtx *m);
 
 // int      zsl_mtx_fprint(FILE *stream, zsl_mtx *m);
 
@@ -1054,6 +2957,12 @@ int zsl_mtx_print(struct zsl_mtx *m);
 }
 #endif
 
+/* The inline versions of zsl_mtx_add, zsl_mtx_sub, zsl_mtx_mult and
+ * zsl_mtx_trans use the fixed-size kernels. */
+#if CONFIG_ZSL_MATRIX_INLINE
+#include <zsl/matrices_fixed.h>
+#endif
+
 #endif /* ZEPHYR_INCLUDE_ZSL_MATRICES_H_ */
 
 /** @} */ /* End of matrices group */
@@ -0,0 +1,961 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Fixed-size matrix kernels for zscilib.
+ *
+ * This file contains static inline kernels for 2x2, 3x3, 4x4 and 6x6
+ * matrices, which are common in attitude, rotation and color code. Since
+ * the dimensions are known at compile time the loops are fully unrolled,
+ * avoiding the indexing and bounds checking overhead of the generic
+ * functions.
+ *
+ * The kernels operate directly on row-major zsl_real_t arrays, such as the
+ * 'data' field of a struct zsl_mtx, and perform no size checks. Unless
+ * noted otherwise, the output must not overlap either input.
+ *
+ * zsl_mtx_inv_3x3 and zsl_mtx_inv_4x4 always use the inverse kernels
+ * below, which can also be called directly to get the determinant from
+ * the same pass.
+ *
+ * The zsl_vec3_* kernels do the same for 3-vectors, such as the vector
+ * part of a quaternion or a physics state, and are used by the generic
+ * vector functions when they are passed 3-vectors.
+ *
+ * When CONFIG_ZSL_MATRIX_INLINE is enabled, zsl_mtx_mult, zsl_mtx_trans,
+ * zsl_mtx_add and zsl_mtx_sub dispatch to these kernels automatically for
+ * matching sizes, and are defined inline at the end of this file so that
+ * 3x3 inputs reach the kernels without a function call.
+ *
+ * Other sizes can be declared with the ZSL_MTX_DECLARE_* macros at the end
+ * of this file, which generate a matrix type and a family of functions for
+ * the given dimensions. Any temporary storage they need is a fixed-size
+ * local array, so their stack usage is known at compile time.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_
+
+#include <errno.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Generic kernels, only called with a constant 'n' so that the compiler can
+ * fully unroll them. */
+static inline void zsl_mtx_fixed_mult(const zsl_real_t *a,
+				      const zsl_real_t *b, zsl_real_t *c,
+				      const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			zsl_real_t x = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				x += a[i * n + k] * b[k * n + j];
+			}
+			c[i * n + j] = x;
+		}
+	}
+}
+
+static inline void zsl_mtx_fixed_mult_vec(const zsl_real_t *a,
+					  const zsl_real_t *x, zsl_real_t *y,
+					  const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t s = 0.0;
+		for (size_t k = 0; k < n; k++) {
+			s += a[i * n + k] * x[k];
+		}
+		y[i] = s;
+	}
+}
+
+static inline void zsl_mtx_fixed_trans(const zsl_real_t *a, zsl_real_t *b,
+				       const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		b[i * n + i] = a[i * n + i];
+		for (size_t j = i + 1; j < n; j++) {
+			zsl_real_t x = a[i * n + j];
+			b[i * n + j] = a[j * n + i];
+			b[j * n + i] = x;
+		}
+	}
+}
+
+static inline void zsl_mtx_fixed_add(const zsl_real_t *a, const zsl_real_t *b,
+				     zsl_real_t *c, const size_t n)
+{
+	for (size_t i = 0; i < n * n; i++) {
+		c[i] = a[i] + b[i];
+	}
+}
+
+static inline void zsl_mtx_fixed_sub(const zsl_real_t *a, const zsl_real_t *b,
+				     zsl_real_t *c, const size_t n)
+{
+	for (size_t i = 0; i < n * n; i++) {
+		c[i] = a[i] - b[i];
+	}
+}
+
+/* Rectangular and decomposition kernels used by the ZSL_MTX_DECLARE_*
+ * macros, again only called with constant dimensions. */
+static inline void zsl_mtx_fixed_mult_mpn(const zsl_real_t *a,
+					  const zsl_real_t *b, zsl_real_t *c,
+					  const size_t m, const size_t p,
+					  const size_t n)
+{
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			zsl_real_t x = 0.0;
+			for (size_t k = 0; k < p; k++) {
+				x += a[i * p + k] * b[k * n + j];
+			}
+			c[i * n + j] = x;
+		}
+	}
+}
+
+static inline void zsl_mtx_fixed_mult_vec_mn(const zsl_real_t *a,
+					     const zsl_real_t *x,
+					     zsl_real_t *y, const size_t m,
+					     const size_t n)
+{
+	for (size_t i = 0; i < m; i++) {
+		zsl_real_t s = 0.0;
+		for (size_t k = 0; k < n; k++) {
+			s += a[i * n + k] * x[k];
+		}
+		y[i] = s;
+	}
+}
+
+static inline void zsl_mtx_fixed_mult_trans_vec_mn(const zsl_real_t *a,
+						   const zsl_real_t *x,
+						   zsl_real_t *y,
+						   const size_t m,
+						   const size_t n)
+{
+	for (size_t j = 0; j < n; j++) {
+		y[j] = 0.0;
+	}
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			y[j] += a[i * n + j] * x[i];
+		}
+	}
+}
+
+static inline void zsl_mtx_fixed_trans_mn(const zsl_real_t *a, zsl_real_t *b,
+					  const size_t m, const size_t n)
+{
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			b[j * m + i] = a[i * n + j];
+		}
+	}
+}
+
+/* Cholesky-Banachiewicz, as in zsl_mtx_cholesky. 'l' may be 'a'. */
+static inline int zsl_mtx_fixed_cholesky(const zsl_real_t *a, zsl_real_t *l,
+					 const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			zsl_real_t x = a[i * n + j];
+			for (size_t k = 0; k < j; k++) {
+				x -= l[i * n + k] * l[j * n + k];
+			}
+			if (i == j) {
+				/* Also catches NaN values. */
+				if (!(x > 0.0)) {
+					return -ENOTPOSDEF;
+				}
+				l[i * n + i] = ZSL_SQRT(x);
+			} else {
+				l[i * n + j] = x / l[j * n + j];
+			}
+		}
+		for (size_t j = i + 1; j < n; j++) {
+			l[i * n + j] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
+/* Solves L * L^T * x = b by forward and back substitution. 'x' may be
+ * 'b'. */
+static inline void zsl_mtx_fixed_chol_solve(const zsl_real_t *l,
+					    const zsl_real_t *b,
+					    zsl_real_t *x, const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t s = b[i];
+		for (size_t k = 0; k < i; k++) {
+			s -= l[i * n + k] * x[k];
+		}
+		x[i] = s / l[i * n + i];
+	}
+	for (size_t i = n; i-- > 0;) {
+		zsl_real_t s = x[i];
+		for (size_t k = i + 1; k < n; k++) {
+			s -= l[k * n + i] * x[k];
+		}
+		x[i] = s / l[i * n + i];
+	}
+}
+
+/* Gauss-Jordan inversion with partial pivoting, b = t^-1. 't' is a working
+ * copy of the input, which is overwritten. */
+static inline int zsl_mtx_fixed_inv(zsl_real_t *t, zsl_real_t *b,
+				    const size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			b[i * n + j] = (i == j) ? 1.0 : 0.0;
+		}
+	}
+
+	for (size_t c = 0; c < n; c++) {
+		size_t p = c;
+		zsl_real_t f;
+
+		for (size_t i = c + 1; i < n; i++) {
+			if (ZSL_ABS(t[i * n + c]) > ZSL_ABS(t[p * n + c])) {
+				p = i;
+			}
+		}
+		if (t[p * n + c] == 0.0) {
+			return -ESINGULAR;
+		}
+		if (p != c) {
+			for (size_t j = 0; j < n; j++) {
+				f = t[c * n + j];
+				t[c * n + j] = t[p * n + j];
+				t[p * n + j] = f;
+				f = b[c * n + j];
+				b[c * n + j] = b[p * n + j];
+				b[p * n + j] = f;
+			}
+		}
+
+		f = 1.0 / t[c * n + c];
+		for (size_t j = 0; j < n; j++) {
+			t[c * n + j] *= f;
+			b[c * n + j] *= f;
+		}
+		for (size_t i = 0; i < n; i++) {
+			if (i == c || t[i * n + c] == 0.0) {
+				continue;
+			}
+			f = t[i * n + c];
+			for (size_t j = 0; j < n; j++) {
+				t[i * n + j] -= f * t[c * n + j];
+				b[i * n + j] -= f * b[c * n + j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Multiplies two 2x2 matrices, c = a * b.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx22_mult(const zsl_real_t *a, const zsl_real_t *b,
+				  zsl_real_t *c)
+{
+	c[0] = a[0] * b[0] + a[1] * b[2];
+	c[1] = a[0] * b[1] + a[1] * b[3];
+	c[2] = a[2] * b[0] + a[3] * b[2];
+	c[3] = a[2] * b[1] + a[3] * b[3];
+}
+
+/**
+ * @brief Multiplies two 3x3 matrices, c = a * b.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx33_mult(const zsl_real_t *a, const zsl_real_t *b,
+				  zsl_real_t *c)
+{
+	c[0] = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+	c[1] = a[0] * b[1] + a[1] * b[4] + a[2] * b[7];
+	c[2] = a[0] * b[2] + a[1] * b[5] + a[2] * b[8];
+	c[3] = a[3] * b[0] + a[4] * b[3] + a[5] * b[6];
+	c[4] = a[3] * b[1] + a[4] * b[4] + a[5] * b[7];
+	c[5] = a[3] * b[2] + a[4] * b[5] + a[5] * b[8];
+	c[6] = a[6] * b[0] + a[7] * b[3] + a[8] * b[6];
+	c[7] = a[6] * b[1] + a[7] * b[4] + a[8] * b[7];
+	c[8] = a[6] * b[2] + a[7] * b[5] + a[8] * b[8];
+}
+
+/**
+ * @brief Multiplies two 4x4 matrices, c = a * b.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx44_mult(const zsl_real_t *a, const zsl_real_t *b,
+				  zsl_real_t *c)
+{
+	zsl_mtx_fixed_mult(a, b, c, 4);
+}
+
+/**
+ * @brief Multiplies two 6x6 matrices, c = a * b.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx66_mult(const zsl_real_t *a, const zsl_real_t *b,
+				  zsl_real_t *c)
+{
+	zsl_mtx_fixed_mult(a, b, c, 6);
+}
+
+/**
+ * @brief Multiplies a 2x2 matrix by a 2-element column vector, y = a * x.
+ *
+ * @param a     The input matrix.
+ * @param x     The input vector.
+ * @param y     The output vector.
+ */
+static inline void zsl_mtx22_mult_vec(const zsl_real_t *a,
+				      const zsl_real_t *x, zsl_real_t *y)
+{
+	y[0] = a[0] * x[0] + a[1] * x[1];
+	y[1] = a[2] * x[0] + a[3] * x[1];
+}
+
+/**
+ * @brief Multiplies a 3x3 matrix by a 3-element column vector, y = a * x.
+ *
+ * @param a     The input matrix.
+ * @param x     The input vector.
+ * @param y     The output vector.
+ */
+static inline void zsl_mtx33_mult_vec(const zsl_real_t *a,
+				      const zsl_real_t *x, zsl_real_t *y)
+{
+	y[0] = a[0] * x[0] + a[1] * x[1] + a[2] * x[2];
+	y[1] = a[3] * x[0] + a[4] * x[1] + a[5] * x[2];
+	y[2] = a[6] * x[0] + a[7] * x[1] + a[8] * x[2];
+}
+
+/**
+ * @brief Multiplies a 4x4 matrix by a 4-element column vector, y = a * x.
+ *
+ * @param a     The input matrix.
+ * @param x     The input vector.
+ * @param y     The output vector.
+ */
+static inline void zsl_mtx44_mult_vec(const zsl_real_t *a,
+				      const zsl_real_t *x, zsl_real_t *y)
+{
+	zsl_mtx_fixed_mult_vec(a, x, y, 4);
+}
+
+/**
+ * @brief Multiplies a 6x6 matrix by a 6-element column vector, y = a * x.
+ *
+ * @param a     The input matrix.
+ * @param x     The input vector.
+ * @param y     The output vector.
+ */
+static inline void zsl_mtx66_mult_vec(const zsl_real_t *a,
+				      const zsl_real_t *x, zsl_real_t *y)
+{
+	zsl_mtx_fixed_mult_vec(a, x, y, 6);
+}
+
+/**
+ * @brief Transposes a 2x2 matrix. 'b' may be 'a' to transpose in place.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix.
+ */
+static inline void zsl_mtx22_trans(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_mtx_fixed_trans(a, b, 2);
+}
+
+/**
+ * @brief Transposes a 3x3 matrix. 'b' may be 'a' to transpose in place.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix.
+ */
+static inline void zsl_mtx33_trans(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_mtx_fixed_trans(a, b, 3);
+}
+
+/**
+ * @brief Transposes a 4x4 matrix. 'b' may be 'a' to transpose in place.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix.
+ */
+static inline void zsl_mtx44_trans(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_mtx_fixed_trans(a, b, 4);
+}
+
+/**
+ * @brief Transposes a 6x6 matrix. 'b' may be 'a' to transpose in place.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix.
+ */
+static inline void zsl_mtx66_trans(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_mtx_fixed_trans(a, b, 6);
+}
+
+/**
+ * @brief Adds two 2x2 matrices, c = a + b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx22_add(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_add(a, b, c, 2);
+}
+
+/**
+ * @brief Adds two 3x3 matrices, c = a + b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx33_add(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_add(a, b, c, 3);
+}
+
+/**
+ * @brief Adds two 4x4 matrices, c = a + b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx44_add(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_add(a, b, c, 4);
+}
+
+/**
+ * @brief Adds two 6x6 matrices, c = a + b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx66_add(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_add(a, b, c, 6);
+}
+
+/**
+ * @brief Subtracts two 2x2 matrices, c = a - b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx22_sub(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_sub(a, b, c, 2);
+}
+
+/**
+ * @brief Subtracts two 3x3 matrices, c = a - b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx33_sub(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_sub(a, b, c, 3);
+}
+
+/**
+ * @brief Subtracts two 4x4 matrices, c = a - b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx44_sub(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_sub(a, b, c, 4);
+}
+
+/**
+ * @brief Subtracts two 6x6 matrices, c = a - b. 'c' may be 'a' or 'b'.
+ *
+ * @param a     The first input matrix.
+ * @param b     The second input matrix.
+ * @param c     The output matrix.
+ */
+static inline void zsl_mtx66_sub(const zsl_real_t *a, const zsl_real_t *b,
+				 zsl_real_t *c)
+{
+	zsl_mtx_fixed_sub(a, b, c, 6);
+}
+
+/**
+ * @brief Inverts a 3x3 matrix, b = a^-1, using its cofactors. 'b' may be
+ *        'a' to invert in place.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix, which is left unchanged if 'a' is
+ *              singular.
+ *
+ * @return The determinant of 'a', which is 0.0 if 'a' is singular.
+ */
+static inline zsl_real_t zsl_mtx33_inv(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_real_t c[9];
+	zsl_real_t d, s;
+
+	/* The adjugate, i.e. the transposed cofactor matrix. */
+	c[0] = a[4] * a[8] - a[5] * a[7];
+	c[1] = a[2] * a[7] - a[1] * a[8];
+	c[2] = a[1] * a[5] - a[2] * a[4];
+	c[3] = a[5] * a[6] - a[3] * a[8];
+	c[4] = a[0] * a[8] - a[2] * a[6];
+	c[5] = a[2] * a[3] - a[0] * a[5];
+	c[6] = a[3] * a[7] - a[4] * a[6];
+	c[7] = a[1] * a[6] - a[0] * a[7];
+	c[8] = a[0] * a[4] - a[1] * a[3];
+
+	d = a[0] * c[0] + a[1] * c[3] + a[2] * c[6];
+	if (d != 0.0) {
+		s = 1.0 / d;
+		for (size_t i = 0; i < 9; i++) {
+			b[i] = c[i] * s;
+		}
+	}
+
+	return d;
+}
+
+/**
+ * @brief Inverts a 4x4 matrix, b = a^-1, using its cofactors. 'b' may be
+ *        'a' to invert in place.
+ *
+ * The cofactors are built from the twelve 2x2 minors of the top two and
+ * bottom two rows, so each minor is only computed once.
+ *
+ * @param a     The input matrix.
+ * @param b     The output matrix, which is left unchanged if 'a' is
+ *              singular.
+ *
+ * @return The determinant of 'a', which is 0.0 if 'a' is singular.
+ */
+static inline zsl_real_t zsl_mtx44_inv(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_real_t s[6], c[6], t[16];
+	zsl_real_t d, x;
+
+	/* 2x2 minors of rows 0 and 1, and of rows 2 and 3. */
+	s[0] = a[0] * a[5] - a[4] * a[1];
+	s[1] = a[0] * a[6] - a[4] * a[2];
+	s[2] = a[0] * a[7] - a[4] * a[3];
+	s[3] = a[1] * a[6] - a[5] * a[2];
+	s[4] = a[1] * a[7] - a[5] * a[3];
+	s[5] = a[2] * a[7] - a[6] * a[3];
+	c[0] = a[8] * a[13] - a[12] * a[9];
+	c[1] = a[8] * a[14] - a[12] * a[10];
+	c[2] = a[8] * a[15] - a[12] * a[11];
+	c[3] = a[9] * a[14] - a[13] * a[10];
+	c[4] = a[9] * a[15] - a[13] * a[11];
+	c[5] = a[10] * a[15] - a[14] * a[11];
+
+	d = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] +
+	    s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+	if (d == 0.0) {
+		return d;
+	}
+
+	t[0] = a[5] * c[5] - a[6] * c[4] + a[7] * c[3];
+	t[1] = -a[1] * c[5] + a[2] * c[4] - a[3] * c[3];
+	t[2] = a[13] * s[5] - a[14] * s[4] + a[15] * s[3];
+	t[3] = -a[9] * s[5] + a[10] * s[4] - a[11] * s[3];
+	t[4] = -a[4] * c[5] + a[6] * c[2] - a[7] * c[1];
+	t[5] = a[0] * c[5] - a[2] * c[2] + a[3] * c[1];
+	t[6] = -a[12] * s[5] + a[14] * s[2] - a[15] * s[1];
+	t[7] = a[8] * s[5] - a[10] * s[2] + a[11] * s[1];
+	t[8] = a[4] * c[4] - a[5] * c[2] + a[7] * c[0];
+	t[9] = -a[0] * c[4] + a[1] * c[2] - a[3] * c[0];
+	t[10] = a[12] * s[4] - a[13] * s[2] + a[15] * s[0];
+	t[11] = -a[8] * s[4] + a[9] * s[2] - a[11] * s[0];
+	t[12] = -a[4] * c[3] + a[5] * c[1] - a[6] * c[0];
+	t[13] = a[0] * c[3] - a[1] * c[1] + a[2] * c[0];
+	t[14] = -a[12] * s[3] + a[13] * s[1] - a[14] * s[0];
+	t[15] = a[8] * s[3] - a[9] * s[1] + a[10] * s[0];
+
+	x = 1.0 / d;
+	for (size_t i = 0; i < 16; i++) {
+		b[i] = t[i] * x;
+	}
+
+	return d;
+}
+
+/**
+ * @brief Returns the dot product of 3-vectors 'a' and 'b'.
+ *
+ * @param a     The first input vector.
+ * @param b     The second input vector.
+ */
+static inline zsl_real_t zsl_vec3_dot(const zsl_real_t *a, const zsl_real_t *b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * @brief Returns the Euclidean norm of 3-vector 'a'.
+ *
+ * @param a     The input vector.
+ */
+static inline zsl_real_t zsl_vec3_norm(const zsl_real_t *a)
+{
+	return ZSL_SQRT(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+}
+
+/**
+ * @brief Returns the Euclidean distance between 3-vectors 'a' and 'b',
+ *        without forming their difference in memory.
+ *
+ * @param a     The first input vector.
+ * @param b     The second input vector.
+ */
+static inline zsl_real_t zsl_vec3_dist(const zsl_real_t *a,
+				       const zsl_real_t *b)
+{
+	zsl_real_t x = a[0] - b[0];
+	zsl_real_t y = a[1] - b[1];
+	zsl_real_t z = a[2] - b[2];
+
+	return ZSL_SQRT(x * x + y * y + z * z);
+}
+
+/**
+ * @brief Scales 3-vector 'a' to unit length, b = a / |a|, multiplying by
+ *        the reciprocal of the norm. 'b' may be 'a'.
+ *
+ * As with zsl_vec_to_unit, a zero vector gives b = (1, 0, 0).
+ *
+ * @param a     The input vector.
+ * @param b     The output vector.
+ *
+ * @return The norm of 'a', so callers needing both only make one pass.
+ */
+static inline zsl_real_t zsl_vec3_to_unit(const zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_real_t n = zsl_vec3_norm(a);
+	zsl_real_t s;
+
+	if (n == 0.0) {
+		b[0] = 1.0;
+		b[1] = 0.0;
+		b[2] = 0.0;
+		return n;
+	}
+
+	s = 1.0 / n;
+	b[0] = a[0] * s;
+	b[1] = a[1] * s;
+	b[2] = a[2] * s;
+
+	return n;
+}
+
+/**
+ * @brief Projects 3-vector 'v' onto 'u', w = u * (u . v) / (u . u). Both
+ *        dot products are formed in the same pass. 'w' may be 'u' or 'v'.
+ *
+ * @param u     The vector to project onto.
+ * @param v     The vector to project.
+ * @param w     The output vector.
+ */
+static inline void zsl_vec3_project(const zsl_real_t *u, const zsl_real_t *v,
+				    zsl_real_t *w)
+{
+	zsl_real_t p = u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+	zsl_real_t t = u[0] * u[0] + u[1] * u[1] + u[2] * u[2];
+	zsl_real_t s = p / t;
+
+	w[0] = u[0] * s;
+	w[1] = u[1] * s;
+	w[2] = u[2] * s;
+}
+
+/*
+ * Compile-time dimension matrix families.
+ *
+ * ZSL_MTX_DECLARE_OPS(m, n) declares 'struct zsl_mtxMxN', whose 'data'
+ * array holds the m * n entries in row-major order, along with these
+ * static inline functions, where 'T' is that struct:
+ *
+ *   void zsl_mtxMxN_init(T *a)                        a = 0
+ *   struct zsl_mtx zsl_mtxMxN_ref(T *a)               a as a struct zsl_mtx
+ *   void zsl_mtxMxN_add(const T *a, const T *b, T *c) c = a + b
+ *   void zsl_mtxMxN_sub(const T *a, const T *b, T *c) c = a - b
+ *   void zsl_mtxMxN_scalar_mult(T *a, zsl_real_t s)   a = a * s
+ *   void zsl_mtxMxN_mult_vec(const T *a, x[n], y[m])  y = a * x
+ *   void zsl_mtxMxN_mult_trans_vec(a, x[m], y[n])     y = a^T * x
+ *
+ * ZSL_MTX_DECLARE_TRANS(m, n) adds zsl_mtxMxN_trans(a, b), setting the
+ * N x M matrix b = a^T, and ZSL_MTX_DECLARE_MULT(m, p, n) adds
+ * zsl_mtxMxP_mult_PxN(a, b, c), setting the M x N matrix c = a * b. Both
+ * need the matrix types involved to be declared first.
+ *
+ * ZSL_MTX_DECLARE_SQUARE_OPS(n) adds, for a declared N x N type:
+ *
+ *   void zsl_mtxNxN_ident(T *a)                       a = I
+ *   int zsl_mtxNxN_cholesky(const T *a, T *l)         a = l * l^T
+ *   void zsl_mtxNxN_chol_solve(const T *l, b[n], x[n])
+ *   int zsl_mtxNxN_inv(const T *a, T *b)              b = a^-1, b may be a
+ *
+ * zsl_mtxNxN_cholesky returns -ENOTPOSDEF and zsl_mtxNxN_inv returns
+ * -ESINGULAR on failure, like their generic equivalents. Since the types
+ * carry their dimensions, mismatched sizes are compile errors, and no
+ * run-time bounds checks are needed.
+ *
+ * The dimensions must be integer literals, since they form part of the
+ * names, and each family can only be declared once per translation unit,
+ * for example in a shared header:
+ *
+ *   ZSL_MTX_DECLARE_OPS(6, 6)
+ *   ZSL_MTX_DECLARE_OPS(3, 6)
+ *   ZSL_MTX_DECLARE_SQUARE_OPS(6)
+ *   ZSL_MTX_DECLARE_MULT(3, 6, 6)
+ */
+#define ZSL_MTX_DECLARE_OPS(m, n) ZSL_MTX_DECLARE_OPS_(m, n)
+#define ZSL_MTX_DECLARE_TRANS(m, n) ZSL_MTX_DECLARE_TRANS_(m, n)
+#define ZSL_MTX_DECLARE_MULT(m, p, n) ZSL_MTX_DECLARE_MULT_(m, p, n)
+#define ZSL_MTX_DECLARE_SQUARE_OPS(n) ZSL_MTX_DECLARE_SQUARE_OPS_(n)
+
+/** @cond INTERNAL */
+#define ZSL_MTX_DECLARE_OPS_(m, n)					\
+	struct zsl_mtx ## m ## x ## n {					\
+		zsl_real_t data[(m) * (n)];				\
+	};								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _init(struct zsl_mtx ## m ## x ## n *a) \
+	{								\
+		for (size_t i = 0; i < (m) * (n); i++) {		\
+			a->data[i] = 0.0;				\
+		}							\
+	}								\
+	static inline struct zsl_mtx					\
+	zsl_mtx ## m ## x ## n ## _ref(struct zsl_mtx ## m ## x ## n *a) \
+	{								\
+		struct zsl_mtx r = {					\
+			.sz_rows = (m),					\
+			.sz_cols = (n),					\
+			.data = a->data					\
+		};							\
+		return r;						\
+	}								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _add(const struct zsl_mtx ## m ## x ## n *a, \
+				       const struct zsl_mtx ## m ## x ## n *b, \
+				       struct zsl_mtx ## m ## x ## n *c) \
+	{								\
+		for (size_t i = 0; i < (m) * (n); i++) {		\
+			c->data[i] = a->data[i] + b->data[i];		\
+		}							\
+	}								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _sub(const struct zsl_mtx ## m ## x ## n *a, \
+				       const struct zsl_mtx ## m ## x ## n *b, \
+				       struct zsl_mtx ## m ## x ## n *c) \
+	{								\
+		for (size_t i = 0; i < (m) * (n); i++) {		\
+			c->data[i] = a->data[i] - b->data[i];		\
+		}							\
+	}								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _scalar_mult(				\
+		struct zsl_mtx ## m ## x ## n *a, zsl_real_t s)		\
+	{								\
+		for (size_t i = 0; i < (m) * (n); i++) {		\
+			a->data[i] *= s;				\
+		}							\
+	}								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _mult_vec(				\
+		const struct zsl_mtx ## m ## x ## n *a,			\
+		const zsl_real_t x[n], zsl_real_t y[m])			\
+	{								\
+		zsl_mtx_fixed_mult_vec_mn(a->data, x, y, (m), (n));	\
+	}								\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _mult_trans_vec(			\
+		const struct zsl_mtx ## m ## x ## n *a,			\
+		const zsl_real_t x[m], zsl_real_t y[n])			\
+	{								\
+		zsl_mtx_fixed_mult_trans_vec_mn(a->data, x, y, (m), (n)); \
+	}
+
+#define ZSL_MTX_DECLARE_TRANS_(m, n)					\
+	static inline void						\
+	zsl_mtx ## m ## x ## n ## _trans(				\
+		const struct zsl_mtx ## m ## x ## n *a,			\
+		struct zsl_mtx ## n ## x ## m *b)			\
+	{								\
+		zsl_mtx_fixed_trans_mn(a->data, b->data, (m), (n));	\
+	}
+
+#define ZSL_MTX_DECLARE_MULT_(m, p, n)					\
+	static inline void						\
+	zsl_mtx ## m ## x ## p ## _mult_ ## p ## x ## n(		\
+		const struct zsl_mtx ## m ## x ## p *a,			\
+		const struct zsl_mtx ## p ## x ## n *b,			\
+		struct zsl_mtx ## m ## x ## n *c)			\
+	{								\
+		zsl_mtx_fixed_mult_mpn(a->data, b->data, c->data,	\
+				       (m), (p), (n));			\
+	}
+
+#define ZSL_MTX_DECLARE_SQUARE_OPS_(n)					\
+	static inline void						\
+	zsl_mtx ## n ## x ## n ## _ident(struct zsl_mtx ## n ## x ## n *a) \
+	{								\
+		for (size_t i = 0; i < (n) * (n); i++) {		\
+			a->data[i] = (i % ((n) + 1) == 0) ? 1.0 : 0.0;	\
+		}							\
+	}								\
+	static inline int						\
+	zsl_mtx ## n ## x ## n ## _cholesky(				\
+		const struct zsl_mtx ## n ## x ## n *a,			\
+		struct zsl_mtx ## n ## x ## n *l)			\
+	{								\
+		return zsl_mtx_fixed_cholesky(a->data, l->data, (n));	\
+	}								\
+	static inline void						\
+	zsl_mtx ## n ## x ## n ## _chol_solve(				\
+		const struct zsl_mtx ## n ## x ## n *l,			\
+		const zsl_real_t b[n], zsl_real_t x[n])			\
+	{								\
+		zsl_mtx_fixed_chol_solve(l->data, b, x, (n));		\
+	}								\
+	static inline int						\
+	zsl_mtx ## n ## x ## n ## _inv(					\
+		const struct zsl_mtx ## n ## x ## n *a,			\
+		struct zsl_mtx ## n ## x ## n *b)			\
+	{								\
+		struct zsl_mtx ## n ## x ## n t = *a;			\
+		return zsl_mtx_fixed_inv(t.data, b->data, (n));		\
+	}
+/** @endcond */
+
+#if CONFIG_ZSL_MATRIX_INLINE
+/*
+ * With CONFIG_ZSL_MATRIX_INLINE, zsl_mtx_add, zsl_mtx_sub, zsl_mtx_mult and
+ * zsl_mtx_trans are defined here, so that 3x3 inputs go straight to the
+ * kernels above at the call site. Other sizes are passed to the library
+ * versions, which dispatch the remaining fixed sizes themselves.
+ */
+int zsl_mtx_add_ool(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		    struct zsl_mtx *mc);
+int zsl_mtx_sub_ool(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		    struct zsl_mtx *mc);
+int zsl_mtx_mult_ool(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		     struct zsl_mtx *mc);
+int zsl_mtx_trans_ool(const struct zsl_mtx *ma, struct zsl_mtx *mb);
+
+/* True if 'm' is 3x3, and can be passed to the zsl_mtx33_* kernels. */
+static inline bool zsl_mtx_inline_33(const struct zsl_mtx *m)
+{
+	return (m->sz_rows == 3) && (m->sz_cols == 3);
+}
+
+static inline int zsl_mtx_add(const struct zsl_mtx *ma,
+			      const struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	if (zsl_mtx_inline_33(ma) && zsl_mtx_inline_33(mb) &&
+	    zsl_mtx_inline_33(mc)) {
+		zsl_mtx33_add(ma->data, mb->data, mc->data);
+		return 0;
+	}
+
+	return zsl_mtx_add_ool(ma, mb, mc);
+}
+
+static inline int zsl_mtx_sub(const struct zsl_mtx *ma,
+			      const struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	if (zsl_mtx_inline_33(ma) && zsl_mtx_inline_33(mb) &&
+	    zsl_mtx_inline_33(mc)) {
+		zsl_mtx33_sub(ma->data, mb->data, mc->data);
+		return 0;
+	}
+
+	return zsl_mtx_sub_ool(ma, mb, mc);
+}
+
+static inline int zsl_mtx_mult(const struct zsl_mtx *ma,
+			       const struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	if (zsl_mtx_inline_33(ma) && zsl_mtx_inline_33(mb) &&
+	    zsl_mtx_inline_33(mc)) {
+		zsl_mtx33_mult(ma->data, mb->data, mc->data);
+		return 0;
+	}
+
+	return zsl_mtx_mult_ool(ma, mb, mc);
+}
+
+static inline int zsl_mtx_trans(const struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	if (zsl_mtx_inline_33(ma) && zsl_mtx_inline_33(mb)) {
+		zsl_mtx33_trans(ma->data, mb->data);
+		return 0;
+	}
+
+	return zsl_mtx_trans_ool(ma, mb);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_MATRICES_FIXED_H_ */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_BATCH Batches
+ *
+ * @brief Multi-channel batches of samples, viewed as vectors and matrices.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for measurement batches in zscilib.
+ *
+ * A batch holds 2^srclen.samples samples of a sensor with one or more
+ * channels, such as the three axes of an accelerometer, as zsl_real_t
+ * values (ZSL_MES_BATCH_CTYPE). The payload is channel-major: all the
+ * samples of channel 0 come first, then all the samples of channel 1, and
+ * so on, so the number of channels is the payload length divided by the
+ * size of one sample of each channel.
+ *
+ * With this layout, each channel is a contiguous array and the whole
+ * batch is a row-major matrix with one row per channel, so a channel can
+ * be viewed as a zsl_vec, and the batch as a zsl_mtx, that point straight
+ * into the payload. Statistics and fusion code can then work on the
+ * samples without copying or parsing them.
+ */
+
+#ifndef ZSL_MEASUREMENT_BATCH_H__
+#define ZSL_MEASUREMENT_BATCH_H__
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The C type of batch payloads, which matches zsl_real_t. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_MES_BATCH_CTYPE     ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32
+#else
+#define ZSL_MES_BATCH_CTYPE     ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64
+#endif
+
+/**
+ * @brief Sets up a measurement as an empty batch. The filter, unit and
+ *        source fields of the header are left for the caller to set.
+ *
+ * @param mes       The measurement.
+ * @param buf       The payload buffer, which is zeroed.
+ * @param sz        The size of 'buf', in bytes.
+ * @param chans     The number of channels.
+ * @param samples   The log2 of the number of samples.
+ *
+ * @return 0 on success, -ENOMEM if 'buf' is too small, or -EINVAL if the
+ *         payload would be longer than UINT16_MAX bytes, or 'chans' is 0
+ *         or 'samples' is more than 15.
+ */
+int zsl_mes_batch_init(struct zsl_measurement *mes, zsl_real_t *buf,
+		       size_t sz, size_t chans, uint8_t samples);
+
+/**
+ * @brief Gets the number of channels of a batch.
+ *
+ * @param mes   The measurement.
+ *
+ * @return The number of channels, or 0 if the measurement is not a batch
+ *         of ZSL_MES_BATCH_CTYPE values.
+ */
+size_t zsl_mes_batch_chans(const struct zsl_measurement *mes);
+
+/**
+ * @brief Gets a vector view of one channel of a batch, which points into
+ *        the payload.
+ *
+ * @param mes   The measurement.
+ * @param ch    The channel.
+ * @param v     The vector, whose data is not copied.
+ *
+ * @return 0 on success, or -EINVAL if the measurement is not a batch or
+ *         has no channel 'ch'.
+ */
+int zsl_mes_batch_vec(const struct zsl_measurement *mes, size_t ch,
+		      struct zsl_vec *v);
+
+/**
+ * @brief Gets a matrix view of a batch, with one row per channel and one
+ *        column per sample, which points into the payload.
+ *
+ * @param mes   The measurement.
+ * @param m     The matrix, whose data is not copied.
+ *
+ * @return 0 on success, or -EINVAL if the measurement is not a batch.
+ */
+int zsl_mes_batch_mtx(const struct zsl_measurement *mes, struct zsl_mtx *m);
+
+/**
+ * @brief Writes one sample of every channel into a batch, for example one
+ *        x, y, z reading of an accelerometer.
+ *
+ * @param mes   The measurement.
+ * @param s     The index of the sample.
+ * @param v     The sample, with one element per channel.
+ *
+ * @return 0 on success, or -EINVAL if the measurement is not a batch, 's'
+ *         is out of range, or 'v' doesn't have one element per channel.
+ */
+int zsl_mes_batch_put(struct zsl_measurement *mes, size_t s,
+		      const struct zsl_vec *v);
+
+/**
+ * @brief Reads one sample of every channel from a batch.
+ *
+ * @param mes   The measurement.
+ * @param s     The index of the sample.
+ * @param v     The sample, with one element per channel.
+ *
+ * @return As for @ref zsl_mes_batch_put.
+ */
+int zsl_mes_batch_get(const struct zsl_measurement *mes, size_t s,
+		      struct zsl_vec *v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_BATCH_H__ */
+
+/** @} */ /* End of MES_BATCH group */
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_CBOR CBOR Payloads
+ *
+ * @brief CBOR (RFC 8949) encoding of measurement payloads.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for CBOR measurement payloads in zscilib.
+ *
+ * A measurement with a data format of ZSL_MES_FORMAT_CBOR has a payload
+ * that is a single CBOR array. If the header has a timestamp format, the
+ * first item is the timestamp, as an unsigned integer. It is followed by
+ * the 2^srclen.samples sample values, each encoded according to the
+ * header's C type:
+ *
+ *   - Signed and unsigned integers as the shortest CBOR integer.
+ *   - 32 and 64-bit floats, including the range types, as CBOR floats of
+ *     the same size.
+ *   - Booleans as CBOR true and false.
+ *
+ * Other C types are not supported. The decoder also accepts integers and
+ * half, single and double-precision floats for any floating-point C type,
+ * and any integer size that fits the C type, as other encoders may use the
+ * shortest form.
+ *
+ * The encoder and decoder work on a caller's fixed buffer, one sample at a
+ * time, so that samples can be added as they are read from a sensor, and
+ * don't allocate any memory.
+ */
+
+#ifndef ZSL_MEASUREMENT_CBOR_H__
+#define ZSL_MEASUREMENT_CBOR_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The state of a CBOR payload being encoded or decoded.
+ */
+struct zsl_mes_cbor {
+	/** @brief The payload buffer. */
+	uint8_t *buf;
+	/** @brief The size of 'buf' in bytes. */
+	size_t sz;
+	/** @brief The number of bytes written or read so far. */
+	size_t pos;
+	/** @brief The number of samples still to be written or read. */
+	size_t left;
+};
+
+/**
+ * @brief Starts encoding a CBOR payload into 'buf'. The array header, and
+ *        the timestamp if the header has a timestamp format, are written
+ *        straight away.
+ *
+ * @param c     The encoder state.
+ * @param hdr   The measurement header, which gives the sample count, C type
+ *              and timestamp format.
+ * @param ts    The timestamp, which is ignored if there is none.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ *
+ * @return 0 on success, -EINVAL if the C type is not supported, or -ENOMEM
+ *         if 'buf' is too small.
+ */
+int zsl_mes_cbor_enc_start(struct zsl_mes_cbor *c,
+			   const struct zsl_mes_header *hdr, uint64_t ts,
+			   uint8_t *buf, size_t sz);
+
+/**
+ * @brief Encodes the next sample.
+ *
+ * @param c     The encoder state.
+ * @param hdr   The header given to @ref zsl_mes_cbor_enc_start.
+ * @param val   The sample, in the C type given by the header.
+ *
+ * @return 0 on success, -EINVAL if all the samples have been written, or
+ *         -ENOMEM if the buffer is full. Nothing is written on error.
+ */
+int zsl_mes_cbor_enc_sample(struct zsl_mes_cbor *c,
+			    const struct zsl_mes_header *hdr, const void *val);
+
+/**
+ * @brief Finishes encoding a CBOR payload, and sets the payload length
+ *        and data format of 'hdr'.
+ *
+ * @param c     The encoder state.
+ * @param hdr   The header given to @ref zsl_mes_cbor_enc_start.
+ *
+ * @return 0 on success, or -EINVAL if samples are missing or the payload is
+ *         longer than UINT16_MAX bytes.
+ */
+int zsl_mes_cbor_enc_end(struct zsl_mes_cbor *c, struct zsl_mes_header *hdr);
+
+/**
+ * @brief Encodes the 2^srclen.samples raw values of a measurement as a CBOR
+ *        payload.
+ *
+ * @param mes   The measurement, with ZSL_MES_FORMAT_NONE.
+ * @param ts    The timestamp, which is ignored if there is none.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ * @param out   The output measurement, which gets the header of 'mes' with
+ *              the CBOR length and data format, and 'buf' as its payload.
+ *
+ * @return 0 on success, -EINVAL if the C type is not supported, or -ENOMEM
+ *         if 'buf' is too small.
+ */
+int zsl_mes_cbor_enc(const struct zsl_measurement *mes, uint64_t ts,
+		     uint8_t *buf, size_t sz, struct zsl_measurement *out);
+
+/**
+ * @brief Starts decoding the CBOR payload of a measurement, and reads the
+ *        timestamp if the header has a timestamp format.
+ *
+ * @param c     The decoder state.
+ * @param mes   The measurement, with ZSL_MES_FORMAT_CBOR.
+ * @param ts    Pointer to the output timestamp, or NULL. Set to 0 if there
+ *              is none.
+ *
+ * @return 0 on success, or -EINVAL if the C type is not supported or the
+ *         payload doesn't match the header.
+ */
+int zsl_mes_cbor_dec_start(struct zsl_mes_cbor *c,
+			   const struct zsl_measurement *mes, uint64_t *ts);
+
+/**
+ * @brief Decodes the next sample.
+ *
+ * @param c     The decoder state.
+ * @param hdr   The header of the measurement being decoded.
+ * @param val   The output sample, in the C type given by the header.
+ *
+ * @return 0 on success, or -EINVAL if there are no samples left, the
+ *         payload is malformed or the value doesn't fit the C type.
+ */
+int zsl_mes_cbor_dec_sample(struct zsl_mes_cbor *c,
+			    const struct zsl_mes_header *hdr, void *val);
+
+/**
+ * @brief Decodes all the samples of a CBOR payload into an array of raw
+ *        values.
+ *
+ * @param mes   The measurement, with ZSL_MES_FORMAT_CBOR.
+ * @param ts    Pointer to the output timestamp, or NULL.
+ * @param vals  The output values, in the C type given by the header.
+ * @param sz    The size of 'vals' in bytes.
+ *
+ * @return 0 on success, -ENOMEM if 'vals' is too small, or -EINVAL if the
+ *         payload can't be decoded.
+ */
+int zsl_mes_cbor_dec(const struct zsl_measurement *mes, uint64_t *ts,
+		     void *vals, size_t sz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_CBOR_H__ */
+
+/** @} */ /* End of MES_CBOR group */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_CONV Unit Conversion
+ *
+ * @brief Conversion of measurements between units and scales.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for measurement unit conversion in zscilib.
+ *
+ * A measurement value 'v' with unit 'si_unit' and scale 'scale_factor'
+ * stands for v * 10^scale_factor in 'si_unit'. Units that are a scaled or
+ * offset version of another unit, such as ZSL_MES_UNIT_SI_MILLIVOLTS or
+ * ZSL_MES_UNIT_SI_DEGREE_CELSIUS, are listed in a constant table with the
+ * power of ten and offset that relate them to their base unit, and powers
+ * of ten in the range of the SI prefixes come from a constant table rather
+ * than ZSL_POW. Two units can be converted when they have the same base
+ * unit, and the conversion is always y = x * mul + add, where 'mul' and
+ * 'add' are worked out once per conversion, not per value.
+ */
+
+#ifndef ZSL_MEASUREMENT_CONV_H__
+#define ZSL_MEASUREMENT_CONV_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets a power of ten, from a table between 10^-24 and 10^24.
+ *
+ * @param n     The exponent.
+ *
+ * @return 10^n.
+ */
+zsl_real_t zsl_mes_conv_pow10(int n);
+
+/**
+ * @brief Gets the factors to convert a value from one unit and scale to
+ *        another, as y = x * mul + add.
+ *
+ * @param from      The unit of the value, a member of zsl_mes_unit_si.
+ * @param fscale    The scale factor of the value.
+ * @param to        The unit to convert to.
+ * @param tscale    The scale factor to convert to.
+ * @param mul       The multiplier.
+ * @param add       The offset, which is 0 unless one of the units has an
+ *                  offset, such as degrees Celsius.
+ *
+ * @return 0 on success, or -EINVAL if the units can't be converted.
+ */
+int zsl_mes_conv_factor(uint16_t from, int8_t fscale, uint16_t to,
+			int8_t tscale, zsl_real_t *mul, zsl_real_t *add);
+
+/**
+ * @brief Reads the values of a measurement, converted to another unit and
+ *        scale, into an array of zsl_real_t.
+ *
+ * @param mes       The measurement, with any standard integer,
+ *                  floating-point or range C type.
+ * @param to        The unit to convert to.
+ * @param tscale    The scale factor to convert to.
+ * @param out       The output array.
+ * @param n         The number of elements in 'out'.
+ * @param cnt       The number of values written to 'out'.
+ *
+ * @return 0 on success, -EINVAL if the units can't be converted or the C
+ *         type is not supported, or -ENOMEM if 'out' is too small.
+ */
+int zsl_mes_conv_vals(const struct zsl_measurement *mes, uint16_t to,
+		      int8_t tscale, zsl_real_t *out, size_t n, size_t *cnt);
+
+/**
+ * @brief Converts the values of a measurement with a floating-point C
+ *        type to another unit and scale, in place, and updates its header.
+ *
+ * @param mes       The measurement.
+ * @param to        The unit to convert to.
+ * @param tscale    The scale factor to convert to.
+ *
+ * @return 0 on success, or -EINVAL if the units can't be converted or the
+ *         C type is not floating-point. 'mes' is unchanged on error.
+ */
+int zsl_mes_conv(struct zsl_measurement *mes, uint16_t to, int8_t tscale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_CONV_H__ */
+
+/** @} */ /* End of MES_CONV group */
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_FRAG Fragmentation
+ *
+ * @brief Fragmentation and reassembly of large measurement payloads.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for measurement fragmentation in zscilib.
+ *
+ * A measurement whose payload doesn't fit in one packet, such as a spectrum
+ * or a matrix, is sent as a series of fragments. Each fragment has a copy
+ * of the original header, with 'srclen.fragment' set to
+ * ZSL_MES_FRAGMENT_PARTIAL, or ZSL_MES_FRAGMENT_FINAL for the one holding
+ * the end of the payload. Its payload starts with the 16-bit little-endian
+ * offset of the data in the original payload (ZSL_MES_FRAG_OFF_LEN bytes),
+ * followed by the data, so fragments can be reassembled in any order and
+ * missing ones are noticed.
+ *
+ * The fragmenter doesn't copy anything: each fragment is returned as a
+ * header and two payload segments, the offset and a slice of the original
+ * payload, which can be sent with @ref zsl_mes_wire_write.
+ *
+ * The reassembler has a fixed pool of slots, declared with
+ * @ref ZSL_MES_REASM_DEF, one for each source ('srclen.sourceid') being
+ * reassembled at a time. A slot is taken when the first fragment from a
+ * source arrives, and the least recently used slot is given up if none
+ * are free. The fragments' data is copied into the slot's buffer, except
+ * when it is already there: a receiver that reads the header first, such
+ * as a UART driver, can ask @ref zsl_mes_reasm_dst where the data goes and
+ * read it straight into place.
+ */
+
+#ifndef ZSL_MEASUREMENT_FRAG_H__
+#define ZSL_MEASUREMENT_FRAG_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+#include <zsl/measurement/wire.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The size of the offset at the start of a fragment payload, in bytes. */
+#define ZSL_MES_FRAG_OFF_LEN    (2)
+
+/** The number of out-of-order runs of data each slot can track. */
+#define ZSL_MES_REASM_RUNS      (4)
+
+/**
+ * @brief Fragmenter state, which walks through the payload of a
+ *        measurement.
+ */
+struct zsl_mes_frag {
+	/** @brief The header of the measurement being fragmented. */
+	struct zsl_mes_header hdr;
+	/** @brief The payload of the measurement being fragmented. */
+	const uint8_t *data;
+	/** @brief The offset of the next fragment. */
+	uint16_t pos;
+	/** @brief The largest number of data bytes per fragment. */
+	uint16_t chunk;
+	/** @brief Whether the last fragment has been returned. */
+	bool done;
+	/** @brief The encoded offset of the last fragment. */
+	uint8_t off[ZSL_MES_FRAG_OFF_LEN];
+};
+
+/**
+ * @brief A reassembly slot.
+ */
+struct zsl_mes_reasm_slot {
+	/** @brief The header of the first fragment received. */
+	struct zsl_mes_header hdr;
+	/** @brief Whether the slot is in use. */
+	bool used;
+	/** @brief Whether the final fragment has been received. */
+	bool final;
+	/** @brief The length of the payload, once the final fragment is in. */
+	uint16_t total;
+	/** @brief The number of bytes received without a gap from offset 0. */
+	uint16_t next;
+	/** @brief The number of entries in 'runs'. */
+	uint8_t nruns;
+	/** @brief The start and end of each run received beyond a gap. */
+	uint16_t runs[ZSL_MES_REASM_RUNS][2];
+	/** @brief When the slot was last used, for eviction. */
+	uint32_t age;
+};
+
+/**
+ * @brief A reassembler and its slot pool.
+ */
+struct zsl_mes_reasm {
+	/** @brief The slots. */
+	struct zsl_mes_reasm_slot *slots;
+	/** @brief The number of slots. */
+	size_t n;
+	/** @brief The slot buffers, 'sz' bytes each. */
+	uint8_t *buf;
+	/** @brief The size of each slot's buffer, in bytes. */
+	size_t sz;
+	/** @brief A counter incremented for each fragment. */
+	uint32_t tick;
+};
+
+/**
+ * Macro to declare a reassembler with 'nslots' slots, each of which can
+ * hold a payload of up to 'len' bytes.
+ */
+#define ZSL_MES_REASM_DEF(name, nslots, len)				\
+	static struct zsl_mes_reasm_slot name ## _slots[nslots];	\
+	static uint8_t name ## _buf[(nslots) * (len)];			\
+	struct zsl_mes_reasm name = {					\
+		.slots = name ## _slots,				\
+		.n = nslots,						\
+		.buf = name ## _buf,					\
+		.sz = len,						\
+		.tick = 0						\
+	}
+
+/**
+ * @brief Starts fragmenting a measurement.
+ *
+ * @param f     The fragmenter state.
+ * @param mes   The measurement, which must not change until the last
+ *              fragment has been sent.
+ * @param mtu   The largest fragment payload, in bytes, including the
+ *              offset. Fragments are cut at a multiple of the C type size
+ *              where it is known, so each holds whole samples.
+ *
+ * @return 0 on success, or -EINVAL if 'mtu' is too small for a sample or
+ *         'mes' is already a fragment.
+ */
+int zsl_mes_frag_init(struct zsl_mes_frag *f,
+		      const struct zsl_measurement *mes, size_t mtu);
+
+/**
+ * @brief Gets the next fragment. A payload that fits in one fragment is
+ *        returned unchanged, as a single measurement with no offset.
+ *
+ * @param f     The fragmenter state.
+ * @param hdr   The output header.
+ * @param iov   Two output payload segments: the offset, which points into
+ *              'f' and is valid until the next call, and the data.
+ *
+ * @return 0 on success, or -ENODATA if all the fragments have been
+ *         returned.
+ */
+int zsl_mes_frag_next(struct zsl_mes_frag *f, struct zsl_mes_header *hdr,
+		      struct zsl_mes_iov *iov);
+
+/**
+ * @brief Gets where the data of a fragment belongs in its reassembly slot,
+ *        taking a slot for its source if needed, so the data can be
+ *        received into place before calling @ref zsl_mes_reasm_put.
+ *
+ * @param r     The reassembler.
+ * @param hdr   The fragment header, with the length of the data, which
+ *              excludes the offset.
+ * @param off   The offset of the data in the original payload.
+ *
+ * @return The destination, or NULL if the data doesn't fit in a slot.
+ */
+uint8_t *zsl_mes_reasm_dst(struct zsl_mes_reasm *r,
+			   const struct zsl_mes_header *hdr, uint16_t off);
+
+/**
+ * @brief Adds a fragment's data to its reassembly slot.
+ *
+ * @param r     The reassembler.
+ * @param hdr   The fragment header, with the length of the data, which
+ *              excludes the offset.
+ * @param off   The offset of the data in the original payload.
+ * @param data  The data, which is not copied if it is already at
+ *              @ref zsl_mes_reasm_dst.
+ * @param out   The reassembled measurement, when complete. Its payload is
+ *              in the slot, and is valid until the next fragment is added.
+ *
+ * A fragment whose type or unit doesn't match the earlier fragments from
+ * the same source replaces them, as the source has moved on to a new
+ * measurement.
+ *
+ * @return 0 if the measurement is complete, -EAGAIN if more fragments are
+ *         needed, -ENOMEM if the data doesn't fit in a slot or arrived in
+ *         too many out-of-order runs, or -EINVAL if the header is not a
+ *         fragment or the data goes past the end of the final fragment.
+ */
+int zsl_mes_reasm_put(struct zsl_mes_reasm *r,
+		      const struct zsl_mes_header *hdr, uint16_t off,
+		      const void *data, struct zsl_measurement *out);
+
+/**
+ * @brief Adds a received measurement, such as one decoded with
+ *        @ref zsl_mes_wire_dec, to the reassembler. Measurements that are
+ *        not fragments are returned as they are.
+ *
+ * @param r     The reassembler.
+ * @param mes   The measurement or fragment.
+ * @param out   The reassembled measurement, when complete.
+ *
+ * @return As for @ref zsl_mes_reasm_put, and -EINVAL if a fragment is
+ *         shorter than its offset.
+ */
+int zsl_mes_reasm_add(struct zsl_mes_reasm *r,
+		      const struct zsl_measurement *mes,
+		      struct zsl_measurement *out);
+
+/**
+ * @brief Drops the partly reassembled measurement from a source, if any,
+ *        for example after a timeout.
+ *
+ * @param r         The reassembler.
+ * @param sourceid  The source.
+ */
+void zsl_mes_reasm_drop(struct zsl_mes_reasm *r, uint8_t sourceid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_FRAG_H__ */
+
+/** @} */ /* End of MES_FRAG group */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_LOG Deferred Logging
+ *
+ * @brief Logging of measurements, formatted later or on the host.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for deferred measurement logging in zscilib.
+ *
+ * Formatting a measurement with @ref zsl_mes_print, particularly its
+ * floating-point values, is slow, and blocks the thread that produced it.
+ * Instead, @ref zsl_mes_log copies the header and payload into a ring
+ * buffer, declared with @ref ZSL_MES_LOG_DEF, in the wire format of
+ * @ref zsl_mes_wire_enc, which takes no more than two memcpy calls. The
+ * records are formatted later, for example by a low-priority thread
+ * calling @ref zsl_mes_log_print, or sent as they are with
+ * @ref zsl_mes_log_dump, as a binary stream that the host decodes with
+ * @ref zsl_mes_wire_dec.
+ *
+ * One thread may log while another reads the log without locking, as
+ * only the logging thread moves the head of the ring, and only the
+ * reading thread moves its tail. Several logging threads need a lock.
+ * Measurements that don't fit in the free space are dropped and counted,
+ * rather than blocking the caller.
+ */
+
+#ifndef ZSL_MEASUREMENT_LOG_H__
+#define ZSL_MEASUREMENT_LOG_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+#include <zsl/measurement/wire.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A measurement log.
+ */
+struct zsl_mes_log {
+	/** @brief The ring buffer. */
+	uint8_t *buf;
+	/** @brief The size of 'buf', a power of 2. */
+	size_t sz;
+	/** @brief The number of bytes ever written. */
+	volatile size_t head;
+	/** @brief The number of bytes ever read. */
+	volatile size_t tail;
+	/** @brief The number of measurements dropped for lack of space. */
+	uint32_t dropped;
+};
+
+/**
+ * Macro to declare a log with a ring buffer of 'len' bytes, which must be
+ * a power of 2.
+ */
+#define ZSL_MES_LOG_DEF(name, len)					\
+	static uint8_t name ## _buf[len];				\
+	struct zsl_mes_log name = {					\
+		.buf = name ## _buf,					\
+		.sz = len,						\
+		.head = 0,						\
+		.tail = 0,						\
+		.dropped = 0						\
+	}
+
+/**
+ * @brief Logs a measurement, without formatting it.
+ *
+ * @param l     The log.
+ * @param mes   The measurement, whose header and payload are copied.
+ *
+ * @return 0 on success, or -ENOMEM if the log doesn't have room for the
+ *         measurement, which is dropped.
+ */
+int zsl_mes_log(struct zsl_mes_log *l, const struct zsl_measurement *mes);
+
+/**
+ * @brief Takes the oldest measurement from the log.
+ *
+ * @param l     The log.
+ * @param rec   The buffer the record is copied to.
+ * @param sz    The size of 'rec', in bytes.
+ * @param mes   The measurement, whose payload points into 'rec'.
+ *
+ * @return 0 on success, -ENODATA if the log is empty, or -ENOMEM if 'rec'
+ *         is too small, in which case the record is skipped.
+ */
+int zsl_mes_log_pop(struct zsl_mes_log *l, uint8_t *rec, size_t sz,
+		    struct zsl_measurement *mes);
+
+/**
+ * @brief Takes every measurement from the log and prints it with
+ *        @ref zsl_mes_print.
+ *
+ * @param l     The log.
+ * @param rec   A buffer for one record, as in @ref zsl_mes_log_pop.
+ * @param sz    The size of 'rec', in bytes.
+ *
+ * @return The number of measurements printed.
+ */
+size_t zsl_mes_log_print(struct zsl_mes_log *l, uint8_t *rec, size_t sz);
+
+/**
+ * @brief Sends the raw contents of the log through 'fn', and empties it.
+ *        The output is a series of measurements in the wire format.
+ *
+ * @param l     The log.
+ * @param fn    The output function, which gets the data in place, in one
+ *              or two calls.
+ * @param arg   The argument passed to 'fn'.
+ *
+ * @return 0 on success, or the error returned by 'fn', in which case the
+ *         log is left unchanged.
+ */
+int zsl_mes_log_dump(struct zsl_mes_log *l, zsl_mes_wire_write_fn_t fn,
+		     void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_LOG_H__ */
+
+/** @} */ /* End of MES_LOG group */
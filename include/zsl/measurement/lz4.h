@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_LZ4 LZ4 Compression
+ *
+ * @brief LZ4 compression of measurement payloads.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for LZ4 measurement payloads in zscilib.
+ *
+ * Payloads are compressed into the LZ4 block format, which any LZ4
+ * decoder can read. Each payload is an independent block, so a lost packet
+ * doesn't prevent the following ones from being decompressed. The
+ * compressor is a single pass with a hash table of recent positions, which
+ * is the only memory it needs, and is declared up front with
+ * @ref ZSL_MES_LZ4_DEF. The decompressor needs no memory at all.
+ *
+ * Slowly varying sensor data compresses poorly as it is, as successive
+ * samples rarely repeat exactly. With ZSL_MES_COMPRESSION_LZ4_DELTA, each
+ * sample is first replaced by its difference from the previous one (or,
+ * for floating-point types, the XOR of their bits), which turns slow
+ * changes into runs of near-zero bytes that LZ4 matches well.
+ */
+
+#ifndef ZSL_MEASUREMENT_LZ4_H__
+#define ZSL_MEASUREMENT_LZ4_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The LZ4 compressor state.
+ */
+struct zsl_mes_lz4 {
+	/** @brief The hash table of recent positions. */
+	uint16_t *tbl;
+	/** @brief The log2 of the number of entries in 'tbl'. */
+	uint8_t bits;
+};
+
+/**
+ * Macro to declare an LZ4 compressor with a 2^'bits' entry hash table, from
+ * 8 to 16. More entries find more matches in longer payloads, and 10 bits
+ * (2 KiB) is enough for payloads up to a few KiB.
+ */
+#define ZSL_MES_LZ4_DEF(name, hbits)					\
+	static uint16_t name ## _tbl[1 << (hbits)];			\
+	struct zsl_mes_lz4 name = {					\
+		.tbl = name ## _tbl,					\
+		.bits = hbits						\
+	}
+
+/**
+ * @brief The worst-case compressed size of 'len' bytes.
+ */
+#define ZSL_MES_LZ4_BOUND(len)  ((len) + (len) / 255 + 16)
+
+/**
+ * @brief Compresses 'len' bytes into an LZ4 block.
+ *
+ * @param z     The compressor state.
+ * @param src   The input.
+ * @param len   The input length in bytes, up to UINT16_MAX.
+ * @param dst   The output buffer, which must not overlap 'src'.
+ * @param sz    The size of 'dst' in bytes. ZSL_MES_LZ4_BOUND(len) bytes
+ *              are always enough.
+ * @param out   Pointer to the compressed length.
+ *
+ * @return 0 on success, -EINVAL if 'len' is too long, or -ENOMEM if 'dst'
+ *         is too small.
+ */
+int zsl_mes_lz4_comp(struct zsl_mes_lz4 *z, const uint8_t *src, size_t len,
+		     uint8_t *dst, size_t sz, size_t *out);
+
+/**
+ * @brief Decompresses an LZ4 block.
+ *
+ * @param src   The compressed block.
+ * @param len   The length of the block in bytes.
+ * @param dst   The output buffer, which must not overlap 'src'.
+ * @param sz    The size of 'dst' in bytes.
+ * @param out   Pointer to the decompressed length.
+ *
+ * @return 0 on success, -ENOMEM if 'dst' is too small, or -EINVAL if the
+ *         block is malformed.
+ */
+int zsl_mes_lz4_decomp(const uint8_t *src, size_t len, uint8_t *dst,
+		       size_t sz, size_t *out);
+
+/**
+ * @brief Delta-encodes the samples of a payload in place, as described
+ *        above.
+ *
+ * @param ctype The C type of the samples.
+ * @param data  The payload.
+ * @param len   The payload length in bytes.
+ *
+ * @return 0 on success, or -EINVAL if the C type is not supported or 'len'
+ *         is not a whole number of samples.
+ */
+int zsl_mes_lz4_delta(uint8_t ctype, void *data, size_t len);
+
+/**
+ * @brief Reverses @ref zsl_mes_lz4_delta in place.
+ *
+ * @param ctype The C type of the samples.
+ * @param data  The payload.
+ * @param len   The payload length in bytes.
+ *
+ * @return 0 on success, or -EINVAL if the C type is not supported or 'len'
+ *         is not a whole number of samples.
+ */
+int zsl_mes_lz4_undelta(uint8_t ctype, void *data, size_t len);
+
+/**
+ * @brief Compresses the payload of a measurement.
+ *
+ * @param z     The compressor state.
+ * @param mes   The measurement. With delta encoding, its payload is
+ *              modified during the call, and restored before it returns.
+ * @param delta Whether to delta-encode the samples first.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ * @param out   The output measurement, which gets the header of 'mes' with
+ *              the compressed length and compression algorithm, and 'buf'
+ *              as its payload.
+ *
+ * @return 0 on success, -EINVAL if 'mes' is already compressed or its C
+ *         type doesn't support delta encoding, or -ENOMEM if 'buf' is too
+ *         small.
+ */
+int zsl_mes_lz4_enc(struct zsl_mes_lz4 *z, struct zsl_measurement *mes,
+		    bool delta, uint8_t *buf, size_t sz,
+		    struct zsl_measurement *out);
+
+/**
+ * @brief Decompresses the payload of a measurement compressed with
+ *        @ref zsl_mes_lz4_enc.
+ *
+ * @param mes   The compressed measurement.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ * @param out   The output measurement, which gets the header of 'mes' with
+ *              the decompressed length and no compression, and 'buf' as its
+ *              payload.
+ *
+ * @return 0 on success, -ENOMEM if 'buf' is too small, or -EINVAL if the
+ *         payload is not LZ4 compressed or is malformed.
+ */
+int zsl_mes_lz4_dec(const struct zsl_measurement *mes, uint8_t *buf,
+		    size_t sz, struct zsl_measurement *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_LZ4_H__ */
+
+/** @} */ /* End of MES_LZ4 group */
@@ -176,6 +176,8 @@ enum zsl_mes_compression {
 	ZSL_MES_COMPRESSION_NONE        = 0,
 	/** LZ4 compression. */
 	ZSL_MES_COMPRESSION_LZ4         = 1,
+	/** LZ4 compression of delta-encoded samples. */
+	ZSL_MES_COMPRESSION_LZ4_DELTA   = 2,
 };
 
 /** Packet fragments. */
@@ -217,6 +219,15 @@ enum zsl_mes_timestamp {
  *  @{
  */
 
+/**
+ * @brief Gets the size of one value of a C type.
+ *
+ * @param ctype The C type, a member of zsl_mes_unit_ctype.
+ *
+ * @return The size in bytes, or 0 for undefined and user-defined types.
+ */
+size_t zsl_mes_ctype_size(uint8_t ctype);
+
 /**
  * @brief Helper function to display the contents of the zsl_measurement.
  *
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_ROUTE Routing
+ *
+ * @brief Dispatch of measurements to subscribers by filter bits.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for measurement routing in zscilib.
+ *
+ * Subscribers ask for the measurements whose 'filter_bits', masked with
+ * a subscriber-defined mask, equal a given value, for example all the
+ * measurements with a given base type, or a given base and extended type.
+ * Subscriptions are kept in a hash table, declared with
+ * @ref ZSL_MES_ROUTE_DEF, keyed on the mask and the masked value, with all
+ * the subscribers of the same key chained together. Routing a measurement
+ * takes one hash lookup for each distinct mask in use, which is usually
+ * one to three, however many subscribers there are.
+ */
+
+#ifndef ZSL_MEASUREMENT_ROUTE_H__
+#define ZSL_MEASUREMENT_ROUTE_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The number of distinct masks a routing table can use. */
+#define ZSL_MES_ROUTE_MASKS     (4)
+
+/**
+ * @brief Function called with a measurement that matches a subscription.
+ *
+ * @param mes   The measurement.
+ * @param arg   The argument given when subscribing.
+ */
+typedef void (*zsl_mes_route_fn_t)(const struct zsl_measurement *mes,
+				   void *arg);
+
+/**
+ * @brief A subscription.
+ */
+struct zsl_mes_route_sub {
+	/** @brief The mask applied to 'filter_bits'. */
+	uint32_t mask;
+	/** @brief The value of the masked 'filter_bits'. */
+	uint32_t key;
+	/** @brief The function to call. */
+	zsl_mes_route_fn_t fn;
+	/** @brief The argument to pass to 'fn'. */
+	void *arg;
+	/** @brief The next subscription with the same key, plus 1, or 0. */
+	uint16_t next;
+};
+
+/**
+ * @brief A routing table.
+ */
+struct zsl_mes_route {
+	/** @brief The subscriptions. */
+	struct zsl_mes_route_sub *subs;
+	/** @brief The number of entries in 'subs'. */
+	size_t n;
+	/** @brief The number of subscriptions. */
+	size_t count;
+	/**
+	 * @brief The hash table, of 2^bits entries, each of which holds the
+	 * index plus 1 of the first subscription with a key, or 0.
+	 */
+	uint16_t *tbl;
+	/** @brief The log2 of the hash table size. */
+	uint8_t bits;
+	/** @brief The number of keys in the hash table. */
+	size_t nkeys;
+	/** @brief The distinct masks in use. */
+	uint32_t masks[ZSL_MES_ROUTE_MASKS];
+	/** @brief The number of entries in 'masks'. */
+	uint8_t nmasks;
+};
+
+/**
+ * Macro to declare a routing table with room for 'nsubs' subscriptions,
+ * and a hash table of 2^hbits entries, which must be more than the number
+ * of distinct keys.
+ */
+#define ZSL_MES_ROUTE_DEF(name, nsubs, hbits)				\
+	static struct zsl_mes_route_sub name ## _subs[nsubs];		\
+	static uint16_t name ## _tbl[1 << (hbits)];			\
+	struct zsl_mes_route name = {					\
+		.subs = name ## _subs,					\
+		.n = nsubs,						\
+		.count = 0,						\
+		.tbl = name ## _tbl,					\
+		.bits = hbits,						\
+		.nkeys = 0,						\
+		.nmasks = 0						\
+	}
+
+/**
+ * @brief Builds a value of 'filter_bits' from its fields, to be used as a
+ *        subscription mask or value.
+ *
+ * @param base_type     The base type, or 0xFF in a mask.
+ * @param ext_type      The extended type, or 0xFF in a mask.
+ * @param flags_bits    The flags.
+ *
+ * @return The 'filter_bits' value.
+ */
+static inline uint32_t
+zsl_mes_route_bits(uint8_t base_type, uint8_t ext_type, uint16_t flags_bits)
+{
+	struct zsl_mes_header hdr;
+
+	hdr.filter_bits = 0;
+	hdr.filter.base_type = base_type;
+	hdr.filter.ext_type = ext_type;
+	hdr.filter.flags_bits = flags_bits;
+
+	return hdr.filter_bits;
+}
+
+/**
+ * @brief Subscribes to the measurements for which
+ *        (filter_bits & mask) == (value & mask). Subscribers with the same
+ *        mask and value are called in the order they subscribed.
+ *
+ * @param r     The routing table.
+ * @param mask  The mask.
+ * @param value The value.
+ * @param fn    The function to call.
+ * @param arg   The argument to pass to 'fn'.
+ *
+ * @return 0 on success, or -ENOMEM if the table is full or already uses
+ *         ZSL_MES_ROUTE_MASKS other masks.
+ */
+int zsl_mes_route_sub(struct zsl_mes_route *r, uint32_t mask, uint32_t value,
+		      zsl_mes_route_fn_t fn, void *arg);
+
+/**
+ * @brief Calls the subscribers that match a measurement.
+ *
+ * @param r     The routing table.
+ * @param mes   The measurement.
+ *
+ * @return The number of subscribers called.
+ */
+size_t zsl_mes_route(const struct zsl_mes_route *r,
+		     const struct zsl_measurement *mes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_ROUTE_H__ */
+
+/** @} */ /* End of MES_ROUTE group */
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_STORE Time-Series Store
+ *
+ * @brief Fixed-capacity store of timestamped measurements.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for the measurement time-series store in zscilib.
+ *
+ * The store is a ring buffer of measurements, declared with
+ * @ref ZSL_MES_STORE_DEF, for example to hold readings while a device is
+ * offline until they can be forwarded. Each entry holds a copy of the
+ * header and payload of a measurement, and its timestamp, in whichever of
+ * the zsl_mes_timestamp formats the application uses. Once the store is
+ * full, each new measurement replaces the oldest one.
+ *
+ * Timestamps must not decrease from one measurement to the next, so the
+ * entries are always sorted, and a timestamp is found with a binary search
+ * in O(log n) time. Entries are addressed by their index, 0 being the
+ * oldest, and a range of timestamps can be read with an iterator, which
+ * can downsample the range by returning one entry per interval.
+ *
+ * When CONFIG_FLASH is enabled, the store can be saved to and loaded from
+ * a flash partition, to survive a reset.
+ */
+
+#ifndef ZSL_MEASUREMENT_STORE_H__
+#define ZSL_MEASUREMENT_STORE_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef CONFIG_FLASH
+#include <drivers/flash.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A store entry.
+ */
+struct zsl_mes_store_entry {
+	/** @brief The measurement header. */
+	struct zsl_mes_header hdr;
+	/** @brief The timestamp. */
+	uint64_t ts;
+};
+
+/**
+ * @brief A time-series store.
+ */
+struct zsl_mes_store {
+	/** @brief The entries, as a ring buffer. */
+	struct zsl_mes_store_entry *ent;
+	/** @brief The payloads, 'vlen' bytes for each entry. */
+	uint8_t *buf;
+	/** @brief The number of entries the store can hold. */
+	size_t n;
+	/** @brief The largest payload of an entry, in bytes. */
+	size_t vlen;
+	/** @brief The position of the oldest entry in 'ent'. */
+	size_t head;
+	/** @brief The number of entries held. */
+	size_t count;
+};
+
+/**
+ * @brief An iterator over a range of timestamps in a store.
+ */
+struct zsl_mes_store_iter {
+	/** @brief The store. */
+	const struct zsl_mes_store *s;
+	/** @brief The index of the next entry. */
+	size_t idx;
+	/** @brief The index after the last entry in the range. */
+	size_t end;
+	/** @brief The downsampling interval, or 0 to return every entry. */
+	uint64_t ivl;
+};
+
+/**
+ * Macro to declare a store with room for 'cap' measurements, each with a
+ * payload of up to 'len' bytes.
+ */
+#define ZSL_MES_STORE_DEF(name, cap, len)				\
+	static struct zsl_mes_store_entry name ## _ent[cap];		\
+	static uint8_t name ## _buf[(cap) * (len)];			\
+	struct zsl_mes_store name = {					\
+		.ent = name ## _ent,					\
+		.buf = name ## _buf,					\
+		.n = cap,						\
+		.vlen = len,						\
+		.head = 0,						\
+		.count = 0						\
+	}
+
+/**
+ * @brief Adds a measurement to the store, replacing the oldest one if the
+ *        store is full.
+ *
+ * @param s     The store.
+ * @param mes   The measurement, whose header and payload are copied.
+ * @param ts    The timestamp, which must not be earlier than that of the
+ *              last measurement added.
+ *
+ * @return 0 on success, -ENOMEM if the payload is larger than the entries
+ *         of the store, or -EINVAL if the timestamp is out of order.
+ */
+int zsl_mes_store_add(struct zsl_mes_store *s,
+		      const struct zsl_measurement *mes, uint64_t ts);
+
+/**
+ * @brief Finds the first entry with a timestamp at or after 'ts'.
+ *
+ * @param s     The store.
+ * @param ts    The timestamp.
+ *
+ * @return The index of the entry, or the number of entries if all of them
+ *         are earlier than 'ts'.
+ */
+size_t zsl_mes_store_find(const struct zsl_mes_store *s, uint64_t ts);
+
+/**
+ * @brief Gets an entry from the store.
+ *
+ * @param s     The store.
+ * @param idx   The index of the entry, 0 being the oldest.
+ * @param mes   The measurement, whose payload points into the store and is
+ *              valid until the entry is replaced or dropped.
+ * @param ts    The timestamp of the entry, if not NULL.
+ *
+ * @return 0 on success, or -EINVAL if there is no entry at 'idx'.
+ */
+int zsl_mes_store_get(const struct zsl_mes_store *s, size_t idx,
+		      struct zsl_measurement *mes, uint64_t *ts);
+
+/**
+ * @brief Drops the oldest entries, for example once they have been
+ *        forwarded.
+ *
+ * @param s     The store.
+ * @param n     The number of entries to drop. If this is more than the
+ *              number held, the store is emptied.
+ */
+void zsl_mes_store_drop(struct zsl_mes_store *s, size_t n);
+
+/**
+ * @brief Starts iterating over the entries with a timestamp from 't0' to
+ *        't1', inclusive.
+ *
+ * Entries must not be added or dropped while iterating, as this changes
+ * their indices.
+ *
+ * @param it    The iterator.
+ * @param s     The store.
+ * @param t0    The first timestamp.
+ * @param t1    The last timestamp.
+ * @param ivl   The downsampling interval. After an entry with timestamp
+ *              't' is returned, the next one is the first at or after
+ *              't' + 'ivl'. 0 returns every entry.
+ */
+void zsl_mes_store_iter_init(struct zsl_mes_store_iter *it,
+			     const struct zsl_mes_store *s, uint64_t t0,
+			     uint64_t t1, uint64_t ivl);
+
+/**
+ * @brief Gets the next entry in the range of an iterator.
+ *
+ * @param it    The iterator.
+ * @param mes   The measurement, as in @ref zsl_mes_store_get.
+ * @param ts    The timestamp of the entry, if not NULL.
+ *
+ * @return 0 on success, or -ENODATA at the end of the range.
+ */
+int zsl_mes_store_iter_next(struct zsl_mes_store_iter *it,
+			    struct zsl_measurement *mes, uint64_t *ts);
+
+#ifdef CONFIG_FLASH
+/**
+ * @brief Erases a flash region and saves the store to it.
+ *
+ * The region starts with a 32-byte header, followed by the entries and the
+ * payloads, so the payload size of the store must be a multiple of the
+ * flash write block size.
+ *
+ * @param s     The store.
+ * @param dev   The flash device.
+ * @param off   The offset of the region, which must be at the start of a
+ *              flash page.
+ * @param sz    The size of the region, which must be a whole number of
+ *              flash pages.
+ *
+ * @return 0 on success, -ENOMEM if the store doesn't fit in the region, or
+ *         the error returned by the flash driver.
+ */
+int zsl_mes_store_save(const struct zsl_mes_store *s,
+		       const struct device *dev, off_t off, size_t sz);
+
+/**
+ * @brief Loads a store saved with @ref zsl_mes_store_save.
+ *
+ * @param s     The store, which must have the same size as the one saved.
+ * @param dev   The flash device.
+ * @param off   The offset of the region.
+ *
+ * @return 0 on success, -ENODATA if no store was saved at 'off', -EINVAL
+ *         if the saved store has a different size, or the error returned
+ *         by the flash driver. 's' is unchanged if no store of the
+ *         same size was found, and is left empty if reading it failed.
+ */
+int zsl_mes_store_load(struct zsl_mes_store *s, const struct device *dev,
+		       off_t off);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_STORE_H__ */
+
+/** @} */ /* End of MES_STORE group */
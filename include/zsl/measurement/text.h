@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_TEXT Text Encodings
+ *
+ * @brief BASE64 and BASE45 encoding of measurement payloads.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for text-encoded measurement payloads in zscilib.
+ *
+ * Payloads can be encoded as BASE64 (RFC 4648, standard alphabet with '='
+ * padding) or BASE45 (RFC 9285) text, which can be sent over links that
+ * only carry printable characters, such as modem AT commands. BASE45 is
+ * slightly larger than BASE64, but only uses characters that are allowed
+ * in QR code alphanumeric mode.
+ *
+ * The encoders and decoders can convert a buffer in place, as long as it
+ * is large enough for the encoded text. Encoding works from the end of the
+ * buffer to the start and decoding from the start to the end, so that no
+ * input is overwritten before it has been read. Decoding looks up each
+ * group of characters in a table in which every valid character has bit 6
+ * set, so a whole group is checked with a single test.
+ */
+
+#ifndef ZSL_MEASUREMENT_TEXT_H__
+#define ZSL_MEASUREMENT_TEXT_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The BASE64 length of 'n' bytes, including padding. */
+#define ZSL_MES_B64_LEN(n)      (4 * (((n) + 2) / 3))
+
+/** The BASE45 length of 'n' bytes. */
+#define ZSL_MES_B45_LEN(n)      (3 * ((n) / 2) + 2 * ((n) % 2))
+
+/**
+ * @brief Encodes 'len' bytes as BASE64.
+ *
+ * @param src   The input.
+ * @param len   The input length in bytes.
+ * @param dst   The output, which may be 'src' to encode in place, but must
+ *              not otherwise overlap it.
+ * @param sz    The size of 'dst' in bytes, at least ZSL_MES_B64_LEN(len).
+ * @param out   Pointer to the number of characters written.
+ *
+ * @return 0 on success, or -ENOMEM if 'dst' is too small.
+ */
+int zsl_mes_b64_enc(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		    size_t *out);
+
+/**
+ * @brief Decodes BASE64 text. The padding is optional.
+ *
+ * @param src   The input.
+ * @param len   The input length in characters.
+ * @param dst   The output, which may be 'src' to decode in place, but must
+ *              not otherwise overlap it.
+ * @param sz    The size of 'dst' in bytes.
+ * @param out   Pointer to the number of bytes written.
+ *
+ * @return 0 on success, -ENOMEM if 'dst' is too small, or -EINVAL if the
+ *         text is not valid BASE64.
+ */
+int zsl_mes_b64_dec(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		    size_t *out);
+
+/**
+ * @brief Encodes 'len' bytes as BASE45.
+ *
+ * @param src   The input.
+ * @param len   The input length in bytes.
+ * @param dst   The output, which may be 'src' to encode in place, but must
+ *              not otherwise overlap it.
+ * @param sz    The size of 'dst' in bytes, at least ZSL_MES_B45_LEN(len).
+ * @param out   Pointer to the number of characters written.
+ *
+ * @return 0 on success, or -ENOMEM if 'dst' is too small.
+ */
+int zsl_mes_b45_enc(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		    size_t *out);
+
+/**
+ * @brief Decodes BASE45 text.
+ *
+ * @param src   The input.
+ * @param len   The input length in characters.
+ * @param dst   The output, which may be 'src' to decode in place, but must
+ *              not otherwise overlap it.
+ * @param sz    The size of 'dst' in bytes.
+ * @param out   Pointer to the number of bytes written.
+ *
+ * @return 0 on success, -ENOMEM if 'dst' is too small, or -EINVAL if the
+ *         text is not valid BASE45.
+ */
+int zsl_mes_b45_dec(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		    size_t *out);
+
+/**
+ * @brief Encodes the payload of a measurement in place, and sets the
+ *        payload length and encoding of its header.
+ *
+ * @param mes   The measurement, with no encoding.
+ * @param enc   The encoding, ZSL_MES_ENCODING_BASE64 or
+ *              ZSL_MES_ENCODING_BASE45.
+ * @param sz    The size of the buffer that holds the payload, in bytes.
+ *
+ * @return 0 on success, -EINVAL if the measurement is already encoded or
+ *         'enc' is not supported, or -ENOMEM if the buffer is too small or
+ *         the encoded payload is longer than UINT16_MAX characters.
+ */
+int zsl_mes_text_enc(struct zsl_measurement *mes, uint8_t enc, size_t sz);
+
+/**
+ * @brief Decodes the payload of a measurement in place, and sets the
+ *        payload length and encoding of its header. Measurements with no
+ *        encoding are left as they are.
+ *
+ * @param mes   The measurement.
+ *
+ * @return 0 on success, or -EINVAL if the encoding is not supported or the
+ *         payload is not valid.
+ */
+int zsl_mes_text_dec(struct zsl_measurement *mes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_TEXT_H__ */
+
+/** @} */ /* End of MES_TEXT group */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup MES_WIRE Wire Format
+ *
+ * @brief Binary encoding of measurements for transport and storage.
+ *
+ * @ingroup MEASUREMENT
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for the measurement wire format in zscilib.
+ *
+ * A measurement is sent as its ZSL_MES_WIRE_HDR_LEN byte header followed by
+ * 'srclen.len' bytes of payload. The header is always sent little-endian,
+ * one word after the other, regardless of the host byte order or how the
+ * compiler lays out the bit-fields of @ref zsl_mes_header:
+ *
+ *   - 0: base_type, 1: ext_type, 2..3: flags_bits
+ *   - 4..5: si_unit, 6: ctype, 7: scale_factor
+ *   - 8..9: len, 10: fragment (bits 0..1) and samples (bits 4..7),
+ *     11: sourceid
+ *
+ * The encoders write straight into the caller's buffer, and the payload can
+ * be given as a list of segments (@ref zsl_mes_iov), so a header and data
+ * held in several places are sent without first being gathered into a
+ * temporary copy. The decoder doesn't copy the payload either, and points
+ * the decoded measurement at the payload in the receive buffer.
+ */
+
+#ifndef ZSL_MEASUREMENT_WIRE_H__
+#define ZSL_MEASUREMENT_WIRE_H__
+
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+#ifdef CONFIG_NET_BUF
+#include <net/buf.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The size of an encoded measurement header in bytes. */
+#define ZSL_MES_WIRE_HDR_LEN    (12)
+
+/**
+ * @brief A segment of a measurement payload.
+ */
+struct zsl_mes_iov {
+	/** @brief The start of the segment. */
+	const void *base;
+	/** @brief The segment length in bytes. */
+	size_t len;
+};
+
+/**
+ * @brief Function that appends 'len' bytes to a caller-defined output, such
+ *        as a ring buffer or a UART FIFO.
+ *
+ * @param data  The bytes to append.
+ * @param len   The number of bytes.
+ * @param arg   The argument given to @ref zsl_mes_wire_write.
+ *
+ * @return 0 on success, or a negative error code, which is passed back to
+ *         the caller.
+ */
+typedef int (*zsl_mes_wire_write_fn_t)(const void *data, size_t len,
+				       void *arg);
+
+/**
+ * @brief Packs a measurement header into its wire layout.
+ *
+ * @param hdr   The header.
+ * @param buf   The output, of at least ZSL_MES_WIRE_HDR_LEN bytes.
+ */
+void zsl_mes_wire_hdr_pack(const struct zsl_mes_header *hdr, uint8_t *buf);
+
+/**
+ * @brief Unpacks a measurement header from its wire layout.
+ *
+ * @param buf   The input, of at least ZSL_MES_WIRE_HDR_LEN bytes.
+ * @param hdr   The output header.
+ */
+void zsl_mes_wire_hdr_unpack(const uint8_t *buf, struct zsl_mes_header *hdr);
+
+/**
+ * @brief Encodes a measurement and its 'header.srclen.len' byte payload.
+ *
+ * @param mes   The measurement.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ * @param len   Pointer to the number of bytes written.
+ *
+ * @return 0 on success, or -ENOMEM if 'buf' is too small, in which case
+ *         nothing is written.
+ */
+int zsl_mes_wire_enc(const struct zsl_measurement *mes, uint8_t *buf,
+		     size_t sz, size_t *len);
+
+/**
+ * @brief Encodes a measurement header and a payload made of 'n' segments.
+ *        The length in the encoded header is the sum of the segment lengths,
+ *        and 'hdr->srclen.len' is ignored.
+ *
+ * @param hdr   The header.
+ * @param iov   The payload segments.
+ * @param n     The number of segments.
+ * @param buf   The output buffer.
+ * @param sz    The size of 'buf' in bytes.
+ * @param len   Pointer to the number of bytes written.
+ *
+ * @return 0 on success, -EINVAL if the payload is longer than UINT16_MAX
+ *         bytes, or -ENOMEM if 'buf' is too small. Nothing is written on
+ *         error.
+ */
+int zsl_mes_wire_encv(const struct zsl_mes_header *hdr,
+		      const struct zsl_mes_iov *iov, size_t n, uint8_t *buf,
+		      size_t sz, size_t *len);
+
+/**
+ * @brief Sends a measurement header and a payload made of 'n' segments
+ *        through 'fn', as in @ref zsl_mes_wire_encv. 'fn' is called once
+ *        for the header and once for each non-empty segment, which it gets
+ *        in place.
+ *
+ * @param hdr   The header.
+ * @param iov   The payload segments.
+ * @param n     The number of segments.
+ * @param fn    The output function.
+ * @param arg   The argument passed to 'fn'.
+ *
+ * @return 0 on success, -EINVAL if the payload is longer than UINT16_MAX
+ *         bytes, or the first error returned by 'fn'.
+ */
+int zsl_mes_wire_write(const struct zsl_mes_header *hdr,
+		       const struct zsl_mes_iov *iov, size_t n,
+		       zsl_mes_wire_write_fn_t fn, void *arg);
+
+#ifdef CONFIG_NET_BUF
+/**
+ * @brief Appends a measurement header and a payload made of 'n' segments to
+ *        a net_buf, as in @ref zsl_mes_wire_encv.
+ *
+ * @param hdr   The header.
+ * @param iov   The payload segments.
+ * @param n     The number of segments.
+ * @param nb    The net_buf.
+ *
+ * @return 0 on success, -EINVAL if the payload is longer than UINT16_MAX
+ *         bytes, or -ENOMEM if 'nb' doesn't have enough tailroom. Nothing
+ *         is appended on error.
+ */
+int zsl_mes_wire_net_buf(const struct zsl_mes_header *hdr,
+			 const struct zsl_mes_iov *iov, size_t n,
+			 struct net_buf *nb);
+#endif
+
+/**
+ * @brief Decodes the measurement at the start of 'buf'. The payload is not
+ *        copied, and 'mes->payload' points into 'buf'.
+ *
+ * @param buf   The input buffer.
+ * @param sz    The number of bytes in 'buf'.
+ * @param mes   The output measurement.
+ * @param len   Pointer to the number of bytes used, which is the offset of
+ *              the next measurement in a stream.
+ *
+ * @return 0 on success, -EINVAL if a reserved field is not 0, or -ENOMEM if
+ *         'buf' ends before the end of the payload. 'mes' is not changed on
+ *         error.
+ */
+int zsl_mes_wire_dec(uint8_t *buf, size_t sz, struct zsl_measurement *mes,
+		     size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZSL_MEASUREMENT_WIRE_H__ */
+
+/** @} */ /* End of MES_WIRE group */
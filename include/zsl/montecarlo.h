@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup MONTECARLO Monte Carlo Uncertainty Propagation
+ *
+ * @brief Propagating input uncertainties through a model by random sampling.
+ *
+ * A model, such as a physics formula or a colorimetry conversion, is
+ * described as a function of one or more inputs, each with a probability
+ * distribution. @ref zsl_mc_run draws samples of every input from a
+ * seeded @ref zsl_rand generator, evaluates the model on them, and adds
+ * each result to a @ref zsl_sta_stream, whose mean and standard deviation
+ * are then the estimate and the standard uncertainty of the output, as in
+ * JCGM 101 (GUM Supplement 1).
+ *
+ * The samples are drawn and evaluated in batches of ZSL_MC_BATCH, with one
+ * vector per input, so the model is called once per batch rather than once
+ * per sample, and can process each batch with the vector functions. The
+ * work is divided into ZSL_MC_PARTS parts, each with its own generator
+ * stream, which run on the worker pool when CONFIG_ZSL_SMP is enabled. The
+ * results are the same however the parts are divided between threads.
+ */
+
+/**
+ * @file
+ * @brief API header file for Monte Carlo uncertainty propagation in zscilib.
+ *
+ * This file contains the zscilib Monte Carlo APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_MONTECARLO_H_
+#define ZEPHYR_INCLUDE_ZSL_MONTECARLO_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/statistics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MC_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for Monte Carlo uncertainty propagation.
+ *
+ * @ingroup MONTECARLO
+ *  @{ */
+
+/** The number of samples drawn and evaluated together. */
+#ifndef ZSL_MC_BATCH
+#define ZSL_MC_BATCH            (16)
+#endif
+
+/** The largest number of inputs a model can have. */
+#ifndef ZSL_MC_MAX_INPUTS
+#define ZSL_MC_MAX_INPUTS       (8)
+#endif
+
+/**
+ * The number of parts a run is divided into, each with its own generator
+ * stream, which sets the most threads a run can use.
+ */
+#define ZSL_MC_PARTS            (8)
+
+/** @brief The probability distribution of a model input. */
+enum zsl_mc_dist {
+	/** Always 'a'. */
+	ZSL_MC_DIST_FIXED = 0,
+	/** Normal, with mean 'a' and standard deviation 'b'. */
+	ZSL_MC_DIST_NORMAL,
+	/** Uniform (rectangular) from 'a' to 'b'. */
+	ZSL_MC_DIST_UNIFORM,
+	/** Symmetric triangular from 'a' to 'b'. */
+	ZSL_MC_DIST_TRIANGULAR,
+};
+
+/** @brief A model input and its distribution. */
+struct zsl_mc_input {
+	/** The distribution. */
+	enum zsl_mc_dist dist;
+	/** The mean, or the lower limit of the distribution. */
+	zsl_real_t a;
+	/** The standard deviation, or the upper limit of the distribution. */
+	zsl_real_t b;
+};
+
+/**
+ * @brief A model, evaluated on a batch of samples.
+ *
+ * @param x     One vector per input, each holding y->sz samples of that
+ *              input. The vectors may be changed.
+ * @param y     The output vector, with one entry per sample.
+ * @param arg   The 'arg' of the @ref zsl_mc run.
+ *
+ * @return 0 on success, or a negative error code to stop the run.
+ */
+typedef int (*zsl_mc_fn_t)(struct zsl_vec *x, struct zsl_vec *y, void *arg);
+
+/** @brief A Monte Carlo run. */
+struct zsl_mc {
+	/**
+	 * The model. When CONFIG_ZSL_SMP is enabled, it may be called on
+	 * several threads at once, and must be safe to do so.
+	 */
+	zsl_mc_fn_t fn;
+	/** The argument passed to 'fn'. */
+	void *arg;
+	/** The inputs, in the order of the vectors passed to 'fn'. */
+	const struct zsl_mc_input *in;
+	/** The number of entries in 'in', from 1 to ZSL_MC_MAX_INPUTS. */
+	size_t n_in;
+	/** The generator seed. The same seed gives the same results. */
+	uint64_t seed;
+	/**
+	 * An estimate of the multiply-adds needed to evaluate 'fn' on one
+	 * sample, used to decide whether to use the worker pool.
+	 */
+	size_t cost;
+};
+
+/** @} */ /* End of MC_STRUCTS group */
+
+/**
+ * @addtogroup MC_FUNCS Functions
+ *
+ * @brief Monte Carlo uncertainty propagation functions.
+ *
+ * @ingroup MONTECARLO
+ *  @{ */
+
+/**
+ * @brief Evaluates the model of 'mc' on 'n' random samples of its inputs,
+ *        and adds the results to 'y'.
+ *
+ * 'y' isn't reset first, so reset it with @ref zsl_sta_stream_init before
+ * the first run. Further runs with other seeds add more samples.
+ *
+ * @param mc    The run.
+ * @param n     The number of samples.
+ * @param y     The streaming statistics of the model output.
+ *
+ * @return 0 on success, -EINVAL if 'n' is zero, 'mc' has no model, has
+ *         no inputs or more than ZSL_MC_MAX_INPUTS, or has an input with a
+ *         negative standard deviation or an upper limit below its lower
+ *         limit, or the first error returned by the model, in which case
+ *         'y' is left unchanged.
+ */
+int zsl_mc_run(const struct zsl_mc *mc, size_t n, struct zsl_sta_stream *y);
+
+/** @} */ /* End of MC_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_MONTECARLO_H_ */
+
+/** @} */ /* End of MONTECARLO group */
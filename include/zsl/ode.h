@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup ODE Ordinary Differential Equations
+ *
+ * @brief Numerical integration of systems of ordinary differential
+ *        equations, dy/dt = f(t, y), with a zsl_vec state.
+ *
+ * Three integrators are provided:
+ *
+ * - @ref zsl_ode_rk4: classic fixed-step fourth-order Runge-Kutta.
+ * - @ref zsl_ode_rk45: adaptive Dormand-Prince 5(4), which adjusts its
+ *   step size to keep the local error below a tolerance.
+ * - @ref zsl_ode_verlet: velocity Verlet, for second-order systems
+ *   x'' = a(t, x), which is symplectic and so keeps the energy of
+ *   conservative systems (orbits, pendulums, etc.) bounded over long runs.
+ *
+ * The stage vectors are allocated once per call from a workspace (see the
+ * matching `_ws_sz` helpers), so nothing is allocated per step, and the
+ * state updates are plain loops over the vector data.
+ */
+
+/**
+ * @file
+ * @brief API header file for ODE integrators in zscilib.
+ *
+ * This file contains the zscilib ODE integrator APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ODE_H_
+#define ZEPHYR_INCLUDE_ZSL_ODE_H_
+
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Forward declaration, see zsl/workspace.h. */
+struct zsl_workspace;
+
+/**
+ * @addtogroup ODE_FUNCS Functions
+ *
+ * @brief ODE integrator functions.
+ *
+ * @ingroup ODE
+ *  @{ */
+
+/**
+ * @typedef zsl_ode_fn_t
+ * @brief Evaluates the derivative of the system, dydt = f(t, y).
+ *
+ * @param t     The time.
+ * @param y     The state, which must not be modified.
+ * @param dydt  The output derivative, the same size as 'y'.
+ * @param arg   The user data passed to the integrator.
+ *
+ * @return 0 on success, or a negative error code to abort the integration.
+ */
+typedef int (*zsl_ode_fn_t)(zsl_real_t t, struct zsl_vec *y,
+			    struct zsl_vec *dydt, void *arg);
+
+/**
+ * @typedef zsl_ode_acc_fn_t
+ * @brief Evaluates the acceleration of a second-order system, a = f(t, x).
+ *
+ * @param t     The time.
+ * @param x     The position, which must not be modified.
+ * @param a     The output acceleration, the same size as 'x'.
+ * @param arg   The user data passed to the integrator.
+ *
+ * @return 0 on success, or a negative error code to abort the integration.
+ */
+typedef int (*zsl_ode_acc_fn_t)(zsl_real_t t, struct zsl_vec *x,
+				struct zsl_vec *a, void *arg);
+
+/**
+ * @brief Takes 'steps' fixed steps of size 'h' with the classic fourth-order
+ *        Runge-Kutta method, updating 't' and 'y' in place.
+ *
+ * @param f     The derivative function.
+ * @param arg   User data passed to 'f'.
+ * @param t     The time, advanced by 'steps' * 'h'.
+ * @param h     The step size, which may be negative.
+ * @param steps The number of steps to take.
+ * @param y     The state, updated in place.
+ *
+ * @return 0 on success, -ENOMEM if the scratch memory is too small, or the
+ *         error code returned by 'f'.
+ */
+int zsl_ode_rk4(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+		size_t steps, struct zsl_vec *y);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_ode_rk4_ws for an n-element state.
+ *
+ * @param n     The number of elements in the state.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_ode_rk4_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_ode_rk4, but the stage vectors are
+ *        allocated from workspace 'ws'.
+ *
+ * @return 0 on success, -ENOMEM if 'ws' is too small, or the error code
+ *         returned by 'f'.
+ */
+int zsl_ode_rk4_ws(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+		   size_t steps, struct zsl_vec *y, struct zsl_workspace *ws);
+
+/**
+ * @brief Integrates from 't' to 't_end' with the adaptive Dormand-Prince
+ *        5(4) method, updating 't' and 'y' in place.
+ *
+ * Each step is accepted if its estimated local error, as an RMS over the
+ * state of |err| / (tol * (1 + |y|)), is at most 1, and the next step size
+ * is then scaled by 0.9 * err^(-1/5), limited to between 0.2x and 5x. The
+ * last stage of an accepted step is reused as the first stage of the next
+ * one, so each step costs six calls to 'f'.
+ *
+ * @param f     The derivative function.
+ * @param arg   User data passed to 'f'.
+ * @param t     The time, which is 't_end' on success.
+ * @param t_end The time to integrate to, which may be before 't'.
+ * @param h     The initial step size, whose sign is ignored. Set to the
+ *              step size to start with next time on return.
+ * @param tol   The relative and absolute error tolerance per step.
+ * @param y     The state, updated in place.
+ *
+ * @return 0 on success, -EINVAL if 'h' or 'tol' is not positive, -ERANGE
+ *         if the step size underflows, -ENOMEM if the scratch memory is
+ *         too small, or the error code returned by 'f'.
+ */
+int zsl_ode_rk45(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t t_end,
+		 zsl_real_t *h, zsl_real_t tol, struct zsl_vec *y);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_ode_rk45_ws for an n-element state.
+ *
+ * @param n     The number of elements in the state.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_ode_rk45_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_ode_rk45, but the stage vectors are
+ *        allocated from workspace 'ws'.
+ *
+ * @return 0 on success, -EINVAL if 'h' or 'tol' is not positive, -ERANGE
+ *         if the step size underflows, -ENOMEM if 'ws' is too small, or the
+ *         error code returned by 'f'.
+ */
+int zsl_ode_rk45_ws(zsl_ode_fn_t f, void *arg, zsl_real_t *t,
+		    zsl_real_t t_end, zsl_real_t *h, zsl_real_t tol,
+		    struct zsl_vec *y, struct zsl_workspace *ws);
+
+/**
+ * @brief Takes 'steps' fixed steps of size 'h' of the second-order system
+ *        x'' = f(t, x) with the velocity Verlet method, updating 't', 'x',
+ *        'v' and 'a' in place.
+ *
+ * @param f     The acceleration function.
+ * @param arg   User data passed to 'f'.
+ * @param t     The time, advanced by 'steps' * 'h'.
+ * @param h     The step size.
+ * @param steps The number of steps to take.
+ * @param x     The position, updated in place.
+ * @param v     The velocity, updated in place.
+ * @param a     The acceleration at ('t', 'x'), for example from a call to
+ *              'f', which is updated in place. Each step then costs one
+ *              call to 'f'.
+ *
+ * @return 0 on success, -EINVAL if 'x', 'v' and 'a' are not the same size,
+ *         -ENOMEM if the scratch memory is too small, or the error code
+ *         returned by 'f'.
+ */
+int zsl_ode_verlet(zsl_ode_acc_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+		   size_t steps, struct zsl_vec *x, struct zsl_vec *v,
+		   struct zsl_vec *a);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_ode_verlet_ws for an n-element position.
+ *
+ * @param n     The number of elements in the position.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_ode_verlet_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_ode_verlet, but the temporary acceleration
+ *        is allocated from workspace 'ws'.
+ *
+ * @return 0 on success, -EINVAL if 'x', 'v' and 'a' are not the same size,
+ *         -ENOMEM if 'ws' is too small, or the error code returned by 'f'.
+ */
+int zsl_ode_verlet_ws(zsl_ode_acc_fn_t f, void *arg, zsl_real_t *t,
+		      zsl_real_t h, size_t steps, struct zsl_vec *x,
+		      struct zsl_vec *v, struct zsl_vec *a,
+		      struct zsl_workspace *ws);
+
+/** @} */ /* End of ODE_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ODE_H_ */
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup OPTIMIZE Optimization
+ *
+ * @brief Nonlinear least-squares fitting and function minimization.
+ *
+ * @ref zsl_opt_lm fits the parameters 'p' of a model to data by minimizing
+ * the cost 0.5 * |r(p)|^2, where the residuals 'r' and their Jacobian 'J'
+ * are computed by a user callback. Each Levenberg-Marquardt iteration
+ * solves the damped normal equations (J^T * J + lambda * D) * h = -J^T * r
+ * for step 'h' with a Cholesky decomposition, where 'D' is the diagonal of
+ * J^T * J. 'lambda' is reduced after a successful step, moving towards a
+ * Gauss-Newton step, and increased after a failed one, moving towards a
+ * short gradient descent step.
+ *
+ * Each iteration costs O(m * n^2) for 'm' residuals and 'n' parameters,
+ * and every temporary is taken from a @ref zsl_workspace, so a fit of a few
+ * parameters can run in a real-time loop without any allocation.
+ *
+ * General objective functions are minimized with @ref zsl_opt_nm, the
+ * Nelder-Mead simplex method, which needs only function values, or with
+ * @ref zsl_opt_lbfgs, the limited-memory BFGS quasi-Newton method, which
+ * also needs the gradient but converges much faster on smooth functions.
+ * @ref zsl_opt_brent minimizes a function of one variable. Each of these
+ * stops once its evaluation budget is spent, so its run time is bounded.
+ */
+
+/**
+ * @file
+ * @brief API header file for optimization in zscilib.
+ *
+ * This file contains the zscilib optimization APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_OPTIMIZE_H_
+#define ZEPHYR_INCLUDE_ZSL_OPTIMIZE_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/workspace.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup OPT_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for optimization.
+ *
+ * @ingroup OPTIMIZE
+ *  @{ */
+
+/**
+ * @brief A least-squares model, giving the residuals and their Jacobian at
+ *        parameters 'p'.
+ *
+ * @param p     The parameters.
+ * @param r     The output residuals, such as model(p, x_i) - y_i for each
+ *              data point 'i'.
+ * @param j     The output r->sz x p->sz Jacobian, where entry (i, k) is the
+ *              partial derivative of residual 'i' with respect to parameter
+ *              'k'. This is NULL when only the residuals are needed, to
+ *              check a trial step.
+ * @param arg   The 'arg' of the @ref zsl_opt_lm fit.
+ *
+ * @return 0 on success, or a negative error code to stop the fit.
+ */
+typedef int (*zsl_opt_lsq_fn_t)(const struct zsl_vec *p, struct zsl_vec *r,
+				struct zsl_mtx *j, void *arg);
+
+/** @brief A Levenberg-Marquardt least-squares fit. */
+struct zsl_opt_lm {
+	/** The model. */
+	zsl_opt_lsq_fn_t fn;
+	/** The argument passed to 'fn'. */
+	void *arg;
+	/** The number of residuals, at least the number of parameters. */
+	size_t m;
+	/** The most iterations, each of which calls 'fn' once or twice. */
+	size_t max_iter;
+	/**
+	 * Stop once the largest element of the gradient J^T * r is at most
+	 * this.
+	 */
+	zsl_real_t tol_grad;
+	/**
+	 * Stop once the norm of the step is at most this times the norm of
+	 * the parameters.
+	 */
+	zsl_real_t tol_step;
+	/**
+	 * The initial damping. Zero starts with undamped Gauss-Newton steps,
+	 * which suits models that are close to linear, and only adds damping
+	 * if a step fails to reduce the cost. 1E-3 is a good general choice.
+	 */
+	zsl_real_t lambda;
+};
+
+/**
+ * @brief An objective function to minimize.
+ *
+ * @param x     The point to evaluate.
+ * @param f     The output function value at 'x'.
+ * @param g     The output gradient at 'x', or NULL when only the function
+ *              value is needed. This is always NULL for @ref zsl_opt_nm.
+ * @param arg   The 'arg' of the @ref zsl_opt_min minimization.
+ *
+ * @return 0 on success, or a negative error code to stop the minimization.
+ */
+typedef int (*zsl_opt_fn_t)(const struct zsl_vec *x, zsl_real_t *f,
+			    struct zsl_vec *g, void *arg);
+
+/**
+ * @brief A function of one variable to minimize with @ref zsl_opt_brent.
+ *
+ * @param x     The point to evaluate.
+ * @param f     The output function value at 'x'.
+ * @param arg   The argument passed to @ref zsl_opt_brent.
+ *
+ * @return 0 on success, or a negative error code to stop the minimization.
+ */
+typedef int (*zsl_opt_fn1_t)(zsl_real_t x, zsl_real_t *f, void *arg);
+
+/** @brief A minimization with @ref zsl_opt_nm or @ref zsl_opt_lbfgs. */
+struct zsl_opt_min {
+	/** The objective function. */
+	zsl_opt_fn_t fn;
+	/** The argument passed to 'fn'. */
+	void *arg;
+	/** The evaluation budget: the most calls made to 'fn'. */
+	size_t max_evals;
+	/**
+	 * The convergence tolerance. Nelder-Mead stops once every vertex of
+	 * the simplex is within 'tol' of the best vertex in each coordinate,
+	 * and their function values are within 'tol' of the best value.
+	 * L-BFGS stops once the largest element of the gradient is at most
+	 * 'tol'.
+	 */
+	zsl_real_t tol;
+	/**
+	 * The initial step. For Nelder-Mead, the size of the initial simplex
+	 * along each coordinate, where zero uses 5% of each coordinate of the
+	 * starting point. For L-BFGS, the length of the first step along the
+	 * negative gradient, where zero uses a step of unit length.
+	 */
+	zsl_real_t step;
+	/**
+	 * The number of step and gradient change pairs L-BFGS keeps to model
+	 * the inverse Hessian, normally 3 to 10. Unused by Nelder-Mead.
+	 */
+	size_t hist;
+};
+
+/** @brief The outcome of an optimization. */
+struct zsl_opt_res {
+	/** The number of iterations. */
+	size_t iter;
+	/** The number of calls to the model or objective function. */
+	size_t evals;
+	/** The final value of the cost or objective function. */
+	zsl_real_t f;
+};
+
+/** @} */ /* End of OPT_STRUCTS group */
+
+/**
+ * @addtogroup OPT_FUNCS Functions
+ *
+ * @brief Optimization functions.
+ *
+ * @ingroup OPTIMIZE
+ *  @{ */
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_opt_lm_ws for 'm' residuals and 'n' parameters.
+ *
+ * @param m     The number of residuals.
+ * @param n     The number of parameters.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_opt_lm_ws_sz(size_t m, size_t n);
+
+/**
+ * @brief Fits the parameters 'p' of least-squares model 'lm', starting from
+ *        the initial estimate in 'p'.
+ *
+ * @param lm    The fit.
+ * @param p     The parameters, set to the initial estimate on entry, and
+ *              to those with the lowest cost found on return.
+ * @param res   If not NULL, set to the number of iterations and model calls,
+ *              and the final cost 0.5 * |r|^2.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_opt_lm_ws_sz(lm->m, p->sz) free entries.
+ *
+ * @return  0 on convergence, -EINVAL if 'lm' has no model or no iterations,
+ *          'p' is empty or 'lm->m' is less than p->sz, -ENOCONVERGE if
+ *          'lm->max_iter' iterations were made without converging,
+ *          -ENOMEM if 'ws' is too small, or the error returned by the model.
+ */
+int zsl_opt_lm_ws(const struct zsl_opt_lm *lm, struct zsl_vec *p,
+		  struct zsl_opt_res *res, struct zsl_workspace *ws);
+
+/**
+ * @brief Equivalent to @ref zsl_opt_lm_ws, taking its temporaries from the
+ *        scratch pool or the stack.
+ */
+int zsl_opt_lm(const struct zsl_opt_lm *lm, struct zsl_vec *p,
+	       struct zsl_opt_res *res);
+
+/**
+ * @brief Finds a minimum of 'fn' between 'a' and 'b' with Brent's method.
+ *
+ * Parabolic interpolation through the three best points is used where it
+ * makes good progress, falling back to golden-section steps otherwise, so
+ * the interval always shrinks at least as fast as golden-section search.
+ * 'fn' should have a single minimum between 'a' and 'b', as along a search
+ * direction bracketed by a coarser search.
+ *
+ * @param fn        The function to minimize.
+ * @param arg       The argument passed to 'fn'.
+ * @param a         The lower end of the search interval.
+ * @param b         The upper end of the search interval.
+ * @param tol       The absolute tolerance on 'x', above zero.
+ * @param max_evals The evaluation budget: the most calls made to 'fn'.
+ * @param x         The output position of the lowest value found.
+ * @param res       If not NULL, set to the number of iterations and calls
+ *                  to 'fn', and the value of 'fn' at 'x'.
+ *
+ * @return  0 on convergence, -EINVAL if 'b' isn't above 'a', 'tol' isn't
+ *          above zero or 'max_evals' is zero, -ENOCONVERGE if the budget was
+ *          spent first, or the error returned by 'fn'.
+ */
+int zsl_opt_brent(zsl_opt_fn1_t fn, void *arg, zsl_real_t a, zsl_real_t b,
+		  zsl_real_t tol, size_t max_evals, zsl_real_t *x,
+		  struct zsl_opt_res *res);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_opt_nm_ws for 'n' variables.
+ *
+ * @param n     The number of variables.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_opt_nm_ws_sz(size_t n);
+
+/**
+ * @brief Minimizes the objective of 'min' with the Nelder-Mead simplex
+ *        method, starting from the point in 'x'.
+ *
+ * Only function values are used, so this suits objectives that are noisy,
+ * or whose gradient is unknown or discontinuous, with up to about ten
+ * variables.
+ *
+ * @param min   The minimization. 'hist' is unused.
+ * @param x     The variables, set to the starting point on entry, and to
+ *              the lowest point found on return.
+ * @param res   If not NULL, set to the number of iterations and calls to
+ *              the objective, and its value at 'x'.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_opt_nm_ws_sz(x->sz) free entries.
+ *
+ * @return  0 on convergence, -EINVAL if 'min' has no objective, 'x' is
+ *          empty or the budget is too small to evaluate the initial simplex
+ *          of x->sz + 1 points, -ENOCONVERGE if the budget was spent first,
+ *          -ENOMEM if 'ws' is too small, or the error returned by the
+ *          objective.
+ */
+int zsl_opt_nm_ws(const struct zsl_opt_min *min, struct zsl_vec *x,
+		  struct zsl_opt_res *res, struct zsl_workspace *ws);
+
+/**
+ * @brief Equivalent to @ref zsl_opt_nm_ws, taking its temporaries from the
+ *        scratch pool or the stack.
+ */
+int zsl_opt_nm(const struct zsl_opt_min *min, struct zsl_vec *x,
+	       struct zsl_opt_res *res);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_opt_lbfgs_ws for 'n' variables and a history of 'hist'.
+ *
+ * @param n     The number of variables.
+ * @param hist  The number of history pairs.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_opt_lbfgs_ws_sz(size_t n, size_t hist);
+
+/**
+ * @brief Minimizes the objective of 'min' with the limited-memory BFGS
+ *        method, starting from the point in 'x'.
+ *
+ * The inverse Hessian is modelled from the last 'hist' steps and gradient
+ * changes, so each iteration costs O(hist * n), and the step length is
+ * chosen by a backtracking line search that guarantees a sufficient
+ * decrease. The objective must be smooth, and must fill the gradient.
+ *
+ * @param min   The minimization.
+ * @param x     The variables, set to the starting point on entry, and to
+ *              the lowest point found on return.
+ * @param res   If not NULL, set to the number of iterations and calls to
+ *              the objective, and its value at 'x'.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_opt_lbfgs_ws_sz(x->sz, min->hist) free entries.
+ *
+ * @return  0 on convergence, or once no step along the search direction
+ *          changes 'x' at working precision, -EINVAL if 'min' has no
+ *          objective, no budget or no history, or 'x' is empty,
+ *          -ENOCONVERGE if the budget was spent first, -ENOMEM if 'ws' is
+ *          too small, or the error returned by the objective.
+ */
+int zsl_opt_lbfgs_ws(const struct zsl_opt_min *min, struct zsl_vec *x,
+		     struct zsl_opt_res *res, struct zsl_workspace *ws);
+
+/**
+ * @brief Equivalent to @ref zsl_opt_lbfgs_ws, taking its temporaries from
+ *        the scratch pool or the stack.
+ */
+int zsl_opt_lbfgs(const struct zsl_opt_min *min, struct zsl_vec *x,
+		  struct zsl_opt_res *res);
+
+/** @} */ /* End of OPT_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_OPTIMIZE_H_ */
+
+/** @} */ /* End of OPTIMIZE group */
@@ -31,6 +31,7 @@
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
 #include <zsl/orientation/euler.h>
+#include <zsl/orientation/quaternions.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -110,6 +111,55 @@ int zsl_att_to_euler(struct zsl_attitude *a, struct zsl_euler *e);
  */
 int zsl_att_from_euler(struct zsl_euler *e, struct zsl_attitude *a);
 
+/**
+ * @brief Converts 'n' contiguous @ref zsl_attitude values, expressed in
+ *        degrees, to their equivalents in radians in 'e'.
+ *
+ * @param a 	Pointer to the first of 'n' zsl_attitude structs.
+ * @param e 	Pointer to the first of 'n' output zsl_euler structs.
+ * @param n 	The number of values to convert.
+ *
+ * @return 0 if everything executed correctly, otherwise a negative error code.
+ */
+int zsl_att_to_euler_batch(const struct zsl_attitude *a, struct zsl_euler *e,
+			   size_t n);
+
+/**
+ * @brief Converts 'n' contiguous @ref zsl_euler values, expressed in
+ *        radians, to their equivalents in degrees in 'a'.
+ *
+ * @param e 	Pointer to the first of 'n' zsl_euler structs.
+ * @param a 	Pointer to the first of 'n' output zsl_attitude structs.
+ * @param n 	The number of values to convert.
+ *
+ * @return 0 if everything executed correctly, otherwise a negative error code.
+ */
+int zsl_att_from_euler_batch(const struct zsl_euler *e,
+			     struct zsl_attitude *a, size_t n);
+
+/**
+ * @brief Converts a unit quaternion to attitude in degrees, using the same
+ *        Z-Y-X sequence as @ref zsl_quat_to_euler.
+ *
+ * @param q 	Pointer to the unit quaternion to convert.
+ * @param a 	Pointer to the output zsl_attitude struct.
+ *
+ * @return 0 if everything executed correctly, otherwise a negative error code.
+ */
+int zsl_att_from_quat(struct zsl_quat *q, struct zsl_attitude *a);
+
+/**
+ * @brief Converts every unit quaternion in batch 'qb' to attitude in
+ *        degrees, as per @ref zsl_att_from_quat.
+ *
+ * @param qb 	The batch of unit quaternions to convert.
+ * @param a 	Pointer to the first of qb->sz output zsl_attitude structs.
+ *
+ * @return 0 if everything executed correctly, otherwise a negative error code.
+ */
+int zsl_att_from_quat_batch(struct zsl_quat_batch *qb,
+			    struct zsl_attitude *a);
+
 /**
  * @brief Converts a three-axis accelerometer (in m/s^2) and a three-axis
  *        magnetometer sample (in micro-Tesla) to attitude.
@@ -137,6 +187,9 @@ int zsl_att_from_accelmag(struct zsl_vec *accel, struct zsl_vec *mag,
  *       position, not magentic north. Be sure to place the device in a known
  *       orientation when starting it up.
  *
+ * The yaw can't be derived from the accelerometer, so it is set to 0.0 and
+ * flagged as invalid in the output's status bits.
+ *
  * @param accel 	Acceleration triplet in m/s^2.
  * @param a 		Pointer the the output @ref zsl_attitude struct.
  *
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup FUSION_CALIBRATION Calibration
+ *
+ * @brief Sensor calibration helpers for the fusion algorithms.
+ *
+ * @ingroup FUSION
+ *  @{ */
+
+/**
+ * @file
+ * @brief Sensor calibration helpers for the fusion algorithms.
+ *
+ * This file implements a streaming magnetometer hard and soft iron
+ * calibration. Each sample is folded into the 10x10 scatter matrix of the
+ * general ellipsoid equation, so memory use is constant no matter how many
+ * samples are fed, and feeding a sample is cheap enough to be done as the
+ * data arrives. The ellipsoid is then fit once, in
+ * @ref zsl_fus_cal_magn_solve, with the symmetric eigensolver.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FUSION_CALIBRATION_H_
+#define ZEPHYR_INCLUDE_ZSL_FUSION_CALIBRATION_H_
+
+#include <zsl/orientation/fusion/fusion.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The number of coefficients in the general ellipsoid equation.
+ */
+#define ZSL_FUS_CAL_MAGN_N      (10)
+
+/**
+ * @brief Streaming magnetometer calibration state. See
+ *        @ref zsl_fus_cal_magn_init.
+ */
+struct zsl_fus_cal_magn {
+	/** @brief The expected field strength, used to scale the samples. */
+	zsl_real_t field;
+	/** @brief The number of samples fed so far. */
+	size_t n;
+	/**
+	 * @brief The upper triangle of the scatter matrix, packed row by row.
+	 */
+	zsl_real_t s[ZSL_FUS_CAL_MAGN_N * (ZSL_FUS_CAL_MAGN_N + 1) / 2];
+};
+
+/**
+ * @brief Prepares 'c' for a new magnetometer calibration.
+ *
+ * @param c         The calibration state to initialise.
+ * @param field     The expected field strength, in the same units as the
+ *                  samples. The calibrated output has this magnitude.
+ *
+ * @return 0 on success, or -EINVAL if 'field' is not positive.
+ */
+int zsl_fus_cal_magn_init(struct zsl_fus_cal_magn *c, zsl_real_t field);
+
+/**
+ * @brief Adds one raw magnetometer sample to the calibration, which takes
+ *        55 multiply-adds.
+ *
+ * @param c     The calibration state.
+ * @param m     The raw magnetometer 3-vector.
+ *
+ * @return 0 on success, or -EINVAL if 'm' is not a 3-vector.
+ */
+int zsl_fus_cal_magn_feed(struct zsl_fus_cal_magn *c, struct zsl_vec *m);
+
+/**
+ * @brief Fits an ellipsoid to the samples fed so far, and returns the
+ *        correction that maps it onto a sphere of radius c->field.
+ *
+ * The fit minimises the algebraic distance of the samples to the ellipsoid,
+ * so the samples should cover as much of the sphere of orientations as
+ * possible. The state is not changed, so more samples can be fed and the
+ * fit repeated.
+ *
+ * @param c     The calibration state.
+ * @param K     The 3x3 soft iron correction matrix, which is symmetric.
+ * @param b     The hard iron offset 3-vector.
+ *
+ * @return 0 on success, or -EINVAL if 'K' or 'b' have the wrong shape, if
+ *         fewer than @ref ZSL_FUS_CAL_MAGN_N samples were fed, or if the
+ *         samples do not describe an ellipsoid (e.g. they all lie in a
+ *         plane).
+ */
+int zsl_fus_cal_magn_solve(struct zsl_fus_cal_magn *c, struct zsl_mtx *K,
+			   struct zsl_vec *b);
+
+/**
+ * @brief Applies a magnetometer calibration to a raw sample,
+ *        mc = K * (m - b).
+ *
+ * @param K     The 3x3 soft iron correction matrix.
+ * @param b     The hard iron offset 3-vector.
+ * @param m     The raw magnetometer 3-vector.
+ * @param mc    The calibrated output 3-vector, which may be 'm'.
+ *
+ * @return 0 on success, or -EINVAL if any input has the wrong shape.
+ */
+int zsl_fus_cal_magn_apply(struct zsl_mtx *K, struct zsl_vec *b,
+			   struct zsl_vec *m, struct zsl_vec *mc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FUSION_CALIBRATION_H_ */
+
+/** @} */ /* End of calibration group */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup FUSION_ALGORITHM_EKF Extended Kalman
+ *
+ * @brief Extended Kalman filter sensor fusion algorithm.
+ *
+ * @ingroup FUSION
+ *  @{ */
+
+/**
+ * @file
+ * @brief Extended Kalman filter sensor fusion algorithm.
+ *
+ * This file implements an extended Kalman filter orientation estimator,
+ * whose state is the orientation quaternion plus the gyroscope bias
+ * (@ref ZSL_FUS_EKF_N states).
+ *
+ * All matrices have a fixed, compile-time size, and no memory is allocated
+ * during an update. The covariance is kept symmetric by only computing its
+ * upper triangle, and the accelerometer and magnetometer are applied as
+ * sequential scalar measurements, so the innovation matrix never needs to
+ * be inverted. Each scalar update uses the Joseph form, applied in place.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FUSION_EKF_H_
+#define ZEPHYR_INCLUDE_ZSL_FUSION_EKF_H_
+
+#include <zsl/orientation/fusion/fusion.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The number of states in the filter: four for the quaternion, and
+ *        three for the gyroscope bias.
+ */
+#define ZSL_FUS_EKF_N   (7)
+
+/**
+ * @brief Config settings for the extended Kalman filter sensor fusion
+ *        algorithm. All values are variances.
+ */
+struct zsl_fus_ekf_cfg {
+	/**
+	 * @brief Gyroscope noise variance, in (rad/s)^2. Defaults to 1E-4.
+	 */
+	zsl_real_t var_g;
+	/**
+	 * @brief Gyroscope bias random walk variance, in (rad/s)^2 per second.
+	 *        Defaults to 1E-8.
+	 */
+	zsl_real_t var_b;
+	/**
+	 * @brief Variance of each axis of the normalised accelerometer
+	 *        reading. Defaults to 1E-2.
+	 */
+	zsl_real_t var_a;
+	/**
+	 * @brief Variance of the heading taken from the magnetometer, in
+	 *        rad^2. Defaults to 1E-2.
+	 */
+	zsl_real_t var_m;
+};
+
+/**
+ * @brief The config settings used by @ref zsl_fus_ekf_drv, which can be
+ *        changed at any time.
+ */
+extern struct zsl_fus_ekf_cfg zsl_fus_ekf_cfg;
+
+/**
+ * @brief Extended Kalman filter sensor fusion driver, with 'config' pointing
+ *        to @ref zsl_fus_ekf_cfg.
+ */
+extern struct zsl_fus_drv zsl_fus_ekf_drv;
+
+/**
+ * @brief Resets the filter to the identity orientation with no gyroscope
+ *        bias, and resets the covariance.
+ *
+ * @param freq  Sample frequency in Hz (samples per second).
+ *
+ * @return 0 on success, or -EINVAL if 'freq' is zero.
+ */
+int zsl_fus_ekf_init(uint32_t freq);
+
+/**
+ * @brief Updates the filter with one sample.
+ *
+ * The accelerometer and magnetometer data may be in any unit, since they
+ * are normalised. If 'mag' is NULL or zero, only the accelerometer
+ * measurement update is applied, and if 'accel' is NULL or zero, only the
+ * prediction step is run. The magnetometer is applied as a single heading
+ * measurement.
+ *
+ * @param accel  Pointer to the accelerometer XYZ data. NULL for none.
+ * @param mag    Pointer to the magnetometer XYZ data. NULL for none.
+ * @param gyro   Pointer to the gyroscope XYZ data in rad/s.
+ *
+ * @return 0 on success, or -EINVAL if 'gyro' is NULL, or any vector is not
+ *         a 3-vector.
+ */
+int zsl_fus_ekf_feed(struct zsl_vec *accel, struct zsl_vec *mag,
+		     struct zsl_vec *gyro);
+
+/**
+ * @brief Updates the filter with a batch of samples, which may be
+ *        timestamped. See @ref zsl_fus_feed_batch.
+ *
+ * @param b  The batch of samples, with the same units as
+ *           @ref zsl_fus_ekf_feed.
+ *
+ * @return 0 on success, or -EINVAL if the batch is malformed.
+ */
+int zsl_fus_ekf_feed_batch(struct zsl_fus_batch *b);
+
+/**
+ * @brief Gets the current orientation estimate, which rotates vectors from
+ *        the sensor frame to the earth frame.
+ *
+ * @param q  Pointer to the output unit quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_fus_ekf_get_quat(struct zsl_quat *q);
+
+/**
+ * @brief Gets the current gyroscope bias estimate.
+ *
+ * @param b  Pointer to the output 3-vector, in rad/s.
+ *
+ * @return 0 on success, or -EINVAL if 'b' is not a 3-vector.
+ */
+int zsl_fus_ekf_get_bias(struct zsl_vec *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FUSION_EKF_H_ */
+
+/** @} */ /* End of algorithms group */
@@ -65,6 +65,95 @@ typedef int (*zsl_fus_feed_cb_t)(struct zsl_vec *accel,
  */
 typedef int (*zsl_fus_get_quat_cb_t)(struct zsl_quat *q);
 
+/**
+ * @brief A batch of sensor samples, for example read from a sensor FIFO or
+ *        replayed from a log, fed in one call via @ref zsl_fus_feed_batch.
+ */
+struct zsl_fus_batch {
+	/** @brief The number of samples. */
+	size_t n;
+	/**
+	 * @brief The sample times in seconds, 'n' strictly increasing
+	 *        entries. The first sample is timed against the last sample
+	 *        of the previous batch, or the nominal period if there is
+	 *        none. NULL to use the nominal period set by the driver's
+	 *        init handler for every sample.
+	 */
+	zsl_real_t *t;
+	/** @brief The n x 3 accelerometer samples. NULL for none. */
+	struct zsl_mtx *accel;
+	/** @brief The n x 3 magnetometer samples. NULL for none. */
+	struct zsl_mtx *mag;
+	/** @brief The n x 3 gyroscope samples. */
+	struct zsl_mtx *gyro;
+	/**
+	 * @brief Output decimation factor. The orientation is written to 'q'
+	 *        after every 'dec' samples, or only after the last sample if
+	 *        zero.
+	 */
+	uint32_t dec;
+	/** @brief The output orientations. NULL for none. */
+	struct zsl_quat_batch *q;
+	/** @brief Set to the number of orientations written to 'q'. */
+	size_t qn;
+};
+
+/**
+ * @brief Timing state for drivers that accept timestamped batches.
+ */
+struct zsl_fus_clk {
+	/** @brief The nominal sample period in seconds. */
+	zsl_real_t dt;
+	/** @brief The time of the last timestamped sample, in seconds. */
+	zsl_real_t t;
+	/** @brief Whether 't' holds a timestamp. */
+	bool valid;
+};
+
+/**
+ * @brief Returns the period ending at sample 'i' of batch 'b', and records
+ *        its timestamp in 'c'. For use by driver batch handlers, once the
+ *        batch has passed @ref zsl_fus_batch_check.
+ */
+static inline zsl_real_t zsl_fus_clk_tick(struct zsl_fus_clk *c,
+					  struct zsl_fus_batch *b, size_t i)
+{
+	zsl_real_t dt = c->dt;
+
+	if (b->t != NULL) {
+		if (c->valid) {
+			dt = b->t[i] - c->t;
+		}
+		c->t = b->t[i];
+		c->valid = true;
+	}
+
+	return dt;
+}
+
+/**
+ * @brief Returns true if the orientation should be output after sample 'i'
+ *        of batch 'b', based on its decimation factor.
+ */
+static inline bool zsl_fus_batch_out(struct zsl_fus_batch *b, size_t i)
+{
+	if (b->dec == 0) {
+		return i + 1 == b->n;
+	}
+
+	return (i + 1) % b->dec == 0;
+}
+
+/**
+ * @typedef zsl_fus_feed_batch_cb_t
+ * @brief Batch update callback prototype for sensor fusion implementations.
+ *
+ * @param b         Pointer to the batch of samples to feed.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+typedef int (*zsl_fus_feed_batch_cb_t)(struct zsl_fus_batch *b);
+
 /**
  * @typedef zsl_fus_error_cb_t
  * @brief Callback prototype when a fusion algorithm fails to properly feed.
@@ -104,8 +193,44 @@ struct zsl_fus_drv {
 	 *        by the implementing module.
 	 */
 	void *config;
+
+	/**
+	 * @brief Optional callback to fire when feeding a batch of samples.
+	 *        NULL if the driver only supports single samples.
+	 */
+	zsl_fus_feed_batch_cb_t feed_batch_handler;
 };
 
+/**
+ * @brief Checks that the batch 'b' is well formed: the sample matrices are
+ *        n x 3, the timestamps increase, also relative to the last
+ *        timestamp in 'c' if any, and 'q' can hold every output.
+ *
+ * @param b     The batch to check.
+ * @param c     The driver's timing state. NULL to skip the timestamp checks.
+ *
+ * @return 0 if the batch is valid, otherwise -EINVAL.
+ */
+int zsl_fus_batch_check(struct zsl_fus_batch *b, struct zsl_fus_clk *c);
+
+/**
+ * @brief Feeds a batch of samples to a fusion driver, writing the
+ *        decimated orientation output to 'b->q'.
+ *
+ * Drivers with a 'feed_batch_handler' process the whole batch in one call.
+ * Otherwise, each sample is passed to 'feed_handler' and the orientation is
+ * read back with 'get_quat_handler', in which case timestamps are not
+ * supported. If the batch fails to feed, 'error_handler' is called if set.
+ *
+ * @param drv   The fusion driver.
+ * @param b     The batch of samples.
+ *
+ * @return 0 on success, -EINVAL if the batch is malformed, -ENOTSUP if it
+ *         has timestamps the driver cannot handle, or the driver's error
+ *         code.
+ */
+int zsl_fus_feed_batch(struct zsl_fus_drv *drv, struct zsl_fus_batch *b);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup FUSION_ALGORITHM_MADGWICK Madgwick
+ *
+ * @brief Madgwick gradient descent sensor fusion algorithm.
+ *
+ * @ingroup FUSION
+ *  @{ */
+
+/**
+ * @file
+ * @brief Madgwick sensor fusion algorithm.
+ *
+ * This file implements the Madgwick gradient descent orientation filter,
+ * fusing gyroscope data with accelerometer and, optionally, magnetometer
+ * data.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FUSION_MADGWICK_H_
+#define ZEPHYR_INCLUDE_ZSL_FUSION_MADGWICK_H_
+
+#include <zsl/orientation/fusion/fusion.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Config settings for the Madgwick sensor fusion algorithm.
+ */
+struct zsl_fus_madg_cfg {
+	/**
+	 * @brief The filter gain, in rad/s. Higher values converge faster on
+	 *        the accelerometer and magnetometer, but pass through more
+	 *        of their noise. Defaults to 0.1.
+	 */
+	zsl_real_t beta;
+};
+
+/**
+ * @brief The config settings used by @ref zsl_fus_madg_drv, which can be
+ *        changed at any time.
+ */
+extern struct zsl_fus_madg_cfg zsl_fus_madg_cfg;
+
+/**
+ * @brief Madgwick sensor fusion driver, with 'config' pointing to
+ *        @ref zsl_fus_madg_cfg.
+ */
+extern struct zsl_fus_drv zsl_fus_madg_drv;
+
+/**
+ * @brief Resets the Madgwick filter to the identity orientation.
+ *
+ * @param freq  Sample frequency in Hz (samples per second).
+ *
+ * @return 0 on success, or -EINVAL if 'freq' is zero.
+ */
+int zsl_fus_madg_init(uint32_t freq);
+
+/**
+ * @brief Updates the Madgwick filter with one sample.
+ *
+ * The accelerometer and magnetometer data may be in any unit, since they
+ * are normalised. If 'mag' is NULL or zero, only the accelerometer is used
+ * to correct the gyroscope, and if 'accel' is NULL or zero, the gyroscope
+ * data is integrated as is.
+ *
+ * @param accel  Pointer to the accelerometer XYZ data. NULL for none.
+ * @param mag    Pointer to the magnetometer XYZ data. NULL for none.
+ * @param gyro   Pointer to the gyroscope XYZ data in rad/s.
+ *
+ * @return 0 on success, or -EINVAL if 'gyro' is NULL, or any vector is not
+ *         a 3-vector.
+ */
+int zsl_fus_madg_feed(struct zsl_vec *accel, struct zsl_vec *mag,
+		      struct zsl_vec *gyro);
+
+/**
+ * @brief Updates the Madgwick filter with a batch of samples, which may be
+ *        timestamped. See @ref zsl_fus_feed_batch.
+ *
+ * @param b  The batch of samples, with the same units as
+ *           @ref zsl_fus_madg_feed.
+ *
+ * @return 0 on success, or -EINVAL if the batch is malformed.
+ */
+int zsl_fus_madg_feed_batch(struct zsl_fus_batch *b);
+
+/**
+ * @brief Gets the current Madgwick orientation estimate, which rotates
+ *        vectors from the sensor frame to the earth frame.
+ *
+ * @param q  Pointer to the output unit quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_fus_madg_get_quat(struct zsl_quat *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FUSION_MADGWICK_H_ */
+
+/** @} */ /* End of algorithms group */
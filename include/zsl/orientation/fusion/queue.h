@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup FUSION_QUEUE Sample Queue
+ *
+ * @brief Lock-free sample queue between a sensor ISR and a fusion driver.
+ *
+ * @ingroup FUSION
+ *  @{ */
+
+/**
+ * @file
+ * @brief Lock-free sample queue between a sensor ISR and a fusion driver.
+ *
+ * A single producer (typically the sensor ISR) pushes samples with
+ * @ref zsl_fus_queue_push, and a single consumer (the fusion thread)
+ * feeds them to a driver with @ref zsl_fus_queue_drain. Neither side takes
+ * a lock or disables interrupts.
+ *
+ * The samples are stored as n x 3 arrays, one per sensor, so any
+ * contiguous run of queued samples is passed to @ref zsl_fus_feed_batch
+ * in place, without being copied. 'head' and 'tail' are free-running
+ * counts of the samples pushed and drained, each on its own cache line,
+ * so 'head' - 'tail' is the fill level, and together with 'full' and
+ * 'peak' they show how close the consumer is to falling behind.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FUSION_QUEUE_H_
+#define ZEPHYR_INCLUDE_ZSL_FUSION_QUEUE_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <zsl/orientation/fusion/fusion.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The alignment of the queue storage and counters, which should be
+ *        the data cache line size of the target.
+ */
+#ifndef ZSL_FUS_QUEUE_ALIGN
+#define ZSL_FUS_QUEUE_ALIGN     (32)
+#endif
+
+/**
+ * @brief Single-producer, single-consumer queue of fusion driver samples.
+ *        Declare with @ref ZSL_FUS_QUEUE_DEF or @ref ZSL_FUS_QUEUE_DEF_T.
+ */
+struct zsl_fus_queue {
+	/** @brief The capacity in samples, a power of two. */
+	size_t sz;
+	/** @brief 'sz' sample timestamps in seconds, or NULL for none. */
+	zsl_real_t *t;
+	/** @brief 'sz' x 3 accelerometer samples, or NULL for none. */
+	zsl_real_t *accel;
+	/** @brief 'sz' x 3 magnetometer samples, or NULL for none. */
+	zsl_real_t *mag;
+	/** @brief 'sz' x 3 gyroscope samples. */
+	zsl_real_t *gyro;
+	/** @brief The number of samples pushed. Written by the producer. */
+	uint32_t head __attribute__((aligned(ZSL_FUS_QUEUE_ALIGN)));
+	/**
+	 * @brief The number of pushes rejected because the queue was full.
+	 *        Written by the producer.
+	 */
+	uint32_t full;
+	/** @brief The number of samples drained. Written by the consumer. */
+	uint32_t tail __attribute__((aligned(ZSL_FUS_QUEUE_ALIGN)));
+	/**
+	 * @brief The highest fill level seen by the consumer. Written by the
+	 *        consumer.
+	 */
+	uint32_t peak;
+};
+
+/** @cond INTERNAL */
+#define ZSL_FUS_QUEUE_ARR(name, arr, n)					\
+	static zsl_real_t name ## _ ## arr[n]				\
+	__attribute__((aligned(ZSL_FUS_QUEUE_ALIGN)))
+
+#define ZSL_FUS_QUEUE_INIT(name, n, ts)					\
+	_Static_assert((n) > 0 && ((n) & ((n) - 1)) == 0,		\
+		       "queue size must be a power of two");		\
+	ZSL_FUS_QUEUE_ARR(name, accel, 3 * (n));			\
+	ZSL_FUS_QUEUE_ARR(name, mag, 3 * (n));				\
+	ZSL_FUS_QUEUE_ARR(name, gyro, 3 * (n));				\
+	struct zsl_fus_queue name = {					\
+		.sz = n,						\
+		.t = ts,						\
+		.accel = name ## _accel,				\
+		.mag = name ## _mag,					\
+		.gyro = name ## _gyro,					\
+	}
+/** @endcond */
+
+/**
+ * Macro to declare an untimed queue of 'n' samples, where 'n' is a power of
+ * two. Set 'accel' or 'mag' to NULL afterwards if the sensor is absent.
+ */
+#define ZSL_FUS_QUEUE_DEF(name, n)					\
+	ZSL_FUS_QUEUE_INIT(name, n, NULL)
+
+/**
+ * Macro to declare a queue of 'n' timestamped samples, where 'n' is a power
+ * of two. Timestamps require a driver with a batch handler.
+ */
+#define ZSL_FUS_QUEUE_DEF_T(name, n)					\
+	ZSL_FUS_QUEUE_ARR(name, t, n);					\
+	ZSL_FUS_QUEUE_INIT(name, n, name ## _t)
+
+/**
+ * @brief Returns the number of samples currently queued.
+ */
+static inline uint32_t zsl_fus_queue_level(struct zsl_fus_queue *q)
+{
+	return __atomic_load_n(&q->head, __ATOMIC_ACQUIRE) -
+	       __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Adds one sample to the queue. Only one context may push to a queue,
+ *        and this is safe to call from an ISR.
+ *
+ * @param q         The queue.
+ * @param accel     The accelerometer 3-vector, or NULL if q->accel is NULL.
+ * @param mag       The magnetometer 3-vector, or NULL if q->mag is NULL.
+ * @param gyro      The gyroscope 3-vector.
+ * @param t         The sample time in seconds, ignored if q->t is NULL.
+ *
+ * @return 0 on success, -ENOBUFS if the queue is full, in which case the
+ *         sample is dropped and 'full' incremented, or -EINVAL if a
+ *         required vector is missing or not a 3-vector.
+ */
+static inline int zsl_fus_queue_push(struct zsl_fus_queue *q,
+				     struct zsl_vec *accel,
+				     struct zsl_vec *mag,
+				     struct zsl_vec *gyro, zsl_real_t t)
+{
+	uint32_t head = q->head;
+	size_t i;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((gyro == NULL || gyro->sz != 3) ||
+	    (q->accel != NULL && (accel == NULL || accel->sz != 3)) ||
+	    (q->mag != NULL && (mag == NULL || mag->sz != 3))) {
+		return -EINVAL;
+	}
+#endif
+
+	if (head - __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) >= q->sz) {
+		q->full++;
+		return -ENOBUFS;
+	}
+
+	i = head & (q->sz - 1);
+	for (size_t c = 0; c < 3; c++) {
+		q->gyro[3 * i + c] = gyro->data[c];
+		if (q->accel != NULL) {
+			q->accel[3 * i + c] = accel->data[c];
+		}
+		if (q->mag != NULL) {
+			q->mag[3 * i + c] = mag->data[c];
+		}
+	}
+	if (q->t != NULL) {
+		q->t[i] = t;
+	}
+
+	/* Publish the sample only once it has been written. */
+	__atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/**
+ * @brief Feeds up to 'max' queued samples to 'drv', in at most two calls to
+ *        @ref zsl_fus_feed_batch (one if the samples do not wrap around the
+ *        end of the storage). Only one context may drain a queue.
+ *
+ * The samples are fed in place, so they are released to the producer only
+ * once the driver has processed them. If the driver fails, the failing run
+ * of samples is still released, so a bad sample cannot stall the queue.
+ *
+ * @param q     The queue.
+ * @param drv   The fusion driver to feed.
+ * @param max   The maximum number of samples to feed, or 0 for no limit.
+ *
+ * @return The number of samples fed, or the driver's negative error code.
+ */
+int zsl_fus_queue_drain(struct zsl_fus_queue *q, struct zsl_fus_drv *drv,
+			size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FUSION_QUEUE_H_ */
+
+/** @} */ /* End of queue group */
@@ -18,5 +18,10 @@
 #include <zsl/orientation/euler.h>
 #include <zsl/orientation/quaternions.h>
 #include <zsl/orientation/fusion/fusion.h>
+#include <zsl/orientation/fusion/calibration.h>
+#include <zsl/orientation/fusion/ekf.h>
+#include <zsl/orientation/fusion/madgwick.h>
+#include <zsl/orientation/fusion/mahony.h>
+#include <zsl/orientation/fusion/queue.h>
 
 #endif /* ZSL_ORIENTATION_H_ */
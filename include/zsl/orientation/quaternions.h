@@ -119,6 +119,86 @@ enum zsl_quat_type {
 	ZSL_QUAT_TYPE_IDENTITY  = 1,
 };
 
+/**
+ * @brief Represents a batch of 'sz' quaternions in structure-of-arrays form,
+ *        with all real components first, followed by all i, j and then k
+ *        components. The 'i' component of quaternion 'b' is therefore at
+ *        data[sz + b].
+ */
+struct zsl_quat_batch {
+	size_t sz;              /**< @brief The number of quaternions. */
+	zsl_real_t *data;       /**< @brief The components, 4 * sz entries. */
+};
+
+/**
+ * Macro to declare a batch of 'n' quaternions.
+ *
+ * The components are not initialised by this macro.
+ */
+#define ZSL_QUAT_BATCH_DEF(name, n)		\
+	zsl_real_t name ## _quatb[4 * (n)];	\
+	struct zsl_quat_batch name = {		\
+		.sz = n,			\
+		.data = name ## _quatb		\
+	}
+
+/**
+ * @brief Above this dot product between two unit quaternions (an angle of
+ *        about 3.6 degrees between the rotations), slerp is replaced by the
+ *        much cheaper normalised linear interpolation (nlerp), whose
+ *        rotation error is then about 1E-6 rad.
+ */
+#ifndef ZSL_QUAT_NLERP_DOT
+#define ZSL_QUAT_NLERP_DOT      (0.9995)
+#endif
+
+/**
+ * @brief Below this squared half rotation angle, theta^2 (theta below about
+ *        0.03 rad), @ref zsl_quat_integrate evaluates cos(theta) and
+ *        sin(theta) / theta with a Taylor series instead of trig calls. The
+ *        truncation error is then below 2E-12.
+ */
+#ifndef ZSL_QUAT_INTEG_TAYLOR
+#define ZSL_QUAT_INTEG_TAYLOR   (1E-3)
+#endif
+
+/**
+ * @brief Precomputed state to generate evenly spaced slerp outputs between
+ *        two quaternions. See @ref zsl_quat_slerp_step_init.
+ */
+struct zsl_quat_slerp_step {
+	/** @brief The number of outputs, including both end points. */
+	size_t n;
+	/** @brief The index of the next output. */
+	size_t i;
+	/** @brief True if the outputs are generated with nlerp. */
+	bool nlerp;
+	/** @brief Cosine and sine of the angle between outputs. */
+	zsl_real_t c, s;
+	/** @brief Cosine and sine of the angle of the next output. */
+	zsl_real_t ck, sk;
+	/** @brief The start point, or the next output before normalisation
+	 *         for nlerp. */
+	struct zsl_quat qa;
+	/** @brief The unit quaternion orthogonal to qa in the plane of qa and
+	 *         qb, or the increment for nlerp. */
+	struct zsl_quat qo;
+	/** @brief The final output. */
+	struct zsl_quat qb;
+};
+
+/**
+ * @brief Attitude propagation state. See @ref zsl_quat_integ_init.
+ */
+struct zsl_quat_integ {
+	/** @brief The current orientation. */
+	struct zsl_quat q;
+	/** @brief Renormalise after this many steps, or 0 to never. */
+	size_t renorm;
+	/** @brief The number of steps since the last renormalisation. */
+	size_t count;
+};
+
 /** @} */ /* End of QUAT_STRUCTS group */
 
 /**
@@ -196,6 +276,20 @@ int zsl_quat_to_unit(struct zsl_quat *q, struct zsl_quat *qn);
  */
 int zsl_quat_to_unit_d(struct zsl_quat *q);
 
+/**
+ * @brief Normalises a quaternion using @ref zsl_fast_inv_sqrt rather than a
+ *        square root and divide.
+ *
+ * The output magnitude is within 1E-5 of 1.0, which is suitable for keeping
+ * a quaternion that is updated every sample close to unit length.
+ *
+ * @param q 	The source quaternion.
+ * @param qn 	The normalised output quaternion, which may be 'q'.
+ *
+ * @return 0 if everything executed normally, or a negative error code.
+ */
+int zsl_quat_to_unit_fast(struct zsl_quat *q, struct zsl_quat *qn);
+
 /**
  * @brief Verifies that this is a "unit" quaternion, meaning that it has a
  *        magnitude of 1, where sqrt(r^2+i^2+j^2+k^2) = 1.0.
@@ -240,13 +334,47 @@ int zsl_quat_scale_d(struct zsl_quat *q, zsl_real_t s);
  *
  * @param qa 	The first input unit quaternion.
  * @param qb 	The second input unit quaternion.
- * @param qm 	The output placeholder.
+ * @param qm 	The output placeholder, which may be 'qa' or 'qb'.
  *
  * @return 0 if everything executed normally, or a negative error code.
  */
 int zsl_quat_mult(struct zsl_quat *qa, struct zsl_quat *qb,
 		  struct zsl_quat *qm);
 
+/**
+ * @brief Rotates 3-vector 'v' by unit quaternion 'q', giving q * v * q^-1.
+ *
+ * Rather than building the two quaternion products, this uses the
+ * equivalent form v' = v + r * t + (ijk x t), where t = 2 * (ijk x v),
+ * which takes 15 multiplies.
+ *
+ * @param q 	The unit quaternion to rotate by.
+ * @param v 	The input 3-vector.
+ * @param vr 	The rotated output 3-vector, which may be 'v'.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'v' or 'vr' are
+ *         not 3-vectors.
+ */
+int zsl_quat_rot_vec(struct zsl_quat *q, struct zsl_vec *v,
+		     struct zsl_vec *vr);
+
+/**
+ * @brief Rotates each row of the n x 3 matrix 'v' by unit quaternion 'q',
+ *        as per @ref zsl_quat_rot_vec.
+ *
+ * The 3x3 rotation matrix of 'q' is built once (see
+ * @ref zsl_quat_to_rot_mtx33), so each vector then costs 9 multiplies.
+ *
+ * @param q 	The unit quaternion to rotate by.
+ * @param v 	The n x 3 matrix of input vectors, one per row.
+ * @param vr 	The n x 3 matrix of rotated vectors, which may be 'v'.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'v' and 'vr'
+ *         are not the same n x 3 shape.
+ */
+int zsl_quat_rot_vec_batch(struct zsl_quat *q, struct zsl_mtx *v,
+			   struct zsl_mtx *vr);
+
 /**
  * @brief Calculates the exponential of a unit quaternion.
  *
@@ -332,6 +460,10 @@ int zsl_quat_diff(struct zsl_quat *qa, struct zsl_quat *qb,
  * Calculates an intermediate rotation between qa and qb, based on the
  * provided interpolation factor, t (0.0..1.0). Output assigned to qi.
  *
+ * When the dot product of qa and qb exceeds @ref ZSL_QUAT_NLERP_DOT,
+ * normalised linear interpolation is used instead, which avoids the
+ * acos and sin calls and the division by a near-zero sine.
+ *
  * @param qa	The starting unit quaternion value.
  * @param qb	The target unit quaternion value.
  * @param t     The interpolation factor (0.0..1.0)
@@ -342,10 +474,98 @@ int zsl_quat_diff(struct zsl_quat *qa, struct zsl_quat *qb,
 int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 		   zsl_real_t t, struct zsl_quat *qi);
 
+/**
+ * @brief Prepares 's' to generate 'n' evenly spaced slerp outputs from qa
+ *        to qb, both included, via @ref zsl_quat_slerp_step_next.
+ *
+ * The trig functions are only evaluated here. Each output is then
+ * cos(k theta) qa + sin(k theta) qo, where qo is orthogonal to qa, and the
+ * cosine and sine are stepped by a 2x2 rotation, so an output costs twelve
+ * multiplies. The last output is exactly qb. Nearly parallel inputs (see
+ * @ref ZSL_QUAT_NLERP_DOT) are stepped with nlerp instead.
+ *
+ * @param s     The stepper state to initialise.
+ * @param qa    The starting unit quaternion value.
+ * @param qb    The target unit quaternion value.
+ * @param n     The number of outputs, at least 2.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'n' is less
+ *         than 2.
+ */
+int zsl_quat_slerp_step_init(struct zsl_quat_slerp_step *s,
+			     struct zsl_quat *qa, struct zsl_quat *qb, size_t n);
+
+/**
+ * @brief Gets the next output of a slerp stepper.
+ *
+ * @param s     The stepper state, from @ref zsl_quat_slerp_step_init.
+ * @param q     The output quaternion.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if all 'n' outputs
+ *         have already been returned.
+ */
+int zsl_quat_slerp_step_next(struct zsl_quat_slerp_step *s,
+			     struct zsl_quat *q);
+
+/**
+ * @brief Integrates the body frame angular velocity 'w' over 'dt' seconds,
+ *        starting from the unit quaternion 'q': qi = q * exp(w * dt / 2).
+ *
+ * This is the closed-form exponential map, so it is exact for a constant
+ * 'w' over the step, and replaces the sequence of @ref zsl_quat_exp and
+ * @ref zsl_quat_mult calls. Small steps (see @ref ZSL_QUAT_INTEG_TAYLOR)
+ * take no sqrt or trig calls at all.
+ *
+ * The output is not renormalised, so its magnitude drifts by about one
+ * rounding error per call. See @ref zsl_quat_integ_step to renormalise
+ * periodically.
+ *
+ * @param q     The starting unit quaternion.
+ * @param w     The angular velocity 3-vector, in rad/s.
+ * @param dt    The time step, in seconds.
+ * @param qi    The integrated quaternion, which may be 'q'.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'w' is not a
+ *         3-vector.
+ */
+int zsl_quat_integrate(struct zsl_quat *q, struct zsl_vec *w, zsl_real_t dt,
+		       struct zsl_quat *qi);
+
+/**
+ * @brief Prepares 's' to integrate angular velocities from 'q' via
+ *        @ref zsl_quat_integ_step, renormalising every 'renorm' steps.
+ *
+ * @param s         The integrator state to initialise.
+ * @param q         The starting unit quaternion.
+ * @param renorm    Renormalise after this many steps, or 0 to never
+ *                  renormalise.
+ *
+ * @return 0 if everything executed normally, or a negative error code.
+ */
+int zsl_quat_integ_init(struct zsl_quat_integ *s, struct zsl_quat *q,
+			size_t renorm);
+
+/**
+ * @brief Integrates 'w' over 'dt' seconds into s->q, as per
+ *        @ref zsl_quat_integrate.
+ *
+ * @param s     The integrator state.
+ * @param w     The angular velocity 3-vector, in rad/s.
+ * @param dt    The time step, in seconds.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'w' is not a
+ *         3-vector.
+ */
+int zsl_quat_integ_step(struct zsl_quat_integ *s, struct zsl_vec *w,
+			zsl_real_t dt);
+
 /**
  * @brief Converts a unit quaternion to it's equivalent Euler angle. Euler
  *        values expressed in radians.
  *
+ * The angles follow the Z-Y-X (yaw, pitch, roll) sequence, with 'x' holding
+ * the roll, 'y' the pitch and 'z' the yaw, matching @ref zsl_att_from_euler.
+ *
  * @param q 	Pointer to the unit quaternion to convert.
  * @param e 	Pointer to the Euler angle placeholder. Expressed in radians.
  *
@@ -364,6 +584,30 @@ int zsl_quat_to_euler(struct zsl_quat *q, struct zsl_euler *e);
  */
 int zsl_quat_from_euler(struct zsl_euler *e, struct zsl_quat *q);
 
+/**
+ * @brief Converts a unit quaternion to its 3x3 rotation matrix, stored as a
+ *        row-major array of 9 values.
+ *
+ * Unlike @ref zsl_quat_to_rot_mtx this performs no size checks, and shares
+ * the products between terms, taking 12 multiplies.
+ *
+ * @param q 	Pointer to the unit quaternion to convert.
+ * @param m 	Pointer to the 9-element output array.
+ */
+void zsl_quat_to_rot_mtx33(const struct zsl_quat *q, zsl_real_t *m);
+
+/**
+ * @brief Converts a 3x3 rotation matrix, stored as a row-major array of 9
+ *        values, to its equivalent unit quaternion, with r >= 0.
+ *
+ * The largest of the four components is solved for first, so the result
+ * stays accurate for rotations near 180 degrees.
+ *
+ * @param m 	Pointer to the 9-element rotation matrix.
+ * @param q 	Pointer to the output unit quaternion.
+ */
+void zsl_quat_from_rot_mtx33(const zsl_real_t *m, struct zsl_quat *q);
+
 /**
  * @brief Converts a unit quaternion to it's equivalent rotation matrix.
  *
@@ -384,6 +628,49 @@ int zsl_quat_to_rot_mtx(struct zsl_quat *q, struct zsl_mtx *m);
  */
 int zsl_quat_from_rot_mtx(struct zsl_mtx *m, struct zsl_quat *q);
 
+/**
+ * @brief Copies quaternion 'idx' of batch 'qb' into 'q'.
+ *
+ * @param qb    The quaternion batch.
+ * @param idx   The index of the quaternion in the batch (0-based).
+ * @param q     The output quaternion.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'idx' is out of
+ *         range.
+ */
+int zsl_quat_batch_get(struct zsl_quat_batch *qb, size_t idx,
+		       struct zsl_quat *q);
+
+/**
+ * @brief Copies quaternion 'q' into position 'idx' of batch 'qb'.
+ *
+ * @param qb    The quaternion batch.
+ * @param idx   The index of the quaternion in the batch (0-based).
+ * @param q     The input quaternion.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'idx' is out of
+ *         range.
+ */
+int zsl_quat_batch_set(struct zsl_quat_batch *qb, size_t idx,
+		       struct zsl_quat *q);
+
+/**
+ * @brief Multiplies each quaternion in batch 'qa' by the matching quaternion
+ *        in batch 'qb' (a * b), storing the results in 'qm'.
+ *
+ * This is equivalent to calling @ref zsl_quat_mult once per quaternion, but
+ * the components are processed as unit-stride arrays across the batch.
+ *
+ * @param qa    The first input batch.
+ * @param qb    The second input batch.
+ * @param qm    The output batch. This must not be 'qa' or 'qb'.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if the batches are
+ *         different sizes.
+ */
+int zsl_quat_batch_mult(struct zsl_quat_batch *qa, struct zsl_quat_batch *qb,
+			struct zsl_quat_batch *qm);
+
 /** @} */ /* End of QUAT_FUNCTIONS group */
 
 /** @} */ /* End of QUATERNIONS group */
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup PACKED Packed Matrices
+ *
+ * @brief Symmetric and triangular matrices in packed storage.
+ *
+ * Covariance matrices, Cholesky factors and the R of a QR decomposition
+ * only have n * (n + 1) / 2 distinct or non-zero entries, so storing them
+ * as a dense @ref zsl_mtx wastes nearly half the memory. A packed matrix
+ * stores only one triangle, row by row, as in the LAPACK packed formats:
+ *
+ * - Lower triangle: entry (i, j), j <= i, is at data[i * (i + 1) / 2 + j].
+ * - Upper triangle: entry (i, j), j >= i, is at
+ *   data[i * (2 * n - i + 1) / 2 + j - i].
+ *
+ * Each row of the stored triangle is contiguous. Symmetric matrices store
+ * their lower triangle, so a symmetric matrix and its lower Cholesky factor
+ * have the same layout, and the factorisation can be done in place.
+ *
+ * The functions below work on the packed data directly, without expanding
+ * it into a dense matrix.
+ */
+
+/**
+ * @file
+ * @brief API header file for packed matrices in zscilib.
+ *
+ * This file contains the zscilib packed matrix APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_PACKED_H_
+#define ZEPHYR_INCLUDE_ZSL_PACKED_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup PKMTX_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with packed matrices.
+ *
+ * @ingroup PACKED
+ *  @{ */
+
+/** @brief The kinds of matrix that can be held in packed storage. */
+enum zsl_pkmtx_type {
+	/** Symmetric, with the lower triangle stored. */
+	ZSL_PKMTX_SYM           = 0,
+	/** Lower triangular, with zeros above the diagonal. */
+	ZSL_PKMTX_LOWER         = 1,
+	/** Upper triangular, with zeros below the diagonal. */
+	ZSL_PKMTX_UPPER         = 2,
+};
+
+/** @brief Represents a n x n symmetric or triangular matrix, stored in
+ *         packed form. */
+struct zsl_pkmtx {
+	/** The number of rows and columns in the matrix. */
+	size_t sz;
+	/** The kind of matrix, which selects the triangle stored. */
+	enum zsl_pkmtx_type type;
+	/** The n * (n + 1) / 2 stored entries, row by row. */
+	zsl_real_t *data;
+};
+
+/** Returns the number of entries stored for a n x n packed matrix. */
+#define ZSL_PKMTX_SZ(n) ((n) * ((n) + 1) / 2)
+
+/**
+ * Macro to declare a n x n packed matrix of type 't'.
+ *
+ * Be sure to also call 'zsl_pkmtx_init' on the matrix after this macro,
+ * since matrices declared on the stack may have non-zero values by default!
+ */
+#define ZSL_PKMATRIX_DEF(name, n, t)				\
+	zsl_real_t name ## _pkmtx[ZSL_PKMTX_SZ(n)];		\
+	struct zsl_pkmtx name = {				\
+		.sz = n,					\
+		.type = t,					\
+		.data = name ## _pkmtx				\
+	}
+
+/** @} */ /* End of PKMTX_STRUCTS group */
+
+/**
+ * @addtogroup PKMTX_FUNCS Functions
+ *
+ * @brief Functions used to create, convert and operate on packed matrices.
+ *
+ * @ingroup PACKED
+ *  @{ */
+
+/**
+ * @brief Sets every entry of packed matrix 'p' to zero.
+ *
+ * @param p     The packed matrix to initialise.
+ *
+ * @return 0 on success.
+ */
+int zsl_pkmtx_init(struct zsl_pkmtx *p);
+
+/**
+ * @brief Packs the stored triangle of dense matrix 'm' into 'p'. Entries
+ *        of 'm' outside that triangle aren't read.
+ *
+ * @param m     The dense n x n input matrix.
+ * @param p     The packed output matrix, whose type selects the triangle.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' isn't
+ *          n x n.
+ */
+int zsl_pkmtx_from_mtx(const struct zsl_mtx *m, struct zsl_pkmtx *p);
+
+/**
+ * @brief Expands packed matrix 'p' into dense matrix 'm', mirroring the
+ *        stored triangle for symmetric matrices, and filling the other
+ *        triangle with zeros for triangular matrices.
+ *
+ * @param p     The packed input matrix.
+ * @param m     The dense n x n output matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' isn't
+ *          n x n.
+ */
+int zsl_pkmtx_to_mtx(const struct zsl_pkmtx *p, struct zsl_mtx *m);
+
+/**
+ * @brief Gets the value of the entry at row 'i' and column 'j' of 'p'.
+ *
+ * @param p     The packed matrix.
+ * @param i     The row number (zero-based).
+ * @param j     The column number (zero-based).
+ * @param x     Pointer to the output value, which is 0.0 outside the
+ *              stored triangle of a triangular matrix.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'i' or 'j' are
+ *          out of range.
+ */
+int zsl_pkmtx_get(const struct zsl_pkmtx *p, size_t i, size_t j,
+		  zsl_real_t *x);
+
+/**
+ * @brief Sets the entry at row 'i' and column 'j' of 'p' to 'x'. Setting
+ *        (i, j) of a symmetric matrix also sets (j, i).
+ *
+ * @param p     The packed matrix.
+ * @param i     The row number (zero-based).
+ * @param j     The column number (zero-based).
+ * @param x     The value to assign.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'i' or 'j' are
+ *          out of range, or outside the stored triangle of a triangular
+ *          matrix.
+ */
+int zsl_pkmtx_set(struct zsl_pkmtx *p, size_t i, size_t j, zsl_real_t x);
+
+/**
+ * @brief Multiplies packed matrix 'p' by vector 'v', assigning the output
+ *        to 'w' (w = p * v).
+ *
+ * @param p     The n x n packed matrix.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size n. This must not be 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL on a size
+ *          mismatch.
+ */
+int zsl_pkmtx_mult_vec(const struct zsl_pkmtx *p, const struct zsl_vec *v,
+		       struct zsl_vec *w);
+
+/**
+ * @brief Multiplies packed matrix 'p' by dense matrix 'mb', assigning the
+ *        output to dense matrix 'mc' (mc = p * mb).
+ *
+ * @param p     The n x n packed matrix.
+ * @param mb    The n x k dense matrix.
+ * @param mc    The n x k dense output matrix. This must not be 'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          are not compatibly shaped.
+ */
+int zsl_pkmtx_mult_mtx(const struct zsl_pkmtx *p, const struct zsl_mtx *mb,
+		       struct zsl_mtx *mc);
+
+/**
+ * @brief Computes the symmetric product f * p * f^T of dense matrix 'f' and
+ *        symmetric packed matrix 'p', such as the covariance prediction of
+ *        a Kalman filter, storing only its lower triangle in 'po'.
+ *
+ * Each row of f * p is formed in turn and multiplied by the rows of 'f',
+ * so the temporary memory needed is a single row of n entries, rather than
+ * a dense m x n product.
+ *
+ * @param f     The m x n dense matrix.
+ * @param p     The n x n symmetric packed matrix.
+ * @param po    The m x m symmetric packed output matrix. This must not be
+ *              'p'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices
+ *          aren't compatibly shaped or symmetric, or -ENOMEM if no scratch
+ *          memory was available.
+ */
+int zsl_pkmtx_congruence(const struct zsl_mtx *f, const struct zsl_pkmtx *p,
+			 struct zsl_pkmtx *po);
+
+/**
+ * @brief Adds alpha * v * v^T to symmetric packed matrix 'p' in place.
+ *
+ * @param p     The n x n symmetric packed matrix to update.
+ * @param alpha The scale factor applied to the outer product.
+ * @param v     The update vector, of size n.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'p' isn't
+ *          symmetric, or 'v' doesn't have n elements.
+ */
+int zsl_pkmtx_rank1(struct zsl_pkmtx *p, zsl_real_t alpha,
+		    const struct zsl_vec *v);
+
+/**
+ * @brief Solves p * x = b for triangular packed matrix 'p', by forward or
+ *        back substitution.
+ *
+ * @param p     The n x n lower or upper triangular packed matrix.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution vector, of size n. This may be 'b'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'p' isn't
+ *          triangular or 'b' and 'x' don't have n elements, or -ESINGULAR
+ *          if the diagonal of 'p' contains a zero.
+ */
+int zsl_pkmtx_trsv(const struct zsl_pkmtx *p, const struct zsl_vec *b,
+		   struct zsl_vec *x);
+
+/**
+ * @brief Calculates the Cholesky decomposition of symmetric
+ *        positive-definite packed matrix 'p', such that p = L * L^T.
+ *
+ * The symmetric input and the lower triangular output have the same
+ * layout, so 'l' may point to the same data as 'p' to factor in place.
+ *
+ * @param p     The n x n symmetric positive-definite packed matrix.
+ * @param l     The n x n lower triangular packed output matrix. Its type is
+ *              set to ZSL_PKMTX_LOWER.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'p' isn't
+ *          symmetric or 'l' isn't the same size, or -ENOTPOSDEF if 'p'
+ *          isn't positive-definite.
+ */
+int zsl_pkmtx_cholesky(const struct zsl_pkmtx *p, struct zsl_pkmtx *l);
+
+/**
+ * @brief Solves L * L^T * x = b for x, given the lower triangular packed
+ *        Cholesky factor 'l' calculated by @ref zsl_pkmtx_cholesky.
+ *
+ * @param l     The n x n lower triangular packed Cholesky factor.
+ * @param b     The right-hand side vector, of size n.
+ * @param x     The output solution vector, of size n. This may be 'b'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'l' isn't
+ *          lower triangular or 'b' and 'x' don't have n elements.
+ */
+int zsl_pkmtx_chol_solve(const struct zsl_pkmtx *l, const struct zsl_vec *b,
+			 struct zsl_vec *x);
+
+/**
+ * @brief Updates the lower triangular packed Cholesky factor 'l' in place,
+ *        so that it becomes the factor of L * L^T + v * v^T. This is the
+ *        packed equivalent of @ref zsl_mtx_chol_update.
+ *
+ * @param l     The n x n lower triangular packed Cholesky factor to update.
+ * @param v     The update vector, of size n.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'l' isn't lower
+ *          triangular or 'v' doesn't have n elements, or -ENOMEM if no
+ *          scratch memory was available.
+ */
+int zsl_pkmtx_chol_update(struct zsl_pkmtx *l, const struct zsl_vec *v);
+
+/** @} */ /* End of PKMTX_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_PACKED_H_ */
+
+/** @} */ /* End of PACKED group */
@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_ATOMIC_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -98,6 +99,23 @@ int zsl_phy_atom_bohr_orb_ener(uint8_t z, uint8_t n, zsl_real_t *e);
 int zsl_phy_atom_rad_decay(zsl_real_t qi, zsl_real_t t, zsl_real_t lambda,
 			   zsl_real_t *qf);
 
+/**
+ * @brief Calculates @ref zsl_phy_atom_rad_decay at the times t0 + k * dt,
+ *        for k = 0 to qf->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * @param qi      Initial radioactive activity in becquerels.
+ * @param t0      Time of the first sample in seconds.
+ * @param dt      Time between samples in seconds.
+ * @param lambda  Radioactive decay constant defined as nuclear desintegrations
+ *                per second.
+ * @param qf      The output radioactivity in becquerels at each time. Will be
+ *                set to NAN if either lambda or the times are negative.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_atom_rad_decay_vec(zsl_real_t qi, zsl_real_t t0, zsl_real_t dt,
+			       zsl_real_t lambda, struct zsl_vec *qf);
+
 /**
  * @brief Calculates the average distance in meters between the atoms of a
  *        crystalline system according to the Bragg's condition of constructive
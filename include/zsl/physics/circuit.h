@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup CIRCUIT Circuit Solver
+ *
+ * @brief Linear circuit solver using modified nodal analysis (MNA).
+ *
+ * @ingroup PHYSICS
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for the circuit solver in zscilib.
+ *
+ * This file contains the zscilib circuit solver APIs.
+ *
+ * A circuit is a set of resistors, capacitors, inductors and independent
+ * voltage and current sources connected between numbered nodes, where node
+ * 0 is ground. Each node voltage, and the current through each voltage
+ * source and inductor, is an unknown of the MNA system, which is built
+ * from the element stamps and solved with partial-pivoting LU.
+ *
+ * @ref zsl_phy_circ_dc finds the DC operating point, with capacitors open
+ * and inductors shorted. @ref zsl_phy_circ_step then advances the circuit
+ * in time with the trapezoidal rule, in which each capacitor and inductor
+ * is replaced by a conductance and a source that depends on its previous
+ * state. The matrix only depends on the element values and the step size,
+ * so it is factored once and every further step with the same step size
+ * costs one O(n^2) forward and back substitution. Source values can be
+ * changed between steps without refactoring. The first step after a change
+ * is taken as two backward Euler half steps, which use the same matrix, to
+ * avoid the ringing that the trapezoidal rule shows after a sudden change.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_CIRCUIT_H_
+#define ZEPHYR_INCLUDE_ZSL_CIRCUIT_H_
+
+#include <stdbool.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The types of circuit element.
+ */
+enum zsl_phy_circ_type {
+	/** @brief A resistor, with a value in ohms. */
+	ZSL_PHY_CIRC_R,
+	/** @brief A capacitor, with a value in farads. */
+	ZSL_PHY_CIRC_C,
+	/** @brief An inductor, with a value in henries. */
+	ZSL_PHY_CIRC_L,
+	/** @brief A voltage source, with the voltage of 'a' over 'b'. */
+	ZSL_PHY_CIRC_V,
+	/**
+	 * @brief A current source, with the current in amperes that it drives
+	 *        out of node 'b' and into node 'a' through the circuit.
+	 */
+	ZSL_PHY_CIRC_I,
+};
+
+/**
+ * @brief A circuit element between nodes 'a' and 'b'.
+ */
+struct zsl_phy_circ_elem {
+	/** @brief The element type. */
+	enum zsl_phy_circ_type type;
+	/** @brief The first node. */
+	size_t a;
+	/** @brief The second node. */
+	size_t b;
+	/** @brief The element value, in the units given by 'type'. */
+	zsl_real_t val;
+	/** @brief The index of the branch current unknown, for V and L. */
+	size_t br;
+	/** @brief The voltage of 'a' over 'b' at the last solution. */
+	zsl_real_t v;
+	/** @brief The current from 'a' to 'b' at the last solution. */
+	zsl_real_t i;
+};
+
+/**
+ * @brief A circuit and its solver storage. Declare with
+ *        @ref ZSL_PHY_CIRC_DEF, and add elements with
+ *        @ref zsl_phy_circ_add.
+ */
+struct zsl_phy_circ {
+	/** @brief The number of nodes, not counting ground. */
+	size_t nodes;
+	/** @brief The number of entries in 'elem'. */
+	size_t sz_elem;
+	/** @brief The number of elements added. */
+	size_t n_elem;
+	/** @brief The elements. */
+	struct zsl_phy_circ_elem *elem;
+	/** @brief The maximum number of unknowns. */
+	size_t sz;
+	/** @brief The number of unknowns: the nodes, plus one per V and L. */
+	size_t n;
+	/** @brief 'sz' x 'sz' entries for the LU factors of the system. */
+	zsl_real_t *lu;
+	/** @brief 'sz' entries for the row permutation of the factors. */
+	zsl_real_t *perm;
+	/** @brief 'sz' entries for the right-hand side. */
+	zsl_real_t *rhs;
+	/** @brief 'sz' entries for the last solution. */
+	zsl_real_t *x;
+	/** @brief The step size that 'lu' was factored for, 0 for DC. */
+	zsl_real_t h;
+	/** @brief Whether 'lu' holds the factors for the current elements. */
+	bool valid;
+	/** @brief Whether the elements have changed since the last solution. */
+	bool restart;
+};
+
+/**
+ * Macro to declare a circuit with 'nn' nodes (not counting ground), room
+ * for 'ne' elements, and room for 'nb' voltage sources and inductors in
+ * total.
+ */
+#define ZSL_PHY_CIRC_DEF(name, nn, ne, nb)				\
+	static struct zsl_phy_circ_elem name ## _elem[ne];		\
+	static zsl_real_t name ## _lu[((nn) + (nb)) * ((nn) + (nb))];	\
+	static zsl_real_t name ## _vec[4 * ((nn) + (nb))];		\
+	struct zsl_phy_circ name = {					\
+		.nodes = nn,						\
+		.sz_elem = ne,						\
+		.n_elem = 0,						\
+		.elem = name ## _elem,					\
+		.sz = (nn) + (nb),					\
+		.n = nn,						\
+		.lu = name ## _lu,					\
+		.perm = name ## _vec,					\
+		.rhs = name ## _vec + (nn) + (nb),			\
+		.x = name ## _vec + 2 * ((nn) + (nb)),			\
+		.h = 0.0,						\
+		.valid = false,						\
+		.restart = true						\
+	}
+
+/**
+ * @brief Adds an element to a circuit.
+ *
+ * @param c     The circuit.
+ * @param type  The element type.
+ * @param a     The first node, from 0 (ground) to c->nodes.
+ * @param b     The second node, from 0 (ground) to c->nodes.
+ * @param val   The element value, which must be positive for resistors,
+ *              capacitors and inductors.
+ *
+ * @return The index of the new element, -EINVAL if a node or the value is
+ *         out of range, or -ENOMEM if the circuit is full.
+ */
+int zsl_phy_circ_add(struct zsl_phy_circ *c, enum zsl_phy_circ_type type,
+		     size_t a, size_t b, zsl_real_t val);
+
+/**
+ * @brief Changes the value of an element. Changing a resistor, capacitor
+ *        or inductor causes the system to be factored again at the next
+ *        solve, but changing a source does not.
+ *
+ * @param c     The circuit.
+ * @param e     The element index, from @ref zsl_phy_circ_add.
+ * @param val   The new value.
+ *
+ * @return 0 on success, or -EINVAL if 'e' or the value is out of range.
+ */
+int zsl_phy_circ_set(struct zsl_phy_circ *c, size_t e, zsl_real_t val);
+
+/**
+ * @brief Solves for the DC operating point, with capacitors open and
+ *        inductors shorted, and uses it as the initial state for
+ *        @ref zsl_phy_circ_step.
+ *
+ * @param c     The circuit.
+ *
+ * @return 0 on success, or -ESINGULAR if the circuit has no unique DC
+ *         solution, for example if a node is only connected through
+ *         capacitors.
+ */
+int zsl_phy_circ_dc(struct zsl_phy_circ *c);
+
+/**
+ * @brief Advances the circuit by one time step with the trapezoidal rule,
+ *        starting from the last solution.
+ *
+ * @param c     The circuit.
+ * @param h     The step size in seconds.
+ *
+ * @return 0 on success, -EINVAL if 'h' is not positive, or -ESINGULAR if
+ *         the system is singular.
+ */
+int zsl_phy_circ_step(struct zsl_phy_circ *c, zsl_real_t h);
+
+/**
+ * @brief Gets the voltage of a node at the last solution.
+ *
+ * @param c     The circuit.
+ * @param node  The node, from 0 (ground) to c->nodes.
+ * @param v     Pointer to the output voltage in volts.
+ *
+ * @return 0 on success, or -EINVAL if 'node' is out of range.
+ */
+int zsl_phy_circ_volt(struct zsl_phy_circ *c, size_t node, zsl_real_t *v);
+
+/**
+ * @brief Gets the current through an element at the last solution, from
+ *        node 'a' to node 'b' through the element.
+ *
+ * @param c     The circuit.
+ * @param e     The element index, from @ref zsl_phy_circ_add.
+ * @param i     Pointer to the output current in amperes.
+ *
+ * @return 0 on success, or -EINVAL if 'e' is out of range.
+ */
+int zsl_phy_circ_curr(struct zsl_phy_circ *c, size_t e, zsl_real_t *i);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_CIRCUIT_H_ */
+
+/** @} */ /* End of circuit group */
@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_ELEC_COMPS_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -128,6 +129,20 @@ int zsl_phy_ecmp_rlc_volt(zsl_real_t vr, zsl_real_t vl, zsl_real_t vc,
 int zsl_phy_ecmp_rc_charg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			    zsl_real_t i0, zsl_real_t *i);
 
+/**
+ * @brief Calculates @ref zsl_phy_ecmp_rc_charg_i at the times t0 + k * dt,
+ *        for k = 0 to i->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * The other parameters and the validation are as per
+ * @ref zsl_phy_ecmp_rc_charg_i, with the current in amperes at each time
+ * written to 'i'.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_ecmp_rc_charg_i_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+				zsl_real_t dt, zsl_real_t i0,
+				struct zsl_vec *i);
+
 /**
  * @brief Calculates the electric charge in coulombs of a capacitor in a RC
  *        circuit during its charging phase.
@@ -145,6 +160,20 @@ int zsl_phy_ecmp_rc_charg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 int zsl_phy_ecmp_rc_charg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			    zsl_real_t q0, zsl_real_t *q);
 
+/**
+ * @brief Calculates @ref zsl_phy_ecmp_rc_charg_q at the times t0 + k * dt,
+ *        for k = 0 to q->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * The other parameters and the validation are as per
+ * @ref zsl_phy_ecmp_rc_charg_q, with the charge in coulombs at each time
+ * written to 'q'.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_ecmp_rc_charg_q_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+				zsl_real_t dt, zsl_real_t q0,
+				struct zsl_vec *q);
+
 /**
  * @brief Calculates the electric current of a capacitor in a RC circuit
  *        during its discharging phase.
@@ -162,6 +191,20 @@ int zsl_phy_ecmp_rc_charg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 int zsl_phy_ecmp_rc_discharg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			       zsl_real_t i0, zsl_real_t *i);
 
+/**
+ * @brief Calculates @ref zsl_phy_ecmp_rc_discharg_i at the times t0 + k *
+ *        dt, for k = 0 to i->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * The other parameters and the validation are as per
+ * @ref zsl_phy_ecmp_rc_discharg_i, with the current in amperes at each time
+ * written to 'i'.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_ecmp_rc_discharg_i_vec(zsl_real_t r, zsl_real_t c,
+				   zsl_real_t t0, zsl_real_t dt,
+				   zsl_real_t i0, struct zsl_vec *i);
+
 /**
  * @brief Calculates the electric charge in coulombs of a capacitor in a RC
  *        circuit during its discharging phase.
@@ -179,6 +222,20 @@ int zsl_phy_ecmp_rc_discharg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 int zsl_phy_ecmp_rc_discharg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			       zsl_real_t q0, zsl_real_t *q);
 
+/**
+ * @brief Calculates @ref zsl_phy_ecmp_rc_discharg_q at the times t0 + k *
+ *        dt, for k = 0 to q->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * The other parameters and the validation are as per
+ * @ref zsl_phy_ecmp_rc_discharg_q, with the charge in coulombs at each time
+ * written to 'q'.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_ecmp_rc_discharg_q_vec(zsl_real_t r, zsl_real_t c,
+				   zsl_real_t t0, zsl_real_t dt,
+				   zsl_real_t q0, struct zsl_vec *q);
+
 /**
  * @brief Calculates the electric current in amperes of a RL circuit in time.
  *
@@ -195,6 +252,20 @@ int zsl_phy_ecmp_rc_discharg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 int zsl_phy_ecmp_rl_current(zsl_real_t r, zsl_real_t l, zsl_real_t t,
 			    zsl_real_t i0, zsl_real_t *i);
 
+/**
+ * @brief Calculates @ref zsl_phy_ecmp_rl_current at the times t0 + k * dt,
+ *        for k = 0 to i->sz - 1, with @ref zsl_phy_misc_exp_curve.
+ *
+ * The other parameters and the validation are as per
+ * @ref zsl_phy_ecmp_rl_current, with the current in amperes at each time
+ * written to 'i'.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_ecmp_rl_current_vec(zsl_real_t r, zsl_real_t l, zsl_real_t t0,
+				zsl_real_t dt, zsl_real_t i0,
+				struct zsl_vec *i);
+
 #ifdef __cplusplus
 }
 #endif
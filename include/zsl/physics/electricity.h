@@ -123,6 +123,21 @@ int zsl_phy_elcty_resistivity(zsl_real_t r, zsl_real_t a, zsl_real_t l,
  */
 int zsl_phy_elcty_ohm_law(zsl_real_t i, zsl_real_t r, zsl_real_t *v);
 
+/**
+ * @brief Calculates @ref zsl_phy_elcty_ohm_law for each element of the
+ *        equal-sized input vectors, in a single branch-free pass.
+ *
+ * @param i    Electric currents in amperes.
+ * @param r    Resistances in ohms.
+ * @param v    The output voltages in volts, which may be one of the inputs.
+ *             Entries with a negative resistance are set to NAN.
+ *
+ * @return 0 on success, or -EINVAL if any resistance is negative or the
+ *         vectors are not the same size.
+ */
+int zsl_phy_elcty_ohm_law_vec(struct zsl_vec *i, struct zsl_vec *r,
+			      struct zsl_vec *v);
+
 /**
  * @brief Calculates the electric power based on the voltage (v) and electric
  * 		  current (i).
@@ -136,6 +151,20 @@ int zsl_phy_elcty_ohm_law(zsl_real_t i, zsl_real_t r, zsl_real_t *v);
  */
 int zsl_phy_elcty_power_vi(zsl_real_t v, zsl_real_t i, zsl_real_t *p);
 
+/**
+ * @brief Calculates @ref zsl_phy_elcty_power_vi for each element of the
+ *        equal-sized input vectors.
+ *
+ * @param v    Voltages in volts.
+ * @param i    Electric currents in amperes.
+ * @param p    The output electric powers in watts, which may be one of the
+ *             inputs.
+ *
+ * @return 0 on success, or -EINVAL if the vectors are not the same size.
+ */
+int zsl_phy_elcty_power_vi_vec(struct zsl_vec *v, struct zsl_vec *i,
+			       struct zsl_vec *p);
+
 /**
  * @brief Calculates the electric power based on the electric current (i) and
  * 		  the resistance (r).
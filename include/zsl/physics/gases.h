@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_GASES_H_
 
 #include <zsl/zsl.h>
+#include <zsl/interp.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +91,164 @@ int zsl_phy_gas_boyle(zsl_real_t pi, zsl_real_t vi, zsl_real_t pf,
 int zsl_phy_gas_charles_lussac(zsl_real_t ti, zsl_real_t vi, zsl_real_t tf,
 			       zsl_real_t *vf);
 
+/**
+ * @brief Calculates the mole fraction of water vapour in moist air, using
+ *        the CIPM-2007 saturation vapour pressure and enhancement factor.
+ *
+ * @param t    Temperature in kelvins.
+ * @param p    Pressure in pascals.
+ * @param rh   Relative humidity, from 0.0 (dry air) to 1.0.
+ * @param x    Pointer to the output mole fraction. Will be set to NAN if the
+ *             temperature or pressure are not positive, or the relative
+ *             humidity is out of range.
+ *
+ * @return 0 on success, and non-zero error code on failure.
+ */
+int zsl_phy_gas_air_xv(zsl_real_t t, zsl_real_t p, zsl_real_t rh,
+		       zsl_real_t *x);
+
+/**
+ * @brief Calculates the density of moist air with the CIPM-2007 equation,
+ *        including the enhancement factor and compressibility of real air.
+ *
+ * @param t    Temperature in kelvins.
+ * @param p    Pressure in pascals.
+ * @param rh   Relative humidity, from 0.0 (dry air) to 1.0.
+ * @param d    Pointer to the output density in kilograms per cubic meter.
+ *             Will be set to NAN if the temperature or pressure are not
+ *             positive, or the relative humidity is out of range.
+ *
+ * @return 0 on success, and non-zero error code on failure.
+ */
+int zsl_phy_gas_air_dens(zsl_real_t t, zsl_real_t p, zsl_real_t rh,
+			 zsl_real_t *d);
+
+/**
+ * @brief Calculates the dynamic viscosity of air with Sutherland's law.
+ *
+ * @param t    Temperature in kelvins.
+ * @param mu   Pointer to the output viscosity in pascal seconds. Will be set
+ *             to NAN if the temperature is not positive.
+ *
+ * @return 0 on success, and non-zero error code on failure.
+ */
+int zsl_phy_gas_air_visc(zsl_real_t t, zsl_real_t *mu);
+
+/**
+ * @brief A gas property as a function of temperature and pressure, such as
+ *        @ref zsl_phy_gas_air_dens_fn. 'arg' is passed through from
+ *        @ref zsl_phy_gas_cache_init.
+ */
+typedef int (*zsl_phy_gas_prop_fn_t)(zsl_real_t t, zsl_real_t p, void *arg,
+				     zsl_real_t *v);
+
+/**
+ * @brief @ref zsl_phy_gas_air_dens as a property function, with 'arg'
+ *        pointing to the relative humidity, or NULL for dry air.
+ */
+int zsl_phy_gas_air_dens_fn(zsl_real_t t, zsl_real_t p, void *arg,
+			    zsl_real_t *v);
+
+/**
+ * @brief @ref zsl_phy_gas_air_visc as a property function. 'p' and 'arg'
+ *        are ignored.
+ */
+int zsl_phy_gas_air_visc_fn(zsl_real_t t, zsl_real_t p, void *arg,
+			    zsl_real_t *v);
+
+/**
+ * @brief A gas property sampled on a uniform temperature and pressure grid,
+ *        so that it can be looked up in constant time instead of being
+ *        evaluated from its formula. Declare with
+ *        @ref ZSL_PHY_GAS_CACHE_DEF and fill with
+ *        @ref zsl_phy_gas_cache_init.
+ *
+ * Lookups keep the last cell in 'grid', so a cache should only be used from
+ * one thread at a time.
+ */
+struct zsl_phy_gas_cache {
+	/** @brief The 2D table, over temperature (x) and pressure (y). */
+	struct zsl_interp_grid2 grid;
+	/** @brief Storage for the 'nt' temperatures. */
+	zsl_real_t *t;
+	/** @brief The number of temperatures (min two!). */
+	size_t nt;
+	/** @brief Storage for the 'np' pressures. */
+	zsl_real_t *p;
+	/** @brief The number of pressures (min two!). */
+	size_t np;
+	/** @brief Storage for the 'nt' * 'np' property values. */
+	zsl_real_t *v;
+};
+
+/**
+ * Macro to declare a property cache with 'len_t' temperatures and 'len_p'
+ * pressures.
+ */
+#define ZSL_PHY_GAS_CACHE_DEF(name, len_t, len_p)			\
+	static zsl_real_t name ## _t[len_t];				\
+	static zsl_real_t name ## _p[len_p];				\
+	static zsl_real_t name ## _v[(len_t) * (len_p)];		\
+	struct zsl_phy_gas_cache name = {				\
+		.t = name ## _t,					\
+		.nt = len_t,						\
+		.p = name ## _p,					\
+		.np = len_p,						\
+		.v = name ## _v						\
+	}
+
+/**
+ * @brief Fills a property cache by evaluating 'fn' on a uniform grid from
+ *        't0' to 't1' kelvins and 'p0' to 'p1' pascals.
+ *
+ * @param c    The cache.
+ * @param fn   The property function.
+ * @param arg  Passed through to 'fn'.
+ * @param t0   The lowest temperature in kelvins.
+ * @param t1   The highest temperature in kelvins.
+ * @param p0   The lowest pressure in pascals.
+ * @param p1   The highest pressure in pascals.
+ *
+ * @return 0 on success, -EINVAL if a range is empty or the cache has fewer
+ *         than two points on an axis, or the error from 'fn' if it fails
+ *         within the range.
+ */
+int zsl_phy_gas_cache_init(struct zsl_phy_gas_cache *c,
+			   zsl_phy_gas_prop_fn_t fn, void *arg, zsl_real_t t0,
+			   zsl_real_t t1, zsl_real_t p0, zsl_real_t p1);
+
+/**
+ * @brief Looks up a property in a cache with bicubic interpolation.
+ *
+ * @param c    The cache, filled by @ref zsl_phy_gas_cache_init.
+ * @param t    Temperature in kelvins.
+ * @param p    Pressure in pascals.
+ * @param v    Pointer to the output property value. Will be set to NAN if
+ *             't' or 'p' is outside the cache.
+ *
+ * @return 0 on success, and -EINVAL if 't' or 'p' is outside the cache.
+ */
+int zsl_phy_gas_cache_get(struct zsl_phy_gas_cache *c, zsl_real_t t,
+			  zsl_real_t p, zsl_real_t *v);
+
+/**
+ * @brief Looks up a property in a cache at 'count' points (t[k], p[k]), as
+ *        per @ref zsl_phy_gas_cache_get.
+ *
+ * @param c     The cache, filled by @ref zsl_phy_gas_cache_init.
+ * @param t     The 'count' temperatures in kelvins.
+ * @param p     The 'count' pressures in pascals.
+ * @param v     The 'count' output property values.
+ * @param count The number of points.
+ *
+ * @return 0 on success, or -EINVAL if any point is outside the cache, in
+ *         which case its value is set to NAN and the others are still
+ *         looked up.
+ */
+int zsl_phy_gas_cache_get_batch(struct zsl_phy_gas_cache *c,
+				const zsl_real_t *t, const zsl_real_t *p,
+				zsl_real_t *v, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_GRAVITATION_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -102,6 +103,22 @@ int zsl_phy_grav_orb_vel(zsl_real_t mp, zsl_real_t r, zsl_real_t *v);
 int zsl_phy_grav_force(zsl_real_t m1, zsl_real_t m2, zsl_real_t r,
 		       zsl_real_t *f);
 
+/**
+ * @brief Calculates @ref zsl_phy_grav_force for each element of the
+ *        equal-sized input vectors, in a single branch-free pass.
+ *
+ * @param m1        Masses of the first objects in kilograms.
+ * @param m2        Masses of the second objects in kilograms.
+ * @param r         Distances between the objects in meters.
+ * @param f         The output forces in newtons, which may be one of the
+ *                  inputs. Entries with a zero distance are set to NAN.
+ *
+ * @return 0 on success, or -EINVAL if any distance is zero or the vectors
+ *         are not the same size.
+ */
+int zsl_phy_grav_force_vec(struct zsl_vec *m1, struct zsl_vec *m2,
+			   struct zsl_vec *r, struct zsl_vec *f);
+
 /**
  * @brief Calculates the gravitational potential energy between two objects in
  *        kilojoules based on their masses (m1 and m2) and the distance they are
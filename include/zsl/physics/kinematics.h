@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_KINEMATICS_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,22 @@ extern "C" {
 int zsl_phy_kin_dist(zsl_real_t vi, zsl_real_t time, zsl_real_t accel,
 		     zsl_real_t *dist);
 
+/**
+ * @brief Calculates @ref zsl_phy_kin_dist for each element of the
+ *        equal-sized input vectors, in a single branch-free pass.
+ *
+ * @param vi    Initial velocities in meters per second.
+ * @param time  Times in seconds.
+ * @param accel Accelerations in meters per second squared.
+ * @param dist  The output distances in meters, which may be one of the
+ *              inputs. Entries with a negative time are set to NAN.
+ *
+ * @return 0 on success, or -EINVAL if any time is negative or the vectors
+ *         are not the same size.
+ */
+int zsl_phy_kin_dist_vec(struct zsl_vec *vi, struct zsl_vec *time,
+			 struct zsl_vec *accel, struct zsl_vec *dist);
+
 /**
  * @brief Calculates the initial position of a moving body based on the final
  *        position (xf), the initial velocity (vi), acceleration (a) and
@@ -109,6 +126,22 @@ int zsl_phy_kin_time(zsl_real_t vi, zsl_real_t vf, zsl_real_t accel,
 int zsl_phy_kin_vel(zsl_real_t vi, zsl_real_t time, zsl_real_t accel,
 		    zsl_real_t *vf);
 
+/**
+ * @brief Calculates @ref zsl_phy_kin_vel for each element of the
+ *        equal-sized input vectors, in a single branch-free pass.
+ *
+ * @param vi    Initial velocities in meters per second.
+ * @param time  Times in seconds.
+ * @param accel Accelerations in meters per second squared.
+ * @param vf    The output velocities in meters per second, which may be one
+ *              of the inputs. Entries with a negative time are set to NAN.
+ *
+ * @return 0 on success, or -EINVAL if any time is negative or the vectors
+ *         are not the same size.
+ */
+int zsl_phy_kin_vel_vec(struct zsl_vec *vi, struct zsl_vec *time,
+			struct zsl_vec *accel, struct zsl_vec *vf);
+
 /**
  * @brief Calculates the velocity in meters per second of an object under a
  *        constant acceleration (accel) based on its initial velocity (vi) and
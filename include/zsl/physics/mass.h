@@ -24,6 +24,7 @@
 
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,105 @@ int zsl_phy_mass_center(struct zsl_vec *m, struct zsl_vec *x,
 			struct zsl_vec *y, struct zsl_vec *z, zsl_real_t *mx,
 			zsl_real_t *my, zsl_real_t *mz);
 
+/**
+ * @brief Running total mass, centre of mass and second moments of a set of
+ *        point masses. Initialise with @ref zsl_phy_mass_acc_init.
+ *
+ * The moments are kept about the running centre of mass, and updated with
+ * a weighted form of Welford's algorithm, so that points far from the
+ * origin do not lose precision to cancellation.
+ */
+struct zsl_phy_mass_acc {
+	/** @brief The total mass in kilograms. */
+	zsl_real_t m;
+	/** @brief The centre of mass in meters. */
+	zsl_real_t c[3];
+	/**
+	 * @brief The sums of m * dx * dx, m * dy * dy, m * dz * dz,
+	 *        m * dx * dy, m * dx * dz and m * dy * dz about the centre of
+	 *        mass.
+	 */
+	zsl_real_t s[6];
+};
+
+/**
+ * @brief Clears a mass accumulator.
+ *
+ * @param acc   The accumulator.
+ *
+ * @return 0 on success.
+ */
+int zsl_phy_mass_acc_init(struct zsl_phy_mass_acc *acc);
+
+/**
+ * @brief Adds one point mass to a mass accumulator.
+ *
+ * @param acc   The accumulator.
+ * @param m     The mass in kilograms.
+ * @param x     The x coordinate in meters.
+ * @param y     The y coordinate in meters.
+ * @param z     The z coordinate in meters.
+ *
+ * @return 0 on success, -EINVAL if the mass is negative.
+ */
+int zsl_phy_mass_acc_feed(struct zsl_phy_mass_acc *acc, zsl_real_t m,
+			  zsl_real_t x, zsl_real_t y, zsl_real_t z);
+
+/**
+ * @brief Adds a set of point masses, stored as separate mass and coordinate
+ *        vectors, to a mass accumulator.
+ *
+ * @param acc   The accumulator.
+ * @param m     Vector that contains the mass of each object in kilograms.
+ * @param x     Vector that contains the x coordinate of each object in meters.
+ * @param y     Vector that contains the y coordinate of each object in meters.
+ * @param z     Vector that contains the z coordinate of each object in meters.
+ *
+ * @return 0 on success, -EINVAL if the vectors are not the same size or any
+ *         mass is negative, in which case 'acc' is unchanged.
+ */
+int zsl_phy_mass_acc_feed_vec(struct zsl_phy_mass_acc *acc, struct zsl_vec *m,
+			      struct zsl_vec *x, struct zsl_vec *y,
+			      struct zsl_vec *z);
+
+/**
+ * @brief Adds a set of point masses, with interleaved coordinates, to a mass
+ *        accumulator.
+ *
+ * @param acc   The accumulator.
+ * @param m     Vector that contains the mass of each object in kilograms.
+ * @param p     Matrix with one row of x, y, z coordinates in meters per
+ *              object, with as many rows as 'm' has entries.
+ *
+ * @return 0 on success, -EINVAL if 'p' is not m->sz x 3 or any mass is
+ *         negative, in which case 'acc' is unchanged.
+ */
+int zsl_phy_mass_acc_feed_mtx(struct zsl_phy_mass_acc *acc, struct zsl_vec *m,
+			      struct zsl_mtx *p);
+
+/**
+ * @brief Calculates the total mass, the centre of mass and the inertia
+ *        tensor about the centre of mass of the points in a mass
+ *        accumulator. The accumulator is unchanged, so more points can be
+ *        added afterwards.
+ *
+ * The inertia tensor is I = trace(S) * E - S, where S is the 3x3 matrix of
+ * second moments about the centre of mass and E is the identity. Its
+ * diagonal holds the moments of inertia about the x, y and z axes through
+ * the centre of mass, as used by the rotation functions, and the
+ * off-diagonal entries the negated products of inertia.
+ *
+ * @param acc   The accumulator.
+ * @param mt    Pointer to the output total mass in kilograms.
+ * @param com   The output centre of mass in meters, a 3-vector.
+ * @param it    The output 3x3 inertia tensor in kilograms and meters squared.
+ *
+ * @return 0 on success, -EINVAL if the total mass is zero or the output
+ *         sizes are wrong.
+ */
+int zsl_phy_mass_acc_inertia(struct zsl_phy_mass_acc *acc, zsl_real_t *mt,
+			     struct zsl_vec *com, struct zsl_mtx *it);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,11 +23,44 @@
 #define ZEPHYR_INCLUDE_ZSL_PHYSICS_MISC_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief The number of points that @ref zsl_phy_misc_exp_curve computes by
+ *        recurrence between direct evaluations of the exponential.
+ */
+#define ZSL_PHY_MISC_EXP_RESYNC (64)
+
+/**
+ * @brief Samples the exponential process y(t) = b + a * e^(-lambda * t) at
+ *        the times t0 + k * dt, for k = 0 to y->sz - 1.
+ *
+ * Each point is the previous one times the constant e^(-lambda * dt), so
+ * only one exponential is evaluated for every ZSL_PHY_MISC_EXP_RESYNC
+ * points. Every ZSL_PHY_MISC_EXP_RESYNC points, the exponential is
+ * evaluated directly again, which bounds the rounding error accumulated by
+ * the recurrence to about ZSL_PHY_MISC_EXP_RESYNC units in the last place.
+ *
+ * This is the shape of radioactive decay, and of the charge, discharge and
+ * RL transient curves, which are generated with it by
+ * @ref zsl_phy_atom_rad_decay_vec and the eleccomp '_vec' functions.
+ *
+ * @param a       The amplitude of the exponential term.
+ * @param b       The constant offset.
+ * @param lambda  The rate constant, in inverse units of time.
+ * @param t0      The time of the first sample.
+ * @param dt      The time between samples.
+ * @param y       The output samples.
+ *
+ * @return 0 if everything executed properly.
+ */
+int zsl_phy_misc_exp_curve(zsl_real_t a, zsl_real_t b, zsl_real_t lambda,
+			   zsl_real_t t0, zsl_real_t dt, struct zsl_vec *y);
+
 #ifdef __cplusplus
 }
 #endif
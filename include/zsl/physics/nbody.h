@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup NBODY N-Body Gravitation
+ *
+ * @brief Gravitational acceleration of a system of N point masses.
+ *
+ * @ingroup PHYSICS
+ *  @{ */
+
+/**
+ * @file
+ * @brief API header file for N-body gravitation in zscilib.
+ *
+ * This file contains the zscilib N-body gravitation APIs.
+ *
+ * The bodies are stored as separate x, y, z and mass vectors, so the inner
+ * loops read contiguous memory. Two methods are provided:
+ *
+ * - @ref zsl_phy_nbody_acc sums every pair directly, which is exact and
+ *   O(N^2). Its inner loop has no branches, so the compiler can vectorise
+ *   it.
+ * - @ref zsl_phy_nbody_tree_acc uses a Barnes-Hut octree, built with
+ *   @ref zsl_phy_nbody_tree_build, which treats distant groups of bodies as
+ *   a single mass and is O(N log N). This is typically faster above about
+ *   ZSL_PHY_NBODY_BH_MIN bodies.
+ *
+ * Both kernels split the bodies across the worker pool with CONFIG_ZSL_SMP.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_NBODY_H_
+#define ZEPHYR_INCLUDE_ZSL_NBODY_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The approximate number of bodies above which the Barnes-Hut tree
+ *        is faster than the direct sum.
+ */
+#define ZSL_PHY_NBODY_BH_MIN    (1000)
+
+/**
+ * @brief The maximum depth of the octree. Bodies that still share a leaf at
+ *        this depth are merged into a single mass.
+ */
+#define ZSL_PHY_NBODY_DEPTH     (32)
+
+/**
+ * @brief The body index of a cell with children.
+ */
+#define ZSL_PHY_NBODY_NONE      (UINT32_MAX)
+
+/**
+ * @brief A cell of the Barnes-Hut octree.
+ */
+struct zsl_phy_nbody_node {
+	/** @brief The centre of the cell. */
+	zsl_real_t ctr[3];
+	/** @brief Half the side length of the cell. */
+	zsl_real_t half;
+	/** @brief The centre of mass of the bodies in the cell. */
+	zsl_real_t com[3];
+	/** @brief The total mass of the bodies in the cell. */
+	zsl_real_t m;
+	/** @brief The child cell in each octant, or 0 for none. */
+	uint32_t child[8];
+	/** @brief The number of bodies in the cell. */
+	uint32_t n;
+	/**
+	 * @brief The index of the first body in a leaf, or
+	 *        ZSL_PHY_NBODY_NONE if the cell has children.
+	 */
+	uint32_t body;
+};
+
+/**
+ * @brief Barnes-Hut octree storage. Declare with
+ *        @ref ZSL_PHY_NBODY_TREE_DEF, and then rebuild it as often as
+ *        needed with @ref zsl_phy_nbody_tree_build, which reuses the
+ *        storage.
+ */
+struct zsl_phy_nbody_tree {
+	/** @brief The number of nodes in 'nodes'. */
+	size_t sz;
+	/** @brief The number of nodes used by the last build. */
+	size_t n;
+	/** @brief The node storage. The root is node 0. */
+	struct zsl_phy_nbody_node *nodes;
+};
+
+/**
+ * Macro to declare an octree with storage for 'len' nodes. About 2 nodes per
+ * body are enough for most distributions, but closely clustered bodies
+ * need more.
+ */
+#define ZSL_PHY_NBODY_TREE_DEF(name, len)				\
+	static struct zsl_phy_nbody_node name ## _nodes[len];		\
+	struct zsl_phy_nbody_tree name = {				\
+		.sz = len,						\
+		.n = 0,							\
+		.nodes = name ## _nodes					\
+	}
+
+/**
+ * @brief Calculates the gravitational acceleration of each body due to all
+ *        the others by direct summation.
+ *
+ * The acceleration of body i is G * sum(m_j * d_ij / (|d_ij|^2 + eps^2)^1.5)
+ * over all j, where d_ij is the vector from body i to body j. Pairs of
+ * bodies at the same position are ignored.
+ *
+ * @param x     The x coordinate of each body in meters.
+ * @param y     The y coordinate of each body in meters.
+ * @param z     The z coordinate of each body in meters.
+ * @param m     The mass of each body in kilograms.
+ * @param eps   The softening length in meters, which limits the force of
+ *              close encounters, or 0 for none.
+ * @param ax    The output x acceleration of each body, in m/s^2.
+ * @param ay    The output y acceleration of each body, in m/s^2.
+ * @param az    The output z acceleration of each body, in m/s^2.
+ *
+ * The outputs must not alias any of the inputs.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         all the same size.
+ */
+int zsl_phy_nbody_acc(struct zsl_vec *x, struct zsl_vec *y, struct zsl_vec *z,
+		      struct zsl_vec *m, zsl_real_t eps, struct zsl_vec *ax,
+		      struct zsl_vec *ay, struct zsl_vec *az);
+
+/**
+ * @brief Builds the Barnes-Hut octree of a set of bodies, replacing the
+ *        previous contents of 'tree'.
+ *
+ * @param tree  The octree.
+ * @param x     The x coordinate of each body in meters.
+ * @param y     The y coordinate of each body in meters.
+ * @param z     The z coordinate of each body in meters.
+ * @param m     The mass of each body in kilograms.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         all the same size or are empty, or -ENOMEM if 'tree' does not have
+ *         enough nodes.
+ */
+int zsl_phy_nbody_tree_build(struct zsl_phy_nbody_tree *tree,
+			     struct zsl_vec *x, struct zsl_vec *y,
+			     struct zsl_vec *z, struct zsl_vec *m);
+
+/**
+ * @brief Calculates the gravitational acceleration of each body with the
+ *        Barnes-Hut approximation.
+ *
+ * The tree is walked from the root for each body, and a cell of side s at
+ * distance d from the body is treated as a single mass at its centre of
+ * mass if s < theta * d and the body is outside the cell. Otherwise, its
+ * children are visited. A 'theta' of 0 gives the direct sum, and 0.5 is a
+ * common choice, giving errors of around 0.1%.
+ *
+ * @param tree  The octree, built from the same positions.
+ * @param x     The x coordinate of each body in meters.
+ * @param y     The y coordinate of each body in meters.
+ * @param z     The z coordinate of each body in meters.
+ * @param theta The opening angle.
+ * @param eps   The softening length in meters, or 0 for none.
+ * @param ax    The output x acceleration of each body, in m/s^2.
+ * @param ay    The output y acceleration of each body, in m/s^2.
+ * @param az    The output z acceleration of each body, in m/s^2.
+ *
+ * The outputs must not alias any of the inputs.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         all the same size or the tree is empty.
+ */
+int zsl_phy_nbody_tree_acc(struct zsl_phy_nbody_tree *tree,
+			   struct zsl_vec *x, struct zsl_vec *y,
+			   struct zsl_vec *z, zsl_real_t theta, zsl_real_t eps,
+			   struct zsl_vec *ax, struct zsl_vec *ay,
+			   struct zsl_vec *az);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_NBODY_H_ */
+
+/** @} */ /* End of nbody group */
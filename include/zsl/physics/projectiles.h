@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_PROJECTILES_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -172,6 +173,66 @@ int zsl_phy_proj_hor_motion(zsl_real_t vih, zsl_real_t t, zsl_real_t xi,
 int zsl_phy_proj_trajectory(zsl_real_t vih, zsl_real_t viv, zsl_real_t xi,
 			    zsl_real_t yi, zsl_real_t xf, zsl_real_t *yf);
 
+/**
+ * @brief Calculates the height in meters of an object under projectile
+ *        motion at each of the horizontal positions in 'xf'. This is the
+ *        array form of @ref zsl_phy_proj_trajectory.
+ *
+ * The path is the parabola y = yi + a * dx + b * dx^2, with dx = xf - xi,
+ * whose coefficients are computed once, so each point costs two
+ * multiply-adds.
+ *
+ * @param vih    Horizontal velocity of the object in meters per second.
+ * @param viv    Initial vertical velocity of the object in meters per second.
+ * @param xi     Horizontal initial position of the object in meters.
+ * @param yi     Vertical initial position of the object in meters.
+ * @param xf     The horizontal positions in meters.
+ * @param yf     The output heights in meters, the same size as 'xf', which
+ *               may be 'xf' itself. Positions behind the launching point,
+ *               or every position if the horizontal velocity is zero, are
+ *               set to NAN.
+ *
+ * @return 0 if everything executed properly, -EINVAL if any height was set
+ *         to NAN or if the vectors are not the same size.
+ */
+int zsl_phy_proj_trajectory_vec(zsl_real_t vih, zsl_real_t viv,
+				zsl_real_t xi, zsl_real_t yi,
+				struct zsl_vec *xf, struct zsl_vec *yf);
+
+/**
+ * @brief Calculates the height in meters of an object under projectile
+ *        motion with quadratic air drag at each of the horizontal positions
+ *        in 'xf', which must be in ascending order.
+ *
+ * The acceleration is a = g - k * |v| * v, which is integrated in time with
+ * @ref zsl_ode_rk4_ws in steps of 'h' seconds. The flight is integrated
+ * once for the whole vector, and the heights between steps are found by
+ * cubic Hermite interpolation in x, using the slope vy / vx at either end
+ * of the step.
+ *
+ * @param vih    Initial horizontal velocity in meters per second, which
+ *               must be positive.
+ * @param viv    Initial vertical velocity in meters per second.
+ * @param xi     Horizontal initial position of the object in meters.
+ * @param yi     Vertical initial position of the object in meters.
+ * @param k      The drag coefficient over the mass, 0.5 * rho * Cd * A / m,
+ *               in 1/meters. Zero gives the drag-free trajectory.
+ * @param h      The integration time step in seconds.
+ * @param steps  The maximum number of steps to integrate.
+ * @param xf     The horizontal positions in meters, in ascending order.
+ * @param yf     The output heights in meters, the same size as 'xf', which
+ *               may be 'xf' itself. Positions behind the launching point, or
+ *               not reached within 'steps' steps, are set to NAN.
+ *
+ * @return 0 if everything executed properly, -EINVAL if any height was set
+ *         to NAN, if 'vih', 'k' or 'h' is out of range, or if the vectors
+ *         are not the same size.
+ */
+int zsl_phy_proj_trajectory_drag(zsl_real_t vih, zsl_real_t viv,
+				 zsl_real_t xi, zsl_real_t yi, zsl_real_t k,
+				 zsl_real_t h, size_t steps,
+				 struct zsl_vec *xf, struct zsl_vec *yf);
+
 /**
  * @brief Calculates the module of the total velocity in meters per second of
  *        an object under projectile motion at any point, given the vertical
@@ -17,17 +17,161 @@
  * @brief API header file for relativity in zscilib.
  *
  * This file contains the zscilib relativity APIs
+ *
+ * Most functions take a vector of velocities, or of quantities at one
+ * velocity, so that large arrays can be converted in a single call with
+ * the per-call checks and constants hoisted out of the loop. Velocities
+ * are in meters per second, and must be below the speed of light in
+ * magnitude.
  */
 
 #ifndef ZEPHYR_INCLUDE_ZSL_RELATIVITY_H_
 #define ZEPHYR_INCLUDE_ZSL_RELATIVITY_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Calculates the Lorentz factor, 1 / sqrt(1 - v^2 / c^2).
+ *
+ * @param v    Velocity in meters per second.
+ * @param g    Pointer to the output Lorentz factor. Will be set to NAN if
+ *             |v| is not below the speed of light.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_rel_gamma(zsl_real_t v, zsl_real_t *g);
+
+/**
+ * @brief Calculates the Lorentz factor for each velocity in 'v'.
+ *
+ * @param v    Velocities in meters per second.
+ * @param g    The output Lorentz factors, which may be 'v'. Elements are set
+ *             to NAN if |v| is not below the speed of light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any velocity is out of range.
+ */
+int zsl_phy_rel_gamma_vec(struct zsl_vec *v, struct zsl_vec *g);
+
+/**
+ * @brief Calculates the dilated time t = gamma * t0 measured by an observer
+ *        for whom a clock with proper time 't0' moves at each velocity in
+ *        'v'.
+ *
+ * @param t0   Proper time in seconds.
+ * @param v    Velocities in meters per second.
+ * @param t    The output times in seconds, which may be 'v'. Elements are set
+ *             to NAN if |v| is not below the speed of light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any velocity is out of range.
+ */
+int zsl_phy_rel_time_dil_vec(zsl_real_t t0, struct zsl_vec *v,
+			     struct zsl_vec *t);
+
+/**
+ * @brief Calculates the contracted length l = l0 / gamma of an object with
+ *        proper length 'l0' moving at each velocity in 'v'.
+ *
+ * @param l0   Proper length in meters.
+ * @param v    Velocities in meters per second.
+ * @param l    The output lengths in meters, which may be 'v'. Elements are
+ *             set to NAN if |v| is not below the speed of light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any velocity is out of range.
+ */
+int zsl_phy_rel_length_cont_vec(zsl_real_t l0, struct zsl_vec *v,
+				struct zsl_vec *l);
+
+/**
+ * @brief Calculates the relativistic momentum p = gamma * m * v of a mass
+ *        at each velocity in 'v'.
+ *
+ * @param m    Rest mass in kilograms.
+ * @param v    Velocities in meters per second.
+ * @param p    The output momenta in kilogram meters per second, which may be
+ *             'v'. Elements are set to NAN if |v| is not below the speed of
+ *             light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size, the mass is negative or any velocity is out of
+ *         range.
+ */
+int zsl_phy_rel_mom_vec(zsl_real_t m, struct zsl_vec *v, struct zsl_vec *p);
+
+/**
+ * @brief Calculates the relativistic kinetic energy (gamma - 1) * m * c^2 of
+ *        a mass at each velocity in 'v'.
+ *
+ * gamma - 1 is evaluated as gamma^2 * beta^2 / (gamma + 1), which avoids
+ * the cancellation that would otherwise lose all precision at everyday
+ * speeds.
+ *
+ * @param m    Rest mass in kilograms.
+ * @param v    Velocities in meters per second.
+ * @param e    The output kinetic energies in joules, which may be 'v'.
+ *             Elements are set to NAN if |v| is not below the speed of light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size, the mass is negative or any velocity is out of
+ *         range.
+ */
+int zsl_phy_rel_kin_ener_vec(zsl_real_t m, struct zsl_vec *v,
+			     struct zsl_vec *e);
+
+/**
+ * @brief Calculates the rest energy e = m * c^2 of a mass.
+ *
+ * @param m    Rest mass in kilograms.
+ * @param e    Pointer to the output energy in joules. Will be set to NAN if
+ *             the mass is negative.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_rel_mass_ener(zsl_real_t m, zsl_real_t *e);
+
+/**
+ * @brief Adds the velocity 'v' of a frame to each velocity in 'u' measured
+ *        in that frame, with the Lorentz velocity transformation
+ *        w = (u + v) / (1 + u * v / c^2).
+ *
+ * @param u    Velocities in the moving frame in meters per second.
+ * @param v    Velocity of the moving frame in meters per second.
+ * @param w    The output velocities in meters per second, which may be 'u'.
+ *             Elements are set to NAN if |u| or |v| is not below the speed
+ *             of light.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any velocity is out of range.
+ */
+int zsl_phy_rel_vel_add_vec(struct zsl_vec *u, zsl_real_t v,
+			    struct zsl_vec *w);
+
+/**
+ * @brief Applies the relativistic Doppler shift for a source receding at
+ *        velocity 'v' to each frequency in 'f0', so
+ *        f = f0 * sqrt((1 - v / c) / (1 + v / c)).
+ *
+ * The shift factor is computed once for the whole vector.
+ *
+ * @param f0   Emitted frequencies in hertz.
+ * @param v    Velocity of the source away from the receiver in meters per
+ *             second, which is negative for an approaching source.
+ * @param f    The output received frequencies in hertz, which may be 'f0'.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or |v| is not below the speed of light, in which
+ *         case the outputs are set to NAN.
+ */
+int zsl_phy_rel_doppler_vec(struct zsl_vec *f0, zsl_real_t v,
+			    struct zsl_vec *f);
+
 #ifdef __cplusplus
 }
 #endif
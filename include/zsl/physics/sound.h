@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_SOUND_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +75,54 @@ int zsl_phy_sound_level(zsl_real_t i, zsl_real_t i0, zsl_real_t *b);
 int zsl_phy_sound_intensity(zsl_real_t b, zsl_real_t d, zsl_real_t p,
 			    zsl_real_t *i);
 
+/**
+ * @brief Calculates the intensity and sound level of a block of pressure
+ *        samples in a single pass.
+ *
+ * The mean square pressure of the block is accumulated, and gives the
+ * intensity as per @ref zsl_phy_sound_intensity, with the RMS pressure
+ * standing in for the amplitude over sqrt(2). The level is then calculated
+ * from the intensity as per @ref zsl_phy_sound_level, with a single log10
+ * for the whole block. With CONFIG_ZSL_FAST_MATH_SOUND, this uses
+ * @ref zsl_fast_log10.
+ *
+ * @param p    The acoustic pressure samples in pascals.
+ * @param b    Bulk Modulus of the medium in pascals.
+ * @param d    Density of the medium in kilograms per cubic meter.
+ * @param i0   Reference intensity in watts per square meter, such as 1E-12
+ *             for dB SPL in air.
+ * @param i    Pointer to the output intensity in watts per square meter.
+ * @param lvl  Pointer to the output sound level in decibels, which is
+ *             -INFINITY if the block is silent.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the block is empty,
+ *         or the Bulk Modulus, density or reference intensity are not
+ *         positive, in which case the outputs are set to NAN.
+ */
+int zsl_phy_sound_level_block(struct zsl_vec *p, zsl_real_t b, zsl_real_t d,
+			      zsl_real_t i0, zsl_real_t *i, zsl_real_t *lvl);
+
+/**
+ * @brief Calculates the sound level of each consecutive block of 'blk'
+ *        pressure samples in 'p', as per @ref zsl_phy_sound_level_block.
+ *
+ * @param p    The acoustic pressure samples in pascals, whose size must be a
+ *             multiple of 'blk'.
+ * @param blk  The number of samples in each block.
+ * @param b    Bulk Modulus of the medium in pascals.
+ * @param d    Density of the medium in kilograms per cubic meter.
+ * @param i0   Reference intensity in watts per square meter.
+ * @param lvl  The output sound level of each block in decibels, with one
+ *             element per block.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the sizes don't
+ *         match, or the Bulk Modulus, density or reference intensity are
+ *         not positive.
+ */
+int zsl_phy_sound_level_blocks(struct zsl_vec *p, size_t blk, zsl_real_t b,
+			       zsl_real_t d, zsl_real_t i0,
+			       struct zsl_vec *lvl);
+
 /**
  * @brief Calculates the angle of the mach wave created by a moving sound
  *        source of velocity 'vs'.
@@ -104,6 +153,25 @@ int zsl_phy_sound_shock_wave_angle(zsl_real_t v, zsl_real_t vs,
 int zsl_phy_sound_dop_effect(zsl_real_t v, zsl_real_t vs, zsl_real_t vl,
 			     zsl_real_t fs, zsl_real_t *fl);
 
+/**
+ * @brief Calculates @ref zsl_phy_sound_dop_effect for each element of the
+ *        equal-sized source and receptor velocity vectors.
+ *
+ * @param v     Velocity of sound in the medium in meters per second.
+ * @param vs    Velocities of the sound source in meters per second.
+ * @param vl    Velocities of the sound receptor in meters per second.
+ * @param fs    Frequency of the sound in the source in hertzs.
+ * @param fl    The output frequencies in hertzs, which may be one of the
+ *              inputs. Elements are set to NAN as per
+ *              @ref zsl_phy_sound_dop_effect.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any output is NAN.
+ */
+int zsl_phy_sound_dop_effect_vec(zsl_real_t v, struct zsl_vec *vs,
+				 struct zsl_vec *vl, zsl_real_t fs,
+				 struct zsl_vec *fl);
+
 /**
  * @brief Calculates the frequency of the beats created by the interference of
  *        two waves with different frequency.
@@ -117,6 +185,30 @@ int zsl_phy_sound_dop_effect(zsl_real_t v, zsl_real_t vs, zsl_real_t vl,
  */
 int zsl_phy_sound_beat(zsl_real_t fa, zsl_real_t fb, zsl_real_t *f);
 
+/**
+ * @brief Calculates the speed of sound in moist air, treated as an ideal
+ *        mixture of dry air and water vapour.
+ *
+ * @param t    Temperature in kelvins.
+ * @param p    Pressure in pascals.
+ * @param rh   Relative humidity, from 0.0 (dry air) to 1.0.
+ * @param v    Pointer to the output speed in meters per second. Will be set
+ *             to NAN if the temperature or pressure are not positive, or the
+ *             relative humidity is out of range.
+ *
+ * @return 0 if everything executed properly, error code on failure.
+ */
+int zsl_phy_sound_speed_air(zsl_real_t t, zsl_real_t p, zsl_real_t rh,
+			    zsl_real_t *v);
+
+/**
+ * @brief @ref zsl_phy_sound_speed_air as a property function for
+ *        @ref zsl_phy_gas_cache_init, with 'arg' pointing to the relative
+ *        humidity, or NULL for dry air.
+ */
+int zsl_phy_sound_speed_air_fn(zsl_real_t t, zsl_real_t p, void *arg,
+			       zsl_real_t *v);
+
 #ifdef __cplusplus
 }
 #endif
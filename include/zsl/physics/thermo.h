@@ -23,6 +23,7 @@
 #define ZEPHYR_INCLUDE_ZSL_THERMO_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +55,18 @@ int zsl_phy_thermo_fahren_cels(zsl_real_t t1, zsl_real_t *t2, bool ctf);
  */
 int zsl_phy_thermo_cels_kel(zsl_real_t t1, zsl_real_t *t2, bool ktc);
 
+/**
+ * @brief Calculates @ref zsl_phy_thermo_cels_kel for each element of 't1'.
+ *
+ * @param t1    Input temperatures.
+ * @param t2    The output temperatures, which may be 't1'.
+ * @param ktc   If set to true, converts from kelvin to celcius.
+ *
+ * @return 0 on success, or -EINVAL if the vectors are not the same size.
+ */
+int zsl_phy_thermo_cels_kel_vec(struct zsl_vec *t1, struct zsl_vec *t2,
+				bool ktc);
+
 /**
  * @brief Calculates the necessary heat to melt a material based on its latent
  *        heat (lh) and mass (m).
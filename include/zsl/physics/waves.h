@@ -17,17 +17,101 @@
  * @brief API header file for waves in zscilib.
  *
  * This file contains the zscilib waves APIs
+ *
+ * A set of sinusoids is given as separate vectors of amplitudes,
+ * frequencies and phases, each component being a * sin(2 * pi * f * t + ph).
+ * The functions that sample waveforms advance each component by a complex
+ * rotation per sample rather than calling sin, and evaluate sin and cos
+ * directly only once every ZSL_PHY_WAVE_RESYNC samples to bound the
+ * accumulated rounding error.
  */
 
 #ifndef ZEPHYR_INCLUDE_ZSL_WAVES_H_
 #define ZEPHYR_INCLUDE_ZSL_WAVES_H_
 
 #include <zsl/zsl.h>
+#include <zsl/vectors.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief The number of samples that a sinusoid is advanced by rotation
+ *        between direct evaluations of sin and cos. This is also the block
+ *        size that @ref zsl_phy_wave_superpose accumulates all components
+ *        over.
+ */
+#define ZSL_PHY_WAVE_RESYNC     (64)
+
+/**
+ * @brief Calculates the wavelength for each frequency in 'f', as
+ *        lambda = v / f.
+ *
+ * @param v    Propagation speed in meters per second.
+ * @param f    Frequencies in hertz.
+ * @param l    The output wavelengths in meters, which may be 'f'. Elements
+ *             are set to NAN if the frequency is not positive.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or any frequency is not positive.
+ */
+int zsl_phy_wave_len_vec(zsl_real_t v, struct zsl_vec *f, struct zsl_vec *l);
+
+/**
+ * @brief Samples the superposition of a set of sinusoids at the times
+ *        t0 + k * dt, for k = 0 to y->sz - 1.
+ *
+ * The output is built in blocks of ZSL_PHY_WAVE_RESYNC samples, which stay
+ * in cache while every component is added to them, so 'y' is only passed
+ * over once. Each component costs one sin and cos per block, and a complex
+ * multiply per sample.
+ *
+ * @param a    Amplitudes of the components.
+ * @param f    Frequencies of the components in hertz.
+ * @param ph   Phases of the components at t = 0, in radians.
+ * @param t0   Time of the first sample in seconds.
+ * @param dt   Time between samples in seconds.
+ * @param y    The output samples.
+ *
+ * @return 0 if everything executed properly, -EINVAL if 'a', 'f' and 'ph'
+ *         are not the same size.
+ */
+int zsl_phy_wave_superpose(struct zsl_vec *a, struct zsl_vec *f,
+			   struct zsl_vec *ph, zsl_real_t t0, zsl_real_t dt,
+			   struct zsl_vec *y);
+
+/**
+ * @brief Sums a set of sinusoids of the same frequency, given as phasors,
+ *        into a single sinusoid of that frequency.
+ *
+ * @param a    Amplitudes of the components.
+ * @param ph   Phases of the components in radians.
+ * @param amp  Pointer to the output amplitude.
+ * @param phr  Pointer to the output phase in radians, in [-pi, pi].
+ *
+ * @return 0 if everything executed properly, -EINVAL if 'a' and 'ph' are not
+ *         the same size.
+ */
+int zsl_phy_wave_phasor_sum(struct zsl_vec *a, struct zsl_vec *ph,
+			    zsl_real_t *amp, zsl_real_t *phr);
+
+/**
+ * @brief Calculates the intensity of two interfering waves of intensity
+ *        'i1' and 'i2' for each phase difference in 'dph', as
+ *        i = i1 + i2 + 2 * sqrt(i1 * i2) * cos(dph).
+ *
+ * @param i1   Intensity of the first wave.
+ * @param i2   Intensity of the second wave.
+ * @param dph  Phase differences in radians.
+ * @param i    The output intensities, which may be 'dph'.
+ *
+ * @return 0 if everything executed properly, -EINVAL if the vectors are not
+ *         the same size or an intensity is negative.
+ */
+int zsl_phy_wave_interf_vec(zsl_real_t i1, zsl_real_t i2, struct zsl_vec *dph,
+			    struct zsl_vec *i);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup PIPELINE Pipelines
+ *
+ * @brief Graphs of processing nodes connected by lock-free queues, which
+ *        can be spread across threads and cores.
+ *
+ * A chain such as IMU samples -> fusion -> attitude -> measurement -> CBOR
+ * -> radio is described as a set of nodes, each of which wraps one
+ * operation, connected by edges. An edge is a single-producer,
+ * single-consumer ring of preallocated slots. A node writes its output
+ * straight into a slot of its output edge, and the next node reads it in
+ * place from there, so data is never copied between stages.
+ *
+ * Each node belongs to a group, and each group is run by one thread with
+ * @ref zsl_pipe_run, or on Zephyr by @ref zsl_pipe_start, which can also pin
+ * the thread to a CPU. A node only runs when its input has a slot ready
+ * and its output has one free, so a slow stage holds back the stages that
+ * feed it instead of losing data inside the graph. Samples are pushed into
+ * the graph's input edges from outside with @ref zsl_pipe_edge_claim and
+ * @ref zsl_pipe_edge_publish, which are safe to call from an ISR.
+ *
+ * Every node keeps counts of its runs, errors and stalls, and the fewest,
+ * most and total cycles it has taken, which are read with
+ * @ref zsl_pipe_stats.
+ */
+
+/**
+ * @file
+ * @brief API header file for pipelines in zscilib.
+ *
+ * This file contains the zscilib pipeline APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_PIPELINE_H_
+#define ZEPHYR_INCLUDE_ZSL_PIPELINE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup PIPE_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for pipelines.
+ *
+ * @ingroup PIPELINE
+ *  @{ */
+
+/** The number of groups, and so of threads, a pipeline can use. */
+#ifdef CONFIG_ZSL_PIPE_GROUPS
+#define ZSL_PIPE_GROUPS CONFIG_ZSL_PIPE_GROUPS
+#else
+#define ZSL_PIPE_GROUPS 2
+#endif
+
+/**
+ * @brief The alignment of the edge counters and slot storage, which should
+ *        be the data cache line size of the target.
+ */
+#ifndef ZSL_PIPE_ALIGN
+#define ZSL_PIPE_ALIGN          (32)
+#endif
+
+/** The group of an edge end that is outside the pipeline. */
+#define ZSL_PIPE_EXT            (0xFF)
+
+/**
+ * Returned by a node function that consumed its input but produced no
+ * output, for example when decimating.
+ */
+#define ZSL_PIPE_SKIP           (1)
+
+/**
+ * @brief A node operation.
+ *
+ * @param in    The input slot, read in place.
+ * @param out   The output slot to write, or NULL for a node with no output.
+ * @param arg   The node's argument.
+ *
+ * @return 0 to pass 'out' to the next node, ZSL_PIPE_SKIP to produce
+ *         nothing for this input, or a negative error code.
+ */
+typedef int (*zsl_pipe_fn_t)(const void *in, void *out, void *arg);
+
+struct zsl_pipe;
+
+/**
+ * @brief A single-producer, single-consumer ring of fixed size slots.
+ *        Declare with @ref ZSL_PIPE_EDGE_DEF.
+ */
+struct zsl_pipe_edge {
+	/** The number of slots, a power of two. */
+	size_t n;
+	/** The size of each slot in bytes. */
+	size_t sz;
+	/** The slot storage, n * sz bytes. */
+	uint8_t *mem;
+	/** The pipeline, set by @ref zsl_pipe_init. */
+	struct zsl_pipe *pipe;
+	/** The group of the producing node, or ZSL_PIPE_EXT. */
+	uint8_t src;
+	/** The group of the consuming node, or ZSL_PIPE_EXT. */
+	uint8_t dst;
+	/** The number of slots published. Written by the producer. */
+	uint32_t head __attribute__((aligned(ZSL_PIPE_ALIGN)));
+	/** The number of claims refused because the edge was full. */
+	uint32_t full;
+	/** The number of slots released. Written by the consumer. */
+	uint32_t tail __attribute__((aligned(ZSL_PIPE_ALIGN)));
+};
+
+/** Returns the size of an edge slot holding 'sz' bytes, rounded up so that
+ * every slot is 8-byte aligned. */
+#define ZSL_PIPE_SLOT_SZ(sz)    (((sz) + 7) & ~(size_t)7)
+
+/**
+ * Macro to declare an edge of 'slots' slots of 'bytes' bytes, where 'slots'
+ * is a power of two. The slots are static, so this should be used at file
+ * scope.
+ */
+#define ZSL_PIPE_EDGE_DEF(name, slots, bytes)				\
+	_Static_assert((slots) > 0 && ((slots) & ((slots) - 1)) == 0,	\
+		       "edge size must be a power of two");		\
+	static uint8_t name ## _mem[(slots) * ZSL_PIPE_SLOT_SZ(bytes)]	\
+	__attribute__((aligned(ZSL_PIPE_ALIGN)));			\
+	struct zsl_pipe_edge name = {					\
+		.n = slots,						\
+		.sz = ZSL_PIPE_SLOT_SZ(bytes),				\
+		.mem = name ## _mem,					\
+		.src = ZSL_PIPE_EXT,					\
+		.dst = ZSL_PIPE_EXT,					\
+	}
+
+/** @brief The counters kept for each node. */
+struct zsl_pipe_stats {
+	/** The number of times the node ran. */
+	uint32_t calls;
+	/** The number of runs that returned an error. */
+	uint32_t errors;
+	/** The number of times an input was ready but the output was full. */
+	uint32_t stalls;
+	/** The fewest cycles any run took. */
+	uint32_t min;
+	/** The most cycles any run took. */
+	uint32_t max;
+	/** The total number of cycles taken by all runs. */
+	uint64_t total;
+};
+
+/** @brief A node of a pipeline. */
+struct zsl_pipe_node {
+	/** A name for the node, used when reporting. */
+	const char *name;
+	/** The operation. */
+	zsl_pipe_fn_t fn;
+	/** The argument passed to 'fn'. */
+	void *arg;
+	/** The input edge. */
+	struct zsl_pipe_edge *in;
+	/** The output edge, or NULL for a node that ends the pipeline. */
+	struct zsl_pipe_edge *out;
+	/** The group, and so the thread, that runs the node. */
+	uint8_t group;
+	/** The node's counters. Written by the thread that runs it. */
+	struct zsl_pipe_stats stats;
+};
+
+/** @brief A pipeline. Set up with @ref zsl_pipe_init. */
+struct zsl_pipe {
+	/** The nodes. */
+	struct zsl_pipe_node **nodes;
+	/** The number of entries in 'nodes'. */
+	size_t n;
+#ifdef __ZEPHYR__
+	/** Given when a node of each group may be able to run. */
+	struct k_sem wake[ZSL_PIPE_GROUPS];
+#endif
+};
+
+/** @} */ /* End of PIPE_STRUCTS group */
+
+/**
+ * @addtogroup PIPE_FUNCS Functions
+ *
+ * @brief Pipeline functions.
+ *
+ * @ingroup PIPELINE
+ *  @{ */
+
+/**
+ * @brief Connects the nodes of pipeline 'p' through their edges, and clears
+ *        the counters of every node and edge.
+ *
+ * @param p     The pipeline.
+ * @param nodes The nodes, which must stay valid while 'p' is used.
+ * @param n     The number of entries in 'nodes'.
+ *
+ * @return 0 on success, or -EINVAL if a node has no function or input, is
+ *         in a group above ZSL_PIPE_GROUPS - 1, or shares an input or
+ *         output edge with another node.
+ */
+int zsl_pipe_init(struct zsl_pipe *p, struct zsl_pipe_node **nodes,
+		  size_t n);
+
+/**
+ * @brief Returns the next free slot of 'e' for the producer to write, or
+ *        NULL if the edge is full.
+ */
+void *zsl_pipe_edge_claim(struct zsl_pipe_edge *e);
+
+/**
+ * @brief Passes the slot returned by @ref zsl_pipe_edge_claim to the
+ *        consumer, waking its group.
+ */
+void zsl_pipe_edge_publish(struct zsl_pipe_edge *e);
+
+/**
+ * @brief Returns the oldest published slot of 'e' for the consumer to read,
+ *        or NULL if the edge is empty.
+ */
+const void *zsl_pipe_edge_peek(struct zsl_pipe_edge *e);
+
+/**
+ * @brief Returns the slot returned by @ref zsl_pipe_edge_peek to the
+ *        producer, waking its group.
+ */
+void zsl_pipe_edge_release(struct zsl_pipe_edge *e);
+
+/**
+ * @brief Runs node 'nd' once on the oldest slot of its input.
+ *
+ * @param nd    The node.
+ *
+ * @return 0 or ZSL_PIPE_SKIP if the node ran, -EAGAIN if its input was
+ *         empty, -ENOBUFS if its output was full, or the error returned
+ *         by the node, in which case its input is still released.
+ */
+int zsl_pipe_step(struct zsl_pipe_node *nd);
+
+/**
+ * @brief Runs the nodes of 'group' until none of them can make progress.
+ *        Only one thread may run each group.
+ *
+ * @param p     The pipeline.
+ * @param group The group to run.
+ *
+ * @return The number of node runs made.
+ */
+size_t zsl_pipe_run(struct zsl_pipe *p, uint8_t group);
+
+/**
+ * @brief Copies the counters of node 'nd' into 'st', and optionally clears
+ *        them.
+ *
+ * @param nd    The node.
+ * @param st    The output counters.
+ * @param reset If true, clear the node's counters after copying.
+ *
+ * @return 0 on success.
+ */
+int zsl_pipe_stats(struct zsl_pipe_node *nd, struct zsl_pipe_stats *st,
+		   bool reset);
+
+#ifdef __ZEPHYR__
+/**
+ * @brief Runs 'group' forever, sleeping whenever none of its nodes can make
+ *        progress. This is the entry point of the threads started by
+ *        @ref zsl_pipe_start.
+ */
+void zsl_pipe_loop(struct zsl_pipe *p, uint8_t group);
+
+/**
+ * @brief Starts thread 't' to run 'group' with @ref zsl_pipe_loop.
+ *
+ * @param p         The pipeline.
+ * @param group     The group to run.
+ * @param t         The thread.
+ * @param stack     The thread's stack.
+ * @param stack_sz  The size of 'stack'.
+ * @param prio      The thread priority.
+ * @param cpu       The CPU to pin the thread to, or -1 to let it run on
+ *                  any. Pinning needs CONFIG_SCHED_CPU_MASK.
+ *
+ * @return 0 on success, -EINVAL if 'group' is out of range, or -ENOTSUP if
+ *         'cpu' isn't -1 and pinning isn't supported.
+ */
+int zsl_pipe_start(struct zsl_pipe *p, uint8_t group, struct k_thread *t,
+		   k_thread_stack_t *stack, size_t stack_sz, int prio,
+		   int cpu);
+#endif
+
+/** @} */ /* End of PIPE_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_PIPELINE_H_ */
+
+/** @} */ /* End of PIPELINE group */
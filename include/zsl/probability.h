@@ -23,6 +23,7 @@
 
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -136,10 +137,82 @@ zsl_real_t zsl_prob_erf_inv(zsl_real_t *x);
  */
 zsl_real_t zsl_prob_normal_cdf_inv(zsl_real_t *m, zsl_real_t *s, zsl_real_t *x);
 
+/**
+ * @brief Computes the normal probability density function of mean 'm' and
+ *        standard deviation 's' for every value in vector x.
+ *
+ * The normalising constants are computed once for the whole vector, so this
+ * is much cheaper than calling @ref zsl_prob_normal_pdf for each value.
+ *
+ * @param m  Mean value of the normal distribution.
+ * @param s  Standard deviation of the normal distribution.
+ * @param x  The values to calculate the images of.
+ * @param y  The output images, the same size as x. This may be x.
+ *
+ * @return 0 on success, or -EINVAL if x and y are not the same size.
+ */
+int zsl_prob_normal_pdf_vec(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, struct zsl_vec *y);
+
+/**
+ * @brief Computes the log-likelihood of the values in vector x, i.e. the sum
+ *        of the logarithms of their normal probability densities, for mean
+ *        'm' and standard deviation 's'.
+ *
+ * This is evaluated in closed form from the sum of squared deviations, so
+ * no exponential or logarithm is needed per value, and it does not
+ * underflow for large vectors as a product of densities would.
+ *
+ * @param m   Mean value of the normal distribution.
+ * @param s   Standard deviation of the normal distribution.
+ * @param x   The observed values.
+ * @param ll  The natural log-likelihood of x.
+ *
+ * @return 0 on success.
+ */
+int zsl_prob_normal_log_lik(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, zsl_real_t *ll);
+
+/**
+ * @brief Computes the normal cumulative distribution function of mean 'm'
+ *        and standard deviation 's' for every value in vector x.
+ *
+ * @param m  Mean value of the normal distribution.
+ * @param s  Standard deviation of the normal distribution.
+ * @param x  The values to calculate the images of.
+ * @param y  The output images, the same size as x. This may be x.
+ *
+ * @return 0 on success, or -EINVAL if x and y are not the same size.
+ */
+int zsl_prob_normal_cdf_vec(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, struct zsl_vec *y);
+
+/**
+ * @brief Computes the inverse of the normal cumulative distribution function
+ *        of mean 'm' and standard deviation 's' for every value in vector p.
+ *
+ * This uses the same polynomial approximation of the inverse error function
+ * as @ref zsl_prob_erf_inv, evaluated inline, with the range of p checked
+ * once up front rather than per call.
+ *
+ * @param m  Mean value of the normal distribution.
+ * @param s  Standard deviation of the normal distribution.
+ * @param p  The probabilities, each in the open interval (0, 1).
+ * @param y  The output values, the same size as p. This may be p.
+ *
+ * @return 0 on success, or -EINVAL if p and y are not the same size or a
+ *         value of p is outside (0, 1).
+ */
+int zsl_prob_normal_cdf_inv_vec(zsl_real_t *m, zsl_real_t *s,
+				const struct zsl_vec *p, struct zsl_vec *y);
+
 /**
  * @brief Computes the Shannon entropy of a set of events with given
  *        probabilities.
  *
+ * Events with a probability of zero contribute nothing, so an empty bin of
+ * a histogram's PMF can be passed as is.
+ *
  * @param v  The vector with the probabilities of the events.
  * @param h  The Shannon entropy of the probabilities in v.
  *
@@ -147,6 +220,271 @@ zsl_real_t zsl_prob_normal_cdf_inv(zsl_real_t *m, zsl_real_t *s, zsl_real_t *x);
  */
 int zsl_prob_entropy(struct zsl_vec *v, zsl_real_t *h);
 
+/**
+ * @brief A histogram, counting samples into bins that are either uniform
+ *        over [lo, hi) or bounded by a caller-supplied vector of edges.
+ *
+ * Uniform bins are found with a single multiply per sample, and custom
+ * bins with a binary search over the edges. Samples outside the bins are
+ * counted in 'under' and 'over' rather than in any bin. Declare the
+ * histogram and its counts with @ref ZSL_PROB_HIST_DEF.
+ */
+struct zsl_prob_hist {
+	/**
+	 * @brief The number of samples in each bin.
+	 */
+	struct zsl_vec count;
+	/**
+	 * @brief The 'count.sz' + 1 ascending bin edges, with bin i covering
+	 *        [edges[i], edges[i + 1]), or NULL for uniform bins.
+	 */
+	const struct zsl_vec *edges;
+	/**
+	 * @brief The lower bound of the first bin.
+	 */
+	zsl_real_t lo;
+	/**
+	 * @brief The upper bound of the last bin, which is not included.
+	 */
+	zsl_real_t hi;
+	/**
+	 * @brief The number of uniform bins per unit of x.
+	 */
+	zsl_real_t scale;
+	/**
+	 * @brief The number of samples counted in the bins.
+	 */
+	zsl_real_t total;
+	/**
+	 * @brief The number of samples below 'lo', or NaN.
+	 */
+	size_t under;
+	/**
+	 * @brief The number of samples at or above 'hi'.
+	 */
+	size_t over;
+};
+
+/**
+ * Macro to declare a histogram of 'n' bins.
+ *
+ * Be sure to also call 'zsl_prob_hist_init' or 'zsl_prob_hist_init_edges'
+ * on the histogram after this macro, since the storage is not initialised.
+ */
+#define ZSL_PROB_HIST_DEF(name, n)		 \
+	zsl_real_t name ## _count[n];		 \
+	struct zsl_prob_hist name = {		 \
+		.count = {			 \
+			.sz = n,		 \
+			.data = name ## _count	 \
+		}				 \
+	}
+
+/**
+ * @brief A joint histogram of paired samples, with the marginal histograms
+ *        of each variable, used to estimate mutual information.
+ *
+ * Pairs are only counted when both values fall within a bin, so that the
+ * marginals and the joint counts cover the same samples. Declare the
+ * histogram and its counts with @ref ZSL_PROB_HIST2_DEF.
+ */
+struct zsl_prob_hist2 {
+	/**
+	 * @brief The marginal histogram of the first variable.
+	 */
+	struct zsl_prob_hist x;
+	/**
+	 * @brief The marginal histogram of the second variable.
+	 */
+	struct zsl_prob_hist y;
+	/**
+	 * @brief The number of pairs in each bin, with a row per bin of 'x'
+	 *        and a column per bin of 'y'.
+	 */
+	struct zsl_mtx count;
+	/**
+	 * @brief The number of pairs with at least one value outside the bins.
+	 */
+	size_t outside;
+};
+
+/**
+ * Macro to declare a joint histogram of 'nx' by 'ny' bins.
+ *
+ * Be sure to also set up the bins of 'name.x' and 'name.y' with
+ * 'zsl_prob_hist_init' or 'zsl_prob_hist_init_edges', and then call
+ * 'zsl_prob_hist2_reset', after this macro.
+ */
+#define ZSL_PROB_HIST2_DEF(name, nx, ny)		 \
+	zsl_real_t name ## _xcount[nx];			 \
+	zsl_real_t name ## _ycount[ny];			 \
+	zsl_real_t name ## _count[(nx) * (ny)];		 \
+	struct zsl_prob_hist2 name = {			 \
+		.x = {					 \
+			.count = {			 \
+				.sz = nx,		 \
+				.data = name ## _xcount	 \
+			}				 \
+		},					 \
+		.y = {					 \
+			.count = {			 \
+				.sz = ny,		 \
+				.data = name ## _ycount	 \
+			}				 \
+		},					 \
+		.count = {				 \
+			.sz_rows = nx,			 \
+			.sz_cols = ny,			 \
+			.data = name ## _count		 \
+		}					 \
+	}
+
+/**
+ * @brief Sets up 'count.sz' uniform bins over [lo, hi) and clears the
+ *        counts of histogram 'h'.
+ *
+ * @param h   The histogram to initialise.
+ * @param lo  The lower bound of the first bin.
+ * @param hi  The upper bound of the last bin, which is not included.
+ *
+ * @return 0 on success, or -EINVAL if hi <= lo or there are no bins.
+ */
+int zsl_prob_hist_init(struct zsl_prob_hist *h, zsl_real_t lo, zsl_real_t hi);
+
+/**
+ * @brief Sets up custom bins bounded by 'edges' and clears the counts of
+ *        histogram 'h'.
+ *
+ * The edges are referenced rather than copied, and must outlive 'h'.
+ *
+ * @param h      The histogram to initialise.
+ * @param edges  'count.sz' + 1 strictly ascending bin edges.
+ *
+ * @return 0 on success, or -EINVAL if 'edges' is the wrong size or isn't
+ *         strictly ascending.
+ */
+int zsl_prob_hist_init_edges(struct zsl_prob_hist *h,
+			     const struct zsl_vec *edges);
+
+/**
+ * @brief Clears the counts of histogram 'h', keeping its bins.
+ *
+ * @param h  The histogram to clear.
+ *
+ * @return 0 on success.
+ */
+int zsl_prob_hist_reset(struct zsl_prob_hist *h);
+
+/**
+ * @brief Finds the bin of histogram 'h' that holds 'x', without counting it.
+ *
+ * @param h    The histogram to search.
+ * @param x    The value to look up.
+ * @param bin  The bin holding 'x'.
+ *
+ * @return 0 on success, or -EINVAL if 'x' is outside the bins.
+ */
+int zsl_prob_hist_bin(const struct zsl_prob_hist *h, zsl_real_t x,
+		      size_t *bin);
+
+/**
+ * @brief Counts sample 'x' in histogram 'h'.
+ *
+ * @param h  The histogram to update.
+ * @param x  The sample to count.
+ *
+ * @return 0 on success, including when 'x' is outside the bins and is
+ *         counted in 'under' or 'over' instead.
+ */
+int zsl_prob_hist_feed(struct zsl_prob_hist *h, zsl_real_t x);
+
+/**
+ * @brief Counts every sample of vector v in histogram 'h'.
+ *
+ * @param h  The histogram to update.
+ * @param v  The samples to count.
+ *
+ * @return 0 on success.
+ */
+int zsl_prob_hist_feed_vec(struct zsl_prob_hist *h, const struct zsl_vec *v);
+
+/**
+ * @brief Computes the probability mass of each bin of histogram 'h'.
+ *
+ * The result sums to 1, and can be passed to @ref zsl_prob_entropy.
+ *
+ * @param h  The histogram to use.
+ * @param p  The probabilities, the same size as 'h->count'.
+ *
+ * @return 0 on success, or -EINVAL if p is the wrong size or no samples
+ *         have been counted in the bins.
+ */
+int zsl_prob_hist_pmf(const struct zsl_prob_hist *h, struct zsl_vec *p);
+
+/**
+ * @brief Computes the Shannon entropy, in bits, of the binned samples of
+ *        histogram 'h', directly from its counts.
+ *
+ * @param h  The histogram to use.
+ * @param e  The Shannon entropy.
+ *
+ * @return 0 on success, or -EINVAL if no samples have been counted in the
+ *         bins.
+ */
+int zsl_prob_hist_entropy(const struct zsl_prob_hist *h, zsl_real_t *e);
+
+/**
+ * @brief Clears the joint and marginal counts of histogram 'h', keeping its
+ *        bins.
+ *
+ * @param h  The histogram to clear.
+ *
+ * @return 0 on success, or -EINVAL if 'h->count' doesn't match the number
+ *         of bins of 'h->x' and 'h->y'.
+ */
+int zsl_prob_hist2_reset(struct zsl_prob_hist2 *h);
+
+/**
+ * @brief Counts the sample pair ('a', 'b') in histogram 'h'.
+ *
+ * @param h  The histogram to update.
+ * @param a  The sample of the first variable.
+ * @param b  The sample of the second variable.
+ *
+ * @return 0 on success, including when the pair is outside the bins and is
+ *         counted in 'outside' instead.
+ */
+int zsl_prob_hist2_feed(struct zsl_prob_hist2 *h, zsl_real_t a, zsl_real_t b);
+
+/**
+ * @brief Counts the sample pairs (a[i], b[i]) in histogram 'h'.
+ *
+ * @param h  The histogram to update.
+ * @param a  The samples of the first variable.
+ * @param b  The samples of the second variable, the same size as a.
+ *
+ * @return 0 on success, or -EINVAL if a and b are not the same size.
+ */
+int zsl_prob_hist2_feed_vec(struct zsl_prob_hist2 *h, const struct zsl_vec *a,
+			    const struct zsl_vec *b);
+
+/**
+ * @brief Computes the mutual information, in bits, between the binned
+ *        variables of histogram 'h'.
+ *
+ * This is the sum over all bins of p(i,j) * log2(p(i,j) / (p(i) * p(j))),
+ * computed directly from the counts. The joint entropy is then
+ * H(x) + H(y) - I(x;y), using @ref zsl_prob_hist_entropy on 'h->x' and
+ * 'h->y'.
+ *
+ * @param h   The histogram to use.
+ * @param mi  The mutual information.
+ *
+ * @return 0 on success, or -EINVAL if no pairs have been counted in the
+ *         bins.
+ */
+int zsl_prob_hist2_mi(const struct zsl_prob_hist2 *h, zsl_real_t *mi);
+
 #ifdef __cplusplus
 }
 #endif
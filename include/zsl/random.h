@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup RANDOM Random Numbers
+ *
+ * @brief Seedable pseudo-random number generation.
+ *
+ * Each generator is a small, caller-owned context holding the 128-bit state
+ * of a xoshiro128++ generator, so there is no hidden global state: threads
+ * that each own a context need no locking, and a fixed seed reproduces the
+ * same sequence on every target. Uniform values are built from the top bits
+ * of each 32-bit output, and normal values use the ziggurat method, which
+ * needs one output and one table lookup in about 99% of cases.
+ *
+ * The generator is fast and statistically strong, but it is not suitable
+ * for cryptographic purposes.
+ */
+
+/**
+ * @file
+ * @brief API header file for random numbers in zscilib.
+ *
+ * This file contains the zscilib pseudo-random number APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_RANDOM_H_
+#define ZEPHYR_INCLUDE_ZSL_RANDOM_H_
+
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup RAND_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for random number generation.
+ *
+ * @ingroup RANDOM
+ *  @{ */
+
+/** @brief The state of a pseudo-random number generator. */
+struct zsl_rand {
+	/** The xoshiro128++ state, which must not be all zero. */
+	uint32_t s[4];
+};
+
+/** @} */ /* End of RAND_STRUCTS group */
+
+/**
+ * @addtogroup RAND_FUNCS Functions
+ *
+ * @brief Functions used to generate pseudo-random numbers.
+ *
+ * @ingroup RANDOM
+ *  @{ */
+
+/**
+ * @brief Seeds generator 'r', expanding 'seed' into the full state with
+ *        SplitMix64 so that similar seeds give unrelated sequences.
+ *
+ * @param r     The generator to seed.
+ * @param seed  Any 64-bit value, including zero.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_seed(struct zsl_rand *r, uint64_t seed);
+
+/**
+ * @brief Advances generator 'r' by 2^64 outputs.
+ *
+ * Seeding one generator and then copying it, jumping each copy one more
+ * time than the last, gives up to 2^64 non-overlapping streams, one per
+ * thread or per Monte Carlo run.
+ *
+ * @param r  The generator to advance.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_jump(struct zsl_rand *r);
+
+/**
+ * @brief Returns the next 32-bit output of generator 'r'.
+ *
+ * @param r  The generator to use.
+ *
+ * @return A uniformly distributed 32-bit value.
+ */
+uint32_t zsl_rand_u32(struct zsl_rand *r);
+
+/**
+ * @brief Returns a uniformly distributed value in [0.0, 1.0).
+ *
+ * In double precision, two outputs are combined for the full 53 bits of
+ * mantissa. In single precision, one output gives 24 bits.
+ *
+ * @param r  The generator to use.
+ *
+ * @return A value in [0.0, 1.0).
+ */
+zsl_real_t zsl_rand_uniform(struct zsl_rand *r);
+
+/**
+ * @brief Returns a standard normal value, with a mean of 0.0 and a standard
+ *        deviation of 1.0, using the ziggurat method.
+ *
+ * @param r  The generator to use.
+ *
+ * @return A normally distributed value.
+ */
+zsl_real_t zsl_rand_normal(struct zsl_rand *r);
+
+/**
+ * @brief Fills vector v with values uniformly distributed in [a, b).
+ *
+ * @param r  The generator to use.
+ * @param v  The vector to fill.
+ * @param a  The lower bound.
+ * @param b  The upper bound.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_vec_uniform(struct zsl_rand *r, struct zsl_vec *v, zsl_real_t a,
+			 zsl_real_t b);
+
+/**
+ * @brief Fills vector v with normally distributed values of mean 'm' and
+ *        standard deviation 's'.
+ *
+ * @param r  The generator to use.
+ * @param v  The vector to fill.
+ * @param m  The mean.
+ * @param s  The standard deviation.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_vec_normal(struct zsl_rand *r, struct zsl_vec *v, zsl_real_t m,
+			zsl_real_t s);
+
+/**
+ * @brief Fills matrix 'm' with values uniformly distributed in [a, b).
+ *
+ * @param r  The generator to use.
+ * @param m  The matrix to fill.
+ * @param a  The lower bound.
+ * @param b  The upper bound.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_mtx_uniform(struct zsl_rand *r, struct zsl_mtx *m, zsl_real_t a,
+			 zsl_real_t b);
+
+/**
+ * @brief Fills matrix 'm' with normally distributed values of mean 'mean'
+ *        and standard deviation 's'.
+ *
+ * @param r     The generator to use.
+ * @param m     The matrix to fill.
+ * @param mean  The mean.
+ * @param s     The standard deviation.
+ *
+ * @return 0 on success.
+ */
+int zsl_rand_mtx_normal(struct zsl_rand *r, struct zsl_mtx *m,
+			zsl_real_t mean, zsl_real_t s);
+
+/** @} */ /* End of RAND_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_RANDOM_H_ */
+
+/** @} */ /* End of RANDOM group */
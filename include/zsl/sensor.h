@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup SENSOR Sensor Adapter
+ *
+ * @brief Reads Zephyr sensor channels straight into vectors and batches.
+ *
+ * Zephyr sensor drivers return each reading as a struct sensor_value,
+ * an integer part 'val1' and a fractional part 'val2' in millionths.
+ * Rather than converting each value to zsl_real_t and copying it into a
+ * vector before use, the functions here get every requested channel of a
+ * sample in one go and convert them all into their final place: a
+ * @ref zsl_vec, or one column of a channel-major measurement batch (see
+ * @ref MES_BATCH). A batch filled this way can be viewed as a vector per
+ * channel or as a matrix without any further copying.
+ *
+ * @ref zsl_sns_conv is the conversion kernel, which is available on every
+ * target. The device functions need CONFIG_ZSL_SENSOR, and the streaming
+ * functions also need a driver with a data ready trigger.
+ */
+
+/**
+ * @file
+ * @brief API header file for the sensor adapter in zscilib.
+ *
+ * This file contains the zscilib sensor adapter APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_SENSOR_H_
+#define ZEPHYR_INCLUDE_ZSL_SENSOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/measurement/measurement.h>
+
+#if CONFIG_ZSL_SENSOR
+#include <kernel.h>
+#include <drivers/sensor.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SNS_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for the sensor adapter.
+ *
+ * @ingroup SENSOR
+ *  @{ */
+
+/**
+ * The largest number of values that one sample read by the functions
+ * below may hold, counting three for each XYZ channel.
+ */
+#ifdef CONFIG_ZSL_SENSOR_MAX_VALS
+#define ZSL_SNS_MAX_VALS CONFIG_ZSL_SENSOR_MAX_VALS
+#else
+#define ZSL_SNS_MAX_VALS 16
+#endif
+
+#if CONFIG_ZSL_SENSOR
+/**
+ * @brief A stream of samples from a sensor's data ready trigger into a
+ *        measurement batch. Set up with @ref zsl_sns_stream_start.
+ */
+struct zsl_sns_stream {
+	/** The sensor device. */
+	const struct device *dev;
+	/** The channels read on each trigger, in batch channel order. */
+	const enum sensor_channel *ch;
+	/** The number of entries in 'ch'. */
+	size_t nch;
+	/** The batch that samples are written into. */
+	struct zsl_measurement *mes;
+	/** The index of the next sample to write. */
+	volatile size_t next;
+	/** The number of samples lost because the batch was full. */
+	volatile uint32_t dropped;
+	/** Given when the batch has been filled. */
+	struct k_sem full;
+	/** The trigger registered with the driver. */
+	struct sensor_trigger trig;
+};
+#endif
+
+/** @} */ /* End of SNS_STRUCTS group */
+
+/**
+ * @addtogroup SNS_FUNCS Functions
+ *
+ * @brief Sensor adapter functions.
+ *
+ * @ingroup SENSOR
+ *  @{ */
+
+/**
+ * @brief Converts 'n' fixed-point sensor values to zsl_real_t.
+ *
+ * Each value is a pair of int32_t entries, val1 + val2 / 1000000, which is
+ * the layout of struct sensor_value, so an array of those can be passed
+ * directly. The loop is unrolled so that the compiler can vectorise it.
+ *
+ * @param val       The 2 * n input entries, as (val1, val2) pairs.
+ * @param n         The number of values to convert.
+ * @param out       The first output element.
+ * @param stride    The distance between output elements, which is 1 for a
+ *                  vector, or the number of samples for a batch column.
+ *
+ * @return 0 on success, or -EINVAL if 'stride' is 0.
+ */
+int zsl_sns_conv(const int32_t *val, size_t n, zsl_real_t *out,
+		 size_t stride);
+
+#if CONFIG_ZSL_SENSOR
+/**
+ * @brief Gets the number of values returned for channel 'ch', which is 3
+ *        for the XYZ channels (SENSOR_CHAN_ACCEL_XYZ, etc.) and 1 for all
+ *        others.
+ */
+size_t zsl_sns_chan_width(enum sensor_channel ch);
+
+/**
+ * @brief Fetches one sample from 'dev', and converts channels 'ch' into
+ *        'v' in order.
+ *
+ * @param dev   The sensor device.
+ * @param ch    The channels to read.
+ * @param nch   The number of entries in 'ch'.
+ * @param v     The output vector, with one element per value read.
+ *
+ * @return 0 on success, -EINVAL if 'v' is the wrong size or more than
+ *         ZSL_SNS_MAX_VALS values were requested, or the error returned
+ *         by the driver.
+ */
+int zsl_sns_read(const struct device *dev, const enum sensor_channel *ch,
+		 size_t nch, struct zsl_vec *v);
+
+/**
+ * @brief Fetches one sample from 'dev', and converts channels 'ch' into
+ *        sample 's' of batch 'mes', with one batch channel per value read.
+ *        This is equivalent to @ref zsl_sns_read followed by
+ *        @ref zsl_mes_batch_put, without the intermediate vector.
+ *
+ * @param dev   The sensor device.
+ * @param ch    The channels to read.
+ * @param nch   The number of entries in 'ch'.
+ * @param mes   The batch.
+ * @param s     The index of the sample.
+ *
+ * @return 0 on success, -EINVAL if 'mes' is not a batch with one channel
+ *         per value read or 's' is out of range, or the error returned by
+ *         the driver.
+ */
+int zsl_sns_read_batch(const struct device *dev,
+		       const enum sensor_channel *ch, size_t nch,
+		       struct zsl_measurement *mes, size_t s);
+
+/**
+ * @brief Starts filling batch 'mes' from the data ready trigger of 'dev',
+ *        reading channels 'ch' as for @ref zsl_sns_read_batch in the
+ *        trigger handler.
+ *
+ * Up to CONFIG_ZSL_SENSOR_STREAMS streams may run at once, each on a
+ * different device. Samples arriving while the batch is full are counted
+ * in 'st->dropped' and discarded.
+ *
+ * @param st    The stream, which must stay valid until stopped.
+ * @param dev   The sensor device.
+ * @param ch    The channels to read, which must stay valid until stopped.
+ * @param nch   The number of entries in 'ch'.
+ * @param mes   The batch, with one channel per value read.
+ *
+ * @return 0 on success, -EINVAL if 'mes' doesn't match 'ch', -EBUSY if
+ *         'dev' already has a stream, -ENOMEM if all streams are in use,
+ *         or the error returned by sensor_trigger_set, which is -ENOTSUP
+ *         or -ENOSYS for drivers without a data ready trigger. Those can
+ *         be polled with @ref zsl_sns_read_batch instead.
+ */
+int zsl_sns_stream_start(struct zsl_sns_stream *st, const struct device *dev,
+			 const enum sensor_channel *ch, size_t nch,
+			 struct zsl_measurement *mes);
+
+/**
+ * @brief Waits for the batch of 'st' to fill. Once its samples have been
+ *        used, @ref zsl_sns_stream_reset starts the next batch.
+ *
+ * @param st        The stream.
+ * @param timeout   The longest time to wait.
+ *
+ * @return 0 when the batch is full, or -EAGAIN on a timeout.
+ */
+int zsl_sns_stream_wait(struct zsl_sns_stream *st, k_timeout_t timeout);
+
+/**
+ * @brief Empties the batch of 'st', so that the next trigger writes
+ *        sample 0.
+ */
+void zsl_sns_stream_reset(struct zsl_sns_stream *st);
+
+/**
+ * @brief Removes the trigger handler of 'st' and frees its slot.
+ *
+ * @return 0 on success, or -EINVAL if 'st' isn't running.
+ */
+int zsl_sns_stream_stop(struct zsl_sns_stream *st);
+#endif
+
+/** @} */ /* End of SNS_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_SENSOR_H_ */
+
+/** @} */ /* End of SENSOR group */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup SMP Multi-Core Execution
+ *
+ * @brief Splitting large operations across a pool of worker threads.
+ *
+ * When CONFIG_ZSL_SMP is enabled on a multi-core Zephyr target, a pool of
+ * CONFIG_ZSL_SMP_THREADS work queues is started at boot, and the larger
+ * matrix kernels (zsl_mtx_mult, zsl_mtx_mult_ex and everything built on
+ * them, as well as the Householder updates in zsl_mtx_qrd) divide their
+ * output rows or columns between the calling thread and the pool. Large
+ * radix sorts in zsl_vec_sort_ws are split into runs in the same way.
+ *
+ * Calls whose cost is below CONFIG_ZSL_SMP_THRESHOLD, calls made from an
+ * ISR or from a pool thread, and all calls when CONFIG_ZSL_SMP is disabled
+ * run on the calling thread alone, with identical results.
+ */
+
+/**
+ * @file
+ * @brief API header file for multi-core execution in zscilib.
+ *
+ * This file contains the zscilib worker pool APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_SMP_H_
+#define ZEPHYR_INCLUDE_ZSL_SMP_H_
+
+#include <stddef.h>
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SMP_FUNCS Functions
+ *
+ * @brief Functions used to run work on the worker pool.
+ *
+ * @ingroup SMP
+ *  @{ */
+
+/**
+ * @brief Processes the items 'start' to 'end' - 1 of a larger job.
+ *
+ * @param arg   The user data passed to @ref zsl_smp_for.
+ * @param start The first item to process.
+ * @param end   One past the last item to process.
+ */
+typedef void (*zsl_smp_fn_t)(void *arg, size_t start, size_t end);
+
+/**
+ * @brief Calls 'fn' on contiguous, non-overlapping ranges that together
+ *        cover items 0 to n - 1, returning once every range is done.
+ *
+ * The ranges are split between the calling thread and the worker pool
+ * when 'cost' is at least CONFIG_ZSL_SMP_THRESHOLD, and 'fn' must
+ * therefore be safe to run concurrently on different ranges. Otherwise,
+ * 'fn' is called once with the full range on the calling thread.
+ *
+ * @param fn    The function to call on each range.
+ * @param arg   User data passed to each call of 'fn'.
+ * @param n     The number of items, typically output rows or columns.
+ * @param cost  An estimate of the total work, in multiply-adds.
+ *
+ * @return 0 on success.
+ */
+int zsl_smp_for(zsl_smp_fn_t fn, void *arg, size_t n, size_t cost);
+
+/** @} */ /* End of SMP_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_SMP_H_ */
+
+/** @} */ /* End of SMP group */
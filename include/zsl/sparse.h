@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup SPARSE Sparse Matrices
+ *
+ * @brief Sparse matrices in compressed sparse row (CSR) form.
+ *
+ * Large matrices where most entries are zero, such as the Jacobians of
+ * loosely-coupled systems, can be stored and multiplied far more cheaply in
+ * CSR form than as a dense @ref zsl_mtx. Only the non-zero values are kept,
+ * along with their column index, and a per-row offset into those arrays.
+ *
+ * Memory for a sparse matrix is provided by the caller with a fixed
+ * capacity of non-zero entries, which is typically declared with
+ * @ref ZSL_SPMATRIX_DEF. Column indices within each row are kept in
+ * ascending order by every function that produces a sparse matrix.
+ */
+
+/**
+ * @file
+ * @brief API header file for sparse matrices in zscilib.
+ *
+ * This file contains the zscilib sparse matrix APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_SPARSE_H_
+#define ZEPHYR_INCLUDE_ZSL_SPARSE_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SPMTX_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with sparse matrices.
+ *
+ * @ingroup SPARSE
+ *  @{ */
+
+/** @brief Represents a m x n sparse matrix, stored in CSR form. */
+struct zsl_spmtx {
+	/** The number of rows in the matrix (typically denoted as 'm'). */
+	size_t sz_rows;
+	/** The number of columns in the matrix (typically denoted as 'n'). */
+	size_t sz_cols;
+	/** The number of entries available in 'col_idx' and 'data'. */
+	size_t sz_nnz;
+	/**
+	 * Offsets of the first entry of each row in 'col_idx' and 'data', with
+	 * 'sz_rows' + 1 entries. Row i occupies [row_ptr[i], row_ptr[i + 1]),
+	 * and row_ptr[sz_rows] is the number of stored entries.
+	 */
+	size_t *row_ptr;
+	/** The column index of each stored entry. */
+	size_t *col_idx;
+	/** The value of each stored entry. */
+	zsl_real_t *data;
+};
+
+/**
+ * Macro to declare a m*n sparse matrix with room for 'nz' non-zero entries.
+ *
+ * Be sure to also call 'zsl_spmtx_init' on the matrix after this macro, since
+ * matrices declared on the stack may have non-zero row offsets by default!
+ */
+#define ZSL_SPMATRIX_DEF(name, m, n, nz)	 \
+	size_t name ## _rp[(m) + 1];		 \
+	size_t name ## _ci[nz];			 \
+	zsl_real_t name ## _spmtx[nz];		 \
+	struct zsl_spmtx name = {		 \
+		.sz_rows = m,			 \
+		.sz_cols = n,			 \
+		.sz_nnz = nz,			 \
+		.row_ptr = name ## _rp,		 \
+		.col_idx = name ## _ci,		 \
+		.data = name ## _spmtx		 \
+	}
+
+/** @} */ /* End of SPMTX_STRUCTS group */
+
+/**
+ * @addtogroup SPMTX_FUNCS Functions
+ *
+ * @brief Functions used to create, convert and operate on sparse matrices.
+ *
+ * @ingroup SPARSE
+ *  @{ */
+
+/**
+ * @brief Returns the number of entries currently stored in 'sp'.
+ *
+ * @param sp    The sparse matrix.
+ *
+ * @return The number of stored, typically non-zero, entries.
+ */
+static inline size_t zsl_spmtx_nnz(const struct zsl_spmtx *sp)
+{
+	return sp->row_ptr[sp->sz_rows];
+}
+
+/**
+ * @brief Initialises sparse matrix 'sp' as an all-zero matrix, with no
+ *        stored entries.
+ *
+ * @param sp    The sparse matrix to initialise.
+ *
+ * @return 0 on success.
+ */
+int zsl_spmtx_init(struct zsl_spmtx *sp);
+
+/**
+ * @brief Converts dense matrix 'm' to sparse matrix 'sp', storing only the
+ *        entries whose magnitude is greater than 'tol'.
+ *
+ * @param m     The dense input matrix.
+ * @param tol   Entries with an absolute value of 'tol' or less are dropped.
+ *              Use 0.0 to keep every non-zero entry.
+ * @param sp    The sparse output matrix, the same shape as 'm'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'sp' and 'm' are
+ *          different shapes, or -ENOMEM if 'm' has more than 'sp->sz_nnz'
+ *          entries to store. On error, 'sp' is left empty.
+ */
+int zsl_spmtx_from_mtx(const struct zsl_mtx *m, zsl_real_t tol,
+		       struct zsl_spmtx *sp);
+
+/**
+ * @brief Converts sparse matrix 'sp' to dense matrix 'm'.
+ *
+ * @param sp    The sparse input matrix.
+ * @param m     The dense output matrix, the same shape as 'sp'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'sp' and 'm'
+ *          are different shapes.
+ */
+int zsl_spmtx_to_mtx(const struct zsl_spmtx *sp, struct zsl_mtx *m);
+
+/**
+ * @brief Gets the value of the entry at row 'i' and column 'j' of 'sp'.
+ *
+ * @param sp    The sparse matrix.
+ * @param i     The row number (zero-based).
+ * @param j     The column number (zero-based).
+ * @param x     Pointer to the output value, which is 0.0 for entries that
+ *              aren't stored.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'i' or 'j' are
+ *          out of range.
+ */
+int zsl_spmtx_get(const struct zsl_spmtx *sp, size_t i, size_t j,
+		  zsl_real_t *x);
+
+/**
+ * @brief Multiplies sparse matrix 'sp' by vector 'v', assigning the output
+ *        to 'w' (w = sp * v).
+ *
+ * @param sp    The m x n sparse matrix.
+ * @param v     The input vector, of size n.
+ * @param w     The output vector, of size m. This must not be 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL on a size
+ *          mismatch.
+ */
+int zsl_spmtx_mult_vec(const struct zsl_spmtx *sp, const struct zsl_vec *v,
+		       struct zsl_vec *w);
+
+/**
+ * @brief Multiplies the transpose of sparse matrix 'sp' by vector 'v',
+ *        assigning the output to 'w' (w = sp^T * v), without forming the
+ *        transpose.
+ *
+ * @param sp    The m x n sparse matrix.
+ * @param v     The input vector, of size m.
+ * @param w     The output vector, of size n. This must not be 'v'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL on a size
+ *          mismatch.
+ */
+int zsl_spmtx_mult_trans_vec(const struct zsl_spmtx *sp,
+			     const struct zsl_vec *v, struct zsl_vec *w);
+
+/**
+ * @brief Multiplies sparse matrix 'sa' by dense matrix 'mb', assigning the
+ *        output to dense matrix 'mc' (mc = sa * mb).
+ *
+ * @param sa    The m x n sparse matrix.
+ * @param mb    The n x p dense matrix.
+ * @param mc    The m x p dense output matrix. This must not be 'mb'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the matrices
+ *          are not compatibly shaped.
+ */
+int zsl_spmtx_mult_mtx(const struct zsl_spmtx *sa, const struct zsl_mtx *mb,
+		       struct zsl_mtx *mc);
+
+/**
+ * @brief Multiplies sparse matrix 'sa' by sparse matrix 'sb', assigning the
+ *        output to sparse matrix 'sc' (sc = sa * sb).
+ *
+ * Each output row is accumulated in a dense row of length 'sb->sz_cols', so
+ * the cost scales with the number of non-zero products plus the size of
+ * the output, rather than with m * n * p as for @ref zsl_mtx_mult.
+ *
+ * @param sa    The m x n sparse matrix.
+ * @param sb    The n x p sparse matrix.
+ * @param sc    The m x p sparse output matrix. This must not be 'sa' or
+ *              'sb'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ENOMEM if the product has more than
+ *          'sc->sz_nnz' entries. On error, 'sc' is left empty.
+ */
+int zsl_spmtx_mult(const struct zsl_spmtx *sa, const struct zsl_spmtx *sb,
+		   struct zsl_spmtx *sc);
+
+/**
+ * @brief Transposes sparse matrix 'sa', assigning the output to 'sb'.
+ *
+ * Together with @ref zsl_spmtx_mult, this can be used to form the normal
+ * matrix J^T * J of a sparse Jacobian J.
+ *
+ * @param sa    The m x n sparse input matrix.
+ * @param sb    The n x m sparse output matrix. This must not be 'sa'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'sb' is not the
+ *          transposed shape of 'sa', or -ENOMEM if 'sb->sz_nnz' is less
+ *          than the number of entries in 'sa'.
+ */
+int zsl_spmtx_trans(const struct zsl_spmtx *sa, struct zsl_spmtx *sb);
+
+/**
+ * @brief Solves sp * x = b for symmetric positive-definite sparse matrix
+ *        'sp', using the Jacobi-preconditioned conjugate gradient method.
+ *
+ * On entry, 'x' holds the initial guess for the solution, which can simply
+ * be zero. Iteration stops once the residual norm |b - sp * x| is no more
+ * than 'tol' times |b|. In exact arithmetic this takes at most n steps.
+ *
+ * @param sp        The nxn symmetric positive-definite sparse matrix.
+ * @param b         The right-hand side vector, of size n.
+ * @param x         The initial guess on entry, and the solution on exit.
+ * @param tol       The relative residual tolerance.
+ * @param max_iter  The maximum number of iterations to perform.
+ *
+ * @return  0 if everything executed correctly, -EINVAL on a size mismatch,
+ *          -ENOTPOSDEF if 'sp' is found not to be positive-definite, or
+ *          -ENOCONVERGE if 'tol' wasn't reached in 'max_iter' steps, in
+ *          which case 'x' holds the latest estimate.
+ */
+int zsl_spmtx_cg(const struct zsl_spmtx *sp, const struct zsl_vec *b,
+		 struct zsl_vec *x, zsl_real_t tol, size_t max_iter);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_spmtx_cg_ws for an nxn matrix.
+ *
+ * @param n     The number of rows and columns in the sparse matrix.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_spmtx_cg_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_spmtx_cg, taking its temporaries from
+ *        workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param sp        The nxn symmetric positive-definite sparse matrix.
+ * @param b         The right-hand side vector, of size n.
+ * @param x         The initial guess on entry, and the solution on exit.
+ * @param tol       The relative residual tolerance.
+ * @param max_iter  The maximum number of iterations to perform.
+ * @param ws        The workspace to allocate temporaries from, with at
+ *                  least zsl_spmtx_cg_ws_sz(n) free entries.
+ *
+ * @return  0 on success, -EINVAL, -ENOTPOSDEF or -ENOCONVERGE as for
+ *          @ref zsl_spmtx_cg, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_spmtx_cg_ws(const struct zsl_spmtx *sp, const struct zsl_vec *b,
+		    struct zsl_vec *x, zsl_real_t tol, size_t max_iter,
+		    struct zsl_workspace *ws);
+
+/** @} */ /* End of SPMTX_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_SPARSE_H_ */
+
+/** @} */ /* End of SPARSE group */
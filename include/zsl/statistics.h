@@ -45,6 +45,468 @@ struct zsl_sta_linreg {
 	zsl_real_t correlation;
 };
 
+/**
+ * @brief Recursive least squares (RLS) estimator state.
+ *
+ * Tracks the least squares solution 'theta' of y = theta^T * x as new
+ * observation rows (x, y) arrive one at a time, at a cost of O(n^2) per
+ * sample rather than re-solving the whole system. Declare the estimator and
+ * its storage with @ref ZSL_STA_RLS_DEF.
+ */
+struct zsl_sta_rls {
+	/**
+	 * @brief The current parameter estimate, of size n.
+	 */
+	struct zsl_vec theta;
+	/**
+	 * @brief The nxn inverse correlation matrix of the inputs, which is
+	 *        proportional to the covariance of 'theta'.
+	 */
+	struct zsl_mtx p;
+	/**
+	 * @brief Scratch vector of size n, holding p * x for the last update.
+	 */
+	struct zsl_vec gain;
+	/**
+	 * @brief The forgetting factor, in the range (0.0, 1.0]. Values below
+	 *        1.0 exponentially down-weight older samples.
+	 */
+	zsl_real_t lambda;
+};
+
+/**
+ * Macro to declare a recursive least squares estimator for 'n' parameters.
+ *
+ * Be sure to also call 'zsl_sta_rls_init' on the estimator after this macro,
+ * since the storage is not initialised.
+ */
+#define ZSL_STA_RLS_DEF(name, n)		 \
+	zsl_real_t name ## _theta[n];		 \
+	zsl_real_t name ## _p[(n) * (n)];	 \
+	zsl_real_t name ## _gain[n];		 \
+	struct zsl_sta_rls name = {		 \
+		.theta = {			 \
+			.sz = n,		 \
+			.data = name ## _theta	 \
+		},				 \
+		.p = {				 \
+			.sz_rows = n,		 \
+			.sz_cols = n,		 \
+			.data = name ## _p	 \
+		},				 \
+		.gain = {			 \
+			.sz = n,		 \
+			.data = name ## _gain	 \
+		},				 \
+		.lambda = 1.0			 \
+	}
+
+/** @brief Descriptive statistics of a vector, see @ref zsl_sta_summary. */
+struct zsl_sta_summary {
+	/**
+	 * @brief The number of samples.
+	 */
+	size_t n;
+	/**
+	 * @brief The arithmetic mean.
+	 */
+	zsl_real_t mean;
+	/**
+	 * @brief The variance, with the same n - 1 divisor as zsl_sta_var, or
+	 *        0.0 for a single sample.
+	 */
+	zsl_real_t var;
+	/**
+	 * @brief The standard deviation, the square root of 'var'.
+	 */
+	zsl_real_t sta_dev;
+	/**
+	 * @brief The smallest sample.
+	 */
+	zsl_real_t min;
+	/**
+	 * @brief The largest sample.
+	 */
+	zsl_real_t max;
+	/**
+	 * @brief The data range, max - min.
+	 */
+	zsl_real_t range;
+	/**
+	 * @brief The first quartile, as for zsl_sta_quart.
+	 */
+	zsl_real_t q1;
+	/**
+	 * @brief The median, or second quartile.
+	 */
+	zsl_real_t median;
+	/**
+	 * @brief The third quartile.
+	 */
+	zsl_real_t q3;
+	/**
+	 * @brief The interquartile range, q3 - q1.
+	 */
+	zsl_real_t iqr;
+};
+
+/**
+ * @brief Running statistics of a stream of samples.
+ *
+ * Samples are added one at a time with Welford-style updates, so the
+ * moments below stay accurate over long streams without keeping the
+ * samples themselves. Two streams may also be merged, to combine partial
+ * results. Reset the accumulator with @ref zsl_sta_stream_init.
+ */
+struct zsl_sta_stream {
+	/**
+	 * @brief The number of samples added so far.
+	 */
+	size_t n;
+	/**
+	 * @brief The arithmetic mean of the samples.
+	 */
+	zsl_real_t mean;
+	/**
+	 * @brief The sum of the squared deviations from the mean.
+	 */
+	zsl_real_t m2;
+	/**
+	 * @brief The sum of the cubed deviations from the mean.
+	 */
+	zsl_real_t m3;
+	/**
+	 * @brief The sum of the fourth powers of the deviations from the mean.
+	 */
+	zsl_real_t m4;
+	/**
+	 * @brief The smallest sample, only valid when 'n' is non-zero.
+	 */
+	zsl_real_t min;
+	/**
+	 * @brief The largest sample, only valid when 'n' is non-zero.
+	 */
+	zsl_real_t max;
+};
+
+/**
+ * @brief A double-ended queue of sample numbers, used by
+ *        struct zsl_sta_window to track the window minimum and maximum.
+ */
+struct zsl_sta_window_deque {
+	/**
+	 * @brief Ring buffer of sample numbers, with room for a full window.
+	 */
+	size_t *idx;
+	/**
+	 * @brief The position in 'idx' of the oldest entry.
+	 */
+	size_t head;
+	/**
+	 * @brief The number of entries queued.
+	 */
+	size_t len;
+};
+
+/**
+ * @brief Statistics over a sliding window of the last 'buf.sz' samples.
+ *
+ * The samples are kept in ring buffer 'buf'. The mean and variance are
+ * updated in O(1) operations as each new sample replaces the oldest one,
+ * and the minimum and maximum are tracked with monotonic deques, in O(1)
+ * amortised operations per sample. Declare the window and its storage with
+ * @ref ZSL_STA_WINDOW_DEF.
+ */
+struct zsl_sta_window {
+	/**
+	 * @brief Ring buffer holding the samples, whose size is the window
+	 *        length.
+	 */
+	struct zsl_vec buf;
+	/**
+	 * @brief Sample numbers of increasing values, the front being the
+	 *        window minimum.
+	 */
+	struct zsl_sta_window_deque minq;
+	/**
+	 * @brief Sample numbers of decreasing values, the front being the
+	 *        window maximum.
+	 */
+	struct zsl_sta_window_deque maxq;
+	/**
+	 * @brief The number of samples added so far, which is also the number
+	 *        of the next sample.
+	 */
+	size_t seq;
+	/**
+	 * @brief The arithmetic mean of the samples in the window.
+	 */
+	zsl_real_t mean;
+	/**
+	 * @brief The sum of the squared deviations from 'mean' of the samples
+	 *        in the window.
+	 */
+	zsl_real_t m2;
+};
+
+/**
+ * Macro to declare sliding-window statistics over the last 'n' samples.
+ *
+ * Be sure to also call 'zsl_sta_window_init' on the window after this
+ * macro, since the storage is not initialised.
+ */
+#define ZSL_STA_WINDOW_DEF(name, n)		 \
+	zsl_real_t name ## _buf[n];		 \
+	size_t name ## _minq[n];		 \
+	size_t name ## _maxq[n];		 \
+	struct zsl_sta_window name = {		 \
+		.buf = {			 \
+			.sz = n,		 \
+			.data = name ## _buf	 \
+		},				 \
+		.minq = {			 \
+			.idx = name ## _minq	 \
+		},				 \
+		.maxq = {			 \
+			.idx = name ## _maxq	 \
+		}				 \
+	}
+
+/**
+ * The ratio of the standard deviation of a normal distribution to its
+ * median absolute deviation. Multiplying a MAD by this gives a robust
+ * estimate of the standard deviation.
+ */
+#define ZSL_STA_MAD_NORMAL 1.482602218505602
+
+/**
+ * @brief A Hampel filter over a sliding window of the last 'buf.sz'
+ *        samples, replacing outliers with the window median.
+ *
+ * Alongside the ring buffer 'buf', the window is kept in ascending order
+ * in 'sorted'. Each new sample replaces the oldest with two binary searches
+ * and a single move of the values between their positions, and the median
+ * and median absolute deviation are then found in O(log(n)) comparisons,
+ * so windows are never sorted or selected from scratch. Declare the filter
+ * and its storage with @ref ZSL_STA_HAMPEL_DEF.
+ */
+struct zsl_sta_hampel {
+	/**
+	 * @brief Ring buffer holding the samples, whose size is the window
+	 *        length.
+	 */
+	struct zsl_vec buf;
+	/**
+	 * @brief The samples in the window in ascending order, with room for
+	 *        'buf.sz' values.
+	 */
+	zsl_real_t *sorted;
+	/**
+	 * @brief The number of samples added so far.
+	 */
+	size_t seq;
+	/**
+	 * @brief The threshold, in robust standard deviations
+	 *        (ZSL_STA_MAD_NORMAL * MAD) from the window median, beyond
+	 *        which a sample is an outlier.
+	 */
+	zsl_real_t t;
+};
+
+/**
+ * Macro to declare a Hampel filter over the last 'n' samples.
+ *
+ * Be sure to also call 'zsl_sta_hampel_init' on the filter after this
+ * macro, since the storage is not initialised.
+ */
+#define ZSL_STA_HAMPEL_DEF(name, n)		 \
+	zsl_real_t name ## _buf[n];		 \
+	zsl_real_t name ## _srt[n];		 \
+	struct zsl_sta_hampel name = {		 \
+		.buf = {			 \
+			.sz = n,		 \
+			.data = name ## _buf	 \
+		},				 \
+		.sorted = name ## _srt		 \
+	}
+
+/**
+ * @brief A t-digest, estimating the quantiles of an unbounded stream of
+ *        samples in a fixed amount of memory.
+ *
+ * Samples are held as weighted centroids, and neighbouring centroids are
+ * combined whenever the storage fills up, keeping clusters near the median
+ * large and clusters in the tails small, so that extreme quantiles such as
+ * p99 stay accurate. Digests built from separate streams can be merged.
+ * Declare the digest and its storage with @ref ZSL_STA_TDIGEST_DEF.
+ */
+struct zsl_sta_tdigest {
+	/**
+	 * @brief The centroid means, whose size is the centroid capacity.
+	 */
+	struct zsl_vec mean;
+	/**
+	 * @brief The centroid weights, the same size as 'mean'.
+	 */
+	struct zsl_vec weight;
+	/**
+	 * @brief The number of centroids in use.
+	 */
+	size_t n;
+	/**
+	 * @brief The compression, roughly the number of centroids kept after
+	 *        combining them. Larger values are more accurate.
+	 */
+	zsl_real_t delta;
+	/**
+	 * @brief The total weight of all samples, i.e. the number added.
+	 */
+	zsl_real_t total;
+	/**
+	 * @brief The smallest sample, only valid when 'total' is non-zero.
+	 */
+	zsl_real_t min;
+	/**
+	 * @brief The largest sample, only valid when 'total' is non-zero.
+	 */
+	zsl_real_t max;
+};
+
+/**
+ * Macro to declare a t-digest with room for 'n' centroids.
+ *
+ * Be sure to also call 'zsl_sta_tdigest_init' on the digest after this
+ * macro, since the storage is not initialised.
+ */
+#define ZSL_STA_TDIGEST_DEF(name, n)		 \
+	zsl_real_t name ## _mean[n];		 \
+	zsl_real_t name ## _weight[n];		 \
+	struct zsl_sta_tdigest name = {		 \
+		.mean = {			 \
+			.sz = n,		 \
+			.data = name ## _mean	 \
+		},				 \
+		.weight = {			 \
+			.sz = n,		 \
+			.data = name ## _weight	 \
+		}				 \
+	}
+
+/**
+ * @brief Running covariance of a stream of observation rows.
+ *
+ * Each row of n values updates the column means and the co-moment matrix
+ * 'c2' in a single O(n^2 / 2) pass, using the multivariate form of
+ * Welford's update, so the samples themselves are never stored. Only the
+ * upper triangle of 'c2' is maintained. Declare the accumulator and its
+ * storage with @ref ZSL_STA_COVAR_STREAM_DEF.
+ */
+struct zsl_sta_covar_stream {
+	/**
+	 * @brief The number of rows added so far.
+	 */
+	size_t rows;
+	/**
+	 * @brief The mean of each column, of size n.
+	 */
+	struct zsl_vec mean;
+	/**
+	 * @brief Scratch vector of size n, holding the deviation of the last
+	 *        row from the previous means.
+	 */
+	struct zsl_vec delta;
+	/**
+	 * @brief The nxn matrix of summed products of deviations from the
+	 *        mean, of which only the upper triangle is kept up to date.
+	 */
+	struct zsl_mtx c2;
+};
+
+/**
+ * Macro to declare a running covariance accumulator for rows of 'n' values.
+ *
+ * Be sure to also call 'zsl_sta_covar_stream_init' on the accumulator after
+ * this macro, since the storage is not initialised.
+ */
+#define ZSL_STA_COVAR_STREAM_DEF(name, n)	 \
+	zsl_real_t name ## _mean[n];		 \
+	zsl_real_t name ## _delta[n];		 \
+	zsl_real_t name ## _c2[(n) * (n)];	 \
+	struct zsl_sta_covar_stream name = {	 \
+		.rows = 0,			 \
+		.mean = {			 \
+			.sz = n,		 \
+			.data = name ## _mean	 \
+		},				 \
+		.delta = {			 \
+			.sz = n,		 \
+			.data = name ## _delta	 \
+		},				 \
+		.c2 = {				 \
+			.sz_rows = n,		 \
+			.sz_cols = n,		 \
+			.data = name ## _c2	 \
+		}				 \
+	}
+
+/**
+ * @brief Running least squares fit, accumulating the (optionally weighted)
+ *        normal equations X^T * W * X * beta = X^T * W * y row by row.
+ *
+ * Each row costs O(p^2 / 2) operations, independent of the number of rows
+ * seen so far, and the fit is solved on request with a Cholesky
+ * factorisation. Declare the accumulator and its storage with
+ * @ref ZSL_STA_LS_STREAM_DEF.
+ */
+struct zsl_sta_ls_stream {
+	/**
+	 * @brief The pxp matrix X^T * W * X, of which only the lower triangle
+	 *        is kept up to date.
+	 */
+	struct zsl_mtx xtx;
+	/**
+	 * @brief The vector X^T * W * y, of size p.
+	 */
+	struct zsl_vec xty;
+	/**
+	 * @brief Scratch pxp matrix, holding the Cholesky factor of 'xtx' for
+	 *        the last solve.
+	 */
+	struct zsl_mtx l;
+	/**
+	 * @brief The number of rows added so far.
+	 */
+	size_t rows;
+};
+
+/**
+ * Macro to declare a running least squares fit for 'p' parameters.
+ *
+ * Be sure to also call 'zsl_sta_ls_stream_init' on the accumulator after
+ * this macro, since the storage is not initialised.
+ */
+#define ZSL_STA_LS_STREAM_DEF(name, p)		 \
+	zsl_real_t name ## _xtx[(p) * (p)];	 \
+	zsl_real_t name ## _xty[p];		 \
+	zsl_real_t name ## _l[(p) * (p)];	 \
+	struct zsl_sta_ls_stream name = {	 \
+		.xtx = {			 \
+			.sz_rows = p,		 \
+			.sz_cols = p,		 \
+			.data = name ## _xtx	 \
+		},				 \
+		.xty = {			 \
+			.sz = p,		 \
+			.data = name ## _xty	 \
+		},				 \
+		.l = {				 \
+			.sz_rows = p,		 \
+			.sz_cols = p,		 \
+			.data = name ## _l	 \
+		},				 \
+		.rows = 0			 \
+	}
+
 /**
  * @brief Computes the arithmetic mean (average) of a vector.
  *
@@ -53,7 +515,7 @@ struct zsl_sta_linreg {
  *
  * @return int
  */
-int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m);
+int zsl_sta_mean(const struct zsl_vec *v, zsl_real_t *m);
 
 /**
  * @brief Subtracts the mean of vector v from every component of the vector.
@@ -65,19 +527,72 @@ int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w);
+int zsl_sta_demean(const struct zsl_vec *v, struct zsl_vec *w);
 
 /**
  * @brief Computes the given percentile of a vector.
  *
+ * This is the element at sorted position floor(p * n / 100), or the mean of
+ * that element and the one before it if p * n / 100 is a whole number. It
+ * is found by selection on a copy of 'v' rather than a full sort, which is
+ * O(n) on average and O(n log(n)) in the worst case.
+ *
  * @param v    The input vector.
  * @param p    The percentile to be calculated.
  * @param val  The output value.
  *
- * @return  0 if everything executed correctly, otherwise an appropriate
- *          error code.
+ * @return  0 if everything executed correctly, -EINVAL if 'v' is empty or
+ *          'p' needs an element outside of 'v', or -ENOMEM if the copy of
+ *          'v' doesn't fit in the scratch memory.
+ */
+int zsl_sta_percentile(const struct zsl_vec *v, size_t p, zsl_real_t *val);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_percentile, but reorders the elements of
+ *        'v' in place instead of working on a copy.
+ *
+ * @param v    The input vector, whose elements are reordered.
+ * @param p    The percentile to be calculated.
+ * @param val  The output value.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL as for
+ *          @ref zsl_sta_percentile.
+ */
+int zsl_sta_percentile_d(struct zsl_vec *v, size_t p, zsl_real_t *val);
+
+/**
+ * @brief Computes several percentiles of a vector in one pass.
+ *
+ * Each percentile is defined as in @ref zsl_sta_percentile. After each one
+ * is selected, the values below it are left in front of it, so the next
+ * selection only searches the remaining part of the copy of 'v'.
+ *
+ * @param v    The input vector.
+ * @param p    The 'n' percentiles to be calculated, in ascending order.
+ * @param n    The number of percentiles in 'p'.
+ * @param val  The 'n' output values, in the same order as 'p'.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if 'v' is empty, 'p'
+ *          isn't in ascending order or needs an element outside of 'v', or
+ *          -ENOMEM if the copy of 'v' doesn't fit in the scratch memory.
  */
-int zsl_sta_percentile(struct zsl_vec *v, size_t p, zsl_real_t *val);
+int zsl_sta_percentiles(const struct zsl_vec *v, const size_t *p, size_t n,
+			zsl_real_t *val);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_percentiles, but reorders the elements
+ *        of 'v' in place instead of working on a copy.
+ *
+ * @param v    The input vector, whose elements are reordered.
+ * @param p    The 'n' percentiles to be calculated, in ascending order.
+ * @param n    The number of percentiles in 'p'.
+ * @param val  The 'n' output values, in the same order as 'p'.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL as for
+ *          @ref zsl_sta_percentiles.
+ */
+int zsl_sta_percentiles_d(struct zsl_vec *v, const size_t *p, size_t n,
+			  zsl_real_t *val);
 
 /**
  * @brief Computes the median of a vector (the value separating the higher half
@@ -89,11 +604,13 @@ int zsl_sta_percentile(struct zsl_vec *v, size_t p, zsl_real_t *val);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_median(struct zsl_vec *v, zsl_real_t *m);
+int zsl_sta_median(const struct zsl_vec *v, zsl_real_t *m);
 
 /**
  * @brief Calculates the first, second and third quartiles of a vector v.
  *
+ * All three come from a single call to @ref zsl_sta_percentiles.
+ *
  * @param v   The vector to use.
  * @param q1  The first quartile of v.
  * @param q1  The second quartile of v, also the median of v.
@@ -102,7 +619,7 @@ int zsl_sta_median(struct zsl_vec *v, zsl_real_t *m);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_quart(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
+int zsl_sta_quart(const struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
 		  zsl_real_t *q3);
 
 /**
@@ -115,19 +632,167 @@ int zsl_sta_quart(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_quart_range(struct zsl_vec *v, zsl_real_t *r);
+int zsl_sta_quart_range(const struct zsl_vec *v, zsl_real_t *r);
+
+/**
+ * @brief Computes the median absolute deviation of a vector, the median of
+ *        |v[i] - median(v)|, which is a measure of spread that, unlike the
+ *        standard deviation, isn't thrown off by a few outliers.
+ *
+ * Multiply the result by ZSL_STA_MAD_NORMAL to estimate the standard
+ * deviation of normally distributed data. The median and the MAD are each
+ * found by selection, in O(n) average time, on one copy of 'v' taken from
+ * scratch memory.
+ *
+ * @param v    The input vector.
+ * @param med  The median of v. This may be NULL.
+ * @param mad  The median absolute deviation of v.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if v is empty, or
+ *          -ENOMEM if no scratch memory was available.
+ */
+int zsl_sta_mad(const struct zsl_vec *v, zsl_real_t *med, zsl_real_t *mad);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_mad, working on 'v' in place. The
+ *        contents of 'v' are replaced by the absolute deviations from its
+ *        median, in no particular order.
+ */
+int zsl_sta_mad_d(struct zsl_vec *v, zsl_real_t *med, zsl_real_t *mad);
+
+/**
+ * @brief Computes the trimmed mean of a vector: the mean of its values
+ *        once the lowest and highest p percent are dropped.
+ *
+ * floor(p * n / 100) values are dropped from each end. They are moved
+ * aside by two selections on a copy of 'v' in scratch memory, in O(n)
+ * average time, rather than by sorting.
+ *
+ * @param v  The input vector.
+ * @param p  The percentage to drop from each end, below 50.
+ * @param m  The trimmed mean of v.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if v is empty or no
+ *          values would remain, or -ENOMEM if no scratch memory was
+ *          available.
+ */
+int zsl_sta_trim_mean(const struct zsl_vec *v, size_t p, zsl_real_t *m);
+
+/**
+ * @brief Computes the winsorized mean of a vector: the mean once the lowest
+ *        and highest p percent of its values are replaced by the nearest
+ *        remaining value, so they still count, but only as far as the rest
+ *        of the data extends.
+ *
+ * The values are chosen as for @ref zsl_sta_trim_mean, and the same errors
+ * are returned.
+ */
+int zsl_sta_winsor_mean(const struct zsl_vec *v, size_t p, zsl_real_t *m);
+
+/**
+ * @brief Copies the values of v within 't' robust standard deviations of
+ *        its median to w, dropping the outliers, so that the result can be
+ *        passed on to @ref zsl_sta_mean or @ref zsl_sta_linear_reg.
+ *
+ * A value is kept when |v[i] - median| <= t * ZSL_STA_MAD_NORMAL * MAD.
+ * 't' = 3.0 is a common choice. Values keep their original order.
+ *
+ * @param v  The input vector.
+ * @param t  The threshold, in robust standard deviations.
+ * @param w  The output vector, with room for v->sz values. Its length is
+ *           set to the number kept. This may be v.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if v is empty, w is
+ *          too short or t is negative, or -ENOMEM if no scratch memory was
+ *          available.
+ */
+int zsl_sta_reject_outliers(const struct zsl_vec *v, zsl_real_t t,
+			    struct zsl_vec *w);
+
+/**
+ * @brief Fills 'sum' with the descriptive statistics of vector v.
+ *
+ * The mean, variance, minimum and maximum come from a single pass over v
+ * with Welford's update, which also copies v to scratch space. The
+ * quartiles are then selected from that copy with one call to
+ * @ref zsl_sta_percentiles_d. This is much cheaper than calling
+ * zsl_sta_mean, zsl_sta_var, zsl_sta_data_range, zsl_sta_quart and so on
+ * separately, several of which make their own copies.
+ *
+ * @param v    The vector to use.
+ * @param sum  The output statistics.
+ *
+ * @return  0 on success, -EINVAL if v is empty, or -ENOMEM if no scratch
+ *          space is available.
+ */
+int zsl_sta_summary(const struct zsl_vec *v, struct zsl_sta_summary *sum);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_sta_summary_ws for a vector of n values.
+ *
+ * @param n  The length of the input vector.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_sta_summary_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_summary, taking its copy of v from
+ *        workspace 'ws' instead of declaring it on the stack.
+ *
+ * @param v    The vector to use.
+ * @param sum  The output statistics.
+ * @param ws   The workspace to allocate from, with at least
+ *             zsl_sta_summary_ws_sz(v->sz) free entries.
+ *
+ * @return  0 on success, -EINVAL if v is empty, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_sta_summary_ws(const struct zsl_vec *v, struct zsl_sta_summary *sum,
+		       struct zsl_workspace *ws);
 
 /**
  * @brief Computes the mode or modes of a vector v.
  *
+ * A sorted copy of v is scanned for its longest runs of values within
+ * 1E-7 of each other, which takes O(n log(n)) time.
+ *
  * @param v  The vector to use.
- * @param w  Output vector whose components are the modes. If there is only
- *           one mode, the length of w will be 1.
+ * @param w  Output vector whose components are the modes, in ascending
+ *           order. Its length is set to the number of modes, and must be
+ *           at least that number on entry.
  *
- * @return  0 if everything executed correctly, otherwise an appropriate
- *          error code.
+ * @return  0 if everything executed correctly, -EINVAL if w is too short
+ *          to hold every mode, or -ENOMEM if no scratch space is available.
  */
-int zsl_sta_mode(struct zsl_vec *v, struct zsl_vec *w);
+int zsl_sta_mode(const struct zsl_vec *v, struct zsl_vec *w);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_sta_mode_ws for a vector of n values.
+ *
+ * @param n  The length of the input vector.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_sta_mode_ws_sz(size_t n);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_mode, taking its sorted copy of v from
+ *        workspace 'ws' instead of declaring it on the stack.
+ *
+ * @param v   The vector to use.
+ * @param w   Output vector whose components are the modes, as for
+ *            @ref zsl_sta_mode.
+ * @param ws  The workspace to allocate from, with at least
+ *            zsl_sta_mode_ws_sz(v->sz) free entries.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if w is too short
+ *          to hold every mode, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_sta_mode_ws(const struct zsl_vec *v, struct zsl_vec *w,
+		    struct zsl_workspace *ws);
 
 /**
  * @brief Computes the difference between the greatest value and the lowest in
@@ -136,10 +801,9 @@ int zsl_sta_mode(struct zsl_vec *v, struct zsl_vec *w);
  * @param v The vector to use.
  * @param r The range of the data in v.
  *
- * @return  0 if everything executed correctly, otherwise an appropriate
- *          error code.
+ * @return  0 if everything executed correctly, or -EINVAL if v is empty.
  */
-int zsl_sta_data_range(struct zsl_vec *v, zsl_real_t *r);
+int zsl_sta_data_range(const struct zsl_vec *v, zsl_real_t *r);
 
 /**
  * @brief Computes the variance of a vector v (the average of the squared
@@ -151,7 +815,7 @@ int zsl_sta_data_range(struct zsl_vec *v, zsl_real_t *r);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var);
+int zsl_sta_var(const struct zsl_vec *v, zsl_real_t *var);
 
 /**
  * @brief Computes the standard deviation of vector v.
@@ -167,7 +831,7 @@ int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_sta_dev(struct zsl_vec *v, zsl_real_t *s);
+int zsl_sta_sta_dev(const struct zsl_vec *v, zsl_real_t *s);
 
 /**
  * @brief Computes the variance of two sets of data: v and w.
@@ -178,19 +842,103 @@ int zsl_sta_sta_dev(struct zsl_vec *v, zsl_real_t *s);
  *
  * @return 0 on success, and -EINVAL if the vectors aren't identically sized.
  */
-int zsl_sta_covar(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *c);
+int zsl_sta_covar(const struct zsl_vec *v, const struct zsl_vec *w,
+		  zsl_real_t *c);
 
 /**
  * @brief Calculates the nxn covariance matrix of a set of n vectors of the
  *        same length.
  *
+ * The rows of 'm' are read once, in order, each updating the upper triangle
+ * of 'mc' as for @ref zsl_sta_covar_stream_feed, which is then mirrored
+ * into the lower triangle. Only 2n entries of scratch space are needed,
+ * however many rows 'm' has.
+ *
  * @param m   Input matrix, whose columns are the different data sets.
  * @param mc  Output nxn covariance matrix.
  *
  * @return 0 on success, and -EINVAL if 'mc' is not a square matrix with the
- * 		   same number of columns as 'm'.
+ * 		   same number of columns as 'm', or -ENOMEM if no scratch space
+ * 		   is available.
  */
-int zsl_sta_covar_mtx(struct zsl_mtx *m, struct zsl_mtx *mc);
+int zsl_sta_covar_mtx(const struct zsl_mtx *m, struct zsl_mtx *mc);
+
+/**
+ * @brief Calculates the nxn Pearson correlation matrix of a set of n vectors
+ *        of the same length, in the same single pass as
+ *        @ref zsl_sta_covar_mtx.
+ *
+ * Entries involving a column with no variance are set to 0.0, apart from
+ * the diagonal, which is always 1.0.
+ *
+ * @param m   Input matrix, whose columns are the different data sets.
+ * @param mr  Output nxn correlation matrix.
+ *
+ * @return 0 on success, and -EINVAL if 'mr' is not a square matrix with the
+ *         same number of columns as 'm', or -ENOMEM if no scratch space is
+ *         available.
+ */
+int zsl_sta_corr_mtx(const struct zsl_mtx *m, struct zsl_mtx *mr);
+
+/**
+ * @brief Resets running covariance accumulator 's' to hold no rows.
+ *
+ * @param s  The accumulator to reset.
+ *
+ * @return 0 on success, or -EINVAL if its members aren't consistently sized.
+ */
+int zsl_sta_covar_stream_init(struct zsl_sta_covar_stream *s);
+
+/**
+ * @brief Adds observation row 'x' to running covariance accumulator 's', in
+ *        O(n^2 / 2) operations.
+ *
+ * @param s  The accumulator to update.
+ * @param x  The new row, of size n.
+ *
+ * @return 0 on success, or -EINVAL if 'x' is the wrong size.
+ */
+int zsl_sta_covar_stream_feed(struct zsl_sta_covar_stream *s,
+			      const struct zsl_vec *x);
+
+/**
+ * @brief Adds every row of matrix 'm' to running covariance accumulator 's',
+ *        in order.
+ *
+ * @param s  The accumulator to update.
+ * @param m  The new rows, with n columns.
+ *
+ * @return 0 on success, or -EINVAL if 'm' has the wrong number of columns.
+ */
+int zsl_sta_covar_stream_feed_mtx(struct zsl_sta_covar_stream *s,
+				  const struct zsl_mtx *m);
+
+/**
+ * @brief Returns the nxn covariance matrix of the rows added to running
+ *        covariance accumulator 's', with the same n - 1 divisor as
+ *        @ref zsl_sta_covar_mtx.
+ *
+ * @param s   The accumulator to use.
+ * @param mc  Output nxn covariance matrix.
+ *
+ * @return 0 on success, or -EINVAL if 'mc' is the wrong size or fewer than
+ *         two rows have been added.
+ */
+int zsl_sta_covar_stream_covar(const struct zsl_sta_covar_stream *s,
+			       struct zsl_mtx *mc);
+
+/**
+ * @brief Returns the nxn Pearson correlation matrix of the rows added to
+ *        running covariance accumulator 's', as for @ref zsl_sta_corr_mtx.
+ *
+ * @param s   The accumulator to use.
+ * @param mr  Output nxn correlation matrix.
+ *
+ * @return 0 on success, or -EINVAL if 'mr' is the wrong size or fewer than
+ *         two rows have been added.
+ */
+int zsl_sta_covar_stream_corr(const struct zsl_sta_covar_stream *s,
+			      struct zsl_mtx *mr);
 
 /**
  * @brief Calculates the slope, intercept and correlation coefficient of the
@@ -218,9 +966,446 @@ int zsl_sta_covar_mtx(struct zsl_mtx *m, struct zsl_mtx *mc);
  *
  * @return 0 on success, and -EINVAL if the vectors aren't identically sized.
  */
-int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
+int zsl_sta_linear_reg(const struct zsl_vec *v, const struct zsl_vec *w,
 		       struct zsl_sta_linreg *c);
 
+/**
+ * @brief Fits y = X * beta in the (optionally weighted) least squares sense,
+ *        for an mxp design matrix X with m >= p.
+ *
+ * The rows of X and y are scaled by the square roots of the weights, and the
+ * result is solved with a Householder QR decomposition and back
+ * substitution, which avoids squaring the condition number of X as the
+ * normal equations do, and is far cheaper than @ref zsl_mtx_pinv.
+ *
+ * @param x     The mxp design matrix, one observation per row.
+ * @param y     The m observations.
+ * @param w     The m non-negative weights, or NULL to weight every
+ *              observation equally.
+ * @param beta  The p fitted coefficients.
+ *
+ * @return 0 on success, -EINVAL if the sizes don't match, m < p or a weight
+ *         is negative, -ESINGULAR if the columns of X (with non-zero weight)
+ *         are linearly dependent, or -ENOMEM if no scratch space is
+ *         available.
+ */
+int zsl_sta_mult_linear_reg(const struct zsl_mtx *x, const struct zsl_vec *y,
+			    const struct zsl_vec *w, struct zsl_vec *beta);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_sta_mult_linear_reg_ws for an mxp design matrix.
+ *
+ * @param m  The number of observations.
+ * @param p  The number of coefficients.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_sta_mult_linear_reg_ws_sz(size_t m, size_t p);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_mult_linear_reg, taking its temporaries
+ *        from workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param x     The mxp design matrix, one observation per row.
+ * @param y     The m observations.
+ * @param w     The m non-negative weights, or NULL.
+ * @param beta  The p fitted coefficients.
+ * @param ws    The workspace to allocate temporaries from, with at least
+ *              zsl_sta_mult_linear_reg_ws_sz(m, p) free entries.
+ *
+ * @return As for @ref zsl_sta_mult_linear_reg, or -ENOMEM if 'ws' is too
+ *         small.
+ */
+int zsl_sta_mult_linear_reg_ws(const struct zsl_mtx *x,
+			       const struct zsl_vec *y,
+			       const struct zsl_vec *w, struct zsl_vec *beta,
+			       struct zsl_workspace *ws);
+
+/**
+ * @brief Fits the polynomial y = c[0] + c[1] * x + ... + c[d] * x^d, of
+ *        degree d = c->sz - 1, in the (optionally weighted) least squares
+ *        sense.
+ *
+ * This builds the Vandermonde matrix of 'x' and calls
+ * @ref zsl_sta_mult_linear_reg_ws. Centring and scaling 'x' to around
+ * [-1, 1] beforehand improves the accuracy of higher degree fits.
+ *
+ * @param x  The sample positions.
+ * @param y  The samples, the same size as 'x'.
+ * @param w  The non-negative weights, the same size as 'x', or NULL.
+ * @param c  The fitted coefficients, in increasing powers of 'x'.
+ *
+ * @return As for @ref zsl_sta_mult_linear_reg.
+ */
+int zsl_sta_poly_fit(const struct zsl_vec *x, const struct zsl_vec *y,
+		     const struct zsl_vec *w, struct zsl_vec *c);
+
+/**
+ * @brief Returns the number of zsl_real_t entries of workspace required by
+ *        @ref zsl_sta_poly_fit_ws for m samples and p = d + 1 coefficients.
+ *
+ * @param m  The number of samples.
+ * @param p  The number of coefficients.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_sta_poly_fit_ws_sz(size_t m, size_t p);
+
+/**
+ * @brief Equivalent to @ref zsl_sta_poly_fit, taking its temporaries from
+ *        workspace 'ws' instead of declaring them on the stack.
+ *
+ * @param x   The sample positions.
+ * @param y   The samples, the same size as 'x'.
+ * @param w   The non-negative weights, the same size as 'x', or NULL.
+ * @param c   The fitted coefficients, in increasing powers of 'x'.
+ * @param ws  The workspace to allocate temporaries from, with at least
+ *            zsl_sta_poly_fit_ws_sz(x->sz, c->sz) free entries.
+ *
+ * @return As for @ref zsl_sta_poly_fit, or -ENOMEM if 'ws' is too small.
+ */
+int zsl_sta_poly_fit_ws(const struct zsl_vec *x, const struct zsl_vec *y,
+			const struct zsl_vec *w, struct zsl_vec *c,
+			struct zsl_workspace *ws);
+
+/**
+ * @brief Resets running least squares fit 's' to hold no rows.
+ *
+ * @param s  The accumulator to reset.
+ *
+ * @return 0 on success, or -EINVAL if its members aren't consistently sized.
+ */
+int zsl_sta_ls_stream_init(struct zsl_sta_ls_stream *s);
+
+/**
+ * @brief Adds observation 'y' of design row 'x', with weight 'w', to running
+ *        least squares fit 's', in O(p^2 / 2) operations.
+ *
+ * @param s  The accumulator to update.
+ * @param x  The design row, of size p.
+ * @param y  The observation.
+ * @param w  The non-negative weight of the observation, 1.0 for an
+ *           unweighted fit.
+ *
+ * @return 0 on success, or -EINVAL if 'x' is the wrong size or 'w' is
+ *         negative.
+ */
+int zsl_sta_ls_stream_feed(struct zsl_sta_ls_stream *s,
+			   const struct zsl_vec *x, zsl_real_t y,
+			   zsl_real_t w);
+
+/**
+ * @brief Solves running least squares fit 's' for the coefficients that
+ *        best fit the rows added so far.
+ *
+ * Solving the normal equations squares the condition number of the design
+ * matrix, so prefer @ref zsl_sta_mult_linear_reg when all of the rows are
+ * available, and the columns are poorly scaled or nearly dependent.
+ *
+ * @param s     The accumulator to solve. Only its scratch 'l' is modified.
+ * @param beta  The p fitted coefficients.
+ *
+ * @return 0 on success, -EINVAL if 'beta' is the wrong size, or -ENOTPOSDEF
+ *         if too few independent rows have been added to determine 'beta'.
+ */
+int zsl_sta_ls_stream_solve(struct zsl_sta_ls_stream *s, struct zsl_vec *beta);
+
+/**
+ * @brief Resets recursive least squares estimator 'rls', setting 'theta' to
+ *        zero and 'p' to delta * I.
+ *
+ * 'delta' reflects the confidence in the initial zero estimate: a large
+ * value (100.0 to 10000.0, for example) lets the first few samples move
+ * 'theta' quickly, while a small value makes it slow to leave zero.
+ *
+ * @param rls     The estimator to initialise.
+ * @param lambda  The forgetting factor, in the range (0.0, 1.0]. Use 1.0 to
+ *                weight all samples equally, like a batch least squares fit.
+ * @param delta   The initial diagonal value of 'p', which must be positive.
+ *
+ * @return 0 on success, and -EINVAL if 'lambda' or 'delta' are out of range.
+ */
+int zsl_sta_rls_init(struct zsl_sta_rls *rls, zsl_real_t lambda,
+		     zsl_real_t delta);
+
+/**
+ * @brief Updates recursive least squares estimator 'rls' with a new
+ *        observation 'y' of input row 'x', in O(n^2) operations.
+ *
+ * Once the influence of the initial 'delta' has faded, and with 'lambda' set
+ * to 1.0, 'theta' matches the least squares solution of all observations so
+ * far, i.e. pinv(X) * y for the stacked input rows X, without forming X.
+ * The prediction for a new input row is then zsl_vec_dot(&rls->theta, x).
+ *
+ * @param rls   The estimator to update.
+ * @param x     The input row, of size n.
+ * @param y     The observed output for 'x'.
+ * @param err   Pointer to the a priori error y - theta^T * x, computed before
+ *              'theta' is updated. This may be NULL.
+ *
+ * @return 0 on success, -EINVAL if 'x' is the wrong size, or -ENOTPOSDEF if
+ *         'p' has lost positive-definiteness, in which case 'rls' is left
+ *         unchanged and should be re-initialised.
+ */
+int zsl_sta_rls_update(struct zsl_sta_rls *rls, const struct zsl_vec *x,
+		       zsl_real_t y, zsl_real_t *err);
+
+/**
+ * @brief Resets streaming statistics accumulator 's' to hold no samples.
+ *
+ * @param s  The accumulator to reset.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_stream_init(struct zsl_sta_stream *s);
+
+/**
+ * @brief Adds sample 'x' to streaming statistics accumulator 's', in O(1)
+ *        operations.
+ *
+ * @param s  The accumulator to update.
+ * @param x  The new sample.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_stream_feed(struct zsl_sta_stream *s, zsl_real_t x);
+
+/**
+ * @brief Adds every component of vector v to streaming statistics
+ *        accumulator 's', in order.
+ *
+ * @param s  The accumulator to update.
+ * @param v  The new samples.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_stream_feed_vec(struct zsl_sta_stream *s,
+			    const struct zsl_vec *v);
+
+/**
+ * @brief Merges streaming statistics accumulator 'o' into 's', so that 's'
+ *        describes the samples of both, as if they had all been added to 's'.
+ *
+ * This lets a stream be split between threads or time periods, and the
+ * partial results combined later at no extra cost per sample.
+ *
+ * @param s  The accumulator to update.
+ * @param o  The accumulator to merge into 's', which is left unchanged.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_stream_merge(struct zsl_sta_stream *s,
+			 const struct zsl_sta_stream *o);
+
+/**
+ * @brief Returns the variance of the samples in streaming statistics
+ *        accumulator 's', with the same n - 1 divisor as @ref zsl_sta_var.
+ *
+ * @param s    The accumulator to use.
+ * @param var  The variance of the samples added to 's'.
+ *
+ * @return 0 on success, or -EINVAL if 's' holds fewer than two samples.
+ */
+int zsl_sta_stream_var(const struct zsl_sta_stream *s, zsl_real_t *var);
+
+/**
+ * @brief Returns the standard deviation of the samples in streaming
+ *        statistics accumulator 's', as for @ref zsl_sta_sta_dev.
+ *
+ * @param s    The accumulator to use.
+ * @param sd   The standard deviation of the samples added to 's'.
+ *
+ * @return 0 on success, or -EINVAL if 's' holds fewer than two samples.
+ */
+int zsl_sta_stream_sta_dev(const struct zsl_sta_stream *s, zsl_real_t *sd);
+
+/**
+ * @brief Returns the skewness of the samples in streaming statistics
+ *        accumulator 's', m3 / m2^(3/2) for the population moments m2 and m3.
+ *
+ * @param s     The accumulator to use.
+ * @param skew  The skewness of the samples, 0.0 for symmetric data.
+ *
+ * @return 0 on success, or -EINVAL if 's' holds fewer than two samples or
+ *         all of its samples are equal.
+ */
+int zsl_sta_stream_skew(const struct zsl_sta_stream *s, zsl_real_t *skew);
+
+/**
+ * @brief Returns the excess kurtosis of the samples in streaming statistics
+ *        accumulator 's', m4 / m2^2 - 3 for the population moments m2 and m4.
+ *
+ * @param s     The accumulator to use.
+ * @param kurt  The excess kurtosis of the samples, 0.0 for a normal
+ *              distribution.
+ *
+ * @return 0 on success, or -EINVAL if 's' holds fewer than two samples or
+ *         all of its samples are equal.
+ */
+int zsl_sta_stream_kurt(const struct zsl_sta_stream *s, zsl_real_t *kurt);
+
+/**
+ * @brief Empties sliding window 'w'.
+ *
+ * @param w  The window to reset.
+ *
+ * @return 0 on success, or -EINVAL if the window length is zero.
+ */
+int zsl_sta_window_init(struct zsl_sta_window *w);
+
+/**
+ * @brief Adds sample 'x' to sliding window 'w', replacing the oldest sample
+ *        once the window is full.
+ *
+ * The mean and variance are updated from the incoming and outgoing samples
+ * alone, so rounding errors can slowly build up over very long runs. Call
+ * @ref zsl_sta_window_init now and then if that matters more than the gap
+ * in the statistics.
+ *
+ * @param w  The window to update.
+ * @param x  The new sample.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_window_feed(struct zsl_sta_window *w, zsl_real_t x);
+
+/**
+ * @brief Returns the number of samples currently in sliding window 'w'.
+ *
+ * @param w  The window to use.
+ *
+ * @return The number of samples, at most the window length.
+ */
+size_t zsl_sta_window_count(const struct zsl_sta_window *w);
+
+/**
+ * @brief Returns the arithmetic mean of the samples in sliding window 'w'.
+ *
+ * @param w  The window to use.
+ * @param m  The mean of the samples in the window.
+ *
+ * @return 0 on success, or -EINVAL if the window is empty.
+ */
+int zsl_sta_window_mean(const struct zsl_sta_window *w, zsl_real_t *m);
+
+/**
+ * @brief Returns the variance of the samples in sliding window 'w', with the
+ *        same n - 1 divisor as @ref zsl_sta_var.
+ *
+ * @param w    The window to use.
+ * @param var  The variance of the samples in the window.
+ *
+ * @return 0 on success, or -EINVAL if the window holds fewer than two
+ *         samples.
+ */
+int zsl_sta_window_var(const struct zsl_sta_window *w, zsl_real_t *var);
+
+/**
+ * @brief Returns the smallest and largest samples in sliding window 'w'.
+ *
+ * @param w    The window to use.
+ * @param min  The smallest sample in the window. This may be NULL.
+ * @param max  The largest sample in the window. This may be NULL.
+ *
+ * @return 0 on success, or -EINVAL if the window is empty.
+ */
+int zsl_sta_window_range(const struct zsl_sta_window *w, zsl_real_t *min,
+			 zsl_real_t *max);
+
+/**
+ * @brief Empties Hampel filter 'h' and sets its threshold.
+ *
+ * @param h  The filter to reset.
+ * @param t  The threshold, in robust standard deviations, typically 3.0.
+ *
+ * @return 0 on success, or -EINVAL if the window length is zero or 't' is
+ *         negative.
+ */
+int zsl_sta_hampel_init(struct zsl_sta_hampel *h, zsl_real_t t);
+
+/**
+ * @brief Adds sample 'x' to Hampel filter 'h', and returns the filtered
+ *        sample in 'y'.
+ *
+ * 'x' is compared with the median and the median absolute deviation of the
+ * window, including 'x' itself, and 'y' is the median if
+ * |x - median| > t * ZSL_STA_MAD_NORMAL * MAD, or 'x' otherwise. This tests
+ * each sample as it arrives, with no delay, rather than the centre of the
+ * window. Outliers are still added to the window, so that a lasting step
+ * in the signal is followed once it fills half of the window.
+ *
+ * Each call takes O(log(n)) comparisons for a window of 'n' samples, plus
+ * moving at most n values by one place.
+ *
+ * @param h  The filter to update.
+ * @param x  The new sample.
+ * @param y  The filtered sample.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_hampel_feed(struct zsl_sta_hampel *h, zsl_real_t x,
+			zsl_real_t *y);
+
+/**
+ * @brief Empties t-digest 'td' and sets its compression.
+ *
+ * With compression 'delta', a digest keeps between 'delta' and 2 * delta
+ * centroids once they are combined, and needs room for at least 2 * delta
+ * of them so that new samples can be buffered in between. 'delta' = 32
+ * with room for 64 centroids, for example, typically estimates quantiles to
+ * within a few tenths of a percent of the data range, and the extreme
+ * quantiles more closely still.
+ *
+ * @param td     The digest to reset.
+ * @param delta  The compression, at least 1.0.
+ *
+ * @return 0 on success, or -EINVAL if 'delta' is below 1.0 or the centroid
+ *         storage is too small for it.
+ */
+int zsl_sta_tdigest_init(struct zsl_sta_tdigest *td, zsl_real_t delta);
+
+/**
+ * @brief Adds sample 'x' to t-digest 'td', in O(log(n)) amortised operations
+ *        for a capacity of n centroids.
+ *
+ * @param td  The digest to update.
+ * @param x   The new sample.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_tdigest_feed(struct zsl_sta_tdigest *td, zsl_real_t x);
+
+/**
+ * @brief Merges t-digest 'o' into 'td', so that 'td' estimates the quantiles
+ *        of the samples of both.
+ *
+ * @param td  The digest to update.
+ * @param o   The digest to merge into 'td', which is left unchanged. Its
+ *            compression and capacity may differ from those of 'td'.
+ *
+ * @return 0 on success.
+ */
+int zsl_sta_tdigest_merge(struct zsl_sta_tdigest *td,
+			  const struct zsl_sta_tdigest *o);
+
+/**
+ * @brief Estimates quantile 'q' of the samples in t-digest 'td'.
+ *
+ * The centroids are combined first, if any samples have been added since
+ * the last call, which is why 'td' isn't const.
+ *
+ * @param td   The digest to use.
+ * @param q    The quantile to estimate, from 0.0 (the minimum) to 1.0 (the
+ *             maximum), e.g. 0.99 for p99.
+ * @param val  The estimated value of quantile 'q'.
+ *
+ * @return 0 on success, or -EINVAL if 'td' is empty or 'q' is outside
+ *         [0.0, 1.0].
+ */
+int zsl_sta_tdigest_quantile(struct zsl_sta_tdigest *td, zsl_real_t q,
+			     zsl_real_t *val);
+
 /**
  * @brief Calculates the absolute error given a value and its expected value.
  *
@@ -231,7 +1416,8 @@ int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err);
+int zsl_sta_abs_err(const zsl_real_t *val, const zsl_real_t *exp_val,
+		    zsl_real_t *err);
 
 /**
  * @brief Calculates the relative error given a value and its expected value.
@@ -243,7 +1429,8 @@ int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_sta_rel_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err);
+int zsl_sta_rel_err(const zsl_real_t *val, const zsl_real_t *exp_val,
+		    zsl_real_t *err);
 
 #ifdef __cplusplus
 }
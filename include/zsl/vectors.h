@@ -22,12 +22,16 @@
 #ifndef ZEPHYR_INCLUDE_ZSL_VECTORS_H_
 #define ZEPHYR_INCLUDE_ZSL_VECTORS_H_
 
+#include <errno.h>
 #include <zsl/zsl.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Forward declaration, see zsl/workspace.h. */
+struct zsl_workspace;
+
 /**
  * @addtogroup VEC_STRUCTS Structs, Enums and Macros
  *
@@ -44,6 +48,21 @@ struct zsl_vec {
 	zsl_real_t *data;
 };
 
+/**
+ * @brief Steps a window of 'len' values over a vector, 'hop' values at a
+ *        time, without copying. See @ref zsl_vec_win_init.
+ */
+struct zsl_vec_win {
+	/** The vector being stepped over. */
+	const struct zsl_vec *v;
+	/** The number of values in each window. */
+	size_t len;
+	/** The distance between the start of consecutive windows. */
+	size_t hop;
+	/** The offset of the next window in 'v'. */
+	size_t pos;
+};
+
 /** Macro to declare a vector of size `n`.
  *
  * Be sure to also call 'zsl_vec_init' on the vector after this macro, since
@@ -56,6 +75,49 @@ struct zsl_vec {
 		.data = name ## _vec \
 	}
 
+/**
+ * Macro to declare a vector of size `n` whose data is aligned to
+ * ZSL_DATA_ALIGN bytes, and padded to a whole number of ZSL_DATA_ALIGN
+ * blocks.
+ *
+ * The optimised kernels detect aligned operands and use aligned SIMD
+ * loads and stores on them, and the aligned data never splits a cache
+ * line. The padding entries aren't part of the vector.
+ */
+#define ZSL_VECTOR_DEF_ALIGNED(name, n)					\
+	zsl_real_t name ## _vec[ZSL_ALIGN_PAD(n)]			\
+	__attribute__((aligned(ZSL_DATA_ALIGN)));			\
+	struct zsl_vec name = {						\
+		.sz = n,						\
+		.data = name ## _vec					\
+	}
+
+/** Macro to declare a read-only vector of size `n`, initialised from the
+ * values that follow.
+ *
+ * As with ZSL_MATRIX_CONST_DEF, the vector is placed in flash and can be
+ * passed to any 'const struct zsl_vec *' input parameter without copying.
+ */
+#define ZSL_VECTOR_CONST_DEF(name, n, ...)				\
+	static const zsl_real_t name ## _vec[n] = { __VA_ARGS__ };	\
+	static const struct zsl_vec name = {				\
+		.sz = n,						\
+		.data = (zsl_real_t *)name ## _vec			\
+	}
+
+/**
+ * @brief The longest vector that the inline versions of zsl_vec_add,
+ *        zsl_vec_scalar_mult and zsl_vec_dot handle themselves when
+ *        CONFIG_ZSL_VECTOR_INLINE is enabled.
+ *
+ * Longer vectors are passed to the library functions, which can use the
+ * platform kernels. This must be no more than 64, so that the inline
+ * zsl_vec_dot sums in the same order as the library function.
+ */
+#ifndef ZSL_VEC_INLINE_MAX
+#define ZSL_VEC_INLINE_MAX      (16)
+#endif
+
 /** @} */ /* End of VEC_STRUCTS group */
 
 /**
@@ -90,7 +152,7 @@ int zsl_vec_init(struct zsl_vec *v);
  *
  * @return 0 on success, and non-zero error code on failure
  */
-int zsl_vec_from_arr(struct zsl_vec *v, zsl_real_t *a);
+int zsl_vec_from_arr(struct zsl_vec *v, const zsl_real_t *a);
 
 /**
  * @brief Copies the contents of vector 'vsrc' into vector 'vdest'.
@@ -100,7 +162,7 @@ int zsl_vec_from_arr(struct zsl_vec *v, zsl_real_t *a);
  *
  * @return 0 on success, and non-zero error code on failure
  */
-int zsl_vec_copy(struct zsl_vec *vdest, struct zsl_vec *vsrc);
+int zsl_vec_copy(struct zsl_vec *vdest, const struct zsl_vec *vsrc);
 
 /** @} */ /* End of VEC_INIT group */
 
@@ -124,9 +186,59 @@ int zsl_vec_copy(struct zsl_vec *vdest, struct zsl_vec *vsrc);
  *
  * @return 0 on success, -EINVAL on a size of index error.
  */
-int zsl_vec_get_subset(struct zsl_vec *v, size_t offset, size_t len,
+int zsl_vec_get_subset(const struct zsl_vec *v, size_t offset, size_t len,
 		       struct zsl_vec *vsub);
 
+/**
+ * @brief Points 'vw' at a window of 'len' values in source vector 'v',
+ *        starting at 'offset', without copying them.
+ *
+ * The window shares the data of 'v', so writes through either are seen by
+ * both, and it is only valid while the data of 'v' is.
+ *
+ * @param v         The parent vector to take a window of.
+ * @param offset    The starting index (zero-based) of the window.
+ * @param len       The number of values in the window.
+ * @param vw        The window vector, whose data pointer is overwritten.
+ *
+ * @return 0 on success, -EINVAL if the window extends beyond the end of
+ *         'v'.
+ */
+int zsl_vec_view(const struct zsl_vec *v, size_t offset, size_t len,
+		 struct zsl_vec *vw);
+
+/**
+ * @brief Prepares 'w' to step a window of 'len' values over vector 'v',
+ *        moving 'hop' values each time, starting at the first value.
+ *
+ * Windows overlap when 'hop' is less than 'len'. Windows are returned by
+ * @ref zsl_vec_win_next as views of 'v', so no memory is allocated or
+ * copied, and a window that would run past the end of 'v' isn't returned.
+ *
+ * @param w     The window iterator to prepare.
+ * @param v     The vector to step over.
+ * @param len   The number of values in each window.
+ * @param hop   The distance between the start of consecutive windows.
+ *
+ * @return 0 on success, or -EINVAL if 'len' or 'hop' is zero.
+ */
+int zsl_vec_win_init(struct zsl_vec_win *w, const struct zsl_vec *v,
+		     size_t len, size_t hop);
+
+/**
+ * @brief Points 'vw' at the next window of iterator 'w', and advances it.
+ *
+ * A typical loop is:
+ *
+ *   while (zsl_vec_win_next(&w, &vw) == 0) { ... }
+ *
+ * @param w     The window iterator, prepared by @ref zsl_vec_win_init.
+ * @param vw    The window vector, whose data pointer is overwritten.
+ *
+ * @return 0 on success, or -ENOENT if no complete window remains.
+ */
+int zsl_vec_win_next(struct zsl_vec_win *w, struct zsl_vec *vw);
+
 /** @} */ /* End of VEC_SELECTION group */
 
 /**
@@ -146,7 +258,34 @@ int zsl_vec_get_subset(struct zsl_vec *v, size_t offset, size_t len,
  *
  * @return 0 on success, -EINVAL if v and w are not equal length.
  */
-int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x);
+#if CONFIG_ZSL_VECTOR_INLINE
+/* The library version, which the inline one calls for long vectors. */
+int zsl_vec_add_ool(const struct zsl_vec *v, const struct zsl_vec *w,
+		    struct zsl_vec *x);
+
+static inline int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+			      struct zsl_vec *x)
+{
+	if (v->sz > ZSL_VEC_INLINE_MAX) {
+		return zsl_vec_add_ool(v, w, x);
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = v->data[i] + w->data[i];
+	}
+
+	return 0;
+}
+#else
+int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x);
+#endif
 
 /**
  * @brief Subtracts corresponding vector elements in 'v' and 'w', saving to 'x'.
@@ -157,7 +296,26 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x);
  *
  * @return 0 on success, -EINVAL if v and w are not equal length.
  */
-int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x);
+#if CONFIG_ZSL_VECTOR_INLINE
+static inline int zsl_vec_sub(const struct zsl_vec *v, const struct zsl_vec *w,
+			      struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = v->data[i] - w->data[i];
+	}
+
+	return 0;
+}
+#else
+int zsl_vec_sub(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x);
+#endif
 
 /**
  * @brief Negates the elements in vector 'v'.
@@ -171,14 +329,19 @@ int zsl_vec_neg(struct zsl_vec *v);
 /**
  * @brief Component-wise sum of a set of equal-length vectors.
  *
- * @param v  Pointer to the array of vectors.
+ * The sum is formed a few elements at a time across all of the vectors, so
+ * each element of 'w' is written once, and 'w' may be one of the inputs.
+ *
+ * @param v  Pointer to the array of vectors. C doesn't convert a
+ *           'struct zsl_vec **' to this type implicitly, so declare the
+ *           array as 'const struct zsl_vec *v[n]'.
  * @param n  The number of vectors in 'v'.
  * @param w  Pointer to the output vector containing the component-wise sum.
  *
  * @return 0 on success, -EINVAL if vectors in 'v' are no equal length, or
  *         -EINVAL if 'n' = 0.
  */
-int zsl_vec_sum(struct zsl_vec **v, size_t n, struct zsl_vec *w);
+int zsl_vec_sum(const struct zsl_vec *const *v, size_t n, struct zsl_vec *w);
 
 /**
  * @brief Adds a scalar to each element in a vector.
@@ -198,7 +361,25 @@ int zsl_vec_scalar_add(struct zsl_vec *v, zsl_real_t s);
  *
  * @return 0 on success, and non-zero error code on failure
  */
+#if CONFIG_ZSL_VECTOR_INLINE
+/* The library version, which the inline one calls for long vectors. */
+int zsl_vec_scalar_mult_ool(struct zsl_vec *v, zsl_real_t s);
+
+static inline int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s)
+{
+	if (v->sz > ZSL_VEC_INLINE_MAX) {
+		return zsl_vec_scalar_mult_ool(v, s);
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] *= s;
+	}
+
+	return 0;
+}
+#else
 int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s);
+#endif
 
 /**
  * @brief Divide a vector by a scalar.
@@ -220,7 +401,7 @@ int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s);
  * @return The norm of vector v - vector w, or NAN is there was a
  *         size mismatch between vectors v and w.
  */
-zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w);
+zsl_real_t zsl_vec_dist(const struct zsl_vec *v, const struct zsl_vec *w);
 
 /**
  * @brief Computes the dot (aka scalar) product of two equal-length vectors
@@ -228,13 +409,54 @@ zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w);
  *        indicator of the "agreement" between two vectors, or can be used
  *        to determine how far vector w deviates from vector v.
  *
+ * The products are summed pairwise in blocks with four accumulators, so
+ * the rounding error grows with log2(n) rather than n, which keeps long
+ * single-precision vectors accurate.
+ *
  * @param v The first vector.
  * @param w The second vector.
  * @param d The dot product.
  *
  * @return 0 on success, or -EINVAL if vectors v and w aren't equal-length.
  */
-int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d);
+#if CONFIG_ZSL_VECTOR_INLINE
+/* The library version, which the inline one calls for long vectors. */
+int zsl_vec_dot_ool(const struct zsl_vec *v, const struct zsl_vec *w,
+		    zsl_real_t *d);
+
+static inline int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w,
+			      zsl_real_t *d)
+{
+	zsl_real_t s[4] = { 0.0, 0.0, 0.0, 0.0 };
+	size_t i;
+
+	if (v->sz > ZSL_VEC_INLINE_MAX) {
+		return zsl_vec_dot_ool(v, w, d);
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The same four accumulators as the library version. */
+	for (i = 0; i + 4 <= v->sz; i += 4) {
+		for (size_t k = 0; k < 4; k++) {
+			s[k] += v->data[i + k] * w->data[i + k];
+		}
+	}
+	for (; i < v->sz; i++) {
+		s[0] += v->data[i] * w->data[i];
+	}
+	*d = (s[0] + s[1]) + (s[2] + s[3]);
+
+	return 0;
+}
+#else
+int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w,
+		zsl_real_t *d);
+#endif
 
 /**
  * @brief Calculates the norm or absolute value of vector 'v' (the
@@ -244,7 +466,7 @@ int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d);
  *
  * @return The norm of vector 'v'.
  */
-zsl_real_t zsl_vec_norm(struct zsl_vec *v);
+zsl_real_t zsl_vec_norm(const struct zsl_vec *v);
 
 /**
  * @brief   Calculates the projection of vector 'u' over vector 'v', placing
@@ -257,7 +479,8 @@ zsl_real_t zsl_vec_norm(struct zsl_vec *v);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_vec_project(struct zsl_vec *u, struct zsl_vec *v, struct zsl_vec *w);
+int zsl_vec_project(const struct zsl_vec *u, const struct zsl_vec *v,
+		    struct zsl_vec *w);
 
 /**
  * @brief Converts (normalises) vector 'v' to a unit vector (a vector of
@@ -296,7 +519,26 @@ int zsl_vec_to_unit(struct zsl_vec *v);
  * For a discusson of geometric and algebraic applications, see:
  * https://en.wikipedia.org/wiki/Cross_product
  */
-int zsl_vec_cross(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *c);
+#if CONFIG_ZSL_VECTOR_INLINE
+static inline int zsl_vec_cross(const struct zsl_vec *v,
+				const struct zsl_vec *w, struct zsl_vec *c)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != 3) || (w->sz != 3) || (c->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	c->data[0] = v->data[1] * w->data[2] - v->data[2] * w->data[1];
+	c->data[1] = v->data[2] * w->data[0] - v->data[0] * w->data[2];
+	c->data[2] = v->data[0] * w->data[1] - v->data[1] * w->data[0];
+
+	return 0;
+}
+#else
+int zsl_vec_cross(const struct zsl_vec *v, const struct zsl_vec *w,
+		  struct zsl_vec *c);
+#endif
 
 /**
  * @brief Computes the vector's sum of squares.
@@ -305,30 +547,51 @@ int zsl_vec_cross(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *c);
  *
  * @return The sum of the squares of vector 'v'.
  */
-zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v);
+zsl_real_t zsl_vec_sum_of_sqrs(const struct zsl_vec *v);
 
 /**
  * @brief Computes the component-wise mean of a set of identically-sized
  * vectors.
  *
- * @param v  Pointer to the array of vectors.
+ * @param v  Pointer to the array of vectors, declared as for
+ *           @ref zsl_vec_sum.
  * @param n  The number of vectors in 'v'.
  * @param m  Pointer to the output vector whose i'th element is the mean of
  *           the i'th elements of the input vectors.
  *
- * @return 0 on success, and -EINVAL if all vectors aren't identically sized.
+ * @return 0 on success, and -EINVAL if all vectors aren't identically sized,
+ *         or if 'n' = 0.
  */
-int zsl_vec_mean(struct zsl_vec **v, size_t n, struct zsl_vec *m);
+int zsl_vec_mean(const struct zsl_vec *const *v, size_t n,
+		 struct zsl_vec *m);
+
+/**
+ * @brief Adds vector 'v' to the running component-wise mean 'm' of 'n'
+ * vectors, so that 'm' becomes the mean of n + 1 vectors.
+ *
+ * This averages a stream of vectors, such as calibration samples, without
+ * storing them. Start with n = 0, in which case 'm' is set to 'v', and
+ * increment 'n' after each call.
+ *
+ * @param m  The running mean to update.
+ * @param n  The number of vectors already averaged into 'm'.
+ * @param v  The vector to add.
+ *
+ * @return 0 on success, and -EINVAL if 'v' and 'm' aren't identically sized.
+ */
+int zsl_vec_mean_update(struct zsl_vec *m, size_t n, const struct zsl_vec *v);
 
 /**
  * @brief Computes the arithmetic mean of a vector.
  *
+ * The elements are summed pairwise, as in @ref zsl_vec_dot.
+ *
  * @param v  The vector to use.
  * @param m  The arithmetic mean of vector v.
  *
  * @return 0 on success, otherwise an appropriate error code.
  */
-int zsl_vec_ar_mean(struct zsl_vec *v, zsl_real_t *m);
+int zsl_vec_ar_mean(const struct zsl_vec *v, zsl_real_t *m);
 
 /**
  * @brief Reverses the order of the entries in vector 'v'.
@@ -371,7 +634,8 @@ int zsl_vec_zte(struct zsl_vec *v);
  * @return true if the two vectors have the same size and the same values,
  *         otherwise false.
  */
-bool zsl_vec_is_equal(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t eps);
+bool zsl_vec_is_equal(const struct zsl_vec *v, const struct zsl_vec *w,
+		      zsl_real_t eps);
 
 /**
  * @brief Checks if all elements in vector v are >= zero.
@@ -380,7 +644,7 @@ bool zsl_vec_is_equal(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t eps);
  *
  * @return true if all elements in 'v' are zero or positive, otherwise false.
  */
-bool zsl_vec_is_nonneg(struct zsl_vec *v);
+bool zsl_vec_is_nonneg(const struct zsl_vec *v);
 
 /**
  * @brief Checks if vector v contains val, returning the number of occurences.
@@ -392,18 +656,87 @@ bool zsl_vec_is_nonneg(struct zsl_vec *v);
  * @return The number of occurences of val withing range eps, 0 if no
  *         matching occurences were found, or a negative error code.
  */
-int zsl_vec_contains(struct zsl_vec *v, zsl_real_t val, zsl_real_t eps);
+int zsl_vec_contains(const struct zsl_vec *v, zsl_real_t val, zsl_real_t eps);
 
 /**
- * @brief Sorts the values in vector v from smallest to largest using quicksort,
- *        and assigns the sorted output to vector w.
+ * @brief Sorts the values in vector v from smallest to largest, and assigns
+ *        the sorted output to vector w.
+ *
+ * This copies v to w and calls @ref zsl_vec_sort_d on w. v and w may be the
+ * same vector.
  *
  * @param v     The unsorted, input vector.
- * @param w     The sorted, output vector.
+ * @param w     The sorted, output vector, the same size as v.
+ *
+ * @return 0 if everything executed properly, -EINVAL if v and w are not
+ *         the same size.
+ */
+int zsl_vec_sort(const struct zsl_vec *v, struct zsl_vec *w);
+
+/**
+ * @brief Sorts the values in vector v from smallest to largest, in place.
+ *
+ * This is an introsort: quicksort with a median-of-three pivot, finishing
+ * small ranges with an insertion sort, and switching a range to heapsort if
+ * it is still being partitioned after 2 * log2(n) passes. It runs in
+ * O(n log(n)) time in the worst case, including for sorted or constant
+ * input, and isn't recursive: a fixed stack of one small entry per bit of
+ * size_t is used instead, whatever the size of v.
+ *
+ * The sort is not stable, and NaN values give an unspecified order.
+ *
+ * When CONFIG_ZSL_SCRATCH_POOL is enabled and v has at least 1024 values
+ * (single precision) or 2048 values (double precision), a buffer of v->sz
+ * entries is taken from the pool and the radix sort of @ref zsl_vec_sort_ws
+ * is used instead, falling back to the introsort if the pool is too small.
+ * Without the pool, the introsort is always used, since a stack buffer of
+ * v->sz entries could overflow the stack.
+ *
+ * @param v     The vector to sort.
  *
  * @return 0 if everything executed properly, otherwise a negative error code.
  */
-int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w);
+int zsl_vec_sort_d(struct zsl_vec *v);
+
+/**
+ * @brief Returns the number of zsl_real_t workspace entries required by
+ *        @ref zsl_vec_sort_ws for a vector of 'n' values.
+ *
+ * @param n     The size of the vector to sort.
+ *
+ * @return The required workspace size, in zsl_real_t entries.
+ */
+size_t zsl_vec_sort_ws_sz(size_t n);
+
+/**
+ * @brief Sorts the values in vector v from smallest to largest, in place,
+ *        with a buffer allocated from workspace 'ws'.
+ *
+ * Vectors of at least 1024 values (single precision) or 2048 values
+ * (double precision) are sorted with a least significant digit radix sort.
+ * Each value's IEEE-754 bit pattern is mapped to an unsigned integer with
+ * the same order, which is sorted one byte per pass, so the cost is linear
+ * in v->sz. Passes where every value has the same byte are skipped. The
+ * byte counts take 256 size_t entries of stack. Smaller vectors use the
+ * introsort of @ref zsl_vec_sort_d.
+ *
+ * When CONFIG_ZSL_SMP is enabled with a CONFIG_ZSL_SMP_STACK_SIZE of at
+ * least 2048, and v is large enough to radix sort one run per core, v is
+ * split into those runs, which are sorted in parallel on the worker pool
+ * and then merged pairwise, with the merges of each round also running in
+ * parallel.
+ *
+ * Unlike the introsort, -0.0 is placed before +0.0, and NaN values are
+ * placed at the end, or at the start if their sign bit is set.
+ *
+ * @param v     The vector to sort.
+ * @param ws    The workspace to allocate the buffer from, with at least
+ *              zsl_vec_sort_ws_sz(v->sz) free entries.
+ *
+ * @return 0 if everything executed properly, or -ENOMEM if 'ws' is too
+ *         small.
+ */
+int zsl_vec_sort_ws(struct zsl_vec *v, struct zsl_workspace *ws);
 
 /** @} */ /* End of VEC_COMPARE group */
 
@@ -423,7 +756,7 @@ int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w);
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
-int zsl_vec_print(struct zsl_vec *v);
+int zsl_vec_print(const struct zsl_vec *v);
 
 // int      zsl_vec_fprint(FILE *stream, zsl_vec *v);
 
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup WORKSPACE Workspace
+ *
+ * @brief Caller-provided memory arena for temporary matrices and vectors.
+ *
+ * Functions that require large temporary matrices (decompositions, etc.)
+ * can carve their scratch memory out of a single, caller-provided buffer
+ * rather than declaring multiple variable-length arrays on the stack. This
+ * allows the memory requirements of an algorithm to be sized statically,
+ * using the matching `_ws_sz` helper to determine the required size.
+ *
+ * Allocations are made in a strictly LIFO order: take a mark with
+ * @ref zsl_ws_mark before allocating, and return to it with
+ * @ref zsl_ws_release once the temporaries are no longer required.
+ */
+
+/**
+ * @file
+ * @brief API header file for workspaces in zscilib.
+ *
+ * This file contains the zscilib workspace APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_
+#define ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/instrument.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup WS_STRUCTS Structs and Macros
+ *
+ * @brief Common structs and macros for working with workspaces.
+ *
+ * @ingroup WORKSPACE
+ *  @{ */
+
+/** @brief Represents a LIFO arena of zsl_real_t values. */
+struct zsl_workspace {
+	/** The caller-provided backing buffer. */
+	zsl_real_t *data;
+	/** The number of zsl_real_t entries available in 'data'. */
+	size_t sz;
+	/** The number of entries currently allocated. */
+	size_t used;
+	/** The highest value 'used' has reached since initialisation. */
+	size_t peak;
+};
+
+/**
+ * Macro to declare a workspace with 'n' zsl_real_t entries of backing memory.
+ *
+ * This can be used at file scope to statically allocate a workspace, or
+ * inside a function to place the workspace on the stack.
+ */
+#define ZSL_WORKSPACE_DEF(name, n)	     \
+	zsl_real_t name ## _ws[n];	     \
+	struct zsl_workspace name = {	     \
+		.data = name ## _ws,	     \
+		.sz = n,		     \
+		.used = 0,		     \
+		.peak = 0		     \
+	}
+
+/**
+ * Macro to obtain a pointer, 'name', to the workspace that library functions
+ * should take their temporaries from, where 'n' is the number of zsl_real_t
+ * entries required.
+ *
+ * When CONFIG_ZSL_SCRATCH_POOL is enabled this locks and returns the shared
+ * scratch pool, and 'n' is ignored. Otherwise, a workspace of 'n' entries is
+ * declared on the stack. Every use must be paired with ZSL_SCRATCH_PUT.
+ *
+ * This also records the usage of the enclosing function when
+ * CONFIG_ZSL_INSTRUMENT is enabled, see ZSL_INSTR_ENTER.
+ */
+#if CONFIG_ZSL_INSTRUMENT
+#define ZSL_SCRATCH_INSTR(name) ; ZSL_INSTR_ENTER(name ## _instr)
+#else
+#define ZSL_SCRATCH_INSTR(name)
+#endif
+
+#if CONFIG_ZSL_SCRATCH_POOL
+#define ZSL_SCRATCH_DEF(name, n)					\
+	struct zsl_workspace *name = ((void)(n), zsl_scratch_get())	\
+	ZSL_SCRATCH_INSTR(name)
+#define ZSL_SCRATCH_PUT(name) zsl_scratch_put(name)
+#else
+/* At least one entry, since an empty input would declare a zero-length VLA. */
+#define ZSL_SCRATCH_DEF(name, n)					\
+	ZSL_WORKSPACE_DEF(name ## _stk, (n) > 0 ? (n) : 1);		\
+	struct zsl_workspace *name = &name ## _stk			\
+	ZSL_SCRATCH_INSTR(name)
+#define ZSL_SCRATCH_PUT(name) ((void)(name))
+#endif
+
+/** @} */ /* End of WS_STRUCTS group */
+
+/**
+ * @addtogroup WS_FUNCS Functions
+ *
+ * @brief Functions used to allocate memory from a workspace.
+ *
+ * @ingroup WORKSPACE
+ *  @{ */
+
+/**
+ * @brief Initialises workspace 'ws' using the supplied backing buffer.
+ *
+ * @param ws    Pointer to the workspace to initialise.
+ * @param buf   Pointer to the backing buffer.
+ * @param sz    The number of zsl_real_t entries available in 'buf'.
+ *
+ * @return 0 on success, or -EINVAL if 'buf' is NULL and 'sz' is non-zero.
+ */
+int zsl_ws_init(struct zsl_workspace *ws, zsl_real_t *buf, size_t sz);
+
+/**
+ * @brief Returns the current allocation offset of 'ws', which can later be
+ *        passed to @ref zsl_ws_release to free everything allocated since.
+ *
+ * @param ws    Pointer to the workspace to use.
+ *
+ * @return The current allocation offset, in zsl_real_t entries.
+ */
+size_t zsl_ws_mark(struct zsl_workspace *ws);
+
+/**
+ * @brief Releases every allocation made since 'mark' was taken.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param mark  A value previously returned by @ref zsl_ws_mark.
+ *
+ * @return 0 on success, or -EINVAL if 'mark' is beyond the current offset.
+ */
+int zsl_ws_release(struct zsl_workspace *ws, size_t mark);
+
+/**
+ * @brief Returns the number of unallocated zsl_real_t entries in 'ws'.
+ *
+ * @param ws    Pointer to the workspace to use.
+ *
+ * @return The number of entries still available.
+ */
+size_t zsl_ws_avail(struct zsl_workspace *ws);
+
+/**
+ * @brief Allocates 'n' zsl_real_t entries from 'ws'.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param n     The number of entries to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if 'ws' doesn't have
+ *         enough free entries. The contents of the memory are undefined.
+ */
+zsl_real_t *zsl_ws_alloc(struct zsl_workspace *ws, size_t n);
+
+/**
+ * @brief Allocates a rows x cols matrix from 'ws', assigning it to 'm'.
+ *
+ * Be sure to call 'zsl_mtx_init' on the matrix if the initial contents
+ * matter, since the memory may contain values from earlier allocations.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param m     Pointer to the matrix to assign the memory to.
+ * @param rows  The number of rows in the matrix.
+ * @param cols  The number of columns in the matrix.
+ *
+ * @return 0 on success, or -ENOMEM if 'ws' doesn't have enough free entries.
+ */
+int zsl_ws_mtx_alloc(struct zsl_workspace *ws, struct zsl_mtx *m,
+		     size_t rows, size_t cols);
+
+/**
+ * @brief Allocates a vector with 'sz' elements from 'ws', assigning it to 'v'.
+ *
+ * Be sure to call 'zsl_vec_init' on the vector if the initial contents
+ * matter, since the memory may contain values from earlier allocations.
+ *
+ * @param ws    Pointer to the workspace to use.
+ * @param v     Pointer to the vector to assign the memory to.
+ * @param sz    The number of elements in the vector.
+ *
+ * @return 0 on success, or -ENOMEM if 'ws' doesn't have enough free entries.
+ */
+int zsl_ws_vec_alloc(struct zsl_workspace *ws, struct zsl_vec *v, size_t sz);
+
+#if CONFIG_ZSL_SCRATCH_POOL
+/**
+ * @brief Locks and returns the library-wide scratch pool.
+ *
+ * The pool is protected by a mutex that can be taken recursively by the
+ * same thread, so nested library calls may each lock the pool and allocate
+ * from it in turn. Every call must be paired with @ref zsl_scratch_put.
+ *
+ * @return A pointer to the scratch pool.
+ */
+struct zsl_workspace *zsl_scratch_get(void);
+
+/**
+ * @brief Unlocks the scratch pool returned by @ref zsl_scratch_get.
+ *
+ * @param ws    Pointer to the scratch pool.
+ */
+void zsl_scratch_put(struct zsl_workspace *ws);
+
+/**
+ * @brief Returns the highest number of scratch pool entries in use at any
+ *        one time since startup, or since the last call to
+ *        @ref zsl_scratch_reset_peak.
+ *
+ * This can be used to size CONFIG_ZSL_SCRATCH_POOL_SIZE from a real
+ * workload.
+ *
+ * @return The scratch pool high-water mark, in zsl_real_t entries.
+ */
+size_t zsl_scratch_peak(void);
+
+/**
+ * @brief Resets the scratch pool high-water mark to the current usage.
+ */
+void zsl_scratch_reset_peak(void);
+#endif
+
+/** @} */ /* End of WS_FUNCS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_WORKSPACE_H_ */
+
+/** @} */ /* End of workspace group */
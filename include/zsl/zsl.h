@@ -52,7 +52,7 @@ typedef double zsl_real_t;
 #endif
 
 /* Map math functions based on single or double precision. */
-/* TODO: Add an option for fast approximations of trig operations. */
+/* See zsl/fastmath.h for fast approximations of the trig functions. */
 #if CONFIG_ZSL_SINGLE_PRECISION
 #define ZSL_CEIL       ceilf
 #define ZSL_FLOOR      floorf
@@ -71,6 +71,7 @@ typedef double zsl_real_t;
 #define ZSL_ASIN       asinf
 #define ZSL_ACOS       acosf
 #define ZSL_ATAN       atanf
+#define ZSL_ATAN2      atan2f
 #define ZSL_SINH       sinhf
 #define ZSL_COSH       coshf
 #define ZSL_TANH       tanhf
@@ -94,6 +95,7 @@ typedef double zsl_real_t;
 #define ZSL_ASIN       asin
 #define ZSL_ACOS       acos
 #define ZSL_ATAN       atan
+#define ZSL_ATAN2      atan2
 #define ZSL_SINH       sinh
 #define ZSL_COSH       cosh
 #define ZSL_TANH       tanh
@@ -101,6 +103,78 @@ typedef double zsl_real_t;
 #define ZSL_FMA        fma
 #endif
 
+/**
+ * The alignment in bytes of data declared with ZSL_VECTOR_DEF_ALIGNED or
+ * ZSL_MATRIX_DEF_ALIGNED. This should be a power of two no smaller than the
+ * widest SIMD load, ideally the data cache line size (32 on Cortex-M7).
+ */
+#ifdef CONFIG_ZSL_DATA_ALIGN
+#define ZSL_DATA_ALIGN          CONFIG_ZSL_DATA_ALIGN
+#else
+#define ZSL_DATA_ALIGN          32
+#endif
+
+/** The number of zsl_real_t entries in one ZSL_DATA_ALIGN byte block. */
+#define ZSL_DATA_ALIGN_N        (ZSL_DATA_ALIGN / sizeof(zsl_real_t))
+
+/** Rounds 'n' entries up to a whole number of ZSL_DATA_ALIGN byte blocks. */
+#define ZSL_ALIGN_PAD(n)						\
+	((((n) + ZSL_DATA_ALIGN_N - 1) / ZSL_DATA_ALIGN_N) * ZSL_DATA_ALIGN_N)
+
+/** Returns true if pointer 'p' is a multiple of 'a' bytes, a power of two. */
+#define ZSL_IS_ALIGNED(p, a)    ((((uintptr_t)(p)) & ((a) - 1)) == 0)
+
+/**
+ * @brief Approximates 1 / sqrt(x) for x > 0.0 with a bit-level initial
+ *        estimate and two Newton-Raphson steps, avoiding a square root and
+ *        a divide.
+ *
+ * The relative error is below 5E-6, which is suitable for renormalising
+ * vectors and quaternions that are already close to unit length.
+ */
+static inline zsl_real_t zsl_fast_inv_sqrt(zsl_real_t x)
+{
+#if CONFIG_ZSL_SINGLE_PRECISION
+	union { float f; uint32_t u; } c = { .f = x };
+
+	c.u = 0x5f375a86u - (c.u >> 1);
+#else
+	union { double f; uint64_t u; } c = { .f = x };
+
+	c.u = 0x5fe6eb50c7b537a9ull - (c.u >> 1);
+#endif
+	c.f *= 1.5 - 0.5 * x * c.f * c.f;
+	c.f *= 1.5 - 0.5 * x * c.f * c.f;
+
+	return c.f;
+}
+
+/**
+ * Checks internal invariant 'cond', such as the index of an element read
+ * inside a loop whose bounds were validated on entry, if CONFIG_ZSL_ASSERTS
+ * is enabled. This is a debug aid, separate from CONFIG_ZSL_BOUNDS_CHECKS,
+ * and compiles to nothing otherwise.
+ */
+#if CONFIG_ZSL_ASSERTS
+#ifdef __ZEPHYR__
+#include <sys/__assert.h>
+#define ZSL_ASSERT(cond)        __ASSERT(cond, "zscilib: %s", #cond)
+#else
+/* Not assert(), which NDEBUG removes from host release builds. */
+#include <stdio.h>
+#include <stdlib.h>
+#define ZSL_ASSERT(cond)						\
+	do {								\
+		if (!(cond)) {						\
+			fprintf(stderr, "zscilib: %s:%d: %s\n",	\
+				__FILE__, __LINE__, #cond);		\
+			abort();					\
+		}							\
+	} while (0)
+#endif
+#else
+#define ZSL_ASSERT(cond)        ((void)0)
+#endif
 
 /* TODO: Define common errors like shape mismatch, etc. */
 
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Linaro
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Compares two runs of the zscilib benchmark sample.
+
+Each run is a console log captured with CONFIG_BENCH_OUTPUT_CSV or
+CONFIG_BENCH_OUTPUT_JSON. Lines that are not records, such as the boot
+banner, are ignored. Records are matched by function and size, and the
+script exits with 1 if any of them got slower, or used more stack, by more
+than the threshold.
+
+    $ bench_compare.py old.log new.log --threshold 5
+"""
+
+import argparse
+import csv
+import json
+import sys
+
+FIELDS = ("board", "config", "function", "size", "unit", "per_op", "stack")
+
+
+def load(path):
+    """Returns the records in a log, keyed by (function, size)."""
+    recs = {}
+    header = False
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("{"):
+                try:
+                    rec = json.loads(line)
+                except ValueError:
+                    continue
+            elif line == ",".join(FIELDS):
+                header = True
+                continue
+            elif header:
+                row = next(csv.reader([line]))
+                if len(row) != len(FIELDS):
+                    continue
+                rec = dict(zip(FIELDS, row))
+            else:
+                continue
+            try:
+                rec["size"] = int(rec["size"])
+                rec["per_op"] = int(rec["per_op"])
+                rec["stack"] = int(rec["stack"])
+            except (KeyError, ValueError):
+                continue
+            recs[(rec["function"], rec["size"])] = rec
+    return recs
+
+
+def change(old, new):
+    """The change from 'old' to 'new' in percent."""
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    return 100.0 * (new - old) / old
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Flag regressions between two zscilib benchmark runs.")
+    parser.add_argument("old", help="the baseline log")
+    parser.add_argument("new", help="the log to compare with it")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="the largest allowed increase, in percent "
+                             "(default: %(default)s)")
+    parser.add_argument("--stack-threshold", type=float, default=None,
+                        help="the largest allowed increase in stack use, "
+                             "in percent (default: same as --threshold)")
+    args = parser.parse_args()
+    stack_threshold = args.stack_threshold
+    if stack_threshold is None:
+        stack_threshold = args.threshold
+
+    old = load(args.old)
+    new = load(args.new)
+    if not old or not new:
+        sys.exit("no benchmark records found in "
+                 + (args.old if not old else args.new))
+
+    for run in (old, new):
+        units = {r["unit"] for r in run.values()}
+        if len(units) > 1:
+            sys.exit("mixed units in one run: " + ", ".join(sorted(units)))
+    if next(iter(old.values()))["unit"] != next(iter(new.values()))["unit"]:
+        sys.exit("the runs are in different units, and can't be compared")
+
+    failed = False
+    print("%-26s %5s %12s %12s %8s %8s" %
+          ("Function", "Size", "Old", "New", "Time %", "Stack %"))
+    for key in sorted(old.keys() | new.keys()):
+        if key not in new:
+            print("%-26s %5d  missing from the new run" % key)
+            continue
+        if key not in old:
+            print("%-26s %5d  new" % key)
+            continue
+        o, n = old[key], new[key]
+        dt = change(o["per_op"], n["per_op"])
+        ds = change(o["stack"], n["stack"])
+        flag = ""
+        if dt > args.threshold:
+            flag += " SLOWER"
+        if ds > stack_threshold:
+            flag += " STACK"
+        failed = failed or bool(flag)
+        print("%-26s %5d %12d %12d %+7.1f%% %+7.1f%%%s" %
+              (key[0], key[1], o["per_op"], n["per_op"], dt, ds, flag))
+
+    if failed:
+        print("\nRegressions over the threshold found.")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
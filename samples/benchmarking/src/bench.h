@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_H__
+#define BENCH_H__
+
+#include <zephyr.h>
+#include <zsl/zsl.h>
+
+#if !CONFIG_BOARD_QEMU_CORTEX_M3 && \
+	(CONFIG_CPU_CORTEX_M3 || CONFIG_CPU_CORTEX_M4 || CONFIG_CPU_CORTEX_M7)
+/* Use the DWT cycle counter for precision timing on HW M3/M4/M7 cores. */
+#define BENCH_DWT               1
+#define BENCH_UNIT              "cycles"
+#else
+/* Use the high-precision kernel clock. */
+#define BENCH_DWT               0
+#define BENCH_UNIT              "ns"
+#endif
+
+/* Short tags for the build settings, to tell runs apart in CSV and JSON. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define BENCH_CFG_PREC          "single"
+#else
+#define BENCH_CFG_PREC          "double"
+#endif
+#if CONFIG_ZSL_VECTOR_INLINE
+#define BENCH_CFG_VINLINE       "-vinline"
+#else
+#define BENCH_CFG_VINLINE       ""
+#endif
+#if CONFIG_ZSL_MATRIX_INLINE
+#define BENCH_CFG_MINLINE       "-minline"
+#else
+#define BENCH_CFG_MINLINE       ""
+#endif
+#if CONFIG_ZSL_BOUNDS_CHECKS
+#define BENCH_CFG_BOUNDS        "-bounds"
+#else
+#define BENCH_CFG_BOUNDS        ""
+#endif
+#define BENCH_CFG \
+	BENCH_CFG_PREC BENCH_CFG_VINLINE BENCH_CFG_MINLINE BENCH_CFG_BOUNDS
+
+/** The largest matrix or array size any case uses. */
+#define BENCH_MAX_N             (256)
+
+/** A benchmarked function, run at one or more input sizes. */
+struct bench_case {
+	/** The name of the function. */
+	const char *name;
+	/** The input sizes to run it at, ending with 0. */
+	size_t sizes[4];
+	/** The number of calls to time at each size. */
+	uint32_t loops;
+	/**
+	 * Sets up inputs of size 'n', then makes 'loops' calls between
+	 * bench_start and bench_stop.
+	 */
+	void (*run)(size_t n, uint32_t loops);
+};
+
+extern const struct bench_case bench_cases[];
+extern const size_t bench_cases_count;
+
+/** Starts timing. */
+void bench_start(void);
+
+/** Stops timing. */
+void bench_stop(void);
+
+/** The time between the last bench_start and bench_stop, in BENCH_UNIT. */
+uint32_t bench_elapsed(void);
+
+#if CONFIG_BENCH_ENERGY
+/**
+ * Feeds the Madgwick filter at CONFIG_BENCH_ENERGY_RATE in batches of
+ * several sizes, sleeping between batches, and prints how long the CPU was
+ * busy per wake-up and asleep between them at each size.
+ */
+void bench_energy_duty(void);
+#endif
+
+#endif /* BENCH_H__ */
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/statistics.h>
+#include <zsl/interp.h>
+#include <zsl/colorimetry.h>
+#include <zsl/orientation/quaternions.h>
+#include "bench.h"
+
+/*
+ * Inputs and outputs live here rather than on the stack, so the stack
+ * usage reported for each case is that of the function under test.
+ */
+static zsl_real_t bench_a[16 * 16];
+static zsl_real_t bench_b[16 * 16];
+static zsl_real_t bench_c[16 * 16];
+static zsl_real_t bench_d[16 * 16];
+static zsl_real_t bench_v[BENCH_MAX_N];
+static struct zsl_interp_xy bench_xy[BENCH_MAX_N];
+static struct zsl_clr_xyz bench_xyz[BENCH_MAX_N];
+static struct zsl_clr_rgbf bench_rgbf[BENCH_MAX_N];
+static volatile zsl_real_t bench_sink;
+
+/* A well-conditioned, diagonally dominant n x n matrix. */
+static void bench_fill_mtx(struct zsl_mtx *m, zsl_real_t *d, size_t n)
+{
+	m->sz_rows = n;
+	m->sz_cols = n;
+	m->data = d;
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			d[i * n + j] = i == j ? (zsl_real_t)n + 1.0 :
+				       1.0 / (zsl_real_t)(1 + i + j);
+		}
+	}
+}
+
+static void bench_view(struct zsl_mtx *m, zsl_real_t *d, size_t n)
+{
+	m->sz_rows = n;
+	m->sz_cols = n;
+	m->data = d;
+}
+
+static void bench_fill_vec(struct zsl_vec *v, size_t n)
+{
+	v->sz = n;
+	v->data = bench_v;
+	for (size_t i = 0; i < n; i++) {
+		/* Not sorted, so median and quartiles do real work. */
+		bench_v[i] = (zsl_real_t)((i * 37) % n) + 0.5;
+	}
+}
+
+static void bench_vec_add(size_t n, uint32_t loops)
+{
+	struct zsl_vec va = { .sz = n, .data = bench_a };
+	struct zsl_vec vb = { .sz = n, .data = bench_b };
+	struct zsl_vec vc = { .sz = n, .data = bench_c };
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_vec_add(&va, &vb, &vc);
+	}
+	bench_stop();
+}
+
+static void bench_mtx_mult(size_t n, uint32_t loops)
+{
+	struct zsl_mtx ma, mb, mc;
+
+	bench_fill_mtx(&ma, bench_a, n);
+	bench_fill_mtx(&mb, bench_b, n);
+	bench_view(&mc, bench_c, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_mtx_mult(&ma, &mb, &mc);
+	}
+	bench_stop();
+}
+
+static void bench_mtx_inv(size_t n, uint32_t loops)
+{
+	struct zsl_mtx m, mi;
+
+	bench_fill_mtx(&m, bench_a, n);
+	bench_view(&mi, bench_c, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_mtx_inv(&m, &mi);
+	}
+	bench_stop();
+}
+
+static void bench_mtx_qrd(size_t n, uint32_t loops)
+{
+	struct zsl_mtx m, q, r;
+
+	bench_fill_mtx(&m, bench_a, n);
+	bench_view(&q, bench_b, n);
+	bench_view(&r, bench_c, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_mtx_qrd(&m, &q, &r, false);
+	}
+	bench_stop();
+}
+
+static void bench_mtx_svd(size_t n, uint32_t loops)
+{
+	struct zsl_mtx m, u, e, v;
+
+	bench_fill_mtx(&m, bench_a, n);
+	bench_view(&u, bench_b, n);
+	bench_view(&e, bench_c, n);
+	bench_view(&v, bench_d, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_mtx_svd(&m, &u, &e, &v, 150);
+	}
+	bench_stop();
+}
+
+static void bench_sta_mean(size_t n, uint32_t loops)
+{
+	struct zsl_vec v;
+	zsl_real_t m;
+
+	bench_fill_vec(&v, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_sta_mean(&v, &m);
+	}
+	bench_stop();
+	bench_sink = m;
+}
+
+static void bench_sta_var(size_t n, uint32_t loops)
+{
+	struct zsl_vec v;
+	zsl_real_t var;
+
+	bench_fill_vec(&v, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_sta_var(&v, &var);
+	}
+	bench_stop();
+	bench_sink = var;
+}
+
+static void bench_sta_median(size_t n, uint32_t loops)
+{
+	struct zsl_vec v;
+	zsl_real_t m;
+
+	bench_fill_vec(&v, n);
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_sta_median(&v, &m);
+	}
+	bench_stop();
+	bench_sink = m;
+}
+
+static void bench_quat_mult(size_t n, uint32_t loops)
+{
+	struct zsl_quat qa = { .r = 0.7071, .i = 0.7071, .j = 0.0, .k = 0.0 };
+	struct zsl_quat qb = { .r = 0.5, .i = 0.5, .j = 0.5, .k = 0.5 };
+	struct zsl_quat qm;
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_quat_mult(&qa, &qb, &qm);
+	}
+	bench_stop();
+	bench_sink = qm.r;
+}
+
+static void bench_quat_slerp(size_t n, uint32_t loops)
+{
+	struct zsl_quat qa = { .r = 0.7071, .i = 0.7071, .j = 0.0, .k = 0.0 };
+	struct zsl_quat qb = { .r = 0.5, .i = 0.5, .j = 0.5, .k = 0.5 };
+	struct zsl_quat qi;
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_quat_slerp(&qa, &qb, 0.3, &qi);
+	}
+	bench_stop();
+	bench_sink = qi.r;
+}
+
+static void bench_quat_rot_vec(size_t n, uint32_t loops)
+{
+	struct zsl_quat q = { .r = 0.5, .i = 0.5, .j = 0.5, .k = 0.5 };
+	struct zsl_vec v = { .sz = 3, .data = bench_a };
+	struct zsl_vec vr = { .sz = 3, .data = bench_b };
+
+	bench_a[0] = 1.0;
+	bench_a[1] = 2.0;
+	bench_a[2] = 3.0;
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_quat_rot_vec(&q, &v, &vr);
+	}
+	bench_stop();
+}
+
+static void bench_interp_lin_y_arr(size_t n, uint32_t loops)
+{
+	zsl_real_t y;
+
+	for (size_t i = 0; i < n; i++) {
+		bench_xy[i].x = (zsl_real_t)i;
+		bench_xy[i].y = (zsl_real_t)(i * i);
+	}
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_interp_lin_y_arr(bench_xy, n, (zsl_real_t)n / 2.0 + 0.3,
+				     &y);
+	}
+	bench_stop();
+	bench_sink = y;
+}
+
+static void bench_clr_conv_ct_xyz(size_t n, uint32_t loops)
+{
+	struct zsl_clr_xyz xyz;
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_clr_conv_ct_xyz(5000.0, ZSL_CLR_OBS_2_DEG, &xyz);
+	}
+	bench_stop();
+	bench_sink = xyz.xyz_y;
+}
+
+static void bench_clr_conv_xyz_rgbf_arr(size_t n, uint32_t loops)
+{
+	const struct zsl_mtx *ccm;
+
+	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &ccm);
+	for (size_t i = 0; i < n; i++) {
+		bench_xyz[i].xyz_x = 0.3 + 0.001 * (zsl_real_t)i;
+		bench_xyz[i].xyz_y = 0.4;
+		bench_xyz[i].xyz_z = 0.3;
+	}
+
+	bench_start();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_clr_conv_xyz_rgbf_arr(bench_xyz, ccm, bench_rgbf, n);
+	}
+	bench_stop();
+}
+
+const struct bench_case bench_cases[] = {
+	{ "zsl_vec_add", { 3, 16 }, 10000, bench_vec_add },
+	{ "zsl_mtx_mult", { 4, 8, 16 }, 100, bench_mtx_mult },
+	{ "zsl_mtx_inv", { 4, 8, 16 }, 100, bench_mtx_inv },
+	{ "zsl_mtx_qrd", { 4, 8, 16 }, 100, bench_mtx_qrd },
+	{ "zsl_mtx_svd", { 4, 8 }, 10, bench_mtx_svd },
+	{ "zsl_sta_mean", { 16, 64, 256 }, 100, bench_sta_mean },
+	{ "zsl_sta_var", { 16, 64, 256 }, 100, bench_sta_var },
+	{ "zsl_sta_median", { 16, 64, 256 }, 100, bench_sta_median },
+	{ "zsl_quat_mult", { 1 }, 1000, bench_quat_mult },
+	{ "zsl_quat_slerp", { 1 }, 1000, bench_quat_slerp },
+	{ "zsl_quat_rot_vec", { 1 }, 1000, bench_quat_rot_vec },
+	{ "zsl_interp_lin_y_arr", { 16, 64, 256 }, 1000,
+	  bench_interp_lin_y_arr },
+	{ "zsl_clr_conv_ct_xyz", { 1 }, 100, bench_clr_conv_ct_xyz },
+	{ "zsl_clr_conv_xyz_rgbf_arr", { 16, 64, 256 }, 100,
+	  bench_clr_conv_xyz_rgbf_arr },
+};
+
+const size_t bench_cases_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <zsl/zsl.h>
+#include <zsl/orientation/fusion/fusion.h>
+#include <zsl/orientation/fusion/madgwick.h>
+#include "bench.h"
+
+/** The largest number of samples fed per wake-up. */
+#define BENCH_BATCH_MAX         (32)
+
+/* The batch sizes to compare, starting with one wake-up per sample. */
+static const size_t bench_batch_sizes[] = { 1, 4, 16, BENCH_BATCH_MAX };
+
+static zsl_real_t bench_accel[BENCH_BATCH_MAX * 3];
+static zsl_real_t bench_mag[BENCH_BATCH_MAX * 3];
+static zsl_real_t bench_gyro[BENCH_BATCH_MAX * 3];
+
+/* A device lying flat and turning slowly about z. */
+static void bench_energy_fill(void)
+{
+	for (size_t i = 0; i < BENCH_BATCH_MAX; i++) {
+		bench_accel[i * 3 + 0] = 0.0;
+		bench_accel[i * 3 + 1] = 0.0;
+		bench_accel[i * 3 + 2] = 9.81;
+		bench_mag[i * 3 + 0] = 0.2;
+		bench_mag[i * 3 + 1] = 0.0;
+		bench_mag[i * 3 + 2] = -0.4;
+		bench_gyro[i * 3 + 0] = 0.0;
+		bench_gyro[i * 3 + 1] = 0.0;
+		bench_gyro[i * 3 + 2] = 0.1;
+	}
+}
+
+static void bench_energy_header(void)
+{
+#if CONFIG_BENCH_OUTPUT_CSV
+	printk("board,config,batch,wakes,unit,active_per_wake,"
+	       "active_per_sample,idle_us_per_wake,idle_pct\n");
+#elif CONFIG_BENCH_OUTPUT_TABLE
+	printk("\nzsl_fus_feed_batch (Madgwick) at %u Hz, %u samples\n\n",
+	       CONFIG_BENCH_ENERGY_RATE, CONFIG_BENCH_ENERGY_SAMPLES);
+	printk("| Batch | Wakes | %9s/wake | %9s/sample | Idle us/wake "
+	       "| Idle %% |\n", BENCH_UNIT, BENCH_UNIT);
+	printk("|-------|-------|----------------|------------------|"
+	       "--------------|--------|\n");
+#endif
+}
+
+static void bench_energy_print(uint32_t n, uint32_t wakes, uint32_t active,
+			       uint32_t idle_us, uint32_t idle_pm)
+{
+#if CONFIG_BENCH_OUTPUT_CSV
+	printk("%s,opt%d-%s,%u,%u,%s,%u,%u,%u,%u.%u\n", CONFIG_BOARD,
+	       CONFIG_ZSL_PLATFORM_OPT, BENCH_CFG, n, wakes,
+	       BENCH_UNIT, active / wakes, active / (wakes * n),
+	       idle_us / wakes, idle_pm / 10, idle_pm % 10);
+#elif CONFIG_BENCH_OUTPUT_JSON
+	printk("{\"board\": \"%s\", \"config\": \"opt%d-%s\", \"batch\": %u, "
+	       "\"wakes\": %u, \"unit\": \"%s\", \"active_per_wake\": %u, "
+	       "\"active_per_sample\": %u, \"idle_us_per_wake\": %u, "
+	       "\"idle_pct\": %u.%u}\n", CONFIG_BOARD,
+	       CONFIG_ZSL_PLATFORM_OPT, BENCH_CFG, n, wakes,
+	       BENCH_UNIT, active / wakes, active / (wakes * n),
+	       idle_us / wakes, idle_pm / 10, idle_pm % 10);
+#else
+	printk("| %5u | %5u | %14u | %16u | %12u | %4u.%u |\n",
+	       n, wakes, active / wakes, active / (wakes * n),
+	       idle_us / wakes, idle_pm / 10, idle_pm % 10);
+#endif
+}
+
+/*
+ * Feeds CONFIG_BENCH_ENERGY_SAMPLES samples in batches of 'n', one batch
+ * per n / rate seconds, as a sensor FIFO with a watermark of 'n' would
+ * deliver them. The active part of each wake-up is timed between
+ * bench_start and bench_stop, which also drive the profiling pin, and the
+ * rest of the period is spent in k_usleep, letting the idle thread put the
+ * CPU in its low-power state. The time asleep is measured, not assumed.
+ */
+static void bench_energy_batch(size_t n)
+{
+	struct zsl_mtx a = { .sz_rows = n, .sz_cols = 3, .data = bench_accel };
+	struct zsl_mtx m = { .sz_rows = n, .sz_cols = 3, .data = bench_mag };
+	struct zsl_mtx g = { .sz_rows = n, .sz_cols = 3, .data = bench_gyro };
+	struct zsl_fus_batch b = {
+		.n = n, .accel = &a, .mag = &m, .gyro = &g,
+	};
+	struct zsl_quat q;
+	uint32_t wakes = CONFIG_BENCH_ENERGY_SAMPLES / n;
+	uint32_t period_us = (uint32_t)(n * USEC_PER_SEC /
+					CONFIG_BENCH_ENERGY_RATE);
+	uint32_t active = 0;
+	uint32_t busy_us;
+	uint64_t idle_us = 0;
+	uint32_t c0, c1, start;
+	uint64_t wall_us;
+
+	zsl_fus_madg_drv.init_handler(CONFIG_BENCH_ENERGY_RATE);
+
+	start = k_cycle_get_32();
+	for (uint32_t w = 0; w < wakes; w++) {
+		c0 = k_cycle_get_32();
+		bench_start();
+		zsl_fus_feed_batch(&zsl_fus_madg_drv, &b);
+		zsl_fus_madg_drv.get_quat_handler(&q);
+		bench_stop();
+		c1 = k_cycle_get_32();
+		active += bench_elapsed();
+
+		busy_us = k_cyc_to_us_ceil32(c1 - c0);
+		if (busy_us < period_us) {
+			k_usleep(period_us - busy_us);
+		}
+		idle_us += k_cyc_to_us_floor64(k_cycle_get_32() - c1);
+	}
+	wall_us = k_cyc_to_us_floor64(k_cycle_get_32() - start);
+
+	bench_energy_print((uint32_t)n, wakes, active, (uint32_t)idle_us,
+			   wall_us ? (uint32_t)(idle_us * 1000 / wall_us) : 0);
+}
+
+void bench_energy_duty(void)
+{
+	bench_energy_fill();
+	bench_energy_header();
+
+	for (size_t i = 0; i < ARRAY_SIZE(bench_batch_sizes); i++) {
+		k_msleep(CONFIG_BENCH_ENERGY_GAP_MS);
+		bench_energy_batch(bench_batch_sizes[i]);
+	}
+}
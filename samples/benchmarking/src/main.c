@@ -7,27 +7,68 @@
 
 #include <zephyr.h>
 #include <sys/printk.h>
+#if CONFIG_BENCH_ENERGY
+#include <drivers/gpio.h>
+#endif
 #include <zsl/zsl.h>
-#include <zsl/vectors.h>
+#include "bench.h"
+
+/** The stack of the thread each case runs in, whose peak use is reported. */
+#define BENCH_STACK_SIZE (12288)
 
-#if !CONFIG_BOARD_QEMU_CORTEX_M3 && \
-	(CONFIG_CPU_CORTEX_M3 || CONFIG_CPU_CORTEX_M4)
-/* Use DWT cycle counter for precision timing if this is a HW M3/M4 core. */
-uint32_t dwt_count;
+K_THREAD_STACK_DEFINE(bench_stack, BENCH_STACK_SIZE);
+static struct k_thread bench_thread;
+
+#if BENCH_DWT
+static uint32_t dwt_count;
 #define DWT_RESET_CYCLECOUNTER    do {				  \
 		CoreDebug->DEMCR = CoreDebug->DEMCR | 0x01000000; \
 		DWT->CYCCNT = 0;				  \
 		DWT->CTRL = DWT->CTRL | 1; } while(0)
 #else
-/* Use the high-precision kernel clock. */
-uint32_t start_time;
-uint32_t stop_time;
-uint32_t cycles_spent;
-uint32_t nanoseconds_spent;
+static uint32_t start_time;
+static uint32_t stop_time;
 #endif
 
-/** The number of times to execute the code under test. */
-#define BENCH_LOOPS (10000U)
+#if CONFIG_BENCH_ENERGY
+/* High for the timed part of each case, for an external power analyzer. */
+static const struct gpio_dt_spec bench_pin =
+	GPIO_DT_SPEC_GET(DT_ALIAS(led0), gpios);
+#endif
+
+void bench_start(void)
+{
+#if CONFIG_BENCH_ENERGY
+	gpio_pin_set_dt(&bench_pin, 1);
+#endif
+#if BENCH_DWT
+	DWT_RESET_CYCLECOUNTER;
+#else
+	start_time = k_cycle_get_32();
+#endif
+}
+
+void bench_stop(void)
+{
+#if BENCH_DWT
+	dwt_count = DWT->CYCCNT;
+#else
+	stop_time = k_cycle_get_32();
+#endif
+#if CONFIG_BENCH_ENERGY
+	gpio_pin_set_dt(&bench_pin, 0);
+#endif
+}
+
+uint32_t bench_elapsed(void)
+{
+#if BENCH_DWT
+	return dwt_count;
+#else
+	/* Assumes no counter rollover. */
+	return (uint32_t)k_cyc_to_ns_floor64(stop_time - start_time);
+#endif
+}
 
 void print_settings(void)
 {
@@ -59,59 +100,105 @@ void print_settings(void)
 	printk("\n");
 }
 
-void test_vec_add(void)
+static void bench_entry(void *p1, void *p2, void *p3)
 {
-	ZSL_VECTOR_DEF(va, 3);
-	ZSL_VECTOR_DEF(vb, 3);
-	ZSL_VECTOR_DEF(vc, 3);
-
-	zsl_real_t a[3] = { 0.0, 1.0, 2.0 };
-	zsl_real_t b[3] = { -1.0, 0.5, 0.1 };
+	const struct bench_case *c = p1;
 
-	/* Assign arrays to vectors. */
-	zsl_vec_from_arr(&va, a);
-	zsl_vec_from_arr(&vb, b);
+	c->run((size_t)p2, (uint32_t)(uintptr_t)p3);
+}
 
-	/* Init vc with zero values. */
-	zsl_vec_init(&vc);
+static void bench_print_header(void)
+{
+#if CONFIG_BENCH_OUTPUT_CSV
+	printk("board,config,function,size,unit,per_op,stack\n");
+#elif CONFIG_BENCH_OUTPUT_TABLE
+	printk("| %-26s | %4s | %9s/op | %9s |\n", "Function", "Size",
+	       BENCH_UNIT, "Stack (B)");
+	printk("|----------------------------|------|--------------|"
+	       "-----------|\n");
+#endif
+}
 
-#if !CONFIG_BOARD_QEMU_CORTEX_M3 && \
-	(CONFIG_CPU_CORTEX_M3 || CONFIG_CPU_CORTEX_M4)
-	DWT_RESET_CYCLECOUNTER;
+static void bench_print(const struct bench_case *c, size_t n,
+			uint32_t per_op, uint32_t stack)
+{
+#if CONFIG_BENCH_OUTPUT_CSV
+	printk("%s,opt%d-%s,%s,%u,%s,%u,%u\n", CONFIG_BOARD,
+	       CONFIG_ZSL_PLATFORM_OPT, BENCH_CFG, c->name, (unsigned int)n,
+	       BENCH_UNIT, per_op, stack);
+#elif CONFIG_BENCH_OUTPUT_JSON
+	printk("{\"board\": \"%s\", \"config\": \"opt%d-%s\", "
+	       "\"function\": \"%s\", \"size\": %u, \"unit\": \"%s\", "
+	       "\"per_op\": %u, \"stack\": %u}\n", CONFIG_BOARD,
+	       CONFIG_ZSL_PLATFORM_OPT, BENCH_CFG, c->name, (unsigned int)n,
+	       BENCH_UNIT, per_op, stack);
 #else
-	/* Perform the add operation, tracking start and end times. */
-	start_time = k_cycle_get_32();
+	printk("| %-26s | %4u | %12u | %9u |\n", c->name, (unsigned int)n,
+	       per_op, stack);
 #endif
+}
 
-	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
-		zsl_vec_add(&va, &vb, &vc);
-	}
+/*
+ * Runs one case at one size in a fresh thread, so the peak stack use can
+ * be read back once it exits. CONFIG_INIT_STACKS fills the stack with a
+ * known pattern each time the thread is created.
+ */
+static void bench_run(const struct bench_case *c, size_t n)
+{
+	size_t unused = 0;
+#if CONFIG_BENCH_ENERGY
+	uint32_t loops = CONFIG_BENCH_ENERGY_ITERS;
 
-#if !CONFIG_BOARD_QEMU_CORTEX_M3 && \
-	(CONFIG_CPU_CORTEX_M3 || CONFIG_CPU_CORTEX_M4)
-	dwt_count = DWT->CYCCNT;
+	/* Let the console drain, so the pulse stands out from idle. */
+	k_msleep(CONFIG_BENCH_ENERGY_GAP_MS);
 #else
-	stop_time = k_cycle_get_32();
-	/* compute how long the work took (assumes no counter rollover) */
-	cycles_spent = stop_time - start_time;
-	nanoseconds_spent = (uint32_t)k_cyc_to_ns_floor64(cycles_spent);
+	uint32_t loops = c->loops;
 #endif
 
-#if !CONFIG_BOARD_QEMU_CORTEX_M3 && \
-	(CONFIG_CPU_CORTEX_M3 || CONFIG_CPU_CORTEX_M4)
-	printk("zsl_vec_add : %u cycles\n", dwt_count / BENCH_LOOPS);
-#else
-	printk("zsl_vec_add : %u ns\n", nanoseconds_spent / BENCH_LOOPS);
-#endif
+	k_thread_create(&bench_thread, bench_stack,
+			K_THREAD_STACK_SIZEOF(bench_stack), bench_entry,
+			(void *)c, (void *)n, (void *)(uintptr_t)loops,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	k_thread_join(&bench_thread, K_FOREVER);
+	k_thread_stack_space_get(&bench_thread, &unused);
+
+	bench_print(c, n, bench_elapsed() / loops,
+		    (uint32_t)(K_THREAD_STACK_SIZEOF(bench_stack) - unused));
 }
 
 void main(void)
 {
+#if CONFIG_BENCH_OUTPUT_TABLE
 	printk("zscilib benchmark\n\n");
 	print_settings();
+#endif
 
-	while (1) {
-		test_vec_add();
-		k_sleep(K_FOREVER);
+#if CONFIG_BENCH_ENERGY
+	if (!device_is_ready(bench_pin.port) ||
+	    gpio_pin_configure_dt(&bench_pin, GPIO_OUTPUT_INACTIVE)) {
+		printk("Energy profiling pin not ready\n");
+		return;
 	}
+#if CONFIG_BENCH_OUTPUT_TABLE
+	printk("Energy profiling: %u calls per pulse on led0\n\n",
+	       CONFIG_BENCH_ENERGY_ITERS);
+#endif
+#endif
+
+	bench_print_header();
+
+	for (size_t i = 0; i < bench_cases_count; i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(bench_cases[i].sizes) &&
+		     bench_cases[i].sizes[j]; j++) {
+			bench_run(&bench_cases[i], bench_cases[i].sizes[j]);
+		}
+	}
+
+#if CONFIG_BENCH_ENERGY
+	bench_energy_duty();
+#endif
+
+#if CONFIG_BENCH_OUTPUT_TABLE
+	printk("\nDone.\n");
+#endif
 }
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Generates C headers holding precomputed colorimetry lookup tables, so
+ * firmware can keep them in flash rather than computing them at runtime.
+ * Each header is written to stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "zsl/colorimetry.h"
+
+/* The number of significant digits used for real values. */
+static int digits = 9;
+
+static void
+usage(void)
+{
+	printf("Usage: zscilib [-d digits] <table> [args]\n\n"
+	       "Tables:\n"
+	       "  srgb_enc <entries>               8-bit sRGB encoding table\n"
+	       "  srgb_dec                         8-bit sRGB decoding table\n"
+	       "  ct_xyz <points> <2|10>           Color temperature to XYZ\n"
+	       "  cmf <nm> <step> <count> <2|10>   SPD to XYZ weights\n"
+	       "  lef <nm> <step> <count> <p|s>    Luminous efficiency weights\n");
+}
+
+static void
+print_head(const char *guard, const char *desc)
+{
+	printf("/*\n"
+	       " * %s\n"
+	       " *\n"
+	       " * Generated by samples/standalone/clr_lut, do not edit.\n"
+	       " */\n\n", desc);
+	printf("#ifndef %s\n#define %s\n\n", guard, guard);
+	printf("#include <stdint.h>\n#include <zsl/colorimetry.h>\n\n");
+}
+
+static void
+print_tail(const char *guard)
+{
+	printf("\n#endif /* %s */\n", guard);
+}
+
+static void
+print_reals(const zsl_real_t *v, size_t n, size_t cols)
+{
+	for (size_t i = 0; i < n; i++) {
+		printf("%s%.*g%s", (i % cols) ? " " : "\t", digits, v[i],
+		       i == n - 1 ? "\n" : ((i % cols) == cols - 1 ? ",\n" : ","));
+	}
+}
+
+static void
+print_nm(const unsigned int *nm, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		printf("%s%u%s", (i % 12) ? " " : "\t", nm[i],
+		       i == n - 1 ? "\n" : ((i % 12) == 11 ? ",\n" : ","));
+	}
+}
+
+static int
+parse_obs(const char *s, enum zsl_clr_obs *obs)
+{
+	if (strcmp(s, "2") == 0) {
+		*obs = ZSL_CLR_OBS_2_DEG;
+	} else if (strcmp(s, "10") == 0) {
+		*obs = ZSL_CLR_OBS_10_DEG;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int
+parse_grid(char **argv, unsigned int **nm, size_t *n)
+{
+	unsigned int first = (unsigned int)strtoul(argv[0], NULL, 10);
+	unsigned int step = (unsigned int)strtoul(argv[1], NULL, 10);
+
+	*n = strtoul(argv[2], NULL, 10);
+	if (step == 0 || *n == 0) {
+		return -EINVAL;
+	}
+
+	*nm = malloc(*n * sizeof(unsigned int));
+	if (*nm == NULL) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < *n; i++) {
+		(*nm)[i] = first + step * (unsigned int)i;
+	}
+
+	return 0;
+}
+
+static int
+gen_srgb_enc(size_t n)
+{
+	struct zsl_clr_rgbf rgb;
+	struct zsl_clr_rgb8 srgb;
+
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	memset(&rgb, 0, sizeof rgb);
+	print_head("ZSL_CLR_LUT_SRGB_ENC_H_",
+		   "sRGB encoded 8-bit values of linear 0.0..1.0 inputs.");
+	printf("#define ZSL_CLR_LUT_SRGB_ENC_SZ %zu\n\n", n);
+	printf("static const uint8_t zsl_clr_lut_srgb_enc[%zu] = {\n", n);
+	for (size_t i = 0; i < n; i++) {
+		rgb.r = (zsl_real_t)i / (zsl_real_t)(n - 1);
+		zsl_clr_conv_rgbf_srgb8(&rgb, &srgb, 1, false);
+		printf("%s%3u%s", (i % 12) ? " " : "\t", srgb.r,
+		       i == n - 1 ? "\n" : ((i % 12) == 11 ? ",\n" : ","));
+	}
+	printf("};\n");
+	print_tail("ZSL_CLR_LUT_SRGB_ENC_H_");
+
+	return 0;
+}
+
+static int
+gen_srgb_dec(void)
+{
+	zsl_real_t v[256];
+	struct zsl_clr_rgb8 srgb;
+	struct zsl_clr_rgbf rgb;
+
+	memset(&srgb, 0, sizeof srgb);
+	for (size_t i = 0; i < 256; i++) {
+		srgb.r = (uint8_t)i;
+		zsl_clr_conv_srgb8_rgbf(&srgb, &rgb, 1, false);
+		v[i] = rgb.r;
+	}
+
+	print_head("ZSL_CLR_LUT_SRGB_DEC_H_",
+		   "Linear 0.0..1.0 values of sRGB encoded 8-bit inputs.");
+	printf("static const zsl_real_t zsl_clr_lut_srgb_dec[256] = {\n");
+	print_reals(v, 256, 4);
+	printf("};\n");
+	print_tail("ZSL_CLR_LUT_SRGB_DEC_H_");
+
+	return 0;
+}
+
+static int
+gen_ct_xyz(size_t n, enum zsl_clr_obs obs)
+{
+	int rc;
+	struct zsl_clr_ct_lut lut = {
+		.valid = false,
+		.xz = { .sz_rows = n, .sz_cols = 2 }
+	};
+
+	lut.xz.data = malloc(2 * n * sizeof(zsl_real_t));
+	if (lut.xz.data == NULL) {
+		return -ENOMEM;
+	}
+
+	rc = zsl_clr_ct_lut_compile(&lut, obs);
+	if (rc) {
+		goto out;
+	}
+
+	print_head("ZSL_CLR_LUT_CT_XYZ_H_",
+		   "Color temperature to XYZ table for zsl_clr_conv_ct_xyz_lut.");
+	printf("static const zsl_real_t zsl_clr_lut_ct_xyz_xz[%zu] = {\n",
+	       2 * n);
+	print_reals(lut.xz.data, 2 * n, 2);
+	printf("};\n\n");
+	printf("static const struct zsl_clr_ct_lut zsl_clr_lut_ct_xyz = {\n"
+	       "\t.observer = %s,\n"
+	       "\t.valid = true,\n"
+	       "\t.xz = {\n"
+	       "\t\t.sz_rows = %zu,\n"
+	       "\t\t.sz_cols = 2,\n"
+	       "\t\t.data = (zsl_real_t *)zsl_clr_lut_ct_xyz_xz\n"
+	       "\t}\n"
+	       "};\n",
+	       obs == ZSL_CLR_OBS_2_DEG ? "ZSL_CLR_OBS_2_DEG" :
+	       "ZSL_CLR_OBS_10_DEG", n);
+	print_tail("ZSL_CLR_LUT_CT_XYZ_H_");
+
+out:
+	free(lut.xz.data);
+	return rc;
+}
+
+static int
+gen_cmf(unsigned int *nm, size_t n, enum zsl_clr_obs obs)
+{
+	int rc;
+	struct zsl_clr_spd_xyz_conv c = {
+		.w = { .sz_rows = 3, .sz_cols = n }
+	};
+
+	c.w.data = malloc(3 * n * sizeof(zsl_real_t));
+	if (c.w.data == NULL) {
+		return -ENOMEM;
+	}
+
+	rc = zsl_clr_conv_spd_xyz_compile(&c, nm, NULL, obs);
+	if (rc) {
+		goto out;
+	}
+
+	print_head("ZSL_CLR_LUT_CMF_H_",
+		   "SPD to XYZ weights for zsl_clr_conv_spd_xyz_compiled.");
+	printf("#define ZSL_CLR_LUT_CMF_NM_FIRST %u\n", nm[0]);
+	printf("#define ZSL_CLR_LUT_CMF_COUNT %zu\n\n", n);
+	printf("static const zsl_real_t zsl_clr_lut_cmf_w[%zu] = {\n", 3 * n);
+	print_reals(c.w.data, 3 * n, 4);
+	printf("};\n\n");
+	printf("static const struct zsl_clr_spd_xyz_conv zsl_clr_lut_cmf = {\n"
+	       "\t.observer = %s,\n"
+	       "\t.w = {\n"
+	       "\t\t.sz_rows = 3,\n"
+	       "\t\t.sz_cols = %zu,\n"
+	       "\t\t.data = (zsl_real_t *)zsl_clr_lut_cmf_w\n"
+	       "\t}\n"
+	       "};\n",
+	       obs == ZSL_CLR_OBS_2_DEG ? "ZSL_CLR_OBS_2_DEG" :
+	       "ZSL_CLR_OBS_10_DEG", n);
+	print_tail("ZSL_CLR_LUT_CMF_H_");
+
+out:
+	free(c.w.data);
+	return rc;
+}
+
+static int
+gen_lef(unsigned int *nm, size_t n, enum zsl_clr_lef lef)
+{
+	int rc;
+	struct zsl_clr_lef_weights lw = {
+		.valid = false,
+		.w = { .sz = n }
+	};
+
+	lw.nm = malloc(n * sizeof(unsigned int));
+	lw.w.data = malloc(n * sizeof(zsl_real_t));
+	if (lw.nm == NULL || lw.w.data == NULL) {
+		rc = -ENOMEM;
+		goto out;
+	}
+
+	rc = zsl_clr_lef_weights_compile(&lw, lef, nm);
+	if (rc) {
+		goto out;
+	}
+
+	print_head("ZSL_CLR_LUT_LEF_H_",
+		   "Luminous efficiency weights for zsl_clr_lef_integ.");
+	printf("static const unsigned int zsl_clr_lut_lef_nm[%zu] = {\n", n);
+	print_nm(lw.nm, n);
+	printf("};\n\n");
+	printf("static const zsl_real_t zsl_clr_lut_lef_w[%zu] = {\n", n);
+	print_reals(lw.w.data, n, 4);
+	printf("};\n\n");
+	printf("static const struct zsl_clr_lef_weights zsl_clr_lut_lef = {\n"
+	       "\t.lef = %s,\n"
+	       "\t.valid = true,\n"
+	       "\t.nm = (unsigned int *)zsl_clr_lut_lef_nm,\n"
+	       "\t.w = {\n"
+	       "\t\t.sz = %zu,\n"
+	       "\t\t.data = (zsl_real_t *)zsl_clr_lut_lef_w\n"
+	       "\t}\n"
+	       "};\n",
+	       lef == ZSL_CLR_LEF_CIE88_PHOTOPIC ?
+	       "ZSL_CLR_LEF_CIE88_PHOTOPIC" : "ZSL_CLR_LEF_CIE51_SCOTOPIC", n);
+	print_tail("ZSL_CLR_LUT_LEF_H_");
+
+out:
+	free(lw.nm);
+	free(lw.w.data);
+	return rc;
+}
+
+int
+main(int argc, char **argv)
+{
+	int rc = -EINVAL;
+	size_t n;
+	unsigned int *nm = NULL;
+	enum zsl_clr_obs obs;
+
+	if (argc > 2 && strcmp(argv[1], "-d") == 0) {
+		digits = atoi(argv[2]);
+		argc -= 2;
+		argv += 2;
+	}
+
+	if (argc < 2 || digits < 1) {
+		usage();
+		return 1;
+	}
+
+	if (strcmp(argv[1], "srgb_enc") == 0 && argc == 3) {
+		rc = gen_srgb_enc(strtoul(argv[2], NULL, 10));
+	} else if (strcmp(argv[1], "srgb_dec") == 0 && argc == 2) {
+		rc = gen_srgb_dec();
+	} else if (strcmp(argv[1], "ct_xyz") == 0 && argc == 4) {
+		rc = parse_obs(argv[3], &obs);
+		if (!rc) {
+			rc = gen_ct_xyz(strtoul(argv[2], NULL, 10), obs);
+		}
+	} else if (strcmp(argv[1], "cmf") == 0 && argc == 6) {
+		rc = parse_obs(argv[5], &obs);
+		if (!rc) {
+			rc = parse_grid(&argv[2], &nm, &n);
+		}
+		if (!rc) {
+			rc = gen_cmf(nm, n, obs);
+		}
+	} else if (strcmp(argv[1], "lef") == 0 && argc == 6) {
+		rc = parse_grid(&argv[2], &nm, &n);
+		if (!rc) {
+			rc = gen_lef(nm, n, argv[5][0] == 's' ?
+				     ZSL_CLR_LEF_CIE51_SCOTOPIC :
+				     ZSL_CLR_LEF_CIE88_PHOTOPIC);
+		}
+	} else {
+		usage();
+		return 1;
+	}
+
+	free(nm);
+
+	if (rc) {
+		fprintf(stderr, "Unable to generate table (%d).\n", rc);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/block.h>
+#include <zsl/filter.h>
+
+int
+zsl_blk_init(struct zsl_blk *b)
+{
+	if ((b->buf[0] == NULL) || (b->buf[1] == NULL) || (b->sz == 0)) {
+		return -EINVAL;
+	}
+
+	b->nstages = 0;
+	b->head = 0;
+	b->pos = 0;
+	b->overruns = 0;
+	b->tail = 0;
+	b->errors = 0;
+#ifdef __ZEPHYR__
+	k_sem_init(&b->ready, 0, 2);
+#endif
+
+	return 0;
+}
+
+int
+zsl_blk_add_stage(struct zsl_blk *b, zsl_blk_stage_fn_t fn, void *arg)
+{
+	if (fn == NULL) {
+		return -EINVAL;
+	}
+
+	if (b->nstages >= b->max_stages) {
+		return -ENOMEM;
+	}
+
+	b->stages[b->nstages].fn = fn;
+	b->stages[b->nstages].arg = arg;
+	b->nstages++;
+
+	return 0;
+}
+
+int
+zsl_blk_commit(struct zsl_blk *b)
+{
+	uint32_t head = b->head;
+
+	if (head - __atomic_load_n(&b->tail, __ATOMIC_ACQUIRE) >= 2) {
+		b->overruns++;
+		return -ENOBUFS;
+	}
+
+	/* Publish the block only once it has been written. */
+	b->pos = 0;
+	__atomic_store_n(&b->head, head + 1, __ATOMIC_RELEASE);
+#ifdef __ZEPHYR__
+	k_sem_give(&b->ready);
+#endif
+
+	return 0;
+}
+
+int
+zsl_blk_push(struct zsl_blk *b, zsl_real_t x)
+{
+	zsl_real_t *buf = zsl_blk_fill_buf(b);
+
+	if (buf == NULL) {
+		b->overruns++;
+		return -ENOBUFS;
+	}
+
+	buf[b->pos++] = x;
+	if (b->pos == b->sz) {
+		return zsl_blk_commit(b);
+	}
+
+	return 0;
+}
+
+int
+zsl_blk_process(struct zsl_blk *b, bool wait)
+{
+	int rc = 0;
+	uint32_t tail = b->tail;
+	struct zsl_vec v;
+
+	while (__atomic_load_n(&b->head, __ATOMIC_ACQUIRE) == tail) {
+#ifdef __ZEPHYR__
+		if (wait) {
+			/* The count may be stale if earlier calls didn't wait,
+			 * so check the level again after waking. */
+			k_sem_take(&b->ready, K_FOREVER);
+			continue;
+		}
+#endif
+		return -EAGAIN;
+	}
+
+	v.sz = b->sz;
+	v.data = b->buf[tail & 1];
+
+	for (size_t i = 0; i < b->nstages; i++) {
+		rc = b->stages[i].fn(&v, b->stages[i].arg);
+		if (rc) {
+			b->errors++;
+			break;
+		}
+	}
+
+	/* Return the block to the producer. */
+	__atomic_store_n(&b->tail, tail + 1, __ATOMIC_RELEASE);
+
+	return rc;
+}
+
+int
+zsl_blk_stage_fir(struct zsl_vec *v, void *arg)
+{
+	return zsl_fir_process((struct zsl_fir *)arg, v);
+}
+
+int
+zsl_blk_stage_iir(struct zsl_vec *v, void *arg)
+{
+	return zsl_iir_process((struct zsl_iir *)arg, v);
+}
@@ -6,9 +6,10 @@
 
 #include <math.h>
 #include <errno.h>
-#include <kernel.h>
+#include <string.h>
 #include <zsl/zsl.h>
 #include <zsl/chemistry.h>
+#include <zsl/physics/gases.h>
 
 const zsl_real_t zsl_chem_atom_weight[119] = {
         0.0,        /* NULL element so that index matches atomic number. */
@@ -131,3 +132,289 @@ const zsl_real_t zsl_chem_atom_weight[119] = {
         0.0,        /* Tennessine, Ts       117 */
         0.0         /* Oganesson, Og        118 */
 };
+
+const struct zsl_chem_elem_props zsl_chem_elem_props[119] = {
+	{ "",   0,  0 },       /* NULL element, so index = atomic number. */
+	{ "H",  1,  1 },       /* Hydrogen, 1 */
+	{ "He", 1, 18 },       /* Helium, 2 */
+	{ "Li", 2,  1 },       /* Lithium, 3 */
+	{ "Be", 2,  2 },       /* Beryllium, 4 */
+	{ "B",  2, 13 },       /* Boron, 5 */
+	{ "C",  2, 14 },       /* Carbon, 6 */
+	{ "N",  2, 15 },       /* Nitrogen, 7 */
+	{ "O",  2, 16 },       /* Oxygen, 8 */
+	{ "F",  2, 17 },       /* Fluorine, 9 */
+	{ "Ne", 2, 18 },       /* Neon, 10 */
+	{ "Na", 3,  1 },       /* Sodium, 11 */
+	{ "Mg", 3,  2 },       /* Magnesium, 12 */
+	{ "Al", 3, 13 },       /* Aluminium, 13 */
+	{ "Si", 3, 14 },       /* Silicon, 14 */
+	{ "P",  3, 15 },       /* Phosphorus, 15 */
+	{ "S",  3, 16 },       /* Sulfur, 16 */
+	{ "Cl", 3, 17 },       /* Chlorine, 17 */
+	{ "Ar", 3, 18 },       /* Argon, 18 */
+	{ "K",  4,  1 },       /* Potassium, 19 */
+	{ "Ca", 4,  2 },       /* Calcium, 20 */
+	{ "Sc", 4,  3 },       /* Scandium, 21 */
+	{ "Ti", 4,  4 },       /* Titanium, 22 */
+	{ "V",  4,  5 },       /* Vanadium, 23 */
+	{ "Cr", 4,  6 },       /* Chromium, 24 */
+	{ "Mn", 4,  7 },       /* Manganese, 25 */
+	{ "Fe", 4,  8 },       /* Iron, 26 */
+	{ "Co", 4,  9 },       /* Cobalt, 27 */
+	{ "Ni", 4, 10 },       /* Nickel, 28 */
+	{ "Cu", 4, 11 },       /* Copper, 29 */
+	{ "Zn", 4, 12 },       /* Zinc, 30 */
+	{ "Ga", 4, 13 },       /* Gallium, 31 */
+	{ "Ge", 4, 14 },       /* Germanium, 32 */
+	{ "As", 4, 15 },       /* Arsenic, 33 */
+	{ "Se", 4, 16 },       /* Selenium, 34 */
+	{ "Br", 4, 17 },       /* Bromine, 35 */
+	{ "Kr", 4, 18 },       /* Krypton, 36 */
+	{ "Rb", 5,  1 },       /* Rubidium, 37 */
+	{ "Sr", 5,  2 },       /* Strontium, 38 */
+	{ "Y",  5,  3 },       /* Yttrium, 39 */
+	{ "Zr", 5,  4 },       /* Zirconium, 40 */
+	{ "Nb", 5,  5 },       /* Niobium, 41 */
+	{ "Mo", 5,  6 },       /* Molybdenum, 42 */
+	{ "Tc", 5,  7 },       /* Technetium, 43 */
+	{ "Ru", 5,  8 },       /* Ruthenium, 44 */
+	{ "Rh", 5,  9 },       /* Rhodium, 45 */
+	{ "Pd", 5, 10 },       /* Palladium, 46 */
+	{ "Ag", 5, 11 },       /* Silver, 47 */
+	{ "Cd", 5, 12 },       /* Cadmium, 48 */
+	{ "In", 5, 13 },       /* Indium, 49 */
+	{ "Sn", 5, 14 },       /* Tin, 50 */
+	{ "Sb", 5, 15 },       /* Antimony, 51 */
+	{ "Te", 5, 16 },       /* Tellurium, 52 */
+	{ "I",  5, 17 },       /* Iodine, 53 */
+	{ "Xe", 5, 18 },       /* Xenon, 54 */
+	{ "Cs", 6,  1 },       /* Caesium, 55 */
+	{ "Ba", 6,  2 },       /* Barium, 56 */
+	{ "La", 6,  0 },       /* Lanthanum, 57 */
+	{ "Ce", 6,  0 },       /* Cerium, 58 */
+	{ "Pr", 6,  0 },       /* Praseodymium, 59 */
+	{ "Nd", 6,  0 },       /* Neodymium, 60 */
+	{ "Pm", 6,  0 },       /* Promethium, 61 */
+	{ "Sm", 6,  0 },       /* Samarium, 62 */
+	{ "Eu", 6,  0 },       /* Europium, 63 */
+	{ "Gd", 6,  0 },       /* Gadolinium, 64 */
+	{ "Tb", 6,  0 },       /* Terbium, 65 */
+	{ "Dy", 6,  0 },       /* Dysprosium, 66 */
+	{ "Ho", 6,  0 },       /* Holmium, 67 */
+	{ "Er", 6,  0 },       /* Erbium, 68 */
+	{ "Tm", 6,  0 },       /* Thulium, 69 */
+	{ "Yb", 6,  0 },       /* Ytterbium, 70 */
+	{ "Lu", 6,  3 },       /* Lutetium, 71 */
+	{ "Hf", 6,  4 },       /* Hafnium, 72 */
+	{ "Ta", 6,  5 },       /* Tantalum, 73 */
+	{ "W",  6,  6 },       /* Tungsten, 74 */
+	{ "Re", 6,  7 },       /* Rhenium, 75 */
+	{ "Os", 6,  8 },       /* Osmium, 76 */
+	{ "Ir", 6,  9 },       /* Iridium, 77 */
+	{ "Pt", 6, 10 },       /* Platinum, 78 */
+	{ "Au", 6, 11 },       /* Gold, 79 */
+	{ "Hg", 6, 12 },       /* Mercury, 80 */
+	{ "Tl", 6, 13 },       /* Thallium, 81 */
+	{ "Pb", 6, 14 },       /* Lead, 82 */
+	{ "Bi", 6, 15 },       /* Bismuth, 83 */
+	{ "Po", 6, 16 },       /* Polonium, 84 */
+	{ "At", 6, 17 },       /* Astatine, 85 */
+	{ "Rn", 6, 18 },       /* Radon, 86 */
+	{ "Fr", 7,  1 },       /* Francium, 87 */
+	{ "Ra", 7,  2 },       /* Radium, 88 */
+	{ "Ac", 7,  0 },       /* Actinium, 89 */
+	{ "Th", 7,  0 },       /* Thorium, 90 */
+	{ "Pa", 7,  0 },       /* Protactinium, 91 */
+	{ "U",  7,  0 },       /* Uranium, 92 */
+	{ "Np", 7,  0 },       /* Neptunium, 93 */
+	{ "Pu", 7,  0 },       /* Plutonium, 94 */
+	{ "Am", 7,  0 },       /* Americium, 95 */
+	{ "Cm", 7,  0 },       /* Curium, 96 */
+	{ "Bk", 7,  0 },       /* Berkelium, 97 */
+	{ "Cf", 7,  0 },       /* Californium, 98 */
+	{ "Es", 7,  0 },       /* Einsteinium, 99 */
+	{ "Fm", 7,  0 },       /* Fermium, 100 */
+	{ "Md", 7,  0 },       /* Mendelevium, 101 */
+	{ "No", 7,  0 },       /* Nobelium, 102 */
+	{ "Lr", 7,  3 },       /* Lawrencium, 103 */
+	{ "Rf", 7,  4 },       /* Rutherfordium, 104 */
+	{ "Db", 7,  5 },       /* Dubnium, 105 */
+	{ "Sg", 7,  6 },       /* Seaborgium, 106 */
+	{ "Bh", 7,  7 },       /* Bohrium, 107 */
+	{ "Hs", 7,  8 },       /* Hassium, 108 */
+	{ "Mt", 7,  9 },       /* Meitnerium, 109 */
+	{ "Ds", 7, 10 },       /* Darmstadtium, 110 */
+	{ "Rg", 7, 11 },       /* Roentgenium, 111 */
+	{ "Cn", 7, 12 },       /* Copernicium, 112 */
+	{ "Nh", 7, 13 },       /* Nihonium, 113 */
+	{ "Fl", 7, 14 },       /* Flerovium, 114 */
+	{ "Mc", 7, 15 },       /* Moscovium, 115 */
+	{ "Lv", 7, 16 },       /* Livermorium, 116 */
+	{ "Ts", 7, 17 },       /* Tennessine, 117 */
+	{ "Og", 7, 18 }        /* Oganesson, 118 */
+};
+
+int
+zsl_chem_elem_find(const char *sym, enum zsl_chem_elements *e)
+{
+	for (size_t i = 1; i <= ZSL_CHEM_ELEM_OGANESSON; i++) {
+		if (strcmp(zsl_chem_elem_props[i].sym, sym) == 0) {
+			*e = (enum zsl_chem_elements)i;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+int
+zsl_chem_formula_init(struct zsl_chem_formula *f)
+{
+	enum zsl_chem_elements e;
+	zsl_real_t w;
+
+	f->mm = 0.0;
+	for (size_t i = 0; i < f->sz; i++) {
+		e = (enum zsl_chem_elements)f->terms[i].elem;
+		w = zsl_chem_elem_weight(e);
+		if (w == 0.0) {
+			return -EINVAL;
+		}
+		f->mm += w * f->terms[i].count;
+	}
+
+	return 0;
+}
+
+int
+zsl_chem_formula_parse(const char *s, struct zsl_chem_formula *f)
+{
+	size_t n = 0;
+	char sym[3];
+	uint32_t count;
+	enum zsl_chem_elements e;
+
+	while (*s != '\0') {
+		/* A symbol is an upper case letter, then an optional lower case
+		 * letter. */
+		if (*s < 'A' || *s > 'Z') {
+			return -EINVAL;
+		}
+		sym[0] = *s++;
+		sym[1] = '\0';
+		sym[2] = '\0';
+		if (*s >= 'a' && *s <= 'z') {
+			sym[1] = *s++;
+		}
+		if (zsl_chem_elem_find(sym, &e) != 0) {
+			return -EINVAL;
+		}
+
+		count = 0;
+		while (*s >= '0' && *s <= '9') {
+			count = count * 10 + (uint32_t)(*s++ - '0');
+			if (count > UINT16_MAX) {
+				return -EINVAL;
+			}
+		}
+		if (count == 0) {
+			count = 1;
+		}
+
+		if (n == f->sz) {
+			return -ENOMEM;
+		}
+		f->terms[n].elem = (uint8_t)e;
+		f->terms[n].count = (uint16_t)count;
+		n++;
+	}
+
+	if (n == 0) {
+		return -EINVAL;
+	}
+	f->sz = n;
+
+	return zsl_chem_formula_init(f);
+}
+
+/* Sets 'n' to the molar density of an ideal gas, p / RT, in mol/m^3. */
+static int
+zsl_chem_gas_dens(zsl_real_t t, zsl_real_t p, zsl_real_t *n)
+{
+	int rc;
+	zsl_real_t rt;
+
+	if (p <= 0.0) {
+		return -EINVAL;
+	}
+
+	/* The pressure of one mole in one cubic metre is RT. */
+	rc = zsl_phy_gas_press(1.0, 1.0, t, &rt);
+	if (rc != 0 || rt <= 0.0) {
+		return -EINVAL;
+	}
+
+	*n = p / rt;
+
+	return 0;
+}
+
+/* Sets w = s * v, element by element. */
+static void
+zsl_chem_vec_scale(const struct zsl_vec *v, zsl_real_t s, struct zsl_vec *w)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		w->data[i] = v->data[i] * s;
+	}
+}
+
+int
+zsl_chem_ppm_to_mgm3(const struct zsl_chem_formula *f, zsl_real_t t,
+		     zsl_real_t p, const struct zsl_vec *ppm,
+		     struct zsl_vec *mg)
+{
+	zsl_real_t n;
+
+	if (ppm->sz != mg->sz || zsl_chem_gas_dens(t, p, &n) != 0) {
+		return -EINVAL;
+	}
+
+	/* 1 ppm is 1E-6 mol of gas per mol of mixture, and 1 g is 1E3 mg. */
+	zsl_chem_vec_scale(ppm, n * f->mm * 1E-3, mg);
+
+	return 0;
+}
+
+int
+zsl_chem_mgm3_to_ppm(const struct zsl_chem_formula *f, zsl_real_t t,
+		     zsl_real_t p, const struct zsl_vec *mg,
+		     struct zsl_vec *ppm)
+{
+	zsl_real_t n;
+
+	if (mg->sz != ppm->sz || f->mm <= 0.0 ||
+	    zsl_chem_gas_dens(t, p, &n) != 0) {
+		return -EINVAL;
+	}
+
+	zsl_chem_vec_scale(mg, 1E3 / (n * f->mm), ppm);
+
+	return 0;
+}
+
+int
+zsl_chem_ppm_to_molar(zsl_real_t t, zsl_real_t p, const struct zsl_vec *ppm,
+		      struct zsl_vec *mol)
+{
+	zsl_real_t n;
+
+	if (ppm->sz != mol->sz || zsl_chem_gas_dens(t, p, &n) != 0) {
+		return -EINVAL;
+	}
+
+	/* 1E-6 for ppm, and 1E-3 for m^3 to L. */
+	zsl_chem_vec_scale(ppm, n * 1E-9, mol);
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/colorimetry.h>
+
+int zsl_clr_ccm_fit_init(struct zsl_clr_ccm_fit *fit)
+{
+	memset(fit, 0, sizeof(*fit));
+
+	return 0;
+}
+
+/* Returns true if either value of a patch is flagged as invalid. */
+static bool zsl_clr_ccm_fit_invalid(const struct zsl_clr_rgbf *rgb,
+				    const struct zsl_clr_xyz *xyz)
+{
+	return rgb->r_invalid || rgb->g_invalid || rgb->b_invalid ||
+	       xyz->x_invalid || xyz->y_invalid || xyz->z_invalid;
+}
+
+int zsl_clr_ccm_fit_feed(struct zsl_clr_ccm_fit *fit,
+			 const struct zsl_clr_rgbf *rgb,
+			 const struct zsl_clr_xyz *xyz, zsl_real_t w)
+{
+	zsl_real_t r[3] = { rgb->r, rgb->g, rgb->b };
+	zsl_real_t x[3] = { xyz->xyz_x, xyz->xyz_y, xyz->xyz_z };
+
+	if ((w < 0.0) || zsl_clr_ccm_fit_invalid(rgb, xyz)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			fit->rr[i * 3 + j] += w * r[i] * r[j];
+			fit->rx[i * 3 + j] += w * r[i] * x[j];
+		}
+	}
+	fit->xx += w * (x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+	fit->w += w;
+	fit->n++;
+
+	return 0;
+}
+
+int zsl_clr_ccm_fit_feed_arr(struct zsl_clr_ccm_fit *fit,
+			     const struct zsl_clr_rgbf *rgb,
+			     const struct zsl_clr_xyz *xyz, size_t n)
+{
+	/* Check every patch first, so a bad one leaves the fit unchanged. */
+	for (size_t i = 0; i < n; i++) {
+		if (zsl_clr_ccm_fit_invalid(&rgb[i], &xyz[i])) {
+			return -EINVAL;
+		}
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_clr_ccm_fit_feed(fit, &rgb[i], &xyz[i], 1.0);
+	}
+
+	return 0;
+}
+
+int zsl_clr_ccm_fit_solve(const struct zsl_clr_ccm_fit *fit,
+			  const struct zsl_mtx *rgbccm, struct zsl_mtx *ccm,
+			  zsl_real_t *rms)
+{
+	int rc;
+	zsl_real_t sse = 0.0;
+
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(mt, 3, 3);
+	ZSL_MATRIX_DEF(m, 3, 3);
+
+	if ((ccm->sz_rows != 3) || (ccm->sz_cols != 3) || (fit->w <= 0.0)) {
+		return -EINVAL;
+	}
+	if ((rgbccm != NULL) &&
+	    ((rgbccm->sz_rows != 3) || (rgbccm->sz_cols != 3))) {
+		return -EINVAL;
+	}
+
+	/* Solve (sum of rgb * rgb^T) * M^T = (sum of rgb * xyz^T). */
+	memcpy(l.data, fit->rr, sizeof(fit->rr));
+	memcpy(mt.data, fit->rx, sizeof(fit->rx));
+	rc = zsl_mtx_cholesky(&l, &l);
+	if (rc) {
+		return rc;
+	}
+	zsl_mtx_chol_solve(&l, &mt, &mt);
+	zsl_mtx_trans(&mt, &m);
+
+	/* At the solution, the weighted squared error is the sum of xyz^T *
+	 * xyz, less the sum of the products of M^T and rgb * xyz^T. */
+	if (rms != NULL) {
+		for (size_t i = 0; i < 9; i++) {
+			sse += mt.data[i] * fit->rx[i];
+		}
+		sse = fit->xx - sse;
+		*rms = (sse > 0.0) ? ZSL_SQRT(sse / fit->w) : 0.0;
+	}
+
+	if (rgbccm != NULL) {
+		return zsl_mtx_mult(rgbccm, &m, ccm);
+	}
+
+	return zsl_mtx_copy(ccm, &m);
+}
@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <string.h>
 #include <zsl/colorimetry.h>
+#include <zsl/instrument.h>
 
 #ifndef M_PI
 #define M_PI (3.14159265358979323846)
@@ -429,6 +430,8 @@ zsl_clr_conv_spd_xyz(const struct zsl_clr_spd *spd, enum zsl_clr_obs obs,
 	unsigned int nm_idx;
 	const struct zsl_clr_obs_data *obs_data;
 
+	ZSL_TRACE(ZSL_TRACE_CLR_CONV_SPD_XYZ);
+
 	/* Clear the output values (used for internal manipulation). */
 	memset(xyz, 0, sizeof(*xyz));
 	matches = 0;
@@ -444,6 +447,10 @@ zsl_clr_conv_spd_xyz(const struct zsl_clr_spd *spd, enum zsl_clr_obs obs,
 
 	/* Get a reference to the standard observer CMF dataset. */
 	zsl_clr_obs_get(obs, &obs_data);
+	if (obs_data == NULL) {
+		rc = -EINVAL;
+		goto err;
+	}
 
 	/* Sum contents of the spd. Only accept values from 360 to 830 nm. */
 	for (int i = 0; i < spd->size; i++) {
@@ -488,6 +495,278 @@ err:
 	return rc;
 }
 
+int
+zsl_clr_conv_spd_soa_xyz(const struct zsl_clr_spd_soa *spd,
+			 enum zsl_clr_obs obs, struct zsl_clr_xyz *xyz)
+{
+	int rc;
+	int matches;
+	unsigned int nm_idx;
+	zsl_real_t x, y, z;
+	const zsl_real_t *v = spd->values.data;
+	const struct zsl_clr_obs_data *obs_data;
+
+	/* Clear the output values and flags. */
+	memset(xyz, 0, sizeof(*xyz));
+	matches = 0;
+	x = y = z = 0.0;
+
+	if (spd->values.sz < 1) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Get a reference to the standard observer CMF dataset. */
+	zsl_clr_obs_get(obs, &obs_data);
+	if (obs_data == NULL) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Sum contents of the spd. Only accept values from 360 to 830 nm. */
+	for (size_t i = 0; i < spd->values.sz; i++) {
+		if ((spd->nm[i] > 359) && (spd->nm[i] < 831)) {
+			/* Round nm to the nearest 5 nm interval. */
+			nm_idx = ((spd->nm[i] - 360) / 5);
+			/* Accumulate tristimulus values in locals. */
+			x += v[i] * obs_data->data[nm_idx].xyz_x;
+			y += v[i] * obs_data->data[nm_idx].xyz_y;
+			z += v[i] * obs_data->data[nm_idx].xyz_z;
+			matches++;
+		}
+	}
+
+	/* Avoid divide by zero error if no matches found. */
+	if (!matches || y == 0.0) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* The division by the number of valid components cancels out when
+	 * scaling the output to Y=1.0. */
+	xyz->xyz_x = x / y;
+	xyz->xyz_z = z / y;
+	xyz->xyz_y = 1.0;
+
+	/* Set the observer model. */
+	xyz->observer = obs;
+
+	return 0;
+err:
+	xyz->x_invalid = 1;
+	xyz->y_invalid = 1;
+	xyz->z_invalid = 1;
+	return rc;
+}
+
+int
+zsl_clr_conv_spd_xyz_compile(struct zsl_clr_spd_xyz_conv *c,
+			     const unsigned int *nm, const struct zsl_vec *gain,
+			     enum zsl_clr_obs obs)
+{
+	size_t n = c->w.sz_cols;
+	size_t matches = 0;
+	unsigned int nm_idx;
+	zsl_real_t g;
+	const struct zsl_clr_obs_data *obs_data;
+
+	if (c->w.sz_rows != 3 || n == 0 || (gain != NULL && gain->sz != n)) {
+		return -EINVAL;
+	}
+
+	/* Get a reference to the standard observer CMF dataset. */
+	zsl_clr_obs_get(obs, &obs_data);
+	if (obs_data == NULL) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		if ((nm[i] > 359) && (nm[i] < 831)) {
+			/* Round nm to the nearest 5 nm interval. */
+			nm_idx = ((nm[i] - 360) / 5);
+			g = gain == NULL ? 1.0 : gain->data[i];
+			c->w.data[i] = g * obs_data->data[nm_idx].xyz_x;
+			c->w.data[n + i] = g * obs_data->data[nm_idx].xyz_y;
+			c->w.data[2 * n + i] = g * obs_data->data[nm_idx].xyz_z;
+			matches++;
+		} else {
+			c->w.data[i] = 0.0;
+			c->w.data[n + i] = 0.0;
+			c->w.data[2 * n + i] = 0.0;
+		}
+	}
+
+	if (!matches) {
+		return -EINVAL;
+	}
+
+	/* Fold in the division by the number of valid components. */
+	for (size_t i = 0; i < 3 * n; i++) {
+		c->w.data[i] /= (zsl_real_t)matches;
+	}
+
+	c->observer = obs;
+
+	return 0;
+}
+
+int
+zsl_clr_conv_spd_xyz_compiled(const struct zsl_clr_spd_xyz_conv *c,
+			      const struct zsl_vec *values,
+			      struct zsl_clr_xyz *xyz)
+{
+	int rc;
+	size_t n = c->w.sz_cols;
+	struct zsl_vec row = { .sz = n };
+
+	memset(xyz, 0, sizeof(*xyz));
+
+	if (values->sz != n) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* One dot product per row of weights. */
+	row.data = c->w.data;
+	zsl_vec_dot(&row, values, &xyz->xyz_x);
+	row.data = c->w.data + n;
+	zsl_vec_dot(&row, values, &xyz->xyz_y);
+	row.data = c->w.data + 2 * n;
+	zsl_vec_dot(&row, values, &xyz->xyz_z);
+
+	if (xyz->xyz_y == 0.0) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Scale output to Y=1.0 */
+	xyz->xyz_x /= xyz->xyz_y;
+	xyz->xyz_z /= xyz->xyz_y;
+	xyz->xyz_y = 1.0;
+
+	/* Set the observer model. */
+	xyz->observer = c->observer;
+
+	return 0;
+err:
+	xyz->x_invalid = 1;
+	xyz->y_invalid = 1;
+	xyz->z_invalid = 1;
+	return rc;
+}
+
+/**
+ * @brief Cone response matrices for the chromatic adaptation transforms, in
+ *        zsl_clr_cat_method order.
+ */
+static const zsl_real_t zsl_clr_conv_cat_data[2][9] = {
+	/* Bradford. */
+	{ 0.8951, 0.2664, -0.1614,
+	  -0.7502, 1.7135, 0.0367,
+	  0.0389, -0.0685, 1.0296 },
+	/* CAT02. */
+	{ 0.7328, 0.4296, -0.1624,
+	  -0.7036, 1.6975, 0.0061,
+	  0.0030, 0.0136, 0.9834 },
+};
+
+int
+zsl_clr_conv_cat_compile(struct zsl_clr_cat *cat,
+			 enum zsl_clr_cat_method method,
+			 enum zsl_clr_obs obs, enum zsl_clr_illum src,
+			 enum zsl_clr_illum dst)
+{
+	int rc;
+	zsl_real_t rs, rd;
+	const struct zsl_clr_illum_data *ws, *wd;
+
+	ZSL_MATRIX_DEF(ma, 3, 3);
+	ZSL_MATRIX_DEF(mai, 3, 3);
+
+	/* Keep the transform if it is already the requested one. */
+	if (cat->valid && cat->method == method && cat->observer == obs &&
+	    cat->src == src && cat->dst == dst) {
+		return 0;
+	}
+
+	cat->valid = false;
+
+	if (method > ZSL_CLR_CAT_METHOD_CAT02) {
+		return -EINVAL;
+	}
+
+	rc = zsl_clr_illum_get(obs, src, &ws);
+	if (rc) {
+		return rc;
+	}
+	rc = zsl_clr_illum_get(obs, dst, &wd);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_mtx_from_arr(&ma, (zsl_real_t *)zsl_clr_conv_cat_data[method]);
+	rc = zsl_mtx_inv_3x3(&ma, &mai);
+	if (rc) {
+		return rc;
+	}
+
+	/* Scale each cone response row by the ratio of the white points. */
+	for (size_t i = 0; i < 3; i++) {
+		zsl_real_t *row = &ma.data[3 * i];
+
+		rs = row[0] * ws->data.xyz_x + row[1] * ws->data.xyz_y +
+		     row[2] * ws->data.xyz_z;
+		rd = row[0] * wd->data.xyz_x + row[1] * wd->data.xyz_y +
+		     row[2] * wd->data.xyz_z;
+		if (rs == 0.0) {
+			return -EINVAL;
+		}
+		for (size_t j = 0; j < 3; j++) {
+			row[j] *= rd / rs;
+		}
+	}
+
+	rc = zsl_mtx_mult(&mai, &ma, &cat->m);
+	if (rc) {
+		return rc;
+	}
+
+	cat->method = method;
+	cat->observer = obs;
+	cat->src = src;
+	cat->dst = dst;
+	cat->valid = true;
+
+	return 0;
+}
+
+int
+zsl_clr_conv_xyz_cat(const struct zsl_clr_cat *cat,
+		     const struct zsl_clr_xyz *in, struct zsl_clr_xyz *out,
+		     size_t n)
+{
+	const zsl_real_t *m = cat->m.data;
+
+	if (!cat->valid) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t x = in[i].xyz_x;
+		zsl_real_t y = in[i].xyz_y;
+		zsl_real_t z = in[i].xyz_z;
+
+		out[i] = in[i];
+		out[i].xyz_x = m[0] * x + m[1] * y + m[2] * z;
+		out[i].xyz_y = m[3] * x + m[4] * y + m[5] * z;
+		out[i].xyz_z = m[6] * x + m[7] * y + m[8] * z;
+		out[i].observer = cat->observer;
+		out[i].illuminant = cat->dst;
+	}
+
+	return 0;
+}
+
 int
 zsl_clr_conv_xyy_xyz(struct zsl_clr_xyy *xyy, struct zsl_clr_xyz *xyz)
 {
@@ -661,6 +940,12 @@ zsl_clr_conv_ct_xyz(zsl_real_t ct, enum zsl_clr_obs obs, struct zsl_clr_xyz *xyz
 
 	/* Get a reference to the standard observer CMF dataset. */
 	zsl_clr_obs_get(obs, &obs_data);
+	if (obs_data == NULL) {
+		xyz->x_invalid = 1;
+		xyz->y_invalid = 1;
+		xyz->z_invalid = 1;
+		return -EINVAL;
+	}
 
 	/* Calculate emittance at given wavelength using Planck's radiation
 	 * law and the specified 5nm standard observer lookup table. */
@@ -691,8 +976,8 @@ zsl_clr_conv_ct_xyz(zsl_real_t ct, enum zsl_clr_obs obs, struct zsl_clr_xyz *xyz
 }
 
 int
-zsl_clr_conv_ct_rgb8(zsl_real_t ct, enum zsl_clr_obs obs, struct zsl_mtx *mtx,
-		     struct zsl_clr_rgb8 *rgb)
+zsl_clr_conv_ct_rgb8(zsl_real_t ct, enum zsl_clr_obs obs,
+		     const struct zsl_mtx *mtx, struct zsl_clr_rgb8 *rgb)
 {
 	int rc;
 	struct zsl_clr_xyz xyz;
@@ -716,8 +1001,108 @@ err:
 }
 
 int
-zsl_clr_conv_ct_rgbf(zsl_real_t ct, enum zsl_clr_obs obs, struct zsl_mtx *mtx,
-		     struct zsl_clr_rgbf *rgb)
+zsl_clr_ct_lut_compile(struct zsl_clr_ct_lut *lut, enum zsl_clr_obs obs)
+{
+	int rc;
+	size_t n = lut->xz.sz_rows;
+	zsl_real_t m0 = 1.0 / ZSL_CLR_CT_LUT_MIN;
+	zsl_real_t dm;
+	struct zsl_clr_xyz xyz;
+
+	/* Keep the table if it is already the requested one. */
+	if (lut->valid && lut->observer == obs) {
+		return 0;
+	}
+
+	lut->valid = false;
+
+	if (n < 2 || lut->xz.sz_cols != 2) {
+		return -EINVAL;
+	}
+
+	/* Step evenly in reciprocal temperature. */
+	dm = (1.0 / ZSL_CLR_CT_LUT_MAX - m0) / (zsl_real_t)(n - 1);
+
+	for (size_t i = 0; i < n; i++) {
+		rc = zsl_clr_conv_ct_xyz(1.0 / (m0 + dm * (zsl_real_t)i), obs,
+					 &xyz);
+		if (rc) {
+			return rc;
+		}
+		lut->xz.data[2 * i] = xyz.xyz_x;
+		lut->xz.data[2 * i + 1] = xyz.xyz_z;
+	}
+
+	lut->observer = obs;
+	lut->valid = true;
+
+	return 0;
+}
+
+int
+zsl_clr_conv_ct_xyz_lut(const struct zsl_clr_ct_lut *lut, zsl_real_t ct,
+			bool exact, struct zsl_clr_xyz *xyz)
+{
+	size_t i;
+	size_t n = lut->xz.sz_rows;
+	zsl_real_t m0 = 1.0 / ZSL_CLR_CT_LUT_MIN;
+	zsl_real_t pos, f;
+	const zsl_real_t *row;
+
+	if (!lut->valid) {
+		memset(xyz, 0, sizeof *xyz);
+		xyz->x_invalid = 1;
+		xyz->y_invalid = 1;
+		xyz->z_invalid = 1;
+		return -EINVAL;
+	}
+
+	if (exact || ct < ZSL_CLR_CT_LUT_MIN || ct > ZSL_CLR_CT_LUT_MAX) {
+		return zsl_clr_conv_ct_xyz(ct, lut->observer, xyz);
+	}
+
+	/* Find the table position of ct in reciprocal temperature. */
+	pos = (1.0 / ct - m0) / (1.0 / ZSL_CLR_CT_LUT_MAX - m0) *
+	      (zsl_real_t)(n - 1);
+	i = (size_t)pos;
+	if (i > n - 2) {
+		i = n - 2;
+	}
+	f = pos - (zsl_real_t)i;
+	row = &lut->xz.data[2 * i];
+
+	memset(xyz, 0, sizeof *xyz);
+	xyz->xyz_x = row[0] + f * (row[2] - row[0]);
+	xyz->xyz_y = 1.0;
+	xyz->xyz_z = row[1] + f * (row[3] - row[1]);
+	xyz->observer = lut->observer;
+
+	return 0;
+}
+
+int
+zsl_clr_conv_ct_rgb8_lut(const struct zsl_clr_ct_lut *lut, zsl_real_t ct,
+			 bool exact, const struct zsl_mtx *mtx,
+			 struct zsl_clr_rgb8 *rgb)
+{
+	int rc;
+	struct zsl_clr_xyz xyz;
+
+	rc = zsl_clr_conv_ct_xyz_lut(lut, ct, exact, &xyz);
+	if (rc) {
+		rgb->r_invalid = 1;
+		rgb->g_invalid = 1;
+		rgb->b_invalid = 1;
+		rgb->a_invalid = 1;
+		return rc;
+	}
+
+	return zsl_clr_conv_xyz_rgb8(&xyz, mtx, rgb);
+}
+
+int
+zsl_clr_conv_ct_rgbf(zsl_real_t ct, enum zsl_clr_obs obs,
+		     const struct zsl_mtx *mtx, struct zsl_clr_rgbf *rgb)
 {
 	int rc;
 	struct zsl_clr_xyz xyz;
@@ -1041,53 +1426,78 @@ err:
 // 	return status;
 // }
 
-static int
-zsl_clr_conv_uv60_cct_ohno2014(struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct)
+/* Squared distance from uv to entry i of the OHNO2014 lookup table. */
+static inline zsl_real_t
+zsl_clr_conv_ohno2014_dist(size_t i, const struct zsl_clr_uv60 *uv)
 {
-	int rc;
-	zsl_real_t l_fp;
-	zsl_real_t l_bb;
-	zsl_real_t a;
+	zsl_real_t du = zsl_clr_conv_ct_uv_ohno_2014_data[i][1] - uv->uv60_u;
+	zsl_real_t dv = zsl_clr_conv_ct_uv_ohno_2014_data[i][2] - uv->uv60_v;
+
+	return du * du + dv * dv;
+}
+
+/* Table stride of the first, coarse pass of the cascade search. */
+#define OHNO2014_CASCADE_STEP 8
+
+/*
+ * Finds the closest OHNO2014 table entry to uv with a coarse pass over
+ * every OHNO2014_CASCADE_STEP'th entry, refined over the entries either
+ * side of the coarse match. This matches the full scan whenever the
+ * distance has a single minimum along the locus, as it does for any
+ * (u,v) near enough to the locus for CCT to be meaningful.
+ */
+static size_t
+zsl_clr_conv_ohno2014_cascade(const struct zsl_clr_uv60 *uv)
+{
+	size_t best = 0;
+	size_t lo, hi;
+	zsl_real_t d_best = 1.0;
 	zsl_real_t d_cur;
-	zsl_real_t d_best;      /* d */
-	zsl_real_t d_prev;      /* d m-1 */
-	zsl_real_t d_next;      /* d m+1 */
-	zsl_real_t x;           /* Distance from d_best to d m+1. */
-	zsl_real_t l;           /* Total width of d m-1 to d m+1. */
-	int match_idx;          /* Lookup index for d_best values. */
 
-	/* Basic input validation. */
-	if ((uv->u_invalid) || (uv->v_invalid)) {
-		rc = -EINVAL;
-		goto err;
+	for (size_t i = 0; i < OHNO2014_LOOKUP_RECS;
+	     i += OHNO2014_CASCADE_STEP) {
+		d_cur = zsl_clr_conv_ohno2014_dist(i, uv);
+		if (d_cur < d_best) {
+			d_best = d_cur;
+			best = i;
+		}
 	}
 
-	/* Clear values before starting. */
-	memset(cct, 0, sizeof *cct);
+	lo = best > OHNO2014_CASCADE_STEP ? best - OHNO2014_CASCADE_STEP : 0;
+	hi = best + OHNO2014_CASCADE_STEP;
+	if (hi > OHNO2014_LOOKUP_RECS - 1) {
+		hi = OHNO2014_LOOKUP_RECS - 1;
+	}
 
-	/* Triangular solution for CCT. */
 	d_best = 1.0;
-
-	/* Search for closest match for uv from 1% CT to (u,v) lookup.
-	 * Note: the static lookup table could be removed at the cost of a
-	 * performance hit by using the following function to calculate
-	 * distance on demand:
-	 *   zsl_clr_conv_calc_dist_uv60(ct_cur, ZSL_CLR_OBS_2_DEG, uv, &d_cur);
-	 */
-	match_idx = 0;
-	for (size_t i = 0; i < OHNO2014_LOOKUP_RECS; i++) {
-		/* Calculate distance of CT (u,v) to ref (u,v) chromaticity. */
-		d_cur = ((zsl_clr_conv_ct_uv_ohno_2014_data[i][1] - uv->uv60_u) *
-			 (zsl_clr_conv_ct_uv_ohno_2014_data[i][1] - uv->uv60_u) +
-			 (zsl_clr_conv_ct_uv_ohno_2014_data[i][2] - uv->uv60_v) *
-			 (zsl_clr_conv_ct_uv_ohno_2014_data[i][2] - uv->uv60_v));
-		/* Track best match. */
+	best = 0;
+	for (size_t i = lo; i <= hi; i++) {
+		d_cur = zsl_clr_conv_ohno2014_dist(i, uv);
 		if (d_cur < d_best) {
 			d_best = d_cur;
-			match_idx = i;
+			best = i;
 		}
 	}
 
+	return best;
+}
+
+/*
+ * Completes an OHNO2014 conversion from table entry match_idx, the closest
+ * to uv, with a triangular solution for CCT and a polynomial for Duv.
+ */
+static int
+zsl_clr_conv_ohno2014_finish(struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct,
+			     size_t match_idx)
+{
+	zsl_real_t l_fp;
+	zsl_real_t l_bb;
+	zsl_real_t a;
+	zsl_real_t d_prev;      /* d m-1 */
+	zsl_real_t d_next;      /* d m+1 */
+	zsl_real_t x;           /* Distance from d_best to d m+1. */
+	zsl_real_t l;           /* Total width of d m-1 to d m+1. */
+
 	/* Make sure we're within the 1000 K to 20000 K range. */
 	if ((zsl_clr_conv_ct_uv_ohno_2014_data[match_idx][0] <
 	     zsl_clr_conv_ct_uv_ohno_2014_data[1][0]) ||
@@ -1096,25 +1506,9 @@ zsl_clr_conv_uv60_cct_ohno2014(struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct)
 		return -EINVAL;
 	}
 
-	/* Calculate prev distance. */
-	d_prev = ((zsl_clr_conv_ct_uv_ohno_2014_data[match_idx - 1][1] -
-		   uv->uv60_u) *
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx - 1][1] -
-		   uv->uv60_u) +
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx - 1][2] -
-		   uv->uv60_v) *
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx - 1][2] -
-		   uv->uv60_v));
-
-	/* Calculate next distance. */
-	d_next = ((zsl_clr_conv_ct_uv_ohno_2014_data[match_idx + 1][1] -
-		   uv->uv60_u) *
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx + 1][1] -
-		   uv->uv60_u) +
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx + 1][2] -
-		   uv->uv60_v) *
-		  (zsl_clr_conv_ct_uv_ohno_2014_data[match_idx + 1][2] -
-		   uv->uv60_v));
+	/* Calculate prev and next distance. */
+	d_prev = zsl_clr_conv_ohno2014_dist(match_idx - 1, uv);
+	d_next = zsl_clr_conv_ohno2014_dist(match_idx + 1, uv);
 
 	l = ((zsl_clr_conv_ct_uv_ohno_2014_data[match_idx + 1][1] -
 	      zsl_clr_conv_ct_uv_ohno_2014_data[match_idx - 1][1]) *
@@ -1149,12 +1543,105 @@ zsl_clr_conv_uv60_cct_ohno2014(struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct)
 	cct->duv = l_fp - l_bb;
 
 	return 0;
+}
+
+static int
+zsl_clr_conv_uv60_cct_ohno2014(struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct)
+{
+	int rc;
+	zsl_real_t d_cur;
+	zsl_real_t d_best;      /* d */
+	size_t match_idx;       /* Lookup index for d_best values. */
+
+	/* Basic input validation. */
+	if ((uv->u_invalid) || (uv->v_invalid)) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Clear values before starting. */
+	memset(cct, 0, sizeof *cct);
+
+	/* Triangular solution for CCT. */
+	d_best = 1.0;
+
+	/* Search for closest match for uv from 1% CT to (u,v) lookup.
+	 * Note: the static lookup table could be removed at the cost of a
+	 * performance hit by using the following function to calculate
+	 * distance on demand:
+	 *   zsl_clr_conv_calc_dist_uv60(ct_cur, ZSL_CLR_OBS_2_DEG, uv, &d_cur);
+	 */
+	match_idx = 0;
+	for (size_t i = 0; i < OHNO2014_LOOKUP_RECS; i++) {
+		/* Calculate distance of CT (u,v) to ref (u,v) chromaticity. */
+		d_cur = zsl_clr_conv_ohno2014_dist(i, uv);
+		/* Track best match. */
+		if (d_cur < d_best) {
+			d_best = d_cur;
+			match_idx = i;
+		}
+	}
+
+	return zsl_clr_conv_ohno2014_finish(uv, cct, match_idx);
 err:
 	cct->cct_invalid = 1;
 	cct->duv_invalid = 1;
 	return rc;
 }
 
+static int
+zsl_clr_conv_uv60_cct_ohno2014_cascade(struct zsl_clr_uv60 *uv,
+				       struct zsl_clr_cct *cct)
+{
+	/* Basic input validation. */
+	if ((uv->u_invalid) || (uv->v_invalid)) {
+		cct->cct_invalid = 1;
+		cct->duv_invalid = 1;
+		return -EINVAL;
+	}
+
+	memset(cct, 0, sizeof *cct);
+
+	return zsl_clr_conv_ohno2014_finish(uv, cct,
+					    zsl_clr_conv_ohno2014_cascade(uv));
+}
+
+int
+zsl_clr_conv_uv60_cct_ohno2014_hint(struct zsl_clr_uv60 *uv,
+				    struct zsl_clr_cct *cct, size_t *hint)
+{
+	size_t i = *hint;
+	zsl_real_t d_cur;
+
+	/* Basic input validation. */
+	if ((uv->u_invalid) || (uv->v_invalid)) {
+		cct->cct_invalid = 1;
+		cct->duv_invalid = 1;
+		return -EINVAL;
+	}
+
+	memset(cct, 0, sizeof *cct);
+
+	if (i == 0 || i >= OHNO2014_LOOKUP_RECS - 1) {
+		/* No usable hint, so start from scratch. */
+		i = zsl_clr_conv_ohno2014_cascade(uv);
+	} else {
+		/* Walk downhill from the last match. */
+		d_cur = zsl_clr_conv_ohno2014_dist(i, uv);
+		while (i > 0 && zsl_clr_conv_ohno2014_dist(i - 1, uv) < d_cur) {
+			d_cur = zsl_clr_conv_ohno2014_dist(--i, uv);
+		}
+		while (i < OHNO2014_LOOKUP_RECS - 1 &&
+		       zsl_clr_conv_ohno2014_dist(i + 1, uv) < d_cur) {
+			d_cur = zsl_clr_conv_ohno2014_dist(++i, uv);
+		}
+	}
+
+	*hint = i;
+
+	return zsl_clr_conv_ohno2014_finish(uv, cct, i);
+}
+
 int
 zsl_clr_conv_uv60_cct(enum zsl_clr_uv_cct_method method, struct zsl_clr_uv60 *uv,
 		      struct zsl_clr_cct *cct)
@@ -1167,13 +1654,101 @@ zsl_clr_conv_uv60_cct(enum zsl_clr_uv_cct_method method, struct zsl_clr_uv60 *uv
 		return zsl_clr_conv_uv60_cct_ohno2011(uv, cct);
 	case ZSL_CLR_UV_CCT_METHOD_OHNO2014:
 		return zsl_clr_conv_uv60_cct_ohno2014(uv, cct);
+	case ZSL_CLR_UV_CCT_METHOD_OHNO2014_CASCADE:
+		return zsl_clr_conv_uv60_cct_ohno2014_cascade(uv, cct);
 	default:
 		return zsl_clr_conv_uv60_cct_ohno2014(uv, cct);
 	}
 }
 
 int
-zsl_clr_conv_xyz_rgb8(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
+zsl_clr_cct_pipe_compile(struct zsl_clr_cct_pipe *p,
+			 const unsigned int *nm, const struct zsl_vec *gain,
+			 enum zsl_clr_obs obs,
+			 enum zsl_clr_uv_cct_method method)
+{
+	p->method = method;
+	p->hint = 0;
+
+	return zsl_clr_conv_spd_xyz_compile(&p->conv, nm, gain, obs);
+}
+
+int
+zsl_clr_cct_pipe_run(struct zsl_clr_cct_pipe *p,
+		     const struct zsl_vec *counts, struct zsl_clr_cct *cct)
+{
+	int rc;
+	zsl_real_t d;
+	struct zsl_clr_xyz xyz;
+	struct zsl_clr_uv60 uv;
+
+	rc = zsl_clr_conv_spd_xyz_compiled(&p->conv, counts, &xyz);
+	if (rc) {
+		goto err;
+	}
+
+	/* XYZ straight to CIE 1960 (u, v), skipping the xyY step:
+	 *    u = 4X / (X + 15Y + 3Z)
+	 *    v = 6Y / (X + 15Y + 3Z)
+	 */
+	memset(&uv, 0, sizeof uv);
+	d = xyz.xyz_x + 15.0 * xyz.xyz_y + 3.0 * xyz.xyz_z;
+	if (d == 0.0) {
+		rc = -EINVAL;
+		goto err;
+	}
+	uv.uv60_u = 4.0 * xyz.xyz_x / d;
+	uv.uv60_v = 6.0 * xyz.xyz_y / d;
+	uv.observer = xyz.observer;
+
+	switch (p->method) {
+	case ZSL_CLR_UV_CCT_METHOD_OHNO2014:
+	case ZSL_CLR_UV_CCT_METHOD_OHNO2014_CASCADE:
+		return zsl_clr_conv_uv60_cct_ohno2014_hint(&uv, cct, &p->hint);
+	default:
+		return zsl_clr_conv_uv60_cct(p->method, &uv, cct);
+	}
+
+err:
+	cct->cct_invalid = 1;
+	cct->duv_invalid = 1;
+	return rc;
+}
+
+int
+zsl_clr_cct_pipe_mes(struct zsl_clr_cct_pipe *p,
+		     const struct zsl_vec *counts,
+		     struct zsl_measurement *mes)
+{
+	int rc;
+	struct zsl_clr_cct cct;
+
+	memset(&cct, 0, sizeof cct);
+	rc = zsl_clr_cct_pipe_run(p, counts, &cct);
+	if (rc) {
+		return rc;
+	}
+
+	p->out[0] = cct.cct;
+	p->out[1] = cct.duv;
+
+	memset(&mes->header, 0, sizeof mes->header);
+	mes->header.filter.base_type = ZSL_MES_TYPE_COLOR;
+	mes->header.filter.ext_type = ZSL_MES_EXT_TYPE_COLOR_CIE1960_CCT_DUV;
+	mes->header.unit.si_unit = ZSL_MES_UNIT_SI_KELVIN;
+#if CONFIG_ZSL_SINGLE_PRECISION
+	mes->header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+#else
+	mes->header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64;
+#endif
+	mes->header.srclen.len = sizeof(p->out);
+	mes->payload = p->out;
+
+	return 0;
+}
+
+int
+zsl_clr_conv_xyz_rgb8(struct zsl_clr_xyz *xyz, const struct zsl_mtx *mtx,
 		      struct zsl_clr_rgb8 *rgb)
 {
 	int rc;
@@ -1227,7 +1802,7 @@ err:
 }
 
 int
-zsl_clr_conv_xyz_rgbf(struct zsl_clr_xyz *xyz, struct zsl_mtx *mtx,
+zsl_clr_conv_xyz_rgbf(struct zsl_clr_xyz *xyz, const struct zsl_mtx *mtx,
 		      struct zsl_clr_rgbf *rgb)
 {
 	int rc;
@@ -1320,3 +1895,320 @@ err:
 	rgb->a_invalid = 1;
 	return rc;
 }
+
+/* Limits 'v' to 0.0..1.0 if CONFIG_ZSL_CLR_RGBF_BOUND_CAP is set, flagging
+ * values outside the gamut as zsl_clr_conv_xyz_rgbf does. */
+static inline zsl_real_t
+zsl_clr_conv_rgbf_gamut(zsl_real_t v, uint8_t *invalid)
+{
+	*invalid = (v < 0.0) || (v >= 1.0);
+
+	#if CONFIG_ZSL_CLR_RGBF_BOUND_CAP
+	v = (v < 0.0) ? 0.0 : v;
+	v = (v > 1.0) ? 1.0 : v;
+	#endif
+
+	return v;
+}
+
+/* Limits 'v' to 0.0..1.0, with NaN mapping to 0. */
+static inline zsl_real_t
+zsl_clr_conv_unit(zsl_real_t v)
+{
+	v = (v > 0.0) ? v : 0.0;
+
+	return (v < 1.0) ? v : 1.0;
+}
+
+/* Converts a 0.0..1.0 channel to 8-bits, directly or through 'lut'. */
+static inline uint8_t
+zsl_clr_conv_rgb8_chan(zsl_real_t v, const uint8_t *lut, size_t lut_sz)
+{
+	v = zsl_clr_conv_unit(v);
+
+	if (lut == NULL) {
+		return (uint8_t)(v * 255.0);
+	}
+
+	return lut[(size_t)(v * (zsl_real_t)(lut_sz - 1) + 0.5)];
+}
+
+int
+zsl_clr_conv_xyz_rgbf_arr(const struct zsl_clr_xyz *xyz,
+			  const struct zsl_mtx *mtx,
+			  struct zsl_clr_rgbf *rgb, size_t n)
+{
+	zsl_real_t m[9];
+	uint8_t ri, gi, bi;
+
+	if (mtx->sz_rows != 3 || mtx->sz_cols != 3) {
+		return -EINVAL;
+	}
+
+	memcpy(m, mtx->data, sizeof(m));
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t x = xyz[i].xyz_x;
+		zsl_real_t y = xyz[i].xyz_y;
+		zsl_real_t z = xyz[i].xyz_z;
+
+		rgb[i].r = zsl_clr_conv_rgbf_gamut(m[0] * x + m[1] * y +
+						   m[2] * z, &ri);
+		rgb[i].g = zsl_clr_conv_rgbf_gamut(m[3] * x + m[4] * y +
+						   m[5] * z, &gi);
+		rgb[i].b = zsl_clr_conv_rgbf_gamut(m[6] * x + m[7] * y +
+						   m[8] * z, &bi);
+		rgb[i].a = 1.0;
+		rgb[i].r_invalid = ri;
+		rgb[i].g_invalid = gi;
+		rgb[i].b_invalid = bi;
+		rgb[i].a_invalid = 0;
+	}
+
+	return 0;
+}
+
+int
+zsl_clr_conv_xyz_rgb8_arr(const struct zsl_clr_xyz *xyz,
+			  const struct zsl_mtx *mtx,
+			  struct zsl_clr_rgb8 *rgb, size_t n,
+			  const uint8_t *lut, size_t lut_sz)
+{
+	zsl_real_t m[9];
+	uint8_t ri, gi, bi;
+
+	if (mtx->sz_rows != 3 || mtx->sz_cols != 3) {
+		return -EINVAL;
+	}
+	if (lut != NULL && lut_sz < 2) {
+		return -EINVAL;
+	}
+
+	memcpy(m, mtx->data, sizeof(m));
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t x = xyz[i].xyz_x;
+		zsl_real_t y = xyz[i].xyz_y;
+		zsl_real_t z = xyz[i].xyz_z;
+		zsl_real_t r, g, b;
+
+		r = zsl_clr_conv_rgbf_gamut(m[0] * x + m[1] * y + m[2] * z,
+					    &ri);
+		g = zsl_clr_conv_rgbf_gamut(m[3] * x + m[4] * y + m[5] * z,
+					    &gi);
+		b = zsl_clr_conv_rgbf_gamut(m[6] * x + m[7] * y + m[8] * z,
+					    &bi);
+
+		rgb[i].r = zsl_clr_conv_rgb8_chan(r, lut, lut_sz);
+		rgb[i].g = zsl_clr_conv_rgb8_chan(g, lut, lut_sz);
+		rgb[i].b = zsl_clr_conv_rgb8_chan(b, lut, lut_sz);
+		rgb[i].a = 0xFF;
+		rgb[i].r_invalid = ri;
+		rgb[i].g_invalid = gi;
+		rgb[i].b_invalid = bi;
+		rgb[i].a_invalid = 0;
+	}
+
+	return 0;
+}
+
+int
+zsl_clr_conv_xyz_rgbf_planar(const struct zsl_mtx *mtx,
+			     const struct zsl_mtx *xyz,
+			     struct zsl_mtx *rgb)
+{
+	size_t n = xyz->sz_cols;
+	const zsl_real_t *xp = xyz->data;
+	const zsl_real_t *yp = xyz->data + n;
+	const zsl_real_t *zp = xyz->data + 2 * n;
+	zsl_real_t *rp = rgb->data;
+	zsl_real_t *gp = rgb->data + n;
+	zsl_real_t *bp = rgb->data + 2 * n;
+	zsl_real_t m[9];
+
+	if (mtx->sz_rows != 3 || mtx->sz_cols != 3 || xyz->sz_rows != 3 ||
+	    rgb->sz_rows != 3 || rgb->sz_cols != n) {
+		return -EINVAL;
+	}
+
+	memcpy(m, mtx->data, sizeof(m));
+
+	/* One pass per output plane keeps every loop a unit-stride
+	 * multiply-add over three inputs, which the compiler can vectorise. */
+	for (size_t i = 0; i < n; i++) {
+		rp[i] = m[0] * xp[i] + m[1] * yp[i] + m[2] * zp[i];
+	}
+	for (size_t i = 0; i < n; i++) {
+		gp[i] = m[3] * xp[i] + m[4] * yp[i] + m[5] * zp[i];
+	}
+	for (size_t i = 0; i < n; i++) {
+		bp[i] = m[6] * xp[i] + m[7] * yp[i] + m[8] * zp[i];
+	}
+
+	#if CONFIG_ZSL_CLR_RGBF_BOUND_CAP
+	for (size_t i = 0; i < 3 * n; i++) {
+		zsl_real_t v = rgb->data[i];
+
+		v = (v < 0.0) ? 0.0 : v;
+		rgb->data[i] = (v > 1.0) ? 1.0 : v;
+	}
+	#endif
+
+	return 0;
+}
+
+int
+zsl_clr_conv_xyz_rgb888(const struct zsl_mtx *mtx,
+			const struct zsl_mtx *xyz, uint8_t *rgb,
+			const uint8_t *lut, size_t lut_sz)
+{
+	size_t n = xyz->sz_cols;
+	const zsl_real_t *xp = xyz->data;
+	const zsl_real_t *yp = xyz->data + n;
+	const zsl_real_t *zp = xyz->data + 2 * n;
+	zsl_real_t m[9];
+
+	if (mtx->sz_rows != 3 || mtx->sz_cols != 3 || xyz->sz_rows != 3) {
+		return -EINVAL;
+	}
+	if (lut != NULL && lut_sz < 2) {
+		return -EINVAL;
+	}
+
+	memcpy(m, mtx->data, sizeof(m));
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t x = xp[i];
+		zsl_real_t y = yp[i];
+		zsl_real_t z = zp[i];
+
+		rgb[3 * i] = zsl_clr_conv_rgb8_chan(
+			m[0] * x + m[1] * y + m[2] * z, lut, lut_sz);
+		rgb[3 * i + 1] = zsl_clr_conv_rgb8_chan(
+			m[3] * x + m[4] * y + m[5] * z, lut, lut_sz);
+		rgb[3 * i + 2] = zsl_clr_conv_rgb8_chan(
+			m[6] * x + m[7] * y + m[8] * z, lut, lut_sz);
+	}
+
+	return 0;
+}
+
+/* The sRGB transfer function, IEC 61966-2-1. */
+static zsl_real_t
+zsl_clr_conv_srgb_enc(zsl_real_t v)
+{
+	v = zsl_clr_conv_unit(v);
+	if (v <= 0.0031308) {
+		return 12.92 * v;
+	}
+
+	return 1.055 * ZSL_POW(v, 1.0 / 2.4) - 0.055;
+}
+
+/* The inverse sRGB transfer function, IEC 61966-2-1. */
+static zsl_real_t
+zsl_clr_conv_srgb_dec(zsl_real_t v)
+{
+	v = zsl_clr_conv_unit(v);
+	if (v <= 0.04045) {
+		return v / 12.92;
+	}
+
+	return ZSL_POW((v + 0.055) / 1.055, 2.4);
+}
+
+int
+zsl_clr_conv_rgbf_srgbf(const struct zsl_clr_rgbf *rgb,
+			struct zsl_clr_rgbf *srgb, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		srgb[i] = rgb[i];
+		srgb[i].r = zsl_clr_conv_srgb_enc(rgb[i].r);
+		srgb[i].g = zsl_clr_conv_srgb_enc(rgb[i].g);
+		srgb[i].b = zsl_clr_conv_srgb_enc(rgb[i].b);
+	}
+
+	return 0;
+}
+
+int
+zsl_clr_conv_srgbf_rgbf(const struct zsl_clr_rgbf *srgb,
+			struct zsl_clr_rgbf *rgb, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		rgb[i] = srgb[i];
+		rgb[i].r = zsl_clr_conv_srgb_dec(srgb[i].r);
+		rgb[i].g = zsl_clr_conv_srgb_dec(srgb[i].g);
+		rgb[i].b = zsl_clr_conv_srgb_dec(srgb[i].b);
+	}
+
+	return 0;
+}
+
+int
+zsl_clr_conv_rgbf_srgb8(const struct zsl_clr_rgbf *rgb,
+			struct zsl_clr_rgb8 *srgb, size_t n, bool fast)
+{
+	const uint8_t *enc = NULL;
+	const zsl_real_t *dec;
+
+	if (fast) {
+		zsl_clr_srgb_lut_get(&enc, &dec);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		if (enc != NULL) {
+			srgb[i].r = zsl_clr_conv_rgb8_chan(rgb[i].r, enc,
+						ZSL_CLR_SRGB_ENC_LUT_SZ);
+			srgb[i].g = zsl_clr_conv_rgb8_chan(rgb[i].g, enc,
+						ZSL_CLR_SRGB_ENC_LUT_SZ);
+			srgb[i].b = zsl_clr_conv_rgb8_chan(rgb[i].b, enc,
+						ZSL_CLR_SRGB_ENC_LUT_SZ);
+		} else {
+			srgb[i].r = (uint8_t)(zsl_clr_conv_srgb_enc(rgb[i].r) *
+					      255.0 + 0.5);
+			srgb[i].g = (uint8_t)(zsl_clr_conv_srgb_enc(rgb[i].g) *
+					      255.0 + 0.5);
+			srgb[i].b = (uint8_t)(zsl_clr_conv_srgb_enc(rgb[i].b) *
+					      255.0 + 0.5);
+		}
+		srgb[i].a = (uint8_t)(zsl_clr_conv_unit(rgb[i].a) * 255.0 + 0.5);
+		srgb[i].r_invalid = rgb[i].r_invalid;
+		srgb[i].g_invalid = rgb[i].g_invalid;
+		srgb[i].b_invalid = rgb[i].b_invalid;
+		srgb[i].a_invalid = rgb[i].a_invalid;
+	}
+
+	return 0;
+}
+
+int
+zsl_clr_conv_srgb8_rgbf(const struct zsl_clr_rgb8 *srgb,
+			struct zsl_clr_rgbf *rgb, size_t n, bool fast)
+{
+	const uint8_t *enc;
+	const zsl_real_t *dec = NULL;
+
+	if (fast) {
+		zsl_clr_srgb_lut_get(&enc, &dec);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		if (dec != NULL) {
+			rgb[i].r = dec[srgb[i].r];
+			rgb[i].g = dec[srgb[i].g];
+			rgb[i].b = dec[srgb[i].b];
+		} else {
+			rgb[i].r = zsl_clr_conv_srgb_dec(srgb[i].r / 255.0);
+			rgb[i].g = zsl_clr_conv_srgb_dec(srgb[i].g / 255.0);
+			rgb[i].b = zsl_clr_conv_srgb_dec(srgb[i].b / 255.0);
+		}
+		rgb[i].a = srgb[i].a / 255.0;
+		rgb[i].r_invalid = srgb[i].r_invalid;
+		rgb[i].g_invalid = srgb[i].g_invalid;
+		rgb[i].b_invalid = srgb[i].b_invalid;
+		rgb[i].a_invalid = srgb[i].a_invalid;
+	}
+
+	return 0;
+}
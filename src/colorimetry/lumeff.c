@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
 #include <zsl/colorimetry.h>
 
 /**
@@ -246,3 +247,78 @@ zsl_clr_lef_lerp(enum zsl_clr_lef lef, unsigned int nm, zsl_real_t *val)
 
 	return 0;
 }
+
+int
+zsl_clr_lef_weights_compile(struct zsl_clr_lef_weights *lw,
+			    enum zsl_clr_lef lef, const unsigned int *nm)
+{
+	const struct zsl_clr_spd *lef_data;
+	size_t n = lw->w.sz;
+	size_t j;
+	unsigned int lo, hi;
+	zsl_real_t v;
+	bool same = lw->valid && lw->lef == lef;
+
+	for (size_t i = 0; i < n; i++) {
+		if (i && nm[i] <= nm[i - 1]) {
+			lw->valid = false;
+			return -EINVAL;
+		}
+		same = same && lw->nm[i] == nm[i];
+	}
+
+	/* Keep the weights if they are already the requested ones. */
+	if (same) {
+		return 0;
+	}
+
+	/* Get a reference to the LEF data. */
+	zsl_clr_lef_get(lef, &lef_data);
+
+	/* Walk the table alongside the ascending sample wavelengths. */
+	j = 0;
+	for (size_t i = 0; i < n; i++) {
+		lw->nm[i] = nm[i];
+
+		while (j < lef_data->size && lef_data->comps[j].nm < nm[i]) {
+			j++;
+		}
+
+		if (j == lef_data->size || (j == 0 &&
+					    lef_data->comps[0].nm > nm[i])) {
+			/* Outside the table. */
+			v = 0.0;
+		} else if (lef_data->comps[j].nm == nm[i]) {
+			v = lef_data->comps[j].value;
+		} else {
+			v = lef_data->comps[j - 1].value +
+			    (lef_data->comps[j].value -
+			     lef_data->comps[j - 1].value) *
+			    (zsl_real_t)(nm[i] - lef_data->comps[j - 1].nm) /
+			    (zsl_real_t)(lef_data->comps[j].nm -
+					 lef_data->comps[j - 1].nm);
+		}
+
+		/* Trapezoidal width of this sample. */
+		lo = i ? nm[i - 1] : nm[i];
+		hi = i < n - 1 ? nm[i + 1] : nm[i];
+		lw->w.data[i] = v * (zsl_real_t)(hi - lo) / 2.0;
+	}
+
+	lw->lef = lef;
+	lw->valid = true;
+
+	return 0;
+}
+
+int
+zsl_clr_lef_integ(const struct zsl_clr_lef_weights *lw,
+		  const struct zsl_vec *values, zsl_real_t *integ)
+{
+	if (!lw->valid || values->sz != lw->w.sz) {
+		*integ = 0.0;
+		return -EINVAL;
+	}
+
+	return zsl_vec_dot(&lw->w, values, integ);
+}
@@ -30,3 +30,22 @@ int zsl_clr_norm_spd(struct zsl_clr_spd *spd)
 
 	return 0;
 }
+
+int zsl_clr_norm_spd_soa(struct zsl_clr_spd_soa *spd)
+{
+	zsl_real_t max = 0.0;
+	const zsl_real_t *v = spd->values.data;
+
+	/* Determine the max value, reading the values contiguously. */
+	for (size_t i = 0; i < spd->values.sz; i++) {
+		max = v[i] > max ? v[i] : max;
+	}
+
+	/* Avoid divide by zero. */
+	if (max == 0.0) {
+		return -EINVAL;
+	}
+
+	/* Scale values by max. */
+	return zsl_vec_scalar_div(&spd->values, max);
+}
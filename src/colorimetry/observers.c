@@ -123,6 +123,7 @@ static const struct zsl_clr_obs_data zsl_clr_obs_2_deg_data = {
 	}
 };
 
+#if CONFIG_ZSL_CLR_OBS_10_DEG
 /**
  * CIE 1964 10 degree supplementary standard observer color matching functions
  * from 380 nm to 830 nm in 5nm steps.
@@ -228,16 +229,28 @@ static const struct zsl_clr_obs_data zsl_clr_obs_10_deg_data = {
 		{ 0.000001553140, 0.000000629700, 0.000000000000 }      /* 830 nm */
 		}
 	};
+#endif /* CONFIG_ZSL_CLR_OBS_10_DEG */
 
-	void
-	zsl_clr_obs_get(enum zsl_clr_obs obs, const struct zsl_clr_obs_data **data)
-	{
-		switch (obs) {
-		case ZSL_CLR_OBS_10_DEG:
-			*data = &zsl_clr_obs_10_deg_data;
-			break;
-		case ZSL_CLR_OBS_2_DEG:
-			*data = &zsl_clr_obs_2_deg_data;
-			break;
-		}
+/**
+ * @brief The compiled-in observer data, indexed by zsl_clr_obs.
+ */
+static const struct zsl_clr_obs_data *const zsl_clr_obs_list[] = {
+	[ZSL_CLR_OBS_2_DEG] = &zsl_clr_obs_2_deg_data,
+#if CONFIG_ZSL_CLR_OBS_10_DEG
+	[ZSL_CLR_OBS_10_DEG] = &zsl_clr_obs_10_deg_data,
+#else
+	[ZSL_CLR_OBS_10_DEG] = NULL,
+#endif
+};
+
+void
+zsl_clr_obs_get(enum zsl_clr_obs obs, const struct zsl_clr_obs_data **data)
+{
+	if ((size_t)obs >= sizeof(zsl_clr_obs_list) /
+	    sizeof(zsl_clr_obs_list[0])) {
+		*data = NULL;
+		return;
 	}
+
+	*data = zsl_clr_obs_list[obs];
+}
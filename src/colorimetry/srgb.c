@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/colorimetry.h>
+
+#if CONFIG_ZSL_CLR_SRGB_LUT
+
+/**
+ * @brief sRGB encoded 8-bit values of linear 0.0..1.0 inputs, with entry
+ *        'i' holding the rounded encoding of i / 4095, kept in flash.
+ */
+static const uint8_t zsl_clr_srgb_enc_lut[ZSL_CLR_SRGB_ENC_LUT_SZ] = {
+	  0,   1,   2,   2,   3,   4,   5,   6,   6,   7,   8,   9,
+	 10,  10,  11,  12,  13,  13,  14,  15,  15,  16,  16,  17,
+	 18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  23,
+	 23,  24,  24,  25,  25,  25,  26,  26,  27,  27,  27,  28,
+	 28,  29,  29,  29,  30,  30,  30,  31,  31,  31,  32,  32,
+	 32,  33,  33,  33,  34,  34,  34,  34,  35,  35,  35,  36,
+	 36,  36,  37,  37,  37,  37,  38,  38,  38,  38,  39,  39,
+	 39,  40,  40,  40,  40,  41,  41,  41,  41,  42,  42,  42,
+	 42,  43,  43,  43,  43,  43,  44,  44,  44,  44,  45,  45,
+	 45,  45,  46,  46,  46,  46,  46,  47,  47,  47,  47,  48,
+	 48,  48,  48,  48,  49,  49,  49,  49,  49,  50,  50,  50,
+	 50,  50,  51,  51,  51,  51,  51,  52,  52,  52,  52,  52,
+	 53,  53,  53,  53,  53,  54,  54,  54,  54,  54,  55,  55,
+	 55,  55,  55,  55,  56,  56,  56,  56,  56,  57,  57,  57,
+	 57,  57,  57,  58,  58,  58,  58,  58,  58,  59,  59,  59,
+	 59,  59,  59,  60,  60,  60,  60,  60,  60,  61,  61,  61,
+	 61,  61,  61,  62,  62,  62,  62,  62,  62,  63,  63,  63,
+	 63,  63,  63,  64,  64,  64,  64,  64,  64,  64,  65,  65,
+	 65,  65,  65,  65,  66,  66,  66,  66,  66,  66,  66,  67,
+	 67,  67,  67,  67,  67,  67,  68,  68,  68,  68,  68,  68,
+	 68,  69,  69,  69,  69,  69,  69,  69,  70,  70,  70,  70,
+	 70,  70,  70,  71,  71,  71,  71,  71,  71,  71,  72,  72,
+	 72,  72,  72,  72,  72,  72,  73,  73,  73,  73,  73,  73,
+	 73,  74,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,
+	 75,  75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,
+	 77,  77,  77,  77,  77,  77,  77,  77,  78,  78,  78,  78,
+	 78,  78,  78,  78,  78,  79,  79,  79,  79,  79,  79,  79,
+	 79,  80,  80,  80,  80,  80,  80,  80,  80,  81,  81,  81,
+	 81,  81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,
+	 82,  82,  83,  83,  83,  83,  83,  83,  83,  83,  83,  84,
+	 84,  84,  84,  84,  84,  84,  84,  84,  85,  85,  85,  85,
+	 85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,  86,
+	 86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  87,  88,
+	 88,  88,  88,  88,  88,  88,  88,  88,  88,  89,  89,  89,
+	 89,  89,  89,  89,  89,  89,  90,  90,  90,  90,  90,  90,
+	 90,  90,  90,  90,  91,  91,  91,  91,  91,  91,  91,  91,
+	 91,  91,  92,  92,  92,  92,  92,  92,  92,  92,  92,  92,
+	 93,  93,  93,  93,  93,  93,  93,  93,  93,  93,  94,  94,
+	 94,  94,  94,  94,  94,  94,  94,  94,  95,  95,  95,  95,
+	 95,  95,  95,  95,  95,  95,  96,  96,  96,  96,  96,  96,
+	 96,  96,  96,  96,  96,  97,  97,  97,  97,  97,  97,  97,
+	 97,  97,  97,  98,  98,  98,  98,  98,  98,  98,  98,  98,
+	 98,  98,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,
+	 99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+	101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 102,
+	102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 103, 103,
+	103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 104, 104,
+	104, 104, 104, 104, 104, 104, 104, 104, 104, 105, 105, 105,
+	105, 105, 105, 105, 105, 105, 105, 105, 105, 106, 106, 106,
+	106, 106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107,
+	107, 107, 107, 107, 107, 107, 107, 107, 107, 108, 108, 108,
+	108, 108, 108, 108, 108, 108, 108, 108, 108, 109, 109, 109,
+	109, 109, 109, 109, 109, 109, 109, 109, 109, 110, 110, 110,
+	110, 110, 110, 110, 110, 110, 110, 110, 110, 111, 111, 111,
+	111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 112, 112,
+	112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 113, 113,
+	113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 114,
+	114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114,
+	115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115,
+	115, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116,
+	116, 116, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117,
+	117, 117, 117, 117, 118, 118, 118, 118, 118, 118, 118, 118,
+	118, 118, 118, 118, 118, 119, 119, 119, 119, 119, 119, 119,
+	119, 119, 119, 119, 119, 119, 119, 120, 120, 120, 120, 120,
+	120, 120, 120, 120, 120, 120, 120, 120, 120, 121, 121, 121,
+	121, 121, 121, 121, 121, 121, 121, 121, 121, 121, 122, 122,
+	122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122,
+	122, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,
+	123, 123, 123, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+	124, 124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125,
+	125, 125, 125, 125, 125, 125, 125, 125, 126, 126, 126, 126,
+	126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 127, 127,
+	127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+	127, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+	128, 128, 128, 128, 129, 129, 129, 129, 129, 129, 129, 129,
+	129, 129, 129, 129, 129, 129, 129, 130, 130, 130, 130, 130,
+	130, 130, 130, 130, 130, 130, 130, 130, 130, 130, 131, 131,
+	131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131,
+	131, 131, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+	132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133,
+	133, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134,
+	134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134,
+	134, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135,
+	135, 135, 135, 135, 135, 136, 136, 136, 136, 136, 136, 136,
+	136, 136, 136, 136, 136, 136, 136, 136, 136, 137, 137, 137,
+	137, 137, 137, 137, 137, 137, 137, 137, 137, 137, 137, 137,
+	137, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+	138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
+	139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 140, 140,
+	140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140,
+	140, 140, 140, 141, 141, 141, 141, 141, 141, 141, 141, 141,
+	141, 141, 141, 141, 141, 141, 141, 141, 142, 142, 142, 142,
+	142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142,
+	142, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143,
+	143, 143, 143, 143, 143, 143, 144, 144, 144, 144, 144, 144,
+	144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 145,
+	145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145,
+	145, 145, 145, 145, 145, 146, 146, 146, 146, 146, 146, 146,
+	146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 147, 147,
+	147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147,
+	147, 147, 147, 147, 148, 148, 148, 148, 148, 148, 148, 148,
+	148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 149, 149,
+	149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
+	149, 149, 149, 149, 150, 150, 150, 150, 150, 150, 150, 150,
+	150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 151,
+	151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151,
+	151, 151, 151, 151, 151, 152, 152, 152, 152, 152, 152, 152,
+	152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152,
+	153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+	153, 153, 153, 153, 153, 153, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 156, 156, 156, 156,
+	156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+	156, 156, 156, 156, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 158,
+	158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158,
+	158, 158, 158, 158, 158, 158, 159, 159, 159, 159, 159, 159,
+	159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159,
+	159, 159, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160,
+	160, 160, 160, 160, 160, 160, 160, 160, 160, 160, 161, 161,
+	161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161,
+	161, 161, 161, 161, 161, 161, 162, 162, 162, 162, 162, 162,
+	162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+	162, 162, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163,
+	163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 164, 164,
+	164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164,
+	164, 164, 164, 164, 164, 164, 164, 165, 165, 165, 165, 165,
+	165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165,
+	165, 165, 165, 165, 166, 166, 166, 166, 166, 166, 166, 166,
+	166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166,
+	167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167,
+	167, 167, 167, 167, 167, 167, 167, 167, 167, 168, 168, 168,
+	168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+	168, 168, 168, 168, 168, 168, 168, 169, 169, 169, 169, 169,
+	169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169,
+	169, 169, 169, 169, 170, 170, 170, 170, 170, 170, 170, 170,
+	170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	170, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171,
+	171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 172,
+	172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172,
+	172, 172, 172, 172, 172, 172, 172, 172, 172, 173, 173, 173,
+	173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+	173, 173, 173, 173, 173, 173, 173, 174, 174, 174, 174, 174,
+	174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
+	174, 174, 174, 174, 174, 175, 175, 175, 175, 175, 175, 175,
+	175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175,
+	175, 175, 175, 176, 176, 176, 176, 176, 176, 176, 176, 176,
+	176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
+	176, 176, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177,
+	177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177,
+	178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+	178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 179,
+	179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+	179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 180, 180,
+	180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+	180, 180, 180, 180, 180, 180, 180, 180, 180, 181, 181, 181,
+	181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181,
+	181, 181, 181, 181, 181, 181, 181, 181, 182, 182, 182, 182,
+	182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+	182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183,
+	183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183,
+	183, 183, 183, 183, 183, 183, 183, 184, 184, 184, 184, 184,
+	184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+	184, 184, 184, 184, 184, 184, 184, 185, 185, 185, 185, 185,
+	185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185,
+	185, 185, 185, 185, 185, 185, 185, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 188, 188, 188, 188,
+	188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188,
+	188, 188, 188, 188, 188, 188, 188, 188, 189, 189, 189, 189,
+	189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189,
+	189, 189, 189, 189, 189, 189, 189, 189, 189, 190, 190, 190,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 192, 192,
+	192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+	192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+	193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193,
+	193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193,
+	193, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194,
+	194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194,
+	194, 194, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195,
+	195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195,
+	195, 195, 195, 195, 196, 196, 196, 196, 196, 196, 196, 196,
+	196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196,
+	196, 196, 196, 196, 196, 196, 197, 197, 197, 197, 197, 197,
+	197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197,
+	197, 197, 197, 197, 197, 197, 197, 197, 198, 198, 198, 198,
+	198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198,
+	198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 199, 199,
+	199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+	199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+	200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200,
+	200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200,
+	200, 200, 200, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 202, 202, 202, 202, 202, 202,
+	202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+	202, 202, 202, 202, 202, 202, 202, 202, 202, 203, 203, 203,
+	203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203,
+	203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+	205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+	205, 205, 205, 205, 205, 205, 206, 206, 206, 206, 206, 206,
+	206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206,
+	206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 207, 207,
+	207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+	207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+	207, 207, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208,
+	208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208,
+	208, 208, 208, 208, 208, 209, 209, 209, 209, 209, 209, 209,
+	209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+	209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 210, 210,
+	210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+	210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+	210, 210, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211,
+	211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211,
+	211, 211, 211, 211, 211, 211, 212, 212, 212, 212, 212, 212,
+	212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212,
+	212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 213,
+	213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+	213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+	213, 213, 213, 213, 214, 214, 214, 214, 214, 214, 214, 214,
+	214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+	214, 214, 214, 214, 214, 214, 214, 214, 214, 215, 215, 215,
+	215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215,
+	215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215,
+	215, 215, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216,
+	216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216,
+	216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217,
+	217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217,
+	217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217,
+	217, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218,
+	218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218,
+	218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219,
+	219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+	219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+	220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+	220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+	220, 220, 220, 220, 220, 220, 221, 221, 221, 221, 221, 221,
+	221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+	221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+	221, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222,
+	222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222,
+	222, 222, 222, 222, 222, 222, 222, 223, 223, 223, 223, 223,
+	223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223,
+	223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223,
+	223, 223, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224,
+	224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224,
+	224, 224, 224, 224, 224, 224, 224, 224, 225, 225, 225, 225,
+	225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225,
+	225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225,
+	225, 225, 225, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+	226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+	226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 227, 227,
+	227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+	227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+	227, 227, 227, 227, 227, 227, 228, 228, 228, 228, 228, 228,
+	228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228,
+	228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228,
+	228, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229,
+	229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229,
+	229, 229, 229, 229, 229, 229, 229, 229, 229, 230, 230, 230,
+	230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+	230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+	230, 230, 230, 230, 230, 231, 231, 231, 231, 231, 231, 231,
+	231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231,
+	231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231,
+	231, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+	232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+	232, 232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233,
+	233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+	233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+	233, 233, 233, 233, 233, 233, 234, 234, 234, 234, 234, 234,
+	234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+	234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+	234, 234, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 236,
+	236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236,
+	236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236,
+	236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237,
+	237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237,
+	237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237,
+	237, 237, 237, 237, 237, 238, 238, 238, 238, 238, 238, 238,
+	238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+	238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+	238, 238, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+	239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+	239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+	240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 241, 241,
+	241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+	241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+	241, 241, 241, 241, 241, 241, 241, 241, 242, 242, 242, 242,
+	242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+	242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+	242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243,
+	243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+	243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+	243, 243, 243, 243, 244, 244, 244, 244, 244, 244, 244, 244,
+	244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+	244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+	244, 244, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+	245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+	245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+	245, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+	247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+	247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 248,
+	248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+	248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+	248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 249, 249,
+	249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+	249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+	249, 249, 249, 249, 249, 249, 249, 249, 249, 250, 250, 250,
+	250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250,
+	250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250,
+	250, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251,
+	251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+	251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+	251, 251, 251, 251, 251, 251, 251, 251, 251, 252, 252, 252,
+	252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+	252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+	252, 252, 252, 252, 252, 252, 252, 252, 252, 253, 253, 253,
+	253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+	253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+	253, 253, 253, 253, 253, 253, 253, 253, 253, 254, 254, 254,
+	254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+	254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+	254, 254, 254, 254, 254, 254, 254, 254, 254, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255,
+};
+
+/**
+ * @brief Linear 0.0..1.0 values of sRGB encoded 8-bit inputs, with entry
+ *        'i' holding the decoding of i / 255, kept in flash.
+ */
+static const zsl_real_t zsl_clr_srgb_dec_lut[ZSL_CLR_SRGB_DEC_LUT_SZ] = {
+	0.000000000e+00, 3.035269835e-04, 6.070539671e-04, 9.105809506e-04,
+	1.214107934e-03, 1.517634918e-03, 1.821161901e-03, 2.124688885e-03,
+	2.428215868e-03, 2.731742852e-03, 3.035269835e-03, 3.346535764e-03,
+	3.676507324e-03, 4.024717018e-03, 4.391442037e-03, 4.776953481e-03,
+	5.181516702e-03, 5.605391624e-03, 6.048833023e-03, 6.512090793e-03,
+	6.995410187e-03, 7.499032043e-03, 8.023192985e-03, 8.568125618e-03,
+	9.134058702e-03, 9.721217320e-03, 1.032982303e-02, 1.096009401e-02,
+	1.161224518e-02, 1.228648836e-02, 1.298303234e-02, 1.370208305e-02,
+	1.444384360e-02, 1.520851442e-02, 1.599629337e-02, 1.680737575e-02,
+	1.764195449e-02, 1.850022013e-02, 1.938236096e-02, 2.028856306e-02,
+	2.121901038e-02, 2.217388479e-02, 2.315336618e-02, 2.415763245e-02,
+	2.518685963e-02, 2.624122189e-02, 2.732089164e-02, 2.842603950e-02,
+	2.955683444e-02, 3.071344373e-02, 3.189603307e-02, 3.310476657e-02,
+	3.433980681e-02, 3.560131488e-02, 3.688945040e-02, 3.820437160e-02,
+	3.954623528e-02, 4.091519691e-02, 4.231141062e-02, 4.373502926e-02,
+	4.518620439e-02, 4.666508634e-02, 4.817182423e-02, 4.970656598e-02,
+	5.126945837e-02, 5.286064702e-02, 5.448027644e-02, 5.612849005e-02,
+	5.780543019e-02, 5.951123816e-02, 6.124605423e-02, 6.301001765e-02,
+	6.480326669e-02, 6.662593864e-02, 6.847816984e-02, 7.036009570e-02,
+	7.227185068e-02, 7.421356838e-02, 7.618538148e-02, 7.818742181e-02,
+	8.021982031e-02, 8.228270713e-02, 8.437621154e-02, 8.650046204e-02,
+	8.865558629e-02, 9.084171118e-02, 9.305896285e-02, 9.530746663e-02,
+	9.758734714e-02, 9.989872825e-02, 1.022417331e-01, 1.046164841e-01,
+	1.070231030e-01, 1.094617108e-01, 1.119324278e-01, 1.144353738e-01,
+	1.169706678e-01, 1.195384280e-01, 1.221387722e-01, 1.247718176e-01,
+	1.274376804e-01, 1.301364767e-01, 1.328683216e-01, 1.356333297e-01,
+	1.384316150e-01, 1.412632911e-01, 1.441284709e-01, 1.470272665e-01,
+	1.499597898e-01, 1.529261520e-01, 1.559264637e-01, 1.589608351e-01,
+	1.620293756e-01, 1.651321945e-01, 1.682694002e-01, 1.714411007e-01,
+	1.746474037e-01, 1.778884160e-01, 1.811642442e-01, 1.844749945e-01,
+	1.878207723e-01, 1.912016827e-01, 1.946178304e-01, 1.980693196e-01,
+	2.015562538e-01, 2.050787364e-01, 2.086368701e-01, 2.122307574e-01,
+	2.158605001e-01, 2.195261997e-01, 2.232279573e-01, 2.269658735e-01,
+	2.307400485e-01, 2.345505822e-01, 2.383975738e-01, 2.422811225e-01,
+	2.462013267e-01, 2.501582847e-01, 2.541520943e-01, 2.581828529e-01,
+	2.622506575e-01, 2.663556048e-01, 2.704977910e-01, 2.746773121e-01,
+	2.788942635e-01, 2.831487404e-01, 2.874408377e-01, 2.917706498e-01,
+	2.961382708e-01, 3.005437944e-01, 3.049873141e-01, 3.094689228e-01,
+	3.139887134e-01, 3.185467781e-01, 3.231432091e-01, 3.277780981e-01,
+	3.324515363e-01, 3.371636150e-01, 3.419144249e-01, 3.467040564e-01,
+	3.515325995e-01, 3.564001441e-01, 3.613067798e-01, 3.662525956e-01,
+	3.712376805e-01, 3.762621230e-01, 3.813260114e-01, 3.864294338e-01,
+	3.915724777e-01, 3.967552307e-01, 4.019777798e-01, 4.072402119e-01,
+	4.125426135e-01, 4.178850708e-01, 4.232676700e-01, 4.286904966e-01,
+	4.341536362e-01, 4.396571738e-01, 4.452011945e-01, 4.507857828e-01,
+	4.564110232e-01, 4.620769997e-01, 4.677837961e-01, 4.735314961e-01,
+	4.793201831e-01, 4.851499401e-01, 4.910208498e-01, 4.969329951e-01,
+	5.028864580e-01, 5.088813209e-01, 5.149176654e-01, 5.209955732e-01,
+	5.271151257e-01, 5.332764040e-01, 5.394794890e-01, 5.457244614e-01,
+	5.520114015e-01, 5.583403896e-01, 5.647115057e-01, 5.711248295e-01,
+	5.775804404e-01, 5.840784179e-01, 5.906188409e-01, 5.972017884e-01,
+	6.038273389e-01, 6.104955708e-01, 6.172065624e-01, 6.239603917e-01,
+	6.307571363e-01, 6.375968740e-01, 6.444796820e-01, 6.514056374e-01,
+	6.583748173e-01, 6.653872983e-01, 6.724431570e-01, 6.795424696e-01,
+	6.866853124e-01, 6.938717613e-01, 7.011018919e-01, 7.083757799e-01,
+	7.156935005e-01, 7.230551289e-01, 7.304607401e-01, 7.379104088e-01,
+	7.454042095e-01, 7.529422168e-01, 7.605245047e-01, 7.681511472e-01,
+	7.758222183e-01, 7.835377915e-01, 7.912979403e-01, 7.991027380e-01,
+	8.069522577e-01, 8.148465722e-01, 8.227857544e-01, 8.307698768e-01,
+	8.387990117e-01, 8.468732315e-01, 8.549926081e-01, 8.631572135e-01,
+	8.713671192e-01, 8.796223969e-01, 8.879231179e-01, 8.962693534e-01,
+	9.046611744e-01, 9.130986518e-01, 9.215818563e-01, 9.301108584e-01,
+	9.386857285e-01, 9.473065367e-01, 9.559733532e-01, 9.646862479e-01,
+	9.734452904e-01, 9.822505503e-01, 9.911020971e-01, 1.000000000e+00,
+};
+
+int
+zsl_clr_srgb_lut_get(const uint8_t **enc, const zsl_real_t **dec)
+{
+	*enc = zsl_clr_srgb_enc_lut;
+	*dec = zsl_clr_srgb_dec_lut;
+
+	return 0;
+}
+
+#else
+
+int
+zsl_clr_srgb_lut_get(const uint8_t **enc, const zsl_real_t **dec)
+{
+	*enc = NULL;
+	*dec = NULL;
+
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_ZSL_CLR_SRGB_LUT */
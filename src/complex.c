@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/complex.h>
+#include <zsl/workspace.h>
+
+struct zsl_cplx
+zsl_cplx_div(struct zsl_cplx a, struct zsl_cplx b)
+{
+	zsl_real_t r, d;
+
+	if (b.re == 0.0 && b.im == 0.0) {
+		return (struct zsl_cplx){ NAN, NAN };
+	}
+
+	/* Divide through by the larger part of 'b', so that |r| <= 1. */
+	if (ZSL_ABS(b.re) >= ZSL_ABS(b.im)) {
+		r = b.im / b.re;
+		d = b.re + b.im * r;
+		return (struct zsl_cplx){ (a.re + a.im * r) / d,
+					  (a.im - a.re * r) / d };
+	}
+
+	r = b.re / b.im;
+	d = b.re * r + b.im;
+	return (struct zsl_cplx){ (a.re * r + a.im) / d,
+				  (a.im * r - a.re) / d };
+}
+
+zsl_real_t
+zsl_cplx_abs(struct zsl_cplx a)
+{
+	zsl_real_t x = ZSL_ABS(a.re);
+	zsl_real_t y = ZSL_ABS(a.im);
+	zsl_real_t big = ZSL_MAX(x, y);
+	zsl_real_t r;
+
+	if (big == 0.0) {
+		return 0.0;
+	}
+
+	r = (x < y ? x : y) / big;
+	return big * ZSL_SQRT(1.0 + r * r);
+}
+
+zsl_real_t
+zsl_cplx_arg(struct zsl_cplx a)
+{
+	return ZSL_ATAN2(a.im, a.re);
+}
+
+struct zsl_cplx
+zsl_cplx_polar(zsl_real_t r, zsl_real_t theta)
+{
+	return (struct zsl_cplx){ r * ZSL_COS(theta), r * ZSL_SIN(theta) };
+}
+
+struct zsl_cplx
+zsl_cplx_sqrt(struct zsl_cplx a)
+{
+	zsl_real_t t;
+
+	if (a.re == 0.0 && a.im == 0.0) {
+		return (struct zsl_cplx){ 0.0, 0.0 };
+	}
+
+	/* Take the root of the larger of (|a| + |re|) / 2 and derive the other
+	 * part from it, which avoids cancellation when 'a' is near the real
+	 * axis. */
+	t = ZSL_SQRT((zsl_cplx_abs(a) + ZSL_ABS(a.re)) / 2.0);
+	if (a.re >= 0.0) {
+		return (struct zsl_cplx){ t, a.im / (2.0 * t) };
+	}
+
+	return (struct zsl_cplx){ ZSL_ABS(a.im) / (2.0 * t),
+				  a.im < 0.0 ? -t : t };
+}
+
+struct zsl_cplx
+zsl_cplx_exp(struct zsl_cplx a)
+{
+	return zsl_cplx_polar(ZSL_EXP(a.re), a.im);
+}
+
+int
+zsl_cvec_init(struct zsl_cvec *v)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->re[i] = 0.0;
+		v->im[i] = 0.0;
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_from_vec(struct zsl_cvec *v, const struct zsl_vec *re,
+		  const struct zsl_vec *im)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((re->sz != v->sz) || (im != NULL && im->sz != v->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		v->re[i] = re->data[i];
+		v->im[i] = (im == NULL) ? 0.0 : im->data[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_get(const struct zsl_cvec *v, size_t i, struct zsl_cplx *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (i >= v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	x->re = v->re[i];
+	x->im = v->im[i];
+
+	return 0;
+}
+
+int
+zsl_cvec_set(struct zsl_cvec *v, size_t i, struct zsl_cplx x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (i >= v->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	v->re[i] = x.re;
+	v->im[i] = x.im;
+
+	return 0;
+}
+
+int
+zsl_cvec_add(const struct zsl_cvec *v, const struct zsl_cvec *w,
+	     struct zsl_cvec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->re[i] = v->re[i] + w->re[i];
+	}
+	for (size_t i = 0; i < v->sz; i++) {
+		x->im[i] = v->im[i] + w->im[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_sub(const struct zsl_cvec *v, const struct zsl_cvec *w,
+	     struct zsl_cvec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->re[i] = v->re[i] - w->re[i];
+	}
+	for (size_t i = 0; i < v->sz; i++) {
+		x->im[i] = v->im[i] - w->im[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_mul(const struct zsl_cvec *v, const struct zsl_cvec *w,
+	     struct zsl_cvec *x)
+{
+	zsl_real_t re;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		re = v->re[i] * w->re[i] - v->im[i] * w->im[i];
+		x->im[i] = v->re[i] * w->im[i] + v->im[i] * w->re[i];
+		x->re[i] = re;
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_scale(struct zsl_cvec *v, struct zsl_cplx s)
+{
+	zsl_real_t re;
+
+	for (size_t i = 0; i < v->sz; i++) {
+		re = v->re[i] * s.re - v->im[i] * s.im;
+		v->im[i] = v->re[i] * s.im + v->im[i] * s.re;
+		v->re[i] = re;
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_conj(struct zsl_cvec *v)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->im[i] = -v->im[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cvec_dot(const struct zsl_cvec *v, const struct zsl_cvec *w,
+	     struct zsl_cplx *d)
+{
+	zsl_real_t re = 0.0;
+	zsl_real_t im = 0.0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	/* conj(v) * w = (vr * wr + vi * wi) + (vr * wi - vi * wr) i */
+	for (size_t i = 0; i < v->sz; i++) {
+		re += v->re[i] * w->re[i] + v->im[i] * w->im[i];
+		im += v->re[i] * w->im[i] - v->im[i] * w->re[i];
+	}
+
+	d->re = re;
+	d->im = im;
+
+	return 0;
+}
+
+zsl_real_t
+zsl_cvec_norm(const struct zsl_cvec *v)
+{
+	zsl_real_t sum = 0.0;
+
+	for (size_t i = 0; i < v->sz; i++) {
+		sum += v->re[i] * v->re[i] + v->im[i] * v->im[i];
+	}
+
+	return ZSL_SQRT(sum);
+}
+
+int
+zsl_cvec_abs(const struct zsl_cvec *v, struct zsl_vec *w)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		w->data[i] = zsl_cplx_abs((struct zsl_cplx){ v->re[i],
+							     v->im[i] });
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_init(struct zsl_cmtx *m)
+{
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		m->re[i] = 0.0;
+		m->im[i] = 0.0;
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_from_mtx(struct zsl_cmtx *m, const struct zsl_mtx *re,
+		  const struct zsl_mtx *im)
+{
+	size_t n = m->sz_rows * m->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((re->sz_rows != m->sz_rows) || (re->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+	if ((im != NULL) &&
+	    ((im->sz_rows != m->sz_rows) || (im->sz_cols != m->sz_cols))) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		m->re[i] = re->data[i];
+		m->im[i] = (im == NULL) ? 0.0 : im->data[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_get(const struct zsl_cmtx *m, size_t i, size_t j,
+	     struct zsl_cplx *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	x->re = m->re[i * m->sz_cols + j];
+	x->im = m->im[i * m->sz_cols + j];
+
+	return 0;
+}
+
+int
+zsl_cmtx_set(struct zsl_cmtx *m, size_t i, size_t j, struct zsl_cplx x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	m->re[i * m->sz_cols + j] = x.re;
+	m->im[i * m->sz_cols + j] = x.im;
+
+	return 0;
+}
+
+int
+zsl_cmtx_add(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+	     struct zsl_cmtx *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		mc->re[i] = ma->re[i] + mb->re[i];
+	}
+	for (size_t i = 0; i < n; i++) {
+		mc->im[i] = ma->im[i] + mb->im[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_sub(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+	     struct zsl_cmtx *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		mc->re[i] = ma->re[i] - mb->re[i];
+	}
+	for (size_t i = 0; i < n; i++) {
+		mc->im[i] = ma->im[i] - mb->im[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_mult(const struct zsl_cmtx *ma, const struct zsl_cmtx *mb,
+	      struct zsl_cmtx *mc)
+{
+	size_t n = mb->sz_cols;
+	zsl_real_t ar, ai;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_cols != mb->sz_rows) || (mc->sz_rows != ma->sz_rows) ||
+	    (mc->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_cmtx_init(mc);
+
+	/* Row-oriented (i, k, j) order, so the inner loop runs over
+	 * contiguous rows of 'mb' and 'mc' in each of the four part
+	 * arrays. */
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		zsl_real_t *cr = &mc->re[i * n];
+		zsl_real_t *ci = &mc->im[i * n];
+
+		for (size_t k = 0; k < ma->sz_cols; k++) {
+			const zsl_real_t *br = &mb->re[k * n];
+			const zsl_real_t *bi = &mb->im[k * n];
+
+			ar = ma->re[i * ma->sz_cols + k];
+			ai = ma->im[i * ma->sz_cols + k];
+			for (size_t j = 0; j < n; j++) {
+				cr[j] += ar * br[j] - ai * bi[j];
+				ci[j] += ar * bi[j] + ai * br[j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_mult_cvec(const struct zsl_cmtx *m, const struct zsl_cvec *v,
+		   struct zsl_cvec *w)
+{
+	size_t n = m->sz_cols;
+	zsl_real_t re, im;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != n) || (w->sz != m->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		re = 0.0;
+		im = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			re += m->re[i * n + j] * v->re[j] -
+			      m->im[i * n + j] * v->im[j];
+			im += m->re[i * n + j] * v->im[j] +
+			      m->im[i * n + j] * v->re[j];
+		}
+		w->re[i] = re;
+		w->im[i] = im;
+	}
+
+	return 0;
+}
+
+int
+zsl_cmtx_herm(const struct zsl_cmtx *ma, struct zsl_cmtx *mb)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < ma->sz_cols; j++) {
+			mb->re[j * mb->sz_cols + i] =
+				ma->re[i * ma->sz_cols + j];
+			mb->im[j * mb->sz_cols + i] =
+				-ma->im[i * ma->sz_cols + j];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_eigenvalues_cplx(const struct zsl_mtx *m, struct zsl_cvec *v,
+			 size_t iter)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	zsl_real_t a, b, c, d, disc, s;
+	struct zsl_mtx t;
+
+	if ((m->sz_cols != n) || (v->sz != n)) {
+		return -EINVAL;
+	}
+
+	ZSL_SCRATCH_DEF(ws, n * n + zsl_mtx_schur_ws_sz(n));
+	size_t mark = zsl_ws_mark(ws);
+
+	if (zsl_ws_mtx_alloc(ws, &t, n, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_mtx_schur_ws(m, &t, NULL, iter, NULL, ws);
+	if (rc) {
+		goto err;
+	}
+
+	/* The Schur iteration sets the subdiagonal below every deflated block
+	 * to exactly zero, so any non-zero entry left marks a 2x2 block. */
+	for (size_t i = 0; i < n; i++) {
+		a = t.data[i * n + i];
+		if (i + 1 == n || t.data[(i + 1) * n + i] == 0.0) {
+			v->re[i] = a;
+			v->im[i] = 0.0;
+			continue;
+		}
+
+		/* The eigenvalues of [a b; c d] are
+		 * (a + d) / 2 +/- sqrt((a - d)^2 / 4 + b * c). */
+		b = t.data[i * n + i + 1];
+		c = t.data[(i + 1) * n + i];
+		d = t.data[(i + 1) * n + i + 1];
+		disc = (a - d) * (a - d) / 4.0 + b * c;
+		s = ZSL_SQRT(ZSL_ABS(disc));
+		if (disc < 0.0) {
+			v->re[i] = v->re[i + 1] = (a + d) / 2.0;
+			v->im[i] = s;
+			v->im[i + 1] = -s;
+		} else {
+			v->re[i] = (a + d) / 2.0 + s;
+			v->re[i + 1] = (a + d) / 2.0 - s;
+			v->im[i] = v->im[i + 1] = 0.0;
+		}
+		i++;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
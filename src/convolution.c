@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/convolution.h>
+#include <zsl/fft.h>
+#include <zsl/workspace.h>
+
+/* Enable optimised host SIMD kernels if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 4)
+#include <zsl/asm/host/asm_host.h>
+#endif
+
+/* The largest padded output size for which zsl_conv may use the FFT. */
+#ifdef CONFIG_ZSL_CONV_FFT_MAX_N
+#define ZSL_CONV_FFT_MAX_N CONFIG_ZSL_CONV_FFT_MAX_N
+#else
+#define ZSL_CONV_FFT_MAX_N 1024
+#endif
+
+/*
+ * The cost of the FFT method, relative to one multiply-accumulate of the
+ * direct method, is taken as ZSL_CONV_FFT_COST * n * log2(n) for a padded
+ * size of 'n'. This covers the three real transforms and the spectrum
+ * product, with a margin for the direct method's simpler inner loop.
+ */
+#define ZSL_CONV_FFT_COST 4
+
+/* Accumulates y += s * x for the 'n' element arrays 'x' and 'y'. */
+static inline void
+zsl_conv_axpy(const zsl_real_t *x, zsl_real_t s, zsl_real_t *y, size_t n)
+{
+#if ZSL_ASM_HOST_SIMD
+	asm_host_axpy(x, s, y, n);
+#else
+	for (size_t i = 0; i < n; i++) {
+		y[i] += s * x[i];
+	}
+#endif
+}
+
+/* Returns the padded transform size for an output of 'n' samples, and its
+ * log2 in 'lg'. */
+static size_t
+zsl_conv_fft_n(size_t n, size_t *lg)
+{
+	size_t p = 2;
+
+	*lg = 1;
+	while (p < n) {
+		p <<= 1;
+		(*lg)++;
+	}
+
+	return p;
+}
+
+/* Returns true if the FFT method is expected to be faster. */
+static bool
+zsl_conv_use_fft(size_t nx, size_t nh)
+{
+	size_t lg;
+	size_t n = zsl_conv_fft_n(nx + nh - 1, &lg);
+
+	if (n > ZSL_CONV_FFT_MAX_N || n > ZSL_FFT_MAX_N) {
+		return false;
+	}
+
+	return nx * nh > ZSL_CONV_FFT_COST * n * lg;
+}
+
+/*
+ * Computes the linear convolution of 'x' and 'h' into 'y' with the FFT. If
+ * 'rev' is true, 'h' is reversed first, giving the cross-correlation.
+ */
+static int
+zsl_conv_fft_run(const struct zsl_vec *x, const struct zsl_vec *h, bool rev,
+		 struct zsl_vec *y, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t lg;
+	size_t n = zsl_conv_fft_n(y->sz, &lg);
+	zsl_real_t *a, *b;
+	zsl_real_t re;
+	struct zsl_vec va, vb;
+
+	if (n > ZSL_FFT_MAX_N) {
+		return -EINVAL;
+	}
+
+	a = zsl_ws_alloc(ws, n);
+	b = zsl_ws_alloc(ws, n);
+	if (a == NULL || b == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		a[i] = (i < x->sz) ? x->data[i] : 0.0;
+	}
+	for (size_t i = 0; i < n; i++) {
+		if (i >= h->sz) {
+			b[i] = 0.0;
+		} else {
+			b[i] = rev ? h->data[h->sz - 1 - i] : h->data[i];
+		}
+	}
+
+	va.sz = n;
+	va.data = a;
+	vb.sz = n;
+	vb.data = b;
+	zsl_fft_real(&va);
+	zsl_fft_real(&vb);
+
+	/* Multiply the packed spectra. Bins 0 and n / 2 are real. */
+	a[0] *= b[0];
+	a[1] *= b[1];
+	for (size_t k = 2; k < n; k += 2) {
+		re = a[k] * b[k] - a[k + 1] * b[k + 1];
+		a[k + 1] = a[k] * b[k + 1] + a[k + 1] * b[k];
+		a[k] = re;
+	}
+
+	zsl_ifft_real(&va);
+
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = a[i];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+/* Runs zsl_conv_fft_run with scratch memory. */
+static int
+zsl_conv_fft_scratch(const struct zsl_vec *x, const struct zsl_vec *h,
+		     bool rev, struct zsl_vec *y)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_conv_fft_ws_sz(x->sz, h->sz));
+
+	rc = zsl_conv_fft_run(x, h, rev, y, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+int
+zsl_conv(const struct zsl_vec *x, const struct zsl_vec *h,
+	 struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (h->sz == 0) || (y->sz != x->sz + h->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Fall back to the direct method if scratch memory runs out. */
+	if (zsl_conv_use_fft(x->sz, h->sz) &&
+	    zsl_conv_fft_scratch(x, h, false, y) == 0) {
+		return 0;
+	}
+
+	return zsl_conv_direct(x, h, y);
+}
+
+int
+zsl_conv_direct(const struct zsl_vec *x, const struct zsl_vec *h,
+		struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (h->sz == 0) || (y->sz != x->sz + h->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = 0.0;
+	}
+
+	for (size_t k = 0; k < x->sz; k++) {
+		zsl_conv_axpy(h->data, x->data[k], &y->data[k], h->sz);
+	}
+
+	return 0;
+}
+
+size_t
+zsl_conv_fft_ws_sz(size_t nx, size_t nh)
+{
+	size_t lg;
+
+	/* Zero-padded copies of both inputs. */
+	return 2 * zsl_conv_fft_n(nx + nh - 1, &lg);
+}
+
+int
+zsl_conv_fft_ws(const struct zsl_vec *x, const struct zsl_vec *h,
+		struct zsl_vec *y, struct zsl_workspace *ws)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (h->sz == 0) || (y->sz != x->sz + h->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_conv_fft_run(x, h, false, y, ws);
+}
+
+int
+zsl_xcorr(const struct zsl_vec *x, const struct zsl_vec *y,
+	  struct zsl_vec *r)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (y->sz == 0) || (r->sz != x->sz + y->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Fall back to the direct method if scratch memory runs out. */
+	if (zsl_conv_use_fft(x->sz, y->sz) &&
+	    zsl_conv_fft_scratch(x, y, true, r) == 0) {
+		return 0;
+	}
+
+	return zsl_xcorr_direct(x, y, r);
+}
+
+int
+zsl_xcorr_direct(const struct zsl_vec *x, const struct zsl_vec *y,
+		 struct zsl_vec *r)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (y->sz == 0) || (r->sz != x->sz + y->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < r->sz; i++) {
+		zsl_xcorr_lag(x, y, (int)i - (int)(y->sz - 1), &r->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_xcorr_fft_ws(const struct zsl_vec *x, const struct zsl_vec *y,
+		 struct zsl_vec *r, struct zsl_workspace *ws)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((x->sz == 0) || (y->sz == 0) || (r->sz != x->sz + y->sz - 1)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Correlating with 'y' is convolving with 'y' reversed. */
+	return zsl_conv_fft_run(x, y, true, r, ws);
+}
+
+int
+zsl_xcorr_lag(const struct zsl_vec *x, const struct zsl_vec *y, int lag,
+	      zsl_real_t *r)
+{
+	size_t xo, yo, len;
+	struct zsl_vec xw, yw;
+
+	/* The overlap starts at x[xo] and y[yo], where xo - yo = lag. */
+	if (lag >= 0) {
+		xo = (size_t)lag;
+		yo = 0;
+	} else {
+		xo = 0;
+		yo = (size_t)-lag;
+	}
+
+	if (xo >= x->sz || yo >= y->sz) {
+		*r = 0.0;
+		return 0;
+	}
+	len = (x->sz - xo < y->sz - yo) ? x->sz - xo : y->sz - yo;
+
+	zsl_vec_view(x, xo, len, &xw);
+	zsl_vec_view(y, yo, len, &yw);
+
+	return zsl_vec_dot(&xw, &yw, r);
+}
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/dual.h>
+
+/*
+ * Sets 'c' to f(a), where 'fa' is f(a) and 'dfa' is f'(a). 'c' may be 'a',
+ * since each partial is read before it is written.
+ */
+static inline void
+zsl_dual_chain(const struct zsl_dual *a, zsl_real_t fa, zsl_real_t dfa,
+	       struct zsl_dual *c)
+{
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = dfa * a->d[k];
+	}
+	c->v = fa;
+}
+
+int
+zsl_dual_const(struct zsl_dual *a, zsl_real_t x)
+{
+	a->v = x;
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		a->d[k] = 0.0;
+	}
+
+	return 0;
+}
+
+int
+zsl_dual_var(struct zsl_dual *a, zsl_real_t x, size_t i)
+{
+	if (i >= ZSL_DUAL_N) {
+		return -EINVAL;
+	}
+
+	zsl_dual_const(a, x);
+	a->d[i] = 1.0;
+
+	return 0;
+}
+
+int
+zsl_dual_add(const struct zsl_dual *a, const struct zsl_dual *b,
+	     struct zsl_dual *c)
+{
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = a->d[k] + b->d[k];
+	}
+	c->v = a->v + b->v;
+
+	return 0;
+}
+
+int
+zsl_dual_sub(const struct zsl_dual *a, const struct zsl_dual *b,
+	     struct zsl_dual *c)
+{
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = a->d[k] - b->d[k];
+	}
+	c->v = a->v - b->v;
+
+	return 0;
+}
+
+int
+zsl_dual_mult(const struct zsl_dual *a, const struct zsl_dual *b,
+	      struct zsl_dual *c)
+{
+	zsl_real_t av = a->v;
+	zsl_real_t bv = b->v;
+
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = av * b->d[k] + bv * a->d[k];
+	}
+	c->v = av * bv;
+
+	return 0;
+}
+
+int
+zsl_dual_div(const struct zsl_dual *a, const struct zsl_dual *b,
+	     struct zsl_dual *c)
+{
+	zsl_real_t q, ib;
+
+	if (b->v == 0.0) {
+		return -EINVAL;
+	}
+
+	/* (a / b)' = (a' - q * b') / b */
+	ib = 1.0 / b->v;
+	q = a->v * ib;
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = (a->d[k] - q * b->d[k]) * ib;
+	}
+	c->v = q;
+
+	return 0;
+}
+
+int
+zsl_dual_scalar_mult(const struct zsl_dual *a, zsl_real_t s,
+		     struct zsl_dual *c)
+{
+	zsl_dual_chain(a, s * a->v, s, c);
+
+	return 0;
+}
+
+int
+zsl_dual_sqrt(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	zsl_real_t r;
+
+	if (a->v <= 0.0) {
+		return -EINVAL;
+	}
+
+	r = ZSL_SQRT(a->v);
+	zsl_dual_chain(a, r, 0.5 / r, c);
+
+	return 0;
+}
+
+int
+zsl_dual_exp(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	zsl_real_t e = ZSL_EXP(a->v);
+
+	zsl_dual_chain(a, e, e, c);
+
+	return 0;
+}
+
+int
+zsl_dual_log(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	if (a->v <= 0.0) {
+		return -EINVAL;
+	}
+
+	zsl_dual_chain(a, ZSL_LOG(a->v), 1.0 / a->v, c);
+
+	return 0;
+}
+
+int
+zsl_dual_pow(const struct zsl_dual *a, zsl_real_t p, struct zsl_dual *c)
+{
+	zsl_real_t r;
+
+	if (a->v <= 0.0) {
+		return -EINVAL;
+	}
+
+	r = ZSL_POW(a->v, p);
+	zsl_dual_chain(a, r, p * r / a->v, c);
+
+	return 0;
+}
+
+int
+zsl_dual_sin(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	zsl_dual_chain(a, ZSL_SIN(a->v), ZSL_COS(a->v), c);
+
+	return 0;
+}
+
+int
+zsl_dual_cos(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	zsl_dual_chain(a, ZSL_COS(a->v), -ZSL_SIN(a->v), c);
+
+	return 0;
+}
+
+int
+zsl_dual_atan2(const struct zsl_dual *y, const struct zsl_dual *x,
+	       struct zsl_dual *c)
+{
+	zsl_real_t xv = x->v;
+	zsl_real_t yv = y->v;
+	zsl_real_t r2 = xv * xv + yv * yv;
+
+	if (r2 == 0.0) {
+		return -EINVAL;
+	}
+
+	/* atan2(y, x)' = (x * y' - y * x') / (x^2 + y^2) */
+	for (size_t k = 0; k < ZSL_DUAL_N; k++) {
+		c->d[k] = (xv * y->d[k] - yv * x->d[k]) / r2;
+	}
+	c->v = ZSL_ATAN2(yv, xv);
+
+	return 0;
+}
+
+int
+zsl_dual_vec_dot(const struct zsl_dual *a, const struct zsl_dual *b,
+		 size_t n, struct zsl_dual *c)
+{
+	struct zsl_dual s, t;
+
+	zsl_dual_const(&s, 0.0);
+	for (size_t i = 0; i < n; i++) {
+		zsl_dual_mult(&a[i], &b[i], &t);
+		zsl_dual_add(&s, &t, &s);
+	}
+	*c = s;
+
+	return 0;
+}
+
+int
+zsl_dual_vec_norm(const struct zsl_dual *a, size_t n, struct zsl_dual *c)
+{
+	zsl_dual_vec_dot(a, a, n, c);
+
+	return zsl_dual_sqrt(c, c);
+}
+
+int
+zsl_dual_vec_cross(const struct zsl_dual *a, const struct zsl_dual *b,
+		   struct zsl_dual *c)
+{
+	struct zsl_dual r[3], t;
+
+	zsl_dual_mult(&a[1], &b[2], &r[0]);
+	zsl_dual_mult(&a[2], &b[1], &t);
+	zsl_dual_sub(&r[0], &t, &r[0]);
+
+	zsl_dual_mult(&a[2], &b[0], &r[1]);
+	zsl_dual_mult(&a[0], &b[2], &t);
+	zsl_dual_sub(&r[1], &t, &r[1]);
+
+	zsl_dual_mult(&a[0], &b[1], &r[2]);
+	zsl_dual_mult(&a[1], &b[0], &t);
+	zsl_dual_sub(&r[2], &t, &r[2]);
+
+	c[0] = r[0];
+	c[1] = r[1];
+	c[2] = r[2];
+
+	return 0;
+}
+
+int
+zsl_dual_mtx_mult_vec(const struct zsl_mtx *m, const struct zsl_dual *a,
+		      struct zsl_dual *c)
+{
+	struct zsl_dual t;
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		const zsl_real_t *row = &m->data[i * m->sz_cols];
+
+		zsl_dual_const(&c[i], 0.0);
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			zsl_dual_scalar_mult(&a[j], row[j], &t);
+			zsl_dual_add(&c[i], &t, &c[i]);
+		}
+	}
+
+	return 0;
+}
+
+/* Sets 'c' to a * b + s * (d * e), the form of each quaternion term. */
+static void
+zsl_dual_fma2(const struct zsl_dual *a, const struct zsl_dual *b,
+	      zsl_real_t s, const struct zsl_dual *d, const struct zsl_dual *e,
+	      struct zsl_dual *c)
+{
+	struct zsl_dual t;
+
+	zsl_dual_mult(a, b, c);
+	zsl_dual_mult(d, e, &t);
+	zsl_dual_scalar_mult(&t, s, &t);
+	zsl_dual_add(c, &t, c);
+}
+
+int
+zsl_dual_quat_mult(const struct zsl_dual *qa, const struct zsl_dual *qb,
+		   struct zsl_dual *qm)
+{
+	struct zsl_dual r[4], t;
+
+	/* r = ar * br - ai * bi - aj * bj - ak * bk */
+	zsl_dual_fma2(&qa[0], &qb[0], -1.0, &qa[1], &qb[1], &r[0]);
+	zsl_dual_fma2(&qa[2], &qb[2], 1.0, &qa[3], &qb[3], &t);
+	zsl_dual_sub(&r[0], &t, &r[0]);
+
+	/* i = ar * bi + ai * br + aj * bk - ak * bj */
+	zsl_dual_fma2(&qa[0], &qb[1], 1.0, &qa[1], &qb[0], &r[1]);
+	zsl_dual_fma2(&qa[2], &qb[3], -1.0, &qa[3], &qb[2], &t);
+	zsl_dual_add(&r[1], &t, &r[1]);
+
+	/* j = ar * bj - ai * bk + aj * br + ak * bi */
+	zsl_dual_fma2(&qa[0], &qb[2], -1.0, &qa[1], &qb[3], &r[2]);
+	zsl_dual_fma2(&qa[2], &qb[0], 1.0, &qa[3], &qb[1], &t);
+	zsl_dual_add(&r[2], &t, &r[2]);
+
+	/* k = ar * bk + ai * bj - aj * bi + ak * br */
+	zsl_dual_fma2(&qa[0], &qb[3], 1.0, &qa[1], &qb[2], &r[3]);
+	zsl_dual_fma2(&qa[3], &qb[0], -1.0, &qa[2], &qb[1], &t);
+	zsl_dual_add(&r[3], &t, &r[3]);
+
+	for (size_t i = 0; i < 4; i++) {
+		qm[i] = r[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_dual_quat_rot_vec(const struct zsl_dual *q, const struct zsl_dual *v,
+		      struct zsl_dual *vr)
+{
+	struct zsl_dual t[3], u[3];
+
+	/* As zsl_quat_rot_vec: t = 2 * (ijk x v), v' = v + r * t + ijk x t */
+	zsl_dual_vec_cross(&q[1], v, t);
+	for (size_t i = 0; i < 3; i++) {
+		zsl_dual_scalar_mult(&t[i], 2.0, &t[i]);
+	}
+	zsl_dual_vec_cross(&q[1], t, u);
+	for (size_t i = 0; i < 3; i++) {
+		zsl_dual_mult(&q[0], &t[i], &t[i]);
+		zsl_dual_add(&t[i], &u[i], &t[i]);
+		zsl_dual_add(&v[i], &t[i], &vr[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_dual_clr_xyz_xyy(const struct zsl_dual *xyz, struct zsl_dual *xyy)
+{
+	int rc;
+	struct zsl_dual s, x, y;
+
+	zsl_dual_add(&xyz[0], &xyz[1], &s);
+	zsl_dual_add(&s, &xyz[2], &s);
+
+	rc = zsl_dual_div(&xyz[0], &s, &x);
+	if (rc) {
+		return rc;
+	}
+	zsl_dual_div(&xyz[1], &s, &y);
+
+	xyy[2] = xyz[1];
+	xyy[0] = x;
+	xyy[1] = y;
+
+	return 0;
+}
+
+int
+zsl_dual_clr_srgb_enc(const struct zsl_dual *a, struct zsl_dual *c)
+{
+	zsl_real_t v = a->v;
+	zsl_real_t p;
+
+	/* As zsl_clr_conv_rgbf_srgbf, the value is limited to 0.0..1.0,
+	 * where the slope is zero. */
+	if (v <= 0.0) {
+		zsl_dual_chain(a, 0.0, 0.0, c);
+	} else if (v >= 1.0) {
+		zsl_dual_chain(a, 1.0, 0.0, c);
+	} else if (v <= 0.0031308) {
+		zsl_dual_chain(a, 12.92 * v, 12.92, c);
+	} else {
+		p = ZSL_POW(v, 1.0 / 2.4);
+		zsl_dual_chain(a, 1.055 * p - 0.055, 1.055 / 2.4 * p / v, c);
+	}
+
+	return 0;
+}
+
+int
+zsl_dual_jacobian(zsl_dual_fn_t fn, void *arg, const struct zsl_vec *x,
+		  struct zsl_vec *y, struct zsl_mtx *j)
+{
+	int rc;
+	struct zsl_dual dx[ZSL_DUAL_N];
+
+	if ((x->sz > ZSL_DUAL_N) || (y->sz == 0) || (j->sz_rows != y->sz) ||
+	    (j->sz_cols != x->sz)) {
+		return -EINVAL;
+	}
+
+	struct zsl_dual dy[y->sz];
+
+	/* Input 'k' is seeded with a unit partial in slot 'k', so column 'k'
+	 * of the Jacobian comes out in slot 'k' of every output. */
+	for (size_t k = 0; k < x->sz; k++) {
+		zsl_dual_var(&dx[k], x->data[k], k);
+	}
+
+	rc = fn(dx, dy, arg);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = dy[i].v;
+		for (size_t k = 0; k < x->sz; k++) {
+			j->data[i * x->sz + k] = dy[i].d[k];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_dual_propagate(zsl_dual_fn_t fn, void *arg, const struct zsl_vec *x,
+		   const struct zsl_mtx *cx, struct zsl_vec *y,
+		   struct zsl_mtx *cy)
+{
+	int rc;
+
+	if ((x->sz > ZSL_DUAL_N) || (y->sz == 0) || (cx->sz_rows != x->sz) ||
+	    (cx->sz_cols != x->sz) || (cy->sz_rows != y->sz) ||
+	    (cy->sz_cols != y->sz)) {
+		return -EINVAL;
+	}
+
+	ZSL_MATRIX_DEF(j, y->sz, x->sz);
+	ZSL_MATRIX_DEF(jc, y->sz, x->sz);
+
+	rc = zsl_dual_jacobian(fn, arg, x, y, &j);
+	if (rc) {
+		return rc;
+	}
+
+	/* cy = (J * cx) * J^T, with J^T read in place. */
+	zsl_mtx_mult(&j, cx, &jc);
+
+	return zsl_mtx_mult_ex(&jc, false, &j, true, 1.0, 0.0, cy);
+}
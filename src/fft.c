@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/fft.h>
+
+/* The portable real FFT, which a backend may fall back to. */
+static void zsl_fft_real_c(struct zsl_vec *v, bool inverse);
+
+/* Route the real FFT through CMSIS-DSP if requested. */
+#if CONFIG_ZSL_BACKEND_CMSIS_DSP
+#include <zsl/asm/arm/cmsis_dsp_fft.h>
+#endif
+
+/*
+ * sin(2 * pi * i / ZSL_FFT_MAX_N) for i = 0 .. ZSL_FFT_MAX_N / 4. The other
+ * three quarters of the sine and cosine waves are read from this by
+ * symmetry.
+ */
+static const zsl_real_t zsl_fft_sin[ZSL_FFT_MAX_N / 4 + 1] = {
+	0.0000000000000000e+00, 1.5339801862847655e-03, 3.0679567629659761e-03,
+	4.6019261204485705e-03, 6.1358846491544753e-03, 7.6698287395310970e-03,
+	9.2037547820598194e-03, 1.0737659167264491e-02, 1.2271538285719925e-02,
+	1.3805388528060391e-02, 1.5339206284988100e-02, 1.6872987947281710e-02,
+	1.8406729905804820e-02, 1.9940428551514441e-02, 2.1474080275469508e-02,
+	2.3007681468839369e-02, 2.4541228522912288e-02, 2.6074717829103901e-02,
+	2.7608145778965740e-02, 2.9141508764193722e-02, 3.0674803176636626e-02,
+	3.2208025408304586e-02, 3.3741171851377580e-02, 3.5274238898213947e-02,
+	3.6807222941358832e-02, 3.8340120373552694e-02, 3.9872927587739811e-02,
+	4.1405640977076739e-02, 4.2938256934940820e-02, 4.4470771854938668e-02,
+	4.6003182130914623e-02, 4.7535484156959303e-02, 4.9067674327418015e-02,
+	5.0599749036899282e-02, 5.2131704680283324e-02, 5.3663537652730520e-02,
+	5.5195244349689934e-02, 5.6726821166907748e-02, 5.8258264500435752e-02,
+	5.9789570746639868e-02, 6.1320736302208578e-02, 6.2851757564161406e-02,
+	6.4382630929857465e-02, 6.5913352797003805e-02, 6.7443919563664051e-02,
+	6.8974327628266746e-02, 7.0504573389613856e-02, 7.2034653246889332e-02,
+	7.3564563599667426e-02, 7.5094300847921305e-02, 7.6623861392031492e-02,
+	7.8153241632794232e-02, 7.9682437971430126e-02, 8.1211446809592441e-02,
+	8.2740264549375692e-02, 8.4268887593324071e-02, 8.5797312344439894e-02,
+	8.7325535206192059e-02, 8.8853552582524600e-02, 9.0381360877864983e-02,
+	9.1908956497132724e-02, 9.3436335845747787e-02, 9.4963495329638992e-02,
+	9.6490431355252593e-02, 9.8017140329560604e-02, 9.9543618660069319e-02,
+	1.0106986275482782e-01, 1.0259586902243628e-01, 1.0412163387205459e-01,
+	1.0564715371341062e-01, 1.0717242495680884e-01, 1.0869744401313872e-01,
+	1.1022220729388306e-01, 1.1174671121112659e-01, 1.1327095217756435e-01,
+	1.1479492660651008e-01, 1.1631863091190475e-01, 1.1784206150832498e-01,
+	1.1936521481099135e-01, 1.2088808723577708e-01, 1.2241067519921620e-01,
+	1.2393297511851216e-01, 1.2545498341154623e-01, 1.2697669649688587e-01,
+	1.2849811079379317e-01, 1.3001922272223335e-01, 1.3154002870288312e-01,
+	1.3306052515713906e-01, 1.3458070850712617e-01, 1.3610057517570620e-01,
+	1.3762012158648604e-01, 1.3913934416382620e-01, 1.4065823933284921e-01,
+	1.4217680351944803e-01, 1.4369503315029447e-01, 1.4521292465284746e-01,
+	1.4673047445536175e-01, 1.4824767898689603e-01, 1.4976453467732151e-01,
+	1.5128103795733022e-01, 1.5279718525844344e-01, 1.5431297301302010e-01,
+	1.5582839765426523e-01, 1.5734345561623825e-01, 1.5885814333386145e-01,
+	1.6037245724292828e-01, 1.6188639378011183e-01, 1.6339994938297323e-01,
+	1.6491312048996992e-01, 1.6642590354046410e-01, 1.6793829497473117e-01,
+	1.6945029123396796e-01, 1.7096188876030122e-01, 1.7247308399679595e-01,
+	1.7398387338746382e-01, 1.7549425337727143e-01, 1.7700422041214875e-01,
+	1.7851377093899751e-01, 1.8002290140569951e-01, 1.8153160826112497e-01,
+	1.8303988795514095e-01, 1.8454773693861962e-01, 1.8605515166344663e-01,
+	1.8756212858252960e-01, 1.8906866414980619e-01, 1.9057475482025274e-01,
+	1.9208039704989244e-01, 1.9358558729580361e-01, 1.9509032201612825e-01,
+	1.9659459767008022e-01, 1.9809841071795356e-01, 1.9960175762113097e-01,
+	2.0110463484209190e-01, 2.0260703884442113e-01, 2.0410896609281687e-01,
+	2.0561041305309924e-01, 2.0711137619221856e-01, 2.0861185197826349e-01,
+	2.1011183688046961e-01, 2.1161132736922755e-01, 2.1311031991609136e-01,
+	2.1460881099378676e-01, 2.1610679707621952e-01, 2.1760427463848364e-01,
+	2.1910124015686980e-01, 2.2059769010887351e-01, 2.2209362097320351e-01,
+	2.2358902922978999e-01, 2.2508391135979283e-01, 2.2657826384561000e-01,
+	2.2807208317088573e-01, 2.2956536582051887e-01, 2.3105810828067111e-01,
+	2.3255030703877524e-01, 2.3404195858354343e-01, 2.3553305940497549e-01,
+	2.3702360599436720e-01, 2.3851359484431842e-01, 2.4000302244874150e-01,
+	2.4149188530286933e-01, 2.4298017990326387e-01, 2.4446790274782415e-01,
+	2.4595505033579459e-01, 2.4744161916777327e-01, 2.4892760574572015e-01,
+	2.5041300657296522e-01, 2.5189781815421697e-01, 2.5338203699557016e-01,
+	2.5486565960451457e-01, 2.5634868248994291e-01, 2.5783110216215899e-01,
+	2.5931291513288623e-01, 2.6079411791527551e-01, 2.6227470702391359e-01,
+	2.6375467897483135e-01, 2.6523403028551179e-01, 2.6671275747489837e-01,
+	2.6819085706340318e-01, 2.6966832557291509e-01, 2.7114515952680801e-01,
+	2.7262135544994898e-01, 2.7409690986870638e-01, 2.7557181931095814e-01,
+	2.7704608030609990e-01, 2.7851968938505306e-01, 2.7999264308027322e-01,
+	2.8146493792575794e-01, 2.8293657045705539e-01, 2.8440753721127188e-01,
+	2.8587783472708062e-01, 2.8734745954472951e-01, 2.8881640820604948e-01,
+	2.9028467725446233e-01, 2.9175226323498926e-01, 2.9321916269425863e-01,
+	2.9468537218051433e-01, 2.9615088824362379e-01, 2.9761570743508620e-01,
+	2.9907982630804048e-01, 3.0054324141727345e-01, 3.0200594931922808e-01,
+	3.0346794657201132e-01, 3.0492922973540237e-01, 3.0638979537086092e-01,
+	3.0784964004153487e-01, 3.0930876031226873e-01, 3.1076715274961147e-01,
+	3.1222481392182488e-01, 3.1368174039889152e-01, 3.1513792875252244e-01,
+	3.1659337555616585e-01, 3.1804807738501495e-01, 3.1950203081601569e-01,
+	3.2095523242787521e-01, 3.2240767880106985e-01, 3.2385936651785285e-01,
+	3.2531029216226293e-01, 3.2676045232013173e-01, 3.2820984357909250e-01,
+	3.2965846252858749e-01, 3.3110630575987643e-01, 3.3255336986604422e-01,
+	3.3399965144200938e-01, 3.3544514708453160e-01, 3.3688985339222005e-01,
+	3.3833376696554113e-01, 3.3977688440682685e-01, 3.4121920232028236e-01,
+	3.4266071731199438e-01, 3.4410142598993881e-01, 3.4554132496398909e-01,
+	3.4698041084592368e-01, 3.4841868024943456e-01, 3.4985612979013492e-01,
+	3.5129275608556709e-01, 3.5272855575521073e-01, 3.5416352542049034e-01,
+	3.5559766170478385e-01, 3.5703096123342998e-01, 3.5846342063373654e-01,
+	3.5989503653498811e-01, 3.6132580556845428e-01, 3.6275572436739723e-01,
+	3.6418478956707989e-01, 3.6561299780477385e-01, 3.6704034571976718e-01,
+	3.6846682995337232e-01, 3.6989244714893410e-01, 3.7131719395183754e-01,
+	3.7274106700951576e-01, 3.7416406297145793e-01, 3.7558617848921722e-01,
+	3.7700741021641826e-01, 3.7842775480876556e-01, 3.7984720892405116e-01,
+	3.8126576922216238e-01, 3.8268343236508978e-01, 3.8410019501693504e-01,
+	3.8551605384391885e-01, 3.8693100551438858e-01, 3.8834504669882625e-01,
+	3.8975817406985641e-01, 3.9117038430225387e-01, 3.9258167407295147e-01,
+	3.9399204006104810e-01, 3.9540147894781635e-01, 3.9680998741671031e-01,
+	3.9821756215337356e-01, 3.9962419984564679e-01, 4.0102989718357562e-01,
+	4.0243465085941843e-01, 4.0383845756765407e-01, 4.0524131400498986e-01,
+	4.0664321687036903e-01, 4.0804416286497869e-01, 4.0944414869225759e-01,
+	4.1084317105790391e-01, 4.1224122666988289e-01, 4.1363831223843450e-01,
+	4.1503442447608163e-01, 4.1642956009763715e-01, 4.1782371582021227e-01,
+	4.1921688836322391e-01, 4.2060907444840251e-01, 4.2200027079979968e-01,
+	4.2339047414379605e-01, 4.2477968120910881e-01, 4.2616788872679962e-01,
+	4.2755509343028208e-01, 4.2894129205532949e-01, 4.3032648134008261e-01,
+	4.3171065802505726e-01, 4.3309381885315196e-01, 4.3447596056965565e-01,
+	4.3585707992225547e-01, 4.3723717366104409e-01, 4.3861623853852766e-01,
+	4.3999427130963326e-01, 4.4137126873171667e-01, 4.4274722756457002e-01,
+	4.4412214457042920e-01, 4.4549601651398174e-01, 4.4686884016237416e-01,
+	4.4824061228521989e-01, 4.4961132965460654e-01, 4.5098098904510386e-01,
+	4.5234958723377089e-01, 4.5371712100016387e-01, 4.5508358712634384e-01,
+	4.5644898239688392e-01, 4.5781330359887717e-01, 4.5917654752194409e-01,
+	4.6053871095824001e-01, 4.6189979070246273e-01, 4.6325978355186015e-01,
+	4.6461868630623782e-01, 4.6597649576796618e-01, 4.6733320874198842e-01,
+	4.6868882203582790e-01, 4.7004333245959562e-01, 4.7139673682599764e-01,
+	4.7274903195034279e-01, 4.7410021465054997e-01, 4.7545028174715587e-01,
+	4.7679923006332209e-01, 4.7814705642484301e-01, 4.7949375766015301e-01,
+	4.8083933060033396e-01, 4.8218377207912272e-01, 4.8352707893291874e-01,
+	4.8486924800079106e-01, 4.8621027612448642e-01, 4.8755016014843600e-01,
+	4.8888889691976317e-01, 4.9022648328829116e-01, 4.9156291610654990e-01,
+	4.9289819222978404e-01, 4.9423230851595967e-01, 4.9556526182577254e-01,
+	4.9689704902265447e-01, 4.9822766697278187e-01, 4.9955711254508184e-01,
+	5.0088538261124071e-01, 5.0221247404571079e-01, 5.0353838372571758e-01,
+	5.0486310853126759e-01, 5.0618664534515523e-01, 5.0750899105297087e-01,
+	5.0883014254310699e-01, 5.1015009670676681e-01, 5.1146885043797030e-01,
+	5.1278640063356296e-01, 5.1410274419322166e-01, 5.1541787801946293e-01,
+	5.1673179901764987e-01, 5.1804450409599934e-01, 5.1935599016558964e-01,
+	5.2066625414036716e-01, 5.2197529293715439e-01, 5.2328310347565643e-01,
+	5.2458968267846895e-01, 5.2589502747108463e-01, 5.2719913478190128e-01,
+	5.2850200154222848e-01, 5.2980362468629461e-01, 5.3110400115125500e-01,
+	5.3240312787719790e-01, 5.3370100180715296e-01, 5.3499761988709715e-01,
+	5.3629297906596318e-01, 5.3758707629564539e-01, 5.3887990853100842e-01,
+	5.4017147272989285e-01, 5.4146176585312344e-01, 5.4275078486451589e-01,
+	5.4403852673088382e-01, 5.4532498842204646e-01, 5.4661016691083486e-01,
+	5.4789405917310019e-01, 5.4917666218771966e-01, 5.5045797293660481e-01,
+	5.5173798840470734e-01, 5.5301670558002747e-01, 5.5429412145362000e-01,
+	5.5557023301960218e-01, 5.5684503727516010e-01, 5.5811853122055610e-01,
+	5.5939071185913614e-01, 5.6066157619733603e-01, 5.6193112124468947e-01,
+	5.6319934401383409e-01, 5.6446624152051950e-01, 5.6573181078361312e-01,
+	5.6699604882510868e-01, 5.6825895267013149e-01, 5.6952051934694714e-01,
+	5.7078074588696726e-01, 5.7203962932475705e-01, 5.7329716669804220e-01,
+	5.7455335504771576e-01, 5.7580819141784534e-01, 5.7706167285567944e-01,
+	5.7831379641165559e-01, 5.7956455913940563e-01, 5.8081395809576453e-01,
+	5.8206199034077544e-01, 5.8330865293769829e-01, 5.8455394295301533e-01,
+	5.8579785745643886e-01, 5.8704039352091797e-01, 5.8828154822264522e-01,
+	5.8952131864106394e-01, 5.9075970185887416e-01, 5.9199669496204099e-01,
+	5.9323229503979980e-01, 5.9446649918466443e-01, 5.9569930449243336e-01,
+	5.9693070806219650e-01, 5.9816070699634227e-01, 5.9938929840056454e-01,
+	6.0061647938386897e-01, 6.0184224705858003e-01, 6.0306659854034816e-01,
+	6.0428953094815596e-01, 6.0551104140432555e-01, 6.0673112703452448e-01,
+	6.0794978496777363e-01, 6.0916701233645321e-01, 6.1038280627630948e-01,
+	6.1159716392646191e-01, 6.1281008242940971e-01, 6.1402155893103838e-01,
+	6.1523159058062682e-01, 6.1644017453085365e-01, 6.1764730793780387e-01,
+	6.1885298796097632e-01, 6.2005721176328910e-01, 6.2125997651108755e-01,
+	6.2246127937414997e-01, 6.2366111752569453e-01, 6.2485948814238634e-01,
+	6.2605638840434352e-01, 6.2725181549514408e-01, 6.2844576660183271e-01,
+	6.2963823891492698e-01, 6.3082922962842447e-01, 6.3201873593980906e-01,
+	6.3320675505005719e-01, 6.3439328416364549e-01, 6.3557832048855611e-01,
+	6.3676186123628420e-01, 6.3794390362184406e-01, 6.3912444486377573e-01,
+	6.4030348218415167e-01, 6.4148101280858316e-01, 6.4265703396622686e-01,
+	6.4383154288979139e-01, 6.4500453681554393e-01, 6.4617601298331628e-01,
+	6.4734596863651206e-01, 6.4851440102211244e-01, 6.4968130739068319e-01,
+	6.5084668499638088e-01, 6.5201053109695950e-01, 6.5317284295377676e-01,
+	6.5433361783180044e-01, 6.5549285299961535e-01, 6.5665054572942894e-01,
+	6.5780669329707864e-01, 6.5896129298203732e-01, 6.6011434206742048e-01,
+	6.6126583783999227e-01, 6.6241577759017178e-01, 6.6356415861203977e-01,
+	6.6471097820334479e-01, 6.6585623366550972e-01, 6.6699992230363747e-01,
+	6.6814204142651845e-01, 6.6928258834663601e-01, 6.7042156038017309e-01,
+	6.7155895484701833e-01, 6.7269476907077286e-01, 6.7382900037875604e-01,
+	6.7496164610201193e-01, 6.7609270357531592e-01, 6.7722217013718033e-01,
+	6.7835004312986147e-01, 6.7947631989936497e-01, 6.8060099779545302e-01,
+	6.8172407417164971e-01, 6.8284554638524808e-01, 6.8396541179731540e-01,
+	6.8508366777270036e-01, 6.8620031168003859e-01, 6.8731534089175905e-01,
+	6.8842875278409044e-01, 6.8954054473706683e-01, 6.9065071413453460e-01,
+	6.9175925836415775e-01, 6.9286617481742463e-01, 6.9397146088965400e-01,
+	6.9507511398000088e-01, 6.9617713149146299e-01, 6.9727751083088652e-01,
+	6.9837624940897292e-01, 6.9947334464028377e-01, 7.0056879394324834e-01,
+	7.0166259474016845e-01, 7.0275474445722530e-01, 7.0384524052448494e-01,
+	7.0493408037590488e-01, 7.0602126144933974e-01, 7.0710678118654746e-01,
+	7.0819063703319529e-01, 7.0927282643886558e-01, 7.1035334685706231e-01,
+	7.1143219574521643e-01, 7.1250937056469232e-01, 7.1358486878079352e-01,
+	7.1465868786276898e-01, 7.1573082528381859e-01, 7.1680127852109954e-01,
+	7.1787004505573171e-01, 7.1893712237280438e-01, 7.2000250796138165e-01,
+	7.2106619931450811e-01, 7.2212819392921535e-01, 7.2318848930652735e-01,
+	7.2424708295146689e-01, 7.2530397237306066e-01, 7.2635915508434601e-01,
+	7.2741262860237577e-01, 7.2846439044822520e-01, 7.2951443814699690e-01,
+	7.3056276922782759e-01, 7.3160938122389252e-01, 7.3265427167241282e-01,
+	7.3369743811466026e-01, 7.3473887809596339e-01, 7.3577858916571348e-01,
+	7.3681656887736979e-01, 7.3785281478846598e-01, 7.3888732446061511e-01,
+	7.3992009545951609e-01, 7.4095112535495911e-01, 7.4198041172083096e-01,
+	7.4300795213512172e-01, 7.4403374417992918e-01, 7.4505778544146595e-01,
+	7.4608007351006378e-01, 7.4710060598018013e-01, 7.4811938045040349e-01,
+	7.4913639452345926e-01, 7.5015164580621496e-01, 7.5116513190968637e-01,
+	7.5217685044904270e-01, 7.5318679904361241e-01, 7.5419497531688917e-01,
+	7.5520137689653655e-01, 7.5620600141439454e-01, 7.5720884650648446e-01,
+	7.5820990981301528e-01, 7.5920918897838796e-01, 7.6020668165120242e-01,
+	7.6120238548426178e-01, 7.6219629813457890e-01, 7.6318841726338127e-01,
+	7.6417874053611667e-01, 7.6516726562245896e-01, 7.6615399019631281e-01,
+	7.6713891193582040e-01, 7.6812202852336531e-01, 7.6910333764557959e-01,
+	7.7008283699334790e-01, 7.7106052426181371e-01, 7.7203639715038441e-01,
+	7.7301045336273699e-01, 7.7398269060682279e-01, 7.7495310659487382e-01,
+	7.7592169904340758e-01, 7.7688846567323244e-01, 7.7785340420945304e-01,
+	7.7881651238147587e-01, 7.7977778792301444e-01, 7.8073722857209438e-01,
+	7.8169483207105939e-01, 7.8265059616657573e-01, 7.8360451860963820e-01,
+	7.8455659715557524e-01, 7.8550682956405393e-01, 7.8645521359908577e-01,
+	7.8740174702903132e-01, 7.8834642762660623e-01, 7.8928925316888565e-01,
+	7.9023022143731003e-01, 7.9116933021769009e-01, 7.9210657730021239e-01,
+	7.9304196047944364e-01, 7.9397547755433717e-01, 7.9490712632823701e-01,
+	7.9583690460888346e-01, 7.9676481020841872e-01, 7.9769084094339104e-01,
+	7.9861499463476082e-01, 7.9953726910790501e-01, 8.0045766219262271e-01,
+	8.0137617172314013e-01, 8.0229279553811572e-01, 8.0320753148064483e-01,
+	8.0412037739826570e-01, 8.0503133114296366e-01, 8.0594039057117628e-01,
+	8.0684755354379922e-01, 8.0775281792619036e-01, 8.0865618158817498e-01,
+	8.0955764240405126e-01, 8.1045719825259477e-01, 8.1135484701706373e-01,
+	8.1225058658520388e-01, 8.1314441484925359e-01, 8.1403632970594830e-01,
+	8.1492632905652662e-01, 8.1581441080673378e-01, 8.1670057286682785e-01,
+	8.1758481315158371e-01, 8.1846712958029866e-01, 8.1934752007679690e-01,
+	8.2022598256943469e-01, 8.2110251499110465e-01, 8.2197711527924155e-01,
+	8.2284978137582632e-01, 8.2372051122739132e-01, 8.2458930278502529e-01,
+	8.2545615400437744e-01, 8.2632106284566342e-01, 8.2718402727366902e-01,
+	8.2804504525775580e-01, 8.2890411477186487e-01, 8.2976123379452305e-01,
+	8.3061640030884620e-01, 8.3146961230254524e-01, 8.3232086776792968e-01,
+	8.3317016470191319e-01, 8.3401750110601813e-01, 8.3486287498638001e-01,
+	8.3570628435375260e-01, 8.3654772722351189e-01, 8.3738720161566194e-01,
+	8.3822470555483797e-01, 8.3906023707031263e-01, 8.3989379419599941e-01,
+	8.4072537497045807e-01, 8.4155497743689833e-01, 8.4238259964318596e-01,
+	8.4320823964184544e-01, 8.4403189549006641e-01, 8.4485356524970701e-01,
+	8.4567324698729907e-01, 8.4649093877405202e-01, 8.4730663868585832e-01,
+	8.4812034480329712e-01, 8.4893205521163961e-01, 8.4974176800085244e-01,
+	8.5054948126560337e-01, 8.5135519310526520e-01, 8.5215890162391983e-01,
+	8.5296060493036363e-01, 8.5376030113811130e-01, 8.5455798836540053e-01,
+	8.5535366473519603e-01, 8.5614732837519447e-01, 8.5693897741782865e-01,
+	8.5772861000027212e-01, 8.5851622426444274e-01, 8.5930181835700836e-01,
+	8.6008539042939014e-01, 8.6086693863776731e-01, 8.6164646114308130e-01,
+	8.6242395611104050e-01, 8.6319942171212416e-01, 8.6397285612158670e-01,
+	8.6474425751946238e-01, 8.6551362409056898e-01, 8.6628095402451299e-01,
+	8.6704624551569265e-01, 8.6780949676330321e-01, 8.6857070597134090e-01,
+	8.6932987134860673e-01, 8.7008699110871135e-01, 8.7084206347007886e-01,
+	8.7159508665595109e-01, 8.7234605889439154e-01, 8.7309497841829009e-01,
+	8.7384184346536675e-01, 8.7458665227817611e-01, 8.7532940310411078e-01,
+	8.7607009419540660e-01, 8.7680872380914576e-01, 8.7754529020726124e-01,
+	8.7827979165654146e-01, 8.7901222642863341e-01, 8.7974259280004741e-01,
+	8.8047088905216075e-01, 8.8119711347122198e-01, 8.8192126434835494e-01,
+	8.8264333997956279e-01, 8.8336333866573158e-01, 8.8408125871263499e-01,
+	8.8479709843093779e-01, 8.8551085613619995e-01, 8.8622253014888064e-01,
+	8.8693211879434208e-01, 8.8763962040285393e-01, 8.8834503330959624e-01,
+	8.8904835585466457e-01, 8.8974958638307289e-01, 8.9044872324475788e-01,
+	8.9114576479458318e-01, 8.9184070939234272e-01, 8.9253355540276469e-01,
+	8.9322430119551532e-01, 8.9391294514520325e-01, 8.9459948563138258e-01,
+	8.9528392103855758e-01, 8.9596624975618511e-01, 8.9664647017868015e-01,
+	8.9732458070541832e-01, 8.9800057974073988e-01, 8.9867446569395382e-01,
+	8.9934623697934146e-01, 9.0001589201616028e-01, 9.0068342922864686e-01,
+	9.0134884704602203e-01, 9.0201214390249307e-01, 9.0267331823725883e-01,
+	9.0333236849451182e-01, 9.0398929312344334e-01, 9.0464409057824624e-01,
+	9.0529675931811882e-01, 9.0594729780726846e-01, 9.0659570451491533e-01,
+	9.0724197791529593e-01, 9.0788611648766615e-01, 9.0852811871630612e-01,
+	9.0916798309052227e-01, 9.0980570810465222e-01, 9.1044129225806714e-01,
+	9.1107473405517625e-01, 9.1170603200542988e-01, 9.1233518462332275e-01,
+	9.1296219042839810e-01, 9.1358704794525081e-01, 9.1420975570353069e-01,
+	9.1483031223794609e-01, 9.1544871608826783e-01, 9.1606496579933161e-01,
+	9.1667905992104270e-01, 9.1729099700837791e-01, 9.1790077562139039e-01,
+	9.1850839432521225e-01, 9.1911385169005777e-01, 9.1971714629122736e-01,
+	9.2031827670911048e-01, 9.2091724152918952e-01, 9.2151403934204190e-01,
+	9.2210866874334507e-01, 9.2270112833387852e-01, 9.2329141671952764e-01,
+	9.2387953251128674e-01, 9.2446547432526260e-01, 9.2504924078267758e-01,
+	9.2563083050987272e-01, 9.2621024213831127e-01, 9.2678747430458175e-01,
+	9.2736252565040111e-01, 9.2793539482261789e-01, 9.2850608047321548e-01,
+	9.2907458125931575e-01, 9.2964089584318133e-01, 9.3020502289221907e-01,
+	9.3076696107898371e-01, 9.3132670908118043e-01, 9.3188426558166815e-01,
+	9.3243962926846236e-01, 9.3299279883473885e-01, 9.3354377297883617e-01,
+	9.3409255040425887e-01, 9.3463912981968078e-01, 9.3518350993894750e-01,
+	9.3572568948108037e-01, 9.3626566717027826e-01, 9.3680344173592156e-01,
+	9.3733901191257496e-01, 9.3787237643998989e-01, 9.3840353406310806e-01,
+	9.3893248353206449e-01, 9.3945922360218992e-01, 9.3998375303401394e-01,
+	9.4050607059326830e-01, 9.4102617505088926e-01, 9.4154406518302081e-01,
+	9.4205973977101731e-01, 9.4257319760144687e-01, 9.4308443746609349e-01,
+	9.4359345816196039e-01, 9.4410025849127266e-01, 9.4460483726148026e-01,
+	9.4510719328526061e-01, 9.4560732538052128e-01, 9.4610523237040334e-01,
+	9.4660091308328353e-01, 9.4709436635277722e-01, 9.4758559101774109e-01,
+	9.4807458592227623e-01, 9.4856134991573027e-01, 9.4904588185270056e-01,
+	9.4952818059303667e-01, 9.5000824500184300e-01, 9.5048607394948170e-01,
+	9.5096166631157508e-01, 9.5143502096900834e-01, 9.5190613680793223e-01,
+	9.5237501271976588e-01, 9.5284164760119872e-01, 9.5330604035419375e-01,
+	9.5376818988599033e-01, 9.5422809510910567e-01, 9.5468575494133834e-01,
+	9.5514116830577067e-01, 9.5559433413077111e-01, 9.5604525134999641e-01,
+	9.5649391890239499e-01, 9.5694033573220894e-01, 9.5738450078897586e-01,
+	9.5782641302753291e-01, 9.5826607140801767e-01, 9.5870347489587160e-01,
+	9.5913862246184189e-01, 9.5957151308198452e-01, 9.6000214573766585e-01,
+	9.6043051941556579e-01, 9.6085663310767966e-01, 9.6128048581132064e-01,
+	9.6170207652912254e-01, 9.6212140426904158e-01, 9.6253846804435916e-01,
+	9.6295326687368388e-01, 9.6336579978095405e-01, 9.6377606579543984e-01,
+	9.6418406395174572e-01, 9.6458979328981265e-01, 9.6499325285492032e-01,
+	9.6539444169768940e-01, 9.6579335887408357e-01, 9.6619000344541262e-01,
+	9.6658437447833312e-01, 9.6697647104485207e-01, 9.6736629222232851e-01,
+	9.6775383709347551e-01, 9.6813910474636233e-01, 9.6852209427441727e-01,
+	9.6890280477642887e-01, 9.6928123535654853e-01, 9.6965738512429245e-01,
+	9.7003125319454397e-01, 9.7040283868755550e-01, 9.7077214072895035e-01,
+	9.7113915844972509e-01, 9.7150389098625178e-01, 9.7186633748027940e-01,
+	9.7222649707893627e-01, 9.7258436893473221e-01, 9.7293995220556007e-01,
+	9.7329324605469825e-01, 9.7364424965081187e-01, 9.7399296216795583e-01,
+	9.7433938278557586e-01, 9.7468351068851067e-01, 9.7502534506699412e-01,
+	9.7536488511665687e-01, 9.7570213003852857e-01, 9.7603707903903902e-01,
+	9.7636973133002114e-01, 9.7670008612871184e-01, 9.7702814265775439e-01,
+	9.7735390014519996e-01, 9.7767735782450993e-01, 9.7799851493455714e-01,
+	9.7831737071962765e-01, 9.7863392442942310e-01, 9.7894817531906220e-01,
+	9.7926012264908202e-01, 9.7956976568544052e-01, 9.7987710369951764e-01,
+	9.8018213596811732e-01, 9.8048486177346938e-01, 9.8078528040323043e-01,
+	9.8108339115048659e-01, 9.8137919331375456e-01, 9.8167268619698311e-01,
+	9.8196386910955524e-01, 9.8225274136628937e-01, 9.8253930228744124e-01,
+	9.8282355119870524e-01, 9.8310548743121629e-01, 9.8338511032155118e-01,
+	9.8366241921173025e-01, 9.8393741344921892e-01, 9.8421009238692903e-01,
+	9.8448045538322093e-01, 9.8474850180190421e-01, 9.8501423101223984e-01,
+	9.8527764238894122e-01, 9.8553873531217606e-01, 9.8579750916756737e-01,
+	9.8605396334619544e-01, 9.8630809724459867e-01, 9.8655991026477541e-01,
+	9.8680940181418542e-01, 9.8705657130575097e-01, 9.8730141815785843e-01,
+	9.8754394179435923e-01, 9.8778414164457218e-01, 9.8802201714328353e-01,
+	9.8825756773074946e-01, 9.8849079285269659e-01, 9.8872169196032378e-01,
+	9.8895026451030299e-01, 9.8917650996478101e-01, 9.8940042779138038e-01,
+	9.8962201746320078e-01, 9.8984127845882053e-01, 9.9005821026229712e-01,
+	9.9027281236316911e-01, 9.9048508425645698e-01, 9.9069502544266463e-01,
+	9.9090263542778001e-01, 9.9110791372327678e-01, 9.9131085984611544e-01,
+	9.9151147331874390e-01, 9.9170975366909953e-01, 9.9190570043060933e-01,
+	9.9209931314219180e-01, 9.9229059134825737e-01, 9.9247953459870997e-01,
+	9.9266614244894802e-01, 9.9285041445986510e-01, 9.9303235019785141e-01,
+	9.9321194923479450e-01, 9.9338921114808065e-01, 9.9356413552059530e-01,
+	9.9373672194072460e-01, 9.9390697000235606e-01, 9.9407487930487937e-01,
+	9.9424044945318790e-01, 9.9440368005767910e-01, 9.9456457073425542e-01,
+	9.9472312110432570e-01, 9.9487933079480562e-01, 9.9503319943811863e-01,
+	9.9518472667219682e-01, 9.9533391214048228e-01, 9.9548075549192694e-01,
+	9.9562525638099431e-01, 9.9576741446765982e-01, 9.9590722941741172e-01,
+	9.9604470090125197e-01, 9.9617982859569687e-01, 9.9631261218277800e-01,
+	9.9644305135004263e-01, 9.9657114579055484e-01, 9.9669689520289606e-01,
+	9.9682029929116567e-01, 9.9694135776498216e-01, 9.9706007033948296e-01,
+	9.9717643673532619e-01, 9.9729045667869021e-01, 9.9740212990127530e-01,
+	9.9751145614030345e-01, 9.9761843513851955e-01, 9.9772306664419164e-01,
+	9.9782535041111164e-01, 9.9792528619859600e-01, 9.9802287377148624e-01,
+	9.9811811290014918e-01, 9.9821100336047819e-01, 9.9830154493389289e-01,
+	9.9838973740734016e-01, 9.9847558057329477e-01, 9.9855907422975931e-01,
+	9.9864021818026527e-01, 9.9871901223387294e-01, 9.9879545620517241e-01,
+	9.9886954991428356e-01, 9.9894129318685687e-01, 9.9901068585407338e-01,
+	9.9907772775264536e-01, 9.9914241872481691e-01, 9.9920475861836389e-01,
+	9.9926474728659442e-01, 9.9932238458834954e-01, 9.9937767038800285e-01,
+	9.9943060455546173e-01, 9.9948118696616695e-01, 9.9952941750109314e-01,
+	9.9957529604674922e-01, 9.9961882249517864e-01, 9.9965999674395922e-01,
+	9.9969881869620425e-01, 9.9973528826056168e-01, 9.9976940535121528e-01,
+	9.9980116988788426e-01, 9.9983058179582340e-01, 9.9985764100582386e-01,
+	9.9988234745421256e-01, 9.9990470108285290e-01, 9.9992470183914450e-01,
+	9.9994234967602391e-01, 9.9995764455196390e-01, 9.9997058643097414e-01,
+	9.9998117528260111e-01, 9.9998941108192840e-01, 9.9999529380957619e-01,
+	9.9999882345170188e-01, 1.0000000000000000e+00
+};
+
+/* Returns true if 'n' is a power of two from 'min' to ZSL_FFT_MAX_N. */
+static inline bool
+zsl_fft_size_ok(size_t n, size_t min)
+{
+	return n >= min && n <= ZSL_FFT_MAX_N && (n & (n - 1)) == 0;
+}
+
+/*
+ * Sets 'wr' + 'wi' i to e^(-2 pi i m / ZSL_FFT_MAX_N), the twiddle factor
+ * for index 'm', where 0 <= m <= 3 * ZSL_FFT_MAX_N / 4.
+ */
+static inline void
+zsl_fft_twiddle(size_t m, zsl_real_t *wr, zsl_real_t *wi)
+{
+	const size_t q = ZSL_FFT_MAX_N / 4;
+
+	if (m <= q) {
+		*wr = zsl_fft_sin[q - m];
+		*wi = -zsl_fft_sin[m];
+	} else if (m <= 2 * q) {
+		*wr = -zsl_fft_sin[m - q];
+		*wi = -zsl_fft_sin[2 * q - m];
+	} else {
+		*wr = -zsl_fft_sin[3 * q - m];
+		*wi = zsl_fft_sin[m - 2 * q];
+	}
+}
+
+/*
+ * Computes the forward FFT of the 'n' complex values whose real and
+ * imaginary parts are at re[i * s] and im[i * s], in place. Interleaved
+ * data is handled with 's' = 2, and split data with 's' = 1.
+ */
+static void
+zsl_fft_run(zsl_real_t *re, zsl_real_t *im, size_t s, size_t n)
+{
+	size_t j = 0;
+	size_t l;
+	size_t step;
+	size_t p0, p1, p2, p3;
+	zsl_real_t x;
+	zsl_real_t w1r, w1i, w2r, w2i, w3r, w3i;
+	zsl_real_t t1r, t1i, t2r, t2i, t3r, t3i;
+	zsl_real_t s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i;
+
+	/* Put the input into bit-reversed order. */
+	for (size_t i = 1; i < n; i++) {
+		size_t bit = n >> 1;
+
+		while (j & bit) {
+			j ^= bit;
+			bit >>= 1;
+		}
+		j |= bit;
+		if (i < j) {
+			x = re[i * s];
+			re[i * s] = re[j * s];
+			re[j * s] = x;
+			x = im[i * s];
+			im[i * s] = im[j * s];
+			im[j * s] = x;
+		}
+	}
+
+	/* A radix-2 stage first if log2(n) is odd, so the rest are radix-4. */
+	l = 1;
+	if (n & 0xAAAAAAAAu) {
+		for (size_t g = 0; g < n; g += 2) {
+			p0 = g * s;
+			p1 = p0 + s;
+			x = re[p1];
+			re[p1] = re[p0] - x;
+			re[p0] += x;
+			x = im[p1];
+			im[p1] = im[p0] - x;
+			im[p0] += x;
+		}
+		l = 2;
+	}
+
+	/*
+	 * Each radix-4 stage combines four transforms of size 'l' into one of
+	 * size 4 * l. Following bit reversal, the blocks at offsets 0, l, 2l
+	 * and 3l of each group hold the transforms of the inputs whose indices
+	 * are 0, 2, 1 and 3 mod 4 respectively.
+	 */
+	for (; l < n; l <<= 2) {
+		step = ZSL_FFT_MAX_N / (4 * l);
+		for (size_t k = 0; k < l; k++) {
+			zsl_fft_twiddle(k * step, &w1r, &w1i);
+			zsl_fft_twiddle(2 * k * step, &w2r, &w2i);
+			zsl_fft_twiddle(3 * k * step, &w3r, &w3i);
+
+			for (size_t g = k; g < n; g += 4 * l) {
+				p0 = g * s;
+				p1 = p0 + l * s;
+				p2 = p1 + l * s;
+				p3 = p2 + l * s;
+
+				t1r = re[p2] * w1r - im[p2] * w1i;
+				t1i = re[p2] * w1i + im[p2] * w1r;
+				t2r = re[p1] * w2r - im[p1] * w2i;
+				t2i = re[p1] * w2i + im[p1] * w2r;
+				t3r = re[p3] * w3r - im[p3] * w3i;
+				t3i = re[p3] * w3i + im[p3] * w3r;
+
+				s0r = re[p0] + t2r;
+				s0i = im[p0] + t2i;
+				s1r = re[p0] - t2r;
+				s1i = im[p0] - t2i;
+				s2r = t1r + t3r;
+				s2i = t1i + t3i;
+				s3r = t1r - t3r;
+				s3i = t1i - t3i;
+
+				/* X[k + l] = s1 - i s3,
+				 * X[k + 3l] = s1 + i s3 */
+				re[p0] = s0r + s2r;
+				im[p0] = s0i + s2i;
+				re[p1] = s1r + s3i;
+				im[p1] = s1i - s3r;
+				re[p2] = s0r - s2r;
+				im[p2] = s0i - s2i;
+				re[p3] = s1r - s3i;
+				im[p3] = s1i + s3r;
+			}
+		}
+	}
+}
+
+/*
+ * Computes the inverse FFT as conj(FFT(conj(x))) / n, so a single set of
+ * butterflies serves both directions.
+ */
+static void
+zsl_ifft_run(zsl_real_t *re, zsl_real_t *im, size_t s, size_t n)
+{
+	zsl_real_t scale = 1.0 / (zsl_real_t)n;
+
+	for (size_t i = 0; i < n; i++) {
+		im[i * s] = -im[i * s];
+	}
+
+	zsl_fft_run(re, im, s, n);
+
+	for (size_t i = 0; i < n; i++) {
+		re[i * s] *= scale;
+		im[i * s] *= -scale;
+	}
+}
+
+/*
+ * The 'n' real values in 'v' are transformed as the n / 2 complex values
+ * z[j] = v[2j] + v[2j + 1] i, whose transform Z holds the transforms of the
+ * even and odd samples, E[k] = (Z[k] + conj(Z[n/2 - k])) / 2 and
+ * O[k] = (Z[k] - conj(Z[n/2 - k])) / 2i. The two are combined into
+ * X[k] = E[k] + W^k O[k] and X[n/2 - k] = conj(E[k] - W^k O[k]), where
+ * W = e^(-2 pi i / n). The inverse undoes each step in reverse order.
+ */
+static void
+zsl_fft_real_c(struct zsl_vec *v, bool inverse)
+{
+	size_t n = v->sz / 2;
+	size_t step = ZSL_FFT_MAX_N / v->sz;
+	zsl_real_t *d = v->data;
+	zsl_real_t ar, ai, br, bi, er, ei, fr, fi, wr, wi, tr, ti;
+
+	if (!inverse) {
+		zsl_fft_run(d, d + 1, 2, n);
+
+		ar = d[0];
+		d[0] = ar + d[1];
+		d[1] = ar - d[1];
+	} else {
+		ar = d[0];
+		d[0] = (ar + d[1]) / 2.0;
+		d[1] = (ar - d[1]) / 2.0;
+	}
+
+	for (size_t k = 1, j = n - 1; k <= j; k++, j--) {
+		ar = d[2 * k];
+		ai = d[2 * k + 1];
+		br = d[2 * j];
+		bi = -d[2 * j + 1];
+		er = (ar + br) / 2.0;
+		ei = (ai + bi) / 2.0;
+		fr = (ar - br) / 2.0;
+		fi = (ai - bi) / 2.0;
+		zsl_fft_twiddle(k * step, &wr, &wi);
+
+		if (!inverse) {
+			/* t = -i * W^k * f */
+			tr = wr * fi + wi * fr;
+			ti = wi * fi - wr * fr;
+		} else {
+			/* t = i * conj(W^k) * f */
+			tr = wi * fr - wr * fi;
+			ti = wr * fr + wi * fi;
+		}
+
+		d[2 * k] = er + tr;
+		d[2 * k + 1] = ei + ti;
+		d[2 * j] = er - tr;
+		d[2 * j + 1] = ti - ei;
+	}
+
+	if (inverse) {
+		zsl_ifft_run(d, d + 1, 2, n);
+	}
+}
+
+int
+zsl_fft_cplx(struct zsl_cvec *v)
+{
+	if (!zsl_fft_size_ok(v->sz, 1)) {
+		return -EINVAL;
+	}
+
+	zsl_fft_run(v->re, v->im, 1, v->sz);
+
+	return 0;
+}
+
+int
+zsl_ifft_cplx(struct zsl_cvec *v)
+{
+	if (!zsl_fft_size_ok(v->sz, 1)) {
+		return -EINVAL;
+	}
+
+	zsl_ifft_run(v->re, v->im, 1, v->sz);
+
+	return 0;
+}
+
+#if !asm_fft_real
+int
+zsl_fft_real(struct zsl_vec *v)
+{
+	if (!zsl_fft_size_ok(v->sz, 2)) {
+		return -EINVAL;
+	}
+
+	zsl_fft_real_c(v, false);
+
+	return 0;
+}
+
+int
+zsl_ifft_real(struct zsl_vec *v)
+{
+	if (!zsl_fft_size_ok(v->sz, 2)) {
+		return -EINVAL;
+	}
+
+	zsl_fft_real_c(v, true);
+
+	return 0;
+}
+#endif
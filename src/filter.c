@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/filter.h>
+
+/* Enable optimised host SIMD kernels if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 4)
+#include <zsl/asm/host/asm_host.h>
+#endif
+
+/* Returns the dot product of the 'n' element arrays 'a' and 'b'. */
+static inline zsl_real_t
+zsl_flt_dot(const zsl_real_t *a, const zsl_real_t *b, size_t n)
+{
+#if ZSL_ASM_HOST_SIMD
+	return asm_host_dot(a, b, n);
+#else
+	zsl_real_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+	size_t i = 0;
+
+	/* Independent accumulators, so each add doesn't wait on the last. */
+	for (; i + 4 <= n; i += 4) {
+		s0 += a[i] * b[i];
+		s1 += a[i + 1] * b[i + 1];
+		s2 += a[i + 2] * b[i + 2];
+		s3 += a[i + 3] * b[i + 3];
+	}
+	for (; i < n; i++) {
+		s0 += a[i] * b[i];
+	}
+
+	return (s0 + s1) + (s2 + s3);
+#endif
+}
+
+/* Accumulates y += s * x for the 'n' element arrays 'x' and 'y'. */
+static inline void
+zsl_flt_axpy(const zsl_real_t *x, zsl_real_t s, zsl_real_t *y, size_t n)
+{
+#if ZSL_ASM_HOST_SIMD
+	asm_host_axpy(x, s, y, n);
+#else
+	for (size_t i = 0; i < n; i++) {
+		y[i] += s * x[i];
+	}
+#endif
+}
+
+/*
+ * Adds the row of samples at 'x' to the delay line of 'f', which holds the
+ * most recent 'len' rows. Each row is written twice, 'len' rows apart, so
+ * rows 'pos' to 'pos + len - 1' always hold the history, newest first.
+ */
+static inline void
+zsl_fir_push(struct zsl_fir *f, size_t len, const zsl_real_t *x)
+{
+	size_t ch = f->channels;
+	zsl_real_t *d;
+
+	f->pos = (f->pos == 0) ? len - 1 : f->pos - 1;
+	d = &f->state[f->pos * ch];
+	for (size_t c = 0; c < ch; c++) {
+		d[c] = x[c];
+		d[len * ch + c] = x[c];
+	}
+}
+
+/*
+ * Sets the row y[c] = sum(h[k * hs] * x[k * ch + c]) for k < n. A single
+ * channel is a dot product, while several channels accumulate one row of
+ * the history at a time, running the inner loop across channels.
+ */
+static void
+zsl_fir_row(const zsl_real_t *h, size_t hs, size_t n, const zsl_real_t *x,
+	    size_t ch, zsl_real_t *y)
+{
+	if (ch == 1 && hs == 1) {
+		*y = zsl_flt_dot(h, x, n);
+		return;
+	}
+
+	for (size_t c = 0; c < ch; c++) {
+		y[c] = 0.0;
+	}
+	for (size_t k = 0; k < n; k++) {
+		zsl_flt_axpy(&x[k * ch], h[k * hs], y, ch);
+	}
+}
+
+int
+zsl_fir_init(struct zsl_fir *f)
+{
+	if ((f->taps == 0) || (f->channels == 0)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < 2 * f->taps * f->channels; i++) {
+		f->state[i] = 0.0;
+	}
+	f->pos = 0;
+
+	return 0;
+}
+
+int
+zsl_fir_process(struct zsl_fir *f, struct zsl_vec *v)
+{
+	size_t ch = f->channels;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ch == 0) || (v->sz % ch != 0)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i += ch) {
+		zsl_fir_push(f, f->taps, &v->data[i]);
+		zsl_fir_row(f->h, 1, f->taps, &f->state[f->pos * ch], ch,
+			    &v->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_fir_decim(struct zsl_fir *f, size_t m, const struct zsl_vec *v,
+	      struct zsl_vec *w)
+{
+	size_t ch = f->channels;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ch == 0) || (m == 0) || (v->sz % (m * ch) != 0) ||
+	    (w->sz != v->sz / m)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Output row 'j' is written after input row 'j * m' has been read, so
+	 * 'w' can be 'v'. */
+	for (size_t j = 0; j < w->sz; j += ch) {
+		for (size_t r = 0; r < m; r++) {
+			zsl_fir_push(f, f->taps, &v->data[j * m + r * ch]);
+		}
+		zsl_fir_row(f->h, 1, f->taps, &f->state[f->pos * ch], ch,
+			    &w->data[j]);
+	}
+
+	return 0;
+}
+
+int
+zsl_fir_interp(struct zsl_fir *f, size_t l, const struct zsl_vec *v,
+	       struct zsl_vec *w)
+{
+	size_t ch = f->channels;
+	size_t q;
+	size_t n;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ch == 0) || (l == 0) || (v->sz % ch != 0) ||
+	    (w->sz != v->sz * l) || (v->data == w->data)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Output phase 'p' only uses coefficients p, p + l, p + 2l, ..., so
+	 * ceil(taps / l) inputs are enough. */
+	q = (f->taps + l - 1) / l;
+	if (f->pos >= q) {
+		f->pos = 0;
+	}
+
+	for (size_t i = 0; i < v->sz; i += ch) {
+		zsl_fir_push(f, q, &v->data[i]);
+		for (size_t p = 0; p < l; p++) {
+			n = (p < f->taps) ? (f->taps - p + l - 1) / l : 0;
+			zsl_fir_row(&f->h[p], l, n, &f->state[f->pos * ch], ch,
+				    &w->data[i * l + p * ch]);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_iir_init(struct zsl_iir *f)
+{
+	if (f->channels == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < 2 * f->stages * f->channels; i++) {
+		f->state[i] = 0.0;
+	}
+
+	return 0;
+}
+
+int
+zsl_iir_process(struct zsl_iir *f, struct zsl_vec *v)
+{
+	size_t ch = f->channels;
+	zsl_real_t x, y;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ch == 0) || (v->sz % ch != 0)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t s = 0; s < f->stages; s++) {
+		const zsl_real_t b0 = f->coeffs[s].b0;
+		const zsl_real_t b1 = f->coeffs[s].b1;
+		const zsl_real_t b2 = f->coeffs[s].b2;
+		const zsl_real_t a1 = f->coeffs[s].a1;
+		const zsl_real_t a2 = f->coeffs[s].a2;
+		zsl_real_t *z1 = &f->state[2 * s * ch];
+		zsl_real_t *z2 = &f->state[(2 * s + 1) * ch];
+
+		if (ch == 1) {
+			/* Keep the state in registers across the block. */
+			zsl_real_t s1 = *z1;
+			zsl_real_t s2 = *z2;
+
+			for (size_t i = 0; i < v->sz; i++) {
+				x = v->data[i];
+				y = b0 * x + s1;
+				s1 = b1 * x - a1 * y + s2;
+				s2 = b2 * x - a2 * y;
+				v->data[i] = y;
+			}
+			*z1 = s1;
+			*z2 = s2;
+			continue;
+		}
+
+		/* The channels are independent, so this loop vectorises. */
+		for (size_t i = 0; i < v->sz; i += ch) {
+			zsl_real_t *row = &v->data[i];
+
+			for (size_t c = 0; c < ch; c++) {
+				x = row[c];
+				y = b0 * x + z1[c];
+				z1[c] = b1 * x - a1 * y + z2[c];
+				z2[c] = b2 * x - a2 * y;
+				row[c] = y;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/fixed.h>
+
+/*
+ * Products of two Q31 values are Q62. These are shifted down to a Q48
+ * accumulator before being summed, leaving 15 guard bits so that 2^15
+ * full-scale products can be accumulated without overflow.
+ */
+#define ZSL_Q31_ACC_SHIFT 14
+
+/** Returns the Q48 product of the Q31 values 'a' and 'b'. */
+static inline int64_t
+zsl_q31_acc_mul(zsl_q31_t a, zsl_q31_t b)
+{
+	return ((int64_t)a * b) >> ZSL_Q31_ACC_SHIFT;
+}
+
+/** Rounds and saturates the Q48 accumulator 'acc' to Q31. */
+static inline zsl_q31_t
+zsl_q31_acc_sat(int64_t acc)
+{
+	const int sh = 31 - ZSL_Q31_ACC_SHIFT;
+
+	return zsl_q31_sat((acc + (1LL << (sh - 1))) >> sh);
+}
+
+/** Returns floor(sqrt(x)). */
+static uint32_t
+zsl_q31_isqrt(uint64_t x)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > x) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (x >= res + bit) {
+			x -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+/** Returns the Q31 norm of a vector, from its Q48 sum of squares. */
+static zsl_q31_t
+zsl_q31_norm_acc(uint64_t acc)
+{
+	/* The norm is at least 1.0. */
+	if (acc >= (1ULL << 48)) {
+		return ZSL_Q31_MAX;
+	}
+
+	/* sqrt(Q62) is Q31, and acc < 2^48 so the result is < 2^31. */
+	return (zsl_q31_t)zsl_q31_isqrt(acc << ZSL_Q31_ACC_SHIFT);
+}
+
+zsl_q31_t
+zsl_q31_from_real(zsl_real_t x)
+{
+	if (x >= 1.0) {
+		return ZSL_Q31_MAX;
+	}
+	if (x <= -1.0) {
+		return ZSL_Q31_MIN;
+	}
+	/* Also catches NaN values. */
+	if (!(x == x)) {
+		return 0;
+	}
+
+	return zsl_q31_sat((int64_t)ZSL_ROUND(x * (zsl_real_t)2147483648.0));
+}
+
+zsl_real_t
+zsl_q31_to_real(zsl_q31_t q)
+{
+	return (zsl_real_t)q / (zsl_real_t)2147483648.0;
+}
+
+int
+zsl_vec_q31_from_vec(struct zsl_vec *v, struct zsl_vec_q31 *q)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != q->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		q->data[i] = zsl_q31_from_real(v->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_to_vec(struct zsl_vec_q31 *q, struct zsl_vec *v)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != q->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < q->sz; i++) {
+		v->data[i] = zsl_q31_to_real(q->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_add(v->data[i], w->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_sub(v->data[i], w->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_neg(struct zsl_vec_q31 *v)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q31_sat(-(int64_t)v->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q31_mul(v->data[i], s);
+	}
+
+	return 0;
+}
+
+int
+zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w, zsl_q31_t *d)
+{
+	int64_t acc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		acc += zsl_q31_acc_mul(v->data[i], w->data[i]);
+	}
+
+	*d = zsl_q31_acc_sat(acc);
+
+	return 0;
+}
+
+zsl_q31_t
+zsl_vec_q31_norm(struct zsl_vec_q31 *v)
+{
+	uint64_t acc = 0;
+
+	for (size_t i = 0; i < v->sz; i++) {
+		acc += (uint64_t)zsl_q31_acc_mul(v->data[i], v->data[i]);
+	}
+
+	return zsl_q31_norm_acc(acc);
+}
+
+int
+zsl_mtx_q31_from_mtx(struct zsl_mtx *m, struct zsl_mtx_q31 *q)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != q->sz_rows) || (m->sz_cols != q->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		q->data[i] = zsl_q31_from_real(m->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_to_mtx(struct zsl_mtx_q31 *q, struct zsl_mtx *m)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != q->sz_rows) || (m->sz_cols != q->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < q->sz_rows * q->sz_cols; i++) {
+		m->data[i] = zsl_q31_to_real(q->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_add(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		struct zsl_mtx_q31 *mc)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows * ma->sz_cols; i++) {
+		mc->data[i] = zsl_q31_add(ma->data[i], mb->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_sub(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		struct zsl_mtx_q31 *mc)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols) ||
+	    (ma->sz_rows != mc->sz_rows) || (ma->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows * ma->sz_cols; i++) {
+		mc->data[i] = zsl_q31_sub(ma->data[i], mb->data[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_mult(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb,
+		 struct zsl_mtx_q31 *mc)
+{
+	const size_t p = ma->sz_cols;
+	const size_t n = mb->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma has the same number as columns as mb has rows. */
+	if (ma->sz_cols != mb->sz_rows) {
+		return -EINVAL;
+	}
+
+	/* Ensure that mc has ma rows and mb cols */
+	if ((mc->sz_rows != ma->sz_rows) || (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < n; j++) {
+			int64_t acc = 0;
+			for (size_t k = 0; k < p; k++) {
+				acc += zsl_q31_acc_mul(ma->data[i * p + k],
+						       mb->data[k * n + j]);
+			}
+			mc->data[i * n + j] = zsl_q31_acc_sat(acc);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_scalar_mult(struct zsl_mtx_q31 *m, zsl_q31_t s)
+{
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		m->data[i] = zsl_q31_mul(m->data[i], s);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_q31_trans(struct zsl_mtx_q31 *ma, struct zsl_mtx_q31 *mb)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma and mb have the same shape. */
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < ma->sz_cols; j++) {
+			mb->data[j * mb->sz_cols + i] =
+				ma->data[i * ma->sz_cols + j];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_quat_q31_from_quat(struct zsl_quat *q, struct zsl_quat_q31 *qq)
+{
+	qq->r = zsl_q31_from_real(q->r);
+	qq->i = zsl_q31_from_real(q->i);
+	qq->j = zsl_q31_from_real(q->j);
+	qq->k = zsl_q31_from_real(q->k);
+
+	return 0;
+}
+
+int
+zsl_quat_q31_to_quat(struct zsl_quat_q31 *qq, struct zsl_quat *q)
+{
+	q->r = zsl_q31_to_real(qq->r);
+	q->i = zsl_q31_to_real(qq->i);
+	q->j = zsl_q31_to_real(qq->j);
+	q->k = zsl_q31_to_real(qq->k);
+
+	return 0;
+}
+
+zsl_q31_t
+zsl_quat_q31_magn(struct zsl_quat_q31 *q)
+{
+	uint64_t acc;
+
+	acc = (uint64_t)zsl_q31_acc_mul(q->r, q->r) +
+	      (uint64_t)zsl_q31_acc_mul(q->i, q->i) +
+	      (uint64_t)zsl_q31_acc_mul(q->j, q->j) +
+	      (uint64_t)zsl_q31_acc_mul(q->k, q->k);
+
+	return zsl_q31_norm_acc(acc);
+}
+
+int
+zsl_quat_q31_to_unit(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qn)
+{
+	uint64_t acc;
+	int64_t m;
+
+	/* The magnitude of a unit quaternion is 1.0, which isn't a Q31 value,
+	 * so compute it in Q30 from a Q60 sum of squares. */
+	acc = (((uint64_t)((int64_t)q->r * q->r)) >> 2) +
+	      (((uint64_t)((int64_t)q->i * q->i)) >> 2) +
+	      (((uint64_t)((int64_t)q->j * q->j)) >> 2) +
+	      (((uint64_t)((int64_t)q->k * q->k)) >> 2);
+	m = (int64_t)zsl_q31_isqrt(acc);
+
+	if (m == 0) {
+		qn->r = 0;
+		qn->i = 0;
+		qn->j = 0;
+		qn->k = 0;
+	} else {
+		/* (q << 30) / Q30 magnitude yields Q31. */
+		qn->r = zsl_q31_sat(((int64_t)q->r * (1LL << 30)) / m);
+		qn->i = zsl_q31_sat(((int64_t)q->i * (1LL << 30)) / m);
+		qn->j = zsl_q31_sat(((int64_t)q->j * (1LL << 30)) / m);
+		qn->k = zsl_q31_sat(((int64_t)q->k * (1LL << 30)) / m);
+	}
+
+	return 0;
+}
+
+int
+zsl_quat_q31_scale(struct zsl_quat_q31 *q, zsl_q31_t s,
+		   struct zsl_quat_q31 *qs)
+{
+	qs->r = zsl_q31_mul(q->r, s);
+	qs->i = zsl_q31_mul(q->i, s);
+	qs->j = zsl_q31_mul(q->j, s);
+	qs->k = zsl_q31_mul(q->k, s);
+
+	return 0;
+}
+
+int
+zsl_quat_q31_mult(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		  struct zsl_quat_q31 *qm)
+{
+	int64_t r, i, j, k;
+
+	r = zsl_q31_acc_mul(qa->r, qb->r) - zsl_q31_acc_mul(qa->i, qb->i) -
+	    zsl_q31_acc_mul(qa->j, qb->j) - zsl_q31_acc_mul(qa->k, qb->k);
+	i = zsl_q31_acc_mul(qa->r, qb->i) + zsl_q31_acc_mul(qa->i, qb->r) +
+	    zsl_q31_acc_mul(qa->j, qb->k) - zsl_q31_acc_mul(qa->k, qb->j);
+	j = zsl_q31_acc_mul(qa->r, qb->j) - zsl_q31_acc_mul(qa->i, qb->k) +
+	    zsl_q31_acc_mul(qa->j, qb->r) + zsl_q31_acc_mul(qa->k, qb->i);
+	k = zsl_q31_acc_mul(qa->r, qb->k) + zsl_q31_acc_mul(qa->i, qb->j) -
+	    zsl_q31_acc_mul(qa->j, qb->i) + zsl_q31_acc_mul(qa->k, qb->r);
+
+	/* Assign after computing every term, so qm may alias qa or qb. */
+	qm->r = zsl_q31_acc_sat(r);
+	qm->i = zsl_q31_acc_sat(i);
+	qm->j = zsl_q31_acc_sat(j);
+	qm->k = zsl_q31_acc_sat(k);
+
+	return 0;
+}
+
+int
+zsl_quat_q31_conj(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qc)
+{
+	qc->r = q->r;
+	qc->i = zsl_q31_sat(-(int64_t)q->i);
+	qc->j = zsl_q31_sat(-(int64_t)q->j);
+	qc->k = zsl_q31_sat(-(int64_t)q->k);
+
+	return 0;
+}
+
+int
+zsl_interp_lin_y_arr_q31(struct zsl_interp_xy_q31 xy[], size_t n,
+			 zsl_q31_t x, zsl_q31_t *y)
+{
+	size_t lo = 0;
+	size_t hi;
+	int order;
+	int64_t dx, t;
+
+	*y = 0;
+
+	/* Make sure we have an appropriately large dataset. */
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	/* Determine order (1 = ascending, 0 = descending). */
+	order = (xy[n - 1].x >= xy[0].x);
+
+	/* xy[0] and xy[n-1] bounds checks. */
+	if ((order && ((x < xy[0].x) || (x > xy[n - 1].x))) ||
+	    (!order && ((x > xy[0].x) || (x < xy[n - 1].x)))) {
+		return -EINVAL;
+	}
+
+	/* Find the segment [lo, lo + 1] containing x. */
+	hi = n - 1;
+	while (hi - lo > 1) {
+		size_t mid = (lo + hi) >> 1;
+		if ((order && x >= xy[mid].x) || (!order && x <= xy[mid].x)) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	/* Make sure there is a delta on x between the two points. */
+	dx = (int64_t)xy[lo + 1].x - xy[lo].x;
+	if (dx == 0) {
+		return -EINVAL;
+	}
+
+	/*
+	 * The position of x within the segment is t = (x - x1) / (x3 - x1)
+	 * in Q30, and y2 = y1 + t * (y3 - y1). Both products fit in 63 bits.
+	 */
+	t = (((int64_t)x - xy[lo].x) * (1LL << 30)) / dx;
+	*y = zsl_q31_sat(xy[lo].y +
+			 ((((int64_t)xy[lo + 1].y - xy[lo].y) * t) >> 30));
+
+	return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/instrument.h>
+
+#if CONFIG_ZSL_INSTRUMENT || CONFIG_ZSL_TRACE
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#include <spinlock.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __ZEPHYR__
+static struct k_spinlock zsl_instr_lock;
+#define ZSL_INSTR_LOCK() k_spinlock_key_t key = k_spin_lock(&zsl_instr_lock)
+#define ZSL_INSTR_UNLOCK() k_spin_unlock(&zsl_instr_lock, key)
+#else
+#define ZSL_INSTR_LOCK()
+#define ZSL_INSTR_UNLOCK()
+#endif
+#endif
+
+#if CONFIG_ZSL_INSTRUMENT
+/* The innermost call in progress and the scratch memory in use are kept
+ * per thread where the kernel supports it. Otherwise, instrumented
+ * functions should only be profiled from one thread at a time. */
+#if defined(CONFIG_THREAD_LOCAL_STORAGE)
+#define ZSL_INSTR_LOCAL __thread
+#else
+#define ZSL_INSTR_LOCAL
+#endif
+
+static ZSL_INSTR_LOCAL struct zsl_instr_frame *zsl_instr_top;
+static ZSL_INSTR_LOCAL size_t zsl_instr_live;
+
+/* The records of every function called so far. */
+static struct zsl_instr_rec *zsl_instr_list;
+
+/* Not inlined, so the local is placed below the caller's frame. */
+static void __attribute__((noinline))
+zsl_instr_sample(void)
+{
+	volatile uint8_t here = 0;
+	uintptr_t sp = (uintptr_t)&here;
+
+	for (struct zsl_instr_frame *f = zsl_instr_top; f; f = f->up) {
+		if (sp < f->sp_min) {
+			f->sp_min = sp;
+		}
+		if (zsl_instr_live > f->scratch0 &&
+		    zsl_instr_live - f->scratch0 > f->scratch_max) {
+			f->scratch_max = zsl_instr_live - f->scratch0;
+		}
+	}
+}
+
+void
+zsl_instr_enter(struct zsl_instr_frame *f)
+{
+	f->sp_min = f->sp0;
+	f->scratch0 = zsl_instr_live;
+	f->scratch_max = 0;
+	f->up = zsl_instr_top;
+	zsl_instr_top = f;
+
+	zsl_instr_sample();
+}
+
+void
+zsl_instr_exit(struct zsl_instr_frame *f)
+{
+	struct zsl_instr_rec *rec = f->rec;
+
+	zsl_instr_sample();
+	zsl_instr_top = f->up;
+
+	ZSL_INSTR_LOCK();
+	if (!rec->listed) {
+		rec->next = zsl_instr_list;
+		zsl_instr_list = rec;
+		rec->listed = true;
+	}
+	rec->calls++;
+	if (f->sp0 - f->sp_min > rec->stack) {
+		rec->stack = f->sp0 - f->sp_min;
+	}
+	if (f->scratch_max > rec->scratch) {
+		rec->scratch = f->scratch_max;
+	}
+	ZSL_INSTR_UNLOCK();
+}
+
+void
+zsl_instr_scratch(ptrdiff_t delta)
+{
+	if (delta < 0 && (size_t)-delta > zsl_instr_live) {
+		/* Memory allocated before the first instrumented call. */
+		zsl_instr_live = 0;
+	} else {
+		zsl_instr_live += delta;
+	}
+
+	zsl_instr_sample();
+}
+
+const struct zsl_instr_rec *
+zsl_instr_first(void)
+{
+	return zsl_instr_list;
+}
+
+const struct zsl_instr_rec *
+zsl_instr_find(const char *name)
+{
+	for (struct zsl_instr_rec *r = zsl_instr_list; r; r = r->next) {
+		if (strcmp(r->name, name) == 0) {
+			return r;
+		}
+	}
+
+	return NULL;
+}
+
+void
+zsl_instr_reset(void)
+{
+	ZSL_INSTR_LOCK();
+	for (struct zsl_instr_rec *r = zsl_instr_list; r; r = r->next) {
+		r->calls = 0;
+		r->stack = 0;
+		r->scratch = 0;
+	}
+	ZSL_INSTR_UNLOCK();
+}
+#endif /* CONFIG_ZSL_INSTRUMENT */
+
+#if CONFIG_ZSL_TRACE
+static const char *zsl_trace_names[ZSL_TRACE_COUNT] = {
+	[ZSL_TRACE_MTX_MULT] = "zsl_mtx_mult",
+	[ZSL_TRACE_MTX_SVD] = "zsl_mtx_svd",
+	[ZSL_TRACE_MTX_EIGENVALUES] = "zsl_mtx_eigenvalues",
+	[ZSL_TRACE_FUS_FEED] = "zsl_fus_feed",
+	[ZSL_TRACE_CLR_CONV_SPD_XYZ] = "zsl_clr_conv_spd_xyz",
+};
+
+#if CONFIG_ZSL_TRACE_HIST
+static struct zsl_trace_stats zsl_trace_hist[ZSL_TRACE_COUNT];
+#endif
+
+/* The hardware cycle counter, or nanoseconds outside of Zephyr. */
+static inline uint32_t
+zsl_trace_cycles(void)
+{
+#ifdef __ZEPHYR__
+	return k_cycle_get_32();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+void __attribute__((weak))
+zsl_trace_hook_enter(enum zsl_trace_id id)
+{
+	(void)id;
+}
+
+void __attribute__((weak))
+zsl_trace_hook_exit(enum zsl_trace_id id, uint32_t cycles)
+{
+	(void)id;
+	(void)cycles;
+}
+
+const char *
+zsl_trace_name(enum zsl_trace_id id)
+{
+	if ((unsigned int)id >= ZSL_TRACE_COUNT) {
+		return NULL;
+	}
+
+	return zsl_trace_names[id];
+}
+
+struct zsl_trace_span
+zsl_trace_begin(enum zsl_trace_id id)
+{
+	struct zsl_trace_span s = { .id = id };
+
+	zsl_trace_hook_enter(id);
+	s.t0 = zsl_trace_cycles();
+
+	return s;
+}
+
+void
+zsl_trace_end(struct zsl_trace_span *s)
+{
+	/* Unsigned subtraction handles a single counter wrap. */
+	uint32_t cycles = zsl_trace_cycles() - s->t0;
+
+	zsl_trace_hook_exit(s->id, cycles);
+
+#if CONFIG_ZSL_TRACE_HIST
+	struct zsl_trace_stats *st = &zsl_trace_hist[s->id];
+	unsigned int bin = cycles > 1 ? 31 - __builtin_clz(cycles) : 0;
+
+	ZSL_INSTR_LOCK();
+	if (st->calls == 0 || cycles < st->min) {
+		st->min = cycles;
+	}
+	if (cycles > st->max) {
+		st->max = cycles;
+	}
+	st->calls++;
+	st->total += cycles;
+	st->hist[bin]++;
+	ZSL_INSTR_UNLOCK();
+#endif
+}
+
+#if CONFIG_ZSL_TRACE_HIST
+int
+zsl_trace_stats(enum zsl_trace_id id, struct zsl_trace_stats *st)
+{
+	if ((unsigned int)id >= ZSL_TRACE_COUNT) {
+		return -EINVAL;
+	}
+
+	ZSL_INSTR_LOCK();
+	*st = zsl_trace_hist[id];
+	ZSL_INSTR_UNLOCK();
+
+	return 0;
+}
+
+void
+zsl_trace_reset(void)
+{
+	ZSL_INSTR_LOCK();
+	memset(zsl_trace_hist, 0, sizeof(zsl_trace_hist));
+	ZSL_INSTR_UNLOCK();
+}
+#endif
+#endif /* CONFIG_ZSL_TRACE */
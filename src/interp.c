@@ -6,9 +6,19 @@
 
 #include <math.h>
 #include <errno.h>
-#include <kernel.h>
 #include <zsl/zsl.h>
 #include <zsl/interp.h>
+#include <zsl/workspace.h>
+
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#define ZSL_INTERP_MALLOC(sz) k_malloc(sz)
+#define ZSL_INTERP_FREE(p) k_free(p)
+#else
+#include <stdlib.h>
+#define ZSL_INTERP_MALLOC(sz) malloc(sz)
+#define ZSL_INTERP_FREE(p) free(p)
+#endif
 
 int
 zsl_interp_lerp(zsl_real_t v0, zsl_real_t v1, zsl_real_t t, zsl_real_t *v)
@@ -269,7 +279,7 @@ zsl_interp_cubic_calc(struct zsl_interp_xyc xyc[], size_t n, zsl_real_t yp1,
 		goto err;
 	}
 
-	u = (zsl_real_t *)k_malloc((n - 1) * sizeof(zsl_real_t));
+	u = (zsl_real_t *)ZSL_INTERP_MALLOC((n - 1) * sizeof(zsl_real_t));
 	if (u == NULL) {
 		rc = -ENOMEM;
 		goto err;
@@ -311,13 +321,40 @@ zsl_interp_cubic_calc(struct zsl_interp_xyc xyc[], size_t n, zsl_real_t yp1,
 		xyc[k].y2 = xyc[k].y2 * xyc[k + 1].y2 + u[k];
 	}
 
-	k_free(u);
+	ZSL_INTERP_FREE(u);
 
 	return 0;
 err:
 	return rc;
 }
 
+/* Evaluates the spline of xyc between xyc[klo] and xyc[khi] at x. */
+static int
+zsl_interp_cubic_eval(struct zsl_interp_xyc xyc[], int klo, int khi,
+		      zsl_real_t x, zsl_real_t *y)
+{
+	zsl_real_t h;           /* xyc[j+1].x - xyc[j].x */
+	zsl_real_t a;           /* (xyc[j+1].x - x) / h */
+	zsl_real_t b;           /* (x - xyc[j].x) / h */
+
+	h = xyc[khi].x - xyc[klo].x;
+	if (h == 0) {
+		/* No diff = invalid x input! */
+		return -EINVAL;
+	}
+
+	/* Calculate coefficients for hi-x (a) and x-lo (b). */
+	a = (xyc[khi].x - x) / h;
+	b = (x - xyc[klo].x) / h;
+
+	/* Interpolate for y based on a, b using prev. calculated y2 vals. */
+	*y = a * xyc[klo].y + b * xyc[khi].y +
+	     ((a * a * a - a) * xyc[klo].y2 + (b * b * b - b) *
+	      xyc[khi].y2) * (h * h) / 6.0f;
+
+	return 0;
+}
+
 int
 zsl_interp_cubic_arr(struct zsl_interp_xyc xyc[], size_t n,
 		 zsl_real_t x, zsl_real_t *y)
@@ -328,9 +365,6 @@ zsl_interp_cubic_arr(struct zsl_interp_xyc xyc[], size_t n,
 	int khi;                /* Array index value for high point. */
 	static int pklo;        /* Per. low pnt for repeat bisection search. */
 	static int pkhi;        /* Per. high pnt for repeat bisection search. */
-	zsl_real_t h;           /* xyc[j+1].x - xyc[j].x */
-	zsl_real_t a;           /* (xyc[j+1].x - x) / h */
-	zsl_real_t b;           /* (x - xyc[j].x) / h */
 
 	pklo = 0;
 	pkhi = 1;
@@ -378,23 +412,842 @@ zsl_interp_cubic_arr(struct zsl_interp_xyc xyc[], size_t n,
 		pkhi = khi;
 	}
 
-	h = xyc[khi].x - xyc[klo].x;
-	if (h == 0) {
-		/* No diff = invalid x input! */
+	return zsl_interp_cubic_eval(xyc, klo, khi, x, y);
+err:
+	return rc;
+}
+
+/* The x value of element i of a table of 'stride'-byte entries. */
+#define ZSL_INTERP_X(x0, stride, i) \
+	(*(const zsl_real_t *)((const char *)(x0) + (i) * (stride)))
+
+/* Whether a comes before b in a table of the given order. */
+static inline bool
+zsl_interp_before(bool asc, zsl_real_t a, zsl_real_t b)
+{
+	return asc ? (a < b) : (a > b);
+}
+
+/*
+ * Hunts for the interval holding x in the table whose first x value is at
+ * 'x0', starting from the interval cached in c, with the same results as
+ * zsl_interp_find_x.
+ */
+static int
+zsl_interp_hunt(struct zsl_interp_cache *c, const zsl_real_t *x0,
+		size_t stride, zsl_real_t x, int *idx)
+{
+	size_t n = c->n;
+	size_t lo, hi, mid, step;
+	bool asc = c->asc;
+
+	/* xy[0] and xy[n-1] bounds checks, with NaN treated as too low. */
+	if (zsl_interp_before(asc, ZSL_INTERP_X(x0, stride, n - 1), x)) {
+		*idx = n;
+		return -EINVAL;
+	} else if (zsl_interp_before(asc, x, ZSL_INTERP_X(x0, stride, 0)) ||
+		   x != x) {
+		*idx = -1;
+		return -EINVAL;
+	}
+
+	if (x == ZSL_INTERP_X(x0, stride, n - 1)) {
+		lo = n - 2;
+		goto out;
+	}
+
+	lo = c->idx > n - 2 ? n - 2 : c->idx;
+
+	if (zsl_interp_before(asc, x, ZSL_INTERP_X(x0, stride, lo))) {
+		/* Hunt downwards until x is bracketed. */
+		hi = lo;
+		for (step = 1;; step <<= 1) {
+			if (step >= hi) {
+				lo = 0;
+				break;
+			}
+			lo = hi - step;
+			if (!zsl_interp_before(asc, x,
+					       ZSL_INTERP_X(x0, stride, lo))) {
+				break;
+			}
+			hi = lo;
+		}
+	} else if (!zsl_interp_before(asc, x,
+				      ZSL_INTERP_X(x0, stride, lo + 1))) {
+		/* Hunt upwards until x is bracketed. */
+		lo++;
+		for (step = 1;; step <<= 1) {
+			hi = lo + step;
+			if (hi >= n - 1) {
+				hi = n - 1;
+				break;
+			}
+			if (zsl_interp_before(asc, x,
+					      ZSL_INTERP_X(x0, stride, hi))) {
+				break;
+			}
+			lo = hi;
+		}
+	} else {
+		/* Still in the same interval. */
+		goto out;
+	}
+
+	/* Bisect the bracket, keeping x0[lo] <= x < x0[hi]. */
+	while (hi - lo > 1) {
+		mid = lo + ((hi - lo) >> 1);
+		if (zsl_interp_before(asc, x, ZSL_INTERP_X(x0, stride, mid))) {
+			hi = mid;
+		} else {
+			lo = mid;
+		}
+	}
+
+out:
+	c->idx = lo;
+	*idx = (int)lo;
+
+	return 0;
+}
+
+int
+zsl_interp_cache_init(struct zsl_interp_cache *c, struct zsl_interp_xy xy[],
+		      size_t n)
+{
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	c->n = n;
+	c->idx = 0;
+	c->asc = (xy[n - 1].x >= xy[0].x);
+
+	return 0;
+}
+
+int
+zsl_interp_cache_init_xyc(struct zsl_interp_cache *c,
+			  struct zsl_interp_xyc xyc[], size_t n)
+{
+	if (n < 3 || xyc[n - 1].x < xyc[0].x) {
+		return -EINVAL;
+	}
+
+	c->n = n;
+	c->idx = 0;
+	c->asc = true;
+
+	return 0;
+}
+
+int
+zsl_interp_find_x_cached(struct zsl_interp_cache *c,
+			 struct zsl_interp_xy xy[], zsl_real_t x, int *idx)
+{
+	return zsl_interp_hunt(c, &xy[0].x, sizeof(xy[0]), x, idx);
+}
+
+int
+zsl_interp_nn_cached(struct zsl_interp_cache *c, struct zsl_interp_xy xy[],
+		     zsl_real_t x, zsl_real_t *y)
+{
+	int rc;
+	int idx;
+
+	rc = zsl_interp_find_x_cached(c, xy, x, &idx);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	rc = zsl_interp_nn(&xy[idx], &xy[idx + 1], x, y);
+	if (rc) {
+		*y = NAN;
+	}
+
+	return rc;
+}
+
+int
+zsl_interp_lin_y_cached(struct zsl_interp_cache *c, struct zsl_interp_xy xy[],
+			zsl_real_t x, zsl_real_t *y)
+{
+	int rc;
+	int idx;
+
+	rc = zsl_interp_find_x_cached(c, xy, x, &idx);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	rc = zsl_interp_lin_y(&xy[idx], &xy[idx + 1], x, y);
+	if (rc) {
+		*y = NAN;
+	}
+
+	return rc;
+}
+
+int
+zsl_interp_cubic_cached(struct zsl_interp_cache *c,
+			struct zsl_interp_xyc xyc[], zsl_real_t x,
+			zsl_real_t *y)
+{
+	int rc;
+	int idx;
+
+	rc = zsl_interp_hunt(c, &xyc[0].x, sizeof(xyc[0]), x, &idx);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	return zsl_interp_cubic_eval(xyc, idx, idx + 1, x, y);
+}
+
+int
+zsl_interp_lin_y_batch(struct zsl_interp_xy xy[], size_t n,
+		       const zsl_real_t *xs, zsl_real_t *ys, size_t count)
+{
+	int rc;
+	int err = 0;
+	struct zsl_interp_cache c;
+
+	rc = zsl_interp_cache_init(&c, xy, n);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (zsl_interp_lin_y_cached(&c, xy, xs[i], &ys[i])) {
+			err = -EINVAL;
+		}
+	}
+
+	return err;
+}
+
+int
+zsl_interp_cubic_batch(struct zsl_interp_xyc xyc[], size_t n,
+		       const zsl_real_t *xs, zsl_real_t *ys, size_t count)
+{
+	int rc;
+	int err = 0;
+	struct zsl_interp_cache c;
+
+	rc = zsl_interp_cache_init_xyc(&c, xyc, n);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (zsl_interp_cubic_cached(&c, xyc, xs[i], &ys[i])) {
+			err = -EINVAL;
+		}
+	}
+
+	return err;
+}
+
+/*
+ * Splits x into the index i of the grid interval holding it and the
+ * fraction t of the way across that interval.
+ */
+static int
+zsl_interp_grid_pos(const struct zsl_interp_grid *g, zsl_real_t x, size_t *i,
+		    zsl_real_t *t)
+{
+	zsl_real_t pos;
+
+	if (g->n < 2 || !(g->dx > 0.0)) {
+		return -EINVAL;
+	}
+
+	/* Written so that NaN fails the test. */
+	pos = (x - g->x0) / g->dx;
+	if (!(pos >= 0.0) || pos > (zsl_real_t)(g->n - 1)) {
+		return -EINVAL;
+	}
+
+	*i = (size_t)pos;
+	if (*i > g->n - 2) {
+		*i = g->n - 2;
+	}
+	*t = pos - (zsl_real_t)*i;
+
+	return 0;
+}
+
+int
+zsl_interp_grid_nn(const struct zsl_interp_grid *g, zsl_real_t x,
+		   zsl_real_t *y)
+{
+	int rc;
+	size_t i;
+	zsl_real_t t;
+
+	rc = zsl_interp_grid_pos(g, x, &i, &t);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	*y = t >= 0.5 ? g->y[i + 1] : g->y[i];
+
+	return 0;
+}
+
+int
+zsl_interp_grid_lin(const struct zsl_interp_grid *g, zsl_real_t x,
+		    zsl_real_t *y)
+{
+	int rc;
+	size_t i;
+	zsl_real_t t;
+
+	rc = zsl_interp_grid_pos(g, x, &i, &t);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	*y = g->y[i] + t * (g->y[i + 1] - g->y[i]);
+
+	return 0;
+}
+
+size_t
+zsl_interp_grid_cubic_calc_ws_sz(size_t n)
+{
+	return n;
+}
+
+int
+zsl_interp_grid_cubic_calc_ws(struct zsl_interp_grid *g, zsl_real_t yp1,
+			      zsl_real_t ypn, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t n = g->n;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t h = g->dx;
+	const zsl_real_t *y = g->y;
+	zsl_real_t *y2 = g->y2;
+	zsl_real_t p, qn, un;
+	struct zsl_vec u;
+
+	if (n < 3 || y2 == NULL || !(h > 0.0)) {
 		rc = -EINVAL;
 		goto err;
 	}
 
-	/* Calculate coefficients for hi-x (a) and x-lo (b). */
-	a = (xyc[khi].x - x) / h;
-	b = (x - xyc[klo].x) / h;
+	rc = zsl_ws_vec_alloc(ws, &u, n);
+	if (rc) {
+		goto err;
+	}
 
-	/* Interpolate for y based on a, b using prev. calculated y2 vals. */
-	*y = a * xyc[klo].y + b * xyc[khi].y +
-	     ((a * a * a - a) * xyc[klo].y2 + (b * b * b - b) *
-	      xyc[khi].y2) * (h * h) / 6.0f;
+	/* zsl_interp_cubic_calc, with sigma = 1/2 for equal spacing. */
+	if (yp1 > 0.99e30f) {
+		y2[0] = u.data[0] = 0.0;
+	} else {
+		y2[0] = -0.5;
+		u.data[0] = (3.0 / h) * ((y[1] - y[0]) / h - yp1);
+	}
+
+	for (size_t i = 1; i < n - 1; i++) {
+		p = 0.5 * y2[i - 1] + 2.0;
+		y2[i] = -0.5 / p;
+		u.data[i] = (y[i + 1] - 2.0 * y[i] + y[i - 1]) / h;
+		u.data[i] = (3.0 * u.data[i] / h - 0.5 * u.data[i - 1]) / p;
+	}
+
+	if (ypn > 0.99e30f) {
+		qn = un = 0.0;
+	} else {
+		qn = 0.5;
+		un = (3.0 / h) * (ypn - (y[n - 1] - y[n - 2]) / h);
+	}
+
+	y2[n - 1] = (un - qn * u.data[n - 2]) / (qn * y2[n - 2] + 1.0);
+
+	for (size_t k = n - 1; k-- > 0;) {
+		y2[k] = y2[k] * y2[k + 1] + u.data[k];
+	}
 
-	return 0;
 err:
+	zsl_ws_release(ws, mark);
 	return rc;
 }
+
+int
+zsl_interp_grid_cubic_calc(struct zsl_interp_grid *g, zsl_real_t yp1,
+			   zsl_real_t ypn)
+{
+	int rc;
+	ZSL_SCRATCH_DEF(ws, zsl_interp_grid_cubic_calc_ws_sz(g->n));
+
+	rc = zsl_interp_grid_cubic_calc_ws(g, yp1, ypn, ws);
+
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_interp_grid_cubic(const struct zsl_interp_grid *g, zsl_real_t x,
+		      zsl_real_t *y)
+{
+	int rc;
+	size_t i;
+	zsl_real_t a, b;
+
+	if (g->y2 == NULL) {
+		*y = NAN;
+		return -EINVAL;
+	}
+
+	rc = zsl_interp_grid_pos(g, x, &i, &b);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	a = 1.0 - b;
+	*y = a * g->y[i] + b * g->y[i + 1] +
+	     ((a * a * a - a) * g->y2[i] + (b * b * b - b) * g->y2[i + 1]) *
+	     (g->dx * g->dx) / 6.0;
+
+	return 0;
+}
+
+/* Copies the points of xy into sp, checking that x strictly ascends. */
+static int
+zsl_interp_spline_load(struct zsl_interp_spline *sp,
+		       const struct zsl_interp_xy xy[], size_t min)
+{
+	struct zsl_interp_spline_seg *s = sp->seg;
+
+	if (sp->n < min) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < sp->n; i++) {
+		if (i > 0 && !(xy[i].x > xy[i - 1].x)) {
+			return -EINVAL;
+		}
+		s[i].x = xy[i].x;
+		s[i].a = xy[i].y;
+		s[i].b = s[i].c = s[i].d = 0.0;
+	}
+
+	sp->cache.n = sp->n;
+	sp->cache.idx = 0;
+	sp->cache.asc = true;
+
+	return 0;
+}
+
+/*
+ * Turns the end-point derivatives in s[i].b and the secant slopes in s[i].d
+ * into the coefficients of each cubic Hermite interval.
+ */
+static void
+zsl_interp_spline_hermite(struct zsl_interp_spline *sp)
+{
+	struct zsl_interp_spline_seg *s = sp->seg;
+	zsl_real_t h, m;
+
+	for (size_t i = 0; i < sp->n - 1; i++) {
+		h = s[i + 1].x - s[i].x;
+		m = s[i].d;
+		s[i].c = (3.0 * m - 2.0 * s[i].b - s[i + 1].b) / h;
+		s[i].d = (s[i].b + s[i + 1].b - 2.0 * m) / (h * h);
+	}
+
+	s[sp->n - 1].b = s[sp->n - 1].d = 0.0;
+}
+
+/* Stores the secant slope of each interval in s[i].d. */
+static void
+zsl_interp_spline_slopes(struct zsl_interp_spline *sp)
+{
+	struct zsl_interp_spline_seg *s = sp->seg;
+
+	for (size_t i = 0; i < sp->n - 1; i++) {
+		s[i].d = (s[i + 1].a - s[i].a) / (s[i + 1].x - s[i].x);
+	}
+}
+
+int
+zsl_interp_spline_natural(struct zsl_interp_spline *sp,
+			  const struct zsl_interp_xy xy[], zsl_real_t yp1,
+			  zsl_real_t ypn)
+{
+	int rc;
+	size_t n = sp->n;
+	struct zsl_interp_spline_seg *s = sp->seg;
+	zsl_real_t sigma, p, qn, un, h, m, m2;
+
+	rc = zsl_interp_spline_load(sp, xy, 3);
+	if (rc) {
+		return rc;
+	}
+
+	/* zsl_interp_cubic_calc, with the second derivatives in s[i].c and
+	 * the decomposition's temporaries in s[i].d. */
+	if (yp1 > 0.99e30f) {
+		s[0].c = s[0].d = 0.0;
+	} else {
+		h = s[1].x - s[0].x;
+		s[0].c = -0.5;
+		s[0].d = (3.0 / h) * ((s[1].a - s[0].a) / h - yp1);
+	}
+
+	for (size_t i = 1; i < n - 1; i++) {
+		h = s[i].x - s[i - 1].x;
+		sigma = h / (s[i + 1].x - s[i - 1].x);
+		p = sigma * s[i - 1].c + 2.0;
+		s[i].c = (sigma - 1.0) / p;
+		s[i].d = (s[i + 1].a - s[i].a) / (s[i + 1].x - s[i].x) -
+			 (s[i].a - s[i - 1].a) / h;
+		s[i].d = (6.0 * s[i].d / (s[i + 1].x - s[i - 1].x) -
+			  sigma * s[i - 1].d) / p;
+	}
+
+	if (ypn > 0.99e30f) {
+		qn = un = 0.0;
+	} else {
+		h = s[n - 1].x - s[n - 2].x;
+		qn = 0.5;
+		un = (3.0 / h) * (ypn - (s[n - 1].a - s[n - 2].a) / h);
+	}
+
+	s[n - 1].c = (un - qn * s[n - 2].d) / (qn * s[n - 2].c + 1.0);
+	for (size_t k = n - 1; k-- > 0;) {
+		s[k].c = s[k].c * s[k + 1].c + s[k].d;
+	}
+
+	/* Second derivatives to polynomial coefficients, in ascending order
+	 * so that s[i + 1].c is still a second derivative. */
+	for (size_t i = 0; i < n - 1; i++) {
+		h = s[i + 1].x - s[i].x;
+		m = (s[i + 1].a - s[i].a) / h;
+		m2 = s[i].c;
+		s[i].b = m - h * (2.0 * m2 + s[i + 1].c) / 6.0;
+		s[i].c = 0.5 * m2;
+		s[i].d = (s[i + 1].c - m2) / (6.0 * h);
+	}
+	s[n - 1].b = s[n - 1].c = s[n - 1].d = 0.0;
+
+	return 0;
+}
+
+/* The PCHIP end-point derivative from the two nearest intervals. */
+static zsl_real_t
+zsl_interp_pchip_end(zsl_real_t h0, zsl_real_t h1, zsl_real_t m0,
+		     zsl_real_t m1)
+{
+	zsl_real_t t = ((2.0 * h0 + h1) * m0 - h0 * m1) / (h0 + h1);
+
+	if ((t > 0.0) != (m0 > 0.0) || m0 == 0.0) {
+		return 0.0;
+	}
+	if ((m0 > 0.0) != (m1 > 0.0) && ZSL_ABS(t) > ZSL_ABS(3.0 * m0)) {
+		return 3.0 * m0;
+	}
+
+	return t;
+}
+
+int
+zsl_interp_spline_pchip(struct zsl_interp_spline *sp,
+			const struct zsl_interp_xy xy[])
+{
+	int rc;
+	size_t n = sp->n;
+	struct zsl_interp_spline_seg *s = sp->seg;
+	zsl_real_t h0, h1, w1, w2;
+
+	rc = zsl_interp_spline_load(sp, xy, 2);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_interp_spline_slopes(sp);
+
+	if (n == 2) {
+		s[0].b = s[1].b = s[0].d;
+		zsl_interp_spline_hermite(sp);
+		return 0;
+	}
+
+	for (size_t i = 1; i < n - 1; i++) {
+		if (s[i - 1].d * s[i].d <= 0.0) {
+			/* A local extremum, or a flat interval. */
+			s[i].b = 0.0;
+			continue;
+		}
+		h0 = s[i].x - s[i - 1].x;
+		h1 = s[i + 1].x - s[i].x;
+		w1 = 2.0 * h1 + h0;
+		w2 = h1 + 2.0 * h0;
+		s[i].b = (w1 + w2) / (w1 / s[i - 1].d + w2 / s[i].d);
+	}
+
+	s[0].b = zsl_interp_pchip_end(s[1].x - s[0].x, s[2].x - s[1].x,
+				      s[0].d, s[1].d);
+	s[n - 1].b = zsl_interp_pchip_end(s[n - 1].x - s[n - 2].x,
+					  s[n - 2].x - s[n - 3].x,
+					  s[n - 2].d, s[n - 3].d);
+
+	zsl_interp_spline_hermite(sp);
+
+	return 0;
+}
+
+/*
+ * Secant slope i of a spline, with two extra slopes linearly extrapolated
+ * at each end for Akima's method, so i can run from -2 to n.
+ */
+static zsl_real_t
+zsl_interp_akima_slope(const struct zsl_interp_spline *sp, long i)
+{
+	long last = (long)sp->n - 2;
+
+	if (i < 0) {
+		return (1 - i) * sp->seg[0].d + i * sp->seg[1].d;
+	}
+	if (i > last) {
+		return (1 + i - last) * sp->seg[last].d -
+		       (i - last) * sp->seg[last - 1].d;
+	}
+
+	return sp->seg[i].d;
+}
+
+int
+zsl_interp_spline_akima(struct zsl_interp_spline *sp,
+			const struct zsl_interp_xy xy[])
+{
+	int rc;
+	zsl_real_t m0, m1, m2, m3, w0, w1;
+
+	rc = zsl_interp_spline_load(sp, xy, 3);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_interp_spline_slopes(sp);
+
+	for (long i = 0; i < (long)sp->n; i++) {
+		m0 = zsl_interp_akima_slope(sp, i - 2);
+		m1 = zsl_interp_akima_slope(sp, i - 1);
+		m2 = zsl_interp_akima_slope(sp, i);
+		m3 = zsl_interp_akima_slope(sp, i + 1);
+		w0 = ZSL_ABS(m3 - m2);
+		w1 = ZSL_ABS(m1 - m0);
+		if (w0 + w1 == 0.0) {
+			sp->seg[i].b = 0.5 * (m1 + m2);
+		} else {
+			sp->seg[i].b = (w0 * m1 + w1 * m2) / (w0 + w1);
+		}
+	}
+
+	zsl_interp_spline_hermite(sp);
+
+	return 0;
+}
+
+int
+zsl_interp_spline_eval(struct zsl_interp_spline *sp, zsl_real_t x,
+		       zsl_real_t *y)
+{
+	int rc;
+	int idx;
+	const struct zsl_interp_spline_seg *s;
+	zsl_real_t t;
+
+	rc = zsl_interp_hunt(&sp->cache, &sp->seg[0].x, sizeof(sp->seg[0]), x,
+			     &idx);
+	if (rc) {
+		*y = NAN;
+		return rc;
+	}
+
+	s = &sp->seg[idx];
+	t = x - s->x;
+	*y = s->a + t * (s->b + t * (s->c + t * s->d));
+
+	return 0;
+}
+
+/* Checks that the n values of an axis strictly ascend. */
+static int
+zsl_interp_axis_check(const zsl_real_t *a, size_t n)
+{
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		if (!(a[i] > a[i - 1])) {
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_interp_grid2_init(struct zsl_interp_grid2 *g)
+{
+	if (zsl_interp_axis_check(g->x, g->nx) ||
+	    zsl_interp_axis_check(g->y, g->ny)) {
+		return -EINVAL;
+	}
+
+	g->cx.n = g->nx;
+	g->cx.idx = 0;
+	g->cx.asc = true;
+	g->cy.n = g->ny;
+	g->cy.idx = 0;
+	g->cy.asc = true;
+
+	return 0;
+}
+
+/* Finds the cell of g holding (x, y). */
+static int
+zsl_interp_grid2_cell(struct zsl_interp_grid2 *g, zsl_real_t x, zsl_real_t y,
+		      size_t *i, size_t *j)
+{
+	int ix, iy;
+
+	if (zsl_interp_hunt(&g->cx, g->x, sizeof(g->x[0]), x, &ix) ||
+	    zsl_interp_hunt(&g->cy, g->y, sizeof(g->y[0]), y, &iy)) {
+		return -EINVAL;
+	}
+
+	*i = (size_t)ix;
+	*j = (size_t)iy;
+
+	return 0;
+}
+
+int
+zsl_interp_grid2_bilin(struct zsl_interp_grid2 *g, zsl_real_t x,
+		       zsl_real_t y, zsl_real_t *z)
+{
+	size_t i, j;
+	zsl_real_t tx, ty, z0, z1;
+	const zsl_real_t *r0, *r1;
+
+	if (zsl_interp_grid2_cell(g, x, y, &i, &j)) {
+		*z = NAN;
+		return -EINVAL;
+	}
+
+	tx = (x - g->x[i]) / (g->x[i + 1] - g->x[i]);
+	ty = (y - g->y[j]) / (g->y[j + 1] - g->y[j]);
+	r0 = &g->z[i * g->ny + j];
+	r1 = r0 + g->ny;
+
+	z0 = r0[0] + ty * (r0[1] - r0[0]);
+	z1 = r1[0] + ty * (r1[1] - r1[0]);
+	*z = z0 + tx * (z1 - z0);
+
+	return 0;
+}
+
+/*
+ * Cubic Hermite interpolation at x between axis points i and i + 1, where
+ * f[k] is the value at axis point i + k for k = -1 to 2, and only the
+ * values of points within the n-point axis are read.
+ */
+static zsl_real_t
+zsl_interp_hermite(const zsl_real_t *a, size_t n, size_t i,
+		   const zsl_real_t *f, zsl_real_t x)
+{
+	zsl_real_t h = a[i + 1] - a[i];
+	zsl_real_t m = (f[1] - f[0]) / h;
+	zsl_real_t d0 = m;
+	zsl_real_t d1 = m;
+	zsl_real_t hn, t, t2, t3;
+
+	/* The slope of the parabola through each point's neighbours. */
+	if (i > 0) {
+		hn = a[i] - a[i - 1];
+		d0 = (h * (f[0] - f[-1]) / hn + hn * m) / (h + hn);
+	}
+	if (i + 2 < n) {
+		hn = a[i + 2] - a[i + 1];
+		d1 = (hn * m + h * (f[2] - f[1]) / hn) / (h + hn);
+	}
+
+	t = (x - a[i]) / h;
+	t2 = t * t;
+	t3 = t2 * t;
+
+	return (2.0 * t3 - 3.0 * t2 + 1.0) * f[0] +
+	       (t3 - 2.0 * t2 + t) * h * d0 +
+	       (3.0 * t2 - 2.0 * t3) * f[1] +
+	       (t3 - t2) * h * d1;
+}
+
+int
+zsl_interp_grid2_bicubic(struct zsl_interp_grid2 *g, zsl_real_t x,
+			 zsl_real_t y, zsl_real_t *z)
+{
+	size_t i, j;
+	/* Values along y at x rows i - 1 to i + 2, with row i in col[1]. */
+	zsl_real_t col[4];
+
+	if (zsl_interp_grid2_cell(g, x, y, &i, &j)) {
+		*z = NAN;
+		return -EINVAL;
+	}
+
+	for (size_t k = 0; k < 4; k++) {
+		if (i + k < 1 || i + k > g->nx) {
+			continue;
+		}
+		col[k] = zsl_interp_hermite(g->y, g->ny, j,
+					    &g->z[(i + k - 1) * g->ny + j], y);
+	}
+
+	*z = zsl_interp_hermite(g->x, g->nx, i, &col[1], x);
+
+	return 0;
+}
+
+int
+zsl_interp_grid2_bilin_batch(struct zsl_interp_grid2 *g,
+			     const zsl_real_t *xs, const zsl_real_t *ys,
+			     zsl_real_t *zs, size_t count)
+{
+	int err = 0;
+
+	for (size_t k = 0; k < count; k++) {
+		if (zsl_interp_grid2_bilin(g, xs[k], ys[k], &zs[k])) {
+			err = -EINVAL;
+		}
+	}
+
+	return err;
+}
+
+int
+zsl_interp_grid2_bicubic_batch(struct zsl_interp_grid2 *g,
+			       const zsl_real_t *xs, const zsl_real_t *ys,
+			       zsl_real_t *zs, size_t count)
+{
+	int err = 0;
+
+	for (size_t k = 0; k < count; k++) {
+		if (zsl_interp_grid2_bicubic(g, xs[k], ys[k], &zs[k])) {
+			err = -EINVAL;
+		}
+	}
+
+	return err;
+}
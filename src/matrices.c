@@ -7,9 +7,45 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
+#include <zsl/workspace.h>
+#include <zsl/instrument.h>
+#include <zsl/smp.h>
+#include <zsl/random.h>
+
+/* With CONFIG_ZSL_MATRIX_INLINE, matrices.h defines these functions inline
+ * for 3x3 matrices, and they call the versions here, including any
+ * platform kernels, for other sizes. zsl_mtx_get and zsl_mtx_set are only
+ * defined there. */
+#if CONFIG_ZSL_MATRIX_INLINE
+#define zsl_mtx_add zsl_mtx_add_ool
+#define zsl_mtx_sub zsl_mtx_sub_ool
+#define zsl_mtx_mult zsl_mtx_mult_ool
+#define zsl_mtx_trans zsl_mtx_trans_ool
+#endif
+
+/* Route common functions through CMSIS-DSP if requested. */
+#if CONFIG_ZSL_BACKEND_CMSIS_DSP
+#include <zsl/asm/arm/cmsis_dsp_matrices.h>
+#endif
+
+/* Enable optimised ARM Thumb2/MVE functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 2 || CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/arm/asm_arm_matrices.h>
+#endif
+
+/* Enable optimised host SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 4)
+#include <zsl/asm/host/asm_host_matrices.h>
+#endif
+
+/* The fixed-size kernels for small square matrices. The 3x3 and 4x4
+ * inverses always use them, and CONFIG_ZSL_MATRIX_INLINE enables the
+ * rest. */
+#include <zsl/matrices_fixed.h>
 
 /*
  * WARNING: Work in progress!
@@ -27,20 +63,116 @@
 
 // TODO: Introduce local macros for bounds/shape checks to avoid duplication!
 
-/* To avoid declaring multiple matrices on the stack, two chunks of
- * statically declared memory are made available here for reuse in
- * zsl_mtx_qrd_iter. */
-#if CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH
+/* To avoid allocating temporaries on the stack, a chunk of statically
+ * declared memory is made available here for reuse in zsl_mtx_qrd_iter.
+ * The library-wide scratch pool supersedes this when CONFIG_ZSL_SCRATCH_POOL
+ * is enabled, and zsl_mtx_qrd_iter_ctx avoids it entirely. */
+#if CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH && !CONFIG_ZSL_SCRATCH_POOL
 static zsl_real_t scrd_1[CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE];
-static zsl_real_t scrd_2[CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE];
 #define ZSL_QRD_SCRATCH_1_CLEAR (memset(scrd_1, 0,			     \
 					CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE * \
 					sizeof(zsl_real_t)))
-#define ZSL_QRD_SCRATCH_2_CLEAR (memset(scrd_2, 0,			     \
-					CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE * \
-					sizeof(zsl_real_t)))
+
+/* scrd_1 is shared by every caller, so concurrent calls are serialised.
+ * Standalone builds are assumed to be single-threaded. */
+#ifdef __ZEPHYR__
+#include <kernel.h>
+static K_MUTEX_DEFINE(scrd_1_lock);
+#define ZSL_QRD_SCRATCH_1_LOCK() k_mutex_lock(&scrd_1_lock, K_FOREVER)
+#define ZSL_QRD_SCRATCH_1_UNLOCK() k_mutex_unlock(&scrd_1_lock)
+#else
+#define ZSL_QRD_SCRATCH_1_LOCK()
+#define ZSL_QRD_SCRATCH_1_UNLOCK()
+#endif
+#endif
+
+/* Relative tolerance used by the iterative decompositions (QR iteration,
+ * SVD) to detect convergence and negligible values. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_MTX_EPS 1E-6
+#else
+#define ZSL_MTX_EPS 1E-15
+#endif
+
+/* Type used to accumulate residuals during iterative refinement, which
+ * must be wider than zsl_real_t to be of any benefit. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+typedef double zsl_mtx_wide_t;
+#else
+typedef long double zsl_mtx_wide_t;
 #endif
 
+/* Edge length of the square blocks used by zsl_mtx_mult on larger inputs. */
+#ifdef CONFIG_ZSL_MATRIX_MULT_BLOCK_SIZE
+#define ZSL_MTX_MULT_BLOCK_SIZE CONFIG_ZSL_MATRIX_MULT_BLOCK_SIZE
+#else
+#define ZSL_MTX_MULT_BLOCK_SIZE 32
+#endif
+
+/*
+ * zsl_mtx_is_sym compares square tiles of this size with their transposes,
+ * so the column reads of each tile stay within a few cache lines.
+ */
+#define ZSL_MTX_SYM_TILE 8
+
+/* Tolerance used by zsl_mtx_is_sym. */
+#define ZSL_MTX_SYM_EPS 1E-6
+
+/* Tolerance used by zsl_mtx_props to recognise m^T * m as the identity. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_MTX_PROP_EPS 1E-5
+#else
+#define ZSL_MTX_PROP_EPS 1E-10
+#endif
+
+/*
+ * zsl_mtx_is_equal compares blocks of this many entries without branching,
+ * so each block vectorises, and stops at the end of the first that differs.
+ */
+#define ZSL_MTX_CMP_BLOCK 16
+
+/*
+ * Unchecked element and column accessors for internal loops. The public
+ * functions validate their arguments once on entry, so the indices used
+ * inside them are known to be in range and aren't checked again for every
+ * element. CONFIG_ZSL_ASSERTS checks them in debug builds.
+ */
+static inline zsl_real_t
+zsl_mtx_at(const struct zsl_mtx *m, size_t i, size_t j)
+{
+	ZSL_ASSERT((i < m->sz_rows) && (j < m->sz_cols));
+
+	return m->data[(i * m->sz_cols) + j];
+}
+
+static inline void
+zsl_mtx_put(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t x)
+{
+	ZSL_ASSERT((i < m->sz_rows) && (j < m->sz_cols));
+
+	m->data[(i * m->sz_cols) + j] = x;
+}
+
+static inline void
+zsl_mtx_col_load(const struct zsl_mtx *m, size_t j, zsl_real_t *v)
+{
+	ZSL_ASSERT(j < m->sz_cols);
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		v[i] = m->data[i * m->sz_cols + j];
+	}
+}
+
+static inline void
+zsl_mtx_col_store(struct zsl_mtx *m, size_t j, const zsl_real_t *v)
+{
+	ZSL_ASSERT(j < m->sz_cols);
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		m->data[i * m->sz_cols + j] = v[i];
+	}
+}
+
 int
 zsl_mtx_entry_fn_empty(struct zsl_mtx *m, size_t i, size_t j)
 {
@@ -56,8 +188,17 @@ zsl_mtx_entry_fn_identity(struct zsl_mtx *m, size_t i, size_t j)
 int
 zsl_mtx_entry_fn_random(struct zsl_mtx *m, size_t i, size_t j)
 {
-	/* TODO: Determine an appropriate random number generator. */
-	return zsl_mtx_set(m, i, j, 0);
+	/* Entry functions take no context, so this shares one generator.
+	 * zsl_mtx_init_random_ctx is the reentrant alternative. */
+	static struct zsl_rand r;
+	static bool seeded;
+
+	if (!seeded) {
+		zsl_rand_seed(&r, 0);
+		seeded = true;
+	}
+
+	return zsl_mtx_set(m, i, j, 2.0 * zsl_rand_uniform(&r) - 1.0);
 }
 
 int
@@ -65,6 +206,20 @@ zsl_mtx_init(struct zsl_mtx *m, zsl_mtx_init_entry_fn_t entry_fn)
 {
 	int rc;
 
+	/* Zero and identity fills are common enough in the decompositions to
+	 * skip the call per entry. */
+	if (entry_fn == NULL || entry_fn == zsl_mtx_entry_fn_identity) {
+		memset(m->data, 0,
+		       m->sz_rows * m->sz_cols * sizeof(zsl_real_t));
+		if (entry_fn != NULL) {
+			for (size_t i = 0; i < m->sz_rows && i < m->sz_cols;
+			     i++) {
+				m->data[i * m->sz_cols + i] = 1.0;
+			}
+		}
+		return 0;
+	}
+
 	for (size_t i = 0; i < m->sz_rows; i++) {
 		for (size_t j = 0; j < m->sz_cols; j++) {
 			/* If entry_fn is NULL, assign 0.0 values. */
@@ -84,7 +239,7 @@ zsl_mtx_init(struct zsl_mtx *m, zsl_mtx_init_entry_fn_t entry_fn)
 }
 
 int
-zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a)
+zsl_mtx_from_arr(struct zsl_mtx *m, const zsl_real_t *a)
 {
 	memcpy(m->data, a, (m->sz_rows * m->sz_cols) * sizeof(zsl_real_t));
 
@@ -92,7 +247,7 @@ zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a)
 }
 
 int
-zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc)
+zsl_mtx_copy(struct zsl_mtx *mdest, const struct zsl_mtx *msrc)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Ensure that msrc and mdest have the same shape. */
@@ -109,8 +264,9 @@ zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc)
 	return 0;
 }
 
+#if !CONFIG_ZSL_MATRIX_INLINE
 int
-zsl_mtx_get(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x)
+zsl_mtx_get(const struct zsl_mtx *m, size_t i, size_t j, zsl_real_t *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
@@ -136,336 +292,287 @@ zsl_mtx_set(struct zsl_mtx *m, size_t i, size_t j, zsl_real_t x)
 
 	return 0;
 }
+#endif
 
 int
-zsl_mtx_get_row(struct zsl_mtx *m, size_t i, zsl_real_t *v)
+zsl_mtx_get_row(const struct zsl_mtx *m, size_t i, zsl_real_t *v)
 {
-	int rc;
-	zsl_real_t x;
-
-	for (size_t j = 0; j < m->sz_cols; j++) {
-		rc = zsl_mtx_get(m, i, j, &x);
-		if (rc) {
-			return rc;
-		}
-		v[j] = x;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (i >= m->sz_rows) {
+		return -EINVAL;
 	}
+#endif
+
+	memcpy(v, &m->data[i * m->sz_cols], m->sz_cols * sizeof(zsl_real_t));
 
 	return 0;
 }
 
 int
-zsl_mtx_set_row(struct zsl_mtx *m, size_t i, zsl_real_t *v)
+zsl_mtx_set_row(struct zsl_mtx *m, size_t i, const zsl_real_t *v)
 {
-	int rc;
-
-	for (size_t j = 0; j < m->sz_cols; j++) {
-		rc = zsl_mtx_set(m, i, j, v[j]);
-		if (rc) {
-			return rc;
-		}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (i >= m->sz_rows) {
+		return -EINVAL;
 	}
+#endif
+
+	memcpy(&m->data[i * m->sz_cols], v, m->sz_cols * sizeof(zsl_real_t));
 
 	return 0;
 }
 
 int
-zsl_mtx_get_col(struct zsl_mtx *m, size_t j, zsl_real_t *v)
+zsl_mtx_get_col(const struct zsl_mtx *m, size_t j, zsl_real_t *v)
 {
-	int rc;
-	zsl_real_t x;
-
-	for (size_t i = 0; i < m->sz_rows; i++) {
-		rc = zsl_mtx_get(m, i, j, &x);
-		if (rc) {
-			return rc;
-		}
-		v[i] = x;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (j >= m->sz_cols) {
+		return -EINVAL;
 	}
+#endif
+
+	zsl_mtx_col_load(m, j, v);
 
 	return 0;
 }
 
 int
-zsl_mtx_set_col(struct zsl_mtx *m, size_t j, zsl_real_t *v)
+zsl_mtx_set_col(struct zsl_mtx *m, size_t j, const zsl_real_t *v)
 {
-	int rc;
-
-	for (size_t i = 0; i < m->sz_rows; i++) {
-		rc = zsl_mtx_set(m, i, j, v[i]);
-		if (rc) {
-			return rc;
-		}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (j >= m->sz_cols) {
+		return -EINVAL;
 	}
+#endif
+
+	zsl_mtx_col_store(m, j, v);
 
 	return 0;
 }
 
 int
-zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op)
+zsl_mtx_view(struct zsl_mtx *m, size_t i, size_t j, size_t rows, size_t cols,
+	     struct zsl_mtx_view *v)
 {
-	/* Execute the unary operation component by component. */
-	for (size_t i = 0; i < m->sz_cols * m->sz_rows; i++) {
-		switch (op) {
-		case ZSL_MTX_UNARY_OP_INCREMENT:
-			m->data[i] += 1.0;
-			break;
-		case ZSL_MTX_UNARY_OP_DECREMENT:
-			m->data[i] -= 1.0;
-			break;
-		case ZSL_MTX_UNARY_OP_NEGATIVE:
-			m->data[i] = -m->data[i];
-			break;
-		case ZSL_MTX_UNARY_OP_ROUND:
-			m->data[i] = ZSL_ROUND(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_ABS:
-			m->data[i] = ZSL_ABS(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_FLOOR:
-			m->data[i] = ZSL_FLOOR(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_CEIL:
-			m->data[i] = ZSL_CEIL(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_EXP:
-			m->data[i] = ZSL_EXP(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_LOG:
-			m->data[i] = ZSL_LOG(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_LOG10:
-			m->data[i] = ZSL_LOG10(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_SQRT:
-			m->data[i] = ZSL_SQRT(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_SIN:
-			m->data[i] = ZSL_SIN(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_COS:
-			m->data[i] = ZSL_COS(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_TAN:
-			m->data[i] = ZSL_TAN(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_ASIN:
-			m->data[i] = ZSL_ASIN(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_ACOS:
-			m->data[i] = ZSL_ACOS(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_ATAN:
-			m->data[i] = ZSL_ATAN(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_SINH:
-			m->data[i] = ZSL_SINH(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_COSH:
-			m->data[i] = ZSL_COSH(m->data[i]);
-			break;
-		case ZSL_MTX_UNARY_OP_TANH:
-			m->data[i] = ZSL_TANH(m->data[i]);
-			break;
-		default:
-			/* Not yet implemented! */
-			return -ENOSYS;
-		}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the block lies within 'm'. */
+	if ((i + rows > m->sz_rows) || (j + cols > m->sz_cols)) {
+		return -EINVAL;
 	}
+#endif
+
+	v->sz_rows = rows;
+	v->sz_cols = cols;
+	v->ld = m->sz_cols;
+	v->data = &m->data[i * m->sz_cols + j];
 
 	return 0;
 }
 
 int
-zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn)
+zsl_mtx_view_row(struct zsl_mtx *m, size_t i, struct zsl_mtx_view *v)
 {
-	int rc;
-
-	for (size_t i = 0; i < m->sz_rows; i++) {
-		for (size_t j = 0; j < m->sz_cols; j++) {
-			/* If fn is NULL, do nothing. */
-			if (fn != NULL) {
-				rc = fn(m, i, j);
-				if (rc) {
-					return rc;
-				}
-			}
-		}
-	}
+	return zsl_mtx_view(m, i, 0, 1, m->sz_cols, v);
+}
 
-	return 0;
+int
+zsl_mtx_view_col(struct zsl_mtx *m, size_t j, struct zsl_mtx_view *v)
+{
+	return zsl_mtx_view(m, 0, j, m->sz_rows, 1, v);
 }
 
 int
-zsl_mtx_binary_op(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc,
-		  zsl_mtx_binary_op_t op)
+zsl_mtx_view_vec(struct zsl_vec *vec, size_t offset, size_t len,
+		 size_t stride, struct zsl_mtx_view *v)
 {
+	if (stride == 0) {
+		return -EINVAL;
+	}
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
-	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+	/* Make sure the last value viewed lies within 'vec'. */
+	if ((len > 0) && ((offset >= vec->sz) ||
+			  ((len - 1) > (vec->sz - 1 - offset) / stride))) {
 		return -EINVAL;
 	}
 #endif
 
-	/* Execute the binary operation component by component. */
-	for (size_t i = 0; i < ma->sz_cols * ma->sz_rows; i++) {
-		switch (op) {
-		case ZSL_MTX_BINARY_OP_ADD:
-			mc->data[i] = ma->data[i] + mb->data[i];
-			break;
-		case ZSL_MTX_BINARY_OP_SUB:
-			mc->data[i] = ma->data[i] - mb->data[i];
-			break;
-		case ZSL_MTX_BINARY_OP_MULT:
-			mc->data[i] = ma->data[i] * mb->data[i];
-			break;
-		case ZSL_MTX_BINARY_OP_DIV:
-			if (mb->data[i] == 0.0) {
-				mc->data[i] = 0.0;
-			} else {
-				mc->data[i] = ma->data[i] / mb->data[i];
-			}
-			break;
-		case ZSL_MTX_BINARY_OP_MEAN:
-			mc->data[i] = (ma->data[i] + mb->data[i]) / 2.0;
-		case ZSL_MTX_BINARY_OP_EXPON:
-			mc->data[i] = ZSL_POW(ma->data[i], mb->data[i]);
-		case ZSL_MTX_BINARY_OP_MIN:
-			mc->data[i] = ma->data[i] < mb->data[i] ?
-				      ma->data[i] : mb->data[i];
-		case ZSL_MTX_BINARY_OP_MAX:
-			mc->data[i] = ma->data[i] > mb->data[i] ?
-				      ma->data[i] : mb->data[i];
-		case ZSL_MTX_BINARY_OP_EQUAL:
-			mc->data[i] = ma->data[i] == mb->data[i] ? 1.0 : 0.0;
-		case ZSL_MTX_BINARY_OP_NEQUAL:
-			mc->data[i] = ma->data[i] != mb->data[i] ? 1.0 : 0.0;
-		case ZSL_MTX_BINARY_OP_LESS:
-			mc->data[i] = ma->data[i] < mb->data[i] ? 1.0 : 0.0;
-		case ZSL_MTX_BINARY_OP_GREAT:
-			mc->data[i] = ma->data[i] > mb->data[i] ? 1.0 : 0.0;
-		case ZSL_MTX_BINARY_OP_LEQ:
-			mc->data[i] = ma->data[i] <= mb->data[i] ? 1.0 : 0.0;
-		case ZSL_MTX_BINARY_OP_GEQ:
-			mc->data[i] = ma->data[i] >= mb->data[i] ? 1.0 : 0.0;
-		default:
-			/* Not yet implemented! */
-			return -ENOSYS;
-		}
-	}
+	v->sz_rows = len;
+	v->sz_cols = 1;
+	v->ld = stride;
+	v->data = &vec->data[offset];
 
 	return 0;
 }
 
 int
-zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
-		    struct zsl_mtx *mc, zsl_mtx_binary_fn_t fn)
+zsl_mtx_view_sub(struct zsl_mtx_view *v, size_t i, size_t j, size_t rows,
+		 size_t cols, struct zsl_mtx_view *vs)
 {
-	int rc;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
-	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+	/* Make sure the block lies within 'v'. */
+	if ((i + rows > v->sz_rows) || (j + cols > v->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	for (size_t i = 0; i < ma->sz_rows; i++) {
-		for (size_t j = 0; j < ma->sz_cols; j++) {
-			/* If fn is NULL, do nothing. */
-			if (fn != NULL) {
-				rc = fn(ma, mb, mc, i, j);
-				if (rc) {
-					return rc;
-				}
-			}
-		}
-	}
+	vs->sz_rows = rows;
+	vs->sz_cols = cols;
+	vs->ld = v->ld;
+	vs->data = &v->data[i * v->ld + j];
 
 	return 0;
 }
 
 int
-zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+zsl_mtx_view_get(const struct zsl_mtx_view *v, size_t i, size_t j,
+		 zsl_real_t *x)
 {
-	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_ADD);
-}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= v->sz_rows) || (j >= v->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-int
-zsl_mtx_add_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
-{
-	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_ADD);
+	*x = v->data[i * v->ld + j];
+
+	return 0;
 }
 
 int
-zsl_mtx_sum_rows_d(struct zsl_mtx *m, size_t i, size_t j)
+zsl_mtx_view_set(struct zsl_mtx_view *v, size_t i, size_t j, zsl_real_t x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if ((i >= m->sz_rows) || (j >= m->sz_rows)) {
+	if ((i >= v->sz_rows) || (j >= v->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	/* Add row j to row i, element by element. */
-	for (size_t x = 0; x < m->sz_cols; x++) {
-		m->data[(i * m->sz_cols) + x] += m->data[(j * m->sz_cols) + x];
-	}
+	v->data[i * v->ld + j] = x;
 
 	return 0;
 }
 
-int zsl_mtx_sum_rows_scaled_d(struct zsl_mtx *m,
-			      size_t i, size_t j, zsl_real_t s)
+int
+zsl_mtx_view_copy(struct zsl_mtx_view *vdest, const struct zsl_mtx_view *vsrc)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+	/* Make sure the views are the same shape. */
+	if ((vdest->sz_rows != vsrc->sz_rows) ||
+	    (vdest->sz_cols != vsrc->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	/* Set the values in row 'i' to 'i[n] += j[n] * s' . */
-	for (size_t x = 0; x < m->sz_cols; x++) {
-		m->data[(i * m->sz_cols) + x] +=
-			(m->data[(j * m->sz_cols) + x] * s);
+	for (size_t i = 0; i < vsrc->sz_rows; i++) {
+		memcpy(&vdest->data[i * vdest->ld], &vsrc->data[i * vsrc->ld],
+		       vsrc->sz_cols * sizeof(zsl_real_t));
 	}
 
 	return 0;
 }
 
-int
-zsl_mtx_sub(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
-{
-	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_SUB);
-}
+/*
+ * Applies 'expr', in terms of the current coefficient 'x', to each of the
+ * 'sz' coefficients in 'd'. Each operation gets its own loop, so that the
+ * op selection happens once per call rather than once per coefficient.
+ */
+#define ZSL_MTX_UNARY_LOOP(expr)			 \
+	for (size_t i = 0; i < sz; i++) {		 \
+		zsl_real_t x = d[i];			 \
+		d[i] = (expr);				 \
+	}
 
 int
-zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
+zsl_mtx_unary_op(struct zsl_mtx *m, zsl_mtx_unary_op_t op)
 {
-	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_SUB);
+	const size_t sz = m->sz_cols * m->sz_rows;
+	zsl_real_t *d = m->data;
+
+	switch (op) {
+	case ZSL_MTX_UNARY_OP_INCREMENT:
+		ZSL_MTX_UNARY_LOOP(x + 1.0);
+		break;
+	case ZSL_MTX_UNARY_OP_DECREMENT:
+		ZSL_MTX_UNARY_LOOP(x - 1.0);
+		break;
+	case ZSL_MTX_UNARY_OP_NEGATIVE:
+		ZSL_MTX_UNARY_LOOP(-x);
+		break;
+	case ZSL_MTX_UNARY_OP_ROUND:
+		ZSL_MTX_UNARY_LOOP(ZSL_ROUND(x));
+		break;
+	case ZSL_MTX_UNARY_OP_ABS:
+		ZSL_MTX_UNARY_LOOP(ZSL_ABS(x));
+		break;
+	case ZSL_MTX_UNARY_OP_FLOOR:
+		ZSL_MTX_UNARY_LOOP(ZSL_FLOOR(x));
+		break;
+	case ZSL_MTX_UNARY_OP_CEIL:
+		ZSL_MTX_UNARY_LOOP(ZSL_CEIL(x));
+		break;
+	case ZSL_MTX_UNARY_OP_EXP:
+		ZSL_MTX_UNARY_LOOP(ZSL_EXP(x));
+		break;
+	case ZSL_MTX_UNARY_OP_LOG:
+		ZSL_MTX_UNARY_LOOP(ZSL_LOG(x));
+		break;
+	case ZSL_MTX_UNARY_OP_LOG10:
+		ZSL_MTX_UNARY_LOOP(ZSL_LOG10(x));
+		break;
+	case ZSL_MTX_UNARY_OP_SQRT:
+		ZSL_MTX_UNARY_LOOP(ZSL_SQRT(x));
+		break;
+	case ZSL_MTX_UNARY_OP_SIN:
+		ZSL_MTX_UNARY_LOOP(ZSL_SIN(x));
+		break;
+	case ZSL_MTX_UNARY_OP_COS:
+		ZSL_MTX_UNARY_LOOP(ZSL_COS(x));
+		break;
+	case ZSL_MTX_UNARY_OP_TAN:
+		ZSL_MTX_UNARY_LOOP(ZSL_TAN(x));
+		break;
+	case ZSL_MTX_UNARY_OP_ASIN:
+		ZSL_MTX_UNARY_LOOP(ZSL_ASIN(x));
+		break;
+	case ZSL_MTX_UNARY_OP_ACOS:
+		ZSL_MTX_UNARY_LOOP(ZSL_ACOS(x));
+		break;
+	case ZSL_MTX_UNARY_OP_ATAN:
+		ZSL_MTX_UNARY_LOOP(ZSL_ATAN(x));
+		break;
+	case ZSL_MTX_UNARY_OP_SINH:
+		ZSL_MTX_UNARY_LOOP(ZSL_SINH(x));
+		break;
+	case ZSL_MTX_UNARY_OP_COSH:
+		ZSL_MTX_UNARY_LOOP(ZSL_COSH(x));
+		break;
+	case ZSL_MTX_UNARY_OP_TANH:
+		ZSL_MTX_UNARY_LOOP(ZSL_TANH(x));
+		break;
+	default:
+		/* Not yet implemented! */
+		return -ENOSYS;
+	}
+
+	return 0;
 }
 
 int
-zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+zsl_mtx_unary_func(struct zsl_mtx *m, zsl_mtx_unary_fn_t fn)
 {
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Ensure that ma has the same number as columns as mb has rows. */
-	if (ma->sz_cols != mb->sz_rows) {
-		return -EINVAL;
-	}
+	int rc;
 
-	/* Ensure that mc has ma rows and mb cols */
-	if ((mc->sz_rows != ma->sz_rows) || (mc->sz_cols != mb->sz_cols)) {
-		return -EINVAL;
+	/* If fn is NULL, do nothing. */
+	if (fn == NULL) {
+		return 0;
 	}
-#endif
 
-	for (size_t i = 0; i < ma->sz_rows; i++) {
-		for (size_t j = 0; j < mb->sz_cols; j++) {
-			mc->data[j + i * mb->sz_cols] = 0;
-			for (size_t k = 0; k < ma->sz_cols; k++) {
-				mc->data[j + i * mb->sz_cols] +=
-					ma->data[k + i * ma->sz_cols] *
-					mb->data[j + k * mb->sz_cols];
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			rc = fn(m, i, j);
+			if (rc) {
+				return rc;
 			}
 		}
 	}
@@ -474,1213 +581,5776 @@ zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 }
 
 int
-zsl_mtx_scalar_mult_d(struct zsl_mtx *m, zsl_real_t s)
+zsl_mtx_unary_func_rows(struct zsl_mtx *m, zsl_mtx_unary_row_fn_t fn)
 {
-	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
-		m->data[i] *= s;
+	int rc;
+
+	/* If fn is NULL, do nothing. */
+	if (fn == NULL) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		rc = fn(&m->data[i * m->sz_cols], m->sz_cols, i);
+		if (rc) {
+			return rc;
+		}
 	}
 
 	return 0;
 }
 
+/*
+ * Assigns 'expr', in terms of the coefficients 'x' and 'y' of 'a' and 'b',
+ * to each of the 'sz' coefficients in 'c'.
+ */
+#define ZSL_MTX_BINARY_LOOP(expr)			 \
+	for (size_t i = 0; i < sz; i++) {		 \
+		zsl_real_t x = a[i];			 \
+		zsl_real_t y = b[i];			 \
+		c[i] = (expr);				 \
+	}
+
 int
-zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s)
+zsl_mtx_binary_op(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		  struct zsl_mtx *mc, zsl_mtx_binary_op_t op)
 {
+	const size_t sz = ma->sz_cols * ma->sz_rows;
+	const zsl_real_t *a = ma->data;
+	const zsl_real_t *b = mb->data;
+	zsl_real_t *c = mc->data;
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	if (i >= m->sz_rows) {
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	for (size_t k = 0; k < m->sz_cols; k++) {
-		m->data[(i * m->sz_cols) + k] *= s;
+	switch (op) {
+	case ZSL_MTX_BINARY_OP_ADD:
+		ZSL_MTX_BINARY_LOOP(x + y);
+		break;
+	case ZSL_MTX_BINARY_OP_SUB:
+		ZSL_MTX_BINARY_LOOP(x - y);
+		break;
+	case ZSL_MTX_BINARY_OP_MULT:
+		ZSL_MTX_BINARY_LOOP(x * y);
+		break;
+	case ZSL_MTX_BINARY_OP_DIV:
+		ZSL_MTX_BINARY_LOOP(y == 0.0 ? 0.0 : x / y);
+		break;
+	case ZSL_MTX_BINARY_OP_MEAN:
+		ZSL_MTX_BINARY_LOOP((x + y) / 2.0);
+		break;
+	case ZSL_MTX_BINARY_OP_EXPON:
+		ZSL_MTX_BINARY_LOOP(ZSL_POW(x, y));
+		break;
+	case ZSL_MTX_BINARY_OP_MIN:
+		ZSL_MTX_BINARY_LOOP(x < y ? x : y);
+		break;
+	case ZSL_MTX_BINARY_OP_MAX:
+		ZSL_MTX_BINARY_LOOP(x > y ? x : y);
+		break;
+	case ZSL_MTX_BINARY_OP_EQUAL:
+		ZSL_MTX_BINARY_LOOP(x == y ? 1.0 : 0.0);
+		break;
+	case ZSL_MTX_BINARY_OP_NEQUAL:
+		ZSL_MTX_BINARY_LOOP(x != y ? 1.0 : 0.0);
+		break;
+	case ZSL_MTX_BINARY_OP_LESS:
+		ZSL_MTX_BINARY_LOOP(x < y ? 1.0 : 0.0);
+		break;
+	case ZSL_MTX_BINARY_OP_GREAT:
+		ZSL_MTX_BINARY_LOOP(x > y ? 1.0 : 0.0);
+		break;
+	case ZSL_MTX_BINARY_OP_LEQ:
+		ZSL_MTX_BINARY_LOOP(x <= y ? 1.0 : 0.0);
+		break;
+	case ZSL_MTX_BINARY_OP_GEQ:
+		ZSL_MTX_BINARY_LOOP(x >= y ? 1.0 : 0.0);
+		break;
+	default:
+		/* Not yet implemented! */
+		return -ENOSYS;
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
+zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
+		    struct zsl_mtx *mc, zsl_mtx_binary_fn_t fn)
 {
+	int rc;
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Ensure that ma and mb have the same shape. */
-	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	zsl_real_t d[ma->sz_cols];
-
+	/* If fn is NULL, do nothing. */
+	if (fn == NULL) {
+		return 0;
+	}
+
 	for (size_t i = 0; i < ma->sz_rows; i++) {
-		zsl_mtx_get_row(ma, i, d);
-		zsl_mtx_set_col(mb, i, d);
+		for (size_t j = 0; j < ma->sz_cols; j++) {
+			rc = fn(ma, mb, mc, i, j);
+			if (rc) {
+				return rc;
+			}
+		}
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma)
+zsl_mtx_binary_func_rows(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+			 struct zsl_mtx *mc, zsl_mtx_binary_row_fn_t fn)
 {
-	/* Make sure this is a square matrix. */
-	if ((m->sz_rows != m->sz_cols) || (ma->sz_rows != ma->sz_cols)) {
-		return -EINVAL;
-	}
+	int rc;
+	size_t n = ma->sz_cols;
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure this is a 3x3 matrix. */
-	if ((m->sz_rows != 3) || (ma->sz_rows != 3)) {
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	/*
-	 * 3x3 matrix element to array table:
-	 *
-	 * 1,1 = 0  1,2 = 1  1,3 = 2
-	 * 2,1 = 3  2,2 = 4  2,3 = 5
-	 * 3,1 = 6  3,2 = 7  3,3 = 8
-	 */
-
-	ma->data[0] = m->data[4] * m->data[8] - m->data[7] * m->data[5];
-	ma->data[1] = m->data[7] * m->data[2] - m->data[1] * m->data[8];
-	ma->data[2] = m->data[1] * m->data[5] - m->data[4] * m->data[2];
-
-	ma->data[3] = m->data[6] * m->data[5] - m->data[3] * m->data[8];
-	ma->data[4] = m->data[0] * m->data[8] - m->data[6] * m->data[2];
-	ma->data[5] = m->data[3] * m->data[2] - m->data[0] * m->data[5];
+	/* If fn is NULL, do nothing. */
+	if (fn == NULL) {
+		return 0;
+	}
 
-	ma->data[6] = m->data[3] * m->data[7] - m->data[6] * m->data[4];
-	ma->data[7] = m->data[6] * m->data[1] - m->data[0] * m->data[7];
-	ma->data[8] = m->data[0] * m->data[4] - m->data[3] * m->data[1];
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		rc = fn(&ma->data[i * n], &mb->data[i * n], &mc->data[i * n], n,
+			i);
+		if (rc) {
+			return rc;
+		}
+	}
 
 	return 0;
 }
 
-int
-zsl_mtx_adjoint(struct zsl_mtx *m, struct zsl_mtx *ma)
+#if CONFIG_ZSL_MATRIX_INLINE
+/*
+ * Returns true if 'ma', 'mb' and (unless NULL) 'mc' are all square and of
+ * the same size, in which case they may be passed to a fixed-size kernel.
+ */
+static bool
+zsl_mtx_fixed_sq(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+		 const struct zsl_mtx *mc)
 {
-	/* Shortcut for 3x3 matrices. */
-	if (m->sz_rows == 3) {
-		return zsl_mtx_adjoint_3x3(m, ma);
-	}
+	size_t n = ma->sz_rows;
 
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure this is a square matrix. */
-	if (m->sz_rows != m->sz_cols) {
-		return -EINVAL;
+	if ((ma->sz_cols != n) || (mb->sz_rows != n) || (mb->sz_cols != n)) {
+		return false;
 	}
-#endif
 
-	zsl_real_t sign;
-	zsl_real_t d;
-	ZSL_MATRIX_DEF(mr, (m->sz_cols - 1), (m->sz_cols - 1));
+	return (mc == NULL) || ((mc->sz_rows == n) && (mc->sz_cols == n));
+}
+#endif
 
-	for (size_t i = 0; i < m->sz_cols; i++) {
-		for (size_t j = 0; j < m->sz_cols; j++) {
-			sign = 1.0;
-			if ((i + j) % 2 != 0) {
-				sign = -1.0;
-			}
-			zsl_mtx_reduce(m, &mr, i, j);
-			zsl_mtx_deter(&mr, &d);
-			d *= sign;
-			zsl_mtx_set(ma, i, j, d);
+int
+zsl_mtx_add(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+	    struct zsl_mtx *mc)
+{
+#if CONFIG_ZSL_MATRIX_INLINE
+	if (zsl_mtx_fixed_sq(ma, mb, mc)) {
+		switch (ma->sz_rows) {
+		case 2:
+			zsl_mtx22_add(ma->data, mb->data, mc->data);
+			return 0;
+		case 3:
+			zsl_mtx33_add(ma->data, mb->data, mc->data);
+			return 0;
+		case 4:
+			zsl_mtx44_add(ma->data, mb->data, mc->data);
+			return 0;
+		case 6:
+			zsl_mtx66_add(ma->data, mb->data, mc->data);
+			return 0;
+		default:
+			break;
 		}
 	}
+#endif
 
-	return 0;
+
+	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_ADD);
 }
 
 int
-zsl_mtx_reduce(struct zsl_mtx *m, struct zsl_mtx *mr, size_t i, size_t j)
+zsl_mtx_add_d(struct zsl_mtx *ma, const struct zsl_mtx *mb)
 {
-	size_t u = 0;
-	zsl_real_t x;
-	zsl_real_t v[mr->sz_rows * mr->sz_rows];
+	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_ADD);
+}
 
+int
+zsl_mtx_sum_rows_d(struct zsl_mtx *m, size_t i, size_t j)
+{
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure mr is 1 less than m. */
-	if (mr->sz_rows != m->sz_rows - 1) {
+	if ((i >= m->sz_rows) || (j >= m->sz_rows)) {
 		return -EINVAL;
 	}
-	if (mr->sz_cols != m->sz_cols - 1) {
-		return -EINVAL;
+#endif
+
+	/* Add row j to row i, element by element. */
+	for (size_t x = 0; x < m->sz_cols; x++) {
+		m->data[(i * m->sz_cols) + x] += m->data[(j * m->sz_cols) + x];
 	}
+
+	return 0;
+}
+
+int zsl_mtx_sum_rows_scaled_d(struct zsl_mtx *m,
+			      size_t i, size_t j, zsl_real_t s)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
 	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
 		return -EINVAL;
 	}
 #endif
 
-	for (size_t k = 0; k < m->sz_rows; k++) {
-		for (size_t g = 0; g < m->sz_rows; g++) {
-			if (k != i && g != j) {
-				zsl_mtx_get(m, k, g, &x);
-				v[u] = x;
-				u++;
-			}
-		}
+	/* Set the values in row 'i' to 'i[n] += j[n] * s' . */
+	for (size_t x = 0; x < m->sz_cols; x++) {
+		m->data[(i * m->sz_cols) + x] +=
+			(m->data[(j * m->sz_cols) + x] * s);
 	}
 
-	zsl_mtx_from_arr(mr, v);
-
 	return 0;
 }
 
 int
-zsl_mtx_reduce_iter(struct zsl_mtx *m, struct zsl_mtx *mred)
+zsl_mtx_sub(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+	    struct zsl_mtx *mc)
 {
-	/* TODO: Properly check if matrix is square. */
-	if (m->sz_rows == mred->sz_rows) {
-		zsl_mtx_copy(mred, m);
-		return 0;
+#if CONFIG_ZSL_MATRIX_INLINE
+	if (zsl_mtx_fixed_sq(ma, mb, mc)) {
+		switch (ma->sz_rows) {
+		case 2:
+			zsl_mtx22_sub(ma->data, mb->data, mc->data);
+			return 0;
+		case 3:
+			zsl_mtx33_sub(ma->data, mb->data, mc->data);
+			return 0;
+		case 4:
+			zsl_mtx44_sub(ma->data, mb->data, mc->data);
+			return 0;
+		case 6:
+			zsl_mtx66_sub(ma->data, mb->data, mc->data);
+			return 0;
+		default:
+			break;
+		}
 	}
+#endif
 
-	ZSL_MATRIX_DEF(my, (m->sz_rows - 1), (m->sz_cols - 1));
-	zsl_mtx_reduce(m, &my, 0, 0);
-	zsl_mtx_reduce_iter(&my, mred);
-
-	return 0;
+	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_SUB);
 }
 
 int
-zsl_mtx_augm_diag(struct zsl_mtx *m, struct zsl_mtx *maug)
+zsl_mtx_sub_d(struct zsl_mtx *ma, const struct zsl_mtx *mb)
 {
-	zsl_real_t x;
-	/* TODO: Properly check if matrix is square, and diff > 0. */
-	size_t diff = (maug->sz_rows) - (m->sz_rows);
+	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_SUB);
+}
 
-	zsl_mtx_init(maug, zsl_mtx_entry_fn_identity);
-	for (size_t i = 0; i < m->sz_rows; i++) {
-		for (size_t j = 0; j < m->sz_rows; j++) {
-			zsl_mtx_get(m, i, j, &x);
-			zsl_mtx_set(maug, i + diff, j + diff, x);
+/**
+ * @brief Accumulates the rows [i0, i1) and columns [j0, j1) of 'c' with the
+ *        products of 'a' and 'b' over the shared index range [k0, k1),
+ *        using a 4x4 register tile for the bulk of the block and a scalar
+ *        loop for any leftover edge rows or columns.
+ *
+ * Each operand is row-major, with consecutive rows 'lda', 'ldb' and 'ldc'
+ * entries apart. The 'k' index is always traversed in ascending order for
+ * every output coefficient, so the results are identical to those of the
+ * simple loop.
+ */
+static void
+zsl_mtx_mult_block(const zsl_real_t *a, size_t lda, const zsl_real_t *b,
+		   size_t ldb, zsl_real_t *c, size_t ldc,
+		   size_t i0, size_t i1, size_t j0, size_t j1,
+		   size_t k0, size_t k1)
+{
+	size_t i, j, k;
+
+	for (i = i0; i + 4 <= i1; i += 4) {
+		const zsl_real_t *a0 = &a[i * lda];
+		const zsl_real_t *a1 = a0 + lda;
+		const zsl_real_t *a2 = a1 + lda;
+		const zsl_real_t *a3 = a2 + lda;
+
+		for (j = j0; j + 4 <= j1; j += 4) {
+			zsl_real_t *c0 = &c[i * ldc + j];
+			zsl_real_t *c1 = c0 + ldc;
+			zsl_real_t *c2 = c1 + ldc;
+			zsl_real_t *c3 = c2 + ldc;
+
+			/* Keep the 4x4 output tile in registers. */
+			zsl_real_t c00 = c0[0], c01 = c0[1];
+			zsl_real_t c02 = c0[2], c03 = c0[3];
+			zsl_real_t c10 = c1[0], c11 = c1[1];
+			zsl_real_t c12 = c1[2], c13 = c1[3];
+			zsl_real_t c20 = c2[0], c21 = c2[1];
+			zsl_real_t c22 = c2[2], c23 = c2[3];
+			zsl_real_t c30 = c3[0], c31 = c3[1];
+			zsl_real_t c32 = c3[2], c33 = c3[3];
+
+			for (k = k0; k < k1; k++) {
+				const zsl_real_t *bk = &b[k * ldb + j];
+				zsl_real_t b0 = bk[0], b1 = bk[1];
+				zsl_real_t b2 = bk[2], b3 = bk[3];
+				zsl_real_t ak;
+
+				ak = a0[k];
+				c00 += ak * b0; c01 += ak * b1;
+				c02 += ak * b2; c03 += ak * b3;
+				ak = a1[k];
+				c10 += ak * b0; c11 += ak * b1;
+				c12 += ak * b2; c13 += ak * b3;
+				ak = a2[k];
+				c20 += ak * b0; c21 += ak * b1;
+				c22 += ak * b2; c23 += ak * b3;
+				ak = a3[k];
+				c30 += ak * b0; c31 += ak * b1;
+				c32 += ak * b2; c33 += ak * b3;
+			}
+
+			c0[0] = c00; c0[1] = c01; c0[2] = c02; c0[3] = c03;
+			c1[0] = c10; c1[1] = c11; c1[2] = c12; c1[3] = c13;
+			c2[0] = c20; c2[1] = c21; c2[2] = c22; c2[3] = c23;
+			c3[0] = c30; c3[1] = c31; c3[2] = c32; c3[3] = c33;
+		}
+
+		/* Leftover columns for this 4-row strip. */
+		for (; j < j1; j++) {
+			for (size_t r = i; r < i + 4; r++) {
+				zsl_real_t sum = c[r * ldc + j];
+				for (k = k0; k < k1; k++) {
+					sum += a[r * lda + k] * b[k * ldb + j];
+				}
+				c[r * ldc + j] = sum;
+			}
 		}
 	}
 
-	return 0;
+	/* Leftover rows, traversing 'b' and 'c' row-wise. */
+	for (; i < i1; i++) {
+		for (k = k0; k < k1; k++) {
+			zsl_real_t ak = a[i * lda + k];
+			for (j = j0; j < j1; j++) {
+				c[i * ldc + j] += ak * b[k * ldb + j];
+			}
+		}
+	}
 }
 
-int
-zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d)
+/**
+ * @brief Computes c = a * b, or c += a * b if 'acc' is true, where 'a' is
+ *        m x p and 'b' is p x n, with the same row strides as
+ *        @ref zsl_mtx_mult_block.
+ */
+static void
+zsl_mtx_mult_strided(const zsl_real_t *a, size_t lda, const zsl_real_t *b,
+		     size_t ldb, zsl_real_t *c, size_t ldc,
+		     size_t m, size_t n, size_t p, bool acc)
 {
-	/* Make sure this is a square matrix. */
-	if (m->sz_rows != m->sz_cols) {
-		return -EINVAL;
+	const size_t bs = ZSL_MTX_MULT_BLOCK_SIZE;
+
+	for (size_t i = 0; !acc && i < m; i++) {
+		memset(&c[i * ldc], 0, n * sizeof(zsl_real_t));
 	}
 
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure this is a 3x3 matrix. */
-	if (m->sz_rows != 3) {
-		return -EINVAL;
+	/* Small inputs fit in cache already: skip the blocking overhead. */
+	if ((m < 4 || n < 4) || (m <= bs && n <= bs && p <= bs)) {
+		zsl_mtx_mult_block(a, lda, b, ldb, c, ldc, 0, m, 0, n, 0, p);
+		return;
 	}
-#endif
 
-	/*
-	 * 3x3 matrix element to array table:
-	 *
-	 * 1,1 = 0  1,2 = 1  1,3 = 2
-	 * 2,1 = 3  2,2 = 4  2,3 = 5
-	 * 3,1 = 6  3,2 = 7  3,3 = 8
-	 */
+	/* Walk 'b' in bs x bs panels so that the active blocks of 'a', 'b'
+	 * and 'c' stay resident in the data cache. */
+	for (size_t k0 = 0; k0 < p; k0 += bs) {
+		size_t k1 = (k0 + bs < p) ? k0 + bs : p;
+		for (size_t i0 = 0; i0 < m; i0 += bs) {
+			size_t i1 = (i0 + bs < m) ? i0 + bs : m;
+			for (size_t j0 = 0; j0 < n; j0 += bs) {
+				size_t j1 = (j0 + bs < n) ? j0 + bs : n;
+				zsl_mtx_mult_block(a, lda, b, ldb, c, ldc,
+						   i0, i1, j0, j1, k0, k1);
+			}
+		}
+	}
+}
 
-	*d = m->data[0] * (m->data[4] * m->data[8] - m->data[7] * m->data[5]);
-	*d -= m->data[3] * (m->data[1] * m->data[8] - m->data[7] * m->data[2]);
-	*d += m->data[6] * (m->data[1] * m->data[5] - m->data[4] * m->data[2]);
+#if CONFIG_ZSL_SMP
+/* The operands of a zsl_mtx_mult_strided call, split by rows of 'c'. */
+struct zsl_mtx_mult_task {
+	const zsl_real_t *a;
+	const zsl_real_t *b;
+	zsl_real_t *c;
+	size_t lda, ldb, ldc;
+	size_t n, p;
+	bool acc;
+};
+
+static void
+zsl_mtx_mult_task_rows(void *arg, size_t i0, size_t i1)
+{
+	struct zsl_mtx_mult_task *t = arg;
 
-	return 0;
+	zsl_mtx_mult_strided(&t->a[i0 * t->lda], t->lda, t->b, t->ldb,
+			     &t->c[i0 * t->ldc], t->ldc, i1 - i0, t->n, t->p,
+			     t->acc);
+}
+#endif
+
+/**
+ * @brief Equivalent to @ref zsl_mtx_mult_strided, dividing the rows of 'c'
+ *        across the worker pool with CONFIG_ZSL_SMP.
+ */
+static void
+zsl_mtx_mult_par(const zsl_real_t *a, size_t lda, const zsl_real_t *b,
+		 size_t ldb, zsl_real_t *c, size_t ldc,
+		 size_t m, size_t n, size_t p, bool acc)
+{
+#if CONFIG_ZSL_SMP
+	struct zsl_mtx_mult_task t = {
+		.a = a, .b = b, .c = c,
+		.lda = lda, .ldb = ldb, .ldc = ldc,
+		.n = n, .p = p,
+		.acc = acc
+	};
+
+	zsl_smp_for(zsl_mtx_mult_task_rows, &t, m, m * n * p);
+#else
+	zsl_mtx_mult_strided(a, lda, b, ldb, c, ldc, m, n, p, acc);
+#endif
 }
 
 int
-zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d)
+zsl_mtx_mult(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+	     struct zsl_mtx *mc)
 {
-	/* Shortcut for 3x3 matrices. */
-	if (m->sz_rows == 3) {
-		return zsl_mtx_deter_3x3(m, d);
-	}
+	ZSL_TRACE(ZSL_TRACE_MTX_MULT);
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure this is a square matrix. */
-	if (m->sz_rows != m->sz_cols) {
+	/* Ensure that ma has the same number as columns as mb has rows. */
+	if (ma->sz_cols != mb->sz_rows) {
 		return -EINVAL;
 	}
-#endif
-
-	/* Full calculation required for non 3x3 matrices. */
-	int rc;
-	zsl_real_t dtmp;
-	zsl_real_t cur;
-	zsl_real_t sign;
-	ZSL_MATRIX_DEF(mr, (m->sz_rows - 1), (m->sz_rows - 1));
 
-	/* Clear determinant output before starting. */
-	*d = 0.0;
+	/* Ensure that mc has ma rows and mb cols */
+	if ((mc->sz_rows != ma->sz_rows) || (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-	/*
-	 * Iterate across row 0, removing columns one by one.
-	 * Note that these calls are recursive until we reach a 3x3 matrix,
-	 * which will be calculated using the shortcut at the top of this
-	 * function.
-	 */
-	for (size_t g = 0; g < m->sz_cols; g++) {
-		zsl_mtx_get(m, 0, g, &cur);     /* Get value at (0, g). */
-		zsl_mtx_init(&mr, NULL);        /* Clear mr. */
-		zsl_mtx_reduce(m, &mr, 0, g);   /* Remove row 0, column g. */
-		rc = zsl_mtx_deter(&mr, &dtmp); /* Calc. determinant of mr. */
-		sign = 1.0;
-		if (rc) {
-			return -EINVAL;
+#if CONFIG_ZSL_MATRIX_INLINE
+	if (zsl_mtx_fixed_sq(ma, mb, mc)) {
+		switch (ma->sz_rows) {
+		case 2:
+			zsl_mtx22_mult(ma->data, mb->data, mc->data);
+			return 0;
+		case 3:
+			zsl_mtx33_mult(ma->data, mb->data, mc->data);
+			return 0;
+		case 4:
+			zsl_mtx44_mult(ma->data, mb->data, mc->data);
+			return 0;
+		case 6:
+			zsl_mtx66_mult(ma->data, mb->data, mc->data);
+			return 0;
+		default:
+			break;
 		}
+	}
 
-		/* Uneven elements are negative. */
-		if (g % 2 != 0) {
-			sign = -1.0;
+	/* Matrix-vector products with a square 'ma'. */
+	if ((ma->sz_rows == ma->sz_cols) && (mb->sz_rows == ma->sz_rows) &&
+	    (mb->sz_cols == 1) && (mc->sz_rows == ma->sz_rows) &&
+	    (mc->sz_cols == 1)) {
+		switch (ma->sz_rows) {
+		case 2:
+			zsl_mtx22_mult_vec(ma->data, mb->data, mc->data);
+			return 0;
+		case 3:
+			zsl_mtx33_mult_vec(ma->data, mb->data, mc->data);
+			return 0;
+		case 4:
+			zsl_mtx44_mult_vec(ma->data, mb->data, mc->data);
+			return 0;
+		case 6:
+			zsl_mtx66_mult_vec(ma->data, mb->data, mc->data);
+			return 0;
+		default:
+			break;
 		}
-
-		/* Add current determinant to final output value. */
-		*d += dtmp * cur * sign;
 	}
+#endif
+
+#if asm_mtx_mult
+	zsl_asm_mtx_mult(ma, mb, mc);
+#else
+	zsl_mtx_mult_par(ma->data, ma->sz_cols, mb->data, mb->sz_cols,
+			 mc->data, mc->sz_cols, ma->sz_rows, mb->sz_cols,
+			 ma->sz_cols, false);
+#endif
 
 	return 0;
 }
 
+/* The operands of a zsl_mtx_mult_ex call, split by rows of 'c'. */
+struct zsl_mtx_mult_ex_task {
+	const zsl_real_t *a;
+	const zsl_real_t *b;
+	zsl_real_t *c;
+	size_t lda, ldb;
+	size_t n, p;
+	bool trans_a;
+	zsl_real_t alpha, beta;
+};
+
+/* Rows i0 to i1 - 1 of c = alpha * op(a) * b^T + beta * c. */
+static void
+zsl_mtx_mult_ex_rows_bt(void *arg, size_t i0, size_t i1)
+{
+	struct zsl_mtx_mult_ex_task *t = arg;
+	const zsl_real_t *a = t->a;
+	const zsl_real_t *b = t->b;
+	zsl_real_t *c = t->c;
+	const size_t si = t->trans_a ? 1 : t->lda;
+	const size_t sk = t->trans_a ? t->lda : 1;
+	const size_t n = t->n;
+	zsl_real_t x;
+
+	for (size_t i = i0; i < i1; i++) {
+		for (size_t j = 0; j < n; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < t->p; k++) {
+				x += a[i * si + k * sk] * b[j * t->ldb + k];
+			}
+			c[i * n + j] = t->alpha * x +
+				       (t->beta == 0.0 ? 0.0 :
+					t->beta * c[i * n + j]);
+		}
+	}
+}
+
+/* Rows i0 to i1 - 1 of c += alpha * op(a) * b. */
+static void
+zsl_mtx_mult_ex_rows_b(void *arg, size_t i0, size_t i1)
+{
+	struct zsl_mtx_mult_ex_task *t = arg;
+	const zsl_real_t *a = t->a;
+	const zsl_real_t *b = t->b;
+	zsl_real_t *c = t->c;
+	const size_t lda = t->lda;
+	const size_t n = t->n;
+	zsl_real_t x;
+
+	for (size_t i = i0; i < i1; i++) {
+		for (size_t k = 0; k < t->p; k++) {
+			x = t->alpha * (t->trans_a ? a[k * lda + i] :
+					a[i * lda + k]);
+			for (size_t j = 0; j < n; j++) {
+				c[i * n + j] += x * b[k * t->ldb + j];
+			}
+		}
+	}
+}
+
 int
-zsl_mtx_gauss_elim(struct zsl_mtx *m, struct zsl_mtx *mg, struct zsl_mtx *mi,
-		   size_t i, size_t j)
+zsl_mtx_mult_ex(const struct zsl_mtx *ma, bool trans_a,
+		const struct zsl_mtx *mb, bool trans_b, zsl_real_t alpha,
+		zsl_real_t beta, struct zsl_mtx *mc)
 {
-	int rc;
-	zsl_real_t x, y;
-	zsl_real_t epsilon = 1E-6;
+	const size_t m = trans_a ? ma->sz_cols : ma->sz_rows;
+	const size_t p = trans_a ? ma->sz_rows : ma->sz_cols;
+	const size_t n = trans_b ? mb->sz_rows : mb->sz_cols;
+	const size_t lda = ma->sz_cols;
+	const size_t ldb = mb->sz_cols;
+	zsl_real_t *a = ma->data;
+	zsl_real_t *b = mb->data;
+	zsl_real_t *c = mc->data;
+	struct zsl_mtx_mult_ex_task t = {
+		.a = a, .b = b, .c = c,
+		.lda = lda, .ldb = ldb,
+		.n = n, .p = p,
+		.trans_a = trans_a,
+		.alpha = alpha, .beta = beta
+	};
 
-	/* Make a copy of matrix m. */
-	rc = zsl_mtx_copy(mg, m);
-	if (rc) {
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that op(ma) has the same number as columns as op(mb) has
+	 * rows, and that mc has op(ma) rows and op(mb) cols. */
+	if ((trans_b ? mb->sz_cols : mb->sz_rows) != p) {
+		return -EINVAL;
+	}
+	if ((mc->sz_rows != m) || (mc->sz_cols != n)) {
 		return -EINVAL;
 	}
+#endif
 
-	/* Get the value of the element at position (i, j). */
-	rc = zsl_mtx_get(mg, i, j, &y);
-	if (rc) {
-		return rc;
+	/* The plain product can use the blocked kernel as is. */
+	if (!trans_a && !trans_b && (alpha == 1.0) && (beta == 0.0)) {
+		return zsl_mtx_mult(ma, mb, mc);
 	}
 
-	/* If this is a zero value, don't do anything. */
-	if ((y >= 0 && y < epsilon) || (y <= 0 && y > -epsilon)) {
+	/* A * B^T and A^T * B^T: each output entry is a dot product with a
+	 * row of 'mb'. */
+	if (trans_b) {
+		zsl_smp_for(zsl_mtx_mult_ex_rows_bt, &t, m, m * n * p);
 		return 0;
 	}
 
-	/* Cycle through the matrix row by row. */
-	for (size_t p = 0; p < mg->sz_rows; p++) {
-		/* Skip row 'i'. */
-		if (p == i) {
-			p++;
-		}
-		if (p == mg->sz_rows) {
-			break;
+	/* A * B and A^T * B: scale 'mc' by beta, then accumulate rows of 'mb'
+	 * into the rows of 'mc'. Beta is not multiplied in when zero, so that
+	 * uninitialised values in 'mc' are ignored. */
+	if (beta == 0.0) {
+		memset(c, 0, m * n * sizeof(zsl_real_t));
+	} else if (beta != 1.0) {
+		for (size_t i = 0; i < m * n; i++) {
+			c[i] *= beta;
 		}
-		/* Get the value of (p, j), aborting if value is zero. */
-		zsl_mtx_get(mg, p, j, &x);
-		if ((x >= 1E-6) || (x <= -1E-6)) {
-			rc = zsl_mtx_sum_rows_scaled_d(mg, p, i, -(x / y));
+	}
 
-			if (rc) {
-				return -EINVAL;
-			}
-			rc = zsl_mtx_sum_rows_scaled_d(mi, p, i, -(x / y));
-			if (rc) {
-				return -EINVAL;
-			}
-		}
+	/* An unscaled A * B can be accumulated by the blocked kernel. */
+	if (!trans_a && (alpha == 1.0)) {
+		zsl_mtx_mult_par(a, lda, b, ldb, c, n, m, n, p, true);
+		return 0;
 	}
 
+	zsl_smp_for(zsl_mtx_mult_ex_rows_b, &t, m, m * n * p);
+
 	return 0;
 }
 
 int
-zsl_mtx_gauss_elim_d(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i, size_t j)
+zsl_mtx_gemm(const struct zsl_mtx *ma, const struct zsl_mtx *mb,
+	     zsl_real_t alpha, zsl_real_t beta, struct zsl_mtx *mc)
 {
-	return zsl_mtx_gauss_elim(m, m, mi, i, j);
+	return zsl_mtx_mult_ex(ma, false, mb, false, alpha, beta, mc);
 }
 
 int
-zsl_mtx_gauss_reduc(struct zsl_mtx *m, struct zsl_mtx *mi,
-		    struct zsl_mtx *mg)
+zsl_mtx_axpy(zsl_real_t alpha, const struct zsl_mtx *mx, struct zsl_mtx *my)
 {
-	zsl_real_t v[m->sz_rows];
-	zsl_real_t epsilon = 1E-6;
-	zsl_real_t x;
-	zsl_real_t y;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the matrices are identically shaped. */
+	if ((mx->sz_rows != my->sz_rows) || (mx->sz_cols != my->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-	/* Copy the input matrix into 'mg' so all the changes will be done to
-	 * 'mg' and the input matrix will not be destroyed. */
-	zsl_mtx_copy(mg, m);
+	for (size_t i = 0; i < mx->sz_rows * mx->sz_cols; i++) {
+		my->data[i] += alpha * mx->data[i];
+	}
 
-	for (size_t k = 0; k < m->sz_rows; k++) {
+	return 0;
+}
 
-		/* Get every element in the diagonal. */
-		zsl_mtx_get(mg, k, k, &x);
+int
+zsl_mtx_ger(zsl_real_t alpha, const struct zsl_vec *x, const struct zsl_vec *y,
+	    struct zsl_mtx *m)
+{
+	zsl_real_t ax;
+	zsl_real_t *row;
 
-		/* If the diagonal element is zero, find another value in the
-		 * same column that isn't zero and add the row containing
-		 * the non-zero element to the diagonal element's row. */
-		if ((x >= 0 && x < epsilon) || (x <= 0 && x > -epsilon)) {
-			zsl_mtx_get_col(mg, k, v);
-			for (size_t q = 0; q < m->sz_rows; q++) {
-				zsl_mtx_get(mg, q, q, &y);
-				if ((v[q] >= epsilon) || (v[q] <= -epsilon)) {
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is x->sz x y->sz. */
+	if ((m->sz_rows != x->sz) || (m->sz_cols != y->sz)) {
+		return -EINVAL;
+	}
+#endif
 
-					/* If the non-zero element found is
-					 * above the diagonal, only add its row
-					 * if the diagonal element in this row
-					 * is zero, to avoid undoing previous
-					 * steps. */
-					if (q < k && ((y >= epsilon)
-						      || (y <= -epsilon))) {
-					} else {
-						zsl_mtx_sum_rows_d(mg, k, q);
-						zsl_mtx_sum_rows_d(mi, k, q);
-						break;
-					}
-				}
-			}
+	for (size_t i = 0; i < x->sz; i++) {
+		ax = alpha * x->data[i];
+		row = &m->data[i * m->sz_cols];
+		for (size_t j = 0; j < y->sz; j++) {
+			row[j] += ax * y->data[j];
 		}
+	}
 
-		/* Perform the gaussian elimination in the column of the
-		 * diagonal element to get rid of all the values in the column
-		 * except for the diagonal one. */
-		zsl_mtx_gauss_elim_d(mg, mi, k, k);
+	return 0;
+}
 
-		/* Divide the diagonal element's row by the diagonal element. */
-		zsl_mtx_norm_elem_d(mg, mi, k, k);
+int
+zsl_mtx_view_mult(const struct zsl_mtx_view *va, const struct zsl_mtx_view *vb,
+		  struct zsl_mtx_view *vc)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that va has the same number as columns as vb has rows. */
+	if (va->sz_cols != vb->sz_rows) {
+		return -EINVAL;
 	}
 
+	/* Ensure that vc has va rows and vb cols */
+	if ((vc->sz_rows != va->sz_rows) || (vc->sz_cols != vb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_mtx_mult_par(va->data, va->ld, vb->data, vb->ld, vc->data,
+			 vc->ld, va->sz_rows, vb->sz_cols, va->sz_cols, false);
+
 	return 0;
 }
 
 int
-zsl_mtx_gram_schmidt(struct zsl_mtx *m, struct zsl_mtx *mort)
+zsl_mtx_batch_init(struct zsl_mtx_batch *b)
 {
-	ZSL_VECTOR_DEF(v, m->sz_rows);
-	ZSL_VECTOR_DEF(w, m->sz_rows);
-	ZSL_VECTOR_DEF(q, m->sz_rows);
+	memset(b->data, 0, b->sz_rows * b->sz_cols * b->sz_batch *
+	       sizeof(zsl_real_t));
 
-	for (size_t t = 0; t < m->sz_cols; t++) {
-		zsl_vec_init(&q);
-		zsl_mtx_get_col(m, t, v.data);
-		for (size_t g = 0; g < t; g++) {
-			zsl_mtx_get_col(mort, g, w.data);
+	return 0;
+}
 
-			/* Calculate the projection of every column vector
-			 * before 'g' on the 't'th column. */
-			zsl_vec_project(&w, &v, &w);
-			zsl_vec_add(&q, &w, &q);
-		}
+int
+zsl_mtx_batch_get(const struct zsl_mtx_batch *b, size_t idx, struct zsl_mtx *m)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((idx >= b->sz_batch) || (m->sz_rows != b->sz_rows) ||
+	    (m->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-		/* Substract the sum of the projections on the 't'th column from
-		 * the 't'th column and set this vector as the 't'th column of
-		 * the output matrix. */
-		zsl_vec_sub(&v, &q, &v);
-		zsl_mtx_set_col(mort, t, v.data);
+	for (size_t e = 0; e < b->sz_rows * b->sz_cols; e++) {
+		m->data[e] = b->data[e * b->sz_batch + idx];
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_cols_norm(struct zsl_mtx *m, struct zsl_mtx *mnorm)
+zsl_mtx_batch_set(struct zsl_mtx_batch *b, size_t idx, const struct zsl_mtx *m)
 {
-	ZSL_VECTOR_DEF(v, m->sz_rows);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((idx >= b->sz_batch) || (m->sz_rows != b->sz_rows) ||
+	    (m->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-	for (size_t g = 0; g < m->sz_cols; g++) {
-		zsl_mtx_get_col(m, g, v.data);
-		zsl_vec_to_unit(&v);
-		zsl_mtx_set_col(mnorm, g, v.data);
+	for (size_t e = 0; e < b->sz_rows * b->sz_cols; e++) {
+		b->data[e * b->sz_batch + idx] = m->data[e];
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_norm_elem(struct zsl_mtx *m, struct zsl_mtx *mn, struct zsl_mtx *mi,
-		  size_t i, size_t j)
+zsl_mtx_batch_mult(const struct zsl_mtx_batch *ba,
+		   const struct zsl_mtx_batch *bb, struct zsl_mtx_batch *bc)
 {
-	int rc;
-	zsl_real_t x;
-	zsl_real_t epsilon = 1E-6;
+	size_t nb = ba->sz_batch;
+	size_t n = ba->sz_cols;
+	size_t p = bb->sz_cols;
+	zsl_real_t *ra, *rb, *rc;
 
-	/* Make a copy of matrix m. */
-	rc = zsl_mtx_copy(mn, m);
-	if (rc) {
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((bb->sz_rows != n) || (bc->sz_rows != ba->sz_rows) ||
+	    (bc->sz_cols != p) || (bb->sz_batch != nb) ||
+	    (bc->sz_batch != nb)) {
 		return -EINVAL;
 	}
+#endif
 
-	/* Get the value to normalise. */
-	rc = zsl_mtx_get(mn, i, j, &x);
-	if (rc) {
-		return rc;
+	/*
+	 * Each output entry (i, j) is accumulated across the whole batch at
+	 * once, so the innermost loop is a unit-stride multiply-add over 'nb'
+	 * matrices.
+	 */
+	for (size_t i = 0; i < ba->sz_rows; i++) {
+		for (size_t j = 0; j < p; j++) {
+			rc = &bc->data[(i * p + j) * nb];
+			memset(rc, 0, nb * sizeof(zsl_real_t));
+			for (size_t k = 0; k < n; k++) {
+				ra = &ba->data[(i * n + k) * nb];
+				rb = &bb->data[(k * p + j) * nb];
+				for (size_t b = 0; b < nb; b++) {
+					rc[b] += ra[b] * rb[b];
+				}
+			}
+		}
 	}
 
-	/* If the value is 0.0, abort. */
-	if ((x >= 0 && x < epsilon) || (x <= 0 && x > -epsilon)) {
-		return 0;
-	}
+	return 0;
+}
 
-	rc = zsl_mtx_scalar_mult_row_d(mn, i, (1.0 / x));
-	if (rc) {
+int
+zsl_mtx_batch_inv_3x3(const struct zsl_mtx_batch *ba, struct zsl_mtx_batch *bi)
+{
+	size_t nb = ba->sz_batch;
+	zsl_real_t *a[9], *o[9];
+	zsl_real_t x[9], c[9];
+	zsl_real_t d;
+
+	if ((ba->sz_rows != 3) || (ba->sz_cols != 3) || (bi->sz_rows != 3) ||
+	    (bi->sz_cols != 3) || (bi->sz_batch != nb)) {
 		return -EINVAL;
 	}
 
-	rc = zsl_mtx_scalar_mult_row_d(mi, i, (1.0 / x));
-	if (rc) {
-		return -EINVAL;
+	for (size_t e = 0; e < 9; e++) {
+		a[e] = &ba->data[e * nb];
+		o[e] = &bi->data[e * nb];
+	}
+
+	/*
+	 * Each iteration only touches entry 'b' of the nine unit-stride
+	 * element arrays, and reads all of them before writing any, so 'bi'
+	 * may alias 'ba'.
+	 */
+	for (size_t b = 0; b < nb; b++) {
+		for (size_t e = 0; e < 9; e++) {
+			x[e] = a[e][b];
+		}
+
+		/* Transposed cofactors, i.e. the adjugate. */
+		c[0] = x[4] * x[8] - x[5] * x[7];
+		c[1] = x[2] * x[7] - x[1] * x[8];
+		c[2] = x[1] * x[5] - x[2] * x[4];
+		c[3] = x[5] * x[6] - x[3] * x[8];
+		c[4] = x[0] * x[8] - x[2] * x[6];
+		c[5] = x[2] * x[3] - x[0] * x[5];
+		c[6] = x[3] * x[7] - x[4] * x[6];
+		c[7] = x[1] * x[6] - x[0] * x[7];
+		c[8] = x[0] * x[4] - x[1] * x[3];
+
+		d = x[0] * c[0] + x[1] * c[3] + x[2] * c[6];
+		if (d != 0.0) {
+			d = 1.0 / d;
+			for (size_t e = 0; e < 9; e++) {
+				o[e][b] = c[e] * d;
+			}
+		} else {
+			/* Provide an identity matrix if the determinant is 0. */
+			for (size_t e = 0; e < 9; e++) {
+				o[e][b] = (e % 4 == 0) ? 1.0 : 0.0;
+			}
+		}
 	}
 
 	return 0;
 }
 
 int
-zsl_mtx_norm_elem_d(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i, size_t j)
+zsl_mtx_scalar_mult_d(struct zsl_mtx *m, zsl_real_t s)
 {
-	return zsl_mtx_norm_elem(m, m, mi, i, j);
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		m->data[i] *= s;
+	}
+
+	return 0;
 }
 
 int
-zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi)
+zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s)
 {
-	int rc;
-	zsl_real_t d;   /* Determinant. */
-	zsl_real_t s;   /* Scale factor. */
-
-	/* Make sure these are square matrices. */
-	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
-		return -EINVAL;
-	}
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure 'm' and 'mi' have the same shape. */
-	if (m->sz_rows != mi->sz_rows) {
+	if (i >= m->sz_rows) {
 		return -EINVAL;
 	}
-	if (m->sz_cols != mi->sz_cols) {
-		return -EINVAL;
+#endif
+
+	for (size_t k = 0; k < m->sz_cols; k++) {
+		m->data[(i * m->sz_cols) + k] *= s;
 	}
-	/* Make sure these are 3x3 matrices. */
-	if ((m->sz_cols != 3) || (mi->sz_cols != 3)) {
+
+	return 0;
+}
+
+#if !asm_mtx_trans
+int
+zsl_mtx_trans(const struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma and mb have the same shape. */
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
 		return -EINVAL;
 	}
 #endif
 
-	/* Calculate the determinant. */
-	rc = zsl_mtx_deter_3x3(m, &d);
-	if (rc) {
-		goto err;
+#if CONFIG_ZSL_MATRIX_INLINE
+	if (zsl_mtx_fixed_sq(ma, mb, NULL)) {
+		switch (ma->sz_rows) {
+		case 2:
+			zsl_mtx22_trans(ma->data, mb->data);
+			return 0;
+		case 3:
+			zsl_mtx33_trans(ma->data, mb->data);
+			return 0;
+		case 4:
+			zsl_mtx44_trans(ma->data, mb->data);
+			return 0;
+		case 6:
+			zsl_mtx66_trans(ma->data, mb->data);
+			return 0;
+		default:
+			break;
+		}
 	}
+#endif
 
-	/* Calculate the adjoint matrix. */
-	rc = zsl_mtx_adjoint_3x3(m, mi);
-	if (rc) {
-		goto err;
-	}
+	ZSL_INSTR_ENTER(instr);
 
-	/* Scale the output using the determinant. */
-	if (d != 0) {
-		s = 1.0 / d;
-		rc = zsl_mtx_scalar_mult_d(mi, s);
-	} else {
-		/* Provide an identity matrix if the determinant is zero. */
-		rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
-		if (rc) {
-			return -EINVAL;
-		}
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		zsl_mtx_col_store(mb, i, &ma->data[i * ma->sz_cols]);
 	}
 
 	return 0;
-err:
-	return rc;
 }
+#endif
 
-int
-zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
+/* Edge length below which in-place square transposes stop subdividing. */
+#define ZSL_MTX_TRANS_LEAF 16
+
+/*
+ * Swaps the block of rows [r0, r1) and columns [c0, c1) of the n x n matrix
+ * 'd' with its mirror image across the diagonal, transposing both. The
+ * block must lie entirely above the diagonal. The longer side is halved
+ * until the block is small enough to fit in cache, whatever its size.
+ */
+static void
+zsl_mtx_trans_swap(zsl_real_t *d, size_t n, size_t r0, size_t r1, size_t c0,
+		   size_t c1)
 {
-	int rc;
-	zsl_real_t d = 0.0;
+	zsl_real_t x;
 
-	/* Shortcut for 3x3 matrices. */
-	if (m->sz_rows == 3) {
-		return zsl_mtx_inv_3x3(m, mi);
+	if ((r1 - r0 > ZSL_MTX_TRANS_LEAF) && (r1 - r0 >= c1 - c0)) {
+		zsl_mtx_trans_swap(d, n, r0, (r0 + r1) / 2, c0, c1);
+		zsl_mtx_trans_swap(d, n, (r0 + r1) / 2, r1, c0, c1);
+	} else if (c1 - c0 > ZSL_MTX_TRANS_LEAF) {
+		zsl_mtx_trans_swap(d, n, r0, r1, c0, (c0 + c1) / 2);
+		zsl_mtx_trans_swap(d, n, r0, r1, (c0 + c1) / 2, c1);
+	} else {
+		for (size_t i = r0; i < r1; i++) {
+			for (size_t j = c0; j < c1; j++) {
+				x = d[i * n + j];
+				d[i * n + j] = d[j * n + i];
+				d[j * n + i] = x;
+			}
+		}
 	}
+}
 
-	/* Make sure we have square matrices. */
-	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
-		return -EINVAL;
-	}
+/*
+ * Transposes the diagonal block [i0, i1) x [i0, i1) of the n x n matrix 'd'
+ * in place, by transposing its two diagonal quarters and swapping the
+ * off-diagonal ones.
+ */
+static void
+zsl_mtx_trans_diag(zsl_real_t *d, size_t n, size_t i0, size_t i1)
+{
+	size_t mid = (i0 + i1) / 2;
 
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure 'm' and 'mi' have the same shape. */
-	if (m->sz_rows != mi->sz_rows) {
-		return -EINVAL;
-	}
-	if (m->sz_cols != mi->sz_cols) {
-		return -EINVAL;
+	if (i1 - i0 <= ZSL_MTX_TRANS_LEAF) {
+		for (size_t i = i0; i < i1; i++) {
+			zsl_mtx_trans_swap(d, n, i, i + 1, i + 1, i1);
+		}
+		return;
 	}
-#endif
 
-	/* Make a copy of matrix m on the stack to avoid modifying it. */
-	ZSL_MATRIX_DEF(m_tmp, mi->sz_rows, mi->sz_cols);
-	rc = zsl_mtx_copy(&m_tmp, m);
-	if (rc) {
-		return -EINVAL;
-	}
+	zsl_mtx_trans_diag(d, n, i0, mid);
+	zsl_mtx_trans_diag(d, n, mid, i1);
+	zsl_mtx_trans_swap(d, n, i0, mid, mid, i1);
+}
 
-	/* Initialise 'mi' as an identity matrix. */
-	rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
-	if (rc) {
-		return -EINVAL;
+int
+zsl_mtx_trans_d(struct zsl_mtx *m)
+{
+	size_t rows = m->sz_rows;
+	size_t last = rows * m->sz_cols - 1;
+	size_t k;
+	zsl_real_t x, y;
+
+	if (rows == m->sz_cols) {
+		zsl_mtx_trans_diag(m->data, rows, 0, rows);
+		return 0;
 	}
 
-	/* Make sure the determinant of 'm' is not zero. */
-	zsl_mtx_deter(m, &d);
+	/*
+	 * Rectangular (and non-empty) matrices are permuted by following
+	 * cycles: the entry at index k moves to (k * rows) mod (size - 1),
+	 * with the first and last entries fixed. Each cycle is applied once,
+	 * from its smallest index, so no record of visited entries is needed.
+	 */
+	for (size_t s = 1; (rows > 1) && (m->sz_cols > 1) && (s < last); s++) {
+		/* Only start from the lowest index in each cycle. */
+		k = (s * rows) % last;
+		while (k > s) {
+			k = (k * rows) % last;
+		}
+		if (k != s) {
+			continue;
+		}
 
-	if (d == 0) {
-		return 0;
+		x = m->data[s];
+		k = s;
+		do {
+			k = (k * rows) % last;
+			y = m->data[k];
+			m->data[k] = x;
+			x = y;
+		} while (k != s);
 	}
 
-	/* Use Gauss-Jordan elimination for nxn matrices. */
-	zsl_mtx_gauss_reduc(m, mi, &m_tmp);
+	m->sz_rows = m->sz_cols;
+	m->sz_cols = rows;
 
 	return 0;
 }
 
 int
-zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout)
+zsl_mtx_adjoint_3x3(const struct zsl_mtx *m, struct zsl_mtx *ma)
 {
-	int rc;
-	bool done = false;
-	zsl_real_t sum;
-	zsl_real_t row, row2;
-	zsl_real_t col, col2;
-
-	/* Make sure we have square matrices. */
-	if ((m->sz_rows != m->sz_cols) || (mout->sz_rows != mout->sz_cols)) {
+	/* Make sure this is a square matrix. */
+	if ((m->sz_rows != m->sz_cols) || (ma->sz_rows != ma->sz_cols)) {
 		return -EINVAL;
 	}
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure 'm' and 'mout' have the same shape. */
-	if (m->sz_rows != mout->sz_rows) {
-		return -EINVAL;
-	}
-	if (m->sz_cols != mout->sz_cols) {
+	/* Make sure this is a 3x3 matrix. */
+	if ((m->sz_rows != 3) || (ma->sz_rows != 3)) {
 		return -EINVAL;
 	}
 #endif
 
-	rc = zsl_mtx_copy(mout, m);
-	if (rc) {
-		goto err;
-	}
+	/*
+	 * 3x3 matrix element to array table:
+	 *
+	 * 1,1 = 0  1,2 = 1  1,3 = 2
+	 * 2,1 = 3  2,2 = 4  2,3 = 5
+	 * 3,1 = 6  3,2 = 7  3,3 = 8
+	 *
+	 * Every input is read before any output is written, so 'ma' may be
+	 * 'm'.
+	 */
+	zsl_real_t x[9];
 
-	while (!done) {
-		done = true;
+	memcpy(x, m->data, sizeof(x));
 
-		for (size_t i = 0; i < m->sz_rows; i++) {
-			/* Calculate sum of components of each row, column. */
-			for (size_t j = 0; j < m->sz_cols; j++) {
-				row += ZSL_ABS(mout->data[(i * m->sz_rows) +
-							  j]);
-				col += ZSL_ABS(mout->data[(j * m->sz_rows) +
-							  i]);
-			}
+	ma->data[0] = x[4] * x[8] - x[7] * x[5];
+	ma->data[1] = x[7] * x[2] - x[1] * x[8];
+	ma->data[2] = x[1] * x[5] - x[4] * x[2];
 
-			/* TODO: Extend with a check against epsilon? */
-			if (col != 0.0 && row != 0.0) {
-				row2 = row / 2.0;
-				col2 = 1.0;
-				sum = col + row;
+	ma->data[3] = x[6] * x[5] - x[3] * x[8];
+	ma->data[4] = x[0] * x[8] - x[6] * x[2];
+	ma->data[5] = x[3] * x[2] - x[0] * x[5];
 
-				while (col < row2) {
-					col2 *= 2.0;
-					col *= 4.0;
-				}
+	ma->data[6] = x[3] * x[7] - x[6] * x[4];
+	ma->data[7] = x[6] * x[1] - x[0] * x[7];
+	ma->data[8] = x[0] * x[4] - x[3] * x[1];
 
-				row2 = row * 2.0;
+	return 0;
+}
 
-				while (col > row2) {
+int
+zsl_mtx_adjoint(const struct zsl_mtx *m, struct zsl_mtx *ma)
+{
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_adjoint_3x3(m, ma);
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure this is a square matrix. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t sign;
+	zsl_real_t d;
+	ZSL_MATRIX_DEF(mr, (m->sz_cols - 1), (m->sz_cols - 1));
+	ZSL_INSTR_ENTER(instr);
+
+	for (size_t i = 0; i < m->sz_cols; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			sign = 1.0;
+			if ((i + j) % 2 != 0) {
+				sign = -1.0;
+			}
+			zsl_mtx_reduce(m, &mr, i, j);
+			zsl_mtx_deter(&mr, &d);
+			d *= sign;
+			zsl_mtx_put(ma, i, j, d);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_reduce(const struct zsl_mtx *m, struct zsl_mtx *mr, size_t i, size_t j)
+{
+	struct zsl_mtx_view vs, vd;
+	size_t ri[2] = { 0, i + 1 };
+	size_t rn[2] = { i, m->sz_rows - i - 1 };
+	size_t ci[2] = { 0, j + 1 };
+	size_t cn[2] = { j, m->sz_cols - j - 1 };
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure mr is 1 less than m. */
+	if (mr->sz_rows != m->sz_rows - 1) {
+		return -EINVAL;
+	}
+	if (mr->sz_cols != m->sz_cols - 1) {
+		return -EINVAL;
+	}
+	if ((i >= m->sz_rows) || (j >= m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Copy the (up to) four blocks around row 'i' and column 'j' into
+	 * place, a row segment at a time. */
+	for (size_t r = 0; r < 2; r++) {
+		for (size_t c = 0; c < 2; c++) {
+			if ((rn[r] == 0) || (cn[c] == 0)) {
+				continue;
+			}
+			vs.sz_rows = rn[r];
+			vs.sz_cols = cn[c];
+			vs.ld = m->sz_cols;
+			vs.data = &m->data[ri[r] * m->sz_cols + ci[c]];
+			zsl_mtx_view(mr, ri[r] - r, ci[c] - c, rn[r], cn[c],
+				     &vd);
+			zsl_mtx_view_copy(&vd, &vs);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_reduce_iter(struct zsl_mtx *m, struct zsl_mtx *mred)
+{
+	struct zsl_mtx_view vs, vd;
+	size_t k;
+
+	/* TODO: Properly check if matrix is square. */
+	if (mred->sz_rows > m->sz_rows) {
+		return -EINVAL;
+	}
+
+	/* Repeatedly removing the first row and column leaves the trailing
+	 * block of 'm', which is copied directly. */
+	k = m->sz_rows - mred->sz_rows;
+	zsl_mtx_view(m, k, k, mred->sz_rows, mred->sz_cols, &vs);
+	zsl_mtx_view(mred, 0, 0, mred->sz_rows, mred->sz_cols, &vd);
+	zsl_mtx_view_copy(&vd, &vs);
+
+	return 0;
+}
+
+int
+zsl_mtx_augm_diag(const struct zsl_mtx *m, struct zsl_mtx *maug)
+{
+	size_t diff;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure both matrices are square, and 'maug' is the larger. */
+	if ((m->sz_rows != m->sz_cols) || (maug->sz_rows != maug->sz_cols) ||
+	    (maug->sz_rows < m->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	diff = maug->sz_rows - m->sz_rows;
+
+	zsl_mtx_init(maug, zsl_mtx_entry_fn_identity);
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_rows; j++) {
+			zsl_mtx_put(maug, i + diff, j + diff,
+				    zsl_mtx_at(m, i, j));
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_deter_3x3(const struct zsl_mtx *m, zsl_real_t *d)
+{
+	/* Make sure this is a square matrix. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure this is a 3x3 matrix. */
+	if (m->sz_rows != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/*
+	 * 3x3 matrix element to array table:
+	 *
+	 * 1,1 = 0  1,2 = 1  1,3 = 2
+	 * 2,1 = 3  2,2 = 4  2,3 = 5
+	 * 3,1 = 6  3,2 = 7  3,3 = 8
+	 */
+
+	*d = m->data[0] * (m->data[4] * m->data[8] - m->data[7] * m->data[5]);
+	*d -= m->data[3] * (m->data[1] * m->data[8] - m->data[7] * m->data[2]);
+	*d += m->data[6] * (m->data[1] * m->data[5] - m->data[4] * m->data[2]);
+
+	return 0;
+}
+
+/*
+ * Factors square matrix 'a' in place using Gaussian elimination with partial
+ * pivoting, leaving U on and above the diagonal and the multipliers of L
+ * (whose unit diagonal is implied) below it. Each row swap is also applied
+ * to 'b' when it isn't NULL, and 'sign' is set to the parity of the row
+ * permutation (1.0 or -1.0). Columns without a usable pivot are skipped,
+ * leaving a zero on the diagonal of U.
+ */
+static void
+zsl_mtx_lu_fact(struct zsl_mtx *a, struct zsl_mtx *b, zsl_real_t *sign)
+{
+	size_t n = a->sz_rows;
+	size_t p;
+	zsl_real_t max;
+	zsl_real_t x;
+	zsl_real_t f;
+
+	*sign = 1.0;
+
+	for (size_t k = 0; k < n; k++) {
+		/* Find the largest value in column k, on or below the
+		 * diagonal. */
+		p = k;
+		max = ZSL_ABS(a->data[k * n + k]);
+		for (size_t i = k + 1; i < n; i++) {
+			x = ZSL_ABS(a->data[i * n + k]);
+			if (x > max) {
+				max = x;
+				p = i;
+			}
+		}
+
+		if (max == 0.0) {
+			continue;
+		}
+
+		/* Move the pivot row onto the diagonal. */
+		if (p != k) {
+			for (size_t j = 0; j < n; j++) {
+				x = a->data[k * n + j];
+				a->data[k * n + j] = a->data[p * n + j];
+				a->data[p * n + j] = x;
+			}
+			if (b != NULL) {
+				for (size_t j = 0; j < b->sz_cols; j++) {
+					x = b->data[k * b->sz_cols + j];
+					b->data[k * b->sz_cols + j] =
+						b->data[p * b->sz_cols + j];
+					b->data[p * b->sz_cols + j] = x;
+				}
+			}
+			*sign = -*sign;
+		}
+
+		/* Eliminate the values below the pivot. */
+		for (size_t i = k + 1; i < n; i++) {
+			f = a->data[i * n + k] / a->data[k * n + k];
+			a->data[i * n + k] = f;
+			for (size_t j = k + 1; j < n; j++) {
+				a->data[i * n + j] -= f * a->data[k * n + j];
+			}
+		}
+	}
+}
+
+/*
+ * Solves T * X = B in place in 'b', where 'a' is read as a lower (or upper)
+ * triangular matrix T, ignoring the elements in the other triangle. When
+ * 'unit' is set, the diagonal of T is taken to be 1.0 without being read.
+ */
+static void
+zsl_mtx_tri_subst(const struct zsl_mtx *a, struct zsl_mtx *b, bool lower,
+		  bool unit)
+{
+	size_t n = a->sz_rows;
+	size_t nc = b->sz_cols;
+	size_t i;
+	zsl_real_t f;
+
+	/* Rows are solved top down for lower, and bottom up for upper
+	 * triangular matrices, each using the rows already solved. */
+	for (size_t r = 0; r < n; r++) {
+		i = lower ? r : n - 1 - r;
+		for (size_t j = (lower ? 0 : i + 1); j < (lower ? i : n); j++) {
+			f = a->data[i * n + j];
+			for (size_t c = 0; c < nc; c++) {
+				b->data[i * nc + c] -= f * b->data[j * nc + c];
+			}
+		}
+		if (!unit) {
+			f = a->data[i * n + i];
+			for (size_t c = 0; c < nc; c++) {
+				b->data[i * nc + c] /= f;
+			}
+		}
+	}
+}
+
+/*
+ * Solves LU * X = B in place in 'b', where 'a' holds the L and U factors
+ * produced by zsl_mtx_lu_fact and 'b' has already been permuted.
+ */
+static void
+zsl_mtx_lu_subst(const struct zsl_mtx *a, struct zsl_mtx *b)
+{
+	zsl_mtx_tri_subst(a, b, true, true);
+	zsl_mtx_tri_subst(a, b, false, false);
+}
+
+int
+zsl_mtx_lu(const struct zsl_mtx *m, struct zsl_mtx *l, struct zsl_mtx *u,
+	   struct zsl_mtx *p)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	zsl_real_t sign;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'l', 'u' and 'p' are the same shape. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+	if ((l->sz_rows != n) || (l->sz_cols != n) ||
+	    (u->sz_rows != n) || (u->sz_cols != n) ||
+	    (p->sz_rows != n) || (p->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Factor a copy of 'm' in 'u', tracking the row swaps in 'p'. */
+	rc = zsl_mtx_copy(u, m);
+	if (rc) {
+		return rc;
+	}
+	zsl_mtx_init(p, zsl_mtx_entry_fn_identity);
+	zsl_mtx_lu_fact(u, p, &sign);
+
+	/* Move the multipliers below the diagonal of 'u' into 'l'. */
+	zsl_mtx_init(l, zsl_mtx_entry_fn_identity);
+	for (size_t i = 1; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			l->data[i * n + j] = u->data[i * n + j];
+			u->data[i * n + j] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_deter(const struct zsl_mtx *m, zsl_real_t *d)
+{
+	int rc;
+	zsl_real_t sign;
+	struct zsl_mtx lu;
+
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_deter_3x3(m, d);
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure this is a square matrix. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The determinant is the product of the diagonal of U, with the sign
+	 * flipped for every row swap made while factoring. */
+	ZSL_SCRATCH_DEF(ws, m->sz_rows * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &lu, m->sz_rows, m->sz_cols);
+	if (rc) {
+		goto err;
+	}
+	zsl_mtx_copy(&lu, m);
+	zsl_mtx_lu_fact(&lu, NULL, &sign);
+
+	*d = sign;
+	for (size_t i = 0; i < lu.sz_rows; i++) {
+		*d *= lu.data[i * lu.sz_cols + i];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_gauss_elim(struct zsl_mtx *m, struct zsl_mtx *mg, struct zsl_mtx *mi,
+		   size_t i, size_t j)
+{
+	int rc;
+	zsl_real_t x, y, f;
+	zsl_real_t epsilon = 1E-6;
+	zsl_real_t *rg, *ri;
+
+	/* Make a copy of matrix m. */
+	if (mg != m) {
+		rc = zsl_mtx_copy(mg, m);
+		if (rc) {
+			return -EINVAL;
+		}
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= mg->sz_rows) || (j >= mg->sz_cols) ||
+	    (mi->sz_rows != mg->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Get the value of the element at position (i, j). */
+	y = mg->data[i * mg->sz_cols + j];
+
+	/* If this is a zero value, don't do anything. */
+	if ((y >= 0 && y < epsilon) || (y <= 0 && y > -epsilon)) {
+		return 0;
+	}
+
+	rg = &mg->data[i * mg->sz_cols];
+	ri = &mi->data[i * mi->sz_cols];
+
+	/* Subtract a multiple of row 'i' from every other row, skipping$
+	 * rows where (p, j) is already zero. */
+	for (size_t p = 0; p < mg->sz_rows; p++) {
+		if (p == i) {
+			continue;
+		}
+		x = mg->data[p * mg->sz_cols + j];
+		if ((x < 1E-6) && (x > -1E-6)) {
+			continue;
+		}
+
+		f = -(x / y);
+		for (size_t k = 0; k < mg->sz_cols; k++) {
+			mg->data[p * mg->sz_cols + k] += f * rg[k];
+		}
+		for (size_t k = 0; k < mi->sz_cols; k++) {
+			mi->data[p * mi->sz_cols + k] += f * ri[k];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_gauss_elim_d(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i, size_t j)
+{
+	return zsl_mtx_gauss_elim(m, m, mi, i, j);
+}
+
+int
+zsl_mtx_gauss_reduc(struct zsl_mtx *m, struct zsl_mtx *mi,
+		    struct zsl_mtx *mg)
+{
+	zsl_real_t v[m->sz_rows];
+	zsl_real_t epsilon = 1E-6;
+	zsl_real_t x;
+	zsl_real_t y;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'mi' and 'mg' are the same shape. */
+	if ((m->sz_rows != m->sz_cols) ||
+	    (mi->sz_rows != m->sz_rows) || (mi->sz_cols != m->sz_cols) ||
+	    (mg->sz_rows != m->sz_rows) || (mg->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_INSTR_ENTER(instr);
+
+	/* Copy the input matrix into 'mg' so all the changes will be done to
+	 * 'mg' and the input matrix will not be destroyed. */
+	zsl_mtx_copy(mg, m);
+
+	for (size_t k = 0; k < m->sz_rows; k++) {
+
+		/* Get every element in the diagonal. */
+		x = zsl_mtx_at(mg, k, k);
+
+		/* If the diagonal element is zero, find another value in the
+		 * same column that isn't zero and add the row containing
+		 * the non-zero element to the diagonal element's row. */
+		if ((x >= 0 && x < epsilon) || (x <= 0 && x > -epsilon)) {
+			zsl_mtx_col_load(mg, k, v);
+			for (size_t q = 0; q < m->sz_rows; q++) {
+				y = zsl_mtx_at(mg, q, q);
+				if ((v[q] >= epsilon) || (v[q] <= -epsilon)) {
+
+					/* If the non-zero element found is
+					 * above the diagonal, only add its row
+					 * if the diagonal element in this row
+					 * is zero, to avoid undoing previous
+					 * steps. */
+					if (q < k && ((y >= epsilon)
+						      || (y <= -epsilon))) {
+					} else {
+						zsl_mtx_sum_rows_d(mg, k, q);
+						zsl_mtx_sum_rows_d(mi, k, q);
+						break;
+					}
+				}
+			}
+		}
+
+		/* Perform the gaussian elimination in the column of the
+		 * diagonal element to get rid of all the values in the column
+		 * except for the diagonal one. */
+		zsl_mtx_gauss_elim_d(mg, mi, k, k);
+
+		/* Divide the diagonal element's row by the diagonal element. */
+		zsl_mtx_norm_elem_d(mg, mi, k, k);
+	}
+
+	return 0;
+}
+
+/*
+ * Returns the row index, at or below row 'k', of the entry in column 'k'
+ * of the leading n x n block of 'm' with the largest magnitude.
+ */
+static size_t
+zsl_mtx_gauss_pivot(struct zsl_mtx *m, size_t n, size_t k)
+{
+	size_t p = k;
+	zsl_real_t big = ZSL_ABS(m->data[k * m->sz_cols + k]);
+
+	for (size_t i = k + 1; i < n; i++) {
+		if (ZSL_ABS(m->data[i * m->sz_cols + k]) > big) {
+			big = ZSL_ABS(m->data[i * m->sz_cols + k]);
+			p = i;
+		}
+	}
+
+	return p;
+}
+
+/* Returns the largest magnitude in the leading n x n block of 'm'. */
+static zsl_real_t
+zsl_mtx_gauss_norm(struct zsl_mtx *m, size_t n)
+{
+	zsl_real_t big = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			big = ZSL_MAX(big, ZSL_ABS(m->data[i * m->sz_cols + j]));
+		}
+	}
+
+	return big;
+}
+
+/* Swaps rows 'a' and 'b' of 'm'. */
+static void
+zsl_mtx_swap_rows(struct zsl_mtx *m, size_t a, size_t b)
+{
+	zsl_real_t x;
+	zsl_real_t *ra = &m->data[a * m->sz_cols];
+	zsl_real_t *rb = &m->data[b * m->sz_cols];
+
+	for (size_t j = 0; j < m->sz_cols; j++) {
+		x = ra[j];
+		ra[j] = rb[j];
+		rb[j] = x;
+	}
+}
+
+int
+zsl_mtx_gauss_jordan_d(struct zsl_mtx *m, size_t n)
+{
+	size_t p;
+	size_t cols = m->sz_cols;
+	zsl_real_t tol;
+	zsl_real_t f;
+	zsl_real_t *rk, *ri;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* The leading n x n block must fit within 'm'. */
+	if ((n > m->sz_rows) || (n > cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	tol = ZSL_MTX_EPS * (zsl_real_t)n * zsl_mtx_gauss_norm(m, n);
+
+	for (size_t k = 0; k < n; k++) {
+		/* Partial pivoting, stopping as soon as no usable pivot is
+		 * left in column 'k'. */
+		p = zsl_mtx_gauss_pivot(m, n, k);
+		if (!(ZSL_ABS(m->data[p * cols + k]) > tol)) {
+			return -ESINGULAR;
+		}
+		if (p != k) {
+			zsl_mtx_swap_rows(m, p, k);
+		}
+
+		/* Normalise the pivot row. Entries left of column 'k' are
+		 * already zero, so only columns k onwards are touched. */
+		rk = &m->data[k * cols];
+		f = 1.0 / rk[k];
+		for (size_t j = k; j < cols; j++) {
+			rk[j] *= f;
+		}
+
+		/* Clear column 'k' in every other row. */
+		for (size_t i = 0; i < n; i++) {
+			ri = &m->data[i * cols];
+			f = ri[k];
+			if ((i == k) || (f == 0.0)) {
+				continue;
+			}
+			for (size_t j = k; j < cols; j++) {
+				ri[j] -= f * rk[j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_inv_d(struct zsl_mtx *m)
+{
+	size_t n = m->sz_rows;
+	size_t piv[n];
+	size_t p;
+	zsl_real_t tol;
+	zsl_real_t f, x;
+	zsl_real_t *rk, *ri;
+
+	/* Make sure this is a square matrix. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+
+	tol = ZSL_MTX_EPS * (zsl_real_t)n * zsl_mtx_gauss_norm(m, n);
+
+	/*
+	 * Gauss-Jordan elimination, storing the inverse in place of the
+	 * columns that have been reduced to the identity: after step k,
+	 * column k holds column k of the inverse rather than e_k.
+	 */
+	for (size_t k = 0; k < n; k++) {
+		p = zsl_mtx_gauss_pivot(m, n, k);
+		if (!(ZSL_ABS(m->data[p * n + k]) > tol)) {
+			return -ESINGULAR;
+		}
+		piv[k] = p;
+		if (p != k) {
+			zsl_mtx_swap_rows(m, p, k);
+		}
+
+		rk = &m->data[k * n];
+		f = 1.0 / rk[k];
+		rk[k] = 1.0;
+		for (size_t j = 0; j < n; j++) {
+			rk[j] *= f;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			ri = &m->data[i * n];
+			f = ri[k];
+			if ((i == k) || (f == 0.0)) {
+				continue;
+			}
+			ri[k] = 0.0;
+			for (size_t j = 0; j < n; j++) {
+				ri[j] -= f * rk[j];
+			}
+		}
+	}
+
+	/* The row swaps applied to 'm' become column swaps of the inverse,
+	 * undone in reverse order. */
+	for (size_t k = n; k-- > 0;) {
+		if (piv[k] == k) {
+			continue;
+		}
+		for (size_t i = 0; i < n; i++) {
+			x = m->data[i * n + k];
+			m->data[i * n + k] = m->data[i * n + piv[k]];
+			m->data[i * n + piv[k]] = x;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Orthogonalises the columns of 'm' in place, using 'd' and 'qq' (one entry
+ * per column each) for the projection coefficients and the squared norm of
+ * each finished column.
+ *
+ * Each column has its projections onto the columns before it removed in one
+ * pass over the rows, so every access is contiguous. If that pass cancels
+ * more than half of the column's squared norm, rounding may have left it
+ * less than orthogonal, and the pass is repeated once ("twice is enough"),
+ * which makes this at least as stable as modified Gram-Schmidt.
+ */
+static void
+zsl_mtx_gram_schmidt_run(struct zsl_mtx *m, zsl_real_t *d, zsl_real_t *qq)
+{
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	zsl_real_t before, after, x;
+	zsl_real_t *ri;
+
+	for (size_t t = 0; t < cols; t++) {
+		before = 0.0;
+		for (size_t i = 0; i < rows; i++) {
+			x = m->data[i * cols + t];
+			before += x * x;
+		}
+		after = before;
+
+		for (size_t pass = 0; pass < 2 && t > 0; pass++) {
+			for (size_t g = 0; g < t; g++) {
+				d[g] = 0.0;
+			}
+			for (size_t i = 0; i < rows; i++) {
+				ri = &m->data[i * cols];
+				for (size_t g = 0; g < t; g++) {
+					d[g] += ri[g] * ri[t];
+				}
+			}
+			for (size_t g = 0; g < t; g++) {
+				d[g] = (qq[g] != 0.0) ? d[g] / qq[g] : 0.0;
+			}
+
+			after = 0.0;
+			for (size_t i = 0; i < rows; i++) {
+				ri = &m->data[i * cols];
+				x = ri[t];
+				for (size_t g = 0; g < t; g++) {
+					x -= d[g] * ri[g];
+				}
+				ri[t] = x;
+				after += x * x;
+			}
+
+			if (after >= 0.5 * before) {
+				break;
+			}
+			before = after;
+		}
+
+		qq[t] = after;
+	}
+}
+
+int
+zsl_mtx_gram_schmidt_d(struct zsl_mtx *m)
+{
+	int rc = 0;
+	zsl_real_t *d, *qq;
+
+	ZSL_SCRATCH_DEF(ws, 2 * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	d = zsl_ws_alloc(ws, m->sz_cols);
+	qq = zsl_ws_alloc(ws, m->sz_cols);
+	if (d == NULL || qq == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_gram_schmidt_run(m, d, qq);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_gram_schmidt(const struct zsl_mtx *m, struct zsl_mtx *mort)
+{
+	int rc;
+
+	if (mort != m) {
+		rc = zsl_mtx_copy(mort, m);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return zsl_mtx_gram_schmidt_d(mort);
+}
+
+/*
+ * Normalises the columns of 'm' in place, using 'n' (one entry per column)
+ * for their norms.
+ */
+static void
+zsl_mtx_cols_norm_run(struct zsl_mtx *m, zsl_real_t *n)
+{
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	zsl_real_t *ri;
+
+	/* Accumulate the column norms, then scale, a row at a time. */
+	for (size_t j = 0; j < cols; j++) {
+		n[j] = 0.0;
+	}
+	for (size_t i = 0; i < rows; i++) {
+		ri = &m->data[i * cols];
+		for (size_t j = 0; j < cols; j++) {
+			n[j] += ri[j] * ri[j];
+		}
+	}
+	for (size_t j = 0; j < cols; j++) {
+		n[j] = (n[j] != 0.0) ? 1.0 / ZSL_SQRT(n[j]) : 0.0;
+	}
+
+	for (size_t i = 0; i < rows; i++) {
+		ri = &m->data[i * cols];
+		for (size_t j = 0; j < cols; j++) {
+			/* As with zsl_vec_to_unit, zero columns become the
+			 * first unit vector. */
+			if (n[j] == 0.0) {
+				ri[j] = (i == 0) ? 1.0 : 0.0;
+			} else {
+				ri[j] *= n[j];
+			}
+		}
+	}
+}
+
+int
+zsl_mtx_cols_norm_d(struct zsl_mtx *m)
+{
+	int rc = 0;
+	zsl_real_t *n;
+
+	ZSL_SCRATCH_DEF(ws, m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	n = zsl_ws_alloc(ws, m->sz_cols);
+	if (n == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_cols_norm_run(m, n);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_cols_norm(const struct zsl_mtx *m, struct zsl_mtx *mnorm)
+{
+	int rc;
+
+	if (mnorm != m) {
+		rc = zsl_mtx_copy(mnorm, m);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return zsl_mtx_cols_norm_d(mnorm);
+}
+
+int
+zsl_mtx_norm_elem(struct zsl_mtx *m, struct zsl_mtx *mn, struct zsl_mtx *mi,
+		  size_t i, size_t j)
+{
+	int rc;
+	zsl_real_t x;
+	zsl_real_t epsilon = 1E-6;
+
+	/* Make a copy of matrix m. */
+	rc = zsl_mtx_copy(mn, m);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	/* Get the value to normalise. */
+	rc = zsl_mtx_get(mn, i, j, &x);
+	if (rc) {
+		return rc;
+	}
+
+	/* If the value is 0.0, abort. */
+	if ((x >= 0 && x < epsilon) || (x <= 0 && x > -epsilon)) {
+		return 0;
+	}
+
+	rc = zsl_mtx_scalar_mult_row_d(mn, i, (1.0 / x));
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rc = zsl_mtx_scalar_mult_row_d(mi, i, (1.0 / x));
+	if (rc) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_norm_elem_d(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i, size_t j)
+{
+	return zsl_mtx_norm_elem(m, m, mi, i, j);
+}
+
+int
+zsl_mtx_inv_3x3(const struct zsl_mtx *m, struct zsl_mtx *mi)
+{
+	/* Make sure these are square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mi' have the same shape. */
+	if (m->sz_rows != mi->sz_rows) {
+		return -EINVAL;
+	}
+	if (m->sz_cols != mi->sz_cols) {
+		return -EINVAL;
+	}
+	/* Make sure these are 3x3 matrices. */
+	if ((m->sz_cols != 3) || (mi->sz_cols != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Provide an identity matrix if the determinant is zero. */
+	if (zsl_mtx33_inv(m->data, mi->data) == 0.0) {
+		zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_inv_4x4(const struct zsl_mtx *m, struct zsl_mtx *mi)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure these are 4x4 matrices. */
+	if ((m->sz_rows != 4) || (m->sz_cols != 4) || (mi->sz_rows != 4) ||
+	    (mi->sz_cols != 4)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Provide an identity matrix if the determinant is zero. */
+	if (zsl_mtx44_inv(m->data, mi->data) == 0.0) {
+		zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	}
+
+	return 0;
+}
+
+#if !asm_mtx_inv
+int
+zsl_mtx_inv(const struct zsl_mtx *m, struct zsl_mtx *mi)
+{
+	int rc;
+
+	/* Shortcut for 3x3 matrices. */
+	if (m->sz_rows == 3) {
+		return zsl_mtx_inv_3x3(m, mi);
+	}
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mi' have the same shape. */
+	if (m->sz_rows != mi->sz_rows) {
+		return -EINVAL;
+	}
+	if (m->sz_cols != mi->sz_cols) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Shortcut for 4x4 matrices, once the shapes are known to match. */
+	if (m->sz_rows == 4) {
+		return zsl_mtx_inv_4x4(m, mi);
+	}
+
+	/* Factor a copy of matrix m in scratch memory to avoid modifying it. */
+	struct zsl_mtx lu;
+	zsl_real_t sign;
+	ZSL_SCRATCH_DEF(ws, mi->sz_rows * mi->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &lu, mi->sz_rows, mi->sz_cols);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_mtx_copy(&lu, m);
+	if (rc) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Initialise 'mi' as an identity matrix. */
+	rc = zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+	if (rc) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	/* Apply the pivoting row swaps to 'mi' while factoring. */
+	zsl_mtx_lu_fact(&lu, mi, &sign);
+
+	/* Leave 'mi' as an identity matrix if 'm' is singular. */
+	for (size_t i = 0; i < lu.sz_rows; i++) {
+		if (lu.data[i * lu.sz_cols + i] == 0.0) {
+			zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+			goto err;
+		}
+	}
+
+	/* Solve LU * mi = P for each column of the permuted identity. */
+	zsl_mtx_lu_subst(&lu, mi);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+#endif
+
+int
+zsl_mtx_cholesky(const struct zsl_mtx *m, struct zsl_mtx *l)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t x;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'l' is the same shape. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+	if ((l->sz_rows != n) || (l->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Cholesky-Banachiewicz, row by row. Only the lower triangle of 'm'
+	 * is read, and row i of 'm' is fully read before row i of 'l' is
+	 * written, so 'l' and 'm' may be the same matrix. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			x = m->data[i * n + j];
+			for (size_t k = 0; k < j; k++) {
+				x -= l->data[i * n + k] * l->data[j * n + k];
+			}
+
+			if (i == j) {
+				/* Also catches NaN values. */
+				if (!(x > 0.0)) {
+					return -ENOTPOSDEF;
+				}
+				l->data[i * n + i] = ZSL_SQRT(x);
+			} else {
+				l->data[i * n + j] = x / l->data[j * n + j];
+			}
+		}
+
+		for (size_t j = i + 1; j < n; j++) {
+			l->data[i * n + j] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_chol_solve(const struct zsl_mtx *l, struct zsl_mtx *b,
+		   struct zsl_mtx *x)
+{
+	size_t n = l->sz_rows;
+	size_t nc = b->sz_cols;
+	zsl_real_t f;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'l' is square, and 'b' and 'x' have n rows. */
+	if (l->sz_rows != l->sz_cols) {
+		return -EINVAL;
+	}
+	if ((b->sz_rows != n) || (x->sz_rows != n) || (x->sz_cols != nc)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (x != b) {
+		zsl_mtx_copy(x, b);
+	}
+
+	/* Forward substitution, solving L * Y = B. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t k = 0; k < i; k++) {
+			f = l->data[i * n + k];
+			for (size_t c = 0; c < nc; c++) {
+				x->data[i * nc + c] -= f * x->data[k * nc + c];
+			}
+		}
+		f = l->data[i * n + i];
+		for (size_t c = 0; c < nc; c++) {
+			x->data[i * nc + c] /= f;
+		}
+	}
+
+	/* Back substitution, solving L^T * X = Y. */
+	for (size_t i = n; i-- > 0;) {
+		for (size_t k = i + 1; k < n; k++) {
+			f = l->data[k * n + i];
+			for (size_t c = 0; c < nc; c++) {
+				x->data[i * nc + c] -= f * x->data[k * nc + c];
+			}
+		}
+		f = l->data[i * n + i];
+		for (size_t c = 0; c < nc; c++) {
+			x->data[i * nc + c] /= f;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_chol_update(struct zsl_mtx *l, struct zsl_vec *v)
+{
+	int rc;
+	size_t n = l->sz_rows;
+	zsl_real_t r, c, s;
+	struct zsl_vec w;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'l' is square, and 'v' has n elements. */
+	if ((l->sz_rows != l->sz_cols) || (v->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The update consumes its input vector, so work on a copy of 'v'. */
+	ZSL_SCRATCH_DEF(ws, n);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_vec_alloc(ws, &w, n);
+	if (rc) {
+		goto err;
+	}
+	zsl_vec_copy(&w, v);
+
+	/* Apply a sequence of Givens rotations, one column at a time. */
+	for (size_t k = 0; k < n; k++) {
+		r = ZSL_SQRT(l->data[k * n + k] * l->data[k * n + k] +
+			     w.data[k] * w.data[k]);
+		c = r / l->data[k * n + k];
+		s = w.data[k] / l->data[k * n + k];
+		l->data[k * n + k] = r;
+
+		for (size_t i = k + 1; i < n; i++) {
+			l->data[i * n + k] = (l->data[i * n + k] +
+					      s * w.data[i]) / c;
+			w.data[i] = c * w.data[i] - s * l->data[i * n + k];
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+/*
+ * Applies the Sherman-Morrison update to inverse 'mi', given its column
+ * 'c' = mi * u and row 'w' = v^T * mi, and scales 'd' by the determinant
+ * lemma factor 1 + v^T * mi * u, passed as 'den'.
+ */
+static int
+zsl_mtx_inv_sm(struct zsl_mtx *mi, const zsl_real_t *c, const zsl_real_t *w,
+	       zsl_real_t den, zsl_real_t *d)
+{
+	size_t n = mi->sz_rows;
+	zsl_real_t x;
+
+	if (ZSL_ABS(den) <= ZSL_MTX_EPS) {
+		return -ESINGULAR;
+	}
+
+	/* mi -= (mi * u) * (v^T * mi) / den. */
+	for (size_t i = 0; i < n; i++) {
+		x = c[i] / den;
+		for (size_t j = 0; j < n; j++) {
+			mi->data[i * n + j] -= x * w[j];
+		}
+	}
+
+	if (d != NULL) {
+		*d *= den;
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_inv_rank1(struct zsl_mtx *mi, const struct zsl_vec *u,
+		  const struct zsl_vec *v, zsl_real_t *d)
+{
+	int rc;
+	size_t n = mi->sz_rows;
+	zsl_real_t den = 1.0;
+	zsl_real_t *c, *w;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'mi' is square, and 'u' and 'v' have n elements. */
+	if ((mi->sz_rows != mi->sz_cols) || (u->sz != n) || (v->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_SCRATCH_DEF(ws, 2 * n);
+	size_t mark = zsl_ws_mark(ws);
+
+	c = zsl_ws_alloc(ws, n);
+	w = zsl_ws_alloc(ws, n);
+	if (c == NULL || w == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* c = mi * u and w = v^T * mi. */
+	for (size_t i = 0; i < n; i++) {
+		c[i] = 0.0;
+		w[i] = 0.0;
+	}
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			c[i] += mi->data[i * n + j] * u->data[j];
+			w[j] += v->data[i] * mi->data[i * n + j];
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		den += w[i] * u->data[i];
+	}
+
+	rc = zsl_mtx_inv_sm(mi, c, w, den, d);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_inv_update_row(struct zsl_mtx *m, struct zsl_mtx *mi, size_t i,
+		       const struct zsl_vec *row, zsl_real_t *d)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	zsl_real_t dv;
+	zsl_real_t *c, *w;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mi' are square and the same size, and 'row'
+	 * fits. */
+	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != n) ||
+	    (mi->sz_cols != n) || (row->sz != n) || (i >= n)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_SCRATCH_DEF(ws, 2 * n);
+	size_t mark = zsl_ws_mark(ws);
+
+	c = zsl_ws_alloc(ws, n);
+	w = zsl_ws_alloc(ws, n);
+	if (c == NULL || w == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* The new row is m + e_i * v^T, with v the change to row 'i', so
+	 * mi * u is column 'i' of 'mi', copied since it is updated in place. */
+	for (size_t k = 0; k < n; k++) {
+		c[k] = mi->data[k * n + i];
+		w[k] = 0.0;
+	}
+	for (size_t k = 0; k < n; k++) {
+		dv = row->data[k] - m->data[i * n + k];
+		for (size_t j = 0; j < n; j++) {
+			w[j] += dv * mi->data[k * n + j];
+		}
+	}
+
+	rc = zsl_mtx_inv_sm(mi, c, w, 1.0 + w[i], d);
+	if (rc) {
+		goto err;
+	}
+
+	for (size_t k = 0; k < n; k++) {
+		m->data[i * n + k] = row->data[k];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_solve(const struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x)
+{
+	int rc;
+	zsl_real_t sign;
+	struct zsl_mtx lu;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'a' is square, and 'b' and 'x' are compatible. */
+	if (a->sz_rows != a->sz_cols) {
+		return -EINVAL;
+	}
+	if ((b->sz_rows != a->sz_rows) || (x->sz_rows != a->sz_rows) ||
+	    (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_SCRATCH_DEF(ws, a->sz_rows * a->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &lu, a->sz_rows, a->sz_cols);
+	if (rc) {
+		goto err;
+	}
+	zsl_mtx_copy(&lu, a);
+	if (x != b) {
+		zsl_mtx_copy(x, b);
+	}
+
+	/* Factor 'a', applying the same row swaps to the right-hand side. */
+	zsl_mtx_lu_fact(&lu, x, &sign);
+
+	for (size_t i = 0; i < lu.sz_rows; i++) {
+		if (lu.data[i * lu.sz_cols + i] == 0.0) {
+			rc = -ESINGULAR;
+			goto err;
+		}
+	}
+
+	zsl_mtx_lu_subst(&lu, x);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_lu_fact_d(struct zsl_mtx *m, struct zsl_vec *perm)
+{
+	const size_t n = m->sz_rows;
+	struct zsl_mtx pm = { .sz_rows = n, .sz_cols = 1, .data = perm->data };
+	zsl_real_t sign;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'perm' has one entry per row. */
+	if ((m->sz_cols != n) || (perm->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Record the row swaps by applying them to the row indices. */
+	for (size_t i = 0; i < n; i++) {
+		perm->data[i] = (zsl_real_t)i;
+	}
+	zsl_mtx_lu_fact(m, &pm, &sign);
+
+	for (size_t i = 0; i < n; i++) {
+		if (m->data[i * n + i] == 0.0) {
+			return -ESINGULAR;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_lu_solve(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		 struct zsl_mtx *b, struct zsl_mtx *x)
+{
+	const size_t n = lu->sz_rows;
+	const size_t nc = b->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'lu' is square, and 'perm', 'b' and 'x' are compatible. */
+	if ((lu->sz_cols != n) || (perm->sz != n) || (b->sz_rows != n) ||
+	    (x->sz_rows != n) || (x->sz_cols != nc)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* x = P * b, then solve L * U * x = P * b in place. */
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&x->data[i * nc], &b->data[(size_t)perm->data[i] * nc],
+		       nc * sizeof(zsl_real_t));
+	}
+	zsl_mtx_lu_subst(lu, x);
+
+	return 0;
+}
+
+int
+zsl_mtx_norm_1(const struct zsl_mtx *m, zsl_real_t *n)
+{
+	zsl_real_t sum;
+
+	*n = 0.0;
+	for (size_t j = 0; j < m->sz_cols; j++) {
+		sum = 0.0;
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			sum += ZSL_ABS(m->data[i * m->sz_cols + j]);
+		}
+		if (sum > *n) {
+			*n = sum;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Solves A * x = b in place in 'b' (trans false) or A^T * x = b (trans
+ * true), where P * A = L * U is held in 'lu' and 'perm', using 't' (n
+ * entries) as a temporary.
+ */
+static void
+zsl_mtx_lu_solve_vec(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		     bool trans, zsl_real_t *b, zsl_real_t *t)
+{
+	size_t n = lu->sz_rows;
+	struct zsl_mtx bm = { .sz_rows = n, .sz_cols = 1, .data = t };
+
+	if (!trans) {
+		for (size_t i = 0; i < n; i++) {
+			t[i] = b[(size_t)perm->data[i]];
+		}
+		zsl_mtx_lu_subst(lu, &bm);
+		memcpy(b, t, n * sizeof(zsl_real_t));
+		return;
+	}
+
+	/* A^T = U^T * L^T * P, so solve U^T * y = b, then L^T * z = y, and
+	 * finally undo the permutation. */
+	for (size_t i = 0; i < n; i++) {
+		t[i] = b[i];
+		for (size_t j = 0; j < i; j++) {
+			t[i] -= lu->data[j * n + i] * t[j];
+		}
+		t[i] /= lu->data[i * n + i];
+	}
+	for (size_t i = n; i-- > 0;) {
+		for (size_t j = i + 1; j < n; j++) {
+			t[i] -= lu->data[j * n + i] * t[j];
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[(size_t)perm->data[i]] = t[i];
+	}
+}
+
+/*
+ * Estimates the 1-norm of A^-1 from the LU factors of A, with Hager's
+ * method as refined by Higham (LAPACK's xLACON). Each step solves once
+ * with A and once with A^T, so the cost is O(n^2). 'x', 'y' and 't' must
+ * hold n entries each.
+ */
+static zsl_real_t
+zsl_mtx_inv_norm_1_est(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		       zsl_real_t *x, zsl_real_t *y, zsl_real_t *t)
+{
+	size_t n = lu->sz_rows;
+	size_t j = 0;
+	size_t jold;
+	zsl_real_t est = 0.0;
+	zsl_real_t alt = 0.0;
+	zsl_real_t max, xz;
+
+	for (size_t i = 0; i < n; i++) {
+		x[i] = 1.0 / (zsl_real_t)n;
+	}
+
+	for (size_t k = 0; k < 5; k++) {
+		/* y = A^-1 * x, whose 1-norm is the current estimate. */
+		memcpy(y, x, n * sizeof(zsl_real_t));
+		zsl_mtx_lu_solve_vec(lu, perm, false, y, t);
+		est = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			est += ZSL_ABS(y[i]);
+		}
+
+		/* z = A^-T * sign(y), held in 'y'. */
+		for (size_t i = 0; i < n; i++) {
+			y[i] = (y[i] >= 0.0) ? 1.0 : -1.0;
+		}
+		zsl_mtx_lu_solve_vec(lu, perm, true, y, t);
+
+		jold = j;
+		j = 0;
+		max = ZSL_ABS(y[0]);
+		xz = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			if (ZSL_ABS(y[i]) > max) {
+				max = ZSL_ABS(y[i]);
+				j = i;
+			}
+			xz += y[i] * x[i];
+		}
+
+		/* Stop once the gradient doesn't point to a better vertex. */
+		if (k > 0 && (max <= xz || j == jold)) {
+			break;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			x[i] = (i == j) ? 1.0 : 0.0;
+		}
+	}
+
+	/* Guard against matrices where the search above is misled, with an
+	 * alternating vector of increasing magnitude. */
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (i % 2 ? -1.0 : 1.0) *
+		       (1.0 + (n > 1 ? (zsl_real_t)i / (zsl_real_t)(n - 1) :
+			       0.0));
+	}
+	zsl_mtx_lu_solve_vec(lu, perm, false, x, t);
+	for (size_t i = 0; i < n; i++) {
+		alt += ZSL_ABS(x[i]);
+	}
+	alt = 2.0 * alt / (3.0 * (zsl_real_t)n);
+
+	return (alt > est) ? alt : est;
+}
+
+int
+zsl_mtx_rcond_lu(const struct zsl_mtx *lu, const struct zsl_vec *perm,
+		 zsl_real_t anorm, zsl_real_t *rcond)
+{
+	int rc = 0;
+	size_t n = lu->sz_rows;
+	zsl_real_t *x, *y, *t;
+	zsl_real_t inorm;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'lu' is square, and 'perm' has one entry per row. */
+	if ((lu->sz_cols != n) || (perm->sz != n) || (n == 0)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* A zero pivot means A is exactly singular. */
+	*rcond = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		if (lu->data[i * n + i] == 0.0) {
+			return 0;
+		}
+	}
+	if (anorm == 0.0) {
+		return 0;
+	}
+
+	ZSL_SCRATCH_DEF(ws, 3 * n);
+	size_t mark = zsl_ws_mark(ws);
+
+	x = zsl_ws_alloc(ws, n);
+	y = zsl_ws_alloc(ws, n);
+	t = zsl_ws_alloc(ws, n);
+	if (x == NULL || y == NULL || t == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	inorm = zsl_mtx_inv_norm_1_est(lu, perm, x, y, t);
+	if (inorm != 0.0) {
+		*rcond = (1.0 / inorm) / anorm;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_rcond(const struct zsl_mtx *m, zsl_real_t *rcond)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	zsl_real_t anorm;
+	struct zsl_mtx lu;
+	struct zsl_vec perm;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square. */
+	if ((m->sz_cols != n) || (n == 0)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_SCRATCH_DEF(ws, n * n + n);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &lu, n, n);
+	rc |= zsl_ws_vec_alloc(ws, &perm, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_norm_1(m, &anorm);
+	zsl_mtx_copy(&lu, m);
+	rc = zsl_mtx_lu_fact_d(&lu, &perm);
+	if (rc == -ESINGULAR) {
+		*rcond = 0.0;
+		rc = 0;
+		goto err;
+	}
+
+	rc = zsl_mtx_rcond_lu(&lu, &perm, anorm, rcond);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+/*
+ * Solves column 'c' of A * X = B into 'x' using the LU factors in 'lu' and
+ * the row permutation 'perm', then refines it for up to 'iter' steps using
+ * residuals accumulated in zsl_mtx_wide_t. 'b' may be NULL to solve for the
+ * identity matrix. 'bc' and 'd' are n-element temporaries.
+ */
+static void
+zsl_mtx_refine_col(const struct zsl_mtx *a, struct zsl_mtx *lu,
+		   zsl_real_t *perm, struct zsl_mtx *b, size_t c,
+		   struct zsl_mtx *x, size_t iter, zsl_real_t *bc,
+		   zsl_real_t *d)
+{
+	const size_t n = a->sz_rows;
+	const size_t nc = x->sz_cols;
+	struct zsl_mtx dm = { .sz_rows = n, .sz_cols = 1, .data = d };
+	zsl_real_t dmax, xmax;
+	zsl_real_t prev = -1.0;
+	zsl_mtx_wide_t r;
+	size_t p;
+
+	/* Keep a copy of the right-hand side, since 'x' may alias 'b'. */
+	for (size_t i = 0; i < n; i++) {
+		bc[i] = (b == NULL) ? (zsl_real_t)(i == c) :
+			b->data[i * b->sz_cols + c];
+	}
+
+	/* Initial solution in working precision. */
+	for (size_t i = 0; i < n; i++) {
+		d[i] = bc[(size_t)perm[i]];
+	}
+	zsl_mtx_lu_subst(lu, &dm);
+	for (size_t i = 0; i < n; i++) {
+		x->data[i * nc + c] = d[i];
+	}
+
+	for (size_t it = 0; it < iter; it++) {
+		/* d = P * (b - A * x), with the residual accumulated in extra
+		 * precision before it's rounded. */
+		for (size_t i = 0; i < n; i++) {
+			p = (size_t)perm[i];
+			r = bc[p];
+			for (size_t j = 0; j < n; j++) {
+				r -= (zsl_mtx_wide_t)a->data[p * n + j] *
+				     x->data[j * nc + c];
+			}
+			d[i] = (zsl_real_t)r;
+		}
+
+		/* Solve for the correction and apply it. */
+		zsl_mtx_lu_subst(lu, &dm);
+		dmax = 0.0;
+		xmax = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			x->data[i * nc + c] += d[i];
+			dmax = ZSL_MAX(dmax, ZSL_ABS(d[i]));
+			xmax = ZSL_MAX(xmax, ZSL_ABS(x->data[i * nc + c]));
+		}
+
+		/* Stop once the correction is negligible, or has stopped
+		 * shrinking. */
+		if ((dmax <= ZSL_MTX_EPS * xmax) ||
+		    ((prev >= 0.0) && (dmax > 0.5 * prev))) {
+			break;
+		}
+		prev = dmax;
+	}
+}
+
+/*
+ * Shared implementation of the _refine solvers. 'b' may be NULL to solve
+ * for the identity matrix, producing the inverse of 'a'.
+ */
+static int
+zsl_mtx_refine(const struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x,
+	       size_t iter, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	const size_t n = a->sz_rows;
+	size_t mark = zsl_ws_mark(ws);
+	struct zsl_mtx lu;
+	struct zsl_mtx perm;
+	zsl_real_t *bc;
+	zsl_real_t *d;
+	zsl_real_t sign;
+
+	rc |= zsl_ws_mtx_alloc(ws, &lu, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &perm, n, 1);
+	bc = zsl_ws_alloc(ws, n);
+	d = zsl_ws_alloc(ws, n);
+	if (rc || (bc == NULL) || (d == NULL)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* Factor once, recording the row permutation in 'perm'. */
+	zsl_mtx_copy(&lu, a);
+	for (size_t i = 0; i < n; i++) {
+		perm.data[i] = (zsl_real_t)i;
+	}
+	zsl_mtx_lu_fact(&lu, &perm, &sign);
+
+	for (size_t i = 0; i < n; i++) {
+		if (lu.data[i * n + i] == 0.0) {
+			rc = -ESINGULAR;
+			goto err;
+		}
+	}
+
+	for (size_t c = 0; c < x->sz_cols; c++) {
+		zsl_mtx_refine_col(a, &lu, perm.data, b, c, x, iter, bc, d);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+size_t
+zsl_mtx_solve_refine_ws_sz(size_t n)
+{
+	/* The LU factors, the permutation and two column temporaries. */
+	return n * n + 3 * n;
+}
+
+int
+zsl_mtx_solve_refine_ws(const struct zsl_mtx *a, struct zsl_mtx *b,
+			struct zsl_mtx *x, size_t iter,
+			struct zsl_workspace *ws)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'a' is square, and 'b' and 'x' are compatible. */
+	if (a->sz_rows != a->sz_cols) {
+		return -EINVAL;
+	}
+	if ((b->sz_rows != a->sz_rows) || (x->sz_rows != a->sz_rows) ||
+	    (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_mtx_refine(a, b, x, iter, ws);
+}
+
+int
+zsl_mtx_solve_refine(const struct zsl_mtx *a, struct zsl_mtx *b,
+		     struct zsl_mtx *x, size_t iter)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_solve_refine_ws_sz(a->sz_rows));
+	rc = zsl_mtx_solve_refine_ws(a, b, x, iter, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+int
+zsl_mtx_inv_refine_ws(const struct zsl_mtx *m, struct zsl_mtx *mi, size_t iter,
+		      struct zsl_workspace *ws)
+{
+	/* Make sure we have square matrices of the same size. */
+	if ((m->sz_rows != m->sz_cols) || (mi->sz_rows != mi->sz_cols) ||
+	    (m->sz_rows != mi->sz_rows)) {
+		return -EINVAL;
+	}
+
+	return zsl_mtx_refine(m, NULL, mi, iter, ws);
+}
+
+int
+zsl_mtx_inv_refine(const struct zsl_mtx *m, struct zsl_mtx *mi, size_t iter)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_solve_refine_ws_sz(m->sz_rows));
+	rc = zsl_mtx_inv_refine_ws(m, mi, iter, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+/* The degree of the diagonal Pade approximant used by zsl_mtx_expm. */
+#define ZSL_MTX_EXPM_PADE 6
+
+size_t
+zsl_mtx_expm_ws_sz(size_t n)
+{
+	/* The scaled input, the current power of it, the denominator and a
+	 * product temporary. */
+	return 4 * n * n;
+}
+
+int
+zsl_mtx_expm_ws(const struct zsl_mtx *m, struct zsl_mtx *e,
+		struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = m->sz_rows;
+	size_t sq = 0;
+	zsl_real_t norm = 0.0;
+	zsl_real_t row, c, sign;
+	zsl_real_t *p;
+	struct zsl_mtx a, x, d, t;
+
+	/* Make sure we have square matrices of the same size. */
+	if ((m->sz_rows != m->sz_cols) || (e->sz_rows != n) ||
+	    (e->sz_cols != n)) {
+		return -EINVAL;
+	}
+
+	rc |= zsl_ws_mtx_alloc(ws, &a, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &x, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &d, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &t, n, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* Scale 'm' by 2^-sq so that its infinity norm is at most 0.5. */
+	for (size_t i = 0; i < n; i++) {
+		row = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			row += ZSL_ABS(m->data[i * n + j]);
+		}
+		norm = ZSL_MAX(norm, row);
+	}
+	c = 1.0;
+	while (norm > 0.5) {
+		norm *= 0.5;
+		c *= 0.5;
+		sq++;
+	}
+	for (size_t i = 0; i < n * n; i++) {
+		a.data[i] = m->data[i] * c;
+	}
+
+	/*
+	 * Numerator N = sum(c_k * A^k) is built directly in 'e', and the
+	 * denominator D = sum((-1)^k * c_k * A^k) in 'd', with c_0 = 1 and
+	 * c_k = c_(k-1) * (q - k + 1) / (k * (2q - k + 1)).
+	 */
+	zsl_mtx_init(e, zsl_mtx_entry_fn_identity);
+	zsl_mtx_init(&d, zsl_mtx_entry_fn_identity);
+	zsl_mtx_copy(&x, &a);
+	c = 1.0;
+	sign = 1.0;
+	for (size_t k = 1; k <= ZSL_MTX_EXPM_PADE; k++) {
+		if (k > 1) {
+			/* Swap the buffers rather than copying the product. */
+			zsl_mtx_mult(&a, &x, &t);
+			p = x.data;
+			x.data = t.data;
+			t.data = p;
+		}
+		c *= (zsl_real_t)(ZSL_MTX_EXPM_PADE - k + 1) /
+		     (zsl_real_t)(k * (2 * ZSL_MTX_EXPM_PADE - k + 1));
+		sign = -sign;
+		zsl_mtx_axpy(c, &x, e);
+		zsl_mtx_axpy(sign * c, &x, &d);
+	}
+
+	/* exp(A) ~= D^-1 * N, which is well conditioned after scaling. */
+	zsl_mtx_lu_fact(&d, e, &sign);
+	for (size_t i = 0; i < n; i++) {
+		if (d.data[i * n + i] == 0.0) {
+			rc = -ESINGULAR;
+			goto err;
+		}
+	}
+	zsl_mtx_lu_subst(&d, e);
+
+	/* Undo the scaling, since exp(A) = exp(A * 2^-sq)^(2^sq). The squares
+	 * alternate between the buffers of 'e' and 't', with a single copy at
+	 * the end if the last one isn't in 'e'. */
+	x.data = e->data;
+	for (size_t i = 0; i < sq; i++) {
+		zsl_mtx_mult(&x, &x, &t);
+		p = x.data;
+		x.data = t.data;
+		t.data = p;
+	}
+	if (x.data != e->data) {
+		zsl_mtx_copy(e, &x);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_expm(const struct zsl_mtx *m, struct zsl_mtx *e)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_expm_ws_sz(m->sz_rows));
+	rc = zsl_mtx_expm_ws(m, e, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+size_t
+zsl_mtx_c2d_ws_sz(size_t n, size_t p)
+{
+	/* The augmented (n + p) x (n + p) matrix, and zsl_mtx_expm_ws. */
+	return (n + p) * (n + p) + zsl_mtx_expm_ws_sz(n + p);
+}
+
+int
+zsl_mtx_c2d_ws(const struct zsl_mtx *a, const struct zsl_mtx *b, zsl_real_t t,
+	       struct zsl_mtx *ad, struct zsl_mtx *bd,
+	       struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = a->sz_rows;
+	size_t p = (b == NULL) ? 0 : b->sz_cols;
+	struct zsl_mtx mm;
+	struct zsl_mtx_view vm, vs;
+
+	/* Make sure the shapes are consistent. */
+	if ((a->sz_cols != n) || (ad->sz_rows != n) || (ad->sz_cols != n) ||
+	    ((b == NULL) != (bd == NULL))) {
+		return -EINVAL;
+	}
+	if ((b != NULL) && ((b->sz_rows != n) || (bd->sz_rows != n) ||
+			    (bd->sz_cols != p))) {
+		return -EINVAL;
+	}
+
+	rc = zsl_ws_mtx_alloc(ws, &mm, n + p, n + p);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/*
+	 * Zero-order hold: exp([A B; 0 0] * t) = [Ad Bd; 0 I], where
+	 * Ad = exp(A * t) and Bd = integral of exp(A * s) * B over [0, t].
+	 */
+	zsl_mtx_init(&mm, NULL);
+	zsl_mtx_view(&mm, 0, 0, n, n, &vm);
+	vs = (struct zsl_mtx_view){ n, n, n, a->data };
+	zsl_mtx_view_copy(&vm, &vs);
+	if (p > 0) {
+		zsl_mtx_view(&mm, 0, n, n, p, &vm);
+		vs = (struct zsl_mtx_view){ n, p, p, b->data };
+		zsl_mtx_view_copy(&vm, &vs);
+	}
+	zsl_mtx_scalar_mult_d(&mm, t);
+
+	/* zsl_mtx_expm_ws copies its input, so it can run in place. */
+	rc = zsl_mtx_expm_ws(&mm, &mm, ws);
+	if (rc) {
+		goto err;
+	}
+
+	zsl_mtx_view(&mm, 0, 0, n, n, &vs);
+	vm = (struct zsl_mtx_view){ n, n, n, ad->data };
+	zsl_mtx_view_copy(&vm, &vs);
+	if (p > 0) {
+		zsl_mtx_view(&mm, 0, n, n, p, &vs);
+		vm = (struct zsl_mtx_view){ n, p, p, bd->data };
+		zsl_mtx_view_copy(&vm, &vs);
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_c2d(const struct zsl_mtx *a, const struct zsl_mtx *b, zsl_real_t t,
+	    struct zsl_mtx *ad, struct zsl_mtx *bd)
+{
+	int rc;
+	size_t p = (b == NULL) ? 0 : b->sz_cols;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_c2d_ws_sz(a->sz_rows, p));
+	rc = zsl_mtx_c2d_ws(a, b, t, ad, bd, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+int
+zsl_mtx_trsm(const struct zsl_mtx *t, struct zsl_mtx *b, struct zsl_mtx *x,
+	     bool lower)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 't' is square, and 'b' and 'x' are compatible. */
+	if (t->sz_rows != t->sz_cols) {
+		return -EINVAL;
+	}
+	if ((b->sz_rows != t->sz_rows) || (x->sz_rows != t->sz_rows) ||
+	    (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < t->sz_rows; i++) {
+		if (t->data[i * t->sz_cols + i] == 0.0) {
+			return -ESINGULAR;
+		}
+	}
+
+	if (x != b) {
+		zsl_mtx_copy(x, b);
+	}
+
+	zsl_mtx_tri_subst(t, x, lower, false);
+
+	return 0;
+}
+
+int
+zsl_mtx_trsv(const struct zsl_mtx *t, struct zsl_vec *b, struct zsl_vec *x,
+	     bool lower)
+{
+	/* Treat the vectors as single-column matrices. */
+	struct zsl_mtx bm = {
+		.sz_rows = b->sz,
+		.sz_cols = 1,
+		.data = b->data
+	};
+	struct zsl_mtx xm = {
+		.sz_rows = x->sz,
+		.sz_cols = 1,
+		.data = x->data
+	};
+
+	return zsl_mtx_trsm(t, &bm, &xm, lower);
+}
+
+int
+zsl_mtx_balance(const struct zsl_mtx *m, struct zsl_mtx *mout)
+{
+	int rc;
+	bool done = false;
+	zsl_real_t sum;
+	zsl_real_t row = 0.0;
+	zsl_real_t col = 0.0;
+	zsl_real_t row2, col2;
+
+	/* Make sure we have square matrices. */
+	if ((m->sz_rows != m->sz_cols) || (mout->sz_rows != mout->sz_cols)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' and 'mout' have the same shape. */
+	if (m->sz_rows != mout->sz_rows) {
+		return -EINVAL;
+	}
+	if (m->sz_cols != mout->sz_cols) {
+		return -EINVAL;
+	}
+#endif
+
+	rc = zsl_mtx_copy(mout, m);
+	if (rc) {
+		goto err;
+	}
+
+	while (!done) {
+		done = true;
+
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			/* Calculate sum of components of each row, column. */
+			for (size_t j = 0; j < m->sz_cols; j++) {
+				row += ZSL_ABS(mout->data[(i * m->sz_rows) +
+							  j]);
+				col += ZSL_ABS(mout->data[(j * m->sz_rows) +
+							  i]);
+			}
+
+			/* TODO: Extend with a check against epsilon? */
+			if (col != 0.0 && row != 0.0) {
+				row2 = row / 2.0;
+				col2 = 1.0;
+				sum = col + row;
+
+				while (col < row2) {
+					col2 *= 2.0;
+					col *= 4.0;
+				}
+
+				row2 = row * 2.0;
+
+				while (col > row2) {
 					col2 /= 2.0;
 					col /= 4.0;
 				}
 
-				if ((col + row) / col2 < 0.95 * sum) {
-					done = false;
-					row2 = 1.0 / col2;
+				if ((col + row) / col2 < 0.95 * sum) {
+					done = false;
+					row2 = 1.0 / col2;
+
+					for (int k = 0; k < m->sz_rows; k++) {
+						mout->data[(i * m->sz_rows) + k]
+							*= row2;
+						mout->data[(k * m->sz_rows) + i]
+							*= col2;
+					}
+				}
+			}
+
+			row = 0.0;
+			col = 0.0;
+		}
+	}
+
+err:
+	return rc;
+}
+
+size_t
+zsl_mtx_householder_ws_sz(size_t rows)
+{
+	/* v and e1. */
+	return 2 * rows;
+}
+
+int
+zsl_mtx_householder_ws(const struct zsl_mtx *m, struct zsl_mtx *h,
+		       bool hessenberg, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t size = m->sz_rows;
+	size_t diff;
+	struct zsl_vec v, e1;
+	struct zsl_mtx_view vcol, vv;
+
+	if (hessenberg == true) {
+		size--;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'h' is square and large enough for the reflection. */
+	if ((h->sz_rows != h->sz_cols) || (h->sz_rows < size)) {
+		return -EINVAL;
+	}
+#endif
+
+	rc = zsl_ws_vec_alloc(ws, &v, size);
+	rc |= zsl_ws_vec_alloc(ws, &e1, size);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* Create the e1 vector, i.e. the vector (1, 0, 0, ...). */
+	zsl_vec_init(&e1);
+	e1.data[0] = 1.0;
+
+	/* Get the first column of the input matrix, skipping the first entry
+	 * for a Hessenberg reduction. */
+	vcol.sz_rows = size;
+	vcol.sz_cols = 1;
+	vcol.ld = m->sz_cols;
+	vcol.data = &m->data[(m->sz_rows - size) * m->sz_cols];
+	vv.sz_rows = size;
+	vv.sz_cols = 1;
+	vv.ld = 1;
+	vv.data = v.data;
+	zsl_mtx_view_copy(&vv, &vcol);
+
+	/* Change the 'sign' value according to the sign of the first
+	 * coefficient of the matrix. */
+	zsl_real_t sign = 1.0;
+	if (v.data[0] < 0) {
+		sign = -1.0;
+	}
+
+	/* Calculate the vector 'v' that will later be used to calculate the
+	 * Householder matrix. */
+	zsl_vec_scalar_mult(&e1, -sign * zsl_vec_norm(&v));
+
+	zsl_vec_add(&v, &e1, &v);
+
+	zsl_vec_scalar_div(&v, zsl_vec_norm(&v));
+
+	/* Calculate the H householder matrix by doing:
+	 * H = IDENTITY - 2 * v * v^t, with the reflection placed in the lower
+	 * right corner of 'h' if 'h' is larger than the reflection (i.e. if
+	 * Hessenberg is set to true, or if 'h' is an augmented output). */
+	zsl_mtx_init(h, zsl_mtx_entry_fn_identity);
+	diff = h->sz_rows - size;
+	for (size_t i = 0; i < size; i++) {
+		for (size_t j = 0; j < size; j++) {
+			h->data[((i + diff) * h->sz_cols) + j + diff] =
+				(i == j ? 1.0 : 0.0) +
+				(v.data[i] * v.data[j]) * -2.0;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_householder(const struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_householder_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_householder_ws(m, h, hessenberg, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+/*
+ * Computes the Householder reflector H = I - tau * v * v^T that maps the 'n'
+ * elements of 'x', spaced 'stride' entries apart, onto alpha * e1, where
+ * alpha has the sign of x[0]. v[0] is implicitly 1; v[1..n-1] overwrite
+ * x[1..n-1] and x[0] is set to alpha. Returns tau, which is zero (with 'x'
+ * left untouched) if x[1..n-1] is already zero.
+ */
+static zsl_real_t
+zsl_mtx_qr_house(zsl_real_t *x, size_t n, size_t stride)
+{
+	zsl_real_t sigma = 0.0;
+	zsl_real_t alpha, v0;
+
+	for (size_t i = 1; i < n; i++) {
+		sigma += x[i * stride] * x[i * stride];
+	}
+
+	if (sigma == 0.0) {
+		return 0.0;
+	}
+
+	alpha = ZSL_SQRT(x[0] * x[0] + sigma);
+	if (x[0] < 0.0) {
+		alpha = -alpha;
+	}
+
+	/* v0 = x[0] - alpha, rearranged to avoid cancellation since x[0] and
+	 * alpha have the same sign. */
+	v0 = -sigma / (x[0] + alpha);
+
+	for (size_t i = 1; i < n; i++) {
+		x[i * stride] /= v0;
+	}
+	x[0] = alpha;
+
+	return (2.0 * v0 * v0) / (sigma + v0 * v0);
+}
+
+/*
+ * Applies the reflector I - tau * v * v^T to rows r0 to r0 + n - 1 of 'b'
+ * from the left, for columns c0 onwards. v[0] is implicitly 1, and
+ * v[1..n-1] are read from 'v' with the given stride.
+ */
+/* The arguments of a zsl_mtx_qr_reflect_left call, split by columns. */
+struct zsl_mtx_qr_reflect_task {
+	const zsl_real_t *v;
+	size_t stride;
+	size_t n;
+	zsl_real_t tau;
+	struct zsl_mtx *b;
+	size_t r0;
+	size_t c0;
+};
+
+static void
+zsl_mtx_qr_reflect_cols(void *arg, size_t j0, size_t j1)
+{
+	struct zsl_mtx_qr_reflect_task *t = arg;
+	const zsl_real_t *v = t->v;
+	size_t nc = t->b->sz_cols;
+	zsl_real_t *d = &t->b->data[t->r0 * nc + t->c0];
+	zsl_real_t w;
+
+	for (size_t j = j0; j < j1; j++) {
+		w = d[j];
+		for (size_t i = 1; i < t->n; i++) {
+			w += v[i * t->stride] * d[i * nc + j];
+		}
+		w *= t->tau;
+
+		d[j] -= w;
+		for (size_t i = 1; i < t->n; i++) {
+			d[i * nc + j] -= v[i * t->stride] * w;
+		}
+	}
+}
+
+static void
+zsl_mtx_qr_reflect_left(const zsl_real_t *v, size_t stride, size_t n,
+			zsl_real_t tau, struct zsl_mtx *b, size_t r0, size_t c0)
+{
+	struct zsl_mtx_qr_reflect_task t = {
+		.v = v, .stride = stride, .n = n, .tau = tau,
+		.b = b, .r0 = r0, .c0 = c0
+	};
+
+	if ((tau == 0.0) || (c0 >= b->sz_cols)) {
+		return;
+	}
+
+	/* Each column is updated independently. */
+	zsl_smp_for(zsl_mtx_qr_reflect_cols, &t, b->sz_cols - c0,
+		    2 * n * (b->sz_cols - c0));
+}
+
+/*
+ * Applies the reflector I - tau * v * v^T to columns c0 to c0 + n - 1 of
+ * every row of 'b' from the right, with 'v' stored as for
+ * zsl_mtx_qr_reflect_left.
+ */
+static void
+zsl_mtx_qr_reflect_right(const zsl_real_t *v, size_t stride, size_t n,
+			 zsl_real_t tau, struct zsl_mtx *b, size_t c0)
+{
+	size_t nc = b->sz_cols;
+	zsl_real_t w;
+
+	if (tau == 0.0) {
+		return;
+	}
+
+	for (size_t i = 0; i < b->sz_rows; i++) {
+		w = b->data[i * nc + c0];
+		for (size_t k = 1; k < n; k++) {
+			w += v[k * stride] * b->data[i * nc + c0 + k];
+		}
+		w *= tau;
+
+		b->data[i * nc + c0] -= w;
+		for (size_t k = 1; k < n; k++) {
+			b->data[i * nc + c0 + k] -= v[k * stride] * w;
+		}
+	}
+}
+
+/*
+ * Multiplies 'b' from the left by Q = H_0 * H_1 * ... * H_(nref - 1), or
+ * by Q^T if 'trans' is true. Reflector H_k acts on rows k + off onwards,
+ * with its vector stored in column k of 'qr' below row k + off.
+ */
+static void
+zsl_mtx_qr_apply(const struct zsl_mtx *qr, const zsl_real_t *tau,
+		 size_t nref, size_t off, struct zsl_mtx *b, bool trans)
+{
+	size_t nc = qr->sz_cols;
+	size_t k;
+
+	for (size_t g = 0; g < nref; g++) {
+		k = trans ? g : nref - 1 - g;
+		zsl_mtx_qr_reflect_left(&qr->data[(k + off) * nc + k], nc,
+					qr->sz_rows - k - off, tau[k], b,
+					k + off, 0);
+	}
+}
+
+int
+zsl_mtx_qr(const struct zsl_mtx *m, struct zsl_mtx *qr, struct zsl_vec *tau)
+{
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t nref = rows < cols ? rows : cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'qr' matches 'm', with one scale factor per column. */
+	if ((qr->sz_rows != rows) || (qr->sz_cols != cols) ||
+	    (tau->sz != nref)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (qr != m) {
+		zsl_mtx_copy(qr, m);
+	}
+
+	for (size_t k = 0; k < nref; k++) {
+		tau->data[k] = zsl_mtx_qr_house(&qr->data[k * cols + k],
+						rows - k, cols);
+		zsl_mtx_qr_reflect_left(&qr->data[k * cols + k], cols,
+					rows - k, tau->data[k], qr, k, k + 1);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_qr_apply_q(const struct zsl_mtx *qr, const struct zsl_vec *tau,
+		   struct zsl_mtx *b, bool trans)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'b' has as many rows as Q. */
+	if ((b->sz_rows != qr->sz_rows) ||
+	    (tau->sz != (qr->sz_rows < qr->sz_cols ?
+			 qr->sz_rows : qr->sz_cols))) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_mtx_qr_apply(qr, tau->data, tau->sz, 0, b, trans);
+
+	return 0;
+}
+
+size_t
+zsl_mtx_qrd_ws_sz(size_t rows, size_t cols)
+{
+	/* The reflector scale factors. */
+	(void)cols;
+
+	return rows;
+}
+
+int
+zsl_mtx_qrd_ws(const struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	       bool hessenberg, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t nref, off;
+	zsl_real_t *tau;
+	zsl_real_t *v;
+
+	tau = zsl_ws_alloc(ws, rows);
+	if (tau == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_mtx_copy(r, m);
+	if (rc) {
+		goto err;
+	}
+
+	/* The reflectors are applied directly to 'r', and their vectors are
+	 * kept below the diagonal (or subdiagonal) until 'q' is built. */
+	if (hessenberg == true) {
+		/* Reflector k zeroes column k below the subdiagonal, and is
+		 * applied from both sides to keep 'r' similar to 'm'. */
+		off = 1;
+		nref = rows > 2 ? rows - 2 : 0;
+		for (size_t k = 0; k < nref; k++) {
+			v = &r->data[(k + 1) * cols + k];
+			tau[k] = zsl_mtx_qr_house(v, rows - k - 1, cols);
+			zsl_mtx_qr_reflect_left(v, cols, rows - k - 1, tau[k],
+						r, k + 1, k + 1);
+			zsl_mtx_qr_reflect_right(v, cols, rows - k - 1, tau[k],
+						 r, k + 1);
+		}
+	} else {
+		off = 0;
+		nref = rows < cols ? rows : cols;
+		for (size_t k = 0; k < nref; k++) {
+			v = &r->data[k * cols + k];
+			tau[k] = zsl_mtx_qr_house(v, rows - k, cols);
+			zsl_mtx_qr_reflect_left(v, cols, rows - k, tau[k],
+						r, k, k + 1);
+		}
+	}
+
+	/* q = H_0 * H_1 * ... * I. */
+	zsl_mtx_init(q, zsl_mtx_entry_fn_identity);
+	zsl_mtx_qr_apply(r, tau, nref, off, q, false);
+
+	/* Clear the stored reflector vectors. */
+	for (size_t i = 0; i < rows; i++) {
+		for (size_t j = 0; j + off < i && j < cols; j++) {
+			r->data[i * cols + j] = 0.0;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_qrd(const struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	    bool hessenberg)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_qrd_ws_sz(m->sz_rows, m->sz_cols));
+
+	rc = zsl_mtx_qrd_ws(m, q, r, hessenberg, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/*
+ * Returns true if every element to the left of the diagonal in row 'i' of
+ * 'a', up to (but excluding) column 'j', is negligible relative to the
+ * neighbouring diagonal elements, or to 'anorm' if those are zero.
+ */
+static bool
+zsl_mtx_qrd_iter_row_conv(struct zsl_mtx *a, size_t i, size_t j,
+			  zsl_real_t anorm)
+{
+	size_t n = a->sz_cols;
+	zsl_real_t scale;
+
+	scale = ZSL_ABS(a->data[i * n + i]) +
+		ZSL_ABS(a->data[(i - 1) * n + (i - 1)]);
+	if (scale == 0.0) {
+		scale = anorm;
+	}
+
+	for (size_t k = 0; k < j; k++) {
+		if (ZSL_ABS(a->data[i * n + k]) > ZSL_MTX_EPS * scale) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Runs up to 'iter' shifted QR iterations on 'm', using 'rot' (at least
+ * n * (n - 1) entries) to hold the Givens rotations of each QR step.
+ *
+ * The active block is the leading h x h submatrix of 'mout'. Each
+ * iteration factors that block, minus a Wilkinson shift taken from its
+ * trailing 2x2 submatrix, as Q * R using Givens rotations, and replaces it
+ * with R * Q plus the shift. The rotations are also applied to the rows of
+ * the block to its right, so 'mout' remains similar to 'm'. Once the last
+ * row (or last two rows, for a complex conjugate pair) of the block has
+ * converged, it is deflated and the block shrinks; iteration stops when
+ * nothing is left to deflate.
+ */
+static void
+zsl_mtx_qrd_iter_run(const struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter,
+		     zsl_real_t *rot, size_t *used)
+{
+	size_t n = m->sz_rows;
+	size_t h = n;
+	size_t g = 0;
+	size_t nr;
+	zsl_real_t anorm = 0.0;
+	zsl_real_t a, b, c, d;
+	zsl_real_t mu, disc, x, y;
+
+	for (size_t i = 0; i < n * n; i++) {
+		anorm = ZSL_MAX(anorm, ZSL_ABS(mout->data[i]));
+	}
+
+	while (h > 1) {
+		/* Deflate a converged real eigenvalue. */
+		if (zsl_mtx_qrd_iter_row_conv(mout, h - 1, h - 1, anorm)) {
+			for (size_t k = 0; k < h - 1; k++) {
+				mout->data[(h - 1) * n + k] = 0.0;
+			}
+			h--;
+			continue;
+		}
+
+		/* Trailing 2x2 submatrix of the active block. */
+		a = mout->data[(h - 2) * n + (h - 2)];
+		b = mout->data[(h - 2) * n + (h - 1)];
+		c = mout->data[(h - 1) * n + (h - 2)];
+		d = mout->data[(h - 1) * n + (h - 1)];
+		disc = (a - d) * (a - d) / 4.0 + b * c;
+
+		/* Deflate a 2x2 block holding a complex conjugate pair. The
+		 * diagonal and subdiagonal of the block are left untouched. */
+		if (disc < 0.0 && (h == 2 ||
+		    (zsl_mtx_qrd_iter_row_conv(mout, h - 1, h - 2, anorm) &&
+		     zsl_mtx_qrd_iter_row_conv(mout, h - 2, h - 2, anorm)))) {
+			for (size_t k = 0; k < h - 2; k++) {
+				mout->data[(h - 1) * n + k] = 0.0;
+				mout->data[(h - 2) * n + k] = 0.0;
+			}
+			h -= 2;
+			continue;
+		}
+
+		if (g == iter) {
+			break;
+		}
+
+		/* Wilkinson shift: the eigenvalue of the trailing 2x2 closest
+		 * to 'd', or the real part of a complex pair. */
+		mu = (a + d) / 2.0;
+		if (disc >= 0.0) {
+			x = ZSL_SQRT(disc);
+			mu += ((a - d) / 2.0 >= 0.0) ? -x : x;
+		}
+
+		for (size_t i = 0; i < h; i++) {
+			mout->data[i * n + i] -= mu;
+		}
+
+		/* R = Q^T * (A - mu * I), zeroing each element below the
+		 * diagonal of the active block with a Givens rotation of rows
+		 * 'j' and 'i'. The rotation is applied to the full rows, which
+		 * covers the part of 'mout' to the right of the block. */
+		nr = 0;
+		for (size_t j = 0; j < h - 1; j++) {
+			for (size_t i = j + 1; i < h; i++) {
+				a = mout->data[j * n + j];
+				b = mout->data[i * n + j];
+				x = ZSL_SQRT(a * a + b * b);
+				if (x == 0.0) {
+					c = 1.0;
+					d = 0.0;
+				} else {
+					c = a / x;
+					d = b / x;
+				}
+				for (size_t k = j; k < n; k++) {
+					a = mout->data[j * n + k];
+					b = mout->data[i * n + k];
+					mout->data[j * n + k] = c * a + d * b;
+					mout->data[i * n + k] = c * b - d * a;
+				}
+				mout->data[i * n + j] = 0.0;
+				rot[nr++] = c;
+				rot[nr++] = d;
+			}
+		}
+
+		/* A = R * Q + mu * I, applying the rotations to the columns of
+		 * the active block in the same order. */
+		nr = 0;
+		for (size_t j = 0; j < h - 1; j++) {
+			for (size_t i = j + 1; i < h; i++) {
+				c = rot[nr++];
+				d = rot[nr++];
+				for (size_t k = 0; k < h; k++) {
+					x = mout->data[k * n + j];
+					y = mout->data[k * n + i];
+					mout->data[k * n + j] = c * x + d * y;
+					mout->data[k * n + i] = c * y - d * x;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < h; i++) {
+			mout->data[i * n + i] += mu;
+		}
+
+		g++;
+	}
+
+	if (used != NULL) {
+		*used = g;
+	}
+}
+
+size_t
+zsl_mtx_qrd_iter_ws_sz(size_t n)
+{
+	/* The Givens rotations of a single QR step. */
+	return n * n;
+}
+
+int
+zsl_mtx_qrd_iter_ws(const struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter,
+		    size_t *used, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t *rot;
+
+	/* Make a copy of 'm'. */
+	rc = zsl_mtx_copy(mout, m);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rot = zsl_ws_alloc(ws, m->sz_rows * m->sz_rows);
+	if (rot == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_qrd_iter_run(m, mout, iter, rot, used);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_qrd_iter(const struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
+{
+	int rc;
+
+	/* Use scratch memory to avoid stack overflow when these functions
+	 * are called recursively, if it is large enough. */
+	#if CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH && !CONFIG_ZSL_SCRATCH_POOL
+	if (zsl_mtx_qrd_iter_ws_sz(m->sz_rows) <=
+	    CONFIG_ZSL_MATRIX_QRD_SCRATCH_SIZE) {
+		rc = zsl_mtx_copy(mout, m);
+		if (rc) {
+			return -EINVAL;
+		}
+
+		ZSL_QRD_SCRATCH_1_LOCK();
+		ZSL_QRD_SCRATCH_1_CLEAR;
+		zsl_mtx_qrd_iter_run(m, mout, iter, scrd_1, NULL);
+		ZSL_QRD_SCRATCH_1_UNLOCK();
+
+		return 0;
+	}
+	#endif
+
+	/* Use the scratch pool if enabled, otherwise the stack ... this will
+	 * get HUGE though!!! */
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_qrd_iter_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_qrd_iter_ws(m, mout, iter, NULL, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+#endif
+
+/*
+ * Returns true if subdiagonal element (i, i - 1) of upper Hessenberg matrix
+ * 'a' is negligible relative to the neighbouring diagonal elements, or to
+ * 'anorm' if those are zero.
+ */
+static bool
+zsl_mtx_hess_sub_conv(struct zsl_mtx *a, size_t i, zsl_real_t anorm)
+{
+	size_t n = a->sz_cols;
+	zsl_real_t scale;
+
+	scale = ZSL_ABS(a->data[i * n + i]) +
+		ZSL_ABS(a->data[(i - 1) * n + (i - 1)]);
+	if (scale == 0.0) {
+		scale = anorm;
+	}
+
+	return ZSL_ABS(a->data[i * n + (i - 1)]) <= ZSL_MTX_EPS * scale;
+}
+
+/*
+ * Applies the reflector I - tau * v * v^T, with v[0] implicitly 1 and 'nr'
+ * (2 or 3) entries, to rows and columns k to k + nr - 1 of Hessenberg
+ * matrix 't': from the left for columns c0 onwards, and from the right for
+ * rows 0 to r1, below which those columns are zero. When 'q' isn't NULL, it
+ * is also applied to the columns of 'q' from the right.
+ */
+static void
+zsl_mtx_schur_reflect(struct zsl_mtx *t, struct zsl_mtx *q,
+		      const zsl_real_t *v, zsl_real_t tau, size_t nr,
+		      size_t k, size_t c0, size_t r1)
+{
+	size_t n = t->sz_cols;
+	zsl_real_t *d;
+	zsl_real_t w;
+
+	if (tau == 0.0) {
+		return;
+	}
+
+	for (size_t j = c0; j < n; j++) {
+		d = &t->data[k * n + j];
+		w = d[0];
+		for (size_t i = 1; i < nr; i++) {
+			w += v[i] * d[i * n];
+		}
+		w *= tau;
+		d[0] -= w;
+		for (size_t i = 1; i < nr; i++) {
+			d[i * n] -= v[i] * w;
+		}
+	}
+
+	for (size_t i = 0; i <= r1; i++) {
+		d = &t->data[i * n + k];
+		w = d[0];
+		for (size_t j = 1; j < nr; j++) {
+			w += v[j] * d[j];
+		}
+		w *= tau;
+		d[0] -= w;
+		for (size_t j = 1; j < nr; j++) {
+			d[j] -= v[j] * w;
+		}
+	}
+
+	if (q == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		d = &q->data[i * n + k];
+		w = d[0];
+		for (size_t j = 1; j < nr; j++) {
+			w += v[j] * d[j];
+		}
+		w *= tau;
+		d[0] -= w;
+		for (size_t j = 1; j < nr; j++) {
+			d[j] -= v[j] * w;
+		}
+	}
+}
+
+/*
+ * Splits the 2x2 block of 't' at rows and columns p and p + 1, whose
+ * eigenvalues are real, into two 1x1 blocks. A reflector whose first column
+ * is an eigenvector of the block makes its subdiagonal element zero.
+ */
+static void
+zsl_mtx_schur_split(struct zsl_mtx *t, struct zsl_mtx *q, size_t p)
+{
+	size_t n = t->sz_cols;
+	zsl_real_t a = t->data[p * n + p];
+	zsl_real_t b = t->data[p * n + p + 1];
+	zsl_real_t c = t->data[(p + 1) * n + p];
+	zsl_real_t d = t->data[(p + 1) * n + p + 1];
+	zsl_real_t h = (a - d) / 2.0;
+	zsl_real_t r = ZSL_SQRT(h * h + b * c);
+	zsl_real_t v[2];
+	zsl_real_t tau;
+
+	/* (lambda - d, c) is an eigenvector for lambda = d + h +/- r. Taking
+	 * the sign of 'h' avoids cancellation, and 'c' is non-zero. */
+	v[0] = h + ((h >= 0.0) ? r : -r);
+	v[1] = c;
+	tau = zsl_mtx_qr_house(v, 2, 1);
+	zsl_mtx_schur_reflect(t, q, v, tau, 2, p, p, p + 1);
+	t->data[(p + 1) * n + p] = 0.0;
+}
+
+/*
+ * Runs one implicit Francis double-shift QR step on rows and columns l to
+ * h - 1 of Hessenberg matrix 't', with shifts that have the sum 'tr' and
+ * product 'det'. The first column of (T - s1 * I) * (T - s2 * I) is real
+ * even for a complex pair of shifts, and the bulge that reflecting it onto
+ * e1 creates is chased down the band with 3x3 reflectors.
+ */
+static void
+zsl_mtx_schur_francis(struct zsl_mtx *t, struct zsl_mtx *q, size_t l,
+		      size_t h, zsl_real_t tr, zsl_real_t det)
+{
+	size_t n = t->sz_cols;
+	size_t nr;
+	zsl_real_t *a = t->data;
+	zsl_real_t v[3];
+	zsl_real_t tau;
+
+	v[0] = a[l * n + l] * a[l * n + l] +
+	       a[l * n + l + 1] * a[(l + 1) * n + l] -
+	       tr * a[l * n + l] + det;
+	v[1] = a[(l + 1) * n + l] *
+	       (a[l * n + l] + a[(l + 1) * n + l + 1] - tr);
+	v[2] = a[(l + 1) * n + l] * a[(l + 2) * n + l + 1];
+
+	for (size_t k = l; k + 1 < h; k++) {
+		/* The last reflector only spans two rows. */
+		nr = (k + 2 < h) ? 3 : 2;
+		tau = zsl_mtx_qr_house(v, nr, 1);
+		zsl_mtx_schur_reflect(t, q, v, tau, nr, k,
+				      (k > l) ? k - 1 : l,
+				      (k + 3 < h) ? k + 3 : h - 1);
+
+		/* Clear the bulge left below the subdiagonal. */
+		if (k > l) {
+			a[(k + 1) * n + k - 1] = 0.0;
+			if (nr == 3) {
+				a[(k + 2) * n + k - 1] = 0.0;
+			}
+		}
+
+		if (k + 2 < h) {
+			v[0] = a[(k + 1) * n + k];
+			v[1] = a[(k + 2) * n + k];
+			v[2] = (k + 3 < h) ? a[(k + 3) * n + k] : 0.0;
+		}
+	}
+}
+
+/*
+ * Runs up to 'iter' QR iterations on upper Hessenberg matrix 't' in place.
+ * When 'q' isn't NULL, each transformation is also applied to its columns,
+ * so that Q * T * Q^T is preserved.
+ *
+ * The active block runs from the last negligible subdiagonal element to
+ * row 'h' - 1, and converged 1x1 and 2x2 blocks are deflated from its
+ * bottom. Each iteration is an implicit Francis double-shift step, using
+ * the eigenvalues of the trailing 2x2 submatrix as the shifts, so complex
+ * pairs converge quadratically in real arithmetic. If a block hasn't
+ * deflated after every 10 steps, an exceptional shift is used instead, to
+ * break cycles. 'stall' counts the steps since the last deflation, and is
+ * kept by the caller so that runs split over several calls behave as one.
+ * Each step costs O(n^2). Returns true if every row converged within
+ * 'iter' steps.
+ */
+static bool
+zsl_mtx_schur_run(struct zsl_mtx *t, struct zsl_mtx *q, size_t iter,
+		  size_t *stall, size_t *used)
+{
+	size_t n = t->sz_rows;
+	size_t h = n;
+	size_t l;
+	size_t g = 0;
+	zsl_real_t anorm = 0.0;
+	zsl_real_t a, b, c, d;
+	zsl_real_t tr, det, x;
+
+	for (size_t i = 0; i < n * n; i++) {
+		anorm = ZSL_MAX(anorm, ZSL_ABS(t->data[i]));
+	}
+
+	while (h > 1) {
+		/* Find the top of the active block. */
+		for (l = h - 1; l > 0; l--) {
+			if (zsl_mtx_hess_sub_conv(t, l, anorm)) {
+				t->data[l * n + (l - 1)] = 0.0;
+				break;
+			}
+		}
+
+		/* Deflate a converged real eigenvalue. */
+		if (l == h - 1) {
+			h--;
+			*stall = 0;
+			continue;
+		}
+
+		/* Trailing 2x2 submatrix of the active block. */
+		a = t->data[(h - 2) * n + (h - 2)];
+		b = t->data[(h - 2) * n + (h - 1)];
+		c = t->data[(h - 1) * n + (h - 2)];
+		d = t->data[(h - 1) * n + (h - 1)];
+
+		/* Deflate a 2x2 block, keeping a complex conjugate pair as
+		 * it is, and splitting a real pair. */
+		if (l == h - 2) {
+			if ((a - d) * (a - d) / 4.0 + b * c >= 0.0) {
+				zsl_mtx_schur_split(t, q, h - 2);
+			}
+			h -= 2;
+			*stall = 0;
+			continue;
+		}
+
+		if (g == iter) {
+			break;
+		}
+
+		(*stall)++;
+		if (*stall % 10 == 0) {
+			/* Exceptional shifts, as in LAPACK's dlahqr, based on
+			 * the bottom or top of the block in turn. */
+			if (*stall % 20 == 10) {
+				x = ZSL_ABS(c) + ZSL_ABS(t->data[(h - 2) * n +
+								 (h - 3)]);
+				a = 0.75 * x + d;
+			} else {
+				x = ZSL_ABS(t->data[(l + 1) * n + l]) +
+				    ZSL_ABS(t->data[(l + 2) * n + l + 1]);
+				a = 0.75 * x + t->data[l * n + l];
+			}
+			tr = 2.0 * a;
+			det = a * a + 0.4375 * x * x;
+		} else {
+			tr = a + d;
+			det = a * d - b * c;
+		}
+
+		zsl_mtx_schur_francis(t, q, l, h, tr, det);
+		g++;
+	}
+
+	if (used != NULL) {
+		*used = g;
+	}
+
+	return h <= 1;
+}
+
+size_t
+zsl_mtx_schur_ws_sz(size_t n)
+{
+	/* Q when the caller doesn't want it, and zsl_mtx_qrd_ws. */
+	return (n * n) + zsl_mtx_qrd_ws_sz(n, n);
+}
+
+int
+zsl_mtx_schur_ws(const struct zsl_mtx *m, struct zsl_mtx *t, struct zsl_mtx *q,
+		 size_t iter, size_t *used, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = m->sz_rows;
+	size_t stall = 0;
+	struct zsl_mtx qh;
+
+	/* Make sure the matrices are square and of the same size. */
+	if ((m->sz_cols != n) || (t->sz_rows != n) || (t->sz_cols != n)) {
+		return -EINVAL;
+	}
+	if ((q != NULL) && ((q->sz_rows != n) || (q->sz_cols != n))) {
+		return -EINVAL;
+	}
+
+	if (q == NULL) {
+		rc = zsl_ws_mtx_alloc(ws, &qh, n, n);
+		if (rc) {
+			rc = -ENOMEM;
+			goto err;
+		}
+		q = &qh;
+	}
+
+	/* Reduce 'm' to upper Hessenberg form once, M = Q * T * Q^T. */
+	rc = zsl_mtx_qrd_ws(m, q, t, true, ws);
+	if (rc) {
+		goto err;
+	}
+
+	if (!zsl_mtx_schur_run(t, (q == &qh) ? NULL : q, iter, &stall, used)) {
+		rc = -ENOCONVERGE;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_schur(const struct zsl_mtx *m, struct zsl_mtx *t, struct zsl_mtx *q,
+	      size_t iter)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_schur_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_schur_ws(m, t, q, iter, NULL, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/* Sorts 'v' in place by decreasing absolute value. */
+static void
+zsl_mtx_eigenvalues_sort(struct zsl_vec *v)
+{
+	zsl_real_t x;
+	size_t j;
+
+	for (size_t i = 1; i < v->sz; i++) {
+		x = v->data[i];
+		j = i;
+		while (j > 0 && ZSL_ABS(v->data[j - 1]) < ZSL_ABS(x)) {
+			v->data[j] = v->data[j - 1];
+			j--;
+		}
+		v->data[j] = x;
+	}
+}
+
+/*
+ * Balances the nxn matrix 'm' and reduces it to Hessenberg form in 't' (nxn)
+ * in place, using 'tau' (n entries) as a temporary, without forming the
+ * orthogonal factor, since only the eigenvalues are needed.
+ */
+static void
+zsl_mtx_eigenvalues_load(const struct zsl_mtx *m, struct zsl_mtx *t,
+			 zsl_real_t *tau)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t *hv;
+
+	/* Balance the matrix. */
+	zsl_mtx_balance(m, t);
+
+	/* Put the balanced matrix into hessenberg form, as in zsl_mtx_qrd_ws,
+	 * then clear the stored reflector vectors. */
+	for (size_t k = 0; k + 2 < n; k++) {
+		hv = &t->data[(k + 1) * n + k];
+		tau[k] = zsl_mtx_qr_house(hv, n - k - 1, n);
+		zsl_mtx_qr_reflect_left(hv, n, n - k - 1, tau[k], t, k + 1,
+					k + 1);
+		zsl_mtx_qr_reflect_right(hv, n, n - k - 1, tau[k], t, k + 1);
+	}
+	for (size_t i = 2; i < n; i++) {
+		for (size_t j = 0; j + 1 < i; j++) {
+			t->data[i * n + j] = 0.0;
+		}
+	}
+}
+
+/*
+ * Reads the real eigenvalues off the diagonal of the quasi upper triangular
+ * matrix 't' left by zsl_mtx_schur_run, into 'v'. 'sym' is true if the input
+ * matrix was symmetric.
+ */
+static int
+zsl_mtx_eigenvalues_extract(const struct zsl_mtx *t, struct zsl_vec *v,
+			    bool sym)
+{
+	zsl_real_t sdiag;
+	size_t real = 0;
+
+	/* Epsilon is used to check 0 values in the subdiagonal, to determine
+	 * if any coimplekx values were found. Increasing the number of
+	 * iterations will move these values closer to 0, but when using
+	 * single-precision floats the numbers can still be quite large, so
+	 * we need to set a delta of +/- 0.001 in this case. */
+
+	zsl_real_t epsilon = 1E-6;
+
+	zsl_vec_init(v);
+
+	/* If the matrix is symmetric, then it will always have real
+	 * eigenvalues, so treat this case appart. */
+	if (sym) {
+		for (size_t g = 0; g < t->sz_rows; g++) {
+			v->data[g] = zsl_mtx_at(t, g, g);
+		}
+
+		zsl_mtx_eigenvalues_sort(v);
+		return 0;
+	}
+
+	/*
+	 * If any value just below the diagonal is non-zero, it means that the
+	 * numbers above and to the right of the non-zero value are a pair of
+	 * complex values, a complex number and its conjugate.
+	 *
+	 * SVD will always return real numbers so this can be ignored, but if
+	 * you are calculating eigenvalues outside the SVD method, you may
+	 * get complex numbers, which will be indicated with the return error
+	 * code '-ECOMPLEXVAL'.
+	 *
+	 * If the imput matrix has complex eigenvalues, then these will be
+	 * ignored and the output vector will not include them.
+	 *
+	 * NOTE: The real and imaginary parts of the complex numbers are not
+	 * available. This only checks if there are any complex eigenvalues and
+	 * returns an appropriate error code to alert the user that there are
+	 * non-real eigenvalues present.
+	 */
+
+	for (size_t g = 0; g < (t->sz_rows - 1); g++) {
+		/* Check if any element just below the diagonal isn't zero. */
+		sdiag = zsl_mtx_at(t, g + 1, g);
+		if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
+			/* Skip two elements if the element below
+			 * is not zero. */
+			g++;
+		} else {
+			/* Get the diagonal element if the element below
+			 * is zero. */
+			v->data[real] = zsl_mtx_at(t, g, g);
+			real++;
+		}
+	}
+
+
+	/* Since it's not possible to check the coefficient below the last
+	 * diagonal element, then check the element to its left. */
+	sdiag = zsl_mtx_at(t, (t->sz_rows - 1), (t->sz_rows - 2));
+	if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
+		/* Do nothing if the element to its left is not zero. */
+	} else {
+		/* Get the last diagonal element if the element to its left
+		 * is zero. */
+		v->data[real] = zsl_mtx_at(t, (t->sz_rows - 1),
+					   (t->sz_rows - 1));
+		real++;
+	}
+
+	/* Shifted QR leaves the eigenvalues in no particular order on the
+	 * diagonal, so sort them. */
+	v->sz = real;
+	zsl_mtx_eigenvalues_sort(v);
+
+	/* If the number of real eigenvalues ('real' coefficient) is less than
+	 * the matrix dimensions, then there must be complex eigenvalues. */
+	if (real != t->sz_rows) {
+		return -ECOMPLEXVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Calculates the eigenvalues of the nxn matrix 'm' into 'v', using 't'
+ * (nxn) and 'tau' (n entries) as temporaries.
+ */
+static int
+zsl_mtx_eigenvalues_run(const struct zsl_mtx *m, struct zsl_vec *v,
+			size_t iter, size_t *used, struct zsl_mtx *t,
+			zsl_real_t *tau)
+{
+	int rc;
+	bool conv;
+	size_t stall = 0;
+
+	zsl_mtx_eigenvalues_load(m, t, tau);
+
+	/* Calculate the upper triangular matrix by using the recursive QR
+	 * decomposition method, which keeps the Hessenberg form. */
+	conv = zsl_mtx_schur_run(t, NULL, iter, &stall, used);
+
+	/* The diagonal of a partly converged 'T' still holds the estimates,
+	 * but they aren't reported as a success. */
+	rc = zsl_mtx_eigenvalues_extract(t, v, zsl_mtx_is_sym(m));
+
+	return conv ? rc : -ENOCONVERGE;
+}
+
+size_t
+zsl_mtx_eigenvalues_ws_sz(size_t n)
+{
+	/* The Hessenberg matrix and the reflector scale factors. */
+	return (n * n) + n;
+}
+
+int
+zsl_mtx_eigenvalues_ws(const struct zsl_mtx *m, struct zsl_vec *v, size_t iter,
+		       size_t *used, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t *tau;
+	struct zsl_mtx t;
+
+	rc = zsl_ws_mtx_alloc(ws, &t, m->sz_rows, m->sz_rows);
+	tau = zsl_ws_alloc(ws, m->sz_rows);
+	if (rc || tau == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_mtx_eigenvalues_run(m, v, iter, used, &t, tau);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_eigenvalues(const struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+{
+	int rc;
+
+	ZSL_TRACE(ZSL_TRACE_MTX_EIGENVALUES);
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_eigenvalues_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_eigenvalues_ws(m, v, iter, NULL, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+size_t
+zsl_mtx_eigenvectors_ws_sz(size_t n)
+{
+	/* k, f, o and two vectors for zsl_mtx_gram_schmidt_run, five nxn
+	 * matrices, plus zsl_mtx_eigenvalues_ws. */
+	return (5 * n) + (5 * n * n) + zsl_mtx_eigenvalues_ws_sz(n);
+}
+
+int
+zsl_mtx_eigenvectors_ws(const struct zsl_mtx *m, struct zsl_mtx *mev,
+			size_t iter, bool orthonormal, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t b = 0;           /* Total number of eigenvectors. */
+	size_t e_vals = 0;      /* Number of unique eigenvalues. */
+	size_t count = 0;       /* Number of eigenvectors for an eigenvalue. */
+	size_t ga = 0;
+
+	zsl_real_t epsilon = 1E-6;
+	zsl_real_t x;
+
+	/* The vector where all eigenvalues will be stored. */
+	struct zsl_vec k;
+	/* Temp vector to store column data. */
+	struct zsl_vec f;
+	/* The vector where all UNIQUE eigenvalues will be stored. */
+	struct zsl_vec o;
+	/* Temporary mxm identity matrix placeholder. */
+	struct zsl_mtx id;
+	/* 'm' minus the eigenvalues * the identity matrix (id). */
+	struct zsl_mtx mi;
+	/* Placeholder for zsl_mtx_gauss_reduc calls (required param). */
+	struct zsl_mtx mid;
+	/* Matrix containing all column eigenvectors for an eigenvalue. */
+	struct zsl_mtx evec;
+	/* Temporaries for the Gram-Schmidt process. */
+	struct zsl_vec gs1, gs2;
+	/* Matrix containing all column eigenvectors. */
+	struct zsl_mtx mev2;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'mev' has a row per row of 'm'. 'mev'
+	 * isn't checked for columns, since its width is reduced to the
+	 * number of eigenvectors found, and it may be passed again. */
+	if ((m->sz_rows != m->sz_cols) || (mev->sz_rows != m->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	rc = zsl_ws_vec_alloc(ws, &k, m->sz_rows);
+	rc |= zsl_ws_vec_alloc(ws, &f, m->sz_rows);
+	rc |= zsl_ws_vec_alloc(ws, &o, m->sz_rows);
+	rc |= zsl_ws_mtx_alloc(ws, &id, m->sz_rows, m->sz_rows);
+	rc |= zsl_ws_mtx_alloc(ws, &mi, m->sz_rows, m->sz_rows);
+	rc |= zsl_ws_mtx_alloc(ws, &mid, m->sz_rows, m->sz_rows);
+	rc |= zsl_ws_mtx_alloc(ws, &evec, m->sz_rows, m->sz_rows);
+	rc |= zsl_ws_vec_alloc(ws, &gs1, m->sz_rows);
+	rc |= zsl_ws_vec_alloc(ws, &gs2, m->sz_rows);
+	rc |= zsl_ws_mtx_alloc(ws, &mev2, m->sz_rows, m->sz_rows);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	zsl_mtx_init(&mev2, NULL);
+	zsl_vec_init(&o);
+	rc = zsl_mtx_eigenvalues_ws(m, &k, iter, NULL, ws);
+	if (rc == -ENOMEM) {
+		goto err;
+	}
+	rc = 0;
+
+	/* Copy every non-zero eigenvalue ONCE in the 'o' vector to get rid of
+	 * repeated values. */
+	for (size_t q = 0; q < m->sz_rows; q++) {
+		if ((k.data[q] >= epsilon) || (k.data[q] <= -epsilon)) {
+			if (zsl_vec_contains(&o, k.data[q], epsilon) == 0) {
+				o.data[e_vals] = k.data[q];
+				/* Increment the unique eigenvalue counter. */
+				e_vals++;
+			}
+		}
+	}
+
+	/* If zero is also an eigenvalue, copy it once in 'o'. */
+	if (zsl_vec_contains(&k, 0.0, epsilon) > 0) {
+		e_vals++;
+	}
+
+	/* Calculates the null space of 'm' minus each eigenvalue times
+	 * the identity matrix by performing the gaussian reduction. */
+	for (size_t g = 0; g < e_vals; g++) {
+		count = 0;
+		ga = 0;
+
+		/* id = m - o[g] * I, in a single pass. */
+		zsl_mtx_copy(&id, m);
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			id.data[i * m->sz_cols + i] -= o.data[g];
+		}
+		zsl_mtx_gauss_reduc(&id, &mid, &mi);
+
+		/* If 'orthonormal' is true, perform the following process. */
+		if (orthonormal == true) {
+			/* Count how many eigenvectors ('count' coefficient)
+			 * there are for each eigenvalue. */
+			for (size_t h = 0; h < m->sz_rows; h++) {
+				x = zsl_mtx_at(&mi, h, h);
+				if ((x >= 0.0 && x < epsilon) ||
+				    (x <= 0.0 && x > -epsilon)) {
+					count++;
+				}
+			}
+
+			/* Resize evec* placeholders to have 'count' cols. */
+			evec.sz_cols = count;
+
+			/* Get all the eigenvectors for each eigenvalue and set
+			 * them as the columns of 'evec'. */
+			for (size_t h = 0; h < m->sz_rows; h++) {
+				x = zsl_mtx_at(&mi, h, h);
+				if ((x >= 0.0 && x < epsilon) ||
+				    (x <= 0.0 && x > -epsilon)) {
+					zsl_mtx_put(&mi, h, h, -1);
+					zsl_mtx_col_load(&mi, h, f.data);
+					zsl_vec_neg(&f);
+					zsl_mtx_col_store(&evec, ga, f.data);
+					ga++;
+				}
+			}
+			/* Orthonormalize the set of eigenvectors for each
+			 * eigenvalue using the Gram-Schmidt process. */
+			zsl_mtx_gram_schmidt_run(&evec, gs1.data, gs2.data);
+			zsl_mtx_cols_norm_run(&evec, gs1.data);
+
+			/* Place these eigenvectors in the 'mev2' matrix,
+			 * that will hold all the eigenvectors for different
+			 * eigenvalues. */
+			for (size_t gi = 0; gi < count; gi++) {
+				zsl_mtx_col_load(&evec, gi, f.data);
+				zsl_mtx_col_store(&mev2, b, f.data);
+				b++;
+			}
+
+		} else {
+			/* Orthonormal is false. */
+			/* Get the eigenvectors for every eigenvalue and place
+			 * them in 'mev2'. */
+			for (size_t h = 0; h < m->sz_rows; h++) {
+				x = zsl_mtx_at(&mi, h, h);
+				if ((x >= 0.0 && x < epsilon) ||
+				    (x <= 0.0 && x > -epsilon)) {
+					zsl_mtx_put(&mi, h, h, -1);
+					zsl_mtx_col_load(&mi, h, f.data);
+					zsl_vec_neg(&f);
+					zsl_mtx_col_store(&mev2, b, f.data);
+					b++;
+				}
+			}
+		}
+	}
+
+	/* Since 'b' is the number of eigenvectors, reduce 'mev' (of size
+	 * m->sz_rows times b) to erase columns of zeros. */
+	mev->sz_cols = b;
+
+	for (size_t s = 0; s < b; s++) {
+		zsl_mtx_col_load(&mev2, s, f.data);
+		zsl_mtx_col_store(mev, s, f.data);
+	}
+
+	/* Checks if the number of eigenvectors is the same as the shape of
+	 * the input matrix. If the number of eigenvectors is less than
+	 * the number of columns in the input matrix 'm', this will be
+	 * indicated by EEIGENSIZE as a return code. */
+	if (b != m->sz_cols) {
+		rc = -EEIGENSIZE;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_eigenvectors(const struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
+		     bool orthonormal)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_eigenvectors_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_eigenvectors_ws(m, mev, iter, orthonormal, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+#endif
+
+/* Maximum number of Jacobi sweeps in zsl_mtx_eigen_sym. Convergence is
+ * quadratic, so well under ten sweeps are normally required. */
+#define ZSL_MTX_EIGEN_SYM_SWEEPS 50
+
+/*
+ * Sorts the eigenvalues in 'v' by decreasing value, applying the same
+ * permutation to the columns of 'mev' when it isn't NULL.
+ */
+static void
+zsl_mtx_eigen_sym_sort(struct zsl_vec *v, struct zsl_mtx *mev)
+{
+	size_t n = v->sz;
+	size_t k;
+	zsl_real_t x;
+
+	for (size_t i = 0; i < n; i++) {
+		k = i;
+		for (size_t j = i + 1; j < n; j++) {
+			if (v->data[j] > v->data[k]) {
+				k = j;
+			}
+		}
+		if (k == i) {
+			continue;
+		}
+
+		x = v->data[i];
+		v->data[i] = v->data[k];
+		v->data[k] = x;
+		if (mev != NULL) {
+			for (size_t r = 0; r < n; r++) {
+				x = mev->data[r * n + i];
+				mev->data[r * n + i] = mev->data[r * n + k];
+				mev->data[r * n + k] = x;
+			}
+		}
+	}
+}
+
+/*
+ * Returns the Jacobi rotation (c, s) and the tangent 't' that zeroes the
+ * off-diagonal element 'apq' of the symmetric 2x2 [app apq; apq aqq].
+ */
+static void
+zsl_mtx_eigen_sym_rot(zsl_real_t app, zsl_real_t apq, zsl_real_t aqq,
+		      zsl_real_t *c, zsl_real_t *s, zsl_real_t *t)
+{
+	zsl_real_t theta;
+
+	if (apq == 0.0) {
+		*c = 1.0;
+		*s = 0.0;
+		*t = 0.0;
+		return;
+	}
+
+	theta = (aqq - app) / (2.0 * apq);
+	*t = 1.0 / (ZSL_ABS(theta) + ZSL_SQRT(theta * theta + 1.0));
+	if (theta < 0.0) {
+		*t = -*t;
+	}
+	*c = 1.0 / ZSL_SQRT(*t * *t + 1.0);
+	*s = *t * *c;
+}
+
+/*
+ * Closed-form eigendecomposition of a symmetric 3x3 matrix.
+ *
+ * The eigenvalues are the roots of the characteristic cubic, found with
+ * the trigonometric method. The eigenvector of the eigenvalue furthest
+ * from the other two is the cross product of two rows of (m - lambda * I),
+ * and the remaining pair is found with a single Jacobi rotation in the
+ * plane orthogonal to it, which stays accurate for repeated eigenvalues.
+ * Returns false if the cross product degenerates, in which case the
+ * caller should fall back to the iterative method.
+ */
+static bool
+zsl_mtx_eigen_sym_3x3(const struct zsl_mtx *m, struct zsl_vec *v,
+		      struct zsl_mtx *mev)
+{
+	zsl_real_t b[3][3];
+	zsl_real_t r[3][3];
+	zsl_real_t x[3][3];
+	zsl_real_t vd[3], u[3], w[3], y[3];
+	zsl_real_t scale = 0.0;
+	zsl_real_t p1, p2, p, q, det, phi, ld, e1, e2, e3;
+	zsl_real_t buu, buw, bww, c, s, t, nrm, best;
+	size_t bi = 0;
+
+	/* Copy the upper triangle, scaled to avoid overflow in the cubic. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i; j < 3; j++) {
+			b[i][j] = m->data[i * 3 + j];
+			scale = ZSL_MAX(scale, ZSL_ABS(b[i][j]));
+		}
+	}
+
+	if (scale == 0.0) {
+		scale = 1.0;
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i; j < 3; j++) {
+			b[i][j] /= scale;
+			b[j][i] = b[i][j];
+		}
+	}
+
+	p1 = b[0][1] * b[0][1] + b[0][2] * b[0][2] + b[1][2] * b[1][2];
+
+	/* Diagonal matrices are already decomposed. */
+	if (p1 == 0.0) {
+		for (size_t i = 0; i < 3; i++) {
+			v->data[i] = b[i][i] * scale;
+		}
+		if (mev != NULL) {
+			zsl_mtx_init(mev, zsl_mtx_entry_fn_identity);
+		}
+		zsl_mtx_eigen_sym_sort(v, mev);
+		return true;
+	}
+
+	q = (b[0][0] + b[1][1] + b[2][2]) / 3.0;
+	p2 = (b[0][0] - q) * (b[0][0] - q) + (b[1][1] - q) * (b[1][1] - q) +
+	     (b[2][2] - q) * (b[2][2] - q) + 2.0 * p1;
+	p = ZSL_SQRT(p2 / 6.0);
+
+	/* det((b - q * I) / p) / 2, which lies in [-1, 1]. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			r[i][j] = (b[i][j] - (i == j ? q : 0.0)) / p;
+		}
+	}
+	det = r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1]) -
+	      r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0]) +
+	      r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0]);
+	det = ZSL_MAX(-1.0, ZSL_MIN(1.0, det / 2.0));
+	phi = ZSL_ACOS(det) / 3.0;
+
+	/* e1 >= e2 >= e3. */
+	e1 = q + 2.0 * p * ZSL_COS(phi);
+	e3 = q - p * ZSL_COS(phi) - ZSL_SQRT(3.0) * p * ZSL_SIN(phi);
+	e2 = 3.0 * q - e1 - e3;
+	ld = (e1 - e2 >= e2 - e3) ? e1 : e3;
+
+	/* Cross products of the rows of (b - ld * I), keeping the largest. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			r[i][j] = b[i][j] - (i == j ? ld : 0.0);
+		}
+	}
+	best = 0.0;
+	for (size_t i = 0; i < 3; i++) {
+		zsl_real_t *ra = r[i];
+		zsl_real_t *rb = r[(i + 1) % 3];
+
+		x[i][0] = ra[1] * rb[2] - ra[2] * rb[1];
+		x[i][1] = ra[2] * rb[0] - ra[0] * rb[2];
+		x[i][2] = ra[0] * rb[1] - ra[1] * rb[0];
+		nrm = x[i][0] * x[i][0] + x[i][1] * x[i][1] + x[i][2] * x[i][2];
+		if (nrm > best) {
+			best = nrm;
+			bi = i;
+		}
+	}
+
+	if (best == 0.0) {
+		return false;
+	}
+
+	nrm = ZSL_SQRT(best);
+	for (size_t i = 0; i < 3; i++) {
+		vd[i] = x[bi][i] / nrm;
+	}
+
+	/* Orthonormal basis (u, w) of the plane orthogonal to 'vd'. */
+	if (ZSL_ABS(vd[0]) > ZSL_ABS(vd[1])) {
+		nrm = ZSL_SQRT(vd[0] * vd[0] + vd[2] * vd[2]);
+		u[0] = -vd[2] / nrm;
+		u[1] = 0.0;
+		u[2] = vd[0] / nrm;
+	} else {
+		nrm = ZSL_SQRT(vd[1] * vd[1] + vd[2] * vd[2]);
+		u[0] = 0.0;
+		u[1] = vd[2] / nrm;
+		u[2] = -vd[1] / nrm;
+	}
+	w[0] = vd[1] * u[2] - vd[2] * u[1];
+	w[1] = vd[2] * u[0] - vd[0] * u[2];
+	w[2] = vd[0] * u[1] - vd[1] * u[0];
+
+	/* Project 'b' onto the plane and diagonalise the 2x2 result. */
+	buu = buw = bww = 0.0;
+	for (size_t i = 0; i < 3; i++) {
+		y[i] = b[i][0] * u[0] + b[i][1] * u[1] + b[i][2] * u[2];
+		buu += u[i] * y[i];
+		buw += w[i] * y[i];
+	}
+	for (size_t i = 0; i < 3; i++) {
+		bww += w[i] * (b[i][0] * w[0] + b[i][1] * w[1] +
+			       b[i][2] * w[2]);
+	}
+	zsl_mtx_eigen_sym_rot(buu, buw, bww, &c, &s, &t);
+
+	v->data[0] = ld * scale;
+	v->data[1] = (buu - t * buw) * scale;
+	v->data[2] = (bww + t * buw) * scale;
+
+	if (mev != NULL) {
+		for (size_t i = 0; i < 3; i++) {
+			mev->data[i * 3 + 0] = vd[i];
+			mev->data[i * 3 + 1] = c * u[i] - s * w[i];
+			mev->data[i * 3 + 2] = s * u[i] + c * w[i];
+		}
+	}
+
+	zsl_mtx_eigen_sym_sort(v, mev);
+
+	return true;
+}
+
+size_t
+zsl_mtx_eigen_sym_ws_sz(size_t n)
+{
+	/* A working copy of the input matrix. */
+	return n * n;
+}
+
+int
+zsl_mtx_eigen_sym_ws(const struct zsl_mtx *m, struct zsl_vec *v,
+		     struct zsl_mtx *mev, struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = m->sz_rows;
+	zsl_real_t off, fro, apk, aqk, c, s, t;
+	struct zsl_mtx a;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square, and 'v' and 'mev' are sized to match. */
+	if ((m->sz_rows != m->sz_cols) || (v->sz != n) ||
+	    ((mev != NULL) &&
+	     ((mev->sz_rows != n) || (mev->sz_cols != n)))) {
+		return -EINVAL;
+	}
+#endif
+
+	if ((n == 3) && zsl_mtx_eigen_sym_3x3(m, v, mev)) {
+		return 0;
+	}
+
+	rc = zsl_ws_mtx_alloc(ws, &a, n, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* Mirror the upper triangle of 'm' into the working copy. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i; j < n; j++) {
+			a.data[i * n + j] = m->data[i * n + j];
+			a.data[j * n + i] = m->data[i * n + j];
+		}
+	}
+
+	if (mev != NULL) {
+		zsl_mtx_init(mev, zsl_mtx_entry_fn_identity);
+	}
+
+	/* Cyclic Jacobi: rotate each (p, q) pair in turn until the
+	 * off-diagonal part is negligible relative to the whole matrix. */
+	for (size_t sweep = 0; sweep < ZSL_MTX_EIGEN_SYM_SWEEPS; sweep++) {
+		off = fro = 0.0;
+		for (size_t i = 0; i < n * n; i++) {
+			fro += a.data[i] * a.data[i];
+		}
+		for (size_t p = 0; p < n; p++) {
+			for (size_t q = p + 1; q < n; q++) {
+				off += a.data[p * n + q] * a.data[p * n + q];
+			}
+		}
+		if (off <= ZSL_MTX_EPS * ZSL_MTX_EPS * fro) {
+			break;
+		}
+
+		for (size_t p = 0; p < n; p++) {
+			for (size_t q = p + 1; q < n; q++) {
+				zsl_mtx_eigen_sym_rot(a.data[p * n + p],
+						      a.data[p * n + q],
+						      a.data[q * n + q],
+						      &c, &s, &t);
+				if (s == 0.0) {
+					continue;
+				}
+
+				/* a = P^T * a * P. */
+				for (size_t k = 0; k < n; k++) {
+					apk = a.data[k * n + p];
+					aqk = a.data[k * n + q];
+					a.data[k * n + p] = c * apk - s * aqk;
+					a.data[k * n + q] = s * apk + c * aqk;
+				}
+				for (size_t k = 0; k < n; k++) {
+					apk = a.data[p * n + k];
+					aqk = a.data[q * n + k];
+					a.data[p * n + k] = c * apk - s * aqk;
+					a.data[q * n + k] = s * apk + c * aqk;
+				}
+				a.data[p * n + q] = 0.0;
+				a.data[q * n + p] = 0.0;
 
-					for (int k = 0; k < m->sz_rows; k++) {
-						mout->data[(i * m->sz_rows) + k]
-							*= row2;
-						mout->data[(k * m->sz_rows) + i]
-							*= col2;
-					}
+				if (mev == NULL) {
+					continue;
+				}
+
+				/* mev = mev * P. */
+				for (size_t k = 0; k < n; k++) {
+					zsl_real_t *ev = &mev->data[k * n];
+
+					apk = ev[p];
+					aqk = ev[q];
+					ev[p] = c * apk - s * aqk;
+					ev[q] = s * apk + c * aqk;
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		v->data[i] = a.data[i * n + i];
+	}
+	zsl_mtx_eigen_sym_sort(v, mev);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_mtx_eigen_sym(const struct zsl_mtx *m, struct zsl_vec *v,
+		  struct zsl_mtx *mev)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_eigen_sym_ws_sz(m->sz_rows));
+
+	rc = zsl_mtx_eigen_sym_ws(m, v, mev, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/*
+ * Rotates columns 'i' and 'j' of the p x q matrix 'w' to make them
+ * orthogonal, applying the same rotation to 'vq' when it isn't NULL.
+ * Returns false if they already were, in which case nothing is changed.
+ * Costs O(p + q), whatever the data.
+ */
+static bool
+zsl_mtx_svd_rot(struct zsl_mtx *w, struct zsl_mtx *vq, size_t i, size_t j)
+{
+	size_t p = w->sz_rows;
+	size_t q = w->sz_cols;
+	zsl_real_t alpha = 0.0, beta = 0.0, gamma = 0.0;
+	zsl_real_t zeta, t, c, s;
+	zsl_real_t x, y;
+
+	for (size_t k = 0; k < p; k++) {
+		x = w->data[k * q + i];
+		y = w->data[k * q + j];
+		alpha += x * x;
+		beta += y * y;
+		gamma += x * y;
+	}
+
+	/* Skip columns that are already orthogonal. */
+	if (ZSL_ABS(gamma) <= ZSL_MTX_EPS * ZSL_SQRT(alpha * beta)) {
+		return false;
+	}
+
+	/* Rotation that zeroes the (i, j) inner product, using the smaller
+	 * root for t. */
+	zeta = (beta - alpha) / (2.0 * gamma);
+	t = 1.0 / (ZSL_ABS(zeta) + ZSL_SQRT(1.0 + zeta * zeta));
+	if (zeta < 0.0) {
+		t = -t;
+	}
+	c = 1.0 / ZSL_SQRT(1.0 + t * t);
+	s = c * t;
+
+	for (size_t k = 0; k < p; k++) {
+		x = w->data[k * q + i];
+		y = w->data[k * q + j];
+		w->data[k * q + i] = c * x - s * y;
+		w->data[k * q + j] = s * x + c * y;
+	}
+	if (vq == NULL) {
+		return true;
+	}
+	for (size_t k = 0; k < q; k++) {
+		x = vq->data[k * q + i];
+		y = vq->data[k * q + j];
+		vq->data[k * q + i] = c * x - s * y;
+		vq->data[k * q + j] = s * x + c * y;
+	}
+
+	return true;
+}
+
+/*
+ * Runs sweeps of the one-sided (Hestenes) Jacobi SVD on the p x q matrix
+ * 'w', where p >= q.
+ *
+ * Pairs of columns of 'w' are rotated until they are all mutually
+ * orthogonal, at which point the norm of each column is a singular value.
+ * Rotations are accumulated in the q x q matrix 'vq' when it isn't NULL.
+ * Stops after a sweep in which no rotation was required, returning true,
+ * or after 'iter' sweeps. Every sweep costs the same, whatever the data.
+ */
+static bool
+zsl_mtx_svd_sweeps(struct zsl_mtx *w, struct zsl_mtx *vq, size_t iter,
+		   size_t *used)
+{
+	size_t q = w->sz_cols;
+	size_t sweep;
+	bool rotated = true;
+
+	for (sweep = 0; sweep < iter && rotated; sweep++) {
+		rotated = false;
+		for (size_t i = 0; i + 1 < q; i++) {
+			for (size_t j = i + 1; j < q; j++) {
+				if (zsl_mtx_svd_rot(w, vq, i, j)) {
+					rotated = true;
 				}
 			}
+		}
+	}
+
+	if (used != NULL) {
+		*used = sweep;
+	}
+
+	return !rotated;
+}
+
+/*
+ * Writes the norms of the columns of 'w' to 'sig' (q entries), and sorts the
+ * columns of 'w' and 'vq', when it isn't NULL, by decreasing norm.
+ */
+static void
+zsl_mtx_svd_sort(struct zsl_mtx *w, struct zsl_mtx *vq, zsl_real_t *sig)
+{
+	size_t p = w->sz_rows;
+	size_t q = w->sz_cols;
+	size_t piv;
+	zsl_real_t x;
+
+	for (size_t i = 0; i < q; i++) {
+		sig[i] = 0.0;
+		for (size_t k = 0; k < p; k++) {
+			sig[i] += w->data[k * q + i] * w->data[k * q + i];
+		}
+		sig[i] = ZSL_SQRT(sig[i]);
+	}
+
+	/* Selection sort by decreasing singular value. */
+	for (size_t i = 0; i + 1 < q; i++) {
+		piv = i;
+		for (size_t j = i + 1; j < q; j++) {
+			if (sig[j] > sig[piv]) {
+				piv = j;
+			}
+		}
+		if (piv == i) {
+			continue;
+		}
+		x = sig[i];
+		sig[i] = sig[piv];
+		sig[piv] = x;
+		for (size_t k = 0; k < p; k++) {
+			x = w->data[k * q + i];
+			w->data[k * q + i] = w->data[k * q + piv];
+			w->data[k * q + piv] = x;
+		}
+		if (vq == NULL) {
+			continue;
+		}
+		for (size_t k = 0; k < q; k++) {
+			x = vq->data[k * q + i];
+			vq->data[k * q + i] = vq->data[k * q + piv];
+			vq->data[k * q + piv] = x;
+		}
+	}
+}
+
+/*
+ * One-sided Jacobi SVD of 'w', running up to 'iter' sweeps with
+ * zsl_mtx_svd_sweeps, then sorting the singular values into 'sig'.
+ */
+static void
+zsl_mtx_svd_jacobi(struct zsl_mtx *w, struct zsl_mtx *vq, zsl_real_t *sig,
+		   size_t iter)
+{
+	zsl_mtx_svd_sweeps(w, vq, iter, NULL);
+	zsl_mtx_svd_sort(w, vq, sig);
+}
+
+/*
+ * Sets 'tmp' to standard basis vector 'e' with the components along the
+ * first 'c' columns of the p x p matrix 'uf' removed, returning the squared
+ * norm of the result. The projection is applied twice for stability.
+ */
+static zsl_real_t
+zsl_mtx_svd_orth(struct zsl_mtx *uf, size_t c, size_t e, zsl_real_t *tmp)
+{
+	size_t p = uf->sz_rows;
+	zsl_real_t x;
+
+	for (size_t k = 0; k < p; k++) {
+		tmp[k] = (k == e) ? 1.0 : 0.0;
+	}
+
+	for (size_t pass = 0; pass < 2; pass++) {
+		for (size_t j = 0; j < c; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < p; k++) {
+				x += uf->data[k * p + j] * tmp[k];
+			}
+			for (size_t k = 0; k < p; k++) {
+				tmp[k] -= x * uf->data[k * p + j];
+			}
+		}
+	}
+
+	x = 0.0;
+	for (size_t k = 0; k < p; k++) {
+		x += tmp[k] * tmp[k];
+	}
+
+	return x;
+}
+
+/*
+ * Given the p x q matrix 'w' produced by zsl_mtx_svd_jacobi and its sorted
+ * singular values 'sig', writes the normalised columns of 'w' into the
+ * p x p orthogonal matrix 'uf', completing any columns belonging to zero
+ * singular values (and columns q..p-1) with an orthonormal basis. 'tmp'
+ * must hold p entries.
+ */
+static void
+zsl_mtx_svd_basis(struct zsl_mtx *w, zsl_real_t *sig, struct zsl_mtx *uf,
+		  zsl_real_t *tmp)
+{
+	size_t p = w->sz_rows;
+	size_t q = w->sz_cols;
+	size_t r = 0;
+	size_t best;
+	zsl_real_t nrm, bnrm;
+
+	/* Columns with non-negligible singular values are normalised. */
+	while (r < q && sig[r] > ZSL_MTX_EPS * (zsl_real_t)p * sig[0]) {
+		for (size_t k = 0; k < p; k++) {
+			uf->data[k * p + r] = w->data[k * q + r] / sig[r];
+		}
+		r++;
+	}
+
+	/* The remaining columns are built from whichever standard basis
+	 * vector is least parallel to the columns found so far. */
+	for (size_t c = r; c < p; c++) {
+		best = 0;
+		bnrm = -1.0;
+		for (size_t e = 0; e < p; e++) {
+			nrm = zsl_mtx_svd_orth(uf, c, e, tmp);
+			if (nrm > bnrm) {
+				bnrm = nrm;
+				best = e;
+			}
+		}
+
+		nrm = ZSL_SQRT(zsl_mtx_svd_orth(uf, c, best, tmp));
+		for (size_t k = 0; k < p; k++) {
+			uf->data[k * p + c] = tmp[k] / nrm;
+		}
+	}
+}
+
+/*
+ * Loads 'm', or its transpose if it has more columns than rows, into 'w' so
+ * that zsl_mtx_svd_jacobi always runs on a matrix with p >= q.
+ */
+static void
+zsl_mtx_svd_load(const struct zsl_mtx *m, struct zsl_mtx *w)
+{
+	if (m->sz_rows >= m->sz_cols) {
+		zsl_mtx_copy(w, m);
+	} else {
+		zsl_mtx_trans(m, w);
+	}
+}
+
+/*
+ * Completes the SVD of a rows x cols matrix, once zsl_mtx_svd_jacobi has run
+ * on 'w' and written the rotations to 'v' (rows >= cols) or 'u' (otherwise).
+ * Builds the other singular vectors from 'w', using 'tmp' (p entries), and
+ * places the singular values 'sig' on the diagonal of 'e'.
+ */
+static void
+zsl_mtx_svd_form(struct zsl_mtx *u, struct zsl_mtx *e, struct zsl_mtx *v,
+		 struct zsl_mtx *w, zsl_real_t *sig, zsl_real_t *tmp)
+{
+	zsl_mtx_svd_basis(w, sig, (u->sz_rows < v->sz_rows) ? v : u, tmp);
+
+	zsl_mtx_init(e, NULL);
+	for (size_t g = 0; g < w->sz_cols; g++) {
+		e->data[g * e->sz_cols + g] = sig[g];
+	}
+}
+
+/*
+ * Calculates the SVD of 'm' into 'u', 'e' and 'v', using 'w' (p x q, where
+ * p and q are the larger and smaller of the dimensions of 'm'), 'sig'
+ * (q entries) and 'tmp' (p entries) as temporaries.
+ */
+static void
+zsl_mtx_svd_run(const struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+		struct zsl_mtx *v, size_t iter, struct zsl_mtx *w,
+		zsl_real_t *sig, zsl_real_t *tmp)
+{
+	/* For m = U * S * V^T with rows >= cols, 'w' is 'm' and the rotations
+	 * give V directly. For wide matrices 'w' is m^T = V * S * U^T, so the
+	 * roles of 'u' and 'v' are swapped. */
+	struct zsl_mtx *r = (m->sz_rows < m->sz_cols) ? u : v;
+
+	zsl_mtx_svd_load(m, w);
+	zsl_mtx_init(r, zsl_mtx_entry_fn_identity);
+	zsl_mtx_svd_jacobi(w, r, sig, iter);
+	zsl_mtx_svd_form(u, e, v, w, sig, tmp);
+}
 
-			row = 0.0;
-			col = 0.0;
-		}
-	}
+size_t
+zsl_mtx_svd_ws_sz(size_t rows, size_t cols)
+{
+	size_t max = rows > cols ? rows : cols;
+	size_t min = rows < cols ? rows : cols;
 
-err:
-	return rc;
+	/* w, the singular values and the basis completion vector. */
+	return (rows * cols) + min + max;
 }
 
 int
-zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+zsl_mtx_svd_ws(const struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+	       struct zsl_mtx *v, size_t iter, struct zsl_workspace *ws)
 {
-	size_t size = m->sz_rows;
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	bool wide = m->sz_rows < m->sz_cols;
+	size_t p = wide ? m->sz_cols : m->sz_rows;
+	size_t q = wide ? m->sz_rows : m->sz_cols;
+	struct zsl_mtx w;
+	struct zsl_vec sig, tmp;
 
-	if (hessenberg == true) {
-		size--;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the output matrices have the expected shapes. */
+	if ((u->sz_rows != m->sz_rows) || (u->sz_cols != m->sz_rows) ||
+	    (e->sz_rows != m->sz_rows) || (e->sz_cols != m->sz_cols) ||
+	    (v->sz_rows != m->sz_cols) || (v->sz_cols != m->sz_cols)) {
+		return -EINVAL;
 	}
+#endif
 
-	ZSL_VECTOR_DEF(v, size);
-	ZSL_VECTOR_DEF(v2, m->sz_rows);
-	ZSL_VECTOR_DEF(e1, size);
-
-	ZSL_MATRIX_DEF(mv, size, 1);
-	ZSL_MATRIX_DEF(mvt, 1, size);
-	ZSL_MATRIX_DEF(id, size, size);
-	ZSL_MATRIX_DEF(vvt, size, size);
-	ZSL_MATRIX_DEF(h2, size, size);
-
-	/* Create the e1 vector, i.e. the vector (1, 0, 0, ...). */
-	zsl_vec_init(&e1);
-	e1.data[0] = 1.0;
-
-	/* Get the first column of the input matrix. */
-	zsl_mtx_get_col(m, 0, v2.data);
-	if (hessenberg == true) {
-		zsl_vec_get_subset(&v2, 1, size, &v);
-	} else {
-		zsl_vec_copy(&v, &v2);
+	rc = zsl_ws_mtx_alloc(ws, &w, p, q);
+	rc |= zsl_ws_vec_alloc(ws, &sig, q);
+	rc |= zsl_ws_vec_alloc(ws, &tmp, p);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
 	}
 
-	/* Change the 'sign' value according to the sign of the first
-	 * coefficient of the matrix. */
-	zsl_real_t sign = 1.0;
-	if (v.data[0] < 0) {
-		sign = -1.0;
-	}
+	zsl_mtx_svd_run(m, u, e, v, iter, &w, sig.data, tmp.data);
 
-	/* Calculate the vector 'v' that will later be used to calculate the
-	 * Householder matrix. */
-	zsl_vec_scalar_mult(&e1, -sign * zsl_vec_norm(&v));
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
 
-	zsl_vec_add(&v, &e1, &v);
+int
+zsl_mtx_svd(const struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+	    struct zsl_mtx *v, size_t iter)
+{
+	int rc;
 
-	zsl_vec_scalar_div(&v, zsl_vec_norm(&v));
+	ZSL_TRACE(ZSL_TRACE_MTX_SVD);
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_svd_ws_sz(m->sz_rows, m->sz_cols));
 
-	/* Calculate the H householder matrix by doing:
-	 * H = IDENTITY - 2 * v * v^t. */
-	zsl_mtx_from_arr(&mv, v.data);
-	zsl_mtx_trans(&mv, &mvt);
-	zsl_mtx_mult(&mv, &mvt, &vvt);
-	zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
-	zsl_mtx_scalar_mult_d(&vvt, -2);
-	zsl_mtx_add(&id, &vvt, &h2);
+	rc = zsl_mtx_svd_ws(m, u, e, v, iter, ws);
+	ZSL_SCRATCH_PUT(ws);
 
-	/* If Hessenberg set to true, augment the output to the size of 'm'.
-	 * If Hessenberg set to false, this line of code will do nothing but
-	 * copy the matrix 'h2' into the output matrix 'h', */
-	zsl_mtx_augm_diag(&h2, h);
+	return rc;
+}
 
-	return 0;
+size_t
+zsl_mtx_svd_vals_ws_sz(size_t rows, size_t cols)
+{
+	/* w only, since no basis is built. */
+	return rows * cols;
 }
 
 int
-zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
-	    bool hessenberg)
+zsl_mtx_svd_vals_ws(const struct zsl_mtx *m, struct zsl_vec *s, size_t iter,
+		    struct zsl_workspace *ws)
 {
-	ZSL_MATRIX_DEF(r2, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(hess, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(h, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(h2, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(qt, m->sz_rows, m->sz_rows);
-
-	zsl_mtx_init(&h, NULL);
-	zsl_mtx_init(&qt, zsl_mtx_entry_fn_identity);
-	zsl_mtx_copy(r, m);
-
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
-
-		/* Reduce the matrix by 'g' rows and columns each time. */
-		ZSL_MATRIX_DEF(mred, (m->sz_rows - g), (m->sz_cols - g));
-		ZSL_MATRIX_DEF(hred, (m->sz_rows - g), (m->sz_rows - g));
-		zsl_mtx_reduce_iter(r, &mred);
-
-		/* Calculate the reduced Householder matrix 'hred'. */
-		if (hessenberg == true) {
-			zsl_mtx_householder(&mred, &hred, true);
-		} else {
-			zsl_mtx_householder(&mred, &hred, false);
-		}
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t min = m->sz_rows < m->sz_cols ? m->sz_rows : m->sz_cols;
+	struct zsl_mtx w;
 
-		/* Augment the Householder matrix to the input matrix size. */
-		zsl_mtx_augm_diag(&hred, &h);
-		zsl_mtx_mult(&h, r, &r2);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 's' can hold every singular value. */
+	if (s->sz != min) {
+		return -EINVAL;
+	}
+#endif
 
-		/* Multiply this Householder matrix by the previous ones,
-		 * stacked in 'qt'. */
-		zsl_mtx_mult(&h, &qt, &h2);
-		zsl_mtx_copy(&qt, &h2);
-		if (hessenberg == true) {
-			zsl_mtx_mult(&r2, &h, &hess);
-			zsl_mtx_copy(r, &hess);
-		} else {
-			zsl_mtx_copy(r, &r2);
-		}
+	rc = zsl_ws_mtx_alloc(ws, &w, m->sz_rows < m->sz_cols ? m->sz_cols :
+			      m->sz_rows, min);
+	if (rc) {
+		goto err;
 	}
 
-	/* Calculate the 'q' matrix by transposing 'qt'. */
-	zsl_mtx_trans(&qt, q);
+	zsl_mtx_svd_load(m, &w);
+	zsl_mtx_svd_jacobi(&w, NULL, s->data, iter);
 
-	return 0;
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
 }
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
+zsl_mtx_svd_vals(const struct zsl_mtx *m, struct zsl_vec *s, size_t iter)
 {
 	int rc;
 
-	/* Use scratch memory to avoid stack overflow when these functions
-	 * are called recursively. */
-	#ifdef CONFIG_ZSL_MATRIX_QRD_USE_SCRATCH
-	ZSL_QRD_SCRATCH_1_CLEAR;
-	struct zsl_mtx q = {
-		.sz_rows = m->sz_rows,
-		.sz_cols = m->sz_rows,
-		.data = scrd_1
-	};
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_svd_vals_ws_sz(m->sz_rows, m->sz_cols));
 
-	ZSL_QRD_SCRATCH_2_CLEAR;
-	struct zsl_mtx r = {
-		.sz_rows = m->sz_rows,
-		.sz_cols = m->sz_rows,
-		.data = scrd_2
-	};
-	#else
-	/* Use stack ... this will get HUGE though!!! */
-	ZSL_MATRIX_DEF(q, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(r, m->sz_rows, m->sz_rows);
-	#endif
+	rc = zsl_mtx_svd_vals_ws(m, s, iter, ws);
+	ZSL_SCRATCH_PUT(ws);
 
+	return rc;
+}
+#endif
 
-	/* Make a copy of 'm'. */
-	rc = zsl_mtx_copy(mout, m);
-	if (rc) {
-		return -EINVAL;
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/*
+ * Forms the pseudo-inverse 'pinv' of a matrix from 'w' (p x q, where p and
+ * q are the larger and smaller of its dimensions), 'vq' (q x q) and 'sig'
+ * (q entries), as left by zsl_mtx_svd_jacobi. 'sig' is overwritten.
+ *
+ * After zsl_mtx_svd_jacobi, column g of 'w' is sig[g] times the matching
+ * singular vector on the long side of 'm', and column g of 'vq' is the
+ * singular vector on the short side. The pseudo-inverse is then the sum
+ * of their outer products divided by sig[g]^2, so U and sigma are never
+ * formed, and the basis of the null space is never completed.
+ */
+static void
+zsl_mtx_pinv_form(struct zsl_mtx *pinv, struct zsl_mtx *w, struct zsl_mtx *vq,
+		  zsl_real_t *sig)
+{
+	size_t q = w->sz_cols;
+	zsl_real_t epsilon = 1E-6;
+	zsl_real_t x;
+	struct zsl_mtx *a, *b;
+
+	/* Invert the squared singular values, dropping those that are zero. */
+	for (size_t g = 0; g < q; g++) {
+		sig[g] = (sig[g] > epsilon) ? 1.0 / (sig[g] * sig[g]) : 0.0;
 	}
 
-	for (size_t g = 1; g <= iter; g++) {
-		/* Perform the QR decomposition. */
-		zsl_mtx_qrd(mout, &q, &r, false);
+	/* pinv = V * sigma^-1 * U^T. Rows of 'pinv' follow the columns of
+	 * 'm', which are spanned by 'vq' for tall matrices and by 'w' for
+	 * wide ones. 'pinv' has more rows than columns when 'm' is wide. */
+	if (pinv->sz_rows > pinv->sz_cols) {
+		a = w;
+		b = vq;
+	} else {
+		a = vq;
+		b = w;
+	}
 
-		/* Multiply the results of the QR decomposition together but
-		 * changing its order. */
-		zsl_mtx_mult(&r, &q, mout);
+	for (size_t i = 0; i < pinv->sz_rows; i++) {
+		for (size_t j = 0; j < pinv->sz_cols; j++) {
+			x = 0.0;
+			for (size_t g = 0; g < q; g++) {
+				x += a->data[i * q + g] * sig[g] *
+				     b->data[j * q + g];
+			}
+			pinv->data[i * pinv->sz_cols + j] = x;
+		}
 	}
+}
 
-	return 0;
+/*
+ * Calculates the pseudo-inverse of 'm' into 'pinv', using 'w', 'vq' and
+ * 'sig' as temporaries, as described for zsl_mtx_pinv_form.
+ */
+static void
+zsl_mtx_pinv_run(const struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		 struct zsl_mtx *w, struct zsl_mtx *vq, zsl_real_t *sig)
+{
+	zsl_mtx_svd_load(m, w);
+	zsl_mtx_init(vq, zsl_mtx_entry_fn_identity);
+	zsl_mtx_svd_jacobi(w, vq, sig, iter);
+	zsl_mtx_pinv_form(pinv, w, vq, sig);
+}
+
+size_t
+zsl_mtx_pinv_ws_sz(size_t rows, size_t cols)
+{
+	size_t min = rows < cols ? rows : cols;
+
+	/* w, the rotations and the singular values. */
+	return (rows * cols) + (min * min) + min;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+zsl_mtx_pinv_ws(const struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		struct zsl_workspace *ws)
 {
-	zsl_real_t diag;
-	zsl_real_t sdiag;
-	size_t real = 0;
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t rows = m->sz_rows;
+	size_t cols = m->sz_cols;
+	size_t max = rows > cols ? rows : cols;
+	size_t min = rows < cols ? rows : cols;
+	struct zsl_mtx w, vq;
+	struct zsl_vec sig;
 
-	/* Epsilon is used to check 0 values in the subdiagonal, to determine
-	 * if any coimplekx values were found. Increasing the number of
-	 * iterations will move these values closer to 0, but when using
-	 * single-precision floats the numbers can still be quite large, so
-	 * we need to set a delta of +/- 0.001 in this case. */
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'pinv' has the transposed shape of 'm'. */
+	if ((pinv->sz_rows != cols) || (pinv->sz_cols != rows)) {
+		return -EINVAL;
+	}
+#endif
 
-	zsl_real_t epsilon = 1E-6;
+	rc = zsl_ws_mtx_alloc(ws, &w, max, min);
+	rc |= zsl_ws_mtx_alloc(ws, &vq, min, min);
+	rc |= zsl_ws_vec_alloc(ws, &sig, min);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
 
-	ZSL_MATRIX_DEF(mout, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp2, m->sz_rows, m->sz_rows);
+	zsl_mtx_pinv_run(m, pinv, iter, &w, &vq, sig.data);
 
-	/* Balance the matrix. */
-	zsl_mtx_balance(m, &mtemp);
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
 
-	/* Put the balanced matrix into hessenberg form. */
-	zsl_mtx_qrd(&mtemp, &mout, &mtemp2, true);
+int
+zsl_mtx_pinv(const struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter)
+{
+	int rc;
 
-	/* Calculate the upper triangular matrix by using the recursive QR
-	 * decomposition method. */
-	zsl_mtx_qrd_iter(&mtemp2, &mout, iter);
+	ZSL_SCRATCH_DEF(ws, zsl_mtx_pinv_ws_sz(m->sz_rows, m->sz_cols));
 
-	zsl_vec_init(v);
+	rc = zsl_mtx_pinv_ws(m, pinv, iter, ws);
+	ZSL_SCRATCH_PUT(ws);
 
-	/* If the matrix is symmetric, then it will always have real
-	 * eigenvalues, so treat this case appart. */
-	if (zsl_mtx_is_sym(m) == true) {
-		for (size_t g = 0; g < m->sz_rows; g++) {
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[g] = diag;
-		}
+	return rc;
+}
+#endif
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+size_t
+zsl_mtx_plan_ws_sz(enum zsl_mtx_plan_type type, size_t rows, size_t cols)
+{
+	size_t min = rows < cols ? rows : cols;
+
+	switch (type) {
+	case ZSL_MTX_PLAN_SVD:
+		/* The rotations are kept in the plan for time-sliced runs. */
+		return zsl_mtx_svd_ws_sz(rows, cols) + (min * min);
+	case ZSL_MTX_PLAN_SVD_VALS:
+		return zsl_mtx_svd_vals_ws_sz(rows, cols);
+	case ZSL_MTX_PLAN_PINV:
+		return zsl_mtx_pinv_ws_sz(rows, cols);
+	case ZSL_MTX_PLAN_EIGENVALUES:
+		return zsl_mtx_eigenvalues_ws_sz(rows);
+	default:
 		return 0;
 	}
+}
 
-	/*
-	 * If any value just below the diagonal is non-zero, it means that the
-	 * numbers above and to the right of the non-zero value are a pair of
-	 * complex values, a complex number and its conjugate.
-	 *
-	 * SVD will always return real numbers so this can be ignored, but if
-	 * you are calculating eigenvalues outside the SVD method, you may
-	 * get complex numbers, which will be indicated with the return error
-	 * code '-ECOMPLEXVAL'.
-	 *
-	 * If the imput matrix has complex eigenvalues, then these will be
-	 * ignored and the output vector will not include them.
-	 *
-	 * NOTE: The real and imaginary parts of the complex numbers are not
-	 * available. This only checks if there are any complex eigenvalues and
-	 * returns an appropriate error code to alert the user that there are
-	 * non-real eigenvalues present.
-	 */
+int
+zsl_mtx_plan_init(struct zsl_mtx_plan *plan, enum zsl_mtx_plan_type type,
+		  size_t rows, size_t cols, size_t iter,
+		  struct zsl_workspace *ws)
+{
+	int rc;
+	size_t mark = zsl_ws_mark(ws);
+	size_t max = rows > cols ? rows : cols;
+	size_t min = rows < cols ? rows : cols;
 
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
-		/* Check if any element just below the diagonal isn't zero. */
-		zsl_mtx_get(&mout, g + 1, g, &sdiag);
-		if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-			/* Skip two elements if the element below
-			 * is not zero. */
-			g++;
-		} else {
-			/* Get the diagonal element if the element below
-			 * is zero. */
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[real] = diag;
-			real++;
-		}
+	if ((min == 0) || (type > ZSL_MTX_PLAN_EIGENVALUES)) {
+		return -EINVAL;
+	}
+	if ((type == ZSL_MTX_PLAN_EIGENVALUES) && (rows != cols)) {
+		return -EINVAL;
 	}
 
-
-	/* Since it's not possible to check the coefficient below the last
-	 * diagonal element, then check the element to its left. */
-	zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 2), &sdiag);
-	if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-		/* Do nothing if the element to its left is not zero. */
-	} else {
-		/* Get the last diagonal element if the element to its left
-		 * is zero. */
-		zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 1), &diag);
-		v->data[real] = diag;
-		real++;
+	plan->type = type;
+	plan->sz_rows = rows;
+	plan->sz_cols = cols;
+	plan->iter = iter;
+	plan->vq.sz_rows = 0;
+	plan->vq.sz_cols = 0;
+	plan->vq.data = NULL;
+	plan->t1 = NULL;
+	plan->t2 = NULL;
+	plan->done = 0;
+	plan->stall = 0;
+	plan->pi = 0;
+	plan->pj = 1;
+	plan->started = false;
+	plan->converged = false;
+	plan->rotated = false;
+
+	/* The working copy is stored with the long side as rows for the SVD
+	 * and pinv, as expected by zsl_mtx_svd_jacobi. */
+	rc = zsl_ws_mtx_alloc(ws, &plan->w, max, min);
+	if (rc) {
+		goto err;
 	}
 
-	/* If the number of real eigenvalues ('real' coefficient) is less than
-	 * the matrix dimensions, then there must be complex eigenvalues. */
-	v->sz = real;
-	if (real != m->sz_rows) {
-		return -ECOMPLEXVAL;
+	switch (type) {
+	case ZSL_MTX_PLAN_SVD:
+		/* Rotations, singular values and the basis completion
+		 * vector. */
+		rc = zsl_ws_mtx_alloc(ws, &plan->vq, min, min);
+		plan->t1 = zsl_ws_alloc(ws, min);
+		plan->t2 = zsl_ws_alloc(ws, max);
+		if (rc || plan->t1 == NULL || plan->t2 == NULL) {
+			rc = -ENOMEM;
+		}
+		break;
+	case ZSL_MTX_PLAN_PINV:
+		/* Rotations and singular values. */
+		rc = zsl_ws_mtx_alloc(ws, &plan->vq, min, min);
+		plan->t1 = zsl_ws_alloc(ws, min);
+		if (rc || plan->t1 == NULL) {
+			rc = -ENOMEM;
+		}
+		break;
+	case ZSL_MTX_PLAN_EIGENVALUES:
+		/* Reflector scale factors. */
+		plan->t1 = zsl_ws_alloc(ws, rows);
+		if (plan->t1 == NULL) {
+			rc = -ENOMEM;
+		}
+		break;
+	default:
+		break;
 	}
 
-	/* Put the zeros to the end. */
-	zsl_vec_zte(v);
+err:
+	/* The memory is only returned if the plan couldn't be created. */
+	if (rc) {
+		zsl_ws_release(ws, mark);
+	}
+	return rc;
+}
 
-	return 0;
+/* Returns true if 'm' is NULL or has the shape 'plan' was created for. */
+static inline bool
+zsl_mtx_plan_fits(const struct zsl_mtx_plan *plan, const struct zsl_mtx *m)
+{
+	return (m == NULL) || ((m->sz_rows == plan->sz_rows) &&
+			       (m->sz_cols == plan->sz_cols));
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
-		     bool orthonormal)
+zsl_mtx_plan_start(struct zsl_mtx_plan *plan, const struct zsl_mtx *m)
 {
-	size_t b = 0;           /* Total number of eigenvectors. */
-	size_t e_vals = 0;      /* Number of unique eigenvalues. */
-	size_t count = 0;       /* Number of eigenvectors for an eigenvalue. */
-	size_t ga = 0;
-
-	zsl_real_t epsilon = 1E-6;
-	zsl_real_t x;
-
-	/* The vector where all eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(k, m->sz_rows);
-	/* Temp vector to store column data. */
-	ZSL_VECTOR_DEF(f, m->sz_rows);
-	/* The vector where all UNIQUE eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(o, m->sz_rows);
-	/* Temporary mxm identity matrix placeholder. */
-	ZSL_MATRIX_DEF(id, m->sz_rows, m->sz_rows);
-	/* 'm' minus the eigenvalues * the identity matrix (id). */
-	ZSL_MATRIX_DEF(mi, m->sz_rows, m->sz_rows);
-	/* Placeholder for zsl_mtx_gauss_reduc calls (required param). */
-	ZSL_MATRIX_DEF(mid, m->sz_rows, m->sz_rows);
-	/* Matrix containing all column eigenvectors for an eigenvalue. */
-	ZSL_MATRIX_DEF(evec, m->sz_rows, m->sz_rows);
-	/* Matrix containing all column eigenvectors for an eigenvalue.
-	* Two matrices are required for the Gramm-Schmidt operation. */
-	ZSL_MATRIX_DEF(evec2, m->sz_rows, m->sz_rows);
-	/* Matrix containing all column eigenvectors. */
-	ZSL_MATRIX_DEF(mev2, m->sz_rows, m->sz_rows);
-
-	/* TODO: Check that we have a SQUARE matrix, etc. */
-	zsl_mtx_init(&mev2, NULL);
-	zsl_vec_init(&o);
-	zsl_mtx_eigenvalues(m, &k, iter);
+	if (!zsl_mtx_plan_fits(plan, m) || (m == NULL)) {
+		return -EINVAL;
+	}
 
-	/* Copy every non-zero eigenvalue ONCE in the 'o' vector to get rid of
-	 * repeated values. */
-	for (size_t q = 0; q < m->sz_rows; q++) {
-		if ((k.data[q] >= epsilon) || (k.data[q] <= -epsilon)) {
-			if (zsl_vec_contains(&o, k.data[q], epsilon) == 0) {
-				o.data[e_vals] = k.data[q];
-				/* Increment the unique eigenvalue counter. */
-				e_vals++;
-			}
+	if (plan->type == ZSL_MTX_PLAN_EIGENVALUES) {
+		zsl_mtx_eigenvalues_load(m, &plan->w, plan->t1);
+		plan->sym = zsl_mtx_is_sym(m);
+	} else {
+		zsl_mtx_svd_load(m, &plan->w);
+		if (plan->vq.data != NULL) {
+			zsl_mtx_init(&plan->vq, zsl_mtx_entry_fn_identity);
 		}
 	}
 
-	/* If zero is also an eigenvalue, copy it once in 'o'. */
-	if (zsl_vec_contains(&k, 0.0, epsilon) > 0) {
-		e_vals++;
-	}
+	plan->done = 0;
+	plan->stall = 0;
+	plan->pi = 0;
+	plan->pj = 1;
+	plan->started = true;
+	plan->converged = false;
+	plan->rotated = false;
 
-	/* Calculates the null space of 'm' minus each eigenvalue times
-	 * the identity matrix by performing the gaussian reduction. */
-	for (size_t g = 0; g < e_vals; g++) {
-		count = 0;
-		ga = 0;
+	return 0;
+}
 
-		zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
-		zsl_mtx_scalar_mult_d(&id, -o.data[g]);
-		zsl_mtx_add_d(&id, m);
-		zsl_mtx_gauss_reduc(&id, &mid, &mi);
+/*
+ * Continues the Jacobi sweep of 'plan' from its stored column pair, for at
+ * most 'budget' pairs or until the end of the sweep, and returns the number
+ * of pairs visited. Completing a sweep counts it in plan->done.
+ */
+static size_t
+zsl_mtx_plan_pairs(struct zsl_mtx_plan *plan, size_t budget)
+{
+	size_t q = plan->w.sz_cols;
+	size_t n = 0;
+	struct zsl_mtx *vq = (plan->vq.data != NULL) ? &plan->vq : NULL;
 
-		/* If 'orthonormal' is true, perform the following process. */
-		if (orthonormal == true) {
-			/* Count how many eigenvectors ('count' coefficient)
-			 * there are for each eigenvalue. */
-			for (size_t h = 0; h < m->sz_rows; h++) {
-				zsl_mtx_get(&mi, h, h, &x);
-				if ((x >= 0.0 && x < epsilon) ||
-				    (x <= 0.0 && x > -epsilon)) {
-					count++;
-				}
-			}
+	for (; n < budget && plan->pi + 1 < q; n++) {
+		if (zsl_mtx_svd_rot(&plan->w, vq, plan->pi, plan->pj)) {
+			plan->rotated = true;
+		}
+		if (++plan->pj == q) {
+			plan->pi++;
+			plan->pj = plan->pi + 1;
+		}
+	}
 
-			/* Resize evec* placeholders to have 'count' cols. */
-			evec.sz_cols = count;
-			evec2.sz_cols = count;
+	if (plan->pi + 1 >= q) {
+		/* A sweep with no rotation leaves nothing more to do. */
+		plan->done++;
+		plan->converged = !plan->rotated;
+		plan->pi = 0;
+		plan->pj = 1;
+		plan->rotated = false;
+	}
 
-			/* Get all the eigenvectors for each eigenvalue and set
-			 * them as the columns of 'evec'. */
-			for (size_t h = 0; h < m->sz_rows; h++) {
-				zsl_mtx_get(&mi, h, h, &x);
-				if ((x >= 0.0 && x < epsilon) ||
-				    (x <= 0.0 && x > -epsilon)) {
-					zsl_mtx_set(&mi, h, h, -1);
-					zsl_mtx_get_col(&mi, h, f.data);
-					zsl_vec_neg(&f);
-					zsl_mtx_set_col(&evec, ga, f.data);
-					ga++;
-				}
-			}
-			/* Orthonormalize the set of eigenvectors for each
-			 * eigenvalue using the Gram-Schmidt process. */
-			zsl_mtx_gram_schmidt(&evec, &evec2);
-			zsl_mtx_cols_norm(&evec2, &evec);
+	return n;
+}
 
-			/* Place these eigenvectors in the 'mev2' matrix,
-			 * that will hold all the eigenvectors for different
-			 * eigenvalues. */
-			for (size_t gi = 0; gi < count; gi++) {
-				zsl_mtx_get_col(&evec, gi, f.data);
-				zsl_mtx_set_col(&mev2, b, f.data);
-				b++;
-			}
+/* The status of the run started on 'plan', as zsl_mtx_plan_step returns. */
+static int
+zsl_mtx_plan_status(const struct zsl_mtx_plan *plan)
+{
+	if (plan->converged) {
+		return 0;
+	}
+
+	return (plan->done >= plan->iter) ? -ENOCONVERGE : -EAGAIN;
+}
+
+int
+zsl_mtx_plan_step(struct zsl_mtx_plan *plan, size_t budget, size_t *used)
+{
+	size_t n = 0;
+
+	if (!plan->started) {
+		return -EINVAL;
+	}
 
+	if (!plan->converged && (plan->done < plan->iter)) {
+		if (budget > plan->iter - plan->done) {
+			budget = plan->iter - plan->done;
+		}
+		if (plan->type == ZSL_MTX_PLAN_EIGENVALUES) {
+			plan->converged = zsl_mtx_schur_run(&plan->w, NULL,
+							    budget,
+							    &plan->stall, &n);
+			plan->done += n;
 		} else {
-			/* Orthonormal is false. */
-			/* Get the eigenvectors for every eigenvalue and place
-			 * them in 'mev2'. */
-			for (size_t h = 0; h < m->sz_rows; h++) {
-				zsl_mtx_get(&mi, h, h, &x);
-				if ((x >= 0.0 && x < epsilon) ||
-				    (x <= 0.0 && x > -epsilon)) {
-					zsl_mtx_set(&mi, h, h, -1);
-					zsl_mtx_get_col(&mi, h, f.data);
-					zsl_vec_neg(&f);
-					zsl_mtx_set_col(&mev2, b, f.data);
-					b++;
-				}
+			/* Finish a sweep left part way by
+			 * zsl_mtx_plan_rotate as the first of 'budget'. */
+			for (; n < budget && !plan->converged; n++) {
+				zsl_mtx_plan_pairs(plan, SIZE_MAX);
 			}
 		}
 	}
 
-	/* Since 'b' is the number of eigenvectors, reduce 'mev' (of size
-	 * m->sz_rows times b) to erase columns of zeros. */
-	mev->sz_cols = b;
+	if (used != NULL) {
+		*used = n;
+	}
 
-	for (size_t s = 0; s < b; s++) {
-		zsl_mtx_get_col(&mev2, s, f.data);
-		zsl_mtx_set_col(mev, s, f.data);
+	return zsl_mtx_plan_status(plan);
+}
+
+int
+zsl_mtx_plan_rotate(struct zsl_mtx_plan *plan, size_t budget, size_t *used)
+{
+	size_t n = 0;
+
+	if (!plan->started || (plan->type == ZSL_MTX_PLAN_EIGENVALUES)) {
+		return -EINVAL;
 	}
 
-	/* Checks if the number of eigenvectors is the same as the shape of
-	 * the input matrix. If the number of eigenvectors is less than
-	 * the number of columns in the input matrix 'm', this will be
-	 * indicated by EEIGENSIZE as a return code. */
-	if (b != m->sz_cols) {
-		return -EEIGENSIZE;
+	while (!plan->converged && (plan->done < plan->iter) && (n < budget)) {
+		n += zsl_mtx_plan_pairs(plan, budget - n);
 	}
 
-	return 0;
+	if (used != NULL) {
+		*used = n;
+	}
+
+	return zsl_mtx_plan_status(plan);
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
-	    struct zsl_mtx *v, size_t iter)
+zsl_mtx_plan_svd(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+		 struct zsl_mtx *u, struct zsl_mtx *e, struct zsl_mtx *v)
 {
-	ZSL_MATRIX_DEF(aat, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(upri, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(ata, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(at, m->sz_cols, m->sz_rows);
-	ZSL_VECTOR_DEF(ui, m->sz_rows);
-	ZSL_MATRIX_DEF(ui2, m->sz_cols, 1);
-	ZSL_MATRIX_DEF(ui3, m->sz_rows, 1);
-	ZSL_VECTOR_DEF(hu, m->sz_rows);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the plan and the matrices match. */
+	if ((plan->type != ZSL_MTX_PLAN_SVD) || !zsl_mtx_plan_fits(plan, m) ||
+	    (u->sz_rows != plan->sz_rows) || (u->sz_cols != plan->sz_rows) ||
+	    (e->sz_rows != plan->sz_rows) || (e->sz_cols != plan->sz_cols) ||
+	    (v->sz_rows != plan->sz_cols) || (v->sz_cols != plan->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
 
-	zsl_real_t d;
-	size_t pu = 0;
-	size_t min = m->sz_cols;
-	zsl_real_t epsilon = 1E-6;
+	if (m != NULL) {
+		plan->started = false;
+		zsl_mtx_svd_run(m, u, e, v, plan->iter, &plan->w, plan->t1,
+				plan->t2);
+		return 0;
+	}
 
-	zsl_mtx_trans(m, &at);
+	if (!plan->started) {
+		return -EINVAL;
+	}
 
-	/* Calculate 'm' times 'm' transposed and viceversa. */
-	zsl_mtx_mult(m, &at, &aat);
-	zsl_mtx_mult(&at, m, &ata);
+	/* Sorting the state in place leaves a run that can be continued. The
+	 * rotations give 'u' for wide inputs, and 'v' otherwise. */
+	zsl_mtx_svd_sort(&plan->w, &plan->vq, plan->t1);
+	zsl_mtx_copy((plan->sz_rows < plan->sz_cols) ? u : v, &plan->vq);
+	zsl_mtx_svd_form(u, e, v, &plan->w, plan->t1, plan->t2);
 
-	/* Set the value 'min' as the minimum of number of columns and number
-	 * of rows. */
-	if (m->sz_rows <= m->sz_cols) {
-		min = m->sz_rows;
-	}
+	return 0;
+}
 
-	/* Calculate the eigenvalues of the square matrix 'm' times 'm'
-	 * transposed or the square matrix 'm' transposed times 'm', whichever
-	 * is smaller in dimensions. */
-	ZSL_VECTOR_DEF(ev, min);
-	if (min < m->sz_cols) {
-		zsl_mtx_eigenvalues(&aat, &ev, iter);
-	} else {
-		zsl_mtx_eigenvalues(&ata, &ev, iter);
+int
+zsl_mtx_plan_svd_vals(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+		      struct zsl_vec *s)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the plan, 'm' and 's' match. */
+	if ((plan->type != ZSL_MTX_PLAN_SVD_VALS) ||
+	    !zsl_mtx_plan_fits(plan, m) || (s->sz != plan->w.sz_cols)) {
+		return -EINVAL;
 	}
+#endif
 
-	/* Place the square root of these eigenvalues in the diagonal entries
-	 * of 'e', the sigma matrix. */
-	zsl_mtx_init(e, NULL);
-	for (size_t g = 0; g < min; g++) {
-		zsl_mtx_set(e, g, g, ZSL_SQRT(ev.data[g]));
-	}
-
-	/* Calculate the eigenvectors of 'm' times 'm' transposed and set them
-	 * as the columns of the 'v' matrix. */
-	zsl_mtx_eigenvectors(&ata, v, iter, true);
-	for (size_t i = 0; i < min; i++) {
-		zsl_mtx_get_col(v, i, ui.data);
-		zsl_mtx_from_arr(&ui2, ui.data);
-		zsl_mtx_get(e, i, i, &d);
-
-		/* Calculate the column vectors of 'u' by dividing these
-		 * eniegnvectors by the square root its eigenvalue and
-		 * multiplying them by the input matrix. */
-		zsl_mtx_mult(m, &ui2, &ui3);
-		if ((d >= 0.0 && d < epsilon) || (d <= 0.0 && d > -epsilon)) {
-			pu++;
-		} else {
-			zsl_mtx_scalar_mult_d(&ui3, (1 / d));
-			zsl_vec_from_arr(&ui, ui3.data);
-			zsl_mtx_set_col(u, i, ui.data);
-		}
+	if (m != NULL) {
+		plan->started = false;
+		zsl_mtx_svd_load(m, &plan->w);
+		zsl_mtx_svd_jacobi(&plan->w, NULL, s->data, plan->iter);
+		return 0;
 	}
 
-	/* Expand the columns of 'u' into an orthonormal basis if there are
-	 * zero eigenvalues or if the number of columns in 'm' is less than the
-	 * number of rows. */
-	zsl_mtx_eigenvectors(&aat, &upri, iter, true);
-	for (size_t f = min - pu; f < m->sz_rows; f++) {
-		zsl_mtx_get_col(&upri, f, hu.data);
-		zsl_mtx_set_col(u, f, hu.data);
+	if (!plan->started) {
+		return -EINVAL;
 	}
 
+	zsl_mtx_svd_sort(&plan->w, NULL, s->data);
+
 	return 0;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter)
+zsl_mtx_plan_pinv(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+		  struct zsl_mtx *pinv)
 {
-	zsl_real_t x;
-	size_t min = m->sz_cols;
-	zsl_real_t epsilon = 1E-6;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the plan matches, and 'pinv' has the transposed shape of
+	 * 'm'. */
+	if ((plan->type != ZSL_MTX_PLAN_PINV) || !zsl_mtx_plan_fits(plan, m) ||
+	    (pinv->sz_rows != plan->sz_cols) ||
+	    (pinv->sz_cols != plan->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
 
-	ZSL_MATRIX_DEF(u, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(e, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(v, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(et, m->sz_cols, m->sz_rows);
-	ZSL_MATRIX_DEF(ut, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(pas, m->sz_cols, m->sz_rows);
+	if (m != NULL) {
+		plan->started = false;
+		zsl_mtx_pinv_run(m, pinv, plan->iter, &plan->w, &plan->vq,
+				 plan->t1);
+		return 0;
+	}
 
-	/* Determine the SVD decomposition of 'm'. */
-	zsl_mtx_svd(m, &u, &e, &v, iter);
+	if (!plan->started) {
+		return -EINVAL;
+	}
 
-	/* Transpose the 'u' matrix. */
-	zsl_mtx_trans(&u, &ut);
+	zsl_mtx_svd_sort(&plan->w, &plan->vq, plan->t1);
+	zsl_mtx_pinv_form(pinv, &plan->w, &plan->vq, plan->t1);
 
-	/* Set the value 'min' as the minimum of number of columns and number
-	 * of rows. */
-	if (m->sz_rows <= m->sz_cols) {
-		min = m->sz_rows;
-	}
+	return 0;
+}
 
-	for (size_t g = 0; g < min; g++) {
+int
+zsl_mtx_plan_eigenvalues(struct zsl_mtx_plan *plan, const struct zsl_mtx *m,
+			 struct zsl_vec *v)
+{
+	int rc;
 
-		/* Invert the diagonal values in 'e'. If a value is zero, do
-		 * nothing to it. */
-		zsl_mtx_get(&e, g, g, &x);
-		if ((x < epsilon) || (x > -epsilon)) {
-			x = 1 / x;
-			zsl_mtx_set(&e, g, g, x);
-		}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the plan and 'm' match. */
+	if ((plan->type != ZSL_MTX_PLAN_EIGENVALUES) ||
+	    !zsl_mtx_plan_fits(plan, m)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (m != NULL) {
+		plan->started = false;
+		return zsl_mtx_eigenvalues_run(m, v, plan->iter, NULL,
+					       &plan->w, plan->t1);
 	}
 
-	/* Transpose the sigma matrix. */
-	zsl_mtx_trans(&e, &et);
+	if (!plan->started) {
+		return -EINVAL;
+	}
 
-	/* Multiply 'u' (transposed) times sigma (transposed and with inverted
-	 * eigenvalues) times 'v'. */
-	zsl_mtx_mult(&v, &et, &pas);
-	zsl_mtx_mult(&pas, &ut, pinv);
+	rc = zsl_mtx_eigenvalues_extract(&plan->w, v, plan->sym);
 
-	return 0;
+	return plan->converged ? rc : -ENOCONVERGE;
 }
 #endif
 
 int
-zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x)
+zsl_mtx_min(const struct zsl_mtx *m, zsl_real_t *x)
 {
 	zsl_real_t min = m->data[0];
 
@@ -1696,7 +6366,7 @@ zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x)
 }
 
 int
-zsl_mtx_max(struct zsl_mtx *m, zsl_real_t *x)
+zsl_mtx_max(const struct zsl_mtx *m, zsl_real_t *x)
 {
 	zsl_real_t max = m->data[0];
 
@@ -1712,7 +6382,7 @@ zsl_mtx_max(struct zsl_mtx *m, zsl_real_t *x)
 }
 
 int
-zsl_mtx_min_idx(struct zsl_mtx *m, size_t *i, size_t *j)
+zsl_mtx_min_idx(const struct zsl_mtx *m, size_t *i, size_t *j)
 {
 	zsl_real_t min = m->data[0];
 
@@ -1733,7 +6403,7 @@ zsl_mtx_min_idx(struct zsl_mtx *m, size_t *i, size_t *j)
 }
 
 int
-zsl_mtx_max_idx(struct zsl_mtx *m, size_t *i, size_t *j)
+zsl_mtx_max_idx(const struct zsl_mtx *m, size_t *i, size_t *j)
 {
 	zsl_real_t max = m->data[0];
 
@@ -1754,47 +6424,117 @@ zsl_mtx_max_idx(struct zsl_mtx *m, size_t *i, size_t *j)
 }
 
 bool
-zsl_mtx_is_equal(struct zsl_mtx *ma, struct zsl_mtx *mb)
+zsl_mtx_is_equal(const struct zsl_mtx *ma, const struct zsl_mtx *mb)
 {
-	int res;
+	const size_t n = ma->sz_rows * ma->sz_cols;
+	size_t i = 0;
+	size_t end;
+	int bad;
 
 	/* Make sure shape is the same. */
 	if ((ma->sz_rows != mb->sz_rows) || (ma->sz_cols != mb->sz_cols)) {
 		return false;
 	}
 
-	res = memcmp(ma->data, mb->data,
-		     sizeof(zsl_real_t) * (ma->sz_rows + ma->sz_cols));
+	/* Values are compared rather than bytes, so 0.0 and -0.0 are equal. */
+	while (i < n) {
+		end = (n - i > ZSL_MTX_CMP_BLOCK) ? i + ZSL_MTX_CMP_BLOCK : n;
+		bad = 0;
+		for (; i < end; i++) {
+			bad |= (ma->data[i] != mb->data[i]);
+		}
+		if (bad) {
+			return false;
+		}
+	}
 
-	return res == 0 ? true : false;
+	return true;
 }
 
 bool
-zsl_mtx_is_notneg(struct zsl_mtx *m)
+zsl_mtx_is_notneg(const struct zsl_mtx *m)
 {
-	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
-		if (m->data[i] < 0.0) {
-			return false;
+	struct zsl_vec v = {
+		.sz = m->sz_rows * m->sz_cols,
+		.data = m->data
+	};
+
+	return zsl_vec_is_nonneg(&v);
+}
+
+bool
+zsl_mtx_is_sym(const struct zsl_mtx *m)
+{
+	const size_t n = m->sz_rows;
+	const size_t t = ZSL_MTX_SYM_TILE;
+	const zsl_real_t *a = m->data;
+	zsl_real_t diff;
+	size_t ie, je;
+	int bad;
+
+	if (m->sz_rows != m->sz_cols) {
+		return false;
+	}
+
+	/* Compare each tile on or above the diagonal with its mirror. */
+	for (size_t bi = 0; bi < n; bi += t) {
+		ie = (n - bi > t) ? bi + t : n;
+		for (size_t bj = bi; bj < n; bj += t) {
+			je = (n - bj > t) ? bj + t : n;
+			bad = 0;
+			for (size_t i = bi; i < ie; i++) {
+				for (size_t j = (bi == bj) ? i + 1 : bj;
+				     j < je; j++) {
+					diff = a[i * n + j] - a[j * n + i];
+					bad |= (diff >= ZSL_MTX_SYM_EPS) |
+					       (diff <= -ZSL_MTX_SYM_EPS);
+				}
+			}
+			if (bad) {
+				return false;
+			}
 		}
 	}
 
 	return true;
 }
 
-bool
-zsl_mtx_is_sym(struct zsl_mtx *m)
+/* Returns ZSL_MTX_PROP_UPPER and ZSL_MTX_PROP_LOWER for square 'm' if the
+ * entries below or above the diagonal are all exactly zero. */
+static uint32_t
+zsl_mtx_props_tri(const struct zsl_mtx *m)
 {
-	zsl_real_t x;
-	zsl_real_t y;
+	const size_t n = m->sz_rows;
+	int below = 0;
+	int above = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			below |= (m->data[i * n + j] != 0.0);
+		}
+		for (size_t j = i + 1; j < n; j++) {
+			above |= (m->data[i * n + j] != 0.0);
+		}
+	}
+
+	return (below ? 0 : ZSL_MTX_PROP_UPPER) |
+	       (above ? 0 : ZSL_MTX_PROP_LOWER);
+}
+
+/* Returns true if 'm' is the identity matrix, to within ZSL_MTX_PROP_EPS. */
+static bool
+zsl_mtx_props_is_ident(const struct zsl_mtx *m)
+{
+	const zsl_real_t eps = ZSL_MTX_PROP_EPS;
 	zsl_real_t diff;
-	zsl_real_t epsilon = 1E-6;
 
 	for (size_t i = 0; i < m->sz_rows; i++) {
 		for (size_t j = 0; j < m->sz_cols; j++) {
-			zsl_mtx_get(m, i, j, &x);
-			zsl_mtx_get(m, j, i, &y);
-			diff = x - y;
-			if (diff >= epsilon || diff <= -epsilon) {
+			diff = m->data[i * m->sz_cols + j];
+			if (i == j) {
+				diff -= 1.0;
+			}
+			if (diff >= eps || diff <= -eps) {
 				return false;
 			}
 		}
@@ -1804,7 +6544,223 @@ zsl_mtx_is_sym(struct zsl_mtx *m)
 }
 
 int
-zsl_mtx_print(struct zsl_mtx *m)
+zsl_mtx_props(const struct zsl_mtx *m, uint32_t *props)
+{
+	int rc = 0;
+	struct zsl_mtx t;
+
+	*props = 0;
+	if (m->sz_rows != m->sz_cols) {
+		return 0;
+	}
+
+	*props |= zsl_mtx_props_tri(m);
+	if (zsl_mtx_is_sym(m)) {
+		*props |= ZSL_MTX_PROP_SYM;
+	}
+
+	ZSL_SCRATCH_DEF(ws, m->sz_rows * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &t, m->sz_rows, m->sz_cols);
+	if (rc) {
+		goto err;
+	}
+
+	/* 'm' is orthogonal if m^T * m is the identity. */
+	zsl_mtx_mult_ex(m, true, m, false, 1.0, 0.0, &t);
+	if (zsl_mtx_props_is_ident(&t)) {
+		*props |= ZSL_MTX_PROP_ORTHO;
+	}
+
+	/* A symmetric matrix is positive-definite if it has a Cholesky
+	 * factor. */
+	if ((*props & ZSL_MTX_PROP_SYM) && (zsl_mtx_cholesky(m, &t) == 0)) {
+		*props |= ZSL_MTX_PROP_POSDEF;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_mult_props(const struct zsl_mtx *ma, uint32_t pa,
+		   const struct zsl_mtx *mb, uint32_t pb, struct zsl_mtx *mc)
+{
+	const size_t n = ma->sz_cols;
+	const size_t p = mb->sz_cols;
+	size_t k0, k1, j0, j1;
+	zsl_real_t a;
+	zsl_real_t *c;
+
+	/* Without known zeros in either input, use the blocked kernel. */
+	if (((pa | pb) & ZSL_MTX_PROP_DIAG) == 0) {
+		return zsl_mtx_mult(ma, mb, mc);
+	}
+
+	if ((ma->sz_cols != mb->sz_rows) || (mc->sz_rows != ma->sz_rows) ||
+	    (mc->sz_cols != p)) {
+		return -EINVAL;
+	}
+	if (((pa & ZSL_MTX_PROP_DIAG) && (ma->sz_rows != n)) ||
+	    ((pb & ZSL_MTX_PROP_DIAG) && (mb->sz_rows != p))) {
+		return -EINVAL;
+	}
+
+	/* Row i of 'mc' accumulates rows k of 'mb', scaled by a[i][k], over
+	 * the non-zero parts of row i of 'ma' and of each row of 'mb'. */
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		c = &mc->data[i * p];
+		for (size_t j = 0; j < p; j++) {
+			c[j] = 0.0;
+		}
+
+		k0 = (pa & ZSL_MTX_PROP_UPPER) ? i : 0;
+		k1 = (pa & ZSL_MTX_PROP_LOWER) ? i + 1 : n;
+		for (size_t k = k0; k < k1; k++) {
+			a = ma->data[i * n + k];
+			j0 = (pb & ZSL_MTX_PROP_UPPER) ? k : 0;
+			j1 = (pb & ZSL_MTX_PROP_LOWER) ? k + 1 : p;
+			for (size_t j = j0; j < j1; j++) {
+				c[j] += a * mb->data[k * p + j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Solves m * x = b for positive-definite 'm', with its Cholesky factor in
+ * scratch memory. */
+static int
+zsl_mtx_props_chol(const struct zsl_mtx *m, struct zsl_mtx *b,
+		   struct zsl_mtx *x)
+{
+	int rc;
+	struct zsl_mtx l;
+
+	ZSL_SCRATCH_DEF(ws, m->sz_rows * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_mtx_alloc(ws, &l, m->sz_rows, m->sz_cols);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_mtx_cholesky(m, &l);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_mtx_chol_solve(&l, b, x);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_mtx_inv_props(const struct zsl_mtx *m, uint32_t props,
+		  struct zsl_mtx *mi)
+{
+	const size_t n = m->sz_rows;
+	zsl_real_t d;
+
+	if ((m->sz_cols != n) || (mi->sz_rows != n) || (mi->sz_cols != n)) {
+		return -EINVAL;
+	}
+
+	if ((props & ZSL_MTX_PROP_DIAG) == ZSL_MTX_PROP_DIAG) {
+		zsl_mtx_init(mi, zsl_mtx_entry_fn_empty);
+		for (size_t i = 0; i < n; i++) {
+			d = m->data[i * n + i];
+			if (d == 0.0) {
+				return -ESINGULAR;
+			}
+			mi->data[i * n + i] = 1.0 / d;
+		}
+		return 0;
+	}
+
+	if (props & ZSL_MTX_PROP_ORTHO) {
+		return zsl_mtx_trans(m, mi);
+	}
+
+	/* Triangular and positive-definite matrices solve m * mi = I. */
+	if (props & (ZSL_MTX_PROP_UPPER | ZSL_MTX_PROP_LOWER |
+		     ZSL_MTX_PROP_POSDEF)) {
+		zsl_mtx_init(mi, zsl_mtx_entry_fn_identity);
+		return zsl_mtx_solve_props(m, props, mi, mi);
+	}
+
+	return zsl_mtx_inv(m, mi);
+}
+
+int
+zsl_mtx_solve_props(const struct zsl_mtx *a, uint32_t props,
+		    struct zsl_mtx *b, struct zsl_mtx *x)
+{
+	int rc;
+	const size_t n = a->sz_rows;
+	zsl_real_t d;
+	struct zsl_mtx t;
+
+	if ((a->sz_cols != n) || (b->sz_rows != n) || (x->sz_rows != n) ||
+	    (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+
+	if ((props & ZSL_MTX_PROP_DIAG) == ZSL_MTX_PROP_DIAG) {
+		for (size_t i = 0; i < n; i++) {
+			d = a->data[i * n + i];
+			if (d == 0.0) {
+				return -ESINGULAR;
+			}
+			for (size_t j = 0; j < b->sz_cols; j++) {
+				x->data[i * x->sz_cols + j] =
+					b->data[i * b->sz_cols + j] / d;
+			}
+		}
+		return 0;
+	}
+
+	if (props & ZSL_MTX_PROP_UPPER) {
+		return zsl_mtx_trsm(a, b, x, false);
+	}
+	if (props & ZSL_MTX_PROP_LOWER) {
+		return zsl_mtx_trsm(a, b, x, true);
+	}
+
+	if (props & ZSL_MTX_PROP_ORTHO) {
+		/* x = a^T * b, which needs a copy of 'b' to work in place. */
+		if (x->data != b->data) {
+			return zsl_mtx_mult_ex(a, true, b, false, 1.0, 0.0, x);
+		}
+
+		ZSL_SCRATCH_DEF(ws, b->sz_rows * b->sz_cols);
+		size_t mark = zsl_ws_mark(ws);
+
+		rc = zsl_ws_mtx_alloc(ws, &t, b->sz_rows, b->sz_cols);
+		if (rc == 0) {
+			zsl_mtx_copy(&t, b);
+			rc = zsl_mtx_mult_ex(a, true, &t, false, 1.0, 0.0, x);
+		}
+
+		zsl_ws_release(ws, mark);
+		ZSL_SCRATCH_PUT(ws);
+		return rc;
+	}
+
+	if (props & ZSL_MTX_PROP_POSDEF) {
+		return zsl_mtx_props_chol(a, b, x);
+	}
+
+	return zsl_mtx_solve(a, b, x);
+}
+
+int
+zsl_mtx_print(const struct zsl_mtx *m)
 {
 	int rc;
 	zsl_real_t x;
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/batch.h>
+
+int
+zsl_mes_batch_init(struct zsl_measurement *mes, zsl_real_t *buf, size_t sz,
+		   size_t chans, uint8_t samples)
+{
+	size_t len;
+
+	if ((chans == 0) || (samples > 15) ||
+	    (chans > (UINT16_MAX / sizeof(zsl_real_t)) >> samples)) {
+		return -EINVAL;
+	}
+
+	len = (chans * sizeof(zsl_real_t)) << samples;
+	if (len > sz) {
+		return -ENOMEM;
+	}
+
+	memset(buf, 0, len);
+	mes->header.unit.ctype = ZSL_MES_BATCH_CTYPE;
+	mes->header.srclen.len = (uint16_t)len;
+	mes->header.srclen.samples = samples;
+	mes->header.srclen.fragment = ZSL_MES_FRAGMENT_NONE;
+	mes->payload = buf;
+
+	return 0;
+}
+
+size_t
+zsl_mes_batch_chans(const struct zsl_measurement *mes)
+{
+	size_t s = sizeof(zsl_real_t) << mes->header.srclen.samples;
+
+	if ((mes->header.unit.ctype != ZSL_MES_BATCH_CTYPE) ||
+	    (mes->header.srclen.len % s)) {
+		return 0;
+	}
+
+	return mes->header.srclen.len / s;
+}
+
+int
+zsl_mes_batch_vec(const struct zsl_measurement *mes, size_t ch,
+		  struct zsl_vec *v)
+{
+	size_t n = (size_t)1 << mes->header.srclen.samples;
+
+	if (ch >= zsl_mes_batch_chans(mes)) {
+		return -EINVAL;
+	}
+
+	v->sz = n;
+	v->data = (zsl_real_t *)mes->payload + ch * n;
+
+	return 0;
+}
+
+int
+zsl_mes_batch_mtx(const struct zsl_measurement *mes, struct zsl_mtx *m)
+{
+	size_t c = zsl_mes_batch_chans(mes);
+
+	if (c == 0) {
+		return -EINVAL;
+	}
+
+	m->sz_rows = c;
+	m->sz_cols = (size_t)1 << mes->header.srclen.samples;
+	m->data = mes->payload;
+
+	return 0;
+}
+
+int
+zsl_mes_batch_put(struct zsl_measurement *mes, size_t s,
+		  const struct zsl_vec *v)
+{
+	size_t n = (size_t)1 << mes->header.srclen.samples;
+	zsl_real_t *p = (zsl_real_t *)mes->payload + s;
+
+	if ((s >= n) || (v->sz != zsl_mes_batch_chans(mes)) || (v->sz == 0)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		p[i * n] = v->data[i];
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_batch_get(const struct zsl_measurement *mes, size_t s,
+		  struct zsl_vec *v)
+{
+	size_t n = (size_t)1 << mes->header.srclen.samples;
+	const zsl_real_t *p = (const zsl_real_t *)mes->payload + s;
+
+	if ((s >= n) || (v->sz != zsl_mes_batch_chans(mes)) || (v->sz == 0)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = p[i * n];
+	}
+
+	return 0;
+}
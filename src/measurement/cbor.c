@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/cbor.h>
+
+/* CBOR major types. */
+#define ZSL_MES_CBOR_UINT       (0)
+#define ZSL_MES_CBOR_NINT       (1)
+#define ZSL_MES_CBOR_ARRAY      (4)
+#define ZSL_MES_CBOR_SIMPLE     (7)
+
+/* Additional information values of the simple/float major type. */
+#define ZSL_MES_CBOR_FALSE      (20)
+#define ZSL_MES_CBOR_TRUE       (21)
+#define ZSL_MES_CBOR_F16        (25)
+#define ZSL_MES_CBOR_F32        (26)
+#define ZSL_MES_CBOR_F64        (27)
+
+/* How the samples of a C type are represented. */
+enum zsl_mes_cbor_kind {
+	ZSL_MES_CBOR_KIND_UINT,
+	ZSL_MES_CBOR_KIND_INT,
+	ZSL_MES_CBOR_KIND_FLOAT,
+	ZSL_MES_CBOR_KIND_BOOL,
+};
+
+union zsl_mes_cbor_val {
+	int8_t s8;
+	int16_t s16;
+	int32_t s32;
+	int64_t s64;
+	uint8_t u8;
+	uint16_t u16;
+	uint32_t u32;
+	uint64_t u64;
+	float f32;
+	double f64;
+	bool b;
+};
+
+/* Returns the sample size of a C type in bytes, or 0 if unsupported. */
+static size_t
+zsl_mes_cbor_ctype(uint8_t ctype, enum zsl_mes_cbor_kind *kind)
+{
+	switch (ctype) {
+	case ZSL_MES_UNIT_CTYPE_S8:
+	case ZSL_MES_UNIT_CTYPE_S16:
+	case ZSL_MES_UNIT_CTYPE_S32:
+	case ZSL_MES_UNIT_CTYPE_S64:
+		*kind = ZSL_MES_CBOR_KIND_INT;
+		return (size_t)1 << (ctype - ZSL_MES_UNIT_CTYPE_S8);
+	case ZSL_MES_UNIT_CTYPE_U8:
+	case ZSL_MES_UNIT_CTYPE_U16:
+	case ZSL_MES_UNIT_CTYPE_U32:
+	case ZSL_MES_UNIT_CTYPE_U64:
+		*kind = ZSL_MES_CBOR_KIND_UINT;
+		return (size_t)1 << (ctype - ZSL_MES_UNIT_CTYPE_U8);
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_32:
+		*kind = ZSL_MES_CBOR_KIND_FLOAT;
+		return sizeof(float);
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_64:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_64:
+		*kind = ZSL_MES_CBOR_KIND_FLOAT;
+		return sizeof(double);
+	case ZSL_MES_UNIT_CTYPE_BOOL:
+		*kind = ZSL_MES_CBOR_KIND_BOOL;
+		return sizeof(bool);
+	default:
+		return 0;
+	}
+}
+
+/* Writes a head with major type 'mt', additional info 'ai' and 'n' bytes. */
+static int
+zsl_mes_cbor_put(struct zsl_mes_cbor *c, uint8_t mt, uint8_t ai, uint64_t v,
+		 size_t n)
+{
+	uint8_t *p;
+
+	if (c->sz - c->pos < n + 1) {
+		return -ENOMEM;
+	}
+
+	p = &c->buf[c->pos];
+	p[0] = (uint8_t)((mt << 5) | ai);
+	for (size_t i = 0; i < n; i++) {
+		p[n - i] = (uint8_t)(v >> (8 * i));
+	}
+	c->pos += n + 1;
+
+	return 0;
+}
+
+/* Writes the shortest head for the argument 'v'. */
+static int
+zsl_mes_cbor_put_head(struct zsl_mes_cbor *c, uint8_t mt, uint64_t v)
+{
+	if (v < 24) {
+		return zsl_mes_cbor_put(c, mt, (uint8_t)v, 0, 0);
+	} else if (v <= UINT8_MAX) {
+		return zsl_mes_cbor_put(c, mt, 24, v, 1);
+	} else if (v <= UINT16_MAX) {
+		return zsl_mes_cbor_put(c, mt, 25, v, 2);
+	} else if (v <= UINT32_MAX) {
+		return zsl_mes_cbor_put(c, mt, 26, v, 4);
+	}
+
+	return zsl_mes_cbor_put(c, mt, 27, v, 8);
+}
+
+static int
+zsl_mes_cbor_put_int(struct zsl_mes_cbor *c, int64_t v)
+{
+	if (v < 0) {
+		/* -1 - v, without overflowing for INT64_MIN. */
+		return zsl_mes_cbor_put_head(c, ZSL_MES_CBOR_NINT,
+					     ~(uint64_t)v);
+	}
+
+	return zsl_mes_cbor_put_head(c, ZSL_MES_CBOR_UINT, (uint64_t)v);
+}
+
+/* Reads a head, with the argument or the raw float bits in 'v'. */
+static int
+zsl_mes_cbor_get_head(struct zsl_mes_cbor *c, uint8_t *mt, uint8_t *ai,
+		      uint64_t *v)
+{
+	size_t n;
+
+	if (c->pos >= c->sz) {
+		return -EINVAL;
+	}
+
+	*mt = c->buf[c->pos] >> 5;
+	*ai = c->buf[c->pos] & 0x1F;
+	c->pos++;
+
+	if (*ai < 24) {
+		*v = *ai;
+		return 0;
+	} else if (*ai > 27) {
+		/* Reserved, or indefinite lengths, which aren't used here. */
+		return -EINVAL;
+	}
+
+	n = (size_t)1 << (*ai - 24);
+	if (c->sz - c->pos < n) {
+		return -EINVAL;
+	}
+	*v = 0;
+	for (size_t i = 0; i < n; i++) {
+		*v = (*v << 8) | c->buf[c->pos++];
+	}
+
+	return 0;
+}
+
+/* Converts IEEE 754 half-precision bits to a double. */
+static double
+zsl_mes_cbor_half(uint16_t h)
+{
+	int e = (h >> 10) & 0x1F;
+	int m = h & 0x3FF;
+	double v;
+
+	if (e == 0) {
+		v = ldexp(m, -24);
+	} else if (e != 31) {
+		v = ldexp(m + 1024, e - 25);
+	} else {
+		v = m ? NAN : INFINITY;
+	}
+
+	return (h & 0x8000) ? -v : v;
+}
+
+int
+zsl_mes_cbor_enc_start(struct zsl_mes_cbor *c,
+		       const struct zsl_mes_header *hdr, uint64_t ts,
+		       uint8_t *buf, size_t sz)
+{
+	int rc;
+	enum zsl_mes_cbor_kind kind;
+	bool has_ts = hdr->filter.flags.timestamp != ZSL_MES_TIMESTAMP_NONE;
+
+	if (zsl_mes_cbor_ctype(hdr->unit.ctype, &kind) == 0) {
+		return -EINVAL;
+	}
+
+	c->buf = buf;
+	c->sz = sz;
+	c->pos = 0;
+	c->left = (size_t)1 << hdr->srclen.samples;
+
+	rc = zsl_mes_cbor_put_head(c, ZSL_MES_CBOR_ARRAY, c->left + has_ts);
+	if ((rc == 0) && has_ts) {
+		rc = zsl_mes_cbor_put_head(c, ZSL_MES_CBOR_UINT, ts);
+	}
+
+	return rc;
+}
+
+int
+zsl_mes_cbor_enc_sample(struct zsl_mes_cbor *c,
+			const struct zsl_mes_header *hdr, const void *val)
+{
+	int rc;
+	union zsl_mes_cbor_val u;
+	enum zsl_mes_cbor_kind kind;
+	size_t n = zsl_mes_cbor_ctype(hdr->unit.ctype, &kind);
+
+	if ((n == 0) || (c->left == 0)) {
+		return -EINVAL;
+	}
+
+	memcpy(&u, val, n);
+
+	switch (kind) {
+	case ZSL_MES_CBOR_KIND_UINT:
+		rc = zsl_mes_cbor_put_head(c, ZSL_MES_CBOR_UINT,
+					   n == 1 ? u.u8 :
+					   n == 2 ? u.u16 :
+					   n == 4 ? u.u32 : u.u64);
+		break;
+	case ZSL_MES_CBOR_KIND_INT:
+		rc = zsl_mes_cbor_put_int(c, n == 1 ? u.s8 :
+					  n == 2 ? u.s16 :
+					  n == 4 ? u.s32 : u.s64);
+		break;
+	case ZSL_MES_CBOR_KIND_FLOAT:
+		if (n == sizeof(float)) {
+			rc = zsl_mes_cbor_put(c, ZSL_MES_CBOR_SIMPLE,
+					      ZSL_MES_CBOR_F32, u.u32, 4);
+		} else {
+			rc = zsl_mes_cbor_put(c, ZSL_MES_CBOR_SIMPLE,
+					      ZSL_MES_CBOR_F64, u.u64, 8);
+		}
+		break;
+	default:
+		rc = zsl_mes_cbor_put(c, ZSL_MES_CBOR_SIMPLE,
+				      u.b ? ZSL_MES_CBOR_TRUE :
+				      ZSL_MES_CBOR_FALSE, 0, 0);
+		break;
+	}
+
+	if (rc == 0) {
+		c->left--;
+	}
+
+	return rc;
+}
+
+int
+zsl_mes_cbor_enc_end(struct zsl_mes_cbor *c, struct zsl_mes_header *hdr)
+{
+	if ((c->left != 0) || (c->pos > UINT16_MAX)) {
+		return -EINVAL;
+	}
+
+	hdr->filter.flags.data_format = ZSL_MES_FORMAT_CBOR;
+	hdr->srclen.len = (uint16_t)c->pos;
+
+	return 0;
+}
+
+int
+zsl_mes_cbor_enc(const struct zsl_measurement *mes, uint64_t ts,
+		 uint8_t *buf, size_t sz, struct zsl_measurement *out)
+{
+	int rc;
+	struct zsl_mes_cbor c;
+	struct zsl_mes_header hdr = mes->header;
+	enum zsl_mes_cbor_kind kind;
+	size_t n = zsl_mes_cbor_ctype(hdr.unit.ctype, &kind);
+	const uint8_t *p = mes->payload;
+
+	rc = zsl_mes_cbor_enc_start(&c, &hdr, ts, buf, sz);
+	while ((rc == 0) && c.left) {
+		rc = zsl_mes_cbor_enc_sample(&c, &hdr, p);
+		p += n;
+	}
+	if (rc == 0) {
+		rc = zsl_mes_cbor_enc_end(&c, &hdr);
+	}
+	if (rc) {
+		return rc;
+	}
+
+	out->header = hdr;
+	out->payload = buf;
+
+	return 0;
+}
+
+int
+zsl_mes_cbor_dec_start(struct zsl_mes_cbor *c,
+		       const struct zsl_measurement *mes, uint64_t *ts)
+{
+	int rc;
+	uint8_t mt, ai;
+	uint64_t v;
+	enum zsl_mes_cbor_kind kind;
+	const struct zsl_mes_header *hdr = &mes->header;
+	bool has_ts = hdr->filter.flags.timestamp != ZSL_MES_TIMESTAMP_NONE;
+
+	if ((hdr->filter.flags.data_format != ZSL_MES_FORMAT_CBOR) ||
+	    (zsl_mes_cbor_ctype(hdr->unit.ctype, &kind) == 0)) {
+		return -EINVAL;
+	}
+
+	c->buf = mes->payload;
+	c->sz = hdr->srclen.len;
+	c->pos = 0;
+	c->left = (size_t)1 << hdr->srclen.samples;
+
+	rc = zsl_mes_cbor_get_head(c, &mt, &ai, &v);
+	if (rc || (mt != ZSL_MES_CBOR_ARRAY) || (v != c->left + has_ts)) {
+		return -EINVAL;
+	}
+
+	v = 0;
+	if (has_ts) {
+		rc = zsl_mes_cbor_get_head(c, &mt, &ai, &v);
+		if (rc || (mt != ZSL_MES_CBOR_UINT)) {
+			return -EINVAL;
+		}
+	}
+	if (ts != NULL) {
+		*ts = v;
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_cbor_dec_sample(struct zsl_mes_cbor *c,
+			const struct zsl_mes_header *hdr, void *val)
+{
+	uint8_t mt, ai;
+	uint64_t v, max;
+	double d;
+	union zsl_mes_cbor_val u;
+	enum zsl_mes_cbor_kind kind;
+	size_t n = zsl_mes_cbor_ctype(hdr->unit.ctype, &kind);
+
+	if ((n == 0) || (c->left == 0) ||
+	    zsl_mes_cbor_get_head(c, &mt, &ai, &v)) {
+		return -EINVAL;
+	}
+
+	switch (kind) {
+	case ZSL_MES_CBOR_KIND_UINT:
+		max = n == 8 ? UINT64_MAX : ((uint64_t)1 << (8 * n)) - 1;
+		if ((mt != ZSL_MES_CBOR_UINT) || (v > max)) {
+			return -EINVAL;
+		}
+		u.u64 = v;
+		if (n == 1) {
+			u.u8 = (uint8_t)v;
+		} else if (n == 2) {
+			u.u16 = (uint16_t)v;
+		} else if (n == 4) {
+			u.u32 = (uint32_t)v;
+		}
+		break;
+	case ZSL_MES_CBOR_KIND_INT:
+		/* Both signs have the same limit on the argument. */
+		max = ((uint64_t)1 << (8 * n - 1)) - 1;
+		if (((mt != ZSL_MES_CBOR_UINT) && (mt != ZSL_MES_CBOR_NINT)) ||
+		    (v > max)) {
+			return -EINVAL;
+		}
+		u.s64 = mt == ZSL_MES_CBOR_UINT ? (int64_t)v : -1 - (int64_t)v;
+		if (n == 1) {
+			u.s8 = (int8_t)u.s64;
+		} else if (n == 2) {
+			u.s16 = (int16_t)u.s64;
+		} else if (n == 4) {
+			u.s32 = (int32_t)u.s64;
+		}
+		break;
+	case ZSL_MES_CBOR_KIND_FLOAT:
+		if (mt == ZSL_MES_CBOR_UINT) {
+			d = (double)v;
+		} else if (mt == ZSL_MES_CBOR_NINT) {
+			d = -1.0 - (double)v;
+		} else if ((mt == ZSL_MES_CBOR_SIMPLE) &&
+			   (ai == ZSL_MES_CBOR_F16)) {
+			d = zsl_mes_cbor_half((uint16_t)v);
+		} else if ((mt == ZSL_MES_CBOR_SIMPLE) &&
+			   (ai == ZSL_MES_CBOR_F32)) {
+			u.u32 = (uint32_t)v;
+			d = u.f32;
+		} else if ((mt == ZSL_MES_CBOR_SIMPLE) &&
+			   (ai == ZSL_MES_CBOR_F64)) {
+			u.u64 = v;
+			d = u.f64;
+		} else {
+			return -EINVAL;
+		}
+		if (n == sizeof(float)) {
+			u.f32 = (float)d;
+		} else {
+			u.f64 = d;
+		}
+		break;
+	default:
+		if ((mt != ZSL_MES_CBOR_SIMPLE) ||
+		    ((ai != ZSL_MES_CBOR_FALSE) && (ai != ZSL_MES_CBOR_TRUE))) {
+			return -EINVAL;
+		}
+		u.b = ai == ZSL_MES_CBOR_TRUE;
+		break;
+	}
+
+	memcpy(val, &u, n);
+	c->left--;
+
+	return 0;
+}
+
+int
+zsl_mes_cbor_dec(const struct zsl_measurement *mes, uint64_t *ts,
+		 void *vals, size_t sz)
+{
+	int rc;
+	struct zsl_mes_cbor c;
+	enum zsl_mes_cbor_kind kind;
+	size_t n = zsl_mes_cbor_ctype(mes->header.unit.ctype, &kind);
+	uint8_t *p = vals;
+
+	rc = zsl_mes_cbor_dec_start(&c, mes, ts);
+	if (rc) {
+		return rc;
+	}
+	if (sz < c.left * n) {
+		return -ENOMEM;
+	}
+
+	while (c.left) {
+		rc = zsl_mes_cbor_dec_sample(&c, &mes->header, p);
+		if (rc) {
+			return rc;
+		}
+		p += n;
+	}
+
+	/* Nothing may follow the array. */
+	return c.pos == c.sz ? 0 : -EINVAL;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/conv.h>
+
+/* The SI prefix range, which covers nearly all conversions. */
+#define ZSL_MES_CONV_P10_MAX    (24)
+
+static const zsl_real_t zsl_mes_conv_p10[2 * ZSL_MES_CONV_P10_MAX + 1] = {
+	1E-24, 1E-23, 1E-22, 1E-21, 1E-20, 1E-19, 1E-18, 1E-17, 1E-16,
+	1E-15, 1E-14, 1E-13, 1E-12, 1E-11, 1E-10, 1E-9, 1E-8, 1E-7, 1E-6,
+	1E-5, 1E-4, 1E-3, 1E-2, 1E-1, 1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6,
+	1E7, 1E8, 1E9, 1E10, 1E11, 1E12, 1E13, 1E14, 1E15, 1E16, 1E17, 1E18,
+	1E19, 1E20, 1E21, 1E22, 1E23, 1E24
+};
+
+/* A unit defined as its base unit * 10^exp + off. */
+struct zsl_mes_conv_unit {
+	uint16_t unit;
+	uint16_t base;
+	int8_t exp;
+	zsl_real_t off;
+};
+
+static const struct zsl_mes_conv_unit zsl_mes_conv_units[] = {
+	{ ZSL_MES_UNIT_SI_DEGREE_CELSIUS, ZSL_MES_UNIT_SI_KELVIN, 0, 273.15 },
+	{ ZSL_MES_UNIT_SI_GRAMS, ZSL_MES_UNIT_SI_KILOGRAM, -3, 0.0 },
+	{ ZSL_MES_UNIT_SI_HECTOPASCAL, ZSL_MES_UNIT_SI_PASCAL, 2, 0.0 },
+	{ ZSL_MES_UNIT_SI_MICROTESLA, ZSL_MES_UNIT_SI_TESLA, -6, 0.0 },
+	{ ZSL_MES_UNIT_SI_MILLIVOLTS, ZSL_MES_UNIT_SI_VOLT, -3, 0.0 },
+	{ ZSL_MES_UNIT_SI_PERCENT, ZSL_MES_UNIT_SI_INTERVAL, -2, 0.0 },
+};
+
+zsl_real_t
+zsl_mes_conv_pow10(int n)
+{
+	if ((n >= -ZSL_MES_CONV_P10_MAX) && (n <= ZSL_MES_CONV_P10_MAX)) {
+		return zsl_mes_conv_p10[n + ZSL_MES_CONV_P10_MAX];
+	}
+
+	return ZSL_POW(10.0, n);
+}
+
+/* Gets the base unit of 'unit', and the exponent and offset to it. */
+static uint16_t
+zsl_mes_conv_base(uint16_t unit, int *exp, zsl_real_t *off)
+{
+	size_t count = sizeof(zsl_mes_conv_units) /
+		       sizeof(zsl_mes_conv_units[0]);
+
+	for (size_t i = 0; i < count; i++) {
+		if (zsl_mes_conv_units[i].unit == unit) {
+			*exp = zsl_mes_conv_units[i].exp;
+			*off = zsl_mes_conv_units[i].off;
+			return zsl_mes_conv_units[i].base;
+		}
+	}
+
+	*exp = 0;
+	*off = 0.0;
+
+	return unit;
+}
+
+int
+zsl_mes_conv_factor(uint16_t from, int8_t fscale, uint16_t to,
+		    int8_t tscale, zsl_real_t *mul, zsl_real_t *add)
+{
+	int fe, te;
+	zsl_real_t fo, to_off;
+
+	if (zsl_mes_conv_base(from, &fe, &fo) !=
+	    zsl_mes_conv_base(to, &te, &to_off)) {
+		return -EINVAL;
+	}
+	if (from == ZSL_MES_UNIT_SI_UNDEFINED) {
+		return -EINVAL;
+	}
+
+	/*
+	 * base = x * 10^(fscale + fe) + fo, and
+	 * y = (base - to_off) * 10^-(tscale + te).
+	 */
+	*mul = zsl_mes_conv_pow10(fscale + fe - tscale - te);
+	*add = fo == to_off ? 0.0 :
+	       (fo - to_off) * zsl_mes_conv_pow10(-tscale - te);
+
+	return 0;
+}
+
+/* Converts 'n' values of type 't' from 'in' to zsl_real_t in 'out'. */
+#define ZSL_MES_CONV_LOOP(t)						\
+	do {								\
+		t v;							\
+		for (size_t i = 0; i < n; i++) {			\
+			memcpy(&v, in + i * sizeof(t), sizeof(t));	\
+			out[i] = (zsl_real_t)v * mul + add;		\
+		}							\
+	} while (0)
+
+int
+zsl_mes_conv_vals(const struct zsl_measurement *mes, uint16_t to,
+		  int8_t tscale, zsl_real_t *out, size_t n, size_t *cnt)
+{
+	int rc;
+	zsl_real_t mul, add;
+	const uint8_t *in = mes->payload;
+	size_t sz = zsl_mes_ctype_size(mes->header.unit.ctype);
+
+	rc = zsl_mes_conv_factor(mes->header.unit.si_unit,
+				 mes->header.unit.scale_factor, to, tscale,
+				 &mul, &add);
+	if (rc) {
+		return rc;
+	}
+	if (sz == 0) {
+		return -EINVAL;
+	}
+	if (mes->header.srclen.len / sz > n) {
+		return -ENOMEM;
+	}
+	n = mes->header.srclen.len / sz;
+
+	/* One loop per type, so the type isn't checked for each value. */
+	switch (mes->header.unit.ctype) {
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_32:
+		ZSL_MES_CONV_LOOP(float);
+		break;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_64:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_64:
+		ZSL_MES_CONV_LOOP(double);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S8:
+		ZSL_MES_CONV_LOOP(int8_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S16:
+		ZSL_MES_CONV_LOOP(int16_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S32:
+		ZSL_MES_CONV_LOOP(int32_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S64:
+		ZSL_MES_CONV_LOOP(int64_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U8:
+		ZSL_MES_CONV_LOOP(uint8_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U16:
+		ZSL_MES_CONV_LOOP(uint16_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U32:
+		ZSL_MES_CONV_LOOP(uint32_t);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U64:
+		ZSL_MES_CONV_LOOP(uint64_t);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	*cnt = n;
+
+	return 0;
+}
+
+int
+zsl_mes_conv(struct zsl_measurement *mes, uint16_t to, int8_t tscale)
+{
+	int rc;
+	zsl_real_t mul, add;
+	size_t n;
+
+	switch (mes->header.unit.ctype) {
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	rc = zsl_mes_conv_factor(mes->header.unit.si_unit,
+				 mes->header.unit.scale_factor, to, tscale,
+				 &mul, &add);
+	if (rc) {
+		return rc;
+	}
+
+	n = mes->header.srclen.len /
+	    zsl_mes_ctype_size(mes->header.unit.ctype);
+	if (mes->header.unit.ctype == ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32) {
+		float *v = mes->payload;
+		for (size_t i = 0; i < n; i++) {
+			v[i] = (float)(v[i] * mul + add);
+		}
+	} else {
+		double *v = mes->payload;
+		for (size_t i = 0; i < n; i++) {
+			v[i] = v[i] * mul + add;
+		}
+	}
+
+	mes->header.unit.si_unit = to;
+	mes->header.unit.scale_factor = tscale;
+
+	return 0;
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/frag.h>
+
+int
+zsl_mes_frag_init(struct zsl_mes_frag *f, const struct zsl_measurement *mes,
+		  size_t mtu)
+{
+	size_t n = zsl_mes_ctype_size(mes->header.unit.ctype);
+	size_t chunk;
+
+	if (mes->header.srclen.fragment != ZSL_MES_FRAGMENT_NONE) {
+		return -EINVAL;
+	}
+
+	/* Whole samples per fragment, where the sample size is known. */
+	chunk = mtu > ZSL_MES_FRAG_OFF_LEN ? mtu - ZSL_MES_FRAG_OFF_LEN : 0;
+	if (chunk > UINT16_MAX) {
+		chunk = UINT16_MAX;
+	}
+	if (n > 1) {
+		chunk -= chunk % n;
+	}
+
+	/* A chunk of 0 sends the payload whole. */
+	if (mes->header.srclen.len <= mtu) {
+		chunk = 0;
+	} else if (chunk == 0) {
+		return -EINVAL;
+	}
+
+	f->hdr = mes->header;
+	f->data = mes->payload;
+	f->pos = 0;
+	f->chunk = (uint16_t)chunk;
+	f->done = false;
+
+	return 0;
+}
+
+int
+zsl_mes_frag_next(struct zsl_mes_frag *f, struct zsl_mes_header *hdr,
+		  struct zsl_mes_iov *iov)
+{
+	uint16_t len = f->hdr.srclen.len;
+	uint16_t n;
+
+	if (f->done) {
+		return -ENODATA;
+	}
+
+	*hdr = f->hdr;
+
+	if (f->chunk == 0) {
+		iov[0].base = f->off;
+		iov[0].len = 0;
+		iov[1].base = f->data;
+		iov[1].len = len;
+		f->done = true;
+		return 0;
+	}
+
+	n = len - f->pos < f->chunk ? len - f->pos : f->chunk;
+	f->off[0] = (uint8_t)f->pos;
+	f->off[1] = (uint8_t)(f->pos >> 8);
+	iov[0].base = f->off;
+	iov[0].len = ZSL_MES_FRAG_OFF_LEN;
+	iov[1].base = f->data + f->pos;
+	iov[1].len = n;
+
+	f->pos += n;
+	f->done = f->pos == len;
+	hdr->srclen.fragment = f->done ? ZSL_MES_FRAGMENT_FINAL :
+			       ZSL_MES_FRAGMENT_PARTIAL;
+	hdr->srclen.len = ZSL_MES_FRAG_OFF_LEN + n;
+
+	return 0;
+}
+
+/* Finds the slot of a source, or takes a free or the least recent one. */
+static struct zsl_mes_reasm_slot *
+zsl_mes_reasm_slot(struct zsl_mes_reasm *r, const struct zsl_mes_header *hdr)
+{
+	struct zsl_mes_reasm_slot *s = NULL;
+	struct zsl_mes_reasm_slot *t;
+
+	for (size_t i = 0; i < r->n; i++) {
+		t = &r->slots[i];
+		if (t->used &&
+		    (t->hdr.srclen.sourceid == hdr->srclen.sourceid)) {
+			s = t;
+			break;
+		}
+		if ((s == NULL) || (s->used && (!t->used || t->age < s->age))) {
+			s = t;
+		}
+	}
+
+	/* A new source, or a new measurement from the same source. */
+	if (!s->used || (s->hdr.srclen.sourceid != hdr->srclen.sourceid) ||
+	    (s->hdr.filter_bits != hdr->filter_bits) ||
+	    (s->hdr.unit_bits != hdr->unit_bits)) {
+		s->hdr = *hdr;
+		s->used = true;
+		s->final = false;
+		s->total = 0;
+		s->next = 0;
+		s->nruns = 0;
+	}
+	s->age = r->tick++;
+
+	return s;
+}
+
+static uint8_t *
+zsl_mes_reasm_buf(struct zsl_mes_reasm *r, struct zsl_mes_reasm_slot *s)
+{
+	return r->buf + (size_t)(s - r->slots) * r->sz;
+}
+
+/* Records that bytes 'a' to 'b' have been received. */
+static int
+zsl_mes_reasm_mark(struct zsl_mes_reasm_slot *s, uint16_t a, uint16_t b)
+{
+	size_t i;
+
+	if (b <= s->next) {
+		return 0;
+	}
+
+	if (a <= s->next) {
+		/* Extend the gap-free prefix, absorbing the runs it reaches. */
+		s->next = b;
+		i = 0;
+		while (i < s->nruns) {
+			if (s->runs[i][0] <= s->next) {
+				if (s->runs[i][1] > s->next) {
+					s->next = s->runs[i][1];
+				}
+				s->nruns--;
+				s->runs[i][0] = s->runs[s->nruns][0];
+				s->runs[i][1] = s->runs[s->nruns][1];
+				i = 0;
+			} else {
+				i++;
+			}
+		}
+		return 0;
+	}
+
+	/* Merge with any runs it touches, then store it as a run. */
+	i = 0;
+	while (i < s->nruns) {
+		if ((s->runs[i][0] <= b) && (a <= s->runs[i][1])) {
+			a = s->runs[i][0] < a ? s->runs[i][0] : a;
+			b = s->runs[i][1] > b ? s->runs[i][1] : b;
+			s->nruns--;
+			s->runs[i][0] = s->runs[s->nruns][0];
+			s->runs[i][1] = s->runs[s->nruns][1];
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+	if (s->nruns == ZSL_MES_REASM_RUNS) {
+		return -ENOMEM;
+	}
+	s->runs[s->nruns][0] = a;
+	s->runs[s->nruns][1] = b;
+	s->nruns++;
+
+	return 0;
+}
+
+uint8_t *
+zsl_mes_reasm_dst(struct zsl_mes_reasm *r,
+		  const struct zsl_mes_header *hdr, uint16_t off)
+{
+	struct zsl_mes_reasm_slot *s;
+
+	if ((size_t)off + hdr->srclen.len > r->sz) {
+		return NULL;
+	}
+
+	s = zsl_mes_reasm_slot(r, hdr);
+
+	return zsl_mes_reasm_buf(r, s) + off;
+}
+
+int
+zsl_mes_reasm_put(struct zsl_mes_reasm *r,
+		  const struct zsl_mes_header *hdr, uint16_t off,
+		  const void *data, struct zsl_measurement *out)
+{
+	int rc;
+	struct zsl_mes_reasm_slot *s;
+	uint8_t *dst;
+	size_t end = (size_t)off + hdr->srclen.len;
+
+	if ((hdr->srclen.fragment != ZSL_MES_FRAGMENT_PARTIAL) &&
+	    (hdr->srclen.fragment != ZSL_MES_FRAGMENT_FINAL)) {
+		return -EINVAL;
+	}
+	if ((end > r->sz) || (end > UINT16_MAX)) {
+		return -ENOMEM;
+	}
+
+	s = zsl_mes_reasm_slot(r, hdr);
+	if (s->final && (end > s->total)) {
+		return -EINVAL;
+	}
+	if (hdr->srclen.fragment == ZSL_MES_FRAGMENT_FINAL) {
+		if (end < s->next) {
+			return -EINVAL;
+		}
+		s->final = true;
+		s->total = (uint16_t)end;
+	}
+
+	/* Data that was received into place doesn't need to move. */
+	dst = zsl_mes_reasm_buf(r, s) + off;
+	if (dst != data) {
+		memcpy(dst, data, hdr->srclen.len);
+	}
+
+	rc = zsl_mes_reasm_mark(s, off, (uint16_t)end);
+	if (rc) {
+		return rc;
+	}
+
+	if (!s->final || (s->next < s->total)) {
+		return -EAGAIN;
+	}
+
+	out->header = s->hdr;
+	out->header.srclen.fragment = ZSL_MES_FRAGMENT_NONE;
+	out->header.srclen.len = s->total;
+	out->payload = zsl_mes_reasm_buf(r, s);
+	s->used = false;
+
+	return 0;
+}
+
+int
+zsl_mes_reasm_add(struct zsl_mes_reasm *r,
+		  const struct zsl_measurement *mes,
+		  struct zsl_measurement *out)
+{
+	struct zsl_mes_header hdr = mes->header;
+	const uint8_t *p = mes->payload;
+
+	if (hdr.srclen.fragment == ZSL_MES_FRAGMENT_NONE) {
+		*out = *mes;
+		return 0;
+	}
+	if (hdr.srclen.len < ZSL_MES_FRAG_OFF_LEN) {
+		return -EINVAL;
+	}
+
+	hdr.srclen.len -= ZSL_MES_FRAG_OFF_LEN;
+
+	return zsl_mes_reasm_put(r, &hdr, (uint16_t)(p[0] | (p[1] << 8)),
+				 p + ZSL_MES_FRAG_OFF_LEN, out);
+}
+
+void
+zsl_mes_reasm_drop(struct zsl_mes_reasm *r, uint8_t sourceid)
+{
+	for (size_t i = 0; i < r->n; i++) {
+		if (r->slots[i].used &&
+		    (r->slots[i].hdr.srclen.sourceid == sourceid)) {
+			r->slots[i].used = false;
+		}
+	}
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/log.h>
+
+/* Copies 'len' bytes into the ring at 'pos', wrapping around its end. */
+static void
+zsl_mes_log_put(struct zsl_mes_log *l, size_t pos, const void *data,
+		size_t len)
+{
+	size_t p = pos & (l->sz - 1);
+	size_t n = l->sz - p < len ? l->sz - p : len;
+
+	memcpy(l->buf + p, data, n);
+	memcpy(l->buf, (const uint8_t *)data + n, len - n);
+}
+
+/* Copies 'len' bytes out of the ring at 'pos'. */
+static void
+zsl_mes_log_get(const struct zsl_mes_log *l, size_t pos, void *data,
+		size_t len)
+{
+	size_t p = pos & (l->sz - 1);
+	size_t n = l->sz - p < len ? l->sz - p : len;
+
+	memcpy(data, l->buf + p, n);
+	memcpy((uint8_t *)data + n, l->buf, len - n);
+}
+
+int
+zsl_mes_log(struct zsl_mes_log *l, const struct zsl_measurement *mes)
+{
+	uint8_t hdr[ZSL_MES_WIRE_HDR_LEN];
+	size_t head = l->head;
+	size_t len = ZSL_MES_WIRE_HDR_LEN + mes->header.srclen.len;
+
+	if (l->sz - (head - l->tail) < len) {
+		l->dropped++;
+		return -ENOMEM;
+	}
+
+	zsl_mes_wire_hdr_pack(&mes->header, hdr);
+	zsl_mes_log_put(l, head, hdr, ZSL_MES_WIRE_HDR_LEN);
+	zsl_mes_log_put(l, head + ZSL_MES_WIRE_HDR_LEN, mes->payload,
+			mes->header.srclen.len);
+
+	/* Publish the record only once it is complete. */
+	l->head = head + len;
+
+	return 0;
+}
+
+int
+zsl_mes_log_pop(struct zsl_mes_log *l, uint8_t *rec, size_t sz,
+		struct zsl_measurement *mes)
+{
+	uint8_t h[ZSL_MES_WIRE_HDR_LEN];
+	size_t tail = l->tail;
+	size_t len;
+
+	if (l->head == tail) {
+		return -ENODATA;
+	}
+
+	zsl_mes_log_get(l, tail, h, ZSL_MES_WIRE_HDR_LEN);
+	zsl_mes_wire_hdr_unpack(h, &mes->header);
+	len = ZSL_MES_WIRE_HDR_LEN + mes->header.srclen.len;
+
+	if (sz < len) {
+		l->tail = tail + len;
+		return -ENOMEM;
+	}
+
+	zsl_mes_log_get(l, tail, rec, len);
+	l->tail = tail + len;
+	mes->payload = rec + ZSL_MES_WIRE_HDR_LEN;
+
+	return 0;
+}
+
+size_t
+zsl_mes_log_print(struct zsl_mes_log *l, uint8_t *rec, size_t sz)
+{
+	int rc;
+	size_t n = 0;
+	struct zsl_measurement mes;
+
+	while ((rc = zsl_mes_log_pop(l, rec, sz, &mes)) != -ENODATA) {
+		if (rc == 0) {
+			zsl_mes_print(&mes);
+			n++;
+		}
+	}
+
+	return n;
+}
+
+int
+zsl_mes_log_dump(struct zsl_mes_log *l, zsl_mes_wire_write_fn_t fn,
+		 void *arg)
+{
+	int rc;
+	size_t head = l->head;
+	size_t tail = l->tail;
+	size_t p = tail & (l->sz - 1);
+	size_t len = head - tail;
+	size_t n = l->sz - p < len ? l->sz - p : len;
+
+	if (n) {
+		rc = fn(l->buf + p, n, arg);
+		if (rc) {
+			return rc;
+		}
+	}
+	if (len - n) {
+		rc = fn(l->buf, len - n, arg);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	l->tail = head;
+
+	return 0;
+}
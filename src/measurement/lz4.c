@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/lz4.h>
+
+/* The shortest match, and the limits the block format puts on the end. */
+#define ZSL_MES_LZ4_MINMATCH    (4)
+#define ZSL_MES_LZ4_LASTLIT     (5)
+#define ZSL_MES_LZ4_MFLIMIT     (12)
+
+static uint32_t
+zsl_mes_lz4_read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+/* Writes a length nibble's extension bytes, for a length of 15 or more. */
+static int
+zsl_mes_lz4_put_len(uint8_t **op, uint8_t *end, size_t len)
+{
+	for (len -= 15; len >= 255; len -= 255) {
+		if (*op == end) {
+			return -ENOMEM;
+		}
+		*(*op)++ = 255;
+	}
+	if (*op == end) {
+		return -ENOMEM;
+	}
+	*(*op)++ = (uint8_t)len;
+
+	return 0;
+}
+
+/*
+ * Writes a sequence of 'nlit' literals from 'lit', followed by a match of
+ * 'ml' bytes at offset 'off', or no match if 'ml' is 0.
+ */
+static int
+zsl_mes_lz4_put_seq(uint8_t **op, uint8_t *end, const uint8_t *lit,
+		    size_t nlit, size_t off, size_t ml)
+{
+	uint8_t *tok = *op;
+
+	if (*op == end) {
+		return -ENOMEM;
+	}
+	(*op)++;
+
+	*tok = (uint8_t)((nlit < 15 ? nlit : 15) << 4);
+	if ((nlit >= 15) && zsl_mes_lz4_put_len(op, end, nlit)) {
+		return -ENOMEM;
+	}
+	if ((size_t)(end - *op) < nlit) {
+		return -ENOMEM;
+	}
+	memcpy(*op, lit, nlit);
+	*op += nlit;
+
+	if (ml == 0) {
+		return 0;
+	}
+
+	if (end - *op < 2) {
+		return -ENOMEM;
+	}
+	*(*op)++ = (uint8_t)off;
+	*(*op)++ = (uint8_t)(off >> 8);
+
+	ml -= ZSL_MES_LZ4_MINMATCH;
+	*tok |= (uint8_t)(ml < 15 ? ml : 15);
+	if (ml >= 15) {
+		return zsl_mes_lz4_put_len(op, end, ml);
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_lz4_comp(struct zsl_mes_lz4 *z, const uint8_t *src, size_t len,
+		 uint8_t *dst, size_t sz, size_t *out)
+{
+	int rc;
+	uint8_t *op = dst;
+	uint8_t *end = dst + sz;
+	size_t ip = 0;
+	size_t anchor = 0;
+	size_t cand, ml, h;
+
+	if (len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	memset(z->tbl, 0, sizeof(z->tbl[0]) << z->bits);
+
+	/* Matches can't start in the last MFLIMIT bytes. */
+	while (len >= ZSL_MES_LZ4_MFLIMIT + 1 &&
+	       ip < len - ZSL_MES_LZ4_MFLIMIT) {
+		h = (zsl_mes_lz4_read32(&src[ip]) * 2654435761U) >>
+		    (32 - z->bits);
+		cand = z->tbl[h];
+		z->tbl[h] = (uint16_t)ip;
+
+		if ((cand >= ip) || (zsl_mes_lz4_read32(&src[cand]) !=
+				     zsl_mes_lz4_read32(&src[ip]))) {
+			ip++;
+			continue;
+		}
+
+		/* Extend the match, stopping short of the last literals. */
+		ml = ZSL_MES_LZ4_MINMATCH;
+		while ((ip + ml < len - ZSL_MES_LZ4_LASTLIT) &&
+		       (src[cand + ml] == src[ip + ml])) {
+			ml++;
+		}
+
+		rc = zsl_mes_lz4_put_seq(&op, end, &src[anchor], ip - anchor,
+					 ip - cand, ml);
+		if (rc) {
+			return rc;
+		}
+		ip += ml;
+		anchor = ip;
+	}
+
+	rc = zsl_mes_lz4_put_seq(&op, end, &src[anchor], len - anchor, 0, 0);
+	if (rc) {
+		return rc;
+	}
+	*out = (size_t)(op - dst);
+
+	return 0;
+}
+
+/* Reads a length nibble's extension bytes. */
+static int
+zsl_mes_lz4_get_len(const uint8_t **ip, const uint8_t *end, size_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*ip == end) {
+			return -EINVAL;
+		}
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 255);
+
+	return 0;
+}
+
+int
+zsl_mes_lz4_decomp(const uint8_t *src, size_t len, uint8_t *dst,
+		   size_t sz, size_t *out)
+{
+	const uint8_t *ip = src;
+	const uint8_t *end = src + len;
+	size_t op = 0;
+	size_t nlit, ml, off;
+	uint8_t tok;
+
+	while (ip < end) {
+		tok = *ip++;
+
+		nlit = tok >> 4;
+		if ((nlit == 15) && zsl_mes_lz4_get_len(&ip, end, &nlit)) {
+			return -EINVAL;
+		}
+		if ((size_t)(end - ip) < nlit) {
+			return -EINVAL;
+		}
+		if (sz - op < nlit) {
+			return -ENOMEM;
+		}
+		memcpy(&dst[op], ip, nlit);
+		ip += nlit;
+		op += nlit;
+
+		/* The last sequence has no match. */
+		if (ip == end) {
+			break;
+		}
+
+		if (end - ip < 2) {
+			return -EINVAL;
+		}
+		off = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if ((off == 0) || (off > op)) {
+			return -EINVAL;
+		}
+
+		ml = tok & 0xF;
+		if ((ml == 15) && zsl_mes_lz4_get_len(&ip, end, &ml)) {
+			return -EINVAL;
+		}
+		ml += ZSL_MES_LZ4_MINMATCH;
+		if (sz - op < ml) {
+			return -ENOMEM;
+		}
+
+		/* Byte by byte, as the match may overlap its own output. */
+		for (size_t i = 0; i < ml; i++, op++) {
+			dst[op] = dst[op - off];
+		}
+	}
+
+	*out = op;
+
+	return 0;
+}
+
+/*
+ * Gets the word size 'w' that a C type is delta-encoded in, the number of
+ * words per sample, and whether the words are XORed instead of subtracted.
+ */
+static int
+zsl_mes_lz4_delta_fmt(uint8_t ctype, size_t *w, size_t *lag, bool *xor)
+{
+	size_t n = zsl_mes_ctype_size(ctype);
+
+	switch (ctype) {
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_32:
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_32:
+		*w = 4;
+		*xor = true;
+		break;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_64:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_64:
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_64:
+		*w = 8;
+		*xor = true;
+		break;
+	default:
+		if ((n == 0) || (n > 8)) {
+			return -EINVAL;
+		}
+		*w = n;
+		*xor = false;
+		break;
+	}
+	*lag = n / *w;
+
+	return 0;
+}
+
+static uint64_t
+zsl_mes_lz4_ld(const uint8_t *p, size_t w)
+{
+	uint8_t u8;
+	uint16_t u16;
+	uint32_t u32;
+	uint64_t u64;
+
+	switch (w) {
+	case 1:
+		memcpy(&u8, p, w);
+		return u8;
+	case 2:
+		memcpy(&u16, p, w);
+		return u16;
+	case 4:
+		memcpy(&u32, p, w);
+		return u32;
+	default:
+		memcpy(&u64, p, w);
+		return u64;
+	}
+}
+
+static void
+zsl_mes_lz4_st(uint8_t *p, size_t w, uint64_t v)
+{
+	uint8_t u8 = (uint8_t)v;
+	uint16_t u16 = (uint16_t)v;
+	uint32_t u32 = (uint32_t)v;
+
+	switch (w) {
+	case 1:
+		memcpy(p, &u8, w);
+		break;
+	case 2:
+		memcpy(p, &u16, w);
+		break;
+	case 4:
+		memcpy(p, &u32, w);
+		break;
+	default:
+		memcpy(p, &v, w);
+		break;
+	}
+}
+
+int
+zsl_mes_lz4_delta(uint8_t ctype, void *data, size_t len)
+{
+	size_t w, lag, n;
+	bool xor;
+	uint64_t a, b;
+	uint8_t *p = data;
+
+	if (zsl_mes_lz4_delta_fmt(ctype, &w, &lag, &xor) ||
+	    (len % (w * lag))) {
+		return -EINVAL;
+	}
+
+	/* Backwards, so each word is taken from the unmodified previous one. */
+	n = len / w;
+	for (size_t i = n; i-- > lag;) {
+		a = zsl_mes_lz4_ld(&p[i * w], w);
+		b = zsl_mes_lz4_ld(&p[(i - lag) * w], w);
+		zsl_mes_lz4_st(&p[i * w], w, xor ? a ^ b : a - b);
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_lz4_undelta(uint8_t ctype, void *data, size_t len)
+{
+	size_t w, lag, n;
+	bool xor;
+	uint64_t a, b;
+	uint8_t *p = data;
+
+	if (zsl_mes_lz4_delta_fmt(ctype, &w, &lag, &xor) ||
+	    (len % (w * lag))) {
+		return -EINVAL;
+	}
+
+	n = len / w;
+	for (size_t i = lag; i < n; i++) {
+		a = zsl_mes_lz4_ld(&p[i * w], w);
+		b = zsl_mes_lz4_ld(&p[(i - lag) * w], w);
+		zsl_mes_lz4_st(&p[i * w], w, xor ? a ^ b : a + b);
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_lz4_enc(struct zsl_mes_lz4 *z, struct zsl_measurement *mes,
+		bool delta, uint8_t *buf, size_t sz,
+		struct zsl_measurement *out)
+{
+	int rc;
+	size_t len;
+	uint8_t ctype = mes->header.unit.ctype;
+	uint16_t pl = mes->header.srclen.len;
+
+	if (mes->header.filter.flags.compression != ZSL_MES_COMPRESSION_NONE) {
+		return -EINVAL;
+	}
+
+	if (delta) {
+		rc = zsl_mes_lz4_delta(ctype, mes->payload, pl);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rc = zsl_mes_lz4_comp(z, mes->payload, pl, buf, sz, &len);
+
+	if (delta) {
+		zsl_mes_lz4_undelta(ctype, mes->payload, pl);
+	}
+
+	if (rc) {
+		return rc;
+	}
+	if (len > UINT16_MAX) {
+		return -ENOMEM;
+	}
+
+	out->header = mes->header;
+	out->header.filter.flags.compression =
+		delta ? ZSL_MES_COMPRESSION_LZ4_DELTA : ZSL_MES_COMPRESSION_LZ4;
+	out->header.srclen.len = (uint16_t)len;
+	out->payload = buf;
+
+	return 0;
+}
+
+int
+zsl_mes_lz4_dec(const struct zsl_measurement *mes, uint8_t *buf,
+		size_t sz, struct zsl_measurement *out)
+{
+	int rc;
+	size_t len;
+	uint8_t comp = mes->header.filter.flags.compression;
+
+	if ((comp != ZSL_MES_COMPRESSION_LZ4) &&
+	    (comp != ZSL_MES_COMPRESSION_LZ4_DELTA)) {
+		return -EINVAL;
+	}
+
+	rc = zsl_mes_lz4_decomp(mes->payload, mes->header.srclen.len, buf, sz,
+				&len);
+	if (rc) {
+		return rc;
+	}
+	if (len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	if (comp == ZSL_MES_COMPRESSION_LZ4_DELTA) {
+		rc = zsl_mes_lz4_undelta(mes->header.unit.ctype, buf, len);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	out->header = mes->header;
+	out->header.filter.flags.compression = ZSL_MES_COMPRESSION_NONE;
+	out->header.srclen.len = (uint16_t)len;
+	out->payload = buf;
+
+	return 0;
+}
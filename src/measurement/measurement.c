@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/measurement.h>
+
+size_t
+zsl_mes_ctype_size(uint8_t ctype)
+{
+	switch (ctype) {
+	case ZSL_MES_UNIT_CTYPE_S8:
+	case ZSL_MES_UNIT_CTYPE_U8:
+		return 1;
+	case ZSL_MES_UNIT_CTYPE_S16:
+	case ZSL_MES_UNIT_CTYPE_U16:
+		return 2;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_S32:
+	case ZSL_MES_UNIT_CTYPE_U32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_32:
+		return 4;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+	case ZSL_MES_UNIT_CTYPE_S64:
+	case ZSL_MES_UNIT_CTYPE_U64:
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_64:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_64:
+		return 8;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT128:
+	case ZSL_MES_UNIT_CTYPE_S128:
+	case ZSL_MES_UNIT_CTYPE_U128:
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_64:
+		return 16;
+	case ZSL_MES_UNIT_CTYPE_BOOL:
+		return sizeof(bool);
+	default:
+		return 0;
+	}
+}
+
+/* Prints 'n' values of type 't' from 'p', using format 'f'. */
+#define ZSL_MES_PRINT_LOOP(t, f, c)					\
+	do {								\
+		t v;							\
+		for (size_t i = 0; i < n; i++) {			\
+			memcpy(&v, p + i * sizeof(t), sizeof(t));	\
+			printf(f " ", (c)v);				\
+		}							\
+	} while (0)
+
+void
+zsl_mes_print(struct zsl_measurement *sample)
+{
+	const struct zsl_mes_header *h = &sample->header;
+	const uint8_t *p = sample->payload;
+	size_t sz = zsl_mes_ctype_size(h->unit.ctype);
+	size_t n;
+
+	printf("type: 0x%02X/0x%02X, flags: 0x%04X, unit: 0x%04X, "
+	       "ctype: 0x%02X, scale: %d\n", h->filter.base_type,
+	       h->filter.ext_type, h->filter.flags_bits, h->unit.si_unit,
+	       h->unit.ctype, h->unit.scale_factor);
+	printf("len: %u, fragment: %u, samples: %u, source: %u\n",
+	       h->srclen.len, h->srclen.fragment, h->srclen.samples,
+	       h->srclen.sourceid);
+
+	/* Raw values are printed by type, anything else as bytes. */
+	if ((h->filter.flags_bits != 0) || (h->srclen.fragment != 0) ||
+	    (sz == 0)) {
+		n = h->srclen.len;
+		ZSL_MES_PRINT_LOOP(uint8_t, "%02X", unsigned int);
+		printf("\n");
+		return;
+	}
+
+	n = h->srclen.len / sz;
+	switch (h->unit.ctype) {
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_32:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_32:
+		ZSL_MES_PRINT_LOOP(float, "%f", double);
+		break;
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_32:
+		n *= 2;
+		ZSL_MES_PRINT_LOOP(float, "%f", double);
+		break;
+	case ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64:
+	case ZSL_MES_UNIT_CTYPE_RANG_UNIT_INTERVAL_64:
+	case ZSL_MES_UNIT_CTYPE_RANG_PERCENT_64:
+		ZSL_MES_PRINT_LOOP(double, "%f", double);
+		break;
+	case ZSL_MES_UNIT_CTYPE_COMPLEX_64:
+		n *= 2;
+		ZSL_MES_PRINT_LOOP(double, "%f", double);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S8:
+		ZSL_MES_PRINT_LOOP(int8_t, "%d", int);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S16:
+		ZSL_MES_PRINT_LOOP(int16_t, "%d", int);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S32:
+		ZSL_MES_PRINT_LOOP(int32_t, "%ld", long);
+		break;
+	case ZSL_MES_UNIT_CTYPE_S64:
+		ZSL_MES_PRINT_LOOP(int64_t, "%lld", long long);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U8:
+	case ZSL_MES_UNIT_CTYPE_BOOL:
+		ZSL_MES_PRINT_LOOP(uint8_t, "%u", unsigned int);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U16:
+		ZSL_MES_PRINT_LOOP(uint16_t, "%u", unsigned int);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U32:
+		ZSL_MES_PRINT_LOOP(uint32_t, "%lu", unsigned long);
+		break;
+	case ZSL_MES_UNIT_CTYPE_U64:
+		ZSL_MES_PRINT_LOOP(uint64_t, "%llu", unsigned long long);
+		break;
+	default:
+		n = h->srclen.len;
+		ZSL_MES_PRINT_LOOP(uint8_t, "%02X", unsigned int);
+		break;
+	}
+	printf("\n");
+}
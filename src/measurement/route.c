@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/route.h>
+
+/* Multiplicative hash of a mask and a key. */
+static size_t
+zsl_mes_route_hash(const struct zsl_mes_route *r, uint32_t mask, uint32_t key)
+{
+	uint32_t h = (key ^ (mask * 0x9E3779B1UL)) * 0x85EBCA6BUL;
+
+	return (size_t)(h >> (32 - r->bits));
+}
+
+/* Finds the hash table entry of a key, or the empty entry it would use. */
+static size_t
+zsl_mes_route_find(const struct zsl_mes_route *r, uint32_t mask,
+		   uint32_t key)
+{
+	size_t m = ((size_t)1 << r->bits) - 1;
+	size_t i = zsl_mes_route_hash(r, mask, key);
+	const struct zsl_mes_route_sub *s;
+
+	while (r->tbl[i]) {
+		s = &r->subs[r->tbl[i] - 1];
+		if ((s->mask == mask) && (s->key == key)) {
+			break;
+		}
+		i = (i + 1) & m;
+	}
+
+	return i;
+}
+
+int
+zsl_mes_route_sub(struct zsl_mes_route *r, uint32_t mask, uint32_t value,
+		  zsl_mes_route_fn_t fn, void *arg)
+{
+	size_t i, j;
+	uint8_t k;
+	uint32_t key = value & mask;
+	struct zsl_mes_route_sub *s;
+
+	if ((r->count == r->n) || (r->count >= UINT16_MAX)) {
+		return -ENOMEM;
+	}
+
+	for (k = 0; k < r->nmasks; k++) {
+		if (r->masks[k] == mask) {
+			break;
+		}
+	}
+	if (k == ZSL_MES_ROUTE_MASKS) {
+		return -ENOMEM;
+	}
+
+	/* Keep at least one empty entry, which ends every probe. */
+	i = zsl_mes_route_find(r, mask, key);
+	if (!r->tbl[i] && (r->nkeys + 1 >= ((size_t)1 << r->bits))) {
+		return -ENOMEM;
+	}
+
+	s = &r->subs[r->count];
+	s->mask = mask;
+	s->key = key;
+	s->fn = fn;
+	s->arg = arg;
+	s->next = 0;
+	r->count++;
+
+	if (k == r->nmasks) {
+		r->masks[r->nmasks++] = mask;
+	}
+
+	if (!r->tbl[i]) {
+		r->tbl[i] = (uint16_t)r->count;
+		r->nkeys++;
+		return 0;
+	}
+
+	/* Append to the chain, to call subscribers in order. */
+	j = r->tbl[i] - 1;
+	while (r->subs[j].next) {
+		j = r->subs[j].next - 1;
+	}
+	r->subs[j].next = (uint16_t)r->count;
+
+	return 0;
+}
+
+size_t
+zsl_mes_route(const struct zsl_mes_route *r, const struct zsl_measurement *mes)
+{
+	size_t i, n = 0;
+	uint16_t j;
+	uint32_t key;
+	const struct zsl_mes_route_sub *s;
+
+	for (uint8_t k = 0; k < r->nmasks; k++) {
+		key = mes->header.filter_bits & r->masks[k];
+		i = zsl_mes_route_find(r, r->masks[k], key);
+		for (j = r->tbl[i]; j; j = s->next) {
+			s = &r->subs[j - 1];
+			s->fn(mes, s->arg);
+			n++;
+		}
+	}
+
+	return n;
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/store.h>
+
+/* The position in the ring buffer of entry 'idx'. */
+static size_t
+zsl_mes_store_pos(const struct zsl_mes_store *s, size_t idx)
+{
+	size_t p = s->head + idx;
+
+	return p < s->n ? p : p - s->n;
+}
+
+int
+zsl_mes_store_add(struct zsl_mes_store *s, const struct zsl_measurement *mes,
+		  uint64_t ts)
+{
+	size_t p;
+
+	if (mes->header.srclen.len > s->vlen) {
+		return -ENOMEM;
+	}
+	if (s->count &&
+	    (ts < s->ent[zsl_mes_store_pos(s, s->count - 1)].ts)) {
+		return -EINVAL;
+	}
+
+	/* Replace the oldest entry when full. */
+	if (s->count == s->n) {
+		s->head = zsl_mes_store_pos(s, 1);
+		s->count--;
+	}
+
+	p = zsl_mes_store_pos(s, s->count);
+	s->ent[p].hdr = mes->header;
+	s->ent[p].ts = ts;
+	memcpy(s->buf + p * s->vlen, mes->payload, mes->header.srclen.len);
+	s->count++;
+
+	return 0;
+}
+
+size_t
+zsl_mes_store_find(const struct zsl_mes_store *s, uint64_t ts)
+{
+	size_t lo = 0;
+	size_t hi = s->count;
+	size_t mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (s->ent[zsl_mes_store_pos(s, mid)].ts < ts) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+int
+zsl_mes_store_get(const struct zsl_mes_store *s, size_t idx,
+		  struct zsl_measurement *mes, uint64_t *ts)
+{
+	size_t p;
+
+	if (idx >= s->count) {
+		return -EINVAL;
+	}
+
+	p = zsl_mes_store_pos(s, idx);
+	mes->header = s->ent[p].hdr;
+	mes->payload = s->buf + p * s->vlen;
+	if (ts != NULL) {
+		*ts = s->ent[p].ts;
+	}
+
+	return 0;
+}
+
+void
+zsl_mes_store_drop(struct zsl_mes_store *s, size_t n)
+{
+	if (n >= s->count) {
+		s->head = 0;
+		s->count = 0;
+		return;
+	}
+
+	s->head = zsl_mes_store_pos(s, n);
+	s->count -= n;
+}
+
+void
+zsl_mes_store_iter_init(struct zsl_mes_store_iter *it,
+			const struct zsl_mes_store *s, uint64_t t0,
+			uint64_t t1, uint64_t ivl)
+{
+	it->s = s;
+	it->idx = zsl_mes_store_find(s, t0);
+	it->end = t1 == UINT64_MAX ? s->count : zsl_mes_store_find(s, t1 + 1);
+	it->ivl = ivl;
+}
+
+int
+zsl_mes_store_iter_next(struct zsl_mes_store_iter *it,
+			struct zsl_measurement *mes, uint64_t *ts)
+{
+	size_t idx = it->idx;
+	uint64_t t;
+
+	if (idx >= it->end) {
+		return -ENODATA;
+	}
+
+	zsl_mes_store_get(it->s, idx, mes, &t);
+	if (ts != NULL) {
+		*ts = t;
+	}
+
+	/* Skip to the next interval with another search, not a scan. */
+	it->idx = idx + 1;
+	if (it->ivl) {
+		if (t > UINT64_MAX - it->ivl) {
+			it->idx = it->end;
+		} else {
+			idx = zsl_mes_store_find(it->s, t + it->ivl);
+			it->idx = idx > it->idx ? idx : it->idx;
+		}
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_FLASH
+/* 'ZSLS', little-endian. */
+#define ZSL_MES_STORE_MAGIC     (0x534C535AUL)
+
+/* The header of a saved store, padded to 32 bytes. */
+struct zsl_mes_store_flash_hdr {
+	uint32_t magic;
+	uint32_t n;
+	uint32_t vlen;
+	uint32_t head;
+	uint32_t count;
+	uint32_t _rsvd[3];
+};
+
+int
+zsl_mes_store_save(const struct zsl_mes_store *s, const struct device *dev,
+		   off_t off, size_t sz)
+{
+	int rc;
+	struct zsl_mes_store_flash_hdr h = {
+		.magic = ZSL_MES_STORE_MAGIC,
+		.n = s->n,
+		.vlen = s->vlen,
+		.head = s->head,
+		.count = s->count,
+	};
+	size_t el = s->n * sizeof(struct zsl_mes_store_entry);
+	size_t bl = s->n * s->vlen;
+
+	if (sizeof(h) + el + bl > sz) {
+		return -ENOMEM;
+	}
+
+	rc = flash_erase(dev, off, sz);
+	if (rc) {
+		return rc;
+	}
+	rc = flash_write(dev, off, &h, sizeof(h));
+	if (rc) {
+		return rc;
+	}
+	off += sizeof(h);
+	rc = flash_write(dev, off, s->ent, el);
+	if (rc) {
+		return rc;
+	}
+	off += el;
+
+	return flash_write(dev, off, s->buf, bl);
+}
+
+int
+zsl_mes_store_load(struct zsl_mes_store *s, const struct device *dev,
+		   off_t off)
+{
+	int rc;
+	struct zsl_mes_store_flash_hdr h;
+	size_t el = s->n * sizeof(struct zsl_mes_store_entry);
+
+	rc = flash_read(dev, off, &h, sizeof(h));
+	if (rc) {
+		return rc;
+	}
+	if (h.magic != ZSL_MES_STORE_MAGIC) {
+		return -ENODATA;
+	}
+	if ((h.n != s->n) || (h.vlen != s->vlen) || (h.head >= h.n) ||
+	    (h.count > h.n)) {
+		return -EINVAL;
+	}
+
+	/* Entries that were only partly read are dropped. */
+	s->head = 0;
+	s->count = 0;
+	off += sizeof(h);
+	rc = flash_read(dev, off, s->ent, el);
+	if (rc) {
+		return rc;
+	}
+	off += el;
+	rc = flash_read(dev, off, s->buf, s->n * s->vlen);
+	if (rc) {
+		return rc;
+	}
+
+	s->head = h.head;
+	s->count = h.count;
+
+	return 0;
+}
+#endif
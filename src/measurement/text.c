@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/text.h>
+
+/* Set in every valid entry of the decoding tables, above the value. */
+#define ZSL_MES_TEXT_VALID      (0x40)
+
+static const char zsl_mes_b64_chr[64] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const uint8_t zsl_mes_b64_val[256] = {
+	['A'] = 0x40, ['B'] = 0x41, ['C'] = 0x42, ['D'] = 0x43, ['E'] = 0x44,
+	['F'] = 0x45, ['G'] = 0x46, ['H'] = 0x47, ['I'] = 0x48, ['J'] = 0x49,
+	['K'] = 0x4A, ['L'] = 0x4B, ['M'] = 0x4C, ['N'] = 0x4D, ['O'] = 0x4E,
+	['P'] = 0x4F, ['Q'] = 0x50, ['R'] = 0x51, ['S'] = 0x52, ['T'] = 0x53,
+	['U'] = 0x54, ['V'] = 0x55, ['W'] = 0x56, ['X'] = 0x57, ['Y'] = 0x58,
+	['Z'] = 0x59, ['a'] = 0x5A, ['b'] = 0x5B, ['c'] = 0x5C, ['d'] = 0x5D,
+	['e'] = 0x5E, ['f'] = 0x5F, ['g'] = 0x60, ['h'] = 0x61, ['i'] = 0x62,
+	['j'] = 0x63, ['k'] = 0x64, ['l'] = 0x65, ['m'] = 0x66, ['n'] = 0x67,
+	['o'] = 0x68, ['p'] = 0x69, ['q'] = 0x6A, ['r'] = 0x6B, ['s'] = 0x6C,
+	['t'] = 0x6D, ['u'] = 0x6E, ['v'] = 0x6F, ['w'] = 0x70, ['x'] = 0x71,
+	['y'] = 0x72, ['z'] = 0x73, ['0'] = 0x74, ['1'] = 0x75, ['2'] = 0x76,
+	['3'] = 0x77, ['4'] = 0x78, ['5'] = 0x79, ['6'] = 0x7A, ['7'] = 0x7B,
+	['8'] = 0x7C, ['9'] = 0x7D, ['+'] = 0x7E, ['/'] = 0x7F
+};
+
+static const char zsl_mes_b45_chr[45] =
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+static const uint8_t zsl_mes_b45_val[256] = {
+	['0'] = 0x40, ['1'] = 0x41, ['2'] = 0x42, ['3'] = 0x43, ['4'] = 0x44,
+	['5'] = 0x45, ['6'] = 0x46, ['7'] = 0x47, ['8'] = 0x48, ['9'] = 0x49,
+	['A'] = 0x4A, ['B'] = 0x4B, ['C'] = 0x4C, ['D'] = 0x4D, ['E'] = 0x4E,
+	['F'] = 0x4F, ['G'] = 0x50, ['H'] = 0x51, ['I'] = 0x52, ['J'] = 0x53,
+	['K'] = 0x54, ['L'] = 0x55, ['M'] = 0x56, ['N'] = 0x57, ['O'] = 0x58,
+	['P'] = 0x59, ['Q'] = 0x5A, ['R'] = 0x5B, ['S'] = 0x5C, ['T'] = 0x5D,
+	['U'] = 0x5E, ['V'] = 0x5F, ['W'] = 0x60, ['X'] = 0x61, ['Y'] = 0x62,
+	['Z'] = 0x63, [' '] = 0x64, ['$'] = 0x65, ['%'] = 0x66, ['*'] = 0x67,
+	['+'] = 0x68, ['-'] = 0x69, ['.'] = 0x6A, ['/'] = 0x6B, [':'] = 0x6C
+};
+
+int
+zsl_mes_b64_enc(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		size_t *out)
+{
+	size_t n = len / 3;
+	size_t r = len % 3;
+	size_t o = ZSL_MES_B64_LEN(len);
+	uint32_t w;
+
+	if (sz < o) {
+		return -ENOMEM;
+	}
+	*out = o;
+
+	/* The padded final group, which is furthest along the buffer. */
+	if (r) {
+		w = (uint32_t)src[3 * n] << 16;
+		if (r == 2) {
+			w |= (uint32_t)src[3 * n + 1] << 8;
+		}
+		o -= 4;
+		dst[o] = zsl_mes_b64_chr[w >> 18];
+		dst[o + 1] = zsl_mes_b64_chr[(w >> 12) & 0x3F];
+		dst[o + 2] = r == 2 ? zsl_mes_b64_chr[(w >> 6) & 0x3F] : '=';
+		dst[o + 3] = '=';
+	}
+
+	/* Then each group of 3 bytes, from the last to the first. */
+	for (size_t i = n; i-- > 0;) {
+		w = ((uint32_t)src[3 * i] << 16) |
+		    ((uint32_t)src[3 * i + 1] << 8) | src[3 * i + 2];
+		o -= 4;
+		dst[o] = zsl_mes_b64_chr[w >> 18];
+		dst[o + 1] = zsl_mes_b64_chr[(w >> 12) & 0x3F];
+		dst[o + 2] = zsl_mes_b64_chr[(w >> 6) & 0x3F];
+		dst[o + 3] = zsl_mes_b64_chr[w & 0x3F];
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_b64_dec(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		size_t *out)
+{
+	const uint8_t *t = zsl_mes_b64_val;
+	size_t n, r, o;
+	uint8_t a, b, c, d;
+	uint32_t w;
+
+	/* Up to two '=' may pad the final group. */
+	if ((len % 4 == 0) && (len > 0) && (src[len - 1] == '=')) {
+		len -= src[len - 2] == '=' ? 2 : 1;
+	}
+
+	n = len / 4;
+	r = len % 4;
+	if (r == 1) {
+		return -EINVAL;
+	}
+	if (sz < 3 * n + (r ? r - 1 : 0)) {
+		return -ENOMEM;
+	}
+
+	o = 0;
+	for (size_t i = 0; i < n; i++, src += 4) {
+		a = t[src[0]];
+		b = t[src[1]];
+		c = t[src[2]];
+		d = t[src[3]];
+		if (!(a & b & c & d & ZSL_MES_TEXT_VALID)) {
+			return -EINVAL;
+		}
+		w = ((uint32_t)(a & 0x3F) << 18) |
+		    ((uint32_t)(b & 0x3F) << 12) |
+		    ((uint32_t)(c & 0x3F) << 6) | (d & 0x3F);
+		dst[o++] = (uint8_t)(w >> 16);
+		dst[o++] = (uint8_t)(w >> 8);
+		dst[o++] = (uint8_t)w;
+	}
+
+	if (r) {
+		a = t[src[0]];
+		b = t[src[1]];
+		c = r == 3 ? t[src[2]] : ZSL_MES_TEXT_VALID;
+		if (!(a & b & c & ZSL_MES_TEXT_VALID)) {
+			return -EINVAL;
+		}
+		w = ((uint32_t)(a & 0x3F) << 18) |
+		    ((uint32_t)(b & 0x3F) << 12) |
+		    ((uint32_t)(c & 0x3F) << 6);
+		dst[o++] = (uint8_t)(w >> 16);
+		if (r == 3) {
+			dst[o++] = (uint8_t)(w >> 8);
+		}
+	}
+
+	*out = o;
+
+	return 0;
+}
+
+int
+zsl_mes_b45_enc(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		size_t *out)
+{
+	size_t n = len / 2;
+	size_t o = ZSL_MES_B45_LEN(len);
+	uint32_t v;
+
+	if (sz < o) {
+		return -ENOMEM;
+	}
+	*out = o;
+
+	/* A final odd byte is 2 characters, furthest along the buffer. */
+	if (len % 2) {
+		v = src[2 * n];
+		dst[3 * n] = zsl_mes_b45_chr[v % 45];
+		dst[3 * n + 1] = zsl_mes_b45_chr[v / 45];
+	}
+
+	/* Then each pair of bytes, from the last to the first. */
+	for (size_t i = n; i-- > 0;) {
+		v = ((uint32_t)src[2 * i] << 8) | src[2 * i + 1];
+		dst[3 * i] = zsl_mes_b45_chr[v % 45];
+		dst[3 * i + 1] = zsl_mes_b45_chr[(v / 45) % 45];
+		dst[3 * i + 2] = zsl_mes_b45_chr[v / 2025];
+	}
+
+	return 0;
+}
+
+int
+zsl_mes_b45_dec(const uint8_t *src, size_t len, uint8_t *dst, size_t sz,
+		size_t *out)
+{
+	const uint8_t *t = zsl_mes_b45_val;
+	size_t n = len / 3;
+	size_t r = len % 3;
+	size_t o;
+	uint8_t a, b, c;
+	uint32_t v;
+
+	if (r == 1) {
+		return -EINVAL;
+	}
+	if (sz < 2 * n + (r ? 1 : 0)) {
+		return -ENOMEM;
+	}
+
+	o = 0;
+	for (size_t i = 0; i < n; i++, src += 3) {
+		a = t[src[0]];
+		b = t[src[1]];
+		c = t[src[2]];
+		if (!(a & b & c & ZSL_MES_TEXT_VALID)) {
+			return -EINVAL;
+		}
+		v = (a & 0x3F) + 45 * (b & 0x3F) + 2025 * (uint32_t)(c & 0x3F);
+		if (v > UINT16_MAX) {
+			return -EINVAL;
+		}
+		dst[o++] = (uint8_t)(v >> 8);
+		dst[o++] = (uint8_t)v;
+	}
+
+	if (r) {
+		a = t[src[0]];
+		b = t[src[1]];
+		if (!(a & b & ZSL_MES_TEXT_VALID)) {
+			return -EINVAL;
+		}
+		v = (a & 0x3F) + 45 * (b & 0x3F);
+		if (v > UINT8_MAX) {
+			return -EINVAL;
+		}
+		dst[o++] = (uint8_t)v;
+	}
+
+	*out = o;
+
+	return 0;
+}
+
+int
+zsl_mes_text_enc(struct zsl_measurement *mes, uint8_t enc, size_t sz)
+{
+	int rc;
+	size_t len;
+	uint8_t *p = mes->payload;
+
+	if (mes->header.filter.flags.encoding != ZSL_MES_ENCODING_NONE) {
+		return -EINVAL;
+	}
+
+	/* Keep the encoded length within the 16-bit field. */
+	if (sz > UINT16_MAX) {
+		sz = UINT16_MAX;
+	}
+
+	switch (enc) {
+	case ZSL_MES_ENCODING_BASE64:
+		rc = zsl_mes_b64_enc(p, mes->header.srclen.len, p, sz, &len);
+		break;
+	case ZSL_MES_ENCODING_BASE45:
+		rc = zsl_mes_b45_enc(p, mes->header.srclen.len, p, sz, &len);
+		break;
+	default:
+		return -EINVAL;
+	}
+	if (rc) {
+		return rc;
+	}
+
+	mes->header.filter.flags.encoding = enc;
+	mes->header.srclen.len = (uint16_t)len;
+
+	return 0;
+}
+
+int
+zsl_mes_text_dec(struct zsl_measurement *mes)
+{
+	int rc;
+	size_t len = mes->header.srclen.len;
+	uint8_t *p = mes->payload;
+
+	switch (mes->header.filter.flags.encoding) {
+	case ZSL_MES_ENCODING_NONE:
+		return 0;
+	case ZSL_MES_ENCODING_BASE64:
+		rc = zsl_mes_b64_dec(p, len, p, len, &len);
+		break;
+	case ZSL_MES_ENCODING_BASE45:
+		rc = zsl_mes_b45_dec(p, len, p, len, &len);
+		break;
+	default:
+		return -EINVAL;
+	}
+	if (rc) {
+		return rc;
+	}
+
+	mes->header.filter.flags.encoding = ZSL_MES_ENCODING_NONE;
+	mes->header.srclen.len = (uint16_t)len;
+
+	return 0;
+}
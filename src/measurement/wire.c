@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/wire.h>
+
+static void
+zsl_mes_wire_put16(uint8_t *buf, uint16_t v)
+{
+	buf[0] = (uint8_t)v;
+	buf[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t
+zsl_mes_wire_get16(const uint8_t *buf)
+{
+	return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+/* Sums the segment lengths into 'len', which must fit the 16-bit field. */
+static int
+zsl_mes_wire_iov_len(const struct zsl_mes_iov *iov, size_t n, size_t *len)
+{
+	size_t sum = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (iov[i].len > UINT16_MAX - sum) {
+			return -EINVAL;
+		}
+		sum += iov[i].len;
+	}
+	*len = sum;
+
+	return 0;
+}
+
+/* Packs 'hdr' with a payload length of 'len'. */
+static void
+zsl_mes_wire_hdr_pack_len(const struct zsl_mes_header *hdr, size_t len,
+			  uint8_t *buf)
+{
+	buf[0] = hdr->filter.base_type;
+	buf[1] = hdr->filter.ext_type;
+	zsl_mes_wire_put16(&buf[2], hdr->filter.flags_bits);
+	zsl_mes_wire_put16(&buf[4], hdr->unit.si_unit);
+	buf[6] = hdr->unit.ctype;
+	buf[7] = (uint8_t)hdr->unit.scale_factor;
+	zsl_mes_wire_put16(&buf[8], (uint16_t)len);
+	buf[10] = (uint8_t)((hdr->srclen.fragment & 0x3) |
+			    ((hdr->srclen._rsvd & 0x3) << 2) |
+			    ((hdr->srclen.samples & 0xF) << 4));
+	buf[11] = hdr->srclen.sourceid;
+}
+
+void
+zsl_mes_wire_hdr_pack(const struct zsl_mes_header *hdr, uint8_t *buf)
+{
+	zsl_mes_wire_hdr_pack_len(hdr, hdr->srclen.len, buf);
+}
+
+void
+zsl_mes_wire_hdr_unpack(const uint8_t *buf, struct zsl_mes_header *hdr)
+{
+	hdr->filter.base_type = buf[0];
+	hdr->filter.ext_type = buf[1];
+	hdr->filter.flags_bits = zsl_mes_wire_get16(&buf[2]);
+	hdr->unit.si_unit = zsl_mes_wire_get16(&buf[4]);
+	hdr->unit.ctype = buf[6];
+	hdr->unit.scale_factor = (int8_t)buf[7];
+	hdr->srclen.len = zsl_mes_wire_get16(&buf[8]);
+	hdr->srclen.fragment = buf[10] & 0x3;
+	hdr->srclen._rsvd = (buf[10] >> 2) & 0x3;
+	hdr->srclen.samples = buf[10] >> 4;
+	hdr->srclen.sourceid = buf[11];
+}
+
+int
+zsl_mes_wire_enc(const struct zsl_measurement *mes, uint8_t *buf,
+		 size_t sz, size_t *len)
+{
+	struct zsl_mes_iov iov = {
+		.base = mes->payload,
+		.len = mes->header.srclen.len
+	};
+
+	return zsl_mes_wire_encv(&mes->header, &iov, 1, buf, sz, len);
+}
+
+int
+zsl_mes_wire_encv(const struct zsl_mes_header *hdr,
+		  const struct zsl_mes_iov *iov, size_t n, uint8_t *buf,
+		  size_t sz, size_t *len)
+{
+	int rc;
+	size_t pl;
+	uint8_t *p;
+
+	rc = zsl_mes_wire_iov_len(iov, n, &pl);
+	if (rc) {
+		return rc;
+	}
+	if (sz < ZSL_MES_WIRE_HDR_LEN + pl) {
+		return -ENOMEM;
+	}
+
+	zsl_mes_wire_hdr_pack_len(hdr, pl, buf);
+	p = buf + ZSL_MES_WIRE_HDR_LEN;
+	for (size_t i = 0; i < n; i++) {
+		if (iov[i].len) {
+			memcpy(p, iov[i].base, iov[i].len);
+			p += iov[i].len;
+		}
+	}
+	*len = ZSL_MES_WIRE_HDR_LEN + pl;
+
+	return 0;
+}
+
+int
+zsl_mes_wire_write(const struct zsl_mes_header *hdr,
+		   const struct zsl_mes_iov *iov, size_t n,
+		   zsl_mes_wire_write_fn_t fn, void *arg)
+{
+	int rc;
+	size_t pl;
+	uint8_t h[ZSL_MES_WIRE_HDR_LEN];
+
+	rc = zsl_mes_wire_iov_len(iov, n, &pl);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_mes_wire_hdr_pack_len(hdr, pl, h);
+	rc = fn(h, sizeof(h), arg);
+	for (size_t i = 0; (i < n) && (rc == 0); i++) {
+		if (iov[i].len) {
+			rc = fn(iov[i].base, iov[i].len, arg);
+		}
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_NET_BUF
+int
+zsl_mes_wire_net_buf(const struct zsl_mes_header *hdr,
+		     const struct zsl_mes_iov *iov, size_t n,
+		     struct net_buf *nb)
+{
+	int rc;
+	size_t len;
+
+	/* Encode straight into the tailroom, then claim what was used. */
+	rc = zsl_mes_wire_encv(hdr, iov, n, nb->data + nb->len,
+			       net_buf_tailroom(nb), &len);
+	if (rc) {
+		return rc;
+	}
+	net_buf_add(nb, len);
+
+	return 0;
+}
+#endif
+
+int
+zsl_mes_wire_dec(uint8_t *buf, size_t sz, struct zsl_measurement *mes,
+		 size_t *len)
+{
+	size_t pl;
+
+	if (sz < ZSL_MES_WIRE_HDR_LEN) {
+		return -ENOMEM;
+	}
+
+	/* The reserved bits of the flags and of byte 10 must be 0. */
+	if ((zsl_mes_wire_get16(&buf[2]) & 0xE000) || (buf[10] & 0x0C)) {
+		return -EINVAL;
+	}
+
+	pl = zsl_mes_wire_get16(&buf[8]);
+	if (sz - ZSL_MES_WIRE_HDR_LEN < pl) {
+		return -ENOMEM;
+	}
+
+	zsl_mes_wire_hdr_unpack(buf, &mes->header);
+	mes->payload = buf + ZSL_MES_WIRE_HDR_LEN;
+	*len = ZSL_MES_WIRE_HDR_LEN + pl;
+
+	return 0;
+}
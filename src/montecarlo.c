@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/montecarlo.h>
+#include <zsl/random.h>
+#include <zsl/smp.h>
+
+struct zsl_mc_job {
+	const struct zsl_mc *mc;
+	size_t n;
+	struct zsl_sta_stream part[ZSL_MC_PARTS];
+	int rc[ZSL_MC_PARTS];
+};
+
+/* Fills 'v' with samples of input 'in'. */
+static void
+zsl_mc_draw(struct zsl_rand *r, const struct zsl_mc_input *in,
+	    struct zsl_vec *v)
+{
+	switch (in->dist) {
+	case ZSL_MC_DIST_NORMAL:
+		zsl_rand_vec_normal(r, v, in->a, in->b);
+		break;
+	case ZSL_MC_DIST_UNIFORM:
+		zsl_rand_vec_uniform(r, v, in->a, in->b);
+		break;
+	case ZSL_MC_DIST_TRIANGULAR:
+		/* The mean of two uniform samples. */
+		for (size_t i = 0; i < v->sz; i++) {
+			v->data[i] = in->a + (in->b - in->a) * 0.5 *
+				     (zsl_rand_uniform(r) +
+				      zsl_rand_uniform(r));
+		}
+		break;
+	default:
+		for (size_t i = 0; i < v->sz; i++) {
+			v->data[i] = in->a;
+		}
+		break;
+	}
+}
+
+/* Evaluates part 'p' of 'job' into job->part[p]. */
+static int
+zsl_mc_part(struct zsl_mc_job *job, size_t p)
+{
+	int rc;
+	const struct zsl_mc *mc = job->mc;
+	size_t i = job->n * p / ZSL_MC_PARTS;
+	size_t end = job->n * (p + 1) / ZSL_MC_PARTS;
+	size_t b;
+	zsl_real_t xd[ZSL_MC_MAX_INPUTS][ZSL_MC_BATCH];
+	zsl_real_t yd[ZSL_MC_BATCH];
+	struct zsl_vec x[ZSL_MC_MAX_INPUTS];
+	struct zsl_vec y;
+	struct zsl_rand r;
+
+	/* Part 'p' uses the p'th jump of the seeded generator, so that its
+	 * samples don't depend on which thread runs it. */
+	zsl_rand_seed(&r, mc->seed);
+	for (size_t k = 0; k < p; k++) {
+		zsl_rand_jump(&r);
+	}
+
+	zsl_sta_stream_init(&job->part[p]);
+	for (; i < end; i += b) {
+		b = (end - i > ZSL_MC_BATCH) ? ZSL_MC_BATCH : end - i;
+		for (size_t k = 0; k < mc->n_in; k++) {
+			x[k].sz = b;
+			x[k].data = xd[k];
+			zsl_mc_draw(&r, &mc->in[k], &x[k]);
+		}
+		y.sz = b;
+		y.data = yd;
+
+		rc = mc->fn(x, &y, mc->arg);
+		if (rc) {
+			return rc;
+		}
+		zsl_sta_stream_feed_vec(&job->part[p], &y);
+	}
+
+	return 0;
+}
+
+static void
+zsl_mc_parts(void *arg, size_t start, size_t end)
+{
+	struct zsl_mc_job *job = arg;
+
+	for (size_t p = start; p < end; p++) {
+		job->rc[p] = zsl_mc_part(job, p);
+	}
+}
+
+int
+zsl_mc_run(const struct zsl_mc *mc, size_t n, struct zsl_sta_stream *y)
+{
+	struct zsl_mc_job job;
+	const struct zsl_mc_input *in;
+
+	if ((n == 0) || (mc->fn == NULL) || (mc->n_in == 0) ||
+	    (mc->n_in > ZSL_MC_MAX_INPUTS)) {
+		return -EINVAL;
+	}
+
+	for (size_t k = 0; k < mc->n_in; k++) {
+		in = &mc->in[k];
+		if (((in->dist == ZSL_MC_DIST_NORMAL) && (in->b < 0.0)) ||
+		    ((in->dist == ZSL_MC_DIST_UNIFORM) && (in->b < in->a)) ||
+		    ((in->dist == ZSL_MC_DIST_TRIANGULAR) && (in->b < in->a))) {
+			return -EINVAL;
+		}
+	}
+
+	job.mc = mc;
+	job.n = n;
+	zsl_smp_for(zsl_mc_parts, &job, ZSL_MC_PARTS,
+		    n * (mc->cost + mc->n_in));
+
+	for (size_t p = 0; p < ZSL_MC_PARTS; p++) {
+		if (job.rc[p]) {
+			return job.rc[p];
+		}
+	}
+
+	/* Merge in a fixed order, so the rounding is the same every time. */
+	for (size_t p = 0; p < ZSL_MC_PARTS; p++) {
+		zsl_sta_stream_merge(y, &job.part[p]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/ode.h>
+#include <zsl/workspace.h>
+
+/* Dormand-Prince 5(4) nodes and coefficients. */
+static const zsl_real_t zsl_ode_dp_c[7] = {
+	0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0
+};
+
+static const zsl_real_t zsl_ode_dp_a[7][6] = {
+	{ 0.0 },
+	{ 1.0 / 5.0 },
+	{ 3.0 / 40.0, 9.0 / 40.0 },
+	{ 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+	{ 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0,
+	  -212.0 / 729.0 },
+	{ 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+	  -5103.0 / 18656.0 },
+	/* The fifth-order solution, evaluated again as the seventh stage. */
+	{ 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0,
+	  -2187.0 / 6784.0, 11.0 / 84.0 },
+};
+
+/* Difference between the fifth and fourth-order weights. */
+static const zsl_real_t zsl_ode_dp_e[7] = {
+	71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+	-17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0
+};
+
+/* out = y + h * sum(w[j] * k[j]) over the first 'ns' stages. */
+static void
+zsl_ode_stage(const struct zsl_vec *y, struct zsl_vec **k,
+	      const zsl_real_t *w, size_t ns, zsl_real_t h,
+	      struct zsl_vec *out)
+{
+	for (size_t i = 0; i < y->sz; i++) {
+		zsl_real_t s = 0.0;
+		for (size_t j = 0; j < ns; j++) {
+			s += w[j] * k[j]->data[i];
+		}
+		out->data[i] = y->data[i] + h * s;
+	}
+}
+
+size_t
+zsl_ode_rk4_ws_sz(size_t n)
+{
+	/* k1..k4, and the stage input. */
+	return 5 * n;
+}
+
+int
+zsl_ode_rk4_ws(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+	       size_t steps, struct zsl_vec *y, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = y->sz;
+	zsl_real_t t0 = *t;
+	struct zsl_vec k1, k2, k3, k4, yt;
+	struct zsl_vec *k[4] = { &k1, &k2, &k3, &k4 };
+	static const zsl_real_t w2[1] = { 0.5 };
+	static const zsl_real_t w3[2] = { 0.0, 0.5 };
+	static const zsl_real_t w4[3] = { 0.0, 0.0, 1.0 };
+	static const zsl_real_t wy[4] = {
+		1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0
+	};
+
+	rc |= zsl_ws_vec_alloc(ws, &k1, n);
+	rc |= zsl_ws_vec_alloc(ws, &k2, n);
+	rc |= zsl_ws_vec_alloc(ws, &k3, n);
+	rc |= zsl_ws_vec_alloc(ws, &k4, n);
+	rc |= zsl_ws_vec_alloc(ws, &yt, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	for (size_t s = 0; s < steps; s++) {
+		rc = f(*t, y, &k1, arg);
+		if (rc) {
+			goto err;
+		}
+		zsl_ode_stage(y, k, w2, 1, h, &yt);
+		rc = f(*t + 0.5 * h, &yt, &k2, arg);
+		if (rc) {
+			goto err;
+		}
+		zsl_ode_stage(y, k, w3, 2, h, &yt);
+		rc = f(*t + 0.5 * h, &yt, &k3, arg);
+		if (rc) {
+			goto err;
+		}
+		zsl_ode_stage(y, k, w4, 3, h, &yt);
+		rc = f(*t + h, &yt, &k4, arg);
+		if (rc) {
+			goto err;
+		}
+		zsl_ode_stage(y, k, wy, 4, h, y);
+		/* Avoids accumulating rounding errors in 't'. */
+		*t = t0 + (zsl_real_t)(s + 1) * h;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_ode_rk4(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+	    size_t steps, struct zsl_vec *y)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_ode_rk4_ws_sz(y->sz));
+	rc = zsl_ode_rk4_ws(f, arg, t, h, steps, y, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+size_t
+zsl_ode_rk45_ws_sz(size_t n)
+{
+	/* k1..k7, and the stage input, which ends up as the new state. */
+	return 8 * n;
+}
+
+int
+zsl_ode_rk45_ws(zsl_ode_fn_t f, void *arg, zsl_real_t *t,
+		zsl_real_t t_end, zsl_real_t *h, zsl_real_t tol,
+		struct zsl_vec *y, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = y->sz;
+	struct zsl_vec kv[7], yt;
+	struct zsl_vec *k[7], *kt;
+	zsl_real_t dir = t_end >= *t ? 1.0 : -1.0;
+	zsl_real_t hn = ZSL_ABS(*h);
+	zsl_real_t hs, rem, err, e, sc, fac;
+	bool clip;
+
+	if ((hn <= 0.0) || (tol <= 0.0)) {
+		return -EINVAL;
+	}
+
+	for (size_t j = 0; j < 7; j++) {
+		k[j] = &kv[j];
+		rc |= zsl_ws_vec_alloc(ws, k[j], n);
+	}
+	rc |= zsl_ws_vec_alloc(ws, &yt, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = f(*t, y, k[0], arg);
+	if (rc) {
+		goto err;
+	}
+
+	while ((rem = dir * (t_end - *t)) > 0.0) {
+		/* Land exactly on t_end, without changing the proposed step. */
+		clip = hn >= rem;
+		hs = dir * (clip ? rem : hn);
+
+		for (size_t j = 1; j < 7; j++) {
+			zsl_ode_stage(y, k, zsl_ode_dp_a[j], j, hs, &yt);
+			rc = f(*t + zsl_ode_dp_c[j] * hs, &yt, k[j], arg);
+			if (rc) {
+				goto err;
+			}
+		}
+
+		/* RMS of the scaled error estimate. */
+		err = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			e = 0.0;
+			for (size_t j = 0; j < 7; j++) {
+				e += zsl_ode_dp_e[j] * k[j]->data[i];
+			}
+			sc = tol * (1.0 + ZSL_MAX(ZSL_ABS(y->data[i]),
+						  ZSL_ABS(yt.data[i])));
+			e = hs * e / sc;
+			err += e * e;
+		}
+		err = ZSL_SQRT(err / (zsl_real_t)n);
+
+		fac = err > 0.0 ? 0.9 * ZSL_POW(err, -0.2) : 5.0;
+		fac = ZSL_MIN(ZSL_MAX(fac, 0.2), 5.0);
+
+		if (err <= 1.0) {
+			*t = clip ? t_end : *t + hs;
+			zsl_vec_copy(y, &yt);
+			/* Reuse the last stage as the next first stage (FSAL). */
+			kt = k[0];
+			k[0] = k[6];
+			k[6] = kt;
+			if (!clip) {
+				hn *= fac;
+			}
+		} else {
+			hn = ZSL_ABS(hs) * ZSL_MIN(fac, 1.0);
+			if (*t + dir * hn == *t) {
+				rc = -ERANGE;
+				goto err;
+			}
+		}
+	}
+
+	*h = hn;
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_ode_rk45(zsl_ode_fn_t f, void *arg, zsl_real_t *t, zsl_real_t t_end,
+	     zsl_real_t *h, zsl_real_t tol, struct zsl_vec *y)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_ode_rk45_ws_sz(y->sz));
+	rc = zsl_ode_rk45_ws(f, arg, t, t_end, h, tol, y, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+size_t
+zsl_ode_verlet_ws_sz(size_t n)
+{
+	/* The acceleration at the end of the step. */
+	return n;
+}
+
+int
+zsl_ode_verlet_ws(zsl_ode_acc_fn_t f, void *arg, zsl_real_t *t,
+		  zsl_real_t h, size_t steps, struct zsl_vec *x,
+		  struct zsl_vec *v, struct zsl_vec *a,
+		  struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = x->sz;
+	zsl_real_t h2 = 0.5 * h * h;
+	zsl_real_t t0 = *t;
+	struct zsl_vec an;
+
+	if ((v->sz != n) || (a->sz != n)) {
+		return -EINVAL;
+	}
+
+	if (zsl_ws_vec_alloc(ws, &an, n)) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	for (size_t s = 0; s < steps; s++) {
+		for (size_t i = 0; i < n; i++) {
+			x->data[i] += h * v->data[i] + h2 * a->data[i];
+		}
+		rc = f(*t + h, x, &an, arg);
+		if (rc) {
+			goto err;
+		}
+		for (size_t i = 0; i < n; i++) {
+			v->data[i] += 0.5 * h * (a->data[i] + an.data[i]);
+			a->data[i] = an.data[i];
+		}
+		*t = t0 + (zsl_real_t)(s + 1) * h;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_ode_verlet(zsl_ode_acc_fn_t f, void *arg, zsl_real_t *t, zsl_real_t h,
+	       size_t steps, struct zsl_vec *x, struct zsl_vec *v,
+	       struct zsl_vec *a)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_ode_verlet_ws_sz(x->sz));
+	rc = zsl_ode_verlet_ws(f, arg, t, h, steps, x, v, a, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
@@ -0,0 +1,739 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <zsl/zsl.h>
+#include <zsl/optimize.h>
+
+/* Returns 0.5 * |r|^2. */
+static zsl_real_t
+zsl_opt_lm_cost(const struct zsl_vec *r)
+{
+	zsl_real_t c = 0.0;
+
+	for (size_t i = 0; i < r->sz; i++) {
+		c += r->data[i] * r->data[i];
+	}
+
+	return 0.5 * c;
+}
+
+/* Evaluates the model at 'p', and forms a = J^T * J and g = J^T * r. */
+static int
+zsl_opt_lm_linearize(const struct zsl_opt_lm *lm, struct zsl_vec *p,
+		     struct zsl_vec *r, struct zsl_mtx *j, struct zsl_mtx *a,
+		     struct zsl_mtx *g)
+{
+	int rc;
+	struct zsl_mtx rm = {
+		.sz_rows = r->sz,
+		.sz_cols = 1,
+		.data = r->data,
+	};
+
+	rc = lm->fn(p, r, j, lm->arg);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_mtx_mult_ex(j, true, j, false, 1.0, 0.0, a);
+	zsl_mtx_mult_ex(j, true, &rm, false, 1.0, 0.0, g);
+
+	return 0;
+}
+
+size_t
+zsl_opt_lm_ws_sz(size_t m, size_t n)
+{
+	/* J, J^T * J and its damped factor, the current and trial residuals,
+	 * and the gradient, step and trial parameters. */
+	return m * n + 2 * n * n + 2 * m + 3 * n;
+}
+
+int
+zsl_opt_lm_ws(const struct zsl_opt_lm *lm, struct zsl_vec *p,
+	      struct zsl_opt_res *res, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = p->sz;
+	size_t iter = 0;
+	size_t evals = 0;
+	zsl_real_t lambda = lm->lambda;
+	zsl_real_t nu = 2.0;
+	zsl_real_t cost, cost_t, gmax, dmax, d, hn, pn, pred, rho;
+	struct zsl_mtx j, a, l, g, h;
+	struct zsl_vec r, rt, pt;
+
+	if ((lm->fn == NULL) || (lm->max_iter == 0) || (n == 0) ||
+	    (lm->m < n)) {
+		return -EINVAL;
+	}
+
+	rc |= zsl_ws_mtx_alloc(ws, &j, lm->m, n);
+	rc |= zsl_ws_mtx_alloc(ws, &a, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &l, n, n);
+	rc |= zsl_ws_mtx_alloc(ws, &g, n, 1);
+	rc |= zsl_ws_mtx_alloc(ws, &h, n, 1);
+	rc |= zsl_ws_vec_alloc(ws, &r, lm->m);
+	rc |= zsl_ws_vec_alloc(ws, &rt, lm->m);
+	rc |= zsl_ws_vec_alloc(ws, &pt, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = zsl_opt_lm_linearize(lm, p, &r, &j, &a, &g);
+	evals++;
+	if (rc) {
+		goto err;
+	}
+	cost = zsl_opt_lm_cost(&r);
+
+	for (;;) {
+		/* Converged once the gradient vanishes, or the fit is exact. */
+		gmax = 0.0;
+		dmax = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			gmax = ZSL_MAX(gmax, ZSL_ABS(g.data[i]));
+			dmax = ZSL_MAX(dmax, a.data[i * n + i]);
+		}
+		if ((gmax <= lm->tol_grad) || (cost == 0.0)) {
+			break;
+		}
+
+		if (iter == lm->max_iter) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+		iter++;
+
+		/* Solve (J^T * J + lambda * D) * h = -g. Parameters that don't
+		 * affect the residuals get a small floor in 'D', so that the
+		 * damped system stays positive-definite. */
+		for (size_t i = 0; i < n * n; i++) {
+			l.data[i] = a.data[i];
+		}
+		for (size_t i = 0; i < n; i++) {
+			d = ZSL_MAX(a.data[i * n + i], 1E-9 * dmax);
+			l.data[i * n + i] += lambda * d;
+			h.data[i] = -g.data[i];
+		}
+		if (zsl_mtx_cholesky(&l, &l) != 0) {
+			/* Only possible with little or no damping. */
+			lambda = (lambda == 0.0) ? 1E-3 : lambda * nu;
+			nu *= 2.0;
+			continue;
+		}
+		zsl_mtx_chol_solve(&l, &h, &h);
+
+		/* Converged once the step is negligible. */
+		hn = 0.0;
+		pn = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			hn += h.data[i] * h.data[i];
+			pn += p->data[i] * p->data[i];
+			pt.data[i] = p->data[i] + h.data[i];
+		}
+		hn = ZSL_SQRT(hn);
+		pn = ZSL_SQRT(pn);
+		if (hn <= lm->tol_step * (pn + lm->tol_step)) {
+			break;
+		}
+
+		/* Compare the actual reduction in cost with that predicted by
+		 * the linear model, 0.5 * h^T * (lambda * D * h - g). */
+		rc = lm->fn(&pt, &rt, NULL, lm->arg);
+		evals++;
+		if (rc) {
+			goto err;
+		}
+		cost_t = zsl_opt_lm_cost(&rt);
+
+		pred = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			d = lambda * ZSL_MAX(a.data[i * n + i], 1E-9 * dmax);
+			pred += h.data[i] * (d * h.data[i] - g.data[i]);
+		}
+		pred *= 0.5;
+		rho = (pred > 0.0) ? (cost - cost_t) / pred : -1.0;
+
+		if ((rho > 0.0) && (cost_t < cost)) {
+			/* Accept the step, and reduce the damping. */
+			zsl_vec_copy(p, &pt);
+			rc = zsl_opt_lm_linearize(lm, p, &r, &j, &a, &g);
+			evals++;
+			if (rc) {
+				goto err;
+			}
+			cost = cost_t;
+			d = 2.0 * rho - 1.0;
+			lambda *= ZSL_MAX(1.0 / 3.0, 1.0 - d * d * d);
+			nu = 2.0;
+		} else {
+			/* Reject the step, and increase the damping. */
+			lambda = (lambda == 0.0) ? 1E-3 : lambda * nu;
+			nu *= 2.0;
+		}
+	}
+
+	if (res != NULL) {
+		res->iter = iter;
+		res->evals = evals;
+		res->f = cost;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+
+	return rc;
+}
+
+int
+zsl_opt_lm(const struct zsl_opt_lm *lm, struct zsl_vec *p,
+	   struct zsl_opt_res *res)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_opt_lm_ws_sz(lm->m, p->sz));
+	rc = zsl_opt_lm_ws(lm, p, res, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+int
+zsl_opt_brent(zsl_opt_fn1_t fn, void *arg, zsl_real_t a, zsl_real_t b,
+	      zsl_real_t tol, size_t max_evals, zsl_real_t *x,
+	      struct zsl_opt_res *res)
+{
+	int rc = 0;
+	/* The golden-section ratio, (3 - sqrt(5)) / 2. */
+	const zsl_real_t cg = 0.3819660112501051;
+	size_t iter = 0;
+	size_t evals = 0;
+	zsl_real_t xm, u, w, v, fx, fu, fw, fv, d, e, p, q, r, t2;
+	bool golden;
+
+	if ((b <= a) || (tol <= 0.0) || (max_evals == 0) || (fn == NULL)) {
+		return -EINVAL;
+	}
+
+	/* 'x' is the lowest point so far, 'w' the second lowest, and 'v' the
+	 * previous value of 'w'. */
+	*x = w = v = a + cg * (b - a);
+	rc = fn(*x, &fx, arg);
+	evals++;
+	if (rc) {
+		return rc;
+	}
+	fw = fv = fx;
+	d = e = 0.0;
+
+	for (;;) {
+		xm = 0.5 * (a + b);
+		t2 = 2.0 * tol;
+		if (ZSL_ABS(*x - xm) <= t2 - 0.5 * (b - a)) {
+			break;
+		}
+		if (evals == max_evals) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+		iter++;
+
+		/* Try a parabola through x, w and v, if the step before last
+		 * was large enough for it to be reliable. */
+		golden = true;
+		if (ZSL_ABS(e) > tol) {
+			r = (*x - w) * (fx - fv);
+			q = (*x - v) * (fx - fw);
+			p = (*x - v) * q - (*x - w) * r;
+			q = 2.0 * (q - r);
+			if (q > 0.0) {
+				p = -p;
+			} else {
+				q = -q;
+			}
+			r = e;
+			e = d;
+			/* Accept it if it lies in (a, b), and moves less than
+			 * half the step before last. */
+			if ((ZSL_ABS(p) < 0.5 * ZSL_ABS(q * r)) &&
+			    (p > q * (a - *x)) && (p < q * (b - *x))) {
+				d = p / q;
+				u = *x + d;
+				if ((u - a < t2) || (b - u < t2)) {
+					d = (xm >= *x) ? tol : -tol;
+				}
+				golden = false;
+			}
+		}
+		if (golden) {
+			e = (*x >= xm) ? a - *x : b - *x;
+			d = cg * e;
+		}
+
+		/* Never evaluate closer than 'tol' to 'x'. */
+		if (ZSL_ABS(d) >= tol) {
+			u = *x + d;
+		} else {
+			u = *x + ((d > 0.0) ? tol : -tol);
+		}
+		rc = fn(u, &fu, arg);
+		evals++;
+		if (rc) {
+			return rc;
+		}
+
+		if (fu <= fx) {
+			if (u >= *x) {
+				a = *x;
+			} else {
+				b = *x;
+			}
+			v = w;
+			fv = fw;
+			w = *x;
+			fw = fx;
+			*x = u;
+			fx = fu;
+		} else {
+			if (u < *x) {
+				a = u;
+			} else {
+				b = u;
+			}
+			if ((fu <= fw) || (w == *x)) {
+				v = w;
+				fv = fw;
+				w = u;
+				fw = fu;
+			} else if ((fu <= fv) || (v == *x) || (v == w)) {
+				v = u;
+				fv = fu;
+			}
+		}
+	}
+
+	if (res != NULL) {
+		res->iter = iter;
+		res->evals = evals;
+		res->f = fx;
+	}
+
+	return rc;
+}
+
+/* Sets y = x + a * d. 'y' may be 'x'. */
+static void
+zsl_opt_axpy(const struct zsl_vec *x, zsl_real_t a, const struct zsl_vec *d,
+	     struct zsl_vec *y)
+{
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = x->data[i] + a * d->data[i];
+	}
+}
+
+/* Returns a view of row 'i' of 'm'. */
+static struct zsl_vec
+zsl_opt_row(struct zsl_mtx *m, size_t i)
+{
+	struct zsl_vec v = {
+		.sz = m->sz_cols,
+		.data = m->data + i * m->sz_cols,
+	};
+
+	return v;
+}
+
+size_t
+zsl_opt_nm_ws_sz(size_t n)
+{
+	/* The n + 1 vertices and their values, the centroid, and the
+	 * reflected and expanded or contracted points. */
+	return (n + 1) * n + (n + 1) + 3 * n;
+}
+
+int
+zsl_opt_nm_ws(const struct zsl_opt_min *min, struct zsl_vec *x,
+	      struct zsl_opt_res *res, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = x->sz;
+	size_t iter = 0;
+	size_t evals = 0;
+	size_t lo, hi, nh;
+	zsl_real_t fr, fe, dx, spread;
+	struct zsl_mtx s;
+	struct zsl_vec fv, xo, xr, xe, vi, vl, vh;
+
+	if ((min->fn == NULL) || (n == 0) || (min->max_evals <= n)) {
+		return -EINVAL;
+	}
+
+	rc |= zsl_ws_mtx_alloc(ws, &s, n + 1, n);
+	rc |= zsl_ws_vec_alloc(ws, &fv, n + 1);
+	rc |= zsl_ws_vec_alloc(ws, &xo, n);
+	rc |= zsl_ws_vec_alloc(ws, &xr, n);
+	rc |= zsl_ws_vec_alloc(ws, &xe, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* The initial simplex: 'x', and one step along each coordinate. */
+	for (size_t i = 0; i <= n; i++) {
+		vi = zsl_opt_row(&s, i);
+		zsl_vec_copy(&vi, x);
+		if (i > 0) {
+			if (min->step != 0.0) {
+				vi.data[i - 1] += min->step;
+			} else if (vi.data[i - 1] != 0.0) {
+				vi.data[i - 1] *= 1.05;
+			} else {
+				vi.data[i - 1] = 0.00025;
+			}
+		}
+		rc = min->fn(&vi, &fv.data[i], NULL, min->arg);
+		evals++;
+		if (rc) {
+			goto err;
+		}
+	}
+
+	for (;;) {
+		/* Find the lowest, highest and next highest vertices. */
+		lo = 0;
+		hi = 0;
+		for (size_t i = 1; i <= n; i++) {
+			if (fv.data[i] < fv.data[lo]) {
+				lo = i;
+			}
+			if (fv.data[i] > fv.data[hi]) {
+				hi = i;
+			}
+		}
+		nh = lo;
+		for (size_t i = 0; i <= n; i++) {
+			if ((i != hi) && (fv.data[i] > fv.data[nh])) {
+				nh = i;
+			}
+		}
+		vl = zsl_opt_row(&s, lo);
+		vh = zsl_opt_row(&s, hi);
+
+		/* Converged once the simplex is small in both 'x' and 'f'. */
+		spread = 0.0;
+		for (size_t i = 0; i <= n; i++) {
+			vi = zsl_opt_row(&s, i);
+			for (size_t k = 0; k < n; k++) {
+				dx = ZSL_ABS(vi.data[k] - vl.data[k]);
+				spread = ZSL_MAX(spread, dx);
+			}
+		}
+		if ((spread <= min->tol) &&
+		    (fv.data[hi] - fv.data[lo] <= min->tol)) {
+			break;
+		}
+
+		if (evals == min->max_evals) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+		iter++;
+
+		/* Reflect the highest vertex through the centroid of the
+		 * others. */
+		zsl_vec_init(&xo);
+		for (size_t i = 0; i <= n; i++) {
+			if (i != hi) {
+				vi = zsl_opt_row(&s, i);
+				zsl_vec_add(&xo, &vi, &xo);
+			}
+		}
+		zsl_vec_scalar_mult(&xo, 1.0 / n);
+		zsl_vec_sub(&xo, &vh, &xe);
+		zsl_opt_axpy(&xo, 1.0, &xe, &xr);
+		rc = min->fn(&xr, &fr, NULL, min->arg);
+		evals++;
+		if (rc) {
+			goto err;
+		}
+
+		if (fr < fv.data[lo]) {
+			/* Try expanding further in the same direction. */
+			if (evals < min->max_evals) {
+				zsl_opt_axpy(&xo, 2.0, &xe, &xe);
+				rc = min->fn(&xe, &fe, NULL, min->arg);
+				evals++;
+				if (rc) {
+					goto err;
+				}
+				if (fe < fr) {
+					zsl_vec_copy(&xr, &xe);
+					fr = fe;
+				}
+			}
+			zsl_vec_copy(&vh, &xr);
+			fv.data[hi] = fr;
+			continue;
+		}
+
+		if (fr < fv.data[nh]) {
+			zsl_vec_copy(&vh, &xr);
+			fv.data[hi] = fr;
+			continue;
+		}
+
+		if (evals == min->max_evals) {
+			if (fr < fv.data[hi]) {
+				zsl_vec_copy(&vh, &xr);
+				fv.data[hi] = fr;
+			}
+			continue;
+		}
+
+		/* Contract towards the centroid, outside the simplex if the
+		 * reflected point is an improvement, or inside if not. */
+		if (fr < fv.data[hi]) {
+			zsl_opt_axpy(&xo, 0.5, &xe, &xe);
+		} else {
+			zsl_opt_axpy(&xo, -0.5, &xe, &xe);
+			fr = fv.data[hi];
+		}
+		rc = min->fn(&xe, &fe, NULL, min->arg);
+		evals++;
+		if (rc) {
+			goto err;
+		}
+		if (fe <= fr) {
+			zsl_vec_copy(&vh, &xe);
+			fv.data[hi] = fe;
+			continue;
+		}
+
+		/* Shrink every vertex towards the lowest. */
+		for (size_t i = 0; (i <= n) && (evals < min->max_evals); i++) {
+			if (i == lo) {
+				continue;
+			}
+			vi = zsl_opt_row(&s, i);
+			zsl_vec_sub(&vi, &vl, &xe);
+			zsl_opt_axpy(&vl, 0.5, &xe, &vi);
+			rc = min->fn(&vi, &fv.data[i], NULL, min->arg);
+			evals++;
+			if (rc) {
+				goto err;
+			}
+		}
+	}
+
+	zsl_vec_copy(x, &vl);
+
+	if (res != NULL) {
+		res->iter = iter;
+		res->evals = evals;
+		res->f = fv.data[lo];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+
+	return rc;
+}
+
+int
+zsl_opt_nm(const struct zsl_opt_min *min, struct zsl_vec *x,
+	   struct zsl_opt_res *res)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_opt_nm_ws_sz(x->sz));
+	rc = zsl_opt_nm_ws(min, x, res, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
+
+size_t
+zsl_opt_lbfgs_ws_sz(size_t n, size_t hist)
+{
+	/* The step and gradient change histories and their scale factors,
+	 * and the gradient, direction, trial point and trial gradient. */
+	return 2 * hist * n + 2 * hist + 4 * n;
+}
+
+int
+zsl_opt_lbfgs_ws(const struct zsl_opt_min *min, struct zsl_vec *x,
+		 struct zsl_opt_res *res, struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t mark = zsl_ws_mark(ws);
+	size_t n = x->sz;
+	size_t m = min->hist;
+	size_t iter = 0;
+	size_t evals = 0;
+	size_t stored = 0;
+	size_t head = 0;
+	size_t k;
+	zsl_real_t f, ft, gd, gmax, sy, yy, t, gamma, beta;
+	struct zsl_mtx sh, yh;
+	struct zsl_vec rho, alpha, g, d, xt, gt, si, yi;
+	bool moved;
+
+	if ((min->fn == NULL) || (n == 0) || (m == 0) ||
+	    (min->max_evals == 0)) {
+		return -EINVAL;
+	}
+
+	rc |= zsl_ws_mtx_alloc(ws, &sh, m, n);
+	rc |= zsl_ws_mtx_alloc(ws, &yh, m, n);
+	rc |= zsl_ws_vec_alloc(ws, &rho, m);
+	rc |= zsl_ws_vec_alloc(ws, &alpha, m);
+	rc |= zsl_ws_vec_alloc(ws, &g, n);
+	rc |= zsl_ws_vec_alloc(ws, &d, n);
+	rc |= zsl_ws_vec_alloc(ws, &xt, n);
+	rc |= zsl_ws_vec_alloc(ws, &gt, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	rc = min->fn(x, &f, &g, min->arg);
+	evals++;
+	if (rc) {
+		goto err;
+	}
+
+	for (;;) {
+		gmax = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			gmax = ZSL_MAX(gmax, ZSL_ABS(g.data[i]));
+		}
+		if (gmax <= min->tol) {
+			break;
+		}
+		if (evals == min->max_evals) {
+			rc = -ENOCONVERGE;
+			break;
+		}
+		iter++;
+
+		/* The two-loop recursion for d = -H * g, newest pair first,
+		 * with the initial inverse Hessian scaled by the newest pair,
+		 * or by the first step length before there is one. */
+		zsl_vec_copy(&d, &g);
+		for (size_t i = 0; i < stored; i++) {
+			k = (head + m - 1 - i) % m;
+			si = zsl_opt_row(&sh, k);
+			yi = zsl_opt_row(&yh, k);
+			zsl_vec_dot(&si, &d, &alpha.data[k]);
+			alpha.data[k] *= rho.data[k];
+			zsl_opt_axpy(&d, -alpha.data[k], &yi, &d);
+		}
+		if (stored > 0) {
+			k = (head + m - 1) % m;
+			yi = zsl_opt_row(&yh, k);
+			zsl_vec_dot(&yi, &yi, &yy);
+			gamma = 1.0 / (rho.data[k] * yy);
+		} else {
+			gamma = ((min->step > 0.0) ? min->step : 1.0) /
+				zsl_vec_norm(&g);
+		}
+		zsl_vec_scalar_mult(&d, -gamma);
+		for (size_t i = stored; i > 0; i--) {
+			k = (head + m - i) % m;
+			si = zsl_opt_row(&sh, k);
+			yi = zsl_opt_row(&yh, k);
+			zsl_vec_dot(&yi, &d, &beta);
+			beta *= rho.data[k];
+			zsl_opt_axpy(&d, -alpha.data[k] - beta, &si, &d);
+		}
+
+		/* Restart from steepest descent if 'd' isn't downhill. */
+		zsl_vec_dot(&g, &d, &gd);
+		if (gd >= 0.0) {
+			stored = 0;
+			zsl_vec_copy(&d, &g);
+			zsl_vec_scalar_mult(&d, -1.0 / zsl_vec_norm(&g));
+			zsl_vec_dot(&g, &d, &gd);
+		}
+
+		/* Backtrack until the Armijo sufficient decrease condition
+		 * holds, minimizing a quadratic fit along 'd' each time. */
+		t = 1.0;
+		for (;;) {
+			zsl_opt_axpy(x, t, &d, &xt);
+			moved = false;
+			for (size_t i = 0; i < n; i++) {
+				moved |= (xt.data[i] != x->data[i]);
+			}
+			if (!moved) {
+				/* No step changes 'x' at working precision. */
+				goto done;
+			}
+			rc = min->fn(&xt, &ft, &gt, min->arg);
+			evals++;
+			if (rc) {
+				goto err;
+			}
+			if (ft <= f + 1E-4 * t * gd) {
+				break;
+			}
+			if (evals == min->max_evals) {
+				rc = -ENOCONVERGE;
+				goto done;
+			}
+			beta = -gd * t * t / (2.0 * (ft - f - gd * t));
+			t = ZSL_MIN(ZSL_MAX(beta, 0.1 * t), 0.5 * t);
+		}
+
+		/* Keep the step and gradient change if the curvature along
+		 * them is positive, replacing the oldest pair. */
+		si = zsl_opt_row(&sh, head);
+		yi = zsl_opt_row(&yh, head);
+		zsl_vec_sub(&xt, x, &si);
+		zsl_vec_sub(&gt, &g, &yi);
+		zsl_vec_dot(&si, &yi, &sy);
+		if (sy > 0.0) {
+			rho.data[head] = 1.0 / sy;
+			head = (head + 1) % m;
+			stored = (stored < m) ? stored + 1 : m;
+		}
+
+		zsl_vec_copy(x, &xt);
+		zsl_vec_copy(&g, &gt);
+		f = ft;
+	}
+
+done:
+	if (res != NULL) {
+		res->iter = iter;
+		res->evals = evals;
+		res->f = f;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+
+	return rc;
+}
+
+int
+zsl_opt_lbfgs(const struct zsl_opt_min *min, struct zsl_vec *x,
+	      struct zsl_opt_res *res)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_opt_lbfgs_ws_sz(x->sz, min->hist));
+	rc = zsl_opt_lbfgs_ws(min, x, res, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
@@ -7,6 +7,7 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
 #include <zsl/orientation/orientation.h>
 
 int zsl_att_to_vec(struct zsl_attitude *a, struct zsl_vec *v)
@@ -23,11 +24,9 @@ int zsl_att_to_euler(struct zsl_attitude *a, struct zsl_euler *e)
 {
 	int rc = 0;
 
-	zsl_real_t d_to_r = 0.01745329252;
-
-	e->x = a->roll * d_to_r;
-	e->y = a->pitch * d_to_r;
-	e->z = a->yaw * d_to_r;
+	e->x = a->roll * ZSL_DEG_TO_RAD;
+	e->y = a->pitch * ZSL_DEG_TO_RAD;
+	e->z = a->yaw * ZSL_DEG_TO_RAD;
 
 	return rc;
 }
@@ -36,32 +35,102 @@ int zsl_att_from_euler(struct zsl_euler *e, struct zsl_attitude *a)
 {
 	int rc = 0;
 
-	zsl_real_t r_to_d = 57.295779513;
-
-	a->roll = e->x * r_to_d;
-	a->pitch = e->y * r_to_d;
-	a->yaw = e->z * r_to_d;
+	a->roll = e->x * ZSL_RAD_TO_DEG;
+	a->pitch = e->y * ZSL_RAD_TO_DEG;
+	a->yaw = e->z * ZSL_RAD_TO_DEG;
 	a->status_bits =  0;
 
 	return rc;
 }
 
-int zsl_att_from_accelmag(struct zsl_vec *accel, struct zsl_vec *mag,
-			  struct zsl_attitude *a)
+int zsl_att_to_euler_batch(const struct zsl_attitude *a, struct zsl_euler *e,
+			   size_t n)
 {
-	int rc = 0;
+	for (size_t i = 0; i < n; i++) {
+		for (size_t c = 0; c < 3; c++) {
+			e[i].idx[c] = a[i].idx[c] * ZSL_DEG_TO_RAD;
+		}
+	}
+
+	return 0;
+}
+
+int zsl_att_from_euler_batch(const struct zsl_euler *e,
+			     struct zsl_attitude *a, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		for (size_t c = 0; c < 3; c++) {
+			a[i].idx[c] = e[i].idx[c] * ZSL_RAD_TO_DEG;
+		}
+		a[i].status_bits = 0;
+	}
+
+	return 0;
+}
+
+int zsl_att_from_quat(struct zsl_quat *q, struct zsl_attitude *a)
+{
+	struct zsl_euler e;
+
+	zsl_quat_to_euler(q, &e);
+
+	return zsl_att_from_euler(&e, a);
+}
+
+int zsl_att_from_quat_batch(struct zsl_quat_batch *qb,
+			    struct zsl_attitude *a)
+{
+	struct zsl_quat q;
+	struct zsl_euler e;
+
+	for (size_t i = 0; i < qb->sz; i++) {
+		zsl_quat_batch_get(qb, i, &q);
+		zsl_quat_to_euler(&q, &e);
+		zsl_att_from_euler(&e, &a[i]);
+	}
+
+	return 0;
+}
 
-	/* ToDo: Check accel and gyro size, etc. */
+/*
+ * Computes the roll and pitch in radians from an accelerometer sample.
+ */
+static void zsl_att_roll_pitch(struct zsl_vec *accel, zsl_real_t *roll,
+			       zsl_real_t *pitch, zsl_real_t *sr,
+			       zsl_real_t *cr)
+{
+	zsl_real_t x = accel->data[0];
+	zsl_real_t y = accel->data[1];
+	zsl_real_t z = accel->data[2];
 
-	// Accel only
 	//               y
 	// roll = atan2(---)
 	//               z
+	*roll = ZSL_ORI_ATAN2(y, z);
+	*sr = ZSL_ORI_SIN(*roll);
+	*cr = ZSL_ORI_COS(*roll);
 
-	// Accel only
 	//                            -x
 	// pitch = atan(-------------------------------)
 	//               y * sin(roll) + z * cos(roll)
+	*pitch = ZSL_ORI_ATAN2(-x, y * *sr + z * *cr);
+}
+
+int zsl_att_from_accelmag(struct zsl_vec *accel, struct zsl_vec *mag,
+			  struct zsl_attitude *a)
+{
+	int rc = 0;
+	zsl_real_t roll, pitch, sr, cr, sp, cp;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((accel->sz != 3) || (mag->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_att_roll_pitch(accel, &roll, &pitch, &sr, &cr);
+	sp = ZSL_ORI_SIN(pitch);
+	cp = ZSL_ORI_COS(pitch);
 
 	// Mag + previous roll/pitch values
 	//                --                                                    --
@@ -69,6 +138,12 @@ int zsl_att_from_accelmag(struct zsl_vec *accel, struct zsl_vec *mag,
 	//          atan2 |------------------------------------------------------|
 	//                | mx * cos(pitch) + my * sin(pitch) * sin(roll) + mz * |
 	//                --            sin(pitch) * cos(roll))                 --
+	a->yaw = ZSL_ORI_ATAN2(mag->data[2] * sr - mag->data[1] * cr,
+			       mag->data[0] * cp + mag->data[1] * sp * sr +
+			       mag->data[2] * sp * cr) * ZSL_RAD_TO_DEG;
+	a->roll = roll * ZSL_RAD_TO_DEG;
+	a->pitch = pitch * ZSL_RAD_TO_DEG;
+	a->status_bits = 0;
 
 	return rc;
 }
@@ -76,16 +151,21 @@ int zsl_att_from_accelmag(struct zsl_vec *accel, struct zsl_vec *mag,
 int zsl_att_from_accel(struct zsl_vec *accel, struct zsl_attitude *a)
 {
 	int rc = 0;
+	zsl_real_t roll, pitch, sr, cr;
 
-	/* ToDo: Check accel size, etc. */
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (accel->sz != 3) {
+		return -EINVAL;
+	}
+#endif
 
-	//               y
-	// roll = atan2(---)
-	//               z
+	zsl_att_roll_pitch(accel, &roll, &pitch, &sr, &cr);
 
-	//                            -x
-	// pitch = atan(-------------------------------)
-	//               y * sin(roll) + z * cos(roll)
+	a->roll = roll * ZSL_RAD_TO_DEG;
+	a->pitch = pitch * ZSL_RAD_TO_DEG;
+	a->yaw = 0.0;
+	a->status_bits = 0;
+	a->status.yaw_invalid = 1;
 
 	return rc;
-}
\ No newline at end of file
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/matrices_fixed.h>
+#include <zsl/orientation/fusion/calibration.h>
+
+#define N ZSL_FUS_CAL_MAGN_N
+
+int zsl_fus_cal_magn_init(struct zsl_fus_cal_magn *c, zsl_real_t field)
+{
+	if (field <= 0.0) {
+		return -EINVAL;
+	}
+
+	c->field = field;
+	c->n = 0;
+	for (size_t i = 0; i < N * (N + 1) / 2; i++) {
+		c->s[i] = 0.0;
+	}
+
+	return 0;
+}
+
+int zsl_fus_cal_magn_feed(struct zsl_fus_cal_magn *c, struct zsl_vec *m)
+{
+	zsl_real_t d[N];
+	zsl_real_t x, y, z;
+	size_t k = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (m->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/*
+	 * Scale to about unit magnitude, so that the quadratic and constant
+	 * terms of the scatter matrix stay within a few orders of magnitude.
+	 */
+	x = m->data[0] / c->field;
+	y = m->data[1] / c->field;
+	z = m->data[2] / c->field;
+
+	/*
+	 * One row of the design matrix for
+	 * a x^2 + b y^2 + c z^2 + 2f yz + 2g xz + 2h xy + 2p x + 2q y + 2r z
+	 * + d = 0.
+	 */
+	d[0] = x * x;
+	d[1] = y * y;
+	d[2] = z * z;
+	d[3] = 2.0 * y * z;
+	d[4] = 2.0 * x * z;
+	d[5] = 2.0 * x * y;
+	d[6] = 2.0 * x;
+	d[7] = 2.0 * y;
+	d[8] = 2.0 * z;
+	d[9] = 1.0;
+
+	for (size_t i = 0; i < N; i++) {
+		for (size_t j = i; j < N; j++) {
+			c->s[k++] += d[i] * d[j];
+		}
+	}
+	c->n++;
+
+	return 0;
+}
+
+int zsl_fus_cal_magn_solve(struct zsl_fus_cal_magn *c, struct zsl_mtx *K,
+			   struct zsl_vec *b)
+{
+	int rc;
+	size_t k = 0;
+	zsl_real_t a[9], ai[9], o[3], u[3], s;
+
+	ZSL_MATRIX_DEF(sm, N, N);
+	ZSL_MATRIX_DEF(sv, N, N);
+	ZSL_VECTOR_DEF(se, N);
+	ZSL_MATRIX_DEF(am, 3, 3);
+	ZSL_MATRIX_DEF(av, 3, 3);
+	ZSL_VECTOR_DEF(ae, 3);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((K->sz_rows != 3) || (K->sz_cols != 3) || (b->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (c->n < N) {
+		return -EINVAL;
+	}
+
+	/* Unpack the upper triangle, which is all the eigensolver reads. */
+	zsl_mtx_init(&sm, NULL);
+	for (size_t i = 0; i < N; i++) {
+		for (size_t j = i; j < N; j++) {
+			sm.data[i * N + j] = c->s[k++];
+		}
+	}
+
+	/* The coefficients are the eigenvector of the smallest eigenvalue. */
+	rc = zsl_mtx_eigen_sym(&sm, &se, &sv);
+	if (rc) {
+		return rc;
+	}
+
+	/* Quadratic form 'a' and linear term 'u' of the ellipsoid. */
+	a[0] = sv.data[0 * N + N - 1];
+	a[4] = sv.data[1 * N + N - 1];
+	a[8] = sv.data[2 * N + N - 1];
+	a[5] = a[7] = sv.data[3 * N + N - 1];
+	a[2] = a[6] = sv.data[4 * N + N - 1];
+	a[1] = a[3] = sv.data[5 * N + N - 1];
+	u[0] = sv.data[6 * N + N - 1];
+	u[1] = sv.data[7 * N + N - 1];
+	u[2] = sv.data[8 * N + N - 1];
+
+	/* Centre o = -a^-1 u, which gives (x - o)' a (x - o) = o' a o - d. */
+	if (zsl_mtx33_inv(a, ai) == 0.0) {
+		return -EINVAL;
+	}
+	zsl_mtx33_mult_vec(ai, u, o);
+	s = -sv.data[9 * N + N - 1];
+	for (size_t i = 0; i < 3; i++) {
+		o[i] = -o[i];
+		s -= o[i] * u[i];
+	}
+
+	/*
+	 * Normalise to (x - o)' a (x - o) = 1. This also fixes the arbitrary
+	 * sign of the eigenvector. 'a' must then be positive definite, and K
+	 * is its symmetric square root.
+	 */
+	if (s == 0.0) {
+		return -EINVAL;
+	}
+	for (size_t i = 0; i < 9; i++) {
+		am.data[i] = a[i] / s;
+	}
+	rc = zsl_mtx_eigen_sym(&am, &ae, &av);
+	if (rc) {
+		return rc;
+	}
+	if (ae.data[2] <= 0.0) {
+		return -EINVAL;
+	}
+	for (size_t i = 0; i < 3; i++) {
+		ae.data[i] = ZSL_SQRT(ae.data[i]);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			s = 0.0;
+			for (size_t l = 0; l < 3; l++) {
+				s += av.data[i * 3 + l] * ae.data[l] *
+				     av.data[j * 3 + l];
+			}
+			K->data[i * 3 + j] = s;
+		}
+	}
+
+	/* Undo the input scaling. */
+	for (size_t i = 0; i < 3; i++) {
+		b->data[i] = o[i] * c->field;
+	}
+
+	return 0;
+}
+
+int zsl_fus_cal_magn_apply(struct zsl_mtx *K, struct zsl_vec *b,
+			   struct zsl_vec *m, struct zsl_vec *mc)
+{
+	zsl_real_t x[3];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((K->sz_rows != 3) || (K->sz_cols != 3) || (b->sz != 3) ||
+	    (m->sz != 3) || (mc->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < 3; i++) {
+		x[i] = m->data[i] - b->data[i];
+	}
+	zsl_mtx33_mult_vec(K->data, x, mc->data);
+
+	return 0;
+}
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/fastmath.h>
+#include <zsl/instrument.h>
+#include <zsl/orientation/fusion/ekf.h>
+
+#define N ZSL_FUS_EKF_N
+
+struct zsl_fus_ekf_cfg zsl_fus_ekf_cfg = {
+	.var_g = 1E-4,
+	.var_b = 1E-8,
+	.var_a = 1E-2,
+	.var_m = 1E-2,
+};
+
+struct zsl_fus_drv zsl_fus_ekf_drv = {
+	.init_handler = zsl_fus_ekf_init,
+	.feed_handler = zsl_fus_ekf_feed,
+	.get_quat_handler = zsl_fus_ekf_get_quat,
+	.error_handler = NULL,
+	.config = &zsl_fus_ekf_cfg,
+	.feed_batch_handler = zsl_fus_ekf_feed_batch,
+};
+
+/*
+ * The filter state, x = [q0 q1 q2 q3 bx by bz], and its covariance. The
+ * handlers take no context, so there is one instance.
+ */
+static zsl_real_t zsl_fus_ekf_x[N] = { 1.0 };
+static zsl_real_t zsl_fus_ekf_p[N][N];
+static struct zsl_fus_clk zsl_fus_ekf_clk = { .dt = 0.01 };
+
+int zsl_fus_ekf_init(uint32_t freq)
+{
+	if (freq == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < N; i++) {
+		zsl_fus_ekf_x[i] = 0.0;
+		for (size_t j = 0; j < N; j++) {
+			zsl_fus_ekf_p[i][j] = 0.0;
+		}
+		/* The orientation is unknown, the bias is assumed small. */
+		zsl_fus_ekf_p[i][i] = i < 4 ? 1E-1 : 1E-4;
+	}
+	zsl_fus_ekf_x[0] = 1.0;
+	zsl_fus_ekf_clk.dt = 1.0 / (zsl_real_t)freq;
+	zsl_fus_ekf_clk.valid = false;
+
+	return 0;
+}
+
+/*
+ * Propagates the state and covariance over 'dt' seconds with the
+ * bias-corrected gyroscope rate. F = [A B; 0 I], so P = F P F' + Q is
+ * expanded by blocks, and only the upper triangle is computed.
+ */
+static void zsl_fus_ekf_predict(const zsl_real_t *g, zsl_real_t dt)
+{
+	zsl_real_t *x = zsl_fus_ekf_x;
+	zsl_real_t (*p)[N] = zsl_fus_ekf_p;
+	zsl_real_t q0 = x[0], q1 = x[1], q2 = x[2], q3 = x[3];
+	zsl_real_t hdt = 0.5 * dt;
+	zsl_real_t a[4][4], b[4][3], fp[N][N];
+	zsl_real_t wx, wy, wz, vq, vb, n;
+
+	wx = (g[0] - x[4]) * hdt;
+	wy = (g[1] - x[5]) * hdt;
+	wz = (g[2] - x[6]) * hdt;
+
+	/* A = I + 0.5 * dt * Omega(w), the state is q = A q. */
+	a[0][0] = 1.0; a[0][1] = -wx;  a[0][2] = -wy;  a[0][3] = -wz;
+	a[1][0] = wx;  a[1][1] = 1.0;  a[1][2] = wz;   a[1][3] = -wy;
+	a[2][0] = wy;  a[2][1] = -wz;  a[2][2] = 1.0;  a[2][3] = wx;
+	a[3][0] = wz;  a[3][1] = wy;   a[3][2] = -wx;  a[3][3] = 1.0;
+
+	/* B = -0.5 * dt * Xi(q), the sensitivity of q to the bias. */
+	b[0][0] = q1 * hdt;  b[0][1] = q2 * hdt;  b[0][2] = q3 * hdt;
+	b[1][0] = -q0 * hdt; b[1][1] = q3 * hdt;  b[1][2] = -q2 * hdt;
+	b[2][0] = -q3 * hdt; b[2][1] = -q0 * hdt; b[2][2] = q1 * hdt;
+	b[3][0] = q2 * hdt;  b[3][1] = -q1 * hdt; b[3][2] = -q0 * hdt;
+
+	for (size_t i = 0; i < 4; i++) {
+		x[i] = a[i][0] * q0 + a[i][1] * q1 + a[i][2] * q2 +
+		       a[i][3] * q3;
+	}
+
+	/* FP = [A B; 0 I] P. */
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < N; j++) {
+			fp[i][j] = a[i][0] * p[0][j] + a[i][1] * p[1][j] +
+				   a[i][2] * p[2][j] + a[i][3] * p[3][j] +
+				   b[i][0] * p[4][j] + b[i][1] * p[5][j] +
+				   b[i][2] * p[6][j];
+		}
+	}
+
+	/* P = FP F' + Q, upper triangle. Rows 4..6 of FP are rows of P. */
+	for (size_t i = 0; i < N; i++) {
+		zsl_real_t *r = i < 4 ? fp[i] : p[i];
+
+		for (size_t j = i; j < 4; j++) {
+			n = r[0] * a[j][0] + r[1] * a[j][1] + r[2] * a[j][2] +
+			    r[3] * a[j][3] + r[4] * b[j][0] + r[5] * b[j][1] +
+			    r[6] * b[j][2];
+			p[i][j] = n;
+		}
+		for (size_t j = i < 4 ? 4 : i; j < N; j++) {
+			p[i][j] = r[j];
+		}
+	}
+
+	/*
+	 * Q: the gyroscope noise maps into q through Xi(q), and
+	 * Xi(q) Xi(q)' = I - q q' for a unit quaternion.
+	 */
+	vq = zsl_fus_ekf_cfg.var_g * hdt * hdt;
+	vb = zsl_fus_ekf_cfg.var_b * dt;
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = i; j < 4; j++) {
+			p[i][j] += vq * ((i == j ? 1.0 : 0.0) - x[i] * x[j]);
+		}
+	}
+	for (size_t i = 4; i < N; i++) {
+		p[i][i] += vb;
+	}
+
+	/* Mirror the upper triangle. */
+	for (size_t i = 1; i < N; i++) {
+		for (size_t j = 0; j < i; j++) {
+			p[i][j] = p[j][i];
+		}
+	}
+}
+
+/*
+ * Applies one scalar measurement with Jacobian row 'h' (only the quaternion
+ * part, the bias columns are zero), innovation 'y' and variance 'r'. With a
+ * scalar measurement the innovation covariance s is a scalar, so no matrix
+ * inverse is needed, and the Joseph form
+ *
+ *   P = (I - k h) P (I - k h)' + k r k'
+ *     = P - k ph' - ph k' + s k k',  with ph = P h' and k = ph / s
+ *
+ * is applied in place to the upper triangle.
+ */
+static void zsl_fus_ekf_update(const zsl_real_t *h, zsl_real_t y,
+			       zsl_real_t r)
+{
+	zsl_real_t (*p)[N] = zsl_fus_ekf_p;
+	zsl_real_t ph[N], k[N];
+	zsl_real_t s;
+
+	for (size_t i = 0; i < N; i++) {
+		ph[i] = p[i][0] * h[0] + p[i][1] * h[1] + p[i][2] * h[2] +
+			p[i][3] * h[3];
+	}
+
+	s = h[0] * ph[0] + h[1] * ph[1] + h[2] * ph[2] + h[3] * ph[3] + r;
+	if (s <= 0.0) {
+		return;
+	}
+
+	for (size_t i = 0; i < N; i++) {
+		k[i] = ph[i] / s;
+		zsl_fus_ekf_x[i] += k[i] * y;
+	}
+
+	for (size_t i = 0; i < N; i++) {
+		for (size_t j = i; j < N; j++) {
+			p[i][j] += s * k[i] * k[j] - k[i] * ph[j] -
+				   ph[i] * k[j];
+			p[j][i] = p[i][j];
+		}
+	}
+}
+
+/*
+ * Renormalises the quaternion part of the state.
+ */
+static void zsl_fus_ekf_norm(void)
+{
+	zsl_real_t *x = zsl_fus_ekf_x;
+	zsl_real_t n = x[0] * x[0] + x[1] * x[1] + x[2] * x[2] + x[3] * x[3];
+
+	if (n > 0.0) {
+		n = zsl_fast_inv_sqrt(n);
+		x[0] *= n;
+		x[1] *= n;
+		x[2] *= n;
+		x[3] *= n;
+	}
+}
+
+/*
+ * Sequential update with the normalised accelerometer reading, which should
+ * match gravity rotated into the sensor frame, R(q)' [0 0 1]'. The
+ * measurement is relinearised after each axis.
+ */
+static void zsl_fus_ekf_update_accel(zsl_real_t ax, zsl_real_t ay,
+				     zsl_real_t az)
+{
+	zsl_real_t *q = zsl_fus_ekf_x;
+	zsl_real_t r = zsl_fus_ekf_cfg.var_a;
+	zsl_real_t h[4];
+
+	h[0] = -2.0 * q[2];
+	h[1] = 2.0 * q[3];
+	h[2] = -2.0 * q[0];
+	h[3] = 2.0 * q[1];
+	zsl_fus_ekf_update(h, ax - 2.0 * (q[1] * q[3] - q[0] * q[2]), r);
+
+	h[0] = 2.0 * q[1];
+	h[1] = 2.0 * q[0];
+	h[2] = 2.0 * q[3];
+	h[3] = 2.0 * q[2];
+	zsl_fus_ekf_update(h, ay - 2.0 * (q[0] * q[1] + q[2] * q[3]), r);
+
+	h[0] = 2.0 * q[0];
+	h[1] = -2.0 * q[1];
+	h[2] = -2.0 * q[2];
+	h[3] = 2.0 * q[3];
+	zsl_fus_ekf_update(h, az - (q[0] * q[0] - q[1] * q[1] -
+				    q[2] * q[2] + q[3] * q[3]), r);
+}
+
+/*
+ * Heading update from the normalised magnetometer reading m. The field is
+ * rotated into the earth frame, f = R(q) m, and its heading atan2(fy, fx)
+ * should be zero (magnetic north along +x).
+ */
+static void zsl_fus_ekf_update_mag(zsl_real_t mx, zsl_real_t my,
+				   zsl_real_t mz)
+{
+	zsl_real_t *q = zsl_fus_ekf_x;
+	zsl_real_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	zsl_real_t fx, fy, n, h[4];
+
+	fx = mx * (1.0 - 2.0 * (q2 * q2 + q3 * q3)) +
+	     2.0 * my * (q1 * q2 - q0 * q3) + 2.0 * mz * (q1 * q3 + q0 * q2);
+	fy = 2.0 * mx * (q1 * q2 + q0 * q3) +
+	     my * (1.0 - 2.0 * (q1 * q1 + q3 * q3)) +
+	     2.0 * mz * (q2 * q3 - q0 * q1);
+
+	/* A vertical field carries no heading. */
+	n = fx * fx + fy * fy;
+	if (n < 1E-6) {
+		return;
+	}
+	n = 2.0 / n;
+
+	/* d(atan2(fy, fx)) = (fx dfy - fy dfx) / (fx^2 + fy^2). */
+	h[0] = n * (fx * (mx * q3 - mz * q1) - fy * (mz * q2 - my * q3));
+	h[1] = n * (fx * (mx * q2 - 2.0 * my * q1 - mz * q0) -
+		    fy * (my * q2 + mz * q3));
+	h[2] = n * (fx * (mx * q1 + mz * q3) -
+		    fy * (-2.0 * mx * q2 + my * q1 + mz * q0));
+	h[3] = n * (fx * (mx * q0 - 2.0 * my * q3 + mz * q2) -
+		    fy * (-2.0 * mx * q3 - my * q0 + mz * q1));
+
+	zsl_fus_ekf_update(h, -ZSL_ORI_ATAN2(fy, fx), zsl_fus_ekf_cfg.var_m);
+}
+
+static int zsl_fus_ekf_step(const zsl_real_t *accel, const zsl_real_t *mag,
+			    const zsl_real_t *gyro, zsl_real_t dt)
+{
+	zsl_real_t ax, ay, az, mx, my, mz, n;
+
+	ZSL_TRACE(ZSL_TRACE_FUS_FEED);
+
+	zsl_fus_ekf_predict(gyro, dt);
+	zsl_fus_ekf_norm();
+
+	ax = ay = az = 0.0;
+	if (accel != NULL) {
+		ax = accel[0];
+		ay = accel[1];
+		az = accel[2];
+	}
+	n = ax * ax + ay * ay + az * az;
+	if (n == 0.0) {
+		return 0;
+	}
+	n = zsl_fast_inv_sqrt(n);
+	zsl_fus_ekf_update_accel(ax * n, ay * n, az * n);
+
+	mx = my = mz = 0.0;
+	if (mag != NULL) {
+		mx = mag[0];
+		my = mag[1];
+		mz = mag[2];
+	}
+	n = mx * mx + my * my + mz * mz;
+	if (n > 0.0) {
+		n = zsl_fast_inv_sqrt(n);
+		zsl_fus_ekf_update_mag(mx * n, my * n, mz * n);
+	}
+
+	zsl_fus_ekf_norm();
+
+	return 0;
+}
+
+int zsl_fus_ekf_feed(struct zsl_vec *accel, struct zsl_vec *mag,
+		     struct zsl_vec *gyro)
+{
+	if (gyro == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((gyro->sz != 3) || (accel != NULL && accel->sz != 3) ||
+	    (mag != NULL && mag->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_fus_ekf_step(accel != NULL ? accel->data : NULL,
+				mag != NULL ? mag->data : NULL, gyro->data,
+				zsl_fus_ekf_clk.dt);
+}
+
+int zsl_fus_ekf_feed_batch(struct zsl_fus_batch *b)
+{
+	int rc;
+	const zsl_real_t *a, *m;
+	zsl_real_t dt;
+	struct zsl_quat q;
+
+	rc = zsl_fus_batch_check(b, &zsl_fus_ekf_clk);
+	if (rc) {
+		return rc;
+	}
+
+	b->qn = 0;
+	for (size_t i = 0; i < b->n; i++) {
+		a = b->accel != NULL ? &b->accel->data[i * 3] : NULL;
+		m = b->mag != NULL ? &b->mag->data[i * 3] : NULL;
+		dt = zsl_fus_clk_tick(&zsl_fus_ekf_clk, b, i);
+		rc = zsl_fus_ekf_step(a, m, &b->gyro->data[i * 3], dt);
+		if (rc) {
+			return rc;
+		}
+
+		if (b->q != NULL && zsl_fus_batch_out(b, i)) {
+			zsl_fus_ekf_get_quat(&q);
+			zsl_quat_batch_set(b->q, b->qn++, &q);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_fus_ekf_get_quat(struct zsl_quat *q)
+{
+	q->r = zsl_fus_ekf_x[0];
+	q->i = zsl_fus_ekf_x[1];
+	q->j = zsl_fus_ekf_x[2];
+	q->k = zsl_fus_ekf_x[3];
+
+	return 0;
+}
+
+int zsl_fus_ekf_get_bias(struct zsl_vec *b)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (b->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	b->data[0] = zsl_fus_ekf_x[4];
+	b->data[1] = zsl_fus_ekf_x[5];
+	b->data[2] = zsl_fus_ekf_x[6];
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/orientation/fusion/fusion.h>
+
+static bool zsl_fus_batch_mtx_ok(struct zsl_mtx *m, size_t n)
+{
+	return m->sz_rows == n && m->sz_cols == 3;
+}
+
+int zsl_fus_batch_check(struct zsl_fus_batch *b, struct zsl_fus_clk *c)
+{
+	size_t qn;
+
+	if (b->gyro == NULL || !zsl_fus_batch_mtx_ok(b->gyro, b->n)) {
+		return -EINVAL;
+	}
+	if (b->accel != NULL && !zsl_fus_batch_mtx_ok(b->accel, b->n)) {
+		return -EINVAL;
+	}
+	if (b->mag != NULL && !zsl_fus_batch_mtx_ok(b->mag, b->n)) {
+		return -EINVAL;
+	}
+
+	if (b->q != NULL) {
+		qn = b->dec == 0 ? (b->n > 0) : b->n / b->dec;
+		if (b->q->sz < qn) {
+			return -EINVAL;
+		}
+	}
+
+	if (b->t != NULL && c != NULL) {
+		for (size_t i = 0; i < b->n; i++) {
+			if (i > 0 && b->t[i] <= b->t[i - 1]) {
+				return -EINVAL;
+			}
+		}
+		if (b->n > 0 && c->valid && b->t[0] <= c->t) {
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+int zsl_fus_feed_batch(struct zsl_fus_drv *drv, struct zsl_fus_batch *b)
+{
+	int rc;
+	struct zsl_vec a, m, g;
+	struct zsl_quat q;
+
+	if (drv->feed_batch_handler != NULL) {
+		rc = drv->feed_batch_handler(b);
+		goto out;
+	}
+
+	if (b->t != NULL) {
+		rc = -ENOTSUP;
+		goto out;
+	}
+
+	rc = zsl_fus_batch_check(b, NULL);
+	if (rc) {
+		goto out;
+	}
+
+	/* Feed each sample through a vector view of its matrix row. */
+	a.sz = m.sz = g.sz = 3;
+	b->qn = 0;
+	for (size_t i = 0; i < b->n; i++) {
+		g.data = &b->gyro->data[i * 3];
+		if (b->accel != NULL) {
+			a.data = &b->accel->data[i * 3];
+		}
+		if (b->mag != NULL) {
+			m.data = &b->mag->data[i * 3];
+		}
+
+		rc = drv->feed_handler(b->accel != NULL ? &a : NULL,
+				       b->mag != NULL ? &m : NULL, &g);
+		if (rc) {
+			goto out;
+		}
+
+		if (b->q != NULL && zsl_fus_batch_out(b, i)) {
+			drv->get_quat_handler(&q);
+			zsl_quat_batch_set(b->q, b->qn++, &q);
+		}
+	}
+
+out:
+	if (rc && drv->error_handler != NULL) {
+		drv->error_handler(drv->config, rc);
+	}
+
+	return rc;
+}
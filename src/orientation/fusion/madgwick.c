@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/instrument.h>
+#include <zsl/orientation/fusion/madgwick.h>
+
+struct zsl_fus_madg_cfg zsl_fus_madg_cfg = {
+	.beta = 0.1,
+};
+
+struct zsl_fus_drv zsl_fus_madg_drv = {
+	.init_handler = zsl_fus_madg_init,
+	.feed_handler = zsl_fus_madg_feed,
+	.get_quat_handler = zsl_fus_madg_get_quat,
+	.error_handler = NULL,
+	.config = &zsl_fus_madg_cfg,
+	.feed_batch_handler = zsl_fus_madg_feed_batch,
+};
+
+/* The filter state. The handlers take no context, so there is one instance. */
+static struct zsl_quat zsl_fus_madg_q = { .r = 1.0 };
+static struct zsl_fus_clk zsl_fus_madg_clk = { .dt = 0.01 };
+
+int zsl_fus_madg_init(uint32_t freq)
+{
+	if (freq == 0) {
+		return -EINVAL;
+	}
+
+	zsl_quat_init(&zsl_fus_madg_q, ZSL_QUAT_TYPE_IDENTITY);
+	zsl_fus_madg_clk.dt = 1.0 / (zsl_real_t)freq;
+	zsl_fus_madg_clk.valid = false;
+
+	return 0;
+}
+
+/*
+ * Computes the gradient step 's' of the objective function for the
+ * normalised accelerometer direction only.
+ */
+static void zsl_fus_madg_grad_imu(const zsl_real_t *q, zsl_real_t ax,
+				  zsl_real_t ay, zsl_real_t az, zsl_real_t *s)
+{
+	zsl_real_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	zsl_real_t _2q0 = 2.0 * q0;
+	zsl_real_t _2q1 = 2.0 * q1;
+	zsl_real_t _2q2 = 2.0 * q2;
+	zsl_real_t _2q3 = 2.0 * q3;
+	zsl_real_t _4q0 = 4.0 * q0;
+	zsl_real_t _4q1 = 4.0 * q1;
+	zsl_real_t _4q2 = 4.0 * q2;
+	zsl_real_t _8q1 = 8.0 * q1;
+	zsl_real_t _8q2 = 8.0 * q2;
+	zsl_real_t q0q0 = q0 * q0;
+	zsl_real_t q1q1 = q1 * q1;
+	zsl_real_t q2q2 = q2 * q2;
+	zsl_real_t q3q3 = q3 * q3;
+
+	s[0] = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+	s[1] = _4q1 * q3q3 - _2q3 * ax + 4.0 * q0q0 * q1 - _2q0 * ay - _4q1 +
+	       _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+	s[2] = 4.0 * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 +
+	       _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+	s[3] = 4.0 * q1q1 * q3 - _2q1 * ax + 4.0 * q2q2 * q3 - _2q2 * ay;
+}
+
+/*
+ * Computes the gradient step 's' of the objective function for the
+ * normalised accelerometer and magnetometer directions.
+ */
+static void zsl_fus_madg_grad_marg(const zsl_real_t *q, zsl_real_t ax,
+				   zsl_real_t ay, zsl_real_t az, zsl_real_t mx,
+				   zsl_real_t my, zsl_real_t mz, zsl_real_t *s)
+{
+	zsl_real_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	zsl_real_t hx, hy, h2, _2bx, _2bz, _4bx, _4bz;
+	zsl_real_t ex, ey, ez;           /* Earth frame errors (accel). */
+	zsl_real_t fx, fy, fz;           /* Earth frame errors (mag). */
+	zsl_real_t _2q0mx = 2.0 * q0 * mx;
+	zsl_real_t _2q0my = 2.0 * q0 * my;
+	zsl_real_t _2q0mz = 2.0 * q0 * mz;
+	zsl_real_t _2q1mx = 2.0 * q1 * mx;
+	zsl_real_t _2q0 = 2.0 * q0;
+	zsl_real_t _2q1 = 2.0 * q1;
+	zsl_real_t _2q2 = 2.0 * q2;
+	zsl_real_t _2q3 = 2.0 * q3;
+	zsl_real_t _2q0q2 = 2.0 * q0 * q2;
+	zsl_real_t _2q2q3 = 2.0 * q2 * q3;
+	zsl_real_t q0q0 = q0 * q0;
+	zsl_real_t q0q1 = q0 * q1;
+	zsl_real_t q0q2 = q0 * q2;
+	zsl_real_t q0q3 = q0 * q3;
+	zsl_real_t q1q1 = q1 * q1;
+	zsl_real_t q1q2 = q1 * q2;
+	zsl_real_t q1q3 = q1 * q3;
+	zsl_real_t q2q2 = q2 * q2;
+	zsl_real_t q2q3 = q2 * q3;
+	zsl_real_t q3q3 = q3 * q3;
+
+	/* Reference direction of the earth's magnetic field. */
+	hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 +
+	     _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+	hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 -
+	     my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+	h2 = hx * hx + hy * hy;
+	_2bx = h2 > 0.0 ? h2 * zsl_fast_inv_sqrt(h2) : 0.0;
+	_2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 -
+	       mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+	_4bx = 2.0 * _2bx;
+	_4bz = 2.0 * _2bz;
+
+	/* Shared objective function terms. */
+	ex = 2.0 * q1q3 - _2q0q2 - ax;
+	ey = 2.0 * q0q1 + _2q2q3 - ay;
+	ez = 1.0 - 2.0 * q1q1 - 2.0 * q2q2 - az;
+	fx = _2bx * (0.5 - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+	fy = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+	fz = _2bx * (q0q2 + q1q3) + _2bz * (0.5 - q1q1 - q2q2) - mz;
+
+	s[0] = -_2q2 * ex + _2q1 * ey - _2bz * q2 * fx +
+	       (-_2bx * q3 + _2bz * q1) * fy + _2bx * q2 * fz;
+	s[1] = _2q3 * ex + _2q0 * ey - 4.0 * q1 * ez + _2bz * q3 * fx +
+	       (_2bx * q2 + _2bz * q0) * fy + (_2bx * q3 - _4bz * q1) * fz;
+	s[2] = -_2q0 * ex + _2q3 * ey - 4.0 * q2 * ez +
+	       (-_4bx * q2 - _2bz * q0) * fx + (_2bx * q1 + _2bz * q3) * fy +
+	       (_2bx * q0 - _4bz * q2) * fz;
+	s[3] = _2q1 * ex + _2q2 * ey + (-_4bx * q3 + _2bz * q1) * fx +
+	       (-_2bx * q0 + _2bz * q2) * fy + _2bx * q1 * fz;
+}
+
+static int zsl_fus_madg_step(const zsl_real_t *accel, const zsl_real_t *mag,
+			     const zsl_real_t *gyro, zsl_real_t dt)
+{
+	zsl_real_t *q = zsl_fus_madg_q.idx;
+	zsl_real_t qd[4], s[4];
+	zsl_real_t ax, ay, az, mx, my, mz, gx, gy, gz, n;
+	zsl_real_t beta = zsl_fus_madg_cfg.beta;
+
+	ZSL_TRACE(ZSL_TRACE_FUS_FEED);
+
+	gx = gyro[0];
+	gy = gyro[1];
+	gz = gyro[2];
+
+	/* Rate of change of the quaternion from the gyroscope, 0.5 * q * w. */
+	qd[0] = 0.5 * (-q[1] * gx - q[2] * gy - q[3] * gz);
+	qd[1] = 0.5 * (q[0] * gx + q[2] * gz - q[3] * gy);
+	qd[2] = 0.5 * (q[0] * gy - q[1] * gz + q[3] * gx);
+	qd[3] = 0.5 * (q[0] * gz + q[1] * gy - q[2] * gx);
+
+	ax = ay = az = 0.0;
+	if (accel != NULL) {
+		ax = accel[0];
+		ay = accel[1];
+		az = accel[2];
+	}
+	n = ax * ax + ay * ay + az * az;
+
+	/* Apply a feedback step when there is an accelerometer reading. */
+	if (n > 0.0) {
+		n = zsl_fast_inv_sqrt(n);
+		ax *= n;
+		ay *= n;
+		az *= n;
+
+		mx = my = mz = 0.0;
+		if (mag != NULL) {
+			mx = mag[0];
+			my = mag[1];
+			mz = mag[2];
+		}
+		n = mx * mx + my * my + mz * mz;
+
+		if (n > 0.0) {
+			n = zsl_fast_inv_sqrt(n);
+			zsl_fus_madg_grad_marg(q, ax, ay, az, mx * n, my * n,
+					       mz * n, s);
+		} else {
+			zsl_fus_madg_grad_imu(q, ax, ay, az, s);
+		}
+
+		n = s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3];
+		if (n > 0.0) {
+			n = beta * zsl_fast_inv_sqrt(n);
+			qd[0] -= n * s[0];
+			qd[1] -= n * s[1];
+			qd[2] -= n * s[2];
+			qd[3] -= n * s[3];
+		}
+	}
+
+	/* Integrate, and renormalise. */
+	q[0] += qd[0] * dt;
+	q[1] += qd[1] * dt;
+	q[2] += qd[2] * dt;
+	q[3] += qd[3] * dt;
+
+	return zsl_quat_to_unit_fast(&zsl_fus_madg_q, &zsl_fus_madg_q);
+}
+
+int zsl_fus_madg_feed(struct zsl_vec *accel, struct zsl_vec *mag,
+		      struct zsl_vec *gyro)
+{
+	if (gyro == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((gyro->sz != 3) || (accel != NULL && accel->sz != 3) ||
+	    (mag != NULL && mag->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_fus_madg_step(accel != NULL ? accel->data : NULL,
+				 mag != NULL ? mag->data : NULL, gyro->data,
+				 zsl_fus_madg_clk.dt);
+}
+
+int zsl_fus_madg_feed_batch(struct zsl_fus_batch *b)
+{
+	int rc;
+	const zsl_real_t *a, *m;
+	zsl_real_t dt;
+	struct zsl_quat q;
+
+	rc = zsl_fus_batch_check(b, &zsl_fus_madg_clk);
+	if (rc) {
+		return rc;
+	}
+
+	b->qn = 0;
+	for (size_t i = 0; i < b->n; i++) {
+		a = b->accel != NULL ? &b->accel->data[i * 3] : NULL;
+		m = b->mag != NULL ? &b->mag->data[i * 3] : NULL;
+		dt = zsl_fus_clk_tick(&zsl_fus_madg_clk, b, i);
+		rc = zsl_fus_madg_step(a, m, &b->gyro->data[i * 3], dt);
+		if (rc) {
+			return rc;
+		}
+
+		if (b->q != NULL && zsl_fus_batch_out(b, i)) {
+			zsl_fus_madg_get_quat(&q);
+			zsl_quat_batch_set(b->q, b->qn++, &q);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_fus_madg_get_quat(struct zsl_quat *q)
+{
+	*q = zsl_fus_madg_q;
+
+	return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/instrument.h>
+#include <zsl/orientation/fusion/mahony.h>
+
+struct zsl_fus_mahn_cfg zsl_fus_mahn_cfg = {
+	.kp = 1.0,
+	.ki = 0.0,
+};
+
+struct zsl_fus_drv zsl_fus_mahn_drv = {
+	.init_handler = zsl_fus_mahn_init,
+	.feed_handler = zsl_fus_mahn_feed,
+	.get_quat_handler = zsl_fus_mahn_get_quat,
+	.error_handler = NULL,
+	.config = &zsl_fus_mahn_cfg,
+	.feed_batch_handler = zsl_fus_mahn_feed_batch,
+};
+
+/* The filter state. The handlers take no context, so there is one instance. */
+static struct zsl_quat zsl_fus_mahn_q = { .r = 1.0 };
+static zsl_real_t zsl_fus_mahn_integ[3];
+static struct zsl_fus_clk zsl_fus_mahn_clk = { .dt = 0.01 };
+
+int zsl_fus_mahn_init(uint32_t freq)
+{
+	if (freq == 0) {
+		return -EINVAL;
+	}
+
+	zsl_quat_init(&zsl_fus_mahn_q, ZSL_QUAT_TYPE_IDENTITY);
+	zsl_fus_mahn_integ[0] = 0.0;
+	zsl_fus_mahn_integ[1] = 0.0;
+	zsl_fus_mahn_integ[2] = 0.0;
+	zsl_fus_mahn_clk.dt = 1.0 / (zsl_real_t)freq;
+	zsl_fus_mahn_clk.valid = false;
+
+	return 0;
+}
+
+static int zsl_fus_mahn_step(const zsl_real_t *accel, const zsl_real_t *mag,
+			     const zsl_real_t *gyro, zsl_real_t dt)
+{
+	zsl_real_t *q = zsl_fus_mahn_q.idx;
+	zsl_real_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	zsl_real_t ax, ay, az, mx, my, mz, gx, gy, gz, n;
+	zsl_real_t vx, vy, vz, ex, ey, ez;
+
+	ZSL_TRACE(ZSL_TRACE_FUS_FEED);
+
+	gx = gyro[0];
+	gy = gyro[1];
+	gz = gyro[2];
+
+	ax = ay = az = 0.0;
+	if (accel != NULL) {
+		ax = accel[0];
+		ay = accel[1];
+		az = accel[2];
+	}
+	n = ax * ax + ay * ay + az * az;
+
+	/* Apply PI feedback when there is an accelerometer reading. */
+	if (n > 0.0) {
+		n = zsl_fast_inv_sqrt(n);
+		ax *= n;
+		ay *= n;
+		az *= n;
+
+		/* Estimated direction of gravity, halved. */
+		vx = q1 * q3 - q0 * q2;
+		vy = q0 * q1 + q2 * q3;
+		vz = q0 * q0 - 0.5 + q3 * q3;
+
+		/* Error is the cross product of measured and estimated. */
+		ex = ay * vz - az * vy;
+		ey = az * vx - ax * vz;
+		ez = ax * vy - ay * vx;
+
+		mx = my = mz = 0.0;
+		if (mag != NULL) {
+			mx = mag[0];
+			my = mag[1];
+			mz = mag[2];
+		}
+		n = mx * mx + my * my + mz * mz;
+
+		if (n > 0.0) {
+			zsl_real_t hx, hy, h2, bx, bz, wx, wy, wz;
+			zsl_real_t q0q1 = q0 * q1;
+			zsl_real_t q0q2 = q0 * q2, q0q3 = q0 * q3;
+			zsl_real_t q1q1 = q1 * q1, q1q2 = q1 * q2;
+			zsl_real_t q1q3 = q1 * q3, q2q2 = q2 * q2;
+			zsl_real_t q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+			n = zsl_fast_inv_sqrt(n);
+			mx *= n;
+			my *= n;
+			mz *= n;
+
+			/* Reference direction of the earth's magnetic field. */
+			hx = 2.0 * (mx * (0.5 - q2q2 - q3q3) +
+				    my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+			hy = 2.0 * (mx * (q1q2 + q0q3) +
+				    my * (0.5 - q1q1 - q3q3) +
+				    mz * (q2q3 - q0q1));
+			h2 = hx * hx + hy * hy;
+			bx = h2 > 0.0 ? h2 * zsl_fast_inv_sqrt(h2) : 0.0;
+			bz = 2.0 * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) +
+				    mz * (0.5 - q1q1 - q2q2));
+
+			/* Estimated direction of the magnetic field, halved. */
+			wx = bx * (0.5 - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+			wy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+			wz = bx * (q0q2 + q1q3) + bz * (0.5 - q1q1 - q2q2);
+
+			ex += my * wz - mz * wy;
+			ey += mz * wx - mx * wz;
+			ez += mx * wy - my * wx;
+		}
+
+		/* Integral feedback, which estimates the gyroscope bias. */
+		if (zsl_fus_mahn_cfg.ki > 0.0) {
+			n = 2.0 * zsl_fus_mahn_cfg.ki * dt;
+			zsl_fus_mahn_integ[0] += n * ex;
+			zsl_fus_mahn_integ[1] += n * ey;
+			zsl_fus_mahn_integ[2] += n * ez;
+			gx += zsl_fus_mahn_integ[0];
+			gy += zsl_fus_mahn_integ[1];
+			gz += zsl_fus_mahn_integ[2];
+		} else {
+			zsl_fus_mahn_integ[0] = 0.0;
+			zsl_fus_mahn_integ[1] = 0.0;
+			zsl_fus_mahn_integ[2] = 0.0;
+		}
+
+		/* Proportional feedback. */
+		n = 2.0 * zsl_fus_mahn_cfg.kp;
+		gx += n * ex;
+		gy += n * ey;
+		gz += n * ez;
+	}
+
+	/* Integrate q += 0.5 * q * w * dt, and renormalise. */
+	gx *= 0.5 * dt;
+	gy *= 0.5 * dt;
+	gz *= 0.5 * dt;
+	q[0] += -q1 * gx - q2 * gy - q3 * gz;
+	q[1] += q0 * gx + q2 * gz - q3 * gy;
+	q[2] += q0 * gy - q1 * gz + q3 * gx;
+	q[3] += q0 * gz + q1 * gy - q2 * gx;
+
+	return zsl_quat_to_unit_fast(&zsl_fus_mahn_q, &zsl_fus_mahn_q);
+}
+
+int zsl_fus_mahn_feed(struct zsl_vec *accel, struct zsl_vec *mag,
+		      struct zsl_vec *gyro)
+{
+	if (gyro == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((gyro->sz != 3) || (accel != NULL && accel->sz != 3) ||
+	    (mag != NULL && mag->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_fus_mahn_step(accel != NULL ? accel->data : NULL,
+				 mag != NULL ? mag->data : NULL, gyro->data,
+				 zsl_fus_mahn_clk.dt);
+}
+
+int zsl_fus_mahn_feed_batch(struct zsl_fus_batch *b)
+{
+	int rc;
+	const zsl_real_t *a, *m;
+	zsl_real_t dt;
+	struct zsl_quat q;
+
+	rc = zsl_fus_batch_check(b, &zsl_fus_mahn_clk);
+	if (rc) {
+		return rc;
+	}
+
+	b->qn = 0;
+	for (size_t i = 0; i < b->n; i++) {
+		a = b->accel != NULL ? &b->accel->data[i * 3] : NULL;
+		m = b->mag != NULL ? &b->mag->data[i * 3] : NULL;
+		dt = zsl_fus_clk_tick(&zsl_fus_mahn_clk, b, i);
+		rc = zsl_fus_mahn_step(a, m, &b->gyro->data[i * 3], dt);
+		if (rc) {
+			return rc;
+		}
+
+		if (b->q != NULL && zsl_fus_batch_out(b, i)) {
+			zsl_fus_mahn_get_quat(&q);
+			zsl_quat_batch_set(b->q, b->qn++, &q);
+		}
+	}
+
+	return 0;
+}
+
+int zsl_fus_mahn_get_quat(struct zsl_quat *q)
+{
+	*q = zsl_fus_mahn_q;
+
+	return 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/orientation/fusion/queue.h>
+
+int zsl_fus_queue_drain(struct zsl_fus_queue *q, struct zsl_fus_drv *drv,
+			size_t max)
+{
+	int rc;
+	uint32_t tail = q->tail;
+	uint32_t level;
+	size_t i, n, fed = 0;
+	struct zsl_mtx a, m, g;
+	struct zsl_fus_batch b = { 0 };
+
+	level = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE) - tail;
+	if (level > q->peak) {
+		q->peak = level;
+	}
+	if (max != 0 && level > max) {
+		level = max;
+	}
+
+	a.sz_cols = m.sz_cols = g.sz_cols = 3;
+	b.accel = q->accel != NULL ? &a : NULL;
+	b.mag = q->mag != NULL ? &m : NULL;
+	b.gyro = &g;
+
+	while (fed < level) {
+		/* The longest contiguous run, up to the end of the storage. */
+		i = tail & (q->sz - 1);
+		n = level - fed;
+		if (n > q->sz - i) {
+			n = q->sz - i;
+		}
+
+		a.sz_rows = m.sz_rows = g.sz_rows = n;
+		b.n = n;
+		b.t = q->t != NULL ? &q->t[i] : NULL;
+		g.data = &q->gyro[3 * i];
+		if (q->accel != NULL) {
+			a.data = &q->accel[3 * i];
+		}
+		if (q->mag != NULL) {
+			m.data = &q->mag[3 * i];
+		}
+
+		rc = zsl_fus_feed_batch(drv, &b);
+
+		/* Release the run to the producer. */
+		tail += n;
+		__atomic_store_n(&q->tail, tail, __ATOMIC_RELEASE);
+		if (rc) {
+			return rc;
+		}
+		fed += n;
+	}
+
+	return (int)fed;
+}
@@ -7,7 +7,9 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices_fixed.h>
 #include <zsl/orientation/quaternions.h>
 
 /**
@@ -83,6 +85,19 @@ int zsl_quat_to_unit_d(struct zsl_quat *q)
 	return zsl_quat_to_unit(q, q);
 }
 
+int zsl_quat_to_unit_fast(struct zsl_quat *q, struct zsl_quat *qn)
+{
+	zsl_real_t m2 = q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k;
+	zsl_real_t s = m2 > 0.0 ? zsl_fast_inv_sqrt(m2) : 0.0;
+
+	qn->r = q->r * s;
+	qn->i = q->i * s;
+	qn->j = q->j * s;
+	qn->k = q->k * s;
+
+	return 0;
+}
+
 bool zsl_quat_is_unit(struct zsl_quat *q)
 {
 	zsl_real_t unit_len;
@@ -119,41 +134,98 @@ int zsl_quat_mult(struct zsl_quat *qa, struct zsl_quat *qb,
 {
 	int rc = 0;
 
-	qm->i = qa->r * qb->i + qa->i * qb->r + qa->j * qb->k - qa->k * qb->j;
-	qm->j = qa->r * qb->j - qa->i * qb->k + qa->j * qb->r + qa->k * qb->i;
-	qm->k = qa->r * qb->k + qa->i * qb->j - qa->j * qb->i + qa->k * qb->r;
-	qm->r = qa->r * qb->r - qa->i * qb->i - qa->j * qb->j - qa->k * qb->k;
+	/* Load the inputs first, so that qm can alias qa or qb. */
+	zsl_real_t ar = qa->r, ai = qa->i, aj = qa->j, ak = qa->k;
+	zsl_real_t br = qb->r, bi = qb->i, bj = qb->j, bk = qb->k;
+
+	qm->i = ar * bi + ai * br + aj * bk - ak * bj;
+	qm->j = ar * bj - ai * bk + aj * br + ak * bi;
+	qm->k = ar * bk + ai * bj - aj * bi + ak * br;
+	qm->r = ar * br - ai * bi - aj * bj - ak * bk;
 
 	return rc;
 }
 
+/* Rotates the 3-vector at 'v' into 'vr', which may be the same memory. */
+static inline void zsl_quat_rot_vec_raw(const struct zsl_quat *q,
+					const zsl_real_t *v, zsl_real_t *vr)
+{
+	zsl_real_t tx, ty, tz;
+	zsl_real_t vx = v[0], vy = v[1], vz = v[2];
+
+	/* t = 2 * (ijk x v) */
+	tx = 2.0 * (q->j * vz - q->k * vy);
+	ty = 2.0 * (q->k * vx - q->i * vz);
+	tz = 2.0 * (q->i * vy - q->j * vx);
+
+	/* v' = v + r * t + (ijk x t) */
+	vr[0] = vx + q->r * tx + (q->j * tz - q->k * ty);
+	vr[1] = vy + q->r * ty + (q->k * tx - q->i * tz);
+	vr[2] = vz + q->r * tz + (q->i * ty - q->j * tx);
+}
+
+int zsl_quat_rot_vec(struct zsl_quat *q, struct zsl_vec *v,
+		     struct zsl_vec *vr)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != 3) || (vr->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_quat_rot_vec_raw(q, v->data, vr->data);
+
+	return 0;
+}
+
+int zsl_quat_rot_vec_batch(struct zsl_quat *q, struct zsl_mtx *v,
+			   struct zsl_mtx *vr)
+{
+	zsl_real_t m[9];
+	zsl_real_t x[3];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz_cols != 3) || (vr->sz_cols != 3) ||
+	    (v->sz_rows != vr->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Build the rotation matrix once, then 9 multiplies per vector. */
+	zsl_quat_to_rot_mtx33(q, m);
+	for (size_t n = 0; n < v->sz_rows; n++) {
+		x[0] = v->data[3 * n];
+		x[1] = v->data[3 * n + 1];
+		x[2] = v->data[3 * n + 2];
+		zsl_mtx33_mult_vec(m, x, &vr->data[3 * n]);
+	}
+
+	return 0;
+}
+
 int zsl_quat_exp(struct zsl_quat *q, struct zsl_quat *qe)
 {
 	int rc = 0;
 
-	ZSL_VECTOR_DEF(v, 3);
+	zsl_real_t v[3];        /* XYZ vector using ijk from q. */
 	zsl_real_t vmag;        /* Magnitude of v. */
 	zsl_real_t vsin;        /* Sine of vm. */
 	zsl_real_t rexp;        /* Exponent of q->r. */
 
-	/* Populate the XYZ vector using ijk from q. */
-	v.data[0] = q->i;
-	v.data[1] = q->j;
-	v.data[2] = q->k;
+	v[0] = q->i;
+	v[1] = q->j;
+	v[2] = q->k;
 
-	/* Calculate magnitude of v. */
-	vmag = zsl_vec_norm(&v);
+	/* Normalise v to unit vector, getting its magnitude from one pass. */
+	vmag = zsl_vec3_to_unit(v, v);
 
-	/* Normalise v to unit vector. */
-	zsl_vec_to_unit(&v);
-
-	vsin = ZSL_SIN(vmag);
+	vsin = ZSL_ORI_SIN(vmag);
 	rexp = ZSL_EXP(q->r);
 
-	qe->r = ZSL_COS(vmag) * rexp;
-	qe->i = v.data[0] * vsin * rexp;
-	qe->j = v.data[1] * vsin * rexp;
-	qe->k = v.data[2] * vsin * rexp;
+	qe->r = ZSL_ORI_COS(vmag) * rexp;
+	qe->i = v[0] * vsin * rexp;
+	qe->j = v[1] * vsin * rexp;
+	qe->k = v[2] * vsin * rexp;
 
 	return rc;
 }
@@ -162,27 +234,27 @@ int zsl_quat_log(struct zsl_quat *q, struct zsl_quat *ql)
 {
 	int rc = 0;
 
-	ZSL_VECTOR_DEF(v, 3);   /* Vector part of unit quat q. */
+	zsl_real_t v[3];        /* Vector part of unit quat q. */
 	zsl_real_t qmag;        /* Magnitude of q. */
 	zsl_real_t racos;       /* Acos of q->r/qmag. */
 
 	/* Populate the XYZ vector using ijk from q. */
-	v.data[0] = q->i;
-	v.data[1] = q->j;
-	v.data[2] = q->k;
+	v[0] = q->i;
+	v[1] = q->j;
+	v[2] = q->k;
 
 	/* Normalise v to unit vector. */
-	zsl_vec_to_unit(&v);
+	zsl_vec3_to_unit(v, v);
 
 	/* Calculate magnitude of input quat. */
 	qmag = zsl_quat_magn(q);
 
-	racos = ZSL_COS(q->r / qmag);
+	racos = ZSL_ORI_COS(q->r / qmag);
 
 	ql->r = ZSL_LOG(qmag);
-	ql->i = v.data[0] * racos;
-	ql->j = v.data[1] * racos;
-	ql->k = v.data[2] * racos;
+	ql->i = v[0] * racos;
+	ql->j = v[1] * racos;
+	ql->k = v[2] * racos;
 
 	return rc;
 }
@@ -271,12 +343,31 @@ err:
 	return rc;
 }
 
+/*
+ * Normalised linear interpolation, qi = |(1 - t) qa + t qb|.
+ */
+static void zsl_quat_nlerp(struct zsl_quat *qa, struct zsl_quat *qb,
+			   zsl_real_t t, struct zsl_quat *qi)
+{
+	zsl_real_t n = 0.0;
+
+	for (size_t c = 0; c < 4; c++) {
+		qi->idx[c] = qa->idx[c] + t * (qb->idx[c] - qa->idx[c]);
+		n += qi->idx[c] * qi->idx[c];
+	}
+
+	n = 1.0 / ZSL_SQRT(n);
+	for (size_t c = 0; c < 4; c++) {
+		qi->idx[c] *= n;
+	}
+}
+
 int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 		   zsl_real_t t, struct zsl_quat *qi)
 {
 	int rc = 0;
 	struct zsl_quat q1, q2; /* Interim quats. */
-	zsl_real_t dot;         /* qa->r * qb->r. */
+	zsl_real_t dot;         /* qa . qb, the cosine of phi. */
 	zsl_real_t phi;         /* arccos(dot). */
 	zsl_real_t phi_s;       /* sin(phi). */
 	zsl_real_t phi_st;      /* sin(phi * (t)). */
@@ -289,24 +380,36 @@ int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 	 * and popping values on the stack with trivial calls to helper functions.
 	 */
 
-	/* TODO: When t = 0.0 or t = 1.0, just memcpy qa or qb. */
-
 	/* Make sure t is in a valid range. */
 	t = t < 0.0 ? 0.0 : t;
 	t = t > 1.0 ? 1.0 : t;
 
-	dot = qa->r * qb->r;
+	/* The end points need no interpolation. */
+	if (t == 0.0) {
+		*qi = *qa;
+		return rc;
+	}
+	if (t == 1.0) {
+		*qi = *qb;
+		return rc;
+	}
+
+	dot = qa->r * qb->r + qa->i * qb->i + qa->j * qb->j + qa->k * qb->k;
 
 	/*
-	 * Slerp often has problems with angles close to zero. Consider handling
-	 * those edge cases slightly differently?
+	 * Close together, sin(phi) approaches zero and nlerp is
+	 * indistinguishable from slerp.
 	 */
+	if (dot > ZSL_QUAT_NLERP_DOT) {
+		zsl_quat_nlerp(qa, qb, t, qi);
+		return rc;
+	}
 
 	/* Calculate these once before-hand. */
-	phi = ZSL_ACOS(dot);
-	phi_s = ZSL_SIN(phi);
-	phi_st = ZSL_SIN(phi * t);
-	phi_smt = ZSL_SIN(phi * (1.0 - t));
+	phi = ZSL_ORI_ACOS(dot);
+	phi_s = ZSL_ORI_SIN(phi);
+	phi_st = ZSL_ORI_SIN(phi * t);
+	phi_smt = ZSL_ORI_SIN(phi * (1.0 - t));
 
 	/* Calculate intermediate quats. */
 	q1.r = phi_smt / phi_s * qa->r;
@@ -327,11 +430,162 @@ int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 	return rc;
 }
 
+int zsl_quat_slerp_step_init(struct zsl_quat_slerp_step *s,
+			     struct zsl_quat *qa, struct zsl_quat *qb, size_t n)
+{
+	zsl_real_t dot, d;
+
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	s->n = n;
+	s->i = 0;
+	s->qa = *qa;
+	s->qb = *qb;
+
+	dot = qa->r * qb->r + qa->i * qb->i + qa->j * qb->j + qa->k * qb->k;
+	s->nlerp = dot > ZSL_QUAT_NLERP_DOT;
+
+	if (s->nlerp) {
+		/* Step linearly, and normalise each output. */
+		for (size_t k = 0; k < 4; k++) {
+			s->qo.idx[k] = (qb->idx[k] - qa->idx[k]) /
+				       (zsl_real_t)(n - 1);
+		}
+		return 0;
+	}
+
+	/* qo = (qb - dot qa) / sin(phi). */
+	dot = dot < -1.0 ? -1.0 : dot;
+	d = 1.0 / ZSL_SQRT(1.0 - dot * dot);
+	for (size_t k = 0; k < 4; k++) {
+		s->qo.idx[k] = (qb->idx[k] - dot * qa->idx[k]) * d;
+	}
+
+	s->c = ZSL_ORI_COS(ZSL_ORI_ACOS(dot) / (zsl_real_t)(n - 1));
+	s->s = ZSL_SQRT(1.0 - s->c * s->c);
+	s->ck = 1.0;
+	s->sk = 0.0;
+
+	return 0;
+}
+
+int zsl_quat_slerp_step_next(struct zsl_quat_slerp_step *s,
+			     struct zsl_quat *q)
+{
+	zsl_real_t ck;
+
+	if (s->i >= s->n) {
+		return -EINVAL;
+	}
+
+	if (++s->i == s->n) {
+		*q = s->qb;
+		return 0;
+	}
+
+	if (s->nlerp) {
+		zsl_quat_nlerp(&s->qa, &s->qa, 0.0, q);
+		for (size_t k = 0; k < 4; k++) {
+			s->qa.idx[k] += s->qo.idx[k];
+		}
+		return 0;
+	}
+
+	for (size_t k = 0; k < 4; k++) {
+		q->idx[k] = s->ck * s->qa.idx[k] + s->sk * s->qo.idx[k];
+	}
+
+	/* Rotate (ck, sk) by the step angle. */
+	ck = s->ck * s->c - s->sk * s->s;
+	s->sk = s->sk * s->c + s->ck * s->s;
+	s->ck = ck;
+
+	return 0;
+}
+
+int zsl_quat_integrate(struct zsl_quat *q, struct zsl_vec *w, zsl_real_t dt,
+		       struct zsl_quat *qi)
+{
+	zsl_real_t hx, hy, hz, t2, t, c, sn;
+	struct zsl_quat dq;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (w->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Half of the rotation vector, and its squared angle. */
+	hx = 0.5 * dt * w->data[0];
+	hy = 0.5 * dt * w->data[1];
+	hz = 0.5 * dt * w->data[2];
+	t2 = hx * hx + hy * hy + hz * hz;
+
+	/* exp(h) = [cos(t), sin(t) / t * h], with t = |h|. */
+	if (t2 < ZSL_QUAT_INTEG_TAYLOR) {
+		c = 1.0 - t2 * (0.5 - t2 * (1.0 / 24.0));
+		sn = 1.0 - t2 * (1.0 / 6.0 - t2 * (1.0 / 120.0));
+	} else {
+		t = ZSL_SQRT(t2);
+		c = ZSL_ORI_COS(t);
+		sn = ZSL_ORI_SIN(t) / t;
+	}
+
+	dq.r = c;
+	dq.i = sn * hx;
+	dq.j = sn * hy;
+	dq.k = sn * hz;
+
+	return zsl_quat_mult(q, &dq, qi);
+}
+
+int zsl_quat_integ_init(struct zsl_quat_integ *s, struct zsl_quat *q,
+			size_t renorm)
+{
+	s->q = *q;
+	s->renorm = renorm;
+	s->count = 0;
+
+	return 0;
+}
+
+int zsl_quat_integ_step(struct zsl_quat_integ *s, struct zsl_vec *w,
+			zsl_real_t dt)
+{
+	int rc;
+
+	rc = zsl_quat_integrate(&s->q, w, dt, &s->q);
+	if (rc) {
+		return rc;
+	}
+
+	if (s->renorm && ++s->count >= s->renorm) {
+		zsl_quat_to_unit_d(&s->q);
+		s->count = 0;
+	}
+
+	return 0;
+}
+
 int zsl_quat_to_euler(struct zsl_quat *q, struct zsl_euler *e)
 {
 	int rc = 0;
+	zsl_real_t sp;
 
-	/* TODO: Convert quaternion to euler. */
+	/* Z-Y-X (yaw, pitch, roll) sequence, with x = roll and z = yaw. */
+	e->x = ZSL_ORI_ATAN2(2.0 * (q->r * q->i + q->j * q->k),
+			     1.0 - 2.0 * (q->i * q->i + q->j * q->j));
+
+	/* Clamp to avoid NaN from rounding at +/-90 degrees of pitch. */
+	sp = 2.0 * (q->r * q->j - q->k * q->i);
+	sp = sp > 1.0 ? 1.0 : sp;
+	sp = sp < -1.0 ? -1.0 : sp;
+	e->y = ZSL_ORI_ASIN(sp);
+
+	e->z = ZSL_ORI_ATAN2(2.0 * (q->r * q->k + q->i * q->j),
+			     1.0 - 2.0 * (q->j * q->j + q->k * q->k));
 
 	return rc;
 }
@@ -355,9 +609,74 @@ int zsl_quat_from_euler(struct zsl_euler *e, struct zsl_quat *q)
 	return rc;
 }
 
+void zsl_quat_to_rot_mtx33(const struct zsl_quat *q, zsl_real_t *m)
+{
+	zsl_real_t i2 = 2.0 * q->i;
+	zsl_real_t j2 = 2.0 * q->j;
+	zsl_real_t k2 = 2.0 * q->k;
+	zsl_real_t ii = q->i * i2, jj = q->j * j2, kk = q->k * k2;
+	zsl_real_t ij = q->i * j2, ik = q->i * k2, jk = q->j * k2;
+	zsl_real_t ri = q->r * i2, rj = q->r * j2, rk = q->r * k2;
+
+	m[0] = 1.0 - jj - kk;
+	m[1] = ij - rk;
+	m[2] = ik + rj;
+	m[3] = ij + rk;
+	m[4] = 1.0 - ii - kk;
+	m[5] = jk - ri;
+	m[6] = ik - rj;
+	m[7] = jk + ri;
+	m[8] = 1.0 - ii - jj;
+}
+
+void zsl_quat_from_rot_mtx33(const zsl_real_t *m, struct zsl_quat *q)
+{
+	zsl_real_t tr = m[0] + m[4] + m[8];
+	zsl_real_t s;
+
+	/*
+	 * Solve for the largest component first, so that the divisor is never
+	 * smaller than 0.5 (Shepperd's method).
+	 */
+	if (tr > m[0] && tr > m[4] && tr > m[8]) {
+		s = 2.0 * ZSL_SQRT(1.0 + tr);
+		q->r = 0.25 * s;
+		q->i = (m[7] - m[5]) / s;
+		q->j = (m[2] - m[6]) / s;
+		q->k = (m[3] - m[1]) / s;
+	} else if (m[0] > m[4] && m[0] > m[8]) {
+		s = 2.0 * ZSL_SQRT(1.0 + m[0] - m[4] - m[8]);
+		q->r = (m[7] - m[5]) / s;
+		q->i = 0.25 * s;
+		q->j = (m[1] + m[3]) / s;
+		q->k = (m[2] + m[6]) / s;
+	} else if (m[4] > m[8]) {
+		s = 2.0 * ZSL_SQRT(1.0 + m[4] - m[0] - m[8]);
+		q->r = (m[2] - m[6]) / s;
+		q->i = (m[1] + m[3]) / s;
+		q->j = 0.25 * s;
+		q->k = (m[5] + m[7]) / s;
+	} else {
+		s = 2.0 * ZSL_SQRT(1.0 + m[8] - m[0] - m[4]);
+		q->r = (m[3] - m[1]) / s;
+		q->i = (m[2] + m[6]) / s;
+		q->j = (m[5] + m[7]) / s;
+		q->k = 0.25 * s;
+	}
+
+	/* Keep the same hemisphere as the 4x4 conversion (r >= 0). */
+	if (q->r < 0.0) {
+		q->r = -q->r;
+		q->i = -q->i;
+		q->j = -q->j;
+		q->k = -q->k;
+	}
+}
+
 int zsl_quat_to_rot_mtx(struct zsl_quat *q, struct zsl_mtx *m)
 {
 	int rc = 0;
+	zsl_real_t r[9];
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the rotation matrix has an appropriate shape and size. */
@@ -381,26 +700,15 @@ int zsl_quat_to_rot_mtx(struct zsl_quat *q, struct zsl_mtx *m)
 	 *  --            --
 	 */
 
-	zsl_mtx_init(m, NULL);
-
-	/* Note: This can be optimised by pre-calculating shared values. */
-
-	/* Row 0. */
-	zsl_mtx_set(m, 0, 0, 1.0 - 2.0 * (q->j * q->j + q->k * q->k));
-	zsl_mtx_set(m, 0, 1, 2.0 * (q->i * q->j - q->k * q->r));
-	zsl_mtx_set(m, 0, 2, 2.0 * (q->i * q->k + q->j * q->r));
-
-	/* Row 1. */
-	zsl_mtx_set(m, 1, 0, 2.0 * (q->i * q->j + q->k * q->r));
-	zsl_mtx_set(m, 1, 1, 1.0 - 2.0 * (q->i * q->i + q->k * q->k));
-	zsl_mtx_set(m, 1, 2, 2.0 * (q->j * q->k - q->i * q->r));
+	zsl_quat_to_rot_mtx33(q, r);
 
-	/* Row 2. */
-	zsl_mtx_set(m, 2, 0, 2.0 * (q->i * q->k - q->j * q->r));
-	zsl_mtx_set(m, 2, 1, 2.0 * (q->j * q->k + q->i * q->r));
-	zsl_mtx_set(m, 2, 2, 1.0 - 2.0 * (q->i * q->i + q->j * q->j));
-
-	zsl_mtx_set(m, 3, 3, 1.0);
+	zsl_mtx_init(m, NULL);
+	for (size_t row = 0; row < 3; row++) {
+		for (size_t col = 0; col < 3; col++) {
+			m->data[4 * row + col] = r[3 * row + col];
+		}
+	}
+	m->data[15] = 1.0;
 
 err:
 	return rc;
@@ -410,7 +718,7 @@ int zsl_quat_from_rot_mtx(struct zsl_mtx *m, struct zsl_quat *q)
 {
 	int rc = 0;
 	zsl_real_t ichk = 0.0;
-	zsl_real_t r4;
+	zsl_real_t r[9];
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the rotation matrix has an appropriate shape and size. */
@@ -427,13 +735,86 @@ int zsl_quat_from_rot_mtx(struct zsl_mtx *m, struct zsl_quat *q)
 		goto err;
 	}
 
-	/* Convert rotation matrix to unit quaternion. */
-	q->r = ZSL_SQRT(m->data[0] + m->data[5] + m->data[10] + m->data[15]) / 2.0;
-	r4 = q->r * 4.0;
-	q->i = (m->data[9] - m->data[6]) / r4;
-	q->j = (m->data[2] - m->data[8]) / r4;
-	q->k = (m->data[4] - m->data[1]) / r4;
+	for (size_t row = 0; row < 3; row++) {
+		for (size_t col = 0; col < 3; col++) {
+			r[3 * row + col] = m->data[4 * row + col];
+		}
+	}
+	zsl_quat_from_rot_mtx33(r, q);
 
 err:
 	return rc;
-}
\ No newline at end of file
+}
+
+int zsl_quat_batch_get(struct zsl_quat_batch *qb, size_t idx,
+		       struct zsl_quat *q)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (idx >= qb->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t c = 0; c < 4; c++) {
+		q->idx[c] = qb->data[c * qb->sz + idx];
+	}
+
+	return 0;
+}
+
+int zsl_quat_batch_set(struct zsl_quat_batch *qb, size_t idx,
+		       struct zsl_quat *q)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (idx >= qb->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t c = 0; c < 4; c++) {
+		qb->data[c * qb->sz + idx] = q->idx[c];
+	}
+
+	return 0;
+}
+
+int zsl_quat_batch_mult(struct zsl_quat_batch *qa, struct zsl_quat_batch *qb,
+			struct zsl_quat_batch *qm)
+{
+	size_t n = qa->sz;
+	zsl_real_t *ar, *ai, *aj, *ak;
+	zsl_real_t *br, *bi, *bj, *bk;
+	zsl_real_t *mr, *mi, *mj, *mk;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((qb->sz != n) || (qm->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	ar = qa->data;
+	ai = ar + n;
+	aj = ai + n;
+	ak = aj + n;
+	br = qb->data;
+	bi = br + n;
+	bj = bi + n;
+	bk = bj + n;
+	mr = qm->data;
+	mi = mr + n;
+	mj = mi + n;
+	mk = mj + n;
+
+	for (size_t b = 0; b < n; b++) {
+		mi[b] = ar[b] * bi[b] + ai[b] * br[b] + aj[b] * bk[b] -
+			ak[b] * bj[b];
+		mj[b] = ar[b] * bj[b] - ai[b] * bk[b] + aj[b] * br[b] +
+			ak[b] * bi[b];
+		mk[b] = ar[b] * bk[b] + ai[b] * bj[b] - aj[b] * bi[b] +
+			ak[b] * br[b];
+		mr[b] = ar[b] * br[b] - ai[b] * bi[b] - aj[b] * bj[b] -
+			ak[b] * bk[b];
+	}
+
+	return 0;
+}
@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/packed.h>
+#include <zsl/workspace.h>
+
+/* Returns the offset in 'data' of the first stored entry of row 'i', which
+ * is column 0 for lower and symmetric matrices, and column i for upper. */
+static inline size_t
+zsl_pkmtx_row(const struct zsl_pkmtx *p, size_t i)
+{
+	if (p->type == ZSL_PKMTX_UPPER) {
+		return i * (2 * p->sz - i + 1) / 2;
+	}
+
+	return i * (i + 1) / 2;
+}
+
+/* Returns true if entry (i, j) lies in the stored triangle of 'p'. */
+static inline bool
+zsl_pkmtx_stored(const struct zsl_pkmtx *p, size_t i, size_t j)
+{
+	return (p->type == ZSL_PKMTX_UPPER) ? (j >= i) : (j <= i);
+}
+
+/* Sets y = a * x for the n x n symmetric matrix whose lower triangle is
+ * packed at 'a'. Each stored entry is read once, and used for both of the
+ * entries it represents. */
+static void
+zsl_pkmtx_symv(const zsl_real_t *a, size_t n, const zsl_real_t *x,
+	       zsl_real_t *y)
+{
+	zsl_real_t s, xi;
+
+	for (size_t i = 0; i < n; i++) {
+		y[i] = 0.0;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		s = 0.0;
+		xi = x[i];
+		for (size_t j = 0; j < i; j++) {
+			s += a[j] * x[j];
+			y[j] += a[j] * xi;
+		}
+		y[i] += s + a[i] * xi;
+		a += i + 1;
+	}
+}
+
+int
+zsl_pkmtx_init(struct zsl_pkmtx *p)
+{
+	memset(p->data, 0, ZSL_PKMTX_SZ(p->sz) * sizeof(zsl_real_t));
+
+	return 0;
+}
+
+int
+zsl_pkmtx_from_mtx(const struct zsl_mtx *m, struct zsl_pkmtx *p)
+{
+	const size_t n = p->sz;
+	zsl_real_t *d = p->data;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is n x n. */
+	if ((m->sz_rows != n) || (m->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		if (p->type == ZSL_PKMTX_UPPER) {
+			memcpy(d, &m->data[i * n + i],
+			       (n - i) * sizeof(zsl_real_t));
+			d += n - i;
+		} else {
+			memcpy(d, &m->data[i * n],
+			       (i + 1) * sizeof(zsl_real_t));
+			d += i + 1;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_to_mtx(const struct zsl_pkmtx *p, struct zsl_mtx *m)
+{
+	const size_t n = p->sz;
+	zsl_real_t x;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is n x n. */
+	if ((m->sz_rows != n) || (m->sz_cols != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			zsl_pkmtx_get(p, i, j, &x);
+			m->data[i * n + j] = x;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_get(const struct zsl_pkmtx *p, size_t i, size_t j, zsl_real_t *x)
+{
+	size_t t;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= p->sz) || (j >= p->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (!zsl_pkmtx_stored(p, i, j)) {
+		if (p->type != ZSL_PKMTX_SYM) {
+			*x = 0.0;
+			return 0;
+		}
+		/* Read the mirrored entry of a symmetric matrix. */
+		t = i;
+		i = j;
+		j = t;
+	}
+
+	*x = p->data[zsl_pkmtx_row(p, i) + j -
+		     ((p->type == ZSL_PKMTX_UPPER) ? i : 0)];
+
+	return 0;
+}
+
+int
+zsl_pkmtx_set(struct zsl_pkmtx *p, size_t i, size_t j, zsl_real_t x)
+{
+	size_t t;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= p->sz) || (j >= p->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (!zsl_pkmtx_stored(p, i, j)) {
+		if (p->type != ZSL_PKMTX_SYM) {
+			return -EINVAL;
+		}
+		t = i;
+		i = j;
+		j = t;
+	}
+
+	p->data[zsl_pkmtx_row(p, i) + j -
+		((p->type == ZSL_PKMTX_UPPER) ? i : 0)] = x;
+
+	return 0;
+}
+
+int
+zsl_pkmtx_mult_vec(const struct zsl_pkmtx *p, const struct zsl_vec *v,
+		   struct zsl_vec *w)
+{
+	const size_t n = p->sz;
+	const zsl_real_t *a = p->data;
+	zsl_real_t s;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != n) || (w->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	switch (p->type) {
+	case ZSL_PKMTX_SYM:
+		zsl_pkmtx_symv(a, n, v->data, w->data);
+		break;
+	case ZSL_PKMTX_LOWER:
+		for (size_t i = 0; i < n; i++) {
+			s = 0.0;
+			for (size_t j = 0; j <= i; j++) {
+				s += a[j] * v->data[j];
+			}
+			w->data[i] = s;
+			a += i + 1;
+		}
+		break;
+	case ZSL_PKMTX_UPPER:
+		for (size_t i = 0; i < n; i++) {
+			s = 0.0;
+			for (size_t j = i; j < n; j++) {
+				s += a[j - i] * v->data[j];
+			}
+			w->data[i] = s;
+			a += n - i;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_mult_mtx(const struct zsl_pkmtx *p, const struct zsl_mtx *mb,
+		   struct zsl_mtx *mc)
+{
+	const size_t n = p->sz;
+	const size_t k = mb->sz_cols;
+	const zsl_real_t *a = p->data;
+	size_t j0, j1;
+	zsl_real_t *ci;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((mb->sz_rows != n) || (mc->sz_rows != n) || (mc->sz_cols != k)) {
+		return -EINVAL;
+	}
+#endif
+
+	memset(mc->data, 0, n * k * sizeof(zsl_real_t));
+
+	/* Row i of 'mc' accumulates the rows of 'mb' scaled by the stored
+	 * entries of row i, and for symmetric matrices, row j of 'mc' also
+	 * accumulates row i of 'mb' scaled by the mirrored entry. */
+	for (size_t i = 0; i < n; i++) {
+		j0 = (p->type == ZSL_PKMTX_UPPER) ? i : 0;
+		j1 = (p->type == ZSL_PKMTX_UPPER) ? n : i + 1;
+		ci = &mc->data[i * k];
+		for (size_t j = j0; j < j1; j++, a++) {
+			for (size_t c = 0; c < k; c++) {
+				ci[c] += *a * mb->data[j * k + c];
+			}
+			if ((p->type == ZSL_PKMTX_SYM) && (j < i)) {
+				for (size_t c = 0; c < k; c++) {
+					mc->data[j * k + c] +=
+						*a * mb->data[i * k + c];
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_congruence(const struct zsl_mtx *f, const struct zsl_pkmtx *p,
+		     struct zsl_pkmtx *po)
+{
+	int rc;
+	const size_t m = f->sz_rows;
+	const size_t n = f->sz_cols;
+	zsl_real_t *t;
+	zsl_real_t *d = po->data;
+	zsl_real_t s;
+
+	if ((p->type != ZSL_PKMTX_SYM) || (po->type != ZSL_PKMTX_SYM)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((p->sz != n) || (po->sz != m)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_SCRATCH_DEF(ws, n);
+	size_t mark = zsl_ws_mark(ws);
+
+	t = zsl_ws_alloc(ws, n);
+	if (t == NULL) {
+		rc = -ENOMEM;
+		goto err;
+	}
+	rc = 0;
+
+	/* Row i of f * p is (p * f_i^T)^T, since 'p' is symmetric, and entry
+	 * (i, j) of the output is its dot product with row j of 'f'. */
+	for (size_t i = 0; i < m; i++) {
+		zsl_pkmtx_symv(p->data, n, &f->data[i * n], t);
+		for (size_t j = 0; j <= i; j++) {
+			s = 0.0;
+			for (size_t c = 0; c < n; c++) {
+				s += t[c] * f->data[j * n + c];
+			}
+			*d++ = s;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int
+zsl_pkmtx_rank1(struct zsl_pkmtx *p, zsl_real_t alpha,
+		const struct zsl_vec *v)
+{
+	zsl_real_t *a = p->data;
+	zsl_real_t s;
+
+	if (p->type != ZSL_PKMTX_SYM) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != p->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < p->sz; i++) {
+		s = alpha * v->data[i];
+		for (size_t j = 0; j <= i; j++) {
+			a[j] += s * v->data[j];
+		}
+		a += i + 1;
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_trsv(const struct zsl_pkmtx *p, const struct zsl_vec *b,
+	       struct zsl_vec *x)
+{
+	const size_t n = p->sz;
+	const zsl_real_t *a;
+	zsl_real_t s;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	switch (p->type) {
+	case ZSL_PKMTX_LOWER:
+		/* Forward substitution, reading each row once. */
+		a = p->data;
+		for (size_t i = 0; i < n; i++) {
+			s = b->data[i];
+			for (size_t j = 0; j < i; j++) {
+				s -= a[j] * x->data[j];
+			}
+			if (a[i] == 0.0) {
+				return -ESINGULAR;
+			}
+			x->data[i] = s / a[i];
+			a += i + 1;
+		}
+		break;
+	case ZSL_PKMTX_UPPER:
+		/* Back substitution, starting from the last row. */
+		for (size_t i = n; i-- > 0;) {
+			a = &p->data[zsl_pkmtx_row(p, i)];
+			s = b->data[i];
+			for (size_t j = i + 1; j < n; j++) {
+				s -= a[j - i] * x->data[j];
+			}
+			if (a[0] == 0.0) {
+				return -ESINGULAR;
+			}
+			x->data[i] = s / a[0];
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_cholesky(const struct zsl_pkmtx *p, struct zsl_pkmtx *l)
+{
+	const size_t n = p->sz;
+	const zsl_real_t *pi;
+	zsl_real_t *li, *lj;
+	zsl_real_t x;
+
+	if (p->type != ZSL_PKMTX_SYM) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (l->sz != n) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Cholesky-Banachiewicz, row by row, as in zsl_mtx_cholesky. Entry
+	 * (i, j) of 'p' is read before the same entry of 'l' is written, and
+	 * not read again, so 'l' and 'p' may share their data. */
+	for (size_t i = 0; i < n; i++) {
+		pi = &p->data[i * (i + 1) / 2];
+		li = &l->data[i * (i + 1) / 2];
+		for (size_t j = 0; j <= i; j++) {
+			lj = &l->data[j * (j + 1) / 2];
+			x = pi[j];
+			for (size_t k = 0; k < j; k++) {
+				x -= li[k] * lj[k];
+			}
+
+			if (i == j) {
+				/* Also catches NaN values. */
+				if (!(x > 0.0)) {
+					return -ENOTPOSDEF;
+				}
+				li[i] = ZSL_SQRT(x);
+			} else {
+				li[j] = x / lj[j];
+			}
+		}
+	}
+
+	l->type = ZSL_PKMTX_LOWER;
+
+	return 0;
+}
+
+int
+zsl_pkmtx_chol_solve(const struct zsl_pkmtx *l, const struct zsl_vec *b,
+		     struct zsl_vec *x)
+{
+	int rc;
+	const zsl_real_t *a;
+	zsl_real_t xi;
+
+	if (l->type != ZSL_PKMTX_LOWER) {
+		return -EINVAL;
+	}
+
+	/* Solve L * y = b, into 'x'. */
+	rc = zsl_pkmtx_trsv(l, b, x);
+	if (rc) {
+		return rc;
+	}
+
+	/* Solve L^T * x = y, a column of L^T being a row of the packed data,
+	 * so each solved value is subtracted from the values above it. */
+	for (size_t i = l->sz; i-- > 0;) {
+		a = &l->data[i * (i + 1) / 2];
+		xi = x->data[i] / a[i];
+		x->data[i] = xi;
+		for (size_t j = 0; j < i; j++) {
+			x->data[j] -= a[j] * xi;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_pkmtx_chol_update(struct zsl_pkmtx *l, const struct zsl_vec *v)
+{
+	int rc;
+	const size_t n = l->sz;
+	zsl_real_t r, c, s;
+	zsl_real_t *lkk, *lik;
+	struct zsl_vec w;
+
+	if (l->type != ZSL_PKMTX_LOWER) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != n) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The update consumes its input vector, so work on a copy of 'v'. */
+	ZSL_SCRATCH_DEF(ws, n);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_vec_alloc(ws, &w, n);
+	if (rc) {
+		goto err;
+	}
+	zsl_vec_copy(&w, v);
+
+	/* Apply a sequence of Givens rotations, one column at a time. */
+	for (size_t k = 0; k < n; k++) {
+		lkk = &l->data[k * (k + 1) / 2 + k];
+		r = ZSL_SQRT(*lkk * *lkk + w.data[k] * w.data[k]);
+		c = r / *lkk;
+		s = w.data[k] / *lkk;
+		*lkk = r;
+
+		for (size_t i = k + 1; i < n; i++) {
+			lik = &l->data[i * (i + 1) / 2 + k];
+			*lik = (*lik + s * w.data[i]) / c;
+			w.data[i] = c * w.data[i] - s * *lik;
+		}
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
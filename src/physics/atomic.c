@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <zsl/zsl.h>
 #include <zsl/physics/atomic.h>
+#include <zsl/physics/misc.h>
 
 int
 zsl_phy_atom_nucl_radius(uint8_t a, zsl_real_t *r)
@@ -81,6 +82,20 @@ zsl_phy_atom_rad_decay(zsl_real_t qi, zsl_real_t t, zsl_real_t lambda,
 	return 0;
 }
 
+int
+zsl_phy_atom_rad_decay_vec(zsl_real_t qi, zsl_real_t t0, zsl_real_t dt,
+			   zsl_real_t lambda, struct zsl_vec *qf)
+{
+	if (t0 < 0 || dt < 0 || lambda < 0) {
+		for (size_t k = 0; k < qf->sz; k++) {
+			qf->data[k] = NAN;
+		}
+		return -EINVAL;
+	}
+
+	return zsl_phy_misc_exp_curve(qi, 0.0, lambda, t0, dt, qf);
+}
+
 int
 zsl_phy_atom_bragg(uint8_t n, zsl_real_t theta, zsl_real_t lambda,
 		   zsl_real_t *d)
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/physics/circuit.h>
+
+/*
+ * Node 'k' is row k - 1 of the system, and ground (node 0) has no row, so
+ * its entries are dropped.
+ */
+static void
+zsl_phy_circ_stamp(struct zsl_phy_circ *c, size_t i, size_t j, zsl_real_t x)
+{
+	if ((i != 0) && (j != 0)) {
+		c->lu[(i - 1) * c->n + (j - 1)] += x;
+	}
+}
+
+static void
+zsl_phy_circ_src(struct zsl_phy_circ *c, size_t i, zsl_real_t x)
+{
+	if (i != 0) {
+		c->rhs[i - 1] += x;
+	}
+}
+
+/* Conductance stamp of 'g' between nodes 'a' and 'b'. */
+static void
+zsl_phy_circ_cond(struct zsl_phy_circ *c, size_t a, size_t b, zsl_real_t g)
+{
+	zsl_phy_circ_stamp(c, a, a, g);
+	zsl_phy_circ_stamp(c, b, b, g);
+	zsl_phy_circ_stamp(c, a, b, -g);
+	zsl_phy_circ_stamp(c, b, a, -g);
+}
+
+/* Incidence stamp of a branch current unknown, at row/column 'br'. */
+static void
+zsl_phy_circ_branch(struct zsl_phy_circ *c, size_t a, size_t b, size_t br)
+{
+	zsl_real_t *r = &c->lu[br * c->n];
+
+	if (a != 0) {
+		c->lu[(a - 1) * c->n + br] += 1.0;
+		r[a - 1] += 1.0;
+	}
+	if (b != 0) {
+		c->lu[(b - 1) * c->n + br] -= 1.0;
+		r[b - 1] -= 1.0;
+	}
+}
+
+/* Builds and factors the MNA matrix for step size 'h', or 0 for DC. */
+static int
+zsl_phy_circ_fact(struct zsl_phy_circ *c, zsl_real_t h)
+{
+	int rc;
+	struct zsl_phy_circ_elem *e;
+	struct zsl_mtx m = { .sz_rows = c->n, .sz_cols = c->n, .data = c->lu };
+	struct zsl_vec p = { .sz = c->n, .data = c->perm };
+
+	for (size_t i = 0; i < c->n * c->n; i++) {
+		c->lu[i] = 0.0;
+	}
+
+	for (size_t k = 0; k < c->n_elem; k++) {
+		e = &c->elem[k];
+		switch (e->type) {
+		case ZSL_PHY_CIRC_R:
+			zsl_phy_circ_cond(c, e->a, e->b, 1.0 / e->val);
+			break;
+		case ZSL_PHY_CIRC_C:
+			/* Open at DC. */
+			if (h > 0.0) {
+				zsl_phy_circ_cond(c, e->a, e->b,
+						  2.0 * e->val / h);
+			}
+			break;
+		case ZSL_PHY_CIRC_L:
+			/* v - 2L/h * i = -v' - 2L/h * i'. Shorted at DC. */
+			zsl_phy_circ_branch(c, e->a, e->b, e->br);
+			if (h > 0.0) {
+				c->lu[e->br * c->n + e->br] =
+					-2.0 * e->val / h;
+			}
+			break;
+		case ZSL_PHY_CIRC_V:
+			zsl_phy_circ_branch(c, e->a, e->b, e->br);
+			break;
+		case ZSL_PHY_CIRC_I:
+			break;
+		}
+	}
+
+	c->h = h;
+	rc = zsl_mtx_lu_fact_d(&m, &p);
+	c->valid = rc == 0;
+
+	return rc;
+}
+
+/*
+ * Builds the right-hand side for step size 'h', or 0 for DC, from the
+ * sources and the previous state, then solves the system and updates the
+ * state. If 'be' is true, the step is instead a backward Euler step of h / 2,
+ * which uses the same matrix but does not depend on the previous capacitor
+ * currents or inductor voltages.
+ */
+static int
+zsl_phy_circ_solve(struct zsl_phy_circ *c, zsl_real_t h, bool be)
+{
+	int rc;
+	struct zsl_phy_circ_elem *e;
+	struct zsl_mtx m = { .sz_rows = c->n, .sz_cols = c->n, .data = c->lu };
+	struct zsl_vec p = { .sz = c->n, .data = c->perm };
+	struct zsl_mtx b = { .sz_rows = c->n, .sz_cols = 1, .data = c->rhs };
+	struct zsl_mtx x = { .sz_rows = c->n, .sz_cols = 1, .data = c->x };
+	zsl_real_t g, va, vb, ieq;
+
+	if (!c->valid || (c->h != h)) {
+		rc = zsl_phy_circ_fact(c, h);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	for (size_t i = 0; i < c->n; i++) {
+		c->rhs[i] = 0.0;
+	}
+
+	for (size_t k = 0; k < c->n_elem; k++) {
+		e = &c->elem[k];
+		switch (e->type) {
+		case ZSL_PHY_CIRC_C:
+			/* i = g * v - (g * v' + i'), with g = 2C / h. */
+			if (h > 0.0) {
+				g = 2.0 * e->val / h;
+				ieq = g * e->v + (be ? 0.0 : e->i);
+				zsl_phy_circ_src(c, e->a, ieq);
+				zsl_phy_circ_src(c, e->b, -ieq);
+			}
+			break;
+		case ZSL_PHY_CIRC_L:
+			if (h > 0.0) {
+				g = 2.0 * e->val / h;
+				c->rhs[e->br] = -(be ? 0.0 : e->v) - g * e->i;
+			}
+			break;
+		case ZSL_PHY_CIRC_V:
+			c->rhs[e->br] = e->val;
+			break;
+		case ZSL_PHY_CIRC_I:
+			zsl_phy_circ_src(c, e->a, e->val);
+			zsl_phy_circ_src(c, e->b, -e->val);
+			break;
+		default:
+			break;
+		}
+	}
+
+	rc = zsl_mtx_lu_solve(&m, &p, &b, &x);
+	if (rc) {
+		return rc;
+	}
+
+	/* Update the state of each element. */
+	for (size_t k = 0; k < c->n_elem; k++) {
+		e = &c->elem[k];
+		va = e->a != 0 ? c->x[e->a - 1] : 0.0;
+		vb = e->b != 0 ? c->x[e->b - 1] : 0.0;
+		switch (e->type) {
+		case ZSL_PHY_CIRC_R:
+			e->i = (va - vb) / e->val;
+			break;
+		case ZSL_PHY_CIRC_C:
+			/* No current flows at DC. */
+			if (h > 0.0) {
+				g = 2.0 * e->val / h;
+				ieq = g * e->v + (be ? 0.0 : e->i);
+				e->i = g * (va - vb) - ieq;
+			} else {
+				e->i = 0.0;
+			}
+			break;
+		case ZSL_PHY_CIRC_L:
+		case ZSL_PHY_CIRC_V:
+			e->i = c->x[e->br];
+			break;
+		case ZSL_PHY_CIRC_I:
+			e->i = -e->val;
+			break;
+		}
+		e->v = va - vb;
+	}
+
+	return 0;
+}
+
+int
+zsl_phy_circ_add(struct zsl_phy_circ *c, enum zsl_phy_circ_type type,
+		 size_t a, size_t b, zsl_real_t val)
+{
+	struct zsl_phy_circ_elem *e;
+	bool branch = (type == ZSL_PHY_CIRC_V) || (type == ZSL_PHY_CIRC_L);
+
+	if ((a > c->nodes) || (b > c->nodes) || (a == b)) {
+		return -EINVAL;
+	}
+	if ((type == ZSL_PHY_CIRC_R || type == ZSL_PHY_CIRC_C ||
+	     type == ZSL_PHY_CIRC_L) && (val <= 0.0)) {
+		return -EINVAL;
+	}
+	if ((c->n_elem == c->sz_elem) || (branch && (c->n == c->sz))) {
+		return -ENOMEM;
+	}
+
+	e = &c->elem[c->n_elem];
+	e->type = type;
+	e->a = a;
+	e->b = b;
+	e->val = val;
+	e->br = branch ? c->n++ : 0;
+	e->v = 0.0;
+	e->i = 0.0;
+	c->valid = false;
+	c->restart = true;
+
+	return (int)c->n_elem++;
+}
+
+int
+zsl_phy_circ_set(struct zsl_phy_circ *c, size_t e, zsl_real_t val)
+{
+	enum zsl_phy_circ_type type;
+
+	if (e >= c->n_elem) {
+		return -EINVAL;
+	}
+
+	type = c->elem[e].type;
+	if ((type != ZSL_PHY_CIRC_V) && (type != ZSL_PHY_CIRC_I)) {
+		if (val <= 0.0) {
+			return -EINVAL;
+		}
+		c->valid = false;
+	}
+	c->elem[e].val = val;
+	c->restart = true;
+
+	return 0;
+}
+
+int
+zsl_phy_circ_dc(struct zsl_phy_circ *c)
+{
+	int rc;
+
+	rc = zsl_phy_circ_solve(c, 0.0, false);
+	if (rc == 0) {
+		c->restart = false;
+	}
+
+	return rc;
+}
+
+int
+zsl_phy_circ_step(struct zsl_phy_circ *c, zsl_real_t h)
+{
+	int rc;
+
+	if (h <= 0.0) {
+		return -EINVAL;
+	}
+
+	/*
+	 * After a change, the previous capacitor currents and inductor
+	 * voltages may jump, which would make the trapezoidal rule ring, so
+	 * take two backward Euler half steps instead.
+	 */
+	if (c->restart) {
+		rc = zsl_phy_circ_solve(c, h, true);
+		if (rc == 0) {
+			rc = zsl_phy_circ_solve(c, h, true);
+		}
+		c->restart = rc != 0;
+		return rc;
+	}
+
+	return zsl_phy_circ_solve(c, h, false);
+}
+
+int
+zsl_phy_circ_volt(struct zsl_phy_circ *c, size_t node, zsl_real_t *v)
+{
+	if (node > c->nodes) {
+		return -EINVAL;
+	}
+
+	*v = node != 0 ? c->x[node - 1] : 0.0;
+
+	return 0;
+}
+
+int
+zsl_phy_circ_curr(struct zsl_phy_circ *c, size_t e, zsl_real_t *i)
+{
+	if (e >= c->n_elem) {
+		return -EINVAL;
+	}
+
+	*i = c->elem[e].i;
+
+	return 0;
+}
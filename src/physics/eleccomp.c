@@ -8,6 +8,18 @@
 #include <errno.h>
 #include <zsl/zsl.h>
 #include <zsl/physics/eleccomp.h>
+#include <zsl/physics/misc.h>
+
+/* Sets every element of 'v' to NAN, for invalid inputs. */
+static int
+zsl_phy_ecmp_vec_nan(struct zsl_vec *v)
+{
+	for (size_t k = 0; k < v->sz; k++) {
+		v->data[k] = NAN;
+	}
+
+	return -EINVAL;
+}
 
 int
 zsl_phy_ecmp_capac_cpv(zsl_real_t q, zsl_real_t v, zsl_real_t *c)
@@ -87,6 +99,17 @@ zsl_phy_ecmp_rc_charg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t, zsl_real_t i0,
 	return 0;
 }
 
+int
+zsl_phy_ecmp_rc_charg_i_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+			    zsl_real_t dt, zsl_real_t i0, struct zsl_vec *i)
+{
+	if ((r * c) <= 0 || i0 < 0 || t0 < 0 || dt < 0) {
+		return zsl_phy_ecmp_vec_nan(i);
+	}
+
+	return zsl_phy_misc_exp_curve(i0, 0.0, 1.0 / (r * c), t0, dt, i);
+}
+
 int
 zsl_phy_ecmp_rc_charg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t, zsl_real_t q0,
 			zsl_real_t *q)
@@ -101,6 +124,17 @@ zsl_phy_ecmp_rc_charg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t, zsl_real_t q0,
 	return 0;
 }
 
+int
+zsl_phy_ecmp_rc_charg_q_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+			    zsl_real_t dt, zsl_real_t q0, struct zsl_vec *q)
+{
+	if ((r * c) <= 0 || q0 < 0 || t0 < 0 || dt < 0) {
+		return zsl_phy_ecmp_vec_nan(q);
+	}
+
+	return zsl_phy_misc_exp_curve(-q0, q0, 1.0 / (r * c), t0, dt, q);
+}
+
 int
 zsl_phy_ecmp_rc_discharg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			   zsl_real_t i0, zsl_real_t *i)
@@ -115,6 +149,18 @@ zsl_phy_ecmp_rc_discharg_i(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 	return 0;
 }
 
+int
+zsl_phy_ecmp_rc_discharg_i_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+			       zsl_real_t dt, zsl_real_t i0,
+			       struct zsl_vec *i)
+{
+	if ((r * c) <= 0 || i0 < 0 || t0 < 0 || dt < 0) {
+		return zsl_phy_ecmp_vec_nan(i);
+	}
+
+	return zsl_phy_misc_exp_curve(-i0, 0.0, 1.0 / (r * c), t0, dt, i);
+}
+
 int
 zsl_phy_ecmp_rc_discharg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 			   zsl_real_t q0, zsl_real_t *q)
@@ -129,6 +175,18 @@ zsl_phy_ecmp_rc_discharg_q(zsl_real_t r, zsl_real_t c, zsl_real_t t,
 	return 0;
 }
 
+int
+zsl_phy_ecmp_rc_discharg_q_vec(zsl_real_t r, zsl_real_t c, zsl_real_t t0,
+			       zsl_real_t dt, zsl_real_t q0,
+			       struct zsl_vec *q)
+{
+	if ((r * c) <= 0 || q0 < 0 || t0 < 0 || dt < 0) {
+		return zsl_phy_ecmp_vec_nan(q);
+	}
+
+	return zsl_phy_misc_exp_curve(q0, 0.0, 1.0 / (r * c), t0, dt, q);
+}
+
 int
 zsl_phy_ecmp_rl_current(zsl_real_t r, zsl_real_t l, zsl_real_t t, zsl_real_t i0,
 			zsl_real_t *i)
@@ -142,3 +200,14 @@ zsl_phy_ecmp_rl_current(zsl_real_t r, zsl_real_t l, zsl_real_t t, zsl_real_t i0,
 
 	return 0;
 }
+
+int
+zsl_phy_ecmp_rl_current_vec(zsl_real_t r, zsl_real_t l, zsl_real_t t0,
+			    zsl_real_t dt, zsl_real_t i0, struct zsl_vec *i)
+{
+	if (l <= 0 || i0 < 0 || t0 < 0 || dt < 0 || r < 0) {
+		return zsl_phy_ecmp_vec_nan(i);
+	}
+
+	return zsl_phy_misc_exp_curve(-i0, i0, r / l, t0, dt, i);
+}
@@ -127,6 +127,30 @@ zsl_phy_elcty_ohm_law(zsl_real_t i, zsl_real_t r, zsl_real_t *v)
 	return 0;
 }
 
+int
+zsl_phy_elcty_ohm_law_vec(struct zsl_vec *i, struct zsl_vec *r,
+			  struct zsl_vec *v)
+{
+	size_t n = v->sz;
+	int bad = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i->sz != n) || (r->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < n; k++) {
+		zsl_real_t rk = r->data[k];
+		zsl_real_t vk = i->data[k] * rk;
+
+		bad |= rk < 0.0;
+		v->data[k] = rk < 0.0 ? NAN : vk;
+	}
+
+	return bad ? -EINVAL : 0;
+}
+
 int
 zsl_phy_elcty_power_vi(zsl_real_t v, zsl_real_t i, zsl_real_t *p)
 {
@@ -135,6 +159,23 @@ zsl_phy_elcty_power_vi(zsl_real_t v, zsl_real_t i, zsl_real_t *p)
 	return 0;
 }
 
+int
+zsl_phy_elcty_power_vi_vec(struct zsl_vec *v, struct zsl_vec *i,
+			   struct zsl_vec *p)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != p->sz) || (i->sz != p->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < p->sz; k++) {
+		p->data[k] = v->data[k] * i->data[k];
+	}
+
+	return 0;
+}
+
 int
 zsl_phy_elcty_power_ir(zsl_real_t i, zsl_real_t r, zsl_real_t *p)
 {
@@ -61,3 +61,132 @@ zsl_phy_gas_charles_lussac(zsl_real_t ti, zsl_real_t vi, zsl_real_t tf,
 
 	return 0;
 }
+
+/* Molar masses of dry air and water in kg/mol, from CIPM-2007. */
+#define ZSL_PHY_GAS_M_AIR       (28.96546E-3)
+#define ZSL_PHY_GAS_M_WATER     (18.01528E-3)
+
+int
+zsl_phy_gas_air_xv(zsl_real_t t, zsl_real_t p, zsl_real_t rh, zsl_real_t *x)
+{
+	zsl_real_t tc, psv, f;
+
+	if (t <= 0 || p <= 0 || rh < 0 || rh > 1.0) {
+		*x = NAN;
+		return -EINVAL;
+	}
+
+	/* Saturation vapour pressure, and the enhancement factor. */
+	tc = t - 273.15;
+	psv = ZSL_EXP(1.2378847E-5 * t * t - 1.9121316E-2 * t +
+		      33.93711047 - 6.3431645E3 / t);
+	f = 1.00062 + 3.14E-8 * p + 5.6E-7 * tc * tc;
+
+	*x = rh * f * psv / p;
+
+	return 0;
+}
+
+int
+zsl_phy_gas_air_dens(zsl_real_t t, zsl_real_t p, zsl_real_t rh, zsl_real_t *d)
+{
+	int rc;
+	zsl_real_t xv, tc, z;
+
+	rc = zsl_phy_gas_air_xv(t, p, rh, &xv);
+	if (rc) {
+		*d = NAN;
+		return rc;
+	}
+
+	/* Compressibility factor. */
+	tc = t - 273.15;
+	z = 1.0 - p / t * (1.58123E-6 - 2.9331E-8 * tc + 1.1043E-10 * tc * tc +
+			   (5.707E-6 - 2.051E-8 * tc) * xv +
+			   (1.9898E-4 - 2.376E-6 * tc) * xv * xv) +
+	    (p * p) / (t * t) * (1.83E-11 - 0.765E-8 * xv * xv);
+
+	*d = p * ZSL_PHY_GAS_M_AIR / (z * ZSL_IDEAL_GAS_CONST * t) *
+	     (1.0 - xv * (1.0 - ZSL_PHY_GAS_M_WATER / ZSL_PHY_GAS_M_AIR));
+
+	return 0;
+}
+
+int
+zsl_phy_gas_air_visc(zsl_real_t t, zsl_real_t *mu)
+{
+	if (t <= 0) {
+		*mu = NAN;
+		return -EINVAL;
+	}
+
+	/* Sutherland's law, with mu = 1.716E-5 Pa s at 273.15 K. */
+	*mu = 1.716E-5 * ZSL_POW(t / 273.15, 1.5) * (273.15 + 110.4) /
+	      (t + 110.4);
+
+	return 0;
+}
+
+int
+zsl_phy_gas_air_dens_fn(zsl_real_t t, zsl_real_t p, void *arg, zsl_real_t *v)
+{
+	return zsl_phy_gas_air_dens(t, p, arg ? *(zsl_real_t *)arg : 0.0, v);
+}
+
+int
+zsl_phy_gas_air_visc_fn(zsl_real_t t, zsl_real_t p, void *arg, zsl_real_t *v)
+{
+	return zsl_phy_gas_air_visc(t, v);
+}
+
+int
+zsl_phy_gas_cache_init(struct zsl_phy_gas_cache *c, zsl_phy_gas_prop_fn_t fn,
+		       void *arg, zsl_real_t t0, zsl_real_t t1, zsl_real_t p0,
+		       zsl_real_t p1)
+{
+	int rc;
+
+	if (c->nt < 2 || c->np < 2 || !(t1 > t0) || !(p1 > p0)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < c->nt; i++) {
+		c->t[i] = t0 + (t1 - t0) * (zsl_real_t)i /
+			  (zsl_real_t)(c->nt - 1);
+	}
+	for (size_t j = 0; j < c->np; j++) {
+		c->p[j] = p0 + (p1 - p0) * (zsl_real_t)j /
+			  (zsl_real_t)(c->np - 1);
+	}
+
+	for (size_t i = 0; i < c->nt; i++) {
+		for (size_t j = 0; j < c->np; j++) {
+			rc = fn(c->t[i], c->p[j], arg, &c->v[i * c->np + j]);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	c->grid.x = c->t;
+	c->grid.nx = c->nt;
+	c->grid.y = c->p;
+	c->grid.ny = c->np;
+	c->grid.z = c->v;
+
+	return zsl_interp_grid2_init(&c->grid);
+}
+
+int
+zsl_phy_gas_cache_get(struct zsl_phy_gas_cache *c, zsl_real_t t,
+		      zsl_real_t p, zsl_real_t *v)
+{
+	return zsl_interp_grid2_bicubic(&c->grid, t, p, v);
+}
+
+int
+zsl_phy_gas_cache_get_batch(struct zsl_phy_gas_cache *c, const zsl_real_t *t,
+			    const zsl_real_t *p, zsl_real_t *v, size_t count)
+{
+	return zsl_interp_grid2_bicubic_batch(&c->grid, t, p, v, count);
+}
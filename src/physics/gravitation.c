@@ -76,6 +76,31 @@ zsl_phy_grav_force(zsl_real_t m1, zsl_real_t m2, zsl_real_t r, zsl_real_t *f)
 	return 0;
 }
 
+int
+zsl_phy_grav_force_vec(struct zsl_vec *m1, struct zsl_vec *m2,
+		       struct zsl_vec *r, struct zsl_vec *f)
+{
+	size_t n = f->sz;
+	int bad = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m1->sz != n) || (m2->sz != n) || (r->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t ri = r->data[i];
+		zsl_real_t fi = (-ZSL_UNIV_GRAV * m1->data[i] * m2->data[i]) /
+				(ri * ri);
+
+		bad |= ri == 0.0;
+		f->data[i] = ri == 0.0 ? NAN : fi;
+	}
+
+	return bad ? -EINVAL : 0;
+}
+
 int
 zsl_phy_grav_pot_ener(zsl_real_t m1, zsl_real_t m2, zsl_real_t r,
 		      zsl_real_t *u)
@@ -23,6 +23,30 @@ zsl_phy_kin_dist(zsl_real_t vi, zsl_real_t time, zsl_real_t accel,
 	return 0;
 }
 
+int
+zsl_phy_kin_dist_vec(struct zsl_vec *vi, struct zsl_vec *time,
+		     struct zsl_vec *accel, struct zsl_vec *dist)
+{
+	size_t n = dist->sz;
+	int bad = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((vi->sz != n) || (time->sz != n) || (accel->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t t = time->data[i];
+		zsl_real_t d = vi->data[i] * t + 0.5 * accel->data[i] * t * t;
+
+		bad |= t < 0.0;
+		dist->data[i] = t < 0.0 ? NAN : d;
+	}
+
+	return bad ? -EINVAL : 0;
+}
+
 int
 zsl_phy_kin_init_pos(zsl_real_t vi, zsl_real_t t, zsl_real_t a, zsl_real_t xf,
 		     zsl_real_t *xi)
@@ -83,6 +107,30 @@ zsl_phy_kin_vel(zsl_real_t vi, zsl_real_t time, zsl_real_t accel,
 	return 0;
 }
 
+int
+zsl_phy_kin_vel_vec(struct zsl_vec *vi, struct zsl_vec *time,
+		    struct zsl_vec *accel, struct zsl_vec *vf)
+{
+	size_t n = vf->sz;
+	int bad = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((vi->sz != n) || (time->sz != n) || (accel->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t t = time->data[i];
+		zsl_real_t v = vi->data[i] + t * accel->data[i];
+
+		bad |= t < 0.0;
+		vf->data[i] = t < 0.0 ? NAN : v;
+	}
+
+	return bad ? -EINVAL : 0;
+}
+
 int
 zsl_phy_kin_vel2(zsl_real_t vi, zsl_real_t dist, zsl_real_t accel,
 		 zsl_real_t *vf)
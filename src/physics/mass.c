@@ -79,3 +79,147 @@ zsl_phy_mass_center(struct zsl_vec *m, struct zsl_vec *x,
 
 	return 0;
 }
+
+int
+zsl_phy_mass_acc_init(struct zsl_phy_mass_acc *acc)
+{
+	acc->m = 0.0;
+	for (size_t i = 0; i < 3; i++) {
+		acc->c[i] = 0.0;
+	}
+	for (size_t i = 0; i < 6; i++) {
+		acc->s[i] = 0.0;
+	}
+
+	return 0;
+}
+
+/* Weighted Welford update, for a mass 'm' that is known to be positive. */
+static void
+zsl_phy_mass_acc_add(struct zsl_phy_mass_acc *acc, zsl_real_t m,
+		     zsl_real_t x, zsl_real_t y, zsl_real_t z)
+{
+	zsl_real_t d[3], e[3];
+	zsl_real_t w;
+
+	acc->m += m;
+	w = m / acc->m;
+
+	/* Offsets from the old (d) and the new (e) centre of mass. */
+	d[0] = x - acc->c[0];
+	d[1] = y - acc->c[1];
+	d[2] = z - acc->c[2];
+	for (size_t i = 0; i < 3; i++) {
+		acc->c[i] += w * d[i];
+		e[i] = m * (d[i] - w * d[i]);
+	}
+
+	acc->s[0] += d[0] * e[0];
+	acc->s[1] += d[1] * e[1];
+	acc->s[2] += d[2] * e[2];
+	acc->s[3] += d[0] * e[1];
+	acc->s[4] += d[0] * e[2];
+	acc->s[5] += d[1] * e[2];
+}
+
+int
+zsl_phy_mass_acc_feed(struct zsl_phy_mass_acc *acc, zsl_real_t m,
+		      zsl_real_t x, zsl_real_t y, zsl_real_t z)
+{
+	if (m < 0) {
+		return -EINVAL;
+	}
+
+	if (m > 0) {
+		zsl_phy_mass_acc_add(acc, m, x, y, z);
+	}
+
+	return 0;
+}
+
+int
+zsl_phy_mass_acc_feed_vec(struct zsl_phy_mass_acc *acc, struct zsl_vec *m,
+			  struct zsl_vec *x, struct zsl_vec *y,
+			  struct zsl_vec *z)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that all vectors have the same size. */
+	if ((m->sz != x->sz) || (x->sz != y->sz) || (y->sz != z->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Ensure there are no negative values for mass. */
+	if (zsl_vec_is_nonneg(m) == false) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < m->sz; i++) {
+		if (m->data[i] > 0) {
+			zsl_phy_mass_acc_add(acc, m->data[i], x->data[i],
+					     y->data[i], z->data[i]);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_phy_mass_acc_feed_mtx(struct zsl_phy_mass_acc *acc, struct zsl_vec *m,
+			  struct zsl_mtx *p)
+{
+	zsl_real_t *r;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((p->sz_rows != m->sz) || (p->sz_cols != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Ensure there are no negative values for mass. */
+	if (zsl_vec_is_nonneg(m) == false) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < m->sz; i++) {
+		r = &p->data[i * 3];
+		if (m->data[i] > 0) {
+			zsl_phy_mass_acc_add(acc, m->data[i], r[0], r[1], r[2]);
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_phy_mass_acc_inertia(struct zsl_phy_mass_acc *acc, zsl_real_t *mt,
+			 struct zsl_vec *com, struct zsl_mtx *it)
+{
+	const zsl_real_t *s = acc->s;
+	zsl_real_t tr = s[0] + s[1] + s[2];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((com->sz != 3) || (it->sz_rows != 3) || (it->sz_cols != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The centre of mass is undefined until a mass has been added. */
+	if (acc->m == 0.0) {
+		return -EINVAL;
+	}
+
+	*mt = acc->m;
+	for (size_t i = 0; i < 3; i++) {
+		com->data[i] = acc->c[i];
+	}
+
+	it->data[0] = tr - s[0];
+	it->data[4] = tr - s[1];
+	it->data[8] = tr - s[2];
+	it->data[1] = it->data[3] = -s[3];
+	it->data[2] = it->data[6] = -s[4];
+	it->data[5] = it->data[7] = -s[5];
+
+	return 0;
+}
@@ -8,3 +8,25 @@
 #include <errno.h>
 #include <zsl/zsl.h>
 #include <zsl/physics/misc.h>
+
+int
+zsl_phy_misc_exp_curve(zsl_real_t a, zsl_real_t b, zsl_real_t lambda,
+		       zsl_real_t t0, zsl_real_t dt, struct zsl_vec *y)
+{
+	size_t end;
+	zsl_real_t r = ZSL_EXP(-lambda * dt);
+	zsl_real_t e;
+
+	for (size_t k0 = 0; k0 < y->sz; k0 += ZSL_PHY_MISC_EXP_RESYNC) {
+		/* Resync from the exact value, then step by the ratio. */
+		e = ZSL_EXP(-lambda * (t0 + (zsl_real_t)k0 * dt));
+		end = k0 + ZSL_PHY_MISC_EXP_RESYNC;
+		end = end < y->sz ? end : y->sz;
+		for (size_t k = k0; k < end; k++) {
+			y->data[k] = b + a * e;
+			e *= r;
+		}
+	}
+
+	return 0;
+}
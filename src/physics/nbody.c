@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/smp.h>
+#include <zsl/physics/nbody.h>
+
+#define NONE ZSL_PHY_NBODY_NONE
+
+/* The arguments shared by the ranges of an acceleration kernel. */
+struct zsl_phy_nbody_task {
+	const zsl_real_t *x, *y, *z, *m;
+	zsl_real_t *ax, *ay, *az;
+	size_t n;
+	zsl_real_t eps2;
+	zsl_real_t theta2;
+	const struct zsl_phy_nbody_node *nodes;
+};
+
+static void
+zsl_phy_nbody_direct_rows(void *arg, size_t i0, size_t i1)
+{
+	const struct zsl_phy_nbody_task *t = arg;
+	zsl_real_t dx, dy, dz, r2, r2e, s, sx, sy, sz;
+
+	for (size_t i = i0; i < i1; i++) {
+		sx = sy = sz = 0.0;
+		/* No branches, so that the compiler can vectorise this loop. */
+		for (size_t j = 0; j < t->n; j++) {
+			dx = t->x[j] - t->x[i];
+			dy = t->y[j] - t->y[i];
+			dz = t->z[j] - t->z[i];
+			r2 = dx * dx + dy * dy + dz * dz;
+			r2e = r2 + t->eps2;
+			s = r2 > 0.0 ? t->m[j] / (r2e * ZSL_SQRT(r2e)) : 0.0;
+			sx += s * dx;
+			sy += s * dy;
+			sz += s * dz;
+		}
+		t->ax[i] = ZSL_UNIV_GRAV * sx;
+		t->ay[i] = ZSL_UNIV_GRAV * sy;
+		t->az[i] = ZSL_UNIV_GRAV * sz;
+	}
+}
+
+int
+zsl_phy_nbody_acc(struct zsl_vec *x, struct zsl_vec *y, struct zsl_vec *z,
+		  struct zsl_vec *m, zsl_real_t eps, struct zsl_vec *ax,
+		  struct zsl_vec *ay, struct zsl_vec *az)
+{
+	size_t n = x->sz;
+	struct zsl_phy_nbody_task t = {
+		.x = x->data, .y = y->data, .z = z->data, .m = m->data,
+		.ax = ax->data, .ay = ay->data, .az = az->data,
+		.n = n, .eps2 = eps * eps
+	};
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((y->sz != n) || (z->sz != n) || (m->sz != n) ||
+	    (ax->sz != n) || (ay->sz != n) || (az->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_smp_for(zsl_phy_nbody_direct_rows, &t, n, 10 * n * n);
+}
+
+/* Adds a body at 'p' to the mass and mass-weighted position sum of 'nd'. */
+static void
+zsl_phy_nbody_add(struct zsl_phy_nbody_node *nd, const zsl_real_t *p,
+		  zsl_real_t m)
+{
+	nd->n++;
+	nd->m += m;
+	for (size_t k = 0; k < 3; k++) {
+		nd->com[k] += m * p[k];
+	}
+}
+
+static size_t
+zsl_phy_nbody_octant(const struct zsl_phy_nbody_node *nd, const zsl_real_t *p)
+{
+	return (p[0] >= nd->ctr[0] ? 1 : 0) | (p[1] >= nd->ctr[1] ? 2 : 0) |
+	       (p[2] >= nd->ctr[2] ? 4 : 0);
+}
+
+/* Creates the child of 'parent' in octant 'o', as a leaf holding body 'b'. */
+static int
+zsl_phy_nbody_child(struct zsl_phy_nbody_tree *tree, size_t parent, size_t o,
+		    uint32_t b, const zsl_real_t *p, zsl_real_t m)
+{
+	struct zsl_phy_nbody_node *pn = &tree->nodes[parent];
+	struct zsl_phy_nbody_node *nd;
+	zsl_real_t q;
+
+	if (tree->n >= tree->sz) {
+		return -ENOMEM;
+	}
+
+	nd = &tree->nodes[tree->n];
+	pn->child[o] = (uint32_t)tree->n++;
+
+	q = 0.5 * pn->half;
+	nd->ctr[0] = pn->ctr[0] + ((o & 1) ? q : -q);
+	nd->ctr[1] = pn->ctr[1] + ((o & 2) ? q : -q);
+	nd->ctr[2] = pn->ctr[2] + ((o & 4) ? q : -q);
+	nd->half = q;
+	nd->com[0] = nd->com[1] = nd->com[2] = 0.0;
+	nd->m = 0.0;
+	for (size_t k = 0; k < 8; k++) {
+		nd->child[k] = 0;
+	}
+	nd->n = 0;
+	nd->body = b;
+	zsl_phy_nbody_add(nd, p, m);
+
+	return 0;
+}
+
+/* Inserts body 'b' into the tree, splitting leaves as needed. */
+static int
+zsl_phy_nbody_insert(struct zsl_phy_nbody_tree *tree, struct zsl_vec *x,
+		     struct zsl_vec *y, struct zsl_vec *z, struct zsl_vec *m,
+		     uint32_t b)
+{
+	int rc;
+	size_t idx = 0;
+	size_t o;
+	uint32_t k;
+	zsl_real_t p[3] = { x->data[b], y->data[b], z->data[b] };
+	zsl_real_t pk[3];
+	struct zsl_phy_nbody_node *nd;
+
+	for (size_t d = 0;; d++) {
+		nd = &tree->nodes[idx];
+
+		if (nd->body != NONE) {
+			/* An empty root, or a leaf at the maximum depth. */
+			if ((nd->n == 0) || (d == ZSL_PHY_NBODY_DEPTH)) {
+				zsl_phy_nbody_add(nd, p, m->data[b]);
+				return 0;
+			}
+
+			/* Split the leaf, moving its body down a level. */
+			k = nd->body;
+			pk[0] = x->data[k];
+			pk[1] = y->data[k];
+			pk[2] = z->data[k];
+			nd->body = NONE;
+			o = zsl_phy_nbody_octant(nd, pk);
+			rc = zsl_phy_nbody_child(tree, idx, o, k, pk,
+						 m->data[k]);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		zsl_phy_nbody_add(nd, p, m->data[b]);
+		o = zsl_phy_nbody_octant(nd, p);
+		if (nd->child[o] == 0) {
+			return zsl_phy_nbody_child(tree, idx, o, b, p,
+						   m->data[b]);
+		}
+		idx = nd->child[o];
+	}
+}
+
+int
+zsl_phy_nbody_tree_build(struct zsl_phy_nbody_tree *tree,
+			 struct zsl_vec *x, struct zsl_vec *y,
+			 struct zsl_vec *z, struct zsl_vec *m)
+{
+	int rc;
+	size_t n = x->sz;
+	zsl_real_t lo[3], hi[3];
+	struct zsl_phy_nbody_node *nd;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((y->sz != n) || (z->sz != n) || (m->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	tree->n = 0;
+	if ((n == 0) || (tree->sz == 0)) {
+		return n == 0 ? -EINVAL : -ENOMEM;
+	}
+
+	/* The root is the bounding cube of all the bodies. */
+	lo[0] = hi[0] = x->data[0];
+	lo[1] = hi[1] = y->data[0];
+	lo[2] = hi[2] = z->data[0];
+	for (size_t i = 1; i < n; i++) {
+		lo[0] = ZSL_MIN(lo[0], x->data[i]);
+		hi[0] = ZSL_MAX(hi[0], x->data[i]);
+		lo[1] = ZSL_MIN(lo[1], y->data[i]);
+		hi[1] = ZSL_MAX(hi[1], y->data[i]);
+		lo[2] = ZSL_MIN(lo[2], z->data[i]);
+		hi[2] = ZSL_MAX(hi[2], z->data[i]);
+	}
+
+	nd = &tree->nodes[0];
+	nd->half = 0.0;
+	for (size_t k = 0; k < 3; k++) {
+		nd->ctr[k] = 0.5 * (lo[k] + hi[k]);
+		nd->half = ZSL_MAX(nd->half, 0.5 * (hi[k] - lo[k]));
+		nd->com[k] = 0.0;
+	}
+	if (nd->half == 0.0) {
+		nd->half = 1.0;
+	}
+	nd->m = 0.0;
+	for (size_t k = 0; k < 8; k++) {
+		nd->child[k] = 0;
+	}
+	nd->n = 0;
+	nd->body = 0;
+	tree->n = 1;
+
+	for (uint32_t b = 0; b < n; b++) {
+		rc = zsl_phy_nbody_insert(tree, x, y, z, m, b);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	/* Turn the mass-weighted sums into centres of mass. */
+	for (size_t i = 0; i < tree->n; i++) {
+		nd = &tree->nodes[i];
+		for (size_t k = 0; k < 3; k++) {
+			nd->com[k] = nd->m != 0.0 ? nd->com[k] / nd->m :
+				     nd->ctr[k];
+		}
+	}
+
+	return 0;
+}
+
+/* Marks the stack entries of cells on the path from the root to 'p'. */
+#define ON_PATH (1UL << 31)
+
+/*
+ * Pushes the children of 'nd' onto 'stack', marking the one in octant 'o'
+ * as on the path, and returns the new stack size.
+ */
+static size_t
+zsl_phy_nbody_push(const struct zsl_phy_nbody_node *nd, uint32_t *stack,
+		   size_t top, size_t o)
+{
+	for (size_t c = 0; c < 8; c++) {
+		if (nd->child[c] != 0) {
+			stack[top++] = nd->child[c] | (c == o ? ON_PATH : 0);
+		}
+	}
+
+	return top;
+}
+
+static void
+zsl_phy_nbody_tree_rows(void *arg, size_t i0, size_t i1)
+{
+	const struct zsl_phy_nbody_task *t = arg;
+	const struct zsl_phy_nbody_node *nd;
+	uint32_t stack[8 * (ZSL_PHY_NBODY_DEPTH + 1)];
+	uint32_t e;
+	bool path;
+	size_t top, o;
+	zsl_real_t p[3], dx, dy, dz, r2, r2e, s, sx, sy, sz, w;
+
+	for (size_t i = i0; i < i1; i++) {
+		p[0] = t->x[i];
+		p[1] = t->y[i];
+		p[2] = t->z[i];
+		sx = sy = sz = 0.0;
+		stack[0] = ON_PATH;
+		top = 1;
+
+		/*
+		 * The cells containing 'p' are tracked with the same octant
+		 * tests as the build, rather than from their bounds, so that
+		 * rounding cannot make body 'i' attract itself.
+		 */
+		while (top > 0) {
+			e = stack[--top];
+			path = (e & ON_PATH) != 0;
+			nd = &t->nodes[e & ~ON_PATH];
+			dx = nd->com[0] - p[0];
+			dy = nd->com[1] - p[1];
+			dz = nd->com[2] - p[2];
+			r2 = dx * dx + dy * dy + dz * dz;
+			w = 2.0 * nd->half;
+
+			/* Open cells that are too close, or that hold 'p'. */
+			if ((nd->body == NONE) &&
+			    (path || (w * w >= t->theta2 * r2))) {
+				o = path ? zsl_phy_nbody_octant(nd, p) : 8;
+				top = zsl_phy_nbody_push(nd, stack, top, o);
+				continue;
+			}
+
+			/* Skip the leaf of body 'i' itself. */
+			if (path) {
+				continue;
+			}
+
+			if (r2 > 0.0) {
+				r2e = r2 + t->eps2;
+				s = nd->m / (r2e * ZSL_SQRT(r2e));
+				sx += s * dx;
+				sy += s * dy;
+				sz += s * dz;
+			}
+		}
+
+		t->ax[i] = ZSL_UNIV_GRAV * sx;
+		t->ay[i] = ZSL_UNIV_GRAV * sy;
+		t->az[i] = ZSL_UNIV_GRAV * sz;
+	}
+}
+
+int
+zsl_phy_nbody_tree_acc(struct zsl_phy_nbody_tree *tree, struct zsl_vec *x,
+		       struct zsl_vec *y, struct zsl_vec *z, zsl_real_t theta,
+		       zsl_real_t eps, struct zsl_vec *ax, struct zsl_vec *ay,
+		       struct zsl_vec *az)
+{
+	size_t n = x->sz;
+	struct zsl_phy_nbody_task t = {
+		.x = x->data, .y = y->data, .z = z->data,
+		.ax = ax->data, .ay = ay->data, .az = az->data,
+		.n = n, .eps2 = eps * eps, .theta2 = theta * theta,
+		.nodes = tree->nodes
+	};
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((y->sz != n) || (z->sz != n) || (ax->sz != n) ||
+	    (ay->sz != n) || (az->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (tree->n == 0) {
+		return -EINVAL;
+	}
+
+	/* The full tree walk is an upper bound on the work per body. */
+	return zsl_smp_for(zsl_phy_nbody_tree_rows, &t, n, 10 * n * tree->n);
+}
@@ -7,6 +7,8 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/zsl.h>
+#include <zsl/ode.h>
+#include <zsl/workspace.h>
 #include <zsl/physics/projectiles.h>
 
 int
@@ -125,6 +127,135 @@ zsl_phy_proj_trajectory(zsl_real_t vih, zsl_real_t viv, zsl_real_t xi,
 	return 0;
 }
 
+int
+zsl_phy_proj_trajectory_vec(zsl_real_t vih, zsl_real_t viv, zsl_real_t xi,
+			    zsl_real_t yi, struct zsl_vec *xf,
+			    struct zsl_vec *yf)
+{
+	zsl_real_t a, b, dx;
+	bool bad = false;
+	bool neg;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (xf->sz != yf->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	if (vih == 0) {
+		for (size_t i = 0; i < yf->sz; i++) {
+			yf->data[i] = NAN;
+		}
+		return -EINVAL;
+	}
+
+	/* y = yi + a * dx + b * dx^2, with t = dx / vih. */
+	a = viv / vih;
+	b = -ZSL_GRAV_EARTH / (2.0 * vih * vih);
+
+	for (size_t i = 0; i < xf->sz; i++) {
+		dx = xf->data[i] - xi;
+		neg = dx * vih < 0;
+		bad |= neg;
+		yf->data[i] = neg ? NAN : yi + dx * (a + b * dx);
+	}
+
+	return bad ? -EINVAL : 0;
+}
+
+/* State: x, y, vx, vy. 'arg' points to the drag coefficient. */
+static int
+zsl_phy_proj_drag_fn(zsl_real_t t, struct zsl_vec *s, struct zsl_vec *ds,
+		     void *arg)
+{
+	zsl_real_t kv = *(zsl_real_t *)arg *
+			ZSL_SQRT(s->data[2] * s->data[2] +
+				 s->data[3] * s->data[3]);
+
+	ds->data[0] = s->data[2];
+	ds->data[1] = s->data[3];
+	ds->data[2] = -kv * s->data[2];
+	ds->data[3] = -ZSL_GRAV_EARTH - kv * s->data[3];
+
+	return 0;
+}
+
+int
+zsl_phy_proj_trajectory_drag(zsl_real_t vih, zsl_real_t viv, zsl_real_t xi,
+			     zsl_real_t yi, zsl_real_t k, zsl_real_t h,
+			     size_t steps, struct zsl_vec *xf,
+			     struct zsl_vec *yf)
+{
+	int rc = 0;
+	size_t i = 0;
+	zsl_real_t t = 0.0;
+	zsl_real_t x0, y0, m0, x1, m1, dx, u, u2, u3;
+
+	ZSL_VECTOR_DEF(s, 4);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (xf->sz != yf->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	if ((vih <= 0) || (k < 0) || (h <= 0)) {
+		for (size_t j = 0; j < yf->sz; j++) {
+			yf->data[j] = NAN;
+		}
+		return -EINVAL;
+	}
+
+	/* Positions behind the launching point. */
+	while (i < xf->sz && xf->data[i] < xi) {
+		yf->data[i++] = NAN;
+		rc = -EINVAL;
+	}
+
+	s.data[0] = xi;
+	s.data[1] = yi;
+	s.data[2] = vih;
+	s.data[3] = viv;
+
+	ZSL_SCRATCH_DEF(ws, zsl_ode_rk4_ws_sz(4));
+
+	for (size_t n = 0; n < steps && i < xf->sz; n++) {
+		x0 = s.data[0];
+		y0 = s.data[1];
+		m0 = s.data[3] / s.data[2];
+
+		if (zsl_ode_rk4_ws(zsl_phy_proj_drag_fn, &k, &t, h, 1, &s,
+				   ws)) {
+			break;
+		}
+
+		/* Hermite interpolation of every position within the step. */
+		x1 = s.data[0];
+		m1 = s.data[3] / s.data[2];
+		dx = x1 - x0;
+		while (i < xf->sz && xf->data[i] <= x1) {
+			u = (xf->data[i] - x0) / dx;
+			u2 = u * u;
+			u3 = u2 * u;
+			yf->data[i] = (2.0 * u3 - 3.0 * u2 + 1.0) * y0 +
+				      (u3 - 2.0 * u2 + u) * dx * m0 +
+				      (-2.0 * u3 + 3.0 * u2) * s.data[1] +
+				      (u3 - u2) * dx * m1;
+			i++;
+		}
+	}
+
+	ZSL_SCRATCH_PUT(ws);
+
+	/* Positions that were not reached. */
+	while (i < xf->sz) {
+		yf->data[i++] = NAN;
+		rc = -EINVAL;
+	}
+
+	return rc;
+}
+
 int
 zsl_phy_proj_vel(zsl_real_t vfh, zsl_real_t vfv, zsl_real_t *vf)
 {
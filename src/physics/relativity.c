@@ -8,3 +8,179 @@
 #include <errno.h>
 #include <zsl/zsl.h>
 #include <zsl/physics/relativity.h>
+
+/* Returns 1 - (v / c)^2, which is only positive for |v| < c. */
+static inline zsl_real_t
+zsl_phy_rel_beta2c(zsl_real_t v)
+{
+	zsl_real_t b = v / ZSL_LIGHT_SPEED;
+
+	return 1.0 - b * b;
+}
+
+/*
+ * Calculates out = s * gamma for each velocity, or s / gamma if 'inv' is
+ * true, and multiplied by the velocity itself if 'mul_v' is true.
+ */
+static int
+zsl_phy_rel_scale_vec(struct zsl_vec *v, zsl_real_t s, bool inv, bool mul_v,
+		      struct zsl_vec *out)
+{
+	int rc = 0;
+	zsl_real_t d, g;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != out->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < v->sz; k++) {
+		d = zsl_phy_rel_beta2c(v->data[k]);
+		if (d <= 0.0) {
+			out->data[k] = NAN;
+			rc = -EINVAL;
+			continue;
+		}
+		g = inv ? ZSL_SQRT(d) : 1.0 / ZSL_SQRT(d);
+		out->data[k] = s * g * (mul_v ? v->data[k] : 1.0);
+	}
+
+	return rc;
+}
+
+int
+zsl_phy_rel_gamma(zsl_real_t v, zsl_real_t *g)
+{
+	zsl_real_t d = zsl_phy_rel_beta2c(v);
+
+	if (d <= 0.0) {
+		*g = NAN;
+		return -EINVAL;
+	}
+
+	*g = 1.0 / ZSL_SQRT(d);
+
+	return 0;
+}
+
+int
+zsl_phy_rel_gamma_vec(struct zsl_vec *v, struct zsl_vec *g)
+{
+	return zsl_phy_rel_scale_vec(v, 1.0, false, false, g);
+}
+
+int
+zsl_phy_rel_time_dil_vec(zsl_real_t t0, struct zsl_vec *v, struct zsl_vec *t)
+{
+	return zsl_phy_rel_scale_vec(v, t0, false, false, t);
+}
+
+int
+zsl_phy_rel_length_cont_vec(zsl_real_t l0, struct zsl_vec *v,
+			    struct zsl_vec *l)
+{
+	return zsl_phy_rel_scale_vec(v, l0, true, false, l);
+}
+
+int
+zsl_phy_rel_mom_vec(zsl_real_t m, struct zsl_vec *v, struct zsl_vec *p)
+{
+	if (m < 0) {
+		return -EINVAL;
+	}
+
+	return zsl_phy_rel_scale_vec(v, m, false, true, p);
+}
+
+int
+zsl_phy_rel_kin_ener_vec(zsl_real_t m, struct zsl_vec *v, struct zsl_vec *e)
+{
+	int rc = 0;
+	zsl_real_t mc2 = m * ZSL_LIGHT_SPEED * ZSL_LIGHT_SPEED;
+	zsl_real_t b, d, g2;
+
+	if (m < 0) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (v->sz != e->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < v->sz; k++) {
+		b = v->data[k] / ZSL_LIGHT_SPEED;
+		d = 1.0 - b * b;
+		if (d <= 0.0) {
+			e->data[k] = NAN;
+			rc = -EINVAL;
+			continue;
+		}
+		/* gamma - 1 = gamma^2 * beta^2 / (gamma + 1). */
+		g2 = 1.0 / d;
+		e->data[k] = mc2 * g2 * b * b / (ZSL_SQRT(g2) + 1.0);
+	}
+
+	return rc;
+}
+
+int
+zsl_phy_rel_mass_ener(zsl_real_t m, zsl_real_t *e)
+{
+	if (m < 0) {
+		*e = NAN;
+		return -EINVAL;
+	}
+
+	*e = m * ZSL_LIGHT_SPEED * ZSL_LIGHT_SPEED;
+
+	return 0;
+}
+
+int
+zsl_phy_rel_vel_add_vec(struct zsl_vec *u, zsl_real_t v, struct zsl_vec *w)
+{
+	int rc = 0;
+	zsl_real_t vc = v / (ZSL_LIGHT_SPEED * ZSL_LIGHT_SPEED);
+	bool v_ok = zsl_phy_rel_beta2c(v) > 0.0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (u->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < u->sz; k++) {
+		if (!v_ok || zsl_phy_rel_beta2c(u->data[k]) <= 0.0) {
+			w->data[k] = NAN;
+			rc = -EINVAL;
+			continue;
+		}
+		w->data[k] = (u->data[k] + v) / (1.0 + u->data[k] * vc);
+	}
+
+	return rc;
+}
+
+int
+zsl_phy_rel_doppler_vec(struct zsl_vec *f0, zsl_real_t v, struct zsl_vec *f)
+{
+	zsl_real_t b = v / ZSL_LIGHT_SPEED;
+	zsl_real_t s;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (f0->sz != f->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	s = zsl_phy_rel_beta2c(v) > 0.0 ? ZSL_SQRT((1.0 - b) / (1.0 + b)) : NAN;
+
+	for (size_t k = 0; k < f->sz; k++) {
+		f->data[k] = s * f0->data[k];
+	}
+
+	return s == s ? 0 : -EINVAL;
+}
@@ -7,6 +7,8 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
+#include <zsl/physics/gases.h>
 #include <zsl/physics/sound.h>
 
 int
@@ -48,6 +50,70 @@ zsl_phy_sound_intensity(zsl_real_t b, zsl_real_t d, zsl_real_t p, zsl_real_t *i)
 	return 0;
 }
 
+/*
+ * The level of a block with mean square pressure 'ms', where
+ * k = sqrt(b / d) / (b * i0) converts it to a relative intensity.
+ */
+static inline zsl_real_t
+zsl_phy_sound_block_lvl(zsl_real_t ms, zsl_real_t k)
+{
+	return ms > 0.0 ? 10.0 * ZSL_SND_LOG10(ms * k) : -INFINITY;
+}
+
+int
+zsl_phy_sound_level_block(struct zsl_vec *p, zsl_real_t b, zsl_real_t d,
+			  zsl_real_t i0, zsl_real_t *i, zsl_real_t *lvl)
+{
+	zsl_real_t ms = 0.0;
+
+	if (p->sz == 0 || b <= 0 || d <= 0 || i0 <= 0) {
+		*i = NAN;
+		*lvl = NAN;
+		return -EINVAL;
+	}
+
+	for (size_t k = 0; k < p->sz; k++) {
+		ms += p->data[k] * p->data[k];
+	}
+	ms /= (zsl_real_t)p->sz;
+
+	*i = ms * ZSL_SQRT(b / d) / b;
+	*lvl = zsl_phy_sound_block_lvl(ms, ZSL_SQRT(b / d) / (b * i0));
+
+	return 0;
+}
+
+int
+zsl_phy_sound_level_blocks(struct zsl_vec *p, size_t blk, zsl_real_t b,
+			   zsl_real_t d, zsl_real_t i0, struct zsl_vec *lvl)
+{
+	zsl_real_t k, ms;
+	const zsl_real_t *s;
+
+	if (blk == 0 || b <= 0 || d <= 0 || i0 <= 0) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((p->sz % blk != 0) || (lvl->sz != p->sz / blk)) {
+		return -EINVAL;
+	}
+#endif
+
+	k = ZSL_SQRT(b / d) / (b * i0);
+
+	for (size_t n = 0; n < lvl->sz; n++) {
+		s = &p->data[n * blk];
+		ms = 0.0;
+		for (size_t j = 0; j < blk; j++) {
+			ms += s[j] * s[j];
+		}
+		lvl->data[n] = zsl_phy_sound_block_lvl(ms / (zsl_real_t)blk, k);
+	}
+
+	return 0;
+}
+
 int
 zsl_phy_sound_shock_wave_angle(zsl_real_t v, zsl_real_t vs, zsl_real_t *theta)
 {
@@ -75,6 +141,29 @@ zsl_phy_sound_dop_effect(zsl_real_t v, zsl_real_t vs, zsl_real_t vl,
 	return 0;
 }
 
+int
+zsl_phy_sound_dop_effect_vec(zsl_real_t v, struct zsl_vec *vs,
+			     struct zsl_vec *vl, zsl_real_t fs,
+			     struct zsl_vec *fl)
+{
+	int rc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((vs->sz != fl->sz) || (vl->sz != fl->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < fl->sz; k++) {
+		if (zsl_phy_sound_dop_effect(v, vs->data[k], vl->data[k], fs,
+					     &fl->data[k])) {
+			rc = -EINVAL;
+		}
+	}
+
+	return rc;
+}
+
 int
 zsl_phy_sound_beat(zsl_real_t fa, zsl_real_t fb, zsl_real_t *f)
 {
@@ -87,3 +176,35 @@ zsl_phy_sound_beat(zsl_real_t fa, zsl_real_t fb, zsl_real_t *f)
 
 	return 0;
 }
+
+int
+zsl_phy_sound_speed_air(zsl_real_t t, zsl_real_t p, zsl_real_t rh,
+			zsl_real_t *v)
+{
+	int rc;
+	zsl_real_t xv, m, cp;
+
+	rc = zsl_phy_gas_air_xv(t, p, rh, &xv);
+	if (rc) {
+		*v = NAN;
+		return rc;
+	}
+
+	/*
+	 * Mean molar mass, and molar heat capacity over R, taking 7/2 for
+	 * dry air and 4 for water vapour.
+	 */
+	m = (1.0 - xv) * 28.96546E-3 + xv * 18.01528E-3;
+	cp = (1.0 - xv) * 3.5 + xv * 4.0;
+
+	*v = ZSL_SQRT(cp / (cp - 1.0) * ZSL_IDEAL_GAS_CONST * t / m);
+
+	return 0;
+}
+
+int
+zsl_phy_sound_speed_air_fn(zsl_real_t t, zsl_real_t p, void *arg,
+			   zsl_real_t *v)
+{
+	return zsl_phy_sound_speed_air(t, p, arg ? *(zsl_real_t *)arg : 0.0, v);
+}
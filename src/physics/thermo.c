@@ -35,6 +35,24 @@ zsl_phy_thermo_cels_kel(zsl_real_t t1, zsl_real_t *t2, bool ktc)
 	return 0;
 }
 
+int
+zsl_phy_thermo_cels_kel_vec(struct zsl_vec *t1, struct zsl_vec *t2, bool ktc)
+{
+	zsl_real_t off = ktc ? -273.15 : 273.15;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (t1->sz != t2->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < t2->sz; i++) {
+		t2->data[i] = t1->data[i] + off;
+	}
+
+	return 0;
+}
+
 int
 zsl_phy_thermo_heat_fusion(zsl_real_t m, zsl_real_t lh, zsl_real_t *q)
 {
@@ -8,3 +8,116 @@
 #include <errno.h>
 #include <zsl/zsl.h>
 #include <zsl/physics/waves.h>
+
+int
+zsl_phy_wave_len_vec(zsl_real_t v, struct zsl_vec *f, struct zsl_vec *l)
+{
+	int rc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (f->sz != l->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < f->sz; k++) {
+		if (f->data[k] <= 0) {
+			l->data[k] = NAN;
+			rc = -EINVAL;
+			continue;
+		}
+		l->data[k] = v / f->data[k];
+	}
+
+	return rc;
+}
+
+int
+zsl_phy_wave_superpose(struct zsl_vec *a, struct zsl_vec *f,
+		       struct zsl_vec *ph, zsl_real_t t0, zsl_real_t dt,
+		       struct zsl_vec *y)
+{
+	size_t n;
+	zsl_real_t w, c, s, cr, sr, tmp;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((f->sz != a->sz) || (ph->sz != a->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k0 = 0; k0 < y->sz; k0 += ZSL_PHY_WAVE_RESYNC) {
+		n = y->sz - k0 < ZSL_PHY_WAVE_RESYNC ? y->sz - k0 :
+		    ZSL_PHY_WAVE_RESYNC;
+		for (size_t k = 0; k < n; k++) {
+			y->data[k0 + k] = 0.0;
+		}
+
+		for (size_t j = 0; j < a->sz; j++) {
+			/* Resync at the start of the block, then rotate. */
+			w = 2.0 * ZSL_PI * f->data[j];
+			tmp = w * (t0 + (zsl_real_t)k0 * dt) + ph->data[j];
+			c = a->data[j] * ZSL_COS(tmp);
+			s = a->data[j] * ZSL_SIN(tmp);
+			cr = ZSL_COS(w * dt);
+			sr = ZSL_SIN(w * dt);
+			for (size_t k = 0; k < n; k++) {
+				y->data[k0 + k] += s;
+				tmp = c * cr - s * sr;
+				s = s * cr + c * sr;
+				c = tmp;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_phy_wave_phasor_sum(struct zsl_vec *a, struct zsl_vec *ph,
+			zsl_real_t *amp, zsl_real_t *phr)
+{
+	zsl_real_t re = 0.0;
+	zsl_real_t im = 0.0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (a->sz != ph->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t k = 0; k < a->sz; k++) {
+		re += a->data[k] * ZSL_COS(ph->data[k]);
+		im += a->data[k] * ZSL_SIN(ph->data[k]);
+	}
+
+	*amp = ZSL_SQRT(re * re + im * im);
+	*phr = ZSL_ATAN2(im, re);
+
+	return 0;
+}
+
+int
+zsl_phy_wave_interf_vec(zsl_real_t i1, zsl_real_t i2, struct zsl_vec *dph,
+			struct zsl_vec *i)
+{
+	zsl_real_t s, m;
+
+	if (i1 < 0 || i2 < 0) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (dph->sz != i->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	s = i1 + i2;
+	m = 2.0 * ZSL_SQRT(i1 * i2);
+	for (size_t k = 0; k < i->sz; k++) {
+		i->data[k] = s + m * ZSL_COS(dph->data[k]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/pipeline.h>
+
+#ifndef __ZEPHYR__
+#include <time.h>
+#endif
+
+/* The hardware cycle counter, or nanoseconds outside of Zephyr. */
+static inline uint32_t
+zsl_pipe_cycles(void)
+{
+#ifdef __ZEPHYR__
+	return k_cycle_get_32();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+static inline void
+zsl_pipe_wake(struct zsl_pipe *p, uint8_t group)
+{
+#ifdef __ZEPHYR__
+	if ((p != NULL) && (group != ZSL_PIPE_EXT)) {
+		k_sem_give(&p->wake[group]);
+	}
+#else
+	(void)p;
+	(void)group;
+#endif
+}
+
+static void
+zsl_pipe_edge_reset(struct zsl_pipe_edge *e, struct zsl_pipe *p)
+{
+	e->pipe = p;
+	e->src = ZSL_PIPE_EXT;
+	e->dst = ZSL_PIPE_EXT;
+	e->head = 0;
+	e->full = 0;
+	e->tail = 0;
+}
+
+int
+zsl_pipe_init(struct zsl_pipe *p, struct zsl_pipe_node **nodes, size_t n)
+{
+	struct zsl_pipe_node *nd;
+
+	for (size_t i = 0; i < n; i++) {
+		nd = nodes[i];
+		if ((nd->fn == NULL) || (nd->in == NULL) ||
+		    (nd->group >= ZSL_PIPE_GROUPS) || (nd->in == nd->out)) {
+			return -EINVAL;
+		}
+		zsl_pipe_edge_reset(nd->in, p);
+		if (nd->out != NULL) {
+			zsl_pipe_edge_reset(nd->out, p);
+		}
+	}
+
+	/* Each edge may have only one producer and one consumer. */
+	for (size_t i = 0; i < n; i++) {
+		nd = nodes[i];
+		if (nd->in->dst != ZSL_PIPE_EXT) {
+			return -EINVAL;
+		}
+		nd->in->dst = nd->group;
+		if (nd->out != NULL) {
+			if (nd->out->src != ZSL_PIPE_EXT) {
+				return -EINVAL;
+			}
+			nd->out->src = nd->group;
+		}
+		memset(&nd->stats, 0, sizeof(nd->stats));
+	}
+
+	p->nodes = nodes;
+	p->n = n;
+#ifdef __ZEPHYR__
+	for (size_t g = 0; g < ZSL_PIPE_GROUPS; g++) {
+		k_sem_init(&p->wake[g], 0, 1);
+	}
+#endif
+
+	return 0;
+}
+
+void *
+zsl_pipe_edge_claim(struct zsl_pipe_edge *e)
+{
+	uint32_t head = e->head;
+
+	if (head - __atomic_load_n(&e->tail, __ATOMIC_ACQUIRE) >= e->n) {
+		e->full++;
+		return NULL;
+	}
+
+	return e->mem + (head & (e->n - 1)) * e->sz;
+}
+
+void
+zsl_pipe_edge_publish(struct zsl_pipe_edge *e)
+{
+	/* Publish the slot only once it has been written. */
+	__atomic_store_n(&e->head, e->head + 1, __ATOMIC_RELEASE);
+	zsl_pipe_wake(e->pipe, e->dst);
+}
+
+const void *
+zsl_pipe_edge_peek(struct zsl_pipe_edge *e)
+{
+	uint32_t tail = e->tail;
+
+	if (__atomic_load_n(&e->head, __ATOMIC_ACQUIRE) == tail) {
+		return NULL;
+	}
+
+	return e->mem + (tail & (e->n - 1)) * e->sz;
+}
+
+void
+zsl_pipe_edge_release(struct zsl_pipe_edge *e)
+{
+	__atomic_store_n(&e->tail, e->tail + 1, __ATOMIC_RELEASE);
+	zsl_pipe_wake(e->pipe, e->src);
+}
+
+int
+zsl_pipe_step(struct zsl_pipe_node *nd)
+{
+	int rc;
+	uint32_t t0, cycles;
+	const void *in;
+	void *out = NULL;
+	struct zsl_pipe_stats *st = &nd->stats;
+
+	in = zsl_pipe_edge_peek(nd->in);
+	if (in == NULL) {
+		return -EAGAIN;
+	}
+
+	if (nd->out != NULL) {
+		out = zsl_pipe_edge_claim(nd->out);
+		if (out == NULL) {
+			st->stalls++;
+			return -ENOBUFS;
+		}
+	}
+
+	t0 = zsl_pipe_cycles();
+	rc = nd->fn(in, out, nd->arg);
+	/* Unsigned subtraction handles a single counter wrap. */
+	cycles = zsl_pipe_cycles() - t0;
+
+	if (st->calls == 0 || cycles < st->min) {
+		st->min = cycles;
+	}
+	if (cycles > st->max) {
+		st->max = cycles;
+	}
+	st->total += cycles;
+	st->calls++;
+
+	if (rc < 0) {
+		st->errors++;
+	} else if ((rc == 0) && (out != NULL)) {
+		zsl_pipe_edge_publish(nd->out);
+	}
+
+	/* The input is released even on an error, so that a bad slot cannot
+	 * stall the pipeline. */
+	zsl_pipe_edge_release(nd->in);
+
+	return rc;
+}
+
+size_t
+zsl_pipe_run(struct zsl_pipe *p, uint8_t group)
+{
+	int rc;
+	size_t runs = 0;
+	bool progress = true;
+
+	while (progress) {
+		progress = false;
+		for (size_t i = 0; i < p->n; i++) {
+			if (p->nodes[i]->group != group) {
+				continue;
+			}
+			rc = zsl_pipe_step(p->nodes[i]);
+			if ((rc != -EAGAIN) && (rc != -ENOBUFS)) {
+				progress = true;
+				runs++;
+			}
+		}
+	}
+
+	return runs;
+}
+
+int
+zsl_pipe_stats(struct zsl_pipe_node *nd, struct zsl_pipe_stats *st,
+	       bool reset)
+{
+	*st = nd->stats;
+	if (reset) {
+		memset(&nd->stats, 0, sizeof(nd->stats));
+	}
+
+	return 0;
+}
+
+#ifdef __ZEPHYR__
+void
+zsl_pipe_loop(struct zsl_pipe *p, uint8_t group)
+{
+	while (1) {
+		/* The semaphore may have been given for slots that an
+		 * earlier pass already handled, so this can wake without
+		 * work, but never miss any. */
+		if (zsl_pipe_run(p, group) == 0) {
+			k_sem_take(&p->wake[group], K_FOREVER);
+		}
+	}
+}
+
+static void
+zsl_pipe_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p3);
+
+	zsl_pipe_loop((struct zsl_pipe *)p1, (uint8_t)(uintptr_t)p2);
+}
+
+int
+zsl_pipe_start(struct zsl_pipe *p, uint8_t group, struct k_thread *t,
+	       k_thread_stack_t *stack, size_t stack_sz, int prio, int cpu)
+{
+	if (group >= ZSL_PIPE_GROUPS) {
+		return -EINVAL;
+	}
+
+#if !CONFIG_SCHED_CPU_MASK
+	if (cpu != -1) {
+		return -ENOTSUP;
+	}
+#endif
+
+	k_thread_create(t, stack, stack_sz, zsl_pipe_thread, p,
+			(void *)(uintptr_t)group, NULL, prio, 0, K_FOREVER);
+#if CONFIG_SCHED_CPU_MASK
+	if (cpu != -1) {
+		k_thread_cpu_pin(t, cpu);
+	}
+#endif
+	k_thread_start(t);
+
+	return 0;
+}
+#endif
@@ -78,7 +78,7 @@ zsl_real_t zsl_prob_normal_pdf(zsl_real_t *m, zsl_real_t *s, zsl_real_t *x)
 	zsl_real_t y;
 
 	y = (1. / (*s * ZSL_SQRT(2. * ZSL_PI))) *
-	    ZSL_POW(ZSL_E, -0.5 * ((*x - *m) / *s) * ((*x - *m) / *s));
+	    ZSL_EXP(-0.5 * ((*x - *m) / *s) * ((*x - *m) / *s));
 
 	return y;
 }
@@ -92,18 +92,12 @@ zsl_real_t zsl_prob_normal_cdf(zsl_real_t *m, zsl_real_t *s, zsl_real_t *x)
 	return y;
 }
 
-zsl_real_t zsl_prob_erf_inv(zsl_real_t *x)
+/* The polynomial approximation behind zsl_prob_erf_inv, for |x| < 1. */
+static inline zsl_real_t zsl_prob_erf_inv_poly(zsl_real_t x)
 {
-	zsl_real_t p, r, t;
-	
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure x is between -1 and 1. */
-	if (*x <= -1.0 || *x >= 1.0) {
-		return -EINVAL;
-	}
-#endif
+	zsl_real_t p, t;
 
-	t = ZSL_FMA(*x, 0.0 - *x, 1.0);
+	t = ZSL_FMA(x, 0.0 - x, 1.0);
 	t = ZSL_LOG(t);
 	if (ZSL_ABS(t) > 6.125) {
 		p = 3.03697567e-10;                     //  0x1.4deb44p-32
@@ -127,8 +121,19 @@ zsl_real_t zsl_prob_erf_inv(zsl_real_t *x)
 		p = ZSL_FMA(p, t, -2.32015476e-1);      // -0x1.db2aeep-3
 		p = ZSL_FMA(p, t,  8.86226892e-1);
 	}
-	r = *x * p;
-	return r;
+	return x * p;
+}
+
+zsl_real_t zsl_prob_erf_inv(zsl_real_t *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure x is between -1 and 1. */
+	if (*x <= -1.0 || *x >= 1.0) {
+		return -EINVAL;
+	}
+#endif
+
+	return zsl_prob_erf_inv_poly(*x);
 }
 
 zsl_real_t zsl_prob_normal_cdf_inv(zsl_real_t *m, zsl_real_t *s, zsl_real_t *p)
@@ -148,6 +153,89 @@ zsl_real_t zsl_prob_normal_cdf_inv(zsl_real_t *m, zsl_real_t *s, zsl_real_t *p)
 	return y;
 }
 
+int zsl_prob_normal_pdf_vec(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (x->sz != y->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The constants are computed once, leaving one exp() per sample. */
+	zsl_real_t k = 1. / (*s * ZSL_SQRT(2. * ZSL_PI));
+	zsl_real_t c = 1. / (*s * ZSL_SQRT(2.));
+	zsl_real_t z;
+
+	for (size_t i = 0; i < x->sz; i++) {
+		z = (x->data[i] - *m) * c;
+		y->data[i] = k * ZSL_EXP(-z * z);
+	}
+
+	return 0;
+}
+
+int zsl_prob_normal_log_lik(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, zsl_real_t *ll)
+{
+	zsl_real_t z, sum = 0.0;
+
+	for (size_t i = 0; i < x->sz; i++) {
+		z = (x->data[i] - *m);
+		sum += z * z;
+	}
+
+	/* The sum of the log-densities, needing no exp() or log() per
+	 * sample. */
+	*ll = -0.5 * sum / (*s * *s) -
+	      (zsl_real_t)x->sz * ZSL_LOG(*s * ZSL_SQRT(2. * ZSL_PI));
+
+	return 0;
+}
+
+int zsl_prob_normal_cdf_vec(zsl_real_t *m, zsl_real_t *s,
+			    const struct zsl_vec *x, struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (x->sz != y->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t c = 1. / (*s * ZSL_SQRT(2.));
+
+	for (size_t i = 0; i < x->sz; i++) {
+		y->data[i] = 0.5 * (1. + ZSL_ERF((x->data[i] - *m) * c));
+	}
+
+	return 0;
+}
+
+int zsl_prob_normal_cdf_inv_vec(zsl_real_t *m, zsl_real_t *s,
+				const struct zsl_vec *p, struct zsl_vec *y)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (p->sz != y->sz) {
+		return -EINVAL;
+	}
+	/* Make sure every p is between 0 and 1. */
+	for (size_t i = 0; i < p->sz; i++) {
+		if (p->data[i] <= 0.0 || p->data[i] >= 1.0) {
+			return -EINVAL;
+		}
+	}
+#endif
+
+	zsl_real_t c = *s * ZSL_SQRT(2.0);
+
+	for (size_t i = 0; i < p->sz; i++) {
+		y->data[i] = *m + c * zsl_prob_erf_inv_poly(2.0 * p->data[i] -
+							    1.0);
+	}
+
+	return 0;
+}
+
 int zsl_prob_entropy(struct zsl_vec *v, zsl_real_t *h)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
@@ -163,10 +251,239 @@ int zsl_prob_entropy(struct zsl_vec *v, zsl_real_t *h)
 
 	*h = 0.0;
 	for (size_t i = 0; i < v->sz; i++) {
-		*h -= v->data[i] * ZSL_LOG(v->data[i]);
+		/* The limit of p * log(p) as p goes to zero is zero. */
+		if (v->data[i] > 0.0) {
+			*h -= v->data[i] * ZSL_LOG(v->data[i]);
+		}
 	}
 
 	*h /= ZSL_LOG(2.);
 
 	return 0;
 }
+
+int zsl_prob_hist_init(struct zsl_prob_hist *h, zsl_real_t lo, zsl_real_t hi)
+{
+	if (!(hi > lo) || h->count.sz == 0) {
+		return -EINVAL;
+	}
+
+	h->edges = NULL;
+	h->lo = lo;
+	h->hi = hi;
+	h->scale = (zsl_real_t)h->count.sz / (hi - lo);
+
+	return zsl_prob_hist_reset(h);
+}
+
+int zsl_prob_hist_init_edges(struct zsl_prob_hist *h,
+			     const struct zsl_vec *edges)
+{
+	if (h->count.sz == 0 || edges->sz != h->count.sz + 1) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 1; i < edges->sz; i++) {
+		if (!(edges->data[i] > edges->data[i - 1])) {
+			return -EINVAL;
+		}
+	}
+
+	h->edges = edges;
+	h->lo = edges->data[0];
+	h->hi = edges->data[edges->sz - 1];
+	h->scale = 0.0;
+
+	return zsl_prob_hist_reset(h);
+}
+
+int zsl_prob_hist_reset(struct zsl_prob_hist *h)
+{
+	memset(h->count.data, 0, h->count.sz * sizeof(zsl_real_t));
+	h->total = 0.0;
+	h->under = 0;
+	h->over = 0;
+
+	return 0;
+}
+
+int zsl_prob_hist_bin(const struct zsl_prob_hist *h, zsl_real_t x,
+		      size_t *bin)
+{
+	size_t lo, hi, mid;
+
+	/* Written so that NaN fails the test. */
+	if (!(x >= h->lo) || x >= h->hi) {
+		return -EINVAL;
+	}
+
+	if (h->edges == NULL) {
+		*bin = (size_t)((x - h->lo) * h->scale);
+		/* Rounding can push values just below 'hi' past the end. */
+		if (*bin >= h->count.sz) {
+			*bin = h->count.sz - 1;
+		}
+		return 0;
+	}
+
+	/* The last edge at or below x, with edges[lo] <= x < edges[hi]. */
+	lo = 0;
+	hi = h->count.sz;
+	while (hi - lo > 1) {
+		mid = lo + (hi - lo) / 2;
+		if (h->edges->data[mid] <= x) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	*bin = lo;
+
+	return 0;
+}
+
+int zsl_prob_hist_feed(struct zsl_prob_hist *h, zsl_real_t x)
+{
+	size_t bin;
+
+	if (zsl_prob_hist_bin(h, x, &bin) != 0) {
+		if (x >= h->hi) {
+			h->over++;
+		} else {
+			h->under++;
+		}
+		return 0;
+	}
+
+	h->count.data[bin] += 1.0;
+	h->total += 1.0;
+
+	return 0;
+}
+
+int zsl_prob_hist_feed_vec(struct zsl_prob_hist *h, const struct zsl_vec *v)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		zsl_prob_hist_feed(h, v->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_prob_hist_pmf(const struct zsl_prob_hist *h, struct zsl_vec *p)
+{
+	if (p->sz != h->count.sz || h->total <= 0.0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < p->sz; i++) {
+		p->data[i] = h->count.data[i] / h->total;
+	}
+
+	return 0;
+}
+
+int zsl_prob_hist_entropy(const struct zsl_prob_hist *h, zsl_real_t *e)
+{
+	zsl_real_t c;
+	zsl_real_t sum = 0.0;
+
+	if (h->total <= 0.0) {
+		return -EINVAL;
+	}
+
+	/* H = log(N) - sum(c * log(c)) / N, with no division per bin. */
+	for (size_t i = 0; i < h->count.sz; i++) {
+		c = h->count.data[i];
+		if (c > 0.0) {
+			sum += c * ZSL_LOG(c);
+		}
+	}
+
+	*e = (ZSL_LOG(h->total) - sum / h->total) / ZSL_LOG(2.);
+
+	return 0;
+}
+
+int zsl_prob_hist2_reset(struct zsl_prob_hist2 *h)
+{
+	if (h->count.sz_rows != h->x.count.sz ||
+	    h->count.sz_cols != h->y.count.sz) {
+		return -EINVAL;
+	}
+
+	zsl_prob_hist_reset(&h->x);
+	zsl_prob_hist_reset(&h->y);
+	memset(h->count.data, 0,
+	       h->count.sz_rows * h->count.sz_cols * sizeof(zsl_real_t));
+	h->outside = 0;
+
+	return 0;
+}
+
+int zsl_prob_hist2_feed(struct zsl_prob_hist2 *h, zsl_real_t a, zsl_real_t b)
+{
+	size_t i, j;
+
+	if (zsl_prob_hist_bin(&h->x, a, &i) != 0 ||
+	    zsl_prob_hist_bin(&h->y, b, &j) != 0) {
+		h->outside++;
+		return 0;
+	}
+
+	h->x.count.data[i] += 1.0;
+	h->x.total += 1.0;
+	h->y.count.data[j] += 1.0;
+	h->y.total += 1.0;
+	h->count.data[i * h->count.sz_cols + j] += 1.0;
+
+	return 0;
+}
+
+int zsl_prob_hist2_feed_vec(struct zsl_prob_hist2 *h, const struct zsl_vec *a,
+			    const struct zsl_vec *b)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (a->sz != b->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < a->sz; i++) {
+		zsl_prob_hist2_feed(h, a->data[i], b->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_prob_hist2_mi(const struct zsl_prob_hist2 *h, zsl_real_t *mi)
+{
+	zsl_real_t n = h->x.total;
+	zsl_real_t c, cx;
+	zsl_real_t sum = 0.0;
+
+	if (n <= 0.0) {
+		return -EINVAL;
+	}
+
+	/* I = sum(c(i,j) * log(c(i,j) * N / (c(i) * c(j)))) / N. */
+	for (size_t i = 0; i < h->count.sz_rows; i++) {
+		cx = h->x.count.data[i];
+		for (size_t j = 0; j < h->count.sz_cols; j++) {
+			c = h->count.data[i * h->count.sz_cols + j];
+			if (c > 0.0) {
+				sum += c * ZSL_LOG(c * n /
+						   (cx * h->y.count.data[j]));
+			}
+		}
+	}
+
+	*mi = sum / n / ZSL_LOG(2.);
+
+	/* Rounding can leave a tiny negative value for independent data. */
+	if (*mi < 0.0) {
+		*mi = 0.0;
+	}
+
+	return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+#include <zsl/random.h>
+
+/* The ziggurat's base strip starts at R, and the 128 strips each have area
+ * V. For strip i, a 31-bit sample below zsl_rand_kn[i] lies wholly inside
+ * the curve, zsl_rand_wn[i] scales it to x, and zsl_rand_fn[i] is the
+ * density at the strip's right-hand edge. */
+#define ZSL_RAND_ZIG_R 3.442619855899
+
+static const uint32_t zsl_rand_kn[128] = {
+	0x76ad2212u, 0x00000000u, 0x600f1b53u, 0x6ce447a6u, 0x725b46a2u,
+	0x7560051du, 0x774921ebu, 0x789a25bdu, 0x799045c3u, 0x7a4bce5du,
+	0x7adf629fu, 0x7b5682a6u, 0x7bb8a8c6u, 0x7c0ae722u, 0x7c50cce7u,
+	0x7c8cec5bu, 0x7cc12cd6u, 0x7ceefed2u, 0x7d177e0bu, 0x7d3b8883u,
+	0x7d5bce6cu, 0x7d78dd64u, 0x7d932886u, 0x7dab0e57u, 0x7dc0dd30u,
+	0x7dd4d688u, 0x7de73185u, 0x7df81ceau, 0x7e07c0a3u, 0x7e163efau,
+	0x7e23b587u, 0x7e303dfdu, 0x7e3beec2u, 0x7e46db77u, 0x7e51155du,
+	0x7e5aabb3u, 0x7e63abf7u, 0x7e6c222cu, 0x7e741906u, 0x7e7b9a18u,
+	0x7e82adfau, 0x7e895c63u, 0x7e8fac4bu, 0x7e95a3fbu, 0x7e9b4924u,
+	0x7ea0a0efu, 0x7ea5b00du, 0x7eaa7ac3u, 0x7eaf04f3u, 0x7eb3522au,
+	0x7eb765a5u, 0x7ebb4259u, 0x7ebeeafdu, 0x7ec2620au, 0x7ec5a9c4u,
+	0x7ec8c441u, 0x7ecbb365u, 0x7ece78edu, 0x7ed11671u, 0x7ed38d62u,
+	0x7ed5df12u, 0x7ed80cb4u, 0x7eda175cu, 0x7edc0005u, 0x7eddc78eu,
+	0x7edf6ebfu, 0x7ee0f647u, 0x7ee25ebeu, 0x7ee3a8a9u, 0x7ee4d473u,
+	0x7ee5e276u, 0x7ee6d2f5u, 0x7ee7a620u, 0x7ee85c10u, 0x7ee8f4cdu,
+	0x7ee97047u, 0x7ee9ce59u, 0x7eea0ecau, 0x7eea3147u, 0x7eea3568u,
+	0x7eea1aabu, 0x7ee9e071u, 0x7ee98602u, 0x7ee90a88u, 0x7ee86d08u,
+	0x7ee7ac6au, 0x7ee6c769u, 0x7ee5bc9cu, 0x7ee48a67u, 0x7ee32efcu,
+	0x7ee1a857u, 0x7edff42fu, 0x7ede0ffau, 0x7edbf8d9u, 0x7ed9ab94u,
+	0x7ed7248du, 0x7ed45faeu, 0x7ed1585cu, 0x7ece095fu, 0x7eca6ccbu,
+	0x7ec67be2u, 0x7ec22eeeu, 0x7ebd7d1au, 0x7eb85c35u, 0x7eb2c075u,
+	0x7eac9c20u, 0x7ea5df27u, 0x7e9e769fu, 0x7e964c16u, 0x7e8d44bau,
+	0x7e834033u, 0x7e781728u, 0x7e6b9933u, 0x7e5d8a1au, 0x7e4d9dedu,
+	0x7e3b737au, 0x7e268c2fu, 0x7e0e3ff5u, 0x7df1aa5du, 0x7dcf8c72u,
+	0x7da61a1eu, 0x7d72a0fbu, 0x7d30e097u, 0x7cd9b4abu, 0x7c600f1au,
+	0x7ba90bdcu, 0x7a722176u, 0x77d664e5u,
+};
+
+static const zsl_real_t zsl_rand_wn[128] = {
+	1.729040522e-09, 1.268092845e-10, 1.689751777e-10, 1.986268844e-10,
+	2.223243179e-10, 2.424493613e-10, 2.601613190e-10, 2.761198871e-10,
+	2.907396282e-10, 3.042997041e-10, 3.169979521e-10, 3.289802053e-10,
+	3.403573812e-10, 3.512160221e-10, 3.616250995e-10, 3.716405763e-10,
+	3.813085643e-10, 3.906675681e-10, 3.997501187e-10, 4.085839862e-10,
+	4.171930964e-10, 4.255982353e-10, 4.338175974e-10, 4.418672181e-10,
+	4.497613196e-10, 4.575125889e-10, 4.651324048e-10, 4.726310238e-10,
+	4.800177347e-10, 4.873009868e-10, 4.944884981e-10, 5.015873466e-10,
+	5.086040482e-10, 5.155446229e-10, 5.224146520e-10, 5.292193275e-10,
+	5.359634953e-10, 5.426516925e-10, 5.492881800e-10, 5.558769721e-10,
+	5.624218613e-10, 5.689264417e-10, 5.753941290e-10, 5.818281786e-10,
+	5.882317021e-10, 5.946076818e-10, 6.009589843e-10, 6.072883728e-10,
+	6.135985177e-10, 6.198920075e-10, 6.261713578e-10, 6.324390202e-10,
+	6.386973906e-10, 6.449488167e-10, 6.511956053e-10, 6.574400293e-10,
+	6.636843339e-10, 6.699307434e-10, 6.761814667e-10, 6.824387039e-10,
+	6.887046513e-10, 6.949815079e-10, 7.012714804e-10, 7.075767893e-10,
+	7.138996747e-10, 7.202424015e-10, 7.266072661e-10, 7.329966016e-10,
+	7.394127850e-10, 7.458582428e-10, 7.523354585e-10, 7.588469793e-10,
+	7.653954238e-10, 7.719834898e-10, 7.786139632e-10, 7.852897266e-10,
+	7.920137693e-10, 7.987891979e-10, 8.056192475e-10, 8.125072942e-10,
+	8.194568683e-10, 8.264716694e-10, 8.335555823e-10, 8.407126946e-10,
+	8.479473165e-10, 8.552640026e-10, 8.626675754e-10, 8.701631525e-10,
+	8.777561764e-10, 8.854524480e-10, 8.932581641e-10, 9.011799601e-10,
+	9.092249580e-10, 9.174008206e-10, 9.257158144e-10, 9.341788804e-10,
+	9.427997160e-10, 9.515888694e-10, 9.605578494e-10, 9.697192525e-10,
+	9.790869128e-10, 9.886760771e-10, 9.985036135e-10, 1.008588259e-09,
+	1.018950917e-09, 1.029615015e-09, 1.040606944e-09, 1.051956589e-09,
+	1.063697999e-09, 1.075870210e-09, 1.088518296e-09, 1.101694708e-09,
+	1.115461010e-09, 1.129890161e-09, 1.145069570e-09, 1.161105243e-09,
+	1.178127561e-09, 1.196299505e-09, 1.215828698e-09, 1.236985629e-09,
+	1.260132330e-09, 1.285769684e-09, 1.314620185e-09, 1.347783956e-09,
+	1.387063532e-09, 1.435740319e-09, 1.500865903e-09, 1.603094794e-09,
+};
+
+static const zsl_real_t zsl_rand_fn[128] = {
+	1.000000000e+00, 9.635996931e-01, 9.362826817e-01, 9.130436480e-01,
+	8.922816508e-01, 8.732430489e-01, 8.555006079e-01, 8.387836053e-01,
+	8.229072114e-01, 8.077382947e-01, 7.931770118e-01, 7.791460859e-01,
+	7.655841739e-01, 7.524415592e-01, 7.396772437e-01, 7.272569183e-01,
+	7.151515074e-01, 7.033360990e-01, 6.917891434e-01, 6.804918410e-01,
+	6.694276673e-01, 6.585820001e-01, 6.479418211e-01, 6.374954773e-01,
+	6.272324852e-01, 6.171433708e-01, 6.072195366e-01, 5.974531509e-01,
+	5.878370544e-01, 5.783646811e-01, 5.690299911e-01, 5.598274127e-01,
+	5.507517931e-01, 5.417983550e-01, 5.329626594e-01, 5.242405727e-01,
+	5.156282382e-01, 5.071220511e-01, 4.987186355e-01, 4.904148253e-01,
+	4.822076463e-01, 4.740943007e-01, 4.660721527e-01, 4.581387163e-01,
+	4.502916437e-01, 4.425287153e-01, 4.348478302e-01, 4.272469983e-01,
+	4.197243320e-01, 4.122780401e-01, 4.049064208e-01, 3.976078565e-01,
+	3.903808082e-01, 3.832238111e-01, 3.761354695e-01, 3.691144537e-01,
+	3.621594954e-01, 3.552693848e-01, 3.484429675e-01, 3.416791412e-01,
+	3.349768533e-01, 3.283350984e-01, 3.217529159e-01, 3.152293881e-01,
+	3.087636380e-01, 3.023548278e-01, 2.960021568e-01, 2.897048604e-01,
+	2.834622082e-01, 2.772735029e-01, 2.711380791e-01, 2.650553023e-01,
+	2.590245674e-01, 2.530452985e-01, 2.471169475e-01, 2.412389935e-01,
+	2.354109423e-01, 2.296323252e-01, 2.239026994e-01, 2.182216466e-01,
+	2.125887731e-01, 2.070037094e-01, 2.014661101e-01, 1.959756531e-01,
+	1.905320403e-01, 1.851349970e-01, 1.797842721e-01, 1.744796383e-01,
+	1.692208922e-01, 1.640078547e-01, 1.588403711e-01, 1.537183122e-01,
+	1.486415742e-01, 1.436100801e-01, 1.386237800e-01, 1.336826526e-01,
+	1.287867062e-01, 1.239359802e-01, 1.191305467e-01, 1.143705124e-01,
+	1.096560210e-01, 1.049872554e-01, 1.003644410e-01, 9.578784912e-02,
+	9.125780083e-02, 8.677467189e-02, 8.233889824e-02, 7.795098251e-02,
+	7.361150188e-02, 6.932111739e-02, 6.508058521e-02, 6.089077035e-02,
+	5.675266348e-02, 5.266740190e-02, 4.863629586e-02, 4.466086220e-02,
+	4.074286807e-02, 3.688438879e-02, 3.308788615e-02, 2.935631744e-02,
+	2.569329194e-02, 2.210330462e-02, 1.859210274e-02, 1.516729801e-02,
+	1.183947866e-02, 8.624484413e-03, 5.548995221e-03, 2.669629084e-03,
+};
+
+static inline uint32_t zsl_rand_rotl(uint32_t x, int k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+/* One step of SplitMix64, used to expand a seed. */
+static uint64_t zsl_rand_splitmix(uint64_t *x)
+{
+	uint64_t z = (*x += 0x9e3779b97f4a7c15u);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+
+	return z ^ (z >> 31);
+}
+
+int zsl_rand_seed(struct zsl_rand *r, uint64_t seed)
+{
+	uint64_t z;
+
+	for (size_t i = 0; i < 4; i += 2) {
+		z = zsl_rand_splitmix(&seed);
+		r->s[i] = (uint32_t)z;
+		r->s[i + 1] = (uint32_t)(z >> 32);
+	}
+
+	/* SplitMix64 can't produce an all-zero state, but guard anyway. */
+	if ((r->s[0] | r->s[1] | r->s[2] | r->s[3]) == 0) {
+		r->s[0] = 1;
+	}
+
+	return 0;
+}
+
+uint32_t zsl_rand_u32(struct zsl_rand *r)
+{
+	uint32_t *s = r->s;
+	uint32_t res = zsl_rand_rotl(s[0] + s[3], 7) + s[0];
+	uint32_t t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = zsl_rand_rotl(s[3], 11);
+
+	return res;
+}
+
+int zsl_rand_jump(struct zsl_rand *r)
+{
+	static const uint32_t jump[4] = {
+		0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu
+	};
+	uint32_t t[4] = { 0, 0, 0, 0 };
+
+	for (size_t i = 0; i < 4; i++) {
+		for (int b = 0; b < 32; b++) {
+			if (jump[i] & ((uint32_t)1 << b)) {
+				t[0] ^= r->s[0];
+				t[1] ^= r->s[1];
+				t[2] ^= r->s[2];
+				t[3] ^= r->s[3];
+			}
+			zsl_rand_u32(r);
+		}
+	}
+
+	for (size_t i = 0; i < 4; i++) {
+		r->s[i] = t[i];
+	}
+
+	return 0;
+}
+
+zsl_real_t zsl_rand_uniform(struct zsl_rand *r)
+{
+#if CONFIG_ZSL_SINGLE_PRECISION
+	return (zsl_real_t)(zsl_rand_u32(r) >> 8) * (1.0f / 16777216.0f);
+#else
+	uint64_t hi = zsl_rand_u32(r) >> 5;
+	uint64_t lo = zsl_rand_u32(r) >> 6;
+
+	return (zsl_real_t)((hi << 26) | lo) * (1.0 / 9007199254740992.0);
+#endif
+}
+
+/* A uniform value in (0.0, 1.0], safe to take the logarithm of. */
+static inline zsl_real_t zsl_rand_uniform_pos(struct zsl_rand *r)
+{
+	return 1.0 - zsl_rand_uniform(r);
+}
+
+zsl_real_t zsl_rand_normal(struct zsl_rand *r)
+{
+	int32_t hz;
+	uint32_t iz;
+	zsl_real_t x, y;
+
+	for (;;) {
+		hz = (int32_t)zsl_rand_u32(r);
+		iz = (uint32_t)hz & 127;
+		x = (zsl_real_t)hz * zsl_rand_wn[iz];
+
+		/* The fast path: inside the strip's rectangle. */
+		if ((uint32_t)(hz < 0 ? -(int64_t)hz : hz) < zsl_rand_kn[iz]) {
+			return x;
+		}
+
+		if (iz == 0) {
+			/* The base strip's tail beyond R, sampled with
+			 * Marsaglia's exponential method. */
+			do {
+				x = -ZSL_LOG(zsl_rand_uniform_pos(r)) /
+				    ZSL_RAND_ZIG_R;
+				y = -ZSL_LOG(zsl_rand_uniform_pos(r));
+			} while (y + y < x * x);
+
+			return (hz > 0) ? ZSL_RAND_ZIG_R + x :
+			       -ZSL_RAND_ZIG_R - x;
+		}
+
+		/* The wedge between the rectangle and the curve. */
+		if (zsl_rand_fn[iz] + zsl_rand_uniform(r) *
+		    (zsl_rand_fn[iz - 1] - zsl_rand_fn[iz]) <
+		    ZSL_EXP(-0.5 * x * x)) {
+			return x;
+		}
+	}
+}
+
+int zsl_rand_vec_uniform(struct zsl_rand *r, struct zsl_vec *v, zsl_real_t a,
+			 zsl_real_t b)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = a + (b - a) * zsl_rand_uniform(r);
+	}
+
+	return 0;
+}
+
+int zsl_rand_vec_normal(struct zsl_rand *r, struct zsl_vec *v, zsl_real_t m,
+			zsl_real_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = m + s * zsl_rand_normal(r);
+	}
+
+	return 0;
+}
+
+int zsl_rand_mtx_uniform(struct zsl_rand *r, struct zsl_mtx *m, zsl_real_t a,
+			 zsl_real_t b)
+{
+	struct zsl_vec v = {
+		.sz = m->sz_rows * m->sz_cols,
+		.data = m->data
+	};
+
+	return zsl_rand_vec_uniform(r, &v, a, b);
+}
+
+int zsl_rand_mtx_normal(struct zsl_rand *r, struct zsl_mtx *m,
+			zsl_real_t mean, zsl_real_t s)
+{
+	struct zsl_vec v = {
+		.sz = m->sz_rows * m->sz_cols,
+		.data = m->data
+	};
+
+	return zsl_rand_vec_normal(r, &v, mean, s);
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/zsl.h>
+#include <zsl/sensor.h>
+#include <zsl/measurement/batch.h>
+
+int
+zsl_sns_conv(const int32_t *val, size_t n, zsl_real_t *out, size_t stride)
+{
+	const zsl_real_t u = 1E-6;
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (stride == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Four independent conversions per pass, for SIMD or dual issue. */
+	for (; i + 4 <= n; i += 4) {
+		zsl_real_t a = (zsl_real_t)val[2 * i] +
+			       (zsl_real_t)val[2 * i + 1] * u;
+		zsl_real_t b = (zsl_real_t)val[2 * i + 2] +
+			       (zsl_real_t)val[2 * i + 3] * u;
+		zsl_real_t c = (zsl_real_t)val[2 * i + 4] +
+			       (zsl_real_t)val[2 * i + 5] * u;
+		zsl_real_t d = (zsl_real_t)val[2 * i + 6] +
+			       (zsl_real_t)val[2 * i + 7] * u;
+
+		out[i * stride] = a;
+		out[(i + 1) * stride] = b;
+		out[(i + 2) * stride] = c;
+		out[(i + 3) * stride] = d;
+	}
+
+	for (; i < n; i++) {
+		out[i * stride] = (zsl_real_t)val[2 * i] +
+				  (zsl_real_t)val[2 * i + 1] * u;
+	}
+
+	return 0;
+}
+
+#if CONFIG_ZSL_SENSOR
+
+#ifdef CONFIG_ZSL_SENSOR_STREAMS
+#define ZSL_SNS_STREAMS CONFIG_ZSL_SENSOR_STREAMS
+#else
+#define ZSL_SNS_STREAMS 1
+#endif
+
+/* zsl_sns_conv reads sensor_value arrays as (val1, val2) pairs. */
+BUILD_ASSERT(sizeof(struct sensor_value) == 2 * sizeof(int32_t),
+	     "struct sensor_value is not two packed int32_t values");
+
+/* The running streams, looked up by device in the trigger handler, since
+ * drivers may pass their own copy of the trigger to the handler. */
+static struct zsl_sns_stream *zsl_sns_streams[ZSL_SNS_STREAMS];
+static struct k_spinlock zsl_sns_lock;
+
+size_t
+zsl_sns_chan_width(enum sensor_channel ch)
+{
+	switch (ch) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_MAGN_XYZ:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+/* Returns the number of values in one sample of channels 'ch', or 0 if
+ * that is more than ZSL_SNS_MAX_VALS. */
+static size_t
+zsl_sns_count(const enum sensor_channel *ch, size_t nch)
+{
+	size_t cnt = 0;
+
+	for (size_t i = 0; i < nch; i++) {
+		cnt += zsl_sns_chan_width(ch[i]);
+	}
+
+	return (cnt > ZSL_SNS_MAX_VALS) ? 0 : cnt;
+}
+
+/* Fetches a sample from 'dev', and gets channels 'ch' into 'sv'. */
+static int
+zsl_sns_get(const struct device *dev, const enum sensor_channel *ch,
+	    size_t nch, struct sensor_value *sv)
+{
+	int rc;
+
+	rc = sensor_sample_fetch(dev);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < nch; i++) {
+		rc = sensor_channel_get(dev, ch[i], sv);
+		if (rc) {
+			return rc;
+		}
+		sv += zsl_sns_chan_width(ch[i]);
+	}
+
+	return 0;
+}
+
+int
+zsl_sns_read(const struct device *dev, const enum sensor_channel *ch,
+	     size_t nch, struct zsl_vec *v)
+{
+	int rc;
+	size_t cnt = zsl_sns_count(ch, nch);
+	struct sensor_value sv[ZSL_SNS_MAX_VALS];
+
+	if ((cnt == 0) || (v->sz != cnt)) {
+		return -EINVAL;
+	}
+
+	rc = zsl_sns_get(dev, ch, nch, sv);
+	if (rc) {
+		return rc;
+	}
+
+	return zsl_sns_conv((const int32_t *)sv, cnt, v->data, 1);
+}
+
+int
+zsl_sns_read_batch(const struct device *dev, const enum sensor_channel *ch,
+		   size_t nch, struct zsl_measurement *mes, size_t s)
+{
+	int rc;
+	size_t cnt = zsl_sns_count(ch, nch);
+	size_t n = (size_t)1 << mes->header.srclen.samples;
+	struct sensor_value sv[ZSL_SNS_MAX_VALS];
+
+	if ((cnt == 0) || (cnt != zsl_mes_batch_chans(mes)) || (s >= n)) {
+		return -EINVAL;
+	}
+
+	rc = zsl_sns_get(dev, ch, nch, sv);
+	if (rc) {
+		return rc;
+	}
+
+	/* Sample 's' is column 's' of the channel-major payload. */
+	return zsl_sns_conv((const int32_t *)sv, cnt,
+			    (zsl_real_t *)mes->payload + s, n);
+}
+
+static void
+zsl_sns_stream_handler(const struct device *dev, struct sensor_trigger *trig)
+{
+	struct zsl_sns_stream *st = NULL;
+	k_spinlock_key_t key;
+	size_t n;
+
+	ARG_UNUSED(trig);
+
+	key = k_spin_lock(&zsl_sns_lock);
+	for (size_t i = 0; i < ZSL_SNS_STREAMS; i++) {
+		if (zsl_sns_streams[i] && zsl_sns_streams[i]->dev == dev) {
+			st = zsl_sns_streams[i];
+			break;
+		}
+	}
+	k_spin_unlock(&zsl_sns_lock, key);
+
+	if (st == NULL) {
+		return;
+	}
+
+	n = (size_t)1 << st->mes->header.srclen.samples;
+	if (st->next >= n) {
+		/* Still fetch, since some drivers only rearm the trigger once
+		 * the sample has been read. */
+		st->dropped++;
+		sensor_sample_fetch(dev);
+		return;
+	}
+
+	if (zsl_sns_read_batch(dev, st->ch, st->nch, st->mes, st->next) == 0) {
+		st->next++;
+		if (st->next == n) {
+			k_sem_give(&st->full);
+		}
+	}
+}
+
+int
+zsl_sns_stream_start(struct zsl_sns_stream *st, const struct device *dev,
+		     const enum sensor_channel *ch, size_t nch,
+		     struct zsl_measurement *mes)
+{
+	int rc;
+	int slot = -1;
+	size_t cnt = zsl_sns_count(ch, nch);
+	k_spinlock_key_t key;
+
+	if ((cnt == 0) || (cnt != zsl_mes_batch_chans(mes))) {
+		return -EINVAL;
+	}
+
+	st->dev = dev;
+	st->ch = ch;
+	st->nch = nch;
+	st->mes = mes;
+	st->next = 0;
+	st->dropped = 0;
+	st->trig.type = SENSOR_TRIG_DATA_READY;
+	st->trig.chan = SENSOR_CHAN_ALL;
+	k_sem_init(&st->full, 0, 1);
+
+	key = k_spin_lock(&zsl_sns_lock);
+	for (int i = 0; i < ZSL_SNS_STREAMS; i++) {
+		if (zsl_sns_streams[i] == NULL) {
+			if (slot < 0) {
+				slot = i;
+			}
+		} else if (zsl_sns_streams[i]->dev == dev) {
+			k_spin_unlock(&zsl_sns_lock, key);
+			return -EBUSY;
+		}
+	}
+	if (slot >= 0) {
+		zsl_sns_streams[slot] = st;
+	}
+	k_spin_unlock(&zsl_sns_lock, key);
+
+	if (slot < 0) {
+		return -ENOMEM;
+	}
+
+	rc = sensor_trigger_set(dev, &st->trig, zsl_sns_stream_handler);
+	if (rc) {
+		key = k_spin_lock(&zsl_sns_lock);
+		zsl_sns_streams[slot] = NULL;
+		k_spin_unlock(&zsl_sns_lock, key);
+	}
+
+	return rc;
+}
+
+int
+zsl_sns_stream_wait(struct zsl_sns_stream *st, k_timeout_t timeout)
+{
+	return k_sem_take(&st->full, timeout);
+}
+
+void
+zsl_sns_stream_reset(struct zsl_sns_stream *st)
+{
+	k_sem_reset(&st->full);
+	st->next = 0;
+}
+
+int
+zsl_sns_stream_stop(struct zsl_sns_stream *st)
+{
+	int slot = -1;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&zsl_sns_lock);
+	for (int i = 0; i < ZSL_SNS_STREAMS; i++) {
+		if (zsl_sns_streams[i] == st) {
+			slot = i;
+		}
+	}
+	k_spin_unlock(&zsl_sns_lock, key);
+
+	if (slot < 0) {
+		return -EINVAL;
+	}
+
+	/* Remove the handler before freeing the slot, so that it can't be
+	 * reused while a trigger is still being handled. */
+	sensor_trigger_set(st->dev, &st->trig, NULL);
+
+	key = k_spin_lock(&zsl_sns_lock);
+	zsl_sns_streams[slot] = NULL;
+	k_spin_unlock(&zsl_sns_lock, key);
+
+	return 0;
+}
+
+#endif /* CONFIG_ZSL_SENSOR */
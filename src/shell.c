@@ -4,11 +4,17 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <stdio.h> /* TODO: Remove when shell print with float fixed. */
 #include <stdlib.h>
 #include <ctype.h>
 #include <shell/shell.h>
+#include <zsl/instrument.h>
+#include <zsl/matrices.h>
+#include <zsl/statistics.h>
+#include <zsl/vectors.h>
+
+#if CONFIG_ZSL_COLORIMETRY
 #include <zsl/colorimetry.h>
+#endif
 
 #if CONFIG_ZSL_SHELL
 
@@ -31,13 +37,107 @@ zsl_clr_shell_cmd_version(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+#if CONFIG_ZSL_COLORIMETRY
+/* The number of color temperatures converted together in a batch. */
+#define ZSL_CLR_SHELL_CT_CHUNK 8
+
+/* The color temperature table used by batch conversions, compiled on first
+ * use. 128 points keep the interpolation error below 0.1 %. */
+ZSL_CLR_CT_LUT_DEF(zsl_clr_shell_ct_lut, 128);
+
+/* A range needs both a stop and a step color temperature. */
+static int
+zsl_clr_shell_ct_usage(const struct shell *shell)
+{
+	shell_print(shell, "Error: expected 'ct' or 'start stop step'\n");
+
+	return -EINVAL;
+}
+
+/*
+ * Converts color temperatures from argv[1] to argv[2] K, in steps of
+ * argv[3] K, to sRGB (D65), printing one line per color temperature with
+ * its out of gamut flags. The correlation matrix and the color temperature
+ * table are set up once, and the values are converted in chunks.
+ */
+static int
+zsl_clr_shell_ct_batch(const struct shell *shell, char **argv, bool flt)
+{
+	int rc;
+	size_t n, cnt;
+	zsl_real_t start, stop, step;
+	const struct zsl_mtx *srgb_ccm;
+	struct zsl_clr_xyz xyz[ZSL_CLR_SHELL_CT_CHUNK];
+	struct zsl_clr_rgb8 rgb[ZSL_CLR_SHELL_CT_CHUNK];
+	struct zsl_clr_rgbf rgbf[ZSL_CLR_SHELL_CT_CHUNK];
+
+	start = strtof(argv[1], NULL);
+	stop = strtof(argv[2], NULL);
+	step = strtof(argv[3], NULL);
+	if (start <= 0.0) {
+		return zsl_clr_shell_invalid_arg(shell, argv[1]);
+	}
+	if (stop < start) {
+		return zsl_clr_shell_invalid_arg(shell, argv[2]);
+	}
+	if (step <= 0.0) {
+		return zsl_clr_shell_invalid_arg(shell, argv[3]);
+	}
+
+	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb_ccm);
+	rc = zsl_clr_ct_lut_compile(&zsl_clr_shell_ct_lut, ZSL_CLR_OBS_2_DEG);
+	if (rc) {
+		return rc;
+	}
+
+	/* Color temperature 'i' is start + i * step, rather than a running
+	 * sum, so rounding can't drift or drop the last value. */
+	n = (size_t)((stop - start) / step + 1E-6) + 1;
+	for (size_t i = 0; i < n; i += cnt) {
+		cnt = (n - i > ZSL_CLR_SHELL_CT_CHUNK) ?
+		      ZSL_CLR_SHELL_CT_CHUNK : n - i;
+		for (size_t k = 0; k < cnt; k++) {
+			zsl_clr_conv_ct_xyz_lut(&zsl_clr_shell_ct_lut,
+						start + (i + k) * step, false,
+						&xyz[k]);
+		}
+
+		if (flt) {
+			zsl_clr_conv_xyz_rgbf_arr(xyz, srgb_ccm, rgbf, cnt);
+		} else {
+			zsl_clr_conv_xyz_rgb8_arr(xyz, srgb_ccm, rgb, cnt,
+						  NULL, 0);
+		}
+
+		for (size_t k = 0; k < cnt; k++) {
+			unsigned int ct =
+				(unsigned int)(start + (i + k) * step);
+
+			if (flt) {
+				shell_print(shell, "%u %f %f %f %c%c%c", ct,
+					    rgbf[k].r, rgbf[k].g, rgbf[k].b,
+					    rgbf[k].r_invalid ? 'R' : '.',
+					    rgbf[k].g_invalid ? 'G' : '.',
+					    rgbf[k].b_invalid ? 'B' : '.');
+			} else {
+				shell_print(shell, "%u %d %d %d %c%c%c", ct,
+					    rgb[k].r, rgb[k].g, rgb[k].b,
+					    rgb[k].r_invalid ? 'R' : '.',
+					    rgb[k].g_invalid ? 'G' : '.',
+					    rgb[k].b_invalid ? 'B' : '.');
+			}
+		}
+	}
+
+	return 0;
+}
+
 static int
 zsl_clr_shell_cmd_ct2rgb(const struct shell *shell, size_t argc, char **argv)
 {
-	ARG_UNUSED(argc);
 	zsl_real_t ct = 0.0;
 	struct zsl_clr_rgb8 rgb;
-	struct zsl_mtx *srgb_ccm;
+	const struct zsl_mtx *srgb_ccm;
 
 	/* sRGB D65 correlation matrix. */
 	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb_ccm);
@@ -49,10 +149,21 @@ zsl_clr_shell_cmd_ct2rgb(const struct shell *shell, size_t argc, char **argv)
 		shell_print(shell, "$ %s %s 5600.0", argv[-1], argv[0]);
 		shell_print(shell, "5600 K to sRGB (D65) = 255 248 224");
 		shell_print(shell, "Gamut Warning: R..\n");
-		shell_print(shell, "'R..' indicates red is out of gamut.");
+		shell_print(shell, "'R..' indicates red is out of gamut.\n");
+		shell_print(shell, "$ %s %s 2000 6500 500", argv[-1],
+			    argv[0]);
+		shell_print(shell, "Converts 2000..6500 K in 500 K steps, one");
+		shell_print(shell, "'ct r g b gamut' line each.");
 		return 0;
 	}
 
+	if (argc == 3) {
+		return zsl_clr_shell_ct_usage(shell);
+	}
+	if (argc == 4) {
+		return zsl_clr_shell_ct_batch(shell, argv, false);
+	}
+
 	/* Invalid color temperature. */
 	ct = strtof(argv[1], NULL);
 	if (ct <= 0.0) {
@@ -78,10 +189,9 @@ zsl_clr_shell_cmd_ct2rgb(const struct shell *shell, size_t argc, char **argv)
 static int
 zsl_clr_shell_cmd_ct2rgbf(const struct shell *shell, size_t argc, char **argv)
 {
-	ARG_UNUSED(argc);
 	zsl_real_t ct = 0.0;
 	struct zsl_clr_rgbf rgb;
-	struct zsl_mtx *srgb_ccm;
+	const struct zsl_mtx *srgb_ccm;
 
 	/* sRGB D65 correlation matrix. */
 	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb_ccm);
@@ -93,10 +203,21 @@ zsl_clr_shell_cmd_ct2rgbf(const struct shell *shell, size_t argc, char **argv)
 		shell_print(shell, "$ %s %s 5600.0", argv[-1], argv[0]);
 		shell_print(shell, "5600 K to sRGB (D65) = TODOO");
 		shell_print(shell, "Gamut Warning: R..\n");
-		shell_print(shell, "'R..' indicates red is out of gamut.");
+		shell_print(shell, "'R..' indicates red is out of gamut.\n");
+		shell_print(shell, "$ %s %s 2000 6500 500", argv[-1],
+			    argv[0]);
+		shell_print(shell, "Converts 2000..6500 K in 500 K steps, one");
+		shell_print(shell, "'ct r g b gamut' line each.");
 		return 0;
 	}
 
+	if (argc == 3) {
+		return zsl_clr_shell_ct_usage(shell);
+	}
+	if (argc == 4) {
+		return zsl_clr_shell_ct_batch(shell, argv, true);
+	}
+
 	/* Invalid color temperature. */
 	ct = strtof(argv[1], NULL);
 	if (ct <= 0.0) {
@@ -105,9 +226,8 @@ zsl_clr_shell_cmd_ct2rgbf(const struct shell *shell, size_t argc, char **argv)
 
 	/* Convert ct to sRGB and display floating point component values. */
 	zsl_clr_conv_ct_rgbf(ct, ZSL_CLR_OBS_2_DEG, srgb_ccm, &rgb);
-	/* TODO: Use sprintf for floats? */
-	printf("%d K to sRGB (D65) = %f %f %f\n",
-	       (unsigned int)ct, rgb.r, rgb.g, rgb.b);
+	shell_print(shell, "%u K to sRGB (D65) = %f %f %f",
+		    (unsigned int)ct, rgb.r, rgb.g, rgb.b);
 
 	/* Display an out of gamut warning. */
 	if ((rgb.r_invalid) || (rgb.g_invalid) || (rgb.b_invalid)) {
@@ -126,11 +246,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	/* 'version' command handler. */
 	SHELL_CMD(version, NULL, "library version", zsl_clr_shell_cmd_version),
 	/* 'rgb' command handler. */
-	SHELL_CMD_ARG(ct2rgb, NULL, "ct to sRGB (D65)",
-		      zsl_clr_shell_cmd_ct2rgb, 2, 0),
+	SHELL_CMD_ARG(ct2rgb, NULL, "ct [stop step] to sRGB (D65)",
+		      zsl_clr_shell_cmd_ct2rgb, 2, 2),
 	/* 'rgbf' command handler. */
-	SHELL_CMD_ARG(ct2rgbf, NULL, "ct to sRGB float (D65)",
-		      zsl_clr_shell_cmd_ct2rgbf, 2, 0),
+	SHELL_CMD_ARG(ct2rgbf, NULL, "ct [stop step] to sRGB float (D65)",
+		      zsl_clr_shell_cmd_ct2rgbf, 2, 2),
 
 	/* Array terminator. */
 	SHELL_SUBCMD_SET_END
@@ -138,5 +258,336 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 
 /* Root command "color" (level 0). */
 SHELL_CMD_REGISTER(color, &sub_color, "Colorimetry commands", NULL);
+#endif /* CONFIG_ZSL_COLORIMETRY */
+
+#if CONFIG_ZSL_INSTRUMENT
+static int
+zsl_shell_cmd_instr(const struct shell *shell, size_t argc, char **argv)
+{
+	const struct zsl_instr_rec *r;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") == 0) {
+			zsl_instr_reset();
+			return 0;
+		}
+		r = zsl_instr_find(argv[1]);
+		if (r == NULL) {
+			shell_print(shell, "No calls to \"%s\" recorded",
+				    argv[1]);
+			return -ENOENT;
+		}
+	} else {
+		r = zsl_instr_first();
+	}
+
+	shell_print(shell, "%-28s %8s %10s %12s", "Function", "Calls",
+		    "Stack (B)", "Scratch (B)");
+	for (; r; r = argc > 1 ? NULL : r->next) {
+		shell_print(shell, "%-28s %8u %10u %12u", r->name,
+			    (unsigned int)r->calls, (unsigned int)r->stack,
+			    (unsigned int)r->scratch);
+	}
+
+	return 0;
+}
+#endif
+
+#if CONFIG_ZSL_TRACE_HIST
+static int
+zsl_shell_cmd_trace(const struct shell *shell, size_t argc, char **argv)
+{
+	struct zsl_trace_stats st;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			return zsl_clr_shell_invalid_arg(shell, argv[1]);
+		}
+		zsl_trace_reset();
+		return 0;
+	}
+
+	shell_print(shell, "%-22s %8s %10s %10s %10s", "Function", "Calls",
+		    "Min", "Mean", "Max");
+	for (int id = 0; id < ZSL_TRACE_COUNT; id++) {
+		zsl_trace_stats(id, &st);
+		if (st.calls == 0) {
+			continue;
+		}
+		shell_print(shell, "%-22s %8u %10u %10u %10u",
+			    zsl_trace_name(id), (unsigned int)st.calls,
+			    (unsigned int)st.min,
+			    (unsigned int)(st.total / st.calls),
+			    (unsigned int)st.max);
+	}
+
+	return 0;
+}
+#endif
+
+#if CONFIG_ZSL_SHELL_BENCH
+#define ZSL_BENCH_MAX_N CONFIG_ZSL_SHELL_BENCH_MAX_N
+
+/* Inputs and outputs, kept off the bench thread's stack so the stack use
+ * reported is that of the kernel. */
+static zsl_real_t zsl_bench_buf[4][ZSL_BENCH_MAX_N * ZSL_BENCH_MAX_N];
+static struct zsl_mtx zsl_bench_m[4];
+static struct zsl_vec zsl_bench_v[2];
+static volatile zsl_real_t zsl_bench_sink;
+static uint32_t zsl_bench_cycles;
+
+static K_THREAD_STACK_DEFINE(zsl_bench_stack,
+			     CONFIG_ZSL_SHELL_BENCH_STACK_SIZE);
+static struct k_thread zsl_bench_thread;
+
+static void
+zsl_bench_vec_add(void)
+{
+	zsl_vec_add(&zsl_bench_v[0], &zsl_bench_v[1], &zsl_bench_v[1]);
+}
+
+static void
+zsl_bench_mtx_mult(void)
+{
+	zsl_mtx_mult(&zsl_bench_m[0], &zsl_bench_m[1], &zsl_bench_m[2]);
+}
+
+static void
+zsl_bench_mtx_inv(void)
+{
+	zsl_mtx_inv(&zsl_bench_m[0], &zsl_bench_m[2]);
+}
+
+static void
+zsl_bench_mtx_deter(void)
+{
+	zsl_real_t d;
+
+	zsl_mtx_deter(&zsl_bench_m[0], &d);
+	zsl_bench_sink = d;
+}
+
+static void
+zsl_bench_mtx_qrd(void)
+{
+	zsl_mtx_qrd(&zsl_bench_m[0], &zsl_bench_m[2], &zsl_bench_m[3], false);
+}
+
+static void
+zsl_bench_mtx_eigenvalues(void)
+{
+	zsl_mtx_eigenvalues(&zsl_bench_m[0], &zsl_bench_v[1], 150);
+}
+
+static void
+zsl_bench_mtx_svd(void)
+{
+	zsl_mtx_svd(&zsl_bench_m[0], &zsl_bench_m[1], &zsl_bench_m[2],
+		    &zsl_bench_m[3], 150);
+}
+
+static void
+zsl_bench_mtx_pinv(void)
+{
+	zsl_mtx_pinv(&zsl_bench_m[0], &zsl_bench_m[2], 150);
+}
+
+static void
+zsl_bench_sta_mean(void)
+{
+	zsl_real_t m;
+
+	zsl_sta_mean(&zsl_bench_v[0], &m);
+	zsl_bench_sink = m;
+}
+
+static void
+zsl_bench_sta_var(void)
+{
+	zsl_real_t var;
+
+	zsl_sta_var(&zsl_bench_v[0], &var);
+	zsl_bench_sink = var;
+}
+
+static void
+zsl_bench_sta_median(void)
+{
+	zsl_real_t m;
+
+	zsl_sta_median(&zsl_bench_v[0], &m);
+	zsl_bench_sink = m;
+}
+
+/* The kernels that can be run. Matrices are n x n, vectors n long. */
+static const struct {
+	const char *name;
+	void (*run)(void);
+} zsl_bench_kernels[] = {
+	{ "vec_add", zsl_bench_vec_add },
+	{ "mtx_mult", zsl_bench_mtx_mult },
+	{ "mtx_inv", zsl_bench_mtx_inv },
+	{ "mtx_deter", zsl_bench_mtx_deter },
+	{ "mtx_qrd", zsl_bench_mtx_qrd },
+	{ "mtx_eigenvalues", zsl_bench_mtx_eigenvalues },
+	{ "mtx_svd", zsl_bench_mtx_svd },
+	{ "mtx_pinv", zsl_bench_mtx_pinv },
+	{ "sta_mean", zsl_bench_sta_mean },
+	{ "sta_var", zsl_bench_sta_var },
+	{ "sta_median", zsl_bench_sta_median },
+};
+
+#define ZSL_BENCH_KERNELS (sizeof(zsl_bench_kernels) /			\
+			   sizeof(zsl_bench_kernels[0]))
+
+/* Sets up well-conditioned, symmetric n x n inputs. */
+static void
+zsl_bench_setup(size_t n)
+{
+	for (size_t k = 0; k < 4; k++) {
+		zsl_bench_m[k].sz_rows = n;
+		zsl_bench_m[k].sz_cols = n;
+		zsl_bench_m[k].data = zsl_bench_buf[k];
+	}
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			zsl_bench_buf[0][i * n + j] = i == j ?
+				(zsl_real_t)n + 1.0 :
+				1.0 / (zsl_real_t)(1 + i + j);
+		}
+	}
+	memcpy(zsl_bench_buf[1], zsl_bench_buf[0],
+	       n * n * sizeof(zsl_real_t));
+
+	/* Not sorted, so the median does real work. */
+	zsl_bench_v[0].sz = n;
+	zsl_bench_v[0].data = zsl_bench_buf[3];
+	zsl_bench_v[1].sz = n;
+	zsl_bench_v[1].data = zsl_bench_buf[2];
+	for (size_t i = 0; i < n; i++) {
+		zsl_bench_buf[3][i] = (zsl_real_t)((i * 37) % n) + 0.5;
+	}
+}
+
+static void
+zsl_bench_entry(void *p1, void *p2, void *p3)
+{
+	size_t k = (size_t)(uintptr_t)p1;
+	uint32_t loops = (uint32_t)(uintptr_t)p2;
+	uint32_t t0;
+
+	ARG_UNUSED(p3);
+
+	t0 = k_cycle_get_32();
+	for (uint32_t i = 0; i < loops; i++) {
+		zsl_bench_kernels[k].run();
+	}
+	zsl_bench_cycles = k_cycle_get_32() - t0;
+}
+
+static int
+zsl_shell_cmd_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	size_t k;
+	long n;
+	long loops = 100;
+
+	for (k = 0; k < ZSL_BENCH_KERNELS; k++) {
+		if (strcmp(argv[1], zsl_bench_kernels[k].name) == 0) {
+			break;
+		}
+	}
+	if (k == ZSL_BENCH_KERNELS || argc < 3) {
+		shell_print(shell, "Kernels:");
+		for (k = 0; k < ZSL_BENCH_KERNELS; k++) {
+			shell_print(shell, "  %s", zsl_bench_kernels[k].name);
+		}
+		if (strcmp(argv[1], "list") == 0) {
+			return 0;
+		}
+		return zsl_clr_shell_invalid_arg(shell, argv[1]);
+	}
+
+	n = strtol(argv[2], NULL, 10);
+	if (n < 2 || n > ZSL_BENCH_MAX_N) {
+		return zsl_clr_shell_invalid_arg(shell, argv[2]);
+	}
+	if (argc > 3) {
+		loops = strtol(argv[3], NULL, 10);
+		if (loops < 1) {
+			return zsl_clr_shell_invalid_arg(shell, argv[3]);
+		}
+	}
+
+	zsl_bench_setup((size_t)n);
+#if CONFIG_ZSL_INSTRUMENT
+	zsl_instr_reset();
+#endif
+#if CONFIG_ZSL_TRACE_HIST
+	zsl_trace_reset();
+#endif
+
+	/* Run in a fresh thread, so its peak stack use can be read back. */
+	k_thread_create(&zsl_bench_thread, zsl_bench_stack,
+			K_THREAD_STACK_SIZEOF(zsl_bench_stack), zsl_bench_entry,
+			(void *)(uintptr_t)k, (void *)(uintptr_t)loops, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	k_thread_join(&zsl_bench_thread, K_FOREVER);
+
+	shell_print(shell, "%s %ldx%ld: %ld calls, %u cycles/op, %u ns/op",
+		    argv[1], n, n, loops,
+		    (unsigned int)(zsl_bench_cycles / loops),
+		    (unsigned int)(k_cyc_to_ns_floor64(zsl_bench_cycles) /
+				   loops));
+
+#if CONFIG_INIT_STACKS && CONFIG_THREAD_STACK_INFO
+	size_t unused = 0;
+
+	k_thread_stack_space_get(&zsl_bench_thread, &unused);
+	shell_print(shell, "Stack: %u of %u bytes",
+		    (unsigned int)(K_THREAD_STACK_SIZEOF(zsl_bench_stack) -
+				   unused),
+		    (unsigned int)K_THREAD_STACK_SIZEOF(zsl_bench_stack));
+#endif
+
+#if CONFIG_ZSL_INSTRUMENT
+	zsl_shell_cmd_instr(shell, 1, argv);
+#endif
+#if CONFIG_ZSL_TRACE_HIST
+	zsl_shell_cmd_trace(shell, 1, argv);
+#endif
+
+	return 0;
+}
+#endif
+
+/* Subcommand array for "zsl" (level 1). */
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_zsl,
+	/* 'version' command handler. */
+	SHELL_CMD(version, NULL, "library version", zsl_clr_shell_cmd_version),
+#if CONFIG_ZSL_INSTRUMENT
+	/* 'instr' command handler. */
+	SHELL_CMD_ARG(instr, NULL,
+		      "peak stack and scratch use [function|reset]",
+		      zsl_shell_cmd_instr, 1, 1),
+#endif
+#if CONFIG_ZSL_TRACE_HIST
+	/* 'trace' command handler. */
+	SHELL_CMD_ARG(trace, NULL, "cycle counts of traced functions [reset]",
+		      zsl_shell_cmd_trace, 1, 1),
+#endif
+#if CONFIG_ZSL_SHELL_BENCH
+	/* 'bench' command handler. */
+	SHELL_CMD_ARG(bench, NULL, "time a kernel <kernel|list> <n> [loops]",
+		      zsl_shell_cmd_bench, 2, 2),
+#endif
+
+	/* Array terminator. */
+	SHELL_SUBCMD_SET_END
+	);
+
+/* Root command "zsl" (level 0). */
+SHELL_CMD_REGISTER(zsl, &sub_zsl, "zscilib commands", NULL);
 
 #endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/smp.h>
+
+#if CONFIG_ZSL_SMP && defined(__ZEPHYR__)
+#include <kernel.h>
+#include <init.h>
+
+#ifndef CONFIG_ZSL_SMP_THREADS
+#define CONFIG_ZSL_SMP_THREADS 1
+#endif
+
+#ifndef CONFIG_ZSL_SMP_STACK_SIZE
+#define CONFIG_ZSL_SMP_STACK_SIZE 1024
+#endif
+
+#ifndef CONFIG_ZSL_SMP_PRIORITY
+#define CONFIG_ZSL_SMP_PRIORITY 10
+#endif
+
+#ifndef CONFIG_ZSL_SMP_THRESHOLD
+#define CONFIG_ZSL_SMP_THRESHOLD 32768
+#endif
+
+/* One range of a zsl_smp_for job, queued on a pool thread. */
+struct zsl_smp_task {
+	struct k_work work;
+	zsl_smp_fn_t fn;
+	void *arg;
+	size_t start;
+	size_t end;
+	struct k_sem *done;
+};
+
+static struct k_work_q zsl_smp_q[CONFIG_ZSL_SMP_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(zsl_smp_stack, CONFIG_ZSL_SMP_THREADS,
+				   CONFIG_ZSL_SMP_STACK_SIZE);
+
+static void
+zsl_smp_handler(struct k_work *work)
+{
+	struct zsl_smp_task *t = CONTAINER_OF(work, struct zsl_smp_task, work);
+
+	t->fn(t->arg, t->start, t->end);
+	k_sem_give(t->done);
+}
+
+/* Pool threads run their share inline, rather than waiting on a queue
+ * that may be their own. */
+static bool
+zsl_smp_in_pool(void)
+{
+	k_tid_t cur = k_current_get();
+
+	for (size_t i = 0; i < CONFIG_ZSL_SMP_THREADS; i++) {
+		if (cur == &zsl_smp_q[i].thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int
+zsl_smp_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (size_t i = 0; i < CONFIG_ZSL_SMP_THREADS; i++) {
+		k_work_queue_start(&zsl_smp_q[i], zsl_smp_stack[i],
+				   K_THREAD_STACK_SIZEOF(zsl_smp_stack[i]),
+				   CONFIG_ZSL_SMP_PRIORITY, NULL);
+		k_thread_name_set(&zsl_smp_q[i].thread, "zsl_smp");
+	}
+
+	return 0;
+}
+
+SYS_INIT(zsl_smp_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+int
+zsl_smp_for(zsl_smp_fn_t fn, void *arg, size_t n, size_t cost)
+{
+	struct zsl_smp_task task[CONFIG_ZSL_SMP_THREADS];
+	struct k_sem done;
+	size_t parts = CONFIG_ZSL_SMP_THREADS + 1;
+
+	if ((cost < CONFIG_ZSL_SMP_THRESHOLD) || (n < 2) || k_is_in_isr() ||
+	    zsl_smp_in_pool()) {
+		fn(arg, 0, n);
+		return 0;
+	}
+
+	if (parts > n) {
+		parts = n;
+	}
+
+	k_sem_init(&done, 0, parts - 1);
+
+	/* Range 0 is kept for the calling thread. */
+	for (size_t i = 1; i < parts; i++) {
+		struct zsl_smp_task *t = &task[i - 1];
+
+		t->fn = fn;
+		t->arg = arg;
+		t->start = n * i / parts;
+		t->end = n * (i + 1) / parts;
+		t->done = &done;
+		k_work_init(&t->work, zsl_smp_handler);
+		if (k_work_submit_to_queue(&zsl_smp_q[i - 1], &t->work) < 0) {
+			zsl_smp_handler(&t->work);
+		}
+	}
+
+	fn(arg, 0, n / parts);
+
+	for (size_t i = 1; i < parts; i++) {
+		k_sem_take(&done, K_FOREVER);
+	}
+
+	return 0;
+}
+
+#else
+
+int
+zsl_smp_for(zsl_smp_fn_t fn, void *arg, size_t n, size_t cost)
+{
+	(void)cost;
+
+	fn(arg, 0, n);
+
+	return 0;
+}
+
+#endif /* CONFIG_ZSL_SMP */
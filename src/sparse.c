@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <zsl/zsl.h>
+#include <zsl/sparse.h>
+#include <zsl/workspace.h>
+
+int
+zsl_spmtx_init(struct zsl_spmtx *sp)
+{
+	memset(sp->row_ptr, 0, (sp->sz_rows + 1) * sizeof(size_t));
+
+	return 0;
+}
+
+int
+zsl_spmtx_from_mtx(const struct zsl_mtx *m, zsl_real_t tol,
+		   struct zsl_spmtx *sp)
+{
+	size_t nz = 0;
+	zsl_real_t x;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'sp' and 'm' are the same shape. */
+	if ((sp->sz_rows != m->sz_rows) || (sp->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	sp->row_ptr[0] = 0;
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			x = m->data[i * m->sz_cols + j];
+			if (ZSL_ABS(x) <= tol) {
+				continue;
+			}
+			if (nz == sp->sz_nnz) {
+				zsl_spmtx_init(sp);
+				return -ENOMEM;
+			}
+			sp->col_idx[nz] = j;
+			sp->data[nz] = x;
+			nz++;
+		}
+		sp->row_ptr[i + 1] = nz;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_to_mtx(const struct zsl_spmtx *sp, struct zsl_mtx *m)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'sp' and 'm' are the same shape. */
+	if ((sp->sz_rows != m->sz_rows) || (sp->sz_cols != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	memset(m->data, 0, m->sz_rows * m->sz_cols * sizeof(zsl_real_t));
+
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			m->data[i * m->sz_cols + sp->col_idx[k]] = sp->data[k];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_get(const struct zsl_spmtx *sp, size_t i, size_t j, zsl_real_t *x)
+{
+	size_t lo;
+	size_t hi;
+	size_t mid;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((i >= sp->sz_rows) || (j >= sp->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Binary search the row, since column indices are kept sorted. */
+	lo = sp->row_ptr[i];
+	hi = sp->row_ptr[i + 1];
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (sp->col_idx[mid] < j) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if ((lo < sp->row_ptr[i + 1]) && (sp->col_idx[lo] == j)) {
+		*x = sp->data[lo];
+	} else {
+		*x = 0.0;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_vec(const struct zsl_spmtx *sp, const struct zsl_vec *v,
+		   struct zsl_vec *w)
+{
+	zsl_real_t sum;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != sp->sz_cols) || (w->sz != sp->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		sum = 0.0;
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			sum += sp->data[k] * v->data[sp->col_idx[k]];
+		}
+		w->data[i] = sum;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_trans_vec(const struct zsl_spmtx *sp, const struct zsl_vec *v,
+			 struct zsl_vec *w)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((v->sz != sp->sz_rows) || (w->sz != sp->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Scatter each row of 'sp', scaled by v[i], into the output. */
+	memset(w->data, 0, w->sz * sizeof(zsl_real_t));
+	for (size_t i = 0; i < sp->sz_rows; i++) {
+		for (size_t k = sp->row_ptr[i]; k < sp->row_ptr[i + 1]; k++) {
+			w->data[sp->col_idx[k]] += sp->data[k] * v->data[i];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult_mtx(const struct zsl_spmtx *sa, const struct zsl_mtx *mb,
+		   struct zsl_mtx *mc)
+{
+	size_t p = mb->sz_cols;
+	zsl_real_t a;
+	const zsl_real_t *b;
+	zsl_real_t *c;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that the matrices are compatibly shaped. */
+	if ((mb->sz_rows != sa->sz_cols) || (mc->sz_rows != sa->sz_rows) ||
+	    (mc->sz_cols != p)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Each output row is a sum of rows of 'mb', scaled by row i of 'sa'. */
+	memset(mc->data, 0, mc->sz_rows * p * sizeof(zsl_real_t));
+	for (size_t i = 0; i < sa->sz_rows; i++) {
+		c = &mc->data[i * p];
+		for (size_t k = sa->row_ptr[i]; k < sa->row_ptr[i + 1]; k++) {
+			a = sa->data[k];
+			b = &mb->data[sa->col_idx[k] * p];
+			for (size_t j = 0; j < p; j++) {
+				c[j] += a * b[j];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_mult(const struct zsl_spmtx *sa, const struct zsl_spmtx *sb,
+	       struct zsl_spmtx *sc)
+{
+	size_t p = sb->sz_cols;
+	size_t nz = 0;
+	size_t r;
+	zsl_real_t a;
+	zsl_real_t acc[p];
+	bool used[p];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that the matrices are compatibly shaped. */
+	if ((sb->sz_rows != sa->sz_cols) || (sc->sz_rows != sa->sz_rows) ||
+	    (sc->sz_cols != p)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t j = 0; j < p; j++) {
+		acc[j] = 0.0;
+		used[j] = false;
+	}
+
+	/*
+	 * Gustavson's algorithm: row i of the product is accumulated in a
+	 * dense row, from the rows of 'sb' selected by row i of 'sa'. Scanning
+	 * the dense row in order keeps the output columns sorted.
+	 */
+	sc->row_ptr[0] = 0;
+	for (size_t i = 0; i < sa->sz_rows; i++) {
+		for (size_t k = sa->row_ptr[i]; k < sa->row_ptr[i + 1]; k++) {
+			a = sa->data[k];
+			r = sa->col_idx[k];
+			for (size_t l = sb->row_ptr[r]; l < sb->row_ptr[r + 1];
+			     l++) {
+				acc[sb->col_idx[l]] += a * sb->data[l];
+				used[sb->col_idx[l]] = true;
+			}
+		}
+
+		for (size_t j = 0; j < p; j++) {
+			if (!used[j]) {
+				continue;
+			}
+			if (nz == sc->sz_nnz) {
+				zsl_spmtx_init(sc);
+				return -ENOMEM;
+			}
+			sc->col_idx[nz] = j;
+			sc->data[nz] = acc[j];
+			nz++;
+			acc[j] = 0.0;
+			used[j] = false;
+		}
+		sc->row_ptr[i + 1] = nz;
+	}
+
+	return 0;
+}
+
+int
+zsl_spmtx_trans(const struct zsl_spmtx *sa, struct zsl_spmtx *sb)
+{
+	size_t nz = zsl_spmtx_nnz(sa);
+	size_t j;
+	size_t dst;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'sb' has the transposed shape of 'sa'. */
+	if ((sb->sz_rows != sa->sz_cols) || (sb->sz_cols != sa->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	if (nz > sb->sz_nnz) {
+		return -ENOMEM;
+	}
+
+	/* Count the entries in each column of 'sa', offset by one. */
+	memset(sb->row_ptr, 0, (sb->sz_rows + 1) * sizeof(size_t));
+	for (size_t k = 0; k < nz; k++) {
+		sb->row_ptr[sa->col_idx[k] + 1]++;
+	}
+
+	/* Convert the counts to the starting offset of each output row. */
+	for (j = 0; j < sb->sz_rows; j++) {
+		sb->row_ptr[j + 1] += sb->row_ptr[j];
+	}
+
+	/*
+	 * Scatter the entries, using row_ptr[j] as the insertion point for
+	 * output row j. Visiting 'sa' in row order keeps each output row
+	 * sorted, and leaves row_ptr[j] at the start of row j + 1.
+	 */
+	for (size_t i = 0; i < sa->sz_rows; i++) {
+		for (size_t k = sa->row_ptr[i]; k < sa->row_ptr[i + 1]; k++) {
+			j = sa->col_idx[k];
+			dst = sb->row_ptr[j]++;
+			sb->col_idx[dst] = i;
+			sb->data[dst] = sa->data[k];
+		}
+	}
+
+	/* Shift the offsets back into place. */
+	for (j = sb->sz_rows; j > 0; j--) {
+		sb->row_ptr[j] = sb->row_ptr[j - 1];
+	}
+	sb->row_ptr[0] = 0;
+
+	return 0;
+}
+
+size_t
+zsl_spmtx_cg_ws_sz(size_t n)
+{
+	/* The residual, preconditioned residual, direction, product and
+	 * inverse diagonal. */
+	return 5 * n;
+}
+
+int
+zsl_spmtx_cg_ws(const struct zsl_spmtx *sp, const struct zsl_vec *b,
+		struct zsl_vec *x, zsl_real_t tol, size_t max_iter,
+		struct zsl_workspace *ws)
+{
+	int rc = 0;
+	size_t n = sp->sz_rows;
+	size_t mark;
+	zsl_real_t d;
+	zsl_real_t bn;
+	zsl_real_t rz;
+	zsl_real_t rz_new;
+	zsl_real_t pq;
+	zsl_real_t alpha;
+
+	struct zsl_vec r;
+	struct zsl_vec z;
+	struct zsl_vec p;
+	struct zsl_vec q;
+	struct zsl_vec dinv;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'sp' is square, and 'b' and 'x' are compatible. */
+	if ((sp->sz_cols != n) || (b->sz != n) || (x->sz != n)) {
+		return -EINVAL;
+	}
+#endif
+
+	mark = zsl_ws_mark(ws);
+	rc |= zsl_ws_vec_alloc(ws, &r, n);
+	rc |= zsl_ws_vec_alloc(ws, &z, n);
+	rc |= zsl_ws_vec_alloc(ws, &p, n);
+	rc |= zsl_ws_vec_alloc(ws, &q, n);
+	rc |= zsl_ws_vec_alloc(ws, &dinv, n);
+	if (rc) {
+		rc = -ENOMEM;
+		goto err;
+	}
+
+	/* The Jacobi preconditioner needs a positive diagonal. */
+	for (size_t i = 0; i < n; i++) {
+		zsl_spmtx_get(sp, i, i, &d);
+		if (d <= 0.0) {
+			rc = -ENOTPOSDEF;
+			goto err;
+		}
+		dinv.data[i] = 1.0 / d;
+	}
+
+	bn = zsl_vec_norm(b);
+	if (bn == 0.0) {
+		zsl_vec_init(x);
+		goto err;
+	}
+
+	/* r = b - A * x, z = M^-1 * r, p = z. */
+	zsl_spmtx_mult_vec(sp, x, &q);
+	for (size_t i = 0; i < n; i++) {
+		r.data[i] = b->data[i] - q.data[i];
+		z.data[i] = dinv.data[i] * r.data[i];
+		p.data[i] = z.data[i];
+	}
+	zsl_vec_dot(&r, &z, &rz);
+
+	for (size_t k = 0; k < max_iter; k++) {
+		if (zsl_vec_norm(&r) <= tol * bn) {
+			goto err;
+		}
+
+		zsl_spmtx_mult_vec(sp, &p, &q);
+		zsl_vec_dot(&p, &q, &pq);
+		if (pq <= 0.0) {
+			rc = -ENOTPOSDEF;
+			goto err;
+		}
+
+		alpha = rz / pq;
+		for (size_t i = 0; i < n; i++) {
+			x->data[i] += alpha * p.data[i];
+			r.data[i] -= alpha * q.data[i];
+			z.data[i] = dinv.data[i] * r.data[i];
+		}
+
+		zsl_vec_dot(&r, &z, &rz_new);
+		for (size_t i = 0; i < n; i++) {
+			p.data[i] = z.data[i] + (rz_new / rz) * p.data[i];
+		}
+		rz = rz_new;
+	}
+
+	if (zsl_vec_norm(&r) > tol * bn) {
+		rc = -ENOCONVERGE;
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int
+zsl_spmtx_cg(const struct zsl_spmtx *sp, const struct zsl_vec *b,
+	     struct zsl_vec *x, zsl_real_t tol, size_t max_iter)
+{
+	int rc;
+
+	ZSL_SCRATCH_DEF(ws, zsl_spmtx_cg_ws_sz(sp->sz_rows));
+	rc = zsl_spmtx_cg_ws(sp, b, x, tol, max_iter, ws);
+	ZSL_SCRATCH_PUT(ws);
+
+	return rc;
+}
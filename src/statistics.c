@@ -10,15 +10,23 @@
 #include <string.h>
 #include <zsl/zsl.h>
 #include <zsl/statistics.h>
+#include <zsl/workspace.h>
 
-int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m)
+/* Relative tolerance below which a pivot is treated as zero. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_STA_EPS 1E-6
+#else
+#define ZSL_STA_EPS 1E-15
+#endif
+
+int zsl_sta_mean(const struct zsl_vec *v, zsl_real_t *m)
 {
 	zsl_vec_ar_mean(v, m);
 
 	return 0;
 }
 
-int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w)
+int zsl_sta_demean(const struct zsl_vec *v, struct zsl_vec *w)
 {
 	zsl_real_t m;
 
@@ -29,114 +37,534 @@ int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w)
 	return 0;
 }
 
-int zsl_sta_percentile(struct zsl_vec *v, size_t p, zsl_real_t *val)
+/* Ranges at or below this size are finished with an insertion sort. */
+#define ZSL_STA_SELECT_SMALL 16
+
+static void zsl_sta_swap(zsl_real_t *a, size_t i, size_t j)
 {
-	ZSL_VECTOR_DEF(w, v->sz);
+	zsl_real_t t = a[i];
 
-	zsl_vec_init(&w);
-	zsl_vec_sort(v, &w);
+	a[i] = a[j];
+	a[j] = t;
+}
 
-	zsl_real_t x = (p * v->sz) / 100.;
-	zsl_real_t per = ZSL_FLOOR(x);
+/*
+ * Introselect: partially reorders a[lo..hi) so that a[k] holds the value it
+ * would have if the range were sorted, with no larger value before it and
+ * no smaller value after it.
+ *
+ * Quickselect with a median-of-three pivot only descends into the side
+ * holding 'k', which is O(n) on average. If the range hasn't shrunk after
+ * 2 * log2(n) partitions, the pivots are being chosen badly and the rest is
+ * sorted with zsl_vec_sort_d instead, bounding the worst case at
+ * O(n log(n)).
+ */
+static void zsl_sta_select(zsl_real_t *a, size_t lo, size_t hi, size_t k)
+{
+	size_t depth = 0;
+	size_t i, j, m;
+	zsl_real_t pivot, x;
 
-	if (x == per) {
-		*val = (w.data[(int)per] + w.data[(int)per - 1]) / 2.;
-	} else {
-		*val = w.data[(int)per];
+	for (size_t n = hi - lo; n > 1; n >>= 1) {
+		depth += 2;
 	}
 
-	return 0;
+	while (hi - lo > ZSL_STA_SELECT_SMALL) {
+		if (depth-- == 0) {
+			struct zsl_vec rest = { .sz = hi - lo, .data = &a[lo] };
+
+			zsl_vec_sort_d(&rest);
+			return;
+		}
+
+		/* Order a[lo], a[m] and a[hi - 1], and use a[m] as the pivot.
+		 * The outer two then stop both scans below. */
+		m = lo + (hi - lo) / 2;
+		if (a[m] < a[lo]) {
+			zsl_sta_swap(a, m, lo);
+		}
+		if (a[hi - 1] < a[lo]) {
+			zsl_sta_swap(a, hi - 1, lo);
+		}
+		if (a[hi - 1] < a[m]) {
+			zsl_sta_swap(a, hi - 1, m);
+		}
+		pivot = a[m];
+
+		/* Hoare partition into a[lo..j] <= pivot <= a[j + 1..hi). */
+		i = lo;
+		j = hi - 1;
+		for (;;) {
+			while (a[i] < pivot) {
+				i++;
+			}
+			while (a[j] > pivot) {
+				j--;
+			}
+			if (i >= j) {
+				break;
+			}
+			zsl_sta_swap(a, i, j);
+			i++;
+			j--;
+		}
+
+		if (k <= j) {
+			hi = j + 1;
+		} else {
+			lo = j + 1;
+		}
+	}
+
+	for (i = lo + 1; i < hi; i++) {
+		x = a[i];
+		for (j = i; j > lo && a[j - 1] > x; j--) {
+			a[j] = a[j - 1];
+		}
+		a[j] = x;
+	}
 }
 
-int zsl_sta_median(struct zsl_vec *v, zsl_real_t *m)
+int zsl_sta_percentiles_d(struct zsl_vec *v, const size_t *p, size_t n,
+			  zsl_real_t *val)
 {
-	zsl_sta_percentile(v, 50, m);
+	size_t lo = 0;
+	size_t idx;
+	zsl_real_t x, per, prev;
+
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t q = 0; q < n; q++) {
+		/* The percentiles must be in ascending order. */
+		if (q > 0 && p[q] < p[q - 1]) {
+			return -EINVAL;
+		}
+
+		x = (p[q] * v->sz) / 100.;
+		per = ZSL_FLOOR(x);
+		idx = (size_t)per;
+
+		/* Make sure the element(s) used exist. */
+		if ((idx >= v->sz) || (x == per && idx == 0)) {
+			return -EINVAL;
+		}
+
+		/* An index that was already selected doesn't move again, and
+		 * can't be an averaged one, since 'x' only increases. */
+		if (idx < lo) {
+			val[q] = v->data[idx];
+			continue;
+		}
+
+		/* Everything before 'lo' is in its sorted position, and every
+		 * selection leaves the preceding values no larger. */
+		zsl_sta_select(v->data, lo, v->sz, idx);
+		if (x == per) {
+			prev = v->data[idx - 1];
+			for (size_t i = lo; i + 1 < idx; i++) {
+				prev = ZSL_MAX(prev, v->data[i]);
+			}
+			val[q] = (v->data[idx] + prev) / 2.;
+		} else {
+			val[q] = v->data[idx];
+		}
+		lo = idx + 1;
+	}
 
 	return 0;
 }
 
-int zsl_sta_quart(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
+int zsl_sta_percentiles(const struct zsl_vec *v, const size_t *p, size_t n,
+			zsl_real_t *val)
+{
+	int rc;
+	struct zsl_vec w;
+	ZSL_SCRATCH_DEF(ws, v->sz);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_vec_alloc(ws, &w, v->sz);
+	if (rc) {
+		goto err;
+	}
+
+	zsl_vec_copy(&w, v);
+	rc = zsl_sta_percentiles_d(&w, p, n, val);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int zsl_sta_percentile(const struct zsl_vec *v, size_t p, zsl_real_t *val)
+{
+	return zsl_sta_percentiles(v, &p, 1, val);
+}
+
+int zsl_sta_percentile_d(struct zsl_vec *v, size_t p, zsl_real_t *val)
+{
+	return zsl_sta_percentiles_d(v, &p, 1, val);
+}
+
+int zsl_sta_median(const struct zsl_vec *v, zsl_real_t *m)
+{
+	return zsl_sta_percentile(v, 50, m);
+}
+
+int zsl_sta_quart(const struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
 		  zsl_real_t *q3)
 {
-	zsl_sta_percentile(v, 25, q1);
-	zsl_sta_percentile(v, 50, q2);
-	zsl_sta_percentile(v, 75, q3);
+	int rc;
+	const size_t p[3] = { 25, 50, 75 };
+	zsl_real_t q[3];
+
+	/* One copy of 'v', partitioned once for all three quartiles. */
+	rc = zsl_sta_percentiles(v, p, 3, q);
+	if (rc) {
+		return rc;
+	}
+
+	*q1 = q[0];
+	*q2 = q[1];
+	*q3 = q[2];
+
+	return 0;
+}
+
+int zsl_sta_quart_range(const struct zsl_vec *v, zsl_real_t *r)
+{
+	int rc;
+	const size_t p[2] = { 25, 75 };
+	zsl_real_t q[2];
+
+	rc = zsl_sta_percentiles(v, p, 2, q);
+	if (rc) {
+		return rc;
+	}
+
+	*r = q[1] - q[0];
 
 	return 0;
 }
 
-int zsl_sta_quart_range(struct zsl_vec *v, zsl_real_t *r)
+int zsl_sta_mad_d(struct zsl_vec *v, zsl_real_t *med, zsl_real_t *mad)
 {
-	zsl_real_t q1, q3;
+	int rc;
+	zsl_real_t m;
+
+	/* Two O(n) selections: the median, then the median of the absolute
+	 * deviations from it, written over 'v'. */
+	rc = zsl_sta_percentile_d(v, 50, &m);
+	if (rc) {
+		return rc;
+	}
 
-	zsl_sta_percentile(v, 25, &q1);
-	zsl_sta_percentile(v, 75, &q3);
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = ZSL_ABS(v->data[i] - m);
+	}
+
+	rc = zsl_sta_percentile_d(v, 50, mad);
+	if (rc) {
+		return rc;
+	}
 
-	*r = q3 - q1;
+	if (med != NULL) {
+		*med = m;
+	}
 
 	return 0;
 }
 
-int zsl_sta_mode(struct zsl_vec *v, struct zsl_vec *w)
+int zsl_sta_mad(const struct zsl_vec *v, zsl_real_t *med, zsl_real_t *mad)
+{
+	int rc;
+	struct zsl_vec w;
+	ZSL_SCRATCH_DEF(ws, v->sz);
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_vec_alloc(ws, &w, v->sz);
+	if (rc) {
+		goto err;
+	}
+
+	zsl_vec_copy(&w, v);
+	rc = zsl_sta_mad_d(&w, med, mad);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+/*
+ * Computes the mean of a copy of 'v' with the lowest and highest p percent
+ * of its values either dropped or, if 'winsor' is true, clamped to the
+ * remaining extremes.
+ */
+static int zsl_sta_trim(const struct zsl_vec *v, size_t p, bool winsor,
+			zsl_real_t *m)
+{
+	int rc;
+	size_t n = v->sz;
+	size_t k = (p * n) / 100;
+	struct zsl_vec w, mid;
+	zsl_real_t mean;
+	ZSL_SCRATCH_DEF(ws, n);
+	size_t mark = zsl_ws_mark(ws);
+
+	/* At least one value must remain. */
+	if (p >= 50 || 2 * k >= n) {
+		rc = -EINVAL;
+		goto err;
+	}
+
+	rc = zsl_ws_vec_alloc(ws, &w, n);
+	if (rc) {
+		goto err;
+	}
+	zsl_vec_copy(&w, v);
+
+	/* Move the k smallest values below w[k], then the k largest above
+	 * w[n - k - 1], leaving the kept values in between. */
+	if (k > 0) {
+		zsl_sta_select(w.data, 0, n, k);
+		zsl_sta_select(w.data, k, n, n - k - 1);
+	}
+
+	zsl_vec_view(&w, k, n - 2 * k, &mid);
+	zsl_vec_ar_mean(&mid, &mean);
+
+	if (winsor) {
+		mean = (mean * (zsl_real_t)(n - 2 * k) +
+			(zsl_real_t)k * (w.data[k] + w.data[n - k - 1])) /
+		       (zsl_real_t)n;
+	}
+	*m = mean;
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int zsl_sta_trim_mean(const struct zsl_vec *v, size_t p, zsl_real_t *m)
+{
+	return zsl_sta_trim(v, p, false, m);
+}
+
+int zsl_sta_winsor_mean(const struct zsl_vec *v, size_t p, zsl_real_t *m)
+{
+	return zsl_sta_trim(v, p, true, m);
+}
+
+int zsl_sta_reject_outliers(const struct zsl_vec *v, zsl_real_t t,
+			    struct zsl_vec *w)
 {
-	size_t i, j = 0, count, maxcount = 0;
+	int rc;
+	size_t n = 0;
+	zsl_real_t med, mad, lim;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (w->sz < v->sz) {
+		return -EINVAL;
+	}
+#endif
 
-	ZSL_VECTOR_DEF(u, v->sz);
-	ZSL_VECTOR_DEF(w_temp, v->sz);
+	if (t < 0.0) {
+		return -EINVAL;
+	}
 
-	w->sz = v->sz;
-	zsl_vec_init(w);
+	rc = zsl_sta_mad(v, &med, &mad);
+	if (rc) {
+		return rc;
+	}
 
-	for (i = 0; i < v->sz; i++) {
-		count = zsl_vec_contains(v, v->data[i], 1E-7);
-		u.data[i] = count;
-		if (count > maxcount) {
-			maxcount = count;
+	/* Each value is read before any write to its index, so 'w' may be
+	 * 'v'. */
+	lim = t * ZSL_STA_MAD_NORMAL * mad;
+	for (size_t i = 0; i < v->sz; i++) {
+		if (ZSL_ABS(v->data[i] - med) <= lim) {
+			w->data[n++] = v->data[i];
 		}
 	}
+	w->sz = n;
+
+	return 0;
+}
+
+size_t zsl_sta_summary_ws_sz(size_t n)
+{
+	return n;
+}
+
+int zsl_sta_summary_ws(const struct zsl_vec *v, struct zsl_sta_summary *sum,
+		       struct zsl_workspace *ws)
+{
+	int rc;
+	struct zsl_vec u;
+	zsl_real_t x, d, m2 = 0.0;
+	zsl_real_t q[3];
+	const size_t p[3] = { 25, 50, 75 };
+	size_t mark = zsl_ws_mark(ws);
+
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
+
+	rc = zsl_ws_vec_alloc(ws, &u, v->sz);
+	if (rc) {
+		goto err;
+	}
 
-	for (i = 0; i < v->sz; i++) {
-		if (u.data[i] == maxcount) {
-			w_temp.data[j] = v->data[i];
-			j++;
+	sum->n = v->sz;
+	sum->mean = 0.0;
+	sum->min = v->data[0];
+	sum->max = v->data[0];
+	for (size_t i = 0; i < v->sz; i++) {
+		x = v->data[i];
+		u.data[i] = x;
+		d = x - sum->mean;
+		sum->mean += d / (zsl_real_t)(i + 1);
+		m2 += d * (x - sum->mean);
+		if (x < sum->min) {
+			sum->min = x;
+		}
+		if (x > sum->max) {
+			sum->max = x;
 		}
 	}
 
-	w_temp.sz = j;
-	count = 0;
+	sum->var = (v->sz > 1) ? m2 / (zsl_real_t)(v->sz - 1) : 0.0;
+	sum->sta_dev = ZSL_SQRT(sum->var);
+	sum->range = sum->max - sum->min;
 
-	for (i = 0; i < j; i++) {
-		if (w_temp.data[i] >= 1E-5 || w_temp.data[i] <= 1E-5) {
-			if (zsl_vec_contains(w, w_temp.data[i], 1E-5) == 0) {
-				w->data[count] = w_temp.data[i];
-				count++;
-			}
+	rc = zsl_sta_percentiles_d(&u, p, 3, q);
+	if (rc) {
+		goto err;
+	}
+	sum->q1 = q[0];
+	sum->median = q[1];
+	sum->q3 = q[2];
+	sum->iqr = q[2] - q[0];
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int zsl_sta_summary(const struct zsl_vec *v, struct zsl_sta_summary *sum)
+{
+	int rc;
+	ZSL_SCRATCH_DEF(ws, zsl_sta_summary_ws_sz(v->sz));
+
+	rc = zsl_sta_summary_ws(v, sum, ws);
+
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+size_t zsl_sta_mode_ws_sz(size_t n)
+{
+	return n;
+}
+
+int zsl_sta_mode_ws(const struct zsl_vec *v, struct zsl_vec *w,
+		    struct zsl_workspace *ws)
+{
+	int rc;
+	struct zsl_vec u;
+	size_t i, run, count = 0, maxcount = 0;
+	size_t mark = zsl_ws_mark(ws);
+
+	rc = zsl_ws_vec_alloc(ws, &u, v->sz);
+	if (rc) {
+		goto err;
+	}
+
+	/* Sorting groups equal values into runs, so one pass finds the
+	 * longest run and a second copies the first value of each run of
+	 * that length. */
+	zsl_vec_copy(&u, v);
+	zsl_vec_sort_d(&u);
+
+	for (i = 0; i < u.sz; i += run) {
+		for (run = 1; i + run < u.sz &&
+		     u.data[i + run] - u.data[i] < 1E-7; run++) {
 		}
+		if (run > maxcount) {
+			maxcount = run;
+			count = 1;
+		} else if (run == maxcount) {
+			count++;
+		}
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure w can hold every mode. */
+	if (w->sz < count) {
+		rc = -EINVAL;
+		goto err;
 	}
+#endif
 
-	if (zsl_vec_contains(&w_temp, 0.0, 1E-5) > 0) {
-		count++;
+	count = 0;
+	for (i = 0; i < u.sz; i += run) {
+		for (run = 1; i + run < u.sz &&
+		     u.data[i + run] - u.data[i] < 1E-7; run++) {
+		}
+		if (run == maxcount) {
+			w->data[count++] = u.data[i];
+		}
 	}
 
 	w->sz = count;
 
-	return 0;
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
 }
 
-int zsl_sta_data_range(struct zsl_vec *v, zsl_real_t *r)
+int zsl_sta_mode(const struct zsl_vec *v, struct zsl_vec *w)
 {
-	ZSL_VECTOR_DEF(w, v->sz);
+	int rc;
+	ZSL_SCRATCH_DEF(ws, zsl_sta_mode_ws_sz(v->sz));
+
+	rc = zsl_sta_mode_ws(v, w, ws);
+
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int zsl_sta_data_range(const struct zsl_vec *v, zsl_real_t *r)
+{
+	zsl_real_t min, max;
+
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
 
-	zsl_vec_sort(v, &w);
+	/* A single pass for the extremes, rather than sorting a copy. */
+	min = max = v->data[0];
+	for (size_t i = 1; i < v->sz; i++) {
+		if (v->data[i] < min) {
+			min = v->data[i];
+		}
+		if (v->data[i] > max) {
+			max = v->data[i];
+		}
+	}
 
-	*r = w.data[v->sz - 1] - w.data[0];
+	*r = max - min;
 
 	return 0;
 }
 
-int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var)
+int zsl_sta_var(const struct zsl_vec *v, zsl_real_t *var)
 {
 	ZSL_VECTOR_DEF(w, v->sz);
+	ZSL_INSTR_ENTER(instr);
 	*var = 0;
 
 	zsl_sta_demean(v, &w);
@@ -150,7 +578,7 @@ int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var)
 	return 0;
 }
 
-int zsl_sta_sta_dev(struct zsl_vec *v, zsl_real_t *s)
+int zsl_sta_sta_dev(const struct zsl_vec *v, zsl_real_t *s)
 {
 	zsl_real_t var;
 
@@ -161,7 +589,8 @@ int zsl_sta_sta_dev(struct zsl_vec *v, zsl_real_t *s)
 	return 0;
 }
 
-int zsl_sta_covar(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *c)
+int zsl_sta_covar(const struct zsl_vec *v, const struct zsl_vec *w,
+		  zsl_real_t *c)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure v and w are equal length. */
@@ -172,6 +601,7 @@ int zsl_sta_covar(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *c)
 
 	ZSL_VECTOR_DEF(v_dm, v->sz);
 	ZSL_VECTOR_DEF(w_dm, w->sz);
+	ZSL_INSTR_ENTER(instr);
 
 	zsl_sta_demean(v, &v_dm);
 	zsl_sta_demean(w, &w_dm);
@@ -186,33 +616,198 @@ int zsl_sta_covar(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *c)
 	return 0;
 }
 
-int zsl_sta_covar_mtx(struct zsl_mtx *m, struct zsl_mtx *mc)
+/*
+ * Adds row 'x' of n values to the column means and the upper triangle of the
+ * co-moment matrix 'c2', 'rows' being the row count including 'x'. 'd' is
+ * scratch space for n values.
+ */
+static void zsl_sta_covar_row(size_t n, size_t rows, zsl_real_t *mean,
+			      zsl_real_t *d, zsl_real_t *c2,
+			      const zsl_real_t *x)
+{
+	zsl_real_t di;
+
+	for (size_t j = 0; j < n; j++) {
+		d[j] = x[j] - mean[j];
+		mean[j] += d[j] / (zsl_real_t)rows;
+	}
+
+	/* c2 += d * (x - mean)^T, where the second factor equals
+	 * d * (rows - 1) / rows, keeping the update symmetric. */
+	for (size_t i = 0; i < n; i++) {
+		di = d[i] * (zsl_real_t)(rows - 1) / (zsl_real_t)rows;
+		for (size_t j = i; j < n; j++) {
+			c2[i * n + j] += di * d[j];
+		}
+	}
+}
+
+/*
+ * Writes the covariance, or with 'corr' the correlation, of the upper
+ * triangle co-moments 'c2' of 'rows' rows into both triangles of 'mc', which
+ * may share storage with 'c2'.
+ */
+static void zsl_sta_covar_finish(size_t n, size_t rows, const zsl_real_t *c2,
+				 struct zsl_mtx *mc, bool corr)
+{
+	zsl_real_t x, si, sj;
+
+	/* Write the strict lower triangle first, leaving the diagonal and
+	 * upper triangle of 'c2' intact until they have been read. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			x = c2[i * n + j] / (zsl_real_t)(rows - 1);
+			if (corr) {
+				si = c2[i * n + i];
+				sj = c2[j * n + j];
+				x = (si > 0.0 && sj > 0.0) ?
+				    c2[i * n + j] / ZSL_SQRT(si * sj) : 0.0;
+			}
+			mc->data[j * n + i] = x;
+		}
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		mc->data[i * n + i] = corr ? 1.0 :
+				      c2[i * n + i] / (zsl_real_t)(rows - 1);
+		for (size_t j = i + 1; j < n; j++) {
+			mc->data[i * n + j] = mc->data[j * n + i];
+		}
+	}
+}
+
+static int zsl_sta_covar_mtx_run(const struct zsl_mtx *m, struct zsl_mtx *mc,
+				 bool corr)
 {
+	int rc;
+	size_t n = m->sz_cols;
+	struct zsl_vec mean, d;
+	ZSL_SCRATCH_DEF(ws, 2 * m->sz_cols);
+	size_t mark = zsl_ws_mark(ws);
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure 'mc' is a square matrix with same num. columns as 'm'. */
 	if (mc->sz_rows != mc->sz_cols || mc->sz_cols != m->sz_cols) {
+		rc = -EINVAL;
+		goto err;
+	}
+#endif
+
+	rc = zsl_ws_vec_alloc(ws, &mean, n);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_ws_vec_alloc(ws, &d, n);
+	if (rc) {
+		goto err;
+	}
+
+	/* The upper triangle of 'mc' holds the running co-moments. */
+	zsl_vec_init(&mean);
+	zsl_mtx_init(mc, NULL);
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		zsl_sta_covar_row(n, i + 1, mean.data, d.data, mc->data,
+				  &m->data[i * n]);
+	}
+
+	zsl_sta_covar_finish(n, m->sz_rows, mc->data, mc, corr);
+
+err:
+	zsl_ws_release(ws, mark);
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int zsl_sta_covar_mtx(const struct zsl_mtx *m, struct zsl_mtx *mc)
+{
+	return zsl_sta_covar_mtx_run(m, mc, false);
+}
+
+int zsl_sta_corr_mtx(const struct zsl_mtx *m, struct zsl_mtx *mr)
+{
+	return zsl_sta_covar_mtx_run(m, mr, true);
+}
+
+int zsl_sta_covar_stream_init(struct zsl_sta_covar_stream *s)
+{
+	size_t n = s->mean.sz;
+
+	if (s->delta.sz != n || s->c2.sz_rows != n || s->c2.sz_cols != n) {
+		return -EINVAL;
+	}
+
+	s->rows = 0;
+	zsl_vec_init(&s->mean);
+	zsl_mtx_init(&s->c2, NULL);
+
+	return 0;
+}
+
+int zsl_sta_covar_stream_feed(struct zsl_sta_covar_stream *s,
+			      const struct zsl_vec *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (x->sz != s->mean.sz) {
 		return -EINVAL;
 	}
 #endif
 
-	zsl_real_t c;
+	s->rows++;
+	zsl_sta_covar_row(s->mean.sz, s->rows, s->mean.data, s->delta.data,
+			  s->c2.data, x->data);
 
-	ZSL_VECTOR_DEF(v1, m->sz_rows);
-	ZSL_VECTOR_DEF(v2, m->sz_rows);
+	return 0;
+}
 
-	for (size_t i = 0; i < m->sz_cols; i++) {
-		for (size_t j = 0; j < m->sz_cols; j++) {
-			zsl_mtx_get_col(m, i, v1.data);
-			zsl_mtx_get_col(m, j, v2.data);
-			zsl_sta_covar(&v1, &v2, &c);
-			mc->data[(i * m->sz_cols) + j] = c;
-		}
+int zsl_sta_covar_stream_feed_mtx(struct zsl_sta_covar_stream *s,
+				  const struct zsl_mtx *m)
+{
+	size_t n = s->mean.sz;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (m->sz_cols != n) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		s->rows++;
+		zsl_sta_covar_row(n, s->rows, s->mean.data, s->delta.data,
+				  s->c2.data, &m->data[i * n]);
+	}
+
+	return 0;
+}
+
+int zsl_sta_covar_stream_covar(const struct zsl_sta_covar_stream *s,
+			       struct zsl_mtx *mc)
+{
+	size_t n = s->mean.sz;
+
+	if (mc->sz_rows != n || mc->sz_cols != n || s->rows < 2) {
+		return -EINVAL;
+	}
+
+	zsl_sta_covar_finish(n, s->rows, s->c2.data, mc, false);
+
+	return 0;
+}
+
+int zsl_sta_covar_stream_corr(const struct zsl_sta_covar_stream *s,
+			      struct zsl_mtx *mr)
+{
+	size_t n = s->mean.sz;
+
+	if (mr->sz_rows != n || mr->sz_cols != n || s->rows < 2) {
+		return -EINVAL;
 	}
 
+	zsl_sta_covar_finish(n, s->rows, s->c2.data, mr, true);
+
 	return 0;
 }
 
-int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
+int zsl_sta_linear_reg(const struct zsl_vec *v, const struct zsl_vec *w,
 		       struct zsl_sta_linreg *c)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
@@ -243,14 +838,887 @@ int zsl_sta_linear_reg(struct zsl_vec *v, struct zsl_vec *w,
 	return 0;
 }
 
-int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+size_t zsl_sta_mult_linear_reg_ws_sz(size_t m, size_t p)
+{
+	return m * p + m + p;
+}
+
+int zsl_sta_mult_linear_reg_ws(const struct zsl_mtx *x,
+			       const struct zsl_vec *y,
+			       const struct zsl_vec *w, struct zsl_vec *beta,
+			       struct zsl_workspace *ws)
+{
+	int rc;
+	size_t m = x->sz_rows;
+	size_t p = x->sz_cols;
+	zsl_real_t sw, f, rmax;
+	struct zsl_mtx qr, b;
+	struct zsl_vec tau;
+	size_t mark = zsl_ws_mark(ws);
+
+	if (y->sz != m || beta->sz != p || m < p || p == 0 ||
+	    (w != NULL && w->sz != m)) {
+		return -EINVAL;
+	}
+
+	rc = zsl_ws_mtx_alloc(ws, &qr, m, p);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_ws_mtx_alloc(ws, &b, m, 1);
+	if (rc) {
+		goto err;
+	}
+	rc = zsl_ws_vec_alloc(ws, &tau, p);
+	if (rc) {
+		goto err;
+	}
+
+	/* Scaling each row by sqrt(w) turns the weighted problem into an
+	 * ordinary one. */
+	for (size_t i = 0; i < m; i++) {
+		sw = 1.0;
+		if (w != NULL) {
+			if (w->data[i] < 0.0) {
+				rc = -EINVAL;
+				goto err;
+			}
+			sw = ZSL_SQRT(w->data[i]);
+		}
+		for (size_t j = 0; j < p; j++) {
+			qr.data[i * p + j] = sw * x->data[i * p + j];
+		}
+		b.data[i] = sw * y->data[i];
+	}
+
+	/* X = Q * R, so beta solves R * beta = the first p entries of
+	 * Q^T * y. */
+	zsl_mtx_qr(&qr, &qr, &tau);
+	zsl_mtx_qr_apply_q(&qr, &tau, &b, true);
+
+	rmax = 0.0;
+	for (size_t i = 0; i < p; i++) {
+		f = ZSL_ABS(qr.data[i * p + i]);
+		rmax = (f > rmax) ? f : rmax;
+	}
+
+	for (size_t i = p; i-- > 0;) {
+		if (ZSL_ABS(qr.data[i * p + i]) <= ZSL_STA_EPS * p * rmax ||
+		    rmax == 0.0) {
+			rc = -ESINGULAR;
+			goto err;
+		}
+		f = b.data[i];
+		for (size_t j = i + 1; j < p; j++) {
+			f -= qr.data[i * p + j] * beta->data[j];
+		}
+		beta->data[i] = f / qr.data[i * p + i];
+	}
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int zsl_sta_mult_linear_reg(const struct zsl_mtx *x, const struct zsl_vec *y,
+			    const struct zsl_vec *w, struct zsl_vec *beta)
+{
+	int rc;
+	ZSL_SCRATCH_DEF(ws,
+			zsl_sta_mult_linear_reg_ws_sz(x->sz_rows, x->sz_cols));
+
+	rc = zsl_sta_mult_linear_reg_ws(x, y, w, beta, ws);
+
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+size_t zsl_sta_poly_fit_ws_sz(size_t m, size_t p)
+{
+	return m * p + zsl_sta_mult_linear_reg_ws_sz(m, p);
+}
+
+int zsl_sta_poly_fit_ws(const struct zsl_vec *x, const struct zsl_vec *y,
+			const struct zsl_vec *w, struct zsl_vec *c,
+			struct zsl_workspace *ws)
+{
+	int rc;
+	size_t m = x->sz;
+	size_t p = c->sz;
+	struct zsl_mtx v;
+	size_t mark = zsl_ws_mark(ws);
+
+	if (p == 0) {
+		return -EINVAL;
+	}
+
+	rc = zsl_ws_mtx_alloc(ws, &v, m, p);
+	if (rc) {
+		goto err;
+	}
+
+	/* The Vandermonde matrix, row i being 1, x_i, x_i^2, ... */
+	for (size_t i = 0; i < m; i++) {
+		v.data[i * p] = 1.0;
+		for (size_t j = 1; j < p; j++) {
+			v.data[i * p + j] = v.data[i * p + j - 1] * x->data[i];
+		}
+	}
+
+	rc = zsl_sta_mult_linear_reg_ws(&v, y, w, c, ws);
+
+err:
+	zsl_ws_release(ws, mark);
+	return rc;
+}
+
+int zsl_sta_poly_fit(const struct zsl_vec *x, const struct zsl_vec *y,
+		     const struct zsl_vec *w, struct zsl_vec *c)
+{
+	int rc;
+	ZSL_SCRATCH_DEF(ws, zsl_sta_poly_fit_ws_sz(x->sz, c->sz));
+
+	rc = zsl_sta_poly_fit_ws(x, y, w, c, ws);
+
+	ZSL_SCRATCH_PUT(ws);
+	return rc;
+}
+
+int zsl_sta_ls_stream_init(struct zsl_sta_ls_stream *s)
+{
+	size_t p = s->xty.sz;
+
+	if (s->xtx.sz_rows != p || s->xtx.sz_cols != p ||
+	    s->l.sz_rows != p || s->l.sz_cols != p) {
+		return -EINVAL;
+	}
+
+	s->rows = 0;
+	zsl_mtx_init(&s->xtx, NULL);
+	zsl_vec_init(&s->xty);
+
+	return 0;
+}
+
+int zsl_sta_ls_stream_feed(struct zsl_sta_ls_stream *s,
+			   const struct zsl_vec *x, zsl_real_t y,
+			   zsl_real_t w)
+{
+	size_t p = s->xty.sz;
+	zsl_real_t wxi;
+
+	if (x->sz != p || w < 0.0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < p; i++) {
+		wxi = w * x->data[i];
+		for (size_t j = 0; j <= i; j++) {
+			s->xtx.data[i * p + j] += wxi * x->data[j];
+		}
+		s->xty.data[i] += wxi * y;
+	}
+	s->rows++;
+
+	return 0;
+}
+
+int zsl_sta_ls_stream_solve(struct zsl_sta_ls_stream *s, struct zsl_vec *beta)
+{
+	int rc;
+	size_t p = s->xty.sz;
+	struct zsl_mtx b = { .sz_rows = p, .sz_cols = 1, .data = s->xty.data };
+	struct zsl_mtx x = { .sz_rows = p, .sz_cols = 1, .data = beta->data };
+
+	if (beta->sz != p) {
+		return -EINVAL;
+	}
+
+	/* zsl_mtx_cholesky only reads the lower triangle of 'xtx'. */
+	rc = zsl_mtx_cholesky(&s->xtx, &s->l);
+	if (rc) {
+		return rc;
+	}
+
+	return zsl_mtx_chol_solve(&s->l, &b, &x);
+}
+
+int zsl_sta_rls_init(struct zsl_sta_rls *rls, zsl_real_t lambda,
+		     zsl_real_t delta)
+{
+	if (!(lambda > 0.0 && lambda <= 1.0) || !(delta > 0.0)) {
+		return -EINVAL;
+	}
+
+	rls->lambda = lambda;
+	zsl_vec_init(&rls->theta);
+	zsl_vec_init(&rls->gain);
+	zsl_mtx_init(&rls->p, zsl_mtx_entry_fn_identity);
+	zsl_mtx_scalar_mult_d(&rls->p, delta);
+
+	return 0;
+}
+
+int zsl_sta_rls_update(struct zsl_sta_rls *rls, const struct zsl_vec *x,
+		       zsl_real_t y, zsl_real_t *err)
+{
+	size_t n = rls->theta.sz;
+	zsl_real_t *p = rls->p.data;
+	zsl_real_t *g = rls->gain.data;
+	zsl_real_t denom, e, f;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (x->sz != n) {
+		return -EINVAL;
+	}
+#endif
+
+	/* g = P * x, denom = lambda + x^T * P * x, e = y - theta^T * x. */
+	denom = rls->lambda;
+	e = y;
+	for (size_t i = 0; i < n; i++) {
+		g[i] = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			g[i] += p[i * n + j] * x->data[j];
+		}
+		denom += x->data[i] * g[i];
+		e -= rls->theta.data[i] * x->data[i];
+	}
+
+	if (!(denom > 0.0)) {
+		return -ENOTPOSDEF;
+	}
+
+	if (err != NULL) {
+		*err = e;
+	}
+
+	/* theta += g * e / denom. */
+	f = e / denom;
+	for (size_t i = 0; i < n; i++) {
+		rls->theta.data[i] += g[i] * f;
+	}
+
+	/*
+	 * P = (P - g * g^T / denom) / lambda. Only the upper triangle is
+	 * computed and mirrored, so that rounding can't make P asymmetric.
+	 */
+	f = 1.0 / denom;
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i; j < n; j++) {
+			p[i * n + j] = (p[i * n + j] - g[i] * g[j] * f) /
+				       rls->lambda;
+			p[j * n + i] = p[i * n + j];
+		}
+	}
+
+	return 0;
+}
+
+int zsl_sta_stream_init(struct zsl_sta_stream *s)
+{
+	s->n = 0;
+	s->mean = 0.0;
+	s->m2 = 0.0;
+	s->m3 = 0.0;
+	s->m4 = 0.0;
+	s->min = 0.0;
+	s->max = 0.0;
+
+	return 0;
+}
+
+int zsl_sta_stream_feed(struct zsl_sta_stream *s, zsl_real_t x)
+{
+	zsl_real_t n, d, dn, dn2, t;
+
+	if (s->n == 0 || x < s->min) {
+		s->min = x;
+	}
+	if (s->n == 0 || x > s->max) {
+		s->max = x;
+	}
+
+	/* Welford's update, extended to the third and fourth moments. The
+	 * higher moments are updated first, since they use the old m2, m3. */
+	s->n++;
+	n = (zsl_real_t)s->n;
+	d = x - s->mean;
+	dn = d / n;
+	dn2 = dn * dn;
+	t = d * dn * (n - 1.0);
+
+	s->mean += dn;
+	s->m4 += t * dn2 * (n * n - 3.0 * n + 3.0) + 6.0 * dn2 * s->m2 -
+		 4.0 * dn * s->m3;
+	s->m3 += t * dn * (n - 2.0) - 3.0 * dn * s->m2;
+	s->m2 += t;
+
+	return 0;
+}
+
+int zsl_sta_stream_feed_vec(struct zsl_sta_stream *s,
+			    const struct zsl_vec *v)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		zsl_sta_stream_feed(s, v->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_sta_stream_merge(struct zsl_sta_stream *s,
+			 const struct zsl_sta_stream *o)
+{
+	zsl_real_t na, nb, n, d, d2, dn;
+
+	if (o->n == 0) {
+		return 0;
+	}
+	if (s->n == 0) {
+		*s = *o;
+		return 0;
+	}
+
+	na = (zsl_real_t)s->n;
+	nb = (zsl_real_t)o->n;
+	n = na + nb;
+	d = o->mean - s->mean;
+	d2 = d * d;
+	dn = d / n;
+
+	/* Pairwise combination of the central moments, in the order that
+	 * leaves the old m2 and m3 of 's' available to the higher terms. */
+	s->m4 += o->m4 +
+		 d2 * dn * dn * na * nb * (na * na - na * nb + nb * nb) / n +
+		 6.0 * dn * dn * (na * na * o->m2 + nb * nb * s->m2) +
+		 4.0 * dn * (na * o->m3 - nb * s->m3);
+	s->m3 += o->m3 + d2 * dn * na * nb * (na - nb) / n +
+		 3.0 * dn * (na * o->m2 - nb * s->m2);
+	s->m2 += o->m2 + d2 * na * nb / n;
+	s->mean += dn * nb;
+	s->n += o->n;
+
+	if (o->min < s->min) {
+		s->min = o->min;
+	}
+	if (o->max > s->max) {
+		s->max = o->max;
+	}
+
+	return 0;
+}
+
+int zsl_sta_stream_var(const struct zsl_sta_stream *s, zsl_real_t *var)
+{
+	if (s->n < 2) {
+		return -EINVAL;
+	}
+
+	*var = s->m2 / (zsl_real_t)(s->n - 1);
+
+	return 0;
+}
+
+int zsl_sta_stream_sta_dev(const struct zsl_sta_stream *s, zsl_real_t *sd)
+{
+	int rc;
+
+	rc = zsl_sta_stream_var(s, sd);
+	if (rc) {
+		return rc;
+	}
+
+	*sd = ZSL_SQRT(*sd);
+
+	return 0;
+}
+
+int zsl_sta_stream_skew(const struct zsl_sta_stream *s, zsl_real_t *skew)
+{
+	if (s->n < 2 || !(s->m2 > 0.0)) {
+		return -EINVAL;
+	}
+
+	*skew = ZSL_SQRT((zsl_real_t)s->n) * s->m3 / (s->m2 * ZSL_SQRT(s->m2));
+
+	return 0;
+}
+
+int zsl_sta_stream_kurt(const struct zsl_sta_stream *s, zsl_real_t *kurt)
+{
+	if (s->n < 2 || !(s->m2 > 0.0)) {
+		return -EINVAL;
+	}
+
+	*kurt = (zsl_real_t)s->n * s->m4 / (s->m2 * s->m2) - 3.0;
+
+	return 0;
+}
+
+int zsl_sta_window_init(struct zsl_sta_window *w)
+{
+	if (w->buf.sz == 0) {
+		return -EINVAL;
+	}
+
+	w->minq.head = 0;
+	w->minq.len = 0;
+	w->maxq.head = 0;
+	w->maxq.len = 0;
+	w->seq = 0;
+	w->mean = 0.0;
+	w->m2 = 0.0;
+
+	return 0;
+}
+
+/*
+ * Adds sample number 'seq' of the window to deque 'q', first dropping the
+ * front if it has just left the window, and then every entry from the back
+ * that 'seq' replaces as a candidate. 'lower' selects the minimum deque.
+ */
+static void zsl_sta_window_push(struct zsl_sta_window *w,
+				struct zsl_sta_window_deque *q, size_t seq,
+				bool lower)
+{
+	size_t n = w->buf.sz;
+	zsl_real_t x = w->buf.data[seq % n];
+	zsl_real_t b;
+
+	if (q->len > 0 && seq - q->idx[q->head] >= n) {
+		q->head = (q->head + 1) % n;
+		q->len--;
+	}
+
+	while (q->len > 0) {
+		b = w->buf.data[q->idx[(q->head + q->len - 1) % n] % n];
+		if (lower ? (b < x) : (b > x)) {
+			break;
+		}
+		q->len--;
+	}
+
+	q->idx[(q->head + q->len) % n] = seq;
+	q->len++;
+}
+
+int zsl_sta_window_feed(struct zsl_sta_window *w, zsl_real_t x)
+{
+	size_t n = w->buf.sz;
+	size_t slot = w->seq % n;
+	zsl_real_t mean, d;
+
+	if (w->seq < n) {
+		/* Still filling up: Welford's update. */
+		d = x - w->mean;
+		w->mean += d / (zsl_real_t)(w->seq + 1);
+		w->m2 += d * (x - w->mean);
+	} else {
+		/* Replace the oldest sample, keeping the count at n. */
+		d = w->buf.data[slot];
+		mean = w->mean + (x - d) / (zsl_real_t)n;
+		w->m2 += (x - d) * (x - mean + d - w->mean);
+		w->mean = mean;
+		if (w->m2 < 0.0) {
+			w->m2 = 0.0;
+		}
+	}
+
+	w->buf.data[slot] = x;
+	zsl_sta_window_push(w, &w->minq, w->seq, true);
+	zsl_sta_window_push(w, &w->maxq, w->seq, false);
+	w->seq++;
+
+	return 0;
+}
+
+size_t zsl_sta_window_count(const struct zsl_sta_window *w)
+{
+	return (w->seq < w->buf.sz) ? w->seq : w->buf.sz;
+}
+
+int zsl_sta_window_mean(const struct zsl_sta_window *w, zsl_real_t *m)
+{
+	if (w->seq == 0) {
+		return -EINVAL;
+	}
+
+	*m = w->mean;
+
+	return 0;
+}
+
+int zsl_sta_window_var(const struct zsl_sta_window *w, zsl_real_t *var)
+{
+	size_t n = zsl_sta_window_count(w);
+
+	if (n < 2) {
+		return -EINVAL;
+	}
+
+	*var = w->m2 / (zsl_real_t)(n - 1);
+
+	return 0;
+}
+
+int zsl_sta_window_range(const struct zsl_sta_window *w, zsl_real_t *min,
+			 zsl_real_t *max)
+{
+	size_t n = w->buf.sz;
+
+	if (w->seq == 0) {
+		return -EINVAL;
+	}
+
+	if (min != NULL) {
+		*min = w->buf.data[w->minq.idx[w->minq.head] % n];
+	}
+	if (max != NULL) {
+		*max = w->buf.data[w->maxq.idx[w->maxq.head] % n];
+	}
+
+	return 0;
+}
+
+int zsl_sta_hampel_init(struct zsl_sta_hampel *h, zsl_real_t t)
+{
+	if (h->buf.sz == 0 || !(t >= 0.0)) {
+		return -EINVAL;
+	}
+
+	h->seq = 0;
+	h->t = t;
+
+	return 0;
+}
+
+/* Returns the first index in s[lo..hi) whose value isn't below 'x', or
+ * above it if 'upper' is true. */
+static size_t zsl_sta_hampel_bound(const zsl_real_t *s, size_t lo, size_t hi,
+				   zsl_real_t x, bool upper)
+{
+	size_t m;
+
+	while (lo < hi) {
+		m = lo + (hi - lo) / 2;
+		if (upper ? (s[m] <= x) : (s[m] < x)) {
+			lo = m + 1;
+		} else {
+			hi = m;
+		}
+	}
+
+	return lo;
+}
+
+/*
+ * Returns the k'th smallest (zero-based) of the distances |s[i] - m| over
+ * the 'c' sorted values in 's', where the first 'p' values are below 'm'.
+ *
+ * The distances below 'm' increase from s[p - 1] down to s[0], and those
+ * at or above it from s[p] up, so this is the k'th smallest value of two
+ * sorted sequences, found by bisecting the number taken from the first.
+ */
+static zsl_real_t zsl_sta_hampel_kth(const zsl_real_t *s, size_t c, size_t p,
+				     zsl_real_t m, size_t k)
+{
+	size_t nr = c - p;
+	size_t lo = (k + 1 > nr) ? k + 1 - nr : 0;
+	size_t hi = (k + 1 < p) ? k + 1 : p;
+	size_t i, j;
+	zsl_real_t l, r;
+
+	while (lo < hi) {
+		i = lo + (hi - lo) / 2;
+		j = k + 1 - i;
+		/* Take more from below 'm' if its next distance is smaller
+		 * than the last one taken from above. */
+		if (j > 0 && m - s[p - 1 - i] < s[p + j - 1] - m) {
+			lo = i + 1;
+		} else {
+			hi = i;
+		}
+	}
+
+	i = lo;
+	j = k + 1 - i;
+	l = (i > 0) ? m - s[p - i] : 0.0;
+	r = (j > 0) ? s[p + j - 1] - m : 0.0;
+
+	return ZSL_MAX(l, r);
+}
+
+int zsl_sta_hampel_feed(struct zsl_sta_hampel *h, zsl_real_t x,
+			zsl_real_t *y)
+{
+	size_t n = h->buf.sz;
+	size_t slot = h->seq % n;
+	size_t c, i, j, p;
+	zsl_real_t *s = h->sorted;
+	zsl_real_t old, med, mad;
+
+	if (h->seq < n) {
+		/* Still filling up: insert 'x' after any equal values. */
+		c = h->seq;
+		j = zsl_sta_hampel_bound(s, 0, c, x, true);
+		memmove(&s[j + 1], &s[j], (c - j) * sizeof(zsl_real_t));
+		s[j] = x;
+		c++;
+	} else {
+		/* Replace the oldest sample, shifting only the values between
+		 * its position and that of 'x'. */
+		c = n;
+		old = h->buf.data[slot];
+		i = zsl_sta_hampel_bound(s, 0, c, old, false);
+		if (x > old) {
+			j = zsl_sta_hampel_bound(s, i + 1, c, x, false) - 1;
+			memmove(&s[i], &s[i + 1], (j - i) * sizeof(zsl_real_t));
+		} else {
+			j = zsl_sta_hampel_bound(s, 0, i, x, true);
+			memmove(&s[j + 1], &s[j], (i - j) * sizeof(zsl_real_t));
+		}
+		s[j] = x;
+	}
+
+	h->buf.data[slot] = x;
+	h->seq++;
+
+	/* The median and MAD, averaging the middle two for even counts as
+	 * zsl_sta_median does. */
+	if (c & 1) {
+		med = s[c / 2];
+		p = zsl_sta_hampel_bound(s, 0, c, med, false);
+		mad = zsl_sta_hampel_kth(s, c, p, med, c / 2);
+	} else {
+		med = (s[c / 2 - 1] + s[c / 2]) / 2.0;
+		p = zsl_sta_hampel_bound(s, 0, c, med, false);
+		mad = (zsl_sta_hampel_kth(s, c, p, med, c / 2 - 1) +
+		       zsl_sta_hampel_kth(s, c, p, med, c / 2)) / 2.0;
+	}
+
+	if (ZSL_ABS(x - med) > h->t * ZSL_STA_MAD_NORMAL * mad) {
+		*y = med;
+	} else {
+		*y = x;
+	}
+
+	return 0;
+}
+
+int zsl_sta_tdigest_init(struct zsl_sta_tdigest *td, zsl_real_t delta)
+{
+	if (!(delta >= 1.0) || td->weight.sz != td->mean.sz ||
+	    (zsl_real_t)td->mean.sz < 2.0 * delta) {
+		return -EINVAL;
+	}
+
+	td->n = 0;
+	td->delta = delta;
+	td->total = 0.0;
+	td->min = 0.0;
+	td->max = 0.0;
+
+	return 0;
+}
+
+/* Restores the max-heap property of the first n centroids below 'r'. */
+static void zsl_sta_tdigest_sift(zsl_real_t *m, zsl_real_t *w, size_t r,
+				 size_t n)
+{
+	size_t c;
+	zsl_real_t t;
+
+	for (; (c = 2 * r + 1) < n; r = c) {
+		if (c + 1 < n && m[c] < m[c + 1]) {
+			c++;
+		}
+		if (m[r] >= m[c]) {
+			break;
+		}
+		t = m[r];
+		m[r] = m[c];
+		m[c] = t;
+		t = w[r];
+		w[r] = w[c];
+		w[c] = t;
+	}
+}
+
+/*
+ * Sorts the centroids by mean, then makes one pass combining neighbours
+ * while the merged cluster spans no more than one unit of the scale
+ * k(q) = delta / pi * asin(2 * q - 1), which limits both the number
+ * of centroids kept and their size near q = 0 and q = 1.
+ */
+static void zsl_sta_tdigest_compress(struct zsl_sta_tdigest *td)
+{
+	zsl_real_t *m = td->mean.data;
+	zsl_real_t *w = td->weight.data;
+	zsl_real_t scale = td->delta / ZSL_PI;
+	zsl_real_t sofar = 0.0;
+	zsl_real_t kl, kr, t;
+	size_t out = 0;
+
+	if (td->n < 2) {
+		return;
+	}
+
+	/* Heapsort both arrays together, by mean. */
+	for (size_t s = td->n / 2; s-- > 0;) {
+		zsl_sta_tdigest_sift(m, w, s, td->n);
+	}
+	for (size_t e = td->n; e-- > 1;) {
+		t = m[0];
+		m[0] = m[e];
+		m[e] = t;
+		t = w[0];
+		w[0] = w[e];
+		w[e] = t;
+		zsl_sta_tdigest_sift(m, w, 0, e);
+	}
+
+	kl = -scale * ZSL_ASIN(1.0);
+	for (size_t i = 1; i < td->n; i++) {
+		t = (sofar + w[out] + w[i]) / td->total;
+		kr = scale * ZSL_ASIN(2.0 * (t > 1.0 ? 1.0 : t) - 1.0);
+		if (kr - kl <= 1.0) {
+			m[out] += (m[i] - m[out]) * w[i] / (w[out] + w[i]);
+			w[out] += w[i];
+		} else {
+			sofar += w[out];
+			t = sofar / td->total;
+			kl = scale * ZSL_ASIN(2.0 * (t > 1.0 ? 1.0 : t) - 1.0);
+			out++;
+			m[out] = m[i];
+			w[out] = w[i];
+		}
+	}
+
+	td->n = out + 1;
+}
+
+/* Adds a centroid of weight 'wt' at 'x', combining centroids if full. */
+static void zsl_sta_tdigest_add(struct zsl_sta_tdigest *td, zsl_real_t x,
+				zsl_real_t wt)
+{
+	size_t best = 0;
+
+	if (td->total == 0.0 || x < td->min) {
+		td->min = x;
+	}
+	if (td->total == 0.0 || x > td->max) {
+		td->max = x;
+	}
+	td->total += wt;
+
+	if (td->n == td->mean.sz) {
+		zsl_sta_tdigest_compress(td);
+	}
+
+	if (td->n < td->mean.sz) {
+		td->mean.data[td->n] = x;
+		td->weight.data[td->n] = wt;
+		td->n++;
+		return;
+	}
+
+	/* Still full, which the 2 * delta capacity should prevent: fold the
+	 * sample into the nearest centroid instead. */
+	for (size_t i = 1; i < td->n; i++) {
+		if (ZSL_ABS(td->mean.data[i] - x) <
+		    ZSL_ABS(td->mean.data[best] - x)) {
+			best = i;
+		}
+	}
+	td->weight.data[best] += wt;
+	td->mean.data[best] += (x - td->mean.data[best]) * wt /
+			       td->weight.data[best];
+}
+
+int zsl_sta_tdigest_feed(struct zsl_sta_tdigest *td, zsl_real_t x)
+{
+	zsl_sta_tdigest_add(td, x, 1.0);
+
+	return 0;
+}
+
+int zsl_sta_tdigest_merge(struct zsl_sta_tdigest *td,
+			  const struct zsl_sta_tdigest *o)
+{
+	zsl_real_t min = o->min;
+	zsl_real_t max = o->max;
+
+	if (o->total == 0.0) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < o->n; i++) {
+		zsl_sta_tdigest_add(td, o->mean.data[i], o->weight.data[i]);
+	}
+
+	/* The extremes of 'o' may have been folded into its centroids. */
+	if (min < td->min) {
+		td->min = min;
+	}
+	if (max > td->max) {
+		td->max = max;
+	}
+
+	return 0;
+}
+
+int zsl_sta_tdigest_quantile(struct zsl_sta_tdigest *td, zsl_real_t q,
+			     zsl_real_t *val)
+{
+	zsl_real_t *m = td->mean.data;
+	zsl_real_t *w = td->weight.data;
+	zsl_real_t t, lo, hi;
+
+	if (td->total == 0.0 || !(q >= 0.0 && q <= 1.0)) {
+		return -EINVAL;
+	}
+
+	zsl_sta_tdigest_compress(td);
+
+	/* Each centroid's mean is taken to sit at the middle of its weight,
+	 * and the minimum and maximum at either end, interpolating linearly
+	 * in between. */
+	t = q * td->total;
+	if (t < w[0] / 2.0) {
+		*val = td->min + (m[0] - td->min) * t / (w[0] / 2.0);
+		return 0;
+	}
+
+	lo = w[0] / 2.0;
+	for (size_t i = 1; i < td->n; i++) {
+		hi = lo + (w[i - 1] + w[i]) / 2.0;
+		if (t < hi) {
+			*val = m[i - 1] + (m[i] - m[i - 1]) * (t - lo) /
+			       (hi - lo);
+			return 0;
+		}
+		lo = hi;
+	}
+
+	t -= lo;
+	hi = w[td->n - 1] / 2.0;
+	*val = m[td->n - 1] + (td->max - m[td->n - 1]) *
+	       (t > hi ? 1.0 : t / hi);
+
+	return 0;
+}
+
+int zsl_sta_abs_err(const zsl_real_t *val, const zsl_real_t *exp_val,
+		    zsl_real_t *err)
 {
 	*err = ZSL_ABS(*val - *exp_val);
 
 	return 0;
 }
 
-int zsl_sta_rel_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+int zsl_sta_rel_err(const zsl_real_t *val, const zsl_real_t *exp_val,
+		    zsl_real_t *err)
 {
 	*err = ZSL_ABS(100. * *val - 100 * *exp_val) / *exp_val;
 
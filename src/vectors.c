@@ -9,13 +9,221 @@
 #include <stdbool.h>
 #include <string.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices_fixed.h>
+#include <zsl/smp.h>
+#include <zsl/workspace.h>
 #include <zsl/zsl.h>
 
-/* Enable optimised ARM Thumb/Thumb2 functions if available. */
-#if (CONFIG_ZSL_PLATFORM_OPT == 1 || CONFIG_ZSL_PLATFORM_OPT == 2)
+/*
+ * Blocks of up to this many elements are reduced directly, using four
+ * independent accumulators so that consecutive additions don't wait on each
+ * other. Longer inputs are split in half recursively and the partial sums
+ * added pairwise, which keeps the rounding error growing with log2(n) rather
+ * than n, at no extra cost per element. The platform kernels included below
+ * split long inputs in the same way.
+ */
+#define ZSL_VEC_PAIRWISE_BLOCK 64
+
+/* With CONFIG_ZSL_VECTOR_INLINE, vectors.h defines these functions inline,
+ * and they call the versions here, including any platform kernels, for
+ * long vectors. zsl_vec_sub and zsl_vec_cross are only defined there. */
+#if CONFIG_ZSL_VECTOR_INLINE
+#define zsl_vec_add zsl_vec_add_ool
+#define zsl_vec_scalar_mult zsl_vec_scalar_mult_ool
+#define zsl_vec_dot zsl_vec_dot_ool
+#endif
+
+/* Route common functions through CMSIS-DSP if requested. */
+#if CONFIG_ZSL_BACKEND_CMSIS_DSP
+#include <zsl/asm/arm/cmsis_dsp_vectors.h>
+#endif
+
+/* Enable optimised ARM Thumb/Thumb2/MVE functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 1 || CONFIG_ZSL_PLATFORM_OPT == 2 || \
+     CONFIG_ZSL_PLATFORM_OPT == 3)
 #include <zsl/asm/arm/asm_arm_vectors.h>
 #endif
 
+/* Enable optimised host SIMD functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 4)
+#include <zsl/asm/host/asm_host_vectors.h>
+#endif
+
+/*
+ * The comparison functions check blocks of this many elements without
+ * branching, so the compiler can vectorise each block, and stop at the end
+ * of the first block that fails.
+ */
+#define ZSL_VEC_CMP_BLOCK 16
+
+/*
+ * zsl_vec_sum and zsl_vec_mean accumulate this many output elements at a
+ * time across every input vector, so each block stays in registers and the
+ * output is written once, rather than read and written once per input.
+ */
+#define ZSL_VEC_SUM_BLOCK 8
+
+/* Returns the sum of a[i] * b[i], or of a[i] if 'b' is NULL. */
+static zsl_real_t zsl_vec_pairwise(const zsl_real_t *a, const zsl_real_t *b,
+				   size_t n)
+{
+	zsl_real_t s0 = 0.0;
+	zsl_real_t s1 = 0.0;
+	zsl_real_t s2 = 0.0;
+	zsl_real_t s3 = 0.0;
+	size_t h, i;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		/* Split on a multiple of four to keep the blocks unrolled. */
+		h = (n / 2) & ~(size_t)3;
+		return zsl_vec_pairwise(a, b, h) +
+		       zsl_vec_pairwise(a + h, (b != NULL) ? b + h : NULL,
+					 n - h);
+	}
+
+	if (b == NULL) {
+		for (i = 0; i + 4 <= n; i += 4) {
+			s0 += a[i];
+			s1 += a[i + 1];
+			s2 += a[i + 2];
+			s3 += a[i + 3];
+		}
+		for (; i < n; i++) {
+			s0 += a[i];
+		}
+	} else {
+		for (i = 0; i + 4 <= n; i += 4) {
+			s0 += a[i] * b[i];
+			s1 += a[i + 1] * b[i + 1];
+			s2 += a[i + 2] * b[i + 2];
+			s3 += a[i + 3] * b[i + 3];
+		}
+		for (; i < n; i++) {
+			s0 += a[i] * b[i];
+		}
+	}
+
+	return (s0 + s1) + (s2 + s3);
+}
+
+/* Returns the sum of (a[i] - b[i])^2, reduced as in zsl_vec_pairwise. */
+static zsl_real_t zsl_vec_pairwise_dist(const zsl_real_t *a,
+					const zsl_real_t *b, size_t n)
+{
+	zsl_real_t s0 = 0.0;
+	zsl_real_t s1 = 0.0;
+	zsl_real_t s2 = 0.0;
+	zsl_real_t s3 = 0.0;
+	zsl_real_t d0, d1, d2, d3;
+	size_t h, i;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		h = (n / 2) & ~(size_t)3;
+		return zsl_vec_pairwise_dist(a, b, h) +
+		       zsl_vec_pairwise_dist(a + h, b + h, n - h);
+	}
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		d0 = a[i] - b[i];
+		d1 = a[i + 1] - b[i + 1];
+		d2 = a[i + 2] - b[i + 2];
+		d3 = a[i + 3] - b[i + 3];
+		s0 += d0 * d0;
+		s1 += d1 * d1;
+		s2 += d2 * d2;
+		s3 += d3 * d3;
+	}
+	for (; i < n; i++) {
+		d0 = a[i] - b[i];
+		s0 += d0 * d0;
+	}
+
+	return (s0 + s1) + (s2 + s3);
+}
+
+/*
+ * Sets 'ab' to the sum of a[i] * b[i] and 'aa' to the sum of a[i]^2, reading
+ * each element once, reduced as in zsl_vec_pairwise.
+ */
+static void zsl_vec_pairwise_dot2(const zsl_real_t *a, const zsl_real_t *b,
+				  size_t n, zsl_real_t *ab, zsl_real_t *aa)
+{
+	zsl_real_t p0 = 0.0;
+	zsl_real_t p1 = 0.0;
+	zsl_real_t t0 = 0.0;
+	zsl_real_t t1 = 0.0;
+	zsl_real_t ab2, aa2;
+	size_t h, i;
+
+	if (n > ZSL_VEC_PAIRWISE_BLOCK) {
+		h = (n / 2) & ~(size_t)3;
+		zsl_vec_pairwise_dot2(a, b, h, ab, aa);
+		zsl_vec_pairwise_dot2(a + h, b + h, n - h, &ab2, &aa2);
+		*ab += ab2;
+		*aa += aa2;
+		return;
+	}
+
+	for (i = 0; i + 2 <= n; i += 2) {
+		p0 += a[i] * b[i];
+		t0 += a[i] * a[i];
+		p1 += a[i + 1] * b[i + 1];
+		t1 += a[i + 1] * a[i + 1];
+	}
+	for (; i < n; i++) {
+		p0 += a[i] * b[i];
+		t0 += a[i] * a[i];
+	}
+
+	*ab = p0 + p1;
+	*aa = t0 + t1;
+}
+
+/*
+ * Sets w[j] to s times the sum of v[i][j] over the 'n' vectors in 'v', each
+ * of 'sz' elements. Each output block is stored only after all the inputs
+ * have been read, so 'w' may be one of the inputs.
+ */
+static void zsl_vec_sum_blocked(const struct zsl_vec *const *v, size_t n,
+				size_t sz, zsl_real_t s, zsl_real_t *w)
+{
+	zsl_real_t acc[ZSL_VEC_SUM_BLOCK];
+	const zsl_real_t *x;
+	size_t j, k, len;
+
+	for (j = 0; j < sz; j += ZSL_VEC_SUM_BLOCK) {
+		len = sz - j;
+		if (len > ZSL_VEC_SUM_BLOCK) {
+			len = ZSL_VEC_SUM_BLOCK;
+		}
+
+		for (k = 0; k < ZSL_VEC_SUM_BLOCK; k++) {
+			acc[k] = 0.0;
+		}
+
+		if (len == ZSL_VEC_SUM_BLOCK) {
+			/* Fixed trip count, so the compiler can unroll it. */
+			for (size_t i = 0; i < n; i++) {
+				x = &v[i]->data[j];
+				for (k = 0; k < ZSL_VEC_SUM_BLOCK; k++) {
+					acc[k] += x[k];
+				}
+			}
+		} else {
+			for (size_t i = 0; i < n; i++) {
+				x = &v[i]->data[j];
+				for (k = 0; k < len; k++) {
+					acc[k] += x[k];
+				}
+			}
+		}
+
+		for (k = 0; k < len; k++) {
+			w[j + k] = acc[k] * s;
+		}
+	}
+}
+
 int zsl_vec_init(struct zsl_vec *v)
 {
 	memset(v->data, 0, v->sz * sizeof(zsl_real_t));
@@ -23,14 +231,14 @@ int zsl_vec_init(struct zsl_vec *v)
 	return 0;
 }
 
-int zsl_vec_from_arr(struct zsl_vec *v, zsl_real_t *a)
+int zsl_vec_from_arr(struct zsl_vec *v, const zsl_real_t *a)
 {
 	memcpy(v->data, a, v->sz * sizeof(zsl_real_t));
 
 	return 0;
 }
 
-int zsl_vec_copy(struct zsl_vec *vdest, struct zsl_vec *vsrc)
+int zsl_vec_copy(struct zsl_vec *vdest, const struct zsl_vec *vsrc)
 {
 	vdest->sz = vsrc->sz;
 	memcpy(vdest->data, vsrc->data, sizeof(zsl_real_t) *
@@ -39,7 +247,7 @@ int zsl_vec_copy(struct zsl_vec *vdest, struct zsl_vec *vsrc)
 	return 0;
 }
 
-int zsl_vec_get_subset(struct zsl_vec *v, size_t offset, size_t len,
+int zsl_vec_get_subset(const struct zsl_vec *v, size_t offset, size_t len,
 		       struct zsl_vec *vsub)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
@@ -67,8 +275,53 @@ int zsl_vec_get_subset(struct zsl_vec *v, size_t offset, size_t len,
 	return 0;
 }
 
+int zsl_vec_view(const struct zsl_vec *v, size_t offset, size_t len,
+		 struct zsl_vec *vw)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the window lies within v. */
+	if ((offset > v->sz) || (len > v->sz - offset)) {
+		return -EINVAL;
+	}
+#endif
+
+	vw->sz = len;
+	vw->data = &v->data[offset];
+
+	return 0;
+}
+
+int zsl_vec_win_init(struct zsl_vec_win *w, const struct zsl_vec *v,
+		     size_t len, size_t hop)
+{
+	if ((len == 0) || (hop == 0)) {
+		return -EINVAL;
+	}
+
+	w->v = v;
+	w->len = len;
+	w->hop = hop;
+	w->pos = 0;
+
+	return 0;
+}
+
+int zsl_vec_win_next(struct zsl_vec_win *w, struct zsl_vec *vw)
+{
+	if ((w->pos > w->v->sz) || (w->len > w->v->sz - w->pos)) {
+		return -ENOENT;
+	}
+
+	vw->sz = w->len;
+	vw->data = &w->v->data[w->pos];
+	w->pos += w->hop;
+
+	return 0;
+}
+
 #if !asm_vec_add
-int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+int zsl_vec_add(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure v and w are equal length. */
@@ -85,7 +338,9 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 }
 #endif
 
-int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+#if !CONFIG_ZSL_VECTOR_INLINE
+int zsl_vec_sub(const struct zsl_vec *v, const struct zsl_vec *w,
+		struct zsl_vec *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure v and w are equal length. */
@@ -100,6 +355,7 @@ int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 
 	return 0;
 }
+#endif
 
 int zsl_vec_neg(struct zsl_vec *v)
 {
@@ -110,7 +366,7 @@ int zsl_vec_neg(struct zsl_vec *v)
 	return 0;
 }
 
-int zsl_vec_sum(struct zsl_vec **v, size_t n, struct zsl_vec *w)
+int zsl_vec_sum(const struct zsl_vec *const *v, size_t n, struct zsl_vec *w)
 {
 	size_t sz_last;
 
@@ -131,11 +387,7 @@ int zsl_vec_sum(struct zsl_vec **v, size_t n, struct zsl_vec *w)
 
 	/* Sum all vectors. */
 	w->sz = sz_last;
-	for (size_t i = 0; i < n; i++) {
-		for (size_t j = 0; j < w->sz; j++) {
-			w->data[j] += v[i]->data[j];
-		}
-	}
+	zsl_vec_sum_blocked(v, n, sz_last, 1.0, w->data);
 
 	return 0;
 }
@@ -178,28 +430,26 @@ int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s)
 }
 #endif
 
-zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w)
+zsl_real_t zsl_vec_dist(const struct zsl_vec *v, const struct zsl_vec *w)
 {
-	int rc = 0;
-
-	zsl_real_t xdat[v->sz];
-
-	struct zsl_vec x = { .sz = v->sz, .data = xdat };
-
-	memset(xdat, 0, x.sz * sizeof(zsl_real_t));
-
-	rc = zsl_vec_sub(v, w, &x);
-	if (rc) {
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
 		return NAN;
 	}
+#endif
 
-	return zsl_vec_norm(&x);
+	if (v->sz == 3) {
+		return zsl_vec3_dist(v->data, w->data);
+	}
+
+	/* Accumulate the squared differences without storing them. */
+	return ZSL_SQRT(zsl_vec_pairwise_dist(v->data, w->data, v->sz));
 }
 
-int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
+#if !asm_vec_dot
+int zsl_vec_dot(const struct zsl_vec *v, const struct zsl_vec *w, zsl_real_t *d)
 {
-	zsl_real_t res = 0.0;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure v and w are equal length. */
 	if (v->sz != w->sz) {
@@ -207,25 +457,29 @@ int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
 	}
 #endif
 
-	for (size_t i = 0; i < v->sz; i++) {
-		res += v->data[i] * w->data[i];
-	}
-
-	*d = res;
+	*d = zsl_vec_pairwise(v->data, w->data, v->sz);
 
 	return 0;
 }
+#endif
 
-zsl_real_t zsl_vec_norm(struct zsl_vec *v)
+#if !asm_vec_norm
+zsl_real_t zsl_vec_norm(const struct zsl_vec *v)
 {
 	/*
 	 * |v| = sqrt( v[0]^2 + v[1]^2 + V[...]^2 )
 	 */
 
-	return ZSL_SQRT(zsl_vec_sum_of_sqrs(v));
+	if (v->sz == 3) {
+		return zsl_vec3_norm(v->data);
+	}
+
+	return ZSL_SQRT(zsl_vec_pairwise(v->data, v->data, v->sz));
 }
+#endif
 
-int zsl_vec_project(struct zsl_vec *u, struct zsl_vec *v, struct zsl_vec *w)
+int zsl_vec_project(const struct zsl_vec *u, const struct zsl_vec *v,
+		    struct zsl_vec *w)
 {
 	zsl_real_t p;
 	zsl_real_t t;
@@ -237,17 +491,31 @@ int zsl_vec_project(struct zsl_vec *u, struct zsl_vec *v, struct zsl_vec *w)
 	}
 #endif
 
-	zsl_vec_copy(w, u);
-	zsl_vec_dot(v, u, &p);
-	zsl_vec_dot(u, u, &t);
-	zsl_vec_scalar_mult(w, p / t);
+	if (u->sz == 3) {
+		zsl_vec3_project(u->data, v->data, w->data);
+		return 0;
+	}
+
+	/* Form u . v and u . u in one pass, then scale u straight into w. */
+	zsl_vec_pairwise_dot2(u->data, v->data, u->sz, &p, &t);
+	t = p / t;
+	for (size_t i = 0; i < u->sz; i++) {
+		w->data[i] = u->data[i] * t;
+	}
 
 	return 0;
 }
 
 int zsl_vec_to_unit(struct zsl_vec *v)
 {
-	zsl_real_t norm = zsl_vec_norm(v);
+	zsl_real_t norm;
+
+	if (v->sz == 3) {
+		zsl_vec3_to_unit(v->data, v->data);
+		return 0;
+	}
+
+	norm = zsl_vec_norm(v);
 
 	/*
 	 *            v
@@ -268,7 +536,9 @@ int zsl_vec_to_unit(struct zsl_vec *v)
 	return 0;
 }
 
-int zsl_vec_cross(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *c)
+#if !CONFIG_ZSL_VECTOR_INLINE
+int zsl_vec_cross(const struct zsl_vec *v, const struct zsl_vec *w,
+		  struct zsl_vec *c)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure this is a 3-vector. */
@@ -297,8 +567,9 @@ int zsl_vec_cross(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *c)
 
 	return 0;
 }
+#endif
 
-zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v)
+zsl_real_t zsl_vec_sum_of_sqrs(const struct zsl_vec *v)
 {
 	zsl_real_t dot = 0.0;
 
@@ -307,41 +578,65 @@ zsl_real_t zsl_vec_sum_of_sqrs(struct zsl_vec *v)
 	return dot;
 }
 
-int zsl_vec_mean(struct zsl_vec **v, size_t n, struct zsl_vec *m)
+int zsl_vec_mean(const struct zsl_vec *const *v, size_t n,
+		 struct zsl_vec *m)
 {
-	int rc;
+	if (!n) {
+		return -EINVAL;
+	}
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure the mean vector has an approproate size. */
 	if (m->sz != v[0]->sz) {
 		return -EINVAL;
 	}
+
+	/* Make sure all vectors have the same size. */
+	for (size_t i = 0; i < n; i++) {
+		if (v[i]->sz != m->sz) {
+			return -EINVAL;
+		}
+	}
 #endif
 
-	/* sum also checks that all vectors have the same length. */
-	rc = zsl_vec_sum(v, n, m);
-	if (rc) {
-		return rc;
+	/* Scale each block as it is stored, rather than in a second pass. */
+	zsl_vec_sum_blocked(v, n, m->sz, 1.0 / (zsl_real_t) n, m->data);
+
+	return 0;
+}
+
+int zsl_vec_mean_update(struct zsl_vec *m, size_t n, const struct zsl_vec *v)
+{
+	zsl_real_t s;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and m are equal length. */
+	if (m->sz != v->sz) {
+		return -EINVAL;
 	}
+#endif
 
-	rc = zsl_vec_scalar_mult(m, 1.0 / (zsl_real_t) n);
+	/*
+	 * Welford's update, m' = m + (v - m) / (n + 1), which never forms the
+	 * running sum, so it can't overflow or lose the precision of 'm' for
+	 * large 'n'.
+	 */
+	s = 1.0 / (zsl_real_t)(n + 1);
+	for (size_t i = 0; i < m->sz; i++) {
+		m->data[i] += (v->data[i] - m->data[i]) * s;
+	}
 
 	return 0;
 }
 
-int zsl_vec_ar_mean(struct zsl_vec *v, zsl_real_t *m)
+int zsl_vec_ar_mean(const struct zsl_vec *v, zsl_real_t *m)
 {
 	/* Avoid divide by zero errors. */
 	if (v->sz < 1) {
 		return -EINVAL;
 	}
 
-	*m = 0.0;
-	for (size_t i = 0; i < v->sz; i++) {
-		*m += v->data[i];
-	}
-
-	*m /= v->sz;
+	*m = zsl_vec_pairwise(v->data, NULL, v->sz) / v->sz;
 
 	return 0;
 }
@@ -382,17 +677,27 @@ int zsl_vec_zte(struct zsl_vec *v)
 	return 0;
 }
 
-bool zsl_vec_is_equal(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t eps)
+bool zsl_vec_is_equal(const struct zsl_vec *v, const struct zsl_vec *w,
+		      zsl_real_t eps)
 {
 	zsl_real_t c;
+	size_t i = 0;
+	size_t end;
+	int bad;
 
 	if (v->sz != w->sz) {
 		return false;
 	}
 
-	for (size_t i = 0; i < v->sz; i++) {
-		c = v->data[i] - w->data[i];
-		if (c >= eps || -c >= eps) {
+	while (i < v->sz) {
+		end = (v->sz - i > ZSL_VEC_CMP_BLOCK) ? i + ZSL_VEC_CMP_BLOCK :
+		      v->sz;
+		bad = 0;
+		for (; i < end; i++) {
+			c = v->data[i] - w->data[i];
+			bad |= (c >= eps) | (-c >= eps);
+		}
+		if (bad) {
 			return false;
 		}
 	}
@@ -400,10 +705,20 @@ bool zsl_vec_is_equal(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t eps)
 	return true;
 }
 
-bool zsl_vec_is_nonneg(struct zsl_vec *v)
+bool zsl_vec_is_nonneg(const struct zsl_vec *v)
 {
-	for (size_t i = 0; i < v->sz; i++) {
-		if (v->data[i] < 0.0) {
+	size_t i = 0;
+	size_t end;
+	int bad;
+
+	while (i < v->sz) {
+		end = (v->sz - i > ZSL_VEC_CMP_BLOCK) ? i + ZSL_VEC_CMP_BLOCK :
+		      v->sz;
+		bad = 0;
+		for (; i < end; i++) {
+			bad |= (v->data[i] < 0.0);
+		}
+		if (bad) {
 			return false;
 		}
 	}
@@ -411,7 +726,7 @@ bool zsl_vec_is_nonneg(struct zsl_vec *v)
 	return true;
 }
 
-int zsl_vec_contains(struct zsl_vec *v, zsl_real_t val, zsl_real_t eps)
+int zsl_vec_contains(const struct zsl_vec *v, zsl_real_t val, zsl_real_t eps)
 {
 	zsl_real_t c;
 	int count = 0;
@@ -426,91 +741,450 @@ int zsl_vec_contains(struct zsl_vec *v, zsl_real_t val, zsl_real_t eps)
 	return count;
 }
 
-/**
- * @brief Quicksort implementation used by zsl_vec_sort.
- *
- * @param v    	Unsorted input vector.
- * @param low 	Low index value.
- * @param high  High index value.
- *
- * @return 0 if everything executed properly, otherwise a negative error code.
+/* Ranges at or below this size are finished with an insertion sort. */
+#define ZSL_VEC_SORT_SMALL 16
+
+static void zsl_vec_sort_swap(zsl_real_t *a, size_t i, size_t j)
+{
+	zsl_real_t t = a[i];
+
+	a[i] = a[j];
+	a[j] = t;
+}
+
+/* Restores the max-heap property of a[0..n) below node 'r'. */
+static void zsl_vec_sort_sift(zsl_real_t *a, size_t r, size_t n)
+{
+	size_t c;
+
+	for (; (c = 2 * r + 1) < n; r = c) {
+		if (c + 1 < n && a[c] < a[c + 1]) {
+			c++;
+		}
+		if (a[r] >= a[c]) {
+			break;
+		}
+		zsl_vec_sort_swap(a, r, c);
+	}
+}
+
+/* Sorts a[0..n) in place with heapsort, in O(n log(n)) time. */
+static void zsl_vec_heapsort(zsl_real_t *a, size_t n)
+{
+	for (size_t s = n / 2; s-- > 0;) {
+		zsl_vec_sort_sift(a, s, n);
+	}
+	for (size_t e = n; e-- > 1;) {
+		zsl_vec_sort_swap(a, 0, e);
+		zsl_vec_sort_sift(a, 0, e);
+	}
+}
+
+/*
+ * Partitions a[lo..hi) around the median of its first, middle and last
+ * values, returning j such that a[lo..j] <= pivot <= a[j + 1..hi). Both
+ * sides are non-empty, since the outer two values stop both scans.
  */
-static int zsl_vec_quicksort(struct zsl_vec *v, size_t low, size_t high)
+static size_t zsl_vec_sort_part(zsl_real_t *a, size_t lo, size_t hi)
 {
-	size_t i, j, p;
-	zsl_real_t t;
+	size_t m = lo + (hi - lo) / 2;
+	size_t i = lo;
+	size_t j = hi - 1;
+	zsl_real_t pivot;
 
-	if (low < high) {
-		p = low;
-		i = low;
-		j = high;
+	if (a[m] < a[lo]) {
+		zsl_vec_sort_swap(a, m, lo);
+	}
+	if (a[hi - 1] < a[lo]) {
+		zsl_vec_sort_swap(a, hi - 1, lo);
+	}
+	if (a[hi - 1] < a[m]) {
+		zsl_vec_sort_swap(a, hi - 1, m);
+	}
+	pivot = a[m];
 
-		while (i < j) {
-			while (v->data[i] <= v->data[p] && i <= high) {
-				i++;
+	for (;;) {
+		while (a[i] < pivot) {
+			i++;
+		}
+		while (a[j] > pivot) {
+			j--;
+		}
+		if (i >= j) {
+			return j;
+		}
+		zsl_vec_sort_swap(a, i, j);
+		i++;
+		j--;
+	}
+}
+
+/* Sorts a[0..n) in place with an introsort. */
+static void zsl_vec_introsort(zsl_real_t *a, size_t n)
+{
+	/* Ranges still to be sorted. The larger side of each partition is
+	 * pushed and the smaller one sorted first, so at most log2(n) ranges
+	 * are ever pending, and one per bit of size_t is always enough. */
+	struct {
+		size_t lo;
+		size_t hi;
+		size_t depth;
+	} stack[sizeof(size_t) * 8];
+	size_t top = 0;
+	size_t lo = 0;
+	size_t hi = n;
+	size_t depth = 0;
+	size_t i, j;
+	zsl_real_t x;
+
+	/* Past 2 * log2(n) partitions of one range, the pivots are being
+	 * chosen badly and the range is heapsorted instead. */
+	for (; n > 1; n >>= 1) {
+		depth += 2;
+	}
+
+	for (;;) {
+		while (hi - lo > ZSL_VEC_SORT_SMALL) {
+			if (depth == 0) {
+				zsl_vec_heapsort(&a[lo], hi - lo);
+				lo = hi;
+				break;
 			}
-			while (v->data[j] > v->data[p] && j >= low) {
-				j--;
+			depth--;
+
+			j = zsl_vec_sort_part(a, lo, hi) + 1;
+			stack[top].depth = depth;
+			if (j - lo < hi - j) {
+				stack[top].lo = j;
+				stack[top].hi = hi;
+				hi = j;
+			} else {
+				stack[top].lo = lo;
+				stack[top].hi = j;
+				lo = j;
 			}
-			if (i < j) {
-				t = v->data[i];
-				v->data[i] = v->data[j];
-				v->data[j] = t;
+			top++;
+		}
+
+		for (i = lo + 1; i < hi; i++) {
+			x = a[i];
+			for (j = i; j > lo && a[j - 1] > x; j--) {
+				a[j] = a[j - 1];
 			}
+			a[j] = x;
+		}
+
+		if (top == 0) {
+			break;
 		}
+		top--;
+		lo = stack[top].lo;
+		hi = stack[top].hi;
+		depth = stack[top].depth;
+	}
+}
+
+/*
+ * Inputs of at least this many values are radix sorted when a buffer of the
+ * same size is available. The radix sort makes one pass per byte of the
+ * values, so it overtakes the introsort's log2(n) comparison passes at
+ * about 1024 floats or 2048 doubles.
+ */
+#define ZSL_VEC_SORT_RADIX_MIN (256 * sizeof(zsl_real_t))
+
+/*
+ * With CONFIG_ZSL_SMP, inputs of at least this many values per run are
+ * split into one run per worker thread plus the calling thread, each radix
+ * sorted on its own core, and the runs are then merged in parallel. The
+ * radix byte counts take 256 size_t entries of stack, so this is only done
+ * when the worker threads have stacks of at least 2 KiB. Otherwise, a
+ * single radix sort on the calling thread beats introsorting the runs.
+ */
+#if CONFIG_ZSL_SMP
+#ifndef CONFIG_ZSL_SMP_THREADS
+#define CONFIG_ZSL_SMP_THREADS 1
+#endif
+#ifndef CONFIG_ZSL_SMP_STACK_SIZE
+#define CONFIG_ZSL_SMP_STACK_SIZE 1024
+#endif
+#endif
+
+#if CONFIG_ZSL_SMP && (CONFIG_ZSL_SMP_STACK_SIZE >= 2048)
+#define ZSL_VEC_SORT_RUNS (CONFIG_ZSL_SMP_THREADS + 1)
+#else
+#define ZSL_VEC_SORT_RUNS 1
+#endif
+
+/* The radix sort key, an unsigned integer the size of zsl_real_t. */
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+typedef uint32_t zsl_vec_key_t;
+#else
+typedef uint64_t zsl_vec_key_t;
+#endif
 
-		t = v->data[j];
-		v->data[j] = v->data[p];
-		v->data[p] = t;
+#define ZSL_VEC_KEY_BITS (sizeof(zsl_vec_key_t) * 8)
+#define ZSL_VEC_KEY_SIGN ((zsl_vec_key_t)1 << (ZSL_VEC_KEY_BITS - 1))
 
-		zsl_vec_quicksort(v, low, i - 1);
-		zsl_vec_quicksort(v, j + 1, high);
+/*
+ * Maps the IEEE-754 bit pattern of a[i] to a key that orders as an unsigned
+ * integer the same way as the values do: negative values have every bit
+ * flipped, reversing their order, and positive values have the sign bit
+ * set, placing them above the negatives. The keys are stored in place of
+ * the values, and only ever copied bitwise, so no value is ever rounded.
+ */
+static void zsl_vec_sort_to_keys(zsl_real_t *a, size_t n)
+{
+	zsl_vec_key_t k;
+
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&k, &a[i], sizeof(k));
+		k = (k & ZSL_VEC_KEY_SIGN) ? ~k : (k | ZSL_VEC_KEY_SIGN);
+		memcpy(&a[i], &k, sizeof(k));
 	}
+}
 
-	return 0;
+/* Reverses zsl_vec_sort_to_keys, reading 'src' and writing 'dst'. */
+static void zsl_vec_sort_from_keys(const zsl_real_t *src, zsl_real_t *dst,
+				   size_t n)
+{
+	zsl_vec_key_t k;
+
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&k, &src[i], sizeof(k));
+		k = (k & ZSL_VEC_KEY_SIGN) ? (k & ~ZSL_VEC_KEY_SIGN) : ~k;
+		memcpy(&dst[i], &k, sizeof(k));
+	}
 }
 
-int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w)
+/*
+ * Sorts a[0..n) with a least significant digit radix sort on the keys from
+ * zsl_vec_sort_to_keys, one byte per pass, using 't' as an n-entry buffer.
+ * Passes where every key has the same byte, such as the high exponent bits
+ * of values of similar magnitude, are skipped. Equal values keep their
+ * order, and NaNs are placed at the end (or the start, if negative).
+ */
+static void zsl_vec_radix(zsl_real_t *a, zsl_real_t *t, size_t n)
 {
-	/* Set counters to zero. */
-	size_t count = 0;
-	size_t count2 = 0;
-	size_t i, j, k;
+	size_t cnt[256];
+	size_t sum, c;
+	zsl_real_t *src = a;
+	zsl_real_t *dst = t;
+	zsl_real_t *sw;
+	zsl_vec_key_t k;
+	unsigned int d;
+
+	zsl_vec_sort_to_keys(a, n);
+
+	for (size_t shift = 0; shift < ZSL_VEC_KEY_BITS; shift += 8) {
+		memset(cnt, 0, sizeof(cnt));
+		for (size_t i = 0; i < n; i++) {
+			memcpy(&k, &src[i], sizeof(k));
+			cnt[(k >> shift) & 0xff]++;
+		}
 
-	ZSL_VECTOR_DEF(u, v->sz);
-	zsl_vec_init(&u);
+		memcpy(&k, &src[0], sizeof(k));
+		if (cnt[(k >> shift) & 0xff] == n) {
+			continue;
+		}
 
-	/* Copy the vector 'v' into the vector 'u' with no repeated values. */
-	for (j = 0; j < v->sz; j++) {
-		if (v->data[j] >= 1E-5 || v->data[j] <= 1E-5) {
-			if (zsl_vec_contains(&u, v->data[j], 1E-5) == 0) {
-				u.data[count] = v->data[j];
-				count++;
-			}
+		/* Turn the counts into the first output index of each byte. */
+		sum = 0;
+		for (d = 0; d < 256; d++) {
+			c = cnt[d];
+			cnt[d] = sum;
+			sum += c;
 		}
+
+		for (size_t i = 0; i < n; i++) {
+			memcpy(&k, &src[i], sizeof(k));
+			memcpy(&dst[cnt[(k >> shift) & 0xff]++], &src[i],
+			       sizeof(k));
+		}
+
+		sw = src;
+		src = dst;
+		dst = sw;
 	}
 
-	if (zsl_vec_contains(v, 0.0, 1E-5) > 0) {
-		count++;
+	zsl_vec_sort_from_keys(src, a, n);
+}
+
+/* Sorts a[0..n), using the n-entry buffer 't' if it isn't NULL. */
+static void zsl_vec_sort_run(zsl_real_t *a, zsl_real_t *t, size_t n)
+{
+	if (t != NULL && n >= ZSL_VEC_SORT_RADIX_MIN) {
+		zsl_vec_radix(a, t, n);
+	} else {
+		zsl_vec_introsort(a, n);
 	}
+}
 
-	u.sz = count;
+/* Merges the sorted ranges a[lo..mid) and a[mid..hi) into b[lo..hi). */
+static void zsl_vec_sort_merge(const zsl_real_t *a, zsl_real_t *b, size_t lo,
+			       size_t mid, size_t hi)
+{
+	size_t i = lo;
+	size_t j = mid;
+	size_t k = lo;
 
-	/* Sort the vector with no repeated values 'u'. */
-	zsl_vec_quicksort(&u, 0, count - 1);
+	while (i < mid && j < hi) {
+		b[k++] = (a[j] < a[i]) ? a[j++] : a[i++];
+	}
+	while (i < mid) {
+		b[k++] = a[i++];
+	}
+	while (j < hi) {
+		b[k++] = a[j++];
+	}
+}
 
-	/* Add back the repeated values in the correct order into the vector 'w'. */
-	for (i = 0; i < count; i++) {
-		for (k = 0; k < zsl_vec_contains(v, u.data[i], 1E-5); k++) {
-			w->data[count2] = u.data[i];
-			count2++;
-		}
+/* The state of a run-split sort, shared with the worker threads. */
+struct zsl_vec_sort_job {
+	zsl_real_t *src;
+	zsl_real_t *dst;
+	/* Run r is src[bounds[r]..bounds[r + 1]). */
+	size_t bounds[ZSL_VEC_SORT_RUNS + 1];
+	/* The number of runs, in 'bounds', merged into each output run. */
+	size_t width;
+};
+
+static void zsl_vec_sort_runs_fn(void *arg, size_t start, size_t end)
+{
+	struct zsl_vec_sort_job *job = arg;
+	size_t lo;
+
+	for (size_t r = start; r < end; r++) {
+		lo = job->bounds[r];
+		zsl_vec_sort_run(&job->src[lo], &job->dst[lo],
+				 job->bounds[r + 1] - lo);
+	}
+}
+
+static void zsl_vec_sort_merge_fn(void *arg, size_t start, size_t end)
+{
+	struct zsl_vec_sort_job *job = arg;
+	size_t w = job->width;
+	size_t r0, r1, r2;
+
+	for (size_t p = start; p < end; p++) {
+		r0 = 2 * p * w;
+		r1 = (r0 + w < ZSL_VEC_SORT_RUNS) ? r0 + w : ZSL_VEC_SORT_RUNS;
+		r2 = (r1 + w < ZSL_VEC_SORT_RUNS) ? r1 + w : ZSL_VEC_SORT_RUNS;
+		zsl_vec_sort_merge(job->src, job->dst, job->bounds[r0],
+				   job->bounds[r1], job->bounds[r2]);
+	}
+}
+
+/*
+ * Sorts a[0..n) as ZSL_VEC_SORT_RUNS runs on the worker pool, then merges
+ * pairs of runs, ping-ponging between 'a' and 't', until one remains.
+ */
+static void zsl_vec_sort_split(zsl_real_t *a, zsl_real_t *t, size_t n)
+{
+	struct zsl_vec_sort_job job;
+	size_t lg = 1;
+	size_t pairs;
+	zsl_real_t *sw;
+
+	for (size_t m = n; m > 1; m >>= 1) {
+		lg++;
+	}
+
+	for (size_t r = 0; r <= ZSL_VEC_SORT_RUNS; r++) {
+		job.bounds[r] = n * r / ZSL_VEC_SORT_RUNS;
+	}
+	job.src = a;
+	job.dst = t;
+	zsl_smp_for(zsl_vec_sort_runs_fn, &job, ZSL_VEC_SORT_RUNS, n * lg);
+
+	for (job.width = 1; job.width < ZSL_VEC_SORT_RUNS; job.width *= 2) {
+		pairs = (ZSL_VEC_SORT_RUNS + 2 * job.width - 1) /
+			(2 * job.width);
+		zsl_smp_for(zsl_vec_sort_merge_fn, &job, pairs, n);
+		sw = job.src;
+		job.src = job.dst;
+		job.dst = sw;
+	}
+
+	if (job.src != a) {
+		memcpy(a, job.src, n * sizeof(zsl_real_t));
 	}
+}
+
+/* Sorts a[0..n) with the fastest method that the n-entry buffer 't', or
+ * NULL if there isn't one, allows. */
+static void zsl_vec_sort_buf(zsl_real_t *a, zsl_real_t *t, size_t n)
+{
+	if (t != NULL && ZSL_VEC_SORT_RUNS > 1 &&
+	    n >= ZSL_VEC_SORT_RUNS * ZSL_VEC_SORT_RADIX_MIN) {
+		zsl_vec_sort_split(a, t, n);
+	} else {
+		zsl_vec_sort_run(a, t, n);
+	}
+}
+
+int zsl_vec_sort_d(struct zsl_vec *v)
+{
+#if CONFIG_ZSL_SCRATCH_POOL
+	/* Only the shared pool is tried, since a stack buffer of v->sz
+	 * entries could be far larger than the stack. */
+	if (v->sz >= ZSL_VEC_SORT_RADIX_MIN) {
+		size_t mark;
+		zsl_real_t *t;
+
+		ZSL_SCRATCH_DEF(ws, v->sz);
+		mark = zsl_ws_mark(ws);
+		t = zsl_ws_alloc(ws, v->sz);
+		zsl_vec_sort_buf(v->data, t, v->sz);
+		zsl_ws_release(ws, mark);
+		ZSL_SCRATCH_PUT(ws);
+
+		return 0;
+	}
+#endif
+
+	zsl_vec_introsort(v->data, v->sz);
+
+	return 0;
+}
+
+size_t zsl_vec_sort_ws_sz(size_t n)
+{
+	return n;
+}
+
+int zsl_vec_sort_ws(struct zsl_vec *v, struct zsl_workspace *ws)
+{
+	size_t mark = zsl_ws_mark(ws);
+	zsl_real_t *t = zsl_ws_alloc(ws, v->sz);
+
+	if (t == NULL) {
+		return -ENOMEM;
+	}
+
+	zsl_vec_sort_buf(v->data, t, v->sz);
+	zsl_ws_release(ws, mark);
 
 	return 0;
 }
 
-int zsl_vec_print(struct zsl_vec *v)
+int zsl_vec_sort(const struct zsl_vec *v, struct zsl_vec *w)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	if (w->data != v->data) {
+		memcpy(w->data, v->data, v->sz * sizeof(zsl_real_t));
+	}
+
+	return zsl_vec_sort_d(w);
+}
+
+int zsl_vec_print(const struct zsl_vec *v)
 {
 	for (size_t g = 0; g < v->sz; g++) {
 		printf("%f ", v->data[g]);
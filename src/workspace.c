@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <zsl/zsl.h>
+#include <zsl/workspace.h>
+
+#if CONFIG_ZSL_SCRATCH_POOL
+#ifdef __ZEPHYR__
+#include <kernel.h>
+#endif
+
+#ifndef CONFIG_ZSL_SCRATCH_POOL_SIZE
+#define CONFIG_ZSL_SCRATCH_POOL_SIZE 1024
+#endif
+
+/* The shared scratch pool used by library functions for temporaries. */
+static zsl_real_t zsl_scratch_buf[CONFIG_ZSL_SCRATCH_POOL_SIZE];
+static struct zsl_workspace zsl_scratch_pool = {
+	.data = zsl_scratch_buf,
+	.sz = CONFIG_ZSL_SCRATCH_POOL_SIZE,
+	.used = 0,
+	.peak = 0
+};
+
+/* Zephyr mutexes can be locked recursively by their owner, which is
+ * required since pool users call into other pool users. Standalone builds
+ * are assumed to be single-threaded. */
+#ifdef __ZEPHYR__
+static K_MUTEX_DEFINE(zsl_scratch_lock);
+#define ZSL_SCRATCH_LOCK() k_mutex_lock(&zsl_scratch_lock, K_FOREVER)
+#define ZSL_SCRATCH_UNLOCK() k_mutex_unlock(&zsl_scratch_lock)
+#else
+#define ZSL_SCRATCH_LOCK()
+#define ZSL_SCRATCH_UNLOCK()
+#endif
+#endif /* CONFIG_ZSL_SCRATCH_POOL */
+
+int
+zsl_ws_init(struct zsl_workspace *ws, zsl_real_t *buf, size_t sz)
+{
+	if (buf == NULL && sz != 0) {
+		return -EINVAL;
+	}
+
+	ws->data = buf;
+	ws->sz = sz;
+	ws->used = 0;
+	ws->peak = 0;
+
+	return 0;
+}
+
+size_t
+zsl_ws_mark(struct zsl_workspace *ws)
+{
+	return ws->used;
+}
+
+int
+zsl_ws_release(struct zsl_workspace *ws, size_t mark)
+{
+	if (mark > ws->used) {
+		return -EINVAL;
+	}
+
+	zsl_instr_scratch(-(ptrdiff_t)((ws->used - mark) *
+				       sizeof(zsl_real_t)));
+	ws->used = mark;
+
+	return 0;
+}
+
+size_t
+zsl_ws_avail(struct zsl_workspace *ws)
+{
+	return ws->sz - ws->used;
+}
+
+zsl_real_t *
+zsl_ws_alloc(struct zsl_workspace *ws, size_t n)
+{
+	zsl_real_t *p;
+
+	if (n > ws->sz - ws->used) {
+		return NULL;
+	}
+
+	p = &ws->data[ws->used];
+	ws->used += n;
+	if (ws->used > ws->peak) {
+		ws->peak = ws->used;
+	}
+	zsl_instr_scratch((ptrdiff_t)(n * sizeof(zsl_real_t)));
+
+	return p;
+}
+
+int
+zsl_ws_mtx_alloc(struct zsl_workspace *ws, struct zsl_mtx *m,
+		 size_t rows, size_t cols)
+{
+	zsl_real_t *p = zsl_ws_alloc(ws, rows * cols);
+
+	if (p == NULL) {
+		return -ENOMEM;
+	}
+
+	m->sz_rows = rows;
+	m->sz_cols = cols;
+	m->data = p;
+
+	return 0;
+}
+
+int
+zsl_ws_vec_alloc(struct zsl_workspace *ws, struct zsl_vec *v, size_t sz)
+{
+	zsl_real_t *p = zsl_ws_alloc(ws, sz);
+
+	if (p == NULL) {
+		return -ENOMEM;
+	}
+
+	v->sz = sz;
+	v->data = p;
+
+	return 0;
+}
+
+#if CONFIG_ZSL_SCRATCH_POOL
+struct zsl_workspace *
+zsl_scratch_get(void)
+{
+	ZSL_SCRATCH_LOCK();
+
+	return &zsl_scratch_pool;
+}
+
+void
+zsl_scratch_put(struct zsl_workspace *ws)
+{
+	(void)ws;
+
+	ZSL_SCRATCH_UNLOCK();
+}
+
+size_t
+zsl_scratch_peak(void)
+{
+	size_t peak;
+
+	ZSL_SCRATCH_LOCK();
+	peak = zsl_scratch_pool.peak;
+	ZSL_SCRATCH_UNLOCK();
+
+	return peak;
+}
+
+void
+zsl_scratch_reset_peak(void)
+{
+	ZSL_SCRATCH_LOCK();
+	zsl_scratch_pool.peak = zsl_scratch_pool.used;
+	ZSL_SCRATCH_UNLOCK();
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/block.h>
+#include <zsl/filter.h>
+#include <zsl/statistics.h>
+#include "floatcheck.h"
+
+ZSL_BLK_DEF(blk_test, 8, 4);
+
+static const zsl_real_t blk_test_h[2] = { 0.5, 0.5 };
+
+/* Keeps every second sample, shortening the block. */
+static int blk_test_decim(struct zsl_vec *v, void *arg)
+{
+	for (size_t i = 0; i < v->sz / 2; i++) {
+		v->data[i] = v->data[2 * i + 1];
+	}
+	v->sz /= 2;
+
+	return 0;
+}
+
+static int blk_test_mean(struct zsl_vec *v, void *arg)
+{
+	return zsl_sta_mean(v, (zsl_real_t *)arg);
+}
+
+static int blk_test_fail(struct zsl_vec *v, void *arg)
+{
+	(*(int *)arg)++;
+
+	return -EIO;
+}
+
+void test_blk_process(void)
+{
+	int rc;
+	int calls = 0;
+	zsl_real_t mean = 0.0;
+	zsl_real_t *buf;
+
+	ZSL_FIR_DEF(fir, 2, 1, blk_test_h);
+
+	rc = zsl_fir_init(&fir);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_blk_init(&blk_test);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_blk_add_stage(&blk_test, NULL, NULL) == -EINVAL,
+		     NULL);
+	zassert_true(zsl_blk_add_stage(&blk_test, zsl_blk_stage_fir,
+				       &fir) == 0, NULL);
+	zassert_true(zsl_blk_add_stage(&blk_test, blk_test_decim,
+				       NULL) == 0, NULL);
+	zassert_true(zsl_blk_add_stage(&blk_test, blk_test_mean,
+				       &mean) == 0, NULL);
+
+	/* Nothing to process yet. */
+	rc = zsl_blk_process(&blk_test, false);
+	zassert_true(rc == -EAGAIN, NULL);
+
+	/* Fill both blocks, so that the next sample is dropped. */
+	for (size_t i = 0; i < 16; i++) {
+		rc = zsl_blk_push(&blk_test, (zsl_real_t)i);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(zsl_blk_fill_buf(&blk_test) == NULL, NULL);
+	rc = zsl_blk_push(&blk_test, 16.0);
+	zassert_true(rc == -ENOBUFS, NULL);
+	zassert_true(blk_test.overruns == 1, NULL);
+
+	/* The filtered block 0..7 is 0, 0.5, ..., 6.5, and the odd samples
+	 * 0.5, 2.5, 4.5 and 6.5 have a mean of 3.5. */
+	rc = zsl_blk_process(&blk_test, false);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mean, 3.5, 1E-6), NULL);
+
+	/* The filter state carries over into the block 8..15. */
+	rc = zsl_blk_process(&blk_test, false);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mean, 11.5, 1E-6), NULL);
+	rc = zsl_blk_process(&blk_test, false);
+	zassert_true(rc == -EAGAIN, NULL);
+
+	/* A block filled through the DMA path, stopped by a failing stage,
+	 * which is still returned to the producer. */
+	rc = zsl_blk_add_stage(&blk_test, blk_test_fail, &calls);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_blk_add_stage(&blk_test, blk_test_fail, &calls);
+	zassert_true(rc == -ENOMEM, NULL);
+	buf = zsl_blk_fill_buf(&blk_test);
+	zassert_true(buf == blk_test.buf[0], NULL);
+	for (size_t i = 0; i < 8; i++) {
+		buf[i] = 1.0;
+	}
+	rc = zsl_blk_commit(&blk_test);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_blk_process(&blk_test, false);
+	zassert_true(rc == -EIO, NULL);
+	zassert_true(calls == 1, NULL);
+	zassert_true(blk_test.errors == 1, NULL);
+	zassert_true(zsl_blk_fill_buf(&blk_test) == blk_test.buf[1], NULL);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/chemistry.h>
+#include "floatcheck.h"
+
+void test_chem_elem_props(void)
+{
+	int rc;
+	enum zsl_chem_elements e;
+
+	/* The table is indexed by atomic number. */
+	zassert_true(strcmp(zsl_chem_elem_props[ZSL_CHEM_ELEM_HYDROGEN].sym,
+			    "H") == 0, NULL);
+	zassert_true(strcmp(zsl_chem_elem_props[ZSL_CHEM_ELEM_IRON].sym,
+			    "Fe") == 0, NULL);
+	zassert_true(zsl_chem_elem_props[ZSL_CHEM_ELEM_IRON].period == 4, NULL);
+	zassert_true(zsl_chem_elem_props[ZSL_CHEM_ELEM_IRON].group == 8, NULL);
+	zassert_true(zsl_chem_elem_props[ZSL_CHEM_ELEM_GOLD].group == 11, NULL);
+	zassert_true(zsl_chem_elem_props[ZSL_CHEM_ELEM_RADON].group == 18,
+		     NULL);
+	zassert_true(zsl_chem_elem_props[ZSL_CHEM_ELEM_OGANESSON].period == 7,
+		     NULL);
+
+	zassert_true(val_is_equal(zsl_chem_elem_weight(ZSL_CHEM_ELEM_OXYGEN),
+				  15.9994, 1E-4), NULL);
+	zassert_true(zsl_chem_elem_weight((enum zsl_chem_elements)200) == 0.0,
+		     NULL);
+
+	/* Every symbol maps back to its own element. */
+	for (int i = 1; i <= ZSL_CHEM_ELEM_OGANESSON; i++) {
+		rc = zsl_chem_elem_find(zsl_chem_elem_props[i].sym, &e);
+		zassert_true(rc == 0, NULL);
+		zassert_true((int)e == i, NULL);
+	}
+
+	rc = zsl_chem_elem_find("Xx", &e);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_chem_formula(void)
+{
+	int rc;
+	struct zsl_chem_term co2_terms[] = {
+		{ .elem = ZSL_CHEM_ELEM_CARBON, .count = 1 },
+		{ .elem = ZSL_CHEM_ELEM_OXYGEN, .count = 2 },
+	};
+	struct zsl_chem_formula co2 = {
+		.sz = 2,
+		.terms = co2_terms,
+	};
+	struct zsl_chem_term bad_terms[] = {
+		{ .elem = ZSL_CHEM_ELEM_AMERICIUM, .count = 1 },
+	};
+	struct zsl_chem_formula bad = {
+		.sz = 1,
+		.terms = bad_terms,
+	};
+
+	ZSL_CHEM_FORMULA_DEF(f, 4);
+	ZSL_CHEM_FORMULA_DEF(small, 2);
+
+	rc = zsl_chem_formula_init(&co2);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(co2.mm, 44.0095, 1E-4), NULL);
+
+	/* No standard atomic weight. */
+	rc = zsl_chem_formula_init(&bad);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_chem_formula_parse("CO2", &f);
+	zassert_true(rc == 0, NULL);
+	zassert_true(f.sz == 2, NULL);
+	zassert_true(val_is_equal(f.mm, co2.mm, 1E-6), NULL);
+
+	/* Ethanol, with a repeated element. */
+	f.sz = 4;
+	rc = zsl_chem_formula_parse("CH3CH2OH", &f);
+	zassert_true(rc == -ENOMEM, NULL);
+
+	rc = zsl_chem_formula_parse("C2H6O", &f);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(f.mm, 46.0682, 1E-3), NULL);
+
+	rc = zsl_chem_formula_parse("NaCl", &small);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(small.mm, 58.4427, 1E-3), NULL);
+
+	/* Invalid formulas. */
+	small.sz = 2;
+	rc = zsl_chem_formula_parse("co2", &small);
+	zassert_true(rc == -EINVAL, NULL);
+	small.sz = 2;
+	rc = zsl_chem_formula_parse("Qa", &small);
+	zassert_true(rc == -EINVAL, NULL);
+	small.sz = 2;
+	rc = zsl_chem_formula_parse("", &small);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_chem_gas_conc(void)
+{
+	int rc;
+	zsl_real_t a[3] = { 0.0, 400.0, 1000.0 };
+	zsl_real_t b[2];
+	struct zsl_vec ppm = { .sz = 3, .data = a };
+	struct zsl_vec short_vec = { .sz = 2, .data = b };
+
+	ZSL_VECTOR_DEF(mg, 3);
+	ZSL_VECTOR_DEF(mol, 3);
+	ZSL_CHEM_FORMULA_DEF(co2, 2);
+
+	rc = zsl_chem_formula_parse("CO2", &co2);
+	zassert_true(rc == 0, NULL);
+
+	/* 400 ppm of CO2 at 25 C and 1 atm is about 720 mg/m^3, using a molar
+	 * volume of 24.465 L/mol. */
+	rc = zsl_chem_ppm_to_mgm3(&co2, 298.15, 101325.0, &ppm, &mg);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mg.data[0], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mg.data[1], 400.0 * 44.0095 / 24.4654,
+				  1E-2), NULL);
+
+	/* The inverse, in place. */
+	rc = zsl_chem_mgm3_to_ppm(&co2, 298.15, 101325.0, &mg, &mg);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mg.data[1], 400.0, 1E-2), NULL);
+	zassert_true(val_is_equal(mg.data[2], 1000.0, 1E-2), NULL);
+
+	rc = zsl_chem_ppm_to_molar(298.15, 101325.0, &ppm, &mol);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mol.data[2], 1E-3 / 24.4654, 1E-8), NULL);
+
+	/* Invalid conditions and sizes. */
+	rc = zsl_chem_ppm_to_mgm3(&co2, 0.0, 101325.0, &ppm, &mg);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_chem_ppm_to_mgm3(&co2, 298.15, -1.0, &ppm, &mg);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_chem_ppm_to_molar(298.15, 101325.0, &ppm, &short_vec);
+	zassert_true(rc == -EINVAL, NULL);
+}
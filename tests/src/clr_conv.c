@@ -27,6 +27,478 @@ test_conv_spd_xyz(void)
 	zassert_false(xyz.z_invalid, NULL);
 }
 
+void
+test_conv_spd_xyz_compiled(void)
+{
+	int rc;
+	struct zsl_clr_xyz ref, xyz;
+	unsigned int nm[22];
+
+	ZSL_CLR_SPD_XYZ_CONV_DEF(conv, 22);
+	ZSL_VECTOR_DEF(val, 22);
+	ZSL_VECTOR_DEF(gain, 22);
+
+	/* The test spd, plus one sample outside 360..830 nm. */
+	for (size_t i = 0; i < 21; i++) {
+		nm[i] = zsl_clr_test_spd_5983k.comps[i].nm;
+		val.data[i] = zsl_clr_test_spd_5983k.comps[i].value;
+	}
+	nm[21] = 900;
+	val.data[21] = 5.0;
+
+	/* Test 1: Matches zsl_clr_conv_spd_xyz. */
+	rc = zsl_clr_conv_spd_xyz_compile(&conv, nm, NULL, ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_spd_xyz_compiled(&conv, &val, &xyz);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_spd_xyz(&zsl_clr_test_spd_5983k, ZSL_CLR_OBS_2_DEG,
+				  &ref);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-5), NULL);
+	zassert_true(val_is_equal(xyz.xyz_y, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-5), NULL);
+	zassert_true(xyz.observer == ZSL_CLR_OBS_2_DEG, NULL);
+	zassert_false(xyz.x_invalid, NULL);
+
+	/* Test 2: A gain is the same as scaling the values. */
+	for (size_t i = 0; i < 22; i++) {
+		gain.data[i] = 0.5 + 0.05 * i;
+	}
+	rc = zsl_clr_conv_spd_xyz_compile(&conv, nm, &gain,
+					  ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_spd_xyz_compiled(&conv, &val, &ref);
+	zassert_true(rc == 0, NULL);
+	zsl_clr_conv_spd_xyz_compile(&conv, nm, NULL, ZSL_CLR_OBS_2_DEG);
+	for (size_t i = 0; i < 22; i++) {
+		val.data[i] *= gain.data[i];
+	}
+	rc = zsl_clr_conv_spd_xyz_compiled(&conv, &val, &xyz);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-5), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-5), NULL);
+
+	/* Test 3: Invalid sizes and wavelengths. */
+	val.sz = 21;
+	rc = zsl_clr_conv_spd_xyz_compiled(&conv, &val, &xyz);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(xyz.x_invalid, NULL);
+	gain.sz = 21;
+	rc = zsl_clr_conv_spd_xyz_compile(&conv, nm, &gain,
+					  ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == -EINVAL, NULL);
+	for (size_t i = 0; i < 22; i++) {
+		nm[i] = 300;
+	}
+	rc = zsl_clr_conv_spd_xyz_compile(&conv, nm, NULL, ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void
+test_conv_spd_soa_xyz(void)
+{
+	int rc;
+	struct zsl_clr_xyz ref, xyz;
+
+	ZSL_CLR_SPD_SOA_DEF(spd, 21);
+
+	for (size_t i = 0; i < 21; i++) {
+		spd.nm[i] = zsl_clr_test_spd_5983k.comps[i].nm;
+		spd.values.data[i] = 4.0 * zsl_clr_test_spd_5983k.comps[i].value;
+	}
+
+	/* Test 1: Normalisation puts the max value at 1.0. */
+	rc = zsl_clr_norm_spd_soa(&spd);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 21; i++) {
+		zassert_true(val_is_equal(spd.values.data[i],
+					  zsl_clr_test_spd_5983k.comps[i].value /
+					  1.006, 1E-5), NULL);
+	}
+
+	/* Test 2: Matches zsl_clr_conv_spd_xyz. */
+	rc = zsl_clr_conv_spd_soa_xyz(&spd, ZSL_CLR_OBS_2_DEG, &xyz);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_spd_xyz(&zsl_clr_test_spd_5983k, ZSL_CLR_OBS_2_DEG,
+				  &ref);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-5), NULL);
+	zassert_true(val_is_equal(xyz.xyz_y, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-5), NULL);
+	zassert_true(xyz.observer == ZSL_CLR_OBS_2_DEG, NULL);
+	zassert_false(xyz.x_invalid, NULL);
+
+	/* Test 3: All zero values and out of range wavelengths. */
+	zsl_vec_init(&spd.values);
+	rc = zsl_clr_norm_spd_soa(&spd);
+	zassert_true(rc == -EINVAL, NULL);
+	for (size_t i = 0; i < 21; i++) {
+		spd.nm[i] = 900;
+		spd.values.data[i] = 1.0;
+	}
+	rc = zsl_clr_conv_spd_soa_xyz(&spd, ZSL_CLR_OBS_2_DEG, &xyz);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(xyz.x_invalid, NULL);
+}
+
+void
+test_clr_lef_integ(void)
+{
+	int rc;
+	zsl_real_t v, ref, integ;
+	unsigned int nm[401];
+
+	ZSL_CLR_LEF_WEIGHTS_DEF(lw, 401);
+	ZSL_VECTOR_DEF(val, 401);
+
+	/* A 1 nm grid from 380 to 780 nm. */
+	for (size_t i = 0; i < 401; i++) {
+		nm[i] = 380 + i;
+		val.data[i] = 0.5 + 0.001 * i;
+	}
+
+	/* Test 1: Matches a trapezoidal sum of zsl_clr_lef_lerp values. */
+	rc = zsl_clr_lef_weights_compile(&lw, ZSL_CLR_LEF_CIE88_PHOTOPIC, nm);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_lef_integ(&lw, &val, &integ);
+	zassert_true(rc == 0, NULL);
+	ref = 0.0;
+	for (size_t i = 0; i < 401; i++) {
+		zsl_clr_lef_lerp(ZSL_CLR_LEF_CIE88_PHOTOPIC, nm[i], &v);
+		ref += v * val.data[i] * ((i == 0 || i == 400) ? 0.5 : 1.0);
+	}
+	zassert_true(val_is_equal(integ, ref, 1E-4), NULL);
+
+	/* Test 2: The weights are kept for the same wavelengths. */
+	lw.w.data[0] = 42.0;
+	rc = zsl_clr_lef_weights_compile(&lw, ZSL_CLR_LEF_CIE88_PHOTOPIC, nm);
+	zassert_true(rc == 0, NULL);
+	zassert_true(lw.w.data[0] == 42.0, NULL);
+	rc = zsl_clr_lef_weights_compile(&lw, ZSL_CLR_LEF_CIE51_SCOTOPIC, nm);
+	zassert_true(rc == 0, NULL);
+	zsl_clr_lef_lerp(ZSL_CLR_LEF_CIE51_SCOTOPIC, 380, &v);
+	zassert_true(val_is_equal(lw.w.data[0], v * 0.5, 1E-9), NULL);
+
+	/* Test 3: Wavelengths outside the table get no weight. */
+	nm[0] = 300;
+	rc = zsl_clr_lef_weights_compile(&lw, ZSL_CLR_LEF_CIE88_PHOTOPIC, nm);
+	zassert_true(rc == 0, NULL);
+	zassert_true(lw.w.data[0] == 0.0, NULL);
+
+	/* Test 4: Invalid wavelengths and sizes. */
+	nm[10] = nm[9];
+	rc = zsl_clr_lef_weights_compile(&lw, ZSL_CLR_LEF_CIE88_PHOTOPIC, nm);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_clr_lef_integ(&lw, &val, &integ);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void
+test_clr_data_get(void)
+{
+	int rc;
+	const struct zsl_clr_illum_data *illum;
+	const struct zsl_clr_obs_data *obs;
+
+	/* Every illuminant is found directly, with matching metadata. */
+	for (int i = ZSL_CLR_ILLUM_A; i <= ZSL_CLR_ILLUM_ICC; i++) {
+		rc = zsl_clr_illum_get(ZSL_CLR_OBS_2_DEG, i, &illum);
+		zassert_true(rc == 0, NULL);
+		zassert_true(illum->illuminant == i, NULL);
+		zassert_true(illum->observer == ZSL_CLR_OBS_2_DEG, NULL);
+		zassert_true(val_is_equal(illum->data.xyz_y, 1.0, 1E-6), NULL);
+	}
+
+	rc = zsl_clr_illum_get(ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_D65, &illum);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(illum->data.xyz_x, 0.95047, 1E-6), NULL);
+	zassert_true(val_is_equal(illum->data.xyz_z, 1.08883, 1E-6), NULL);
+
+	/* No 10 degree illuminant data, or unknown illuminants. */
+	rc = zsl_clr_illum_get(ZSL_CLR_OBS_10_DEG, ZSL_CLR_ILLUM_D65, &illum);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_clr_illum_get(ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_ICC + 1,
+			       &illum);
+	zassert_true(rc == -EINVAL, NULL);
+
+	zsl_clr_obs_get(ZSL_CLR_OBS_2_DEG, &obs);
+	zassert_true(obs != NULL, NULL);
+	zassert_true(obs->observer == ZSL_CLR_OBS_2_DEG, NULL);
+
+	zsl_clr_obs_get(ZSL_CLR_OBS_10_DEG, &obs);
+#if CONFIG_ZSL_CLR_OBS_10_DEG
+	zassert_true(obs != NULL, NULL);
+	zassert_true(obs->observer == ZSL_CLR_OBS_10_DEG, NULL);
+#else
+	zassert_true(obs == NULL, NULL);
+#endif
+}
+
+void
+test_conv_xyz_cat(void)
+{
+	int rc;
+	struct zsl_clr_xyz xyz[2], out[2];
+	const struct zsl_clr_illum_data *d50, *d65;
+	const zsl_real_t bradford_d65_d50[9] = {
+		1.0478112, 0.0228866, -0.0501270,
+		0.0295424, 0.9904844, -0.0170491,
+		-0.0092345, 0.0150436, 0.7521316
+	};
+
+	ZSL_CLR_CAT_DEF(cat);
+	ZSL_CLR_CAT_DEF(inv);
+
+	zsl_clr_illum_get(ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_D50, &d50);
+	zsl_clr_illum_get(ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_D65, &d65);
+
+	/* Not compiled yet. */
+	rc = zsl_clr_conv_xyz_cat(&cat, xyz, out, 2);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Test 1: Bradford D65 to D50 matches the published matrix. */
+	rc = zsl_clr_conv_cat_compile(&cat, ZSL_CLR_CAT_METHOD_BRADFORD,
+				      ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_D65,
+				      ZSL_CLR_ILLUM_D50);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(cat.m.data[i], bradford_d65_d50[i],
+					  1E-5), NULL);
+	}
+
+	/* Test 2: Both methods map the source white to the destination white,
+	 * and the reverse transform undoes the forward one. */
+	for (int method = ZSL_CLR_CAT_METHOD_BRADFORD;
+	     method <= ZSL_CLR_CAT_METHOD_CAT02; method++) {
+		rc = zsl_clr_conv_cat_compile(&cat, method, ZSL_CLR_OBS_2_DEG,
+					      ZSL_CLR_ILLUM_D65,
+					      ZSL_CLR_ILLUM_D50);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_clr_conv_cat_compile(&inv, method, ZSL_CLR_OBS_2_DEG,
+					      ZSL_CLR_ILLUM_D50,
+					      ZSL_CLR_ILLUM_D65);
+		zassert_true(rc == 0, NULL);
+
+		memset(xyz, 0, sizeof xyz);
+		xyz[0].xyz_x = d65->data.xyz_x;
+		xyz[0].xyz_y = d65->data.xyz_y;
+		xyz[0].xyz_z = d65->data.xyz_z;
+		xyz[1].xyz_x = 0.5;
+		xyz[1].xyz_y = 0.4;
+		xyz[1].xyz_z = 0.3;
+		xyz[1].z_invalid = 1;
+
+		rc = zsl_clr_conv_xyz_cat(&cat, xyz, out, 2);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(out[0].xyz_x, d50->data.xyz_x, 1E-5),
+			     NULL);
+		zassert_true(val_is_equal(out[0].xyz_y, d50->data.xyz_y, 1E-5),
+			     NULL);
+		zassert_true(val_is_equal(out[0].xyz_z, d50->data.xyz_z, 1E-5),
+			     NULL);
+		zassert_true(out[0].illuminant == ZSL_CLR_ILLUM_D50, NULL);
+		zassert_true(out[1].z_invalid, NULL);
+
+		/* In place. */
+		rc = zsl_clr_conv_xyz_cat(&inv, out, out, 2);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(out[1].xyz_x, 0.5, 1E-5), NULL);
+		zassert_true(val_is_equal(out[1].xyz_y, 0.4, 1E-5), NULL);
+		zassert_true(val_is_equal(out[1].xyz_z, 0.3, 1E-5), NULL);
+		zassert_true(out[1].illuminant == ZSL_CLR_ILLUM_D65, NULL);
+	}
+
+	/* Test 3: A matching transform is kept rather than recomputed. */
+	cat.m.data[0] = 2.0;
+	rc = zsl_clr_conv_cat_compile(&cat, ZSL_CLR_CAT_METHOD_CAT02,
+				      ZSL_CLR_OBS_2_DEG, ZSL_CLR_ILLUM_D65,
+				      ZSL_CLR_ILLUM_D50);
+	zassert_true(rc == 0, NULL);
+	zassert_true(cat.m.data[0] == 2.0, NULL);
+
+	/* Test 4: Missing illuminant data. */
+	rc = zsl_clr_conv_cat_compile(&cat, ZSL_CLR_CAT_METHOD_BRADFORD,
+				      ZSL_CLR_OBS_10_DEG, ZSL_CLR_ILLUM_D65,
+				      ZSL_CLR_ILLUM_D50);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_false(cat.valid, NULL);
+}
+
+void
+test_clr_cct_pipe(void)
+{
+	int rc;
+	unsigned int nm[21];
+	struct zsl_clr_xyz xyz;
+	struct zsl_clr_uv60 uv;
+	struct zsl_clr_cct ref, cct;
+	struct zsl_measurement mes;
+	zsl_real_t *payload;
+
+	ZSL_CLR_CCT_PIPE_DEF(pipe, 21);
+	ZSL_VECTOR_DEF(counts, 21);
+	ZSL_VECTOR_DEF(gain, 21);
+
+	/* Sensor counts which give the test spd once calibrated. */
+	for (size_t i = 0; i < 21; i++) {
+		nm[i] = zsl_clr_test_spd_5983k.comps[i].nm;
+		gain.data[i] = 0.5 + 0.1 * i;
+		counts.data[i] = 1000.0 * zsl_clr_test_spd_5983k.comps[i].value /
+				 gain.data[i];
+	}
+
+	/* The sequential conversion. */
+	memset(&uv, 0, sizeof uv);
+	rc = zsl_clr_conv_spd_xyz(&zsl_clr_test_spd_5983k, ZSL_CLR_OBS_2_DEG,
+				  &xyz);
+	zassert_true(rc == 0, NULL);
+	zsl_clr_conv_xyz_uv60(&xyz, &uv);
+
+	for (int method = ZSL_CLR_UV_CCT_METHOD_MCCAMY;
+	     method <= ZSL_CLR_UV_CCT_METHOD_OHNO2014_CASCADE; method++) {
+		memset(&ref, 0, sizeof ref);
+		memset(&cct, 0, sizeof cct);
+		rc = zsl_clr_conv_uv60_cct(method, &uv, &ref);
+		zassert_true(rc == 0, NULL);
+
+		rc = zsl_clr_cct_pipe_compile(&pipe, nm, &gain,
+					      ZSL_CLR_OBS_2_DEG, method);
+		zassert_true(rc == 0, NULL);
+
+		/* Repeated samples reuse the table hint. */
+		for (int j = 0; j < 3; j++) {
+			rc = zsl_clr_cct_pipe_run(&pipe, &counts, &cct);
+			zassert_true(rc == 0, NULL);
+			zassert_true(val_is_equal(cct.cct, ref.cct, 1E-2), NULL);
+			zassert_true(val_is_equal(cct.duv, ref.duv, 1E-5), NULL);
+			zassert_false(cct.cct_invalid, NULL);
+		}
+	}
+
+	/* Measurement output. */
+	rc = zsl_clr_cct_pipe_mes(&pipe, &counts, &mes);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mes.header.filter.base_type == ZSL_MES_TYPE_COLOR, NULL);
+	zassert_true(mes.header.filter.ext_type ==
+		     ZSL_MES_EXT_TYPE_COLOR_CIE1960_CCT_DUV, NULL);
+	zassert_true(mes.header.unit.si_unit == ZSL_MES_UNIT_SI_KELVIN, NULL);
+	zassert_true(mes.header.srclen.len == 2 * sizeof(zsl_real_t), NULL);
+	payload = mes.payload;
+	zassert_true(val_is_equal(payload[0], ref.cct, 1E-2), NULL);
+	zassert_true(val_is_equal(payload[1], ref.duv, 1E-5), NULL);
+
+	/* A dark sample fails without touching the measurement. */
+	zsl_vec_init(&counts);
+	mes.payload = NULL;
+	rc = zsl_clr_cct_pipe_mes(&pipe, &counts, &mes);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(mes.payload == NULL, NULL);
+	rc = zsl_clr_cct_pipe_run(&pipe, &counts, &cct);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(cct.cct_invalid, NULL);
+}
+
+void
+test_clr_ccm_fit(void)
+{
+	int rc;
+	zsl_real_t rms;
+	struct zsl_clr_ccm_fit fit;
+	struct zsl_clr_rgbf rgb[24];
+	struct zsl_clr_xyz xyz[24];
+	struct zsl_clr_rgb8 rgb8;
+	const struct zsl_mtx *srgb;
+
+	/* A sensor whose channels are linear sRGB, so the fit should give
+	 * the sRGB to XYZ matrix. */
+	zsl_real_t sd[9] = { 0.4124564, 0.3575761, 0.1804375,
+			     0.2126729, 0.7151522, 0.0721750,
+			     0.0193339, 0.1191920, 0.9503041 };
+
+	ZSL_MATRIX_DEF(ccm, 3, 3);
+
+	memset(rgb, 0, sizeof rgb);
+	memset(xyz, 0, sizeof xyz);
+	for (size_t i = 0; i < 24; i++) {
+		rgb[i].r = (zsl_real_t)((i * 7) % 24) / 23.0;
+		rgb[i].g = (zsl_real_t)((i * 11) % 24) / 23.0;
+		rgb[i].b = (zsl_real_t)((i * 5 + 3) % 24) / 23.0;
+		xyz[i].xyz_x = sd[0] * rgb[i].r + sd[1] * rgb[i].g +
+			       sd[2] * rgb[i].b;
+		xyz[i].xyz_y = sd[3] * rgb[i].r + sd[4] * rgb[i].g +
+			       sd[5] * rgb[i].b;
+		xyz[i].xyz_z = sd[6] * rgb[i].r + sd[7] * rgb[i].g +
+			       sd[8] * rgb[i].b;
+	}
+
+	rc = zsl_clr_ccm_fit_init(&fit);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_ccm_fit_feed_arr(&fit, rgb, xyz, 24);
+	zassert_true(rc == 0, NULL);
+	zassert_true(fit.n == 24, NULL);
+	rc = zsl_clr_ccm_fit_solve(&fit, NULL, &ccm, &rms);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(ccm.data[i], sd[i], 1E-5), NULL);
+	}
+	zassert_true(val_is_equal(rms, 0.0, 1E-3), NULL);
+
+	/* Followed by the XYZ to sRGB matrix, the product is the identity,
+	 * and converts sensor readings straight to sRGB. */
+	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb);
+	rc = zsl_clr_ccm_fit_solve(&fit, srgb, &ccm, NULL);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zassert_true(val_is_equal(ccm.data[i * 3 + j],
+						  (i == j) ? 1.0 : 0.0, 1E-4),
+				     NULL);
+		}
+	}
+	xyz[0].xyz_x = 1.0;
+	xyz[0].xyz_y = 0.5;
+	xyz[0].xyz_z = 0.0;
+	rc = zsl_clr_conv_xyz_rgb8(&xyz[0], &ccm, &rgb8);
+	zassert_true(rc == 0, NULL);
+	zassert_true(rgb8.r >= 254, NULL);
+	zassert_true((rgb8.g >= 126) && (rgb8.g <= 128), NULL);
+	zassert_true(rgb8.b <= 1, NULL);
+
+	/* A noisy patch gives a residual error, which a low weight limits. */
+	xyz[0].xyz_x = 0.5;
+	xyz[0].xyz_y = 0.5;
+	xyz[0].xyz_z = 0.5;
+	rgb[0].r = 0.2;
+	rgb[0].g = 0.9;
+	rgb[0].b = 0.1;
+	rc = zsl_clr_ccm_fit_feed(&fit, &rgb[0], &xyz[0], 0.01);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_ccm_fit_solve(&fit, NULL, &ccm, &rms);
+	zassert_true(rc == 0, NULL);
+	zassert_true(rms > 0.0, NULL);
+	zassert_true(rms < 0.01, NULL);
+	zassert_true(val_is_equal(ccm.data[0], sd[0], 1E-2), NULL);
+
+	/* Invalid input. */
+	rc = zsl_clr_ccm_fit_feed(&fit, &rgb[0], &xyz[0], -1.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rgb[1].g_invalid = 1;
+	rc = zsl_clr_ccm_fit_feed_arr(&fit, rgb, xyz, 24);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(fit.n == 25, NULL);
+
+	/* Without any blue response, the fit is underdetermined. */
+	zsl_clr_ccm_fit_init(&fit);
+	rc = zsl_clr_ccm_fit_solve(&fit, NULL, &ccm, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+	rgb[0].b = 0.0;
+	zsl_clr_ccm_fit_feed(&fit, &rgb[0], &xyz[0], 1.0);
+	rgb[0].r = 0.7;
+	zsl_clr_ccm_fit_feed(&fit, &rgb[0], &xyz[0], 1.0);
+	rc = zsl_clr_ccm_fit_solve(&fit, NULL, &ccm, NULL);
+	zassert_true(rc == -ENOTPOSDEF, NULL);
+}
+
 void
 test_conv_ct_xyz(void)
 {
@@ -46,12 +518,70 @@ test_conv_ct_xyz(void)
 	zassert_false(xyz.z_invalid, NULL);
 }
 
+void
+test_conv_ct_xyz_lut(void)
+{
+	int rc;
+	zsl_real_t err, max_err;
+	struct zsl_clr_xyz ref, xyz;
+
+	ZSL_CLR_CT_LUT_DEF(lut, 128);
+	ZSL_CLR_CT_LUT_DEF(small, 1);
+
+	/* Test 1: An uncompiled or undersized table is rejected. */
+	rc = zsl_clr_conv_ct_xyz_lut(&lut, 5600.0, false, &xyz);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(xyz.x_invalid, NULL);
+	rc = zsl_clr_ct_lut_compile(&small, ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_clr_ct_lut_compile(&lut, ZSL_CLR_OBS_2_DEG);
+	zassert_true(rc == 0, NULL);
+	zassert_true(lut.valid, NULL);
+
+	/* Test 2: The table ends match the exact values. */
+	zsl_clr_conv_ct_xyz(ZSL_CLR_CT_LUT_MIN, ZSL_CLR_OBS_2_DEG, &ref);
+	zsl_clr_conv_ct_xyz_lut(&lut, ZSL_CLR_CT_LUT_MIN, false, &xyz);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-6), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-6), NULL);
+	zsl_clr_conv_ct_xyz(ZSL_CLR_CT_LUT_MAX, ZSL_CLR_OBS_2_DEG, &ref);
+	zsl_clr_conv_ct_xyz_lut(&lut, ZSL_CLR_CT_LUT_MAX, false, &xyz);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-6), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-6), NULL);
+
+	/* Test 3: Interpolated values stay close across the range. */
+	max_err = 0.0;
+	for (zsl_real_t ct = 1000.0; ct <= 25000.0; ct += 37.0) {
+		zsl_clr_conv_ct_xyz(ct, ZSL_CLR_OBS_2_DEG, &ref);
+		rc = zsl_clr_conv_ct_xyz_lut(&lut, ct, false, &xyz);
+		zassert_true(rc == 0, NULL);
+		zassert_true(xyz.xyz_y == 1.0, NULL);
+		zassert_true(xyz.observer == ZSL_CLR_OBS_2_DEG, NULL);
+		err = ZSL_ABS(xyz.xyz_x - ref.xyz_x) / ref.xyz_x;
+		max_err = err > max_err ? err : max_err;
+		err = ZSL_ABS(xyz.xyz_z - ref.xyz_z) / (ref.xyz_z + 1E-3);
+		max_err = err > max_err ? err : max_err;
+	}
+	zassert_true(max_err < 1E-3, NULL);
+
+	/* Test 4: Exact and out of range values use Planck's law. */
+	rc = zsl_clr_conv_ct_xyz_lut(&lut, 5600.0, true, &xyz);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(xyz.xyz_x, 0.9738203, 1E-6), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, 0.9751908, 1E-6), NULL);
+	zsl_clr_conv_ct_xyz(40000.0, ZSL_CLR_OBS_2_DEG, &ref);
+	rc = zsl_clr_conv_ct_xyz_lut(&lut, 40000.0, false, &xyz);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(xyz.xyz_x, ref.xyz_x, 1E-6), NULL);
+	zassert_true(val_is_equal(xyz.xyz_z, ref.xyz_z, 1E-6), NULL);
+}
+
 void
 test_conv_ct_rgb8(void)
 {
 	int rc;
 	struct zsl_clr_rgb8 rgb;
-	struct zsl_mtx *srgb_ccm;
+	const struct zsl_mtx *srgb_ccm;
 
 	/* Get sRGB D65 correlation matrix for testing. */
 	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb_ccm);
@@ -70,6 +600,218 @@ test_conv_ct_rgb8(void)
 	zassert_false(rgb.a_invalid, NULL);
 }
 
+void
+test_conv_xyz_rgb_arr(void)
+{
+	int rc;
+	struct zsl_clr_xyz xyz[8];
+	struct zsl_clr_rgbf rgbf[8], reff;
+	struct zsl_clr_rgb8 rgb8[8], ref8;
+	uint8_t rgb888[8 * 3];
+	uint8_t lut[5] = { 0, 10, 20, 30, 40 };
+	const struct zsl_mtx *srgb_ccm;
+	ZSL_MATRIX_DEF(xyz_p, 3, 8);
+	ZSL_MATRIX_DEF(rgb_p, 3, 8);
+	ZSL_MATRIX_DEF(bad, 3, 2);
+
+	zsl_clr_rgbccm_get(ZSL_CLR_RGB_CCM_SRGB_D65, &srgb_ccm);
+
+	/* A spread of in and out of gamut values, including negative RGB. */
+	memset(xyz, 0, sizeof xyz);
+	for (size_t i = 0; i < 8; i++) {
+		rc = zsl_clr_conv_ct_xyz(1500.0 + 1500.0 * i, ZSL_CLR_OBS_2_DEG,
+					 &xyz[i]);
+		zassert_true(rc == 0, NULL);
+		xyz[i].xyz_x *= 0.2 + 0.15 * i;
+		xyz[i].xyz_y *= 0.2 + 0.15 * i;
+		xyz[i].xyz_z *= 0.2 + 0.15 * i;
+		xyz_p.data[i] = xyz[i].xyz_x;
+		xyz_p.data[8 + i] = xyz[i].xyz_y;
+		xyz_p.data[16 + i] = xyz[i].xyz_z;
+	}
+
+	rc = zsl_clr_conv_xyz_rgbf_arr(xyz, srgb_ccm, rgbf, 8);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_xyz_rgb8_arr(xyz, srgb_ccm, rgb8, 8, NULL, 0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_xyz_rgbf_planar(srgb_ccm, &xyz_p, &rgb_p);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_clr_conv_xyz_rgb888(srgb_ccm, &xyz_p, rgb888, NULL, 0);
+	zassert_true(rc == 0, NULL);
+
+	/* Compare against the single value conversions. */
+	for (size_t i = 0; i < 8; i++) {
+		rc = zsl_clr_conv_xyz_rgbf(&xyz[i], srgb_ccm, &reff);
+		zassert_true(rc == 0, NULL);
+		memset(&ref8, 0, sizeof ref8);
+		rc = zsl_clr_conv_xyz_rgb8(&xyz[i], srgb_ccm, &ref8);
+		zassert_true(rc == 0, NULL);
+
+		zassert_true(val_is_equal(rgbf[i].r, reff.r, 1E-6), NULL);
+		zassert_true(val_is_equal(rgbf[i].g, reff.g, 1E-6), NULL);
+		zassert_true(val_is_equal(rgbf[i].b, reff.b, 1E-6), NULL);
+		zassert_true(rgbf[i].a == reff.a, NULL);
+		zassert_true(rgbf[i].r_invalid == reff.r_invalid, NULL);
+		zassert_true(rgbf[i].g_invalid == reff.g_invalid, NULL);
+		zassert_true(rgbf[i].b_invalid == reff.b_invalid, NULL);
+		zassert_false(rgbf[i].a_invalid, NULL);
+
+		zassert_true(rgb8[i].r == ref8.r, NULL);
+		zassert_true(rgb8[i].g == ref8.g, NULL);
+		zassert_true(rgb8[i].b == ref8.b, NULL);
+		zassert_true(rgb8[i].a == 0xFF, NULL);
+		zassert_true(rgb8[i].r_invalid == ref8.r_invalid, NULL);
+		zassert_true(rgb8[i].g_invalid == ref8.g_invalid, NULL);
+		zassert_true(rgb8[i].b_invalid == ref8.b_invalid, NULL);
+
+		zassert_true(val_is_equal(rgb_p.data[i], reff.r, 1E-6), NULL);
+		zassert_true(val_is_equal(rgb_p.data[8 + i], reff.g, 1E-6),
+			     NULL);
+		zassert_true(val_is_equal(rgb_p.data[16 + i], reff.b, 1E-6),
+			     NULL);
+
+		zassert_true(rgb888[3 * i] == ref8.r, NULL);
+		zassert_true(rgb888[3 * i + 1] == ref8.g, NULL);
+		zassert_true(rgb888[3 * i + 2] == ref8.b, NULL);
+	}
+
+	/* Lookup table output rounds to the nearest entry. */
+	rc = zsl_clr_conv_xyz_rgb888(srgb_ccm, &xyz_p, rgb888, lut, 5);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		zsl_real_t r = rgb_p.data[i];
+
+		r = (r < 0.0) ? 0.0 : ((r > 1.0) ? 1.0 : r);
+		zassert_true(rgb888[3 * i] == lut[(size_t)(r * 4.0 + 0.5)],
+			     NULL);
+	}
+
+	/* Invalid sizes. */
+	rc = zsl_clr_conv_xyz_rgbf_arr(xyz, &bad, rgbf, 8);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_clr_conv_xyz_rgb8_arr(xyz, srgb_ccm, rgb8, 8, lut, 1);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_clr_conv_xyz_rgbf_planar(srgb_ccm, &xyz_p, &bad);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void
+test_conv_srgb(void)
+{
+	int rc;
+	const uint8_t *enc;
+	const zsl_real_t *dec;
+	struct zsl_clr_rgbf lin[3], srgbf[3], back[3];
+	struct zsl_clr_rgb8 exact[3], fast[3];
+
+	memset(lin, 0, sizeof lin);
+	lin[0].r = 0.0;
+	lin[0].g = 0.002;
+	lin[0].b = 0.5;
+	lin[0].a = 1.0;
+	lin[1].r = 1.0;
+	lin[1].g = -0.25;	/* Out of gamut, limited to 0.0. */
+	lin[1].b = 1.5;		/* Out of gamut, limited to 1.0. */
+	lin[1].a = 0.5;
+	lin[1].g_invalid = 1;
+	lin[1].b_invalid = 1;
+	lin[2].r = 0.18;
+	lin[2].g = 0.0031308;
+	lin[2].b = 0.9;
+	lin[2].a = 0.0;
+
+	/* Exact floating point encode and decode. */
+	rc = zsl_clr_conv_rgbf_srgbf(lin, srgbf, 3);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(srgbf[0].r, 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(srgbf[0].g, 0.02584, 1E-5), NULL);
+	zassert_true(val_is_equal(srgbf[0].b, 0.7353570, 1E-5), NULL);
+	zassert_true(val_is_equal(srgbf[1].r, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(srgbf[1].g, 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(srgbf[1].b, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(srgbf[2].r, 0.4613561, 1E-5), NULL);
+	zassert_true(val_is_equal(srgbf[2].g, 0.0404499, 1E-5), NULL);
+	zassert_true(srgbf[1].a == 0.5, NULL);
+	zassert_true(srgbf[1].g_invalid, NULL);
+	zassert_true(srgbf[1].b_invalid, NULL);
+	zassert_false(srgbf[1].r_invalid, NULL);
+
+	rc = zsl_clr_conv_srgbf_rgbf(srgbf, back, 3);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(back[0].g, 0.002, 1E-5), NULL);
+	zassert_true(val_is_equal(back[0].b, 0.5, 1E-5), NULL);
+	zassert_true(val_is_equal(back[2].r, 0.18, 1E-5), NULL);
+	zassert_true(val_is_equal(back[2].b, 0.9, 1E-5), NULL);
+
+	/* 8-bit encode, and the lookup tables when they are available. */
+	rc = zsl_clr_conv_rgbf_srgb8(lin, exact, 3, false);
+	zassert_true(rc == 0, NULL);
+	zassert_true(exact[0].r == 0, NULL);
+	zassert_true(exact[0].g == 7, NULL);
+	zassert_true(exact[0].b == 188, NULL);
+	zassert_true(exact[1].r == 255, NULL);
+	zassert_true(exact[1].g == 0, NULL);
+	zassert_true(exact[1].b == 255, NULL);
+	zassert_true(exact[1].a == 128, NULL);
+	zassert_true(exact[1].g_invalid, NULL);
+	zassert_true(exact[2].r == 118, NULL);
+	zassert_true(exact[2].a == 0, NULL);
+
+	rc = zsl_clr_conv_rgbf_srgb8(lin, fast, 3, true);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(fast[i].r, exact[i].r, 1.5), NULL);
+		zassert_true(val_is_equal(fast[i].g, exact[i].g, 1.5), NULL);
+		zassert_true(val_is_equal(fast[i].b, exact[i].b, 1.5), NULL);
+		zassert_true(fast[i].a == exact[i].a, NULL);
+	}
+
+	rc = zsl_clr_srgb_lut_get(&enc, &dec);
+	if (rc == 0) {
+		zassert_true(enc[0] == 0, NULL);
+		zassert_true(enc[ZSL_CLR_SRGB_ENC_LUT_SZ - 1] == 255, NULL);
+		zassert_true(dec[0] == 0.0, NULL);
+		zassert_true(val_is_equal(dec[ZSL_CLR_SRGB_DEC_LUT_SZ - 1],
+					  1.0, 1E-6), NULL);
+
+		/* Every step of the encoding table is within one of exact. */
+		for (size_t i = 0; i < ZSL_CLR_SRGB_ENC_LUT_SZ; i++) {
+			lin[0].r = (zsl_real_t)i / 4095.0;
+			rc = zsl_clr_conv_rgbf_srgb8(lin, exact, 1, false);
+			zassert_true(rc == 0, NULL);
+			zassert_true(val_is_equal(enc[i], exact[0].r, 1.5),
+				     NULL);
+		}
+	} else {
+		zassert_true(rc == -ENOTSUP, NULL);
+		zassert_true(enc == NULL, NULL);
+		zassert_true(dec == NULL, NULL);
+	}
+
+	/* 8-bit decode matches with and without the table, and re-encodes
+	 * to the same value. */
+	for (unsigned int i = 0; i < 256; i++) {
+		exact[0].r = (uint8_t)i;
+		exact[0].g = (uint8_t)(255 - i);
+		exact[0].b = (uint8_t)(i / 2);
+		exact[0].a = 0xFF;
+		rc = zsl_clr_conv_srgb8_rgbf(exact, &back[0], 1, false);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_clr_conv_srgb8_rgbf(exact, &back[1], 1, true);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(back[0].r, back[1].r, 1E-6), NULL);
+		zassert_true(val_is_equal(back[0].g, back[1].g, 1E-6), NULL);
+		zassert_true(val_is_equal(back[0].b, back[1].b, 1E-6), NULL);
+		zassert_true(back[0].a == 1.0, NULL);
+
+		rc = zsl_clr_conv_rgbf_srgb8(&back[0], fast, 1, false);
+		zassert_true(rc == 0, NULL);
+		zassert_true(fast[0].r == exact[0].r, NULL);
+		zassert_true(fast[0].g == exact[0].g, NULL);
+		zassert_true(fast[0].b == exact[0].b, NULL);
+	}
+}
+
 void
 test_conv_cct_xyy(void)
 {
@@ -258,3 +1000,56 @@ test_conv_uv60_cct_ohno2014(void)
 
 	/* TODO: Add further tests! */
 }
+
+void
+test_conv_uv60_cct_ohno2014_fast(void)
+{
+	int rc, rc2, rc3;
+	size_t hint = 0;
+	zsl_real_t ct;
+	struct zsl_clr_uv60 uv;
+	struct zsl_clr_cct ref, fast, hinted;
+
+	/* Sweep along the locus, either side of it, and compare the cascade
+	 * and hinted searches against the full table search. */
+	for (ct = 1200.0; ct < 15000.0; ct *= 1.03) {
+		for (int k = -1; k <= 1; k++) {
+			memset(&uv, 0, sizeof uv);
+			rc = zsl_clr_conv_ct_uv60(ct, ZSL_CLR_OBS_2_DEG, &uv);
+			zassert_true(rc == 0, NULL);
+			uv.uv60_v += 0.004 * k;
+
+			rc = zsl_clr_conv_uv60_cct(
+				ZSL_CLR_UV_CCT_METHOD_OHNO2014, &uv, &ref);
+			rc2 = zsl_clr_conv_uv60_cct(
+				ZSL_CLR_UV_CCT_METHOD_OHNO2014_CASCADE, &uv,
+				&fast);
+			rc3 = zsl_clr_conv_uv60_cct_ohno2014_hint(&uv, &hinted,
+								  &hint);
+			zassert_true(rc == 0, NULL);
+			zassert_true(rc2 == 0, NULL);
+			zassert_true(rc3 == 0, NULL);
+			zassert_true(val_is_equal(fast.cct, ref.cct, 1E-3),
+				     NULL);
+			zassert_true(val_is_equal(fast.duv, ref.duv, 1E-6),
+				     NULL);
+			zassert_true(val_is_equal(hinted.cct, ref.cct, 1E-3),
+				     NULL);
+			zassert_true(val_is_equal(hinted.duv, ref.duv, 1E-6),
+				     NULL);
+		}
+	}
+
+	/* A stale hint far from the new reading still converges. */
+	uv.uv60_u = 0.25309737;
+	uv.uv60_v = 0.34765305;
+	rc = zsl_clr_conv_uv60_cct_ohno2014_hint(&uv, &hinted, &hint);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(hinted.cct, 2938.0, 10.0), NULL);
+
+	/* Invalid input. */
+	uv.u_invalid = 1;
+	rc = zsl_clr_conv_uv60_cct_ohno2014_hint(&uv, &hinted, &hint);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(hinted.cct_invalid, NULL);
+}
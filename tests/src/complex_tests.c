@@ -6,7 +6,10 @@
 
 #include <complex.h>    /* C99 complex number support. */
 #include <ztest.h>
+#include <errno.h>
+#include <math.h>
 #include <zsl/zsl.h>
+#include <zsl/complex.h>
 #include "floatcheck.h"
 
 /**
@@ -35,3 +38,182 @@ void test_complex_add(void)
         zassert_true(val_is_equal(creal(c), creal(a) + creal(b), 1E-5), NULL);
         zassert_true(val_is_equal(cimag(c), cimag(a) + cimag(b), 1E-5), NULL);
 }
+
+void test_cplx_scalar(void)
+{
+	struct zsl_cplx a = { 3.0, 4.0 };
+	struct zsl_cplx b = { 1.0, -2.0 };
+	struct zsl_cplx c;
+
+	c = zsl_cplx_mul(a, b);
+	zassert_true(val_is_equal(c.re, 11.0, 1E-5), NULL);
+	zassert_true(val_is_equal(c.im, -2.0, 1E-5), NULL);
+
+	/* (a * b) / b = a */
+	c = zsl_cplx_div(c, b);
+	zassert_true(val_is_equal(c.re, 3.0, 1E-5), NULL);
+	zassert_true(val_is_equal(c.im, 4.0, 1E-5), NULL);
+
+	zassert_true(val_is_equal(zsl_cplx_abs(a), 5.0, 1E-5), NULL);
+	zassert_true(val_is_equal(zsl_cplx_abs2(a), 25.0, 1E-5), NULL);
+	zassert_true(val_is_equal(zsl_cplx_arg(b), ZSL_ATAN2(-2.0, 1.0), 1E-5),
+		     NULL);
+
+	/* sqrt(-3 - 4i) = 1 - 2i */
+	c = zsl_cplx_sqrt((struct zsl_cplx){ -3.0, -4.0 });
+	zassert_true(val_is_equal(c.re, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(c.im, -2.0, 1E-5), NULL);
+
+	/* e^(i * pi) = -1 */
+	c = zsl_cplx_exp((struct zsl_cplx){ 0.0, ZSL_PI });
+	zassert_true(val_is_equal(c.re, -1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(c.im, 0.0, 1E-5), NULL);
+
+	c = zsl_cplx_div(a, (struct zsl_cplx){ 0.0, 0.0 });
+	zassert_true(isnan(c.re) && isnan(c.im), NULL);
+}
+
+void test_cvec_ops(void)
+{
+	int rc;
+	struct zsl_cplx d;
+
+	ZSL_CVEC_DEF(v, 3);
+	ZSL_CVEC_DEF(w, 3);
+	ZSL_CVEC_DEF(x, 3);
+	ZSL_CVEC_DEF(y, 2);
+	ZSL_VECTOR_DEF(mag, 3);
+
+	zsl_cvec_init(&v);
+	zsl_cvec_set(&v, 0, (struct zsl_cplx){ 1.0, 1.0 });
+	zsl_cvec_set(&v, 1, (struct zsl_cplx){ 2.0, 0.0 });
+	zsl_cvec_set(&v, 2, (struct zsl_cplx){ 0.0, -3.0 });
+	zsl_cvec_init(&w);
+	zsl_cvec_set(&w, 0, (struct zsl_cplx){ 1.0, -1.0 });
+	zsl_cvec_set(&w, 1, (struct zsl_cplx){ 0.0, 1.0 });
+	zsl_cvec_set(&w, 2, (struct zsl_cplx){ 4.0, 0.0 });
+
+	rc = zsl_cvec_add(&v, &w, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x.re[0], 2.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im[0], 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im[2], -3.0, 1E-5), NULL);
+
+	rc = zsl_cvec_mul(&v, &w, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x.re[0], 2.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im[0], 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.re[1], 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im[1], 2.0, 1E-5), NULL);
+
+	/* The product of a vector with itself is its squared norm. */
+	rc = zsl_cvec_dot(&v, &v, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(d.re, 15.0, 1E-5), NULL);
+	zassert_true(val_is_equal(d.im, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(zsl_cvec_norm(&v), ZSL_SQRT(15.0), 1E-5),
+		     NULL);
+
+	/* conj(v) . w = (1 - i)(1 - i) + 2i + 3i * 4 = -2i + 2i + 12i */
+	rc = zsl_cvec_dot(&v, &w, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(d.re, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(d.im, 12.0, 1E-5), NULL);
+
+	rc = zsl_cvec_abs(&v, &mag);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mag.data[0], ZSL_SQRT(2.0), 1E-5), NULL);
+	zassert_true(val_is_equal(mag.data[2], 3.0, 1E-5), NULL);
+
+	rc = zsl_cvec_add(&v, &y, &x);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_cmtx_mult(void)
+{
+	int rc;
+	struct zsl_cplx x;
+
+	/* A = [1 + i, 2; -i, 3] */
+	zsl_real_t are[4] = { 1.0, 2.0, 0.0, 3.0 };
+	zsl_real_t aim[4] = { 1.0, 0.0, -1.0, 0.0 };
+	struct zsl_cmtx ma = { .sz_rows = 2, .sz_cols = 2,
+			       .re = are, .im = aim };
+
+	ZSL_CMTX_DEF(mh, 2, 2);
+	ZSL_CMTX_DEF(mc, 2, 2);
+	ZSL_CVEC_DEF(v, 2);
+	ZSL_CVEC_DEF(w, 2);
+
+	/* A^H * A is Hermitian, with a real diagonal. */
+	rc = zsl_cmtx_herm(&ma, &mh);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_cmtx_mult(&mh, &ma, &mc);
+	zassert_true(rc == 0, NULL);
+
+	zsl_cmtx_get(&mc, 0, 0, &x);
+	zassert_true(val_is_equal(x.re, 3.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im, 0.0, 1E-5), NULL);
+	zsl_cmtx_get(&mc, 0, 1, &x);
+	zassert_true(val_is_equal(x.re, 2.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im, 1.0, 1E-5), NULL);
+	zsl_cmtx_get(&mc, 1, 0, &x);
+	zassert_true(val_is_equal(x.re, 2.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im, -1.0, 1E-5), NULL);
+	zsl_cmtx_get(&mc, 1, 1, &x);
+	zassert_true(val_is_equal(x.re, 13.0, 1E-5), NULL);
+	zassert_true(val_is_equal(x.im, 0.0, 1E-5), NULL);
+
+	/* A * [i, 1] = [(1 + i)i + 2, 1 + 3] = [1 + i, 4] */
+	zsl_cvec_init(&v);
+	v.im[0] = 1.0;
+	v.re[1] = 1.0;
+	rc = zsl_cmtx_mult_cvec(&ma, &v, &w);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(w.re[0], 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(w.im[0], 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(w.re[1], 4.0, 1E-5), NULL);
+	zassert_true(val_is_equal(w.im[1], 0.0, 1E-5), NULL);
+
+	rc = zsl_cmtx_set(&mc, 2, 0, x);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_mtx_eigenvalues_cplx(void)
+{
+	int rc;
+
+	/* A rotation by 90 degrees about z, scaled by 2, which has
+	 * eigenvalues 2i, -2i and 2. */
+	zsl_real_t data[9] = { 0.0, -2.0, 0.0,
+			       2.0, 0.0, 0.0,
+			       0.0, 0.0, 2.0 };
+	struct zsl_mtx m = { .sz_rows = 3, .sz_cols = 3, .data = data };
+	bool pair = false;
+	bool real = false;
+
+	ZSL_CVEC_DEF(v, 3);
+
+	rc = zsl_mtx_eigenvalues_cplx(&m, &v, 500);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t i = 0; i < 3; i++) {
+		if (val_is_equal(v.im[i], 2.0, 1E-4)) {
+			zassert_true(i + 1 < 3, NULL);
+			zassert_true(val_is_equal(v.re[i], 0.0, 1E-4), NULL);
+			zassert_true(val_is_equal(v.re[i + 1], 0.0, 1E-4),
+				     NULL);
+			zassert_true(val_is_equal(v.im[i + 1], -2.0, 1E-4),
+				     NULL);
+			pair = true;
+		} else if (val_is_equal(v.im[i], 0.0, 1E-4)) {
+			zassert_true(val_is_equal(v.re[i], 2.0, 1E-4), NULL);
+			real = true;
+		}
+	}
+	zassert_true(pair && real, NULL);
+
+	v.sz = 2;
+	rc = zsl_mtx_eigenvalues_cplx(&m, &v, 500);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/convolution.h>
+#include <zsl/workspace.h>
+#include "floatcheck.h"
+
+#define CONV_TEST_N 200
+
+static zsl_real_t conv_x[CONV_TEST_N];
+static zsl_real_t conv_h[CONV_TEST_N];
+static zsl_real_t conv_y1[2 * CONV_TEST_N];
+static zsl_real_t conv_y2[2 * CONV_TEST_N];
+
+ZSL_WORKSPACE_DEF(conv_ws, 1024);
+ZSL_WORKSPACE_DEF(conv_ws_small, 256);
+
+static void conv_test_fill(void)
+{
+	for (size_t i = 0; i < CONV_TEST_N; i++) {
+		conv_x[i] = ZSL_SIN(0.21 * i) + 0.1 * (zsl_real_t)(i % 7);
+		conv_h[i] = ZSL_COS(0.13 * i) - 0.05 * (zsl_real_t)(i % 4);
+	}
+}
+
+void test_conv(void)
+{
+	int rc;
+	zsl_real_t y;
+	const size_t nx[] = { 1, 5, 33, 200 };
+	const size_t nh[] = { 1, 3, 31, 150 };
+	struct zsl_vec x = { .data = conv_x };
+	struct zsl_vec h = { .data = conv_h };
+	struct zsl_vec y1 = { .data = conv_y1 };
+	struct zsl_vec y2 = { .data = conv_y2 };
+
+	conv_test_fill();
+
+	for (size_t t = 0; t < sizeof(nx) / sizeof(nx[0]); t++) {
+		x.sz = nx[t];
+		h.sz = nh[t];
+		y1.sz = x.sz + h.sz - 1;
+		y2.sz = y1.sz;
+
+		rc = zsl_conv_direct(&x, &h, &y1);
+		zassert_true(rc == 0, NULL);
+		for (size_t n = 0; n < y1.sz; n++) {
+			y = 0.0;
+			for (size_t k = 0; k < x.sz; k++) {
+				if (n >= k && n - k < h.sz) {
+					y += conv_x[k] * conv_h[n - k];
+				}
+			}
+			zassert_true(val_is_equal(conv_y1[n], y, 1E-6), NULL);
+		}
+
+		zsl_ws_release(&conv_ws, 0);
+		rc = zsl_conv_fft_ws(&x, &h, &y2, &conv_ws);
+		zassert_true(rc == 0, NULL);
+		for (size_t n = 0; n < y1.sz; n++) {
+			zassert_true(val_is_equal(conv_y2[n], conv_y1[n], 1E-4),
+				     NULL);
+		}
+		zassert_equal(conv_ws.used, 0, NULL);
+
+		rc = zsl_conv(&x, &h, &y2);
+		zassert_true(rc == 0, NULL);
+		for (size_t n = 0; n < y1.sz; n++) {
+			zassert_true(val_is_equal(conv_y2[n], conv_y1[n], 1E-4),
+				     NULL);
+		}
+	}
+
+	y1.sz = x.sz + h.sz;
+	rc = zsl_conv(&x, &h, &y1);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_xcorr(void)
+{
+	int rc;
+	zsl_real_t r;
+	size_t peak = 0;
+	struct zsl_vec x = { .sz = 120, .data = conv_x };
+	struct zsl_vec y = { .sz = 100, .data = conv_h };
+	struct zsl_vec r1 = { .sz = 219, .data = conv_y1 };
+	struct zsl_vec r2 = { .sz = 219, .data = conv_y2 };
+
+	/* 'x' is 'y' delayed by 17 samples, with a little offset. */
+	for (size_t i = 0; i < 120; i++) {
+		conv_h[i] = ZSL_SIN(0.05 * i * i) * ZSL_COS(0.3 * i);
+	}
+	for (size_t i = 0; i < 120; i++) {
+		conv_x[i] = 0.01 + ((i >= 17) ? conv_h[i - 17] : 0.0);
+	}
+
+	rc = zsl_xcorr_direct(&x, &y, &r1);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 1; i < r1.sz; i++) {
+		if (conv_y1[i] > conv_y1[peak]) {
+			peak = i;
+		}
+	}
+	zassert_equal((int)peak - (int)(y.sz - 1), 17, NULL);
+
+	rc = zsl_xcorr_lag(&x, &y, 17, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(r, conv_y1[17 + y.sz - 1], 1E-6), NULL);
+	rc = zsl_xcorr_lag(&x, &y, -3, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(r, conv_y1[y.sz - 4], 1E-6), NULL);
+	rc = zsl_xcorr_lag(&x, &y, 500, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(r, 0.0, 1E-6), NULL);
+
+	zsl_ws_release(&conv_ws, 0);
+	rc = zsl_xcorr_fft_ws(&x, &y, &r2, &conv_ws);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < r1.sz; i++) {
+		zassert_true(val_is_equal(conv_y2[i], conv_y1[i], 1E-4), NULL);
+	}
+
+	rc = zsl_xcorr(&x, &y, &r2);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < r1.sz; i++) {
+		zassert_true(val_is_equal(conv_y2[i], conv_y1[i], 1E-4), NULL);
+	}
+
+	/* The workspace is too small for a 256-point transform. */
+	zsl_ws_release(&conv_ws_small, 0);
+	rc = zsl_xcorr_fft_ws(&x, &y, &r1, &conv_ws_small);
+	zassert_true(rc == -ENOMEM, NULL);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/ctx.h>
+#include "floatcheck.h"
+
+void test_ctx_init(void)
+{
+	int rc;
+	bool differ = false;
+	struct zsl_ctx c;
+
+	ZSL_CTX_DEF(c1, 16);
+	ZSL_CTX_DEF(c2, 16);
+	ZSL_WORKSPACE_DEF(ws, 16);
+	ZSL_MATRIX_DEF(ma, 3, 3);
+	ZSL_MATRIX_DEF(mb, 3, 3);
+
+	/* A workspace is required, a generator isn't. */
+	rc = zsl_ctx_init(&c, NULL, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_ctx_init(&c, &ws, NULL);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_ctx_seed(&c, 1), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_init_random_ctx(&ma, &c), -EINVAL, NULL);
+
+	/* Contexts with the same seed give the same values. */
+	zassert_equal(zsl_ctx_seed(&c1, 42), 0, NULL);
+	zassert_equal(zsl_ctx_seed(&c2, 42), 0, NULL);
+	zassert_equal(zsl_mtx_init_random_ctx(&ma, &c1), 0, NULL);
+	zassert_equal(zsl_mtx_init_random_ctx(&mb, &c2), 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_equal(ma.data[i], mb.data[i], NULL);
+		zassert_true(ma.data[i] >= -1.0 && ma.data[i] < 1.0, NULL);
+	}
+
+	/* ... and different seeds give different values. */
+	zassert_equal(zsl_ctx_seed(&c2, 43), 0, NULL);
+	zassert_equal(zsl_mtx_init_random_ctx(&mb, &c2), 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		if (ma.data[i] != mb.data[i]) {
+			differ = true;
+		}
+	}
+	zassert_true(differ, NULL);
+}
+
+void test_ctx_mtx(void)
+{
+	int rc;
+	zsl_real_t a[9] = {
+		4.0, 1.0, 0.5,
+		1.0, 3.0, 0.0,
+		0.5, 0.0, 2.0
+	};
+	struct zsl_mtx m = { .sz_rows = 3, .sz_cols = 3, .data = a };
+
+	ZSL_CTX_DEF(ctx, 128);
+	ZSL_CTX_DEF(tiny, 4);
+	ZSL_MATRIX_DEF(e1, 3, 3);
+	ZSL_MATRIX_DEF(e2, 3, 3);
+
+	/* Results match the plain functions. */
+	zassert_true(zsl_mtx_expm_ws_sz(3) <= 128, NULL);
+	rc = zsl_mtx_expm(&m, &e1);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_expm_ctx(&m, &e2, &ctx);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(e1.data[i], e2.data[i], 1E-6), NULL);
+	}
+
+	/* A workspace that is too small is reported, not overrun. */
+	rc = zsl_mtx_expm_ctx(&m, &e2, &tiny);
+	zassert_equal(rc, -ENOMEM, NULL);
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+	ZSL_CTX_DEF(big, 256);
+	ZSL_VECTOR_DEF(v1, 3);
+	ZSL_VECTOR_DEF(v2, 3);
+
+	zassert_true(zsl_mtx_pinv_ws_sz(3, 3) <= 256, NULL);
+	rc = zsl_mtx_eigenvalues(&m, &v1, 500);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_eigenvalues_ctx(&m, &v2, 500, NULL, &big);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(v1.data[i], v2.data[i], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_svd_vals(&m, &v1, 150);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_svd_vals_ctx(&m, &v2, 150, &big);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(v1.data[i], v2.data[i], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_pinv(&m, &e1, 150);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_pinv_ctx(&m, &e2, 150, &big);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(e1.data[i], e2.data[i], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_pinv_ctx(&m, &e2, 150, &tiny);
+	zassert_equal(rc, -ENOMEM, NULL);
+#endif
+}
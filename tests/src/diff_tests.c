@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Differential and property tests.
+ *
+ * Each case below runs random inputs of random sizes through a library
+ * function, and checks the result either against a plain reference
+ * implementation computed in double precision, or against a property the
+ * result must satisfy, such as a small residual for a linear solve. The
+ * errors are measured in units of the rounding error expected for the
+ * size of the problem, so one tolerance per case holds at every size and
+ * for both single and double precision.
+ *
+ * The time spent in the library function and in the reference is also
+ * recorded for every case, and printed once all cases have run, so a new
+ * fast path can be checked for both its accuracy and its speedup.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <ztest.h>
+#include <sys/printk.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/fixed.h>
+#include <zsl/sparse.h>
+#include <zsl/random.h>
+
+#ifndef __ZEPHYR__
+#include <time.h>
+#endif
+
+/* The largest number of rows or columns of a random input. */
+#define DIFF_MAX_N      (16)
+
+/* The number of random inputs per case. */
+#define DIFF_TRIALS     (32)
+
+/* The unit roundoff of zsl_real_t. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define DIFF_EPS        (5.96E-8)
+#else
+#define DIFF_EPS        (1.12E-16)
+#endif
+
+/* The resolution of a Q31 value. */
+#define DIFF_Q31_EPS    (4.66E-10)
+
+static zsl_real_t diff_a[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_real_t diff_b[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_real_t diff_c[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_real_t diff_d[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_q31_t diff_qa[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_q31_t diff_qb[DIFF_MAX_N * DIFF_MAX_N];
+static zsl_q31_t diff_qc[DIFF_MAX_N * DIFF_MAX_N];
+static double diff_ref[DIFF_MAX_N * DIFF_MAX_N];
+static double diff_scale[DIFF_MAX_N * DIFF_MAX_N];
+ZSL_SPMATRIX_DEF(diff_sp, DIFF_MAX_N, DIFF_MAX_N, DIFF_MAX_N * DIFF_MAX_N);
+
+/* The recorded accuracy and timing of one case. */
+struct diff_stat {
+	/* The largest error seen, in units of the expected rounding error. */
+	double err;
+	/* The total cycles, or nanoseconds off target, in the function. */
+	uint32_t opt;
+	/* The total cycles, or nanoseconds off target, in the reference. */
+	uint32_t ref;
+};
+
+/*
+ * One case. 'run' draws inputs of m x k and k x n for the given sizes,
+ * times the function under test and the reference, and returns the error
+ * in units of the expected rounding error, or a negative value if the
+ * function failed.
+ */
+struct diff_case {
+	const char *name;
+	double (*run)(struct zsl_rand *r, size_t m, size_t k, size_t n,
+		      struct diff_stat *st);
+	double tol;
+};
+
+/* The hardware cycle counter, or nanoseconds outside of Zephyr. */
+static uint32_t diff_cycles(void)
+{
+#ifdef __ZEPHYR__
+	return k_cycle_get_32();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+static struct zsl_mtx diff_mtx(zsl_real_t *data, size_t rows, size_t cols)
+{
+	struct zsl_mtx m = {
+		.sz_rows = rows,
+		.sz_cols = cols,
+		.data = data,
+	};
+
+	return m;
+}
+
+/* Fills 'm' with a random, diagonally dominant and so well-conditioned,
+ * square matrix. */
+static void diff_rand_dominant(struct zsl_rand *r, struct zsl_mtx *m)
+{
+	zsl_rand_mtx_uniform(r, m, -1.0, 1.0);
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		m->data[i * m->sz_cols + i] += (zsl_real_t)m->sz_cols;
+	}
+}
+
+/* Returns the largest of |x - ref| / (u * (scale + 1)). */
+static double diff_err(const zsl_real_t *x, size_t n, double u)
+{
+	double e = 0.0;
+	double d;
+
+	for (size_t i = 0; i < n; i++) {
+		d = x[i] - diff_ref[i];
+		d = fabs(d) / (u * (diff_scale[i] + 1.0));
+		e = (d > e) ? d : e;
+	}
+
+	return e;
+}
+
+/* The reference c = alpha * op(a) * op(b) + beta * c, in double precision.
+ * The scale of each entry is (k + 2) times the sum of the magnitudes of
+ * its terms, which bounds its rounding error. */
+static void diff_ref_gemm(const struct zsl_mtx *a, bool ta,
+			  const struct zsl_mtx *b, bool tb, double alpha,
+			  double beta, const struct zsl_mtx *c)
+{
+	size_t k = ta ? a->sz_rows : a->sz_cols;
+	double s, sa, x, y;
+
+	for (size_t i = 0; i < c->sz_rows; i++) {
+		for (size_t j = 0; j < c->sz_cols; j++) {
+			s = 0.0;
+			sa = 0.0;
+			for (size_t l = 0; l < k; l++) {
+				x = ta ? a->data[l * a->sz_cols + i] :
+				    a->data[i * a->sz_cols + l];
+				y = tb ? b->data[j * b->sz_cols + l] :
+				    b->data[l * b->sz_cols + j];
+				s += x * y;
+				sa += fabs(x * y);
+			}
+			x = (beta != 0.0) ? c->data[i * c->sz_cols + j] : 0.0;
+			diff_ref[i * c->sz_cols + j] = alpha * s + beta * x;
+			diff_scale[i * c->sz_cols + j] = (k + 2) *
+				(fabs(alpha) * sa + fabs(beta * x));
+		}
+	}
+}
+
+static double diff_mtx_mult(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			    struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, k);
+	struct zsl_mtx b = diff_mtx(diff_b, k, n);
+	struct zsl_mtx c = diff_mtx(diff_c, m, n);
+
+	zsl_rand_mtx_uniform(r, &a, -1.0, 1.0);
+	zsl_rand_mtx_uniform(r, &b, -1.0, 1.0);
+	zsl_mtx_init(&c, NULL);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_mult(&a, &b, &c);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_ref_gemm(&a, false, &b, false, 1.0, 0.0, &c);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(c.data, m * n, DIFF_EPS);
+}
+
+static double diff_mtx_mult_ex(struct zsl_rand *r, size_t m, size_t k,
+			       size_t n, struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	bool ta = zsl_rand_u32(r) & 1;
+	bool tb = zsl_rand_u32(r) & 1;
+	zsl_real_t alpha = zsl_rand_uniform(r) * 4.0 - 2.0;
+	zsl_real_t beta = (zsl_rand_u32(r) & 1) ? zsl_rand_uniform(r) : 0.0;
+	struct zsl_mtx a = ta ? diff_mtx(diff_a, k, m) : diff_mtx(diff_a, m, k);
+	struct zsl_mtx b = tb ? diff_mtx(diff_b, n, k) : diff_mtx(diff_b, k, n);
+	struct zsl_mtx c = diff_mtx(diff_c, m, n);
+
+	zsl_rand_mtx_uniform(r, &a, -1.0, 1.0);
+	zsl_rand_mtx_uniform(r, &b, -1.0, 1.0);
+	zsl_rand_mtx_uniform(r, &c, -1.0, 1.0);
+
+	/* The reference reads the initial 'c'. */
+	t0 = diff_cycles();
+	diff_ref_gemm(&a, ta, &b, tb, alpha, beta, &c);
+	st->ref += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_mult_ex(&a, ta, &b, tb, alpha, beta, &c);
+	st->opt += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(c.data, m * n, DIFF_EPS);
+}
+
+static double diff_mtx_trans(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			     struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, n);
+	struct zsl_mtx c = diff_mtx(diff_c, n, m);
+
+	zsl_rand_mtx_uniform(r, &a, -1.0, 1.0);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_trans(&a, &c);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			diff_ref[j * m + i] = a.data[i * n + j];
+			diff_scale[j * m + i] = 0.0;
+		}
+	}
+	st->ref += diff_cycles() - t0;
+
+	/* A transpose is exact. */
+	return rc ? -1.0 : diff_err(c.data, m * n, DIFF_EPS);
+}
+
+static double diff_mtx_add(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			   struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, n);
+	struct zsl_mtx b = diff_mtx(diff_b, m, n);
+	struct zsl_mtx c = diff_mtx(diff_c, m, n);
+
+	zsl_rand_mtx_uniform(r, &a, -1.0, 1.0);
+	zsl_rand_mtx_uniform(r, &b, -1.0, 1.0);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_add(&a, &b, &c);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	for (size_t i = 0; i < m * n; i++) {
+		diff_ref[i] = (double)a.data[i] + b.data[i];
+		diff_scale[i] = fabs(diff_ref[i]);
+	}
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(c.data, m * n, DIFF_EPS);
+}
+
+static double diff_vec_dot(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			   struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	zsl_real_t d;
+	struct zsl_vec v = { .sz = m * k, .data = diff_a };
+	struct zsl_vec w = { .sz = m * k, .data = diff_b };
+	struct zsl_mtx vm = diff_mtx(diff_a, 1, m * k);
+	struct zsl_mtx wm = diff_mtx(diff_b, m * k, 1);
+	struct zsl_mtx dm = diff_mtx(&d, 1, 1);
+
+	zsl_rand_vec_uniform(r, &v, -1.0, 1.0);
+	zsl_rand_vec_uniform(r, &w, -1.0, 1.0);
+
+	t0 = diff_cycles();
+	rc = zsl_vec_dot(&v, &w, &d);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_ref_gemm(&vm, false, &wm, false, 1.0, 0.0, &dm);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(&d, 1, DIFF_EPS);
+}
+
+static double diff_q31_mult(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			    struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx_q31 qa = { .sz_rows = m, .sz_cols = k, .data = diff_qa };
+	struct zsl_mtx_q31 qb = { .sz_rows = k, .sz_cols = n, .data = diff_qb };
+	struct zsl_mtx_q31 qc = { .sz_rows = m, .sz_cols = n, .data = diff_qc };
+	struct zsl_mtx a = diff_mtx(diff_a, m, k);
+	struct zsl_mtx b = diff_mtx(diff_b, k, n);
+	struct zsl_mtx c = diff_mtx(diff_c, m, n);
+
+	/* Small enough that no entry of the product saturates. */
+	zsl_rand_mtx_uniform(r, &a, -0.5, 0.5);
+	zsl_rand_mtx_uniform(r, &b, -1.0 / k, 1.0 / k);
+	zsl_mtx_q31_from_mtx(&a, &qa);
+	zsl_mtx_q31_from_mtx(&b, &qb);
+	zsl_mtx_q31_to_mtx(&qa, &a);
+	zsl_mtx_q31_to_mtx(&qb, &b);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_q31_mult(&qa, &qb, &qc);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_ref_gemm(&a, false, &b, false, 1.0, 0.0, &c);
+	st->ref += diff_cycles() - t0;
+
+	/* Each term is truncated to Q31, so the error grows with 'k'
+	 * rather than with the size of the terms. */
+	for (size_t i = 0; i < m * n; i++) {
+		diff_scale[i] = k + 1;
+	}
+	zsl_mtx_q31_to_mtx(&qc, &c);
+
+	return rc ? -1.0 : diff_err(c.data, m * n,
+				     DIFF_Q31_EPS > DIFF_EPS ?
+				     DIFF_Q31_EPS : DIFF_EPS);
+}
+
+static double diff_spmtx_mult_vec(struct zsl_rand *r, size_t m, size_t k,
+				  size_t n, struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, n);
+	struct zsl_mtx x = diff_mtx(diff_b, n, 1);
+	struct zsl_mtx y = diff_mtx(diff_c, m, 1);
+	struct zsl_vec xv = { .sz = n, .data = diff_b };
+	struct zsl_vec yv = { .sz = m, .data = diff_c };
+
+	/* About a quarter of the entries are non-zero. */
+	zsl_rand_mtx_uniform(r, &a, -1.0, 1.0);
+	for (size_t i = 0; i < m * n; i++) {
+		if (zsl_rand_u32(r) & 3) {
+			a.data[i] = 0.0;
+		}
+	}
+	zsl_rand_mtx_uniform(r, &x, -1.0, 1.0);
+	diff_sp.sz_rows = m;
+	diff_sp.sz_cols = n;
+	zsl_spmtx_init(&diff_sp);
+	zsl_spmtx_from_mtx(&a, 0.0, &diff_sp);
+
+	t0 = diff_cycles();
+	rc = zsl_spmtx_mult_vec(&diff_sp, &xv, &yv);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_ref_gemm(&a, false, &x, false, 1.0, 0.0, &y);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(yv.data, m, DIFF_EPS);
+}
+
+/*
+ * Sets the scale of each row of a solution 'x' of a * x = b from the
+ * backward error bound |b - a * x| <= u * n * (|a| * |x| + |b|), and the
+ * reference to 'b', so diff_err on a * x gives the normwise backward error.
+ */
+static void diff_residual(const struct zsl_mtx *a, const struct zsl_mtx *x,
+			  const struct zsl_mtx *b, struct zsl_mtx *ax)
+{
+	diff_ref_gemm(a, false, x, false, 1.0, 0.0, ax);
+	for (size_t i = 0; i < b->sz_rows * b->sz_cols; i++) {
+		diff_scale[i] += (a->sz_cols + 2) * fabs(b->data[i]);
+		ax->data[i] = diff_ref[i];
+		diff_ref[i] = b->data[i];
+	}
+}
+
+static double diff_mtx_solve(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			     struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, m);
+	struct zsl_mtx b = diff_mtx(diff_b, m, n);
+	struct zsl_mtx x = diff_mtx(diff_c, m, n);
+	struct zsl_mtx ax = diff_mtx(diff_d, m, n);
+
+	diff_rand_dominant(r, &a);
+	zsl_rand_mtx_uniform(r, &b, -1.0, 1.0);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_solve(&a, &b, &x);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_residual(&a, &x, &b, &ax);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(ax.data, m * n, DIFF_EPS);
+}
+
+static double diff_mtx_chol_solve(struct zsl_rand *r, size_t m, size_t k,
+				  size_t n, struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx g = diff_mtx(diff_a, m, m);
+	struct zsl_mtx a = diff_mtx(diff_d, m, m);
+	struct zsl_mtx l = diff_mtx(diff_a, m, m);
+	struct zsl_mtx b = diff_mtx(diff_b, m, n);
+	struct zsl_mtx x = diff_mtx(diff_c, m, n);
+	struct zsl_mtx ax = diff_mtx(diff_a, m, n);
+
+	/* A = G^T * G, with G diagonally dominant, is positive-definite. */
+	diff_rand_dominant(r, &g);
+	zsl_mtx_mult_ex(&g, true, &g, false, 1.0, 0.0, &a);
+	zsl_rand_mtx_uniform(r, &b, -1.0, 1.0);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_cholesky(&a, &l);
+	rc |= zsl_mtx_chol_solve(&l, &b, &x);
+	st->opt += diff_cycles() - t0;
+
+	t0 = diff_cycles();
+	diff_residual(&a, &x, &b, &ax);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(ax.data, m * n, DIFF_EPS);
+}
+
+static double diff_mtx_inv(struct zsl_rand *r, size_t m, size_t k, size_t n,
+			   struct diff_stat *st)
+{
+	int rc;
+	uint32_t t0;
+	struct zsl_mtx a = diff_mtx(diff_a, m, m);
+	struct zsl_mtx ai = diff_mtx(diff_c, m, m);
+	struct zsl_mtx id = diff_mtx(diff_b, m, m);
+	struct zsl_mtx aai = diff_mtx(diff_d, m, m);
+
+	diff_rand_dominant(r, &a);
+	zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
+
+	t0 = diff_cycles();
+	rc = zsl_mtx_inv(&a, &ai);
+	st->opt += diff_cycles() - t0;
+
+	/* Each column of the inverse solves a * x = e_j. */
+	t0 = diff_cycles();
+	diff_residual(&a, &ai, &id, &aai);
+	st->ref += diff_cycles() - t0;
+
+	return rc ? -1.0 : diff_err(aai.data, m * m, DIFF_EPS);
+}
+
+static const struct diff_case diff_cases[] = {
+	{ "mtx_mult", diff_mtx_mult, 2.0 },
+	{ "mtx_mult_ex", diff_mtx_mult_ex, 2.0 },
+	{ "mtx_trans", diff_mtx_trans, 0.0 },
+	{ "mtx_add", diff_mtx_add, 1.0 },
+	{ "vec_dot", diff_vec_dot, 2.0 },
+	{ "mtx_q31_mult", diff_q31_mult, 4.0 },
+	{ "spmtx_mult_vec", diff_spmtx_mult_vec, 2.0 },
+	{ "mtx_solve", diff_mtx_solve, 16.0 },
+	{ "mtx_chol_solve", diff_mtx_chol_solve, 16.0 },
+	{ "mtx_inv", diff_mtx_inv, 16.0 },
+};
+
+#define DIFF_CASES      (sizeof(diff_cases) / sizeof(diff_cases[0]))
+
+/**
+ * @brief Differential and property tests of the matrix, vector, fixed-point
+ *        and sparse functions on random inputs.
+ *
+ * Every case runs DIFF_TRIALS inputs of random sizes from 1 to DIFF_MAX_N
+ * from a fixed seed, so a failure can be reproduced, then the largest error
+ * and the time spent in each function and its reference are printed.
+ */
+void test_diff_random(void)
+{
+	double e;
+	size_t m, k, n;
+	struct zsl_rand r;
+	struct diff_stat st;
+
+	printk("\n%-16s %8s %10s %10s\n", "case", "max err", "opt", "ref");
+
+	for (size_t c = 0; c < DIFF_CASES; c++) {
+		zsl_rand_seed(&r, 0x5eed + c);
+		memset(&st, 0, sizeof(st));
+
+		for (size_t t = 0; t < DIFF_TRIALS; t++) {
+			m = 1 + zsl_rand_u32(&r) % DIFF_MAX_N;
+			k = 1 + zsl_rand_u32(&r) % DIFF_MAX_N;
+			n = 1 + zsl_rand_u32(&r) % DIFF_MAX_N;
+
+			e = diff_cases[c].run(&r, m, k, n, &st);
+			zassert_true(e >= 0.0, "%s failed at %ux%ux%u",
+				     diff_cases[c].name, (unsigned int)m,
+				     (unsigned int)k, (unsigned int)n);
+			zassert_true(e <= diff_cases[c].tol,
+				     "%s error %d/100 at %ux%ux%u",
+				     diff_cases[c].name, (int)(e * 100.0),
+				     (unsigned int)m, (unsigned int)k,
+				     (unsigned int)n);
+			st.err = (e > st.err) ? e : st.err;
+		}
+
+		printk("%-16s %8d %10u %10u\n", diff_cases[c].name,
+		       (int)(st.err * 100.0), (unsigned int)st.opt,
+		       (unsigned int)st.ref);
+	}
+}
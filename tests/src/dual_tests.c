@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/dual.h>
+#include <zsl/orientation/quaternions.h>
+#include "floatcheck.h"
+
+/* P = V * I and R = V / I. */
+static int dual_power(const struct zsl_dual *x, struct zsl_dual *y,
+		      void *arg)
+{
+	zsl_dual_mult(&x[0], &x[1], &y[0]);
+
+	return zsl_dual_div(&x[0], &x[1], &y[1]);
+}
+
+/* Rotates input 3-vector x[0..2] by the quaternion at 'arg'. */
+static int dual_rot(const struct zsl_dual *x, struct zsl_dual *y, void *arg)
+{
+	struct zsl_quat *q = arg;
+	struct zsl_dual dq[4];
+
+	for (size_t i = 0; i < 4; i++) {
+		zsl_dual_const(&dq[i], q->idx[i]);
+	}
+
+	return zsl_dual_quat_rot_vec(dq, x, y);
+}
+
+/**
+ * @brief zsl_dual scalar function unit tests.
+ *
+ * This test checks the derivatives of a composite function against the
+ * analytic result.
+ */
+void test_dual_ops(void)
+{
+	int rc;
+	zsl_real_t x = 0.7;
+	struct zsl_dual a, b, c;
+
+	/* Test 1: f(x) = sin(x) * e^x / sqrt(x) */
+	rc = zsl_dual_var(&a, x, 0);
+	zassert_equal(rc, 0, NULL);
+	zsl_dual_sin(&a, &b);
+	zsl_dual_exp(&a, &c);
+	zsl_dual_mult(&b, &c, &b);
+	zsl_dual_sqrt(&a, &c);
+	rc = zsl_dual_div(&b, &c, &b);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(b.v, ZSL_SIN(x) * ZSL_EXP(x) / ZSL_SQRT(x),
+				  1E-6), NULL);
+	zassert_true(val_is_equal(b.d[0], ZSL_EXP(x) / ZSL_SQRT(x) *
+				  (ZSL_COS(x) + ZSL_SIN(x) -
+				   ZSL_SIN(x) / (2.0 * x)), 1E-6), NULL);
+	zassert_true(b.d[1] == 0.0, NULL);
+
+	/* Test 2: g(x, y) = atan2(y, x) + ln(x) * y^2.5 */
+	zsl_dual_var(&b, 1.3, 1);
+	zsl_dual_atan2(&b, &a, &c);
+	zsl_dual_log(&a, &a);
+	zsl_dual_pow(&b, 2.5, &b);
+	zsl_dual_mult(&a, &b, &a);
+	zsl_dual_add(&a, &c, &a);
+	zassert_true(val_is_equal(a.d[0], -1.3 / (x * x + 1.69) +
+				  ZSL_POW(1.3, 2.5) / x, 1E-6), NULL);
+	zassert_true(val_is_equal(a.d[1], x / (x * x + 1.69) +
+				  ZSL_LOG(x) * 2.5 * ZSL_POW(1.3, 1.5), 1E-6),
+		     NULL);
+
+	/* Test 3: CIE 1931 x = X / (X + Y + Z), and the sRGB encoding. */
+	struct zsl_dual xyz[3], xyy[3];
+
+	zsl_dual_var(&xyz[0], 0.5, 0);
+	zsl_dual_var(&xyz[1], 0.6, 1);
+	zsl_dual_var(&xyz[2], 0.7, 2);
+	rc = zsl_dual_clr_xyz_xyy(xyz, xyy);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(xyy[0].v, 0.5 / 1.8, 1E-6), NULL);
+	zassert_true(val_is_equal(xyy[0].d[0], 1.3 / (1.8 * 1.8), 1E-6), NULL);
+	zassert_true(val_is_equal(xyy[0].d[1], -0.5 / (1.8 * 1.8), 1E-6),
+		     NULL);
+	zassert_true(xyy[2].d[1] == 1.0, NULL);
+	zsl_dual_clr_srgb_enc(&xyz[0], &a);
+	zassert_true(val_is_equal(a.v, 1.055 * ZSL_POW(0.5, 1.0 / 2.4) - 0.055,
+				  1E-6), NULL);
+	zassert_true(val_is_equal(a.d[0], 1.055 / 2.4 *
+				  ZSL_POW(0.5, 1.0 / 2.4 - 1.0), 1E-6), NULL);
+
+	/* Test 4: Invalid arguments. */
+	zsl_dual_const(&c, 0.0);
+	zassert_equal(zsl_dual_var(&a, 1.0, ZSL_DUAL_N), -EINVAL, NULL);
+	zassert_equal(zsl_dual_div(&a, &c, &b), -EINVAL, NULL);
+	zassert_equal(zsl_dual_sqrt(&c, &b), -EINVAL, NULL);
+	zassert_equal(zsl_dual_log(&c, &b), -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_dual_jacobian and zsl_dual_propagate unit tests.
+ *
+ * This test checks Jacobians of a small electrical model and of a
+ * quaternion rotation, and the propagated uncertainty of the model.
+ */
+void test_dual_propagate(void)
+{
+	int rc;
+	zsl_real_t jv[3];
+	ZSL_VECTOR_DEF(x, 2);
+	ZSL_VECTOR_DEF(y, 2);
+	ZSL_VECTOR_DEF(v3, 3);
+	ZSL_VECTOR_DEF(r3, 3);
+	ZSL_VECTOR_DEF(e3, 3);
+	ZSL_MATRIX_DEF(j, 2, 2);
+	ZSL_MATRIX_DEF(j3, 3, 3);
+	ZSL_MATRIX_DEF(cx, 2, 2);
+	ZSL_MATRIX_DEF(cy, 2, 2);
+	struct zsl_quat q = { .r = 0.8, .i = 0.1, .j = -0.3, .k = 0.5 };
+	zsl_real_t u_p;
+
+	/* Test 1: V = 12 V and I = 2 A. */
+	x.data[0] = 12.0;
+	x.data[1] = 2.0;
+	rc = zsl_dual_jacobian(dual_power, NULL, &x, &y, &j);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y.data[0], 24.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y.data[1], 6.0, 1E-6), NULL);
+	zassert_true(val_is_equal(j.data[0], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(j.data[1], 12.0, 1E-6), NULL);
+	zassert_true(val_is_equal(j.data[2], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(j.data[3], -3.0, 1E-6), NULL);
+
+	/* Test 2: With u(V) = 0.1 V and u(I) = 0.02 A, uncorrelated, the
+	 * relative uncertainties of P add in quadrature. */
+	zsl_mtx_init(&cx, NULL);
+	cx.data[0] = 0.01;
+	cx.data[3] = 0.0004;
+	rc = zsl_dual_propagate(dual_power, NULL, &x, &cx, &y, &cy);
+	zassert_equal(rc, 0, NULL);
+	u_p = 24.0 * ZSL_SQRT(0.0001 / 1.44 + 0.0001);
+	zassert_true(val_is_equal(ZSL_SQRT(cy.data[0]), u_p, 1E-6), NULL);
+	/* cov(P, R) = 2 * 0.5 * 0.01 + 12 * -3 * 0.0004 */
+	zassert_true(val_is_equal(cy.data[1], -0.0044, 1E-6), NULL);
+	zassert_true(val_is_equal(cy.data[1], cy.data[2], 1E-9), NULL);
+
+	/* Test 3: The Jacobian of a rotation is its rotation matrix, whose
+	 * columns are the rotated unit vectors. */
+	zsl_quat_to_unit_d(&q);
+	v3.data[0] = 1.0;
+	v3.data[1] = -2.0;
+	v3.data[2] = 0.5;
+	rc = zsl_dual_jacobian(dual_rot, &q, &v3, &r3, &j3);
+	zassert_equal(rc, 0, NULL);
+	zsl_quat_rot_vec(&q, &v3, &e3);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(r3.data[i], e3.data[i], 1E-6), NULL);
+	}
+	for (size_t k = 0; k < 3; k++) {
+		zsl_vec_init(&v3);
+		v3.data[k] = 1.0;
+		zsl_quat_rot_vec(&q, &v3, &e3);
+		zsl_mtx_get_col(&j3, k, jv);
+		for (size_t i = 0; i < 3; i++) {
+			zassert_true(val_is_equal(jv[i], e3.data[i], 1E-6),
+				     NULL);
+		}
+	}
+
+	/* Test 4: Mismatched shapes and model errors. */
+	rc = zsl_dual_jacobian(dual_power, NULL, &x, &y, &j3);
+	zassert_equal(rc, -EINVAL, NULL);
+	x.data[1] = 0.0;
+	rc = zsl_dual_propagate(dual_power, NULL, &x, &cx, &y, &cy);
+	zassert_equal(rc, -EINVAL, NULL);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/fft.h>
+#include "floatcheck.h"
+
+#define FFT_TEST_N 64
+
+static zsl_real_t fft_re[FFT_TEST_N];
+static zsl_real_t fft_im[FFT_TEST_N];
+static zsl_real_t fft_xr[FFT_TEST_N];
+static zsl_real_t fft_xi[FFT_TEST_N];
+
+/* Fills the first 'n' samples with a deterministic, non-symmetric signal. */
+static void fft_test_fill(size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		fft_re[i] = ZSL_SIN(0.3 * i) + 0.25 * (zsl_real_t)(i % 5);
+		fft_im[i] = ZSL_COS(0.7 * i) - 0.1 * (zsl_real_t)(i % 3);
+	}
+}
+
+/* The DFT of the first 'n' samples, computed directly in O(n^2). */
+static void fft_test_dft(size_t n)
+{
+	zsl_real_t a;
+
+	for (size_t k = 0; k < n; k++) {
+		fft_xr[k] = 0.0;
+		fft_xi[k] = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			a = -2.0 * ZSL_PI * (zsl_real_t)((j * k) % n) /
+			    (zsl_real_t)n;
+			fft_xr[k] += fft_re[j] * ZSL_COS(a) -
+				     fft_im[j] * ZSL_SIN(a);
+			fft_xi[k] += fft_re[j] * ZSL_SIN(a) +
+				     fft_im[j] * ZSL_COS(a);
+		}
+	}
+}
+
+void test_fft_cplx(void)
+{
+	int rc;
+	const size_t sizes[] = { 1, 2, 4, 8, 16, 32, 64 };
+	struct zsl_cvec v = { .re = fft_re, .im = fft_im };
+
+	for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+		v.sz = sizes[t];
+		fft_test_fill(v.sz);
+		fft_test_dft(v.sz);
+
+		rc = zsl_fft_cplx(&v);
+		zassert_true(rc == 0, NULL);
+		for (size_t k = 0; k < v.sz; k++) {
+			zassert_true(val_is_equal(fft_re[k], fft_xr[k], 1E-4),
+				     NULL);
+			zassert_true(val_is_equal(fft_im[k], fft_xi[k], 1E-4),
+				     NULL);
+		}
+
+		/* The inverse returns the original samples. */
+		rc = zsl_ifft_cplx(&v);
+		zassert_true(rc == 0, NULL);
+		for (size_t k = 0; k < v.sz; k++) {
+			fft_xr[k] = fft_re[k];
+			fft_xi[k] = fft_im[k];
+		}
+		fft_test_fill(v.sz);
+		for (size_t k = 0; k < v.sz; k++) {
+			zassert_true(val_is_equal(fft_xr[k], fft_re[k], 1E-5),
+				     NULL);
+			zassert_true(val_is_equal(fft_xi[k], fft_im[k], 1E-5),
+				     NULL);
+		}
+	}
+
+	v.sz = 12;
+	rc = zsl_fft_cplx(&v);
+	zassert_true(rc == -EINVAL, NULL);
+	v.sz = 0;
+	rc = zsl_ifft_cplx(&v);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_fft_real(void)
+{
+	int rc;
+	const size_t sizes[] = { 2, 4, 8, 32, 64 };
+	struct zsl_vec v = { .data = fft_re };
+	size_t n;
+
+	for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+		n = sizes[t];
+		v.sz = n;
+		fft_test_fill(n);
+		for (size_t i = 0; i < n; i++) {
+			fft_im[i] = 0.0;
+		}
+		fft_test_dft(n);
+
+		fft_test_fill(n);
+		rc = zsl_fft_real(&v);
+		zassert_true(rc == 0, NULL);
+
+		zassert_true(val_is_equal(fft_re[0], fft_xr[0], 1E-4), NULL);
+		zassert_true(val_is_equal(fft_re[1], fft_xr[n / 2], 1E-4),
+			     NULL);
+		for (size_t k = 1; k < n / 2; k++) {
+			zassert_true(val_is_equal(fft_re[2 * k], fft_xr[k],
+						  1E-4), NULL);
+			zassert_true(val_is_equal(fft_re[2 * k + 1], fft_xi[k],
+						  1E-4), NULL);
+		}
+
+		/* The inverse returns the original samples. */
+		rc = zsl_ifft_real(&v);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			fft_xr[i] = fft_re[i];
+		}
+		fft_test_fill(n);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(val_is_equal(fft_xr[i], fft_re[i], 1E-5),
+				     NULL);
+		}
+	}
+
+	v.sz = 1;
+	rc = zsl_fft_real(&v);
+	zassert_true(rc == -EINVAL, NULL);
+	v.sz = 2 * ZSL_FFT_MAX_N;
+	rc = zsl_ifft_real(&v);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/filter.h>
+#include "floatcheck.h"
+
+static const zsl_real_t flt_h[5] = { 0.1, 0.2, 0.4, 0.2, 0.1 };
+
+static const struct zsl_biquad flt_bq[2] = {
+	/* 2nd-order Butterworth low-pass at 0.1 fs. */
+	{ 0.0674552739, 0.1349105478, 0.0674552739,
+	  -1.1429805025, 0.4128015981 },
+	/* A pair of zeros at Nyquist, with a single pole at 0.5. */
+	{ 0.25, 0.5, 0.25, -0.5, 0.0 },
+};
+
+/* A deterministic test signal. */
+static zsl_real_t flt_x(size_t i)
+{
+	return ZSL_SIN(0.37 * i) + 0.5 * (zsl_real_t)((i * 7) % 3);
+}
+
+void test_fir_process(void)
+{
+	int rc;
+	zsl_real_t y;
+	zsl_real_t in[12];
+	zsl_real_t in3[36];
+	struct zsl_vec v = { .sz = 12, .data = in };
+	struct zsl_vec v3 = { .sz = 36, .data = in3 };
+
+	ZSL_FIR_DEF(f, 5, 1, flt_h);
+	ZSL_FIR_DEF(f3, 5, 3, flt_h);
+
+	rc = zsl_fir_init(&f);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_fir_init(&f3);
+	zassert_true(rc == 0, NULL);
+
+	/* The impulse response is 'h', also across two blocks. */
+	for (size_t i = 0; i < 12; i++) {
+		in[i] = (i == 0) ? 1.0 : 0.0;
+	}
+	v.sz = 3;
+	rc = zsl_fir_process(&f, &v);
+	zassert_true(rc == 0, NULL);
+	v.sz = 9;
+	v.data = &in[3];
+	rc = zsl_fir_process(&f, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 12; i++) {
+		zassert_true(val_is_equal(in[i], i < 5 ? flt_h[i] : 0.0, 1E-6),
+			     NULL);
+	}
+
+	/* Three interleaved channels match the direct convolution. */
+	for (size_t i = 0; i < 36; i++) {
+		in3[i] = flt_x(i);
+	}
+	rc = zsl_fir_process(&f3, &v3);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 12; i++) {
+		for (size_t c = 0; c < 3; c++) {
+			y = 0.0;
+			for (size_t k = 0; k < 5 && k <= i; k++) {
+				y += flt_h[k] * flt_x((i - k) * 3 + c);
+			}
+			zassert_true(val_is_equal(in3[i * 3 + c], y, 1E-5),
+				     NULL);
+		}
+	}
+
+	v3.sz = 35;
+	rc = zsl_fir_process(&f3, &v3);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_fir_decim_interp(void)
+{
+	int rc;
+	zsl_real_t full[24];
+	zsl_real_t dec[24];
+	zsl_real_t up[24];
+	zsl_real_t stuffed[24];
+	struct zsl_vec vf = { .sz = 24, .data = full };
+	struct zsl_vec vd = { .sz = 24, .data = dec };
+	struct zsl_vec wd = { .sz = 8, .data = dec };
+	struct zsl_vec vu = { .sz = 8, .data = up };
+	struct zsl_vec wu = { .sz = 24, .data = stuffed };
+
+	ZSL_FIR_DEF(f, 5, 1, flt_h);
+	ZSL_FIR_DEF(fd, 5, 1, flt_h);
+
+	/* Decimating by 3 in place keeps every third output. */
+	zsl_fir_init(&f);
+	zsl_fir_init(&fd);
+	for (size_t i = 0; i < 24; i++) {
+		full[i] = flt_x(i);
+		dec[i] = flt_x(i);
+	}
+	zsl_fir_process(&f, &vf);
+	rc = zsl_fir_decim(&fd, 3, &vd, &wd);
+	zassert_true(rc == 0, NULL);
+	for (size_t j = 0; j < 8; j++) {
+		zassert_true(val_is_equal(dec[j], full[j * 3 + 2], 1E-6), NULL);
+	}
+
+	/* Interpolating by 3 matches filtering the zero-stuffed input. */
+	zsl_fir_init(&f);
+	zsl_fir_init(&fd);
+	for (size_t i = 0; i < 24; i++) {
+		full[i] = (i % 3 == 0) ? flt_x(i / 3) : 0.0;
+	}
+	for (size_t i = 0; i < 8; i++) {
+		up[i] = flt_x(i);
+	}
+	zsl_fir_process(&f, &vf);
+	rc = zsl_fir_interp(&fd, 3, &vu, &wu);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 24; i++) {
+		zassert_true(val_is_equal(stuffed[i], full[i], 1E-6), NULL);
+	}
+
+	wu.sz = 23;
+	rc = zsl_fir_interp(&fd, 3, &vu, &wu);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fir_decim(&fd, 5, &vd, &wd);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_iir_process(void)
+{
+	int rc;
+	zsl_real_t y[2][20];
+	zsl_real_t s1, s2, x;
+	zsl_real_t in[20];
+	zsl_real_t in2[40];
+	struct zsl_vec v = { .sz = 20, .data = in };
+	struct zsl_vec v2 = { .sz = 40, .data = in2 };
+
+	ZSL_IIR_DEF(f, 2, 1, flt_bq);
+	ZSL_IIR_DEF(f2, 2, 2, flt_bq);
+
+	rc = zsl_iir_init(&f);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_iir_init(&f2);
+	zassert_true(rc == 0, NULL);
+
+	/* The reference, one sample at a time through each section. */
+	for (size_t c = 0; c < 2; c++) {
+		for (size_t i = 0; i < 20; i++) {
+			y[c][i] = flt_x(i * 2 + c);
+		}
+		for (size_t s = 0; s < 2; s++) {
+			s1 = 0.0;
+			s2 = 0.0;
+			for (size_t i = 0; i < 20; i++) {
+				x = y[c][i];
+				y[c][i] = flt_bq[s].b0 * x + s1;
+				s1 = flt_bq[s].b1 * x - flt_bq[s].a1 * y[c][i] +
+				     s2;
+				s2 = flt_bq[s].b2 * x - flt_bq[s].a2 * y[c][i];
+			}
+		}
+	}
+
+	/* One channel, split into two blocks. */
+	for (size_t i = 0; i < 20; i++) {
+		in[i] = flt_x(i * 2);
+	}
+	v.sz = 7;
+	rc = zsl_iir_process(&f, &v);
+	zassert_true(rc == 0, NULL);
+	v.sz = 13;
+	v.data = &in[7];
+	rc = zsl_iir_process(&f, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 20; i++) {
+		zassert_true(val_is_equal(in[i], y[0][i], 1E-5), NULL);
+	}
+
+	/* Two interleaved channels. */
+	for (size_t i = 0; i < 40; i++) {
+		in2[i] = flt_x(i);
+	}
+	rc = zsl_iir_process(&f2, &v2);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 20; i++) {
+		zassert_true(val_is_equal(in2[i * 2], y[0][i], 1E-5), NULL);
+		zassert_true(val_is_equal(in2[i * 2 + 1], y[1][i], 1E-5),
+			     NULL);
+	}
+
+	v2.sz = 39;
+	rc = zsl_iir_process(&f2, &v2);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/fixed.h>
+#include "floatcheck.h"
+
+/**
+ * @brief Q31 scalar arithmetic and conversion unit tests.
+ *
+ * This test verifies the saturating Q31 helpers and the Q15/Q31 and
+ * zsl_real_t conversions.
+ */
+void test_q31_scalar(void)
+{
+	zassert_equal(zsl_q31_from_real(0.5), ZSL_Q31(0.5), NULL);
+	zassert_equal(zsl_q31_from_real(-1.0), ZSL_Q31_MIN, NULL);
+	zassert_equal(zsl_q31_from_real(1.0), ZSL_Q31_MAX, NULL);
+	zassert_equal(zsl_q31_from_real(3.0), ZSL_Q31_MAX, NULL);
+	zassert_equal(zsl_q31_from_real(-3.0), ZSL_Q31_MIN, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(ZSL_Q31(-0.25)), -0.25,
+				  1E-6), NULL);
+
+	/* Saturating add, sub and mult. */
+	zassert_equal(zsl_q31_add(ZSL_Q31(0.75), ZSL_Q31(0.5)), ZSL_Q31_MAX,
+		      NULL);
+	zassert_equal(zsl_q31_sub(ZSL_Q31(-0.75), ZSL_Q31(0.5)), ZSL_Q31_MIN,
+		      NULL);
+	zassert_equal(zsl_q31_add(ZSL_Q31(0.25), ZSL_Q31(-0.5)),
+		      ZSL_Q31(-0.25), NULL);
+	zassert_equal(zsl_q31_mul(ZSL_Q31(0.5), ZSL_Q31(-0.5)),
+		      ZSL_Q31(-0.25), NULL);
+	zassert_equal(zsl_q31_mul(ZSL_Q31_MIN, ZSL_Q31_MIN), ZSL_Q31_MAX,
+		      NULL);
+
+	/* Q15 conversions. */
+	zassert_equal(zsl_q15_to_q31(16384), ZSL_Q31(0.5), NULL);
+	zassert_equal(zsl_q31_to_q15(ZSL_Q31(-0.5)), -16384, NULL);
+	zassert_equal(zsl_q31_to_q15(ZSL_Q31_MAX), INT16_MAX, NULL);
+	zassert_equal(zsl_q31_to_q15(ZSL_Q31_MIN), INT16_MIN, NULL);
+}
+
+/**
+ * @brief Q31 vector unit tests.
+ *
+ * This test verifies the zsl_vec_q31 functions against their zsl_real_t
+ * equivalents.
+ */
+void test_vec_q31(void)
+{
+	int rc;
+	zsl_q31_t d;
+	zsl_real_t x;
+
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(w, 4);
+	ZSL_VECTOR_DEF(r, 4);
+	ZSL_VEC_Q31_DEF(vq, 4);
+	ZSL_VEC_Q31_DEF(wq, 4);
+	ZSL_VEC_Q31_DEF(xq, 4);
+	ZSL_VEC_Q31_DEF(eq, 3);
+
+	zsl_real_t vi[4] = { 0.1, -0.2, 0.3, -0.4 };
+	zsl_real_t wi[4] = { 0.5, 0.25, -0.125, 0.9 };
+
+	zsl_vec_from_arr(&v, vi);
+	zsl_vec_from_arr(&w, wi);
+
+	rc = zsl_vec_q31_from_vec(&v, &vq);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_q31_from_vec(&w, &wq);
+	zassert_equal(rc, 0, NULL);
+
+	/* Round trip. */
+	rc = zsl_vec_q31_to_vec(&vq, &r);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(r.data[i], vi[i], 1E-6), NULL);
+	}
+
+	/* Add and subtract, with saturation. */
+	rc = zsl_vec_q31_add(&vq, &wq, &xq);
+	zassert_equal(rc, 0, NULL);
+	zsl_vec_q31_to_vec(&xq, &r);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(r.data[i], vi[i] + wi[i], 1E-6),
+			     NULL);
+	}
+	rc = zsl_vec_q31_add(&wq, &wq, &xq);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(xq.data[3], ZSL_Q31_MAX, NULL);
+	rc = zsl_vec_q31_sub(&vq, &wq, &xq);
+	zassert_equal(rc, 0, NULL);
+	zsl_vec_q31_to_vec(&xq, &r);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(r.data[i], vi[i] - wi[i], 1E-6),
+			     NULL);
+	}
+	zassert_equal(xq.data[3], ZSL_Q31_MIN, NULL);
+
+	/* Dot product and norm. */
+	rc = zsl_vec_q31_dot(&vq, &wq, &d);
+	zassert_equal(rc, 0, NULL);
+	zsl_vec_dot(&v, &w, &x);
+	zassert_true(val_is_equal(zsl_q31_to_real(d), x, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(zsl_vec_q31_norm(&vq)),
+				  zsl_vec_norm(&v), 1E-6), NULL);
+
+	/* A norm of 1.0 or more saturates. */
+	zassert_equal(zsl_vec_q31_norm(&wq), ZSL_Q31_MAX, NULL);
+
+	/* Scale and negate. */
+	rc = zsl_vec_q31_scalar_mult(&vq, ZSL_Q31(0.5));
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_q31_neg(&vq);
+	zassert_equal(rc, 0, NULL);
+	zsl_vec_q31_to_vec(&vq, &r);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(r.data[i], -0.5 * vi[i], 1E-6), NULL);
+	}
+	xq.data[0] = ZSL_Q31_MIN;
+	zsl_vec_q31_neg(&xq);
+	zassert_equal(xq.data[0], ZSL_Q31_MAX, NULL);
+
+	/* Size mismatches. */
+	rc = zsl_vec_q31_add(&vq, &eq, &xq);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_vec_q31_dot(&vq, &eq, &d);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_vec_q31_from_vec(&v, &eq);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief Q31 matrix unit tests.
+ *
+ * This test verifies the zsl_mtx_q31 functions against their zsl_real_t
+ * equivalents.
+ */
+void test_mtx_q31(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(ma, 2, 3);
+	ZSL_MATRIX_DEF(mb, 3, 2);
+	ZSL_MATRIX_DEF(mc, 2, 2);
+	ZSL_MATRIX_DEF(mr, 2, 2);
+	ZSL_MATRIX_DEF(mt, 3, 2);
+	ZSL_MTX_Q31_DEF(qa, 2, 3);
+	ZSL_MTX_Q31_DEF(qb, 3, 2);
+	ZSL_MTX_Q31_DEF(qc, 2, 2);
+	ZSL_MTX_Q31_DEF(qt, 3, 2);
+
+	zsl_real_t a[6] = {
+		0.1, -0.2, 0.3,
+		0.4, 0.5, -0.6
+	};
+	zsl_real_t b[6] = {
+		0.7, -0.1,
+		0.2, 0.3,
+		-0.5, 0.4
+	};
+
+	zsl_mtx_from_arr(&ma, a);
+	zsl_mtx_from_arr(&mb, b);
+	zsl_mtx_q31_from_mtx(&ma, &qa);
+	zsl_mtx_q31_from_mtx(&mb, &qb);
+
+	/* Multiply. */
+	rc = zsl_mtx_q31_mult(&qa, &qb, &qc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&ma, &mb, &mc);
+	rc = zsl_mtx_q31_to_mtx(&qc, &mr);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(mr.data[i], mc.data[i], 1E-6), NULL);
+	}
+
+	/* Transpose, then add and subtract. */
+	rc = zsl_mtx_q31_trans(&qa, &qt);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_add(&qt, &qb, &qt);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_q31_to_mtx(&qt, &mt);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			zassert_true(val_is_equal(mt.data[i * 2 + j],
+						  a[j * 3 + i] + b[i * 2 + j],
+						  1E-6), NULL);
+		}
+	}
+	rc = zsl_mtx_q31_sub(&qt, &qb, &qt);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_q31_scalar_mult(&qt, ZSL_Q31(-0.5));
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_q31_to_mtx(&qt, &mt);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			zassert_true(val_is_equal(mt.data[i * 2 + j],
+						  -0.5 * a[j * 3 + i], 1E-6),
+				     NULL);
+		}
+	}
+
+	/* Shape mismatches. */
+	rc = zsl_mtx_q31_mult(&qa, &qa, &qc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_q31_add(&qa, &qb, &qa);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_q31_trans(&qa, &qa);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief Q31 quaternion unit tests.
+ *
+ * This test verifies the zsl_quat_q31 functions against their zsl_real_t
+ * equivalents.
+ */
+void test_quat_q31(void)
+{
+	int rc;
+	struct zsl_quat qa = { .r = 0.5, .i = -0.5, .j = 0.5, .k = 0.5 };
+	struct zsl_quat qb = { .r = 0.1, .i = 0.2, .j = -0.3, .k = 0.4 };
+	struct zsl_quat qm, qr;
+	struct zsl_quat_q31 xa, xb, xm;
+
+	zsl_quat_q31_from_quat(&qa, &xa);
+	zsl_quat_q31_from_quat(&qb, &xb);
+
+	/* Hamilton product, in place. */
+	zsl_quat_mult(&qa, &qb, &qm);
+	rc = zsl_quat_q31_mult(&xa, &xb, &xb);
+	zassert_equal(rc, 0, NULL);
+	zsl_quat_q31_to_quat(&xb, &qr);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(qr.idx[i], qm.idx[i], 1E-6), NULL);
+	}
+
+	/* Norm, normalisation and conjugate. */
+	zsl_quat_q31_from_quat(&qb, &xb);
+	zassert_true(val_is_equal(zsl_q31_to_real(zsl_quat_q31_magn(&xb)),
+				  zsl_quat_magn(&qb), 1E-6), NULL);
+	rc = zsl_quat_q31_to_unit(&xb, &xm);
+	zassert_equal(rc, 0, NULL);
+	zsl_quat_to_unit(&qb, &qm);
+	zsl_quat_q31_to_quat(&xm, &qr);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(qr.idx[i], qm.idx[i], 1E-6), NULL);
+	}
+	zassert_true(zsl_quat_q31_magn(&xm) >= ZSL_Q31_MAX - 8, NULL);
+
+	/* q * conj(q) = |q|^2 for a unit quaternion: (1, 0, 0, 0). */
+	rc = zsl_quat_q31_conj(&xa, &xb);
+	zassert_equal(rc, 0, NULL);
+	zsl_quat_q31_mult(&xa, &xb, &xm);
+	zassert_equal(xm.r, ZSL_Q31_MAX, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(xm.i), 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(xm.j), 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(xm.k), 0.0, 1E-6), NULL);
+
+	/* Scale. */
+	rc = zsl_quat_q31_scale(&xa, ZSL_Q31(0.5), &xm);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(xm.i, ZSL_Q31(-0.25), NULL);
+
+	/* A zero quaternion normalises to zero. */
+	xm.r = xm.i = xm.j = xm.k = 0;
+	zsl_quat_q31_to_unit(&xm, &xm);
+	zassert_equal(xm.r, 0, NULL);
+}
+
+/**
+ * @brief zsl_interp_lin_y_arr_q31 unit tests.
+ *
+ * This test verifies the zsl_interp_lin_y_arr_q31 function in ascending
+ * and descending order.
+ */
+void test_interp_lin_y_arr_q31(void)
+{
+	int rc;
+	zsl_q31_t y;
+
+	struct zsl_interp_xy_q31 xy[4] = {
+		{ .x = ZSL_Q31(-0.5), .y = ZSL_Q31(0.25) },
+		{ .x = ZSL_Q31(0.0), .y = ZSL_Q31(-0.75) },
+		{ .x = ZSL_Q31(0.25), .y = ZSL_Q31(0.5) },
+		{ .x = ZSL_Q31(0.75), .y = ZSL_Q31(0.5) }
+	};
+	struct zsl_interp_xy_q31 xyd[3] = {
+		{ .x = ZSL_Q31(0.5), .y = ZSL_Q31(0.0) },
+		{ .x = ZSL_Q31(0.0), .y = ZSL_Q31(0.5) },
+		{ .x = ZSL_Q31(-0.5), .y = ZSL_Q31(-0.5) }
+	};
+
+	rc = zsl_interp_lin_y_arr_q31(xy, 4, ZSL_Q31(-0.25), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(y), -0.25, 1E-6), NULL);
+
+	rc = zsl_interp_lin_y_arr_q31(xy, 4, ZSL_Q31(0.125), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(y), -0.125, 1E-6), NULL);
+
+	/* End points. */
+	rc = zsl_interp_lin_y_arr_q31(xy, 4, ZSL_Q31(0.75), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(y, ZSL_Q31(0.5), NULL);
+	rc = zsl_interp_lin_y_arr_q31(xy, 4, ZSL_Q31(-0.5), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(y, ZSL_Q31(0.25), NULL);
+
+	/* Full-scale end points don't overflow. */
+	xyd[0].x = ZSL_Q31_MAX;
+	xyd[2].x = ZSL_Q31_MIN;
+	xyd[2].y = ZSL_Q31_MIN;
+	rc = zsl_interp_lin_y_arr_q31(xyd, 3, ZSL_Q31(-0.5), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(y), -0.25, 1E-6), NULL);
+
+	/* Descending order. */
+	rc = zsl_interp_lin_y_arr_q31(xyd, 3, ZSL_Q31(0.25), &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(y), 0.375, 1E-6), NULL);
+
+	/* Out of range, and too few points. */
+	rc = zsl_interp_lin_y_arr_q31(xy, 4, ZSL_Q31(0.875), &y);
+	zassert_equal(rc, -EINVAL, NULL);
+	zassert_equal(y, 0, NULL);
+	rc = zsl_interp_lin_y_arr_q31(xy, 1, ZSL_Q31(-0.5), &y);
+	zassert_equal(rc, -EINVAL, NULL);
+}
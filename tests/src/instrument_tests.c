@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/instrument.h>
+
+#if CONFIG_ZSL_TRACE
+static uint32_t trace_enter[ZSL_TRACE_COUNT];
+static uint32_t trace_exit[ZSL_TRACE_COUNT];
+
+void zsl_trace_hook_enter(enum zsl_trace_id id)
+{
+	trace_enter[id]++;
+}
+
+void zsl_trace_hook_exit(enum zsl_trace_id id, uint32_t cycles)
+{
+	(void)cycles;
+	trace_exit[id]++;
+}
+
+/**
+ * @brief zsl_trace_hook_enter, zsl_trace_hook_exit and zsl_trace_stats
+ *        unit tests.
+ *
+ * This test verifies that traced functions report each call to the hooks
+ * and, when enabled, to the histogram.
+ */
+void test_trace_hooks(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(mc, 2, 2);
+
+	zsl_real_t a[4] = { 1.0, 2.0, 3.0, 4.0 };
+	struct zsl_mtx ma = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = a
+	};
+
+	memset(trace_enter, 0, sizeof(trace_enter));
+	memset(trace_exit, 0, sizeof(trace_exit));
+#if CONFIG_ZSL_TRACE_HIST
+	zsl_trace_reset();
+#endif
+
+	rc = zsl_mtx_mult(&ma, &ma, &mc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&ma, &ma, &mc);
+	zassert_equal(rc, 0, NULL);
+
+	zassert_equal(trace_enter[ZSL_TRACE_MTX_MULT], 2, NULL);
+	zassert_equal(trace_exit[ZSL_TRACE_MTX_MULT], 2, NULL);
+	zassert_equal(trace_enter[ZSL_TRACE_MTX_SVD], 0, NULL);
+	zassert_true(strcmp(zsl_trace_name(ZSL_TRACE_MTX_MULT),
+			    "zsl_mtx_mult") == 0, NULL);
+	zassert_is_null(zsl_trace_name(ZSL_TRACE_COUNT), NULL);
+
+#if CONFIG_ZSL_TRACE_HIST
+	struct zsl_trace_stats st;
+	uint32_t n = 0;
+
+	rc = zsl_trace_stats(ZSL_TRACE_MTX_MULT, &st);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(st.calls, 2, NULL);
+	zassert_true(st.min <= st.max, NULL);
+	zassert_true(st.total >= st.max, NULL);
+	for (int i = 0; i < ZSL_TRACE_HIST_BINS; i++) {
+		n += st.hist[i];
+	}
+	zassert_equal(n, 2, NULL);
+
+	rc = zsl_trace_stats(ZSL_TRACE_COUNT, &st);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	zsl_trace_reset();
+	zsl_trace_stats(ZSL_TRACE_MTX_MULT, &st);
+	zassert_equal(st.calls, 0, NULL);
+#endif
+}
+#endif
@@ -505,3 +505,412 @@ void test_interp_cubic_arr(void)
     rc = zsl_interp_cubic_arr(xyc, 2, x, &y);
     zassert_equal(rc, -EINVAL, NULL);
 }
+
+void test_interp_cached(void)
+{
+    int rc, rc2;
+    int idx, idx2;
+    size_t i;
+    zsl_real_t x, y, y2;
+    struct zsl_interp_cache c;
+    struct zsl_interp_xy xy[20];
+    struct zsl_interp_xyc xyc[7];
+
+    /* An ascending table with uneven spacing. */
+    for (i = 0; i < 20; i++) {
+        xy[i].x = (zsl_real_t)(i * i);
+        xy[i].y = (zsl_real_t)i;
+    }
+
+    rc = zsl_interp_cache_init(&c, xy, 20);
+    zassert_equal(rc, 0, NULL);
+
+    /* Test 1: Slow sweep up, then down, then jumps, including
+     * out-of-range values, must match zsl_interp_find_x. */
+    for (i = 0; i < 800; i++) {
+        if (i < 400) {
+            x = -5.0f + (zsl_real_t)i;
+        } else if (i < 600) {
+            x = 400.0f - 2.0f * (zsl_real_t)(i - 400);
+        } else {
+            x = (zsl_real_t)((i * 7919) % 390) - 10.0f;
+        }
+        rc = zsl_interp_find_x_cached(&c, xy, x, &idx);
+        rc2 = zsl_interp_find_x(xy, 20, x, &idx2);
+        zassert_equal(rc, rc2, NULL);
+        zassert_equal(idx, idx2, NULL);
+    }
+
+    /* Test 2: The end points. */
+    rc = zsl_interp_find_x_cached(&c, xy, 361.0f, &idx);
+    zassert_equal(rc, 0, NULL);
+    zassert_equal(idx, 18, NULL);
+    rc = zsl_interp_find_x_cached(&c, xy, 0.0f, &idx);
+    zassert_equal(rc, 0, NULL);
+    zassert_equal(idx, 0, NULL);
+
+    /* Test 3: Linear interpolation. */
+    rc = zsl_interp_lin_y_cached(&c, xy, 12.5f, &y);
+    zassert_equal(rc, 0, NULL);
+    zassert_true(val_is_equal(y, 3.5f, 1E-4F), NULL);
+    rc = zsl_interp_lin_y_cached(&c, xy, 400.0f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+    rc = zsl_interp_nn_cached(&c, xy, 12.5f, &y);
+    rc2 = zsl_interp_nn_arr(xy, 20, 12.5f, &y2);
+    zassert_equal(rc, rc2, NULL);
+    zassert_true(val_is_equal(y, y2, 1E-4F), NULL);
+
+    /* Test 4: A descending table. */
+    for (i = 0; i < 20; i++) {
+        xy[i].x = 100.0f - (zsl_real_t)(i * 5);
+    }
+    rc = zsl_interp_cache_init(&c, xy, 20);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 120; i++) {
+        x = 105.0f - (zsl_real_t)i;
+        rc = zsl_interp_find_x_cached(&c, xy, x, &idx);
+        rc2 = zsl_interp_find_x(xy, 20, x, &idx2);
+        zassert_equal(rc, rc2, NULL);
+        zassert_equal(idx, idx2, NULL);
+    }
+
+    /* Test 5: Cubic spline, matching zsl_interp_cubic_arr. */
+    memset(xyc, 0, sizeof xyc);
+    for (i = 0; i < 7; i++) {
+        xyc[i].x = (zsl_real_t)i - 3.0f;
+    }
+    xyc[1].y = 1.0f;
+    xyc[2].y = 2.0f;
+    xyc[3].y = .75f;
+    xyc[5].y = 2.5f;
+    xyc[6].y = -1.25f;
+    rc = zsl_interp_cubic_calc(xyc, 7, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+    rc = zsl_interp_cache_init_xyc(&c, xyc, 7);
+    zassert_equal(rc, 0, NULL);
+    for (x = 2.9f; x > -3.0f; x -= 0.3f) {
+        rc = zsl_interp_cubic_cached(&c, xyc, x, &y);
+        zassert_equal(rc, 0, NULL);
+        rc = zsl_interp_cubic_arr(xyc, 7, x, &y2);
+        zassert_equal(rc, 0, NULL);
+        zassert_true(val_is_equal(y, y2, 1E-5F), NULL);
+    }
+    rc = zsl_interp_cubic_cached(&c, xyc, 3.5f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+
+    /* Test 6: Tables too small. */
+    rc = zsl_interp_cache_init(&c, xy, 1);
+    zassert_equal(rc, -EINVAL, NULL);
+    rc = zsl_interp_cache_init_xyc(&c, xyc, 2);
+    zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_interp_grid(void)
+{
+    int rc;
+    size_t i;
+    zsl_real_t x, y, y2;
+    zsl_real_t gy[7] = { 0.0f, 1.0f, 2.0f, .75f, 0.0f, 2.5f, -1.25f };
+    zsl_real_t gy2[7];
+    struct zsl_interp_xy xy[7];
+    struct zsl_interp_xyc xyc[7];
+    struct zsl_interp_grid g = {
+        .x0 = -3.0f,
+        .dx = 0.5f,
+        .n = 7,
+        .y = gy,
+        .y2 = gy2
+    };
+
+    for (i = 0; i < 7; i++) {
+        xy[i].x = xyc[i].x = -3.0f + 0.5f * (zsl_real_t)i;
+        xy[i].y = xyc[i].y = gy[i];
+        xyc[i].y2 = 0.0f;
+    }
+
+    /* Test 1: Linear and nearest neighbour lookups, including the ends. */
+    rc = zsl_interp_grid_lin(&g, -2.25f, &y);
+    zassert_equal(rc, 0, NULL);
+    zassert_true(val_is_equal(y, 1.5f, 1E-5F), NULL);
+    for (x = -3.0f; x <= 0.0f; x += 0.125f) {
+        rc = zsl_interp_grid_lin(&g, x, &y);
+        zassert_equal(rc, 0, NULL);
+        rc = zsl_interp_lin_y_arr(xy, 7, x, &y2);
+        zassert_equal(rc, 0, NULL);
+        zassert_true(val_is_equal(y, y2, 1E-5F), NULL);
+    }
+    rc = zsl_interp_grid_nn(&g, -2.2f, &y);
+    zassert_equal(rc, 0, NULL);
+    zassert_true(val_is_equal(y, 2.0f, 1E-5F), NULL);
+    rc = zsl_interp_grid_nn(&g, -2.8f, &y);
+    zassert_equal(rc, 0, NULL);
+    zassert_true(val_is_equal(y, 0.0f, 1E-5F), NULL);
+
+    /* Test 2: The cubic spline matches the X,Y,Y2 table. */
+    rc = zsl_interp_grid_cubic_calc(&g, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+    rc = zsl_interp_cubic_calc(xyc, 7, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 7; i++) {
+        zassert_true(val_is_equal(gy2[i], xyc[i].y2, 1E-4F), NULL);
+    }
+    for (x = -2.9f; x < 0.0f; x += 0.2f) {
+        rc = zsl_interp_grid_cubic(&g, x, &y);
+        zassert_equal(rc, 0, NULL);
+        rc = zsl_interp_cubic_arr(xyc, 7, x, &y2);
+        zassert_equal(rc, 0, NULL);
+        zassert_true(val_is_equal(y, y2, 1E-4F), NULL);
+    }
+
+    /* Test 3: Clamped end derivatives. */
+    rc = zsl_interp_grid_cubic_calc(&g, 1.0f, -2.0f);
+    zassert_equal(rc, 0, NULL);
+    rc = zsl_interp_cubic_calc(xyc, 7, 1.0f, -2.0f);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 7; i++) {
+        zassert_true(val_is_equal(gy2[i], xyc[i].y2, 1E-4F), NULL);
+    }
+
+    /* Test 4: Out of range and invalid grids. */
+    rc = zsl_interp_grid_lin(&g, 0.01f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+    rc = zsl_interp_grid_cubic(&g, -3.01f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+    g.dx = 0.0f;
+    rc = zsl_interp_grid_lin(&g, -3.0f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+    g.dx = 0.5f;
+    g.y2 = NULL;
+    rc = zsl_interp_grid_cubic_calc(&g, 1e30, 1e30);
+    zassert_equal(rc, -EINVAL, NULL);
+    rc = zsl_interp_grid_cubic(&g, -2.0f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_interp_batch(void)
+{
+    int rc;
+    size_t i;
+    zsl_real_t xs[64];
+    zsl_real_t ys[64];
+    zsl_real_t y;
+    struct zsl_interp_xy xy[16];
+    struct zsl_interp_xyc xyc[16];
+
+    for (i = 0; i < 16; i++) {
+        xy[i].x = xyc[i].x = (zsl_real_t)i * 0.25f;
+        xy[i].y = xyc[i].y = (zsl_real_t)((i * 5) % 7);
+        xyc[i].y2 = 0.0f;
+    }
+    rc = zsl_interp_cubic_calc(xyc, 16, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+
+    /* Test 1: Sorted queries match one-off lookups. */
+    for (i = 0; i < 64; i++) {
+        xs[i] = (zsl_real_t)i * 3.75f / 63.0f;
+    }
+    rc = zsl_interp_lin_y_batch(xy, 16, xs, ys, 64);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 64; i++) {
+        zsl_interp_lin_y_arr(xy, 16, xs[i], &y);
+        zassert_true(val_is_equal(ys[i], y, 1E-5F), NULL);
+    }
+    rc = zsl_interp_cubic_batch(xyc, 16, xs, ys, 64);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 64; i++) {
+        zsl_interp_cubic_arr(xyc, 16, xs[i], &y);
+        zassert_true(val_is_equal(ys[i], y, 1E-4F), NULL);
+    }
+
+    /* Test 2: Unsorted queries, in place, with one out of range. */
+    for (i = 0; i < 64; i++) {
+        xs[i] = (zsl_real_t)((i * 37) % 64) * 3.75f / 63.0f;
+    }
+    xs[10] = 4.0f;
+    rc = zsl_interp_lin_y_batch(xy, 16, xs, xs, 64);
+    zassert_equal(rc, -EINVAL, NULL);
+    zassert_true(isnan(xs[10]), NULL);
+    for (i = 0; i < 64; i++) {
+        if (i == 10) {
+            continue;
+        }
+        zsl_interp_lin_y_arr(xy, 16,
+                             (zsl_real_t)((i * 37) % 64) * 3.75f / 63.0f, &y);
+        zassert_true(val_is_equal(xs[i], y, 1E-5F), NULL);
+    }
+
+    /* Test 3: Tables too small. */
+    rc = zsl_interp_lin_y_batch(xy, 1, xs, ys, 64);
+    zassert_equal(rc, -EINVAL, NULL);
+    rc = zsl_interp_cubic_batch(xyc, 2, xs, ys, 64);
+    zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_interp_spline(void)
+{
+    int rc;
+    size_t i;
+    zsl_real_t x, y, y2, prev;
+    struct zsl_interp_xy xy[8];
+    struct zsl_interp_xyc xyc[8];
+
+    ZSL_INTERP_SPLINE_DEF(sp, 8);
+
+    zsl_real_t ya[8] = { 0.0f, 1.0f, 2.0f, .75f, 0.0f, 2.5f, -1.25f, 0.5f };
+    zsl_real_t step[8] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.2f };
+
+    for (i = 0; i < 8; i++) {
+        xy[i].x = xyc[i].x = (zsl_real_t)i + 0.1f * (zsl_real_t)(i * i);
+        xy[i].y = xyc[i].y = ya[i];
+        xyc[i].y2 = 0.0f;
+    }
+
+    /* Test 1: The natural spline matches zsl_interp_cubic_arr. */
+    rc = zsl_interp_spline_natural(&sp, xy, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+    rc = zsl_interp_cubic_calc(xyc, 8, 1e30, 1e30);
+    zassert_equal(rc, 0, NULL);
+    for (x = 0.05f; x < 11.9f; x += 0.4f) {
+        rc = zsl_interp_spline_eval(&sp, x, &y);
+        zassert_equal(rc, 0, NULL);
+        zsl_interp_cubic_arr(xyc, 8, x, &y2);
+        zassert_true(val_is_equal(y, y2, 1E-4F), NULL);
+    }
+
+    /* Test 2: Clamped ends match too. */
+    zsl_interp_spline_natural(&sp, xy, 0.5f, -1.0f);
+    zsl_interp_cubic_calc(xyc, 8, 0.5f, -1.0f);
+    for (x = 0.05f; x < 11.9f; x += 0.4f) {
+        zsl_interp_spline_eval(&sp, x, &y);
+        zsl_interp_cubic_arr(xyc, 8, x, &y2);
+        zassert_true(val_is_equal(y, y2, 1E-4F), NULL);
+    }
+
+    /* Test 3: PCHIP and Akima go through the points, and reproduce a
+     * straight line exactly. */
+    rc = zsl_interp_spline_pchip(&sp, xy);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 8; i++) {
+        zsl_interp_spline_eval(&sp, xy[i].x, &y);
+        zassert_true(val_is_equal(y, ya[i], 1E-5F), NULL);
+    }
+    rc = zsl_interp_spline_akima(&sp, xy);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 8; i++) {
+        zsl_interp_spline_eval(&sp, xy[i].x, &y);
+        zassert_true(val_is_equal(y, ya[i], 1E-5F), NULL);
+    }
+    for (i = 0; i < 8; i++) {
+        xy[i].y = 2.0f * xy[i].x - 1.0f;
+    }
+    zsl_interp_spline_pchip(&sp, xy);
+    zsl_interp_spline_eval(&sp, 4.3f, &y);
+    zassert_true(val_is_equal(y, 7.6f, 1E-4F), NULL);
+    zsl_interp_spline_akima(&sp, xy);
+    zsl_interp_spline_eval(&sp, 4.3f, &y);
+    zassert_true(val_is_equal(y, 7.6f, 1E-4F), NULL);
+
+    /* Test 4: PCHIP keeps a step monotonic, with no overshoot. */
+    for (i = 0; i < 8; i++) {
+        xy[i].y = step[i];
+    }
+    zsl_interp_spline_pchip(&sp, xy);
+    prev = -1.0f;
+    for (x = 0.0f; x <= 11.9f; x += 0.05f) {
+        rc = zsl_interp_spline_eval(&sp, x, &y);
+        zassert_equal(rc, 0, NULL);
+        zassert_true(y >= prev - 1E-6F, NULL);
+        zassert_true(y >= -1E-6F && y <= 1.2f + 1E-6F, NULL);
+        prev = y;
+    }
+
+    /* Test 5: Akima stays flat away from the step. */
+    zsl_interp_spline_akima(&sp, xy);
+    zsl_interp_spline_eval(&sp, 1.5f, &y);
+    zassert_true(val_is_equal(y, 0.0f, 1E-6F), NULL);
+    zsl_interp_spline_eval(&sp, 7.0f, &y);
+    zassert_true(val_is_equal(y, 1.0f, 1E-6F), NULL);
+
+    /* Test 6: Out of range and invalid x. */
+    rc = zsl_interp_spline_eval(&sp, 12.0f, &y);
+    zassert_equal(rc, -EINVAL, NULL);
+    xy[3].x = xy[2].x;
+    rc = zsl_interp_spline_pchip(&sp, xy);
+    zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_interp_grid2(void)
+{
+    int rc;
+    size_t i, j;
+    zsl_real_t x, y, z, e;
+    zsl_real_t ax[5] = { -40.0f, -10.0f, 25.0f, 60.0f, 85.0f };
+    zsl_real_t ay[4] = { 1.8f, 2.5f, 3.3f, 3.6f };
+    zsl_real_t az[5 * 4];
+    zsl_real_t xs[6] = { -40.0f, 85.0f, 0.0f, 30.0f, 31.0f, 90.0f };
+    zsl_real_t ys[6] = { 1.8f, 3.6f, 2.0f, 3.0f, 3.0f, 3.0f };
+    zsl_real_t zs[6];
+    struct zsl_interp_grid2 g = {
+        .x = ax,
+        .nx = 5,
+        .y = ay,
+        .ny = 4,
+        .z = az
+    };
+
+    /* Test 1: Bilinear is exact for z = 1 + 2x - y + 0.5xy. */
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < 4; j++) {
+            az[i * 4 + j] = 1.0f + 2.0f * ax[i] - ay[j] +
+                            0.5f * ax[i] * ay[j];
+        }
+    }
+    rc = zsl_interp_grid2_init(&g);
+    zassert_equal(rc, 0, NULL);
+    for (x = -40.0f; x <= 85.0f; x += 5.0f) {
+        for (y = 1.8f; y <= 3.6f; y += 0.15f) {
+            e = 1.0f + 2.0f * x - y + 0.5f * x * y;
+            rc = zsl_interp_grid2_bilin(&g, x, y, &z);
+            zassert_equal(rc, 0, NULL);
+            zassert_true(val_is_equal(z, e, 1E-3F), NULL);
+            rc = zsl_interp_grid2_bicubic(&g, x, y, &z);
+            zassert_equal(rc, 0, NULL);
+            zassert_true(val_is_equal(z, e, 1E-3F), NULL);
+        }
+    }
+
+    /* Test 2: Bicubic is exact for a quadratic in x away from the edges. */
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < 4; j++) {
+            az[i * 4 + j] = 0.01f * ax[i] * ax[i] + ay[j];
+        }
+    }
+    for (x = -10.0f; x <= 60.0f; x += 5.0f) {
+        rc = zsl_interp_grid2_bicubic(&g, x, 2.9f, &z);
+        zassert_equal(rc, 0, NULL);
+        zassert_true(val_is_equal(z, 0.01f * x * x + 2.9f, 1E-3F), NULL);
+    }
+
+    /* Test 3: Batches, with one point out of range. */
+    rc = zsl_interp_grid2_bilin_batch(&g, xs, ys, zs, 6);
+    zassert_equal(rc, -EINVAL, NULL);
+    zassert_true(isnan(zs[5]), NULL);
+    for (i = 0; i < 5; i++) {
+        zsl_interp_grid2_bilin(&g, xs[i], ys[i], &z);
+        zassert_true(val_is_equal(zs[i], z, 1E-5F), NULL);
+    }
+    rc = zsl_interp_grid2_bicubic_batch(&g, xs, ys, zs, 5);
+    zassert_equal(rc, 0, NULL);
+    for (i = 0; i < 5; i++) {
+        zsl_interp_grid2_bicubic(&g, xs[i], ys[i], &z);
+        zassert_true(val_is_equal(zs[i], z, 1E-5F), NULL);
+    }
+
+    /* Test 4: Invalid axes. */
+    ax[2] = ax[1];
+    rc = zsl_interp_grid2_init(&g);
+    zassert_equal(rc, -EINVAL, NULL);
+    g.ny = 1;
+    rc = zsl_interp_grid2_init(&g);
+    zassert_equal(rc, -EINVAL, NULL);
+}
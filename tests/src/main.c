@@ -7,14 +7,68 @@
 #include <ztest.h>
 
 extern void test_conv_spd_xyz(void);
+extern void test_conv_spd_xyz_compiled(void);
+extern void test_conv_spd_soa_xyz(void);
+extern void test_clr_lef_integ(void);
+extern void test_clr_data_get(void);
+extern void test_clr_cct_pipe(void);
+extern void test_clr_ccm_fit(void);
+extern void test_conv_xyz_cat(void);
 extern void test_conv_ct_xyz(void);
+extern void test_conv_ct_xyz_lut(void);
 extern void test_conv_ct_rgb8(void);
+extern void test_conv_xyz_rgb_arr(void);
+extern void test_conv_srgb(void);
 extern void test_conv_cct_xyy(void);
 extern void test_conv_cct_xyz(void);
 extern void test_conv_uv60_cct_ohno2011(void);
 extern void test_conv_uv60_cct_ohno2014(void);
+extern void test_conv_uv60_cct_ohno2014_fast(void);
 
 extern void test_complex_add(void);
+extern void test_cplx_scalar(void);
+extern void test_cvec_ops(void);
+extern void test_cmtx_mult(void);
+extern void test_mtx_eigenvalues_cplx(void);
+
+extern void test_fft_cplx(void);
+extern void test_fft_real(void);
+
+extern void test_fir_process(void);
+extern void test_fir_decim_interp(void);
+extern void test_blk_process(void);
+extern void test_pipe_run(void);
+extern void test_iir_process(void);
+
+extern void test_conv(void);
+extern void test_xcorr(void);
+
+extern void test_chem_elem_props(void);
+extern void test_chem_formula(void);
+extern void test_chem_gas_conc(void);
+
+extern void test_mes_wire_hdr(void);
+extern void test_mes_wire_enc_dec(void);
+extern void test_mes_wire_encv(void);
+extern void test_mes_cbor_enc(void);
+extern void test_mes_cbor_dec(void);
+extern void test_mes_lz4_comp(void);
+extern void test_mes_lz4_delta(void);
+extern void test_mes_text_b64(void);
+extern void test_mes_text_b45(void);
+extern void test_mes_text_mes(void);
+extern void test_mes_frag_split(void);
+extern void test_mes_frag_reasm(void);
+extern void test_mes_frag_reasm_dst(void);
+extern void test_mes_store_add_find(void);
+extern void test_mes_store_iter(void);
+extern void test_mes_conv_factor(void);
+extern void test_mes_conv_vals(void);
+extern void test_mes_route(void);
+extern void test_mes_route_full(void);
+extern void test_mes_batch(void);
+extern void test_sns_conv(void);
+extern void test_mes_log(void);
 
 extern void test_interp_lerp(void);
 extern void test_interp_find_x_asc(void);
@@ -25,19 +79,43 @@ extern void test_interp_lin_y(void);
 extern void test_interp_lin_y_arr(void);
 extern void test_interp_lin_x(void);
 extern void test_interp_cubic_arr(void);
+extern void test_interp_cached(void);
+extern void test_interp_grid(void);
+extern void test_interp_batch(void);
+extern void test_interp_spline(void);
+extern void test_interp_grid2(void);
+
+extern void test_q31_scalar(void);
+extern void test_vec_q31(void);
+extern void test_mtx_q31(void);
+extern void test_quat_q31(void);
+extern void test_interp_lin_y_arr_q31(void);
+
+extern void test_ode_rk4(void);
+extern void test_ode_rk45(void);
+extern void test_ode_verlet(void);
+
+extern void test_spmtx_conv(void);
+extern void test_spmtx_const(void);
+extern void test_spmtx_mult_vec(void);
+extern void test_spmtx_mult(void);
+extern void test_spmtx_cg(void);
 
 extern void test_matrix_init(void);
 extern void test_matrix_from_arr(void);
+extern void test_matrix_const(void);
 extern void test_matrix_copy(void);
 extern void test_matrix_get(void);
 extern void test_matrix_set(void);
 extern void test_matrix_get_set_row(void);
 extern void test_matrix_get_set_col(void);
+extern void test_matrix_view(void);
 extern void test_matrix_row_from_vec(void);
 extern void test_matrix_unary_op(void);
 extern void test_matrix_unary_func(void);
 extern void test_matrix_binary_op(void);
 extern void test_matrix_binary_func(void);
+extern void test_matrix_func_rows(void);
 extern void test_matrix_add(void);
 extern void test_matrix_add_d(void);
 extern void test_matrix_sum_rows_d(void);
@@ -46,9 +124,15 @@ extern void test_matrix_sub(void);
 extern void test_matrix_sub_d(void);
 extern void test_matrix_mult_sq(void);
 extern void test_matrix_mult_rect(void);
+extern void test_matrix_mult_blocked(void);
+extern void test_matrix_mult_ex(void);
+extern void test_matrix_gemm_axpy_ger(void);
 extern void test_matrix_scalar_mult_d(void);
 extern void test_matrix_scalar_mult_row_d(void);
 extern void test_matrix_trans(void);
+extern void test_matrix_trans_d(void);
+extern void test_matrix_fixed(void);
+extern void test_matrix_fixed_decl(void);
 extern void test_matrix_adjoint_3x3(void);
 extern void test_matrix_adjoint(void);
 extern void test_matrix_reduce(void);
@@ -56,21 +140,44 @@ extern void test_matrix_reduce_iter(void);
 extern void test_matrix_augm_diag(void);
 extern void test_matrix_deter_3x3(void);
 extern void test_matrix_deter(void);
+extern void test_matrix_deter_large(void);
+extern void test_matrix_lu(void);
 extern void test_matrix_gauss_elim(void);
 extern void test_matrix_gauss_elim_d(void);
 extern void test_matrix_gauss_reduc(void);
+extern void test_matrix_gauss_jordan_d(void);
 extern void test_matrix_gram_schmidt_sq(void);
 extern void test_matrix_gram_schmidt_rect(void);
 extern void test_matrix_cols_norm(void);
+extern void test_matrix_gram_schmidt_d(void);
 extern void test_matrix_norm_elem(void);
 extern void test_matrix_norm_elem_d(void);
 extern void test_matrix_inv_3x3(void);
+extern void test_matrix_inv_4x4(void);
 extern void test_matrix_inv(void);
+extern void test_matrix_inv_d(void);
+extern void test_matrix_batch(void);
+extern void test_matrix_cholesky(void);
+extern void test_matrix_chol_solve(void);
+extern void test_matrix_chol_update(void);
+extern void test_matrix_inv_update(void);
+extern void test_matrix_solve(void);
+extern void test_matrix_lu_solve(void);
+extern void test_matrix_rcond(void);
+extern void test_matrix_solve_refine(void);
+extern void test_matrix_expm(void);
+extern void test_matrix_c2d(void);
+extern void test_matrix_trsm(void);
+extern void test_matrix_trsv(void);
 extern void test_matrix_balance(void);
 extern void test_matrix_householder_sq(void);
 extern void test_matrix_householder_rect(void);
 extern void test_matrix_qrd(void);
 extern void test_matrix_qrd_hess(void);
+extern void test_matrix_qr(void);
+extern void test_matrix_schur(void);
+extern void test_matrix_schur_rand(void);
+extern void test_matrix_eigen_sym(void);
 extern void test_matrix_min(void);
 extern void test_matrix_max(void);
 extern void test_matrix_min_idx(void);
@@ -78,6 +185,16 @@ extern void test_matrix_max_idx(void);
 extern void test_matrix_is_equal(void);
 extern void test_matrix_is_notneg(void);
 extern void test_matrix_is_sym(void);
+extern void test_matrix_props(void);
+extern void test_matrix_props_ops(void);
+extern void test_matrix_def_aligned(void);
+
+/* Packed matrix tests. */
+extern void test_pkmtx_convert(void);
+extern void test_pkmtx_mult(void);
+extern void test_pkmtx_solve(void);
+extern void test_ctx_init(void);
+extern void test_ctx_mtx(void);
 
 /* Test for functions that only work with double-precision floats. */
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
@@ -85,13 +202,53 @@ extern void test_matrix_qrd_iter(void);
 extern void test_matrix_eigenvalues(void);
 extern void test_matrix_eigenvectors(void);
 extern void test_matrix_svd(void);
+extern void test_matrix_svd_tall(void);
+extern void test_matrix_svd_rank_deficient(void);
+extern void test_matrix_svd_vals(void);
 extern void test_matrix_pinv(void);
+extern void test_matrix_svd_ws(void);
+extern void test_matrix_pinv_ws(void);
+extern void test_matrix_plan(void);
+extern void test_matrix_plan_step(void);
+extern void test_matrix_eigenvalues_iter(void);
+#endif
+
+extern void test_ws_alloc(void);
+extern void test_ws_mark_release(void);
+extern void test_ws_mtx_vec_alloc(void);
+#if CONFIG_ZSL_SCRATCH_POOL
+extern void test_ws_scratch_pool(void);
+#endif
+#if CONFIG_ZSL_INSTRUMENT
+extern void test_ws_instrument(void);
+#endif
+#if CONFIG_ZSL_TRACE
+extern void test_trace_hooks(void);
 #endif
 
+extern void test_smp_for(void);
+extern void test_smp_mtx(void);
+
+extern void test_rand_u32(void);
+extern void test_rand_dist(void);
+extern void test_rand_fill(void);
+extern void test_mc_run(void);
+extern void test_dual_ops(void);
+extern void test_dual_propagate(void);
+extern void test_opt_lm(void);
+extern void test_opt_lm_ws(void);
+extern void test_opt_brent(void);
+extern void test_opt_nm(void);
+extern void test_opt_lbfgs(void);
+extern void test_diff_random(void);
+
 extern void test_vector_init(void);
 extern void test_vector_from_arr(void);
 extern void test_vector_copy(void);
 extern void test_vector_get_subset(void);
+extern void test_vector_view(void);
+extern void test_vector_win(void);
+extern void test_vector_def_aligned(void);
 extern void test_vector_add(void);
 extern void test_vector_sub(void);
 extern void test_vector_neg(void);
@@ -102,24 +259,31 @@ extern void test_vector_scalar_div(void);
 extern void test_vector_dist(void);
 extern void test_vector_dot(void);
 extern void test_vector_norm(void);
+extern void test_vector_simd_lengths(void);
 extern void test_vector_project(void);
 extern void test_vector_to_unit(void);
 extern void test_vector_cross(void);
 extern void test_vector_sum_of_sqrs(void);
 extern void test_vector_mean(void);
 extern void test_vector_ar_mean(void);
+extern void test_vector_long_sums(void);
 extern void test_vector_rev(void);
 extern void test_vector_zte(void);
 extern void test_vector_is_equal(void);
 extern void test_vector_is_nonneg(void);
 extern void test_vector_contains(void);
 extern void test_vector_sort(void);
+extern void test_vector_sort_d(void);
+extern void test_vector_fused(void);
+extern void test_vector_mean_update(void);
+extern void test_vector_sort_ws(void);
 
 extern void test_phy_atom_nucl_radius(void);
 extern void test_phy_atom_bohr_orb_radius(void);
 extern void test_phy_atom_bohr_orb_vel(void);
 extern void test_phy_atom_bohr_orb_ener(void);
 extern void test_phy_atom_rad_decay(void);
+extern void test_phy_atom_rad_decay_vec(void);
 extern void test_phy_atom_bragg(void);
 
 extern void test_phy_dyn_newton(void);
@@ -141,6 +305,8 @@ extern void test_phy_ecmp_rc_charg_q(void);
 extern void test_phy_ecmp_rc_discharg_i(void);
 extern void test_phy_ecmp_rc_discharg_q(void);
 extern void test_phy_ecmp_rl_current(void);
+extern void test_phy_ecmp_rc_vec(void);
+extern void test_phy_misc_exp_curve(void);
 
 extern void test_phy_elcty_current(void);
 extern void test_phy_elcty_res_series(void);
@@ -149,9 +315,15 @@ extern void test_phy_elcty_cap_series(void);
 extern void test_phy_elcty_cap_parallel(void);
 extern void test_phy_elcty_resistivity(void);
 extern void test_phy_elcty_ohm_law(void);
+extern void test_phy_elcty_ohm_law_vec(void);
 extern void test_phy_elcty_power_vi(void);
+extern void test_phy_elcty_power_vi_vec(void);
 extern void test_phy_elcty_power_ir(void);
 extern void test_phy_elcty_power_vr(void);
+extern void test_phy_circ_dc(void);
+extern void test_phy_circ_singular(void);
+extern void test_phy_circ_rc(void);
+extern void test_phy_circ_rl(void);
 
 extern void test_phy_elec_charge_dens(void);
 extern void test_phy_elec_force(void);
@@ -185,19 +357,27 @@ extern void test_phy_gas_av_vel(void);
 extern void test_phy_gas_press(void);
 extern void test_phy_gas_boyle(void);
 extern void test_phy_gas_charles_lussac(void);
+extern void test_phy_gas_air_dens(void);
+extern void test_phy_gas_air_visc(void);
+extern void test_phy_gas_cache(void);
 
 extern void test_phy_grav_orb_period(void);
 extern void test_phy_grav_esc_vel(void);
 extern void test_phy_grav_acc(void);
 extern void test_phy_grav_orb_vel(void);
 extern void test_phy_grav_force(void);
+extern void test_phy_grav_force_vec(void);
 extern void test_phy_grav_pot_ener(void);
+extern void test_phy_nbody_acc(void);
+extern void test_phy_nbody_tree(void);
 
 extern void test_phy_kin_dist(void);
+extern void test_phy_kin_dist_vec(void);
 extern void test_phy_kin_init_pos(void);
 extern void test_phy_kin_init_pos2(void);
 extern void test_phy_kin_time(void);
 extern void test_phy_kin_vel(void);
+extern void test_phy_kin_vel_vec(void);
 extern void test_phy_kin_vel2(void);
 extern void test_phy_kin_init_vel(void);
 extern void test_phy_kin_init_vel2(void);
@@ -215,6 +395,7 @@ extern void test_phy_magn_flux(void);
 extern void test_phy_magn_mom(void);
 
 extern void test_phy_mass_center(void);
+extern void test_phy_mass_acc_inertia(void);
 
 extern void test_phy_mom_mom(void);
 extern void test_phy_mom_imp(void);
@@ -244,9 +425,15 @@ extern void test_phy_proj_ver_motion(void);
 extern void test_phy_proj_ver_vel(void);
 extern void test_phy_proj_hor_motion(void);
 extern void test_phy_proj_trajectory(void);
+extern void test_phy_proj_trajectory_vec(void);
+extern void test_phy_proj_trajectory_drag(void);
 extern void test_phy_proj_vel(void);
 extern void test_phy_proj_angle(void);
 extern void test_phy_proj_range(void);
+extern void test_phy_rel_gamma(void);
+extern void test_phy_rel_ener(void);
+extern void test_phy_rel_vel_add_vec(void);
+extern void test_phy_rel_doppler_vec(void);
 
 extern void test_phy_rot_angle(void);
 extern void test_phy_rot_dist(void);
@@ -269,18 +456,27 @@ extern void test_phy_rot_power(void);
 extern void test_phy_sound_press_amp(void);
 extern void test_phy_sound_level(void);
 extern void test_phy_sound_intensity(void);
+extern void test_phy_sound_level_block(void);
+extern void test_phy_sound_level_blocks(void);
 extern void test_phy_sound_shock_wave_angle(void);
 extern void test_phy_sound_dop_effect(void);
+extern void test_phy_sound_dop_effect_vec(void);
 extern void test_phy_sound_beat(void);
+extern void test_phy_sound_speed_air(void);
 
 extern void test_phy_thermo_fahren_cels(void);
 extern void test_phy_thermo_cels_kel(void);
+extern void test_phy_thermo_cels_kel_vec(void);
 extern void test_phy_thermo_heat_fusion(void);
 extern void test_phy_thermo_heat(void);
 extern void test_phy_thermo_expan(void);
 extern void test_phy_thermo_mean_free_path(void);
 extern void test_phy_thermo_effic_heat_engine(void);
 extern void test_phy_thermo_carnot_engine(void);
+extern void test_phy_wave_len_vec(void);
+extern void test_phy_wave_superpose(void);
+extern void test_phy_wave_phasor_sum(void);
+extern void test_phy_wave_interf_vec(void);
 
 extern void test_phy_work_module(void);
 extern void test_phy_work_x(void);
@@ -290,16 +486,27 @@ extern void test_phy_work_kin(void);
 extern void test_sta_mean(void);
 extern void test_sta_demean(void);
 extern void test_sta_percentile(void);
+extern void test_sta_percentiles(void);
 extern void test_sta_median(void);
 extern void test_sta_quartiles(void);
 extern void test_sta_quart_range(void);
+extern void test_sta_summary(void);
 extern void test_sta_mode(void);
+extern void test_sta_mode_ws(void);
 extern void test_sta_data_range(void);
 extern void test_sta_variance(void);
 extern void test_sta_standard_deviation(void);
 extern void test_sta_covariance(void);
 extern void test_sta_covariance_matrix(void);
+extern void test_sta_covariance_stream(void);
 extern void test_sta_linear_regression(void);
+extern void test_sta_mult_linear_reg(void);
+extern void test_sta_rls(void);
+extern void test_sta_stream(void);
+extern void test_sta_window(void);
+extern void test_sta_robust(void);
+extern void test_sta_hampel(void);
+extern void test_sta_tdigest(void);
 extern void test_sta_absolute_error(void);
 extern void test_sta_relative_error(void);
 
@@ -311,11 +518,16 @@ extern void test_prob_normal_pdf(void);
 extern void test_prob_normal_cdf(void);
 extern void test_prob_erf_inverse(void);
 extern void test_prob_normal_cdf_inv(void);
+extern void test_prob_normal_vec(void);
 extern void test_prob_entropy(void);
+extern void test_prob_hist(void);
+extern void test_prob_hist2(void);
 
 extern void test_att_to_vec(void);
 extern void test_att_to_euler(void);
 extern void test_att_from_euler(void);
+extern void test_att_euler_batch(void);
+extern void test_att_from_quat(void);
 extern void test_att_from_accelmag(void);
 extern void test_att_from_accel(void);
 
@@ -327,6 +539,17 @@ extern void test_quat_to_unit(void);
 extern void test_quat_is_unit(void);
 extern void test_quat_scale(void);
 extern void test_quat_mult(void);
+extern void test_quat_batch_mult(void);
+extern void test_quat_mult_alias(void);
+extern void test_quat_to_unit_fast(void);
+extern void test_quat_rot_vec(void);
+extern void test_fus_madg(void);
+extern void test_fus_mahn(void);
+extern void test_fus_ekf(void);
+extern void test_fus_feed_batch(void);
+extern void test_fus_queue(void);
+extern void test_fus_cal_magn(void);
+extern void test_fast_trig(void);
 extern void test_quat_exp(void);
 extern void test_quat_log(void);
 extern void test_quat_pow(void);
@@ -334,24 +557,81 @@ extern void test_quat_conj(void);
 extern void test_quat_inv(void);
 extern void test_quat_diff(void);
 extern void test_quat_slerp(void);
+extern void test_quat_slerp_step(void);
+extern void test_quat_integrate(void);
 extern void test_quat_to_euler(void);
 extern void test_quat_from_euler(void);
 extern void test_quat_to_rot_mtx(void);
 extern void test_quat_from_rot_mtx(void);
+extern void test_quat_rot_mtx33(void);
 
 void test_main(void)
 {
 	ztest_test_suite(zsl_tests,
 
 			 ztest_unit_test(test_conv_spd_xyz),
+			 ztest_unit_test(test_conv_spd_xyz_compiled),
+			 ztest_unit_test(test_conv_spd_soa_xyz),
+			 ztest_unit_test(test_clr_lef_integ),
+			 ztest_unit_test(test_clr_data_get),
+			 ztest_unit_test(test_clr_cct_pipe),
+			 ztest_unit_test(test_clr_ccm_fit),
+			 ztest_unit_test(test_conv_xyz_cat),
 			 ztest_unit_test(test_conv_ct_xyz),
+			 ztest_unit_test(test_conv_ct_xyz_lut),
 			 ztest_unit_test(test_conv_ct_rgb8),
+			 ztest_unit_test(test_conv_xyz_rgb_arr),
+			 ztest_unit_test(test_conv_srgb),
 			 ztest_unit_test(test_conv_cct_xyy),
 			 ztest_unit_test(test_conv_cct_xyz),
 			 ztest_unit_test(test_conv_uv60_cct_ohno2011),
 			 ztest_unit_test(test_conv_uv60_cct_ohno2014),
+			 ztest_unit_test(test_conv_uv60_cct_ohno2014_fast),
 
 			 ztest_unit_test(test_complex_add),
+			 ztest_unit_test(test_cplx_scalar),
+			 ztest_unit_test(test_cvec_ops),
+			 ztest_unit_test(test_cmtx_mult),
+			 ztest_unit_test(test_mtx_eigenvalues_cplx),
+
+			 ztest_unit_test(test_fft_cplx),
+			 ztest_unit_test(test_fft_real),
+
+			 ztest_unit_test(test_fir_process),
+			 ztest_unit_test(test_fir_decim_interp),
+			 ztest_unit_test(test_blk_process),
+			 ztest_unit_test(test_pipe_run),
+			 ztest_unit_test(test_iir_process),
+
+			 ztest_unit_test(test_conv),
+			 ztest_unit_test(test_xcorr),
+
+			 ztest_unit_test(test_chem_elem_props),
+			 ztest_unit_test(test_chem_formula),
+			 ztest_unit_test(test_chem_gas_conc),
+
+			 ztest_unit_test(test_mes_wire_hdr),
+			 ztest_unit_test(test_mes_wire_enc_dec),
+			 ztest_unit_test(test_mes_wire_encv),
+			 ztest_unit_test(test_mes_cbor_enc),
+			 ztest_unit_test(test_mes_cbor_dec),
+			 ztest_unit_test(test_mes_lz4_comp),
+			 ztest_unit_test(test_mes_lz4_delta),
+			 ztest_unit_test(test_mes_text_b64),
+			 ztest_unit_test(test_mes_text_b45),
+			 ztest_unit_test(test_mes_text_mes),
+			 ztest_unit_test(test_mes_frag_split),
+			 ztest_unit_test(test_mes_frag_reasm),
+			 ztest_unit_test(test_mes_frag_reasm_dst),
+			 ztest_unit_test(test_mes_store_add_find),
+			 ztest_unit_test(test_mes_store_iter),
+			 ztest_unit_test(test_mes_conv_factor),
+			 ztest_unit_test(test_mes_conv_vals),
+			 ztest_unit_test(test_mes_route),
+			 ztest_unit_test(test_mes_route_full),
+			 ztest_unit_test(test_mes_batch),
+			 ztest_unit_test(test_sns_conv),
+			 ztest_unit_test(test_mes_log),
 
 			 ztest_unit_test(test_interp_lerp),
 			 ztest_unit_test(test_interp_find_x_asc),
@@ -362,19 +642,43 @@ void test_main(void)
 			 ztest_unit_test(test_interp_lin_y_arr),
 			 ztest_unit_test(test_interp_lin_x),
 			 ztest_unit_test(test_interp_cubic_arr),
+			 ztest_unit_test(test_interp_cached),
+			 ztest_unit_test(test_interp_grid),
+			 ztest_unit_test(test_interp_batch),
+			 ztest_unit_test(test_interp_spline),
+			 ztest_unit_test(test_interp_grid2),
+
+			 ztest_unit_test(test_q31_scalar),
+			 ztest_unit_test(test_vec_q31),
+			 ztest_unit_test(test_mtx_q31),
+			 ztest_unit_test(test_quat_q31),
+			 ztest_unit_test(test_interp_lin_y_arr_q31),
+
+			 ztest_unit_test(test_ode_rk4),
+			 ztest_unit_test(test_ode_rk45),
+			 ztest_unit_test(test_ode_verlet),
+
+			 ztest_unit_test(test_spmtx_conv),
+			 ztest_unit_test(test_spmtx_const),
+			 ztest_unit_test(test_spmtx_mult_vec),
+			 ztest_unit_test(test_spmtx_mult),
+			 ztest_unit_test(test_spmtx_cg),
 
 			 ztest_unit_test(test_matrix_init),
 			 ztest_unit_test(test_matrix_from_arr),
+			 ztest_unit_test(test_matrix_const),
 			 ztest_unit_test(test_matrix_copy),
 			 ztest_unit_test(test_matrix_get),
 			 ztest_unit_test(test_matrix_set),
 			 ztest_unit_test(test_matrix_get_set_row),
 			 ztest_unit_test(test_matrix_get_set_col),
+			 ztest_unit_test(test_matrix_view),
 			 ztest_unit_test(test_matrix_row_from_vec),
 			 ztest_unit_test(test_matrix_unary_op),
 			 ztest_unit_test(test_matrix_unary_func),
 			 ztest_unit_test(test_matrix_binary_op),
 			 ztest_unit_test(test_matrix_binary_func),
+			 ztest_unit_test(test_matrix_func_rows),
 			 ztest_unit_test(test_matrix_add),
 			 ztest_unit_test(test_matrix_add_d),
 			 ztest_unit_test(test_matrix_sum_rows_d),
@@ -383,9 +687,15 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_sub_d),
 			 ztest_unit_test(test_matrix_mult_sq),
 			 ztest_unit_test(test_matrix_mult_rect),
+			 ztest_unit_test(test_matrix_mult_blocked),
+			 ztest_unit_test(test_matrix_mult_ex),
+			 ztest_unit_test(test_matrix_gemm_axpy_ger),
 			 ztest_unit_test(test_matrix_scalar_mult_d),
 			 ztest_unit_test(test_matrix_scalar_mult_row_d),
 			 ztest_unit_test(test_matrix_trans),
+			 ztest_unit_test(test_matrix_trans_d),
+			 ztest_unit_test(test_matrix_fixed),
+			 ztest_unit_test(test_matrix_fixed_decl),
 			 ztest_unit_test(test_matrix_adjoint_3x3),
 			 ztest_unit_test(test_matrix_adjoint),
 			 ztest_unit_test(test_matrix_reduce),
@@ -393,21 +703,44 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_augm_diag),
 			 ztest_unit_test(test_matrix_deter_3x3),
 			 ztest_unit_test(test_matrix_deter),
+			 ztest_unit_test(test_matrix_deter_large),
+			 ztest_unit_test(test_matrix_lu),
 			 ztest_unit_test(test_matrix_gauss_elim),
 			 ztest_unit_test(test_matrix_gauss_elim_d),
 			 ztest_unit_test(test_matrix_gauss_reduc),
+			 ztest_unit_test(test_matrix_gauss_jordan_d),
 			 ztest_unit_test(test_matrix_gram_schmidt_sq),
 			 ztest_unit_test(test_matrix_gram_schmidt_rect),
 			 ztest_unit_test(test_matrix_cols_norm),
+			 ztest_unit_test(test_matrix_gram_schmidt_d),
 			 ztest_unit_test(test_matrix_norm_elem),
 			 ztest_unit_test(test_matrix_norm_elem_d),
 			 ztest_unit_test(test_matrix_inv_3x3),
+			 ztest_unit_test(test_matrix_inv_4x4),
 			 ztest_unit_test(test_matrix_inv),
+			 ztest_unit_test(test_matrix_inv_d),
+			 ztest_unit_test(test_matrix_batch),
+			 ztest_unit_test(test_matrix_cholesky),
+			 ztest_unit_test(test_matrix_chol_solve),
+			 ztest_unit_test(test_matrix_chol_update),
+			 ztest_unit_test(test_matrix_inv_update),
+			 ztest_unit_test(test_matrix_solve),
+			 ztest_unit_test(test_matrix_lu_solve),
+			 ztest_unit_test(test_matrix_rcond),
+			 ztest_unit_test(test_matrix_solve_refine),
+			 ztest_unit_test(test_matrix_expm),
+			 ztest_unit_test(test_matrix_c2d),
+			 ztest_unit_test(test_matrix_trsm),
+			 ztest_unit_test(test_matrix_trsv),
 			 ztest_unit_test(test_matrix_balance),
 			 ztest_unit_test(test_matrix_householder_sq),
 			 ztest_unit_test(test_matrix_householder_rect),
 			 ztest_unit_test(test_matrix_qrd),
 			 ztest_unit_test(test_matrix_qrd_hess),
+			 ztest_unit_test(test_matrix_qr),
+			 ztest_unit_test(test_matrix_schur),
+			 ztest_unit_test(test_matrix_schur_rand),
+			 ztest_unit_test(test_matrix_eigen_sym),
 			 ztest_unit_test(test_matrix_min),
 			 ztest_unit_test(test_matrix_max),
 			 ztest_unit_test(test_matrix_min_idx),
@@ -415,11 +748,53 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_is_equal),
 			 ztest_unit_test(test_matrix_is_notneg),
 			 ztest_unit_test(test_matrix_is_sym),
+			 ztest_unit_test(test_matrix_props),
+			 ztest_unit_test(test_matrix_props_ops),
+			 ztest_unit_test(test_matrix_def_aligned),
+
+			 /* Packed matrix tests. */
+			 ztest_unit_test(test_pkmtx_convert),
+			 ztest_unit_test(test_pkmtx_mult),
+			 ztest_unit_test(test_pkmtx_solve),
+			 ztest_unit_test(test_ctx_init),
+			 ztest_unit_test(test_ctx_mtx),
+
+			 ztest_unit_test(test_ws_alloc),
+			 ztest_unit_test(test_ws_mark_release),
+			 ztest_unit_test(test_ws_mtx_vec_alloc),
+#if CONFIG_ZSL_SCRATCH_POOL
+			 ztest_unit_test(test_ws_scratch_pool),
+#endif
+#if CONFIG_ZSL_INSTRUMENT
+			 ztest_unit_test(test_ws_instrument),
+#endif
+#if CONFIG_ZSL_TRACE
+			 ztest_unit_test(test_trace_hooks),
+#endif
+
+			 ztest_unit_test(test_smp_for),
+			 ztest_unit_test(test_smp_mtx),
+
+			 ztest_unit_test(test_rand_u32),
+			 ztest_unit_test(test_rand_dist),
+			 ztest_unit_test(test_rand_fill),
+			 ztest_unit_test(test_mc_run),
+			 ztest_unit_test(test_dual_ops),
+			 ztest_unit_test(test_dual_propagate),
+			 ztest_unit_test(test_opt_lm),
+			 ztest_unit_test(test_opt_lm_ws),
+			 ztest_unit_test(test_opt_brent),
+			 ztest_unit_test(test_opt_nm),
+			 ztest_unit_test(test_opt_lbfgs),
+			 ztest_unit_test(test_diff_random),
 
 			 ztest_unit_test(test_vector_init),
 			 ztest_unit_test(test_vector_from_arr),
 			 ztest_unit_test(test_vector_copy),
 			 ztest_unit_test(test_vector_get_subset),
+			 ztest_unit_test(test_vector_view),
+			 ztest_unit_test(test_vector_win),
+			 ztest_unit_test(test_vector_def_aligned),
 			 ztest_unit_test(test_vector_add),
 			 ztest_unit_test(test_vector_sub),
 			 ztest_unit_test(test_vector_neg),
@@ -430,24 +805,31 @@ void test_main(void)
 			 ztest_unit_test(test_vector_dist),
 			 ztest_unit_test(test_vector_dot),
 			 ztest_unit_test(test_vector_norm),
+			 ztest_unit_test(test_vector_simd_lengths),
 			 ztest_unit_test(test_vector_project),
 			 ztest_unit_test(test_vector_to_unit),
 			 ztest_unit_test(test_vector_cross),
 			 ztest_unit_test(test_vector_sum_of_sqrs),
 			 ztest_unit_test(test_vector_mean),
 			 ztest_unit_test(test_vector_ar_mean),
+			 ztest_unit_test(test_vector_long_sums),
 			 ztest_unit_test(test_vector_rev),
 			 ztest_unit_test(test_vector_zte),
 			 ztest_unit_test(test_vector_is_equal),
 			 ztest_unit_test(test_vector_is_nonneg),
 			 ztest_unit_test(test_vector_contains),
 			 ztest_unit_test(test_vector_sort),
+			 ztest_unit_test(test_vector_sort_d),
+			 ztest_unit_test(test_vector_fused),
+			 ztest_unit_test(test_vector_mean_update),
+			 ztest_unit_test(test_vector_sort_ws),
 
 			 ztest_unit_test(test_phy_atom_nucl_radius),
 			 ztest_unit_test(test_phy_atom_bohr_orb_radius),
 			 ztest_unit_test(test_phy_atom_bohr_orb_vel),
 			 ztest_unit_test(test_phy_atom_bohr_orb_ener),
 			 ztest_unit_test(test_phy_atom_rad_decay),
+			 ztest_unit_test(test_phy_atom_rad_decay_vec),
 			 ztest_unit_test(test_phy_atom_bragg),
 
 			 ztest_unit_test(test_phy_dyn_newton),
@@ -469,6 +851,8 @@ void test_main(void)
 			 ztest_unit_test(test_phy_ecmp_rc_discharg_i),
 			 ztest_unit_test(test_phy_ecmp_rc_discharg_q),
 			 ztest_unit_test(test_phy_ecmp_rl_current),
+			 ztest_unit_test(test_phy_ecmp_rc_vec),
+			 ztest_unit_test(test_phy_misc_exp_curve),
 
 			 ztest_unit_test(test_phy_elcty_current),
 			 ztest_unit_test(test_phy_elcty_res_series),
@@ -477,9 +861,15 @@ void test_main(void)
 			 ztest_unit_test(test_phy_elcty_cap_parallel),
 			 ztest_unit_test(test_phy_elcty_resistivity),
 			 ztest_unit_test(test_phy_elcty_ohm_law),
+			 ztest_unit_test(test_phy_elcty_ohm_law_vec),
 			 ztest_unit_test(test_phy_elcty_power_vi),
+			 ztest_unit_test(test_phy_elcty_power_vi_vec),
 			 ztest_unit_test(test_phy_elcty_power_ir),
 			 ztest_unit_test(test_phy_elcty_power_vr),
+			 ztest_unit_test(test_phy_circ_dc),
+			 ztest_unit_test(test_phy_circ_singular),
+			 ztest_unit_test(test_phy_circ_rc),
+			 ztest_unit_test(test_phy_circ_rl),
 
 			 ztest_unit_test(test_phy_elec_charge_dens),
 			 ztest_unit_test(test_phy_elec_force),
@@ -513,19 +903,27 @@ void test_main(void)
 			 ztest_unit_test(test_phy_gas_press),
 			 ztest_unit_test(test_phy_gas_boyle),
 			 ztest_unit_test(test_phy_gas_charles_lussac),
+			 ztest_unit_test(test_phy_gas_air_dens),
+			 ztest_unit_test(test_phy_gas_air_visc),
+			 ztest_unit_test(test_phy_gas_cache),
 
 			 ztest_unit_test(test_phy_grav_orb_period),
 			 ztest_unit_test(test_phy_grav_esc_vel),
 			 ztest_unit_test(test_phy_grav_acc),
 			 ztest_unit_test(test_phy_grav_orb_vel),
 			 ztest_unit_test(test_phy_grav_force),
+			 ztest_unit_test(test_phy_grav_force_vec),
 			 ztest_unit_test(test_phy_grav_pot_ener),
+			 ztest_unit_test(test_phy_nbody_acc),
+			 ztest_unit_test(test_phy_nbody_tree),
 
 			 ztest_unit_test(test_phy_kin_dist),
+			 ztest_unit_test(test_phy_kin_dist_vec),
 			 ztest_unit_test(test_phy_kin_init_pos),
 			 ztest_unit_test(test_phy_kin_init_pos2),
 			 ztest_unit_test(test_phy_kin_time),
 			 ztest_unit_test(test_phy_kin_vel),
+			 ztest_unit_test(test_phy_kin_vel_vec),
 			 ztest_unit_test(test_phy_kin_vel2),
 			 ztest_unit_test(test_phy_kin_init_vel),
 			 ztest_unit_test(test_phy_kin_init_vel2),
@@ -543,6 +941,7 @@ void test_main(void)
 			 ztest_unit_test(test_phy_magn_mom),
 
 			 ztest_unit_test(test_phy_mass_center),
+			 ztest_unit_test(test_phy_mass_acc_inertia),
 
 			 ztest_unit_test(test_phy_mom_mom),
 			 ztest_unit_test(test_phy_mom_imp),
@@ -572,9 +971,15 @@ void test_main(void)
 			 ztest_unit_test(test_phy_proj_ver_vel),
 			 ztest_unit_test(test_phy_proj_hor_motion),
 			 ztest_unit_test(test_phy_proj_trajectory),
+			 ztest_unit_test(test_phy_proj_trajectory_vec),
+			 ztest_unit_test(test_phy_proj_trajectory_drag),
 			 ztest_unit_test(test_phy_proj_vel),
 			 ztest_unit_test(test_phy_proj_angle),
 			 ztest_unit_test(test_phy_proj_range),
+			 ztest_unit_test(test_phy_rel_gamma),
+			 ztest_unit_test(test_phy_rel_ener),
+			 ztest_unit_test(test_phy_rel_vel_add_vec),
+			 ztest_unit_test(test_phy_rel_doppler_vec),
 
 			 ztest_unit_test(test_phy_rot_angle),
 			 ztest_unit_test(test_phy_rot_dist),
@@ -597,18 +1002,27 @@ void test_main(void)
 			 ztest_unit_test(test_phy_sound_press_amp),
 			 ztest_unit_test(test_phy_sound_level),
 			 ztest_unit_test(test_phy_sound_intensity),
+			 ztest_unit_test(test_phy_sound_level_block),
+			 ztest_unit_test(test_phy_sound_level_blocks),
 			 ztest_unit_test(test_phy_sound_shock_wave_angle),
 			 ztest_unit_test(test_phy_sound_dop_effect),
+			 ztest_unit_test(test_phy_sound_dop_effect_vec),
 			 ztest_unit_test(test_phy_sound_beat),
+			 ztest_unit_test(test_phy_sound_speed_air),
 
 			 ztest_unit_test(test_phy_thermo_fahren_cels),
 			 ztest_unit_test(test_phy_thermo_cels_kel),
+			 ztest_unit_test(test_phy_thermo_cels_kel_vec),
 			 ztest_unit_test(test_phy_thermo_heat_fusion),
 			 ztest_unit_test(test_phy_thermo_heat),
 			 ztest_unit_test(test_phy_thermo_expan),
 			 ztest_unit_test(test_phy_thermo_mean_free_path),
 			 ztest_unit_test(test_phy_thermo_effic_heat_engine),
 			 ztest_unit_test(test_phy_thermo_carnot_engine),
+			 ztest_unit_test(test_phy_wave_len_vec),
+			 ztest_unit_test(test_phy_wave_superpose),
+			 ztest_unit_test(test_phy_wave_phasor_sum),
+			 ztest_unit_test(test_phy_wave_interf_vec),
 
 			 ztest_unit_test(test_phy_work_module),
 			 ztest_unit_test(test_phy_work_x),
@@ -618,16 +1032,27 @@ void test_main(void)
 			 ztest_unit_test(test_sta_mean),
 			 ztest_unit_test(test_sta_demean),
 			 ztest_unit_test(test_sta_percentile),
+			 ztest_unit_test(test_sta_percentiles),
 			 ztest_unit_test(test_sta_median),
 			 ztest_unit_test(test_sta_quartiles),
 			 ztest_unit_test(test_sta_quart_range),
+			 ztest_unit_test(test_sta_summary),
 			 ztest_unit_test(test_sta_mode),
+			 ztest_unit_test(test_sta_mode_ws),
 			 ztest_unit_test(test_sta_data_range),
 			 ztest_unit_test(test_sta_variance),
 			 ztest_unit_test(test_sta_standard_deviation),
 			 ztest_unit_test(test_sta_covariance),
 			 ztest_unit_test(test_sta_covariance_matrix),
+			 ztest_unit_test(test_sta_covariance_stream),
 			 ztest_unit_test(test_sta_linear_regression),
+			 ztest_unit_test(test_sta_mult_linear_reg),
+			 ztest_unit_test(test_sta_rls),
+			 ztest_unit_test(test_sta_stream),
+			 ztest_unit_test(test_sta_window),
+			 ztest_unit_test(test_sta_robust),
+			 ztest_unit_test(test_sta_hampel),
+			 ztest_unit_test(test_sta_tdigest),
 			 ztest_unit_test(test_sta_absolute_error),
 			 ztest_unit_test(test_sta_relative_error),
 
@@ -639,11 +1064,16 @@ void test_main(void)
 			 ztest_unit_test(test_prob_normal_cdf),
 			 ztest_unit_test(test_prob_erf_inverse),
 			 ztest_unit_test(test_prob_normal_cdf_inv),
+			 ztest_unit_test(test_prob_normal_vec),
 			 ztest_unit_test(test_prob_entropy),
+			 ztest_unit_test(test_prob_hist),
+			 ztest_unit_test(test_prob_hist2),
 
 			 ztest_unit_test(test_att_to_vec),
 			 ztest_unit_test(test_att_to_euler),
 			 ztest_unit_test(test_att_from_euler),
+			 ztest_unit_test(test_att_euler_batch),
+			 ztest_unit_test(test_att_from_quat),
 			 ztest_unit_test(test_att_from_accelmag),
 			 ztest_unit_test(test_att_from_accel),
 
@@ -655,6 +1085,17 @@ void test_main(void)
 			 ztest_unit_test(test_quat_is_unit),
 			 ztest_unit_test(test_quat_scale),
 			 ztest_unit_test(test_quat_mult),
+			 ztest_unit_test(test_quat_batch_mult),
+			 ztest_unit_test(test_quat_mult_alias),
+			 ztest_unit_test(test_quat_to_unit_fast),
+			 ztest_unit_test(test_quat_rot_vec),
+			 ztest_unit_test(test_fus_madg),
+			 ztest_unit_test(test_fus_mahn),
+			 ztest_unit_test(test_fus_ekf),
+			 ztest_unit_test(test_fus_feed_batch),
+			 ztest_unit_test(test_fus_queue),
+			 ztest_unit_test(test_fus_cal_magn),
+			 ztest_unit_test(test_fast_trig),
 			 ztest_unit_test(test_quat_exp),
 			 ztest_unit_test(test_quat_log),
 			 ztest_unit_test(test_quat_pow),
@@ -662,10 +1103,13 @@ void test_main(void)
 			 ztest_unit_test(test_quat_inv),
 			 ztest_unit_test(test_quat_diff),
 			 ztest_unit_test(test_quat_slerp),
+			 ztest_unit_test(test_quat_slerp_step),
+			 ztest_unit_test(test_quat_integrate),
 			 ztest_unit_test(test_quat_to_euler),
 			 ztest_unit_test(test_quat_from_euler),
 			 ztest_unit_test(test_quat_to_rot_mtx),
-			 ztest_unit_test(test_quat_from_rot_mtx));
+			 ztest_unit_test(test_quat_from_rot_mtx),
+			 ztest_unit_test(test_quat_rot_mtx33));
 
 	ztest_run_test_suite(zsl_tests);
 
@@ -676,7 +1120,15 @@ void test_main(void)
 			 ztest_unit_test(test_matrix_eigenvalues),
 			 ztest_unit_test(test_matrix_eigenvectors),
 			 ztest_unit_test(test_matrix_svd),
-			 ztest_unit_test(test_matrix_pinv)
+			 ztest_unit_test(test_matrix_svd_tall),
+			 ztest_unit_test(test_matrix_svd_rank_deficient),
+			 ztest_unit_test(test_matrix_svd_vals),
+			 ztest_unit_test(test_matrix_pinv),
+			 ztest_unit_test(test_matrix_svd_ws),
+			 ztest_unit_test(test_matrix_pinv_ws),
+			 ztest_unit_test(test_matrix_plan),
+			 ztest_unit_test(test_matrix_plan_step),
+			 ztest_unit_test(test_matrix_eigenvalues_iter)
 			 );
 
 	ztest_run_test_suite(zsl_tests_double);
@@ -7,7 +7,11 @@
 #include <ztest.h>
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
+#include <zsl/matrices_fixed.h>
 #include <zsl/vectors.h>
+#include <zsl/workspace.h>
+#include <zsl/random.h>
+#include <zsl/statistics.h>
 #include "floatcheck.h"
 
 /**
@@ -53,6 +57,16 @@ void test_matrix_init(void)
 	rc = zsl_mtx_get(&m, 0, 1, &x);
 	zassert_equal(x, 0.0, NULL);
 	zassert_equal(rc, 0, NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* The entry functions are public, so they check their indices. */
+	rc = zsl_mtx_entry_fn_empty(&m, 3, 0);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_entry_fn_identity(&m, 0, 3);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_entry_fn_random(&m, 3, 3);
+	zassert_equal(rc, -EINVAL, NULL);
+#endif
 }
 
 /**
@@ -97,6 +111,242 @@ void test_matrix_from_arr(void)
 	zassert_equal(x, 0.0, NULL);
 }
 
+/**
+ * @brief ZSL_MATRIX_CONST_DEF unit tests.
+ *
+ * This test verifies that read-only matrices and vectors can be passed
+ * directly to input-only parameters.
+ */
+void test_matrix_const(void)
+{
+	int rc;
+	zsl_real_t x;
+	zsl_real_t q[3];
+	struct zsl_mtx_view vd;
+	struct zsl_sta_summary sum;
+	struct zsl_sta_linreg lr;
+
+	ZSL_MATRIX_CONST_DEF(mc, 3, 3, 2.0, 0.0, 1.0,
+				       0.0, 1.0, 0.0,
+				       1.0, 0.0, 1.0);
+	ZSL_VECTOR_CONST_DEF(vc, 3, 1.0, 2.0, 2.0);
+	ZSL_MATRIX_DEF(mi, 3, 3);
+	ZSL_MATRIX_DEF(mp, 3, 3);
+	ZSL_MATRIX_DEF(mt, 3, 3);
+	ZSL_MATRIX_DEF(qr, 3, 3);
+	ZSL_MATRIX_BATCH_DEF(bo, 3, 3, 2);
+	ZSL_VECTOR_DEF(v, 3);
+	ZSL_VECTOR_DEF(vs, 2);
+	ZSL_VECTOR_DEF(tau, 3);
+	ZSL_STA_RLS_DEF(rls, 3);
+	ZSL_WORKSPACE_DEF(ws, 64);
+
+	/* Read-only arrays, a view onto 'mc' and a batch holding 'mc' twice,
+	 * with entry (i, j) of both matrices stored together. */
+	static const zsl_real_t row[3] = { 1.0, 2.0, 2.0 };
+	static const zsl_real_t bdata[18] = { 2.0, 2.0, 0.0, 0.0, 1.0, 1.0,
+					      0.0, 0.0, 1.0, 1.0, 0.0, 0.0,
+					      1.0, 1.0, 0.0, 0.0, 1.0, 1.0 };
+	static const zsl_real_t err_val = 1.0;
+	static const zsl_real_t err_exp = 2.0;
+	static const size_t pcts[2] = { 25, 75 };
+	const struct zsl_mtx_view vw = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.ld = 3,
+		.data = mc.data
+	};
+	const struct zsl_mtx_batch bc = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.sz_batch = 2,
+		.data = (zsl_real_t *)bdata
+	};
+	const struct zsl_vec *vl[2] = { &vc, &vc };
+	const struct zsl_mtx *qrc = &qr;
+	const struct zsl_vec *tauc = &tau;
+
+	rc = zsl_mtx_get(&mc, 0, 2, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+	zassert_true(zsl_mtx_is_sym(&mc), NULL);
+
+	/* mc * inv(mc) = I, without copying 'mc' into RAM. */
+	rc = zsl_mtx_inv(&mc, &mi);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&mc, &mi, &mp);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_init(&mt, zsl_mtx_entry_fn_identity);
+	zassert_true(zsl_mtx_is_equal(&mp, &mt), NULL);
+
+	rc = zsl_mtx_trans(&mc, &mt);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mt, &mc), NULL);
+
+	rc = zsl_mtx_deter(&mc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+
+	/* Read-only vectors. */
+	zassert_true(val_is_equal(zsl_vec_norm(&vc), 3.0, 1E-6), NULL);
+	rc = zsl_vec_dot(&vc, &vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 9.0, 1E-6), NULL);
+	rc = zsl_vec_copy(&v, &vc);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &vc, 1E-6), NULL);
+	rc = zsl_vec_from_arr(&v, row);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &vc, 1E-6), NULL);
+	rc = zsl_vec_get_subset(&vc, 1, 2, &vs);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(vs.data[0], 2.0, 1E-6), NULL);
+	rc = zsl_vec_sum(vl, 2, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v.data[2], 4.0, 1E-6), NULL);
+	rc = zsl_vec_mean(vl, 2, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &vc, 1E-6), NULL);
+
+	/* Read-only arrays. */
+	rc = zsl_mtx_from_arr(&mt, bdata);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mt.data[1], 2.0, 1E-6), NULL);
+	rc = zsl_mtx_set_row(&mt, 0, row);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mt.data[2], 2.0, 1E-6), NULL);
+	rc = zsl_mtx_set_col(&mt, 0, row);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mt.data[3], 2.0, 1E-6), NULL);
+
+	/* Read-only views. */
+	rc = zsl_mtx_view_get(&vw, 0, 2, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+	zsl_mtx_view(&mt, 0, 0, 3, 3, &vd);
+	rc = zsl_mtx_view_copy(&vd, &vw);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mt, &mc), NULL);
+	rc = zsl_mtx_view_mult(&vw, &vw, &vd);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&mc, &mc, &mp);
+	zassert_true(zsl_mtx_is_equal(&mt, &mp), NULL);
+
+	/* Read-only batches. */
+	rc = zsl_mtx_batch_get(&bc, 1, &mt);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mt, &mc), NULL);
+	rc = zsl_mtx_batch_mult(&bc, &bc, &bo);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_batch_get(&bo, 1, &mt);
+	zassert_true(zsl_mtx_is_equal(&mt, &mp), NULL);
+	rc = zsl_mtx_batch_inv_3x3(&bc, &bo);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_batch_get(&bo, 0, &mt);
+	zassert_true(zsl_mtx_is_equal(&mt, &mi), NULL);
+	rc = zsl_mtx_batch_set(&bo, 0, &mc);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_batch_get(&bo, 0, &mt);
+	zassert_true(zsl_mtx_is_equal(&mt, &mc), NULL);
+
+	/* Both forms of exp(mc) agree. */
+	rc = zsl_mtx_expm(&mc, &mt);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_expm_ws(&mc, &mp, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mt, &mp), NULL);
+
+	/* Q * Q^T * mc = mc, with a read-only factorisation. */
+	zsl_mtx_qr(&mc, &qr, &tau);
+	zsl_mtx_copy(&mt, &mc);
+	rc = zsl_mtx_qr_apply_q(qrc, tauc, &mt, true);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_qr_apply_q(&qr, &tau, &mt, false);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(mt.data[i], mc.data[i], 1E-6), NULL);
+	}
+
+	/* Statistics of a read-only vector. */
+	rc = zsl_sta_mean(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 5.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_demean(&vc, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v.data[0], -2.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_percentile(&vc, 50, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 2.0, 1E-6), NULL);
+	rc = zsl_sta_percentiles(&vc, pcts, 2, q);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(q[0], 1.0, 1E-6), NULL);
+	rc = zsl_sta_median(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 2.0, 1E-6), NULL);
+	rc = zsl_sta_quart(&vc, &q[0], &q[1], &q[2]);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(q[1], 2.0, 1E-6), NULL);
+	rc = zsl_sta_quart_range(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+	rc = zsl_sta_mad(&vc, &q[0], &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.0, 1E-6), NULL);
+	rc = zsl_sta_trim_mean(&vc, 0, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 5.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_winsor_mean(&vc, 0, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 5.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_reject_outliers(&vc, 3.0, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(v.sz, 2, NULL);
+	v.sz = 3;
+	rc = zsl_sta_summary(&vc, &sum);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(sum.mean, 5.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_summary_ws(&vc, &sum, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(sum.median, 2.0, 1E-6), NULL);
+	rc = zsl_sta_mode(&vc, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(v.sz, 1, NULL);
+	v.sz = 3;
+	rc = zsl_sta_mode_ws(&vc, &v, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v.data[0], 2.0, 1E-6), NULL);
+	v.sz = 3;
+	rc = zsl_sta_data_range(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+	rc = zsl_sta_var(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_sta_dev(&vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x * x, 1.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_covar(&vc, &vc, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0 / 3.0, 1E-6), NULL);
+	rc = zsl_sta_covar_mtx(&mc, &mt);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mt.data[0], 1.0, 1E-6), NULL);
+	rc = zsl_sta_corr_mtx(&mc, &mt);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mt.data[4], 1.0, 1E-6), NULL);
+	rc = zsl_sta_linear_reg(&vc, &vc, &lr);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(lr.slope, 1.0, 1E-6), NULL);
+	zsl_sta_rls_init(&rls, 1.0, 100.0);
+	rc = zsl_sta_rls_update(&rls, &vc, 1.0, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_sta_abs_err(&err_val, &err_exp, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 1.0, 1E-6), NULL);
+	rc = zsl_sta_rel_err(&err_val, &err_exp, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 50.0, 1E-6), NULL);
+}
+
 /**
  * @brief zsl_mtx_copy and zsl_mtx_is_equal unit tests.
  *
@@ -320,6 +570,111 @@ void test_matrix_get_set_col(void)
 	zassert_true(val_is_equal(v2.data[2], v[2], 1E-5), NULL);
 }
 
+void test_matrix_view(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+
+	struct zsl_mtx_view va, vb, vc, vs;
+
+	ZSL_MATRIX_DEF(m, 6, 7);
+	ZSL_MATRIX_DEF(a, 3, 4);
+	ZSL_MATRIX_DEF(b, 4, 2);
+	ZSL_MATRIX_DEF(c, 3, 2);
+	ZSL_MATRIX_DEF(out, 6, 7);
+
+	for (size_t i = 0; i < 6 * 7; i++) {
+		m.data[i] = (zsl_real_t)i * 0.5 - 3.0;
+	}
+
+	/* Block views index into the parent matrix. */
+	rc = zsl_mtx_view(&m, 1, 2, 3, 4, &va);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(va.ld, 7, NULL);
+	rc = zsl_mtx_view_get(&va, 2, 3, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(x == m.data[3 * 7 + 5], NULL);
+	zassert_equal(zsl_mtx_view_get(&va, 3, 0, &x), -EINVAL, NULL);
+
+	/* Writes through a view land in the parent matrix. */
+	rc = zsl_mtx_view_sub(&va, 1, 1, 2, 2, &vs);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_view_set(&vs, 1, 1, 42.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(m.data[3 * 7 + 4] == 42.0, NULL);
+	zassert_equal(zsl_mtx_view_sub(&va, 2, 2, 2, 2, &vs), -EINVAL, NULL);
+
+	/* Rows and columns. */
+	rc = zsl_mtx_view_row(&m, 5, &vs);
+	zassert_equal(rc, 0, NULL);
+	zassert_true((vs.sz_rows == 1) && (vs.sz_cols == 7), NULL);
+	zassert_true(vs.data == &m.data[5 * 7], NULL);
+	rc = zsl_mtx_view_col(&m, 6, &vs);
+	zassert_equal(rc, 0, NULL);
+	zassert_true((vs.sz_rows == 6) && (vs.sz_cols == 1), NULL);
+	zsl_mtx_view_get(&vs, 4, 0, &x);
+	zassert_true(x == m.data[4 * 7 + 6], NULL);
+	zassert_equal(zsl_mtx_view_row(&m, 6, &vs), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_view_col(&m, 7, &vs), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_view(&m, 4, 0, 3, 1, &vs), -EINVAL, NULL);
+
+	/* Multiplying two blocks matches multiplying copies of them. */
+	zsl_mtx_view(&m, 2, 3, 4, 2, &vb);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zsl_mtx_view_get(&va, i, j, &a.data[i * 4 + j]);
+		}
+	}
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			zsl_mtx_view_get(&vb, i, j, &b.data[i * 2 + j]);
+		}
+	}
+	zsl_mtx_mult(&a, &b, &c);
+
+	zsl_mtx_init(&out, NULL);
+	zsl_mtx_view(&out, 3, 5, 3, 2, &vc);
+	rc = zsl_mtx_view_mult(&va, &vb, &vc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		for (size_t j = 0; j < 7; j++) {
+			x = out.data[i * 7 + j];
+			if ((i >= 3) && (j >= 5)) {
+				zassert_true(val_is_equal(x,
+					c.data[(i - 3) * 2 + j - 5], 1E-5),
+					NULL);
+			} else {
+				zassert_true(x == 0.0, NULL);
+			}
+		}
+	}
+	zassert_equal(zsl_mtx_view_mult(&vb, &va, &vc), -EINVAL, NULL);
+
+	/* Copy a block into another matrix. */
+	zsl_mtx_view(&out, 0, 0, 3, 4, &vc);
+	rc = zsl_mtx_view_copy(&vc, &va);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(out.data[i * 7 + j] == a.data[i * 4 + j],
+				     NULL);
+		}
+	}
+	zassert_equal(zsl_mtx_view_copy(&vc, &vb), -EINVAL, NULL);
+
+	/* Strided views of a vector, such as one channel of three. */
+	struct zsl_vec vec = { .sz = 6 * 7, .data = m.data };
+
+	rc = zsl_mtx_view_vec(&vec, 1, 14, 3, &vs);
+	zassert_equal(rc, 0, NULL);
+	zassert_true((vs.sz_rows == 14) && (vs.sz_cols == 1), NULL);
+	zsl_mtx_view_get(&vs, 13, 0, &x);
+	zassert_true(x == m.data[1 + 13 * 3], NULL);
+	zassert_equal(zsl_mtx_view_vec(&vec, 3, 14, 3, &vs), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_view_vec(&vec, 0, 1, 0, &vs), -EINVAL, NULL);
+	zassert_equal(zsl_mtx_view_vec(&vec, 42, 1, 1, &vs), -EINVAL, NULL);
+}
+
 void test_matrix_row_from_vec(void)
 {
 	int rc;
@@ -421,6 +776,22 @@ void test_matrix_binary_op(void)
 	zassert_true(val_is_equal(mc.data[8], ma.data[8] + mb.data[8], 1E-5),
 		     NULL);
 
+	/* Each operation must stop at its own result. */
+	mb.data[4] = 1.5;
+	rc = zsl_mtx_binary_op(&ma, &mb, &mc, ZSL_MTX_BINARY_OP_MEAN);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mc.data[4], 1.0, 1E-5), NULL);
+	rc = zsl_mtx_binary_op(&ma, &mb, &mc, ZSL_MTX_BINARY_OP_MAX);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mc.data[4], 1.5, 1E-5), NULL);
+	rc = zsl_mtx_binary_op(&ma, &mb, &mc, ZSL_MTX_BINARY_OP_GREAT);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mc.data[4] == 0.0, NULL);
+	rc = zsl_mtx_binary_op(&ma, &mb, &mc, ZSL_MTX_BINARY_OP_GEQ);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mc.data[0] == 1.0, NULL);
+	zassert_true(mc.data[4] == 0.0, NULL);
+
 	/* TODO: Test other operands! */
 }
 
@@ -429,6 +800,67 @@ void test_matrix_binary_func(void)
 
 }
 
+static int
+test_matrix_row_scale(zsl_real_t *row, size_t n, size_t i)
+{
+	for (size_t j = 0; j < n; j++) {
+		row[j] *= (zsl_real_t)(i + 1);
+	}
+
+	return 0;
+}
+
+static int
+test_matrix_row_diff(const zsl_real_t *a, const zsl_real_t *b, zsl_real_t *c,
+		     size_t n, size_t i)
+{
+	if (i == 2) {
+		return -EIO;
+	}
+
+	for (size_t j = 0; j < n; j++) {
+		c[j] = a[j] - b[j];
+	}
+
+	return 0;
+}
+
+void test_matrix_func_rows(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(ma, 3, 4);
+	ZSL_MATRIX_DEF(mb, 3, 4);
+	ZSL_MATRIX_DEF(mc, 3, 4);
+	ZSL_MATRIX_DEF(md, 4, 3);
+
+	for (size_t i = 0; i < 12; i++) {
+		ma.data[i] = 1.0;
+		mb.data[i] = (zsl_real_t)i;
+	}
+	zsl_mtx_init(&mc, NULL);
+
+	/* Row i is scaled by i + 1. */
+	rc = zsl_mtx_unary_func_rows(&ma, test_matrix_row_scale);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 12; i++) {
+		zassert_true(ma.data[i] == (zsl_real_t)(i / 4 + 1), NULL);
+	}
+
+	/* The callback's error code stops iteration after two rows. */
+	rc = zsl_mtx_binary_func_rows(&ma, &mb, &mc, test_matrix_row_diff);
+	zassert_equal(rc, -EIO, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		zassert_true(mc.data[i] == ma.data[i] - mb.data[i], NULL);
+	}
+	zassert_true(mc.data[8] == 0.0, NULL);
+
+	rc = zsl_mtx_binary_func_rows(&ma, &md, &mc, test_matrix_row_diff);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_unary_func_rows(&ma, NULL);
+	zassert_equal(rc, 0, NULL);
+}
+
 void test_matrix_add(void)
 {
 	int rc;
@@ -859,6 +1291,210 @@ void test_matrix_mult_rect(void)
 	zassert_equal(mref.data[11], mc.data[11], NULL);
 }
 
+/* Large operands are kept off the ztest stack. */
+static zsl_real_t mult_blk_a[37 * 45];
+static zsl_real_t mult_blk_b[45 * 34];
+static zsl_real_t mult_blk_c[37 * 34];
+
+/**
+ * @brief zsl_mtx_mult unit tests with inputs large enough to be blocked.
+ *
+ * This test verifies the cache-blocked path of the zsl_mtx_mult function,
+ * including partial edge blocks and edge tiles, against a direct evaluation
+ * of each output coefficient.
+ */
+void test_matrix_mult_blocked(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+
+	struct zsl_mtx ma = {
+		.sz_rows = 37,
+		.sz_cols = 45,
+		.data = mult_blk_a
+	};
+	struct zsl_mtx mb = {
+		.sz_rows = 45,
+		.sz_cols = 34,
+		.data = mult_blk_b
+	};
+	struct zsl_mtx mc = {
+		.sz_rows = 37,
+		.sz_cols = 34,
+		.data = mult_blk_c
+	};
+
+	/* Fill the inputs with small integers so the products are exact. */
+	for (size_t i = 0; i < ma.sz_rows * ma.sz_cols; i++) {
+		ma.data[i] = (zsl_real_t)((int)(i * 7 % 11) - 5);
+	}
+	for (size_t i = 0; i < mb.sz_rows * mb.sz_cols; i++) {
+		mb.data[i] = (zsl_real_t)((int)(i * 5 % 13) - 6);
+	}
+
+	/* Make sure stale output values are discarded. */
+	for (size_t i = 0; i < mc.sz_rows * mc.sz_cols; i++) {
+		mc.data[i] = 99.0;
+	}
+
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t i = 0; i < mc.sz_rows; i++) {
+		for (size_t j = 0; j < mc.sz_cols; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < ma.sz_cols; k++) {
+				x += ma.data[i * ma.sz_cols + k] *
+				     mb.data[k * mb.sz_cols + j];
+			}
+			zassert_equal(mc.data[i * mc.sz_cols + j], x, NULL);
+		}
+	}
+
+	/* A shape mismatch must still be rejected. */
+	mc.sz_cols = 33;
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_mult_ex(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(a, 3, 4);
+	ZSL_MATRIX_DEF(at, 4, 3);
+	ZSL_MATRIX_DEF(b, 4, 5);
+	ZSL_MATRIX_DEF(bt, 5, 4);
+	ZSL_MATRIX_DEF(c0, 3, 5);
+	ZSL_MATRIX_DEF(c, 3, 5);
+
+	for (size_t i = 0; i < 12; i++) {
+		a.data[i] = (zsl_real_t)i * 0.25 - 1.0;
+	}
+	for (size_t i = 0; i < 20; i++) {
+		b.data[i] = 2.0 - (zsl_real_t)(i % 7) * 0.5;
+	}
+	zsl_mtx_trans(&a, &at);
+	zsl_mtx_trans(&b, &bt);
+
+	/* The reference result, a * b. */
+	zsl_mtx_mult(&a, &b, &c0);
+
+	/* Every combination of transposed operands gives the same product,
+	 * with uninitialised output values ignored when beta is zero. */
+	for (size_t t = 0; t < 4; t++) {
+		bool ta = t & 1;
+		bool tb = t & 2;
+
+		for (size_t i = 0; i < 15; i++) {
+			c.data[i] = NAN;
+		}
+		rc = zsl_mtx_mult_ex(ta ? &at : &a, ta, tb ? &bt : &b, tb,
+				     1.0, 0.0, &c);
+		zassert_equal(rc, 0, NULL);
+		for (size_t i = 0; i < 15; i++) {
+			zassert_true(val_is_equal(c.data[i], c0.data[i], 1E-5),
+				     NULL);
+		}
+
+		/* c = 0.5 * a * b + 2.0 * c. */
+		for (size_t i = 0; i < 15; i++) {
+			c.data[i] = (zsl_real_t)i;
+		}
+		rc = zsl_mtx_mult_ex(ta ? &at : &a, ta, tb ? &bt : &b, tb,
+				     0.5, 2.0, &c);
+		zassert_equal(rc, 0, NULL);
+		for (size_t i = 0; i < 15; i++) {
+			x = 0.5 * c0.data[i] + 2.0 * (zsl_real_t)i;
+			zassert_true(val_is_equal(c.data[i], x, 1E-5), NULL);
+		}
+	}
+
+	/* Shape mismatches. */
+	rc = zsl_mtx_mult_ex(&a, true, &b, false, 1.0, 0.0, &c);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_mult_ex(&a, false, &b, true, 1.0, 0.0, &c);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_mult_ex(&a, false, &bt, true, 1.0, 0.0, &a);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_gemm_axpy_ger(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(a, 3, 4);
+	ZSL_MATRIX_DEF(b, 4, 2);
+	ZSL_MATRIX_DEF(ab, 3, 2);
+	ZSL_MATRIX_DEF(c, 3, 2);
+	ZSL_MATRIX_DEF(d, 3, 2);
+	ZSL_VECTOR_DEF(u, 3);
+	ZSL_VECTOR_DEF(v, 2);
+
+	zsl_real_t ua[3] = { 1.0, -2.0, 0.5 };
+	zsl_real_t va[2] = { 3.0, 4.0 };
+
+	for (size_t i = 0; i < 12; i++) {
+		a.data[i] = (zsl_real_t)i - 5.0;
+	}
+	for (size_t i = 0; i < 8; i++) {
+		b.data[i] = 0.5 * (zsl_real_t)i;
+	}
+	zsl_mtx_mult(&a, &b, &ab);
+
+	/* c = -1.5 * a * b + 0.5 * c. */
+	for (size_t i = 0; i < 6; i++) {
+		c.data[i] = (zsl_real_t)i;
+	}
+	rc = zsl_mtx_gemm(&a, &b, -1.5, 0.5, &c);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		x = -1.5 * ab.data[i] + 0.5 * (zsl_real_t)i;
+		zassert_true(val_is_equal(c.data[i], x, 1E-5), NULL);
+	}
+
+	/* Accumulating into an existing matrix. */
+	for (size_t i = 0; i < 6; i++) {
+		c.data[i] = 1.0;
+	}
+	rc = zsl_mtx_gemm(&a, &b, 1.0, 1.0, &c);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(c.data[i], ab.data[i] + 1.0, 1E-5),
+			     NULL);
+	}
+	zassert_equal(zsl_mtx_gemm(&b, &a, 1.0, 0.0, &c), -EINVAL, NULL);
+
+	/* d = 2 * ab + d. */
+	for (size_t i = 0; i < 6; i++) {
+		d.data[i] = -(zsl_real_t)i;
+	}
+	rc = zsl_mtx_axpy(2.0, &ab, &d);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		x = 2.0 * ab.data[i] - (zsl_real_t)i;
+		zassert_true(val_is_equal(d.data[i], x, 1E-5), NULL);
+	}
+	zassert_equal(zsl_mtx_axpy(1.0, &a, &d), -EINVAL, NULL);
+
+	/* d = -2 * u * v^T + d. */
+	zsl_vec_from_arr(&u, ua);
+	zsl_vec_from_arr(&v, va);
+	zsl_mtx_init(&d, zsl_mtx_entry_fn_identity);
+	rc = zsl_mtx_ger(-2.0, &u, &v, &d);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			x = (i == j ? 1.0 : 0.0) - 2.0 * u.data[i] * v.data[j];
+			zassert_true(val_is_equal(d.data[i * 2 + j], x, 1E-5),
+				     NULL);
+		}
+	}
+	zassert_equal(zsl_mtx_ger(1.0, &v, &u, &d), -EINVAL, NULL);
+}
+
 /**
  * @brief zsl_mtx_scalar_mult_d unit tests.
  *
@@ -998,57 +1634,353 @@ void test_matrix_trans(void)
 	zassert_true(val_is_equal(mt.data[7], 4.0, 1E-5), NULL);
 }
 
-void test_matrix_adjoint_3x3(void)
+void test_matrix_trans_d(void)
 {
 	int rc = 0;
-
-	ZSL_MATRIX_DEF(mad, 3, 3);
-
-	/* Input matrix. */
-	zsl_real_t data[9] = {  2.0, -3.0,  1.0,
-			       -4.0,  4.0,  3.0,
-			        3.0,  4.0, -5.0 };
-				
-	struct zsl_mtx m = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = data
+	size_t shapes[][2] = {
+		{ 1, 1 }, { 5, 5 }, { 40, 40 }, { 1, 7 }, { 7, 1 },
+		{ 2, 3 }, { 3, 8 }, { 9, 4 }, { 17, 33 }
 	};
 
-	/* Init matrix 'mad'. */
-	rc = zsl_mtx_init(&mad, NULL);
-	zassert_equal(rc, 0, NULL);
-
-	rc = zsl_mtx_adjoint_3x3(&m, &mad);
-	zassert_equal(rc, 0, NULL);
-	
-	/* Check the output. */
-	zassert_true(val_is_equal(mad.data[0], -32.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[1], -11.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[2], -13.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[3], -11.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[4], -13.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[5], -10.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[6], -28.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[7], -17.0, 1E-6), NULL);
-	zassert_true(val_is_equal(mad.data[8], -4.0, 1E-6), NULL);
+	ZSL_MATRIX_DEF(m, 40, 40);
+	ZSL_MATRIX_DEF(ref, 40, 40);
+
+	for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+		size_t r = shapes[s][0];
+		size_t c = shapes[s][1];
+
+		m.sz_rows = r;
+		m.sz_cols = c;
+		for (size_t i = 0; i < r * c; i++) {
+			m.data[i] = (zsl_real_t)i;
+		}
+
+		ref.sz_rows = c;
+		ref.sz_cols = r;
+		zsl_mtx_trans(&m, &ref);
+
+		rc = zsl_mtx_trans_d(&m);
+		zassert_equal(rc, 0, NULL);
+		zassert_equal(m.sz_rows, c, NULL);
+		zassert_equal(m.sz_cols, r, NULL);
+		for (size_t i = 0; i < r * c; i++) {
+			zassert_true(m.data[i] == ref.data[i], NULL);
+		}
+	}
 }
 
-void test_matrix_adjoint(void)
+/* Checks the fixed-size kernels for 'n' x 'n' inputs against a simple
+ * reference implementation. */
+static bool matrix_fixed_check(size_t n)
 {
-	int rc = 0;
+	zsl_real_t a[36], b[36], c[36], r[36];
+	zsl_real_t x[6], y[6];
 
-	ZSL_MATRIX_DEF(mad, 4, 4);
+	for (size_t i = 0; i < n * n; i++) {
+		a[i] = (zsl_real_t)((i * 7) % 11) - 5.0;
+		b[i] = (zsl_real_t)((i * 5) % 13) / 4.0 - 1.5;
+	}
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (zsl_real_t)i - 2.5;
+	}
 
-	/* Input matrix. */
-	zsl_real_t data[16] = {  2.0, -3.0,  1.0,  5.0,
-				-4.0,  4.0,  3.0, -3.0,
-				-2.0,  6.0,  1.0,  0.0,
-				 3.0,  4.0, -5.0, -8.0 };
-				 
-	struct zsl_mtx m = {
-		.sz_rows = 4,
-		.sz_cols = 4,
+	/* Multiplication. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			r[i * n + j] = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				r[i * n + j] += a[i * n + k] * b[k * n + j];
+			}
+		}
+	}
+	switch (n) {
+	case 2: zsl_mtx22_mult(a, b, c); break;
+	case 3: zsl_mtx33_mult(a, b, c); break;
+	case 4: zsl_mtx44_mult(a, b, c); break;
+	default: zsl_mtx66_mult(a, b, c); break;
+	}
+	for (size_t i = 0; i < n * n; i++) {
+		if (!val_is_equal(c[i], r[i], 1E-5)) {
+			return false;
+		}
+	}
+
+	/* Matrix-vector multiplication. */
+	switch (n) {
+	case 2: zsl_mtx22_mult_vec(a, x, y); break;
+	case 3: zsl_mtx33_mult_vec(a, x, y); break;
+	case 4: zsl_mtx44_mult_vec(a, x, y); break;
+	default: zsl_mtx66_mult_vec(a, x, y); break;
+	}
+	for (size_t i = 0; i < n; i++) {
+		zsl_real_t s = 0.0;
+		for (size_t k = 0; k < n; k++) {
+			s += a[i * n + k] * x[k];
+		}
+		if (!val_is_equal(y[i], s, 1E-5)) {
+			return false;
+		}
+	}
+
+	/* Addition and subtraction. */
+	switch (n) {
+	case 2: zsl_mtx22_add(a, b, c); zsl_mtx22_sub(c, b, r); break;
+	case 3: zsl_mtx33_add(a, b, c); zsl_mtx33_sub(c, b, r); break;
+	case 4: zsl_mtx44_add(a, b, c); zsl_mtx44_sub(c, b, r); break;
+	default: zsl_mtx66_add(a, b, c); zsl_mtx66_sub(c, b, r); break;
+	}
+	for (size_t i = 0; i < n * n; i++) {
+		if (!val_is_equal(c[i], a[i] + b[i], 1E-5) ||
+		    !val_is_equal(r[i], a[i], 1E-5)) {
+			return false;
+		}
+	}
+
+	/* Transpose, both out of place and in place. */
+	memcpy(c, a, n * n * sizeof(zsl_real_t));
+	switch (n) {
+	case 2: zsl_mtx22_trans(a, r); zsl_mtx22_trans(c, c); break;
+	case 3: zsl_mtx33_trans(a, r); zsl_mtx33_trans(c, c); break;
+	case 4: zsl_mtx44_trans(a, r); zsl_mtx44_trans(c, c); break;
+	default: zsl_mtx66_trans(a, r); zsl_mtx66_trans(c, c); break;
+	}
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			if ((r[j * n + i] != a[i * n + j]) ||
+			    (c[j * n + i] != a[i * n + j])) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void test_matrix_fixed(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(ma, 3, 3);
+	ZSL_MATRIX_DEF(mb, 3, 3);
+	ZSL_MATRIX_DEF(mc, 3, 3);
+	ZSL_MATRIX_DEF(vb, 3, 1);
+	ZSL_MATRIX_DEF(vc, 3, 1);
+
+	zassert_true(matrix_fixed_check(2), NULL);
+	zassert_true(matrix_fixed_check(3), NULL);
+	zassert_true(matrix_fixed_check(4), NULL);
+	zassert_true(matrix_fixed_check(6), NULL);
+
+	/* The generic functions give the same results, whether or not they
+	 * dispatch to the kernels. */
+	zsl_real_t a[9] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 10.0 };
+	zsl_real_t b[9] = { -1.0, 0.5, 2.0, 3.0, -2.0, 1.0, 0.0, 4.0, -3.0 };
+	zsl_real_t ab[9] = { 5.0, 8.5, -5.0, 11.0, 16.0, -5.0,
+			     17.0, 27.5, -8.0 };
+	zsl_real_t x[3] = { 1.0, -1.0, 2.0 };
+	zsl_real_t ax[3] = { 5.0, 11.0, 19.0 };
+
+	rc = zsl_mtx_from_arr(&ma, a);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&mb, b);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vb, x);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(mc.data[i], ab[i], 1E-5), NULL);
+	}
+
+	rc = zsl_mtx_mult(&ma, &vb, &vc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(vc.data[i], ax[i], 1E-5), NULL);
+	}
+
+	rc = zsl_mtx_trans(&ma, &mc);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mc.data[1], 4.0, 1E-5), NULL);
+	zassert_true(val_is_equal(mc.data[5], 8.0, 1E-5), NULL);
+
+	rc = zsl_mtx_sub(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_add(&mc, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mc, &ma), NULL);
+}
+
+ZSL_MTX_DECLARE_OPS(6, 6)
+ZSL_MTX_DECLARE_OPS(3, 6)
+ZSL_MTX_DECLARE_OPS(6, 3)
+ZSL_MTX_DECLARE_OPS(3, 3)
+ZSL_MTX_DECLARE_TRANS(3, 6)
+ZSL_MTX_DECLARE_MULT(3, 6, 6)
+ZSL_MTX_DECLARE_MULT(3, 6, 3)
+ZSL_MTX_DECLARE_MULT(6, 6, 6)
+ZSL_MTX_DECLARE_SQUARE_OPS(6)
+
+void test_matrix_fixed_decl(void)
+{
+	int rc;
+	zsl_real_t x[6], y[6], z[6];
+	struct zsl_mtx6x6 p, l, pi, t;
+	struct zsl_mtx3x6 h, hp;
+	struct zsl_mtx6x3 ht;
+	struct zsl_mtx3x3 s;
+	struct zsl_mtx mp, mh, mr;
+
+	ZSL_MATRIX_DEF(mref, 6, 6);
+	ZSL_MATRIX_DEF(mhp, 3, 6);
+	ZSL_MATRIX_DEF(ms, 3, 3);
+
+	zassert_equal(sizeof(p.data), 36 * sizeof(zsl_real_t), NULL);
+
+	/* A symmetric positive-definite 6x6 matrix, and a 3x6 matrix. */
+	zsl_mtx6x6_ident(&p);
+	zsl_mtx6x6_scalar_mult(&p, 4.0);
+	for (size_t i = 0; i < 5; i++) {
+		p.data[i * 6 + i + 1] = 0.5;
+		p.data[(i + 1) * 6 + i] = 0.5;
+	}
+	for (size_t i = 0; i < 18; i++) {
+		h.data[i] = (zsl_real_t)((i * 7) % 5) - 2.0;
+	}
+	for (size_t i = 0; i < 6; i++) {
+		x[i] = (zsl_real_t)i - 2.0;
+	}
+
+	/* The reference view matches the generic functions. */
+	mp = zsl_mtx6x6_ref(&p);
+	mh = zsl_mtx3x6_ref(&h);
+	zassert_equal(mh.sz_rows, 3, NULL);
+	zassert_equal(mh.sz_cols, 6, NULL);
+	zassert_true(mp.data == p.data, NULL);
+
+	/* H * P * H^T, against the generic functions. */
+	zsl_mtx3x6_mult_6x6(&h, &p, &hp);
+	zsl_mtx3x6_trans(&h, &ht);
+	zsl_mtx3x6_mult_6x3(&hp, &ht, &s);
+	zsl_mtx_mult(&mh, &mp, &mhp);
+	zsl_mtx_mult_ex(&mhp, false, &mh, true, 1.0, 0.0, &ms);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(s.data[i], ms.data[i], 1E-5), NULL);
+	}
+	zsl_mtx3x3_sub(&s, &s, &s);
+	zassert_true(s.data[4] == 0.0, NULL);
+
+	/* Matrix-vector products. */
+	zsl_mtx3x6_mult_vec(&h, x, y);
+	zsl_mtx3x6_mult_trans_vec(&h, y, z);
+	for (size_t i = 0; i < 3; i++) {
+		zsl_real_t r = 0.0;
+		for (size_t k = 0; k < 6; k++) {
+			r += h.data[i * 6 + k] * x[k];
+		}
+		zassert_true(val_is_equal(y[i], r, 1E-5), NULL);
+	}
+	for (size_t j = 0; j < 6; j++) {
+		zsl_real_t r = 0.0;
+		for (size_t i = 0; i < 3; i++) {
+			r += h.data[i * 6 + j] * y[i];
+		}
+		zassert_true(val_is_equal(z[j], r, 1E-5), NULL);
+	}
+
+	/* Cholesky factor and solve, against the generic functions. */
+	rc = zsl_mtx6x6_cholesky(&p, &l);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_cholesky(&mp, &mref);
+	for (size_t i = 0; i < 36; i++) {
+		zassert_true(val_is_equal(l.data[i], mref.data[i], 1E-5), NULL);
+	}
+	zsl_mtx6x6_chol_solve(&l, x, y);
+	zsl_mtx6x6_mult_vec(&p, y, z);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(z[i], x[i], 1E-5), NULL);
+	}
+
+	/* Inverse, checked through P * P^-1 = I, then in place. */
+	rc = zsl_mtx6x6_inv(&p, &pi);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx6x6_mult_6x6(&p, &pi, &t);
+	mr = zsl_mtx6x6_ref(&t);
+	for (size_t i = 0; i < 6; i++) {
+		for (size_t j = 0; j < 6; j++) {
+			zassert_true(val_is_equal(mr.data[i * 6 + j],
+						  (i == j) ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+	t = p;
+	rc = zsl_mtx6x6_inv(&t, &t);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx6x6_sub(&t, &pi, &t);
+	for (size_t i = 0; i < 36; i++) {
+		zassert_true(val_is_equal(t.data[i], 0.0, 1E-6), NULL);
+	}
+
+	/* Failures. */
+	zsl_mtx6x6_init(&t);
+	rc = zsl_mtx6x6_inv(&t, &pi);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	p.data[35] = -1.0;
+	rc = zsl_mtx6x6_cholesky(&p, &l);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+}
+
+void test_matrix_adjoint_3x3(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(mad, 3, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = {  2.0, -3.0,  1.0,
+			       -4.0,  4.0,  3.0,
+			        3.0,  4.0, -5.0 };
+				
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix 'mad'. */
+	rc = zsl_mtx_init(&mad, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_adjoint_3x3(&m, &mad);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Check the output. */
+	zassert_true(val_is_equal(mad.data[0], -32.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[1], -11.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[2], -13.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[3], -11.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[4], -13.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[5], -10.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[6], -28.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[7], -17.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mad.data[8], -4.0, 1E-6), NULL);
+}
+
+void test_matrix_adjoint(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(mad, 4, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[16] = {  2.0, -3.0,  1.0,  5.0,
+				-4.0,  4.0,  3.0, -3.0,
+				-2.0,  6.0,  1.0,  0.0,
+				 3.0,  4.0, -5.0, -8.0 };
+				 
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
 		.data = data
 	};
 
@@ -1271,6 +2203,12 @@ void test_matrix_augm_diag(void)
 		zassert_true(val_is_equal(maugm2.data[i], m3.data[i], 1E-6),
 			     NULL);
 	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* The output can't be smaller than the input. */
+	rc = zsl_mtx_augm_diag(&m3, &maugm);
+	zassert_equal(rc, -EINVAL, NULL);
+#endif
 }
 
 void test_matrix_deter_3x3(void)
@@ -1317,7 +2255,104 @@ void test_matrix_deter(void)
 	zassert_equal(rc, 0, NULL);
 	
 	/* Check the output. */
-	zassert_equal(x, -509.0, NULL);
+#if CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(x, -509.0, 1E-2), NULL);
+#else
+	zassert_true(val_is_equal(x, -509.0, 1E-6), NULL);
+#endif
+}
+
+void test_matrix_deter_large(void)
+{
+	int rc = 0;
+	zsl_real_t x = 0.0;
+
+	ZSL_MATRIX_DEF(m, 12, 12);
+
+	/* The nxn tridiagonal (-1, 2, -1) matrix has a determinant of n + 1. */
+	zsl_mtx_init(&m, NULL);
+	for (size_t i = 0; i < 12; i++) {
+		zsl_mtx_set(&m, i, i, 2.0);
+		if (i > 0) {
+			zsl_mtx_set(&m, i, i - 1, -1.0);
+			zsl_mtx_set(&m, i - 1, i, -1.0);
+		}
+	}
+
+	rc = zsl_mtx_deter(&m, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 13.0, 1E-3), NULL);
+
+	/* A repeated row gives a determinant of zero. */
+	for (size_t j = 0; j < 12; j++) {
+		zsl_mtx_set(&m, 5, j, m.data[2 * 12 + j]);
+	}
+	rc = zsl_mtx_deter(&m, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.0, 1E-6), NULL);
+}
+
+void test_matrix_lu(void)
+{
+	int rc = 0;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(l, 4, 4);
+	ZSL_MATRIX_DEF(u, 4, 4);
+	ZSL_MATRIX_DEF(p, 4, 4);
+	ZSL_MATRIX_DEF(pm, 4, 4);
+	ZSL_MATRIX_DEF(lu, 4, 4);
+	ZSL_MATRIX_DEF(bad, 3, 3);
+
+	/* Input matrix, which requires pivoting (m[0][0] is zero). */
+	zsl_real_t data[16] = { 0.0,  2.0, 1.0, -1.0,
+				3.0, -1.0, 4.0,  2.0,
+				6.0,  1.0, 0.5,  3.0,
+				-2.0, 5.0, 1.0,  7.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	rc = zsl_mtx_lu(&m, &l, &u, &p);
+	zassert_equal(rc, 0, NULL);
+
+	/* L is unit lower triangular, U is upper triangular. */
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(l.data[i * 4 + i], 1.0, 1E-6), NULL);
+		for (size_t j = i + 1; j < 4; j++) {
+			zassert_true(val_is_equal(l.data[i * 4 + j], 0.0, 1E-6),
+				     NULL);
+			zassert_true(val_is_equal(u.data[j * 4 + i], 0.0, 1E-6),
+				     NULL);
+		}
+		/* Partial pivoting keeps all multipliers <= 1. */
+		for (size_t j = 0; j < i; j++) {
+			zassert_true(l.data[i * 4 + j] <= 1.0, NULL);
+			zassert_true(l.data[i * 4 + j] >= -1.0, NULL);
+		}
+	}
+
+	/* P * m == L * U. */
+	rc = zsl_mtx_mult(&p, &m, &pm);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&l, &u, &lu);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 16; i++) {
+		zassert_true(val_is_equal(pm.data[i], lu.data[i], 1E-5), NULL);
+	}
+
+	/* The determinant matches the product of U's diagonal and sign(P). */
+	rc = zsl_mtx_deter(&m, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ZSL_ABS(x), ZSL_ABS(u.data[0] * u.data[5] *
+						     u.data[10] * u.data[15]),
+				  1E-3), NULL);
+
+	/* Outputs that aren't the same shape as 'm' are rejected. */
+	rc = zsl_mtx_lu(&m, &bad, &u, &p);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 
 void test_matrix_gauss_elim(void)
@@ -1481,6 +2516,58 @@ void test_matrix_gauss_reduc(void)
 	for (size_t i = 0; i < (vb.sz_rows * vb.sz_cols); i++) {
 		zassert_true(val_is_equal(va.data[i], vb.data[i], 1E-6), NULL);
 	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* The outputs must be the same shape as the input. */
+	va.sz_cols = 2;
+	rc = zsl_mtx_gauss_reduc(&mb, &va, &vb);
+	zassert_equal(rc, -EINVAL, NULL);
+#endif
+}
+
+void test_matrix_gauss_jordan_d(void)
+{
+	int rc = 0;
+
+	/* Augmented [A | B], with a zero leading pivot and two RHS columns. */
+	zsl_real_t data[15] = { 0.0,  2.0,  1.0,  7.0,  1.0,
+				1.0,  1.0,  1.0,  6.0,  0.0,
+				2.0,  1.0, -1.0,  1.0,  2.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	/* [I | A^-1 * B]. */
+	zsl_real_t dtst[15] = { 1.0,  0.0,  0.0,  1.0,  0.0,
+				0.0,  1.0,  0.0,  2.0,  1.0,
+				0.0,  0.0,  1.0,  3.0, -1.0 };
+
+	/* Singular coefficient block, with one RHS column. */
+	zsl_real_t dsng[12] = { 1.0,  2.0,  3.0,  1.0,
+				2.0,  4.0,  6.0,  2.0,
+				1.0,  0.0,  1.0,  3.0 };
+	struct zsl_mtx ms = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = dsng
+	};
+
+	rc = zsl_mtx_gauss_jordan_d(&m, 3);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 15; i++) {
+		zassert_true(val_is_equal(m.data[i], dtst[i], 1E-6), NULL);
+	}
+
+	rc = zsl_mtx_gauss_jordan_d(&ms, 3);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* The coefficient block must fit inside the matrix. */
+	rc = zsl_mtx_gauss_jordan_d(&m, 4);
+	zassert_equal(rc, -EINVAL, NULL);
+#endif
 }
 
 void test_matrix_gram_schmidt_sq(void)
@@ -1604,6 +2691,56 @@ void test_matrix_cols_norm(void)
 	}
 }
 
+void test_matrix_gram_schmidt_d(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(q, 8, 6);
+	ZSL_MATRIX_DEF(mot, 4, 3);
+
+	zsl_real_t data[12] = {  1.0,  5.0,  6.0,
+				-1.0,  2.0, -2.0,
+				-4.0, -2.0,  8.0,
+				 4.0,  3.0,  0.0 };
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 3, .data = data };
+
+	/* In place, the result matches the out-of-place version. */
+	rc = zsl_mtx_gram_schmidt(&m, &mot);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_gram_schmidt_d(&m);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 12; g++) {
+		zassert_true(val_is_equal(m.data[g], mot.data[g], 1E-6), NULL);
+	}
+
+	/* The columns of a Hilbert matrix are nearly dependent, which leaves
+	 * classical Gram-Schmidt far from orthogonal. */
+	for (size_t i = 0; i < 8; i++) {
+		for (size_t j = 0; j < 6; j++) {
+			q.data[i * 6 + j] = 1.0 / (zsl_real_t)(i + j + 1);
+		}
+	}
+	rc = zsl_mtx_gram_schmidt_d(&q);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_cols_norm_d(&q);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t a = 0; a < 6; a++) {
+		for (size_t b = 0; b < 6; b++) {
+			x = 0.0;
+			for (size_t i = 0; i < 8; i++) {
+				x += q.data[i * 6 + a] * q.data[i * 6 + b];
+			}
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+			zassert_true(val_is_equal(x, a == b, 1E-3), NULL);
+#else
+			zassert_true(val_is_equal(x, a == b, 1E-10), NULL);
+#endif
+		}
+	}
+}
+
 void test_matrix_norm_elem(void)
 {
 	int rc = 0;
@@ -1728,6 +2865,80 @@ void test_matrix_inv_3x3(void)
 	zassert_true(val_is_equal(mi.data[6],  0.02122413, 1E-6), NULL);
 	zassert_true(val_is_equal(mi.data[7], -0.01080295, 1E-6), NULL);
 	zassert_true(val_is_equal(mi.data[8],  0.00447788, 1E-6), NULL);
+
+	/* In place inversion gives the same result. */
+	rc = zsl_mtx_inv_3x3(&m, &m);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mi), NULL);
+}
+
+void test_matrix_inv_4x4(void)
+{
+	int rc = 0;
+	zsl_real_t d;
+
+	ZSL_MATRIX_DEF(mi, 4, 4);
+	ZSL_MATRIX_DEF(mg, 4, 4);
+	ZSL_MATRIX_DEF(mp, 4, 4);
+	ZSL_MATRIX_DEF(id, 4, 4);
+	ZSL_MATRIX_DEF(m3, 3, 3);
+
+	/* Input matrix, with a zero leading entry. */
+	zsl_real_t data[16] = { 0.0,  2.0, -1.0,  3.0,
+				1.0,  4.0,  0.5, -2.0,
+				3.0, -1.0,  2.0,  1.0,
+				2.0,  0.0,  1.0,  5.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Singular input matrix, with row 3 = row 0 + row 1. */
+	zsl_real_t dsng[16] = { 1.0, 2.0, 3.0, 4.0,
+				0.5, 1.0, 0.0, 2.0,
+				3.0, 1.0, 4.0, 1.0,
+				1.5, 3.0, 3.0, 6.0 };
+	struct zsl_mtx ms = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dsng
+	};
+
+	rc = zsl_mtx_inv_4x4(&m, &mi);
+	zassert_equal(rc, 0, NULL);
+
+	/* The result must match Gauss-Jordan, and m * mi must be I. */
+	zsl_mtx_copy(&mg, &m);
+	rc = zsl_mtx_inv_d(&mg);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&m, &mi, &mp);
+	zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
+	for (size_t i = 0; i < 16; i++) {
+		zassert_true(val_is_equal(mi.data[i], mg.data[i], 1E-5), NULL);
+		zassert_true(val_is_equal(mp.data[i], id.data[i], 1E-5), NULL);
+	}
+
+	/* zsl_mtx_inv dispatches 4x4 inputs to the same kernel. */
+	rc = zsl_mtx_inv(&m, &mp);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mp, &mi), NULL);
+
+	/* The in-place kernel returns the determinant from the same pass. */
+	d = zsl_mtx44_inv(m.data, m.data);
+	zassert_true(val_is_equal(d, 40.0, 1E-5), NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mi), NULL);
+
+	/* Singular matrices give the identity. */
+	rc = zsl_mtx_inv_4x4(&ms, &mi);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mi, &id), NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Only 4x4 matrices are accepted. */
+	rc = zsl_mtx_inv_4x4(&m, &m3);
+	zassert_equal(rc, -EINVAL, NULL);
+#endif
 }
 
 void test_matrix_inv(void)
@@ -1771,694 +2982,2528 @@ void test_matrix_inv(void)
 	zassert_true(zsl_mtx_is_equal(&mi, &mtst), NULL);
 }
 
-void test_matrix_balance(void)
+void test_matrix_inv_d(void)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(moa, 4, 4);
-	ZSL_MATRIX_DEF(mob, 4, 4);
-
-	/* Input non-symmetric matrix. */
-	zsl_real_t data[16] = { 5.1, -3.2, 4.9, -8.1,
-				2.3, -4.1, -2.8, 0.2,
-				0.0, -7.7, 2.1, 0.0,
-				-0.7, 8.1, -5.5, 3.7 };
+	int rc = 0;
 
-	struct zsl_mtx ma = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = data
-	};
+	ZSL_MATRIX_DEF(mi, 5, 5);
+	ZSL_MATRIX_DEF(mr, 3, 2);
 
-	/* Input symmetric matrix. */
-	zsl_real_t datb[16] = { 5.1, 2.3, 0.0, -8.1,
-				2.3, -4.1, -2.8, 0.2,
-				0.0, -2.8, 2.1, -5.5,
-				-8.1, 0.2, -5.5, 3.7 };
-
-	struct zsl_mtx mb = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datb
+	/* Input matrix, which needs row interchanges to invert. */
+	zsl_real_t data[25] = { 1.0, 1.0, 2.0, 2.0, 1.0,
+				0.0, 0.0, 0.0, 1.0, 2.0,
+				0.0, 0.0, 1.0, 2.0, 2.0,
+				0.0, 0.0, 1.0, 1.0, 2.0,
+				0.0, 1.0, 1.0, 2.0, 1.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
 	};
 
-	/* Expected output. */
-	zsl_real_t dt[16] = { 5.1, -1.6, 2.45, -8.1,
-			      4.6, -4.1, -2.8, 0.4,
-			      0.0, -7.7, 2.1, 0.0,
-			      -0.7, 4.05, -2.75, 3.7 };
-
-	struct zsl_mtx mt = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = dt
+	/* Singular input matrix. */
+	zsl_real_t dsng[9] = { 1.0, 2.0, 3.0,
+			       4.0, 5.0, 6.0,
+			       7.0, 8.0, 9.0 };
+	struct zsl_mtx ms = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dsng
 	};
 
-	/* Init output matrices. */
-	rc = zsl_mtx_init(&moa, NULL);
+	/* The in-place result should match zsl_mtx_inv. */
+	rc = zsl_mtx_inv(&m, &mi);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&mob, NULL);
+	rc = zsl_mtx_inv_d(&m);
 	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 25; i++) {
+		zassert_true(val_is_equal(m.data[i], mi.data[i], 1E-6), NULL);
+	}
 
-	/* Balance the input matrices. */
-	rc = zsl_mtx_balance(&ma, &moa);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_balance(&mb, &mob);
-	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_inv_d(&ms);
+	zassert_equal(rc, -ESINGULAR, NULL);
 
-	/* Check the output. */
-	for (size_t g = 0; g < (ma.sz_rows * ma.sz_cols); g++) {
-		zassert_true(val_is_equal(moa.data[g], mt.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(mob.data[g], mb.data[g], 1E-6), NULL);
-	}
+	rc = zsl_mtx_inv_d(&mr);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 
-void test_matrix_householder_sq(void)
+void test_matrix_batch(void)
 {
-	int rc;
+	int rc = 0;
 
-	ZSL_MATRIX_DEF(h, 3, 3);
+	ZSL_MATRIX_BATCH_DEF(ba, 3, 3, 5);
+	ZSL_MATRIX_BATCH_DEF(bb, 3, 2, 5);
+	ZSL_MATRIX_BATCH_DEF(bc, 3, 2, 5);
+	ZSL_MATRIX_BATCH_DEF(bi, 3, 3, 5);
+	ZSL_MATRIX_BATCH_DEF(bx, 2, 2, 4);
+	ZSL_MATRIX_DEF(ma, 3, 3);
+	ZSL_MATRIX_DEF(mb, 3, 2);
+	ZSL_MATRIX_DEF(mc, 3, 2);
+	ZSL_MATRIX_DEF(mt, 3, 2);
+	ZSL_MATRIX_DEF(mi, 3, 3);
+	ZSL_MATRIX_DEF(mj, 3, 3);
+
+	/* Matrix 3 of the batch is singular. */
+	zsl_real_t da[9] = { 2.0, -1.0,  0.5,
+			     1.0,  3.0, -2.0,
+			     0.0,  1.5,  4.0 };
+	zsl_real_t db[6] = { 1.0,  2.0,
+			    -1.0,  0.5,
+			     3.0, -2.0 };
+
+	rc = zsl_mtx_batch_init(&ba);
+	zassert_equal(rc, 0, NULL);
+	for (size_t b = 0; b < 5; b++) {
+		zsl_mtx_from_arr(&ma, da);
+		zsl_mtx_from_arr(&mb, db);
+		zsl_mtx_scalar_mult_d(&mb, (zsl_real_t)b - 2.0);
+		if (b == 3) {
+			zsl_mtx_scalar_mult_row_d(&ma, 2, 0.0);
+		} else {
+			ma.data[b] += (zsl_real_t)b;
+		}
+		rc = zsl_mtx_batch_set(&ba, b, &ma);
+		zassert_equal(rc, 0, NULL);
+		rc = zsl_mtx_batch_set(&bb, b, &mb);
+		zassert_equal(rc, 0, NULL);
+	}
 
-	/* Input matrix. */
-	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
-			       2.0, 4.0, -2.0,
-			       0.0, 4.0, 2.0 };
+	/* Each batch result must match the single-matrix functions. */
+	rc = zsl_mtx_batch_mult(&ba, &bb, &bc);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_batch_inv_3x3(&ba, &bi);
+	zassert_equal(rc, 0, NULL);
+	for (size_t b = 0; b < 5; b++) {
+		zsl_mtx_batch_get(&ba, b, &ma);
+		zsl_mtx_batch_get(&bb, b, &mb);
+		zsl_mtx_mult(&ma, &mb, &mt);
+		rc = zsl_mtx_batch_get(&bc, b, &mc);
+		zassert_equal(rc, 0, NULL);
+		for (size_t e = 0; e < 6; e++) {
+			zassert_true(val_is_equal(mc.data[e], mt.data[e], 1E-5),
+				     NULL);
+		}
+
+		zsl_mtx_inv_3x3(&ma, &mj);
+		zsl_mtx_batch_get(&bi, b, &mi);
+		for (size_t e = 0; e < 9; e++) {
+			zassert_true(val_is_equal(mi.data[e], mj.data[e], 1E-5),
+				     NULL);
+		}
+	}
+
+	/* In place inversion gives the same result. */
+	rc = zsl_mtx_batch_inv_3x3(&ba, &ba);
+	zassert_equal(rc, 0, NULL);
+	for (size_t e = 0; e < 45; e++) {
+		zassert_true(val_is_equal(ba.data[e], bi.data[e], 1E-6), NULL);
+	}
+
+	/* Mismatched shapes and sizes are rejected. */
+	rc = zsl_mtx_batch_inv_3x3(&bx, &bx);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_batch_mult(&bb, &ba, &bc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_batch_get(&ba, 5, &ma);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_cholesky(void)
+{
+	int rc = 0;
 
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(bad, 3, 3);
+
+	/* Input symmetric positive-definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
 	struct zsl_mtx m = {
 		.sz_rows = 3,
 		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Init matrix h. */
-	rc = zsl_mtx_init(&h, NULL);
-	zassert_equal(rc, 0, NULL);
+	/* Expected lower triangular factor. */
+	zsl_real_t ltst[9] = {  2.0, 0.0, 0.0,
+				6.0, 1.0, 0.0,
+			       -8.0, 5.0, 3.0 };
 
-	/* Compute the Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, false);
+	rc = zsl_mtx_cholesky(&m, &l);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtst[9] = { 0.0, 1.0, 0.0,
-			       1.0, 0.0, 0.0,
-			       0.0, 0.0, 1.0 };
-
-	struct zsl_mtx mt = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = dtst
-	};
-
-	/* Check the output. */
-	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
-		zassert_true(val_is_equal(h.data[g], mt.data[g], 1E-6), NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(l.data[i], ltst[i], 1E-5), NULL);
 	}
-	
-	/* Compute the Hessenberg-Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, true);
-	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtsa[16] = { 1.0, 0.0, 0.0,
-				0.0, 1.0, 0.0,
-				0.0, 0.0, 1.0 };
-
-	struct zsl_mtx mt2 = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = dtsa
-	};
 
-	/* Check the output. */
-	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
-		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	/* In place. */
+	rc = zsl_mtx_cholesky(&m, &m);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(m.data[i], ltst[i], 1E-5), NULL);
 	}
+
+	/* Indefinite matrices are rejected. */
+	zsl_mtx_init(&bad, zsl_mtx_entry_fn_identity);
+	zsl_mtx_set(&bad, 2, 2, -1.0);
+	rc = zsl_mtx_cholesky(&bad, &l);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
 }
 
-void test_matrix_householder_rect(void)
+void test_matrix_chol_solve(void)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(h, 4, 4);
+	int rc = 0;
 
-	/* Input matrix. */
-	zsl_real_t data[12] = { 1.0, -1.0, 4.0,
-				1.0, 4.0, -2.0,
-				1.0, 4.0, 2.0,
-				1.0, -1.0, 0.0 };
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(x, 3, 2);
+	ZSL_MATRIX_DEF(ax, 3, 2);
 
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
 	struct zsl_mtx m = {
-		.sz_rows = 4,
+		.sz_rows = 3,
 		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Init matrix h. */
-	rc = zsl_mtx_init(&h, NULL);
-	zassert_equal(rc, 0, NULL);
-
-	/* Compute the Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, false);
-	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtst[16] = { 0.5, 0.5, 0.5, 0.5,
-				0.5, 0.5, -0.5, -0.5,
-				0.5, -0.5, 0.5, -0.5,
-				0.5, -0.5, -0.5, 0.5 };
-
-	struct zsl_mtx mt = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = dtst
+	/* Two right-hand sides. */
+	zsl_real_t bdata[6] = { 1.0,  0.0,
+				2.0, -3.0,
+				3.0,  5.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = bdata
 	};
 
-	/* Check the output. */
-	zassert_true(zsl_mtx_is_equal(&h, &mt), NULL);
-	
-	/* Compute the Hessenberg-Householder matrix. */
-	rc = zsl_mtx_householder(&m, &h, true);
+	rc = zsl_mtx_cholesky(&m, &l);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_chol_solve(&l, &b, &x);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t dtsa[16] = { 1.0, 0.000000, 0.000000, 0.000000,
-				0.0, 0.577350, 0.577350, 0.577350,
-				0.0, 0.577350, 0.211325, -0.788675,
-				0.0, 0.577350, -0.788675, 0.211325 };
 
-	struct zsl_mtx mt2 = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = dtsa
-	};
+	/* m * x == b. */
+	rc = zsl_mtx_mult(&m, &x, &ax);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(ax.data[i], bdata[i], 1E-3), NULL);
+	}
 
-	/* Check the output. */
-	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
-		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	/* Solving in place gives the same result. */
+	rc = zsl_mtx_chol_solve(&l, &b, &b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(b.data[i], x.data[i], 1E-6), NULL);
 	}
+
+	/* Mismatched right-hand side. */
+	rc = zsl_mtx_chol_solve(&l, &l, &x);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 
-void test_matrix_qrd(void)
+void test_matrix_chol_update(void)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(q, 3, 3);
-	ZSL_MATRIX_DEF(r, 3, 3);
+	int rc = 0;
 
-	/* Input matrix. */
-	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
-			       2.0, 4.0, -2.0,
-			       0.0, 4.0, 2.0 };
+	ZSL_MATRIX_DEF(l, 3, 3);
+	ZSL_MATRIX_DEF(ltst, 3, 3);
 
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				12.0,  37.0, -43.0,
+			       -16.0, -43.0,  98.0 };
 	struct zsl_mtx m = {
 		.sz_rows = 3,
 		.sz_cols = 3,
 		.data = data
 	};
 
-	/* The expected results for Q and R matrices for test purposes. */
-	zsl_real_t qdata[9] = { 0.0, 0.0, 1.0,
-				1.0, 0.0, 0.0,
-				0.0, 1.0, 0.0 };
-
-	struct zsl_mtx q2 = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = qdata
+	zsl_real_t vdata[3] = { 1.0, -2.0, 0.5 };
+	struct zsl_vec v = {
+		.sz = 3,
+		.data = vdata
 	};
 
-	zsl_real_t rdata[9] = { 2.0, 4.0, -2.0,
-				0.0, 4.0, 2.0,
-				0.0, 0.0, 4.0 };
+	rc = zsl_mtx_cholesky(&m, &l);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_chol_update(&l, &v);
+	zassert_equal(rc, 0, NULL);
 
-	struct zsl_mtx r2 = {
-		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = rdata
-	};
+	/* Compare with a full decomposition of m + v * v^T. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			data[i * 3 + j] += vdata[i] * vdata[j];
+		}
+	}
+	rc = zsl_mtx_cholesky(&m, &ltst);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(l.data[i], ltst.data[i], 1E-5), NULL);
+	}
 
+	/* The update vector is left unmodified. */
+	zassert_true(val_is_equal(vdata[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(vdata[1], -2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(vdata[2], 0.5, 1E-6), NULL);
+}
 
-	/* Init matrices Q and R. */
-	rc = zsl_mtx_init(&q, NULL);
+void test_matrix_inv_update(void)
+{
+	int rc = 0;
+	zsl_real_t d, dtst;
+
+	ZSL_MATRIX_DEF(mi, 4, 4);
+	ZSL_MATRIX_DEF(mitst, 4, 4);
+
+	zsl_real_t data[16] = { 4.0, 1.0, 0.5, -1.0,
+				1.0, 3.0, 0.0, 0.25,
+				0.5, 0.0, 2.0, 0.5,
+				-1.0, 0.25, 0.5, 5.0 };
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 4, .data = data };
+
+	zsl_real_t rdata[4] = { 2.0, -1.0, 3.0, 0.5 };
+	struct zsl_vec row = { .sz = 4, .data = rdata };
+
+	zsl_real_t udata[4] = { 0.5, 1.0, -0.5, 0.25 };
+	zsl_real_t vdata[4] = { 1.0, 0.0, 2.0, -1.0 };
+	struct zsl_vec u = { .sz = 4, .data = udata };
+	struct zsl_vec v = { .sz = 4, .data = vdata };
+
+	rc = zsl_mtx_inv(&m, &mi);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&r, NULL);
+	rc = zsl_mtx_deter(&m, &d);
 	zassert_equal(rc, 0, NULL);
 
-	/* Calculate the QR decomposition. */
-	rc = zsl_mtx_qrd(&m, &q, &r, false);
+	/* Replace a row, and compare with a full inversion. */
+	rc = zsl_mtx_inv_update_row(&m, &mi, 2, &row, &d);
 	zassert_equal(rc, 0, NULL);
+	for (size_t k = 0; k < 4; k++) {
+		zassert_true(val_is_equal(data[8 + k], rdata[k], 1E-6), NULL);
+	}
+	rc = zsl_mtx_inv(&m, &mitst);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_deter(&m, &dtst);
+	zassert_equal(rc, 0, NULL);
+	for (size_t k = 0; k < 16; k++) {
+		zassert_true(val_is_equal(mi.data[k], mitst.data[k], 1E-5),
+			     NULL);
+	}
+	zassert_true(val_is_equal(d, dtst, 1E-4), NULL);
 
-	/* Check the output. */
-	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
-		zassert_true(val_is_equal(q.data[g], q2.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(r.data[g], r2.data[g], 1E-6), NULL);
+	/* A general rank-1 update of the inverse and determinant. */
+	rc = zsl_mtx_inv_rank1(&mi, &u, &v, &d);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			data[i * 4 + j] += udata[i] * vdata[j];
+		}
+	}
+	rc = zsl_mtx_inv(&m, &mitst);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_deter(&m, &dtst);
+	zassert_equal(rc, 0, NULL);
+	for (size_t k = 0; k < 16; k++) {
+		zassert_true(val_is_equal(mi.data[k], mitst.data[k], 1E-5),
+			     NULL);
+	}
+	zassert_true(val_is_equal(d, dtst, 1E-4), NULL);
+
+	/* Making two rows equal is rejected, leaving 'm' unchanged. */
+	for (size_t k = 0; k < 4; k++) {
+		rdata[k] = data[k];
 	}
+	rc = zsl_mtx_inv_update_row(&m, &mi, 1, &row, NULL);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	zassert_false(val_is_equal(data[4], data[0], 1E-6) &&
+		      val_is_equal(data[5], data[1], 1E-6), NULL);
 }
 
-void test_matrix_qrd_hess(void)
+void test_matrix_solve(void)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(q, 4, 4);
-	ZSL_MATRIX_DEF(r, 4, 4);
+	int rc = 0;
 
-	/* Input matrix. */
-	zsl_real_t data[16] = { 1.0, 0.0, 4.0, -3.0,
-				2.0, 4.0, -2.0, 7.0,
-				-3.0, 4.0, 2.0, 0.0,
-				5.0, -4.0, 0.0, 6.0 };
+	ZSL_MATRIX_DEF(x, 4, 2);
+	ZSL_MATRIX_DEF(ax, 4, 2);
+	ZSL_MATRIX_DEF(sing, 4, 4);
 
-	struct zsl_mtx m = {
+	/* Input matrix, which requires pivoting (a[0][0] is zero). */
+	zsl_real_t data[16] = { 0.0,  2.0, 1.0, -1.0,
+				3.0, -1.0, 4.0,  2.0,
+				6.0,  1.0, 0.5,  3.0,
+				-2.0, 5.0, 1.0,  7.0 };
+	struct zsl_mtx a = {
 		.sz_rows = 4,
 		.sz_cols = 4,
 		.data = data
 	};
 
-	/* Init matrices Q and R. */
-	rc = zsl_mtx_init(&q, NULL);
+	/* Two right-hand sides. */
+	zsl_real_t bdata[8] = { 1.0,  2.0,
+				0.0, -1.0,
+				4.0,  0.5,
+				-3.0, 1.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = bdata
+	};
+
+	rc = zsl_mtx_solve(&a, &b, &x);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&r, NULL);
+
+	/* a * x == b, and 'a' is unmodified. */
+	zassert_true(val_is_equal(data[0], 0.0, 1E-6), NULL);
+	rc = zsl_mtx_mult(&a, &x, &ax);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Perform the Hessenberg transformation on the input matrix. */
-	rc = zsl_mtx_qrd(&m, &q, &r, true);
+	for (size_t i = 0; i < 8; i++) {
+		zassert_true(val_is_equal(ax.data[i], bdata[i], 1E-5), NULL);
+	}
+
+	/* Solving in place gives the same result. */
+	rc = zsl_mtx_solve(&a, &b, &b);
 	zassert_equal(rc, 0, NULL);
-	
-	/* Expected output. */
-	zsl_real_t hdata[16] = {
+	for (size_t i = 0; i < 8; i++) {
+		zassert_true(val_is_equal(b.data[i], x.data[i], 1E-6), NULL);
+	}
+
+	/* Singular matrices are rejected. */
+	zsl_mtx_init(&sing, zsl_mtx_entry_fn_identity);
+	zsl_mtx_set(&sing, 3, 3, 0.0);
+	rc = zsl_mtx_solve(&sing, &x, &x);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* Mismatched right-hand side. */
+	rc = zsl_mtx_solve(&a, &sing, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_lu_solve(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(lu, 4, 4);
+	ZSL_MATRIX_DEF(x, 4, 2);
+	ZSL_MATRIX_DEF(ax, 4, 2);
+	ZSL_VECTOR_DEF(perm, 4);
+
+	zsl_real_t data[16] = { 0.0,  2.0, 1.0, -1.0,
+				3.0, -1.0, 4.0,  2.0,
+				6.0,  1.0, 0.5,  3.0,
+				-2.0, 5.0, 1.0,  7.0 };
+	struct zsl_mtx a = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	zsl_real_t bdata[8] = { 1.0,  2.0,
+				0.0, -1.0,
+				4.0,  0.5,
+				-3.0, 1.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = bdata
+	};
+
+	/* Factor once, then solve for each right-hand side. */
+	zsl_mtx_copy(&lu, &a);
+	rc = zsl_mtx_lu_fact_d(&lu, &perm);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_lu_solve(&lu, &perm, &b, &x);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_mult(&a, &x, &ax);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		zassert_true(val_is_equal(ax.data[i], bdata[i], 1E-5), NULL);
+	}
+
+	/* Singular matrices are rejected. */
+	zsl_mtx_init(&lu, zsl_mtx_entry_fn_identity);
+	zsl_mtx_set(&lu, 2, 2, 0.0);
+	rc = zsl_mtx_lu_fact_d(&lu, &perm);
+	zassert_equal(rc, -ESINGULAR, NULL);
+}
+
+void test_matrix_rcond(void)
+{
+	int rc;
+	zsl_real_t rcond, an, ain;
+
+	ZSL_MATRIX_DEF(mi, 4, 4);
+	ZSL_MATRIX_DEF(lu, 4, 4);
+	ZSL_VECTOR_DEF(perm, 4);
+
+	/* A non-symmetric matrix that needs row swaps. */
+	zsl_real_t data[16] = { 0.5, 2.0, -1.0, 3.0,
+				4.0, 1.0, 0.25, -2.0,
+				-1.0, 3.0, 2.0, 0.5,
+				2.0, -0.5, 1.0, 1.0 };
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 4, .data = data };
+
+	zsl_real_t dd[4] = { 1.0, 0.0, 0.0, 1E-4 };
+	struct zsl_mtx d = { .sz_rows = 2, .sz_cols = 2, .data = dd };
+
+	zsl_real_t ds[4] = { 1.0, 2.0, 2.0, 4.0 };
+	struct zsl_mtx sing = { .sz_rows = 2, .sz_cols = 2, .data = ds };
+
+	/* The estimate of ||A^-1|| is a lower bound, within a factor of 3. */
+	rc = zsl_mtx_rcond(&m, &rcond);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_inv(&m, &mi);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_norm_1(&m, &an);
+	zsl_mtx_norm_1(&mi, &ain);
+	zassert_true(rcond >= 1.0 / (an * ain) * (1.0 - 1E-5), NULL);
+	zassert_true(rcond <= 3.0 / (an * ain), NULL);
+
+	/* The same estimate from existing factors. */
+	zsl_mtx_copy(&lu, &m);
+	rc = zsl_mtx_lu_fact_d(&lu, &perm);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_rcond_lu(&lu, &perm, an, &an);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(an, rcond, 1E-6), NULL);
+
+	rc = zsl_mtx_rcond(&d, &rcond);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(rcond, 1E-4, 1E-8), NULL);
+
+	/* Singular matrices give zero. */
+	rc = zsl_mtx_rcond(&sing, &rcond);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(rcond, 0.0, 1E-8), NULL);
+
+	/* Only square matrices have an inverse. */
+	m.sz_cols = 2;
+	rc = zsl_mtx_rcond(&m, &rcond);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_solve_refine(void)
+{
+	int rc = 0;
+	zsl_real_t err;
+	zsl_real_t x_err = 0.0;
+	zsl_real_t xr_err = 0.0;
+
+	ZSL_MATRIX_DEF(a, 5, 5);
+	ZSL_MATRIX_DEF(ai, 5, 5);
+	ZSL_MATRIX_DEF(b, 5, 1);
+	ZSL_MATRIX_DEF(x, 5, 1);
+	ZSL_MATRIX_DEF(xr, 5, 1);
+	ZSL_MATRIX_DEF(sing, 5, 5);
+
+	/* The exact inverse of the 5x5 Hilbert matrix. */
+	zsl_real_t hinv[25] = {
+		25.0, -300.0, 1050.0, -1400.0, 630.0,
+		-300.0, 4800.0, -18900.0, 26880.0, -12600.0,
+		1050.0, -18900.0, 79380.0, -117600.0, 56700.0,
+		-1400.0, 26880.0, -117600.0, 179200.0, -88200.0,
+		630.0, -12600.0, 56700.0, -88200.0, 44100.0
+	};
+
+	/* 2520 times the 5x5 Hilbert matrix, which has integer entries and a
+	 * condition number of around 5E5. With x = (1, -1, 1, -1, 1), 'b' is
+	 * also exact. */
+	for (size_t i = 0; i < 5; i++) {
+		b.data[i] = 0.0;
+		for (size_t j = 0; j < 5; j++) {
+			a.data[i * 5 + j] = 2520.0 / (zsl_real_t)(i + j + 1);
+			b.data[i] += (j & 1) ? -a.data[i * 5 + j] :
+				     a.data[i * 5 + j];
+		}
+	}
+
+	rc = zsl_mtx_solve(&a, &b, &x);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_solve_refine(&a, &b, &xr, 5);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t i = 0; i < 5; i++) {
+		zsl_real_t t = (i & 1) ? -1.0 : 1.0;
+
+		x_err = ZSL_MAX(x_err, ZSL_ABS(x.data[i] - t));
+		xr_err = ZSL_MAX(xr_err, ZSL_ABS(xr.data[i] - t));
+	}
+
+	/* Refinement is at least as accurate as the plain solve, and accurate
+	 * to roughly the working precision. */
+	zassert_true(xr_err <= x_err, NULL);
+#if CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(xr_err < 1E-5, NULL);
+#else
+	zassert_true(xr_err < 1E-12, NULL);
+#endif
+
+	/* Solving in place gives the same result. */
+	rc = zsl_mtx_solve_refine(&a, &b, &b, 5);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(b.data[i] == xr.data[i], NULL);
+	}
+
+	/* The refined inverse matches the exact inverse. */
+	rc = zsl_mtx_inv_refine(&a, &ai, 5);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 25; i++) {
+		err = ZSL_ABS(ai.data[i] * 2520.0 - hinv[i]) / 179200.0;
+#if CONFIG_ZSL_SINGLE_PRECISION
+		zassert_true(err < 1E-5, NULL);
+#else
+		zassert_true(err < 1E-12, NULL);
+#endif
+	}
+
+	/* Singular matrices are rejected. */
+	zsl_mtx_init(&sing, zsl_mtx_entry_fn_identity);
+	zsl_mtx_set(&sing, 2, 2, 0.0);
+	rc = zsl_mtx_solve_refine(&sing, &b, &x, 2);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	rc = zsl_mtx_inv_refine(&sing, &ai, 2);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* Mismatched shapes. */
+	rc = zsl_mtx_solve_refine(&a, &sing, &x, 2);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_inv_refine(&a, &x, 2);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_expm(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(e, 2, 2);
+	ZSL_MATRIX_DEF(e3, 3, 3);
+	ZSL_MATRIX_DEF(m23, 2, 3);
+	ZSL_WORKSPACE_DEF(small, 8);
+
+	/* A diagonal matrix, whose norm needs several halvings. */
+	zsl_real_t ddiag[9] = { 1.0,  0.0, 0.0,
+				0.0, -2.0, 0.0,
+				0.0,  0.0, 5.0 };
+	struct zsl_mtx mdiag = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = ddiag
+	};
+
+	/* A rotation generator, exp(m) = [cos(2) sin(2); -sin(2) cos(2)]. */
+	zsl_real_t drot[4] = {  0.0, 2.0,
+			       -2.0, 0.0 };
+	struct zsl_mtx mrot = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = drot
+	};
+
+	/* A nilpotent matrix, exp(m) = I + m. */
+	zsl_real_t dnil[4] = { 0.0, 3.0,
+			       0.0, 0.0 };
+	struct zsl_mtx mnil = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = dnil
+	};
+
+	rc = zsl_mtx_expm(&mdiag, &e3);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zsl_real_t x = (i % 4 == 0) ? ZSL_EXP(ddiag[i]) : 0.0;
+
+		zassert_true(val_is_equal(e3.data[i], x,
+					  1E-4 * (1.0 + ZSL_ABS(x))), NULL);
+	}
+
+	rc = zsl_mtx_expm(&mrot, &e);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(e.data[0], ZSL_COS(2.0), 1E-5), NULL);
+	zassert_true(val_is_equal(e.data[1], ZSL_SIN(2.0), 1E-5), NULL);
+	zassert_true(val_is_equal(e.data[2], -ZSL_SIN(2.0), 1E-5), NULL);
+	zassert_true(val_is_equal(e.data[3], ZSL_COS(2.0), 1E-5), NULL);
+
+	/* In place. */
+	rc = zsl_mtx_expm(&mnil, &mnil);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(mnil.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mnil.data[1], 3.0, 1E-5), NULL);
+	zassert_true(val_is_equal(mnil.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mnil.data[3], 1.0, 1E-6), NULL);
+
+	/* Non-square or mismatched matrices, and a short workspace. */
+	rc = zsl_mtx_expm(&m23, &m23);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_expm(&mrot, &e3);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_expm_ws(&mrot, &e, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(small.used, 0, NULL);
+}
+
+void test_matrix_c2d(void)
+{
+	int rc = 0;
+	zsl_real_t t = 0.1;
+
+	ZSL_MATRIX_DEF(ad, 2, 2);
+	ZSL_MATRIX_DEF(bd, 2, 1);
+	ZSL_MATRIX_DEF(ad1, 1, 1);
+	ZSL_MATRIX_DEF(bd1, 1, 1);
+
+	/* A double integrator, with position and velocity states. */
+	zsl_real_t da[4] = { 0.0, 1.0,
+			     0.0, 0.0 };
+	struct zsl_mtx a = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = da
+	};
+	zsl_real_t db[2] = { 0.0, 1.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 2,
+		.sz_cols = 1,
+		.data = db
+	};
+
+	/* A first-order lag, dx/dt = -2 * x + u. */
+	zsl_real_t da1[1] = { -2.0 };
+	struct zsl_mtx a1 = {
+		.sz_rows = 1,
+		.sz_cols = 1,
+		.data = da1
+	};
+	zsl_real_t db1[1] = { 1.0 };
+	struct zsl_mtx b1 = {
+		.sz_rows = 1,
+		.sz_cols = 1,
+		.data = db1
+	};
+
+	rc = zsl_mtx_c2d(&a, &b, t, &ad, &bd);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ad.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[1], t, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(ad.data[3], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(bd.data[0], t * t / 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(bd.data[1], t, 1E-6), NULL);
+
+	rc = zsl_mtx_c2d(&a1, &b1, t, &ad1, &bd1);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ad1.data[0], ZSL_EXP(-2.0 * t), 1E-6), NULL);
+	zassert_true(val_is_equal(bd1.data[0],
+				  (1.0 - ZSL_EXP(-2.0 * t)) / 2.0, 1E-6), NULL);
+
+	/* Without inputs, only Ad is computed. */
+	zsl_mtx_init(&ad, NULL);
+	rc = zsl_mtx_c2d(&a, NULL, t, &ad, NULL);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(ad.data[1], t, 1E-6), NULL);
+
+	/* Mismatched shapes. */
+	rc = zsl_mtx_c2d(&a, &b1, t, &ad, &bd);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_c2d(&a, &b, t, &ad, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_trsm(void)
+{
+	int rc = 0;
+
+	ZSL_MATRIX_DEF(x, 3, 2);
+	ZSL_MATRIX_DEF(tx, 3, 2);
+
+	/* Lower and upper triangles are both populated, only one is read. */
+	zsl_real_t data[9] = { 2.0, 7.0, -1.0,
+			       1.0, 4.0,  3.0,
+			      -3.0, 2.0,  5.0 };
+	struct zsl_mtx t = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	zsl_real_t ldata[9] = { 2.0, 0.0, 0.0,
+				1.0, 4.0, 0.0,
+			       -3.0, 2.0, 5.0 };
+	struct zsl_mtx lt = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = ldata
+	};
+
+	zsl_real_t udata[9] = { 2.0, 7.0, -1.0,
+				0.0, 4.0,  3.0,
+				0.0, 0.0,  5.0 };
+	struct zsl_mtx ut = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = udata
+	};
+
+	zsl_real_t bdata[6] = { 2.0, -4.0,
+				9.0,  1.0,
+				7.0,  3.0 };
+	struct zsl_mtx b = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = bdata
+	};
+
+	/* Lower triangular. */
+	rc = zsl_mtx_trsm(&t, &b, &x, true);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&lt, &x, &tx);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(tx.data[i], bdata[i], 1E-5), NULL);
+	}
+
+	/* Upper triangular. */
+	rc = zsl_mtx_trsm(&t, &b, &x, false);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&ut, &x, &tx);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		zassert_true(val_is_equal(tx.data[i], bdata[i], 1E-5), NULL);
+	}
+
+	/* A zero on the diagonal is rejected. */
+	data[4] = 0.0;
+	rc = zsl_mtx_trsm(&t, &b, &x, true);
+	zassert_equal(rc, -ESINGULAR, NULL);
+}
+
+void test_matrix_trsv(void)
+{
+	int rc = 0;
+
+	ZSL_VECTOR_DEF(x, 3);
+
+	zsl_real_t data[9] = { 2.0, 0.0, 0.0,
+			       1.0, 4.0, 0.0,
+			      -3.0, 2.0, 5.0 };
+	struct zsl_mtx t = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	zsl_real_t bdata[3] = { 4.0, 10.0, 3.0 };
+	struct zsl_vec b = {
+		.sz = 3,
+		.data = bdata
+	};
+
+	/* x = (2, 2, 1.0). */
+	rc = zsl_mtx_trsv(&t, &b, &x, true);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[1], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(x.data[2], 1.0, 1E-6), NULL);
+
+	/* Mismatched vector size. */
+	b.sz = 2;
+	rc = zsl_mtx_trsv(&t, &b, &x, true);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_balance(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(moa, 4, 4);
+	ZSL_MATRIX_DEF(mob, 4, 4);
+
+	/* Input non-symmetric matrix. */
+	zsl_real_t data[16] = { 5.1, -3.2, 4.9, -8.1,
+				2.3, -4.1, -2.8, 0.2,
+				0.0, -7.7, 2.1, 0.0,
+				-0.7, 8.1, -5.5, 3.7 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input symmetric matrix. */
+	zsl_real_t datb[16] = { 5.1, 2.3, 0.0, -8.1,
+				2.3, -4.1, -2.8, 0.2,
+				0.0, -2.8, 2.1, -5.5,
+				-8.1, 0.2, -5.5, 3.7 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	/* Expected output. */
+	zsl_real_t dt[16] = { 5.1, -1.6, 2.45, -8.1,
+			      4.6, -4.1, -2.8, 0.4,
+			      0.0, -7.7, 2.1, 0.0,
+			      -0.7, 4.05, -2.75, 3.7 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dt
+	};
+
+	/* Init output matrices. */
+	rc = zsl_mtx_init(&moa, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&mob, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Balance the input matrices. */
+	rc = zsl_mtx_balance(&ma, &moa);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_balance(&mb, &mob);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < (ma.sz_rows * ma.sz_cols); g++) {
+		zassert_true(val_is_equal(moa.data[g], mt.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(mob.data[g], mb.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_householder_sq(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(h, 3, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
+			       2.0, 4.0, -2.0,
+			       0.0, 4.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix h. */
+	rc = zsl_mtx_init(&h, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Compute the Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, false);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtst[9] = { 0.0, 1.0, 0.0,
+			       1.0, 0.0, 0.0,
+			       0.0, 0.0, 1.0 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dtst
+	};
+
+	/* Check the output. */
+	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
+		zassert_true(val_is_equal(h.data[g], mt.data[g], 1E-6), NULL);
+	}
+	
+	/* Compute the Hessenberg-Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, true);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtsa[16] = { 1.0, 0.0, 0.0,
+				0.0, 1.0, 0.0,
+				0.0, 0.0, 1.0 };
+
+	struct zsl_mtx mt2 = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dtsa
+	};
+
+	/* Check the output. */
+	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
+		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_householder_rect(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(h, 4, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[12] = { 1.0, -1.0, 4.0,
+				1.0, 4.0, -2.0,
+				1.0, 4.0, 2.0,
+				1.0, -1.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Init matrix h. */
+	rc = zsl_mtx_init(&h, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Compute the Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, false);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtst[16] = { 0.5, 0.5, 0.5, 0.5,
+				0.5, 0.5, -0.5, -0.5,
+				0.5, -0.5, 0.5, -0.5,
+				0.5, -0.5, -0.5, 0.5 };
+
+	struct zsl_mtx mt = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dtst
+	};
+
+	/* Check the output. */
+	zassert_true(zsl_mtx_is_equal(&h, &mt), NULL);
+	
+	/* Compute the Hessenberg-Householder matrix. */
+	rc = zsl_mtx_householder(&m, &h, true);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t dtsa[16] = { 1.0, 0.000000, 0.000000, 0.000000,
+				0.0, 0.577350, 0.577350, 0.577350,
+				0.0, 0.577350, 0.211325, -0.788675,
+				0.0, 0.577350, -0.788675, 0.211325 };
+
+	struct zsl_mtx mt2 = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = dtsa
+	};
+
+	/* Check the output. */
+	for (size_t g = 0; g < (h.sz_rows * h.sz_cols); g++) {
+		zassert_true(val_is_equal(h.data[g], mt2.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_qrd(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(q, 3, 3);
+	ZSL_MATRIX_DEF(r, 3, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[9] = { 0.0, 0.0, 4.0,
+			       2.0, 4.0, -2.0,
+			       0.0, 4.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* The expected results for Q and R matrices for test purposes. */
+	zsl_real_t qdata[9] = { 0.0, 0.0, 1.0,
+				1.0, 0.0, 0.0,
+				0.0, 1.0, 0.0 };
+
+	struct zsl_mtx q2 = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = qdata
+	};
+
+	zsl_real_t rdata[9] = { 2.0, 4.0, -2.0,
+				0.0, 4.0, 2.0,
+				0.0, 0.0, 4.0 };
+
+	struct zsl_mtx r2 = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = rdata
+	};
+
+
+	/* Init matrices Q and R. */
+	rc = zsl_mtx_init(&q, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&r, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Calculate the QR decomposition. */
+	rc = zsl_mtx_qrd(&m, &q, &r, false);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
+		zassert_true(val_is_equal(q.data[g], q2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(r.data[g], r2.data[g], 1E-6), NULL);
+	}
+}
+
+void test_matrix_qrd_hess(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(q, 4, 4);
+	ZSL_MATRIX_DEF(r, 4, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[16] = { 1.0, 0.0, 4.0, -3.0,
+				2.0, 4.0, -2.0, 7.0,
+				-3.0, 4.0, 2.0, 0.0,
+				5.0, -4.0, 0.0, 6.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Init matrices Q and R. */
+	rc = zsl_mtx_init(&q, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&r, NULL);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Perform the Hessenberg transformation on the input matrix. */
+	rc = zsl_mtx_qrd(&m, &q, &r, true);
+	zassert_equal(rc, 0, NULL);
+	
+	/* Expected output. */
+	zsl_real_t hdata[16] = {
 		1.0000000000, -4.3799783705, -2.0074108339, -1.3364472371,
 		6.1644140030, 5.3157894737, 4.9566180780, -3.9888797432,
 		0.0000000000, -6.9114902923, 4.1365576515, 0.8655838518,
 		-0.0000000000, 0.0000000000, 0.3789195885, 2.5476528748 };
 
-	struct zsl_mtx hess = {
+	struct zsl_mtx hess = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = hdata
+	};
+
+	
+	/* Check the output. */
+	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+ 	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-4), NULL);
+#else
+	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-8), NULL);
+#endif
+	}
+}
+
+void test_matrix_qr(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(qr, 4, 2);
+	ZSL_MATRIX_DEF(q, 4, 4);
+	ZSL_MATRIX_DEF(b, 4, 1);
+	ZSL_MATRIX_DEF(c, 2, 1);
+	ZSL_MATRIX_DEF(sq, 3, 3);
+	ZSL_MATRIX_DEF(sq_q, 3, 3);
+	ZSL_MATRIX_DEF(sq_r, 3, 3);
+	ZSL_VECTOR_DEF(tau, 2);
+	ZSL_VECTOR_DEF(sq_tau, 3);
+
+	/* Least-squares line fit, y = 1 + 2x, sampled at x = 0, 1, 2, 3. */
+	zsl_real_t data[8] = { 1.0, 0.0,
+			       1.0, 1.0,
+			       1.0, 2.0,
+			       1.0, 3.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = data
+	};
+
+	/* Square input. */
+	zsl_real_t sqdata[9] = { 3.0, 2.0, 2.0,
+				 1.0, 3.0, 1.0,
+				 1.0, 5.0, 2.0 };
+
+	struct zsl_mtx msq = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = sqdata
+	};
+
+	rc = zsl_mtx_qr(&m, &qr, &tau);
+	zassert_equal(rc, 0, NULL);
+
+	/* Build Q explicitly and check it is orthogonal, and Q * R = m. */
+	zsl_mtx_init(&q, zsl_mtx_entry_fn_identity);
+	rc = zsl_mtx_qr_apply_q(&qr, &tau, &q, false);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < 4; k++) {
+				x += q.data[k * 4 + i] * q.data[k * 4 + j];
+			}
+			zassert_true(val_is_equal(x, i == j ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+		for (size_t j = 0; j < 2; j++) {
+			x = 0.0;
+			for (size_t k = 0; k <= j; k++) {
+				x += q.data[i * 4 + k] * qr.data[k * 2 + j];
+			}
+			zassert_true(val_is_equal(x, data[i * 2 + j], 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Solve the overdetermined system via R * c = (Q^T * b)[0:2]. */
+	for (size_t i = 0; i < 4; i++) {
+		b.data[i] = 1.0 + 2.0 * i;
+	}
+	rc = zsl_mtx_qr_apply_q(&qr, &tau, &b, true);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(b.data[2], 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(b.data[3], 0.0, 1E-5), NULL);
+
+	struct zsl_mtx rt = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = qr.data
+	};
+	struct zsl_mtx bt = {
+		.sz_rows = 2,
+		.sz_cols = 1,
+		.data = b.data
+	};
+
+	rc = zsl_mtx_trsm(&rt, &bt, &c, false);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(c.data[0], 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(c.data[1], 2.0, 1E-5), NULL);
+
+	/* In-place factorisation matches the R from zsl_mtx_qrd. */
+	rc = zsl_mtx_copy(&sq, &msq);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qr(&sq, &sq, &sq_tau);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd(&msq, &sq_q, &sq_r, false);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i; j < 3; j++) {
+			zassert_true(val_is_equal(sq.data[i * 3 + j],
+						  sq_r.data[i * 3 + j], 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Mismatched sizes. */
+	rc = zsl_mtx_qr(&m, &qr, &sq_tau);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_qr_apply_q(&qr, &tau, &c, true);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/* Checks that 'mev' holds orthonormal eigenvectors of 'm' for the
+ * eigenvalues in 'v'. */
+static bool eigen_sym_is_valid(struct zsl_mtx *m, struct zsl_vec *v,
+			       struct zsl_mtx *mev, zsl_real_t eps)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t x;
+
+	for (size_t j = 0; j < n; j++) {
+		/* m * v_j = lambda_j * v_j. */
+		for (size_t i = 0; i < n; i++) {
+			x = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				x += m->data[i * n + k] * mev->data[k * n + j];
+			}
+			if (!val_is_equal(x, v->data[j] * mev->data[i * n + j],
+					  eps)) {
+				return false;
+			}
+		}
+
+		/* v_i . v_j = delta_ij. */
+		for (size_t i = 0; i < n; i++) {
+			x = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				x += mev->data[k * n + i] *
+				     mev->data[k * n + j];
+			}
+			if (!val_is_equal(x, i == j ? 1.0 : 0.0, eps)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void test_matrix_schur(void)
+{
+	int rc;
+	size_t used;
+	zsl_real_t re, im;
+
+	ZSL_MATRIX_DEF(t, 4, 4);
+	ZSL_MATRIX_DEF(q, 4, 4);
+	ZSL_MATRIX_DEF(tmp, 4, 4);
+	ZSL_MATRIX_DEF(mr, 4, 4);
+	ZSL_MATRIX_DEF(qtq, 4, 4);
+	ZSL_MATRIX_DEF(t3, 3, 3);
+	ZSL_MATRIX_DEF(q3, 3, 3);
+	ZSL_MATRIX_DEF(m23, 2, 3);
+	ZSL_WORKSPACE_DEF(ws, 64);
+
+	/* Input matrix with real eigenvalues. */
+	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				5.0, 3.0, -5.0, 2.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input matrix with eigenvalues 2 and 1 +/- 2i. */
+	zsl_real_t dcplx[9] = { 1.0, -4.0, 2.0,
+				1.0,  1.0, 3.0,
+				0.0,  0.0, 2.0 };
+	struct zsl_mtx mc = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = dcplx
+	};
+
+	zsl_real_t ev[4] = { 4.8347780554139375, -2.6841592178899276,
+			     1.8493811427083884, -1.0 };
+
+	rc = zsl_mtx_schur_ws(&m, &t, &q, 500, &used, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	zassert_true(used < 50, NULL);
+
+	/* 'T' is upper triangular, and Q * T * Q^T = M with orthogonal Q. */
+	for (size_t i = 1; i < 4; i++) {
+		for (size_t j = 0; j < i; j++) {
+			zassert_true(val_is_equal(t.data[i * 4 + j], 0.0, 1E-5),
+				     NULL);
+		}
+	}
+	zsl_mtx_mult(&q, &t, &tmp);
+	zsl_mtx_mult_ex(&tmp, false, &q, true, 1.0, 0.0, &mr);
+	zsl_mtx_mult_ex(&q, true, &q, false, 1.0, 0.0, &qtq);
+	for (size_t i = 0; i < 16; i++) {
+		zassert_true(val_is_equal(mr.data[i], data[i], 1E-4), NULL);
+		zassert_true(val_is_equal(qtq.data[i], (i % 5 == 0) ? 1.0 : 0.0,
+					  1E-5), NULL);
+	}
+
+	/* The diagonal holds every eigenvalue, in no particular order. */
+	for (size_t k = 0; k < 4; k++) {
+		bool found = false;
+
+		for (size_t i = 0; i < 4; i++) {
+			if (val_is_equal(t.data[i * 5], ev[k], 1E-4)) {
+				found = true;
+			}
+		}
+		zassert_true(found, NULL);
+	}
+
+	/* Only 'T' is needed, and the result is unchanged. */
+	rc = zsl_mtx_schur(&m, &tmp, NULL, 500);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 16; i++) {
+		zassert_true(val_is_equal(tmp.data[i], t.data[i], 1E-6), NULL);
+	}
+
+	/* A complex pair is left as a 2x2 block on the diagonal. */
+	rc = zsl_mtx_schur(&mc, &t3, &q3, 500);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_get(&t3, 1, 0, &im);
+	zsl_mtx_get(&t3, 2, 1, &re);
+	if (val_is_equal(re, 0.0, 1E-5)) {
+		/* The block is the leading 2x2, and 'T'(2, 2) is real. */
+		re = (t3.data[0] + t3.data[4]) / 2.0;
+		im = t3.data[0] * t3.data[4] - t3.data[1] * t3.data[3];
+		zassert_true(val_is_equal(t3.data[8], 2.0, 1E-5), NULL);
+	} else {
+		zassert_true(val_is_equal(im, 0.0, 1E-5), NULL);
+		re = (t3.data[4] + t3.data[8]) / 2.0;
+		im = t3.data[4] * t3.data[8] - t3.data[5] * t3.data[7];
+		zassert_true(val_is_equal(t3.data[0], 2.0, 1E-5), NULL);
+	}
+	/* The block's trace is 2 * Re and its determinant is |lambda|^2. */
+	zassert_true(val_is_equal(re, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(im, 5.0, 1E-4), NULL);
+
+	/* Too few iterations, and non-square or mismatched matrices. */
+	rc = zsl_mtx_schur(&m, &t, NULL, 1);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	rc = zsl_mtx_schur(&m23, &t, NULL, 10);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_schur(&m, &t3, NULL, 10);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_schur(&m, &t, &q3, 10);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_schur_rand(void)
+{
+	int rc;
+	size_t used;
+	zsl_real_t x;
+	struct zsl_rand r;
+
+	ZSL_MATRIX_DEF(m, 12, 12);
+	ZSL_MATRIX_DEF(t, 12, 12);
+	ZSL_MATRIX_DEF(q, 12, 12);
+	ZSL_MATRIX_DEF(tmp, 12, 12);
+	ZSL_MATRIX_DEF(mr, 12, 12);
+	ZSL_WORKSPACE_DEF(ws, 12 * 12 + 12);
+
+	zassert_true(ws.sz >= zsl_mtx_schur_ws_sz(12), NULL);
+	zsl_rand_seed(&r, 29);
+
+	/* Dense random inputs have complex pairs and clustered eigenvalues,
+	 * and each must converge in a few double-shift steps per
+	 * eigenvalue. */
+	for (size_t n = 8; n <= 12; n++) {
+		m.sz_rows = m.sz_cols = n;
+		t.sz_rows = t.sz_cols = n;
+		q.sz_rows = q.sz_cols = n;
+		tmp.sz_rows = tmp.sz_cols = n;
+		mr.sz_rows = mr.sz_cols = n;
+
+		for (size_t k = 0; k < 8; k++) {
+			zsl_rand_mtx_uniform(&r, &m, -1.0, 1.0);
+			rc = zsl_mtx_schur_ws(&m, &t, &q, 30 * n, &used, &ws);
+			zassert_equal(rc, 0, NULL);
+			zassert_true(used <= 4 * n, NULL);
+
+			/* 'T' is quasi upper triangular, with no two
+			 * consecutive non-zero subdiagonal elements, and
+			 * every 2x2 block holds a complex pair. */
+			for (size_t i = 1; i < n; i++) {
+				for (size_t j = 0; j + 1 < i; j++) {
+					zassert_equal(t.data[i * n + j], 0.0,
+						      NULL);
+				}
+				if (t.data[i * n + i - 1] == 0.0) {
+					continue;
+				}
+				zassert_true(i == 1 ||
+					     t.data[(i - 1) * n + i - 2] == 0.0,
+					     NULL);
+				x = (t.data[(i - 1) * n + i - 1] -
+				     t.data[i * n + i]) / 2.0;
+				x = x * x + t.data[(i - 1) * n + i] *
+				    t.data[i * n + i - 1];
+				zassert_true(x < 0.0, NULL);
+			}
+
+			/* Q * T * Q^T = M. */
+			zsl_mtx_mult(&q, &t, &tmp);
+			zsl_mtx_mult_ex(&tmp, false, &q, true, 1.0, 0.0, &mr);
+			for (size_t i = 0; i < n * n; i++) {
+				zassert_true(val_is_equal(mr.data[i],
+							  m.data[i], 1E-4),
+					     NULL);
+			}
+		}
+	}
+}
+
+void test_matrix_eigen_sym(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(v3, 3);
+	ZSL_VECTOR_DEF(v4, 4);
+	ZSL_VECTOR_DEF(v5, 5);
+	ZSL_MATRIX_DEF(mev3, 3, 3);
+	ZSL_MATRIX_DEF(mev4, 4, 4);
+	ZSL_MATRIX_DEF(mev5, 5, 5);
+
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zsl_real_t eps = 1E-4;
+#else
+	zsl_real_t eps = 1E-10;
+#endif
+
+	/* Distinct eigenvalues, 2 + sqrt(2), 2 and 2 - sqrt(2). */
+	zsl_real_t da[9] = { 2.0, -1.0, 0.0,
+			     -1.0, 2.0, -1.0,
+			     0.0, -1.0, 2.0 };
+
+	/* Repeated eigenvalues, 4, 1 and 1. */
+	zsl_real_t db[9] = { 2.0, 1.0, 1.0,
+			     1.0, 2.0, 1.0,
+			     1.0, 1.0, 2.0 };
+
+	/* Diagonal. */
+	zsl_real_t dc[9] = { 1.0, 0.0, 0.0,
+			     0.0, -3.0, 0.0,
+			     0.0, 0.0, 2.0 };
+
+	/* 4x4, solved iteratively. */
+	zsl_real_t dd[16] = { 1.0, 2.0, 4.0, 0.0,
+			      2.0, 3.0, 4.0, -2.0,
+			      4.0, 4.0, -3.0, 5.0,
+			      0.0, -2.0, 5.0, -1.0 };
+
+	/* 5x5, with a repeated eigenvalue of 1. */
+	zsl_real_t de[25] = { 2.0, 1.0, 0.0, 0.0, 0.0,
+			      1.0, 2.0, 0.0, 0.0, 0.0,
+			      0.0, 0.0, 1.0, 0.0, 0.0,
+			      0.0, 0.0, 0.0, 5.0, 0.5,
+			      0.0, 0.0, 0.0, 0.5, 5.0 };
+
+	struct zsl_mtx ma = { .sz_rows = 3, .sz_cols = 3, .data = da };
+	struct zsl_mtx mb = { .sz_rows = 3, .sz_cols = 3, .data = db };
+	struct zsl_mtx mc = { .sz_rows = 3, .sz_cols = 3, .data = dc };
+	struct zsl_mtx md = { .sz_rows = 4, .sz_cols = 4, .data = dd };
+	struct zsl_mtx me = { .sz_rows = 5, .sz_cols = 5, .data = de };
+
+	rc = zsl_mtx_eigen_sym(&ma, &v3, &mev3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v3.data[0], 2.0 + ZSL_SQRT(2.0), eps), NULL);
+	zassert_true(val_is_equal(v3.data[1], 2.0, eps), NULL);
+	zassert_true(val_is_equal(v3.data[2], 2.0 - ZSL_SQRT(2.0), eps), NULL);
+	zassert_true(eigen_sym_is_valid(&ma, &v3, &mev3, eps), NULL);
+
+	rc = zsl_mtx_eigen_sym(&mb, &v3, &mev3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v3.data[0], 4.0, eps), NULL);
+	zassert_true(val_is_equal(v3.data[1], 1.0, eps), NULL);
+	zassert_true(val_is_equal(v3.data[2], 1.0, eps), NULL);
+	zassert_true(eigen_sym_is_valid(&mb, &v3, &mev3, eps), NULL);
+
+	rc = zsl_mtx_eigen_sym(&mc, &v3, &mev3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v3.data[0], 2.0, eps), NULL);
+	zassert_true(val_is_equal(v3.data[1], 1.0, eps), NULL);
+	zassert_true(val_is_equal(v3.data[2], -3.0, eps), NULL);
+	zassert_true(eigen_sym_is_valid(&mc, &v3, &mev3, eps), NULL);
+
+	rc = zsl_mtx_eigen_sym(&md, &v4, &mev4);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v4.data[0], 7.4199113544017665, 1E-5),
+		     NULL);
+	zassert_true(val_is_equal(v4.data[1], 2.7935849909013921, 1E-5),
+		     NULL);
+	zassert_true(val_is_equal(v4.data[2], -0.9244614420638188, 1E-5),
+		     NULL);
+	zassert_true(val_is_equal(v4.data[3], -9.2890349032381003, 1E-5),
+		     NULL);
+	zassert_true(eigen_sym_is_valid(&md, &v4, &mev4, eps), NULL);
+
+	rc = zsl_mtx_eigen_sym(&me, &v5, &mev5);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v5.data[0], 5.5, eps), NULL);
+	zassert_true(val_is_equal(v5.data[1], 4.5, eps), NULL);
+	zassert_true(val_is_equal(v5.data[2], 3.0, eps), NULL);
+	zassert_true(val_is_equal(v5.data[3], 1.0, eps), NULL);
+	zassert_true(val_is_equal(v5.data[4], 1.0, eps), NULL);
+	zassert_true(eigen_sym_is_valid(&me, &v5, &mev5, eps), NULL);
+
+	/* The eigenvectors are optional. */
+	rc = zsl_mtx_eigen_sym(&md, &v4, NULL);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v4.data[3], -9.2890349032381003, 1E-5),
+		     NULL);
+
+	/* Mismatched output sizes. */
+	rc = zsl_mtx_eigen_sym(&md, &v3, &mev4);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+void test_matrix_qrd_iter(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(m2, 4, 4);
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(v2, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				5.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Init the output matrix. */
+	rc = zsl_mtx_init(&m2, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Perform the QR method 1500 times matrix. */
+	rc = zsl_mtx_qrd_iter(&m, &m2, 1500);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check if the output matrix is upper triangular and if it is similar
+	 * to the input matrix. */
+	zassert_true(val_is_equal(m2.data[4], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[8], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[9], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[12], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[13], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m2.data[14], 0.0, 1E-6), NULL);
+
+	zsl_mtx_eigenvalues(&m, &v, 500);
+	zsl_mtx_eigenvalues(&m2, &v2, 500);
+
+	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-6), NULL);
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+void test_matrix_eigenvalues(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(va, 4);
+	ZSL_VECTOR_DEF(vb, 4);
+	ZSL_VECTOR_DEF(vc, 4);
+
+	ZSL_VECTOR_DEF(va2, 4);
+	ZSL_VECTOR_DEF(vb2, 2);
+	ZSL_VECTOR_DEF(vc2, 4);
+
+	/* Input real-eigenvalue matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				5.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input complex-eigenvalue matrix. */
+	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				9.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	/* Input symmetric matrix. */
+	zsl_real_t datc[16] = { 1.0, 2.0, 4.0, 0.0,
+				2.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 5.0,
+				0.0, -2.0, 5.0, -1.0 };
+
+	struct zsl_mtx mc = {
 		.sz_rows = 4,
 		.sz_cols = 4,
-		.data = hdata
+		.data = datc
 	};
 
-	
+	/* Expected output. */
+	va2.data[0] = 4.8347780554139375;
+	va2.data[1] = -2.6841592178899276;
+	va2.data[2] = 1.8493811427083884;
+	va2.data[3] = -0.9999999802303374;
+
+	vb2.data[0] = -3.0925670160610634;
+	vb2.data[1] = -1.0000000075030784;
+
+	vc2.data[0] = -9.2890349032381003;
+	vc2.data[1] = 7.4199113544017665;
+	vc2.data[2] = 2.7935849909013921;
+	vc2.data[3] = -0.9244614420638188;
+
+
+	/* Init the output vectors. */
+	rc = zsl_vec_init(&va);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_init(&vb);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_vec_init(&vc);
+	zassert_equal(rc, 0, NULL);
+
+	/* Calculate the eigenvalues of 'ma', 'mb' and 'mc'. */
+	rc = zsl_mtx_eigenvalues(&ma, &va, 150);
+	zassert_equal(rc, 0, NULL);
+
+	rc = zsl_mtx_eigenvalues(&mb, &vb, 150);
+	zassert_equal(rc, -ECOMPLEXVAL, NULL);
+
+	rc = zsl_mtx_eigenvalues(&mc, &vc, 150);
+	zassert_equal(rc, 0, NULL);
+
 	/* Check the output. */
-	for (size_t g = 0; g < (m.sz_rows * m.sz_cols); g++) {
-#ifdef CONFIG_ZSL_SINGLE_PRECISION
- 	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-4), NULL);
-#else
-	zassert_true(val_is_equal(r.data[g], hess.data[g], 1E-8), NULL);
-#endif
-	}
+	zassert_true(zsl_vec_is_equal(&va, &va2, 1E-6), NULL);
+	zassert_true(zsl_vec_is_equal(&vb, &vb2, 1E-6), NULL);
+	zassert_true(zsl_vec_is_equal(&vc, &vc2, 1E-6), NULL);
 }
+#endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
-void test_matrix_qrd_iter(void)
+void test_matrix_eigenvectors(void)
 {
 	int rc;
 
-	ZSL_MATRIX_DEF(m2, 4, 4);
-	ZSL_VECTOR_DEF(v, 4);
-	ZSL_VECTOR_DEF(v2, 4);
+	ZSL_MATRIX_DEF(va, 4, 4);
+	ZSL_MATRIX_DEF(vb, 4, 4);
+	ZSL_MATRIX_DEF(vc, 4, 4);
+	ZSL_MATRIX_DEF(vd, 3, 3);
 
-	/* Input matrix. */
+	ZSL_MATRIX_DEF(va2, 4, 4);
+	ZSL_MATRIX_DEF(vb2, 4, 2);
+	ZSL_MATRIX_DEF(vc2, 4, 2);
+	ZSL_MATRIX_DEF(vd2, 3, 3);
+
+	/* Input real-eigenvalue matrix. */
 	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
 				0.0, 3.0, 4.0, -2.0,
 				4.0, 4.0, -3.0, 0.0,
 				5.0, 3.0, -5.0, 2.0 };
 
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input complex-eigenvalue matrix. */
+	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				9.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	/* Input real-eigenvalue non-diagonalisable matrix with repeated
+	 * eigenvalues. */
+	zsl_real_t datc[16] = { 1.0, 2.0, 4.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				0.0, 0.0, 3.0, 5.0,
+				0.0, 0.0, 0.0, 1.0 };
+
+	struct zsl_mtx mc = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datc
+	};
+	
+	/* Input real-eigenvalue diagonalisable matrix with repeated
+	 * eigenvalues. */
+	zsl_real_t datd[9] = { 5.0, -4.0, 4.0,
+			       12.0, -11.0, 12.0,
+			       4.0, -4.0, 5.0 };
+
+	struct zsl_mtx md = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = datd
+	};
+
+	/* Init the output matrices. */
+	rc = zsl_mtx_init(&va, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&vb, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&vc, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&vd, NULL);
+	zassert_equal(rc, 0, NULL);
+
+	/* Calculate the eigenvectors of 'ma', 'mb' and 'mc'
+	 * non-orthonormalised. */
+	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, false);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, false);
+	zassert_equal(rc, -EEIGENSIZE, NULL);
+	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, false);
+	zassert_equal(rc, -EEIGENSIZE, NULL);
+	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, false);
+	zassert_equal(rc, 0, NULL);
+
+	/* Expected output. */
+	zsl_real_t a[16] = {
+		0.7555042357,  0.6223771803,  0.2074844660,  5.5000009316,
+		2.2040997676, -0.5240911326,  0.2956011625, -3.5000005906,
+		1.5110084714,  1.2447543606,  0.4149689321,  4.0000005733,
+		1.0000000000,  1.0000000000,  1.0000000000,  1.0000000000
+	};
+
+	zsl_real_t b[8] = { 1.2304303063, -0.5000000054,
+			    -1.2873789372, 0.5000000045,
+			    2.4608606125, -0.0000000055,
+			    1.0000000000, 1.0000000000 };
+
+	zsl_real_t c[8] = { 1.0, 1.0,
+			    1.0, 0.0,
+			    0.0, 0.0,
+			    0.0, 0.0 };
+
+	zsl_real_t d[9] = { 1.0, 1.0, -1.0,
+			    3.0, 1.0, 0.0,
+			    1.0, 0.0, 1.0 };
+
+	rc = zsl_mtx_from_arr(&va2, a);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vb2, b);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vc2, c);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vd2, d);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
+		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
+	}
+
+	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
+		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
+	}
+	
+	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
+		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
+	}
+
+	/* Calculate the eigenvectors of 'ma', 'mb' and 'mc' orthonormalised. */
+	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, true);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, true);
+	zassert_equal(rc, -EEIGENSIZE, NULL);
+	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, true);
+	zassert_equal(rc, -EEIGENSIZE, NULL);
+	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, true);
+	zassert_equal(rc, 0, NULL);
+
+	/* Expected output. */
+	zsl_real_t a2[16] = {
+		0.2559636199, 0.3472992698, 0.1817921832, 0.7130241030,
+		0.7467454562, -0.2924536333, 0.2589976094, -0.4537426107,
+		0.5119272398, 0.6945985397, 0.3635843664, 0.5185629705,
+		0.3387983916, 0.5580205715, 0.8761724995, 0.1296407240
+	};
+
+
+	zsl_real_t b2[8] = { 0.3847511767, -0.4082482935,
+			     -0.4025588109, 0.4082482928,
+			     0.7695023535, -0.0000000045,
+			     0.3126964402, 0.8164965782 };
+
+	zsl_real_t c2[8] = { 0.7071067812, 1.0,
+			     0.7071067812, 0.0,
+			     0.0, 0.0,
+			     0.0, 0.0 };
+
+	zsl_real_t d2[9] = { 0.3015113441, 0.7071067750, -0.4082482533,
+			    0.9045340323, 0.7071067874, 0.4082481887,
+			    0.3015113494, 0.0000000498, 0.8164966504 };
+
+	rc = zsl_mtx_from_arr(&va2, a2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vb2, b2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vc2, c2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&vd2, d2);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
+		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
+	}
+	
+	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
+		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
+		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
+	}
+	
+	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
+		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
+	}
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/* Compares column 'j' of 'a' and 'b', allowing for a change of sign. */
+static bool svd_col_is_equal(struct zsl_mtx *a, struct zsl_mtx *b, size_t j,
+			     zsl_real_t eps)
+{
+	zsl_real_t dot = 0.0;
+	zsl_real_t sign;
+
+	for (size_t i = 0; i < a->sz_rows; i++) {
+		dot += a->data[i * a->sz_cols + j] *
+		       b->data[i * b->sz_cols + j];
+	}
+	sign = dot < 0.0 ? -1.0 : 1.0;
+
+	for (size_t i = 0; i < a->sz_rows; i++) {
+		if (!val_is_equal(sign * a->data[i * a->sz_cols + j],
+				  b->data[i * b->sz_cols + j], eps)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void test_matrix_svd(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(e, 3, 4);
+	ZSL_MATRIX_DEF(v, 4, 4);
+
+	ZSL_MATRIX_DEF(u2, 3, 3);
+	ZSL_MATRIX_DEF(e2, 3, 4);
+	ZSL_MATRIX_DEF(v2, 4, 4);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
 	struct zsl_mtx m = {
-		.sz_rows = 4,
+		.sz_rows = 3,
 		.sz_cols = 4,
 		.data = data
 	};
 
-	/* Init the output matrix. */
-	rc = zsl_mtx_init(&m2, NULL);
+	/* Init the output matrices. */
+	rc = zsl_mtx_init(&u, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&e, NULL);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&v, NULL);
 	zassert_equal(rc, 0, NULL);
 
-	/* Perform the QR method 1500 times matrix. */
-	rc = zsl_mtx_qrd_iter(&m, &m2, 1500);
+	/* Calculate the svd of 'm'. */
+	rc = zsl_mtx_svd(&m, &u, &e, &v, 1500);
 	zassert_equal(rc, 0, NULL);
 
-	/* Check if the output matrix is upper triangular and if it is similar
-	 * to the input matrix. */
-	zassert_true(val_is_equal(m2.data[4], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[8], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[9], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[12], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[13], 0.0, 1E-6), NULL);
-	zassert_true(val_is_equal(m2.data[14], 0.0, 1E-6), NULL);
+	/* Expected output. */
+	zsl_real_t a[9] = { -0.3481845133, -0.0474852763, 0.9362225661,
+			    -0.0396196056, -0.9970784021, -0.0653065614,
+			    -0.9365884003, 0.0598315021, -0.3452859102 };
 
-	zsl_mtx_eigenvalues(&m, &v, 500);
-	zsl_mtx_eigenvalues(&m2, &v2, 500);
+	zsl_real_t b[12] = { 6.8246886030, 0.0, 0.0, 0.0,
+			     0.0, 5.3940011894, 0.0, 0.0,
+			     0.0, 0.0, 0.5730415692, 0.0 };
 
-	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-6), NULL);
+	zsl_real_t c[16] = { -0.5999596982, 0.0355655710, -0.7764202435,
+			     0.1896181853, -0.6683940777, -0.5277862667, 0.5154631408, 0.0948090926,
+			     0.4395030259, -0.7638713255, -0.2819884104, 0.3792363705, 0.0116106706,
+			     0.3696989923, 0.2279295777, 0.9006863800 };
+
+	rc = zsl_mtx_from_arr(&u2, a);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&e2, b);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_from_arr(&v2, c);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. Singular vectors are only unique up to their
+	 * sign, so each column of 'u' and 'v' may be negated as a whole. */
+	for (size_t j = 0; j < u.sz_cols; j++) {
+		zassert_true(svd_col_is_equal(&u, &u2, j, 1E-8), NULL);
+	}
+
+	for (size_t g = 0; g < (e.sz_rows * e.sz_cols); g++) {
+		zassert_true(val_is_equal(e.data[g], e2.data[g], 1E-8), NULL);
+	}
+
+	for (size_t j = 0; j < v.sz_cols; j++) {
+		zassert_true(svd_col_is_equal(&v, &v2, j, 1E-8), NULL);
+	}
+
+	/* The signs of 'u' and 'v' are consistent: u * e * v^T == m. */
+	ZSL_MATRIX_DEF(vt, 4, 4);
+	ZSL_MATRIX_DEF(ue, 3, 4);
+	ZSL_MATRIX_DEF(uev, 3, 4);
+	zsl_mtx_trans(&v, &vt);
+	zsl_mtx_mult(&u, &e, &ue);
+	zsl_mtx_mult(&ue, &vt, &uev);
+	for (size_t g = 0; g < 12; g++) {
+		zassert_true(val_is_equal(uev.data[g], data[g], 1E-8), NULL);
+	}
 }
 #endif
 
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
-void test_matrix_eigenvalues(void)
+/* Checks that the columns of square matrix 'q' are orthonormal. */
+static bool svd_is_orthonormal(struct zsl_mtx *q, zsl_real_t eps)
 {
-	int rc;
-
-	ZSL_VECTOR_DEF(va, 4);
-	ZSL_VECTOR_DEF(vb, 4);
-	ZSL_VECTOR_DEF(vc, 4);
+	zsl_real_t dot;
+
+	for (size_t a = 0; a < q->sz_cols; a++) {
+		for (size_t b = 0; b < q->sz_cols; b++) {
+			dot = 0.0;
+			for (size_t i = 0; i < q->sz_rows; i++) {
+				dot += q->data[i * q->sz_cols + a] *
+				       q->data[i * q->sz_cols + b];
+			}
+			if (!val_is_equal(dot, a == b ? 1.0 : 0.0, eps)) {
+				return false;
+			}
+		}
+	}
 
-	ZSL_VECTOR_DEF(va2, 4);
-	ZSL_VECTOR_DEF(vb2, 2);
-	ZSL_VECTOR_DEF(vc2, 4);
+	return true;
+}
 
-	/* Input real-eigenvalue matrix. */
-	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
-				0.0, 3.0, 4.0, -2.0,
-				4.0, 4.0, -3.0, 0.0,
-				5.0, 3.0, -5.0, 2.0 };
+void test_matrix_svd_tall(void)
+{
+	int rc;
 
-	struct zsl_mtx ma = {
+	ZSL_MATRIX_DEF(u, 4, 4);
+	ZSL_MATRIX_DEF(e, 4, 3);
+	ZSL_MATRIX_DEF(v, 3, 3);
+	ZSL_MATRIX_DEF(vt, 3, 3);
+	ZSL_MATRIX_DEF(ue, 4, 3);
+	ZSL_MATRIX_DEF(uev, 4, 3);
+
+	/* The transpose of the test_matrix_svd input, which has the same
+	 * singular values. */
+	zsl_real_t data[12] = {  1.0,  0.0,  4.0,
+				 2.0,  3.0,  4.0,
+				-1.0,  4.0, -3.0,
+				 0.0, -2.0,  0.0 };
+	struct zsl_mtx m = {
 		.sz_rows = 4,
-		.sz_cols = 4,
+		.sz_cols = 3,
 		.data = data
 	};
 
-	/* Input complex-eigenvalue matrix. */
-	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
-				0.0, 3.0, 4.0, -2.0,
-				4.0, 4.0, -3.0, 0.0,
-				9.0, 3.0, -5.0, 2.0 };
+	rc = zsl_mtx_svd(&m, &u, &e, &v, 100);
+	zassert_equal(rc, 0, NULL);
 
-	struct zsl_mtx mb = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datb
-	};
+	zassert_true(val_is_equal(e.data[0], 6.8246886030, 1E-8), NULL);
+	zassert_true(val_is_equal(e.data[4], 5.3940011894, 1E-8), NULL);
+	zassert_true(val_is_equal(e.data[8], 0.5730415692, 1E-8), NULL);
 
-	/* Input symmetric matrix. */
-	zsl_real_t datc[16] = { 1.0, 2.0, 4.0, 0.0,
-				2.0, 3.0, 4.0, -2.0,
-				4.0, 4.0, -3.0, 5.0,
-				0.0, -2.0, 5.0, -1.0 };
+	zassert_true(svd_is_orthonormal(&u, 1E-10), NULL);
+	zassert_true(svd_is_orthonormal(&v, 1E-10), NULL);
 
-	struct zsl_mtx mc = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datc
-	};
+	zsl_mtx_trans(&v, &vt);
+	zsl_mtx_mult(&u, &e, &ue);
+	zsl_mtx_mult(&ue, &vt, &uev);
+	for (size_t g = 0; g < 12; g++) {
+		zassert_true(val_is_equal(uev.data[g], data[g], 1E-10), NULL);
+	}
+}
 
-	/* Expected output. */
-	va2.data[0] = 4.8347780554139375;
-	va2.data[1] = -2.6841592178899276;
-	va2.data[2] = 1.8493811427083884;
-	va2.data[3] = -0.9999999802303374;
+void test_matrix_svd_rank_deficient(void)
+{
+	int rc;
 
-	vb2.data[0] = -3.0925670160610634;
-	vb2.data[1] = -1.0000000075030784;
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(e, 3, 3);
+	ZSL_MATRIX_DEF(v, 3, 3);
+	ZSL_MATRIX_DEF(vt, 3, 3);
+	ZSL_MATRIX_DEF(ue, 3, 3);
+	ZSL_MATRIX_DEF(uev, 3, 3);
+
+	/* The last row is the sum of the first two, so the rank is 2. */
+	zsl_real_t data[9] = { 1.0, 2.0, 3.0,
+			       4.0, 5.0, 6.0,
+			       5.0, 7.0, 9.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
 
-	vc2.data[0] = -9.2890349032381003;
-	vc2.data[1] = 7.4199113544017665;
-	vc2.data[2] = 2.7935849909013921;
-	vc2.data[3] = -0.9244614420638188;
+	rc = zsl_mtx_svd(&m, &u, &e, &v, 100);
+	zassert_equal(rc, 0, NULL);
 
+	/* The smallest singular value is zero, and 'u' is still a complete
+	 * orthonormal basis. */
+	zassert_true(val_is_equal(e.data[8], 0.0, 1E-10), NULL);
+	zassert_true(svd_is_orthonormal(&u, 1E-10), NULL);
+	zassert_true(svd_is_orthonormal(&v, 1E-10), NULL);
 
-	/* Init the output vectors. */
-	rc = zsl_vec_init(&va);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_vec_init(&vb);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_vec_init(&vc);
-	zassert_equal(rc, 0, NULL);
+	zsl_mtx_trans(&v, &vt);
+	zsl_mtx_mult(&u, &e, &ue);
+	zsl_mtx_mult(&ue, &vt, &uev);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_true(val_is_equal(uev.data[g], data[g], 1E-10), NULL);
+	}
+}
 
-	/* Calculate the eigenvalues of 'ma', 'mb' and 'mc'. */
-	rc = zsl_mtx_eigenvalues(&ma, &va, 150);
-	zassert_equal(rc, 0, NULL);
+void test_matrix_svd_vals(void)
+{
+	int rc;
 
-	rc = zsl_mtx_eigenvalues(&mb, &vb, 150);
-	zassert_equal(rc, -ECOMPLEXVAL, NULL);
+	ZSL_VECTOR_DEF(s, 3);
+	ZSL_VECTOR_DEF(bad, 4);
 
-	rc = zsl_mtx_eigenvalues(&mc, &vc, 150);
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	rc = zsl_mtx_svd_vals(&m, &s, 100);
 	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(s.data[0], 6.8246886030, 1E-8), NULL);
+	zassert_true(val_is_equal(s.data[1], 5.3940011894, 1E-8), NULL);
+	zassert_true(val_is_equal(s.data[2], 0.5730415692, 1E-8), NULL);
 
-	/* Check the output. */
-	zassert_true(zsl_vec_is_equal(&va, &va2, 1E-6), NULL);
-	zassert_true(zsl_vec_is_equal(&vb, &vb2, 1E-6), NULL);
-	zassert_true(zsl_vec_is_equal(&vc, &vc2, 1E-6), NULL);
+	/* The values-only mode needs far less workspace than the full SVD. */
+	zassert_true(zsl_mtx_svd_vals_ws_sz(3, 4) < zsl_mtx_svd_ws_sz(3, 4),
+		     NULL);
+
+	/* 's' must hold min(rows, cols) values. */
+	rc = zsl_mtx_svd_vals(&m, &bad, 100);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
-void test_matrix_eigenvectors(void)
+/* Workspace used by the _ws decomposition tests, kept off the stack. */
+static zsl_real_t mtx_ws_buf[1024];
+
+void test_matrix_svd_ws(void)
 {
 	int rc;
+	size_t sz;
+	struct zsl_workspace ws;
 
-	ZSL_MATRIX_DEF(va, 4, 4);
-	ZSL_MATRIX_DEF(vb, 4, 4);
-	ZSL_MATRIX_DEF(vc, 4, 4);
-	ZSL_MATRIX_DEF(vd, 3, 3);
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(e, 3, 4);
+	ZSL_MATRIX_DEF(v, 4, 4);
 
-	ZSL_MATRIX_DEF(va2, 4, 4);
-	ZSL_MATRIX_DEF(vb2, 4, 2);
-	ZSL_MATRIX_DEF(vc2, 4, 2);
-	ZSL_MATRIX_DEF(vd2, 3, 3);
+	ZSL_MATRIX_DEF(u2, 3, 3);
+	ZSL_MATRIX_DEF(e2, 3, 4);
+	ZSL_MATRIX_DEF(v2, 4, 4);
 
-	/* Input real-eigenvalue matrix. */
-	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
 				0.0, 3.0, 4.0, -2.0,
-				4.0, 4.0, -3.0, 0.0,
-				5.0, 3.0, -5.0, 2.0 };
+				4.0, 4.0, -3.0, 0.0 };
 
-	struct zsl_mtx ma = {
-		.sz_rows = 4,
+	struct zsl_mtx m = {
+		.sz_rows = 3,
 		.sz_cols = 4,
 		.data = data
 	};
 
-	/* Input complex-eigenvalue matrix. */
-	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
-				0.0, 3.0, 4.0, -2.0,
-				4.0, 4.0, -3.0, 0.0,
-				9.0, 3.0, -5.0, 2.0 };
+	sz = zsl_mtx_svd_ws_sz(3, 4);
+	zassert_true(sz <= 1024, NULL);
 
-	struct zsl_mtx mb = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datb
-	};
+	/* A workspace that is too small must be rejected. */
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz / 2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_svd_ws(&m, &u, &e, &v, 1500, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 0, NULL);
 
-	/* Input real-eigenvalue non-diagonalisable matrix with repeated
-	 * eigenvalues. */
-	zsl_real_t datc[16] = { 1.0, 2.0, 4.0, 0.0,
-				0.0, 3.0, 4.0, -2.0,
-				0.0, 0.0, 3.0, 5.0,
-				0.0, 0.0, 0.0, 1.0 };
+	/* The workspace and stack versions produce the same results. */
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_svd_ws(&m, &u, &e, &v, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	zassert_true(ws.peak <= sz, NULL);
 
-	struct zsl_mtx mc = {
-		.sz_rows = 4,
-		.sz_cols = 4,
-		.data = datc
-	};
-	
-	/* Input real-eigenvalue diagonalisable matrix with repeated
-	 * eigenvalues. */
-	zsl_real_t datd[9] = { 5.0, -4.0, 4.0,
-			       12.0, -11.0, 12.0,
-			       4.0, -4.0, 5.0 };
+	rc = zsl_mtx_svd(&m, &u2, &e2, &v2, 1500);
+	zassert_equal(rc, 0, NULL);
 
-	struct zsl_mtx md = {
+	zassert_true(zsl_mtx_is_equal(&u, &u2), NULL);
+	zassert_true(zsl_mtx_is_equal(&e, &e2), NULL);
+	zassert_true(zsl_mtx_is_equal(&v, &v2), NULL);
+}
+
+void test_matrix_pinv_ws(void)
+{
+	int rc;
+	struct zsl_workspace ws;
+
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinv2, 4, 3);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
 		.sz_rows = 3,
-		.sz_cols = 3,
-		.data = datd
+		.sz_cols = 4,
+		.data = data
 	};
 
-	/* Init the output matrices. */
-	rc = zsl_mtx_init(&va, NULL);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&vb, NULL);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&vc, NULL);
-	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&vd, NULL);
+	zassert_true(zsl_mtx_pinv_ws_sz(3, 4) <= 1024, NULL);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, zsl_mtx_pinv_ws_sz(3, 4));
 	zassert_equal(rc, 0, NULL);
 
-	/* Calculate the eigenvectors of 'ma', 'mb' and 'mc'
-	 * non-orthonormalised. */
-	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, false);
+	rc = zsl_mtx_pinv_ws(&m, &pinv, 1500, &ws);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, false);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
-	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, false);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
-	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, false);
+	zassert_equal(ws.used, 0, NULL);
+
+	rc = zsl_mtx_pinv(&m, &pinv2, 1500);
 	zassert_equal(rc, 0, NULL);
 
-	/* Expected output. */
-	zsl_real_t a[16] = {
-		0.7555042357,  0.6223771803,  0.2074844660,  5.5000009316,
-		2.2040997676, -0.5240911326,  0.2956011625, -3.5000005906,
-		1.5110084714,  1.2447543606,  0.4149689321,  4.0000005733,
-		1.0000000000,  1.0000000000,  1.0000000000,  1.0000000000
-	};
+	zassert_true(zsl_mtx_is_equal(&pinv, &pinv2), NULL);
+}
 
-	zsl_real_t b[8] = { 1.2304303063, -0.5000000054,
-			    -1.2873789372, 0.5000000045,
-			    2.4608606125, -0.0000000055,
-			    1.0000000000, 1.0000000000 };
+void test_matrix_plan(void)
+{
+	int rc;
+	struct zsl_workspace ws;
+	struct zsl_mtx_plan plan;
+	size_t sz;
 
-	zsl_real_t c[8] = { 1.0, 1.0,
-			    0.0, 1.0,
-			    0.0, 0.0,
-			    0.0, 0.0 };
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(e, 3, 4);
+	ZSL_MATRIX_DEF(v, 4, 4);
+	ZSL_MATRIX_DEF(u2, 3, 3);
+	ZSL_MATRIX_DEF(e2, 3, 4);
+	ZSL_MATRIX_DEF(v2, 4, 4);
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinv2, 4, 3);
+	ZSL_VECTOR_DEF(s, 3);
+	ZSL_VECTOR_DEF(s2, 3);
+	ZSL_VECTOR_DEF(ev, 4);
+	ZSL_VECTOR_DEF(ev2, 4);
 
-	zsl_real_t d[9] = { 1.0, 1.0, -1.0,
-			    3.0, 1.0, 0.0,
-			    1.0, 0.0, 1.0 };
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+	zsl_real_t sq[16] = { 1.0, 2.0, -1.0, 0.0,
+			      0.0, 3.0, 4.0, -2.0,
+			      4.0, 4.0, -3.0, 0.0,
+			      5.0, 3.0, -5.0, 2.0 };
 
-	rc = zsl_mtx_from_arr(&va2, a);
+	struct zsl_mtx m = { .sz_rows = 3, .sz_cols = 4, .data = data };
+	struct zsl_mtx ms = { .sz_rows = 4, .sz_cols = 4, .data = sq };
+
+	/* Shapes that can't be planned are rejected. */
+	rc = zsl_ws_init(&ws, mtx_ws_buf, 1024);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vb2, b);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_EIGENVALUES, 3, 4, 150,
+			       &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD, 0, 4, 150, &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* A workspace that is too small is rejected when planning. */
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_SVD, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz - 1);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vc2, c);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD, 3, 4, 1500, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* Each plan can be executed repeatedly, and matches the unplanned
+	 * function. */
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vd2, d);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD, 3, 4, 1500, &ws);
 	zassert_equal(rc, 0, NULL);
-
-	/* Check the output. */
-	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
-		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
+	zassert_equal(ws.used, sz, NULL);
+	rc = zsl_mtx_svd(&m, &u2, &e2, &v2, 1500);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		rc = zsl_mtx_plan_svd(&plan, &m, &u, &e, &v);
+		zassert_equal(rc, 0, NULL);
+		zassert_true(zsl_mtx_is_equal(&u, &u2), NULL);
+		zassert_true(zsl_mtx_is_equal(&e, &e2), NULL);
+		zassert_true(zsl_mtx_is_equal(&v, &v2), NULL);
 	}
 
-	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
-		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
-	}
-	
-	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
-		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
-	}
+	/* Executing a plan of a different type is an error. */
+	rc = zsl_mtx_plan_pinv(&plan, &m, &pinv);
+	zassert_equal(rc, -EINVAL, NULL);
 
-	/* Calculate the eigenvectors of 'ma', 'mb' and 'mc' orthonormalised. */
-	rc = zsl_mtx_eigenvectors(&ma, &va, 1500, true);
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_SVD_VALS, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_eigenvectors(&mb, &vb, 1500, true);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
-	rc = zsl_mtx_eigenvectors(&mc, &vc, 1500, true);
-	zassert_equal(rc, -EEIGENSIZE, NULL);
-	rc = zsl_mtx_eigenvectors(&md, &vd, 1500, true);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD_VALS, 3, 4, 1500, &ws);
 	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_svd_vals(&plan, &m, &s);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_svd_vals(&m, &s2, 1500);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&s, &s2, 1E-8), NULL);
 
-	/* Expected output. */
-	zsl_real_t a2[16] = {
-		0.2559636199, 0.3472992698, 0.1817921832, 0.7130241030,
-		0.7467454562, -0.2924536333, 0.2589976094, -0.4537426107,
-		0.5119272398, 0.6945985397, 0.3635843664, 0.5185629705,
-		0.3387983916, 0.5580205715, 0.8761724995, 0.1296407240
-	};
-
-
-	zsl_real_t b2[8] = { 0.3847511767, -0.4082482935,
-			     -0.4025588109, 0.4082482928,
-			     0.7695023535, -0.0000000045,
-			     0.3126964402, 0.8164965782 };
-
-	zsl_real_t c2[8] = { 1.0, 0.7071067812,
-			     0.0, 0.7071067812,
-			     0.0, 0.0,
-			     0.0, 0.0 };
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_PINV, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_PINV, 3, 4, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_pinv(&m, &pinv2, 1500);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		rc = zsl_mtx_plan_pinv(&plan, &m, &pinv);
+		zassert_equal(rc, 0, NULL);
+		zassert_true(zsl_mtx_is_equal(&pinv, &pinv2), NULL);
+	}
 
-	zsl_real_t d2[9] = { 0.3015113441, 0.7071067750, -0.4082482533,
-			    0.9045340323, 0.7071067874, 0.4082481887,
-			    0.3015113494, 0.0000000498, 0.8164966504 };
+	/* The input must have the shape the plan was created for. */
+	rc = zsl_mtx_plan_pinv(&plan, &ms, &pinv);
+	zassert_equal(rc, -EINVAL, NULL);
 
-	rc = zsl_mtx_from_arr(&va2, a2);
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_EIGENVALUES, 4, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vb2, b2);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_EIGENVALUES, 4, 4, 500,
+			       &ws);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vc2, c2);
+	rc = zsl_mtx_eigenvalues(&ms, &ev2, 500);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&vd2, d2);
+	for (size_t i = 0; i < 2; i++) {
+		rc = zsl_mtx_plan_eigenvalues(&plan, &ms, &ev);
+		zassert_equal(rc, 0, NULL);
+		zassert_true(zsl_vec_is_equal(&ev, &ev2, 1E-8), NULL);
+	}
+}
+
+/* Steps a started plan one iteration at a time until it converges. */
+static size_t
+test_matrix_plan_slices(struct zsl_mtx_plan *plan)
+{
+	int rc;
+	size_t used, slices = 0;
+
+	do {
+		rc = zsl_mtx_plan_step(plan, 1, &used);
+		zassert_true(used <= 1, NULL);
+		slices++;
+	} while (rc == -EAGAIN);
 	zassert_equal(rc, 0, NULL);
 
-	/* Check the output. */
-	for (size_t g = 0; g < (va.sz_rows * va.sz_cols); g++) {
-		zassert_true(val_is_equal(va.data[g], va2.data[g], 1E-6), NULL);
-	}
-	
-	for (size_t g = 0; g < (vb.sz_rows * vb.sz_cols); g++) {
-		zassert_true(val_is_equal(vb.data[g], vb2.data[g], 1E-6), NULL);
-		zassert_true(val_is_equal(vc.data[g], vc2.data[g], 1E-6), NULL);
-	}
-	
-	for (size_t g = 0; g < (vd.sz_rows * vd.sz_cols); g++) {
-		zassert_true(val_is_equal(vd.data[g], vd2.data[g], 1E-6), NULL);
-	}
+	return slices;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-void test_matrix_svd(void)
+void test_matrix_plan_step(void)
 {
 	int rc;
+	struct zsl_workspace ws;
+	struct zsl_mtx_plan plan;
+	size_t sz, used;
 
 	ZSL_MATRIX_DEF(u, 3, 3);
 	ZSL_MATRIX_DEF(e, 3, 4);
 	ZSL_MATRIX_DEF(v, 4, 4);
-
 	ZSL_MATRIX_DEF(u2, 3, 3);
 	ZSL_MATRIX_DEF(e2, 3, 4);
 	ZSL_MATRIX_DEF(v2, 4, 4);
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinv2, 4, 3);
+	ZSL_VECTOR_DEF(s, 3);
+	ZSL_VECTOR_DEF(s2, 3);
+	ZSL_VECTOR_DEF(ev, 4);
+	ZSL_VECTOR_DEF(ev2, 4);
 
-	/* Input  matrix. */
 	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
 				0.0, 3.0, 4.0, -2.0,
 				4.0, 4.0, -3.0, 0.0 };
+	zsl_real_t sq[16] = { 1.0, 2.0, -1.0, 0.0,
+			      0.0, 3.0, 4.0, -2.0,
+			      4.0, 4.0, -3.0, 0.0,
+			      5.0, 3.0, -5.0, 2.0 };
 
-	struct zsl_mtx m = {
-		.sz_rows = 3,
-		.sz_cols = 4,
-		.data = data
-	};
+	struct zsl_mtx m = { .sz_rows = 3, .sz_cols = 4, .data = data };
+	struct zsl_mtx ms = { .sz_rows = 4, .sz_cols = 4, .data = sq };
 
-	/* Init the output matrices. */
-	rc = zsl_mtx_init(&u, NULL);
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_SVD, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&e, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD, 3, 4, 1500, &ws);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_init(&v, NULL);
+	zassert_equal(ws.used, sz, NULL);
+
+	/* Nothing can be stepped or formed before a run is started. */
+	rc = zsl_mtx_plan_step(&plan, 1, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_plan_svd(&plan, NULL, &u, &e, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_plan_start(&plan, &ms);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* A run sliced into single sweeps gives the blocking result. */
+	rc = zsl_mtx_plan_svd(&plan, &m, &u2, &e2, &v2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_start(&plan, &m);
 	zassert_equal(rc, 0, NULL);
+	zassert_true(test_matrix_plan_slices(&plan) > 1, NULL);
+	rc = zsl_mtx_plan_svd(&plan, NULL, &u, &e, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&u, &u2), NULL);
+	zassert_true(zsl_mtx_is_equal(&e, &e2), NULL);
+	zassert_true(zsl_mtx_is_equal(&v, &v2), NULL);
 
-	/* Calculate the svd of 'm'. */
-	rc = zsl_mtx_svd(&m, &u, &e, &v, 1500);
+	/* So does a run sliced into single column pairs, even when mixed with
+	 * whole sweeps. */
+	rc = zsl_mtx_plan_start(&plan, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_rotate(&plan, 1, &used);
+	zassert_equal(rc, -EAGAIN, NULL);
+	zassert_equal(used, 1, NULL);
+	rc = zsl_mtx_plan_step(&plan, 1, NULL);
+	zassert_equal(rc, -EAGAIN, NULL);
+	do {
+		rc = zsl_mtx_plan_rotate(&plan, 1, &used);
+		zassert_true(used <= 1, NULL);
+	} while (rc == -EAGAIN);
 	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_svd(&plan, NULL, &u, &e, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&u, &u2), NULL);
+	zassert_true(zsl_mtx_is_equal(&e, &e2), NULL);
+	zassert_true(zsl_mtx_is_equal(&v, &v2), NULL);
 
-	/* Expected output. */
-	zsl_real_t a[9] = { -0.3481845133, -0.0474852763, 0.9362225661,
-			    -0.0396196056, -0.9970784021, -0.0653065614,
-			    -0.9365884003, 0.0598315021, -0.3452859102 };
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_SVD_VALS, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_SVD_VALS, 3, 4, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_svd_vals(&plan, &m, &s2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_start(&plan, &m);
+	zassert_equal(rc, 0, NULL);
+	test_matrix_plan_slices(&plan);
+	rc = zsl_mtx_plan_svd_vals(&plan, NULL, &s);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&s, &s2, 1E-8), NULL);
 
-	zsl_real_t b[12] = { 6.8246886030, 0.0, 0.0, 0.0,
-			     0.0, 5.3940011894, 0.0, 0.0,
-			     0.0, 0.0, 0.5730415692, 0.0 };
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_PINV, 3, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_PINV, 3, 4, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_pinv(&plan, &m, &pinv2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_start(&plan, &m);
+	zassert_equal(rc, 0, NULL);
+	test_matrix_plan_slices(&plan);
+	rc = zsl_mtx_plan_pinv(&plan, NULL, &pinv);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&pinv, &pinv2), NULL);
 
-	zsl_real_t c[16] = { -0.5999596982, 0.0355655710, -0.7764202435,
-			     0.1896181853, -0.6683940777, -0.5277862667, 0.5154631408, 0.0948090926,
-			     0.4395030259, -0.7638713255, -0.2819884104, 0.3792363705, 0.0116106706,
-			     0.3696989923, 0.2279295777, 0.9006863800 };
+	sz = zsl_mtx_plan_ws_sz(ZSL_MTX_PLAN_EIGENVALUES, 4, 4);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_EIGENVALUES, 4, 4, 500,
+			       &ws);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_eigenvalues(&plan, &ms, &ev2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_start(&plan, &ms);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(test_matrix_plan_slices(&plan) > 1, NULL);
+	rc = zsl_mtx_plan_eigenvalues(&plan, NULL, &ev);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&ev, &ev2, 1E-8), NULL);
+	rc = zsl_mtx_plan_rotate(&plan, 1, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
 
-	rc = zsl_mtx_from_arr(&u2, a);
+	/* A run that uses up the plan's iterations stops converging. */
+	rc = zsl_ws_init(&ws, mtx_ws_buf, sz);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&e2, b);
+	rc = zsl_mtx_plan_init(&plan, ZSL_MTX_PLAN_EIGENVALUES, 4, 4, 2, &ws);
 	zassert_equal(rc, 0, NULL);
-	rc = zsl_mtx_from_arr(&v2, c);
+	rc = zsl_mtx_plan_start(&plan, &ms);
 	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_plan_step(&plan, 1, NULL);
+	zassert_equal(rc, -EAGAIN, NULL);
+	rc = zsl_mtx_plan_step(&plan, 10, NULL);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	rc = zsl_mtx_plan_step(&plan, 10, NULL);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	rc = zsl_mtx_plan_eigenvalues(&plan, NULL, &ev);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	rc = zsl_mtx_plan_eigenvalues(&plan, &ms, &ev);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+}
+#endif
 
-	/* Check the output. */
-	for (size_t g = 0; g < (u.sz_rows * u.sz_cols); g++) {
-		zassert_true(val_is_equal(u.data[g], u2.data[g], 1E-8), NULL);
-	}
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+void test_matrix_eigenvalues_iter(void)
+{
+	int rc;
+	size_t used;
+	struct zsl_workspace ws;
 
-	for (size_t g = 0; g < (e.sz_rows * e.sz_cols); g++) {
-		zassert_true(val_is_equal(e.data[g], e2.data[g], 1E-8), NULL);
-	}
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(v2, 4);
 
-	for (size_t g = 0; g < (v.sz_rows * v.sz_cols); g++) {
-		zassert_true(val_is_equal(v.data[g], v2.data[g], 1E-8), NULL);
-	}
+	/* Input real-eigenvalue matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				5.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Expected output. */
+	v2.data[0] = 4.8347780554139375;
+	v2.data[1] = -2.6841592178899276;
+	v2.data[2] = 1.8493811427083884;
+	v2.data[3] = -1.0;
+
+	zassert_true(zsl_mtx_eigenvalues_ws_sz(4) <= 1024, NULL);
+	rc = zsl_ws_init(&ws, mtx_ws_buf, zsl_mtx_eigenvalues_ws_sz(4));
+	zassert_equal(rc, 0, NULL);
+
+	/* Shifted QR should converge long before the iteration limit. */
+	rc = zsl_mtx_eigenvalues_ws(&m, &v, 500, &used, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	zassert_true(used > 0, NULL);
+	zassert_true(used < 50, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-6), NULL);
+
+	/* Hitting the iteration limit reports the limit. */
+	rc = zsl_mtx_eigenvalues_ws(&m, &v, 2, &used, &ws);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(used, 2, NULL);
 }
 #endif
 
@@ -2507,6 +5552,10 @@ void test_matrix_pinv(void)
 		zassert_true(val_is_equal(pinv.data[g], pinv2.data[g], 1E-8),
 			     NULL);
 	}
+
+	/* The output must have the transposed shape of the input. */
+	rc = zsl_mtx_pinv(&m, &m, 1500);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 #endif
 
@@ -2631,6 +5680,12 @@ void test_matrix_is_equal(void)
 	zsl_mtx_set(&mb, 1, 1, 0.5);
 	res = zsl_mtx_is_equal(&ma, &mb);
 	zassert_equal(res, false, "");
+
+	/* Every element is compared, including the last. */
+	zsl_mtx_set(&mb, 1, 1, 4.0);
+	zsl_mtx_set(&mb, 3, 1, 4.5);
+	res = zsl_mtx_is_equal(&ma, &mb);
+	zassert_equal(res, false, "");
 }
 
 void test_matrix_is_notneg(void)
@@ -2686,4 +5741,220 @@ void test_matrix_is_sym(void)
 	/* Perform a test with a non-symmetric matrix. */
 	res = zsl_mtx_is_sym(&mb);
 	zassert_equal(res, false, NULL);
+
+	/* A matrix spanning several tiles, with a difference in the last. */
+	ZSL_MATRIX_DEF(mc, 19, 19);
+	for (size_t i = 0; i < 19; i++) {
+		for (size_t j = 0; j < 19; j++) {
+			mc.data[i * 19 + j] = (zsl_real_t)(i + j) +
+					      0.25 * i * j;
+		}
+	}
+	res = zsl_mtx_is_sym(&mc);
+	zassert_equal(res, true, NULL);
+	mc.data[17 * 19 + 18] += 0.5;
+	res = zsl_mtx_is_sym(&mc);
+	zassert_equal(res, false, NULL);
+
+	/* Non-square matrices are never symmetric. */
+	mc.sz_cols = 18;
+	res = zsl_mtx_is_sym(&mc);
+	zassert_equal(res, false, NULL);
+}
+
+void test_matrix_props(void)
+{
+	int rc;
+	uint32_t props;
+
+	ZSL_MATRIX_CONST_DEF(spd, 3, 3,
+			     4.0, 1.0, 0.5,
+			     1.0, 3.0, 0.0,
+			     0.5, 0.0, 2.0);
+	ZSL_MATRIX_CONST_DEF(sym, 2, 2,
+			     1.0, 2.0,
+			     2.0, 1.0);
+	ZSL_MATRIX_CONST_DEF(gen, 2, 2,
+			     1.0, 2.0,
+			     0.0, 1.0);
+
+	rc = zsl_mtx_props(&spd, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(props, ZSL_MTX_PROP_SYM | ZSL_MTX_PROP_POSDEF, NULL);
+
+	/* Symmetric, with eigenvalues 3 and -1. */
+	rc = zsl_mtx_props(&sym, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(props, ZSL_MTX_PROP_SYM, NULL);
+
+	rc = zsl_mtx_props(&gen, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(props, ZSL_MTX_PROP_UPPER, NULL);
+
+	/* A rotation by 90 degrees. */
+	ZSL_MATRIX_CONST_DEF(rot, 2, 2,
+			     0.0, -1.0,
+			     1.0, 0.0);
+	rc = zsl_mtx_props(&rot, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(props, ZSL_MTX_PROP_ORTHO, NULL);
+
+	ZSL_MATRIX_CONST_DEF(diag, 2, 2,
+			     2.0, 0.0,
+			     0.0, 4.0);
+	rc = zsl_mtx_props(&diag, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(props, ZSL_MTX_PROP_DIAG | ZSL_MTX_PROP_SYM |
+		      ZSL_MTX_PROP_POSDEF, NULL);
+}
+
+void test_matrix_props_ops(void)
+{
+	int rc;
+	uint32_t props;
+	struct zsl_mtx *ms[4];
+
+	ZSL_MATRIX_CONST_DEF(up, 3, 3,
+			     2.0, 1.0, -1.0,
+			     0.0, 3.0, 0.5,
+			     0.0, 0.0, 4.0);
+	ZSL_MATRIX_CONST_DEF(lo, 3, 3,
+			     1.0, 0.0, 0.0,
+			     -2.0, 5.0, 0.0,
+			     0.5, 1.5, 2.0);
+	ZSL_MATRIX_CONST_DEF(dg, 3, 3,
+			     2.0, 0.0, 0.0,
+			     0.0, -4.0, 0.0,
+			     0.0, 0.0, 0.5);
+	ZSL_MATRIX_CONST_DEF(spd, 3, 3,
+			     4.0, 1.0, 0.5,
+			     1.0, 3.0, 0.0,
+			     0.5, 0.0, 2.0);
+	ZSL_MATRIX_DEF(q, 3, 3);
+	ZSL_MATRIX_DEF(r, 3, 3);
+	ZSL_MATRIX_DEF(mc, 3, 3);
+	ZSL_MATRIX_DEF(mref, 3, 3);
+	ZSL_MATRIX_DEF(mi, 3, 3);
+	ZSL_MATRIX_DEF(b, 3, 2);
+	ZSL_MATRIX_DEF(x, 3, 2);
+	ZSL_MATRIX_DEF(xref, 3, 2);
+
+	ms[0] = (struct zsl_mtx *)&up;
+	ms[1] = (struct zsl_mtx *)&lo;
+	ms[2] = (struct zsl_mtx *)&dg;
+	ms[3] = (struct zsl_mtx *)&spd;
+
+	for (size_t i = 0; i < 6; i++) {
+		b.data[i] = (zsl_real_t)i - 2.5;
+	}
+
+	/* Each structured path matches the general one. */
+	for (size_t m = 0; m < 4; m++) {
+		rc = zsl_mtx_props(ms[m], &props);
+		zassert_equal(rc, 0, NULL);
+
+		for (size_t p = 0; p < 4; p++) {
+			uint32_t pp;
+
+			zsl_mtx_props(ms[p], &pp);
+			rc = zsl_mtx_mult_props(ms[m], props, ms[p], pp, &mc);
+			zassert_equal(rc, 0, NULL);
+			zsl_mtx_mult(ms[m], ms[p], &mref);
+			for (size_t k = 0; k < 9; k++) {
+				zassert_true(val_is_equal(mc.data[k],
+							  mref.data[k], 1E-5),
+					     NULL);
+			}
+		}
+
+		rc = zsl_mtx_inv_props(ms[m], props, &mi);
+		zassert_equal(rc, 0, NULL);
+		zsl_mtx_inv(ms[m], &mref);
+		for (size_t k = 0; k < 9; k++) {
+			zassert_true(val_is_equal(mi.data[k], mref.data[k],
+						  1E-5), NULL);
+		}
+
+		zsl_mtx_solve(ms[m], &b, &xref);
+		rc = zsl_mtx_solve_props(ms[m], props, &b, &x);
+		zassert_equal(rc, 0, NULL);
+		for (size_t k = 0; k < 6; k++) {
+			zassert_true(val_is_equal(x.data[k], xref.data[k],
+						  1E-5), NULL);
+		}
+	}
+
+	/* The Q and R of a QR decomposition have known structure. */
+	zsl_mtx_qrd(&spd, &q, &r, false);
+	rc = zsl_mtx_props(&q, &props);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(props & ZSL_MTX_PROP_ORTHO, NULL);
+
+	rc = zsl_mtx_inv_props(&q, ZSL_MTX_PROP_ORTHO, &mi);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&q, &mi, &mc);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			zassert_true(val_is_equal(mc.data[i * 3 + j],
+						  (i == j) ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Solve in place with Q, then undo it with R. */
+	zsl_mtx_copy(&x, &b);
+	rc = zsl_mtx_solve_props(&q, ZSL_MTX_PROP_ORTHO, &x, &x);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_solve_props(&r, ZSL_MTX_PROP_UPPER, &x, &x);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_solve(&spd, &b, &xref);
+	for (size_t k = 0; k < 6; k++) {
+		zassert_true(val_is_equal(x.data[k], xref.data[k], 1E-5),
+			     NULL);
+	}
+
+	/* A zero on the diagonal. */
+	zsl_mtx_init(&mc, NULL);
+	rc = zsl_mtx_inv_props(&mc, ZSL_MTX_PROP_DIAG, &mi);
+	zassert_equal(rc, -ESINGULAR, NULL);
+	rc = zsl_mtx_mult_props(&b, ZSL_MTX_PROP_UPPER, &mc, 0, &mref);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_matrix_def_aligned(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF_ALIGNED(ma, 9, 7);
+	ZSL_MATRIX_DEF_ALIGNED(mb, 7, 16);
+	ZSL_MATRIX_DEF_ALIGNED(mc, 9, 16);
+	ZSL_MATRIX_DEF(mref, 9, 16);
+
+	zassert_equal(ma.sz_rows, 9, NULL);
+	zassert_equal(ma.sz_cols, 7, NULL);
+	zassert_true(ZSL_IS_ALIGNED(ma.data, ZSL_DATA_ALIGN), NULL);
+	zassert_true(ZSL_IS_ALIGNED(mc.data, ZSL_DATA_ALIGN), NULL);
+	zassert_equal(sizeof(ma_mtx) % ZSL_DATA_ALIGN, 0, NULL);
+
+	for (size_t i = 0; i < 9 * 7; i++) {
+		ma.data[i] = (zsl_real_t)((i * 5) % 11) - 5.0;
+	}
+	for (size_t i = 0; i < 7 * 16; i++) {
+		mb.data[i] = (zsl_real_t)((i * 3) % 7) * 0.25;
+	}
+
+	/* Rows of 'mb' and 'mc' are aligned, since 16 columns fill whole
+	 * vectors. The result matches the element by element product. */
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		for (size_t j = 0; j < 16; j++) {
+			mref.data[i * 16 + j] = 0.0;
+			for (size_t k = 0; k < 7; k++) {
+				mref.data[i * 16 + j] += ma.data[i * 7 + k] *
+							 mb.data[k * 16 + j];
+			}
+		}
+	}
+	zassert_true(zsl_mtx_is_equal(&mc, &mref), NULL);
 }
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/statistics.h>
+#include <zsl/measurement/batch.h>
+#include "floatcheck.h"
+
+void test_mes_batch(void)
+{
+	int rc;
+	zsl_real_t mean;
+	zsl_real_t buf[12];
+	zsl_real_t xyz[4][3] = {
+		{ 0.1, -0.2, 9.8 },
+		{ 0.3, -0.4, 9.7 },
+		{ 0.5, -0.6, 9.9 },
+		{ 0.7, -0.8, 9.6 }
+	};
+	struct zsl_measurement mes;
+	struct zsl_vec v;
+	struct zsl_mtx m;
+
+	ZSL_VECTOR_DEF(s, 3);
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.base_type = ZSL_MES_TYPE_ACCELERATION;
+	rc = zsl_mes_batch_init(&mes, buf, sizeof(buf), 3, 2);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mes.header.srclen.len == sizeof(buf), NULL);
+	zassert_true(zsl_mes_batch_chans(&mes) == 3, NULL);
+
+	/* Four x, y, z readings, stored channel-major. */
+	for (size_t i = 0; i < 4; i++) {
+		zsl_vec_from_arr(&s, xyz[i]);
+		rc = zsl_mes_batch_put(&mes, i, &s);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(buf[4] == xyz[0][1], NULL);
+	zassert_true(buf[11] == xyz[3][2], NULL);
+
+	/* The y channel as a vector over the payload. */
+	rc = zsl_mes_batch_vec(&mes, 1, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(v.sz == 4, NULL);
+	zassert_true(v.data == &buf[4], NULL);
+	rc = zsl_sta_mean(&v, &mean);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mean, -0.5, 1E-6), NULL);
+
+	/* The whole batch as a 3x4 matrix. */
+	rc = zsl_mes_batch_mtx(&mes, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(m.sz_rows == 3, NULL);
+	zassert_true(m.sz_cols == 4, NULL);
+	zassert_true(m.data == buf, NULL);
+
+	rc = zsl_mes_batch_get(&mes, 2, &s);
+	zassert_true(rc == 0, NULL);
+	zassert_true(s.data[0] == xyz[2][0], NULL);
+	zassert_true(s.data[2] == xyz[2][2], NULL);
+
+	/* Out of range channels and samples. */
+	rc = zsl_mes_batch_vec(&mes, 3, &v);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_batch_get(&mes, 4, &s);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Other C types are not batches. */
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	zassert_true(zsl_mes_batch_chans(&mes) == 0, NULL);
+	rc = zsl_mes_batch_mtx(&mes, &m);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_mes_batch_init(&mes, buf, sizeof(buf), 4, 2);
+	zassert_true(rc == -ENOMEM, NULL);
+	rc = zsl_mes_batch_init(&mes, buf, sizeof(buf), 0, 2);
+	zassert_true(rc == -EINVAL, NULL);
+}
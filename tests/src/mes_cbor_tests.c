@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/cbor.h>
+
+void test_mes_cbor_enc(void)
+{
+	int rc;
+	uint8_t buf[32];
+	int16_t s[4] = { 0, 23, -24, -1000 };
+	float f = 1.5f;
+	bool b[2] = { true, false };
+	struct zsl_measurement mes, out;
+	struct zsl_mes_cbor c;
+	/* [1000, 0, 23, -24, -1000] */
+	const uint8_t exp_s[] = {
+		0x85, 0x19, 0x03, 0xE8, 0x00, 0x17, 0x37, 0x39, 0x03, 0xE7
+	};
+	/* [1.5] */
+	const uint8_t exp_f[] = { 0x81, 0xFA, 0x3F, 0xC0, 0x00, 0x00 };
+
+	/* Four samples, with a timestamp. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.flags.timestamp = ZSL_MES_TIMESTAMP_EPOCH_32;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	mes.header.srclen.samples = 2;
+	mes.header.srclen.len = sizeof(s);
+	mes.payload = s;
+
+	rc = zsl_mes_cbor_enc(&mes, 1000, buf, sizeof(buf), &out);
+	zassert_true(rc == 0, NULL);
+	zassert_true(out.payload == buf, NULL);
+	zassert_true(out.header.filter.flags.data_format ==
+		     ZSL_MES_FORMAT_CBOR, NULL);
+	zassert_true(out.header.srclen.len == sizeof(exp_s), NULL);
+	zassert_true(memcmp(buf, exp_s, sizeof(exp_s)) == 0, NULL);
+
+	/* One sample, no timestamp. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+	mes.payload = &f;
+	rc = zsl_mes_cbor_enc(&mes, 0, buf, sizeof(buf), &out);
+	zassert_true(rc == 0, NULL);
+	zassert_true(out.header.srclen.len == sizeof(exp_f), NULL);
+	zassert_true(memcmp(buf, exp_f, sizeof(exp_f)) == 0, NULL);
+
+	/* Streamed booleans. */
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_BOOL;
+	mes.header.srclen.samples = 1;
+	rc = zsl_mes_cbor_enc_start(&c, &mes.header, 0, buf, sizeof(buf));
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_cbor_enc_sample(&c, &mes.header, &b[0]);
+	zassert_true(rc == 0, NULL);
+
+	/* Ending early fails. */
+	rc = zsl_mes_cbor_enc_end(&c, &mes.header);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_mes_cbor_enc_sample(&c, &mes.header, &b[1]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_cbor_enc_sample(&c, &mes.header, &b[1]);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_cbor_enc_end(&c, &mes.header);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mes.header.srclen.len == 3, NULL);
+	zassert_true(buf[0] == 0x82, NULL);
+	zassert_true(buf[1] == 0xF5, NULL);
+	zassert_true(buf[2] == 0xF4, NULL);
+
+	/* Too small a buffer, and unsupported C types. */
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	mes.header.srclen.samples = 2;
+	mes.payload = s;
+	rc = zsl_mes_cbor_enc(&mes, 0, buf, 6, &out);
+	zassert_true(rc == -ENOMEM, NULL);
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_COMPLEX_32;
+	rc = zsl_mes_cbor_enc(&mes, 0, buf, sizeof(buf), &out);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_mes_cbor_dec(void)
+{
+	int rc;
+	uint64_t ts;
+	uint8_t buf[64];
+	int64_t s[4] = { INT64_MIN, -1, 0, INT64_MAX };
+	int64_t sd[4];
+	double d[2];
+	int8_t s8[2];
+	struct zsl_measurement mes, out;
+	/* [1.0 as a half, -2] */
+	uint8_t f16[] = { 0x82, 0xF9, 0x3C, 0x00, 0x21 };
+	/* [200, -3] */
+	uint8_t big[] = { 0x82, 0x18, 0xC8, 0x22 };
+
+	/* Round trip with the widest integers and a 64-bit timestamp. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.flags.timestamp = ZSL_MES_TIMESTAMP_UPTIME_US_64;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S64;
+	mes.header.srclen.samples = 2;
+	mes.payload = s;
+	rc = zsl_mes_cbor_enc(&mes, UINT64_MAX, buf, sizeof(buf), &out);
+	zassert_true(rc == 0, NULL);
+
+	rc = zsl_mes_cbor_dec(&out, &ts, sd, sizeof(sd));
+	zassert_true(rc == 0, NULL);
+	zassert_true(ts == UINT64_MAX, NULL);
+	zassert_true(memcmp(s, sd, sizeof(s)) == 0, NULL);
+
+	/* Output too small, or a truncated payload. */
+	rc = zsl_mes_cbor_dec(&out, &ts, sd, sizeof(sd) - 1);
+	zassert_true(rc == -ENOMEM, NULL);
+	out.header.srclen.len--;
+	rc = zsl_mes_cbor_dec(&out, &ts, sd, sizeof(sd));
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Other encoders' shorter forms are accepted for doubles. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.flags.data_format = ZSL_MES_FORMAT_CBOR;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT64;
+	mes.header.srclen.samples = 1;
+	mes.header.srclen.len = sizeof(f16);
+	mes.payload = f16;
+	rc = zsl_mes_cbor_dec(&mes, &ts, d, sizeof(d));
+	zassert_true(rc == 0, NULL);
+	zassert_true(ts == 0, NULL);
+	zassert_true(d[0] == 1.0, NULL);
+	zassert_true(d[1] == -2.0, NULL);
+
+	/* Values that don't fit the C type are rejected. */
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S8;
+	mes.header.srclen.len = sizeof(big);
+	mes.payload = big;
+	rc = zsl_mes_cbor_dec(&mes, NULL, s8, sizeof(s8));
+	zassert_true(rc == -EINVAL, NULL);
+	big[2] = 0x7F;
+	rc = zsl_mes_cbor_dec(&mes, NULL, s8, sizeof(s8));
+	zassert_true(rc == 0, NULL);
+	zassert_true(s8[0] == 127, NULL);
+	zassert_true(s8[1] == -3, NULL);
+
+	/* The array length must match the sample count. */
+	mes.header.srclen.samples = 2;
+	rc = zsl_mes_cbor_dec(&mes, NULL, s8, sizeof(s8));
+	zassert_true(rc == -EINVAL, NULL);
+}
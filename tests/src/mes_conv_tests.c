@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/conv.h>
+#include "floatcheck.h"
+
+void test_mes_conv_factor(void)
+{
+	int rc;
+	zsl_real_t mul, add;
+
+	zassert_true(val_is_equal(zsl_mes_conv_pow10(-3), 1E-3, 1E-12), NULL);
+	zassert_true(val_is_equal(zsl_mes_conv_pow10(0), 1.0, 1E-12), NULL);
+	zassert_true(val_is_equal(zsl_mes_conv_pow10(30) / 1E30, 1.0, 1E-5),
+		     NULL);
+
+	/* mV to V. */
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_MILLIVOLTS, 0,
+				 ZSL_MES_UNIT_SI_VOLT, 0, &mul, &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mul, 1E-3, 1E-12), NULL);
+	zassert_true(add == 0.0, NULL);
+
+	/* mV * 10^-3 (uV) to kV. */
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_MILLIVOLTS,
+				 ZSL_MES_SI_SCALE_MILLI, ZSL_MES_UNIT_SI_VOLT,
+				 ZSL_MES_SI_SCALE_KILO, &mul, &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mul, 1E-9, 1E-15), NULL);
+
+	/* hPa to kPa, and the same unit and scale. */
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_HECTOPASCAL, 0,
+				 ZSL_MES_UNIT_SI_PASCAL, 3, &mul, &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mul, 0.1, 1E-9), NULL);
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_LUX, 0, ZSL_MES_UNIT_SI_LUX, 0,
+				 &mul, &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mul == 1.0, NULL);
+
+	/* Degrees C to K, and K to degrees C * 10^-1. */
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_DEGREE_CELSIUS, 0,
+				 ZSL_MES_UNIT_SI_KELVIN, 0, &mul, &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mul, 1.0, 1E-9), NULL);
+	zassert_true(val_is_equal(add, 273.15, 1E-4), NULL);
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_KELVIN, 0,
+				 ZSL_MES_UNIT_SI_DEGREE_CELSIUS, -1, &mul,
+				 &add);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mul, 10.0, 1E-6), NULL);
+	zassert_true(val_is_equal(add, -2731.5, 1E-3), NULL);
+
+	/* Different quantities. */
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_MILLIVOLTS, 0,
+				 ZSL_MES_UNIT_SI_AMPERE, 0, &mul, &add);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_conv_factor(ZSL_MES_UNIT_SI_UNDEFINED, 0,
+				 ZSL_MES_UNIT_SI_UNDEFINED, 0, &mul, &add);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_mes_conv_vals(void)
+{
+	int rc;
+	size_t cnt;
+	int16_t mv[4] = { -1500, 0, 250, 3300 };
+	float c[3] = { -40.0f, 0.0f, 25.0f };
+	zsl_real_t out[4];
+	struct zsl_measurement mes;
+
+	/* A batch of S16 mV readings, read as V. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.si_unit = ZSL_MES_UNIT_SI_MILLIVOLTS;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	mes.header.srclen.len = sizeof(mv);
+	mes.payload = mv;
+
+	rc = zsl_mes_conv_vals(&mes, ZSL_MES_UNIT_SI_VOLT, 0, out, 4, &cnt);
+	zassert_true(rc == 0, NULL);
+	zassert_true(cnt == 4, NULL);
+	zassert_true(val_is_equal(out[0], -1.5, 1E-6), NULL);
+	zassert_true(val_is_equal(out[1], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(out[2], 0.25, 1E-6), NULL);
+	zassert_true(val_is_equal(out[3], 3.3, 1E-6), NULL);
+
+	rc = zsl_mes_conv_vals(&mes, ZSL_MES_UNIT_SI_VOLT, 0, out, 3, &cnt);
+	zassert_true(rc == -ENOMEM, NULL);
+
+	/* Integer payloads can't be converted in place. */
+	rc = zsl_mes_conv(&mes, ZSL_MES_UNIT_SI_VOLT, 0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Float degrees C to K, in place. */
+	mes.header.unit.si_unit = ZSL_MES_UNIT_SI_DEGREE_CELSIUS;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+	mes.header.srclen.len = sizeof(c);
+	mes.payload = c;
+
+	rc = zsl_mes_conv(&mes, ZSL_MES_UNIT_SI_KELVIN, 0);
+	zassert_true(rc == 0, NULL);
+	zassert_true(mes.header.unit.si_unit == ZSL_MES_UNIT_SI_KELVIN, NULL);
+	zassert_true(mes.header.unit.scale_factor == 0, NULL);
+	zassert_true(val_is_equal(c[0], 233.15, 1E-4), NULL);
+	zassert_true(val_is_equal(c[1], 273.15, 1E-4), NULL);
+	zassert_true(val_is_equal(c[2], 298.15, 1E-4), NULL);
+
+	rc = zsl_mes_conv(&mes, ZSL_MES_UNIT_SI_METER, 0);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(mes.header.unit.si_unit == ZSL_MES_UNIT_SI_KELVIN, NULL);
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/frag.h>
+
+/*
+ * Fragments 25 floats with an MTU of 30, and encodes each of the 4
+ * fragments. Returns the number of fragments, or 0 on error.
+ */
+static size_t
+mes_frag_test_split(float *v, uint8_t sourceid, uint8_t pkt[][64],
+		    size_t *len)
+{
+	size_t n = 0;
+	struct zsl_measurement mes;
+	struct zsl_mes_frag f;
+	struct zsl_mes_header hdr;
+	struct zsl_mes_iov iov[2];
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.base_type = ZSL_MES_TYPE_LIGHT;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+	mes.header.srclen.sourceid = sourceid;
+	mes.header.srclen.len = 25 * sizeof(float);
+	mes.payload = v;
+
+	if (zsl_mes_frag_init(&f, &mes, 30)) {
+		return 0;
+	}
+	while ((n < 4) && (zsl_mes_frag_next(&f, &hdr, iov) == 0)) {
+		if (zsl_mes_wire_encv(&hdr, iov, 2, pkt[n], 64, &len[n])) {
+			return 0;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+void test_mes_frag_split(void)
+{
+	int rc;
+	float v[25];
+	struct zsl_measurement mes;
+	struct zsl_mes_frag f;
+	struct zsl_mes_header hdr;
+	struct zsl_mes_iov iov[2];
+	uint16_t pos = 0;
+
+	for (int i = 0; i < 25; i++) {
+		v[i] = (float)i;
+	}
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+	mes.header.srclen.len = sizeof(v);
+	mes.payload = v;
+
+	/* 28 bytes (7 whole floats) per fragment, taken from 'v' in place. */
+	rc = zsl_mes_frag_init(&f, &mes, 31);
+	zassert_true(rc == 0, NULL);
+	for (int i = 0; i < 4; i++) {
+		rc = zsl_mes_frag_next(&f, &hdr, iov);
+		zassert_true(rc == 0, NULL);
+		zassert_true(hdr.srclen.fragment == (i < 3 ?
+			     ZSL_MES_FRAGMENT_PARTIAL : ZSL_MES_FRAGMENT_FINAL),
+			     NULL);
+		zassert_true(iov[0].len == ZSL_MES_FRAG_OFF_LEN, NULL);
+		zassert_true(((const uint8_t *)iov[0].base)[0] == pos, NULL);
+		zassert_true(iov[1].base == (uint8_t *)v + pos, NULL);
+		zassert_true(iov[1].len == (i < 3 ? 28 : 16), NULL);
+		zassert_true(hdr.srclen.len == iov[1].len + 2, NULL);
+		pos += iov[1].len;
+	}
+	rc = zsl_mes_frag_next(&f, &hdr, iov);
+	zassert_true(rc == -ENODATA, NULL);
+
+	/* A payload that fits is sent whole. */
+	rc = zsl_mes_frag_init(&f, &mes, sizeof(v));
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_frag_next(&f, &hdr, iov);
+	zassert_true(rc == 0, NULL);
+	zassert_true(hdr.srclen.fragment == ZSL_MES_FRAGMENT_NONE, NULL);
+	zassert_true(iov[0].len == 0, NULL);
+	zassert_true(iov[1].len == sizeof(v), NULL);
+	rc = zsl_mes_frag_next(&f, &hdr, iov);
+	zassert_true(rc == -ENODATA, NULL);
+
+	/* No room for a whole sample. */
+	rc = zsl_mes_frag_init(&f, &mes, 5);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_mes_frag_reasm(void)
+{
+	int rc;
+	float a[25], b[25];
+	uint8_t pa[4][64], pb[4][64];
+	size_t la[4], lb[4], na, nb, used;
+	struct zsl_measurement mes, out;
+	int order[4] = { 2, 0, 3, 1 };
+
+	ZSL_MES_REASM_DEF(r, 2, 128);
+
+	for (int i = 0; i < 25; i++) {
+		a[i] = (float)i;
+		b[i] = -(float)i;
+	}
+	na = mes_frag_test_split(a, 1, pa, la);
+	nb = mes_frag_test_split(b, 2, pb, lb);
+	zassert_true(na == 4, NULL);
+	zassert_true(nb == 4, NULL);
+
+	/* Two sources interleaved, one of them out of order. */
+	for (size_t i = 0; i < 4; i++) {
+		rc = zsl_mes_wire_dec(pa[i], la[i], &mes, &used);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_mes_reasm_add(&r, &mes, &out);
+		zassert_true(rc == (i < 3 ? -EAGAIN : 0), NULL);
+		if (rc == 0) {
+			zassert_true(out.header.srclen.fragment ==
+				     ZSL_MES_FRAGMENT_NONE, NULL);
+			zassert_true(out.header.srclen.len == sizeof(a), NULL);
+			zassert_true(out.header.srclen.sourceid == 1, NULL);
+			zassert_true(memcmp(out.payload, a, sizeof(a)) == 0,
+				     NULL);
+		}
+
+		rc = zsl_mes_wire_dec(pb[order[i]], lb[order[i]], &mes, &used);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_mes_reasm_add(&r, &mes, &out);
+		zassert_true(rc == (i < 3 ? -EAGAIN : 0), NULL);
+		if (rc == 0) {
+			zassert_true(out.header.srclen.sourceid == 2, NULL);
+			zassert_true(memcmp(out.payload, b, sizeof(b)) == 0,
+				     NULL);
+		}
+	}
+
+	/* Duplicates are harmless, and missing fragments hold it back. */
+	for (size_t i = 0; i < 3; i++) {
+		rc = zsl_mes_wire_dec(pa[i], la[i], &mes, &used);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_mes_reasm_add(&r, &mes, &out);
+		zassert_true(rc == -EAGAIN, NULL);
+		rc = zsl_mes_reasm_add(&r, &mes, &out);
+		zassert_true(rc == -EAGAIN, NULL);
+	}
+	zsl_mes_reasm_drop(&r, 1);
+	rc = zsl_mes_wire_dec(pa[3], la[3], &mes, &used);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_reasm_add(&r, &mes, &out);
+	zassert_true(rc == -EAGAIN, NULL);
+
+	/* Unfragmented measurements pass straight through. */
+	memset(&mes, 0, sizeof(mes));
+	mes.header.srclen.len = sizeof(a);
+	mes.payload = a;
+	rc = zsl_mes_reasm_add(&r, &mes, &out);
+	zassert_true(rc == 0, NULL);
+	zassert_true(out.payload == a, NULL);
+}
+
+void test_mes_frag_reasm_dst(void)
+{
+	int rc;
+	float a[25];
+	uint8_t pa[4][64];
+	size_t la[4], na;
+	uint16_t off;
+	uint8_t *dst;
+	struct zsl_mes_header hdr;
+	struct zsl_measurement out;
+
+	ZSL_MES_REASM_DEF(r, 1, 100);
+
+	for (int i = 0; i < 25; i++) {
+		a[i] = 0.5f * (float)i;
+	}
+	na = mes_frag_test_split(a, 7, pa, la);
+	zassert_true(na == 4, NULL);
+
+	/* Read the header first, then the data straight into its slot. */
+	for (size_t i = 0; i < na; i++) {
+		zsl_mes_wire_hdr_unpack(pa[i], &hdr);
+		off = pa[i][ZSL_MES_WIRE_HDR_LEN] |
+		      (pa[i][ZSL_MES_WIRE_HDR_LEN + 1] << 8);
+		hdr.srclen.len -= ZSL_MES_FRAG_OFF_LEN;
+		dst = zsl_mes_reasm_dst(&r, &hdr, off);
+		zassert_not_null(dst, NULL);
+		memcpy(dst, &pa[i][ZSL_MES_WIRE_HDR_LEN + 2], hdr.srclen.len);
+		rc = zsl_mes_reasm_put(&r, &hdr, off, dst, &out);
+		zassert_true(rc == (i < 3 ? -EAGAIN : 0), NULL);
+	}
+	zassert_true(memcmp(out.payload, a, sizeof(a)) == 0, NULL);
+
+	/* Data past the end of the slot. */
+	hdr.srclen.len = 10;
+	hdr.srclen.fragment = ZSL_MES_FRAGMENT_PARTIAL;
+	zassert_is_null(zsl_mes_reasm_dst(&r, &hdr, 95), NULL);
+	rc = zsl_mes_reasm_put(&r, &hdr, 95, a, &out);
+	zassert_true(rc == -ENOMEM, NULL);
+}
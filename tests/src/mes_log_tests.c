@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/log.h>
+
+struct mes_log_test_out {
+	uint8_t buf[64];
+	size_t len;
+};
+
+static int
+mes_log_test_write(const void *data, size_t len, void *arg)
+{
+	struct mes_log_test_out *o = arg;
+
+	if (o->len + len > sizeof(o->buf)) {
+		return -ENOMEM;
+	}
+	memcpy(o->buf + o->len, data, len);
+	o->len += len;
+
+	return 0;
+}
+
+void test_mes_log(void)
+{
+	int rc;
+	uint8_t rec[32];
+	int16_t v[4] = { -3, 7, 1000, -2000 };
+	struct zsl_measurement mes, out;
+	struct mes_log_test_out o;
+	size_t used;
+
+	ZSL_MES_LOG_DEF(l, 64);
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.base_type = ZSL_MES_TYPE_TEMPERATURE;
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	mes.header.srclen.len = sizeof(v);
+	mes.payload = v;
+
+	rc = zsl_mes_log_pop(&l, rec, sizeof(rec), &out);
+	zassert_true(rc == -ENODATA, NULL);
+
+	/* 20-byte records, in a 64-byte ring that wraps around. */
+	for (int i = 0; i < 8; i++) {
+		mes.header.srclen.sourceid = i;
+		rc = zsl_mes_log(&l, &mes);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_mes_log_pop(&l, rec, sizeof(rec), &out);
+		zassert_true(rc == 0, NULL);
+		zassert_true(out.header.srclen.sourceid == i, NULL);
+		zassert_true(out.header.filter_bits == mes.header.filter_bits,
+			     NULL);
+		zassert_true(out.header.srclen.len == sizeof(v), NULL);
+		zassert_true(memcmp(out.payload, v, sizeof(v)) == 0, NULL);
+	}
+
+	/* The ring holds 3 records, and drops the 4th. */
+	for (int i = 0; i < 4; i++) {
+		rc = zsl_mes_log(&l, &mes);
+		zassert_true(rc == (i < 3 ? 0 : -ENOMEM), NULL);
+	}
+	zassert_true(l.dropped == 1, NULL);
+	zassert_true(l.head - l.tail == 60, NULL);
+
+	/* Too small a buffer skips the record. */
+	rc = zsl_mes_log_pop(&l, rec, 8, &out);
+	zassert_true(rc == -ENOMEM, NULL);
+
+	/* The rest as a raw wire format stream. */
+	memset(&o, 0, sizeof(o));
+	rc = zsl_mes_log_dump(&l, mes_log_test_write, &o);
+	zassert_true(rc == 0, NULL);
+	zassert_true(o.len == 40, NULL);
+	zassert_true(l.head == l.tail, NULL);
+
+	for (size_t p = 0, i = 0; p < o.len; p += used, i++) {
+		rc = zsl_mes_wire_dec(o.buf + p, o.len - p, &out, &used);
+		zassert_true(rc == 0, NULL);
+		zassert_true(memcmp(out.payload, v, sizeof(v)) == 0, NULL);
+	}
+}
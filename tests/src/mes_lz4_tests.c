@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/lz4.h>
+
+void test_mes_lz4_comp(void)
+{
+	int rc;
+	size_t len, dlen;
+	uint8_t src[600];
+	uint8_t dst[ZSL_MES_LZ4_BOUND(600)];
+	uint8_t dec[600];
+	uint32_t x = 12345;
+	/* 'a', then a match of 8 at offset 1, then 5 literal 'b's. */
+	const uint8_t blk[] = { 0x14, 'a', 0x01, 0x00, 0x50,
+				'b', 'b', 'b', 'b', 'b' };
+
+	ZSL_MES_LZ4_DEF(z, 10);
+
+	/* A block from another encoder. */
+	rc = zsl_mes_lz4_decomp(blk, sizeof(blk), dec, sizeof(dec), &dlen);
+	zassert_true(rc == 0, NULL);
+	zassert_true(dlen == 14, NULL);
+	zassert_true(memcmp(dec, "aaaaaaaaabbbbb", 14) == 0, NULL);
+
+	/* Repetitive data, including a long match and long literal runs. */
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (uint8_t)((i < 300) ? i / 7 : 'x');
+	}
+	rc = zsl_mes_lz4_comp(&z, src, sizeof(src), dst, sizeof(dst), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len < sizeof(src) / 2, NULL);
+	rc = zsl_mes_lz4_decomp(dst, len, dec, sizeof(dec), &dlen);
+	zassert_true(rc == 0, NULL);
+	zassert_true(dlen == sizeof(src), NULL);
+	zassert_true(memcmp(src, dec, sizeof(src)) == 0, NULL);
+
+	/* Incompressible data stays within the bound. */
+	for (size_t i = 0; i < sizeof(src); i++) {
+		x = x * 1103515245U + 12345U;
+		src[i] = (uint8_t)(x >> 16);
+	}
+	rc = zsl_mes_lz4_comp(&z, src, sizeof(src), dst, sizeof(dst), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len <= ZSL_MES_LZ4_BOUND(sizeof(src)), NULL);
+	rc = zsl_mes_lz4_decomp(dst, len, dec, sizeof(dec), &dlen);
+	zassert_true(rc == 0, NULL);
+	zassert_true(memcmp(src, dec, sizeof(src)) == 0, NULL);
+
+	/* Short inputs are all literals. */
+	rc = zsl_mes_lz4_comp(&z, src, 3, dst, sizeof(dst), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len == 4, NULL);
+	rc = zsl_mes_lz4_comp(&z, src, 0, dst, sizeof(dst), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len == 1, NULL);
+
+	/* Output too small, and malformed blocks. */
+	rc = zsl_mes_lz4_comp(&z, src, sizeof(src), dst, 100, &len);
+	zassert_true(rc == -ENOMEM, NULL);
+	rc = zsl_mes_lz4_decomp(blk, sizeof(blk), dec, 13, &dlen);
+	zassert_true(rc == -ENOMEM, NULL);
+	rc = zsl_mes_lz4_decomp(blk, 3, dec, sizeof(dec), &dlen);
+	zassert_true(rc == -EINVAL, NULL);
+	memcpy(dst, blk, sizeof(blk));
+	dst[2] = 2;
+	rc = zsl_mes_lz4_decomp(dst, sizeof(blk), dec, sizeof(dec), &dlen);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_mes_lz4_delta(void)
+{
+	int rc;
+	int16_t s[256];
+	int16_t r[256];
+	float f[4] = { 1.0f, 1.0f, -2.5f, 3.0f };
+	float fd[4];
+	uint8_t buf[ZSL_MES_LZ4_BOUND(sizeof(s))];
+	uint8_t dec[sizeof(s)];
+	struct zsl_measurement mes, comp, plain, out;
+
+	ZSL_MES_LZ4_DEF(z, 10);
+
+	/* A slow ramp, which only compresses well with delta encoding. */
+	for (int i = 0; i < 256; i++) {
+		s[i] = (int16_t)(-1000 + 3 * i);
+		r[i] = s[i];
+	}
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S16;
+	mes.header.srclen.len = sizeof(s);
+	mes.payload = s;
+
+	rc = zsl_mes_lz4_enc(&z, &mes, false, buf, sizeof(buf), &plain);
+	zassert_true(rc == 0, NULL);
+	zassert_true(plain.header.filter.flags.compression ==
+		     ZSL_MES_COMPRESSION_LZ4, NULL);
+	rc = zsl_mes_lz4_enc(&z, &mes, true, buf, sizeof(buf), &comp);
+	zassert_true(rc == 0, NULL);
+	zassert_true(comp.header.filter.flags.compression ==
+		     ZSL_MES_COMPRESSION_LZ4_DELTA, NULL);
+	zassert_true(comp.header.srclen.len < plain.header.srclen.len / 4,
+		     NULL);
+
+	/* The source payload is restored. */
+	zassert_true(memcmp(s, r, sizeof(s)) == 0, NULL);
+
+	/* Compressed payloads can't be compressed again. */
+	rc = zsl_mes_lz4_enc(&z, &comp, false, dec, sizeof(dec), &out);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_mes_lz4_dec(&comp, dec, sizeof(dec), &out);
+	zassert_true(rc == 0, NULL);
+	zassert_true(out.header.filter.flags.compression ==
+		     ZSL_MES_COMPRESSION_NONE, NULL);
+	zassert_true(out.header.srclen.len == sizeof(s), NULL);
+	zassert_true(memcmp(out.payload, s, sizeof(s)) == 0, NULL);
+
+	/* Floats are XORed, which is exact for any bit pattern. */
+	memcpy(fd, f, sizeof(f));
+	rc = zsl_mes_lz4_delta(ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32, fd,
+			       sizeof(fd));
+	zassert_true(rc == 0, NULL);
+	zassert_true(fd[0] == 1.0f, NULL);
+	zassert_true(fd[1] == 0.0f, NULL);
+	rc = zsl_mes_lz4_undelta(ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32, fd,
+				 sizeof(fd));
+	zassert_true(rc == 0, NULL);
+	zassert_true(memcmp(f, fd, sizeof(f)) == 0, NULL);
+
+	/* Partial samples and unsupported types. */
+	rc = zsl_mes_lz4_delta(ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32, fd, 6);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_lz4_delta(ZSL_MES_UNIT_CTYPE_S128, fd, sizeof(fd));
+	zassert_true(rc == -EINVAL, NULL);
+}
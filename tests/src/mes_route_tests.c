@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/route.h>
+
+static int mes_route_test_log[8];
+static size_t mes_route_test_n;
+
+static void
+mes_route_test_fn(const struct zsl_measurement *mes, void *arg)
+{
+	if (mes_route_test_n < 8) {
+		mes_route_test_log[mes_route_test_n++] = *(int *)arg;
+	}
+}
+
+void test_mes_route(void)
+{
+	int rc;
+	size_t n;
+	int id[6] = { 0, 1, 2, 3, 4, 5 };
+	uint32_t base = zsl_mes_route_bits(0xFF, 0, 0);
+	uint32_t both = zsl_mes_route_bits(0xFF, 0xFF, 0);
+	struct zsl_measurement mes;
+
+	ZSL_MES_ROUTE_DEF(r, 6, 3);
+
+	/* 0 and 1: all light. 2: light/ext 3. 3: temperature. 4: all. */
+	rc = zsl_mes_route_sub(&r, base,
+			       zsl_mes_route_bits(ZSL_MES_TYPE_LIGHT, 0, 0),
+			       mes_route_test_fn, &id[0]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_route_sub(&r, base,
+			       zsl_mes_route_bits(ZSL_MES_TYPE_LIGHT, 0, 0),
+			       mes_route_test_fn, &id[1]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_route_sub(&r, both,
+			       zsl_mes_route_bits(ZSL_MES_TYPE_LIGHT, 3, 0),
+			       mes_route_test_fn, &id[2]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_route_sub(&r, base,
+			       zsl_mes_route_bits(ZSL_MES_TYPE_TEMPERATURE, 0,
+						  0),
+			       mes_route_test_fn, &id[3]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_route_sub(&r, 0, 0, mes_route_test_fn, &id[4]);
+	zassert_true(rc == 0, NULL);
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.filter.base_type = ZSL_MES_TYPE_LIGHT;
+	mes.header.filter.ext_type = 3;
+	mes.header.filter.flags.encoding = ZSL_MES_ENCODING_BASE64;
+
+	mes_route_test_n = 0;
+	n = zsl_mes_route(&r, &mes);
+	zassert_true(n == 4, NULL);
+	zassert_true(mes_route_test_n == 4, NULL);
+	zassert_true(mes_route_test_log[0] == 0, NULL);
+	zassert_true(mes_route_test_log[1] == 1, NULL);
+	zassert_true(mes_route_test_log[2] == 2, NULL);
+	zassert_true(mes_route_test_log[3] == 4, NULL);
+
+	mes.header.filter.base_type = ZSL_MES_TYPE_TEMPERATURE;
+	mes_route_test_n = 0;
+	n = zsl_mes_route(&r, &mes);
+	zassert_true(n == 2, NULL);
+	zassert_true(mes_route_test_log[0] == 3, NULL);
+	zassert_true(mes_route_test_log[1] == 4, NULL);
+
+	/* Out of subscriptions. */
+	rc = zsl_mes_route_sub(&r, 0, 0, mes_route_test_fn, &id[5]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_route_sub(&r, 0, 0, mes_route_test_fn, &id[5]);
+	zassert_true(rc == -ENOMEM, NULL);
+}
+
+void test_mes_route_full(void)
+{
+	int rc;
+	int id = 0;
+	uint32_t base = zsl_mes_route_bits(0xFF, 0, 0);
+
+	ZSL_MES_ROUTE_DEF(r, 16, 2);
+
+	/* A hash table of 4 holds 3 keys. */
+	for (uint8_t t = 1; t <= 3; t++) {
+		rc = zsl_mes_route_sub(&r, base, zsl_mes_route_bits(t, 0, 0),
+				       mes_route_test_fn, &id);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_mes_route_sub(&r, base, zsl_mes_route_bits(4, 0, 0),
+			       mes_route_test_fn, &id);
+	zassert_true(rc == -ENOMEM, NULL);
+
+	/* But more subscribers to an existing key fit. */
+	rc = zsl_mes_route_sub(&r, base, zsl_mes_route_bits(2, 0, 0),
+			       mes_route_test_fn, &id);
+	zassert_true(rc == 0, NULL);
+}
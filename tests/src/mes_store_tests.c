@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/store.h>
+
+void test_mes_store_add_find(void)
+{
+	int rc;
+	uint64_t ts;
+	uint32_t v;
+	uint8_t big[9];
+	struct zsl_measurement mes, out;
+
+	ZSL_MES_STORE_DEF(s, 4, 8);
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_U32;
+	mes.header.srclen.len = sizeof(v);
+	mes.payload = &v;
+
+	zassert_true(zsl_mes_store_find(&s, 0) == 0, NULL);
+
+	/* Timestamps 10, 20, ..., 60 in a store of 4, which wraps around. */
+	for (v = 1; v <= 6; v++) {
+		rc = zsl_mes_store_add(&s, &mes, 10 * v);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(s.count == 4, NULL);
+
+	rc = zsl_mes_store_get(&s, 0, &out, &ts);
+	zassert_true(rc == 0, NULL);
+	zassert_true(ts == 30, NULL);
+	zassert_true(*(uint32_t *)out.payload == 3, NULL);
+	zassert_true(out.header.unit.ctype == ZSL_MES_UNIT_CTYPE_U32, NULL);
+	rc = zsl_mes_store_get(&s, 3, &out, &ts);
+	zassert_true(rc == 0, NULL);
+	zassert_true(ts == 60, NULL);
+	zassert_true(*(uint32_t *)out.payload == 6, NULL);
+	rc = zsl_mes_store_get(&s, 4, &out, &ts);
+	zassert_true(rc == -EINVAL, NULL);
+
+	zassert_true(zsl_mes_store_find(&s, 0) == 0, NULL);
+	zassert_true(zsl_mes_store_find(&s, 30) == 0, NULL);
+	zassert_true(zsl_mes_store_find(&s, 31) == 1, NULL);
+	zassert_true(zsl_mes_store_find(&s, 50) == 2, NULL);
+	zassert_true(zsl_mes_store_find(&s, 61) == 4, NULL);
+
+	/* Out of order timestamps and large payloads. */
+	rc = zsl_mes_store_add(&s, &mes, 59);
+	zassert_true(rc == -EINVAL, NULL);
+	mes.header.srclen.len = sizeof(big);
+	mes.payload = big;
+	rc = zsl_mes_store_add(&s, &mes, 70);
+	zassert_true(rc == -ENOMEM, NULL);
+
+	/* Forwarded entries are dropped from the start. */
+	zsl_mes_store_drop(&s, 3);
+	zassert_true(s.count == 1, NULL);
+	rc = zsl_mes_store_get(&s, 0, &out, &ts);
+	zassert_true(rc == 0, NULL);
+	zassert_true(ts == 60, NULL);
+	zsl_mes_store_drop(&s, 5);
+	zassert_true(s.count == 0, NULL);
+}
+
+void test_mes_store_iter(void)
+{
+	int rc;
+	int n;
+	uint64_t ts;
+	uint16_t v;
+	uint64_t exp[4] = { 20, 45, 70, 95 };
+	struct zsl_measurement mes, out;
+	struct zsl_mes_store_iter it;
+
+	ZSL_MES_STORE_DEF(s, 32, 2);
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_U16;
+	mes.header.srclen.len = sizeof(v);
+	mes.payload = &v;
+
+	/* Timestamps 0, 5, ..., 155. */
+	for (v = 0; v < 32; v++) {
+		rc = zsl_mes_store_add(&s, &mes, 5 * v);
+		zassert_true(rc == 0, NULL);
+	}
+
+	/* Every entry from 18 to 42. */
+	n = 0;
+	zsl_mes_store_iter_init(&it, &s, 18, 42, 0);
+	while (zsl_mes_store_iter_next(&it, &out, &ts) == 0) {
+		zassert_true(ts == (uint64_t)(20 + 5 * n), NULL);
+		zassert_true(*(uint16_t *)out.payload == 4 + n, NULL);
+		n++;
+	}
+	zassert_true(n == 5, NULL);
+
+	/* One entry per 23 time units from 18 to 100. */
+	n = 0;
+	zsl_mes_store_iter_init(&it, &s, 18, 100, 23);
+	while (zsl_mes_store_iter_next(&it, &out, &ts) == 0) {
+		zassert_true(n < 4, NULL);
+		zassert_true(ts == exp[n], NULL);
+		n++;
+	}
+	zassert_true(n == 4, NULL);
+
+	/* The whole store, and an empty range. */
+	n = 0;
+	zsl_mes_store_iter_init(&it, &s, 0, UINT64_MAX, 0);
+	while (zsl_mes_store_iter_next(&it, &out, NULL) == 0) {
+		n++;
+	}
+	zassert_true(n == 32, NULL);
+	zsl_mes_store_iter_init(&it, &s, 156, 200, 0);
+	rc = zsl_mes_store_iter_next(&it, &out, &ts);
+	zassert_true(rc == -ENODATA, NULL);
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/text.h>
+
+void test_mes_text_b64(void)
+{
+	int rc;
+	size_t len;
+	uint8_t buf[16];
+	/* RFC 4648 test vectors. */
+	const char *in[7] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+	const char *exp[7] = {
+		"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"
+	};
+
+	for (int i = 0; i < 7; i++) {
+		/* In place, both ways. */
+		memcpy(buf, in[i], strlen(in[i]));
+		rc = zsl_mes_b64_enc(buf, strlen(in[i]), buf, sizeof(buf),
+				     &len);
+		zassert_true(rc == 0, NULL);
+		zassert_true(len == strlen(exp[i]), NULL);
+		zassert_true(memcmp(buf, exp[i], len) == 0, NULL);
+
+		rc = zsl_mes_b64_dec(buf, len, buf, sizeof(buf), &len);
+		zassert_true(rc == 0, NULL);
+		zassert_true(len == strlen(in[i]), NULL);
+		zassert_true(memcmp(buf, in[i], len) == 0, NULL);
+	}
+
+	/* Unpadded input. */
+	rc = zsl_mes_b64_dec((const uint8_t *)"Zm9vYmE", 7, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len == 5, NULL);
+	zassert_true(memcmp(buf, "fooba", 5) == 0, NULL);
+
+	/* Invalid characters and lengths, and small outputs. */
+	rc = zsl_mes_b64_dec((const uint8_t *)"Zm9v-mFy", 8, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b64_dec((const uint8_t *)"Zm=v", 4, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b64_dec((const uint8_t *)"Zm9vY", 5, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b64_dec((const uint8_t *)"Zm9vYmFy", 8, buf, 5, &len);
+	zassert_true(rc == -ENOMEM, NULL);
+	rc = zsl_mes_b64_enc((const uint8_t *)"foob", 4, buf, 7, &len);
+	zassert_true(rc == -ENOMEM, NULL);
+}
+
+void test_mes_text_b45(void)
+{
+	int rc;
+	size_t len;
+	uint8_t buf[16];
+	/* RFC 9285 test vectors. */
+	const char *in[4] = { "AB", "Hello!!", "base-45", "ietf!" };
+	const char *exp[4] = {
+		"BB8", "%69 VD92EX0", "UJCLQE7W581", "QED8WEX0"
+	};
+
+	for (int i = 0; i < 4; i++) {
+		memcpy(buf, in[i], strlen(in[i]));
+		rc = zsl_mes_b45_enc(buf, strlen(in[i]), buf, sizeof(buf),
+				     &len);
+		zassert_true(rc == 0, NULL);
+		zassert_true(len == strlen(exp[i]), NULL);
+		zassert_true(memcmp(buf, exp[i], len) == 0, NULL);
+
+		rc = zsl_mes_b45_dec(buf, len, buf, sizeof(buf), &len);
+		zassert_true(rc == 0, NULL);
+		zassert_true(len == strlen(in[i]), NULL);
+		zassert_true(memcmp(buf, in[i], len) == 0, NULL);
+	}
+
+	/* Out of range groups, invalid characters and lengths. */
+	rc = zsl_mes_b45_dec((const uint8_t *)"GGW", 3, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b45_dec((const uint8_t *)"::", 2, buf, sizeof(buf), &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b45_dec((const uint8_t *)"bB8", 3, buf, sizeof(buf), &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b45_dec((const uint8_t *)"BB8B", 4, buf, sizeof(buf),
+			     &len);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_mes_b45_enc((const uint8_t *)"AB", 2, buf, 2, &len);
+	zassert_true(rc == -ENOMEM, NULL);
+}
+
+void test_mes_text_mes(void)
+{
+	int rc;
+	uint8_t buf[32];
+	int32_t v[3] = { -1, 100000, 7 };
+	struct zsl_measurement mes;
+
+	memset(&mes, 0, sizeof(mes));
+	mes.header.unit.ctype = ZSL_MES_UNIT_CTYPE_S32;
+	mes.header.srclen.len = sizeof(v);
+	mes.payload = buf;
+	memcpy(buf, v, sizeof(v));
+
+	for (uint8_t enc = ZSL_MES_ENCODING_BASE64;
+	     enc <= ZSL_MES_ENCODING_BASE45; enc++) {
+		rc = zsl_mes_text_enc(&mes, enc, sizeof(buf));
+		zassert_true(rc == 0, NULL);
+		zassert_true(mes.header.filter.flags.encoding == enc, NULL);
+		zassert_true(mes.header.srclen.len ==
+			     (enc == ZSL_MES_ENCODING_BASE64 ? 16 : 18), NULL);
+
+		/* Already encoded. */
+		rc = zsl_mes_text_enc(&mes, enc, sizeof(buf));
+		zassert_true(rc == -EINVAL, NULL);
+
+		rc = zsl_mes_text_dec(&mes);
+		zassert_true(rc == 0, NULL);
+		zassert_true(mes.header.filter.flags.encoding ==
+			     ZSL_MES_ENCODING_NONE, NULL);
+		zassert_true(mes.header.srclen.len == sizeof(v), NULL);
+		zassert_true(memcmp(buf, v, sizeof(v)) == 0, NULL);
+	}
+
+	/* Too small a buffer leaves the measurement unchanged. */
+	rc = zsl_mes_text_enc(&mes, ZSL_MES_ENCODING_BASE64, 15);
+	zassert_true(rc == -ENOMEM, NULL);
+	zassert_true(mes.header.srclen.len == sizeof(v), NULL);
+	zassert_true(memcmp(buf, v, sizeof(v)) == 0, NULL);
+	rc = zsl_mes_text_enc(&mes, 3, sizeof(buf));
+	zassert_true(rc == -EINVAL, NULL);
+}
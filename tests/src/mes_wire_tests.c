@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2021 Linaro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/measurement/wire.h>
+
+static void
+mes_wire_test_hdr(struct zsl_mes_header *hdr)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->filter.base_type = ZSL_MES_TYPE_TEMPERATURE;
+	hdr->filter.ext_type = 0x12;
+	hdr->filter.flags.timestamp = ZSL_MES_TIMESTAMP_EPOCH_32;
+	hdr->unit.si_unit = 0x1234;
+	hdr->unit.ctype = ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32;
+	hdr->unit.scale_factor = -3;
+	hdr->srclen.len = 8;
+	hdr->srclen.fragment = ZSL_MES_FRAGMENT_FINAL;
+	hdr->srclen.samples = 1;
+	hdr->srclen.sourceid = 0xA5;
+}
+
+void test_mes_wire_hdr(void)
+{
+	uint8_t buf[ZSL_MES_WIRE_HDR_LEN];
+	struct zsl_mes_header hdr, out;
+
+	mes_wire_test_hdr(&hdr);
+	zsl_mes_wire_hdr_pack(&hdr, buf);
+
+	/* The wire layout doesn't depend on the host byte order. */
+	zassert_true(buf[0] == ZSL_MES_TYPE_TEMPERATURE, NULL);
+	zassert_true(buf[1] == 0x12, NULL);
+	zassert_true(buf[2] == (hdr.filter.flags_bits & 0xFF), NULL);
+	zassert_true(buf[3] == (hdr.filter.flags_bits >> 8), NULL);
+	zassert_true(buf[4] == 0x34, NULL);
+	zassert_true(buf[5] == 0x12, NULL);
+	zassert_true(buf[6] == ZSL_MES_UNIT_CTYPE_IEEE754_FLOAT32, NULL);
+	zassert_true(buf[7] == 0xFD, NULL);
+	zassert_true(buf[8] == 8, NULL);
+	zassert_true(buf[9] == 0, NULL);
+	zassert_true(buf[10] == 0x12, NULL);
+	zassert_true(buf[11] == 0xA5, NULL);
+
+	memset(&out, 0, sizeof(out));
+	zsl_mes_wire_hdr_unpack(buf, &out);
+	zassert_true(out.filter_bits == hdr.filter_bits, NULL);
+	zassert_true(out.unit_bits == hdr.unit_bits, NULL);
+	zassert_true(out.srclen_bits == hdr.srclen_bits, NULL);
+}
+
+void test_mes_wire_enc_dec(void)
+{
+	int rc;
+	size_t len, used;
+	uint8_t buf[64];
+	float val[2] = { 21.5f, -3.25f };
+	struct zsl_measurement mes, out;
+
+	mes_wire_test_hdr(&mes.header);
+	mes.payload = val;
+
+	rc = zsl_mes_wire_enc(&mes, buf, sizeof(buf), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len == ZSL_MES_WIRE_HDR_LEN + sizeof(val), NULL);
+
+	rc = zsl_mes_wire_dec(buf, len, &out, &used);
+	zassert_true(rc == 0, NULL);
+	zassert_true(used == len, NULL);
+	zassert_true(out.header.srclen.len == sizeof(val), NULL);
+	zassert_true(out.header.unit.scale_factor == -3, NULL);
+
+	/* The payload is decoded in place. */
+	zassert_true(out.payload == buf + ZSL_MES_WIRE_HDR_LEN, NULL);
+	zassert_true(memcmp(out.payload, val, sizeof(val)) == 0, NULL);
+
+	/* Too small a buffer writes nothing. */
+	memset(buf, 0, sizeof(buf));
+	rc = zsl_mes_wire_enc(&mes, buf, len - 1, &len);
+	zassert_true(rc == -ENOMEM, NULL);
+	zassert_true(buf[0] == 0, NULL);
+
+	/* A truncated stream or set reserved bits fail to decode. */
+	rc = zsl_mes_wire_enc(&mes, buf, sizeof(buf), &len);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_mes_wire_dec(buf, len - 1, &out, &used);
+	zassert_true(rc == -ENOMEM, NULL);
+	rc = zsl_mes_wire_dec(buf, ZSL_MES_WIRE_HDR_LEN - 1, &out, &used);
+	zassert_true(rc == -ENOMEM, NULL);
+	buf[10] |= 0x4;
+	rc = zsl_mes_wire_dec(buf, len, &out, &used);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+struct mes_wire_test_sink {
+	uint8_t buf[64];
+	size_t len;
+	size_t calls;
+};
+
+static int
+mes_wire_test_write(const void *data, size_t len, void *arg)
+{
+	struct mes_wire_test_sink *s = arg;
+
+	if (len > sizeof(s->buf) - s->len) {
+		return -ENOSPC;
+	}
+	memcpy(s->buf + s->len, data, len);
+	s->len += len;
+	s->calls++;
+
+	return 0;
+}
+
+void test_mes_wire_encv(void)
+{
+	int rc;
+	size_t len, used;
+	uint8_t buf[64];
+	uint16_t a[3] = { 1, 2, 3 };
+	uint16_t b[2] = { 4, 5 };
+	uint16_t all[5] = { 1, 2, 3, 4, 5 };
+	struct zsl_mes_header hdr;
+	struct zsl_measurement out;
+	struct mes_wire_test_sink sink = { .len = 0, .calls = 0 };
+	struct zsl_mes_iov iov[3] = {
+		{ .base = a, .len = sizeof(a) },
+		{ .base = NULL, .len = 0 },
+		{ .base = b, .len = sizeof(b) },
+	};
+
+	mes_wire_test_hdr(&hdr);
+	hdr.unit.ctype = ZSL_MES_UNIT_CTYPE_U16;
+
+	/* The segments are gathered, and the length comes from them. */
+	rc = zsl_mes_wire_encv(&hdr, iov, 3, buf, sizeof(buf), &len);
+	zassert_true(rc == 0, NULL);
+	zassert_true(len == ZSL_MES_WIRE_HDR_LEN + 10, NULL);
+	rc = zsl_mes_wire_dec(buf, len, &out, &used);
+	zassert_true(rc == 0, NULL);
+	zassert_true(out.header.srclen.len == 10, NULL);
+	zassert_true(memcmp(out.payload, all, sizeof(all)) == 0, NULL);
+
+	/* The same bytes through an output function, skipping empty ones. */
+	rc = zsl_mes_wire_write(&hdr, iov, 3, mes_wire_test_write, &sink);
+	zassert_true(rc == 0, NULL);
+	zassert_true(sink.calls == 3, NULL);
+	zassert_true(sink.len == len, NULL);
+	zassert_true(memcmp(sink.buf, buf, len) == 0, NULL);
+
+	/* Errors from the output function are passed back. */
+	sink.len = sizeof(sink.buf) - ZSL_MES_WIRE_HDR_LEN - 2;
+	rc = zsl_mes_wire_write(&hdr, iov, 3, mes_wire_test_write, &sink);
+	zassert_true(rc == -ENOSPC, NULL);
+
+	/* The payload must fit the 16-bit length. */
+	iov[1].base = a;
+	iov[1].len = UINT16_MAX;
+	rc = zsl_mes_wire_encv(&hdr, iov, 3, buf, sizeof(buf), &len);
+	zassert_true(rc == -EINVAL, NULL);
+}
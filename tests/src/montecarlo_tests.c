@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/montecarlo.h>
+#include "floatcheck.h"
+
+/* y = x0 * x1, as for P = V * I. */
+static int mc_product(struct zsl_vec *x, struct zsl_vec *y, void *arg)
+{
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = x[0].data[i] * x[1].data[i];
+	}
+
+	return 0;
+}
+
+/* y = x0, to check the input distributions. */
+static int mc_first(struct zsl_vec *x, struct zsl_vec *y, void *arg)
+{
+	for (size_t i = 0; i < y->sz; i++) {
+		y->data[i] = x[0].data[i];
+	}
+
+	return 0;
+}
+
+static int mc_fail(struct zsl_vec *x, struct zsl_vec *y, void *arg)
+{
+	return -EDOM;
+}
+
+/**
+ * @brief zsl_mc_run unit tests.
+ *
+ * This test propagates known distributions through simple models, and
+ * checks the estimates against the analytic values, that a seed gives
+ * reproducible results, and the error cases.
+ */
+void test_mc_run(void)
+{
+	int rc;
+	zsl_real_t sd;
+	struct zsl_sta_stream y, y2;
+	struct zsl_mc_input in[2] = {
+		{ .dist = ZSL_MC_DIST_NORMAL, .a = 12.0, .b = 0.1 },
+		{ .dist = ZSL_MC_DIST_NORMAL, .a = 2.0, .b = 0.02 },
+	};
+	struct zsl_mc mc = {
+		.fn = mc_product,
+		.in = in,
+		.n_in = 2,
+		.seed = 42,
+		.cost = 1,
+	};
+
+	/* Test 1: For a product, the relative uncertainties add in
+	 * quadrature to first order: 24 * sqrt(0.1/12^2 + 0.01^2). */
+	zsl_sta_stream_init(&y);
+	rc = zsl_mc_run(&mc, 20000, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(y.n, 20000, NULL);
+	zassert_true(val_is_equal(y.mean, 24.0, 0.01), NULL);
+	zsl_sta_stream_sta_dev(&y, &sd);
+	zassert_true(val_is_equal(sd, 24.0 * ZSL_SQRT(0.0001 / 1.44 + 0.0001),
+				   0.01), NULL);
+
+	/* Test 2: The same seed gives exactly the same results. */
+	zsl_sta_stream_init(&y2);
+	rc = zsl_mc_run(&mc, 20000, &y2);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(y2.mean == y.mean, NULL);
+	zassert_true(y2.m2 == y.m2, NULL);
+
+	/* Test 3: Uniform and triangular inputs. */
+	mc.fn = mc_first;
+	mc.n_in = 1;
+	in[0].dist = ZSL_MC_DIST_UNIFORM;
+	in[0].a = 1.0;
+	in[0].b = 3.0;
+	zsl_sta_stream_init(&y);
+	rc = zsl_mc_run(&mc, 20000, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y.mean, 2.0, 0.02), NULL);
+	zassert_true(y.min >= 1.0 && y.max <= 3.0, NULL);
+	zsl_sta_stream_sta_dev(&y, &sd);
+	zassert_true(val_is_equal(sd, 2.0 / ZSL_SQRT(12.0), 0.01), NULL);
+
+	in[0].dist = ZSL_MC_DIST_TRIANGULAR;
+	zsl_sta_stream_init(&y);
+	rc = zsl_mc_run(&mc, 20000, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y.mean, 2.0, 0.02), NULL);
+	zsl_sta_stream_sta_dev(&y, &sd);
+	zassert_true(val_is_equal(sd, 2.0 / ZSL_SQRT(24.0), 0.01), NULL);
+
+	/* Test 4: Fewer samples than parts. */
+	in[0].dist = ZSL_MC_DIST_FIXED;
+	zsl_sta_stream_init(&y);
+	rc = zsl_mc_run(&mc, 3, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(y.n, 3, NULL);
+	zassert_true(val_is_equal(y.mean, 1.0, 1E-6), NULL);
+
+	/* Test 5: Invalid runs, and model errors, leave 'y' unchanged. */
+	in[0].dist = ZSL_MC_DIST_UNIFORM;
+	in[0].b = 0.0;
+	rc = zsl_mc_run(&mc, 10, &y);
+	zassert_equal(rc, -EINVAL, NULL);
+	in[0].b = 3.0;
+	rc = zsl_mc_run(&mc, 0, &y);
+	zassert_equal(rc, -EINVAL, NULL);
+	mc.fn = mc_fail;
+	rc = zsl_mc_run(&mc, 10, &y);
+	zassert_equal(rc, -EDOM, NULL);
+	zassert_equal(y.n, 3, NULL);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/ode.h>
+#include "floatcheck.h"
+
+/* y' = -y, counting the calls in 'arg'. */
+static int ode_decay(zsl_real_t t, struct zsl_vec *y, struct zsl_vec *dydt,
+		     void *arg)
+{
+	size_t *calls = arg;
+
+	(*calls)++;
+	dydt->data[0] = -y->data[0];
+
+	return 0;
+}
+
+/* Harmonic oscillator, x' = v, v' = -x. */
+static int ode_sho(zsl_real_t t, struct zsl_vec *y, struct zsl_vec *dydt,
+		   void *arg)
+{
+	dydt->data[0] = y->data[1];
+	dydt->data[1] = -y->data[0];
+
+	return 0;
+}
+
+static int ode_fail(zsl_real_t t, struct zsl_vec *y, struct zsl_vec *dydt,
+		    void *arg)
+{
+	return -EDOM;
+}
+
+/* Nonlinear pendulum, x'' = -sin(x). */
+static int ode_pendulum(zsl_real_t t, struct zsl_vec *x, struct zsl_vec *a,
+			void *arg)
+{
+	a->data[0] = -ZSL_SIN(x->data[0]);
+
+	return 0;
+}
+
+void test_ode_rk4(void)
+{
+	int rc;
+	size_t calls = 0;
+	zsl_real_t t = 0.0;
+
+	ZSL_VECTOR_DEF(y, 1);
+	ZSL_VECTOR_DEF(y2, 2);
+
+	/* Exponential decay, four calls per step. */
+	y.data[0] = 1.0;
+	rc = zsl_ode_rk4(ode_decay, &calls, &t, 0.1, 10, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(t, 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(y.data[0], ZSL_EXP(-1.0), 1E-5), NULL);
+	zassert_equal(calls, 40, NULL);
+
+	/* A quarter period of the harmonic oscillator. */
+	t = 0.0;
+	y2.data[0] = 1.0;
+	y2.data[1] = 0.0;
+	rc = zsl_ode_rk4(ode_sho, NULL, &t, ZSL_PI / 200.0, 100, &y2);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y2.data[0], 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(y2.data[1], -1.0, 1E-5), NULL);
+
+	/* Errors from the derivative function are returned. */
+	rc = zsl_ode_rk4(ode_fail, NULL, &t, 0.1, 10, &y);
+	zassert_equal(rc, -EDOM, NULL);
+}
+
+void test_ode_rk45(void)
+{
+	int rc;
+	size_t calls = 0;
+	zsl_real_t t = 0.0;
+	zsl_real_t h = 0.01;
+
+	ZSL_VECTOR_DEF(y, 1);
+	ZSL_VECTOR_DEF(y2, 2);
+
+	/* Lands exactly on t_end, with far fewer calls than a fixed step. */
+	y.data[0] = 1.0;
+	rc = zsl_ode_rk45(ode_decay, &calls, &t, 2.0, &h, 1E-6, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(t == 2.0, NULL);
+	zassert_true(val_is_equal(y.data[0], ZSL_EXP(-2.0), 1E-5), NULL);
+	zassert_true(h > 0.01, NULL);
+	zassert_true(calls < 200, NULL);
+
+	/* And back again. */
+	rc = zsl_ode_rk45(ode_decay, &calls, &t, 0.0, &h, 1E-6, &y);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(t == 0.0, NULL);
+	zassert_true(val_is_equal(y.data[0], 1.0, 1E-4), NULL);
+
+	/* A full period of the harmonic oscillator. */
+	t = 0.0;
+	h = 0.1;
+	y2.data[0] = 1.0;
+	y2.data[1] = 0.0;
+	rc = zsl_ode_rk45(ode_sho, NULL, &t, 2.0 * ZSL_PI, &h, 1E-6, &y2);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(y2.data[0], 1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(y2.data[1], 0.0, 1E-4), NULL);
+
+	/* Invalid arguments, and errors from the derivative function. */
+	h = 0.0;
+	rc = zsl_ode_rk45(ode_sho, NULL, &t, 1.0, &h, 1E-6, &y2);
+	zassert_equal(rc, -EINVAL, NULL);
+	h = 0.1;
+	rc = zsl_ode_rk45(ode_sho, NULL, &t, 1.0, &h, 0.0, &y2);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_ode_rk45(ode_fail, NULL, &t, 1.0, &h, 1E-6, &y2);
+	zassert_equal(rc, -EDOM, NULL);
+}
+
+void test_ode_verlet(void)
+{
+	int rc;
+	zsl_real_t t = 0.0;
+	zsl_real_t e0, e;
+
+	ZSL_VECTOR_DEF(x, 1);
+	ZSL_VECTOR_DEF(v, 1);
+	ZSL_VECTOR_DEF(a, 1);
+	ZSL_VECTOR_DEF(ax, 2);
+
+	/* A large swing, where the energy must stay bounded. */
+	x.data[0] = 2.0;
+	v.data[0] = 0.0;
+	ode_pendulum(t, &x, &a, NULL);
+	e0 = 0.5 * v.data[0] * v.data[0] - ZSL_COS(x.data[0]);
+
+	for (size_t n = 0; n < 20; n++) {
+		rc = zsl_ode_verlet(ode_pendulum, NULL, &t, 0.01, 500, &x, &v,
+				    &a);
+		zassert_equal(rc, 0, NULL);
+		e = 0.5 * v.data[0] * v.data[0] - ZSL_COS(x.data[0]);
+		zassert_true(val_is_equal(e, e0, 1E-4), NULL);
+	}
+	zassert_true(val_is_equal(t, 100.0, 1E-3), NULL);
+
+	/* Mismatched sizes. */
+	rc = zsl_ode_verlet(ode_pendulum, NULL, &t, 0.01, 1, &x, &v, &ax);
+	zassert_equal(rc, -EINVAL, NULL);
+}
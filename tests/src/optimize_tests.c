@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/optimize.h>
+#include "floatcheck.h"
+
+/* Samples of y = 5 * e^(-0.7 * t) + 1, at t = 0..9. */
+static zsl_real_t opt_decay_y[10];
+
+/* r_i = a * e^(-b * t_i) + c - y_i, for p = { a, b, c }. */
+static int opt_decay(const struct zsl_vec *p, struct zsl_vec *r,
+		     struct zsl_mtx *j, void *arg)
+{
+	zsl_real_t *y = arg;
+	zsl_real_t e;
+
+	for (size_t i = 0; i < r->sz; i++) {
+		e = ZSL_EXP(-p->data[1] * i);
+		r->data[i] = p->data[0] * e + p->data[2] - y[i];
+		if (j != NULL) {
+			j->data[i * 3] = e;
+			j->data[i * 3 + 1] = -p->data[0] * i * e;
+			j->data[i * 3 + 2] = 1.0;
+		}
+	}
+
+	return 0;
+}
+
+/* The Rosenbrock function as residuals: r = { 10 * (y - x^2), 1 - x }. */
+static int opt_rosen(const struct zsl_vec *p, struct zsl_vec *r,
+		     struct zsl_mtx *j, void *arg)
+{
+	r->data[0] = 10.0 * (p->data[1] - p->data[0] * p->data[0]);
+	r->data[1] = 1.0 - p->data[0];
+	if (j != NULL) {
+		j->data[0] = -20.0 * p->data[0];
+		j->data[1] = 10.0;
+		j->data[2] = -1.0;
+		j->data[3] = 0.0;
+	}
+
+	return 0;
+}
+
+static int opt_fail(const struct zsl_vec *p, struct zsl_vec *r,
+		    struct zsl_mtx *j, void *arg)
+{
+	return -EIO;
+}
+
+/**
+ * @brief zsl_opt_lm unit tests.
+ *
+ * This test fits an exponential decay to exact samples, and minimizes the
+ * Rosenbrock function from its usual starting point.
+ */
+void test_opt_lm(void)
+{
+	int rc;
+	struct zsl_opt_res res;
+	struct zsl_opt_lm lm = {
+		.fn = opt_decay,
+		.arg = opt_decay_y,
+		.m = 10,
+		.max_iter = 100,
+		.tol_grad = 1E-6,
+		.tol_step = 1E-6,
+		.lambda = 1E-3,
+	};
+
+	ZSL_VECTOR_DEF(p, 3);
+
+	for (size_t i = 0; i < 10; i++) {
+		opt_decay_y[i] = 5.0 * ZSL_EXP(-0.7 * i) + 1.0;
+	}
+
+	p.data[0] = 1.0;
+	p.data[1] = 0.1;
+	p.data[2] = 0.0;
+	rc = zsl_opt_lm(&lm, &p, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(p.data[0], 5.0, 1E-3), NULL);
+	zassert_true(val_is_equal(p.data[1], 0.7, 1E-3), NULL);
+	zassert_true(val_is_equal(p.data[2], 1.0, 1E-3), NULL);
+	zassert_true(val_is_equal(res.f, 0.0, 1E-6), NULL);
+	zassert_true(res.iter > 0, NULL);
+	zassert_true(res.evals <= 2 * res.iter + 1, NULL);
+
+	/* The curved valley of the Rosenbrock function needs damping. */
+	lm.fn = opt_rosen;
+	lm.arg = NULL;
+	lm.m = 2;
+	p.sz = 2;
+	p.data[0] = -1.2;
+	p.data[1] = 1.0;
+	rc = zsl_opt_lm(&lm, &p, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(p.data[0], 1.0, 1E-3), NULL);
+	zassert_true(val_is_equal(p.data[1], 1.0, 1E-3), NULL);
+}
+
+/**
+ * @brief zsl_opt_lm_ws unit tests.
+ *
+ * This test checks Gauss-Newton steps, the iteration limit, the workspace
+ * size and the error codes.
+ */
+void test_opt_lm_ws(void)
+{
+	int rc;
+	struct zsl_opt_res res;
+	struct zsl_opt_lm lm = {
+		.fn = opt_decay,
+		.arg = opt_decay_y,
+		.m = 10,
+		.max_iter = 100,
+		.tol_grad = 1E-6,
+		.tol_step = 1E-6,
+		.lambda = 0.0,
+	};
+
+	ZSL_VECTOR_DEF(p, 3);
+	ZSL_WORKSPACE_DEF(ws, 128);
+	ZSL_WORKSPACE_DEF(small, 64);
+
+	zassert_true(zsl_opt_lm_ws_sz(10, 3) <= 128, NULL);
+	zassert_true(zsl_opt_lm_ws_sz(10, 3) > 64, NULL);
+
+	for (size_t i = 0; i < 10; i++) {
+		opt_decay_y[i] = 5.0 * ZSL_EXP(-0.7 * i) + 1.0;
+	}
+
+	/* Undamped Gauss-Newton steps, from close to the solution. */
+	p.data[0] = 4.5;
+	p.data[1] = 0.6;
+	p.data[2] = 1.2;
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(p.data[0], 5.0, 1E-3), NULL);
+	zassert_true(val_is_equal(p.data[1], 0.7, 1E-3), NULL);
+	zassert_true(val_is_equal(p.data[2], 1.0, 1E-3), NULL);
+	zassert_true(res.iter < 10, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* Stopping at the iteration limit keeps the best parameters. */
+	lm.max_iter = 1;
+	p.data[0] = 1.0;
+	p.data[1] = 0.1;
+	p.data[2] = 0.0;
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &ws);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(res.iter, 1, NULL);
+	zassert_true(res.f > 0.0, NULL);
+
+	/* Error codes. */
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(small.used, 0, NULL);
+
+	lm.m = 2;
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	lm.m = 10;
+	lm.max_iter = 0;
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	lm.max_iter = 10;
+	lm.fn = opt_fail;
+	rc = zsl_opt_lm_ws(&lm, &p, &res, &ws);
+	zassert_equal(rc, -EIO, NULL);
+	zassert_equal(ws.used, 0, NULL);
+}
+
+/* f = (x - 2)^2 + 1. */
+static int opt_parab(zsl_real_t x, zsl_real_t *f, void *arg)
+{
+	*f = (x - 2.0) * (x - 2.0) + 1.0;
+
+	return 0;
+}
+
+static int opt_cos(zsl_real_t x, zsl_real_t *f, void *arg)
+{
+	*f = ZSL_COS(x);
+
+	return 0;
+}
+
+/* The Rosenbrock function, f = 100 * (y - x^2)^2 + (1 - x)^2. */
+static int opt_rosen_f(const struct zsl_vec *x, zsl_real_t *f,
+		       struct zsl_vec *g, void *arg)
+{
+	zsl_real_t a = x->data[1] - x->data[0] * x->data[0];
+	zsl_real_t b = 1.0 - x->data[0];
+
+	*f = 100.0 * a * a + b * b;
+	if (g != NULL) {
+		g->data[0] = -400.0 * x->data[0] * a - 2.0 * b;
+		g->data[1] = 200.0 * a;
+	}
+
+	return 0;
+}
+
+/* f = sum((i + 1) * (x_i - i)^2), with its minimum at x_i = i. */
+static int opt_bowl(const struct zsl_vec *x, zsl_real_t *f,
+		    struct zsl_vec *g, void *arg)
+{
+	*f = 0.0;
+	for (size_t i = 0; i < x->sz; i++) {
+		*f += (i + 1) * (x->data[i] - i) * (x->data[i] - i);
+		if (g != NULL) {
+			g->data[i] = 2.0 * (i + 1) * (x->data[i] - i);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief zsl_opt_brent unit tests.
+ *
+ * This test finds the minimum of a parabola and of cos(x), and checks the
+ * evaluation budget and error codes.
+ */
+void test_opt_brent(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_opt_res res;
+
+	rc = zsl_opt_brent(opt_parab, NULL, 0.0, 5.0, 1E-5, 50, &x, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 2.0, 1E-3), NULL);
+	zassert_true(val_is_equal(res.f, 1.0, 1E-5), NULL);
+	zassert_true(res.evals <= 50, NULL);
+
+	rc = zsl_opt_brent(opt_cos, NULL, 2.0, 4.0, 1E-5, 50, &x, NULL);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, ZSL_PI, 1E-3), NULL);
+
+	/* The budget bounds the number of calls. */
+	rc = zsl_opt_brent(opt_cos, NULL, 2.0, 4.0, 1E-5, 3, &x, &res);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(res.evals, 3, NULL);
+
+	rc = zsl_opt_brent(opt_cos, NULL, 4.0, 2.0, 1E-5, 50, &x, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_opt_brent(opt_cos, NULL, 2.0, 4.0, 0.0, 50, &x, NULL);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_opt_nm unit tests.
+ *
+ * This test minimizes the Rosenbrock function and a quadratic bowl, and
+ * checks the evaluation budget and error codes.
+ */
+void test_opt_nm(void)
+{
+	int rc;
+	struct zsl_opt_res res;
+	struct zsl_opt_min min = {
+		.fn = opt_rosen_f,
+		.max_evals = 1000,
+		.tol = 1E-6,
+		.step = 0.5,
+	};
+
+	ZSL_VECTOR_DEF(x, 4);
+	ZSL_WORKSPACE_DEF(ws, 64);
+
+	x.sz = 2;
+	x.data[0] = -1.2;
+	x.data[1] = 1.0;
+	rc = zsl_opt_nm(&min, &x, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 1.0, 1E-2), NULL);
+	zassert_true(val_is_equal(x.data[1], 1.0, 1E-2), NULL);
+	zassert_true(res.evals <= 1000, NULL);
+
+	/* A default initial simplex around the origin. */
+	min.fn = opt_bowl;
+	min.step = 0.0;
+	x.sz = 4;
+	zsl_vec_init(&x);
+	rc = zsl_opt_nm_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(x.data[i], i, 1E-2), NULL);
+	}
+	zassert_equal(ws.used, 0, NULL);
+
+	/* The budget bounds the number of calls, and keeps the best point. */
+	min.max_evals = 20;
+	zsl_vec_init(&x);
+	rc = zsl_opt_nm_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(res.evals, 20, NULL);
+	zassert_true(res.f < 50.0, NULL);
+
+	min.max_evals = 4;
+	rc = zsl_opt_nm_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_opt_lbfgs unit tests.
+ *
+ * This test minimizes the Rosenbrock function and a quadratic bowl, and
+ * checks the evaluation budget and error codes.
+ */
+void test_opt_lbfgs(void)
+{
+	int rc;
+	struct zsl_opt_res res;
+	struct zsl_opt_min min = {
+		.fn = opt_rosen_f,
+		.max_evals = 500,
+		.tol = 1E-3,
+		.hist = 5,
+	};
+
+	ZSL_VECTOR_DEF(x, 4);
+	ZSL_WORKSPACE_DEF(ws, 64);
+	ZSL_WORKSPACE_DEF(small, 16);
+
+	x.sz = 2;
+	x.data[0] = -1.2;
+	x.data[1] = 1.0;
+	rc = zsl_opt_lbfgs(&min, &x, &res);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x.data[0], 1.0, 1E-2), NULL);
+	zassert_true(val_is_equal(x.data[1], 1.0, 1E-2), NULL);
+	zassert_true(res.evals <= 500, NULL);
+
+	/* A quadratic is minimized in a few iterations. */
+	min.fn = opt_bowl;
+	min.hist = 3;
+	x.sz = 4;
+	zsl_vec_init(&x);
+	rc = zsl_opt_lbfgs_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(x.data[i], i, 1E-3), NULL);
+	}
+	zassert_true(res.iter < 20, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* The budget bounds the number of calls. */
+	min.max_evals = 3;
+	zsl_vec_init(&x);
+	rc = zsl_opt_lbfgs_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+	zassert_equal(res.evals, 3, NULL);
+
+	/* Error codes. */
+	rc = zsl_opt_lbfgs_ws(&min, &x, &res, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	min.hist = 0;
+	rc = zsl_opt_lbfgs_ws(&min, &x, &res, &ws);
+	zassert_equal(rc, -EINVAL, NULL);
+}
@@ -7,6 +7,7 @@
 #include <ztest.h>
 #include <zsl/zsl.h>
 #include <zsl/orientation/orientation.h>
+#include <zsl/fastmath.h>
 #include "floatcheck.h"
 
 void test_att_to_vec(void)
@@ -78,14 +79,144 @@ void test_att_from_euler(void)
 	zassert_true(val_is_equal(a.yaw, acmp.yaw, 1E-4), NULL);
 }
 
+void test_att_euler_batch(void)
+{
+	int rc;
+	struct zsl_attitude a[3], ar[3];
+	struct zsl_euler e[3], es;
+
+	for (size_t n = 0; n < 3; n++) {
+		a[n].roll = 164.0545819 - 50.0 * n;
+		a[n].pitch = 74.3575337 - 30.0 * n;
+		a[n].yaw = -105.9453765 + 90.0 * n;
+		a[n].status_bits = 0;
+	}
+
+	/* Matches the single conversion, and round trips. */
+	rc = zsl_att_to_euler_batch(a, e, 3);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_att_from_euler_batch(e, ar, 3);
+	zassert_true(rc == 0, NULL);
+	for (size_t n = 0; n < 3; n++) {
+		zsl_att_to_euler(&a[n], &es);
+		for (size_t c = 0; c < 3; c++) {
+			zassert_true(val_is_equal(e[n].idx[c], es.idx[c], 1E-6),
+				     NULL);
+			zassert_true(val_is_equal(ar[n].idx[c], a[n].idx[c],
+						  1E-4), NULL);
+		}
+		zassert_true(ar[n].status_bits == 0, NULL);
+	}
+}
+
+void test_att_from_quat(void)
+{
+	int rc;
+	struct zsl_quat q;
+	struct zsl_euler e;
+	struct zsl_attitude a, ab[4];
+
+	ZSL_QUAT_BATCH_DEF(qb, 4);
+
+	for (size_t n = 0; n < 4; n++) {
+		q.r = 0.9 - 0.2 * n;
+		q.i = 0.1 + 0.1 * n;
+		q.j = -0.3;
+		q.k = 0.2 * n;
+		zsl_quat_to_unit_d(&q);
+		zsl_quat_batch_set(&qb, n, &q);
+	}
+
+	rc = zsl_att_from_quat_batch(&qb, ab);
+	zassert_true(rc == 0, NULL);
+	for (size_t n = 0; n < 4; n++) {
+		zsl_quat_batch_get(&qb, n, &q);
+		zsl_quat_to_euler(&q, &e);
+		rc = zsl_att_from_quat(&q, &a);
+		zassert_true(rc == 0, NULL);
+		for (size_t c = 0; c < 3; c++) {
+			zassert_true(val_is_equal(a.idx[c],
+						  e.idx[c] * ZSL_RAD_TO_DEG,
+						  1E-4), NULL);
+			zassert_true(ab[n].idx[c] == a.idx[c], NULL);
+		}
+		zassert_true(a.status_bits == 0, NULL);
+	}
+}
+
 void test_att_from_accelmag(void)
 {
+	int rc;
+	struct zsl_attitude a;
+	zsl_real_t s, c;
 
+	ZSL_VECTOR_DEF(accel, 3);
+	ZSL_VECTOR_DEF(mag, 3);
+
+	/* Level, with the horizontal field 45 degrees from the x axis. */
+	zsl_vec_init(&accel);
+	accel.data[2] = 9.80665;
+	mag.data[0] = 10.0;
+	mag.data[1] = -10.0;
+	mag.data[2] = -40.0;
+
+	rc = zsl_att_from_accelmag(&accel, &mag, &a);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(a.roll, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.pitch, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.yaw, 45.0, 1E-4), NULL);
+	zassert_true(a.status_bits == 0, NULL);
+
+	/* Rolled 30 degrees, the tilt compensated heading is unchanged. */
+	s = ZSL_SIN(ZSL_PI / 6.0);
+	c = ZSL_COS(ZSL_PI / 6.0);
+	accel.data[1] = 9.80665 * s;
+	accel.data[2] = 9.80665 * c;
+	mag.data[1] = -10.0 * c - 40.0 * s;
+	mag.data[2] = 10.0 * s - 40.0 * c;
+
+	rc = zsl_att_from_accelmag(&accel, &mag, &a);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(a.roll, 30.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.pitch, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.yaw, 45.0, 1E-4), NULL);
 }
 
 void test_att_from_accel(void)
 {
+	int rc;
+	struct zsl_attitude a;
+
+	ZSL_VECTOR_DEF(accel, 3);
 
+	/* Rolled 30 degrees. */
+	zsl_vec_init(&accel);
+	accel.data[1] = 9.80665 * ZSL_SIN(ZSL_PI / 6.0);
+	accel.data[2] = 9.80665 * ZSL_COS(ZSL_PI / 6.0);
+
+	rc = zsl_att_from_accel(&accel, &a);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(a.roll, 30.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.pitch, 0.0, 1E-4), NULL);
+	zassert_true(a.status.yaw_invalid, NULL);
+	zassert_true(!a.status.roll_invalid && !a.status.pitch_invalid, NULL);
+
+	/* Pitched 20 degrees nose up. */
+	accel.data[0] = -9.80665 * ZSL_SIN(ZSL_PI / 9.0);
+	accel.data[1] = 0.0;
+	accel.data[2] = 9.80665 * ZSL_COS(ZSL_PI / 9.0);
+
+	rc = zsl_att_from_accel(&accel, &a);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(a.roll, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(a.pitch, 20.0, 1E-4), NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Only 3-vectors are accepted. */
+	accel.sz = 2;
+	rc = zsl_att_from_accel(&accel, &a);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
 }
 
 void test_eul_to_vec(void)
@@ -232,6 +363,176 @@ void test_quat_mult(void)
 	zassert_true(val_is_equal(qm.k, 1.5, 1E-6), NULL);
 }
 
+void test_quat_batch_mult(void)
+{
+	int rc;
+	struct zsl_quat qa, qb, qm, qt;
+
+	ZSL_QUAT_BATCH_DEF(ba, 6);
+	ZSL_QUAT_BATCH_DEF(bb, 6);
+	ZSL_QUAT_BATCH_DEF(bm, 6);
+	ZSL_QUAT_BATCH_DEF(bx, 5);
+
+	for (size_t b = 0; b < 6; b++) {
+		qa.r = 1.0 - 0.1 * b;
+		qa.i = 0.25 * b;
+		qa.j = 0.5 - 0.2 * b;
+		qa.k = 0.75;
+		qb.r = 0.5;
+		qb.i = -0.3 * b;
+		qb.j = 0.1 * b;
+		qb.k = 1.0 - 0.25 * b;
+		rc = zsl_quat_batch_set(&ba, b, &qa);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_quat_batch_set(&bb, b, &qb);
+		zassert_true(rc == 0, NULL);
+	}
+
+	rc = zsl_quat_batch_mult(&ba, &bb, &bm);
+	zassert_true(rc == 0, NULL);
+
+	/* Each product must match zsl_quat_mult. */
+	for (size_t b = 0; b < 6; b++) {
+		zsl_quat_batch_get(&ba, b, &qa);
+		zsl_quat_batch_get(&bb, b, &qb);
+		zsl_quat_mult(&qa, &qb, &qt);
+		rc = zsl_quat_batch_get(&bm, b, &qm);
+		zassert_true(rc == 0, NULL);
+		for (size_t c = 0; c < 4; c++) {
+			zassert_true(val_is_equal(qm.idx[c], qt.idx[c], 1E-6),
+				     NULL);
+		}
+	}
+
+	/* The batches must be the same size. */
+	rc = zsl_quat_batch_mult(&ba, &bx, &bm);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_quat_batch_get(&ba, 6, &qm);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_quat_mult_alias(void)
+{
+	struct zsl_quat qa = { .r = 1.0, .i = 0.25, .j = 0.5, .k = 0.75 };
+	struct zsl_quat qb = { .r = 0.5, .i = -0.3, .j = 0.1, .k = 1.0 };
+	struct zsl_quat qm, qt;
+
+	zsl_quat_mult(&qa, &qb, &qm);
+
+	/* The output may alias either input. */
+	qt = qa;
+	zsl_quat_mult(&qt, &qb, &qt);
+	for (size_t c = 0; c < 4; c++) {
+		zassert_true(val_is_equal(qt.idx[c], qm.idx[c], 1E-5), NULL);
+	}
+	qt = qb;
+	zsl_quat_mult(&qa, &qt, &qt);
+	for (size_t c = 0; c < 4; c++) {
+		zassert_true(val_is_equal(qt.idx[c], qm.idx[c], 1E-5), NULL);
+	}
+}
+
+void test_quat_to_unit_fast(void)
+{
+	struct zsl_quat q = { .r = 1.0, .i = 0.25, .j = 0.5, .k = 0.75 };
+	struct zsl_quat qn, qf;
+
+	zsl_quat_to_unit(&q, &qn);
+	zsl_quat_to_unit_fast(&q, &qf);
+	for (size_t c = 0; c < 4; c++) {
+		zassert_true(val_is_equal(qf.idx[c], qn.idx[c], 1E-5), NULL);
+	}
+	zassert_true(val_is_equal(zsl_quat_magn(&qf), 1.0, 1E-5), NULL);
+
+	/* In place, over a wide range of magnitudes. */
+	for (zsl_real_t s = 1E-3; s < 1E3; s *= 7.0) {
+		qf = q;
+		zsl_quat_scale_d(&qf, s);
+		zsl_quat_to_unit_fast(&qf, &qf);
+		zassert_true(val_is_equal(zsl_quat_magn(&qf), 1.0, 1E-5), NULL);
+	}
+
+	/* A zero quaternion stays zero. */
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_EMPTY);
+	zsl_quat_to_unit_fast(&q, &qf);
+	zassert_true(qf.r == 0.0 && qf.i == 0.0 && qf.j == 0.0 && qf.k == 0.0,
+		     NULL);
+}
+
+void test_quat_rot_vec(void)
+{
+	int rc;
+	struct zsl_quat q = { .r = 1.0, .i = 0.25, .j = -0.5, .k = 0.75 };
+	struct zsl_quat qv, qc;
+
+	ZSL_MATRIX_DEF(rot, 4, 4);
+	ZSL_MATRIX_DEF(vb, 6, 3);
+	ZSL_MATRIX_DEF(vbr, 6, 3);
+	ZSL_MATRIX_DEF(vbx, 5, 3);
+	ZSL_VECTOR_DEF(v, 3);
+	ZSL_VECTOR_DEF(vr, 3);
+	ZSL_VECTOR_DEF(vx, 4);
+
+	zsl_quat_to_unit_d(&q);
+	zsl_quat_to_rot_mtx(&q, &rot);
+
+	v.data[0] = 0.3;
+	v.data[1] = -1.2;
+	v.data[2] = 9.81;
+
+	/* Matches the rotation matrix. */
+	rc = zsl_quat_rot_vec(&q, &v, &vr);
+	zassert_true(rc == 0, NULL);
+	for (size_t r = 0; r < 3; r++) {
+		zsl_real_t e = 0.0;
+		for (size_t c = 0; c < 3; c++) {
+			e += rot.data[4 * r + c] * v.data[c];
+		}
+		zassert_true(val_is_equal(vr.data[r], e, 1E-5), NULL);
+	}
+
+	/* Matches q * v * q^-1. */
+	qv.r = 0.0;
+	qv.i = v.data[0];
+	qv.j = v.data[1];
+	qv.k = v.data[2];
+	zsl_quat_conj(&q, &qc);
+	zsl_quat_mult(&q, &qv, &qv);
+	zsl_quat_mult(&qv, &qc, &qv);
+	zassert_true(val_is_equal(vr.data[0], qv.i, 1E-5), NULL);
+	zassert_true(val_is_equal(vr.data[1], qv.j, 1E-5), NULL);
+	zassert_true(val_is_equal(vr.data[2], qv.k, 1E-5), NULL);
+
+	/* In place. */
+	rc = zsl_quat_rot_vec(&q, &v, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &vr, 1E-5), NULL);
+
+	/* Batches match the single vector version, also in place. */
+	for (size_t n = 0; n < 6; n++) {
+		vb.data[3 * n] = 0.5 * n;
+		vb.data[3 * n + 1] = 1.0 - 0.3 * n;
+		vb.data[3 * n + 2] = -2.0 + n;
+	}
+	rc = zsl_quat_rot_vec_batch(&q, &vb, &vbr);
+	zassert_true(rc == 0, NULL);
+	for (size_t n = 0; n < 6; n++) {
+		zsl_vec_from_arr(&v, &vb.data[3 * n]);
+		zsl_quat_rot_vec(&q, &v, &vr);
+		zsl_vec_from_arr(&v, &vbr.data[3 * n]);
+		zassert_true(zsl_vec_is_equal(&v, &vr, 1E-5), NULL);
+	}
+	rc = zsl_quat_rot_vec_batch(&q, &vb, &vb);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&vb, &vbr), NULL);
+
+	/* Invalid shapes. */
+	rc = zsl_quat_rot_vec(&q, &vx, &vr);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_quat_rot_vec_batch(&q, &vb, &vbx);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_quat_exp(void)
 {
 	/* TODO: Verify results! */
@@ -357,11 +658,118 @@ void test_quat_slerp(void)
 	zassert_true(val_is_equal(qi.i, qb.i, 1E-6), NULL);
 	zassert_true(val_is_equal(qi.j, qb.j, 1E-6), NULL);
 	zassert_true(val_is_equal(qi.k, qb.k, 1E-6), NULL);
+
+	/* Nearly parallel inputs use nlerp, which should match slerp. */
+	qb.r = ZSL_COS(0.01);
+	qb.i = ZSL_SIN(0.01);
+	rc = zsl_quat_slerp(&qa, &qb, 0.3, &qi);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(qi.r, ZSL_COS(0.003), 1E-6), NULL);
+	zassert_true(val_is_equal(qi.i, ZSL_SIN(0.003), 1E-6), NULL);
+	zassert_true(val_is_equal(qi.j, 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(qi.k, 0.0, 1E-6), NULL);
+}
+
+void test_quat_integrate(void)
+{
+	int rc;
+	struct zsl_quat q = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat qi, qe;
+	struct zsl_quat_integ st;
+
+	ZSL_VECTOR_DEF(w, 3);
+	ZSL_VECTOR_DEF(wx, 4);
+
+	/* 1 rad/s about z for 1 s, with small steps (Taylor path). */
+	w.data[0] = 0.0;
+	w.data[1] = 0.0;
+	w.data[2] = 1.0;
+	qi = q;
+	for (size_t n = 0; n < 1000; n++) {
+		rc = zsl_quat_integrate(&qi, &w, 0.001, &qi);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(val_is_equal(qi.r, ZSL_COS(0.5), 1E-5), NULL);
+	zassert_true(val_is_equal(qi.i, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(qi.j, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(qi.k, ZSL_SIN(0.5), 1E-5), NULL);
+
+	/* The same rotation in a single large step (trig path). */
+	rc = zsl_quat_integrate(&q, &w, 1.0, &qe);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(qi.r, qe.r, 1E-5), NULL);
+	zassert_true(val_is_equal(qi.k, qe.k, 1E-5), NULL);
+
+	/* Body frame rates: 90 degrees about x, then 90 degrees about the
+	 * new y, which is the original z. */
+	w.data[0] = ZSL_PI / 2.0;
+	w.data[1] = 0.0;
+	w.data[2] = 0.0;
+	zsl_quat_integrate(&q, &w, 1.0, &qi);
+	w.data[0] = 0.0;
+	w.data[1] = ZSL_PI / 2.0;
+	zsl_quat_integrate(&qi, &w, 1.0, &qi);
+	qe.r = 0.5;
+	qe.i = 0.5;
+	qe.j = 0.5;
+	qe.k = 0.5;
+	for (size_t c = 0; c < 4; c++) {
+		zassert_true(val_is_equal(qi.idx[c], qe.idx[c], 1E-5), NULL);
+	}
+
+	/* The stepper renormalises periodically. */
+	w.data[0] = 3.0;
+	w.data[1] = -2.0;
+	w.data[2] = 1.0;
+	rc = zsl_quat_integ_init(&st, &q, 100);
+	zassert_true(rc == 0, NULL);
+	for (size_t n = 0; n < 3000; n++) {
+		rc = zsl_quat_integ_step(&st, &w, 1.0 / 3000.0);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(st.count == 0, NULL);
+	zassert_true(val_is_equal(zsl_quat_magn(&st.q), 1.0, 1E-6), NULL);
+
+	/* Invalid angular velocity. */
+	rc = zsl_quat_integrate(&q, &wx, 0.001, &qi);
+	zassert_true(rc == -EINVAL, NULL);
 }
 
 void test_quat_to_euler(void)
 {
-	/* TODO */
+	int rc;
+	struct zsl_quat qx, qy, qz, q;
+	struct zsl_euler e;
+	zsl_real_t roll = 0.3;
+	zsl_real_t pitch = -0.2;
+	zsl_real_t yaw = 1.1;
+
+	/* q = qz(yaw) * qy(pitch) * qx(roll). */
+	zsl_quat_init(&qx, ZSL_QUAT_TYPE_EMPTY);
+	zsl_quat_init(&qy, ZSL_QUAT_TYPE_EMPTY);
+	zsl_quat_init(&qz, ZSL_QUAT_TYPE_EMPTY);
+	qx.r = ZSL_COS(roll / 2.0);
+	qx.i = ZSL_SIN(roll / 2.0);
+	qy.r = ZSL_COS(pitch / 2.0);
+	qy.j = ZSL_SIN(pitch / 2.0);
+	qz.r = ZSL_COS(yaw / 2.0);
+	qz.k = ZSL_SIN(yaw / 2.0);
+	zsl_quat_mult(&qz, &qy, &q);
+	zsl_quat_mult(&q, &qx, &q);
+
+	rc = zsl_quat_to_euler(&q, &e);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(e.x, roll, 1E-5), NULL);
+	zassert_true(val_is_equal(e.y, pitch, 1E-5), NULL);
+	zassert_true(val_is_equal(e.z, yaw, 1E-5), NULL);
+
+	/* Pitch is clamped at +90 degrees rather than returning NaN. */
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_EMPTY);
+	q.r = ZSL_SQRT(0.5);
+	q.j = ZSL_SQRT(0.5) + 1E-7;
+	rc = zsl_quat_to_euler(&q, &e);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(e.y, ZSL_PI / 2.0, 1E-3), NULL);
 }
 
 void test_quat_from_euler(void)
@@ -473,3 +881,550 @@ void test_quat_from_rot_mtx(void)
 	zassert_true(val_is_equal(q.j, qcmp.j, 1E-6), NULL);
 	zassert_true(val_is_equal(q.k, qcmp.k, 1E-6), NULL);
 }
+
+void test_quat_rot_mtx33(void)
+{
+	struct zsl_quat q, qr;
+	zsl_real_t m[9];
+	zsl_real_t d;
+	struct zsl_quat qs[3] = {
+		{ .r = 0.5443311, .i = 0.4082483,
+		  .j = 0.6804138, .k = 0.2721655 },
+		/* 180 degrees about x, and near 180 degrees about a diagonal. */
+		{ .r = 0.0, .i = 1.0, .j = 0.0, .k = 0.0 },
+		{ .r = 0.001, .i = 0.1, .j = -0.7, .k = 0.7 },
+	};
+
+	ZSL_MATRIX_DEF(rot, 4, 4);
+
+	for (size_t n = 0; n < 3; n++) {
+		q = qs[n];
+		zsl_quat_to_unit_d(&q);
+
+		/* Matches the 4x4 conversion. */
+		zsl_quat_to_rot_mtx33(&q, m);
+		zsl_quat_to_rot_mtx(&q, &rot);
+		for (size_t r = 0; r < 3; r++) {
+			for (size_t c = 0; c < 3; c++) {
+				zassert_true(val_is_equal(m[3 * r + c],
+							  rot.data[4 * r + c],
+							  1E-6), NULL);
+			}
+		}
+
+		/* Round trips, including near 180 degrees. */
+		zsl_quat_from_rot_mtx33(m, &qr);
+		d = q.r * qr.r + q.i * qr.i + q.j * qr.j + q.k * qr.k;
+		zassert_true(val_is_equal(ZSL_ABS(d), 1.0, 1E-5), NULL);
+		zassert_true(qr.r >= 0.0, NULL);
+	}
+}
+
+/**
+ * Runs the common checks for a fusion driver, using only the zsl_fus_drv
+ * interface. 'tol' is the allowed error once the filter has converged.
+ */
+static void test_fus_drv_common(struct zsl_fus_drv *drv, uint32_t iter,
+				zsl_real_t tol)
+{
+	int rc;
+	uint32_t i;
+	struct zsl_quat q;
+	zsl_real_t w = 0.5;
+	zsl_real_t c = ZSL_COS(ZSL_PI / 6.0);
+	zsl_real_t s = ZSL_SIN(ZSL_PI / 6.0);
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_DEF(v, 3);
+	ZSL_VECTOR_DEF(vr, 3);
+
+	/* A zero sample rate is invalid. */
+	rc = drv->init_handler(0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* A gyroscope sample is required. */
+	rc = drv->init_handler(100);
+	zassert_true(rc == 0, NULL);
+	rc = drv->feed_handler(&a, &m, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* A level, stationary device should remain at identity. */
+	zsl_vec_init(&g);
+	zsl_vec_init(&m);
+	zsl_vec_init(&a);
+	a.data[2] = 1.0;
+	for (i = 0; i < 100; i++) {
+		rc = drv->feed_handler(&a, NULL, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	drv->get_quat_handler(&q);
+	zassert_true(val_is_equal(q.r, 1.0, 1E-5), NULL);
+	zassert_true(val_is_equal(q.i, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(q.j, 0.0, 1E-5), NULL);
+	zassert_true(val_is_equal(q.k, 0.0, 1E-5), NULL);
+
+	/* Gyroscope only: 1 s at w rad/s about z. */
+	drv->init_handler(100);
+	g.data[2] = w;
+	for (i = 0; i < 100; i++) {
+		rc = drv->feed_handler(NULL, NULL, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	drv->get_quat_handler(&q);
+	zassert_true(val_is_equal(q.r, ZSL_COS(w / 2.0), 1E-4), NULL);
+	zassert_true(val_is_equal(q.i, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(q.j, 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(q.k, ZSL_SIN(w / 2.0), 1E-4), NULL);
+
+	/* Converge from a 30 degree tilt about x, so gravity maps to +z. */
+	drv->init_handler(100);
+	zsl_vec_init(&g);
+	a.data[0] = 0.0;
+	a.data[1] = s;
+	a.data[2] = c;
+	for (i = 0; i < iter; i++) {
+		rc = drv->feed_handler(&a, NULL, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	drv->get_quat_handler(&q);
+	rc = zsl_quat_rot_vec(&q, &a, &vr);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(vr.data[0], 0.0, tol), NULL);
+	zassert_true(val_is_equal(vr.data[1], 0.0, tol), NULL);
+	zassert_true(val_is_equal(vr.data[2], 1.0, tol), NULL);
+
+	/* Converge heading, so the field has no east (y) component. */
+	drv->init_handler(100);
+	a.data[1] = 0.0;
+	a.data[2] = 1.0;
+	m.data[0] = 0.3;
+	m.data[1] = 0.3;
+	m.data[2] = -0.4;
+	for (i = 0; i < iter; i++) {
+		rc = drv->feed_handler(&a, &m, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	drv->get_quat_handler(&q);
+	zsl_quat_rot_vec(&q, &m, &vr);
+	zassert_true(vr.data[0] > 0.0, NULL);
+	zassert_true(val_is_equal(vr.data[1], 0.0, tol), NULL);
+	zsl_quat_rot_vec(&q, &a, &v);
+	zassert_true(val_is_equal(v.data[2], 1.0, tol), NULL);
+}
+
+void test_fus_madg(void)
+{
+	zsl_real_t beta = zsl_fus_madg_cfg.beta;
+
+	/*
+	 * Use a higher gain so the convergence checks stay short. The fixed
+	 * size gradient step leaves a limit cycle of about beta * dt.
+	 */
+	zsl_fus_madg_cfg.beta = 0.5;
+	test_fus_drv_common(&zsl_fus_madg_drv, 2000, 1E-2);
+	zsl_fus_madg_cfg.beta = beta;
+}
+
+void test_fus_mahn(void)
+{
+	test_fus_drv_common(&zsl_fus_mahn_drv, 2000, 1E-3);
+}
+
+void test_fus_ekf(void)
+{
+	int rc;
+	uint32_t i;
+	struct zsl_quat q;
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_DEF(b, 3);
+
+	test_fus_drv_common(&zsl_fus_ekf_drv, 2000, 1E-3);
+
+	/* A constant gyroscope offset on a stationary device is a bias. */
+	rc = zsl_fus_ekf_init(100);
+	zassert_true(rc == 0, NULL);
+	zsl_vec_init(&a);
+	a.data[2] = 1.0;
+	zsl_vec_init(&g);
+	g.data[0] = 0.02;
+	g.data[1] = -0.01;
+	for (i = 0; i < 6000; i++) {
+		rc = zsl_fus_ekf_feed(&a, NULL, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_fus_ekf_get_bias(&b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], 0.02, 1E-3), NULL);
+	zassert_true(val_is_equal(b.data[1], -0.01, 1E-3), NULL);
+	zsl_fus_ekf_get_quat(&q);
+	zassert_true(val_is_equal(q.r, 1.0, 1E-3), NULL);
+}
+
+void test_fus_feed_batch(void)
+{
+	int rc;
+	struct zsl_quat q, q2;
+	struct zsl_fus_drv drv = zsl_fus_mahn_drv;
+	zsl_real_t w = 0.5;
+	zsl_real_t t[32];
+
+	ZSL_MATRIX_DEF(a, 32, 3);
+	ZSL_MATRIX_DEF(g, 32, 3);
+	ZSL_QUAT_BATCH_DEF(qb, 4);
+
+	/* 32 tilted, rotating samples, such as a FIFO read would return. */
+	for (size_t i = 0; i < 32; i++) {
+		a.data[i * 3 + 0] = 0.0;
+		a.data[i * 3 + 1] = 0.5;
+		a.data[i * 3 + 2] = 0.8;
+		g.data[i * 3 + 0] = 0.1;
+		g.data[i * 3 + 1] = 0.0;
+		g.data[i * 3 + 2] = w;
+	}
+
+	struct zsl_fus_batch b = {
+		.n = 32,
+		.accel = &a,
+		.gyro = &g,
+		.dec = 8,
+		.q = &qb,
+	};
+
+	/* The native batch handler. */
+	rc = zsl_fus_mahn_init(100);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_fus_feed_batch(&zsl_fus_mahn_drv, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(b.qn == 4, NULL);
+	zsl_quat_batch_get(&qb, 3, &q);
+
+	/* The per-sample fallback must give the same result. */
+	drv.feed_batch_handler = NULL;
+	rc = drv.init_handler(100);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_fus_feed_batch(&drv, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(b.qn == 4, NULL);
+	zsl_quat_batch_get(&qb, 3, &q2);
+	zassert_true(val_is_equal(q.r, q2.r, 1E-6), NULL);
+	zassert_true(val_is_equal(q.i, q2.i, 1E-6), NULL);
+	zassert_true(val_is_equal(q.j, q2.j, 1E-6), NULL);
+	zassert_true(val_is_equal(q.k, q2.k, 1E-6), NULL);
+
+	/* Only the last sample is output with no decimation. */
+	b.dec = 0;
+	rc = zsl_fus_feed_batch(&drv, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(b.qn == 1, NULL);
+
+	/* Timestamps are not supported without a batch handler. */
+	for (size_t i = 0; i < 32; i++) {
+		t[i] = 0.01 * (zsl_real_t)i;
+	}
+	b.t = t;
+	rc = zsl_fus_feed_batch(&drv, &b);
+	zassert_true(rc == -ENOTSUP, NULL);
+
+	/*
+	 * Irregular timestamps, gyro only about z. The first sample uses the
+	 * nominal 0.01 s period, so the batch spans 0.63 s.
+	 */
+	zsl_fus_madg_init(100);
+	for (size_t i = 0; i < 32; i++) {
+		t[i] = 0.02 * (zsl_real_t)i + ((i & 1) ? 0.005 : 0.0);
+		g.data[i * 3 + 0] = 0.0;
+	}
+	t[31] = 0.62;
+	b.accel = NULL;
+	rc = zsl_fus_feed_batch(&zsl_fus_madg_drv, &b);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_batch_get(&qb, 0, &q);
+	zassert_true(val_is_equal(q.r, ZSL_COS(w * 0.63 / 2.0), 1E-4), NULL);
+	zassert_true(val_is_equal(q.k, ZSL_SIN(w * 0.63 / 2.0), 1E-4), NULL);
+
+	/* The next batch must start after the last timestamp. */
+	rc = zsl_fus_feed_batch(&zsl_fus_madg_drv, &b);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Timestamps must increase. */
+	zsl_fus_madg_init(100);
+	t[5] = t[4];
+	rc = zsl_fus_feed_batch(&zsl_fus_madg_drv, &b);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The output must hold every decimated orientation. */
+	b.t = NULL;
+	b.dec = 4;
+	rc = zsl_fus_feed_batch(&zsl_fus_madg_drv, &b);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+/* A driver without a batch handler, which records the gyro x values fed. */
+static zsl_real_t test_fus_queue_seen[16];
+static size_t test_fus_queue_nseen;
+
+static int test_fus_queue_feed(struct zsl_vec *a, struct zsl_vec *m,
+			       struct zsl_vec *g)
+{
+	test_fus_queue_seen[test_fus_queue_nseen++] = g->data[0];
+
+	return 0;
+}
+
+void test_fus_queue(void)
+{
+	int rc;
+	zsl_real_t x = 0.0;
+	struct zsl_fus_drv drv = {
+		.feed_handler = test_fus_queue_feed,
+	};
+
+	ZSL_FUS_QUEUE_DEF(q, 8);
+	ZSL_FUS_QUEUE_DEF_T(qt, 4);
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	zsl_vec_init(&a);
+	zsl_vec_init(&m);
+	zsl_vec_init(&g);
+	a.data[2] = 1.0;
+	m.data[0] = 1.0;
+	test_fus_queue_nseen = 0;
+
+	/* Push 6, and drain at most 4. */
+	for (size_t n = 0; n < 6; n++) {
+		g.data[0] = x++;
+		rc = zsl_fus_queue_push(&q, &a, &m, &g, 0.0);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(zsl_fus_queue_level(&q) == 6, NULL);
+	rc = zsl_fus_queue_drain(&q, &drv, 4);
+	zassert_true(rc == 4, NULL);
+	zassert_true(zsl_fus_queue_level(&q) == 2, NULL);
+
+	/* Fill up, wrapping around the end of the storage. */
+	for (size_t n = 0; n < 6; n++) {
+		g.data[0] = x++;
+		rc = zsl_fus_queue_push(&q, &a, &m, &g, 0.0);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_fus_queue_push(&q, &a, &m, &g, 0.0);
+	zassert_true(rc == -ENOBUFS, NULL);
+	zassert_true(q.full == 1, NULL);
+
+	/* The rest comes out in order, in two runs. */
+	rc = zsl_fus_queue_drain(&q, &drv, 0);
+	zassert_true(rc == 8, NULL);
+	zassert_true(test_fus_queue_nseen == 12, NULL);
+	for (size_t n = 0; n < 12; n++) {
+		zassert_true(test_fus_queue_seen[n] == (zsl_real_t)n, NULL);
+	}
+	zassert_true(q.head == 12 && q.tail == 12, NULL);
+	zassert_true(q.peak == 8, NULL);
+	rc = zsl_fus_queue_drain(&q, &drv, 0);
+	zassert_true(rc == 0, NULL);
+
+	/* Missing sensors. */
+	rc = zsl_fus_queue_push(&q, NULL, &m, &g, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Timestamps need a batch handler, but the samples are released. */
+	for (size_t n = 0; n < 3; n++) {
+		rc = zsl_fus_queue_push(&qt, &a, &m, &g, 0.01 * (n + 1));
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_fus_queue_drain(&qt, &drv, 0);
+	zassert_true(rc == -ENOTSUP, NULL);
+	zassert_true(zsl_fus_queue_level(&qt) == 0, NULL);
+
+	/* A batch driver takes timestamped samples across the wrap. */
+	zsl_fus_madg_drv.init_handler(100);
+	for (size_t n = 3; n < 6; n++) {
+		rc = zsl_fus_queue_push(&qt, &a, &m, &g, 0.01 * (n + 1));
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_fus_queue_drain(&qt, &zsl_fus_madg_drv, 0);
+	zassert_true(rc == 3, NULL);
+}
+
+void test_fus_cal_magn(void)
+{
+	int rc;
+	struct zsl_fus_cal_magn c;
+	zsl_real_t z, r, phi;
+	/* Soft iron distortion and hard iron offset of the simulated sensor. */
+	zsl_real_t d[9] = {
+		1.2, 0.1, -0.05,
+		0.1, 0.9, 0.08,
+		-0.05, 0.08, 1.05
+	};
+	zsl_real_t bt[3] = { 12.0, -30.0, 7.5 };
+
+	ZSL_MATRIX_DEF(K, 3, 3);
+	ZSL_MATRIX_DEF(Kx, 3, 4);
+	ZSL_VECTOR_DEF(b, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(u, 3);
+	ZSL_VECTOR_DEF(mx, 2);
+
+	rc = zsl_fus_cal_magn_init(&c, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_init(&c, 50.0);
+	zassert_true(rc == 0, NULL);
+
+	/* Too few samples. */
+	rc = zsl_fus_cal_magn_solve(&c, &K, &b);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Distorted samples of a 50 uT field, spread over the sphere. */
+	for (size_t n = 0; n < 200; n++) {
+		z = 1.0 - (2.0 * n + 1.0) / 200.0;
+		r = ZSL_SQRT(1.0 - z * z);
+		phi = 2.39996323 * n;
+		u.data[0] = 50.0 * r * ZSL_COS(phi);
+		u.data[1] = 50.0 * r * ZSL_SIN(phi);
+		u.data[2] = 50.0 * z;
+		for (size_t i = 0; i < 3; i++) {
+			m.data[i] = bt[i];
+			for (size_t j = 0; j < 3; j++) {
+				m.data[i] += d[i * 3 + j] * u.data[j];
+			}
+		}
+		rc = zsl_fus_cal_magn_feed(&c, &m);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(c.n == 200, NULL);
+
+	rc = zsl_fus_cal_magn_solve(&c, &K, &b);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(b.data[i], bt[i], 1E-2), NULL);
+	}
+
+	/* The calibrated output lies on the 50 uT sphere. */
+	for (size_t n = 0; n < 3; n++) {
+		for (size_t i = 0; i < 3; i++) {
+			m.data[i] = bt[i] + 50.0 * d[i * 3 + n];
+		}
+		rc = zsl_fus_cal_magn_apply(&K, &b, &m, &m);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(zsl_vec_norm(&m), 50.0, 1E-2), NULL);
+	}
+
+	/* Invalid shapes. */
+	rc = zsl_fus_cal_magn_feed(&c, &mx);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_solve(&c, &Kx, &b);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_apply(&K, &b, &mx, &m);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Samples in a single plane do not describe an ellipsoid. */
+	zsl_fus_cal_magn_init(&c, 50.0);
+	for (size_t n = 0; n < 50; n++) {
+		m.data[0] = 50.0 * ZSL_COS(0.2 * n);
+		m.data[1] = 50.0 * ZSL_SIN(0.2 * n);
+		m.data[2] = 0.0;
+		zsl_fus_cal_magn_feed(&c, &m);
+	}
+	rc = zsl_fus_cal_magn_solve(&c, &K, &b);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_fast_trig(void)
+{
+	zsl_real_t x, y;
+
+	for (int i = -1000; i <= 1000; i++) {
+		x = (zsl_real_t)i * 0.01;
+		zassert_true(val_is_equal(zsl_fast_sin(x), ZSL_SIN(x), 1E-5),
+			     NULL);
+		zassert_true(val_is_equal(zsl_fast_cos(x), ZSL_COS(x), 1E-5),
+			     NULL);
+
+		/* Angles around the full circle at radius 2, skipping +/-pi. */
+		y = 2.0 * ZSL_SIN(x);
+		x = 2.0 * ZSL_COS(x);
+		zassert_true(val_is_equal(zsl_fast_atan2(y, x), ZSL_ATAN2(y, x),
+					  1E-5) || ZSL_ABS(y) < 1E-6, NULL);
+
+		x = (zsl_real_t)i * 0.001;
+		zassert_true(val_is_equal(zsl_fast_asin(x), ZSL_ASIN(x), 1E-5),
+			     NULL);
+		zassert_true(val_is_equal(zsl_fast_acos(x), ZSL_ACOS(x), 1E-5),
+			     NULL);
+	}
+
+	zassert_true(zsl_fast_atan2(0.0, 0.0) == 0.0, NULL);
+	zassert_true(val_is_equal(zsl_fast_atan2(1.0, 0.0), ZSL_PI / 2.0, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(zsl_fast_acos(1.5), 0.0, 1E-6), NULL);
+}
+
+void test_quat_slerp_step(void)
+{
+	int rc;
+	struct zsl_quat qa, qb, qi, qs;
+	struct zsl_quat_slerp_step st;
+	zsl_real_t n;
+
+	/* Two unrelated unit quaternions. */
+	qa.r = 0.9;
+	qa.i = 0.1;
+	qa.j = -0.3;
+	qa.k = 0.2;
+	qb.r = 0.2;
+	qb.i = 0.7;
+	qb.j = 0.4;
+	qb.k = -0.5;
+	zsl_quat_to_unit(&qa, &qa);
+	zsl_quat_to_unit(&qb, &qb);
+
+	/* At least two outputs are needed. */
+	rc = zsl_quat_slerp_step_init(&st, &qa, &qb, 1);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The stepper must match slerp at each evenly spaced t. */
+	rc = zsl_quat_slerp_step_init(&st, &qa, &qb, 33);
+	zassert_true(rc == 0, NULL);
+	zassert_false(st.nlerp, NULL);
+	for (size_t k = 0; k < 33; k++) {
+		rc = zsl_quat_slerp_step_next(&st, &qs);
+		zassert_true(rc == 0, NULL);
+		zsl_quat_slerp(&qa, &qb, (zsl_real_t)k / 32.0, &qi);
+		for (size_t c = 0; c < 4; c++) {
+			zassert_true(val_is_equal(qs.idx[c], qi.idx[c], 1E-4),
+				     NULL);
+		}
+	}
+	zassert_true(qs.r == qb.r && qs.i == qb.i && qs.j == qb.j &&
+		     qs.k == qb.k, NULL);
+
+	/* Further calls fail. */
+	rc = zsl_quat_slerp_step_next(&st, &qs);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Nearly parallel inputs are stepped with nlerp. */
+	n = 0.02;
+	qb = qa;
+	qb.k += n;
+	zsl_quat_to_unit(&qb, &qb);
+	rc = zsl_quat_slerp_step_init(&st, &qa, &qb, 5);
+	zassert_true(rc == 0, NULL);
+	zassert_true(st.nlerp, NULL);
+	for (size_t k = 0; k < 5; k++) {
+		rc = zsl_quat_slerp_step_next(&st, &qs);
+		zassert_true(rc == 0, NULL);
+		zsl_quat_slerp(&qa, &qb, (zsl_real_t)k / 4.0, &qi);
+		zassert_true(val_is_equal(zsl_quat_magn(&qs), 1.0, 1E-5), NULL);
+		for (size_t c = 0; c < 4; c++) {
+			zassert_true(val_is_equal(qs.idx[c], qi.idx[c], 1E-5),
+				     NULL);
+		}
+	}
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/packed.h>
+#include "floatcheck.h"
+
+/* A symmetric positive-definite test matrix. */
+static zsl_real_t pk_spd[16] = {
+	4.0, 1.0, 0.5, -1.0,
+	1.0, 3.0, 0.0, 0.25,
+	0.5, 0.0, 2.0, 0.5,
+	-1.0, 0.25, 0.5, 5.0
+};
+
+/* Dense reference for w = m * v. */
+static void pk_mult_vec(struct zsl_mtx *m, struct zsl_vec *v,
+			struct zsl_vec *w)
+{
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		w->data[i] = 0.0;
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			w->data[i] += m->data[i * m->sz_cols + j] * v->data[j];
+		}
+	}
+}
+
+void test_pkmtx_convert(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 4, .data = pk_spd };
+
+	ZSL_PKMATRIX_DEF(ps, 4, ZSL_PKMTX_SYM);
+	ZSL_PKMATRIX_DEF(pl, 4, ZSL_PKMTX_LOWER);
+	ZSL_PKMATRIX_DEF(pu, 4, ZSL_PKMTX_UPPER);
+	ZSL_MATRIX_DEF(mo, 4, 4);
+	ZSL_MATRIX_DEF(mw, 3, 4);
+
+	zassert_equal(ZSL_PKMTX_SZ(4), 10, NULL);
+
+	/* A symmetric matrix round trips. */
+	rc = zsl_pkmtx_from_mtx(&m, &ps);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(ps.data[3] == 0.5, NULL);
+	rc = zsl_pkmtx_to_mtx(&ps, &mo);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mo), NULL);
+
+	/* Triangular matrices keep one triangle, and zero the other. */
+	zsl_pkmtx_from_mtx(&m, &pl);
+	zsl_pkmtx_from_mtx(&m, &pu);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zsl_pkmtx_get(&pl, i, j, &x);
+			zassert_true(x == ((j <= i) ? pk_spd[i * 4 + j] : 0.0),
+				     NULL);
+			zsl_pkmtx_get(&pu, i, j, &x);
+			zassert_true(x == ((j >= i) ? pk_spd[i * 4 + j] : 0.0),
+				     NULL);
+		}
+	}
+	zassert_true(pu.data[4] == 3.0, NULL);
+
+	/* Setting a symmetric entry sets its mirror. */
+	rc = zsl_pkmtx_set(&ps, 0, 3, 9.0);
+	zassert_equal(rc, 0, NULL);
+	zsl_pkmtx_get(&ps, 3, 0, &x);
+	zassert_true(x == 9.0, NULL);
+
+	/* The zero triangle of a triangular matrix can't be set. */
+	zassert_equal(zsl_pkmtx_set(&pu, 3, 0, 1.0), -EINVAL, NULL);
+	zassert_equal(zsl_pkmtx_get(&pu, 4, 0, &x), -EINVAL, NULL);
+	zassert_equal(zsl_pkmtx_from_mtx(&mw, &pu), -EINVAL, NULL);
+}
+
+void test_pkmtx_mult(void)
+{
+	int rc;
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 4, .data = pk_spd };
+	enum zsl_pkmtx_type types[3] = {
+		ZSL_PKMTX_SYM, ZSL_PKMTX_LOWER, ZSL_PKMTX_UPPER
+	};
+
+	ZSL_PKMATRIX_DEF(p, 4, ZSL_PKMTX_SYM);
+	ZSL_PKMATRIX_DEF(po, 3, ZSL_PKMTX_SYM);
+	ZSL_MATRIX_DEF(md, 4, 4);
+	ZSL_MATRIX_DEF(mb, 4, 2);
+	ZSL_MATRIX_DEF(mc, 4, 2);
+	ZSL_MATRIX_DEF(mref, 4, 2);
+	ZSL_MATRIX_DEF(f, 3, 4);
+	ZSL_MATRIX_DEF(fp, 3, 4);
+	ZSL_MATRIX_DEF(fpf, 3, 3);
+	ZSL_MATRIX_DEF(pod, 3, 3);
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(w, 4);
+	ZSL_VECTOR_DEF(wref, 4);
+
+	for (size_t i = 0; i < 8; i++) {
+		mb.data[i] = (zsl_real_t)i * 0.5 - 1.0;
+	}
+	for (size_t i = 0; i < 12; i++) {
+		f.data[i] = (zsl_real_t)((i * 7) % 5) - 2.0;
+	}
+	for (size_t i = 0; i < 4; i++) {
+		v.data[i] = (zsl_real_t)i + 0.5;
+	}
+
+	/* Each type matches the product with its dense expansion. */
+	for (size_t t = 0; t < 3; t++) {
+		p.type = types[t];
+		zsl_pkmtx_from_mtx(&m, &p);
+		zsl_pkmtx_to_mtx(&p, &md);
+
+		rc = zsl_pkmtx_mult_vec(&p, &v, &w);
+		zassert_equal(rc, 0, NULL);
+		pk_mult_vec(&md, &v, &wref);
+		zassert_true(zsl_vec_is_equal(&w, &wref, 1E-5), NULL);
+
+		rc = zsl_pkmtx_mult_mtx(&p, &mb, &mc);
+		zassert_equal(rc, 0, NULL);
+		zsl_mtx_mult(&md, &mb, &mref);
+		for (size_t i = 0; i < 8; i++) {
+			zassert_true(val_is_equal(mc.data[i], mref.data[i],
+						  1E-5), NULL);
+		}
+	}
+
+	/* F * P * F^T, against the dense product. */
+	p.type = ZSL_PKMTX_SYM;
+	zsl_pkmtx_from_mtx(&m, &p);
+	rc = zsl_pkmtx_congruence(&f, &p, &po);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&f, &m, &fp);
+	zsl_mtx_mult_ex(&fp, false, &f, true, 1.0, 0.0, &fpf);
+	zsl_pkmtx_to_mtx(&po, &pod);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(pod.data[i], fpf.data[i], 1E-4),
+			     NULL);
+	}
+	zassert_equal(zsl_pkmtx_congruence(&f, &po, &p), -EINVAL, NULL);
+
+	/* P + 2 * v * v^T. */
+	rc = zsl_pkmtx_rank1(&p, 2.0, &v);
+	zassert_equal(rc, 0, NULL);
+	zsl_pkmtx_to_mtx(&p, &md);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(val_is_equal(md.data[i * 4 + j],
+						  pk_spd[i * 4 + j] + 2.0 *
+						  v.data[i] * v.data[j], 1E-5),
+				     NULL);
+		}
+	}
+}
+
+void test_pkmtx_solve(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_mtx m = { .sz_rows = 4, .sz_cols = 4, .data = pk_spd };
+
+	ZSL_PKMATRIX_DEF(p, 4, ZSL_PKMTX_SYM);
+	ZSL_PKMATRIX_DEF(pu, 4, ZSL_PKMTX_UPPER);
+	ZSL_MATRIX_DEF(l, 4, 4);
+	ZSL_VECTOR_DEF(b, 4);
+	ZSL_VECTOR_DEF(xs, 4);
+	ZSL_VECTOR_DEF(r, 4);
+	ZSL_VECTOR_DEF(u, 4);
+
+	for (size_t i = 0; i < 4; i++) {
+		b.data[i] = (zsl_real_t)i - 1.5;
+		u.data[i] = 0.25 * (zsl_real_t)(i + 1);
+	}
+
+	/* Factor in place, and compare with the dense factor. */
+	zsl_pkmtx_from_mtx(&m, &p);
+	rc = zsl_pkmtx_cholesky(&p, &p);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(p.type, ZSL_PKMTX_LOWER, NULL);
+	zsl_mtx_cholesky(&m, &l);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zsl_pkmtx_get(&p, i, j, &x);
+			zassert_true(val_is_equal(x, l.data[i * 4 + j], 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Solve in place, and check the residual. */
+	zsl_vec_copy(&xs, &b);
+	rc = zsl_pkmtx_chol_solve(&p, &xs, &xs);
+	zassert_equal(rc, 0, NULL);
+	pk_mult_vec(&m, &xs, &r);
+	zassert_true(zsl_vec_is_equal(&r, &b, 1E-5), NULL);
+
+	/* A rank-1 update matches the dense update. */
+	rc = zsl_pkmtx_chol_update(&p, &u);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_chol_update(&l, &u);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			zsl_pkmtx_get(&p, i, j, &x);
+			zassert_true(val_is_equal(x, l.data[i * 4 + j], 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Upper triangular substitution. */
+	zsl_pkmtx_from_mtx(&m, &pu);
+	rc = zsl_pkmtx_trsv(&pu, &b, &xs);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_pkmtx_mult_vec(&pu, &xs, &r);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&r, &b, 1E-5), NULL);
+
+	/* Invalid inputs. */
+	zsl_pkmtx_from_mtx(&m, &p);
+	p.type = ZSL_PKMTX_SYM;
+	zassert_equal(zsl_pkmtx_trsv(&p, &b, &xs), -EINVAL, NULL);
+	zassert_equal(zsl_pkmtx_chol_solve(&p, &b, &xs), -EINVAL, NULL);
+	zsl_pkmtx_set(&p, 0, 0, -1.0);
+	zassert_equal(zsl_pkmtx_cholesky(&p, &p), -ENOTPOSDEF, NULL);
+	zsl_pkmtx_set(&pu, 2, 2, 0.0);
+	zassert_equal(zsl_pkmtx_trsv(&pu, &b, &xs), -ESINGULAR, NULL);
+}
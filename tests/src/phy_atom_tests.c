@@ -124,3 +124,25 @@ void test_phy_atom_bragg(void)
 	/* IEEE standard states that x != x is true only for NAN values. */
 	zassert_true(d != d, NULL);
 }
+
+void test_phy_atom_rad_decay_vec(void)
+{
+	int rc;
+	zsl_real_t qf;
+
+	ZSL_VECTOR_DEF(q, 100);
+
+	rc = zsl_phy_atom_rad_decay_vec(15.0, 2.0, 0.5, 0.3, &q);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < q.sz; k++) {
+		zsl_phy_atom_rad_decay(15.0, 2.0 + 0.5 * (zsl_real_t)k, 0.3,
+				       &qf);
+		zassert_true(val_is_equal(q.data[k], qf, 1E-5), NULL);
+	}
+
+	/* Example for negative time step. */
+	rc = zsl_phy_atom_rad_decay_vec(15.0, 2.0, -0.5, 0.3, &q);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(q.data[0] != q.data[0], NULL);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/physics/circuit.h>
+#include "floatcheck.h"
+
+void test_phy_circ_dc(void)
+{
+	int rc;
+	int vs, r1, is;
+	zsl_real_t v, i;
+
+	ZSL_PHY_CIRC_DEF(c, 3, 5, 1);
+
+	/* 10 V across a 1k/1k divider, with a 1 mA source into node 3. */
+	vs = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_V, 1, 0, 10.0);
+	r1 = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 1, 2, 1000.0);
+	zassert_true(zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 2, 0, 1000.0) >= 0,
+		     NULL);
+	is = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_I, 3, 0, 1E-3);
+	zassert_true(zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 3, 0, 2000.0) >= 0,
+		     NULL);
+	zassert_true((vs >= 0) && (r1 >= 0) && (is >= 0), NULL);
+
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, 0, NULL);
+
+	zsl_phy_circ_volt(&c, 1, &v);
+	zassert_true(val_is_equal(v, 10.0, 1E-5), NULL);
+	zsl_phy_circ_volt(&c, 2, &v);
+	zassert_true(val_is_equal(v, 5.0, 1E-5), NULL);
+	zsl_phy_circ_volt(&c, 3, &v);
+	zassert_true(val_is_equal(v, 2.0, 1E-5), NULL);
+	zsl_phy_circ_curr(&c, vs, &i);
+	zassert_true(val_is_equal(i, -5E-3, 1E-6), NULL);
+	zsl_phy_circ_curr(&c, r1, &i);
+	zassert_true(val_is_equal(i, 5E-3, 1E-6), NULL);
+
+	/* Changing a source reuses the factors. */
+	rc = zsl_phy_circ_set(&c, vs, 4.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(c.valid, NULL);
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, 0, NULL);
+	zsl_phy_circ_volt(&c, 2, &v);
+	zassert_true(val_is_equal(v, 2.0, 1E-5), NULL);
+
+	/* Changing a resistor does not. */
+	rc = zsl_phy_circ_set(&c, r1, 3000.0);
+	zassert_equal(rc, 0, NULL);
+	zassert_false(c.valid, NULL);
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, 0, NULL);
+	zsl_phy_circ_volt(&c, 2, &v);
+	zassert_true(val_is_equal(v, 1.0, 1E-5), NULL);
+
+	/* Invalid nodes, values and elements. */
+	rc = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 4, 0, 1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 1, 1, 1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_phy_circ_set(&c, r1, -1.0);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_phy_circ_volt(&c, 4, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_phy_circ_curr(&c, 5, &i);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* The circuit is full. */
+	rc = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 1, 0, 1.0);
+	zassert_equal(rc, -ENOMEM, NULL);
+}
+
+void test_phy_circ_singular(void)
+{
+	int rc;
+
+	ZSL_PHY_CIRC_DEF(c, 2, 2, 1);
+
+	/* Node 2 is only connected through a capacitor, so floats at DC. */
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_V, 1, 0, 1.0);
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_C, 1, 2, 1E-6);
+
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	rc = zsl_phy_circ_step(&c, 0.0);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+void test_phy_circ_rc(void)
+{
+	int rc;
+	int vs;
+	zsl_real_t v;
+	zsl_real_t tau = 1000.0 * 1E-6;
+
+	ZSL_PHY_CIRC_DEF(c, 2, 3, 1);
+
+	/* RC low-pass, charged from 0 V by a 1 V step. */
+	vs = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_V, 1, 0, 0.0);
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 1, 2, 1000.0);
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_C, 2, 0, 1E-6);
+
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, 0, NULL);
+	zsl_phy_circ_set(&c, vs, 1.0);
+
+	for (size_t s = 0; s < 100; s++) {
+		rc = zsl_phy_circ_step(&c, tau / 100.0);
+		zassert_equal(rc, 0, NULL);
+	}
+
+	/* v = 1 - e^-1 after one time constant. */
+	zsl_phy_circ_volt(&c, 2, &v);
+	zassert_true(val_is_equal(v, 1.0 - ZSL_EXP(-1.0), 1E-4), NULL);
+}
+
+void test_phy_circ_rl(void)
+{
+	int rc;
+	int ind;
+	zsl_real_t i;
+	zsl_real_t tau = 0.1 / 10.0;
+
+	ZSL_PHY_CIRC_DEF(c, 2, 3, 2);
+
+	/* 5 V switched onto a 10 ohm, 100 mH series RL circuit at t = 0. */
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_V, 1, 0, 5.0);
+	zsl_phy_circ_add(&c, ZSL_PHY_CIRC_R, 1, 2, 10.0);
+	ind = zsl_phy_circ_add(&c, ZSL_PHY_CIRC_L, 2, 0, 0.1);
+
+	/* The DC solution would short the inductor, so start from rest. */
+	for (size_t s = 0; s < 200; s++) {
+		rc = zsl_phy_circ_step(&c, tau / 200.0);
+		zassert_equal(rc, 0, NULL);
+	}
+
+	/* i = (V / R) * (1 - e^-1) after one time constant. */
+	zsl_phy_circ_curr(&c, ind, &i);
+	zassert_true(val_is_equal(i, 0.5 * (1.0 - ZSL_EXP(-1.0)), 1E-4), NULL);
+
+	/* The DC operating point has the full current. */
+	rc = zsl_phy_circ_dc(&c);
+	zassert_equal(rc, 0, NULL);
+	zsl_phy_circ_curr(&c, ind, &i);
+	zassert_true(val_is_equal(i, 0.5, 1E-5), NULL);
+}
@@ -234,3 +234,59 @@ void test_phy_ecmp_rl_current(void)
 	/* IEEE standard states that x != x is true only for NAN values. */
 	zassert_true(i != i, NULL);
 }
+
+void test_phy_ecmp_rc_vec(void)
+{
+	int rc;
+	zsl_real_t t, x;
+
+	ZSL_VECTOR_DEF(v, 80);
+
+	/* R = 1k, C = 1 mF, so tau = 1 s, over 4 time constants. */
+	rc = zsl_phy_ecmp_rc_charg_i_vec(1000.0, 1E-3, 0.0, 0.05, 2.0, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < v.sz; k++) {
+		t = 0.05 * (zsl_real_t)k;
+		zsl_phy_ecmp_rc_charg_i(1000.0, 1E-3, t, 2.0, &x);
+		zassert_true(val_is_equal(v.data[k], x, 1E-6), NULL);
+	}
+
+	rc = zsl_phy_ecmp_rc_charg_q_vec(1000.0, 1E-3, 0.0, 0.05, 2.0, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < v.sz; k++) {
+		t = 0.05 * (zsl_real_t)k;
+		zsl_phy_ecmp_rc_charg_q(1000.0, 1E-3, t, 2.0, &x);
+		zassert_true(val_is_equal(v.data[k], x, 1E-6), NULL);
+	}
+
+	rc = zsl_phy_ecmp_rc_discharg_i_vec(1000.0, 1E-3, 0.0, 0.05, 2.0, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < v.sz; k++) {
+		t = 0.05 * (zsl_real_t)k;
+		zsl_phy_ecmp_rc_discharg_i(1000.0, 1E-3, t, 2.0, &x);
+		zassert_true(val_is_equal(v.data[k], x, 1E-6), NULL);
+	}
+
+	rc = zsl_phy_ecmp_rc_discharg_q_vec(1000.0, 1E-3, 0.0, 0.05, 2.0, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < v.sz; k++) {
+		t = 0.05 * (zsl_real_t)k;
+		zsl_phy_ecmp_rc_discharg_q(1000.0, 1E-3, t, 2.0, &x);
+		zassert_true(val_is_equal(v.data[k], x, 1E-6), NULL);
+	}
+
+	/* R = 10, L = 5 H. */
+	rc = zsl_phy_ecmp_rl_current_vec(10.0, 5.0, 0.1, 0.02, 3.0, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < v.sz; k++) {
+		t = 0.1 + 0.02 * (zsl_real_t)k;
+		zsl_phy_ecmp_rl_current(10.0, 5.0, t, 3.0, &x);
+		zassert_true(val_is_equal(v.data[k], x, 1E-6), NULL);
+	}
+
+	/* Example for zero capacitance. */
+	rc = zsl_phy_ecmp_rc_discharg_q_vec(1000.0, 0.0, 0.0, 0.05, 2.0, &v);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(v.data[0] != v.data[0], NULL);
+}
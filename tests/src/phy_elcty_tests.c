@@ -184,6 +184,31 @@ void test_phy_elcty_ohm_law(void)
 	zassert_true(v != v, NULL);
 }
 
+void test_phy_elcty_ohm_law_vec(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(i, 2);
+	ZSL_VECTOR_DEF(r, 2);
+	ZSL_VECTOR_DEF(v, 2);
+
+	i.data[0] = 15.0;
+	i.data[1] = 0.5;
+	r.data[0] = 2.0;
+	r.data[1] = -1.0;
+
+	/* Only the entry with a negative resistance is NAN. */
+	rc = zsl_phy_elcty_ohm_law_vec(&i, &r, &v);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(v.data[0], 30.0, 1E-6), NULL);
+	zassert_true(v.data[1] != v.data[1], NULL);
+
+	r.data[1] = 100.0;
+	rc = zsl_phy_elcty_ohm_law_vec(&i, &r, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(v.data[1], 50.0, 1E-6), NULL);
+}
+
 void test_phy_elcty_power_vi(void)
 {
 	int rc;
@@ -194,6 +219,29 @@ void test_phy_elcty_power_vi(void)
 	zassert_true(val_is_equal(p, 0.0375, 1E-6), NULL);
 }
 
+void test_phy_elcty_power_vi_vec(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(v, 2);
+	ZSL_VECTOR_DEF(i, 2);
+	ZSL_VECTOR_DEF(p, 2);
+	ZSL_VECTOR_DEF(px, 3);
+
+	v.data[0] = 15.0;
+	v.data[1] = 3.3;
+	i.data[0] = 2.0;
+	i.data[1] = 0.1;
+
+	rc = zsl_phy_elcty_power_vi_vec(&v, &i, &p);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(p.data[0], 30.0, 1E-6), NULL);
+	zassert_true(val_is_equal(p.data[1], 0.33, 1E-6), NULL);
+
+	rc = zsl_phy_elcty_power_vi_vec(&v, &i, &px);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_phy_elcty_power_ir(void)
 {
 	int rc;
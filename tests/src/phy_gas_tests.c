@@ -146,3 +146,94 @@ void test_phy_gas_charles_lussac(void)
 	/* IEEE standard states that x != x is true only for NAN values. */
 	zassert_true(vf != vf, NULL);
 }
+
+void test_phy_gas_air_dens(void)
+{
+	int rc;
+	zsl_real_t d;
+
+	/* Moist air at 20 C and 50% relative humidity. */
+	rc = zsl_phy_gas_air_dens(293.15, 101325.0, 0.5, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(d, 1.1993152, 1E-5), NULL);
+
+	/* Dry air at 0 C. */
+	rc = zsl_phy_gas_air_dens(273.15, 101325.0, 0.0, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(d, 1.2930502, 1E-5), NULL);
+
+	/* Example for relative humidity above 1. */
+	rc = zsl_phy_gas_air_dens(293.15, 101325.0, 1.5, &d);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(d != d, NULL);
+
+	/* Example for zero pressure. */
+	rc = zsl_phy_gas_air_dens(293.15, 0.0, 0.5, &d);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(d != d, NULL);
+}
+
+void test_phy_gas_air_visc(void)
+{
+	int rc;
+	zsl_real_t mu;
+
+	rc = zsl_phy_gas_air_visc(300.0, &mu);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mu, 1.8459163E-5, 1E-10), NULL);
+
+	/* Example for negative temperature. */
+	rc = zsl_phy_gas_air_visc(-300.0, &mu);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(mu != mu, NULL);
+}
+
+void test_phy_gas_cache(void)
+{
+	int rc;
+	zsl_real_t rh = 0.5;
+	zsl_real_t d, v;
+	zsl_real_t t[3] = { 251.3, 287.9, 319.2 };
+	zsl_real_t p[3] = { 80300.0, 97750.0, 119000.0 };
+	zsl_real_t vb[3];
+
+	ZSL_PHY_GAS_CACHE_DEF(cache, 15, 5);
+
+	rc = zsl_phy_gas_cache_init(&cache, zsl_phy_gas_air_dens_fn, &rh,
+				    250.0, 320.0, 80000.0, 120000.0);
+	zassert_true(rc == 0, NULL);
+
+	/* Lookups match the formula between the grid points. */
+	for (size_t k = 0; k < 3; k++) {
+		rc = zsl_phy_gas_cache_get(&cache, t[k], p[k], &v);
+		zassert_true(rc == 0, NULL);
+		zsl_phy_gas_air_dens(t[k], p[k], rh, &d);
+		zassert_true(val_is_equal(v, d, 1E-4), NULL);
+	}
+
+	rc = zsl_phy_gas_cache_get_batch(&cache, t, p, vb, 3);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < 3; k++) {
+		zsl_phy_gas_air_dens(t[k], p[k], rh, &d);
+		zassert_true(val_is_equal(vb[k], d, 1E-4), NULL);
+	}
+
+	/* Example for a temperature outside the cache. */
+	rc = zsl_phy_gas_cache_get(&cache, 330.0, 100000.0, &v);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(v != v, NULL);
+
+	/* Example for an empty range. */
+	rc = zsl_phy_gas_cache_init(&cache, zsl_phy_gas_air_visc_fn, NULL,
+				    250.0, 250.0, 80000.0, 120000.0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Example for a range the property isn't defined over. */
+	rc = zsl_phy_gas_cache_init(&cache, zsl_phy_gas_air_visc_fn, NULL,
+				    -10.0, 320.0, 80000.0, 120000.0);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -86,6 +86,38 @@ void test_phy_grav_force(void)
 	zassert_true(f != f, NULL);
 }
 
+void test_phy_grav_force_vec(void)
+{
+	int rc;
+	zsl_real_t f;
+
+	ZSL_VECTOR_DEF(m1, 2);
+	ZSL_VECTOR_DEF(m2, 2);
+	ZSL_VECTOR_DEF(r, 2);
+	ZSL_VECTOR_DEF(fv, 2);
+
+	zsl_real_t vm1[2] = { 15.0, 5.972E24 };
+	zsl_real_t vm2[2] = { 25.0, 80.0 };
+	zsl_real_t vr[2] = { 2.0, 6.371E6 };
+
+	zsl_vec_from_arr(&m1, vm1);
+	zsl_vec_from_arr(&m2, vm2);
+	zsl_vec_from_arr(&r, vr);
+
+	rc = zsl_phy_grav_force_vec(&m1, &m2, &r, &fv);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		zsl_phy_grav_force(vm1[i], vm2[i], vr[i], &f);
+		zassert_true(val_is_equal(fv.data[i], f, 1E-6), NULL);
+	}
+
+	/* Example for a distance of zero. */
+	r.data[1] = 0.0;
+	rc = zsl_phy_grav_force_vec(&m1, &m2, &r, &fv);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(fv.data[1] != fv.data[1], NULL);
+}
+
 void test_phy_grav_pot_ener(void)
 {
 	int rc;
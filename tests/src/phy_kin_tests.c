@@ -27,6 +27,46 @@ void test_phy_kin_dist(void)
 	zassert_true(dist != dist, NULL);
 }
 
+void test_phy_kin_dist_vec(void)
+{
+	int rc;
+	zsl_real_t d;
+
+	ZSL_VECTOR_DEF(vi, 3);
+	ZSL_VECTOR_DEF(t, 3);
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(dist, 3);
+	ZSL_VECTOR_DEF(dx, 2);
+
+	zsl_real_t vvi[3] = { 15.0, 0.0, -3.0 };
+	zsl_real_t vt[3] = { 5.0, 2.0, 1.5 };
+	zsl_real_t va[3] = { -2.0, 9.81, 0.5 };
+
+	zsl_vec_from_arr(&vi, vvi);
+	zsl_vec_from_arr(&t, vt);
+	zsl_vec_from_arr(&a, va);
+
+	/* Matches the scalar version. */
+	rc = zsl_phy_kin_dist_vec(&vi, &t, &a, &dist);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zsl_phy_kin_dist(vvi[i], vt[i], va[i], &d);
+		zassert_true(val_is_equal(dist.data[i], d, 1E-6), NULL);
+	}
+
+	/* Only the entry with a negative time is NAN. */
+	t.data[1] = -1.0;
+	rc = zsl_phy_kin_dist_vec(&vi, &t, &a, &t);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(t.data[0], 50.0, 1E-6), NULL);
+	zassert_true(t.data[1] != t.data[1], NULL);
+	zassert_true(t.data[2] == dist.data[2], NULL);
+
+	/* Mismatched sizes. */
+	rc = zsl_phy_kin_dist_vec(&vi, &t, &a, &dx);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_phy_kin_init_pos(void)
 {
 	int rc;
@@ -97,6 +137,39 @@ void test_phy_kin_vel(void)
 	zassert_true(vf != vf, NULL);
 }
 
+void test_phy_kin_vel_vec(void)
+{
+	int rc;
+	zsl_real_t v;
+
+	ZSL_VECTOR_DEF(vi, 2);
+	ZSL_VECTOR_DEF(t, 2);
+	ZSL_VECTOR_DEF(a, 2);
+	ZSL_VECTOR_DEF(vf, 2);
+
+	zsl_real_t vvi[2] = { 15.0, -3.0 };
+	zsl_real_t vt[2] = { 5.0, 1.5 };
+	zsl_real_t va[2] = { -2.0, 0.5 };
+
+	zsl_vec_from_arr(&vi, vvi);
+	zsl_vec_from_arr(&t, vt);
+	zsl_vec_from_arr(&a, va);
+
+	rc = zsl_phy_kin_vel_vec(&vi, &t, &a, &vf);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		zsl_phy_kin_vel(vvi[i], vt[i], va[i], &v);
+		zassert_true(val_is_equal(vf.data[i], v, 1E-6), NULL);
+	}
+
+	/* Example for negative time. */
+	t.data[0] = -1.0;
+	rc = zsl_phy_kin_vel_vec(&vi, &t, &a, &vf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(vf.data[0] != vf.data[0], NULL);
+	zassert_true(val_is_equal(vf.data[1], -2.25, 1E-6), NULL);
+}
+
 void test_phy_kin_vel2(void)
 {
 	int rc;
@@ -129,3 +129,104 @@ void test_phy_mass_center(void)
 	zassert_true(my != my, NULL);
 	zassert_true(mz != mz, NULL);
 }
+
+void test_phy_mass_acc_inertia(void)
+{
+	int rc;
+	zsl_real_t mt, mx, my, mz;
+	struct zsl_phy_mass_acc acc, acc2;
+
+	ZSL_VECTOR_DEF(m, 6);
+	ZSL_VECTOR_DEF(x, 6);
+	ZSL_VECTOR_DEF(y, 6);
+	ZSL_VECTOR_DEF(z, 6);
+	ZSL_MATRIX_DEF(p, 6, 3);
+	ZSL_VECTOR_DEF(com, 3);
+	ZSL_MATRIX_DEF(it, 3, 3);
+	ZSL_MATRIX_DEF(it2, 3, 3);
+
+	zsl_real_t md[6] = { 6.0, 1.0, 3.5, 7.0, 4.2, 1.7 };
+	zsl_real_t xd[6] = { 5.0, -3.0, -2.1, 4.9, 5.3, -1.1 };
+	zsl_real_t yd[6] = { -1.0, 0.5, 0.1, 0.7, 4.4, -0.3 };
+	zsl_real_t zd[6] = { 3.0, -1.5, 2.0, 8.1, 2.4, -5.5 };
+
+	/* Two unit masses on the x and y axes. */
+	zsl_phy_mass_acc_init(&acc);
+	rc = zsl_phy_mass_acc_feed(&acc, 1.0, 1.0, 0.0, 0.0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_mass_acc_feed(&acc, 1.0, 0.0, 1.0, 0.0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_mass_acc_inertia(&acc, &mt, &com, &it);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mt, 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(com.data[0], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(com.data[1], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(com.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[0], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[4], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[8], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[1], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[3], 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(it.data[5], 0.0, 1E-6), NULL);
+
+	/* The centre of mass matches zsl_phy_mass_center. */
+	zsl_vec_from_arr(&m, md);
+	zsl_vec_from_arr(&x, xd);
+	zsl_vec_from_arr(&y, yd);
+	zsl_vec_from_arr(&z, zd);
+	zsl_phy_mass_acc_init(&acc);
+	rc = zsl_phy_mass_acc_feed_vec(&acc, &m, &x, &y, &z);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_mass_acc_inertia(&acc, &mt, &com, &it);
+	zassert_true(rc == 0, NULL);
+	zsl_phy_mass_center(&m, &x, &y, &z, &mx, &my, &mz);
+	zassert_true(val_is_equal(mt, 23.4, 1E-5), NULL);
+	zassert_true(val_is_equal(com.data[0], mx, 1E-5), NULL);
+	zassert_true(val_is_equal(com.data[1], my, 1E-5), NULL);
+	zassert_true(val_is_equal(com.data[2], mz, 1E-5), NULL);
+
+	/* Interleaved points fed in two batches give the same result. */
+	for (size_t i = 0; i < 6; i++) {
+		p.data[i * 3 + 0] = xd[i];
+		p.data[i * 3 + 1] = yd[i];
+		p.data[i * 3 + 2] = zd[i];
+	}
+	m.sz = p.sz_rows = 2;
+	zsl_phy_mass_acc_init(&acc2);
+	rc = zsl_phy_mass_acc_feed_mtx(&acc2, &m, &p);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_mass_acc_feed_vec(&acc2, &m, &x, &y, &z);
+	zassert_true(rc == -EINVAL, NULL);
+	m.data += 2;
+	p.data += 6;
+	m.sz = p.sz_rows = 4;
+	rc = zsl_phy_mass_acc_feed_mtx(&acc2, &m, &p);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_mass_acc_inertia(&acc2, &mt, &com, &it2);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(it.data[i], it2.data[i], 1E-4), NULL);
+	}
+
+	/* Shifting every point leaves the inertia tensor unchanged. */
+	zsl_phy_mass_acc_init(&acc2);
+	for (size_t i = 0; i < 6; i++) {
+		rc = zsl_phy_mass_acc_feed(&acc2, md[i], xd[i] + 1000.0,
+					   yd[i] - 500.0, zd[i] + 250.0);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_phy_mass_acc_inertia(&acc2, &mt, &com, &it2);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(com.data[0], mx + 1000.0, 1E-3), NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(it.data[i], it2.data[i], 1E-2), NULL);
+	}
+
+	/* Negative masses, and an empty accumulator, are rejected. */
+	rc = zsl_phy_mass_acc_feed(&acc2, -1.0, 0.0, 0.0, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_phy_mass_acc_init(&acc2);
+	rc = zsl_phy_mass_acc_inertia(&acc2, &mt, &com, &it2);
+	zassert_true(rc == -EINVAL, NULL);
+}
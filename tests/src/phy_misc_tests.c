@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/physics/misc.h>
+#include "floatcheck.h"
+
+void test_phy_misc_exp_curve(void)
+{
+	int rc;
+	zsl_real_t y;
+
+	ZSL_VECTOR_DEF(v, 1000);
+	ZSL_VECTOR_DEF(g, 3);
+
+	/* Spans several resyncs, decaying by about e^-7. */
+	rc = zsl_phy_misc_exp_curve(2.5, 0.5, 0.7, 0.25, 0.01, &v);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t k = 0; k < v.sz; k++) {
+		y = 0.5 + 2.5 * ZSL_EXP(-0.7 * (0.25 + (zsl_real_t)k * 0.01));
+		zassert_true(val_is_equal(v.data[k], y, 1E-5), NULL);
+	}
+
+	/* A negative rate gives exponential growth. */
+	rc = zsl_phy_misc_exp_curve(1.0, 0.0, -ZSL_LOG(2.0), 0.0, 1.0, &g);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(g.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(g.data[1], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(g.data[2], 4.0, 1E-6), NULL);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/physics/gravitation.h>
+#include <zsl/physics/nbody.h>
+#include "floatcheck.h"
+
+#define NB 64
+
+/* Places NB bodies pseudo-randomly in a 100 m cube, with masses of 1E10. */
+static void nbody_fill(struct zsl_vec *x, struct zsl_vec *y,
+		       struct zsl_vec *z, struct zsl_vec *m)
+{
+	uint32_t s = 12345;
+
+	for (size_t i = 0; i < NB; i++) {
+		s = s * 1103515245u + 12345u;
+		x->data[i] = (zsl_real_t)((s >> 8) % 10000) / 100.0;
+		s = s * 1103515245u + 12345u;
+		y->data[i] = (zsl_real_t)((s >> 8) % 10000) / 100.0;
+		s = s * 1103515245u + 12345u;
+		z->data[i] = (zsl_real_t)((s >> 8) % 10000) / 100.0;
+		m->data[i] = 1E10 * (1.0 + (zsl_real_t)(i % 4));
+	}
+}
+
+void test_phy_nbody_acc(void)
+{
+	int rc;
+	zsl_real_t a;
+
+	ZSL_VECTOR_DEF(x, 2);
+	ZSL_VECTOR_DEF(y, 2);
+	ZSL_VECTOR_DEF(z, 2);
+	ZSL_VECTOR_DEF(m, 2);
+	ZSL_VECTOR_DEF(ax, 2);
+	ZSL_VECTOR_DEF(ay, 2);
+	ZSL_VECTOR_DEF(az, 2);
+	ZSL_VECTOR_DEF(ax3, 3);
+
+	zsl_vec_init(&x);
+	zsl_vec_init(&y);
+	zsl_vec_init(&z);
+	x.data[1] = 6.371E6;
+	m.data[0] = 5.972E24;
+	m.data[1] = 80.0;
+
+	/* A person on the surface of the Earth, and the Earth. */
+	rc = zsl_phy_nbody_acc(&x, &y, &z, &m, 0.0, &ax, &ay, &az);
+	zassert_true(rc == 0, NULL);
+	zsl_phy_grav_acc(m.data[0], x.data[1], &a);
+	zassert_true(val_is_equal(ax.data[1], a, 1E-6), NULL);
+	zassert_true(val_is_equal(ax.data[1], -9.8196, 1E-4), NULL);
+	zassert_true(ax.data[0] > 0.0, NULL);
+	zsl_phy_grav_acc(m.data[1], x.data[1], &a);
+	zassert_true(val_is_equal(ax.data[0], -a, 1E-12), NULL);
+	zassert_true(ay.data[0] == 0.0 && az.data[1] == 0.0, NULL);
+
+	/* Bodies at the same position do not attract each other. */
+	x.data[1] = 0.0;
+	rc = zsl_phy_nbody_acc(&x, &y, &z, &m, 0.0, &ax, &ay, &az);
+	zassert_true(rc == 0, NULL);
+	zassert_true(ax.data[0] == 0.0 && ax.data[1] == 0.0, NULL);
+
+	/* Mismatched sizes. */
+	rc = zsl_phy_nbody_acc(&x, &y, &z, &m, 0.0, &ax3, &ay, &az);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_phy_nbody_tree(void)
+{
+	int rc;
+	zsl_real_t mag, err;
+
+	ZSL_VECTOR_DEF(x, NB);
+	ZSL_VECTOR_DEF(y, NB);
+	ZSL_VECTOR_DEF(z, NB);
+	ZSL_VECTOR_DEF(m, NB);
+	ZSL_VECTOR_DEF(ax, NB);
+	ZSL_VECTOR_DEF(ay, NB);
+	ZSL_VECTOR_DEF(az, NB);
+	ZSL_VECTOR_DEF(bx, NB);
+	ZSL_VECTOR_DEF(by, NB);
+	ZSL_VECTOR_DEF(bz, NB);
+	ZSL_PHY_NBODY_TREE_DEF(tree, 4 * NB);
+	ZSL_PHY_NBODY_TREE_DEF(small, 8);
+
+	nbody_fill(&x, &y, &z, &m);
+
+	rc = zsl_phy_nbody_acc(&x, &y, &z, &m, 0.1, &ax, &ay, &az);
+	zassert_true(rc == 0, NULL);
+
+	rc = zsl_phy_nbody_tree_build(&tree, &x, &y, &z, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(tree.nodes[0].n == NB, NULL);
+
+	/* An opening angle of zero visits every body. */
+	rc = zsl_phy_nbody_tree_acc(&tree, &x, &y, &z, 0.0, 0.1, &bx, &by, &bz);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < NB; i++) {
+		mag = ZSL_SQRT(ax.data[i] * ax.data[i] +
+			       ay.data[i] * ay.data[i] +
+			       az.data[i] * az.data[i]);
+		zassert_true(val_is_equal(bx.data[i], ax.data[i], 1E-4 * mag),
+			     NULL);
+		zassert_true(val_is_equal(by.data[i], ay.data[i], 1E-4 * mag),
+			     NULL);
+		zassert_true(val_is_equal(bz.data[i], az.data[i], 1E-4 * mag),
+			     NULL);
+	}
+
+	/* A typical opening angle is within 1% overall. */
+	rc = zsl_phy_nbody_tree_acc(&tree, &x, &y, &z, 0.5, 0.1, &bx, &by, &bz);
+	zassert_true(rc == 0, NULL);
+	mag = err = 0.0;
+	for (size_t i = 0; i < NB; i++) {
+		mag += ax.data[i] * ax.data[i] + ay.data[i] * ay.data[i] +
+		       az.data[i] * az.data[i];
+		err += (bx.data[i] - ax.data[i]) * (bx.data[i] - ax.data[i]) +
+		       (by.data[i] - ay.data[i]) * (by.data[i] - ay.data[i]) +
+		       (bz.data[i] - az.data[i]) * (bz.data[i] - az.data[i]);
+	}
+	zassert_true(err < 1E-4 * mag, NULL);
+
+	/* The tree is too small, but can be reused once it fails. */
+	rc = zsl_phy_nbody_tree_build(&small, &x, &y, &z, &m);
+	zassert_true(rc == -ENOMEM, NULL);
+	x.sz = y.sz = z.sz = m.sz = 2;
+	ax.sz = ay.sz = az.sz = 2;
+	rc = zsl_phy_nbody_tree_build(&small, &x, &y, &z, &m);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_nbody_tree_acc(&small, &x, &y, &z, 0.5, 0.0,
+				    &ax, &ay, &az);
+	zassert_true(rc == 0, NULL);
+	/* Equal and opposite forces. */
+	zassert_true(val_is_equal(ax.data[0] * m.data[0] /
+				  (ax.data[1] * m.data[1]), -1.0, 1E-5), NULL);
+
+	/* Coincident bodies are merged at the maximum depth. */
+	x.data[1] = x.data[0];
+	y.data[1] = y.data[0];
+	z.data[1] = z.data[0];
+	rc = zsl_phy_nbody_tree_build(&tree, &x, &y, &z, &m);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_phy_nbody_tree_acc(&tree, &x, &y, &z, 0.5, 0.0,
+				    &ax, &ay, &az);
+	zassert_true(rc == 0, NULL);
+	zassert_true(ax.data[0] == 0.0 && ax.data[1] == 0.0, NULL);
+}
@@ -160,6 +160,97 @@ void test_phy_proj_trajectory(void)
 	zassert_true(yf != yf, NULL);
 }
 
+void test_phy_proj_trajectory_vec(void)
+{
+	int rc;
+	zsl_real_t y;
+
+	ZSL_VECTOR_DEF(xf, 4);
+	ZSL_VECTOR_DEF(yf, 4);
+	ZSL_VECTOR_DEF(yx, 3);
+
+	zsl_real_t x[4] = { 10.0, 12.5, 15.0, 17.0 };
+
+	zsl_vec_from_arr(&xf, x);
+
+	/* Matches the scalar version. */
+	rc = zsl_phy_proj_trajectory_vec(5.0, 4.0, 10.0, 12.0, &xf, &yf);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zsl_phy_proj_trajectory(5.0, 4.0, 10.0, 12.0, x[i], &y);
+		zassert_true(val_is_equal(yf.data[i], y, 1E-6), NULL);
+	}
+	zassert_true(val_is_equal(yf.data[2], 11.0965, 1E-6), NULL);
+
+	/* Only the position behind the launching point is NAN, in place. */
+	xf.data[0] = 5.0;
+	rc = zsl_phy_proj_trajectory_vec(5.0, 4.0, 10.0, 12.0, &xf, &xf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(xf.data[0] != xf.data[0], NULL);
+	zassert_true(val_is_equal(xf.data[2], 11.0965, 1E-6), NULL);
+
+	/* Example where the horizontal velocity is zero. */
+	zsl_vec_from_arr(&xf, x);
+	rc = zsl_phy_proj_trajectory_vec(0.0, 4.0, 10.0, 12.0, &xf, &yf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(yf.data[3] != yf.data[3], NULL);
+
+	/* Mismatched sizes. */
+	rc = zsl_phy_proj_trajectory_vec(5.0, 4.0, 10.0, 12.0, &xf, &yx);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_phy_proj_trajectory_drag(void)
+{
+	int rc;
+	zsl_real_t y;
+
+	ZSL_VECTOR_DEF(xf, 5);
+	ZSL_VECTOR_DEF(yf, 5);
+
+	zsl_real_t x[5] = { 9.0, 10.0, 12.5, 15.0, 17.0 };
+
+	zsl_vec_from_arr(&xf, x);
+
+	/* Without drag, this is the parabola, except behind the launch. */
+	rc = zsl_phy_proj_trajectory_drag(5.0, 4.0, 10.0, 12.0, 0.0, 0.05,
+					  100, &xf, &yf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(yf.data[0] != yf.data[0], NULL);
+	for (size_t i = 1; i < 5; i++) {
+		zsl_phy_proj_trajectory(5.0, 4.0, 10.0, 12.0, x[i], &y);
+		zassert_true(val_is_equal(yf.data[i], y, 1E-4), NULL);
+	}
+
+	/* Drag brings the object down sooner, computed in place. */
+	rc = zsl_phy_proj_trajectory_drag(5.0, 4.0, 10.0, 12.0, 0.05, 0.01,
+					  1000, &xf, &xf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(xf.data[1], 12.0, 1E-6), NULL);
+	for (size_t i = 2; i < 5; i++) {
+		zsl_phy_proj_trajectory(5.0, 4.0, 10.0, 12.0, x[i], &y);
+		zassert_true(xf.data[i] < y, NULL);
+	}
+
+	/* Positions beyond the last step are NAN. */
+	zsl_vec_from_arr(&xf, x);
+	rc = zsl_phy_proj_trajectory_drag(5.0, 4.0, 10.0, 12.0, 0.0, 0.1,
+					  9, &xf, &yf);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(yf.data[2], 12.0 + 2.0 - 9.807 * 0.125,
+				  1E-4), NULL);
+	zassert_true(yf.data[3] != yf.data[3], NULL);
+	zassert_true(yf.data[4] != yf.data[4], NULL);
+
+	/* A non-positive horizontal velocity or step is rejected. */
+	rc = zsl_phy_proj_trajectory_drag(0.0, 4.0, 10.0, 12.0, 0.0, 0.1,
+					  10, &xf, &yf);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_phy_proj_trajectory_drag(5.0, 4.0, 10.0, 12.0, 0.0, 0.0,
+					  10, &xf, &yf);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_phy_proj_vel(void)
 {
 	int rc;
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/physics/relativity.h>
+#include "floatcheck.h"
+
+void test_phy_rel_gamma(void)
+{
+	int rc;
+	zsl_real_t g;
+	zsl_real_t c = ZSL_LIGHT_SPEED;
+
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(o, 4);
+
+	zsl_real_t a[4] = { 0.0, 0.6 * c, -0.8 * c, 1.2 * c };
+
+	rc = zsl_phy_rel_gamma(0.6 * c, &g);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(g, 1.25, 1E-6), NULL);
+
+	zsl_vec_from_arr(&v, a);
+	rc = zsl_phy_rel_gamma_vec(&v, &o);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(o.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[1], 1.25, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[2], 5.0 / 3.0, 1E-6), NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(o.data[3] != o.data[3], NULL);
+
+	/* Time dilation and length contraction. */
+	rc = zsl_phy_rel_time_dil_vec(2.0, &v, &o);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(o.data[1], 2.5, 1E-6), NULL);
+	rc = zsl_phy_rel_length_cont_vec(2.0, &v, &o);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(o.data[1], 1.6, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[2], 1.2, 1E-6), NULL);
+
+	/* Example for faster than light. */
+	rc = zsl_phy_rel_gamma(1.01 * c, &g);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(g != g, NULL);
+}
+
+void test_phy_rel_ener(void)
+{
+	int rc;
+	zsl_real_t e;
+	zsl_real_t c = ZSL_LIGHT_SPEED;
+
+	ZSL_VECTOR_DEF(v, 3);
+	ZSL_VECTOR_DEF(o, 3);
+
+	zsl_real_t a[3] = { 30.0, 0.6 * c, -0.6 * c };
+
+	zsl_vec_from_arr(&v, a);
+
+	/* Matches 0.5 * m * v^2 at everyday speeds. */
+	rc = zsl_phy_rel_kin_ener_vec(2.0, &v, &o);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(o.data[0] / 900.0, 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[1] / (0.5 * c * c), 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[2], o.data[1], 1E-6), NULL);
+
+	rc = zsl_phy_rel_mom_vec(2.0, &v, &o);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(o.data[1] / (1.5 * c), 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(o.data[2] / (-1.5 * c), 1.0, 1E-6), NULL);
+
+	rc = zsl_phy_rel_mass_ener(1E-3, &e);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(e / (1E-3 * c * c), 1.0, 1E-6), NULL);
+
+	/* Example for a negative mass. */
+	rc = zsl_phy_rel_mass_ener(-1.0, &e);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(e != e, NULL);
+}
+
+void test_phy_rel_vel_add_vec(void)
+{
+	int rc;
+	zsl_real_t c = ZSL_LIGHT_SPEED;
+
+	ZSL_VECTOR_DEF(u, 3);
+	ZSL_VECTOR_DEF(w, 3);
+
+	zsl_real_t a[3] = { 0.5 * c, 0.0, -0.5 * c };
+
+	zsl_vec_from_arr(&u, a);
+	rc = zsl_phy_rel_vel_add_vec(&u, 0.5 * c, &w);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(w.data[0] / c, 0.8, 1E-6), NULL);
+	zassert_true(val_is_equal(w.data[1] / c, 0.5, 1E-6), NULL);
+	zassert_true(val_is_equal(w.data[2] / c, 0.0, 1E-6), NULL);
+
+	/* In place. */
+	rc = zsl_phy_rel_vel_add_vec(&u, 0.5 * c, &u);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(u.data[0] / c, 0.8, 1E-6), NULL);
+}
+
+void test_phy_rel_doppler_vec(void)
+{
+	int rc;
+	zsl_real_t c = ZSL_LIGHT_SPEED;
+
+	ZSL_VECTOR_DEF(f0, 2);
+	ZSL_VECTOR_DEF(f, 2);
+
+	zsl_real_t a[2] = { 2.4E9, 5.8E9 };
+
+	zsl_vec_from_arr(&f0, a);
+
+	/* Receding at 0.6c halves the frequency. */
+	rc = zsl_phy_rel_doppler_vec(&f0, 0.6 * c, &f);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(f.data[0] / 1.2E9, 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(f.data[1] / 2.9E9, 1.0, 1E-6), NULL);
+
+	/* Approaching doubles it. */
+	rc = zsl_phy_rel_doppler_vec(&f0, -0.6 * c, &f);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(f.data[0] / 4.8E9, 1.0, 1E-6), NULL);
+
+	/* Example for faster than light. */
+	rc = zsl_phy_rel_doppler_vec(&f0, -1.01 * c, &f);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(f.data[0] != f.data[0], NULL);
+}
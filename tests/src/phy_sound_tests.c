@@ -8,6 +8,7 @@
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
 #include <zsl/vectors.h>
+#include <zsl/fastmath.h>
 #include <zsl/physics/sound.h>
 #include "floatcheck.h"
 
@@ -174,3 +175,135 @@ void test_phy_sound_beat(void)
 	/* IEEE standard states that x != x is true only for NAN values. */
 	zassert_true(f != f, NULL);
 }
+
+void test_phy_sound_speed_air(void)
+{
+	int rc;
+	zsl_real_t rh = 0.5;
+	zsl_real_t v;
+
+	rc = zsl_phy_sound_speed_air(293.15, 101325.0, 0.0, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(v, 343.2304776, 1E-4), NULL);
+
+	/* Water vapour is lighter than air, so sound travels faster. */
+	rc = zsl_phy_sound_speed_air_fn(293.15, 101325.0, &rh, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(v, 343.8711922, 1E-4), NULL);
+
+	/* Example for negative temperature. */
+	rc = zsl_phy_sound_speed_air(-293.15, 101325.0, 0.0, &v);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(v != v, NULL);
+}
+
+void test_phy_sound_level_block(void)
+{
+	int rc;
+	zsl_real_t i, lvl, i1, lvl1;
+
+	ZSL_VECTOR_DEF(p, 1024);
+
+	/* A 1 Pa amplitude sine wave over whole periods. */
+	for (size_t k = 0; k < p.sz; k++) {
+		p.data[k] = ZSL_SIN(2.0 * ZSL_PI * (zsl_real_t)k / 64.0);
+	}
+
+	/* Air, with a bulk modulus of 1.42E5 Pa and density of 1.2 kg/m^3. */
+	rc = zsl_phy_sound_level_block(&p, 1.42E5, 1.2, 1E-12, &i, &lvl);
+	zassert_true(rc == 0, NULL);
+
+	/* Matches the single value functions with the amplitude. */
+	zsl_phy_sound_intensity(1.42E5, 1.2, 1.0, &i1);
+	zsl_phy_sound_level(i1, 1E-12, &lvl1);
+	zassert_true(val_is_equal(i, i1, 1E-8), NULL);
+	zassert_true(val_is_equal(lvl, lvl1, 1E-4), NULL);
+
+	/* Silence. */
+	zsl_vec_init(&p);
+	rc = zsl_phy_sound_level_block(&p, 1.42E5, 1.2, 1E-12, &i, &lvl);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(i, 0.0, 1E-12), NULL);
+	zassert_true(lvl < -1E30, NULL);
+
+	/* Example for a zero density. */
+	rc = zsl_phy_sound_level_block(&p, 1.42E5, 0.0, 1E-12, &i, &lvl);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(lvl != lvl, NULL);
+
+	/* The fast log10 over a wide range of intensities. */
+	for (zsl_real_t x = 1.7E-12; x < 1E12; x *= 1.37) {
+		zassert_true(val_is_equal(zsl_fast_log10(x), ZSL_LOG10(x),
+					  1E-6), NULL);
+	}
+}
+
+void test_phy_sound_level_blocks(void)
+{
+	int rc;
+	zsl_real_t i, lvl1;
+	struct zsl_vec blk;
+
+	ZSL_VECTOR_DEF(p, 4 * 256);
+	ZSL_VECTOR_DEF(lvl, 4);
+	ZSL_VECTOR_DEF(bad, 3);
+
+	/* Four blocks of sine waves, each ten times quieter than the last. */
+	for (size_t k = 0; k < p.sz; k++) {
+		p.data[k] = ZSL_POW(0.1, (zsl_real_t)(k / 256)) *
+			    ZSL_SIN(2.0 * ZSL_PI * (zsl_real_t)k / 32.0);
+	}
+
+	rc = zsl_phy_sound_level_blocks(&p, 256, 1.42E5, 1.2, 1E-12, &lvl);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t n = 0; n < 4; n++) {
+		blk.sz = 256;
+		blk.data = &p.data[n * 256];
+		zsl_phy_sound_level_block(&blk, 1.42E5, 1.2, 1E-12, &i, &lvl1);
+		zassert_true(val_is_equal(lvl.data[n], lvl1, 1E-4), NULL);
+		if (n > 0) {
+			zassert_true(val_is_equal(lvl.data[n - 1] - lvl.data[n],
+						  20.0, 1E-3), NULL);
+		}
+	}
+
+	/* Example for an output that doesn't match the number of blocks. */
+	rc = zsl_phy_sound_level_blocks(&p, 256, 1.42E5, 1.2, 1E-12, &bad);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_phy_sound_dop_effect_vec(void)
+{
+	int rc;
+	zsl_real_t fl;
+
+	ZSL_VECTOR_DEF(vs, 3);
+	ZSL_VECTOR_DEF(vl, 3);
+	ZSL_VECTOR_DEF(f, 3);
+
+	zsl_real_t a[3] = { 10.0, -25.0, 0.0 };
+	zsl_real_t b[3] = { 0.0, 5.0, -343.0 };
+
+	zsl_vec_from_arr(&vs, a);
+	zsl_vec_from_arr(&vl, b);
+
+	/* The last receptor moves away at the speed of sound. */
+	rc = zsl_phy_sound_dop_effect_vec(343.0, &vs, &vl, 440.0, &f);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < 3; k++) {
+		zsl_phy_sound_dop_effect(343.0, a[k], b[k], 440.0, &fl);
+		zassert_true(val_is_equal(f.data[k], fl, 1E-6), NULL);
+	}
+
+	/* Example for a receptor that outruns the sound. */
+	vl.data[2] = -400.0;
+	rc = zsl_phy_sound_dop_effect_vec(343.0, &vs, &vl, 440.0, &f);
+	zassert_true(rc == -EINVAL, NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(f.data[2] != f.data[2], NULL);
+	zassert_true(val_is_equal(f.data[0], 440.0 * 343.0 / 353.0, 1E-4),
+		     NULL);
+}
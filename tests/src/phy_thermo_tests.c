@@ -47,6 +47,32 @@ void test_phy_thermo_cels_kel(void)
 #endif
 }
 
+void test_phy_thermo_cels_kel_vec(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(t, 3);
+	ZSL_VECTOR_DEF(tx, 2);
+
+	zsl_real_t vt[3] = { -273.15, 0.0, 25.0 };
+
+	zsl_vec_from_arr(&t, vt);
+
+	/* Celcius to kelvin and back, in place. */
+	rc = zsl_phy_thermo_cels_kel_vec(&t, &t, false);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(t.data[0], 0.0, 1E-4), NULL);
+	zassert_true(val_is_equal(t.data[2], 298.15, 1E-4), NULL);
+	rc = zsl_phy_thermo_cels_kel_vec(&t, &t, true);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(t.data[i], vt[i], 1E-4), NULL);
+	}
+
+	rc = zsl_phy_thermo_cels_kel_vec(&t, &tx, true);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_phy_thermo_heat_fusion(void)
 {
 	int rc;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/physics/waves.h>
+#include "floatcheck.h"
+
+void test_phy_wave_len_vec(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(f, 3);
+	ZSL_VECTOR_DEF(l, 3);
+
+	zsl_real_t a[3] = { 1E8, 3E8, 0.0 };
+
+	zsl_vec_from_arr(&f, a);
+	rc = zsl_phy_wave_len_vec(3E8, &f, &l);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(l.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(l.data[1], 1.0, 1E-6), NULL);
+	/* IEEE standard states that x != x is true only for NAN values. */
+	zassert_true(l.data[2] != l.data[2], NULL);
+}
+
+void test_phy_wave_superpose(void)
+{
+	int rc;
+	zsl_real_t t, y;
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(f, 3);
+	ZSL_VECTOR_DEF(ph, 3);
+	ZSL_VECTOR_DEF(out, 1000);
+
+	zsl_real_t ad[3] = { 1.0, 0.5, 0.25 };
+	zsl_real_t fd[3] = { 50.0, 123.0, 1000.0 };
+	zsl_real_t pd[3] = { 0.0, 1.0, -2.0 };
+
+	zsl_vec_from_arr(&a, ad);
+	zsl_vec_from_arr(&f, fd);
+	zsl_vec_from_arr(&ph, pd);
+
+	/* 1000 samples at 8 kHz, over many resyncs and a partial block. */
+	rc = zsl_phy_wave_superpose(&a, &f, &ph, 0.01, 1.0 / 8000.0, &out);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t k = 0; k < out.sz; k++) {
+		t = 0.01 + (zsl_real_t)k / 8000.0;
+		y = 0.0;
+		for (size_t j = 0; j < 3; j++) {
+			y += ad[j] * ZSL_SIN(2.0 * ZSL_PI * fd[j] * t + pd[j]);
+		}
+		zassert_true(val_is_equal(out.data[k], y, 1E-4), NULL);
+	}
+
+	/* Example for mismatched component vectors. */
+	rc = zsl_phy_wave_superpose(&a, &f, &out, 0.0, 1.0, &out);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_phy_wave_phasor_sum(void)
+{
+	int rc;
+	zsl_real_t amp, phr;
+
+	ZSL_VECTOR_DEF(a, 2);
+	ZSL_VECTOR_DEF(ph, 2);
+
+	/* Two waves in quadrature. */
+	zsl_real_t ad[2] = { 3.0, 4.0 };
+	zsl_real_t pd[2] = { 0.0, ZSL_PI / 2.0 };
+
+	zsl_vec_from_arr(&a, ad);
+	zsl_vec_from_arr(&ph, pd);
+	rc = zsl_phy_wave_phasor_sum(&a, &ph, &amp, &phr);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(amp, 5.0, 1E-6), NULL);
+	zassert_true(val_is_equal(phr, ZSL_ATAN2(4.0, 3.0), 1E-6), NULL);
+
+	/* Equal waves in antiphase cancel. */
+	a.data[1] = 3.0;
+	ph.data[1] = ZSL_PI;
+	rc = zsl_phy_wave_phasor_sum(&a, &ph, &amp, &phr);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(amp, 0.0, 1E-6), NULL);
+}
+
+void test_phy_wave_interf_vec(void)
+{
+	int rc;
+
+	ZSL_VECTOR_DEF(d, 3);
+	ZSL_VECTOR_DEF(i, 3);
+
+	zsl_real_t dd[3] = { 0.0, ZSL_PI / 2.0, ZSL_PI };
+
+	zsl_vec_from_arr(&d, dd);
+	rc = zsl_phy_wave_interf_vec(1.0, 4.0, &d, &i);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(i.data[0], 9.0, 1E-6), NULL);
+	zassert_true(val_is_equal(i.data[1], 5.0, 1E-6), NULL);
+	zassert_true(val_is_equal(i.data[2], 1.0, 1E-6), NULL);
+
+	/* Example for a negative intensity. */
+	rc = zsl_phy_wave_interf_vec(-1.0, 4.0, &d, &i);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/pipeline.h>
+#include "floatcheck.h"
+
+ZSL_PIPE_EDGE_DEF(pipe_test_in, 4, 3 * sizeof(zsl_real_t));
+ZSL_PIPE_EDGE_DEF(pipe_test_mid, 2, sizeof(zsl_real_t));
+
+/* Writes the norm of a 3-vector, skipping zero vectors. */
+static int pipe_test_norm(const void *in, void *out, void *arg)
+{
+	struct zsl_vec v = { .sz = 3, .data = (zsl_real_t *)in };
+
+	*(zsl_real_t *)out = zsl_vec_norm(&v);
+	if (*(zsl_real_t *)out == 0.0) {
+		return ZSL_PIPE_SKIP;
+	}
+
+	return 0;
+}
+
+/* Adds each input to the total at 'arg', failing on negative values. */
+static int pipe_test_sum(const void *in, void *out, void *arg)
+{
+	zsl_real_t x = *(const zsl_real_t *)in;
+
+	if (x < 0.0) {
+		return -EDOM;
+	}
+	*(zsl_real_t *)arg += x;
+
+	return 0;
+}
+
+static void pipe_test_push(zsl_real_t x, zsl_real_t y, zsl_real_t z)
+{
+	zsl_real_t *s = zsl_pipe_edge_claim(&pipe_test_in);
+
+	zassert_not_null(s, NULL);
+	s[0] = x;
+	s[1] = y;
+	s[2] = z;
+	zsl_pipe_edge_publish(&pipe_test_in);
+}
+
+void test_pipe_run(void)
+{
+	int rc;
+	zsl_real_t total = 0.0;
+	zsl_real_t *s;
+	struct zsl_pipe p;
+	struct zsl_pipe_stats st;
+	struct zsl_pipe_node norm = {
+		.name = "norm",
+		.fn = pipe_test_norm,
+		.in = &pipe_test_in,
+		.out = &pipe_test_mid,
+		.group = 0,
+	};
+	struct zsl_pipe_node sum = {
+		.name = "sum",
+		.fn = pipe_test_sum,
+		.arg = &total,
+		.in = &pipe_test_mid,
+		.group = 1,
+	};
+	struct zsl_pipe_node *nodes[] = { &norm, &sum };
+	struct zsl_pipe_node *bad[] = { &norm, &norm };
+
+	/* Two nodes can't consume the same edge. */
+	rc = zsl_pipe_init(&p, bad, 2);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_pipe_init(&p, nodes, 2);
+	zassert_true(rc == 0, NULL);
+	zassert_true(pipe_test_mid.src == 0, NULL);
+	zassert_true(pipe_test_mid.dst == 1, NULL);
+	zassert_true(pipe_test_in.src == ZSL_PIPE_EXT, NULL);
+
+	zassert_true(zsl_pipe_step(&norm) == -EAGAIN, NULL);
+	zassert_true(zsl_pipe_run(&p, 0) == 0, NULL);
+
+	/* Fill the input. The middle edge only holds two norms, so group
+	 * 0 stalls until group 1 has drained it. */
+	pipe_test_push(3.0, 4.0, 0.0);
+	pipe_test_push(0.0, 0.0, 0.0);
+	pipe_test_push(1.0, 2.0, 2.0);
+	pipe_test_push(0.0, 6.0, 8.0);
+	zassert_is_null(zsl_pipe_edge_claim(&pipe_test_in), NULL);
+	zassert_true(pipe_test_in.full == 1, NULL);
+
+	zassert_true(zsl_pipe_run(&p, 0) == 3, NULL);
+	zassert_true(norm.stats.stalls == 1, NULL);
+	zassert_true(zsl_pipe_run(&p, 1) == 2, NULL);
+	zassert_true(val_is_equal(total, 8.0, 1E-6), NULL);
+	zassert_true(zsl_pipe_run(&p, 0) == 1, NULL);
+	zassert_true(zsl_pipe_run(&p, 1) == 1, NULL);
+	zassert_true(val_is_equal(total, 18.0, 1E-6), NULL);
+
+	/* An error is counted, and the input still released. */
+	s = zsl_pipe_edge_claim(&pipe_test_mid);
+	zassert_not_null(s, NULL);
+	*s = -1.0;
+	zsl_pipe_edge_publish(&pipe_test_mid);
+	zassert_true(zsl_pipe_step(&sum) == -EDOM, NULL);
+	zassert_is_null(zsl_pipe_edge_peek(&pipe_test_mid), NULL);
+
+	rc = zsl_pipe_stats(&norm, &st, true);
+	zassert_true(rc == 0, NULL);
+	zassert_true(st.calls == 4, NULL);
+	zassert_true(st.errors == 0, NULL);
+	zassert_true(st.min <= st.max, NULL);
+	zassert_true(st.total >= st.max, NULL);
+	zassert_true(norm.stats.calls == 0, NULL);
+	zsl_pipe_stats(&sum, &st, false);
+	zassert_true(st.calls == 4, NULL);
+	zassert_true(st.errors == 1, NULL);
+}
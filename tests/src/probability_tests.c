@@ -173,6 +173,62 @@ void test_prob_normal_cdf_inv(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+void test_prob_normal_vec(void)
+{
+	int rc;
+	zsl_real_t m = 1.5, s = 2.0, ll, ref;
+
+	ZSL_VECTOR_DEF(x, 7);
+	ZSL_VECTOR_DEF(y, 7);
+	ZSL_VECTOR_DEF(z, 6);
+
+	zsl_real_t a[7] = { -4.0, -1.0, 0.0, 1.5, 2.25, 5.0, 9.0 };
+
+	rc = zsl_vec_from_arr(&x, a);
+	zassert_true(rc == 0, NULL);
+
+	/* Each batch result matches the scalar functions. */
+	rc = zsl_prob_normal_pdf_vec(&m, &s, &x, &y);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < x.sz; i++) {
+		zassert_true(val_is_equal(y.data[i],
+					  zsl_prob_normal_pdf(&m, &s, &a[i]),
+					  1E-6), NULL);
+	}
+
+	rc = zsl_prob_normal_log_lik(&m, &s, &x, &ll);
+	zassert_true(rc == 0, NULL);
+	ref = 0.0;
+	for (size_t i = 0; i < x.sz; i++) {
+		ref += ZSL_LOG(y.data[i]);
+	}
+	zassert_true(val_is_equal(ll, ref, 1E-4), NULL);
+
+	rc = zsl_prob_normal_cdf_vec(&m, &s, &x, &y);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < x.sz; i++) {
+		zassert_true(val_is_equal(y.data[i],
+					  zsl_prob_normal_cdf(&m, &s, &a[i]),
+					  1E-6), NULL);
+	}
+
+	/* The inverse takes the probabilities back to the values, in
+	 * place. */
+	rc = zsl_prob_normal_cdf_inv_vec(&m, &s, &y, &y);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < x.sz; i++) {
+		zassert_true(val_is_equal(y.data[i], a[i], 1E-3), NULL);
+	}
+
+	/* Mismatched sizes, and probabilities outside (0, 1). */
+	rc = zsl_prob_normal_pdf_vec(&m, &s, &x, &z);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_prob_normal_cdf_vec(&m, &s, &x, &z);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_prob_normal_cdf_inv_vec(&m, &s, &x, &y);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_prob_entropy(void)
 {
 	zsl_real_t rc;
@@ -198,4 +254,136 @@ void test_prob_entropy(void)
 	/* Compute the entropy of vb. It should return an error */
 	rc = zsl_prob_entropy(&vb, &h);
 	zassert_true(rc == -EINVAL, NULL);	
-}
\ No newline at end of file
+}
+void test_prob_hist(void)
+{
+	int rc;
+	size_t bin;
+	zsl_real_t h, e;
+
+	ZSL_PROB_HIST_DEF(hu, 4);
+	ZSL_PROB_HIST_DEF(hc, 3);
+	ZSL_VECTOR_DEF(p, 4);
+	ZSL_VECTOR_DEF(x, 10);
+	ZSL_VECTOR_DEF(edges, 4);
+
+	zsl_real_t xa[10] = { 0.0, 0.1, 0.3, 0.5, 0.6, 0.8, 0.99, 1.0, -0.1,
+			      0.25 };
+	zsl_real_t ea[4] = { -1.0, 0.2, 0.5, 10.0 };
+
+	zsl_vec_from_arr(&x, xa);
+	zsl_vec_from_arr(&edges, ea);
+
+	/* Uniform bins over [0, 1). */
+	rc = zsl_prob_hist_init(&hu, 0.0, 1.0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_prob_hist_feed_vec(&hu, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(hu.count.data[0], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hu.count.data[1], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hu.count.data[2], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hu.count.data[3], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hu.total, 8.0, 1E-6), NULL);
+	zassert_equal(hu.under, 1, NULL);
+	zassert_equal(hu.over, 1, NULL);
+
+	/* Four equally likely bins carry two bits. */
+	rc = zsl_prob_hist_entropy(&hu, &e);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(e, 2.0, 1E-6), NULL);
+	rc = zsl_prob_hist_pmf(&hu, &p);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_prob_entropy(&p, &h);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(h, e, 1E-6), NULL);
+
+	/* Custom bins, found by binary search. */
+	rc = zsl_prob_hist_init_edges(&hc, &edges);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_prob_hist_bin(&hc, 0.2, &bin);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(bin, 1, NULL);
+	rc = zsl_prob_hist_bin(&hc, NAN, &bin);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_prob_hist_feed_vec(&hc, &x);
+	zassert_true(val_is_equal(hc.count.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hc.count.data[1], 2.0, 1E-6), NULL);
+	zassert_true(val_is_equal(hc.count.data[2], 5.0, 1E-6), NULL);
+	zassert_equal(hc.under + hc.over, 0, NULL);
+
+	/* Empty bins don't break the entropy. */
+	zsl_prob_hist_reset(&hu);
+	rc = zsl_prob_hist_entropy(&hu, &e);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_prob_hist_feed(&hu, 0.1);
+	zsl_prob_hist_feed(&hu, 0.9);
+	rc = zsl_prob_hist_pmf(&hu, &p);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_prob_entropy(&p, &h);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(h, 1.0, 1E-6), NULL);
+
+	/* Invalid bins. */
+	rc = zsl_prob_hist_init(&hu, 1.0, 1.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_prob_hist_init_edges(&hu, &edges);
+	zassert_true(rc == -EINVAL, NULL);
+	edges.data[2] = edges.data[1];
+	rc = zsl_prob_hist_init_edges(&hc, &edges);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_prob_hist2(void)
+{
+	int rc;
+	zsl_real_t mi, hx, hy;
+
+	ZSL_PROB_HIST2_DEF(h, 4, 4);
+	ZSL_VECTOR_DEF(a, 8);
+	ZSL_VECTOR_DEF(b, 8);
+
+	zsl_real_t aa[8] = { 0.5, 1.5, 2.5, 3.5, 0.5, 1.5, 2.5, 3.5 };
+	zsl_real_t ba[8] = { 0.5, 1.5, 2.5, 3.5, 1.5, 0.5, 3.5, 2.5 };
+
+	zsl_vec_from_arr(&a, aa);
+	zsl_vec_from_arr(&b, ba);
+
+	zassert_true(zsl_prob_hist_init(&h.x, 0.0, 4.0) == 0, NULL);
+	zassert_true(zsl_prob_hist_init(&h.y, 0.0, 4.0) == 0, NULL);
+	rc = zsl_prob_hist2_reset(&h);
+	zassert_true(rc == 0, NULL);
+
+	/* Identical variables share all of their information. */
+	rc = zsl_prob_hist2_feed_vec(&h, &a, &a);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_prob_hist2_mi(&h, &mi);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mi, 2.0, 1E-6), NULL);
+
+	/* Here b gives a's bin pair but not which of the two bins. */
+	zsl_prob_hist2_reset(&h);
+	zsl_prob_hist2_feed_vec(&h, &a, &b);
+	zsl_prob_hist2_feed(&h, 5.0, 0.5);
+	zassert_equal(h.outside, 1, NULL);
+	rc = zsl_prob_hist2_mi(&h, &mi);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mi, 1.0, 1E-6), NULL);
+	zsl_prob_hist_entropy(&h.x, &hx);
+	zsl_prob_hist_entropy(&h.y, &hy);
+	zassert_true(val_is_equal(hx + hy - mi, 3.0, 1E-6), NULL);
+
+	/* Independent variables share none. */
+	zsl_prob_hist2_reset(&h);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zsl_prob_hist2_feed(&h, 0.5 + i, 0.5 + j);
+		}
+	}
+	zsl_prob_hist2_mi(&h, &mi);
+	zassert_true(val_is_equal(mi, 0.0, 1E-6), NULL);
+
+	/* Mismatched sizes. */
+	a.sz = 7;
+	rc = zsl_prob_hist2_feed_vec(&h, &a, &b);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/random.h>
+#include "floatcheck.h"
+
+/**
+ * @brief zsl_rand_seed, zsl_rand_u32 and zsl_rand_jump unit tests.
+ *
+ * This test verifies the generator against the reference xoshiro128++
+ * sequence, and checks that seeding is reproducible and that jumped
+ * generators give a different stream.
+ */
+void test_rand_u32(void)
+{
+	int rc;
+	struct zsl_rand a, b;
+	uint32_t ref[4] = { 0xc9c8548fu, 0x11ca377au, 0x0c8942f1u, 0x70439841u };
+	size_t same = 0;
+
+	rc = zsl_rand_seed(&a, 12345);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(a.s[0], 0xa9d111a0u, NULL);
+	zassert_equal(a.s[1], 0x22118258u, NULL);
+	zassert_equal(a.s[2], 0xf713f8edu, NULL);
+	zassert_equal(a.s[3], 0x346edce5u, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_equal(zsl_rand_u32(&a), ref[i], NULL);
+	}
+
+	/* The same seed gives the same sequence. */
+	zsl_rand_seed(&a, 42);
+	zsl_rand_seed(&b, 42);
+	for (size_t i = 0; i < 100; i++) {
+		zassert_equal(zsl_rand_u32(&a), zsl_rand_u32(&b), NULL);
+	}
+
+	/* A jumped copy gives a different stream. */
+	rc = zsl_rand_jump(&b);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 100; i++) {
+		if (zsl_rand_u32(&a) == zsl_rand_u32(&b)) {
+			same++;
+		}
+	}
+	zassert_true(same < 2, NULL);
+
+	/* A zero seed still gives a usable state. */
+	zsl_rand_seed(&a, 0);
+	zassert_true((a.s[0] | a.s[1] | a.s[2] | a.s[3]) != 0, NULL);
+}
+
+/**
+ * @brief zsl_rand_uniform and zsl_rand_normal unit tests.
+ *
+ * This test verifies the range and the first two moments of each
+ * distribution over a large sample.
+ */
+void test_rand_dist(void)
+{
+	struct zsl_rand r;
+	zsl_real_t x;
+	zsl_real_t sum = 0.0;
+	zsl_real_t sum2 = 0.0;
+	size_t n = 20000;
+	size_t tail = 0;
+
+	zsl_rand_seed(&r, 7);
+
+	for (size_t i = 0; i < n; i++) {
+		x = zsl_rand_uniform(&r);
+		zassert_true(x >= 0.0 && x < 1.0, NULL);
+		sum += x;
+		sum2 += x * x;
+	}
+	sum /= n;
+	sum2 = sum2 / n - sum * sum;
+	zassert_true(val_is_equal(sum, 0.5, 0.01), NULL);
+	zassert_true(val_is_equal(sum2, 1.0 / 12.0, 0.005), NULL);
+
+	sum = 0.0;
+	sum2 = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		x = zsl_rand_normal(&r);
+		sum += x;
+		sum2 += x * x;
+		if (x > 1.96 || x < -1.96) {
+			tail++;
+		}
+	}
+	sum /= n;
+	sum2 = sum2 / n - sum * sum;
+	zassert_true(val_is_equal(sum, 0.0, 0.03), NULL);
+	zassert_true(val_is_equal(sum2, 1.0, 0.05), NULL);
+
+	/* About 5% of samples lie beyond 1.96 standard deviations. */
+	zassert_true(tail > n * 4 / 100 && tail < n * 6 / 100, NULL);
+}
+
+/**
+ * @brief zsl_rand_vec_*, zsl_rand_mtx_* and zsl_mtx_entry_fn_random unit
+ *        tests.
+ *
+ * This test verifies that the fills cover every entry within the requested
+ * bounds.
+ */
+void test_rand_fill(void)
+{
+	int rc;
+	struct zsl_rand r;
+	zsl_real_t sum = 0.0;
+
+	ZSL_VECTOR_DEF(v, 500);
+	ZSL_MATRIX_DEF(m, 20, 25);
+
+	zsl_rand_seed(&r, 99);
+
+	rc = zsl_rand_vec_uniform(&r, &v, -2.0, 3.0);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < v.sz; i++) {
+		zassert_true(v.data[i] >= -2.0 && v.data[i] < 3.0, NULL);
+	}
+
+	rc = zsl_rand_vec_normal(&r, &v, 10.0, 0.5);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < v.sz; i++) {
+		sum += v.data[i];
+	}
+	zassert_true(val_is_equal(sum / v.sz, 10.0, 0.1), NULL);
+
+	rc = zsl_rand_mtx_uniform(&r, &m, 5.0, 6.0);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < m.sz_rows * m.sz_cols; i++) {
+		zassert_true(m.data[i] >= 5.0 && m.data[i] < 6.0, NULL);
+	}
+
+	sum = 0.0;
+	rc = zsl_rand_mtx_normal(&r, &m, -1.0, 2.0);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < m.sz_rows * m.sz_cols; i++) {
+		sum += m.data[i];
+	}
+	zassert_true(val_is_equal(sum / 500.0, -1.0, 0.3), NULL);
+
+	/* The entry function gives distinct values in [-1.0, 1.0). */
+	rc = zsl_mtx_init(&m, zsl_mtx_entry_fn_random);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < m.sz_rows * m.sz_cols; i++) {
+		zassert_true(m.data[i] >= -1.0 && m.data[i] < 1.0, NULL);
+	}
+	zassert_true(m.data[0] != m.data[1], NULL);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/sensor.h>
+#include <zsl/measurement/batch.h>
+#include "floatcheck.h"
+
+void test_sns_conv(void)
+{
+	int rc;
+	zsl_real_t out[7];
+	zsl_real_t buf[12];
+	/* Laid out as struct sensor_value, with val2 taking val1's sign. */
+	const int32_t val[14] = {
+		0, 0,           1, 500000,      -1, -500000,    9, 806650,
+		0, -250000,     -12, -1,        2000, 999999
+	};
+	const zsl_real_t exp[7] = {
+		0.0, 1.5, -1.5, 9.80665, -0.25, -12.000001, 2000.999999
+	};
+	struct zsl_measurement mes;
+	struct zsl_vec v;
+
+	/* Contiguous output, covering the unrolled loop and its tail. */
+	rc = zsl_sns_conv(val, 7, out, 1);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 7; i++) {
+		zassert_true(val_is_equal(out[i], exp[i], 1E-4), NULL);
+	}
+
+	/* Three values written as sample 2 of a 3 channel, 4 sample batch. */
+	memset(&mes, 0, sizeof(mes));
+	rc = zsl_mes_batch_init(&mes, buf, sizeof(buf), 3, 2);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sns_conv(&val[2], 3, (zsl_real_t *)mes.payload + 2, 4);
+	zassert_true(rc == 0, NULL);
+	for (size_t ch = 0; ch < 3; ch++) {
+		rc = zsl_mes_batch_vec(&mes, ch, &v);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(v.data[2], exp[ch + 1], 1E-6), NULL);
+		zassert_true(v.data[1] == 0.0, NULL);
+		zassert_true(v.data[3] == 0.0, NULL);
+	}
+
+	/* Nothing to convert. */
+	rc = zsl_sns_conv(val, 0, out, 1);
+	zassert_true(rc == 0, NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_sns_conv(val, 7, out, 0);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/smp.h>
+#include "floatcheck.h"
+
+/* Counts how many times each item is visited. */
+static void smp_count(void *arg, size_t start, size_t end)
+{
+	int *count = arg;
+
+	for (size_t i = start; i < end; i++) {
+		count[i]++;
+	}
+}
+
+/**
+ * @brief zsl_smp_for unit tests.
+ *
+ * This test verifies that every item is visited exactly once, whether or
+ * not the job is split across the worker pool.
+ */
+void test_smp_for(void)
+{
+	int rc;
+	int count[37];
+
+	/* Small and large jobs. */
+	memset(count, 0, sizeof(count));
+	rc = zsl_smp_for(smp_count, count, 37, 0);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_equal(count[i], 1, NULL);
+	}
+
+	memset(count, 0, sizeof(count));
+	rc = zsl_smp_for(smp_count, count, 37, (size_t)-1);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 37; i++) {
+		zassert_equal(count[i], 1, NULL);
+	}
+
+	/* Fewer items than threads, and no items at all. */
+	memset(count, 0, sizeof(count));
+	rc = zsl_smp_for(smp_count, count, 1, (size_t)-1);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(count[0], 1, NULL);
+	rc = zsl_smp_for(smp_count, count, 0, (size_t)-1);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(count[0], 1, NULL);
+}
+
+/**
+ * @brief Large zsl_mtx_mult, zsl_mtx_mult_ex and zsl_mtx_qrd unit tests.
+ *
+ * These matrices are above the default CONFIG_ZSL_SMP_THRESHOLD, so the
+ * results are checked against a naive product when the work is split.
+ */
+void test_smp_mtx(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(ma, 40, 36);
+	ZSL_MATRIX_DEF(mb, 36, 33);
+	ZSL_MATRIX_DEF(mc, 40, 33);
+	ZSL_MATRIX_DEF(mt, 36, 36);
+	ZSL_MATRIX_DEF(q, 40, 40);
+	ZSL_MATRIX_DEF(r, 40, 36);
+	ZSL_MATRIX_DEF(qr, 40, 36);
+
+	for (size_t i = 0; i < 40 * 36; i++) {
+		ma.data[i] = (zsl_real_t)((i * 7) % 13) - 6.0;
+	}
+	for (size_t i = 0; i < 36 * 33; i++) {
+		mb.data[i] = (zsl_real_t)((i * 5) % 11) * 0.25 - 1.0;
+	}
+
+	rc = zsl_mtx_mult(&ma, &mb, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 40; i++) {
+		for (size_t j = 0; j < 33; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < 36; k++) {
+				x += ma.data[i * 36 + k] * mb.data[k * 33 + j];
+			}
+			zassert_true(val_is_equal(mc.data[i * 33 + j], x, 1E-4),
+				     NULL);
+		}
+	}
+
+	/* The transposed product, as used for Gram matrices. */
+	rc = zsl_mtx_mult_ex(&ma, true, &ma, false, 0.5, 0.0, &mt);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 36; i++) {
+		for (size_t j = 0; j < 36; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < 40; k++) {
+				x += ma.data[k * 36 + i] * ma.data[k * 36 + j];
+			}
+			zassert_true(val_is_equal(mt.data[i * 36 + j], 0.5 * x,
+						  1E-4), NULL);
+		}
+	}
+
+	/* Q * R must reproduce the input. */
+	rc = zsl_mtx_qrd(&ma, &q, &r, false);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_mult(&q, &r, &qr);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 40 * 36; i++) {
+		zassert_true(val_is_equal(qr.data[i], ma.data[i], 1E-3), NULL);
+	}
+}
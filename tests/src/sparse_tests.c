@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/sparse.h>
+#include <zsl/workspace.h>
+#include "floatcheck.h"
+
+/* A 4x5 test matrix, with 8 of 20 entries non-zero. */
+static zsl_real_t sp_a[20] = {
+	2.0, 0.0, 0.0, -1.0, 0.0,
+	0.0, 0.0, 3.5, 0.0, 0.0,
+	1.0, 0.0, 0.0, 0.0, 4.0,
+	0.0, -2.0, 0.5, 0.0, 1.5
+};
+
+/**
+ * @brief zsl_spmtx_from_mtx, zsl_spmtx_to_mtx and zsl_spmtx_get unit tests.
+ *
+ * This test verifies conversion between dense and sparse matrices.
+ */
+void test_spmtx_conv(void)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mc, 4, 5);
+	ZSL_SPMATRIX_DEF(sp, 4, 5, 10);
+	ZSL_SPMATRIX_DEF(small, 4, 5, 6);
+	ZSL_SPMATRIX_DEF(bad, 5, 4, 10);
+
+	zsl_mtx_from_arr(&m, sp_a);
+	zsl_spmtx_init(&sp);
+	zassert_equal(zsl_spmtx_nnz(&sp), 0, NULL);
+
+	rc = zsl_spmtx_from_mtx(&m, 0.0, &sp);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_spmtx_nnz(&sp), 8, NULL);
+	zassert_equal(sp.row_ptr[1], 2, NULL);
+	zassert_equal(sp.row_ptr[2], 3, NULL);
+	zassert_equal(sp.col_idx[7], 4, NULL);
+
+	/* Every entry reads back, including the implicit zeros. */
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			rc = zsl_spmtx_get(&sp, i, j, &x);
+			zassert_equal(rc, 0, NULL);
+			zassert_true(x == sp_a[i * 5 + j], NULL);
+		}
+	}
+	rc = zsl_spmtx_get(&sp, 4, 0, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Round trip back to a dense matrix. */
+	zsl_mtx_init(&mc, zsl_mtx_entry_fn_identity);
+	rc = zsl_spmtx_to_mtx(&sp, &mc);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&m, &mc), NULL);
+
+	/* Entries at or below the tolerance are dropped. */
+	rc = zsl_spmtx_from_mtx(&m, 1.0, &sp);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_spmtx_nnz(&sp), 5, NULL);
+
+	/* Not enough room, or the wrong shape. */
+	rc = zsl_spmtx_from_mtx(&m, 0.0, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(zsl_spmtx_nnz(&small), 0, NULL);
+	rc = zsl_spmtx_from_mtx(&m, 0.0, &bad);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief Sparse matrix functions with read-only dense inputs.
+ *
+ * This test verifies that matrices and vectors declared with
+ * ZSL_MATRIX_CONST_DEF and ZSL_VECTOR_CONST_DEF can be passed directly to
+ * the input-only parameters of the sparse matrix functions.
+ */
+void test_spmtx_const(void)
+{
+	int rc;
+
+	ZSL_MATRIX_CONST_DEF(mc, 3, 3, 4.0, 1.0, 0.0,
+				       1.0, 3.0, 0.0,
+				       0.0, 0.0, 2.0);
+	ZSL_VECTOR_CONST_DEF(vc, 3, 1.0, 2.0, 3.0);
+	ZSL_SPMATRIX_DEF(sp, 3, 3, 9);
+	ZSL_MATRIX_DEF(mp, 3, 3);
+	ZSL_MATRIX_DEF(mr, 3, 3);
+	ZSL_VECTOR_DEF(w, 3);
+	ZSL_VECTOR_DEF(x, 3);
+
+	rc = zsl_spmtx_from_mtx(&mc, 0.0, &sp);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_spmtx_nnz(&sp), 5, NULL);
+
+	rc = zsl_spmtx_mult_vec(&sp, &vc, &w);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(w.data[0], 6.0, 1E-6), NULL);
+	zassert_true(val_is_equal(w.data[1], 7.0, 1E-6), NULL);
+	zassert_true(val_is_equal(w.data[2], 6.0, 1E-6), NULL);
+
+	rc = zsl_spmtx_mult_trans_vec(&sp, &vc, &w);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(w.data[1], 7.0, 1E-6), NULL);
+
+	rc = zsl_spmtx_mult_mtx(&sp, &mc, &mp);
+	zassert_equal(rc, 0, NULL);
+	zsl_mtx_mult(&mc, &mc, &mr);
+	zassert_true(zsl_mtx_is_equal(&mp, &mr), NULL);
+
+	/* Solve sp * x = vc, then check the residual. */
+	zsl_vec_init(&x);
+	rc = zsl_spmtx_cg(&sp, &vc, &x, 1E-6, 10);
+	zassert_equal(rc, 0, NULL);
+	zsl_spmtx_mult_vec(&sp, &x, &w);
+	zassert_true(zsl_vec_is_equal(&w, &vc, 1E-4), NULL);
+}
+
+/**
+ * @brief zsl_spmtx_mult_vec and zsl_spmtx_mult_trans_vec unit tests.
+ *
+ * This test verifies sparse matrix-vector products against the dense
+ * results.
+ */
+void test_spmtx_mult_vec(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_SPMATRIX_DEF(sp, 4, 5, 8);
+	ZSL_VECTOR_DEF(v, 5);
+	ZSL_VECTOR_DEF(w, 4);
+	ZSL_VECTOR_DEF(u, 5);
+
+	zsl_real_t a[5] = { 1.0, 2.0, -1.0, 0.5, 3.0 };
+	zsl_real_t b[4] = { 1.0, -1.0, 2.0, 0.5 };
+
+	/* sp * a, and sp^T * b. */
+	zsl_real_t ab[4] = { 1.5, -3.5, 13.0, 0.0 };
+	zsl_real_t atb[5] = { 4.0, -1.0, -3.25, -1.0, 8.75 };
+
+	zsl_mtx_from_arr(&m, sp_a);
+	zsl_spmtx_init(&sp);
+	zsl_spmtx_from_mtx(&m, 0.0, &sp);
+
+	zsl_vec_from_arr(&v, a);
+	rc = zsl_spmtx_mult_vec(&sp, &v, &w);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(w.data[i], ab[i], 1E-6), NULL);
+	}
+
+	zsl_vec_from_arr(&w, b);
+	rc = zsl_spmtx_mult_trans_vec(&sp, &w, &u);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		zassert_true(val_is_equal(u.data[i], atb[i], 1E-6), NULL);
+	}
+
+	/* Size mismatches. */
+	rc = zsl_spmtx_mult_vec(&sp, &w, &w);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_spmtx_mult_trans_vec(&sp, &v, &u);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_spmtx_mult, zsl_spmtx_mult_mtx and zsl_spmtx_trans unit tests.
+ *
+ * This test verifies sparse matrix-matrix products and transposes against
+ * the dense equivalents.
+ */
+void test_spmtx_mult(void)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(m, 4, 5);
+	ZSL_MATRIX_DEF(mt, 5, 4);
+	ZSL_MATRIX_DEF(mtm, 5, 5);
+	ZSL_MATRIX_DEF(mmt, 4, 4);
+	ZSL_MATRIX_DEF(res, 5, 5);
+	ZSL_MATRIX_DEF(res2, 4, 4);
+	ZSL_SPMATRIX_DEF(sp, 4, 5, 8);
+	ZSL_SPMATRIX_DEF(spt, 5, 4, 8);
+	ZSL_SPMATRIX_DEF(sptsp, 5, 5, 25);
+	ZSL_SPMATRIX_DEF(small, 5, 5, 4);
+	ZSL_SPMATRIX_DEF(bad, 4, 4, 8);
+
+	zsl_mtx_from_arr(&m, sp_a);
+	zsl_mtx_trans(&m, &mt);
+	zsl_mtx_mult(&mt, &m, &mtm);
+	zsl_mtx_mult(&m, &mt, &mmt);
+	zsl_spmtx_init(&sp);
+	zsl_spmtx_from_mtx(&m, 0.0, &sp);
+
+	/* Transpose, with sorted columns in each output row. */
+	rc = zsl_spmtx_trans(&sp, &spt);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_spmtx_nnz(&spt), 8, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t k = spt.row_ptr[i] + 1; k < spt.row_ptr[i + 1];
+		     k++) {
+			zassert_true(spt.col_idx[k - 1] < spt.col_idx[k], NULL);
+		}
+	}
+	rc = zsl_spmtx_to_mtx(&spt, &mt);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(mt.data[i * 4 + j] == sp_a[j * 5 + i],
+				     NULL);
+		}
+	}
+	rc = zsl_spmtx_trans(&sp, &bad);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Sparse * sparse, which forms the normal matrix A^T * A. */
+	zsl_spmtx_init(&sptsp);
+	rc = zsl_spmtx_mult(&spt, &sp, &sptsp);
+	zassert_equal(rc, 0, NULL);
+	zsl_spmtx_to_mtx(&sptsp, &res);
+	for (size_t i = 0; i < 25; i++) {
+		zassert_true(val_is_equal(res.data[i], mtm.data[i], 1E-6),
+			     NULL);
+	}
+	rc = zsl_spmtx_mult(&spt, &sp, &small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(zsl_spmtx_nnz(&small), 0, NULL);
+	rc = zsl_spmtx_mult(&sp, &sp, &sptsp);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* Sparse * dense. */
+	rc = zsl_spmtx_mult_mtx(&sp, &mt, &res2);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 16; i++) {
+		zassert_true(val_is_equal(res2.data[i], mmt.data[i], 1E-6),
+			     NULL);
+	}
+	rc = zsl_spmtx_mult_mtx(&sp, &m, &res2);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_spmtx_cg unit tests.
+ *
+ * This test verifies the conjugate gradient solver on a sparse, symmetric
+ * positive-definite, tridiagonal system.
+ */
+void test_spmtx_cg(void)
+{
+	int rc;
+	zsl_real_t d;
+
+	ZSL_MATRIX_DEF(m, 20, 20);
+	ZSL_SPMATRIX_DEF(sp, 20, 20, 58);
+	ZSL_VECTOR_DEF(xt, 20);
+	ZSL_VECTOR_DEF(b, 20);
+	ZSL_VECTOR_DEF(x, 20);
+	ZSL_WORKSPACE_DEF(ws, 100);
+	ZSL_WORKSPACE_DEF(ws_small, 99);
+
+	/* A 1D Laplacian with a varying diagonal, and a known solution. */
+	zsl_mtx_init(&m, NULL);
+	for (size_t i = 0; i < 20; i++) {
+		zsl_mtx_set(&m, i, i, 2.0 + 0.1 * i);
+		if (i > 0) {
+			zsl_mtx_set(&m, i, i - 1, -1.0);
+			zsl_mtx_set(&m, i - 1, i, -1.0);
+		}
+		xt.data[i] = (zsl_real_t)(i % 3) - 1.0;
+	}
+	zsl_spmtx_init(&sp);
+	rc = zsl_spmtx_from_mtx(&m, 0.0, &sp);
+	zassert_equal(rc, 0, NULL);
+	zsl_spmtx_mult_vec(&sp, &xt, &b);
+
+	zsl_vec_init(&x);
+	rc = zsl_spmtx_cg(&sp, &b, &x, 1E-6, 20);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 20; i++) {
+		zassert_true(val_is_equal(x.data[i], xt.data[i], 1E-4), NULL);
+	}
+
+	/* A zero right-hand side has a zero solution. */
+	zsl_vec_init(&b);
+	rc = zsl_spmtx_cg(&sp, &b, &x, 1E-6, 20);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 20; i++) {
+		zassert_true(x.data[i] == 0.0, NULL);
+	}
+
+	/* Too few iterations to converge. */
+	zsl_spmtx_mult_vec(&sp, &xt, &b);
+	zsl_vec_init(&x);
+	rc = zsl_spmtx_cg(&sp, &b, &x, 1E-6, 2);
+	zassert_equal(rc, -ENOCONVERGE, NULL);
+
+	/* The workspace variant. */
+	zsl_vec_init(&x);
+	rc = zsl_spmtx_cg_ws(&sp, &b, &x, 1E-6, 20, &ws_small);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(zsl_spmtx_cg_ws_sz(20), 100, NULL);
+	rc = zsl_spmtx_cg_ws(&sp, &b, &x, 1E-6, 20, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* A non-positive diagonal entry. */
+	zsl_spmtx_get(&sp, 3, 3, &d);
+	zsl_mtx_set(&m, 3, 3, -d);
+	zsl_spmtx_from_mtx(&m, 0.0, &sp);
+	rc = zsl_spmtx_cg(&sp, &b, &x, 1E-6, 20);
+	zassert_equal(rc, -ENOTPOSDEF, NULL);
+}
@@ -8,6 +8,7 @@
 #include <ztest.h>
 #include <zsl/zsl.h>
 #include <zsl/statistics.h>
+#include <zsl/workspace.h>
 #include "floatcheck.h"
 
 void test_sta_mean(void)
@@ -92,6 +93,93 @@ void test_sta_percentile(void)
 	zassert_true(val_is_equal(val, 1.0, 1E-6), NULL);
 }
 
+/* Reference percentile, computed from a fully sorted copy. */
+static zsl_real_t sta_ref_percentile(zsl_real_t *sorted, size_t n, size_t p)
+{
+	zsl_real_t x = (p * n) / 100.;
+	zsl_real_t per = ZSL_FLOOR(x);
+
+	if (x == per) {
+		return (sorted[(size_t)per] + sorted[(size_t)per - 1]) / 2.;
+	}
+
+	return sorted[(size_t)per];
+}
+
+void test_sta_percentiles(void)
+{
+	int rc;
+	zsl_real_t x;
+	zsl_real_t val[6];
+	zsl_real_t sorted[203];
+	const size_t p[6] = { 5, 25, 50, 50, 75, 99 };
+	const size_t pbad[2] = { 50, 25 };
+	uint32_t seed = 12345;
+
+	ZSL_VECTOR_DEF(v, 203);
+	ZSL_VECTOR_DEF(w, 203);
+
+	/* Pseudo-random values with plenty of repeats. */
+	for (size_t i = 0; i < v.sz; i++) {
+		seed = seed * 1103515245u + 12345u;
+		v.data[i] = (zsl_real_t)((seed >> 16) % 50) - 25.0;
+	}
+
+	/* Reference values from an insertion sort. */
+	memcpy(sorted, v.data, sizeof(sorted));
+	for (size_t i = 1; i < v.sz; i++) {
+		size_t j;
+
+		x = sorted[i];
+		for (j = i; j > 0 && sorted[j - 1] > x; j--) {
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = x;
+	}
+
+	rc = zsl_sta_percentiles(&v, p, 6, val);
+	zassert_equal(rc, 0, NULL);
+	for (size_t q = 0; q < 6; q++) {
+		x = sta_ref_percentile(sorted, v.sz, p[q]);
+		zassert_true(val_is_equal(val[q], x, 1E-6), NULL);
+	}
+
+	/* Every single percentile, in place, matches too. */
+	for (size_t q = 1; q < 100; q++) {
+		zsl_vec_copy(&w, &v);
+		rc = zsl_sta_percentile_d(&w, q, &x);
+		zassert_equal(rc, 0, NULL);
+		zassert_true(val_is_equal(x, sta_ref_percentile(sorted, v.sz,
+								 q), 1E-6),
+			     NULL);
+	}
+
+	/* Sorted and constant inputs, the worst cases for naive pivots. */
+	memcpy(w.data, sorted, sizeof(sorted));
+	rc = zsl_sta_percentiles_d(&w, p, 6, val);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(val[5], sta_ref_percentile(sorted, v.sz, 99),
+				  1E-6), NULL);
+	for (size_t i = 0; i < w.sz; i++) {
+		w.data[i] = 3.0;
+	}
+	rc = zsl_sta_percentiles_d(&w, p, 6, val);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(val[2], 3.0, 1E-6), NULL);
+
+	/* Unordered percentiles, out of range percentiles, and no data. */
+	rc = zsl_sta_percentiles(&v, pbad, 2, val);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_sta_percentile(&v, 100, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+	w.sz = 5;
+	rc = zsl_sta_percentile(&w, 0, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+	w.sz = 0;
+	rc = zsl_sta_percentile(&w, 50, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 void test_sta_median(void)
 {
 	int rc;
@@ -151,6 +239,60 @@ void test_sta_quart_range(void)
 	zassert_true(val_is_equal(r, 8.0, 1E-6), NULL);
 }
 
+void test_sta_summary(void)
+{
+	int rc;
+	zsl_real_t x, q1, q2, q3;
+	struct zsl_sta_summary sum;
+
+	ZSL_VECTOR_DEF(v, 10);
+	ZSL_WORKSPACE_DEF(ws, 10);
+
+	zsl_real_t a[10] = { 3.0, -1.5, 7.25, 0.0, 2.0, 2.0, -4.0, 9.5, 1.0,
+			     5.5 };
+
+	rc = zsl_vec_from_arr(&v, a);
+	zassert_true(rc == 0, NULL);
+
+	/* Every field matches the separate functions. */
+	rc = zsl_sta_summary(&v, &sum);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(sum.n, 10, NULL);
+	zsl_sta_mean(&v, &x);
+	zassert_true(val_is_equal(sum.mean, x, 1E-6), NULL);
+	zsl_sta_var(&v, &x);
+	zassert_true(val_is_equal(sum.var, x, 1E-5), NULL);
+	zsl_sta_sta_dev(&v, &x);
+	zassert_true(val_is_equal(sum.sta_dev, x, 1E-5), NULL);
+	zsl_sta_data_range(&v, &x);
+	zassert_true(val_is_equal(sum.range, x, 1E-6), NULL);
+	zassert_true(val_is_equal(sum.min, -4.0, 1E-6), NULL);
+	zassert_true(val_is_equal(sum.max, 9.5, 1E-6), NULL);
+	zsl_sta_quart(&v, &q1, &q2, &q3);
+	zassert_true(val_is_equal(sum.q1, q1, 1E-6), NULL);
+	zassert_true(val_is_equal(sum.median, q2, 1E-6), NULL);
+	zassert_true(val_is_equal(sum.q3, q3, 1E-6), NULL);
+	zsl_sta_quart_range(&v, &x);
+	zassert_true(val_is_equal(sum.iqr, x, 1E-6), NULL);
+
+	/* The input is left untouched, and the workspace is released. */
+	rc = zsl_sta_summary_ws(&v, &sum, &ws);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(zsl_ws_mark(&ws), 0, NULL);
+	zassert_true(val_is_equal(v.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(v.data[9], 5.5, 1E-6), NULL);
+
+	/* A single sample has no spread, and no samples are refused. */
+	v.sz = 1;
+	rc = zsl_sta_summary(&v, &sum);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(sum.var, 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(sum.median, 3.0, 1E-6), NULL);
+	v.sz = 0;
+	rc = zsl_sta_summary(&v, &sum);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 void test_sta_mode(void)
 {
 	int rc;
@@ -186,6 +328,55 @@ void test_sta_mode(void)
 	zassert_true(val_is_equal(mb.data[2], 1.5, 1E-6), NULL);
 }
 
+void test_sta_mode_ws(void)
+{
+	int rc;
+	uint32_t seed = 4096;
+	zsl_real_t lead;
+	static zsl_real_t a[4096];
+
+	static ZSL_WORKSPACE_DEF(ws, 4096);
+	ZSL_WORKSPACE_DEF(small, 100);
+	ZSL_VECTOR_DEF(m, 4);
+	ZSL_VECTOR_DEF(s, 1);
+	struct zsl_vec v = { .sz = 4096, .data = a };
+
+	/* An ADC-style histogram where codes 0 to 9 appear 400 times each,
+	 * and codes 3 and 9 another 48 times, shuffled. */
+	for (size_t i = 0; i < v.sz; i++) {
+		a[i] = (i < 4000) ? (zsl_real_t)(i % 10) : (i % 2 ? 3.0 : 9.0);
+	}
+	for (size_t i = v.sz - 1; i > 0; i--) {
+		size_t j;
+		zsl_real_t t;
+
+		seed = seed * 1103515245u + 12345u;
+		j = (seed >> 8) % (i + 1);
+		t = a[i];
+		a[i] = a[j];
+		a[j] = t;
+	}
+	lead = a[0];
+
+	rc = zsl_sta_mode_ws(&v, &m, &ws);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(m.sz, 2, NULL);
+	zassert_true(val_is_equal(m.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[1], 9.0, 1E-6), NULL);
+
+	/* The input is left as it was. */
+	zassert_true(val_is_equal(a[0], lead, 1E-6), NULL);
+
+	/* The workspace is released, and the output must fit every mode. */
+	zassert_equal(zsl_ws_mark(&ws), 0, NULL);
+	rc = zsl_sta_mode_ws(&v, &s, &ws);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The workspace must hold a full copy of the input. */
+	rc = zsl_sta_mode_ws(&v, &m, &small);
+	zassert_true(rc == -ENOMEM, NULL);
+}
+
 void test_sta_data_range(void)
 {
 	int rc;
@@ -314,6 +505,92 @@ void test_sta_covariance_matrix(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+void test_sta_covariance_stream(void)
+{
+	int rc;
+	uint32_t seed = 38;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(ma, 4, 3);
+	ZSL_MATRIX_DEF(mb, 3, 3);
+	ZSL_MATRIX_DEF(mc, 3, 3);
+	ZSL_MATRIX_DEF(mr, 3, 3);
+	ZSL_MATRIX_DEF(mbig, 200, 3);
+	ZSL_MATRIX_DEF(md, 2, 2);
+	ZSL_VECTOR_DEF(row, 3);
+	ZSL_VECTOR_DEF(vbad, 2);
+	ZSL_STA_COVAR_STREAM_DEF(cs, 3);
+
+	zsl_real_t a[12] = { -1.0, -6.5, 1.2,
+			     7.0, 5.5, 0.0,
+			     -0.5, 4.0, 6.5,
+			     -1.0, 4.0, -8.5 };
+
+	rc = zsl_mtx_from_arr(&ma, a);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_covar_mtx(&ma, &mb);
+	zassert_true(rc == 0, NULL);
+
+	/* The correlation is the covariance scaled by the deviations. */
+	rc = zsl_sta_corr_mtx(&ma, &mr);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			x = mb.data[i * 3 + j] / ZSL_SQRT(mb.data[i * 3 + i] *
+							  mb.data[j * 3 + j]);
+			zassert_true(val_is_equal(mr.data[i * 3 + j], x, 1E-6),
+				     NULL);
+		}
+	}
+	rc = zsl_sta_corr_mtx(&ma, &md);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Rows fed one at a time match the batch result. */
+	rc = zsl_sta_covar_stream_init(&cs);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_covar_stream_covar(&cs, &mc);
+	zassert_true(rc == -EINVAL, NULL);
+	for (size_t i = 0; i < ma.sz_rows; i++) {
+		zsl_mtx_get_row(&ma, i, row.data);
+		rc = zsl_sta_covar_stream_feed(&cs, &row);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_sta_covar_stream_feed(&cs, &vbad);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_covar_stream_covar(&cs, &mc);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mb, &mc), NULL);
+	rc = zsl_sta_covar_stream_corr(&cs, &mc);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_mtx_is_equal(&mr, &mc), NULL);
+	rc = zsl_sta_covar_stream_covar(&cs, &md);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* A large offset and a constant column. The first two columns are
+	 * correlated, the third has no variance. */
+	for (size_t i = 0; i < mbig.sz_rows; i++) {
+		seed = seed * 1103515245u + 12345u;
+		x = (zsl_real_t)((seed >> 16) % 100) / 10.0;
+		mbig.data[i * 3 + 0] = 1E3 + x;
+		mbig.data[i * 3 + 1] = 1E3 - 2.0 * x;
+		mbig.data[i * 3 + 2] = 5.0;
+	}
+	zsl_sta_covar_stream_init(&cs);
+	rc = zsl_sta_covar_stream_feed_mtx(&cs, &mbig);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(cs.rows, 200, NULL);
+	zsl_sta_covar_stream_covar(&cs, &mc);
+	zassert_true(val_is_equal(mc.data[1], -2.0 * mc.data[0], 1E-3), NULL);
+	zassert_true(val_is_equal(mc.data[4], 4.0 * mc.data[0], 1E-3), NULL);
+	zassert_true(val_is_equal(mc.data[8], 0.0, 1E-6), NULL);
+	rc = zsl_sta_corr_mtx(&mbig, &mr);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(mr.data[1], -1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(mr.data[3], -1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(mr.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mr.data[8], 1.0, 1E-6), NULL);
+}
+
 void test_sta_linear_regression(void)
 {
 	int rc;
@@ -360,6 +637,534 @@ void test_sta_linear_regression(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+void test_sta_mult_linear_reg(void)
+{
+	int rc;
+	zsl_real_t t;
+
+	ZSL_MATRIX_DEF(x, 8, 3);
+	ZSL_MATRIX_DEF(xd, 8, 3);
+	ZSL_VECTOR_DEF(y, 8);
+	ZSL_VECTOR_DEF(w, 8);
+	ZSL_VECTOR_DEF(beta, 3);
+	ZSL_VECTOR_DEF(b2, 2);
+	ZSL_STA_LS_STREAM_DEF(ls, 3);
+
+	/* y = 1 + 2 * x1 - 3 * x2, with column 0 as the intercept. */
+	for (size_t i = 0; i < 8; i++) {
+		x.data[i * 3 + 0] = 1.0;
+		x.data[i * 3 + 1] = (zsl_real_t)i;
+		x.data[i * 3 + 2] = (zsl_real_t)((i * 5) % 7) / 2.0;
+		y.data[i] = 1.0 + 2.0 * x.data[i * 3 + 1] -
+			    3.0 * x.data[i * 3 + 2];
+		w.data[i] = 1.0;
+	}
+
+	rc = zsl_sta_mult_linear_reg(&x, &y, NULL, &beta);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(beta.data[0], 1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[1], 2.0, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[2], -3.0, 1E-4), NULL);
+
+	/* A zero weight removes an outlier entirely. */
+	y.data[3] += 50.0;
+	w.data[3] = 0.0;
+	rc = zsl_sta_mult_linear_reg(&x, &y, &w, &beta);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(beta.data[0], 1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[1], 2.0, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[2], -3.0, 1E-4), NULL);
+
+	/* The same fit, row by row through the normal equations. */
+	rc = zsl_sta_ls_stream_init(&ls);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_ls_stream_solve(&ls, &beta);
+	zassert_true(rc == -ENOTPOSDEF, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		struct zsl_vec row = { .sz = 3, .data = &x.data[i * 3] };
+
+		rc = zsl_sta_ls_stream_feed(&ls, &row, y.data[i], w.data[i]);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_equal(ls.rows, 8, NULL);
+	rc = zsl_sta_ls_stream_solve(&ls, &beta);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(beta.data[0], 1.0, 1E-3), NULL);
+	zassert_true(val_is_equal(beta.data[1], 2.0, 1E-3), NULL);
+	zassert_true(val_is_equal(beta.data[2], -3.0, 1E-3), NULL);
+	rc = zsl_sta_ls_stream_feed(&ls, &b2, 1.0, 1.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_ls_stream_solve(&ls, &b2);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* A least squares fit through noisy data matches the simple linear
+	 * regression. */
+	zsl_real_t xa[6] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+	zsl_real_t ya[6] = { 0.9, 3.2, 4.8, 7.1, 9.2, 10.8 };
+	struct zsl_vec vx = { .sz = 6, .data = xa };
+	struct zsl_vec vy = { .sz = 6, .data = ya };
+	struct zsl_sta_linreg lr;
+
+	zsl_sta_linear_reg(&vx, &vy, &lr);
+	rc = zsl_sta_poly_fit(&vx, &vy, NULL, &b2);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b2.data[0], lr.intercept, 1E-4), NULL);
+	zassert_true(val_is_equal(b2.data[1], lr.slope, 1E-4), NULL);
+
+	/* A quadratic is recovered exactly. */
+	for (size_t i = 0; i < 6; i++) {
+		t = xa[i] - 2.5;
+		ya[i] = 0.5 - t + 0.25 * t * t;
+		xa[i] = t;
+	}
+	rc = zsl_sta_poly_fit(&vx, &vy, NULL, &beta);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(beta.data[0], 0.5, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[1], -1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(beta.data[2], 0.25, 1E-4), NULL);
+
+	/* Dependent columns, negative weights, and too few rows. */
+	zsl_mtx_copy(&xd, &x);
+	for (size_t i = 0; i < 8; i++) {
+		xd.data[i * 3 + 2] = 2.0 * xd.data[i * 3 + 1] - 1.0;
+	}
+	rc = zsl_sta_mult_linear_reg(&xd, &y, NULL, &beta);
+	zassert_true(rc == -ESINGULAR, NULL);
+	w.data[0] = -1.0;
+	rc = zsl_sta_mult_linear_reg(&x, &y, &w, &beta);
+	zassert_true(rc == -EINVAL, NULL);
+	vx.sz = 2;
+	vy.sz = 2;
+	rc = zsl_sta_poly_fit(&vx, &vy, NULL, &beta);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_sta_rls(void)
+{
+	int rc;
+	zsl_real_t e;
+
+	ZSL_STA_RLS_DEF(rls, 3);
+	ZSL_VECTOR_DEF(x, 3);
+	ZSL_VECTOR_DEF(xb, 2);
+
+	/* Observation rows, with a constant last column for the offset. */
+	zsl_real_t a[24] = { 1.0,  0.5, 1.0,
+			     2.0, -1.0, 1.0,
+			     0.0,  3.0, 1.0,
+			    -1.0,  1.5, 1.0,
+			     3.0,  2.0, 1.0,
+			     0.5, -2.5, 1.0,
+			    -2.0, -0.5, 1.0,
+			     1.5,  1.0, 1.0 };
+
+	/* Noisy samples of y = 2 * x0 - x1 + 0.5. */
+	zsl_real_t b[8] = { 2.02, 5.47, -2.53, -2.96, 4.51, 3.98, -2.99, 2.52 };
+
+	/* Invalid settings are rejected. */
+	rc = zsl_sta_rls_init(&rls, 0.0, 100.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_rls_init(&rls, 1.5, 100.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_rls_init(&rls, 1.0, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* With lambda = 1.0, RLS should match the batch least squares fit. */
+	rc = zsl_sta_rls_init(&rls, 1.0, 1E6);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		zsl_vec_from_arr(&x, &a[i * 3]);
+		rc = zsl_sta_rls_update(&rls, &x, b[i], &e);
+		zassert_true(rc == 0, NULL);
+	}
+
+	zassert_true(val_is_equal(rls.theta.data[0], 1.996202, 1E-3), NULL);
+	zassert_true(val_is_equal(rls.theta.data[1], -0.995834, 1E-3), NULL);
+	zassert_true(val_is_equal(rls.theta.data[2], 0.502791, 1E-3), NULL);
+
+	/* P must stay symmetric. */
+	zassert_true(zsl_mtx_is_sym(&rls.p), NULL);
+
+	/* With forgetting, the estimate follows a change in the model. */
+	rc = zsl_sta_rls_init(&rls, 0.8, 100.0);
+	zassert_true(rc == 0, NULL);
+	for (size_t k = 0; k < 64; k++) {
+		zsl_real_t *r = &a[(k % 8) * 3];
+		zsl_real_t y = (k < 32) ? 2.0 * r[0] - r[1] + 0.5 :
+			       -r[0] + 3.0 * r[1] - 1.0;
+
+		zsl_vec_from_arr(&x, r);
+		rc = zsl_sta_rls_update(&rls, &x, y, NULL);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(val_is_equal(rls.theta.data[0], -1.0, 1E-2), NULL);
+	zassert_true(val_is_equal(rls.theta.data[1], 3.0, 1E-2), NULL);
+	zassert_true(val_is_equal(rls.theta.data[2], -1.0, 1E-2), NULL);
+
+	/* The input row must match the number of parameters. */
+	rc = zsl_sta_rls_update(&rls, &xb, 1.0, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_sta_stream(void)
+{
+	int rc;
+	zsl_real_t x, var;
+	struct zsl_sta_stream s, sa, sb;
+
+	ZSL_VECTOR_DEF(v, 15);
+
+	zsl_real_t a[15] = { -3.0, 1.0, 2.0, 8.5, -3.5, 4.0, 7.0, -2.0, 0.0,
+			     6.0, 1.25, 9.0, -1.0, 2.5, 3.0 };
+
+	rc = zsl_vec_from_arr(&v, a);
+	zassert_true(rc == 0, NULL);
+
+	/* Too few samples for the spread. */
+	zsl_sta_stream_init(&s);
+	rc = zsl_sta_stream_var(&s, &x);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_sta_stream_feed(&s, 4.0);
+	rc = zsl_sta_stream_sta_dev(&s, &x);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_sta_stream_feed(&s, 4.0);
+	rc = zsl_sta_stream_skew(&s, &x);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* One sample at a time matches the batch functions. */
+	zsl_sta_stream_init(&s);
+	for (size_t i = 0; i < v.sz; i++) {
+		rc = zsl_sta_stream_feed(&s, a[i]);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_equal(s.n, 15, NULL);
+	zassert_true(val_is_equal(s.mean, 2.3166666667, 1E-6), NULL);
+	zassert_true(val_is_equal(s.min, -3.5, 1E-6), NULL);
+	zassert_true(val_is_equal(s.max, 9.0, 1E-6), NULL);
+	zsl_sta_var(&v, &var);
+	rc = zsl_sta_stream_var(&s, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x, var, 1E-5), NULL);
+	zassert_true(val_is_equal(x, 15.8434523810, 1E-5), NULL);
+	rc = zsl_sta_stream_sta_dev(&s, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x, 3.9803834465, 1E-5), NULL);
+	rc = zsl_sta_stream_skew(&s, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x, 0.2494402627, 1E-5), NULL);
+	rc = zsl_sta_stream_kurt(&s, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x, -0.9952603954, 1E-5), NULL);
+
+	/* Uneven halves, merged, match the single stream. */
+	struct zsl_vec va = { .sz = 4, .data = a };
+	struct zsl_vec vb = { .sz = 11, .data = &a[4] };
+
+	zsl_sta_stream_init(&sa);
+	zsl_sta_stream_init(&sb);
+	zsl_sta_stream_feed_vec(&sa, &va);
+	zsl_sta_stream_feed_vec(&sb, &vb);
+	rc = zsl_sta_stream_merge(&sa, &sb);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(sa.n, s.n, NULL);
+	zassert_true(val_is_equal(sa.mean, s.mean, 1E-6), NULL);
+	zassert_true(val_is_equal(sa.m2, s.m2, 1E-4), NULL);
+	zassert_true(val_is_equal(sa.m3, s.m3, 1E-3), NULL);
+	zassert_true(val_is_equal(sa.m4, s.m4, 1E-2), NULL);
+	zassert_true(val_is_equal(sa.min, s.min, 1E-6), NULL);
+	zassert_true(val_is_equal(sa.max, s.max, 1E-6), NULL);
+
+	/* Merging with an empty stream, either way round. */
+	zsl_sta_stream_init(&sb);
+	zsl_sta_stream_merge(&sa, &sb);
+	zassert_equal(sa.n, s.n, NULL);
+	zsl_sta_stream_merge(&sb, &s);
+	zassert_true(val_is_equal(sb.m4, s.m4, 1E-6), NULL);
+
+	/* A large offset doesn't swamp a small spread. */
+	zsl_sta_stream_init(&s);
+	for (size_t i = 0; i < 1000; i++) {
+		zsl_sta_stream_feed(&s, 1E4 + ((i % 2) ? 0.5 : -0.5));
+	}
+	rc = zsl_sta_stream_var(&s, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(x, 0.25 * 1000 / 999, 1E-4), NULL);
+}
+
+void test_sta_window(void)
+{
+	int rc;
+	uint32_t seed = 36;
+	size_t cnt;
+	zsl_real_t x, m, var, min, max;
+	zsl_real_t hist[300];
+
+	ZSL_STA_WINDOW_DEF(w, 16);
+
+	rc = zsl_sta_window_init(&w);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_window_mean(&w, &m);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_window_range(&w, &min, &max);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Compare every step against the batch functions over the same
+	 * samples, including runs of rising, falling and equal values. */
+	for (size_t i = 0; i < 300; i++) {
+		seed = seed * 1103515245u + 12345u;
+		if (i >= 100 && i < 140) {
+			x = (zsl_real_t)i;
+		} else if (i >= 140 && i < 180) {
+			x = 300.0 - (zsl_real_t)i;
+		} else if (i >= 180 && i < 210) {
+			x = 7.0;
+		} else {
+			x = (zsl_real_t)((seed >> 16) % 1000) / 10.0 - 50.0;
+		}
+		hist[i] = x;
+
+		rc = zsl_sta_window_feed(&w, x);
+		zassert_true(rc == 0, NULL);
+
+		cnt = zsl_sta_window_count(&w);
+		zassert_equal(cnt, (i < 16) ? i + 1 : 16, NULL);
+
+		struct zsl_vec v = { .sz = cnt, .data = &hist[i + 1 - cnt] };
+		zsl_real_t ref;
+
+		zsl_sta_mean(&v, &ref);
+		rc = zsl_sta_window_mean(&w, &m);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(m, ref, 1E-4), NULL);
+
+		rc = zsl_sta_window_range(&w, &min, &max);
+		zassert_true(rc == 0, NULL);
+		ref = v.data[0];
+		for (size_t j = 1; j < cnt; j++) {
+			ref = (v.data[j] < ref) ? v.data[j] : ref;
+		}
+		zassert_equal(min, ref, NULL);
+		ref = v.data[0];
+		for (size_t j = 1; j < cnt; j++) {
+			ref = (v.data[j] > ref) ? v.data[j] : ref;
+		}
+		zassert_equal(max, ref, NULL);
+
+		rc = zsl_sta_window_var(&w, &var);
+		if (cnt < 2) {
+			zassert_true(rc == -EINVAL, NULL);
+			continue;
+		}
+		zassert_true(rc == 0, NULL);
+		zsl_sta_var(&v, &ref);
+		zassert_true(ZSL_ABS(var - ref) < 1E-2 + 1E-4 * ref, NULL);
+	}
+
+	/* Only one of the bounds may be requested, and reset empties it. */
+	rc = zsl_sta_window_range(&w, NULL, &max);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_window_init(&w);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(zsl_sta_window_count(&w), 0, NULL);
+}
+
+void test_sta_robust(void)
+{
+	int rc;
+	zsl_real_t med, mad, m;
+
+	zsl_real_t a[10] = { 2.0, 4.0, 1.0, 3.0, 100.0, 5.0, 7.0, 6.0, -90.0,
+			     8.0 };
+	struct zsl_vec v = { .sz = 10, .data = a };
+
+	ZSL_VECTOR_DEF(w, 10);
+
+	/* Sorted: -90 1 2 3 4 5 6 7 8 100, median 4.5, and deviations
+	 * 0.5 0.5 1.5 1.5 2.5 2.5 3.5 3.5 94.5 95.5, median 2.5. */
+	rc = zsl_sta_mad(&v, &med, &mad);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(med, 4.5, 1E-6), NULL);
+	zassert_true(val_is_equal(mad, 2.5, 1E-6), NULL);
+	zassert_true(a[4] == 100.0, NULL);
+
+	/* Dropping 10% from each end removes -90 and 100. */
+	rc = zsl_sta_trim_mean(&v, 10, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(m, 4.5, 1E-6), NULL);
+
+	/* ...while winsorizing replaces them with 1 and 8. */
+	rc = zsl_sta_winsor_mean(&v, 10, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(m, 4.5, 1E-6), NULL);
+	rc = zsl_sta_winsor_mean(&v, 20, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(m, 4.5, 1E-6), NULL);
+
+	/* Nothing trimmed is the plain mean. */
+	rc = zsl_sta_trim_mean(&v, 5, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(m, 4.6, 1E-6), NULL);
+
+	rc = zsl_sta_trim_mean(&v, 50, &m);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The two outliers lie far beyond 3 * 1.4826 * 2.5 of the median. */
+	rc = zsl_sta_reject_outliers(&v, 3.0, &w);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(w.sz, 8, NULL);
+	zassert_true(w.data[0] == 2.0 && w.data[7] == 8.0, NULL);
+
+	/* In place, keeping only the values within 0.5 * 1.4826 * 2.5 of
+	 * 4.5, in their original order. */
+	rc = zsl_sta_reject_outliers(&v, 0.5, &v);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(v.sz, 4, NULL);
+	zassert_true(a[0] == 4.0 && a[1] == 3.0, NULL);
+	zassert_true(a[2] == 5.0 && a[3] == 6.0, NULL);
+
+	rc = zsl_sta_reject_outliers(&v, -1.0, &v);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_sta_hampel(void)
+{
+	int rc;
+	uint32_t seed = 7;
+	size_t cnt;
+	zsl_real_t x, y, med, mad;
+	zsl_real_t hist[200];
+	zsl_real_t tmp[16];
+
+	ZSL_STA_HAMPEL_DEF(h15, 15);
+	ZSL_STA_HAMPEL_DEF(h16, 16);
+	struct zsl_sta_hampel *hs[2] = { &h15, &h16 };
+
+	rc = zsl_sta_hampel_init(&h15, -1.0);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Compare every step with the batch median and MAD of the same
+	 * window, for odd and even lengths, including spikes, repeated
+	 * values and a step. */
+	for (size_t k = 0; k < 2; k++) {
+		struct zsl_sta_hampel *h = hs[k];
+
+		rc = zsl_sta_hampel_init(h, 3.0);
+		zassert_true(rc == 0, NULL);
+
+		for (size_t i = 0; i < 200; i++) {
+			seed = seed * 1103515245u + 12345u;
+			x = (zsl_real_t)((seed >> 16) % 100) / 10.0;
+			if (i % 17 == 5) {
+				x += 50.0;
+			} else if (i >= 60 && i < 80) {
+				x = 3.0;
+			} else if (i >= 120) {
+				x += 20.0;
+			}
+			hist[i] = x;
+
+			rc = zsl_sta_hampel_feed(h, x, &y);
+			zassert_true(rc == 0, NULL);
+
+			cnt = (i < h->buf.sz) ? i + 1 : h->buf.sz;
+			struct zsl_vec v = { .sz = cnt, .data = tmp };
+
+			memcpy(tmp, &hist[i + 1 - cnt], cnt * sizeof(tmp[0]));
+
+			rc = zsl_sta_mad_d(&v, &med, &mad);
+			zassert_true(rc == 0, NULL);
+			if (ZSL_ABS(x - med) > 3.0 * ZSL_STA_MAD_NORMAL * mad) {
+				zassert_true(val_is_equal(y, med, 1E-5), NULL);
+			} else {
+				zassert_true(y == x, NULL);
+			}
+
+			/* Spikes are removed once the window has filled. */
+			if (i % 17 == 5 && i > 16) {
+				zassert_true(y < 40.0, NULL);
+			}
+		}
+
+		/* The step has been followed. */
+		zassert_true(y > 19.0, NULL);
+	}
+}
+
+void test_sta_tdigest(void)
+{
+	int rc;
+	uint32_t seed = 37;
+	zsl_real_t x;
+	const zsl_real_t q[5] = { 0.01, 0.25, 0.5, 0.95, 0.99 };
+
+	ZSL_STA_TDIGEST_DEF(td, 64);
+	ZSL_STA_TDIGEST_DEF(ta, 64);
+	ZSL_STA_TDIGEST_DEF(tb, 48);
+	ZSL_STA_TDIGEST_DEF(tc, 10);
+
+	rc = zsl_sta_tdigest_init(&tc, 32.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_tdigest_init(&td, 0.5);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_sta_tdigest_init(&td, 32.0);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_tdigest_quantile(&td, 0.5, &x);
+	zassert_true(rc == -EINVAL, NULL);
+	zsl_sta_tdigest_init(&ta, 32.0);
+	zsl_sta_tdigest_init(&tb, 24.0);
+
+	/* 100000 uniform samples in [0, 1000), split between two digests
+	 * as well as fed to a third. */
+	for (size_t i = 0; i < 100000; i++) {
+		seed = seed * 1103515245u + 12345u;
+		x = (zsl_real_t)((seed >> 8) % 100000) / 100.0;
+		zsl_sta_tdigest_feed(&td, x);
+		zsl_sta_tdigest_feed((i % 3) ? &ta : &tb, x);
+	}
+	zassert_true(td.n <= 64, NULL);
+	zassert_true(val_is_equal(td.total, 100000.0, 1E-6), NULL);
+
+	rc = zsl_sta_tdigest_merge(&ta, &tb);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(ta.total, 100000.0, 1E-6), NULL);
+
+	for (size_t i = 0; i < 5; i++) {
+		rc = zsl_sta_tdigest_quantile(&td, q[i], &x);
+		zassert_true(rc == 0, NULL);
+		zassert_true(ZSL_ABS(x - 1000.0 * q[i]) < 5.0, NULL);
+		rc = zsl_sta_tdigest_quantile(&ta, q[i], &x);
+		zassert_true(rc == 0, NULL);
+		zassert_true(ZSL_ABS(x - 1000.0 * q[i]) < 5.0, NULL);
+	}
+
+	/* The tails are tighter than the middle. */
+	zsl_sta_tdigest_quantile(&td, 0.99, &x);
+	zassert_true(ZSL_ABS(x - 990.0) < 1.5, NULL);
+
+	/* The ends are exact, and out of range quantiles are refused. */
+	zsl_sta_tdigest_quantile(&td, 0.0, &x);
+	zassert_true(val_is_equal(x, td.min, 1E-6), NULL);
+	zsl_sta_tdigest_quantile(&td, 1.0, &x);
+	zassert_true(val_is_equal(x, td.max, 1E-6), NULL);
+	rc = zsl_sta_tdigest_quantile(&td, 1.5, &x);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Sorted input, and a handful of samples, kept exactly. */
+	zsl_sta_tdigest_init(&td, 32.0);
+	for (size_t i = 0; i < 10000; i++) {
+		zsl_sta_tdigest_feed(&td, (zsl_real_t)i);
+	}
+	zsl_sta_tdigest_quantile(&td, 0.95, &x);
+	zassert_true(ZSL_ABS(x - 9500.0) < 50.0, NULL);
+
+	zsl_sta_tdigest_init(&td, 32.0);
+	zsl_sta_tdigest_feed(&td, 3.0);
+	zsl_sta_tdigest_feed(&td, 1.0);
+	zsl_sta_tdigest_feed(&td, 2.0);
+	zsl_sta_tdigest_quantile(&td, 0.5, &x);
+	zassert_true(val_is_equal(x, 2.0, 1E-6), NULL);
+}
+
 void test_sta_absolute_error(void)
 {
 	int rc;
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <ztest.h>
 #include <zsl/zsl.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices_fixed.h>
+#include <zsl/workspace.h>
 #include "floatcheck.h"
 
 void test_vector_init(void)
@@ -136,6 +139,119 @@ void test_vector_get_subset(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+void test_vector_view(void)
+{
+	int rc;
+	struct zsl_vec vw;
+
+	zsl_real_t a[6] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+	struct zsl_vec v = { .sz = 6, .data = a };
+
+	/* The view shares the parent's data. */
+	rc = zsl_vec_view(&v, 2, 3, &vw);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(vw.sz, 3, NULL);
+	zassert_true(vw.data == &a[2], NULL);
+	vw.data[0] = 10.0;
+	zassert_equal(a[2], 10.0, NULL);
+
+	/* An empty view at the end is valid. */
+	rc = zsl_vec_view(&v, 6, 0, &vw);
+	zassert_true(rc == 0, NULL);
+
+	/* Windows past the end are rejected. */
+	rc = zsl_vec_view(&v, 4, 3, &vw);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_vec_view(&v, 7, 0, &vw);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_vector_win(void)
+{
+	int rc;
+	size_t n = 0;
+	struct zsl_vec vw;
+	struct zsl_vec_win w;
+
+	zsl_real_t a[7] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+	struct zsl_vec v = { .sz = 7, .data = a };
+
+	/* Overlapping windows of 4, every 2 values: 0, 2 (4 would overrun). */
+	rc = zsl_vec_win_init(&w, &v, 4, 2);
+	zassert_true(rc == 0, NULL);
+	while (zsl_vec_win_next(&w, &vw) == 0) {
+		zassert_equal(vw.sz, 4, NULL);
+		zassert_true(vw.data == &a[2 * n], NULL);
+		n++;
+	}
+	zassert_equal(n, 2, NULL);
+
+	/* Windows that tile the vector exactly. */
+	n = 0;
+	rc = zsl_vec_win_init(&w, &v, 1, 1);
+	zassert_true(rc == 0, NULL);
+	while (zsl_vec_win_next(&w, &vw) == 0) {
+		n++;
+	}
+	zassert_equal(n, 7, NULL);
+
+	/* A window longer than the vector is never returned. */
+	rc = zsl_vec_win_init(&w, &v, 8, 1);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_vec_win_next(&w, &vw) == -ENOENT, NULL);
+
+	rc = zsl_vec_win_init(&w, &v, 0, 1);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_vec_win_init(&w, &v, 1, 0);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_vector_def_aligned(void)
+{
+	int rc;
+	zsl_real_t d, dv;
+	struct zsl_vec va, vb;
+
+	ZSL_VECTOR_DEF_ALIGNED(a, 19);
+	ZSL_VECTOR_DEF_ALIGNED(b, 19);
+	ZSL_VECTOR_DEF_ALIGNED(c, 19);
+
+	zassert_equal(a.sz, 19, NULL);
+	zassert_true(ZSL_IS_ALIGNED(a.data, ZSL_DATA_ALIGN), NULL);
+	zassert_true(ZSL_IS_ALIGNED(b.data, ZSL_DATA_ALIGN), NULL);
+	zassert_equal(sizeof(a_vec) % ZSL_DATA_ALIGN, 0, NULL);
+	zassert_true(sizeof(a_vec) >= 19 * sizeof(zsl_real_t), NULL);
+
+	for (size_t i = 0; i < 19; i++) {
+		a.data[i] = (zsl_real_t)i * 0.5;
+		b.data[i] = 2.0 - (zsl_real_t)i;
+	}
+
+	/* Aligned operands, with a remainder after the last full vector. */
+	rc = zsl_vec_add(&a, &b, &c);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_vec_dot(&a, &b, &d);
+	zassert_true(rc == 0, NULL);
+	dv = 0.0;
+	for (size_t i = 0; i < 19; i++) {
+		zassert_true(val_is_equal(c.data[i], 2.0 - 0.5 * (zsl_real_t)i,
+					  1E-6), NULL);
+		dv += a.data[i] * b.data[i];
+	}
+	zassert_true(val_is_equal(d, dv, 1E-6), NULL);
+
+	/* Views one entry in are misaligned, and give the same results. */
+	zsl_vec_view(&a, 1, 18, &va);
+	zsl_vec_view(&b, 1, 18, &vb);
+	rc = zsl_vec_dot(&va, &vb, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(d, dv - a.data[0] * b.data[0], 1E-6), NULL);
+	rc = zsl_vec_scalar_mult(&va, 2.0);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(a.data[0], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(a.data[18], 18.0, 1E-6), NULL);
+}
+
 void test_vector_add(void)
 {
 	int rc;
@@ -224,7 +340,7 @@ void test_vector_sum(void)
 	zsl_vec_init(&vc);
 	zsl_vec_init(&vsum);
 
-	struct zsl_vec *vlist[3] = { &va, &vb, &vc };
+	const struct zsl_vec *vlist[3] = { &va, &vb, &vc };
 
 	/* Assign values to vectors. */
 	va.data[0] = 1.0;
@@ -407,6 +523,50 @@ void test_vector_norm(void)
 	zassert_true(val_is_equal(norm, 4.5486261662, 1E-6), NULL);
 }
 
+void test_vector_simd_lengths(void)
+{
+	int rc;
+	zsl_real_t d;
+	zsl_real_t sum;
+
+	ZSL_VECTOR_DEF(v, 37);
+	ZSL_VECTOR_DEF(w, 37);
+	ZSL_VECTOR_DEF(x, 37);
+
+	/* Check every length up to 37, so that the main loop and the tail of
+	 * any vectorised implementation are both exercised. Small integer
+	 * values keep the results exact. */
+	for (size_t n = 1; n <= 37; n++) {
+		v.sz = w.sz = x.sz = n;
+		sum = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			v.data[i] = (zsl_real_t)((int)(i % 7) - 3);
+			w.data[i] = (zsl_real_t)((int)(i % 5) + 1);
+			sum += v.data[i] * w.data[i];
+		}
+
+		rc = zsl_vec_dot(&v, &w, &d);
+		zassert_true(rc == 0, NULL);
+		zassert_true(d == sum, NULL);
+
+		rc = zsl_vec_add(&v, &w, &x);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(x.data[i] == v.data[i] + w.data[i], NULL);
+		}
+
+		rc = zsl_vec_scalar_mult(&x, 2.0);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < n; i++) {
+			zassert_true(x.data[i] ==
+				     2.0 * (v.data[i] + w.data[i]), NULL);
+		}
+
+		zassert_true(val_is_equal(zsl_vec_norm(&w) * zsl_vec_norm(&w),
+					  zsl_vec_sum_of_sqrs(&w), 1E-4), NULL);
+	}
+}
+
 void test_vector_project(void)
 {
 	int rc;
@@ -557,9 +717,9 @@ void test_vector_mean(void)
 	zsl_vec_init(&var);
 	zsl_vec_init(&var2);
 
-	struct zsl_vec *vlist[3] = { &va, &vb, &vc };
-	struct zsl_vec *vlist2[3] = { &va, &vb, &vc2 };
-	struct zsl_vec *vlist3[0];
+	const struct zsl_vec *vlist[3] = { &va, &vb, &vc };
+	const struct zsl_vec *vlist2[3] = { &va, &vb, &vc2 };
+	const struct zsl_vec *vlist3[0];
 
 	/* Assign values to vectors. */
 	va.data[0] = 1.0;
@@ -627,6 +787,41 @@ void test_vector_ar_mean(void)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+/* Long buffer for the pairwise summation tests. */
+static zsl_real_t vec_long_buf[10000];
+
+void test_vector_long_sums(void)
+{
+	int rc;
+	zsl_real_t x;
+	struct zsl_vec v = {
+		.sz = 10000,
+		.data = vec_long_buf
+	};
+
+	/* A single running sum of these loses several digits in single
+	 * precision. */
+	for (size_t i = 0; i < v.sz; i++) {
+		v.data[i] = (i % 2) ? 0.3 : 0.1;
+	}
+
+	rc = zsl_vec_ar_mean(&v, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.2, 1E-6), NULL);
+
+	rc = zsl_vec_dot(&v, &v, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x / 500.0, 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_vec_sum_of_sqrs(&v) / 500.0, 1.0, 1E-6),
+		     NULL);
+
+	/* Lengths that don't split into whole unrolled blocks. */
+	v.sz = 1003;
+	rc = zsl_vec_ar_mean(&v, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 200.5 / 1003.0, 1E-6), NULL);
+}
+
 void test_vector_rev(void)
 {
 	int rc;
@@ -789,6 +984,19 @@ void test_vector_is_equal(void)
 	w.data[0] = -1.00001;
 	eq = zsl_vec_is_equal(&v, &w, 1E-5);
 	zassert_false(eq, NULL);
+
+	/* A difference in a later block of a longer vector. */
+	ZSL_VECTOR_DEF(lx, 37);
+	ZSL_VECTOR_DEF(ly, 37);
+	for (size_t i = 0; i < 37; i++) {
+		lx.data[i] = (zsl_real_t)i;
+		ly.data[i] = (zsl_real_t)i;
+	}
+	eq = zsl_vec_is_equal(&lx, &ly, 1E-5);
+	zassert_true(eq, NULL);
+	ly.data[36] += 0.1;
+	eq = zsl_vec_is_equal(&lx, &ly, 1E-5);
+	zassert_false(eq, NULL);
 }
 
 void test_vector_is_nonneg(void)
@@ -815,6 +1023,15 @@ void test_vector_is_nonneg(void)
 	/* Check if any value is negative in 'w'. */
 	neg = zsl_vec_is_nonneg(&w);
 	zassert_true(neg, NULL);
+
+	/* A negative value in a later block of a longer vector. */
+	ZSL_VECTOR_DEF(x, 40);
+	zsl_vec_init(&x);
+	neg = zsl_vec_is_nonneg(&x);
+	zassert_true(neg, NULL);
+	x.data[39] = -1E-3;
+	neg = zsl_vec_is_nonneg(&x);
+	zassert_false(neg, NULL);
 }
 
 void test_vector_contains(void)
@@ -908,3 +1125,280 @@ void test_vector_sort(void)
 	zassert_equal(wp.data[3], ws.data[3], NULL);
 	zassert_equal(wp.data[4], ws.data[4], NULL);
 }
+
+/* Checks that a is ordered and holds the same values as the unsorted b. */
+static bool vector_is_sorted_from(const zsl_real_t *a, const zsl_real_t *b,
+				  size_t n)
+{
+	zsl_real_t sa = 0.0;
+	zsl_real_t sb = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (i > 0 && a[i - 1] > a[i]) {
+			return false;
+		}
+		sa += a[i];
+		sb += b[i];
+	}
+
+	return val_is_equal(sa, sb, 1E-6);
+}
+
+void test_vector_sort_d(void)
+{
+	int rc;
+	uint32_t seed = 2021;
+	static zsl_real_t orig[1000];
+
+	ZSL_VECTOR_DEF(v, 1000);
+	ZSL_VECTOR_DEF(w, 1000);
+	ZSL_VECTOR_DEF(x, 999);
+
+	/* Sorted, reversed, constant, organ-pipe and pseudo-random inputs,
+	 * the first four being the usual worst cases for quicksort. */
+	for (size_t k = 0; k < 5; k++) {
+		for (size_t i = 0; i < v.sz; i++) {
+			switch (k) {
+			case 0:
+				orig[i] = (zsl_real_t)i;
+				break;
+			case 1:
+				orig[i] = (zsl_real_t)(v.sz - i);
+				break;
+			case 2:
+				orig[i] = 1.5;
+				break;
+			case 3:
+				orig[i] = (zsl_real_t)(i < v.sz / 2 ? i :
+						       v.sz - i);
+				break;
+			default:
+				seed = seed * 1103515245u + 12345u;
+				orig[i] = (zsl_real_t)((seed >> 16) % 100) / 8.0;
+				break;
+			}
+			v.data[i] = orig[i];
+		}
+
+		rc = zsl_vec_sort(&v, &w);
+		zassert_true(rc == 0, NULL);
+		zassert_true(vector_is_sorted_from(w.data, orig, v.sz), NULL);
+
+		rc = zsl_vec_sort_d(&v);
+		zassert_true(rc == 0, NULL);
+		zassert_true(zsl_vec_is_equal(&v, &w, 1E-6), NULL);
+	}
+
+	/* Values closer than 1E-5 are kept as they are. */
+	v.sz = 3;
+	v.data[0] = 2.0;
+	v.data[1] = 1.000001;
+	v.data[2] = 1.0;
+	rc = zsl_vec_sort_d(&v);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(v.data[0], 1.0, NULL);
+	zassert_equal(v.data[1], (zsl_real_t)1.000001, NULL);
+	zassert_equal(v.data[2], 2.0, NULL);
+
+	/* Empty and single element vectors. */
+	v.sz = 0;
+	rc = zsl_vec_sort_d(&v);
+	zassert_true(rc == 0, NULL);
+	v.sz = 1;
+	rc = zsl_vec_sort_d(&v);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(v.data[0], 1.0, NULL);
+
+	/* The output must be the same size as the input. */
+	v.sz = 1000;
+	rc = zsl_vec_sort(&v, &x);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+void test_vector_fused(void)
+{
+	int rc;
+	zsl_real_t d, p, t, n;
+	size_t sz[3] = { 3, 7, 150 };
+
+	ZSL_VECTOR_DEF(u, 150);
+	ZSL_VECTOR_DEF(v, 150);
+	ZSL_VECTOR_DEF(w, 150);
+
+	/* Compare the fused kernels against the definitions, for the 3-vector
+	 * fast path, a short tail and a length split pairwise. */
+	for (size_t k = 0; k < 3; k++) {
+		u.sz = v.sz = w.sz = sz[k];
+		d = p = t = 0.0;
+		for (size_t i = 0; i < u.sz; i++) {
+			u.data[i] = (zsl_real_t)((int)(i % 7) - 3) / 4.0 + 0.1;
+			v.data[i] = (zsl_real_t)((int)(i % 5) + 1) / 2.0;
+			d += (u.data[i] - v.data[i]) * (u.data[i] - v.data[i]);
+			p += u.data[i] * v.data[i];
+			t += u.data[i] * u.data[i];
+		}
+
+		zassert_true(val_is_equal(zsl_vec_dist(&u, &v), ZSL_SQRT(d),
+					  1E-5), NULL);
+		zassert_true(val_is_equal(zsl_vec_norm(&u), ZSL_SQRT(t), 1E-5),
+			     NULL);
+
+		rc = zsl_vec_project(&u, &v, &w);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < u.sz; i++) {
+			zassert_true(val_is_equal(w.data[i],
+						  u.data[i] * p / t, 1E-5),
+				     NULL);
+		}
+
+		/* The output may be the vector projected onto. */
+		rc = zsl_vec_project(&u, &v, &u);
+		zassert_true(rc == 0, NULL);
+		zassert_true(zsl_vec_is_equal(&u, &w, 1E-6), NULL);
+
+		rc = zsl_vec_to_unit(&w);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(zsl_vec_norm(&w), 1.0, 1E-5), NULL);
+		zassert_true(val_is_equal(w.data[0],
+					  u.data[0] / zsl_vec_norm(&u), 1E-5),
+			     NULL);
+	}
+
+	/* The 3-vector kernels return the norm from the same pass. */
+	zsl_real_t a[3] = { 3.0, 0.0, -4.0 };
+
+	n = zsl_vec3_to_unit(a, a);
+	zassert_true(val_is_equal(n, 5.0, 1E-6), NULL);
+	zassert_true(val_is_equal(a[0], 0.6, 1E-6), NULL);
+	zassert_true(val_is_equal(a[2], -0.8, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_vec3_norm(a), 1.0, 1E-6), NULL);
+
+	/* Vectors of different sizes have no distance. */
+	v.sz = 4;
+	u.sz = 3;
+	zassert_true(isnan(zsl_vec_dist(&u, &v)), NULL);
+}
+
+void test_vector_mean_update(void)
+{
+	int rc;
+	zsl_real_t data[20][19];
+	struct zsl_vec vs[20];
+	const struct zsl_vec *vlist[20];
+
+	ZSL_VECTOR_DEF(m, 19);
+	ZSL_VECTOR_DEF(r, 19);
+	ZSL_VECTOR_DEF(x, 18);
+
+	/* 19 elements, so the blocked sum has a partial last block. */
+	for (size_t i = 0; i < 20; i++) {
+		for (size_t j = 0; j < 19; j++) {
+			data[i][j] = (zsl_real_t)((int)((i * 7 + j * 3) % 11));
+		}
+		vs[i].sz = 19;
+		vs[i].data = data[i];
+		vlist[i] = &vs[i];
+	}
+
+	rc = zsl_vec_mean(vlist, 20, &m);
+	zassert_true(rc == 0, NULL);
+
+	/* The running mean matches the batch mean. */
+	zsl_vec_init(&r);
+	for (size_t i = 0; i < 20; i++) {
+		rc = zsl_vec_mean_update(&r, i, &vs[i]);
+		zassert_true(rc == 0, NULL);
+	}
+	zassert_true(zsl_vec_is_equal(&m, &r, 1E-5), NULL);
+
+	for (size_t j = 0; j < 19; j++) {
+		zsl_real_t sum = 0.0;
+
+		for (size_t i = 0; i < 20; i++) {
+			sum += data[i][j];
+		}
+		zassert_true(val_is_equal(m.data[j], sum / 20.0, 1E-6), NULL);
+	}
+
+	/* The sum may be written over one of its inputs. */
+	rc = zsl_vec_sum(vlist, 20, &vs[0]);
+	zassert_true(rc == 0, NULL);
+	zsl_vec_scalar_mult(&vs[0], 1.0 / 20.0);
+	zassert_true(zsl_vec_is_equal(&m, &vs[0], 1E-6), NULL);
+
+	rc = zsl_vec_mean_update(&m, 1, &x);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+/* Returns true if a[0..n) is sorted and holds the same values as b. */
+static bool vector_is_perm_sorted(const zsl_real_t *a, const zsl_real_t *b,
+				  size_t n)
+{
+	size_t ca, cb;
+
+	for (size_t i = 0; i < n; i++) {
+		if (i > 0 && a[i - 1] > a[i]) {
+			return false;
+		}
+		ca = cb = 0;
+		for (size_t j = 0; j < n; j++) {
+			ca += (a[j] == a[i]);
+			cb += (b[j] == a[i]);
+		}
+		if (ca != cb) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void test_vector_sort_ws(void)
+{
+	int rc;
+	uint32_t seed = 12345;
+	static zsl_real_t data[2048];
+	static zsl_real_t orig[2048];
+	static zsl_real_t buf[2048];
+	struct zsl_vec v = { .sz = 2048, .data = data };
+	struct zsl_workspace ws;
+
+	/* Large enough to be radix sorted in either precision. */
+	zsl_ws_init(&ws, buf, 2048);
+
+	/* Mixed signs and magnitudes, with repeats, so every byte of the
+	 * radix keys varies. */
+	for (size_t i = 0; i < v.sz; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (zsl_real_t)((int)((seed >> 16) % 2001) - 1000) /
+			  (zsl_real_t)(1 + (seed >> 8) % 97);
+	}
+	data[17] = 0.0;
+	data[18] = -1E30;
+	data[19] = 1E-30;
+	data[20] = data[21];
+	memcpy(orig, data, sizeof(data));
+
+	rc = zsl_vec_sort_ws(&v, &ws);
+	zassert_true(rc == 0, NULL);
+	zassert_true(zsl_ws_mark(&ws) == 0, NULL);
+	zassert_true(vector_is_perm_sorted(data, orig, v.sz), NULL);
+	zassert_true(data[0] == (zsl_real_t)-1E30, NULL);
+
+	/* Already sorted, and constant input. */
+	memcpy(orig, data, sizeof(data));
+	rc = zsl_vec_sort_ws(&v, &ws);
+	zassert_true(rc == 0, NULL);
+	zassert_true(memcmp(orig, data, sizeof(data)) == 0, NULL);
+	for (size_t i = 0; i < v.sz; i++) {
+		data[i] = 2.5;
+	}
+	rc = zsl_vec_sort_ws(&v, &ws);
+	zassert_true(rc == 0, NULL);
+	zassert_true(data[0] == 2.5 && data[v.sz - 1] == 2.5, NULL);
+
+	/* The buffer must fit in the workspace. */
+	ws.sz = zsl_vec_sort_ws_sz(v.sz) - 1;
+	rc = zsl_vec_sort_ws(&v, &ws);
+	zassert_true(rc == -ENOMEM, NULL);
+}
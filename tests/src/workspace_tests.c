@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/vectors.h>
+#include <zsl/workspace.h>
+#include "floatcheck.h"
+
+/**
+ * @brief zsl_ws_init and zsl_ws_alloc unit tests.
+ *
+ * This test verifies the zsl_ws_init, zsl_ws_alloc and zsl_ws_avail
+ * functions.
+ */
+void test_ws_alloc(void)
+{
+	int rc;
+	zsl_real_t buf[16];
+	zsl_real_t *p;
+	struct zsl_workspace ws;
+
+	rc = zsl_ws_init(&ws, buf, 16);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 16, NULL);
+
+	/* A NULL buffer is only accepted for an empty workspace. */
+	rc = zsl_ws_init(&ws, NULL, 16);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_ws_init(&ws, buf, 16);
+	zassert_equal(rc, 0, NULL);
+
+	/* Allocations are contiguous. */
+	p = zsl_ws_alloc(&ws, 4);
+	zassert_true(p == &buf[0], NULL);
+	p = zsl_ws_alloc(&ws, 10);
+	zassert_true(p == &buf[4], NULL);
+	zassert_equal(zsl_ws_avail(&ws), 2, NULL);
+
+	/* Requests that exceed the remaining space fail. */
+	p = zsl_ws_alloc(&ws, 3);
+	zassert_true(p == NULL, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 2, NULL);
+
+	p = zsl_ws_alloc(&ws, 2);
+	zassert_true(p == &buf[14], NULL);
+	zassert_equal(zsl_ws_avail(&ws), 0, NULL);
+	zassert_equal(ws.peak, 16, NULL);
+}
+
+/**
+ * @brief zsl_ws_mark and zsl_ws_release unit tests.
+ *
+ * This test verifies the zsl_ws_mark and zsl_ws_release functions, as well
+ * as the high-water mark recorded in the workspace.
+ */
+void test_ws_mark_release(void)
+{
+	int rc;
+	size_t mark;
+	zsl_real_t *p;
+
+	ZSL_WORKSPACE_DEF(ws, 12);
+
+	p = zsl_ws_alloc(&ws, 3);
+	zassert_true(p != NULL, NULL);
+
+	mark = zsl_ws_mark(&ws);
+	zassert_equal(mark, 3, NULL);
+
+	p = zsl_ws_alloc(&ws, 8);
+	zassert_true(p == &ws.data[3], NULL);
+
+	/* Releasing returns to the mark, but the peak is retained. */
+	rc = zsl_ws_release(&ws, mark);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_ws_avail(&ws), 9, NULL);
+	zassert_equal(ws.peak, 11, NULL);
+
+	/* Memory is reused after a release. */
+	p = zsl_ws_alloc(&ws, 1);
+	zassert_true(p == &ws.data[3], NULL);
+
+	/* A mark beyond the current offset is invalid. */
+	rc = zsl_ws_release(&ws, 10);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+/**
+ * @brief zsl_ws_mtx_alloc and zsl_ws_vec_alloc unit tests.
+ *
+ * This test verifies the zsl_ws_mtx_alloc and zsl_ws_vec_alloc functions.
+ */
+void test_ws_mtx_vec_alloc(void)
+{
+	int rc;
+	struct zsl_mtx m;
+	struct zsl_vec v;
+
+	ZSL_WORKSPACE_DEF(ws, 20);
+
+	rc = zsl_ws_mtx_alloc(&ws, &m, 3, 4);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(m.sz_rows, 3, NULL);
+	zassert_equal(m.sz_cols, 4, NULL);
+	zassert_true(m.data == &ws.data[0], NULL);
+
+	rc = zsl_ws_vec_alloc(&ws, &v, 8);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(v.sz, 8, NULL);
+	zassert_true(v.data == &ws.data[12], NULL);
+
+	/* The workspace is now full. */
+	rc = zsl_ws_vec_alloc(&ws, &v, 1);
+	zassert_equal(rc, -ENOMEM, NULL);
+	rc = zsl_ws_mtx_alloc(&ws, &m, 1, 1);
+	zassert_equal(rc, -ENOMEM, NULL);
+
+	/* Matrices allocated from the workspace behave like any other. */
+	zsl_ws_release(&ws, 0);
+	rc = zsl_ws_mtx_alloc(&ws, &m, 2, 2);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_init(&m, zsl_mtx_entry_fn_identity);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(m.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[1], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(m.data[3], 1.0, 1E-6), NULL);
+}
+
+#if CONFIG_ZSL_SCRATCH_POOL
+/**
+ * @brief zsl_scratch_get and zsl_scratch_peak unit tests.
+ *
+ * This test verifies that library functions release everything they take
+ * from the scratch pool, and that the high-water mark is tracked.
+ */
+void test_ws_scratch_pool(void)
+{
+	int rc;
+	zsl_real_t d;
+	struct zsl_workspace *ws;
+
+	ZSL_MATRIX_DEF(mi, 5, 5);
+
+	zsl_real_t data[25] = { 2.0, 1.0, 0.0, 0.0, 1.0,
+				1.0, 3.0, 1.0, 0.0, 0.0,
+				0.0, 1.0, 4.0, 1.0, 0.0,
+				0.0, 0.0, 1.0, 5.0, 1.0,
+				1.0, 0.0, 0.0, 1.0, 6.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	ws = zsl_scratch_get();
+	zassert_equal(ws->used, 0, NULL);
+	zsl_scratch_put(ws);
+
+	zsl_scratch_reset_peak();
+	zassert_equal(zsl_scratch_peak(), 0, NULL);
+
+	/* 5x5 determinant: a single 5x5 copy is factored. */
+	rc = zsl_mtx_deter(&m, &d);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(d, 442.0, 1E-3), NULL);
+	zassert_equal(zsl_scratch_peak(), 25, NULL);
+
+	/* 5x5 inverse: the same single 5x5 copy is factored. */
+	zsl_scratch_reset_peak();
+	rc = zsl_mtx_inv(&m, &mi);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(zsl_scratch_peak(), 25, NULL);
+
+	/* Everything has been returned to the pool. */
+	ws = zsl_scratch_get();
+	zassert_equal(ws->used, 0, NULL);
+	zsl_scratch_put(ws);
+}
+#endif
+
+#if CONFIG_ZSL_INSTRUMENT
+/**
+ * @brief zsl_instr_find unit tests.
+ *
+ * This test verifies that instrumented functions record their calls and
+ * peak usage, including that of the instrumented functions they call.
+ */
+void test_ws_instrument(void)
+{
+	int rc;
+	zsl_real_t d;
+	const struct zsl_instr_rec *deter;
+	const struct zsl_instr_rec *adj;
+
+	ZSL_MATRIX_DEF(ma, 5, 5);
+
+	zsl_real_t data[25] = { 2.0, 1.0, 0.0, 0.0, 1.0,
+				1.0, 3.0, 1.0, 0.0, 0.0,
+				0.0, 1.0, 4.0, 1.0, 0.0,
+				0.0, 0.0, 1.0, 5.0, 1.0,
+				1.0, 0.0, 0.0, 1.0, 6.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 5,
+		.data = data
+	};
+
+	zsl_instr_reset();
+
+	/* 5x5 determinant: a single 5x5 copy is factored. */
+	rc = zsl_mtx_deter(&m, &d);
+	zassert_equal(rc, 0, NULL);
+	deter = zsl_instr_find("zsl_mtx_deter");
+	zassert_not_null(deter, NULL);
+	zassert_equal(deter->calls, 1, NULL);
+	zassert_equal(deter->scratch, 25 * sizeof(zsl_real_t), NULL);
+	zassert_true(deter->stack > 0, NULL);
+
+	/* The adjoint takes the 4x4 determinant of 25 minors. */
+	rc = zsl_mtx_adjoint(&m, &ma);
+	zassert_equal(rc, 0, NULL);
+	adj = zsl_instr_find("zsl_mtx_adjoint");
+	zassert_not_null(adj, NULL);
+	zassert_equal(adj->calls, 1, NULL);
+	zassert_equal(deter->calls, 26, NULL);
+	zassert_equal(adj->scratch, 16 * sizeof(zsl_real_t), NULL);
+	zassert_true(adj->stack > 16 * sizeof(zsl_real_t), NULL);
+
+	zsl_instr_reset();
+	zassert_equal(deter->calls, 0, NULL);
+	zassert_equal(deter->stack, 0, NULL);
+	zassert_true(zsl_instr_find("zsl_mtx_qrd") == NULL ||
+		     zsl_instr_find("zsl_mtx_qrd")->calls == 0, NULL);
+}
+#endif